@@ -36,6 +36,13 @@
 
 #include "ALICE3/Core/DelphesO2TrackSmearer.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+
 namespace o2
 {
 namespace delphes
@@ -43,6 +50,30 @@ namespace delphes
 
 /*****************************************************************/
 
+TrackSmearer::~TrackSmearer()
+{
+  for (unsigned int ipdg = 0; ipdg < nLUTs; ++ipdg) {
+    unloadTable(ipdg);
+  }
+}
+
+/*****************************************************************/
+
+void TrackSmearer::unloadTable(int ipdg)
+{
+  if (mLUTMap[ipdg]) {
+    munmap(mLUTMap[ipdg], mLUTMapSize[ipdg]);
+  }
+  mLUTMap[ipdg] = nullptr;
+  mLUTMapSize[ipdg] = 0;
+  mLUTEntry[ipdg] = nullptr;
+  mBinCache[ipdg].valid = false;
+  delete mLUTHeader[ipdg];
+  mLUTHeader[ipdg] = nullptr;
+}
+
+/*****************************************************************/
+
 bool TrackSmearer::loadTable(int pdg, const char* filename, bool forceReload)
 {
   auto ipdg = getIndexPDG(pdg);
@@ -50,60 +81,55 @@ bool TrackSmearer::loadTable(int pdg, const char* filename, bool forceReload)
     std::cout << " --- LUT table for PDG " << pdg << " has been already loaded with index " << ipdg << std::endl;
     return false;
   }
-  mLUTHeader[ipdg] = new lutHeader_t;
+  unloadTable(ipdg);
 
-  std::ifstream lutFile(filename, std::ifstream::binary);
-  if (!lutFile.is_open()) {
+  int lutFile = open(filename, O_RDONLY);
+  if (lutFile < 0) {
     std::cout << " --- cannot open covariance matrix file for PDG " << pdg << ": " << filename << std::endl;
-    delete mLUTHeader[ipdg];
-    mLUTHeader[ipdg] = nullptr;
     return false;
   }
-  lutFile.read(reinterpret_cast<char*>(mLUTHeader[ipdg]), sizeof(lutHeader_t));
-  if (lutFile.gcount() != sizeof(lutHeader_t)) {
+  struct stat lutStat;
+  if (fstat(lutFile, &lutStat) != 0 || static_cast<std::size_t>(lutStat.st_size) < sizeof(lutHeader_t)) {
     std::cout << " --- troubles reading covariance matrix header for PDG " << pdg << ": " << filename << std::endl;
-    delete mLUTHeader[ipdg];
-    mLUTHeader[ipdg] = nullptr;
+    close(lutFile);
+    return false;
+  }
+  // private mapping: the pages of the file are shared until written, which the smearer never does
+  const std::size_t mapSize = lutStat.st_size;
+  void* map = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, lutFile, 0);
+  close(lutFile);
+  if (map == MAP_FAILED) {
+    std::cout << " --- cannot map covariance matrix file for PDG " << pdg << ": " << filename << std::endl;
     return false;
   }
+  mLUTMap[ipdg] = map;
+  mLUTMapSize[ipdg] = mapSize;
+
+  mLUTHeader[ipdg] = new lutHeader_t;
+  std::memcpy(mLUTHeader[ipdg], map, sizeof(lutHeader_t));
   if (mLUTHeader[ipdg]->version != LUTCOVM_VERSION) {
     std::cout << " --- LUT header version mismatch: expected/detected = " << LUTCOVM_VERSION << "/" << mLUTHeader[ipdg]->version << std::endl;
-    delete mLUTHeader[ipdg];
-    mLUTHeader[ipdg] = nullptr;
+    unloadTable(ipdg);
     return false;
   }
   if (mLUTHeader[ipdg]->pdg != pdg) {
     std::cout << " --- LUT header PDG mismatch: expected/detected = " << pdg << "/" << mLUTHeader[ipdg]->pdg << std::endl;
-    delete mLUTHeader[ipdg];
-    mLUTHeader[ipdg] = nullptr;
+    unloadTable(ipdg);
     return false;
   }
-  const int nnch = mLUTHeader[ipdg]->nchmap.nbins;
-  const int nrad = mLUTHeader[ipdg]->radmap.nbins;
-  const int neta = mLUTHeader[ipdg]->etamap.nbins;
-  const int npt = mLUTHeader[ipdg]->ptmap.nbins;
-  mLUTEntry[ipdg] = new lutEntry_t****[nnch];
-  for (int inch = 0; inch < nnch; ++inch) {
-    mLUTEntry[ipdg][inch] = new lutEntry_t***[nrad];
-    for (int irad = 0; irad < nrad; ++irad) {
-      mLUTEntry[ipdg][inch][irad] = new lutEntry_t**[neta];
-      for (int ieta = 0; ieta < neta; ++ieta) {
-        mLUTEntry[ipdg][inch][irad][ieta] = new lutEntry_t*[npt];
-        for (int ipt = 0; ipt < npt; ++ipt) {
-          mLUTEntry[ipdg][inch][irad][ieta][ipt] = new lutEntry_t;
-          lutFile.read(reinterpret_cast<char*>(mLUTEntry[ipdg][inch][irad][ieta][ipt]), sizeof(lutEntry_t));
-          if (lutFile.gcount() != sizeof(lutEntry_t)) {
-            std::cout << " --- troubles reading covariance matrix entry for PDG " << pdg << ": " << filename << std::endl;
-            return false;
-          }
-        }
-      }
-    }
+  const std::size_t nnch = mLUTHeader[ipdg]->nchmap.nbins;
+  const std::size_t nrad = mLUTHeader[ipdg]->radmap.nbins;
+  const std::size_t neta = mLUTHeader[ipdg]->etamap.nbins;
+  const std::size_t npt = mLUTHeader[ipdg]->ptmap.nbins;
+  if (mapSize < sizeof(lutHeader_t) + nnch * nrad * neta * npt * sizeof(lutEntry_t)) {
+    std::cout << " --- troubles reading covariance matrix entry for PDG " << pdg << ": " << filename << std::endl;
+    unloadTable(ipdg);
+    return false;
   }
+  mLUTEntry[ipdg] = reinterpret_cast<lutEntry_t*>(static_cast<char*>(map) + sizeof(lutHeader_t));
   std::cout << " --- read covariance matrix table for PDG " << pdg << ": " << filename << std::endl;
   mLUTHeader[ipdg]->print();
 
-  lutFile.close();
   return true;
 }
 
@@ -115,53 +141,62 @@ lutEntry_t*
   auto ipdg = getIndexPDG(pdg);
   if (!mLUTHeader[ipdg])
     return nullptr;
-  auto inch = mLUTHeader[ipdg]->nchmap.find(nch);
-  auto irad = mLUTHeader[ipdg]->radmap.find(radius);
+  auto& binCache = mBinCache[ipdg];
+  if (!binCache.valid || binCache.nch != nch || binCache.radius != radius) {
+    binCache.nch = nch;
+    binCache.radius = radius;
+    binCache.inch = mLUTHeader[ipdg]->nchmap.find(nch);
+    binCache.irad = mLUTHeader[ipdg]->radmap.find(radius);
+    binCache.fraction = mLUTHeader[ipdg]->nchmap.fracPositionWithinBin(nch);
+    binCache.valid = true;
+  }
+  auto inch = binCache.inch;
+  auto irad = binCache.irad;
   auto ieta = mLUTHeader[ipdg]->etamap.find(eta);
   auto ipt = mLUTHeader[ipdg]->ptmap.find(pt);
 
   // Interpolate if requested
-  auto fraction = mLUTHeader[ipdg]->nchmap.fracPositionWithinBin(nch);
   if (mInterpolateEfficiency) {
+    auto fraction = binCache.fraction;
     if (fraction > 0.5) {
       if (mWhatEfficiency == 1) {
         if (inch < mLUTHeader[ipdg]->nchmap.nbins - 1) {
-          interpolatedEff = (1.5f - fraction) * mLUTEntry[ipdg][inch][irad][ieta][ipt]->eff + (-0.5f + fraction) * mLUTEntry[ipdg][inch + 1][irad][ieta][ipt]->eff;
+          interpolatedEff = (1.5f - fraction) * getEntry(ipdg, inch, irad, ieta, ipt)->eff + (-0.5f + fraction) * getEntry(ipdg, inch + 1, irad, ieta, ipt)->eff;
         } else {
-          interpolatedEff = mLUTEntry[ipdg][inch][irad][ieta][ipt]->eff;
+          interpolatedEff = getEntry(ipdg, inch, irad, ieta, ipt)->eff;
         }
       }
       if (mWhatEfficiency == 2) {
         if (inch < mLUTHeader[ipdg]->nchmap.nbins - 1) {
-          interpolatedEff = (1.5f - fraction) * mLUTEntry[ipdg][inch][irad][ieta][ipt]->eff2 + (-0.5f + fraction) * mLUTEntry[ipdg][inch + 1][irad][ieta][ipt]->eff2;
+          interpolatedEff = (1.5f - fraction) * getEntry(ipdg, inch, irad, ieta, ipt)->eff2 + (-0.5f + fraction) * getEntry(ipdg, inch + 1, irad, ieta, ipt)->eff2;
         } else {
-          interpolatedEff = mLUTEntry[ipdg][inch][irad][ieta][ipt]->eff2;
+          interpolatedEff = getEntry(ipdg, inch, irad, ieta, ipt)->eff2;
         }
       }
     } else {
       float comparisonValue = mLUTHeader[ipdg]->nchmap.log ? log10(nch) : nch;
       if (mWhatEfficiency == 1) {
         if (inch > 0 && comparisonValue < mLUTHeader[ipdg]->nchmap.max) {
-          interpolatedEff = (0.5f + fraction) * mLUTEntry[ipdg][inch][irad][ieta][ipt]->eff + (0.5f - fraction) * mLUTEntry[ipdg][inch - 1][irad][ieta][ipt]->eff;
+          interpolatedEff = (0.5f + fraction) * getEntry(ipdg, inch, irad, ieta, ipt)->eff + (0.5f - fraction) * getEntry(ipdg, inch - 1, irad, ieta, ipt)->eff;
         } else {
-          interpolatedEff = mLUTEntry[ipdg][inch][irad][ieta][ipt]->eff;
+          interpolatedEff = getEntry(ipdg, inch, irad, ieta, ipt)->eff;
         }
       }
       if (mWhatEfficiency == 2) {
         if (inch > 0 && comparisonValue < mLUTHeader[ipdg]->nchmap.max) {
-          interpolatedEff = (0.5f + fraction) * mLUTEntry[ipdg][inch][irad][ieta][ipt]->eff2 + (0.5f - fraction) * mLUTEntry[ipdg][inch - 1][irad][ieta][ipt]->eff2;
+          interpolatedEff = (0.5f + fraction) * getEntry(ipdg, inch, irad, ieta, ipt)->eff2 + (0.5f - fraction) * getEntry(ipdg, inch - 1, irad, ieta, ipt)->eff2;
         } else {
-          interpolatedEff = mLUTEntry[ipdg][inch][irad][ieta][ipt]->eff2;
+          interpolatedEff = getEntry(ipdg, inch, irad, ieta, ipt)->eff2;
         }
       }
     }
   } else {
     if (mWhatEfficiency == 1)
-      interpolatedEff = mLUTEntry[ipdg][inch][irad][ieta][ipt]->eff;
+      interpolatedEff = getEntry(ipdg, inch, irad, ieta, ipt)->eff;
     if (mWhatEfficiency == 2)
-      interpolatedEff = mLUTEntry[ipdg][inch][irad][ieta][ipt]->eff2;
+      interpolatedEff = getEntry(ipdg, inch, irad, ieta, ipt)->eff2;
   }
-  return mLUTEntry[ipdg][inch][irad][ieta][ipt];
+  return getEntry(ipdg, inch, irad, ieta, ipt);
 } //;
 
 /*****************************************************************/
@@ -187,20 +222,26 @@ bool TrackSmearer::smearTrack(O2Track& o2track, lutEntry_t* lutEntry, float inte
     return false;
 
   // transform params vector and smear
-  double params_[5];
-  for (int i = 0; i < 5; ++i) {
-    double val = 0.;
-    for (int j = 0; j < 5; ++j)
-      val += lutEntry->eigvec[j][i] * o2track.getParam(j);
-    params_[i] = gRandom->Gaus(val, sqrt(lutEntry->eigval[i]));
+  // (the parameters are read once, and the rotations run on local arrays)
+  float trackParams[5];
+  for (int j = 0; j < 5; ++j)
+    trackParams[j] = o2track.getParam(j);
+  double rotated[5] = {0.};
+  for (int j = 0; j < 5; ++j) {
+    for (int i = 0; i < 5; ++i)
+      rotated[i] += lutEntry->eigvec[j][i] * trackParams[j];
   }
+  double params_[5];
+  for (int i = 0; i < 5; ++i)
+    params_[i] = gRandom->Gaus(rotated[i], sqrt(lutEntry->eigval[i]));
   // transform back params vector
-  for (int i = 0; i < 5; ++i) {
-    double val = 0.;
-    for (int j = 0; j < 5; ++j)
-      val += lutEntry->eiginv[j][i] * params_[j];
-    o2track.setParam(val, i);
+  double smeared[5] = {0.};
+  for (int j = 0; j < 5; ++j) {
+    for (int i = 0; i < 5; ++i)
+      smeared[i] += lutEntry->eiginv[j][i] * params_[j];
   }
+  for (int i = 0; i < 5; ++i)
+    o2track.setParam(smeared[i], i);
   // should make a sanity check that par[2] sin(phi) is in [-1, 1]
   if (fabs(o2track.getParam(2)) > 1.) {
     std::cout << " --- smearTrack failed sin(phi) sanity check: " << o2track.getParam(2) << std::endl;
@@ -24,6 +24,7 @@
 #ifndef ALICE3_CORE_DELPHESO2TRACKSMEARER_H_
 #define ALICE3_CORE_DELPHESO2TRACKSMEARER_H_
 
+#include <cstddef>
 #include <map>
 #include <iostream>
 #include <fstream>
@@ -173,9 +174,14 @@ class TrackSmearer
 
  public:
   TrackSmearer() = default;
-  ~TrackSmearer() = default;
+  ~TrackSmearer();
+  TrackSmearer(const TrackSmearer&) = delete;
+  TrackSmearer& operator=(const TrackSmearer&) = delete;
 
   /** LUT methods **/
+  /// The LUT file is memory mapped: the entries are read in place, in the order
+  /// they are written ([nch][rad][eta][pt] after the header), and the pages are
+  /// shared by all the processes which map the same file
   bool loadTable(int pdg, const char* filename, bool forceReload = false);
   void useEfficiency(bool val) { mUseEfficiency = val; }                      //;
   void interpolateEfficiency(bool val) { mInterpolateEfficiency = val; }      //;
@@ -220,9 +226,30 @@ class TrackSmearer
   void setdNdEta(float val) { mdNdEta = val; } //;
 
  protected:
+  /// Entry of a LUT, from the flat index of its bins
+  lutEntry_t* getEntry(int ipdg, int inch, int irad, int ieta, int ipt)
+  {
+    const lutHeader_t* header = mLUTHeader[ipdg];
+    return mLUTEntry[ipdg] + ((static_cast<std::size_t>(inch) * header->radmap.nbins + irad) * header->etamap.nbins + ieta) * header->ptmap.nbins + ipt;
+  }
+  void unloadTable(int ipdg);
+
   static constexpr unsigned int nLUTs = 8; // Number of LUT available
   lutHeader_t* mLUTHeader[nLUTs] = {nullptr};
-  lutEntry_t***** mLUTEntry[nLUTs] = {nullptr};
+  lutEntry_t* mLUTEntry[nLUTs] = {nullptr}; // entries in the mapped file
+  void* mLUTMap[nLUTs] = {nullptr};         // mapping of the LUT file
+  std::size_t mLUTMapSize[nLUTs] = {0};     // size of the mapping
+
+  /// nch and radius bins of the last lookup: all the tracks of an event share them
+  struct binCache_t {
+    bool valid = false;
+    float nch = 0.;
+    float radius = 0.;
+    int inch = 0;
+    int irad = 0;
+    float fraction = 0.5f; // position within the nch bin, for the efficiency interpolation
+  };
+  binCache_t mBinCache[nLUTs];
   bool mUseEfficiency = true;
   bool mInterpolateEfficiency = false;
   bool mSkipUnreconstructed = true; // don't smear tracks that are not reco'ed
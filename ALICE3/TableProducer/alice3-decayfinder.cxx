@@ -23,6 +23,7 @@
 #include <map>
 #include <iterator>
 #include <utility>
+#include <vector>
 
 #include "Framework/runDataProcessing.h"
 #include "Framework/RunningWorkflowInfo.h"
@@ -298,11 +299,26 @@ struct alice3decayFinder {
     float eta;
   } lcbaryon;
 
-  template <typename TTrackType>
-  bool buildDecayCandidateTwoBody(TTrackType const& posTrackRow, TTrackType const& negTrackRow, float posMass, float negMass)
+  // track parametrisations of the grouped tracks of a collision, converted once instead of once per combination
+  std::vector<o2::track::TrackParCov> poolPiPlus;
+  std::vector<o2::track::TrackParCov> poolPiMinus;
+  std::vector<o2::track::TrackParCov> poolKaPlus;
+  std::vector<o2::track::TrackParCov> poolKaMinus;
+  std::vector<o2::track::TrackParCov> poolPrPlus;
+  std::vector<o2::track::TrackParCov> poolPrMinus;
+
+  template <typename TTracks>
+  void fillPool(TTracks const& tracks, std::vector<o2::track::TrackParCov>& pool)
   {
-    o2::track::TrackParCov posTrack = getTrackParCov(posTrackRow);
-    o2::track::TrackParCov negTrack = getTrackParCov(negTrackRow);
+    pool.clear();
+    for (auto const& track : tracks) {
+      pool.push_back(getTrackParCov(track));
+    }
+  }
+  bool buildDecayCandidateTwoBody(o2::track::TrackParCov const& posTrackPar, o2::track::TrackParCov const& negTrackPar, float posMass, float negMass)
+  {
+    o2::track::TrackParCov posTrack = posTrackPar;
+    o2::track::TrackParCov negTrack = negTrackPar;
 
     //}-{}-{}-{}-{}-{}-{}-{}-{}-{}
     // Move close to minima
@@ -335,12 +351,11 @@ struct alice3decayFinder {
     return true;
   }
 
-  template <typename TTrackType>
-  bool buildDecayCandidateThreeBody(TTrackType const& prong0, TTrackType const& prong1, TTrackType const& prong2, float p0mass, float p1mass, float p2mass)
+  bool buildDecayCandidateThreeBody(o2::track::TrackParCov const& prong0, o2::track::TrackParCov const& prong1, o2::track::TrackParCov const& prong2, float p0mass, float p1mass, float p2mass)
   {
-    o2::track::TrackParCov t0 = getTrackParCov(prong0);
-    o2::track::TrackParCov t1 = getTrackParCov(prong1);
-    o2::track::TrackParCov t2 = getTrackParCov(prong2);
+    o2::track::TrackParCov t0 = prong0;
+    o2::track::TrackParCov t1 = prong1;
+    o2::track::TrackParCov t2 = prong2;
 
     //}-{}-{}-{}-{}-{}-{}-{}-{}-{}
     // Move close to minima
@@ -355,9 +370,9 @@ struct alice3decayFinder {
     }
     //}-{}-{}-{}-{}-{}-{}-{}-{}-{}
 
-    t0 = fitter.getTrack(0);
-    t1 = fitter.getTrack(1);
-    t2 = fitter.getTrack(2);
+    t0 = fitter3.getTrack(0);
+    t1 = fitter3.getTrack(1);
+    t2 = fitter3.getTrack(2);
     std::array<float, 3> P0;
     std::array<float, 3> P1;
     std::array<float, 3> P2;
@@ -498,23 +513,36 @@ struct alice3decayFinder {
         histos.fill(HIST("h2dDCAxyVsPtKaMinusFromD"), track.pt(), track.dcaXY() * 1e+4);
     }
 
+    fillPool(tracksPiPlusFromDgrouped, poolPiPlus);
+    fillPool(tracksPiMinusFromDgrouped, poolPiMinus);
+    fillPool(tracksKaPlusFromDgrouped, poolKaPlus);
+    fillPool(tracksKaMinusFromDgrouped, poolKaMinus);
+
     // D mesons
+    size_t iPos = 0;
     for (auto const& posTrackRow : tracksPiPlusFromDgrouped) {
+      const auto& posTrackPar = poolPiPlus[iPos++];
+      size_t iNeg = 0;
       for (auto const& negTrackRow : tracksKaMinusFromDgrouped) {
+        const auto& negTrackPar = poolKaMinus[iNeg++];
         if (mcSameMotherCheck && !checkSameMother(posTrackRow, negTrackRow))
           continue;
-        if (!buildDecayCandidateTwoBody(posTrackRow, negTrackRow, o2::constants::physics::MassPionCharged, o2::constants::physics::MassKaonCharged))
+        if (!buildDecayCandidateTwoBody(posTrackPar, negTrackPar, o2::constants::physics::MassPionCharged, o2::constants::physics::MassKaonCharged))
           continue;
         histos.fill(HIST("hMassD"), dmeson.mass);
         histos.fill(HIST("h3dRecD"), dmeson.pt, dmeson.eta, dmeson.mass);
       }
     }
     // D mesons
+    iPos = 0;
     for (auto const& posTrackRow : tracksKaPlusFromDgrouped) {
+      const auto& posTrackPar = poolKaPlus[iPos++];
+      size_t iNeg = 0;
       for (auto const& negTrackRow : tracksPiMinusFromDgrouped) {
+        const auto& negTrackPar = poolPiMinus[iNeg++];
         if (mcSameMotherCheck && !checkSameMother(posTrackRow, negTrackRow))
           continue;
-        if (!buildDecayCandidateTwoBody(posTrackRow, negTrackRow, o2::constants::physics::MassKaonCharged, o2::constants::physics::MassPionCharged))
+        if (!buildDecayCandidateTwoBody(posTrackPar, negTrackPar, o2::constants::physics::MassKaonCharged, o2::constants::physics::MassPionCharged))
           continue;
         histos.fill(HIST("hMassDbar"), dmeson.mass);
         histos.fill(HIST("h3dRecDbar"), dmeson.pt, dmeson.eta, dmeson.mass);
@@ -550,15 +578,30 @@ struct alice3decayFinder {
         histos.fill(HIST("h2dDCAxyVsPtPrMinusFromLc"), track.pt(), track.dcaXY() * 1e+4);
     }
 
+    fillPool(tracksPiPlusFromLcgrouped, poolPiPlus);
+    fillPool(tracksPiMinusFromLcgrouped, poolPiMinus);
+    fillPool(tracksKaPlusFromLcgrouped, poolKaPlus);
+    fillPool(tracksKaMinusFromLcgrouped, poolKaMinus);
+    fillPool(tracksPrPlusFromLcgrouped, poolPrPlus);
+    fillPool(tracksPrMinusFromLcgrouped, poolPrMinus);
+
     // Lc+ baryons +4122 -> +2212 -321 +211
+    size_t iProton = 0;
     for (auto const& proton : tracksPrPlusFromLcgrouped) {
+      const auto& protonPar = poolPrPlus[iProton++];
+      size_t iPion = 0;
       for (auto const& pion : tracksPiPlusFromLcgrouped) {
+        const auto& pionPar = poolPiPlus[iPion++];
         if (pion.globalIndex() == proton.globalIndex())
           continue; // avoid self
+        if (mcSameMotherCheck && !checkSameMother(proton, pion))
+          continue; // independent of the kaon
+        size_t iKaon = 0;
         for (auto const& kaon : tracksKaMinusFromLcgrouped) {
-          if (mcSameMotherCheck && (!checkSameMother(proton, kaon) || !checkSameMother(proton, pion)))
+          const auto& kaonPar = poolKaMinus[iKaon++];
+          if (mcSameMotherCheck && !checkSameMother(proton, kaon))
             continue;
-          if (!buildDecayCandidateThreeBody(proton, kaon, pion, o2::constants::physics::MassProton, o2::constants::physics::MassKaonCharged, o2::constants::physics::MassPionCharged))
+          if (!buildDecayCandidateThreeBody(protonPar, kaonPar, pionPar, o2::constants::physics::MassProton, o2::constants::physics::MassKaonCharged, o2::constants::physics::MassPionCharged))
             continue;
           histos.fill(HIST("hMassLc"), lcbaryon.mass);
           histos.fill(HIST("h3dRecLc"), lcbaryon.pt, lcbaryon.eta, lcbaryon.mass);
@@ -566,14 +609,22 @@ struct alice3decayFinder {
       }
     }
     // Lc- baryons -4122 -> -2212 +321 -211
+    iProton = 0;
     for (auto const& proton : tracksPrMinusFromLcgrouped) {
+      const auto& protonPar = poolPrMinus[iProton++];
+      size_t iPion = 0;
       for (auto const& pion : tracksPiMinusFromLcgrouped) {
+        const auto& pionPar = poolPiMinus[iPion++];
         if (pion.globalIndex() == proton.globalIndex())
           continue; // avoid self
+        if (mcSameMotherCheck && !checkSameMother(proton, pion))
+          continue; // independent of the kaon
+        size_t iKaon = 0;
         for (auto const& kaon : tracksKaPlusFromLcgrouped) {
-          if (mcSameMotherCheck && (!checkSameMother(proton, kaon) || !checkSameMother(proton, pion)))
+          const auto& kaonPar = poolKaPlus[iKaon++];
+          if (mcSameMotherCheck && !checkSameMother(proton, kaon))
             continue;
-          if (!buildDecayCandidateThreeBody(proton, kaon, pion, o2::constants::physics::MassProton, o2::constants::physics::MassKaonCharged, o2::constants::physics::MassPionCharged))
+          if (!buildDecayCandidateThreeBody(protonPar, kaonPar, pionPar, o2::constants::physics::MassProton, o2::constants::physics::MassKaonCharged, o2::constants::physics::MassPionCharged))
             continue;
           histos.fill(HIST("hMassLcbar"), lcbaryon.mass);
           histos.fill(HIST("h3dRecLcbar"), lcbaryon.pt, lcbaryon.eta, lcbaryon.mass);
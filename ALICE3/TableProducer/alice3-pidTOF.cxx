@@ -112,20 +112,39 @@ struct ALICE3pidTOFTask {
     }
   }
 
-  template <o2::track::PID::ID id>
-  float sigma(Trks::iterator track)
+  /// Quantities of a track shared by all the mass hypotheses
+  struct TrackResponse {
+    float p;          // momentum
+    float sigmaP;     // momentum uncertainty
+    float evTimeReso; // collision time resolution (ps)
+    float length;     // track length
+    float expMom;     // TOF expected momentum
+    float deltaTime;  // track time minus collision time (ps)
+  };
+
+  TrackResponse getTrackResponse(Trks::iterator const& track)
   {
-    return o2::pid::tof::TOFResoALICE3ParamTrack<id>(track, resoParameters);
+    const auto& collision = track.collision();
+    TrackResponse response;
+    response.p = track.p();
+    response.sigmaP = o2::pid::tof::TOFResoALICE3MomentumError(track);
+    response.evTimeReso = collision.collisionTimeRes() * 1000.f;
+    response.length = track.length();
+    response.expMom = track.tofExpMom() / o2::pid::tof::kCSPEED;
+    response.deltaTime = (track.trackTime() - collision.collisionTime()) * 1000.f;
+    return response;
   }
-  template <o2::track::PID::ID id>
-  float nsigma(Trks::iterator track)
+
+  /// Fills the expected sigma and the nsigma of a hypothesis, with the sigma evaluated once for both
+  template <o2::track::PID::ID id, typename TTable>
+  void fillPID(TTable& table, Trks::iterator const& track, const TrackResponse& response)
   {
+    const float expSigma = o2::pid::tof::TOFResoALICE3Param(response.p, response.sigmaP, response.evTimeReso, response.length, o2::track::pid_constants::sMasses2Z[id], resoParameters);
     if (!track.hasTOF()) {
-      return -999.f;
+      table(expSigma, -999.f);
+      return;
     }
-    return ((track.trackTime() - track.collision().collisionTime()) * 1000.f - o2::pid::tof::ExpTimes<Trks::iterator, id>::ComputeExpectedTime(track.tofExpMom() / o2::pid::tof::kCSPEED,
-                                                                                                                                               track.length())) /
-           sigma<id>(track);
+    table(expSigma, (response.deltaTime - o2::pid::tof::ExpTimes<Trks::iterator, id>::ComputeExpectedTime(response.expMom, response.length)) / expSigma);
   }
   void process(Trks const& tracks, Coll const&)
   {
@@ -139,15 +158,16 @@ struct ALICE3pidTOFTask {
     tablePIDHe.reserve(tracks.size());
     tablePIDAl.reserve(tracks.size());
     for (auto const& trk : tracks) {
-      tablePIDEl(sigma<PID::Electron>(trk), nsigma<PID::Electron>(trk));
-      tablePIDMu(sigma<PID::Muon>(trk), nsigma<PID::Muon>(trk));
-      tablePIDPi(sigma<PID::Pion>(trk), nsigma<PID::Pion>(trk));
-      tablePIDKa(sigma<PID::Kaon>(trk), nsigma<PID::Kaon>(trk));
-      tablePIDPr(sigma<PID::Proton>(trk), nsigma<PID::Proton>(trk));
-      tablePIDDe(sigma<PID::Deuteron>(trk), nsigma<PID::Deuteron>(trk));
-      tablePIDTr(sigma<PID::Triton>(trk), nsigma<PID::Triton>(trk));
-      tablePIDHe(sigma<PID::Helium3>(trk), nsigma<PID::Helium3>(trk));
-      tablePIDAl(sigma<PID::Alpha>(trk), nsigma<PID::Alpha>(trk));
+      const TrackResponse response = getTrackResponse(trk);
+      fillPID<PID::Electron>(tablePIDEl, trk, response);
+      fillPID<PID::Muon>(tablePIDMu, trk, response);
+      fillPID<PID::Pion>(tablePIDPi, trk, response);
+      fillPID<PID::Kaon>(tablePIDKa, trk, response);
+      fillPID<PID::Proton>(tablePIDPr, trk, response);
+      fillPID<PID::Deuteron>(tablePIDDe, trk, response);
+      fillPID<PID::Triton>(tablePIDTr, trk, response);
+      fillPID<PID::Helium3>(tablePIDHe, trk, response);
+      fillPID<PID::Alpha>(tablePIDAl, trk, response);
     }
   }
 };
@@ -202,7 +202,7 @@ struct Alice3LutMaker {
                const o2::soa::Join<o2::aod::Tracks, o2::aod::TracksCov, o2::aod::McTrackLabels>& tracks,
                const o2::aod::McCollisions&)
   {
-    std::vector<int64_t> recoTracks(tracks.size());
+    std::vector<bool> isReconstructed(mcParticles.size(), false); // flag per MC particle, to avoid searching the reconstructed ones for the efficiency
     int ntrks = 0;
 
     for (const auto& track : tracks) {
@@ -216,78 +216,82 @@ struct Alice3LutMaker {
         continue;
       }
 
-      recoTracks[ntrks++] = mcParticle.globalIndex();
-
-      histos.fill(HIST("pt"), mcParticle.pt());
-      histos.fill(HIST("eta"), mcParticle.eta());
-
-      histos.fill(HIST("CovMat_sigmaY"), mcParticle.pt(), mcParticle.eta(), track.sigmaY());
-      histos.fill(HIST("CovMat_sigmaZ"), mcParticle.pt(), mcParticle.eta(), track.sigmaZ());
-      histos.fill(HIST("CovMat_sigmaSnp"), mcParticle.pt(), mcParticle.eta(), track.sigmaSnp());
-      histos.fill(HIST("CovMat_sigmaTgl"), mcParticle.pt(), mcParticle.eta(), track.sigmaTgl());
-      histos.fill(HIST("CovMat_sigma1Pt"), mcParticle.pt(), mcParticle.eta(), track.sigma1Pt());
-      histos.fill(HIST("CovMat_rhoZY"), mcParticle.pt(), mcParticle.eta(), track.rhoZY());
-      histos.fill(HIST("CovMat_rhoSnpY"), mcParticle.pt(), mcParticle.eta(), track.rhoSnpY());
-      histos.fill(HIST("CovMat_rhoSnpZ"), mcParticle.pt(), mcParticle.eta(), track.rhoSnpZ());
-      histos.fill(HIST("CovMat_rhoTglY"), mcParticle.pt(), mcParticle.eta(), track.rhoTglY());
-      histos.fill(HIST("CovMat_rhoTglZ"), mcParticle.pt(), mcParticle.eta(), track.rhoTglZ());
-      histos.fill(HIST("CovMat_rhoTglSnp"), mcParticle.pt(), mcParticle.eta(), track.rhoTglSnp());
-      histos.fill(HIST("CovMat_rho1PtY"), mcParticle.pt(), mcParticle.eta(), track.rho1PtY());
-      histos.fill(HIST("CovMat_rho1PtZ"), mcParticle.pt(), mcParticle.eta(), track.rho1PtZ());
-      histos.fill(HIST("CovMat_rho1PtSnp"), mcParticle.pt(), mcParticle.eta(), track.rho1PtSnp());
-      histos.fill(HIST("CovMat_rho1PtTgl"), mcParticle.pt(), mcParticle.eta(), track.rho1PtTgl());
-
-      histos.fill(HIST("CovMat_cYY"), mcParticle.pt(), mcParticle.eta(), track.cYY());
-      histos.fill(HIST("CovMat_cZY"), mcParticle.pt(), mcParticle.eta(), track.cZY());
-      histos.fill(HIST("CovMat_cZZ"), mcParticle.pt(), mcParticle.eta(), track.cZZ());
-      histos.fill(HIST("CovMat_cSnpY"), mcParticle.pt(), mcParticle.eta(), track.cSnpY());
-      histos.fill(HIST("CovMat_cSnpZ"), mcParticle.pt(), mcParticle.eta(), track.cSnpZ());
-      histos.fill(HIST("CovMat_cSnpSnp"), mcParticle.pt(), mcParticle.eta(), track.cSnpSnp());
-      histos.fill(HIST("CovMat_cTglY"), mcParticle.pt(), mcParticle.eta(), track.cTglY());
-      histos.fill(HIST("CovMat_cTglZ"), mcParticle.pt(), mcParticle.eta(), track.cTglZ());
-      histos.fill(HIST("CovMat_cTglSnp"), mcParticle.pt(), mcParticle.eta(), track.cTglSnp());
-      histos.fill(HIST("CovMat_cTglTgl"), mcParticle.pt(), mcParticle.eta(), track.cTglTgl());
-      histos.fill(HIST("CovMat_c1PtY"), mcParticle.pt(), mcParticle.eta(), track.c1PtY());
-      histos.fill(HIST("CovMat_c1PtZ"), mcParticle.pt(), mcParticle.eta(), track.c1PtZ());
-      histos.fill(HIST("CovMat_c1PtSnp"), mcParticle.pt(), mcParticle.eta(), track.c1PtSnp());
-      histos.fill(HIST("CovMat_c1PtTgl"), mcParticle.pt(), mcParticle.eta(), track.c1PtTgl());
-      histos.fill(HIST("CovMat_c1Pt21Pt2"), mcParticle.pt(), mcParticle.eta(), track.c1Pt21Pt2());
+      isReconstructed[mcParticle.globalIndex()] = true;
+      ntrks++;
+
+      // computed once for all the profiles below
+      const float pt = mcParticle.pt();
+      const float eta = mcParticle.eta();
+      histos.fill(HIST("pt"), pt);
+      histos.fill(HIST("eta"), eta);
+
+      histos.fill(HIST("CovMat_sigmaY"), pt, eta, track.sigmaY());
+      histos.fill(HIST("CovMat_sigmaZ"), pt, eta, track.sigmaZ());
+      histos.fill(HIST("CovMat_sigmaSnp"), pt, eta, track.sigmaSnp());
+      histos.fill(HIST("CovMat_sigmaTgl"), pt, eta, track.sigmaTgl());
+      histos.fill(HIST("CovMat_sigma1Pt"), pt, eta, track.sigma1Pt());
+      histos.fill(HIST("CovMat_rhoZY"), pt, eta, track.rhoZY());
+      histos.fill(HIST("CovMat_rhoSnpY"), pt, eta, track.rhoSnpY());
+      histos.fill(HIST("CovMat_rhoSnpZ"), pt, eta, track.rhoSnpZ());
+      histos.fill(HIST("CovMat_rhoTglY"), pt, eta, track.rhoTglY());
+      histos.fill(HIST("CovMat_rhoTglZ"), pt, eta, track.rhoTglZ());
+      histos.fill(HIST("CovMat_rhoTglSnp"), pt, eta, track.rhoTglSnp());
+      histos.fill(HIST("CovMat_rho1PtY"), pt, eta, track.rho1PtY());
+      histos.fill(HIST("CovMat_rho1PtZ"), pt, eta, track.rho1PtZ());
+      histos.fill(HIST("CovMat_rho1PtSnp"), pt, eta, track.rho1PtSnp());
+      histos.fill(HIST("CovMat_rho1PtTgl"), pt, eta, track.rho1PtTgl());
+
+      histos.fill(HIST("CovMat_cYY"), pt, eta, track.cYY());
+      histos.fill(HIST("CovMat_cZY"), pt, eta, track.cZY());
+      histos.fill(HIST("CovMat_cZZ"), pt, eta, track.cZZ());
+      histos.fill(HIST("CovMat_cSnpY"), pt, eta, track.cSnpY());
+      histos.fill(HIST("CovMat_cSnpZ"), pt, eta, track.cSnpZ());
+      histos.fill(HIST("CovMat_cSnpSnp"), pt, eta, track.cSnpSnp());
+      histos.fill(HIST("CovMat_cTglY"), pt, eta, track.cTglY());
+      histos.fill(HIST("CovMat_cTglZ"), pt, eta, track.cTglZ());
+      histos.fill(HIST("CovMat_cTglSnp"), pt, eta, track.cTglSnp());
+      histos.fill(HIST("CovMat_cTglTgl"), pt, eta, track.cTglTgl());
+      histos.fill(HIST("CovMat_c1PtY"), pt, eta, track.c1PtY());
+      histos.fill(HIST("CovMat_c1PtZ"), pt, eta, track.c1PtZ());
+      histos.fill(HIST("CovMat_c1PtSnp"), pt, eta, track.c1PtSnp());
+      histos.fill(HIST("CovMat_c1PtTgl"), pt, eta, track.c1PtTgl());
+      histos.fill(HIST("CovMat_c1Pt21Pt2"), pt, eta, track.c1Pt21Pt2());
 
       if (!addQA) { // Only if QA histograms are enabled
         continue;
       }
 
-      histos.fill(HIST("QA/CovMat_sigmaY"), mcParticle.pt(), mcParticle.eta(), track.sigmaY());
-      histos.fill(HIST("QA/CovMat_sigmaZ"), mcParticle.pt(), mcParticle.eta(), track.sigmaZ());
-      histos.fill(HIST("QA/CovMat_sigmaSnp"), mcParticle.pt(), mcParticle.eta(), track.sigmaSnp());
-      histos.fill(HIST("QA/CovMat_sigmaTgl"), mcParticle.pt(), mcParticle.eta(), track.sigmaTgl());
-      histos.fill(HIST("QA/CovMat_sigma1Pt"), mcParticle.pt(), mcParticle.eta(), track.sigma1Pt());
-      histos.fill(HIST("QA/CovMat_rhoZY"), mcParticle.pt(), mcParticle.eta(), track.rhoZY());
-      histos.fill(HIST("QA/CovMat_rhoSnpY"), mcParticle.pt(), mcParticle.eta(), track.rhoSnpY());
-      histos.fill(HIST("QA/CovMat_rhoSnpZ"), mcParticle.pt(), mcParticle.eta(), track.rhoSnpZ());
-      histos.fill(HIST("QA/CovMat_rhoTglY"), mcParticle.pt(), mcParticle.eta(), track.rhoTglY());
-      histos.fill(HIST("QA/CovMat_rhoTglZ"), mcParticle.pt(), mcParticle.eta(), track.rhoTglZ());
-      histos.fill(HIST("QA/CovMat_rhoTglSnp"), mcParticle.pt(), mcParticle.eta(), track.rhoTglSnp());
-      histos.fill(HIST("QA/CovMat_rho1PtY"), mcParticle.pt(), mcParticle.eta(), track.rho1PtY());
-      histos.fill(HIST("QA/CovMat_rho1PtZ"), mcParticle.pt(), mcParticle.eta(), track.rho1PtZ());
-      histos.fill(HIST("QA/CovMat_rho1PtSnp"), mcParticle.pt(), mcParticle.eta(), track.rho1PtSnp());
-      histos.fill(HIST("QA/CovMat_rho1PtTgl"), mcParticle.pt(), mcParticle.eta(), track.rho1PtTgl());
-
-      histos.fill(HIST("QA/CovMat_cYY"), mcParticle.pt(), mcParticle.eta(), track.cYY());
-      histos.fill(HIST("QA/CovMat_cZY"), mcParticle.pt(), mcParticle.eta(), track.cZY());
-      histos.fill(HIST("QA/CovMat_cZZ"), mcParticle.pt(), mcParticle.eta(), track.cZZ());
-      histos.fill(HIST("QA/CovMat_cSnpY"), mcParticle.pt(), mcParticle.eta(), track.cSnpY());
-      histos.fill(HIST("QA/CovMat_cSnpZ"), mcParticle.pt(), mcParticle.eta(), track.cSnpZ());
-      histos.fill(HIST("QA/CovMat_cSnpSnp"), mcParticle.pt(), mcParticle.eta(), track.cSnpSnp());
-      histos.fill(HIST("QA/CovMat_cTglY"), mcParticle.pt(), mcParticle.eta(), track.cTglY());
-      histos.fill(HIST("QA/CovMat_cTglZ"), mcParticle.pt(), mcParticle.eta(), track.cTglZ());
-      histos.fill(HIST("QA/CovMat_cTglSnp"), mcParticle.pt(), mcParticle.eta(), track.cTglSnp());
-      histos.fill(HIST("QA/CovMat_cTglTgl"), mcParticle.pt(), mcParticle.eta(), track.cTglTgl());
-      histos.fill(HIST("QA/CovMat_c1PtY"), mcParticle.pt(), mcParticle.eta(), track.c1PtY());
-      histos.fill(HIST("QA/CovMat_c1PtZ"), mcParticle.pt(), mcParticle.eta(), track.c1PtZ());
-      histos.fill(HIST("QA/CovMat_c1PtSnp"), mcParticle.pt(), mcParticle.eta(), track.c1PtSnp());
-      histos.fill(HIST("QA/CovMat_c1PtTgl"), mcParticle.pt(), mcParticle.eta(), track.c1PtTgl());
-      histos.fill(HIST("QA/CovMat_c1Pt21Pt2"), mcParticle.pt(), mcParticle.eta(), track.c1Pt21Pt2());
+      histos.fill(HIST("QA/CovMat_sigmaY"), pt, eta, track.sigmaY());
+      histos.fill(HIST("QA/CovMat_sigmaZ"), pt, eta, track.sigmaZ());
+      histos.fill(HIST("QA/CovMat_sigmaSnp"), pt, eta, track.sigmaSnp());
+      histos.fill(HIST("QA/CovMat_sigmaTgl"), pt, eta, track.sigmaTgl());
+      histos.fill(HIST("QA/CovMat_sigma1Pt"), pt, eta, track.sigma1Pt());
+      histos.fill(HIST("QA/CovMat_rhoZY"), pt, eta, track.rhoZY());
+      histos.fill(HIST("QA/CovMat_rhoSnpY"), pt, eta, track.rhoSnpY());
+      histos.fill(HIST("QA/CovMat_rhoSnpZ"), pt, eta, track.rhoSnpZ());
+      histos.fill(HIST("QA/CovMat_rhoTglY"), pt, eta, track.rhoTglY());
+      histos.fill(HIST("QA/CovMat_rhoTglZ"), pt, eta, track.rhoTglZ());
+      histos.fill(HIST("QA/CovMat_rhoTglSnp"), pt, eta, track.rhoTglSnp());
+      histos.fill(HIST("QA/CovMat_rho1PtY"), pt, eta, track.rho1PtY());
+      histos.fill(HIST("QA/CovMat_rho1PtZ"), pt, eta, track.rho1PtZ());
+      histos.fill(HIST("QA/CovMat_rho1PtSnp"), pt, eta, track.rho1PtSnp());
+      histos.fill(HIST("QA/CovMat_rho1PtTgl"), pt, eta, track.rho1PtTgl());
+
+      histos.fill(HIST("QA/CovMat_cYY"), pt, eta, track.cYY());
+      histos.fill(HIST("QA/CovMat_cZY"), pt, eta, track.cZY());
+      histos.fill(HIST("QA/CovMat_cZZ"), pt, eta, track.cZZ());
+      histos.fill(HIST("QA/CovMat_cSnpY"), pt, eta, track.cSnpY());
+      histos.fill(HIST("QA/CovMat_cSnpZ"), pt, eta, track.cSnpZ());
+      histos.fill(HIST("QA/CovMat_cSnpSnp"), pt, eta, track.cSnpSnp());
+      histos.fill(HIST("QA/CovMat_cTglY"), pt, eta, track.cTglY());
+      histos.fill(HIST("QA/CovMat_cTglZ"), pt, eta, track.cTglZ());
+      histos.fill(HIST("QA/CovMat_cTglSnp"), pt, eta, track.cTglSnp());
+      histos.fill(HIST("QA/CovMat_cTglTgl"), pt, eta, track.cTglTgl());
+      histos.fill(HIST("QA/CovMat_c1PtY"), pt, eta, track.c1PtY());
+      histos.fill(HIST("QA/CovMat_c1PtZ"), pt, eta, track.c1PtZ());
+      histos.fill(HIST("QA/CovMat_c1PtSnp"), pt, eta, track.c1PtSnp());
+      histos.fill(HIST("QA/CovMat_c1PtTgl"), pt, eta, track.c1PtTgl());
+      histos.fill(HIST("QA/CovMat_c1Pt21Pt2"), pt, eta, track.c1Pt21Pt2());
     }
     histos.fill(HIST("multiplicity"), ntrks);
 
@@ -299,7 +303,7 @@ struct Alice3LutMaker {
         continue;
       }
 
-      if (std::find(recoTracks.begin(), recoTracks.end(), mcParticle.globalIndex()) != recoTracks.end()) {
+      if (isReconstructed[mcParticle.globalIndex()]) {
         histos.fill(HIST("Efficiency"), mcParticle.pt(), mcParticle.eta(), 1.);
       } else {
         histos.fill(HIST("Efficiency"), mcParticle.pt(), mcParticle.eta(), 0.);
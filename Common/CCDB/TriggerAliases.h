@@ -15,6 +15,7 @@
 #include <cstdint>
 #include <map>
 #include <string>
+#include <vector>
 #include <Rtypes.h>
 
 enum triggerAliases {
@@ -71,4 +72,49 @@ class TriggerAliases
   ClassDefNV(TriggerAliases, 8)
 };
 
+/// Class masks of the aliases of a TriggerAliases object as flat arrays, for the evaluation
+/// of the fired aliases of every BC without iterating over the maps
+class TriggerAliasMasks
+{
+ public:
+  void Set(const TriggerAliases* aliases)
+  {
+    mSource = aliases;
+    mAliasBits.clear();
+    mMasks.clear();
+    mMasksNext50.clear();
+    for (const auto& al : aliases->GetAliasToTriggerMaskMap()) {
+      mAliasBits.push_back(BIT(al.first));
+      mMasks.push_back(al.second);
+      mMasksNext50.push_back(0);
+    }
+    for (const auto& al : aliases->GetAliasToTriggerMaskNext50Map()) {
+      mAliasBits.push_back(BIT(al.first));
+      mMasks.push_back(0);
+      mMasksNext50.push_back(al.second);
+    }
+  }
+
+  /// Object the masks were taken from
+  const TriggerAliases* GetSource() const { return mSource; }
+
+  /// Bits of the aliases with at least one fired class
+  uint32_t GetAliases(uint64_t triggerMask, uint64_t triggerMaskNext50 = 0) const
+  {
+    uint32_t alias{0};
+    for (size_t i = 0; i < mAliasBits.size(); i++) {
+      if ((triggerMask & mMasks[i]) || (triggerMaskNext50 & mMasksNext50[i])) {
+        alias |= mAliasBits[i];
+      }
+    }
+    return alias;
+  }
+
+ private:
+  const TriggerAliases* mSource = nullptr;
+  std::vector<uint32_t> mAliasBits;   // bit of the alias of each entry
+  std::vector<uint64_t> mMasks;       // classes 0-49 of each entry
+  std::vector<uint64_t> mMasksNext50; // classes 50-99 of each entry
+};
+
 #endif // COMMON_CCDB_TRIGGERALIASES_H_
@@ -11,6 +11,7 @@
 
 #include "ctpRateFetcher.h"
 
+#include <algorithm>
 #include <map>
 #include <vector>
 
@@ -25,6 +26,74 @@ namespace o2
 double ctpRateFetcher::fetch(o2::ccdb::BasicCCDBManager* ccdb, uint64_t timeStamp, int runNumber, std::string sourceName)
 {
   setupRun(runNumber, ccdb, timeStamp);
+  if (mUseRateTables) {
+    bool found = false;
+    const double rate = lookUp(getRateTable(ccdb, runNumber, sourceName), timeStamp * 1.e-3, found);
+    if (found) {
+      return rate;
+    }
+  }
+  return fetchFromCCDBScalers(ccdb, timeStamp, runNumber, sourceName);
+}
+
+void ctpRateFetcher::fetch(o2::ccdb::BasicCCDBManager* ccdb, const std::vector<uint64_t>& timeStamps, int runNumber, const std::string& sourceName, std::vector<double>& rates)
+{
+  rates.resize(timeStamps.size());
+  for (size_t i = 0; i < timeStamps.size(); i++) {
+    rates[i] = fetch(ccdb, timeStamps[i], runNumber, sourceName);
+  }
+}
+
+const ctpRateFetcher::RateTable& ctpRateFetcher::getRateTable(o2::ccdb::BasicCCDBManager* ccdb, int runNumber, const std::string& sourceName)
+{
+  auto it = mRateTables.find(sourceName);
+  if (it != mRateTables.end()) {
+    return it->second;
+  }
+  RateTable& table = mRateTables[sourceName];
+  const auto& recs = mScalers->getScalerRecordO2();
+  table.times.reserve(recs.size());
+  for (const auto& rec : recs) {
+    table.times.push_back(rec.epochTime);
+  }
+  if (!std::is_sorted(table.times.begin(), table.times.end())) {
+    LOG(warning) << "CTP scaler records not sorted in time, not using rate table for " << sourceName;
+    table.times.clear();
+    return table;
+  }
+  // the rate is constant in each interval between records, evaluate it at the centre
+  table.rates.reserve(table.times.size());
+  for (size_t i = 0; i + 1 < table.times.size(); i++) {
+    const uint64_t centre = static_cast<uint64_t>(0.5 * (table.times[i] + table.times[i + 1]) * 1.e3);
+    table.rates.push_back(fetchFromCCDBScalers(ccdb, centre, runNumber, sourceName));
+  }
+  LOG(info) << "Built CTP rate table for " << sourceName << " in run " << runNumber << " with " << table.rates.size() << " intervals";
+  return table;
+}
+
+double ctpRateFetcher::lookUp(const RateTable& table, double time, bool& found) const
+{
+  found = false;
+  if (table.rates.empty() || time < table.times.front() || time >= table.times.back()) {
+    return -1.;
+  }
+  const size_t i = std::upper_bound(table.times.begin(), table.times.end(), time) - table.times.begin() - 1;
+  found = true;
+  if (!mInterpolate) {
+    return table.rates[i];
+  }
+  const double centre = 0.5 * (table.times[i] + table.times[i + 1]);
+  const size_t j = time < centre ? (i > 0 ? i - 1 : i) : (i + 1 < table.rates.size() ? i + 1 : i);
+  if (j == i) {
+    return table.rates[i];
+  }
+  const double centreJ = 0.5 * (table.times[j] + table.times[j + 1]);
+  const double w = (time - centre) / (centreJ - centre);
+  return table.rates[i] + w * (table.rates[j] - table.rates[i]);
+}
+
+double ctpRateFetcher::fetchFromCCDBScalers(o2::ccdb::BasicCCDBManager* ccdb, uint64_t timeStamp, int runNumber, const std::string& sourceName)
+{
   if (sourceName.find("ZNC") != std::string::npos) {
     if (runNumber < 544448) {
       return fetchCTPratesInputs(ccdb, timeStamp, runNumber, 25) / (sourceName.find("hadronic") != std::string::npos ? 28. : 1.);
@@ -103,6 +172,7 @@ void ctpRateFetcher::setupRun(int runNumber, o2::ccdb::BasicCCDBManager* ccdb, u
     return;
   }
   mRunNumber = runNumber;
+  mRateTables.clear();
   LOG(debug) << "Setting up CTP scalers for run " << mRunNumber;
   if (mManualCleanup) {
     delete mConfig;
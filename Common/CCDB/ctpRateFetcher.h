@@ -12,7 +12,9 @@
 #ifndef COMMON_CCDB_CTPRATEFETCHER_H_
 #define COMMON_CCDB_CTPRATEFETCHER_H_
 
+#include <map>
 #include <string>
+#include <vector>
 
 #include "CCDB/BasicCCDBManager.h"
 
@@ -35,10 +37,39 @@ class ctpRateFetcher
  public:
   ctpRateFetcher() = default;
   double fetch(o2::ccdb::BasicCCDBManager* ccdb, uint64_t timeStamp, int runNumber, std::string sourceName);
+  /// Fetches the rates for a list of timestamps of the same run
+  void fetch(o2::ccdb::BasicCCDBManager* ccdb, const std::vector<uint64_t>& timeStamps, int runNumber, const std::string& sourceName, std::vector<double>& rates);
+  /// Fetches the rates for all the collisions of a table, the BC table must provide the timestamps
+  template <typename TBCs, typename TCollisions>
+  void fetchColumn(o2::ccdb::BasicCCDBManager* ccdb, const TCollisions& collisions, const std::string& sourceName, std::vector<double>& rates)
+  {
+    rates.clear();
+    rates.reserve(collisions.size());
+    for (const auto& collision : collisions) {
+      const auto bc = collision.template bc_as<TBCs>();
+      rates.push_back(fetch(ccdb, bc.timestamp(), bc.runNumber(), sourceName));
+    }
+  }
 
   void setManualCleanup(bool manualCleanup = true) { mManualCleanup = manualCleanup; }
+  /// Precomputes, once per run and source, the rate of each interval between scaler records and answers by binary search.
+  /// If interpolate is set, the rate is interpolated linearly between the centres of the intervals
+  void setUseRateTables(bool useRateTables = true, bool interpolate = false)
+  {
+    mUseRateTables = useRateTables;
+    mInterpolate = interpolate;
+  }
 
  private:
+  /// Rates of a source in the intervals between consecutive scaler records of a run
+  struct RateTable {
+    std::vector<double> times; // epoch time of the scaler records in s
+    std::vector<double> rates; // rate of each interval [times[i], times[i+1])
+  };
+
+  double fetchFromCCDBScalers(o2::ccdb::BasicCCDBManager* ccdb, uint64_t timeStamp, int runNumber, const std::string& sourceName);
+  const RateTable& getRateTable(o2::ccdb::BasicCCDBManager* ccdb, int runNumber, const std::string& sourceName);
+  double lookUp(const RateTable& table, double time, bool& found) const;
   double fetchCTPratesInputs(o2::ccdb::BasicCCDBManager* ccdb, uint64_t timeStamp, int runNumber, int input);
   double fetchCTPratesClasses(o2::ccdb::BasicCCDBManager* ccdb, uint64_t timeStamp, int runNumber, const std::string& className, int inputType = 1);
   double pileUpCorrection(double rate);
@@ -49,6 +80,9 @@ class ctpRateFetcher
   ctp::CTPConfiguration* mConfig = nullptr;
   ctp::CTPRunScalers* mScalers = nullptr;
   parameters::GRPLHCIFData* mLHCIFdata = nullptr;
+  bool mUseRateTables = false;
+  bool mInterpolate = false;
+  std::map<std::string, RateTable> mRateTables; // rate tables of the current run per source
 };
 } // namespace o2
 
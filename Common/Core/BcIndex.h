@@ -0,0 +1,190 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file BcIndex.h
+/// \brief Sorted index from global BC to row index, for exact, closest and range lookups
+///        Replaces the std::map<globalBC, index> built per dataframe in several tasks:
+///        the BCs are stored in two contiguous arrays and looked up by binary search,
+///        or by galloping search from a hint when the queries are ordered.
+
+#ifndef COMMON_CORE_BCINDEX_H_
+#define COMMON_CORE_BCINDEX_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+class BcIndex
+{
+ public:
+  BcIndex() = default;
+
+  /// Builds the index of all the BCs of a table
+  template <typename TBCs>
+  explicit BcIndex(TBCs const& bcs)
+  {
+    build(bcs);
+  }
+
+  /// Builds the index of all the BCs of a table
+  template <typename TBCs>
+  void build(TBCs const& bcs)
+  {
+    clear();
+    reserve(bcs.size());
+    for (const auto& bc : bcs) {
+      add(bc.globalBC(), bc.globalIndex());
+    }
+    finalize();
+  }
+
+  void clear()
+  {
+    mGlobalBCs.clear();
+    mIndices.clear();
+    mSorted = true;
+  }
+  void reserve(size_t n)
+  {
+    mGlobalBCs.reserve(n);
+    mIndices.reserve(n);
+  }
+
+  /// Adds an entry, finalize() must be called before the lookups
+  void add(uint64_t globalBC, int32_t index)
+  {
+    if (!mGlobalBCs.empty() && globalBC < mGlobalBCs.back()) {
+      mSorted = false;
+    }
+    mGlobalBCs.push_back(globalBC);
+    mIndices.push_back(index);
+  }
+
+  /// Sorts the entries if they were not added in order. For repeated BCs the last added entry is kept, as for std::map::operator[]
+  void finalize()
+  {
+    if (!mSorted) {
+      std::vector<size_t> order(mGlobalBCs.size());
+      std::iota(order.begin(), order.end(), 0);
+      std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) { return mGlobalBCs[a] < mGlobalBCs[b]; });
+      std::vector<uint64_t> globalBCs(order.size());
+      std::vector<int32_t> indices(order.size());
+      for (size_t i = 0; i < order.size(); i++) {
+        globalBCs[i] = mGlobalBCs[order[i]];
+        indices[i] = mIndices[order[i]];
+      }
+      mGlobalBCs.swap(globalBCs);
+      mIndices.swap(indices);
+      mSorted = true;
+    }
+    // remove repeated BCs, keeping the last entry
+    size_t out = 0;
+    for (size_t i = 0; i < mGlobalBCs.size(); i++) {
+      if (out > 0 && mGlobalBCs[out - 1] == mGlobalBCs[i]) {
+        mIndices[out - 1] = mIndices[i];
+        continue;
+      }
+      mGlobalBCs[out] = mGlobalBCs[i];
+      mIndices[out] = mIndices[i];
+      out++;
+    }
+    mGlobalBCs.resize(out);
+    mIndices.resize(out);
+  }
+
+  size_t size() const { return mGlobalBCs.size(); }
+  bool empty() const { return mGlobalBCs.empty(); }
+  uint64_t getGlobalBC(size_t pos) const { return mGlobalBCs[pos]; }
+  int32_t getIndex(size_t pos) const { return mIndices[pos]; }
+
+  /// Position of the first entry with BC >= globalBC
+  size_t lowerBound(uint64_t globalBC) const
+  {
+    return std::lower_bound(mGlobalBCs.begin(), mGlobalBCs.end(), globalBC) - mGlobalBCs.begin();
+  }
+
+  /// Position of the first entry with BC >= globalBC, by galloping search from the position of a previous query
+  size_t lowerBound(uint64_t globalBC, size_t hint) const
+  {
+    const size_t n = mGlobalBCs.size();
+    if (hint >= n) {
+      hint = n > 0 ? n - 1 : 0;
+    }
+    size_t lo = 0;
+    size_t hi = n;
+    if (n > 0 && mGlobalBCs[hint] < globalBC) {
+      // gallop forward
+      size_t step = 1;
+      lo = hint + 1;
+      while (hint + step < n && mGlobalBCs[hint + step] < globalBC) {
+        lo = hint + step + 1;
+        step *= 2;
+      }
+      hi = std::min(n, hint + step + 1);
+    } else if (n > 0) {
+      // gallop backward
+      size_t step = 1;
+      hi = hint + 1;
+      while (step <= hint && mGlobalBCs[hint - step] >= globalBC) {
+        hi = hint - step + 1;
+        step *= 2;
+      }
+      lo = step <= hint ? hint - step : 0;
+    }
+    return std::lower_bound(mGlobalBCs.begin() + lo, mGlobalBCs.begin() + hi, globalBC) - mGlobalBCs.begin();
+  }
+
+  /// Row index of the entry with exactly this BC, -1 if not found
+  int32_t find(uint64_t globalBC) const
+  {
+    const size_t pos = lowerBound(globalBC);
+    return (pos < mGlobalBCs.size() && mGlobalBCs[pos] == globalBC) ? mIndices[pos] : -1;
+  }
+
+  /// Position of the entry with the closest BC, the higher one for ties. The index must not be empty
+  size_t findClosestPosition(uint64_t globalBC) const
+  {
+    size_t pos = lowerBound(globalBC);
+    if (pos == mGlobalBCs.size()) {
+      return pos - 1;
+    }
+    if (pos > 0 && globalBC - mGlobalBCs[pos - 1] < mGlobalBCs[pos] - globalBC) {
+      return pos - 1;
+    }
+    return pos;
+  }
+  /// Closest BC of the index. The index must not be empty
+  uint64_t findClosestBC(uint64_t globalBC) const { return mGlobalBCs[findClosestPosition(globalBC)]; }
+  /// Row index of the closest BC. The index must not be empty
+  int32_t findClosest(uint64_t globalBC) const { return mIndices[findClosestPosition(globalBC)]; }
+
+  /// Range of positions [first, last) of the entries with minBC <= BC <= maxBC
+  std::pair<size_t, size_t> getRange(uint64_t minBC, uint64_t maxBC) const
+  {
+    const size_t first = lowerBound(minBC);
+    const size_t last = std::upper_bound(mGlobalBCs.begin() + first, mGlobalBCs.end(), maxBC) - mGlobalBCs.begin();
+    return {first, last};
+  }
+  /// Range of positions [first, last) of the entries within +/- nBCs of globalBC
+  std::pair<size_t, size_t> getRangeAround(uint64_t globalBC, uint64_t nBCs) const
+  {
+    return getRange(globalBC > nBCs ? globalBC - nBCs : 0, globalBC + nBCs);
+  }
+
+ private:
+  std::vector<uint64_t> mGlobalBCs; // sorted global BCs
+  std::vector<int32_t> mIndices;    // row index of each BC
+  bool mSorted = true;
+};
+
+#endif // COMMON_CORE_BCINDEX_H_
@@ -20,6 +20,10 @@
 #ifndef COMMON_CORE_COLLISIONASSOCIATION_H_
 #define COMMON_CORE_COLLISIONASSOCIATION_H_
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <thread>
 #include <vector>
 #include <memory>
 #include <utility>
@@ -57,6 +61,7 @@ class CollisionAssociation
   void setIncludeUnassigned(bool enable = true) { mIncludeUnassigned = enable; }
   void setFillTableOfCollIdsPerTrack(bool fill = true) { mFillTableOfCollIdsPerTrack = fill; }
   void setBcWindow(int bcWindow = 115) { mBcWindowForOneSigma = bcWindow; }
+  void setNumThreads(int nThreads = 1) { mNumThreads = nThreads > 0 ? nThreads : 1; }
 
   template <typename TTracks, typename Slice, typename Assoc, typename RevIndices>
   void runStandardAssoc(o2::aod::Collisions const& collisions,
@@ -125,153 +130,143 @@ class CollisionAssociation
                         Assoc& association,
                         RevIndices& reverseIndices)
   {
-    // cache globalBC and track time in BC for optimization
-    std::vector<int64_t> globalBC;
-    std::vector<int64_t> trackBCCache;
-    std::vector<std::pair<typename TTracks::iterator, typename TTracks::iterator>> trackIterationWindows; // continous regions in which we can count on increasing globalBC numbers
-    globalBC.reserve(tracks.size());
-    trackBCCache.reserve(tracks.size());
-    auto trackBegin = tracks.begin();
-    int lastCollisionId = 0;
-    if (tracks.size() > 0) {
-      lastCollisionId = trackBegin.collisionId();
-    }
-    auto track = trackBegin;
-    for (; track != tracks.end(); ++track) {
-      int64_t trackBC = -1;
-      if (track.has_collision()) {
-        trackBC = track.collision().bc().globalBC();
-      } else if (mIncludeUnassigned) {
-        for (const auto& ambTrack : ambiguousTracks) {
-          if constexpr (isCentralBarrel) { // FIXME: to be removed as soon as it is possible to use getId<Table>() for joined tables
-            if (ambTrack.trackId() == track.globalIndex()) {
-              if (!ambTrack.has_bc() || ambTrack.bc().size() == 0) {
-                break;
-              }
-              trackBC = ambTrack.bc().begin().globalBC();
-              break;
-            }
-          } else {
-            if (ambTrack.template getId<TTracks>() == track.globalIndex()) {
-              trackBC = ambTrack.bc().begin().globalBC();
-              break;
-            }
+    // BC of the ambiguous tracks, looked up once per track id instead of scanning the ambiguous table per track
+    std::vector<int64_t> ambiguousBC;
+    if (mIncludeUnassigned) {
+      ambiguousBC.assign(tracksUnfiltered.size(), kBcNotFound);
+      for (const auto& ambTrack : ambiguousTracks) {
+        int64_t trackId = -1;
+        if constexpr (isCentralBarrel) { // FIXME: to be removed as soon as it is possible to use getId<Table>() for joined tables
+          trackId = ambTrack.trackId();
+        } else {
+          trackId = ambTrack.template getId<TTracks>();
+        }
+        if (trackId < 0 || trackId >= static_cast<int64_t>(ambiguousBC.size()) || ambiguousBC[trackId] != kBcNotFound) {
+          continue; // the first entry of a track is used
+        }
+        if constexpr (isCentralBarrel) {
+          if (!ambTrack.has_bc() || ambTrack.bc().size() == 0) {
+            ambiguousBC[trackId] = -1;
+            continue;
           }
         }
+        ambiguousBC[trackId] = ambTrack.bc().begin().globalBC();
+      }
+    }
+
+    // cache the track quantities needed for the time compatibility, indexed by filtered index
+    const int nTracks = tracks.size();
+    std::vector<TrackTimeInfo> trackInfos(nTracks);
+    std::vector<int> sortedTracks; // tracks with a BC, sorted by their BC window position
+    sortedTracks.reserve(nTracks);
+    for (const auto& track : tracks) {
+      TrackTimeInfo& info = trackInfos[track.filteredIndex()];
+      info.globalIndex = track.globalIndex();
+      if (track.has_collision()) {
+        info.globalBC = track.collision().bc().globalBC();
+      } else if (mIncludeUnassigned && ambiguousBC[track.globalIndex()] != kBcNotFound) {
+        info.globalBC = ambiguousBC[track.globalIndex()];
       }
-      globalBC.push_back(trackBC);
-      trackBCCache.push_back(trackBC + track.trackTime() / o2::constants::lhc::LHCBunchSpacingNS);
-      // find uniform blocks
-      if ((track.collisionId() < lastCollisionId) || (lastCollisionId < 0 && track.collisionId() >= 0)) {
-        if (lastCollisionId >= 0 || mIncludeUnassigned) {
-          LOGP(debug, "Found track block from {} to {}, current id {}, last id {}", trackBegin.filteredIndex(), track.filteredIndex() - 1, track.collisionId(), lastCollisionId);
-          trackIterationWindows.push_back(std::make_pair(trackBegin, track));
+      info.windowBC = info.globalBC + track.trackTime() / o2::constants::lhc::LHCBunchSpacingNS;
+      info.trackTime = track.trackTime();
+      info.trackTimeRes = track.trackTimeRes();
+      if constexpr (isCentralBarrel) {
+        if (mUsePvAssociation && track.isPVContributor()) {
+          info.trackTime = track.collision().collisionTime();        // if PV contributor, we assume the time to be the one of the collision
+          info.trackTimeRes = o2::constants::lhc::LHCBunchSpacingNS; // 1 BC
+          info.threshold = ThresholdPvContributor;
+        } else if (TESTBIT(track.flags(), o2::aod::track::TrackTimeResIsRange)) {
+          // the track time resolution is a range, not a gaussian resolution
+          info.threshold = ThresholdRange;
+        } else {
+          info.threshold = ThresholdGaussian;
+        }
+      } else {
+        // the track is not a central track
+        if constexpr (TTracks::template contains<o2::aod::MFTTracks>()) {
+          // then the track is an MFT track, or an MFT track with additionnal joined info
+          // in this case TrackTimeResIsRange
+          info.threshold = ThresholdRange;
+        } else if constexpr (TTracks::template contains<o2::aod::FwdTracks>()) {
+          // the track is a fwd track, with a gaussian time resolution
+          info.threshold = ThresholdGaussian;
         }
-        trackBegin = track;
       }
-      lastCollisionId = track.collisionId();
+      if (info.globalBC >= 0) {
+        sortedTracks.push_back(track.filteredIndex());
+      }
     }
-    // trackIterationWindows.push_back(std::make_pair(trackBegin, tracks.end()));
-    if (lastCollisionId >= 0 || mIncludeUnassigned) {
-      LOGP(debug, "Found track block from {} to {}", trackBegin.filteredIndex(), tracks.size() - 1);
-      trackIterationWindows.push_back(std::make_pair(trackBegin, track));
+    std::stable_sort(sortedTracks.begin(), sortedTracks.end(), [&trackInfos](int a, int b) { return trackInfos[a].windowBC < trackInfos[b].windowBC; });
+    std::vector<int64_t> sortedWindowBC(sortedTracks.size());
+    for (size_t i = 0; i < sortedTracks.size(); i++) {
+      sortedWindowBC[i] = trackInfos[sortedTracks[i]].windowBC;
     }
 
-    // define vector of vectors to store indices of compatible collisions per track
-    std::vector<std::unique_ptr<std::vector<int>>> collsPerTrack(tracksUnfiltered.size());
-
-    // loop over collisions to find time-compatible tracks
-    int64_t bcOffsetMax = mBcWindowForOneSigma * mNumSigmaForTimeCompat + mTimeMargin / o2::constants::lhc::LHCBunchSpacingNS;
+    // cache the collision quantities
+    const int nCollisions = collisions.size();
+    std::vector<CollisionTimeInfo> collInfos(nCollisions);
     for (const auto& collision : collisions) {
-      const float collTime = collision.collisionTime();
-      const float collTimeRes2 = collision.collisionTimeRes() * collision.collisionTimeRes();
-      uint64_t collBC = collision.bc().globalBC();
-
-      // This is done per block to allow optimization below. Within each block the globalBC increase continously
-      for (auto& iterationWindow : trackIterationWindows) {
-        bool iteratorMoved = false;
-        const bool isAssignedTrackWindow = (iterationWindow.first != iterationWindow.second) ? iterationWindow.first.has_collision() : false;
-        for (auto track = iterationWindow.first; track != iterationWindow.second; ++track) {
-          int64_t trackBC = globalBC[track.filteredIndex()];
-          if (trackBC < 0) {
-            continue;
-          }
-
-          // Optimization to avoid looping over the full track list each time. This builds on that tracks are sorted by BCs (which they should be because collisions are sorted by BCs)
-          const int64_t bcOffset = trackBC - (int64_t)collBC;
-          if constexpr (isCentralBarrel) {
-            // only for blocks with collision association
-            if (isAssignedTrackWindow) {
-              constexpr int margin = 200;
-              if (!iteratorMoved && bcOffset > -bcOffsetMax - margin) {
-                iterationWindow.first.setCursor(track.filteredIndex());
-                iteratorMoved = true;
-                LOGP(debug, "Moving iterator begin {}", track.filteredIndex());
-              } else if (bcOffset > bcOffsetMax + margin) {
-                LOGP(debug, "Stopping iterator {}", track.filteredIndex());
-                break;
-              }
-            }
-          }
-
-          int64_t bcOffsetWindow = trackBCCache[track.filteredIndex()] - (int64_t)collBC;
-          if (std::abs(bcOffsetWindow) > bcOffsetMax) {
-            continue;
-          }
+      CollisionTimeInfo& info = collInfos[collision.globalIndex()];
+      info.globalIndex = collision.globalIndex();
+      info.globalBC = collision.bc().globalBC();
+      info.collTime = collision.collisionTime();
+      info.collTimeRes2 = collision.collisionTimeRes() * collision.collisionTimeRes();
+    }
 
-          float trackTime = 0;
-          float trackTimeRes = 0;
-          if constexpr (isCentralBarrel) {
-            if (mUsePvAssociation && track.isPVContributor()) {
-              trackTime = track.collision().collisionTime();        // if PV contributor, we assume the time to be the one of the collision
-              trackTimeRes = o2::constants::lhc::LHCBunchSpacingNS; // 1 BC
-            } else {
-              trackTime = track.trackTime();
-              trackTimeRes = track.trackTimeRes();
-            }
-          } else {
-            trackTime = track.trackTime();
-            trackTimeRes = track.trackTimeRes();
+    // sweep over the collisions: the candidate tracks of each collision are the contiguous range of the sorted BC windows
+    // within the maximum offset, the chunks of collisions are independent and can be processed in parallel
+    const int64_t bcOffsetMax = mBcWindowForOneSigma * mNumSigmaForTimeCompat + mTimeMargin / o2::constants::lhc::LHCBunchSpacingNS;
+    auto matchChunk = [&](int firstColl, int lastColl, std::vector<std::pair<int, int>>& matches) {
+      std::vector<int> compatible;
+      for (int iColl = firstColl; iColl < lastColl; iColl++) {
+        const CollisionTimeInfo& coll = collInfos[iColl];
+        compatible.clear();
+        auto it = std::lower_bound(sortedWindowBC.begin(), sortedWindowBC.end(), coll.globalBC - bcOffsetMax);
+        for (; it != sortedWindowBC.end() && *it <= coll.globalBC + bcOffsetMax; ++it) {
+          const int iTrack = sortedTracks[it - sortedWindowBC.begin()];
+          if (isTimeCompatible(coll, trackInfos[iTrack])) {
+            compatible.push_back(iTrack);
           }
+        }
+        // keep the track order of the input table within each collision
+        std::sort(compatible.begin(), compatible.end());
+        for (const int iTrack : compatible) {
+          matches.emplace_back(iColl, iTrack);
+        }
+      }
+    };
 
-          const float deltaTime = trackTime - collTime + bcOffset * o2::constants::lhc::LHCBunchSpacingNS;
-          float sigmaTimeRes2 = collTimeRes2 + trackTimeRes * trackTimeRes;
-          LOGP(debug, "collision time={}, collision time res={}, track time={}, track time res={}, bc collision={}, bc track={}, delta time={}", collTime, collision.collisionTimeRes(), track.trackTime(), track.trackTimeRes(), collBC, trackBC, deltaTime);
+    const int nChunks = std::max(1, std::min(mNumThreads, nCollisions / kMinCollisionsPerChunk));
+    std::vector<std::vector<std::pair<int, int>>> chunkMatches(nChunks);
+    if (nChunks == 1) {
+      matchChunk(0, nCollisions, chunkMatches[0]);
+    } else {
+      LOGP(debug, "Associating {} collisions in {} parallel chunks", nCollisions, nChunks);
+      std::vector<std::thread> threads;
+      threads.reserve(nChunks);
+      for (int iChunk = 0; iChunk < nChunks; iChunk++) {
+        threads.emplace_back(matchChunk, static_cast<int>(static_cast<int64_t>(nCollisions) * iChunk / nChunks), static_cast<int>(static_cast<int64_t>(nCollisions) * (iChunk + 1) / nChunks), std::ref(chunkMatches[iChunk]));
+      }
+      for (auto& thread : threads) {
+        thread.join();
+      }
+    }
 
-          float thresholdTime = 0.;
-          if constexpr (isCentralBarrel) {
-            if (mUsePvAssociation && track.isPVContributor()) {
-              thresholdTime = trackTimeRes;
-            } else if (TESTBIT(track.flags(), o2::aod::track::TrackTimeResIsRange)) {
-              // the track time resolution is a range, not a gaussian resolution
-              thresholdTime = trackTimeRes + mNumSigmaForTimeCompat * std::sqrt(collTimeRes2) + mTimeMargin;
-            } else {
-              thresholdTime = mNumSigmaForTimeCompat * std::sqrt(sigmaTimeRes2) + mTimeMargin;
-            }
-          } else {
-            // the track is not a central track
-            if constexpr (TTracks::template contains<o2::aod::MFTTracks>()) {
-              // then the track is an MFT track, or an MFT track with additionnal joined info
-              // in this case TrackTimeResIsRange
-              thresholdTime = trackTimeRes + mNumSigmaForTimeCompat * std::sqrt(collTimeRes2) + mTimeMargin;
-            } else if constexpr (TTracks::template contains<o2::aod::FwdTracks>()) {
-              // the track is a fwd track, with a gaussian time resolution
-              thresholdTime = mNumSigmaForTimeCompat * std::sqrt(sigmaTimeRes2) + mTimeMargin;
-            }
-          }
+    // define vector of vectors to store indices of compatible collisions per track
+    std::vector<std::unique_ptr<std::vector<int>>> collsPerTrack(tracksUnfiltered.size());
 
-          if (std::abs(deltaTime) < thresholdTime) {
-            const auto collIdx = collision.globalIndex();
-            const auto trackIdx = track.globalIndex();
-            LOGP(debug, "Filling track id {} for coll id {}", trackIdx, collIdx);
-            association(collIdx, trackIdx);
-            if (mFillTableOfCollIdsPerTrack) {
-              if (collsPerTrack[trackIdx] == nullptr) {
-                collsPerTrack[trackIdx] = std::make_unique<std::vector<int>>();
-              }
-              collsPerTrack[trackIdx].get()->push_back(collIdx);
-            }
+    // fill the association in collision order
+    for (const auto& matches : chunkMatches) {
+      for (const auto& [iColl, iTrack] : matches) {
+        const auto collIdx = collInfos[iColl].globalIndex;
+        const auto trackIdx = trackInfos[iTrack].globalIndex;
+        LOGP(debug, "Filling track id {} for coll id {}", trackIdx, collIdx);
+        association(collIdx, trackIdx);
+        if (mFillTableOfCollIdsPerTrack) {
+          if (collsPerTrack[trackIdx] == nullptr) {
+            collsPerTrack[trackIdx] = std::make_unique<std::vector<int>>();
           }
+          collsPerTrack[trackIdx].get()->push_back(collIdx);
         }
       }
     }
@@ -291,6 +286,54 @@ class CollisionAssociation
   }
 
  private:
+  static constexpr int64_t kBcNotFound = -2;        // ambiguous track not found
+  static constexpr int kMinCollisionsPerChunk = 50; // minimum number of collisions to justify a parallel chunk
+
+  enum TimeThreshold {
+    ThresholdNone = 0,      // not a supported track type, never compatible
+    ThresholdPvContributor, // PV contributor, the collision time is assigned to the track
+    ThresholdRange,         // the track time resolution is a range
+    ThresholdGaussian       // the track time resolution is gaussian
+  };
+
+  struct TrackTimeInfo {
+    int64_t globalIndex = -1;
+    int64_t globalBC = -1;
+    int64_t windowBC = -1;
+    float trackTime = 0.f;
+    float trackTimeRes = 0.f;
+    TimeThreshold threshold = ThresholdNone;
+  };
+
+  struct CollisionTimeInfo {
+    int64_t globalIndex = -1;
+    int64_t globalBC = 0;
+    float collTime = 0.f;
+    float collTimeRes2 = 0.f;
+  };
+
+  bool isTimeCompatible(const CollisionTimeInfo& coll, const TrackTimeInfo& track) const
+  {
+    const int64_t bcOffset = track.globalBC - coll.globalBC;
+    const float deltaTime = track.trackTime - coll.collTime + bcOffset * o2::constants::lhc::LHCBunchSpacingNS;
+    float thresholdTime = 0.;
+    switch (track.threshold) {
+      case ThresholdPvContributor:
+        thresholdTime = track.trackTimeRes;
+        break;
+      case ThresholdRange:
+        thresholdTime = track.trackTimeRes + mNumSigmaForTimeCompat * std::sqrt(coll.collTimeRes2) + mTimeMargin;
+        break;
+      case ThresholdGaussian:
+        thresholdTime = mNumSigmaForTimeCompat * std::sqrt(coll.collTimeRes2 + track.trackTimeRes * track.trackTimeRes) + mTimeMargin;
+        break;
+      default:
+        break;
+    }
+    return std::abs(deltaTime) < thresholdTime;
+  }
+
+  int mNumThreads{1};                                                                // number of threads for the time association
   float mNumSigmaForTimeCompat{4.};                                                  // number of sigma for time compatibility
   float mTimeMargin{500.};                                                           // additional time margin in ns
   int mTrackSelection{o2::aod::track_association::TrackSelection::GlobalTrackWoDCA}; // track selection for central barrel tracks (standard association only)
@@ -12,6 +12,14 @@
 #ifndef ANALYSIS_CORE_EVENTMIXING_H_
 #define ANALYSIS_CORE_EVENTMIXING_H_
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "Framework/Logger.h"
+
 namespace eventmixing
 {
 /// Calculate hash for an element based on 2 properties and their bins.
@@ -33,18 +41,238 @@ static int getMixingBin(const T1& vtxBins, const T1& multBins, const T2& vtx, co
     return -1;
   }
 
-  for (unsigned int i = 1; i < vtxBins.size(); i++) {
-    if (vtx < vtxBins.at(i)) {
-      for (unsigned int j = 1; j < multBins.size(); j++) {
-        if (mult < multBins.at(j)) {
-          return i + j * (vtxBins.size() + 1);
-        }
-      }
-    }
+  // first upper edge above the value, the bin edges are sorted
+  const unsigned int i = std::upper_bound(vtxBins.begin(), vtxBins.end(), vtx) - vtxBins.begin();
+  const unsigned int j = std::upper_bound(multBins.begin(), multBins.end(), mult) - multBins.begin();
+  if (i < vtxBins.size() && j < multBins.size()) {
+    return i + j * (vtxBins.size() + 1);
   }
   // overflow
   return -1;
 }
+
+/// \brief Binning of the events in N variables, with constant-time bin lookup
+/// The binning of each variable follows the ConfigurableAxis convention: {VARIABLE_WIDTH, e0, e1, ...} or {nBins, min, max}.
+/// Variable-width binnings are looked up in a uniform table of cells finer than the narrowest bin.
+/// Values outside of the binning give -1
+template <int N>
+class MixingBinning
+{
+ public:
+  static constexpr int NVariables = N;
+
+  MixingBinning() = default;
+
+  /// Sets the binning of one variable
+  /// \param iVar index of the variable
+  /// \param binning bin edges in the ConfigurableAxis convention
+  void setBinning(const int iVar, const std::vector<double>& binning)
+  {
+    if (iVar < 0 || iVar >= N) {
+      LOG(fatal) << "MixingBinning: variable index " << iVar << " out of range";
+    }
+    Axis& axis = mAxes[iVar];
+    axis.edges.clear();
+    axis.lut.clear();
+    if (binning.size() > 1 && binning[0] == kVariableWidth) {
+      axis.edges.assign(binning.begin() + 1, binning.end());
+    } else if (binning.size() == 3 && binning[0] > 0) {
+      const int nBins = static_cast<int>(binning[0]);
+      for (int i = 0; i <= nBins; i++) {
+        axis.edges.push_back(binning[1] + i * (binning[2] - binning[1]) / nBins);
+      }
+    }
+    if (axis.edges.size() < 2 || !std::is_sorted(axis.edges.begin(), axis.edges.end())) {
+      LOG(fatal) << "MixingBinning: invalid binning for variable " << iVar;
+    }
+    axis.min = axis.edges.front();
+    double minWidth = axis.edges.back() - axis.edges.front();
+    for (size_t i = 1; i < axis.edges.size(); i++) {
+      minWidth = std::min(minWidth, axis.edges[i] - axis.edges[i - 1]);
+    }
+    const int nCells = std::min(kMaxLutCells, static_cast<int>(std::ceil((axis.edges.back() - axis.min) / minWidth)));
+    axis.invCellWidth = nCells / (axis.edges.back() - axis.min);
+    axis.lut.resize(nCells + 1);
+    for (int c = 0; c <= nCells; c++) {
+      const double x = axis.min + c / axis.invCellWidth;
+      axis.lut[c] = std::max(0, static_cast<int>(std::upper_bound(axis.edges.begin(), axis.edges.end(), x) - axis.edges.begin()) - 1);
+    }
+    mNBins = 1;
+    for (int i = 0; i < N; i++) {
+      mStrides[i] = mNBins;
+      mNBins *= std::max<int>(1, static_cast<int>(mAxes[i].edges.size()) - 1);
+    }
+  }
+
+  /// Gets the number of bins of one variable
+  int getNBins(const int iVar) const { return static_cast<int>(mAxes[iVar].edges.size()) - 1; }
+  /// Gets the total number of bins
+  int getNBins() const { return mNBins; }
+
+  /// Gets the bin of one variable, -1 if out of range
+  int getAxisBin(const int iVar, const double value) const
+  {
+    const Axis& axis = mAxes[iVar];
+    if (!(value >= axis.min) || value >= axis.edges.back()) {
+      return -1;
+    }
+    int bin = axis.lut[static_cast<int>((value - axis.min) * axis.invCellWidth)];
+    // the cell can contain a bin edge, usually at most one bin away
+    while (bin + 1 < static_cast<int>(axis.edges.size()) - 1 && value >= axis.edges[bin + 1]) {
+      bin++;
+    }
+    while (bin > 0 && value < axis.edges[bin]) {
+      bin--;
+    }
+    return bin;
+  }
+
+  /// Gets the global bin of an event, -1 if any of the values is out of range
+  template <typename... Ts>
+  int getBin(const Ts... values) const
+  {
+    static_assert(sizeof...(Ts) == N, "MixingBinning: wrong number of values");
+    const std::array<double, N> v{static_cast<double>(values)...};
+    int globalBin = 0;
+    for (int i = 0; i < N; i++) {
+      const int bin = getAxisBin(i, v[i]);
+      if (bin < 0) {
+        return -1;
+      }
+      globalBin += bin * mStrides[i];
+    }
+    return globalBin;
+  }
+
+ private:
+  static constexpr double kVariableWidth = 0.; // same as VARIABLE_WIDTH of ConfigurableAxis
+  static constexpr int kMaxLutCells = 10000;
+
+  struct Axis {
+    std::vector<double> edges;
+    std::vector<int> lut;
+    double min = 0.;
+    double invCellWidth = 0.;
+  };
+  std::array<Axis, N> mAxes;
+  std::array<int, N> mStrides{};
+  int mNBins = 0;
+};
+
+/// \brief Pool of events for event mixing, with a ring buffer of fixed depth per bin
+/// The tracks of each pooled event are stored contiguously, the buffers are recycled when an event is replaced,
+/// hence the memory is bounded by nBins x depth x the largest events and no allocation happens once the pool is filled.
+/// The pool can be kept as a member of a task to mix across dataframes.
+/// \tparam TKey identifier of the events (e.g. pair of dataframe and collision index)
+/// \tparam TTrack compact structure holding what is needed of the tracks for the mixing
+template <typename TKey, typename TTrack>
+class EventMixingPool
+{
+ public:
+  EventMixingPool() = default;
+  EventMixingPool(const int nBins, const int depth, const int maxTracksPerEvent = -1) { init(nBins, depth, maxTracksPerEvent); }
+
+  /// Initialises the pool
+  /// \param nBins number of mixing bins
+  /// \param depth number of events kept per bin
+  /// \param maxTracksPerEvent maximum number of tracks stored per event, negative for no limit
+  void init(const int nBins, const int depth, const int maxTracksPerEvent = -1)
+  {
+    if (nBins <= 0 || depth <= 0) {
+      LOG(fatal) << "EventMixingPool: invalid number of bins " << nBins << " or depth " << depth;
+    }
+    mNBins = nBins;
+    mDepth = depth;
+    mMaxTracksPerEvent = maxTracksPerEvent;
+    mEvents.assign(static_cast<size_t>(nBins) * depth, Event{});
+    mNEvents.assign(nBins, 0);
+    mNext.assign(nBins, 0);
+    mCurrent.clear();
+  }
+
+  /// Adds a track to the event being processed
+  void addTrack(const TTrack& track)
+  {
+    if (mMaxTracksPerEvent < 0 || static_cast<int>(mCurrent.size()) < mMaxTracksPerEvent) {
+      mCurrent.push_back(track);
+    }
+  }
+  template <typename... Args>
+  void emplaceTrack(Args&&... args)
+  {
+    if (mMaxTracksPerEvent < 0 || static_cast<int>(mCurrent.size()) < mMaxTracksPerEvent) {
+      mCurrent.emplace_back(std::forward<Args>(args)...);
+    }
+  }
+  /// Tracks of the event being processed
+  const std::vector<TTrack>& getCurrentTracks() const { return mCurrent; }
+  /// Discards the tracks of the event being processed
+  void resetCurrentEvent() { mCurrent.clear(); }
+
+  /// Stores the event being processed in the pool, replacing the oldest event of the bin if full.
+  /// To be called after mixing the event being processed with the pool
+  void addEvent(const int bin, const TKey& key)
+  {
+    if (bin < 0 || bin >= mNBins) {
+      mCurrent.clear();
+      return;
+    }
+    Event& event = mEvents[static_cast<size_t>(bin) * mDepth + mNext[bin]];
+    event.key = key;
+    event.tracks.swap(mCurrent); // no copy, the buffer of the replaced event is reused
+    mCurrent.clear();
+    mNext[bin] = (mNext[bin] + 1) % mDepth;
+    mNEvents[bin] = std::min(mNEvents[bin] + 1, mDepth);
+  }
+
+  /// Number of events stored in a bin
+  int getNEvents(const int bin) const { return (bin < 0 || bin >= mNBins) ? 0 : mNEvents[bin]; }
+  /// Key of the i-th event of a bin, from the oldest to the most recent
+  const TKey& getEventKey(const int bin, const int i) const { return event(bin, i).key; }
+  /// Tracks of the i-th event of a bin, from the oldest to the most recent
+  const std::vector<TTrack>& getTracks(const int bin, const int i) const { return event(bin, i).tracks; }
+
+  /// Empties the pool, keeping the allocated buffers
+  void clear()
+  {
+    std::fill(mNEvents.begin(), mNEvents.end(), 0);
+    std::fill(mNext.begin(), mNext.end(), 0);
+    for (auto& e : mEvents) {
+      e.tracks.clear();
+    }
+    mCurrent.clear();
+  }
+
+  /// Memory allocated for the stored tracks, in bytes
+  size_t getMemoryFootprint() const
+  {
+    size_t size = mCurrent.capacity() * sizeof(TTrack);
+    for (const auto& e : mEvents) {
+      size += e.tracks.capacity() * sizeof(TTrack);
+    }
+    return size;
+  }
+
+ private:
+  struct Event {
+    TKey key{};
+    std::vector<TTrack> tracks;
+  };
+
+  const Event& event(const int bin, const int i) const
+  {
+    const int oldest = mNEvents[bin] < mDepth ? 0 : mNext[bin];
+    return mEvents[static_cast<size_t>(bin) * mDepth + (oldest + i) % mDepth];
+  }
+
+  int mNBins = 0;
+  int mDepth = 0;
+  int mMaxTracksPerEvent = -1;
+  std::vector<Event> mEvents; // nBins x depth events
+  std::vector<int> mNEvents;  // number of events stored per bin
+  std::vector<int> mNext;     // slot of the next event per bin
+  std::vector<TTrack> mCurrent;
+};
 }; // namespace eventmixing
 
 #endif /* ANALYSIS_CORE_EVENTMIXING_H_ */
@@ -106,6 +106,32 @@ bool MetadataHelper::isMC() const
   return b;
 }
 
+MetadataHelper::Property MetadataHelper::run3() const
+{
+  if (!mIsInitialized || mMetadata.at("Run") == "undefined") {
+    return Property::kUndefined;
+  }
+  return mMetadata.at("Run") == "3" ? Property::kYes : Property::kNo;
+}
+
+MetadataHelper::Property MetadataHelper::mc() const
+{
+  if (!mIsInitialized || mMetadata.at("DataType") == "undefined") {
+    return Property::kUndefined;
+  }
+  return mMetadata.at("DataType") == "MC" ? Property::kYes : Property::kNo;
+}
+
+std::string MetadataHelper::getRecoPass() const
+{
+  const Property isMC = mc();
+  if (isMC == Property::kUndefined) {
+    return "";
+  }
+  const std::string pass = mMetadata.at(isMC == Property::kYes ? "AnchorPassName" : "RecoPassName");
+  return pass == "undefined" ? "" : pass;
+}
+
 bool MetadataHelper::isInitialized() const
 {
   if (mIsInitialized) {
@@ -23,6 +23,11 @@
 #include "Framework/ConfigContext.h"
 
 struct MetadataHelper {
+  /// Value of a property of the data, which is undefined if the metadata does not provide it
+  enum class Property : int { kUndefined = -1,
+                              kNo = 0,
+                              kYes = 1 };
+
   /// @brief Constructor for the MetadataHelper. Defines the all the metadata keys that will be looked for and accessible
   MetadataHelper();
 
@@ -45,6 +50,18 @@ struct MetadataHelper {
   /// @return 1 if the data is from MC, 0 if it is not, -1 if it is not defined
   bool isMC() const;
 
+  /// Function to check if the data is from Run 3, without requiring the metadata to be initialized or defined
+  /// @return kYes or kNo if the run is defined in the metadata, kUndefined otherwise
+  Property run3() const;
+
+  /// Function to check if the data is from MC, without requiring the metadata to be initialized or defined
+  /// @return kYes or kNo if the data type is defined in the metadata, kUndefined otherwise
+  Property mc() const;
+
+  /// Function to get the pass of the reconstruction, that of the anchor for MC
+  /// @return the name of the pass, empty if it is not defined in the metadata
+  std::string getRecoPass() const;
+
   /// @brief Function to check if the data has been correctly initialized
   /// @return true if the data has been initialized, false otherwise
   bool isInitialized() const;
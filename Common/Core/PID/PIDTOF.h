@@ -19,6 +19,7 @@
 #ifndef COMMON_CORE_PID_PIDTOF_H_
 #define COMMON_CORE_PID_PIDTOF_H_
 
+#include <array>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -500,6 +501,128 @@ class ExpTimes
   }
 };
 
+/// \brief SoA batch kernel for the TOF expected times, resolutions and separations of all mass hypotheses
+/// The track columns needed for the response (momentum, length, TOF signal, event time) are copied into contiguous arrays,
+/// the hypotheses are then computed in one branch-free loop per hypothesis over the arrays
+class ExpTimesBatch
+{
+ public:
+  static constexpr int NHypotheses = 9;
+
+  ExpTimesBatch() = default;
+  ~ExpTimesBatch() = default;
+
+  void clear()
+  {
+    mP.clear();
+    mExpMom.clear();
+    mLength.clear();
+    mTOFSignal.clear();
+    mEvTime.clear();
+    mEvTimeErr.clear();
+    mTimeShift.clear();
+    mHasTOF.clear();
+    mHasCollision.clear();
+  }
+
+  void reserve(const std::size_t size)
+  {
+    mP.reserve(size);
+    mExpMom.reserve(size);
+    mLength.reserve(size);
+    mTOFSignal.reserve(size);
+    mEvTime.reserve(size);
+    mEvTimeErr.reserve(size);
+    mTimeShift.reserve(size);
+    mHasTOF.reserve(size);
+    mHasCollision.reserve(size);
+  }
+
+  std::size_t size() const { return mP.size(); }
+
+  /// Loads the columns of a track, applying the momentum and time shift corrections of the parameters
+  /// \param parameters Detector response parameters
+  /// \param track Track of interest
+  template <typename ParamType, typename TrackType>
+  void push(const ParamType& parameters, const TrackType& track)
+  {
+    mP.push_back(track.p());
+    mLength.push_back(track.length());
+    mTOFSignal.push_back(track.tofSignal());
+    mEvTime.push_back(track.tofEvTime());
+    mEvTimeErr.push_back(track.tofEvTimeErr());
+    mHasTOF.push_back(track.hasTOF());
+    mHasCollision.push_back(track.has_collision());
+    if (!track.hasTOF()) {
+      mExpMom.push_back(1.f);
+      mTimeShift.push_back(0.f);
+      return;
+    }
+    const float shift = 1.f + track.sign() * parameters.getMomentumChargeShift(track.eta());
+    if (track.trackType() == o2::aod::track::Run2Track) {
+      mExpMom.push_back(track.tofExpMom() * kCSPEDDInv / shift);
+      mTimeShift.push_back(0.f);
+    } else {
+      mExpMom.push_back(track.tofExpMom() / shift);
+      mTimeShift.push_back(parameters.getTimeShift(track.eta(), track.sign()));
+    }
+  }
+
+  /// Computes the expected resolution and the separation of the loaded tracks in [first, last) for the given hypotheses
+  /// \param parameters Detector response parameters
+  /// \param hypotheses list of mass hypotheses to compute
+  template <typename ParamType>
+  void compute(const ParamType& parameters, const std::vector<int>& hypotheses, const std::size_t first, const std::size_t last)
+  {
+    for (const int& id : hypotheses) {
+      mExpSigma[id].resize(size());
+      mSeparation[id].resize(size());
+      const float massZ = o2::track::pid_constants::sMasses2Z[id];
+      const float massZSquared = massZ * massZ;
+      // Resolution parameters: pion parameters are used up to the pion mass, then kaon and proton ones
+      const int iPar = id <= o2::track::PID::Pion ? 0 : (id == o2::track::PID::Kaon ? 5 : 9);
+      const int iParTrk = id <= o2::track::PID::Pion ? 3 : (id == o2::track::PID::Kaon ? 8 : 12);
+      const float par0 = parameters[iPar];
+      const float par1 = parameters[iPar + 1];
+      const float par2 = parameters[iPar + 2];
+      const float parTrk2 = parameters[iParTrk] * parameters[iParTrk];
+      const float parTime2 = parameters[4] * parameters[4];
+      float* expSigma = mExpSigma[id].data();
+      float* separation = mSeparation[id].data();
+      for (std::size_t i = first; i < last; ++i) {
+        const float mom = mP[i];
+        const float expMom = mExpMom[i];
+        const float expTime = mLength[i] * std::sqrt(massZSquared + expMom * expMom) / (kCSPEED * expMom) + mTimeShift[i];
+        const float dpp = par0 + par1 * mom + par2 * massZ / mom;
+        const float sigma = dpp * mTOFSignal[i] / (1.f + mom * mom / massZSquared);
+        const float reso = std::sqrt(sigma * sigma + parTrk2 / (mom * mom) + parTime2 + mEvTimeErr[i] * mEvTimeErr[i]);
+        const float resolution = mom > 0.f ? reso : -999.f;
+        const float nSigma = mHasTOF[i] ? (mTOFSignal[i] - mEvTime[i] - expTime) / resolution : defaultReturnValue;
+        expSigma[i] = mHasCollision[i] ? resolution : -999.f;
+        separation[i] = mHasCollision[i] ? nSigma : -999.f;
+      }
+    }
+  }
+
+  float getExpectedSigma(const int id, const std::size_t i) const { return mExpSigma[id][i]; }
+  float getSeparation(const int id, const std::size_t i) const { return mSeparation[id][i]; }
+
+ private:
+  // Input columns
+  std::vector<float> mP;
+  std::vector<float> mExpMom; // TOF expected momentum corrected for the charge shift
+  std::vector<float> mLength;
+  std::vector<float> mTOFSignal;
+  std::vector<float> mEvTime;
+  std::vector<float> mEvTimeErr;
+  std::vector<float> mTimeShift;    // post-calibration time shift
+  std::vector<uint8_t> mHasTOF;
+  std::vector<uint8_t> mHasCollision; // tracks without collision have no event time
+  // Outputs per hypothesis
+  std::array<std::vector<float>, NHypotheses> mExpSigma;
+  std::array<std::vector<float>, NHypotheses> mSeparation;
+};
+
 /// \brief Class to convert the trackTime to the tofSignal used for PID
 template <typename TrackType>
 class TOFSignal
@@ -17,6 +17,7 @@
 #ifndef COMMON_CORE_PID_TPCPIDRESPONSE_H_
 #define COMMON_CORE_PID_TPCPIDRESPONSE_H_
 
+#include <algorithm>
 #include <array>
 #include <vector>
 #include <cmath>
@@ -29,6 +30,80 @@
 namespace o2::pid::tpc
 {
 
+/// \brief Lookup table of the BetheBlochAleph parametrisation in log(beta*gamma), with linear interpolation
+class BetheBlochLookupTable
+{
+ public:
+  BetheBlochLookupTable() = default;
+  ~BetheBlochLookupTable() = default;
+
+  /// Builds the table for a set of parameters, refining the binning until the interpolation error is below the bound
+  /// \param params are the 5 parameters of the BetheBlochAleph parametrisation
+  /// \param maxRelError is the maximum relative interpolation error accepted, checked at the bin centres
+  /// \param bgMin lower beta*gamma of the table, below the exact parametrisation is used
+  /// \param bgMax upper beta*gamma of the table, above the exact parametrisation is used
+  void build(const std::array<float, 5>& params, const float maxRelError = 1.e-4f, const float bgMin = 0.05f, const float bgMax = 1.e5f)
+  {
+    mParams = params;
+    mLogMin = std::log(bgMin);
+    mLogMax = std::log(bgMax);
+    for (int nBins = NBinsStart; nBins <= NBinsMax; nBins *= 2) {
+      const float step = (mLogMax - mLogMin) / nBins;
+      mInvStep = 1.f / step;
+      mTable.resize(nBins + 1);
+      for (int i = 0; i <= nBins; i++) {
+        mTable[i] = exact(std::exp(mLogMin + i * step));
+      }
+      mMaxRelError = 0.f;
+      for (int i = 0; i < nBins; i++) {
+        const float bg = std::exp(mLogMin + (i + 0.5f) * step);
+        const float reference = exact(bg);
+        if (reference != 0.f) {
+          mMaxRelError = std::max(mMaxRelError, std::abs(eval(bg) - reference) / std::abs(reference));
+        }
+      }
+      if (mMaxRelError <= maxRelError) {
+        break;
+      }
+    }
+    if (mMaxRelError > maxRelError) {
+      LOGP(warning, "Bethe-Bloch lookup table: relative error {} above the requested bound {} with {} bins", mMaxRelError, maxRelError, mTable.size() - 1);
+    } else {
+      LOGP(info, "Bethe-Bloch lookup table built with {} bins, max relative error {}", mTable.size() - 1, mMaxRelError);
+    }
+  }
+
+  /// Tells whether the table was built for the given parameters
+  bool matches(const std::array<float, 5>& params) const { return !mTable.empty() && params == mParams; }
+  bool isBuilt() const { return !mTable.empty(); }
+  float getMaxRelError() const { return mMaxRelError; }
+
+  /// Evaluates the parametrisation, by interpolation if beta*gamma is inside the table
+  float eval(const float bg) const
+  {
+    const float x = (std::log(bg) - mLogMin) * mInvStep;
+    if (mTable.empty() || !(x >= 0.f) || x >= static_cast<float>(mTable.size() - 1)) {
+      return exact(bg);
+    }
+    const int i = static_cast<int>(x);
+    const float w = x - i;
+    return mTable[i] + w * (mTable[i + 1] - mTable[i]);
+  }
+
+ private:
+  static constexpr int NBinsStart = 1024;
+  static constexpr int NBinsMax = 1 << 20;
+
+  float exact(const float bg) const { return o2::tpc::BetheBlochAleph(bg, mParams[0], mParams[1], mParams[2], mParams[3], mParams[4]); }
+
+  std::array<float, 5> mParams = {0.f, 0.f, 0.f, 0.f, 0.f};
+  std::vector<float> mTable;
+  float mLogMin = 0.f;
+  float mLogMax = 0.f;
+  float mInvStep = 0.f;
+  float mMaxRelError = 0.f;
+};
+
 /// \brief Class to handle the TPC PID response
 
 class Response
@@ -86,6 +161,17 @@ class Response
   /// Gets relative dEdx resolution contribution due to relative pt resolution
   float GetRelativeResolutiondEdx(const float p, const float mass, const float charge, const float resol) const;
 
+  /// Precomputes the lookup tables of the Bethe-Bloch parametrisation (in beta*gamma) and of the cluster-dependent resolution terms
+  /// To be called once per parameter object, e.g. after each CCDB update. The tables are not streamed
+  /// \param maxRelError is the maximum relative interpolation error accepted for the Bethe-Bloch table
+  void BuildLookupTables(const float maxRelError = 1.e-4f);
+  void ClearLookupTables()
+  {
+    mBetheBlochLut = BetheBlochLookupTable{};
+    mUseLookupTables = false;
+  }
+  bool GetUseLookupTables() const { return mUseLookupTables; }
+
   void PrintAll() const;
 
  private:
@@ -98,6 +184,22 @@ class Response
   bool mUseDefaultResolutionParam = true;
   float nClNorm = 152.f;
 
+  // Transient lookup tables
+  static constexpr int NClustersMax = 256;
+  bool mUseLookupTables = false;                              //! switch to use the lookup tables
+  BetheBlochLookupTable mBetheBlochLut;                      //! Bethe-Bloch parametrisation in beta*gamma
+  std::array<float, NClustersMax> mNClDefaultResolution = {}; //! sqrt(1 + p1 / nCl) of the default resolution parametrisation
+  std::array<float, NClustersMax> mNClSqrtNorm = {};         //! sqrt(nClNorm / nCl) of the full resolution parametrisation
+
+  /// Bethe-Bloch parametrisation, interpolated in the lookup table if enabled
+  float BetheBloch(const float bg) const
+  {
+    if (mUseLookupTables) {
+      return mBetheBlochLut.eval(bg);
+    }
+    return o2::tpc::BetheBlochAleph(bg, mBetheBlochParams[0], mBetheBlochParams[1], mBetheBlochParams[2], mBetheBlochParams[3], mBetheBlochParams[4]);
+  }
+
   ClassDefNV(Response, 3);
 
 }; // class Response
@@ -109,7 +211,7 @@ inline float Response::GetExpectedSignal(const TrackType& track, const o2::track
   if (!track.hasTPC()) {
     return -999.f;
   }
-  const float bethe = mMIP * o2::tpc::BetheBlochAleph(track.tpcInnerParam() / o2::track::pid_constants::sMasses[id], mBetheBlochParams[0], mBetheBlochParams[1], mBetheBlochParams[2], mBetheBlochParams[3], mBetheBlochParams[4]) * std::pow(static_cast<float>(o2::track::pid_constants::sCharges[id]), mChargeFactor);
+  const float bethe = mMIP * BetheBloch(track.tpcInnerParam() / o2::track::pid_constants::sMasses[id]) * std::pow(static_cast<float>(o2::track::pid_constants::sCharges[id]), mChargeFactor);
   return bethe >= 0.f ? bethe : -999.f;
 }
 
@@ -122,7 +224,9 @@ inline float Response::GetExpectedSigma(const CollisionType& collision, const Tr
   }
   float resolution = 0.;
   if (mUseDefaultResolutionParam) {
-    const float reso = GetExpectedSignal(track, id) * mResolutionParamsDefault[0] * (static_cast<float>(track.tpcNClsFound()) > 0 ? std::sqrt(1. + mResolutionParamsDefault[1] / static_cast<float>(track.tpcNClsFound())) : 1.f);
+    const int nCl = track.tpcNClsFound();
+    const float nClFactor = (mUseLookupTables && nCl < NClustersMax) ? mNClDefaultResolution[nCl > 0 ? nCl : 0] : (static_cast<float>(nCl) > 0 ? std::sqrt(1. + mResolutionParamsDefault[1] / static_cast<float>(nCl)) : 1.f);
+    const float reso = GetExpectedSignal(track, id) * mResolutionParamsDefault[0] * nClFactor;
     reso >= 0.f ? resolution = reso : resolution = -999.f;
   } else {
 
@@ -130,10 +234,12 @@ inline float Response::GetExpectedSigma(const CollisionType& collision, const Tr
     const double p = track.tpcInnerParam();
     const double mass = o2::track::pid_constants::sMasses[id];
     const double bg = p / mass;
-    const double dEdx = o2::tpc::BetheBlochAleph(static_cast<float>(bg), mBetheBlochParams[0], mBetheBlochParams[1], mBetheBlochParams[2], mBetheBlochParams[3], mBetheBlochParams[4]) * std::pow(static_cast<float>(o2::track::pid_constants::sCharges[id]), mChargeFactor);
+    const double dEdx = BetheBloch(static_cast<float>(bg)) * std::pow(static_cast<float>(o2::track::pid_constants::sCharges[id]), mChargeFactor);
     const double relReso = GetRelativeResolutiondEdx(p, mass, o2::track::pid_constants::sCharges[id], mResolutionParams[3]);
+    const int nCl = track.tpcNClsFound();
+    const double sqrtNcl = (mUseLookupTables && nCl > 0 && nCl < NClustersMax) ? mNClSqrtNorm[nCl] : std::sqrt(ncl);
 
-    const std::vector<double> values{1.f / dEdx, track.tgl(), std::sqrt(ncl), relReso, track.signed1Pt(), collision.multTPC() / mMultNormalization};
+    const std::array<double, 6> values{1.f / dEdx, track.tgl(), sqrtNcl, relReso, track.signed1Pt(), collision.multTPC() / mMultNormalization};
 
     const float reso = sqrt(pow(mResolutionParams[0], 2) * values[0] + pow(mResolutionParams[1], 2) * (values[2] * mResolutionParams[5]) * pow(values[0] / sqrt(1 + pow(values[1], 2)), mResolutionParams[2]) + values[2] * pow(values[3], 2) + pow(mResolutionParams[4] * values[4], 2) + pow(values[5] * mResolutionParams[6], 2) + pow(values[5] * (values[0] / sqrt(1 + pow(values[1], 2))) * mResolutionParams[7], 2)) * dEdx * mMIP;
     reso >= 0.f ? resolution = reso : resolution = -999.f;
@@ -189,14 +295,24 @@ inline float Response::GetSignalDelta(const TrackType& trk, const o2::track::PID
 inline float Response::GetRelativeResolutiondEdx(const float p, const float mass, const float charge, const float resol) const
 {
   const float bg = p / mass;
-  const float dEdx = o2::tpc::BetheBlochAleph(bg, mBetheBlochParams[0], mBetheBlochParams[1], mBetheBlochParams[2], mBetheBlochParams[3], mBetheBlochParams[4]) * std::pow(charge, mChargeFactor);
+  const float dEdx = BetheBloch(bg) * std::pow(charge, mChargeFactor);
   const float deltaP = resol * std::sqrt(dEdx);
   const float bgDelta = p * (1 + deltaP) / mass;
-  const float dEdx2 = o2::tpc::BetheBlochAleph(bgDelta, mBetheBlochParams[0], mBetheBlochParams[1], mBetheBlochParams[2], mBetheBlochParams[3], mBetheBlochParams[4]) * std::pow(charge, mChargeFactor);
+  const float dEdx2 = BetheBloch(bgDelta) * std::pow(charge, mChargeFactor);
   const float deltaRel = std::abs(dEdx2 - dEdx) / dEdx;
   return deltaRel;
 }
 
+inline void Response::BuildLookupTables(const float maxRelError)
+{
+  mBetheBlochLut.build(mBetheBlochParams, maxRelError);
+  for (int nCl = 0; nCl < NClustersMax; nCl++) {
+    mNClDefaultResolution[nCl] = nCl > 0 ? std::sqrt(1. + mResolutionParamsDefault[1] / static_cast<float>(nCl)) : 1.f;
+    mNClSqrtNorm[nCl] = nCl > 0 ? std::sqrt(nClNorm / nCl) : 0.f;
+  }
+  mUseLookupTables = true;
+}
+
 inline void Response::PrintAll() const
 {
   LOGP(info, "==== TPC PID response parameters: ====");
@@ -218,6 +334,9 @@ inline void Response::PrintAll() const
   LOGP(info, "mChargeFactor = {}", mChargeFactor);
   LOGP(info, "mMultNormalization = {}", mMultNormalization);
   LOGP(info, "nClNorm = {}", nClNorm);
+  if (mUseLookupTables) {
+    LOGP(info, "Using lookup tables, max relative error of the Bethe-Bloch table = {}", mBetheBlochLut.getMaxRelError());
+  }
 }
 
 } // namespace o2::pid::tpc
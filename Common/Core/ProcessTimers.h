@@ -0,0 +1,100 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file ProcessTimers.h
+/// \brief Wall-clock time, calls and processed rows of named sections of a task, e.g. its process functions or hot
+///        loops, accumulated in histograms of the task registry so that they end up in AnalysisResults.root.
+///        Usage:
+///          ProcessTimers timers;
+///          void init(InitContext&) { timers.init(registry, {"processData", "candidateLoop"}); }
+///          void processData(...) { ProcessTimers::Scope scope{timers, 0, tracks.size()}; ... }
+
+#ifndef COMMON_CORE_PROCESSTIMERS_H_
+#define COMMON_CORE_PROCESSTIMERS_H_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <TH1.h>
+
+#include "Framework/HistogramRegistry.h"
+
+class ProcessTimers
+{
+ public:
+  /// Adds the histograms of the sections to a registry, in the directory ProcessTimers
+  /// \param sections names of the sections, in the order of their indices
+  void init(o2::framework::HistogramRegistry& registry, const std::vector<std::string>& sections)
+  {
+    const int nSections = sections.size();
+    const o2::framework::AxisSpec axis{nSections, -0.5, nSections - 0.5, "section"};
+    mTime = registry.add<TH1>("ProcessTimers/hTime", "Wall-clock time;;time (#mus)", o2::framework::HistType::kTH1D, {axis});
+    mCalls = registry.add<TH1>("ProcessTimers/hCalls", "Calls;;calls", o2::framework::HistType::kTH1D, {axis});
+    mRows = registry.add<TH1>("ProcessTimers/hRows", "Processed rows;;rows", o2::framework::HistType::kTH1D, {axis});
+    for (int iSection = 0; iSection < nSections; iSection++) {
+      for (const auto& hist : {mTime, mCalls, mRows}) {
+        hist->GetXaxis()->SetBinLabel(iSection + 1, sections[iSection].data());
+      }
+    }
+  }
+
+  /// Whether init was called, the scopes do nothing otherwise
+  bool isEnabled() const { return mTime != nullptr; }
+
+  /// Adds the time of one call of a section
+  void add(int section, double microseconds, int64_t nRows = 0)
+  {
+    mTime->AddBinContent(section + 1, microseconds);
+    mCalls->AddBinContent(section + 1);
+    if (nRows > 0) {
+      mRows->AddBinContent(section + 1, nRows);
+    }
+  }
+
+  /// Adds rows to a section, e.g. the candidates accepted in a loop
+  void addRows(int section, int64_t nRows)
+  {
+    if (isEnabled()) {
+      mRows->AddBinContent(section + 1, nRows);
+    }
+  }
+
+  /// Times the enclosing scope as one call of a section
+  class Scope
+  {
+   public:
+    Scope(ProcessTimers& timers, int section, int64_t nRows = 0) : mTimers(timers), mSection(section), mNRows(nRows), mStart(std::chrono::steady_clock::now()) {}
+    ~Scope()
+    {
+      if (mTimers.isEnabled()) {
+        mTimers.add(mSection, std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - mStart).count(), mNRows);
+      }
+    }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    ProcessTimers& mTimers;
+    int mSection;
+    int64_t mNRows;
+    std::chrono::steady_clock::time_point mStart;
+  };
+
+ private:
+  std::shared_ptr<TH1> mTime;  // total time of each section
+  std::shared_ptr<TH1> mCalls; // number of calls of each section
+  std::shared_ptr<TH1> mRows;  // number of rows processed by each section
+};
+
+#endif // COMMON_CORE_PROCESSTIMERS_H_
@@ -20,7 +20,7 @@
 #include <algorithm> // std::find
 #include <array>     // std::array
 #include <cmath>     // std::abs, std::sqrt
-#include <utility>   // std::move
+#include <utility>   // std::move, std::swap
 #include <vector>    // std::vector
 
 #include "TMCProcess.h" // for VMC Particle Production Process
@@ -439,6 +439,76 @@ struct RecoDecay {
     return std::sqrt(m2(args...));
   }
 
+  /// Calculates invariant masses of a batch of two-prong candidates under several mass hypotheses.
+  /// The momenta are given as structure of arrays, e.g. table columns, and processed in one loop,
+  /// with the momenta squared computed once per candidate and shared by all the hypotheses.
+  /// The masses are the same as those of m() for each candidate.
+  /// \param nCandidates  number of candidates
+  /// \param momProng0,momProng1  arrays of the {x, y, z} momentum components of the two prongs, at least nCandidates values each
+  /// \param arrMass  array of the {prong 0, prong 1} masses of each hypothesis
+  /// \param arrOutput  array of the output arrays of each hypothesis, at least nCandidates values each
+  template <std::size_t N, typename T, typename U, typename V>
+  static void mTwoProngs(std::size_t nCandidates, const std::array<const T*, 3>& momProng0, const std::array<const T*, 3>& momProng1, const std::array<std::array<U, 2>, N>& arrMass, const std::array<V*, N>& arrOutput)
+  {
+    std::array<std::array<double, 2>, N> arrMass2;
+    for (std::size_t iHypo = 0; iHypo < N; ++iHypo) {
+      arrMass2[iHypo] = {sq(arrMass[iHypo][0]), sq(arrMass[iHypo][1])};
+    }
+    for (std::size_t iCand = 0; iCand < nCandidates; ++iCand) {
+      const double mom2Prong0 = sumOfSquares(momProng0[0][iCand], momProng0[1][iCand], momProng0[2][iCand]);
+      const double mom2Prong1 = sumOfSquares(momProng1[0][iCand], momProng1[1][iCand], momProng1[2][iCand]);
+      const double mom2Total = sumOfSquares(static_cast<double>(momProng0[0][iCand]) + momProng1[0][iCand],
+                                            static_cast<double>(momProng0[1][iCand]) + momProng1[1][iCand],
+                                            static_cast<double>(momProng0[2][iCand]) + momProng1[2][iCand]);
+      for (std::size_t iHypo = 0; iHypo < N; ++iHypo) {
+        const double energyTot = std::sqrt(mom2Prong0 + arrMass2[iHypo][0]) + std::sqrt(mom2Prong1 + arrMass2[iHypo][1]);
+        arrOutput[iHypo][iCand] = static_cast<V>(std::sqrt(energyTot * energyTot - mom2Total));
+      }
+    }
+  }
+
+  /// Calculates transverse momenta, pseudorapidities and azimuths of a batch of 3-momenta.
+  /// The momenta are given as structure of arrays, e.g. table columns, and processed in one loop.
+  /// The values are the same as those of pt(), eta() and phi() for each momentum.
+  /// \param nCandidates  number of momenta
+  /// \param mom  arrays of the {x, y, z} momentum components, at least nCandidates values each
+  /// \param outPt,outEta,outPhi  output arrays, at least nCandidates values each
+  template <typename T, typename V>
+  static void getPtEtaPhi(std::size_t nCandidates, const std::array<const T*, 3>& mom, V* outPt, V* outEta, V* outPhi)
+  {
+    for (std::size_t iCand = 0; iCand < nCandidates; ++iCand) {
+      const std::array<T, 3> momCand{mom[0][iCand], mom[1][iCand], mom[2][iCand]};
+      outPt[iCand] = static_cast<V>(pt(momCand));
+      outEta[iCand] = static_cast<V>(eta(momCand));
+      outPhi[iCand] = static_cast<V>(phi(momCand[0], momCand[1]));
+    }
+  }
+
+  /// Calculates invariant masses, transverse momenta, pseudorapidities and azimuths of a batch of two-prong candidates.
+  /// The momenta of the prongs are given as structure of arrays, e.g. table columns, and processed in one loop,
+  /// with the momentum of each candidate summed once and shared by all the outputs.
+  /// The values are the same as those of m() for each candidate, and of pt(), eta() and phi() for its momentum summed in double precision.
+  /// \param nCandidates  number of candidates
+  /// \param momProng0,momProng1  arrays of the {x, y, z} momentum components of the two prongs, at least nCandidates values each
+  /// \param arrMass  {prong 0, prong 1} masses
+  /// \param outMass,outPt,outEta,outPhi  output arrays, at least nCandidates values each
+  template <typename T, typename U, typename V>
+  static void getMassPtEtaPhi(std::size_t nCandidates, const std::array<const T*, 3>& momProng0, const std::array<const T*, 3>& momProng1, const std::array<U, 2>& arrMass, V* outMass, V* outPt, V* outEta, V* outPhi)
+  {
+    const std::array<double, 2> arrMass2{sq(arrMass[0]), sq(arrMass[1])};
+    for (std::size_t iCand = 0; iCand < nCandidates; ++iCand) {
+      const std::array<double, 3> momTotal{static_cast<double>(momProng0[0][iCand]) + momProng1[0][iCand],
+                                           static_cast<double>(momProng0[1][iCand]) + momProng1[1][iCand],
+                                           static_cast<double>(momProng0[2][iCand]) + momProng1[2][iCand]};
+      const double energyTot = std::sqrt(sumOfSquares(momProng0[0][iCand], momProng0[1][iCand], momProng0[2][iCand]) + arrMass2[0]) +
+                               std::sqrt(sumOfSquares(momProng1[0][iCand], momProng1[1][iCand], momProng1[2][iCand]) + arrMass2[1]);
+      outMass[iCand] = static_cast<V>(std::sqrt(energyTot * energyTot - p2(momTotal)));
+      outPt[iCand] = static_cast<V>(pt(momTotal));
+      outEta[iCand] = static_cast<V>(eta(momTotal));
+      outPhi[iCand] = static_cast<V>(phi(momTotal[0], momTotal[1]));
+    }
+  }
+
   // Calculation of topological quantities
 
   /// Calculates impact parameter in the bending plane of the particle w.r.t. a point
@@ -533,15 +603,15 @@ struct RecoDecay {
       *sign = sgn;
     }
 
-    // vector of vectors with mother indices; each line corresponds to a "stage"
-    std::vector<std::vector<int64_t>> arrayIds{};
-    std::vector<int64_t> initVec{particle.globalIndex()};
-    arrayIds.push_back(initVec); // the first vector contains the index of the original particle
+    // mother indices of the previous and of the current "stage"; the first stage contains the index of the original particle
+    // only two stages are kept, with their capacity reused, instead of one vector per stage
+    std::vector<int64_t> arrayIds{particle.globalIndex()};
+    std::vector<int64_t> arrayIdsStage{};
 
-    while (!motherFound && arrayIds[-stage].size() > 0 && (depthMax < 0 || -stage < depthMax)) {
+    while (!motherFound && arrayIds.size() > 0 && (depthMax < 0 || -stage < depthMax)) {
       // vector of mother indices for the current stage
-      std::vector<int64_t> arrayIdsStage{};
-      for (auto& iPart : arrayIds[-stage]) { // check all the particles that were the mothers at the previous stage
+      arrayIdsStage.clear();
+      for (auto& iPart : arrayIds) { // check all the particles that were the mothers at the previous stage
         auto particleMother = particlesMC.rawIteratorAt(iPart - particlesMC.offset());
         if (particleMother.has_mothers()) {
           for (auto iMother = particleMother.mothersIds().front(); iMother <= particleMother.mothersIds().back(); ++iMother) { // loop over the mother particles of the analysed particle
@@ -571,8 +641,8 @@ struct RecoDecay {
           }
         }
       }
-      // add vector of mother indices for the current stage
-      arrayIds.push_back(arrayIdsStage);
+      // the mothers of the current stage are the particles of the next one
+      std::swap(arrayIds, arrayIdsStage);
       stage--;
     }
     if (sign) {
@@ -920,19 +990,19 @@ struct RecoDecay {
   {
     int stage = 0; // mother tree level (just for debugging)
 
-    // vector of vectors with mother indices; each line corresponds to a "stage"
-    std::vector<std::vector<int64_t>> arrayIds{};
-    std::vector<int64_t> initVec{particle.globalIndex()};
-    arrayIds.push_back(initVec); // the first vector contains the index of the original particle
+    // mother indices of the previous and of the current "stage"; the first stage contains the index of the original particle
+    // only two stages are kept, with their capacity reused, instead of one vector per stage
+    std::vector<int64_t> arrayIds{particle.globalIndex()};
+    std::vector<int64_t> arrayIdsStage{};
     auto PDGParticle = std::abs(particle.pdgCode());
     bool couldBePrompt = false;
     if (PDGParticle / 100 == 4 || PDGParticle / 1000 == 4) {
       couldBePrompt = true;
     }
-    while (arrayIds[-stage].size() > 0) {
+    while (arrayIds.size() > 0) {
       // vector of mother indices for the current stage
-      std::vector<int64_t> arrayIdsStage{};
-      for (auto& iPart : arrayIds[-stage]) { // check all the particles that were the mothers at the previous stage
+      arrayIdsStage.clear();
+      for (auto& iPart : arrayIds) { // check all the particles that were the mothers at the previous stage
         auto particleMother = particlesMC.rawIteratorAt(iPart - particlesMC.offset());
         if (particleMother.has_mothers()) {
           for (auto iMother = particleMother.mothersIds().front(); iMother <= particleMother.mothersIds().back(); ++iMother) { // loop over the mother particles of the analysed particle
@@ -983,8 +1053,8 @@ struct RecoDecay {
           }
         }
       }
-      // add vector of mother indices for the current stage
-      arrayIds.push_back(arrayIdsStage);
+      // the mothers of the current stage are the particles of the next one
+      std::swap(arrayIds, arrayIdsStage);
       stage--;
     }
     if (!searchUpToQuark && couldBePrompt) { // Returns prompt if it's a charm hadron or a charm-hadron daughter. Note: 1) LF decay particles from cases like -> Lc -> p K0S, K0S -> pi pi are marked as prompt. 2) if particles from HF parton showers have to be searched, switch to option "search up to quark"
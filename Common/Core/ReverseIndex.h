@@ -0,0 +1,84 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file ReverseIndex.h
+/// \brief Lists of values grouped by the rows of a parent table, e.g. the tracks of each MC particle, stored as one
+///        array of values and one array of offsets (CSR format) instead of one vector per parent.
+///        The lists are either built from the parent index of each child, by counting sort in two passes,
+///        or filled in the order of the parents. A list is then a span, with no search and no copy.
+
+#ifndef COMMON_CORE_REVERSEINDEX_H_
+#define COMMON_CORE_REVERSEINDEX_H_
+
+#include <cstdint>
+#include <vector>
+
+#include <gsl/span>
+
+template <typename TValue = int>
+class ReverseIndex
+{
+ public:
+  /// Builds the lists of children of each parent, in the order of the children
+  /// \param nParents number of rows of the parent table
+  /// \param nChildren number of rows of the child table
+  /// \param parentOf callable returning the parent row of a child row, negative if the child has no parent
+  template <typename F>
+  void build(int nParents, int nChildren, F&& parentOf)
+  {
+    mOffsets.assign(nParents + 1, 0);
+    for (int iChild = 0; iChild < nChildren; iChild++) {
+      const auto iParent = parentOf(iChild);
+      if (iParent >= 0) {
+        mOffsets[iParent + 1]++;
+      }
+    }
+    for (int iParent = 0; iParent < nParents; iParent++) {
+      mOffsets[iParent + 1] += mOffsets[iParent];
+    }
+    mValues.resize(mOffsets[nParents]);
+    std::vector<int> position(mOffsets.begin(), mOffsets.end() - 1);
+    for (int iChild = 0; iChild < nChildren; iChild++) {
+      const auto iParent = parentOf(iChild);
+      if (iParent >= 0) {
+        mValues[position[iParent]++] = iChild;
+      }
+    }
+  }
+
+  /// Removes all the lists, before filling them with push_back and closeList
+  void clear()
+  {
+    mOffsets.assign(1, 0);
+    mValues.clear();
+  }
+  void reserve(int nParents, int nValues)
+  {
+    mOffsets.reserve(nParents + 1);
+    mValues.reserve(nValues);
+  }
+
+  /// Adds a value to the list of the next parent
+  void push_back(TValue value) { mValues.push_back(value); }
+  /// Ends the list of the next parent, possibly empty
+  void closeList() { mOffsets.push_back(mValues.size()); }
+
+  /// Number of lists, i.e. of parents
+  int size() const { return mOffsets.size() - 1; }
+  /// List of a parent
+  gsl::span<const TValue> operator[](int iParent) const { return {mValues.data() + mOffsets[iParent], mValues.data() + mOffsets[iParent + 1]}; }
+
+ private:
+  std::vector<int64_t> mOffsets{0}; // start of the list of each parent in mValues, and the end of the last list
+  std::vector<TValue> mValues;      // values of all the lists, parent by parent
+};
+
+#endif // COMMON_CORE_REVERSEINDEX_H_
@@ -17,8 +17,11 @@
 
 #include "Common/Core/TableHelper.h"
 
+#include <algorithm>
 #include <string>
+#include <vector>
 
+#include "Framework/DeviceSpec.h"
 #include "Framework/InitContext.h"
 #include "Framework/RunningWorkflowInfo.h"
 
@@ -53,6 +56,39 @@ bool isTableRequiredInWorkflow(o2::framework::InitContext& initContext, const st
   return tableNeeded;
 }
 
+/// Function to get the tables produced by the current device that no device of the workflow consumes, not even the AOD writer
+/// @param initContext initContext of the init function
+std::vector<std::string> getTablesNotConsumedInWorkflow(o2::framework::InitContext& initContext)
+{
+  auto& deviceSpec = initContext.services().get<o2::framework::DeviceSpec const>();
+  std::vector<std::string> tables;
+  for (auto const& output : deviceSpec.outputs) {
+    const std::string& table = output.matcher.binding.value;
+    if (table.empty() || std::find(tables.begin(), tables.end(), table) != tables.end()) {
+      continue;
+    }
+    if (!isTableRequiredInWorkflow(initContext, table)) {
+      tables.push_back(table);
+    }
+  }
+  return tables;
+}
+
+/// Function to print the tables produced by the current device that no device of the workflow consumes
+/// @param initContext initContext of the init function
+/// @return number of such tables
+int printTablesNotConsumedInWorkflow(o2::framework::InitContext& initContext)
+{
+  const auto tables = getTablesNotConsumedInWorkflow(initContext);
+  for (auto const& table : tables) {
+    LOG(info) << "Table produced but not consumed in the workflow: " << table;
+  }
+  if (!tables.empty()) {
+    LOG(info) << tables.size() << " table(s) of device " << initContext.services().get<o2::framework::DeviceSpec const>().name << " are not consumed, their process functions can be disabled";
+  }
+  return tables.size();
+}
+
 /// Function to enable or disable a configurable flag, depending on the fact that a table is needed or not
 /// @param initContext initContext of the init function
 /// @param table name of the table to check for
@@ -19,6 +19,7 @@
 #define COMMON_CORE_TABLEHELPER_H_
 
 #include <string>
+#include <vector>
 
 #include "Framework/InitContext.h"
 #include "Framework/RunningWorkflowInfo.h"
@@ -32,6 +33,15 @@ void printTablesInWorkflow(o2::framework::InitContext& initContext);
 /// @param table name of the table to check for
 bool isTableRequiredInWorkflow(o2::framework::InitContext& initContext, const std::string& table);
 
+/// Function to get the tables produced by the current device that no device of the workflow consumes, not even the AOD writer
+/// @param initContext initContext of the init function
+std::vector<std::string> getTablesNotConsumedInWorkflow(o2::framework::InitContext& initContext);
+
+/// Function to print the tables produced by the current device that no device of the workflow consumes
+/// @param initContext initContext of the init function
+/// @return number of such tables
+int printTablesNotConsumedInWorkflow(o2::framework::InitContext& initContext);
+
 /// Function to enable or disable a configurable flag, depending on the fact that a table is needed or not
 /// @param initContext initContext of the init function
 /// @param table name of the table to check for
@@ -13,14 +13,25 @@
 // Class for track selection
 //
 
+#include <bitset>
+
 #include "Framework/Logger.h"
 #include "Common/Core/TrackSelection.h"
 
-bool TrackSelection::FulfillsITSHitRequirements(uint8_t itsClusterMap) const
+uint8_t TrackSelection::getITSLayerMask(const std::set<uint8_t>& layers)
 {
   constexpr uint8_t bit = 1;
+  uint8_t mask = 0;
+  for (auto& layer : layers) {
+    mask |= bit << layer;
+  }
+  return mask;
+}
+
+bool TrackSelection::FulfillsITSHitRequirements(uint8_t itsClusterMap) const
+{
   for (auto& itsRequirement : mRequiredITSHits) {
-    auto hits = std::count_if(itsRequirement.second.begin(), itsRequirement.second.end(), [&](auto&& requiredLayer) { return itsClusterMap & (bit << requiredLayer); });
+    auto hits = static_cast<int>(std::bitset<8>(itsClusterMap & itsRequirement.second).count());
     if ((itsRequirement.first == -1) && (hits > 0)) {
       return false; // no hits were required in specified layers
     } else if (hits < itsRequirement.first) {
@@ -114,12 +125,12 @@ void TrackSelection::SetMaxDcaXYPtDep(std::function<float(float)> ptDepCut)
 void TrackSelection::SetRequireHitsInITSLayers(int8_t minNRequiredHits, std::set<uint8_t> requiredLayers)
 {
   // layer 0 corresponds to the the innermost ITS layer
-  mRequiredITSHits.push_back(std::make_pair(minNRequiredHits, requiredLayers));
+  mRequiredITSHits.push_back(std::make_pair(minNRequiredHits, getITSLayerMask(requiredLayers)));
   LOG(info) << "Track selection, set require hits in ITS layers: " << static_cast<int>(minNRequiredHits);
 }
 void TrackSelection::SetRequireNoHitsInITSLayers(std::set<uint8_t> excludedLayers)
 {
-  mRequiredITSHits.push_back(std::make_pair(-1, excludedLayers));
+  mRequiredITSHits.push_back(std::make_pair(-1, getITSLayerMask(excludedLayers)));
   LOG(info) << "Track selection, set require no hits in ITS layers";
 }
 
@@ -152,7 +152,8 @@ class TrackSelection
   template <typename T>
   bool IsSelected(T const& track, const TrackCuts& cut) const
   {
-    const bool isRun2 = track.trackType() == o2::aod::track::Run2Track || track.trackType() == o2::aod::track::Run2Tracklet;
+    // only evaluated by the cuts which depend on it
+    auto isRun2 = [&track]() { return track.trackType() == o2::aod::track::Run2Track || track.trackType() == o2::aod::track::Run2Tracklet; };
 
     switch (cut) {
       case TrackCuts::kTrackType:
@@ -177,7 +178,7 @@ class TrackSelection
         return track.tpcChi2NCl() <= mMaxChi2PerClusterTPC;
 
       case TrackCuts::kTPCRefit:
-        return (mRequireTPCRefit ? (isRun2 ? (track.flags() & o2::aod::track::TPCrefit) : track.hasTPC()) : true);
+        return (mRequireTPCRefit ? (isRun2() ? (track.flags() & o2::aod::track::TPCrefit) : track.hasTPC()) : true);
 
       case TrackCuts::kITSNCls:
         return track.itsNCls() >= mMinNClustersITS;
@@ -186,13 +187,13 @@ class TrackSelection
         return track.itsChi2NCl() <= mMaxChi2PerClusterITS;
 
       case TrackCuts::kITSRefit:
-        return (mRequireITSRefit ? (isRun2 ? (track.flags() & o2::aod::track::ITSrefit) : track.hasITS()) : true);
+        return (mRequireITSRefit ? (isRun2() ? (track.flags() & o2::aod::track::ITSrefit) : track.hasITS()) : true);
 
       case TrackCuts::kITSHits:
         return FulfillsITSHitRequirements(track.itsClusterMap());
 
       case TrackCuts::kGoldenChi2:
-        return (isRun2 && mRequireGoldenChi2) ? (track.flags() & o2::aod::track::GoldenChi2) : true;
+        return (mRequireGoldenChi2 && isRun2()) ? (track.flags() & o2::aod::track::GoldenChi2) : true;
 
       case TrackCuts::kDCAxy:
         return abs(track.dcaXY()) <= ((mMaxDcaXYPtDep) ? mMaxDcaXYPtDep(track.pt()) : mMaxDcaXY);
@@ -231,6 +232,7 @@ class TrackSelection
 
  private:
   bool FulfillsITSHitRequirements(uint8_t itsClusterMap) const;
+  static uint8_t getITSLayerMask(const std::set<uint8_t>& layers);
 
   o2::aod::track::TrackTypeEnum mTrackType{o2::aod::track::TrackTypeEnum::Track};
 
@@ -254,10 +256,10 @@ class TrackSelection
   bool mRequireTPCRefit{false};   // require refit in TPC
   bool mRequireGoldenChi2{false}; // require golden chi2 cut (Run 2 only)
 
-  // vector of ITS requirements (minNRequiredHits in specific requiredLayers)
-  std::vector<std::pair<int8_t, std::set<uint8_t>>> mRequiredITSHits{};
+  // vector of ITS requirements (minNRequiredHits in specific requiredLayers, as a bitmask of the layers)
+  std::vector<std::pair<int8_t, uint8_t>> mRequiredITSHits{};
 
-  ClassDefNV(TrackSelection, 1);
+  ClassDefNV(TrackSelection, 2);
 };
 
 #endif // COMMON_CORE_TRACKSELECTION_H_
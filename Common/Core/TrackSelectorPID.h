@@ -17,6 +17,9 @@
 #ifndef COMMON_CORE_TRACKSELECTORPID_H_
 #define COMMON_CORE_TRACKSELECTORPID_H_
 
+#include <cstdint>
+#include <vector>
+
 #include <TPDGCode.h>
 
 #include "Framework/Logger.h"
@@ -648,4 +651,84 @@ using TrackSelectorPi = TrackSelectorPidBase<kPiPlus>;    // Pi
 using TrackSelectorKa = TrackSelectorPidBase<kKPlus>;     // Ka
 using TrackSelectorPr = TrackSelectorPidBase<kProton>;    // Pr
 
+/// Table of PID selection statuses of all the tracks of a dataframe, built once from the PID columns
+/// The status (see TrackSelectorPID::Status) of each species is packed in 2 bits, up to 8 species per track.
+/// Tasks which evaluate the PID of the same track many times (e.g. for each candidate it belongs to)
+/// can build it once per dataframe and look the status up by track index (e.g. the prong index columns).
+class TrackSelectorPidStatusTable
+{
+ public:
+  /// PID selection used to compute the status
+  enum class Mode {
+    Tpc = 0,
+    Tof,
+    TpcOrTof,
+    TpcAndTof,
+    Bayes,
+    BayesProb
+  };
+
+  static constexpr int MaxSpecies = 8; ///< maximum number of species per track
+
+  /// Default constructor
+  TrackSelectorPidStatusTable() = default;
+
+  /// Computes the status of all the tracks of a table
+  /// \tparam mode  PID selection used to compute the status
+  /// \param tracks  table of tracks with the PID columns needed by the selectors
+  /// \param selectors  PID selectors, one per species, the species index is the position in the list
+  template <Mode mode, typename TTracks, typename... TSelectors>
+  void build(TTracks const& tracks, TSelectors&... selectors)
+  {
+    static_assert(sizeof...(TSelectors) > 0 && sizeof...(TSelectors) <= MaxSpecies, "Unsupported number of species");
+    mNSpecies = sizeof...(TSelectors);
+    mStatus.clear();
+    mStatus.reserve(tracks.size());
+    for (const auto& track : tracks) {
+      uint16_t status = 0;
+      int iSpecies = 0;
+      ((status |= static_cast<uint16_t>(computeStatus<mode>(selectors, track)) << (2 * iSpecies++)), ...);
+      mStatus.push_back(status);
+    }
+  }
+
+  /// Number of tracks in the table
+  std::size_t size() const { return mStatus.size(); }
+
+  /// Number of species per track
+  int getNSpecies() const { return mNSpecies; }
+
+  /// Returns the status of a track for a species
+  /// \param indexTrack  row index of the track in the table used to build it
+  /// \param iSpecies  index of the species, position of its selector in build
+  /// \return PID status (see TrackSelectorPID::Status)
+  TrackSelectorPID::Status getStatus(int64_t indexTrack, int iSpecies) const
+  {
+    return static_cast<TrackSelectorPID::Status>((mStatus[indexTrack] >> (2 * iSpecies)) & 0x3);
+  }
+
+ private:
+  std::vector<uint16_t> mStatus; ///< packed status of each track
+  int mNSpecies = 0;             ///< number of species per track
+
+  /// Status of a track for one selector
+  template <Mode mode, typename TSelector, typename T>
+  static TrackSelectorPID::Status computeStatus(TSelector& selector, const T& track)
+  {
+    if constexpr (mode == Mode::Tpc) {
+      return selector.statusTpc(track);
+    } else if constexpr (mode == Mode::Tof) {
+      return selector.statusTof(track);
+    } else if constexpr (mode == Mode::TpcOrTof) {
+      return selector.statusTpcOrTof(track);
+    } else if constexpr (mode == Mode::TpcAndTof) {
+      return selector.statusTpcAndTof(track);
+    } else if constexpr (mode == Mode::Bayes) {
+      return selector.statusBayes(track);
+    } else {
+      return selector.statusBayesProb(track);
+    }
+  }
+};
+
 #endif // COMMON_CORE_TRACKSELECTORPID_H_
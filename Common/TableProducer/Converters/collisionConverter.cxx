@@ -34,6 +34,7 @@ struct collisionConverter {
 
   void process(aod::Collisions_000 const& collisionTable)
   {
+    Collisions_001.reserve(collisionTable.size());
     float negtolerance = -1.0f * tolerance;
     for (auto& collision : collisionTable) {
       float lYY = collision.covXZ();
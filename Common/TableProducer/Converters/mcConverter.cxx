@@ -8,6 +8,8 @@
 // In applying this license CERN does not waive the privileges and immunities
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
+#include <vector>
+
 #include "Framework/runDataProcessing.h"
 #include "Framework/AnalysisTask.h"
 #include "Framework/AnalysisDataModel.h"
@@ -22,9 +24,11 @@ struct McConverter {
 
   void process(aod::StoredMcParticles_000 const& mcParticles_000)
   {
+    mcParticles_001.reserve(mcParticles_000.size());
+    std::vector<int> mothers;
     for (auto& p : mcParticles_000) {
 
-      std::vector<int> mothers;
+      mothers.clear();
       if (p.mother0Id() >= 0) {
         mothers.push_back(p.mother0Id());
       }
@@ -31,6 +31,7 @@ struct MftTracksConverter {
   void process(aod::MFTTracks_000 const& mftTracks_000)
   {
 
+    mftTracks_001.reserve(mftTracks_000.size());
     for (const auto& track0 : mftTracks_000) {
       uint64_t mftClusterSizesAndTrackFlags = 0;
       int8_t nClusters = track0.nClusters();
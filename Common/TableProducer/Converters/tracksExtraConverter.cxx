@@ -31,6 +31,7 @@ struct TracksExtraConverter {
   void process(aod::TracksExtra_000 const& tracksExtra_000)
   {
 
+    tracksExtra_001.reserve(tracksExtra_000.size());
     for (const auto& track0 : tracksExtra_000) {
 
       uint32_t itsClusterSizes = 0;
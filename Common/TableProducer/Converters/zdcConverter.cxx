@@ -12,6 +12,8 @@
 // ZDC converter to new format
 // to be used with Run 2 converted data and older AO2Ds
 
+#include <vector>
+
 #include "Framework/runDataProcessing.h"
 #include "Framework/AnalysisTask.h"
 #include "Framework/AnalysisDataModel.h"
@@ -26,6 +28,10 @@ struct zdcConverter {
 
   void process(aod::Zdcs_000 const& zdcLegacy, aod::BCs const&)
   {
+    Zdcs_001.reserve(zdcLegacy.size());
+    // Create variables to initialize Zdcs_001 table, reused for all the rows
+    std::vector<float> zdcEnergy, zdcAmplitudes, zdcTime;
+    std::vector<uint8_t> zdcChannelsE, zdcChannelsT;
     for (auto& zdcData : zdcLegacy) {
       // Get legacy information, please
       auto bc = zdcData.bc();
@@ -46,9 +52,11 @@ struct zdcConverter {
       auto timeZPA = zdcData.timeZPA();
       auto timeZPC = zdcData.timeZPC();
 
-      // Create variables to initialize Zdcs_001 table
-      std::vector<float> zdcEnergy, zdcAmplitudes, zdcTime;
-      std::vector<uint8_t> zdcChannelsE, zdcChannelsT;
+      zdcEnergy.clear();
+      zdcAmplitudes.clear();
+      zdcTime.clear();
+      zdcChannelsE.clear();
+      zdcChannelsT.clear();
 
       // Tie variables in such that they get read correctly later
       zdcEnergy.emplace_back(energyZEM1);
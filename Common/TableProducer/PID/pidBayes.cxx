@@ -109,26 +109,18 @@ struct bayesPid {
   std::array<std::array<float, PID::NIDs>, kNProb> Probability; /// Probabilities for all the cases defined in ProbType
   std::vector<PID::ID> enabledSpecies;                          /// Enabled species
 
+  std::array<std::array<bool, PID::NIDs>, kNDet> enabledDetSpecies{}; /// Species enabled for each detector, filled once in init
+
   /// Checker of the species that are enabled and initializer of the probabilities
   template <ProbType detIndex, o2::track::PID::ID pid>
   bool checkEnabled()
   {
     static_assert(detIndex < kNDet && detIndex >= 0);
-    if (!enabledDet[detIndex]) {
-      LOG(debug) << "Detector " << detectorName[detIndex] << " disabled";
-      return false; // Setting the probability to 1 if the detector is disabled
-    }
-    LOG(debug) << "Detector " << detectorName[detIndex] << " enabled with " << enabledSpecies.size() << " species";
-
-    for (const auto enabledPid : enabledSpecies) { // Checking that the species is enabled
-      LOG(debug) << "Testing " << PID::getName(enabledPid) << " " << static_cast<int>(enabledPid) << " vs " << static_cast<int>(pid);
-      if (enabledPid == pid) {
-        LOG(debug) << "Particle " << PID::getName(enabledPid) << " enabled";
-        Probability[detIndex][pid] = 1.f / enabledSpecies.size(); // set flat distribution (no decision yet)
-        return true;
-      }
+    if (!enabledDetSpecies[detIndex][pid]) { // Detector or species disabled
+      return false;
     }
-    return false;
+    Probability[detIndex][pid] = 1.f / enabledSpecies.size(); // set flat distribution (no decision yet)
+    return true;
   }
 
   float fRange = 5.f;
@@ -217,6 +209,13 @@ struct bayesPid {
     } else { // All ok
       LOG(info) << enabledSpecies.size() << " species enabled for the Bayesian PID computation";
     }
+    // Caching the enabled detector-species combinations, checked for every track
+    for (int det = 0; det < kNDet; det++) {
+      LOG(debug) << "Detector " << detectorName[det] << (enabledDet[det] ? " enabled" : " disabled") << " with " << enabledSpecies.size() << " species";
+      for (const auto enabledPid : enabledSpecies) {
+        enabledDetSpecies[det][enabledPid] = enabledDet[det];
+      }
+    }
     // Getting the parametrization parameters
     ccdb->setURL(url.value);
     ccdb->setTimestamp(timestamp.value);
@@ -372,87 +372,70 @@ struct tofPid {
   PROCESS_SWITCH(tofPid, processWSlice, "Process with track slices", true);
 
   using TrksIU = soa::Join<aod::TracksIU, aod::TracksExtra, aod::TOFSignal, aod::TOFEvTime, aod::pidEvTimeFlags>;
-  template <o2::track::PID::ID pid>
-  using ResponseImplementationIU = o2::pid::tof::ExpTimes<TrksIU::iterator, pid>;
+  o2::pid::tof::ExpTimesBatch mBatch; // SoA batch kernel for processWoSlice
   void processWoSlice(TrksIU const& tracks, aod::Collisions const&, aod::BCsWithTimestamps const&)
   {
-    constexpr auto responseEl = ResponseImplementationIU<PID::Electron>();
-    constexpr auto responseMu = ResponseImplementationIU<PID::Muon>();
-    constexpr auto responsePi = ResponseImplementationIU<PID::Pion>();
-    constexpr auto responseKa = ResponseImplementationIU<PID::Kaon>();
-    constexpr auto responsePr = ResponseImplementationIU<PID::Proton>();
-    constexpr auto responseDe = ResponseImplementationIU<PID::Deuteron>();
-    constexpr auto responseTr = ResponseImplementationIU<PID::Triton>();
-    constexpr auto responseHe = ResponseImplementationIU<PID::Helium3>();
-    constexpr auto responseAl = ResponseImplementationIU<PID::Alpha>();
-
     for (auto const& pidId : mEnabledParticles) {
       reserveTable(pidId, tracks.size());
     }
 
-    for (auto const& track : tracks) { // Loop on all tracks
-      if (!track.has_collision()) {    // Track was not assigned, cannot compute NSigma (no event time) -> filling with empty table
-        for (auto const& pidId : mEnabledParticles) {
-          makeTableEmpty(pidId);
-        }
-        continue;
-      }
-
-      if (enableTimeDependentResponse && (track.collisionId() != mLastCollisionId)) { // Time dependent calib is enabled and this is a new collision
-        mLastCollisionId = track.collisionId();                                       // Cache last collision ID
-        timestamp.value = track.collision().bc_as<aod::BCsWithTimestamps>().timestamp();
-        LOG(debug) << "Updating parametrization from path '" << parametrizationPath.value << "' and timestamp " << timestamp.value;
-        if (!ccdb->getForTimeStamp<o2::tof::ParameterCollection>(parametrizationPath.value, timestamp.value)->retrieveParameters(mRespParamsV2, passName.value)) {
-          if (fatalOnPassNotAvailable) {
-            LOGF(fatal, "Pass '%s' not available in the retrieved CCDB object", passName.value.data());
-          } else {
-            LOGF(warning, "Pass '%s' not available in the retrieved CCDB object", passName.value.data());
-          }
+    // Time dependent calib is enabled and this is a new collision
+    auto needsUpdate = [&](const auto& track) {
+      return enableTimeDependentResponse && track.has_collision() && (track.collisionId() != mLastCollisionId);
+    };
+    auto updateParameters = [&](const auto& track) {
+      mLastCollisionId = track.collisionId(); // Cache last collision ID
+      timestamp.value = track.collision().template bc_as<aod::BCsWithTimestamps>().timestamp();
+      LOG(debug) << "Updating parametrization from path '" << parametrizationPath.value << "' and timestamp " << timestamp.value;
+      if (!ccdb->getForTimeStamp<o2::tof::ParameterCollection>(parametrizationPath.value, timestamp.value)->retrieveParameters(mRespParamsV2, passName.value)) {
+        if (fatalOnPassNotAvailable) {
+          LOGF(fatal, "Pass '%s' not available in the retrieved CCDB object", passName.value.data());
+        } else {
+          LOGF(warning, "Pass '%s' not available in the retrieved CCDB object", passName.value.data());
         }
       }
+    };
+    // All hypotheses of the dataframe are computed at once, tracks without collision get the dummy values
+    o2::pid::tof::computeBatch(mBatch, tracks, mRespParamsV2, mEnabledParticles, needsUpdate, updateParameters);
 
-      for (auto const& pidId : mEnabledParticles) { // Loop on enabled particle hypotheses
-        switch (pidId) {
-          case 0:
-            aod::pidutils::packInTable<aod::pidtof_tiny::binning>(responseEl.GetSeparation(mRespParamsV2, track),
-                                                                  tablePIDEl);
-            break;
-          case 1:
-            aod::pidutils::packInTable<aod::pidtof_tiny::binning>(responseMu.GetSeparation(mRespParamsV2, track),
-                                                                  tablePIDMu);
-            break;
-          case 2:
-            aod::pidutils::packInTable<aod::pidtof_tiny::binning>(responsePi.GetSeparation(mRespParamsV2, track),
-                                                                  tablePIDPi);
-            break;
-          case 3:
-            aod::pidutils::packInTable<aod::pidtof_tiny::binning>(responseKa.GetSeparation(mRespParamsV2, track),
-                                                                  tablePIDKa);
-            break;
-          case 4:
-            aod::pidutils::packInTable<aod::pidtof_tiny::binning>(responsePr.GetSeparation(mRespParamsV2, track),
-                                                                  tablePIDPr);
-            break;
-          case 5:
-            aod::pidutils::packInTable<aod::pidtof_tiny::binning>(responseDe.GetSeparation(mRespParamsV2, track),
-                                                                  tablePIDDe);
-            break;
-          case 6:
-            aod::pidutils::packInTable<aod::pidtof_tiny::binning>(responseTr.GetSeparation(mRespParamsV2, track),
-                                                                  tablePIDTr);
-            break;
-          case 7:
-            aod::pidutils::packInTable<aod::pidtof_tiny::binning>(responseHe.GetSeparation(mRespParamsV2, track),
-                                                                  tablePIDHe);
-            break;
-          case 8:
-            aod::pidutils::packInTable<aod::pidtof_tiny::binning>(responseAl.GetSeparation(mRespParamsV2, track),
-                                                                  tablePIDAl);
-            break;
-          default:
-            LOG(fatal) << "Wrong particle ID in processWoSlice()";
-            break;
+    // Tables are filled in bulk, one hypothesis at a time
+    for (auto const& pidId : mEnabledParticles) {
+      auto fillTable = [&](auto& table) {
+        for (std::size_t i = 0; i < mBatch.size(); ++i) {
+          aod::pidutils::packInTable<aod::pidtof_tiny::binning>(mBatch.getSeparation(pidId, i), table);
         }
+      };
+      switch (pidId) {
+        case 0:
+          fillTable(tablePIDEl);
+          break;
+        case 1:
+          fillTable(tablePIDMu);
+          break;
+        case 2:
+          fillTable(tablePIDPi);
+          break;
+        case 3:
+          fillTable(tablePIDKa);
+          break;
+        case 4:
+          fillTable(tablePIDPr);
+          break;
+        case 5:
+          fillTable(tablePIDDe);
+          break;
+        case 6:
+          fillTable(tablePIDTr);
+          break;
+        case 7:
+          fillTable(tablePIDHe);
+          break;
+        case 8:
+          fillTable(tablePIDAl);
+          break;
+        default:
+          LOG(fatal) << "Wrong particle ID in processWoSlice()";
+          break;
       }
     }
   }
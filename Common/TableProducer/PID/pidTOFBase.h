@@ -57,4 +57,31 @@ DECLARE_SOA_TABLE(EvTimeTOFOnly, "AOD", "EvTimeTOFOnly", //! Table for the TOF e
                   pidtofevtime::EvTimeTOFMult);
 } // namespace o2::aod
 
+namespace o2::pid::tof
+{
+/// Loads the tracks of a dataframe into the batch kernel and computes the enabled hypotheses
+/// \param batch TOF batch kernel
+/// \param tracks tracks of the dataframe
+/// \param parameters response parameters, possibly updated by updateParameters
+/// \param hypotheses enabled mass hypotheses
+/// \param needsUpdate callable telling if the response parameters must be updated for a track
+/// \param updateParameters callable updating the response parameters for a track. The tracks loaded before are computed with the previous parameters
+template <typename TTracks, typename ParamType, typename TNeedsUpdate, typename TUpdate>
+void computeBatch(ExpTimesBatch& batch, const TTracks& tracks, ParamType& parameters, const std::vector<int>& hypotheses, TNeedsUpdate&& needsUpdate, TUpdate&& updateParameters)
+{
+  batch.clear();
+  batch.reserve(tracks.size());
+  std::size_t first = 0;
+  for (auto const& track : tracks) {
+    if (needsUpdate(track)) {
+      batch.compute(parameters, hypotheses, first, batch.size());
+      first = batch.size();
+      updateParameters(track);
+    }
+    batch.push(parameters, track);
+  }
+  batch.compute(parameters, hypotheses, first, batch.size());
+}
+} // namespace o2::pid::tof
+
 #endif // COMMON_TABLEPRODUCER_PID_PIDTOFBASE_H_
@@ -98,11 +98,7 @@ struct TOFCalibConfig : ConfigurableGroup {
     // Then the information about the metadata
     if (passName.value == "metadata") {
       LOG(info) << "Getting pass from metadata";
-      if (metadataInfo.isMC()) {
-        passName.value = metadataInfo.get("AnchorPassName");
-      } else {
-        passName.value = metadataInfo.get("RecoPassName");
-      }
+      passName.value = metadataInfo.getRecoPass();
       LOG(info) << "Passed autodetect mode for pass. Taking '" << passName.value << "'";
     }
     LOG(info) << "Using parameter collection, starting from pass '" << passName.value << "'";
@@ -528,6 +524,19 @@ struct tofEventTime {
       float t0AC[2] = {.0f, 999.f};                                                                                   // Value and error of T0A or T0C or T0AC
       float t0TOF[2] = {static_cast<float_t>(evTimeTOF.mEventTime), static_cast<float_t>(evTimeTOF.mEventTimeError)}; // Value and error of TOF
 
+      // The T0 measurement does not depend on the track: its weight is computed once per collision
+      const bool hasT0 = collision.has_foundFT0();
+      uint8_t flagsT0 = 0;
+      float weightT0 = 0.f;
+      if (hasT0) { // T0 measurement is available
+        if (collision.t0ACValid()) {
+          t0AC[0] = collision.t0AC() * 1000.f;
+          t0AC[1] = collision.t0resolution() * 1000.f;
+          flagsT0 = o2::aod::pidflags::enums::PIDFlags::EvTimeT0AC;
+        }
+        weightT0 = 1.f / (t0AC[1] * t0AC[1]);
+      }
+
       uint8_t flags = 0;
       int nGoodTracksForTOF = 0;
       float eventTime = 0.f;
@@ -553,17 +562,10 @@ struct tofEventTime {
           sumOfWeights += weight;
         }
 
-        if (collision.has_foundFT0()) { // T0 measurement is available
-          // const auto& ft0 = collision.foundFT0();
-          if (collision.t0ACValid()) {
-            t0AC[0] = collision.t0AC() * 1000.f;
-            t0AC[1] = collision.t0resolution() * 1000.f;
-            flags |= o2::aod::pidflags::enums::PIDFlags::EvTimeT0AC;
-          }
-
-          weight = 1.f / (t0AC[1] * t0AC[1]);
-          eventTime += t0AC[0] * weight;
-          sumOfWeights += weight;
+        if (hasT0) {
+          flags |= flagsT0;
+          eventTime += t0AC[0] * weightT0;
+          sumOfWeights += weightT0;
         }
 
         if (sumOfWeights < weightDiamond) { // avoiding sumOfWeights = 0 or worse that diamond
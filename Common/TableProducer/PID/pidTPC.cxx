@@ -27,12 +27,14 @@
 // O2 includes
 #include <CCDB/BasicCCDBManager.h>
 #include "Framework/AnalysisTask.h"
+#include "Framework/HistogramRegistry.h"
 #include "ReconstructionDataFormats/Track.h"
 #include "CCDB/CcdbApi.h"
 #include "Common/DataModel/PIDResponse.h"
 #include "Common/Core/PID/TPCPIDResponse.h"
 #include "Framework/AnalysisDataModel.h"
 #include "Common/DataModel/Multiplicity.h"
+#include "MetadataHelper.h"
 #include "TableHelper.h"
 #include "Tools/ML/model.h"
 #include "pidTPCBase.h"
@@ -45,6 +47,8 @@ using namespace o2::framework::expressions;
 using namespace o2::track;
 using namespace o2::ml;
 
+MetadataHelper metadataInfo; // Metadata helper
+
 void customize(std::vector<o2::framework::ConfigParamSpec>& workflowOptions)
 {
   std::vector<ConfigParamSpec> options{{"add-qa", VariantType::Int, 0, {"Legacy. No effect."}}};
@@ -92,22 +96,29 @@ struct tpcPid {
   std::map<std::string, std::string> metadata;
   std::map<std::string, std::string> headers;
   std::vector<int> speciesNetworkFlags = std::vector<int>(9);
+  std::vector<int> networkRowIndex; // row of each (mass hypothesis, track) pair in the batched network prediction, -1 if the network is not applied
 
   // Input parameters
   Service<o2::ccdb::BasicCCDBManager> ccdb;
   Configurable<std::string> paramfile{"param-file", "", "Path to the parametrization object, if empty the parametrization is not taken from file"};
   Configurable<std::string> url{"ccdb-url", "http://alice-ccdb.cern.ch", "url of the ccdb repository"};
   Configurable<std::string> ccdbPath{"ccdbPath", "Analysis/PID/TPC/Response", "Path of the TPC parametrization on the CCDB"};
-  Configurable<std::string> recoPass{"recoPass", "", "Reconstruction pass name for CCDB query (automatically takes latest object for timestamp if blank)"};
+  Configurable<std::string> recoPass{"recoPass", "", "Reconstruction pass name for CCDB query (automatically takes latest object for timestamp if blank, taken from the AO2D metadata if 'metadata')"};
   Configurable<int64_t> ccdbTimestamp{"ccdb-timestamp", 0, "timestamp of the object used to query in CCDB the detector response. Exceptions: -1 gets the latest object, 0 gets the run dependent timestamp"};
   // Parameters for loading network from a file / downloading the file
   Configurable<bool> useNetworkCorrection{"useNetworkCorrection", 0, "(bool) Wether or not to use the network correction for the TPC dE/dx signal"};
   Configurable<bool> autofetchNetworks{"autofetchNetworks", 1, "(bool) Automatically fetches networks from CCDB for the correct run number"};
+  Configurable<bool> useLookupTables{"useLookupTables", false, "(bool) Tabulate the Bethe-Bloch parametrisation and the cluster-dependent resolution terms once per parameter object"};
+  Configurable<float> lutMaxRelError{"lutMaxRelError", 1.e-4f, "Maximum relative interpolation error of the Bethe-Bloch lookup table"};
   Configurable<bool> skipTPCOnly{"skipTPCOnly", false, "Flag to skip TPC only tracks (faster but affects the analyses that use TPC only tracks)"};
   Configurable<std::string> networkPathLocally{"networkPathLocally", "network.onnx", "(std::string) Path to the local .onnx file. If autofetching is enabled, then this is where the files will be downloaded"};
   Configurable<std::string> networkPathCCDB{"networkPathCCDB", "Analysis/PID/TPC/ML", "Path on CCDB"};
   Configurable<bool> enableNetworkOptimizations{"enableNetworkOptimizations", 1, "(bool) If the neural network correction is used, this enables GraphOptimizationLevel::ORT_ENABLE_EXTENDED in the ONNX session"};
   Configurable<int> networkSetNumThreads{"networkSetNumThreads", 0, "Especially important for running on a SLURM cluster. Sets the number of threads used for execution."};
+  Configurable<std::string> networkExecutionProvider{"networkExecutionProvider", "CPU", "ONNX execution provider for the network: CPU, CUDA, TensorRT or ROCm (falls back to CPU if not available)"};
+  Configurable<int> networkDeviceId{"networkDeviceId", 0, "GPU device used by the network execution provider"};
+  Configurable<bool> networkTimingHistograms{"networkTimingHistograms", false, "(bool) Fill per-execution-provider timing histograms of the network inference"};
+  Configurable<int> networkGlobalThreadPool{"networkGlobalThreadPool", 0, "If > 0, all ONNX sessions of the process share one intra-op thread pool of this size (overrides networkSetNumThreads)"};
   // Configuration flags to include and exclude particle hypotheses
   Configurable<int> pidFullEl{"pid-full-el", -1, {"Produce PID information for the Electron mass hypothesis, overrides the automatic setup: the corresponding table can be set off (0) or on (1)"}};
   Configurable<int> pidFullMu{"pid-full-mu", -1, {"Produce PID information for the Muon mass hypothesis, overrides the automatic setup: the corresponding table can be set off (0) or on (1)"}};
@@ -142,12 +153,17 @@ struct tpcPid {
   // Parametrization configuration
   bool useCCDBParam = false;
 
+  HistogramRegistry histos{"Histos", {}, OutputObjHandlingPolicy::AnalysisObject};
+
   void init(o2::framework::InitContext& initContext)
   {
     // Protection for process flags
     if ((doprocessStandard && doprocessMcTuneOnData) || (!doprocessStandard && !doprocessMcTuneOnData)) {
       LOG(fatal) << "pid-tpc must have only one of the options 'processStandard' OR 'processMcTuneOnData' enabled. Please check your configuration.";
     }
+    if (doprocessMcTuneOnData && metadataInfo.mc() == MetadataHelper::Property::kNo) {
+      LOG(fatal) << "pid-tpc cannot run processMcTuneOnData on data according to the metadata. Please enable processStandard.";
+    }
     response = new o2::pid::tpc::Response();
     // Checking the tables are requested in the workflow and enabling them
     auto enableFlag = [&](const std::string particle, Configurable<int>& flag) {
@@ -188,6 +204,10 @@ struct tpcPid {
     speciesNetworkFlags[8] = useNetworkAl;
 
     // Initialise metadata object for CCDB calls
+    if (recoPass.value == "metadata") {
+      recoPass.value = metadataInfo.getRecoPass();
+      LOGP(info, "Reco pass taken from the AO2D metadata: '{}'", recoPass.value);
+    }
     if (recoPass.value == "") {
       LOGP(info, "Reco pass not specified; CCDB will take latest available object");
     } else {
@@ -205,6 +225,9 @@ struct tpcPid {
       } catch (...) {
         LOGF(fatal, "Loading the TPC PID Response from file {} failed!", fname.Data());
       }
+      if (useLookupTables) {
+        response->BuildLookupTables(lutMaxRelError);
+      }
       response->PrintAll();
     } else {
       useCCDBParam = true;
@@ -226,6 +249,9 @@ struct tpcPid {
             LOGF(fatal, "Unable to find any TPC object corresponding to timestamp {}!", time);
           }
         }
+        if (useLookupTables) {
+          response->BuildLookupTables(lutMaxRelError);
+        }
         response->PrintAll();
       }
     }
@@ -235,6 +261,18 @@ struct tpcPid {
     if (!useNetworkCorrection) {
       return;
     } else {
+      /// Process-wide cap on the inference threads
+      OnnxModel::setGlobalThreadPool(networkGlobalThreadPool.value);
+      network.setExecutionProvider(networkExecutionProvider.value, networkDeviceId.value);
+      if (networkTimingHistograms) {
+        const AxisSpec axisProvider{OnnxModel::NExecutionProviders, -0.5, OnnxModel::NExecutionProviders - 0.5, "execution provider"};
+        auto hTimePerRow = histos.add<TH2>("networkTimePerRow", "Network inference time per track-hypothesis pair;execution provider;time per row (ns)", kTH2F, {axisProvider, {1000, 0., 2000.}});
+        auto hTimeBatch = histos.add<TH2>("networkTimeBatch", "Network inference time per dataframe;execution provider;time (ms)", kTH2F, {axisProvider, {1000, 0., 1000.}});
+        for (int i = 0; i < OnnxModel::NExecutionProviders; i++) {
+          hTimePerRow->GetXaxis()->SetBinLabel(i + 1, OnnxModel::ExecutionProviders[i]);
+          hTimeBatch->GetXaxis()->SetBinLabel(i + 1, OnnxModel::ExecutionProviders[i]);
+        }
+      }
       /// CCDB and auto-fetching
       ccdbApi.init(url);
       if (!autofetchNetworks) {
@@ -293,6 +331,9 @@ struct tpcPid {
             LOGP(fatal, "Could not find ANY TPC response object for the timestamp {}!", bc.timestamp());
           }
         }
+        if (useLookupTables) {
+          response->BuildLookupTables(lutMaxRelError);
+        }
         response->PrintAll();
       }
 
@@ -312,61 +353,77 @@ struct tpcPid {
 
     // Defining some network parameters
     int input_dimensions = network.getNumInputNodes();
-    int output_dimensions = network.getNumOutputNodes();
-    const uint64_t track_prop_size = input_dimensions * size;
-    const uint64_t prediction_size = output_dimensions * size;
-
-    network_prediction = std::vector<float>(prediction_size * 9); // For each mass hypotheses
     const float nNclNormalization = response->GetNClNormalization();
     float duration_network = 0;
 
-    std::vector<float> track_properties(track_prop_size);
-    uint64_t counter_track_props = 0;
-    int loop_counter = 0;
-
-    // Filling a std::vector<float> to be evaluated by the network
-    // Evaluation on single tracks brings huge overhead: Thus evaluation is done on one large vector
-    for (int i = 0; i < 9; i++) { // Loop over particle number for which network correction is used
-      for (auto const& trk : tracks) {
-        if (!trk.hasTPC()) {
+    // Filling one contiguous std::vector<float> with all tracks x enabled mass hypotheses of the dataframe, which is evaluated by the network in a single batched inference
+    // Tracks below the beta-gamma cutoff (or without collision) are masked out before the inference and keep the row index -1
+    networkRowIndex.assign(9 * size, -1);
+    std::vector<float> track_properties;
+    track_properties.reserve(input_dimensions * size * 9);
+    int n_rows = 0;
+    uint64_t count_tracks = 0;
+    for (auto const& trk : tracks) {
+      if (!trk.hasTPC()) {
+        continue;
+      }
+      if (skipTPCOnly) {
+        if (!trk.hasITS() && !trk.hasTRD() && !trk.hasTOF()) {
           continue;
         }
-        if (skipTPCOnly) {
-          if (!trk.hasITS() && !trk.hasTRD() && !trk.hasTOF()) {
+      }
+      if (trk.has_collision()) {
+        const float multTPC = collisions.iteratorAt(trk.collisionId()).multTPC() / 11000.;
+        const float nclNorm = std::sqrt(nNclNormalization / trk.tpcNClsFound());
+        for (int i = 0; i < 9; i++) { // Loop over particle number for which network correction is used
+          if (!speciesNetworkFlags[i] || trk.tpcInnerParam() / o2::track::pid_constants::sMasses[i] <= networkBetaGammaCutoff) {
             continue;
           }
-        }
-        track_properties[counter_track_props] = trk.tpcInnerParam();
-        track_properties[counter_track_props + 1] = trk.tgl();
-        track_properties[counter_track_props + 2] = trk.signed1Pt();
-        track_properties[counter_track_props + 3] = o2::track::pid_constants::sMasses[i];
-        track_properties[counter_track_props + 4] = trk.has_collision() ? collisions.iteratorAt(trk.collisionId()).multTPC() / 11000. : 1.;
-        track_properties[counter_track_props + 5] = std::sqrt(nNclNormalization / trk.tpcNClsFound());
-        counter_track_props += input_dimensions;
-      }
-
-      auto start_network_eval = std::chrono::high_resolution_clock::now();
-      float* output_network = network.evalModel(track_properties);
-      auto stop_network_eval = std::chrono::high_resolution_clock::now();
-      duration_network += std::chrono::duration<float, std::ratio<1, 1000000000>>(stop_network_eval - start_network_eval).count();
-      for (uint64_t i = 0; i < prediction_size; i += output_dimensions) {
-        for (int j = 0; j < output_dimensions; j++) {
-          network_prediction[i + j + prediction_size * loop_counter] = output_network[i + j];
+          const uint64_t counter_track_props = track_properties.size();
+          track_properties.resize(counter_track_props + input_dimensions);
+          track_properties[counter_track_props] = trk.tpcInnerParam();
+          track_properties[counter_track_props + 1] = trk.tgl();
+          track_properties[counter_track_props + 2] = trk.signed1Pt();
+          track_properties[counter_track_props + 3] = o2::track::pid_constants::sMasses[i];
+          track_properties[counter_track_props + 4] = multTPC;
+          track_properties[counter_track_props + 5] = nclNorm;
+          networkRowIndex[count_tracks + size * i] = n_rows++;
         }
       }
+      count_tracks++;
+    }
 
-      counter_track_props = 0;
-      loop_counter += 1;
+    auto start_network_eval = std::chrono::high_resolution_clock::now();
+    network.evalModelBatch(track_properties, network_prediction);
+    auto stop_network_eval = std::chrono::high_resolution_clock::now();
+    duration_network += std::chrono::duration<float, std::ratio<1, 1000000000>>(stop_network_eval - start_network_eval).count();
+    if (networkTimingHistograms && n_rows > 0) {
+      histos.fill(HIST("networkTimePerRow"), network.getExecutionProviderIndex(), duration_network / n_rows);
+      histos.fill(HIST("networkTimeBatch"), network.getExecutionProviderIndex(), duration_network / 1000000);
+    }
+    if (network_prediction.size() != static_cast<std::size_t>(n_rows) * network.getNumOutputNodes()) {
+      LOG(fatal) << "Network prediction has " << network_prediction.size() << " values, expected " << n_rows * network.getNumOutputNodes() << "!";
     }
-    track_properties.clear();
 
     auto stop_network_total = std::chrono::high_resolution_clock::now();
-    LOG(debug) << "Neural Network for the TPC PID response correction: Time per track (eval ONNX): " << duration_network / (size * 9) << "ns ; Total time (eval ONNX): " << duration_network / 1000000000 << " s";
-    LOG(debug) << "Neural Network for the TPC PID response correction: Time per track (eval + overhead): " << std::chrono::duration<float, std::ratio<1, 1000000000>>(stop_network_total - start_network_total).count() / (size * 9) << "ns ; Total time (eval + overhead): " << std::chrono::duration<float, std::ratio<1, 1000000000>>(stop_network_total - start_network_total).count() / 1000000000 << " s";
+    LOG(debug) << "Neural Network for the TPC PID response correction: Evaluated " << n_rows << " track-hypothesis pairs out of " << size * 9;
+    LOG(debug) << "Neural Network for the TPC PID response correction: Time per track (eval ONNX): " << duration_network / std::max(n_rows, 1) << "ns ; Total time (eval ONNX): " << duration_network / 1000000000 << " s";
+    LOG(debug) << "Neural Network for the TPC PID response correction: Time per track (eval + overhead): " << std::chrono::duration<float, std::ratio<1, 1000000000>>(stop_network_total - start_network_total).count() / std::max(n_rows, 1) << "ns ; Total time (eval + overhead): " << std::chrono::duration<float, std::ratio<1, 1000000000>>(stop_network_total - start_network_total).count() / 1000000000 << " s";
 
     return network_prediction;
   }
 
+  /// Row of the track and mass hypothesis in the batched network prediction
+  /// \return -1 if the network correction is not applied to this track and mass hypothesis
+  template <typename T>
+  int getNetworkRow(const T& trk, const int pid, const uint64_t count_tracks, const uint64_t tracksForNet_size)
+  {
+    if (!useNetworkCorrection || !trk.hasTPC() || (skipTPCOnly && !trk.hasITS() && !trk.hasTRD() && !trk.hasTOF())) {
+      return -1;
+    }
+    return networkRowIndex[count_tracks + tracksForNet_size * pid];
+  }
+
   template <typename C, typename T, typename NSF, typename NST>
   void makePidTables(const int flagFull, NSF& tableFull, const int flagTiny, NST& tableTiny, const o2::track::PID::ID pid, const float tpcSignal, const T& trk, const C& collisions, const std::vector<float>& network_prediction, const int& count_tracks, const int& tracksForNet_size)
   {
@@ -400,23 +457,23 @@ struct tpcPid {
     }
 
     float nSigma = -999.f;
-    float bg = trk.tpcInnerParam() / o2::track::pid_constants::sMasses[pid]; // estimated beta-gamma for network cutoff
-    if (useNetworkCorrection && speciesNetworkFlags[pid] && trk.has_collision() && bg > networkBetaGammaCutoff) {
+    const int row = getNetworkRow(trk, pid, count_tracks, tracksForNet_size); // beta-gamma cutoff and species switches are already applied when building the network input
+    if (row >= 0) {
 
       // Here comes the application of the network. The output--dimensions of the network determine the application: 1: mean, 2: sigma, 3: sigma asymmetric
       // For now only the option 2: sigma will be used. The other options are kept if there would be demand later on
       if (network.getNumOutputNodes() == 1) { // Expected mean correction; no sigma correction
-        nSigma = (tpcSignal - network_prediction[count_tracks + tracksForNet_size * pid] * expSignal) / expSigma;
+        nSigma = (tpcSignal - network_prediction[row] * expSignal) / expSigma;
       } else if (network.getNumOutputNodes() == 2) { // Symmetric sigma correction
-        expSigma = (network_prediction[2 * (count_tracks + tracksForNet_size * pid) + 1] - network_prediction[2 * (count_tracks + tracksForNet_size * pid)]) * expSignal;
-        nSigma = (tpcSignal / expSignal - network_prediction[2 * (count_tracks + tracksForNet_size * pid)]) / (network_prediction[2 * (count_tracks + tracksForNet_size * pid) + 1] - network_prediction[2 * (count_tracks + tracksForNet_size * pid)]);
+        expSigma = (network_prediction[2 * row + 1] - network_prediction[2 * row]) * expSignal;
+        nSigma = (tpcSignal / expSignal - network_prediction[2 * row]) / (network_prediction[2 * row + 1] - network_prediction[2 * row]);
       } else if (network.getNumOutputNodes() == 3) { // Asymmetric sigma corection
-        if (tpcSignal / expSignal >= network_prediction[3 * (count_tracks + tracksForNet_size * pid)]) {
-          expSigma = (network_prediction[3 * (count_tracks + tracksForNet_size * pid) + 1] - network_prediction[3 * (count_tracks + tracksForNet_size * pid)]) * expSignal;
-          nSigma = (tpcSignal / expSignal - network_prediction[3 * (count_tracks + tracksForNet_size * pid)]) / (network_prediction[3 * (count_tracks + tracksForNet_size * pid) + 1] - network_prediction[3 * (count_tracks + tracksForNet_size * pid)]);
+        if (tpcSignal / expSignal >= network_prediction[3 * row]) {
+          expSigma = (network_prediction[3 * row + 1] - network_prediction[3 * row]) * expSignal;
+          nSigma = (tpcSignal / expSignal - network_prediction[3 * row]) / (network_prediction[3 * row + 1] - network_prediction[3 * row]);
         } else {
-          expSigma = (network_prediction[3 * (count_tracks + tracksForNet_size * pid)] - network_prediction[3 * (count_tracks + tracksForNet_size * pid) + 2]) * expSignal;
-          nSigma = (tpcSignal / expSignal - network_prediction[3 * (count_tracks + tracksForNet_size * pid)]) / (network_prediction[3 * (count_tracks + tracksForNet_size * pid)] - network_prediction[3 * (count_tracks + tracksForNet_size * pid) + 2]);
+          expSigma = (network_prediction[3 * row] - network_prediction[3 * row + 2]) * expSignal;
+          nSigma = (tpcSignal / expSignal - network_prediction[3 * row]) / (network_prediction[3 * row] - network_prediction[3 * row + 2]);
         }
       } else {
         LOGF(fatal, "Network output-dimensions incompatible!");
@@ -490,6 +547,9 @@ struct tpcPid {
             LOGP(fatal, "Could not find ANY TPC response object for the timestamp {}!", bc.timestamp());
           }
         }
+        if (useLookupTables) {
+          response->BuildLookupTables(lutMaxRelError);
+        }
         response->PrintAll();
       }
 
@@ -579,6 +639,9 @@ struct tpcPid {
             LOGP(fatal, "Could not find ANY TPC response object for the timestamp {}!", bc.timestamp());
           }
         }
+        if (useLookupTables) {
+          response->BuildLookupTables(lutMaxRelError);
+        }
         response->PrintAll();
       }
 
@@ -599,11 +662,11 @@ struct tpcPid {
         if (expSignal < 0. || expSigma < 0.) { // if expectation invalid then give undefined signal
           mcTunedTPCSignal = -999.f;
         }
-        float bg = trk.tpcInnerParam() / o2::track::pid_constants::sMasses[pid]; // estimated beta-gamma for network cutoff
+        const int row = getNetworkRow(trk, pid, count_tracks, tracksForNet_size);
 
-        if (useNetworkCorrection && speciesNetworkFlags[pid] && trk.has_collision() && bg > networkBetaGammaCutoff) {
-          auto mean = network_prediction[2 * (count_tracks + tracksForNet_size * pid)] * expSignal; // Absolute mean, i.e. the mean dE/dx value of the data in that slice, not the mean of the NSigma distribution
-          auto sigma = (network_prediction[2 * (count_tracks + tracksForNet_size * pid) + 1] - network_prediction[2 * (count_tracks + tracksForNet_size * pid)]) * expSignal;
+        if (row >= 0) {
+          auto mean = network_prediction[2 * row] * expSignal; // Absolute mean, i.e. the mean dE/dx value of the data in that slice, not the mean of the NSigma distribution
+          auto sigma = (network_prediction[2 * row + 1] - network_prediction[2 * row]) * expSignal;
           if (mean < 0.f || sigma < 0.f) {
             mcTunedTPCSignal = -999.f;
           } else {
@@ -641,4 +704,9 @@ struct tpcPid {
   PROCESS_SWITCH(tpcPid, processMcTuneOnData, "Creating PID tables with MC TuneOnData", false);
 };
 
-WorkflowSpec defineDataProcessing(ConfigContext const& cfgc) { return WorkflowSpec{adaptAnalysisTask<tpcPid>(cfgc)}; }
+WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
+{
+  // Parse the metadata
+  metadataInfo.initMetadata(cfgc);
+  return WorkflowSpec{adaptAnalysisTask<tpcPid>(cfgc)};
+}
@@ -18,6 +18,7 @@
 #include "Common/Core/trackUtilities.h"
 #include "ReconstructionDataFormats/TrackParametrization.h"
 #include "DetectorsBase/Propagator.h"
+#include "Common/Core/BcIndex.h"
 
 #include "CommonUtils/NameConf.h"
 #include "CCDB/BasicCCDBManager.h"
@@ -33,6 +34,10 @@
 #include "PHOSBase/Geometry.h"
 #include "PHOSReconstruction/Clusterer.h"
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
 using namespace o2::framework;
 using namespace o2;
 
@@ -99,6 +104,56 @@ struct caloClusterProducerTask {
     int mEnd[kCpvCells];   // Z (theta) track coordinate in PHOS plane
   };
 
+  BcIndex bcMap;                      // row of each BC
+  BcIndex colMap;                     // collision of each BC
+  std::vector<uint64_t> collisionBCs; // global BC of each collision
+  std::vector<int> collisionOrder;    // collisions ordered by BC
+
+  /// Fills the row of each BC, and the collision of each BC with collisions:
+  /// if several collisions appear in a BC, the one with the largest number of contributors is chosen
+  template <typename TBCs, typename TCollisions>
+  void fillBcAndCollisionMaps(TBCs const& bcs, TCollisions const& colls)
+  {
+    bcMap.clear();
+    bcMap.reserve(bcs.size());
+    int bcId = 0;
+    for (auto bc : bcs) {
+      bcMap.add(bc.globalBC(), bcId);
+      bcId++;
+    }
+    bcMap.finalize();
+
+    collisionBCs.clear();
+    for (auto cl : colls) {
+      collisionBCs.push_back(cl.template bc_as<aod::BCsWithTimestamps>().globalBC());
+    }
+    collisionOrder.resize(collisionBCs.size());
+    std::iota(collisionOrder.begin(), collisionOrder.end(), 0);
+    std::stable_sort(collisionOrder.begin(), collisionOrder.end(), [this](int a, int b) { return collisionBCs[a] < collisionBCs[b]; });
+    colMap.clear();
+    colMap.reserve(collisionOrder.size());
+    for (std::size_t first = 0; first < collisionOrder.size();) {
+      int best = collisionOrder[first];
+      std::size_t last = first + 1;
+      for (; last < collisionOrder.size() && collisionBCs[collisionOrder[last]] == collisionBCs[best]; last++) {
+        // the first collision of the BC with the largest number of contributors
+        if ((colls.begin() + collisionOrder[last]).numContrib() > (colls.begin() + best).numContrib()) {
+          best = collisionOrder[last];
+        }
+      }
+      colMap.add(collisionBCs[best], best);
+      first = last;
+    }
+    colMap.finalize();
+  }
+
+  /// Row of a BC, 0 if not found
+  int getBcId(int64_t globalBC) const
+  {
+    int32_t bcId = bcMap.find(globalBC);
+    return bcId < 0 ? 0 : bcId;
+  }
+
   void init(o2::framework::InitContext&)
   {
     ccdb->setURL(o2::base::NameConf::getCCDBServer());
@@ -121,28 +176,7 @@ struct caloClusterProducerTask {
     } else {
       return;
     }
-    std::map<int64_t, int> bcMap;
-    int bcId = 0;
-    for (auto bc : bcs) {
-      bcMap[bc.globalBC()] = bcId;
-      bcId++;
-    }
-
-    // If several collisions appear in BC, choose one with largers number of contributors
-    std::map<int64_t, int> colMap;
-    int colId = 0;
-    for (auto cl : colls) {
-      auto colbc = colMap.find(cl.bc_as<aod::BCsWithTimestamps>().globalBC());
-      if (colbc == colMap.end()) { // single collision per BC
-        colMap[cl.bc_as<aod::BCsWithTimestamps>().globalBC()] = colId;
-      } else { // not unique collision per BC
-        auto coll2 = colls.begin() + colbc->second;
-        if (cl.numContrib() > coll2.numContrib()) {
-          colMap[cl.bc_as<aod::BCsWithTimestamps>().globalBC()] = colId;
-        }
-      }
-      colId++;
-    }
+    fillBcAndCollisionMaps(bcs, colls);
 
     // Fill list of cells and cell TrigRecs per TF as an input for clusterizer
     // clusterize
@@ -262,12 +296,12 @@ struct caloClusterProducerTask {
       // Extract primary vertex
       TVector3 vtx = {0., 0., 0.}; // default, if not collision will be found
       int colId = -1;
-      auto coliter = colMap.find(cluTR.getBCData().toLong());
-      if (coliter != colMap.end()) { // get vertex from collision
+      int32_t colBcId = colMap.find(cluTR.getBCData().toLong());
+      if (colBcId >= 0) { // get vertex from collision
         // find collision corresponding to current BC
-        auto clvtx = colls.begin() + coliter->second;
+        auto clvtx = colls.begin() + colBcId;
         vtx.SetXYZ(clvtx.posX(), clvtx.posY(), clvtx.posZ());
-        colId = coliter->second;
+        colId = colBcId;
       }
 
       bool cpvExist = false;
@@ -373,7 +407,7 @@ struct caloClusterProducerTask {
         if (colId == -1) {
           // Ambiguos Collision assignment
           cluambcursor(
-            bcMap[cluTR.getBCData().toLong()],
+            getBcId(cluTR.getBCData().toLong()),
             mom.X(), mom.Y(), mom.Z(), e,
             mod, clu.getMultiplicity(), posX, posZ,
             globaPos.X(), globaPos.Y(), globaPos.Z(),
@@ -415,28 +449,7 @@ struct caloClusterProducerTask {
     } else {
       return;
     }
-    std::map<int64_t, int> bcMap;
-    int bcId = 0;
-    for (auto bc : bcs) {
-      bcMap[bc.globalBC()] = bcId;
-      bcId++;
-    }
-
-    // If several collisions appear in BC, choose one with largers number of contributors
-    std::map<int64_t, int> colMap;
-    int colId = 0;
-    for (auto cl : colls) {
-      auto colbc = colMap.find(cl.bc_as<aod::BCsWithTimestamps>().globalBC());
-      if (colbc == colMap.end()) { // single collision per BC
-        colMap[cl.bc_as<aod::BCsWithTimestamps>().globalBC()] = colId;
-      } else { // not unique collision per BC
-        auto coll2 = colls.begin() + colbc->second;
-        if (cl.numContrib() > coll2.numContrib()) {
-          colMap[cl.bc_as<aod::BCsWithTimestamps>().globalBC()] = colId;
-        }
-      }
-      colId++;
-    }
+    fillBcAndCollisionMaps(bcs, colls);
 
     // Fill list of cells and cell TrigRecs per TF as an input for clusterizer
     // clusterize
@@ -578,12 +591,12 @@ struct caloClusterProducerTask {
       // Extract primary vertex
       TVector3 vtx = {0., 0., 0.}; // default, if not collision will be found
       int colId = -1;
-      auto coliter = colMap.find(cluTR.getBCData().toLong());
-      if (coliter != colMap.end()) { // get vertex from collision
+      int32_t colBcId = colMap.find(cluTR.getBCData().toLong());
+      if (colBcId >= 0) { // get vertex from collision
         // find collision corresponding to current BC
-        auto clvtx = colls.begin() + coliter->second;
+        auto clvtx = colls.begin() + colBcId;
         vtx.SetXYZ(clvtx.posX(), clvtx.posY(), clvtx.posZ());
-        colId = coliter->second;
+        colId = colBcId;
       }
 
       bool cpvExist = false;
@@ -697,7 +710,7 @@ struct caloClusterProducerTask {
         if (colId == -1) {
           // Ambiguos Collision assignment
           cluambcursor(
-            bcMap[cluTR.getBCData().toLong()],
+            getBcId(cluTR.getBCData().toLong()),
             mom.X(), mom.Y(), mom.Z(), e,
             mod, clu.getMultiplicity(), posX, posZ,
             globaPos.X(), globaPos.Y(), globaPos.Z(),
@@ -758,28 +771,7 @@ struct caloClusterProducerTask {
       o2::base::Propagator::initFieldFromGRP(grpo);
     }
 
-    std::map<int64_t, int> bcMap;
-    int bcId = 0;
-    for (auto bc : bcs) {
-      bcMap[bc.globalBC()] = bcId;
-      bcId++;
-    }
-
-    // If several collisions appear in BC, choose one with largers number of contributors
-    std::map<int64_t, int> colMap;
-    int colId = 0;
-    for (auto cl : colls) {
-      auto colbc = colMap.find(cl.bc_as<aod::BCsWithTimestamps>().globalBC());
-      if (colbc == colMap.end()) { // single collision per BC
-        colMap[cl.bc_as<aod::BCsWithTimestamps>().globalBC()] = colId;
-      } else { // not unique collision per BC
-        auto coll2 = colls.begin() + colbc->second;
-        if (cl.numContrib() > coll2.numContrib()) {
-          colMap[cl.bc_as<aod::BCsWithTimestamps>().globalBC()] = colId;
-        }
-      }
-      colId++;
-    }
+    fillBcAndCollisionMaps(bcs, colls);
     // Fill list of cells and cell TrigRecs per TF as an input for clusterizer
     // clusterize
     // Fill output table
@@ -972,12 +964,12 @@ struct caloClusterProducerTask {
       // Extract primary vertex
       TVector3 vtx = {0., 0., 0.}; // default, if not collision will be found
       int colId = -1;
-      auto coliter = colMap.find(cluTR.getBCData().toLong());
-      if (coliter != colMap.end()) { // get vertex from collision
+      int32_t colBcId = colMap.find(cluTR.getBCData().toLong());
+      if (colBcId >= 0) { // get vertex from collision
         // find collision corresponding to current BC
-        auto clvtx = colls.begin() + coliter->second;
+        auto clvtx = colls.begin() + colBcId;
         vtx.SetXYZ(clvtx.posX(), clvtx.posY(), clvtx.posZ());
-        colId = coliter->second;
+        colId = colBcId;
       }
 
       bool cpvExist = false;
@@ -1111,7 +1103,7 @@ struct caloClusterProducerTask {
         if (colId == -1) {
           // Ambiguos Collision assignment
           cluambcursor(
-            bcMap[cluTR.getBCData().toLong()],
+            getBcId(cluTR.getBCData().toLong()),
             mom.X(), mom.Y(), mom.Z(), e,
             mod, clu.getMultiplicity(), posX, posZ,
             globaPos.X(), globaPos.Y(), globaPos.Z(),
@@ -1167,28 +1159,7 @@ struct caloClusterProducerTask {
       o2::base::Propagator::initFieldFromGRP(grpo);
     }
 
-    std::map<int64_t, int> bcMap;
-    int bcId = 0;
-    for (auto bc : bcs) {
-      bcMap[bc.globalBC()] = bcId;
-      bcId++;
-    }
-
-    // If several collisions appear in BC, choose one with largers number of contributors
-    std::map<int64_t, int> colMap;
-    int colId = 0;
-    for (auto cl : colls) {
-      auto colbc = colMap.find(cl.bc_as<aod::BCsWithTimestamps>().globalBC());
-      if (colbc == colMap.end()) { // single collision per BC
-        colMap[cl.bc_as<aod::BCsWithTimestamps>().globalBC()] = colId;
-      } else { // not unique collision per BC
-        auto coll2 = colls.begin() + colbc->second;
-        if (cl.numContrib() > coll2.numContrib()) {
-          colMap[cl.bc_as<aod::BCsWithTimestamps>().globalBC()] = colId;
-        }
-      }
-      colId++;
-    }
+    fillBcAndCollisionMaps(bcs, colls);
     // Fill list of cells and cell TrigRecs per TF as an input for clusterizer
     // clusterize
     // Fill output table
@@ -1403,12 +1374,12 @@ struct caloClusterProducerTask {
       // Extract primary vertex
       TVector3 vtx = {0., 0., 0.}; // default, if not collision will be found
       int colId = -1;
-      auto coliter = colMap.find(cluTR.getBCData().toLong());
-      if (coliter != colMap.end()) { // get vertex from collision
+      int32_t colBcId = colMap.find(cluTR.getBCData().toLong());
+      if (colBcId >= 0) { // get vertex from collision
         // find collision corresponding to current BC
-        auto clvtx = colls.begin() + coliter->second;
+        auto clvtx = colls.begin() + colBcId;
         vtx.SetXYZ(clvtx.posX(), clvtx.posY(), clvtx.posZ());
-        colId = coliter->second;
+        colId = colBcId;
       }
 
       bool cpvExist = false;
@@ -1547,7 +1518,7 @@ struct caloClusterProducerTask {
         if (colId == -1) {
           // Ambiguos Collision assignment
           cluambcursor(
-            bcMap[cluTR.getBCData().toLong()],
+            getBcId(cluTR.getBCData().toLong()),
             mom.X(), mom.Y(), mom.Z(), e,
             mod, clu.getMultiplicity(), posX, posZ,
             globaPos.X(), globaPos.Y(), globaPos.Z(),
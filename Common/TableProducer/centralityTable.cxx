@@ -12,6 +12,8 @@
 /// \file centrality.cxx
 /// \brief Task to produce the centrality tables associated to each of the required centrality estimators
 
+#include <algorithm>
+#include <vector>
 #include <CCDB/BasicCCDBManager.h>
 #include <TH1F.h>
 #include <TFormula.h>
@@ -24,12 +26,15 @@
 #include "Common/DataModel/Centrality.h"
 #include "Common/DataModel/EventSelection.h"
 
+#include "MetadataHelper.h"
 #include "TableHelper.h"
 #include "TList.h"
 
 using namespace o2;
 using namespace o2::framework;
 
+MetadataHelper metadataInfo; // Metadata helper
+
 static constexpr int kCentRun2V0Ms = 0;
 static constexpr int kCentRun2V0As = 1;
 static constexpr int kCentRun2SPDTrks = 2;
@@ -83,6 +88,7 @@ struct CentralityTable {
   Configurable<bool> embedINELgtZEROselection{"embedINELgtZEROselection", false, {"Option to do percentile 100.5 if not INELgtZERO"}};
   Configurable<bool> fatalizeMultCalibSanity{"fatalizeMultCalibSanity", false, {"Option to do fatalize the sanity check on the multiplicity calibration"}};
   Configurable<bool> produceHistograms{"produceHistograms", false, {"Option to produce debug histograms"}};
+  Configurable<bool> useCalibrationLuts{"useCalibrationLuts", false, {"Option to copy the Run 3 calibrations into flat lookup tables at each run change, avoiding the TH1 lookups per collision"}};
   ConfigurableAxis binsPercentile{"binsPercentile", {VARIABLE_WIDTH, 0, 0.001, 0.002, 0.003, 0.004, 0.005, 0.006, 0.007, 0.008, 0.009, 0.01, 0.011, 0.012, 0.013, 0.014, 0.015, 0.016, 0.017, 0.018, 0.019, 0.02, 0.021, 0.022, 0.023, 0.024, 0.025, 0.026, 0.027, 0.028, 0.029, 0.03, 0.031, 0.032, 0.033, 0.034, 0.035, 0.036, 0.037, 0.038, 0.039, 0.04, 0.041, 0.042, 0.043, 0.044, 0.045, 0.046, 0.047, 0.048, 0.049, 0.05, 0.051, 0.052, 0.053, 0.054, 0.055, 0.056, 0.057, 0.058, 0.059, 0.06, 0.061, 0.062, 0.063, 0.064, 0.065, 0.066, 0.067, 0.068, 0.069, 0.07, 0.071, 0.072, 0.073, 0.074, 0.075, 0.076, 0.077, 0.078, 0.079, 0.08, 0.081, 0.082, 0.083, 0.084, 0.085, 0.086, 0.087, 0.088, 0.089, 0.09, 0.091, 0.092, 0.093, 0.094, 0.095, 0.096, 0.097, 0.098, 0.099, 0.1, 0.11, 0.12, 0.13, 0.14, 0.15, 0.16, 0.17, 0.18, 0.19, 0.2, 0.21, 0.22, 0.23, 0.24, 0.25, 0.26, 0.27, 0.28, 0.29, 0.3, 0.31, 0.32, 0.33, 0.34, 0.35, 0.36, 0.37, 0.38, 0.39, 0.4, 0.41, 0.42, 0.43, 0.44, 0.45, 0.46, 0.47, 0.48, 0.49, 0.5, 0.51, 0.52, 0.53, 0.54, 0.55, 0.56, 0.57, 0.58, 0.59, 0.6, 0.61, 0.62, 0.63, 0.64, 0.65, 0.66, 0.67, 0.68, 0.69, 0.7, 0.71, 0.72, 0.73, 0.74, 0.75, 0.76, 0.77, 0.78, 0.79, 0.8, 0.81, 0.82, 0.83, 0.84, 0.85, 0.86, 0.87, 0.88, 0.89, 0.9, 0.91, 0.92, 0.93, 0.94, 0.95, 0.96, 0.97, 0.98, 0.99, 1.0, 1.1, 1.2, 1.3, 1.4, 1.5, 1.6, 1.7, 1.8, 1.9, 2.0, 2.1, 2.2, 2.3, 2.4, 2.5, 2.6, 2.7, 2.8, 2.9, 3.0, 3.1, 3.2, 3.3, 3.4, 3.5, 3.6, 3.7, 3.8, 3.9, 4.0, 4.1, 4.2, 4.3, 4.4, 4.5, 4.6, 4.7, 4.8, 4.9, 5.0, 5.1, 5.2, 5.3, 5.4, 5.5, 5.6, 5.7, 5.8, 5.9, 6.0, 6.1, 6.2, 6.3, 6.4, 6.5, 6.6, 6.7, 6.8, 6.9, 7.0, 7.1, 7.2, 7.3, 7.4, 7.5, 7.6, 7.7, 7.8, 7.9, 8.0, 8.1, 8.2, 8.3, 8.4, 8.5, 8.6, 8.7, 8.8, 8.9, 9.0, 9.1, 9.2, 9.3, 9.4, 9.5, 9.6, 9.7, 9.8, 9.9, 10.0, 11.0, 12.0, 13.0, 14.0, 15.0, 16.0, 17.0, 18.0, 19.0, 20.0, 21.0, 22.0, 23.0, 24.0, 25.0, 26.0, 27.0, 28.0, 29.0, 30.0, 31.0, 32.0, 33.0, 34.0, 35.0, 36.0, 37.0, 38.0, 39.0, 40.0, 41.0, 42.0, 43.0, 44.0, 45.0, 46.0, 47.0, 48.0, 49.0, 50.0, 51.0, 52.0, 53.0, 54.0, 55.0, 56.0, 57.0, 58.0, 59.0, 60.0, 61.0, 62.0, 63.0, 64.0, 65.0, 66.0, 67.0, 68.0, 69.0, 70.0, 71.0, 72.0, 73.0, 74.0, 75.0, 76.0, 77.0, 78.0, 79.0, 80.0, 81.0, 82.0, 83.0, 84.0, 85.0, 86.0, 87.0, 88.0, 89.0, 90.0, 91.0, 92.0, 93.0, 94.0, 95.0, 96.0, 97.0, 98.0, 99.0, 100.0}, "Binning of the percentile axis"};
 
   int mRunNumber;
@@ -120,10 +126,51 @@ struct CentralityTable {
     TH1* mhVtxAmpCorr = nullptr;
     TH1* mhMultSelCalib = nullptr;
   } Run2CL1Info;
+  /// Flat copy of a calibration histogram, reproducing TH1::GetBinContent(TH1::FindFixBin(x)) without virtual calls
+  struct calibrationLut {
+    std::vector<float> contents; // bin contents including underflow and overflow
+    std::vector<double> edges;   // bin edges, empty for uniform binning
+    double xMin = 0.;
+    double xMax = 0.;
+    double invWidth = 0.;
+    int nBins = 0;
+    void build(const TH1* h)
+    {
+      const TAxis* axis = h->GetXaxis();
+      nBins = axis->GetNbins();
+      xMin = axis->GetXmin();
+      xMax = axis->GetXmax();
+      invWidth = nBins / (xMax - xMin);
+      edges.clear();
+      if (axis->GetXbins()->GetSize() > 0) {
+        edges.assign(axis->GetXbins()->GetArray(), axis->GetXbins()->GetArray() + nBins + 1);
+      }
+      contents.resize(nBins + 2);
+      for (int i = 0; i < nBins + 2; i++) {
+        contents[i] = h->GetBinContent(i);
+      }
+    }
+    int findBin(double x) const
+    {
+      if (x < xMin) {
+        return 0;
+      }
+      if (!(x < xMax)) {
+        return nBins + 1;
+      }
+      if (edges.empty()) {
+        return 1 + static_cast<int>((x - xMin) * invWidth);
+      }
+      return std::upper_bound(edges.begin(), edges.end(), x) - edges.begin();
+    }
+    float eval(double x) const { return contents[findBin(x)]; }
+  };
   struct calibrationInfo {
     std::string name = "";
     bool mCalibrationStored = false;
     TH1* mhMultSelCalib = nullptr;
+    calibrationLut mLut;
+    bool mUseLut = false;
     float mMCScalePars[6] = {0.0};
     TFormula* mMCScale = nullptr;
     explicit calibrationInfo(std::string name)
@@ -167,6 +214,15 @@ struct CentralityTable {
   void init(InitContext& context)
   {
     LOG(info) << "Initializing centrality table producer";
+    // Select the Run 2 or Run 3 process functions from the metadata, when it defines the run
+    if (metadataInfo.run3() != MetadataHelper::Property::kUndefined) {
+      const bool isRun3 = metadataInfo.run3() == MetadataHelper::Property::kYes;
+      if (doprocessRun3 != isRun3 || doprocessRun2 == isRun3) {
+        LOG(info) << "Enabling the " << (isRun3 ? "Run 3" : "Run 2") << " process function from the metadata";
+        doprocessRun3.value = isRun3;
+        doprocessRun2.value = !isRun3;
+      }
+    }
     if (doprocessRun3FT0 == true) {
       LOG(fatal) << "FT0 only mode is automatically enabled in Run3 mode. Please disable it and enable processRun3.";
     }
@@ -469,7 +525,8 @@ struct CentralityTable {
             listCalib->Add(callst->Clone(Form("%i", bc.runNumber())));
           }
           LOGF(info, "Getting new histograms with %d run number for %d run number", mRunNumber, bc.runNumber());
-          auto getccdb = [callst, bc](struct calibrationInfo& estimator, const Configurable<std::string> generatorName) { // TODO: to consider the name inside the estimator structure
+          const bool useLuts = useCalibrationLuts.value;
+          auto getccdb = [callst, bc, useLuts](struct calibrationInfo& estimator, const Configurable<std::string> generatorName) { // TODO: to consider the name inside the estimator structure
             estimator.mhMultSelCalib = reinterpret_cast<TH1*>(callst->FindObject(TString::Format("hCalibZeq%s", estimator.name.c_str()).Data()));
             estimator.mMCScale = reinterpret_cast<TFormula*>(callst->FindObject(TString::Format("%s-%s", generatorName->c_str(), estimator.name.c_str()).Data()));
             if (estimator.mhMultSelCalib != nullptr) {
@@ -486,6 +543,10 @@ struct CentralityTable {
               }
               estimator.mCalibrationStored = true;
               estimator.isSane();
+              estimator.mUseLut = useLuts;
+              if (useLuts) {
+                estimator.mLut.build(estimator.mhMultSelCalib);
+              }
             } else {
               LOGF(error, "Calibration information from %s for run %d not available", estimator.name.c_str(), bc.runNumber());
             }
@@ -548,7 +609,7 @@ struct CentralityTable {
             scaledMultiplicity = scaleMC(multiplicity, estimator.mMCScalePars);
             LOGF(debug, "Unscaled %s multiplicity: %f, scaled %s multiplicity: %f", estimator.name.c_str(), multiplicity, estimator.name.c_str(), scaledMultiplicity);
           }
-          percentile = estimator.mhMultSelCalib->GetBinContent(estimator.mhMultSelCalib->FindFixBin(scaledMultiplicity));
+          percentile = estimator.mUseLut ? estimator.mLut.eval(scaledMultiplicity) : estimator.mhMultSelCalib->GetBinContent(estimator.mhMultSelCalib->FindFixBin(scaledMultiplicity));
           if (assignOutOfRange)
             percentile = 100.5f;
         }
@@ -646,4 +707,9 @@ struct CentralityTable {
   PROCESS_SWITCH(CentralityTable, processRun3FT0, "Provide Run3 calibrated centrality/multiplicity percentiles tables for FT0 only", false);
 };
 
-WorkflowSpec defineDataProcessing(ConfigContext const& cfgc) { return WorkflowSpec{adaptAnalysisTask<CentralityTable>(cfgc)}; }
+WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
+{
+  // Parse the metadata
+  metadataInfo.initMetadata(cfgc);
+  return WorkflowSpec{adaptAnalysisTask<CentralityTable>(cfgc)};
+}
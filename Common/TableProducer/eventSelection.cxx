@@ -9,6 +9,8 @@
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
 
+#include <string>
+
 #include "Framework/ConfigParamSpec.h"
 #include "Framework/runDataProcessing.h"
 #include "Framework/AnalysisTask.h"
@@ -16,6 +18,10 @@
 #include "Common/DataModel/EventSelection.h"
 #include "Common/CCDB/EventSelectionParams.h"
 #include "Common/CCDB/TriggerAliases.h"
+#include "Common/Core/BcIndex.h"
+#include "Common/Core/MetadataHelper.h"
+#include "Common/Core/ReverseIndex.h"
+#include "Common/Core/TableHelper.h"
 #include "CCDB/BasicCCDBManager.h"
 #include "CommonConstants/LHCConstants.h"
 #include "Framework/HistogramRegistry.h"
@@ -36,6 +42,8 @@ using BCsWithBcSelsRun2 = soa::Join<aod::BCs, aod::Timestamps, aod::BcSels, aod:
 using BCsWithBcSelsRun3 = soa::Join<aod::BCs, aod::Timestamps, aod::BcSels>;
 using FullTracksIU = soa::Join<aod::TracksIU, aod::TracksExtra>;
 
+MetadataHelper metadataInfo; // Metadata helper
+
 struct BcSelectionTask {
   Produces<aod::BcSels> bcsel;
   Service<o2::ccdb::BasicCCDBManager> ccdb;
@@ -53,9 +61,20 @@ struct BcSelectionTask {
   int mITSROFrameEndBorderMargin = 20;   // default value
   int mTimeFrameStartBorderMargin = 300; // default value
   int mTimeFrameEndBorderMargin = 4000;  // default value
+  TriggerAliasMasks aliasMasks;          // class masks of the current trigger aliases
 
-  void init(InitContext&)
+  void init(InitContext& context)
   {
+    printTablesNotConsumedInWorkflow(context);
+    // Select the Run 2 or Run 3 process functions from the metadata, when it defines the run
+    if (metadataInfo.run3() != MetadataHelper::Property::kUndefined) {
+      const bool isRun3 = metadataInfo.run3() == MetadataHelper::Property::kYes;
+      if (doprocessRun3 != isRun3 || doprocessRun2 == isRun3) {
+        LOG(info) << "Enabling the " << (isRun3 ? "Run 3" : "Run 2") << " process function from the metadata";
+        doprocessRun3.value = isRun3;
+        doprocessRun2.value = !isRun3;
+      }
+    }
     // ccdb->setURL("http://ccdb-test.cern.ch:8080");
     ccdb->setURL("http://alice-ccdb.cern.ch");
     ccdb->setCaching(true);
@@ -93,19 +112,10 @@ struct BcSelectionTask {
       EventSelectionParams* par = ccdb->getForTimeStamp<EventSelectionParams>("EventSelection/EventSelectionParams", bc.timestamp());
       TriggerAliases* aliases = ccdb->getForTimeStamp<TriggerAliases>("EventSelection/TriggerAliases", bc.timestamp());
       // fill fired aliases
-      uint32_t alias{0};
-      uint64_t triggerMask = bc.triggerMask();
-      for (auto& al : aliases->GetAliasToTriggerMaskMap()) {
-        if (triggerMask & al.second) {
-          alias |= BIT(al.first);
-        }
-      }
-      uint64_t triggerMaskNext50 = bc.triggerMaskNext50();
-      for (auto& al : aliases->GetAliasToTriggerMaskNext50Map()) {
-        if (triggerMaskNext50 & al.second) {
-          alias |= BIT(al.first);
-        }
+      if (aliasMasks.GetSource() != aliases) {
+        aliasMasks.Set(aliases);
       }
+      uint32_t alias = aliasMasks.GetAliases(bc.triggerMask(), bc.triggerMaskNext50());
       alias |= BIT(kALL);
 
       // get timing info from ZDC, FV0, FT0 and FDD
@@ -221,10 +231,7 @@ struct BcSelectionTask {
     auto alppar = ccdb->getForTimeStamp<o2::itsmft::DPLAlpideParam<0>>("ITS/Config/AlpideParam", ts);
 
     // map from GlobalBC to BcId needed to find triggerBc
-    std::map<uint64_t, int32_t> mapGlobalBCtoBcId;
-    for (auto& bc : bcs) {
-      mapGlobalBCtoBcId[bc.globalBC()] = bc.globalIndex();
-    }
+    BcIndex mapGlobalBCtoBcId(bcs);
     int triggerBcShift = confTriggerBcShift;
     if (confTriggerBcShift == 999) {
       int run = bcs.iteratorAt(0).runNumber();
@@ -264,21 +271,32 @@ struct BcSelectionTask {
       }
     }
 
+    // the CCDB objects are looked up only when the timestamp changes, which happens a few times per time frame
+    int64_t lastTimestamp = -1;
+    EventSelectionParams* par = nullptr;
+    TriggerAliases* aliases = nullptr;
+    o2::parameters::GRPLHCIFData* grplhcif = nullptr;
+    // bin label of the run in the counter and lumi histograms
+    const std::string srunLabel = std::to_string(run);
+    const char* srun = srunLabel.c_str();
+
     // bc loop
     for (auto bc : bcs) {
-      EventSelectionParams* par = ccdb->getForTimeStamp<EventSelectionParams>("EventSelection/EventSelectionParams", bc.timestamp());
-      TriggerAliases* aliases = ccdb->getForTimeStamp<TriggerAliases>("EventSelection/TriggerAliases", bc.timestamp());
+      if (static_cast<int64_t>(bc.timestamp()) != lastTimestamp) {
+        lastTimestamp = bc.timestamp();
+        par = ccdb->getForTimeStamp<EventSelectionParams>("EventSelection/EventSelectionParams", lastTimestamp);
+        aliases = ccdb->getForTimeStamp<TriggerAliases>("EventSelection/TriggerAliases", lastTimestamp);
+        grplhcif = ccdb->getForTimeStamp<o2::parameters::GRPLHCIFData>("GLO/Config/GRPLHCIF", lastTimestamp);
+      }
       uint32_t alias{0};
       // workaround for pp2022 (trigger info is shifted by -294 bcs)
-      int32_t triggerBcId = mapGlobalBCtoBcId[bc.globalBC() + triggerBcShift];
-      if (triggerBcId) {
+      int32_t triggerBcId = mapGlobalBCtoBcId.find(bc.globalBC() + triggerBcShift);
+      if (triggerBcId > 0) {
         auto triggerBc = bcs.iteratorAt(triggerBcId);
-        uint64_t triggerMask = triggerBc.triggerMask();
-        for (auto& al : aliases->GetAliasToTriggerMaskMap()) {
-          if (triggerMask & al.second) {
-            alias |= BIT(al.first);
-          }
+        if (aliasMasks.GetSource() != aliases) {
+          aliasMasks.Set(aliases);
         }
+        alias |= aliasMasks.GetAliases(triggerBc.triggerMask());
       }
       alias |= BIT(kALL);
 
@@ -356,8 +374,6 @@ struct BcSelectionTask {
       LOGP(debug, "foundFT0={}", foundFT0);
 
       // Temporary workaround to get visible cross section. TODO: store run-by-run visible cross sections in CCDB
-      const char* srun = Form("%d", run);
-      auto grplhcif = ccdb->getForTimeStamp<o2::parameters::GRPLHCIFData>("GLO/Config/GRPLHCIF", bc.timestamp());
       int beamZ1 = grplhcif->getBeamZ(o2::constants::lhc::BeamA);
       int beamZ2 = grplhcif->getBeamZ(o2::constants::lhc::BeamC);
       bool isPP = beamZ1 == 1 && beamZ2 == 1;
@@ -444,22 +460,21 @@ struct EventSelectionTask {
   int64_t bcSOR = -1;     // global bc of the start of the first orbit
   int64_t nBCsPerTF = -1; // duration of TF in bcs, should be 128*3564 or 32*3564
 
-  int32_t findClosest(int64_t globalBC, std::map<int64_t, int32_t>& bcs)
-  {
-    auto it = bcs.lower_bound(globalBC);
-    int64_t bc1 = it->first;
-    int32_t index1 = it->second;
-    if (it != bcs.begin())
-      --it;
-    int64_t bc2 = it->first;
-    int32_t index2 = it->second;
-    int64_t dbc1 = std::abs(bc1 - globalBC);
-    int64_t dbc2 = std::abs(bc2 - globalBC);
-    return (dbc1 <= dbc2) ? index1 : index2;
-  }
+  ReverseIndex<int> vCollsInTimeWin;      // collisions in the occupancy time window of each collision
+  ReverseIndex<float> vTimeDeltaForColls; // their time wrt the collision
 
-  void init(InitContext&)
+  void init(InitContext& context)
   {
+    printTablesNotConsumedInWorkflow(context);
+    // Select the Run 2 or Run 3 process functions from the metadata, when it defines the run
+    if (metadataInfo.run3() != MetadataHelper::Property::kUndefined) {
+      const bool isRun3 = metadataInfo.run3() == MetadataHelper::Property::kYes;
+      if (doprocessRun3 != isRun3 || doprocessRun2 == isRun3) {
+        LOG(info) << "Enabling the " << (isRun3 ? "Run 3" : "Run 2") << " process function from the metadata";
+        doprocessRun3.value = isRun3;
+        doprocessRun2.value = !isRun3;
+      }
+    }
     // ccdb->setURL("http://ccdb-test.cern.ch:8080");
     ccdb->setURL("http://alice-ccdb.cern.ch");
     ccdb->setCaching(true);
@@ -582,8 +597,8 @@ struct EventSelectionTask {
 
     // create maps from globalBC to bc index for TVX or FT0-OR fired bcs
     // to be used for closest TVX (FT0-OR) searches
-    std::map<int64_t, int32_t> mapGlobalBcWithTVX;
-    std::map<int64_t, int32_t> mapGlobalBcWithTOR;
+    BcIndex mapGlobalBcWithTVX;
+    BcIndex mapGlobalBcWithTOR;
     for (auto& bc : bcs) {
       int64_t globalBC = bc.globalBC();
       // skip non-colliding bcs for data and anchored runs
@@ -591,12 +606,14 @@ struct EventSelectionTask {
         continue;
       }
       if (bc.selection_bit(kIsBBT0A) || bc.selection_bit(kIsBBT0C)) {
-        mapGlobalBcWithTOR[globalBC] = bc.globalIndex();
+        mapGlobalBcWithTOR.add(globalBC, bc.globalIndex());
       }
       if (bc.selection_bit(kIsTriggerTVX)) {
-        mapGlobalBcWithTVX[globalBC] = bc.globalIndex();
+        mapGlobalBcWithTVX.add(globalBC, bc.globalIndex());
       }
     }
+    mapGlobalBcWithTOR.finalize();
+    mapGlobalBcWithTVX.finalize();
 
     // protection against empty FT0 maps
     if (mapGlobalBcWithTOR.size() == 0 || mapGlobalBcWithTVX.size() == 0) {
@@ -676,12 +693,12 @@ struct EventSelectionTask {
       int64_t minBC = meanBC - deltaBC;
       int64_t maxBC = meanBC + deltaBC;
 
-      int32_t indexClosestTVX = findClosest(meanBC, mapGlobalBcWithTVX);
+      int32_t indexClosestTVX = mapGlobalBcWithTVX.findClosest(meanBC);
       int64_t tvxBC = bcs.iteratorAt(indexClosestTVX).globalBC();
       if (tvxBC >= minBC && tvxBC <= maxBC) { // closest TVX within search region
         bc.setCursor(indexClosestTVX);
       } else { // no TVX within search region, searching for TOR = T0A | T0C
-        int32_t indexClosestTOR = findClosest(meanBC, mapGlobalBcWithTOR);
+        int32_t indexClosestTOR = mapGlobalBcWithTOR.findClosest(meanBC);
         int64_t torBC = bcs.iteratorAt(indexClosestTOR).globalBC();
         if (torBC >= minBC && torBC <= maxBC) {
           bc.setCursor(indexClosestTOR);
@@ -704,17 +721,16 @@ struct EventSelectionTask {
     }
 
     // save indices of collisions in time range for occupancy calculation
-    std::vector<std::vector<int>> vCollsInTimeWin;
-    std::vector<std::vector<float>> vTimeDeltaForColls; // delta time wrt a given collision
+    // the lists of all the collisions are stored in two flat arrays, with no vector per collision
+    vCollsInTimeWin.clear();
+    vTimeDeltaForColls.clear(); // delta time wrt a given collision
     for (auto& col : cols) {
       int32_t colIndex = col.globalIndex();
-      std::vector<int> vAssocToThisCol;
-      std::vector<float> vCollsTimeDeltaWrtGivenColl;
 
       // protection against the TF borders
       if (!vIsFullInfoForOccupancy[colIndex]) {
-        vCollsInTimeWin.push_back(vAssocToThisCol);
-        vTimeDeltaForColls.push_back(vCollsTimeDeltaWrtGivenColl);
+        vCollsInTimeWin.closeList();
+        vTimeDeltaForColls.closeList();
         continue;
       }
 
@@ -734,8 +750,8 @@ struct EventSelectionTask {
         // check if we are within the chosen time range
         if (dt < timeWinOccupancyCalcMinNS)
           break;
-        vAssocToThisCol.push_back(minColIndex);
-        vCollsTimeDeltaWrtGivenColl.push_back(dt);
+        vCollsInTimeWin.push_back(minColIndex);
+        vTimeDeltaForColls.push_back(dt);
         minColIndex--;
       }
       // find all collisions in time window after the current one
@@ -748,12 +764,12 @@ struct EventSelectionTask {
         float dt = (thisBC - foundGlobalBC) * bcNS; // ns
         if (dt > timeWinOccupancyCalcMaxNS)
           break;
-        vAssocToThisCol.push_back(maxColIndex);
-        vCollsTimeDeltaWrtGivenColl.push_back(dt);
+        vCollsInTimeWin.push_back(maxColIndex);
+        vTimeDeltaForColls.push_back(dt);
         maxColIndex++;
       }
-      vCollsInTimeWin.push_back(vAssocToThisCol);
-      vTimeDeltaForColls.push_back(vCollsTimeDeltaWrtGivenColl);
+      vCollsInTimeWin.closeList();
+      vTimeDeltaForColls.closeList();
     }
 
     // perform the occupancy calculation in the pre-defined time window
@@ -777,8 +793,8 @@ struct EventSelectionTask {
         vNumTracksITS567inFullTimeWin[colIndex] = -1; // occupancy in undefined (too close to TF borders)
         continue;
       }
-      std::vector<int> vAssocToThisCol = vCollsInTimeWin[colIndex];
-      std::vector<float> vCollsTimeDeltaWrtGivenColl = vTimeDeltaForColls[colIndex];
+      const auto vAssocToThisCol = vCollsInTimeWin[colIndex];
+      const auto vCollsTimeDeltaWrtGivenColl = vTimeDeltaForColls[colIndex];
       int nITS567tracksInFullTimeWindow = 0;
       int nITS567tracksInTimeBins[nTimeIntervals] = {};
       int nITS567tracksForVetoStandard = 0; // to veto events with nearby collisions
@@ -892,6 +908,8 @@ struct EventSelectionTask {
 
 WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
 {
+  // Parse the metadata
+  metadataInfo.initMetadata(cfgc);
   return WorkflowSpec{
     adaptAnalysisTask<BcSelectionTask>(cfgc),
     adaptAnalysisTask<EventSelectionTask>(cfgc)};
@@ -31,24 +31,27 @@ struct FT0CorrectedTable {
 
   void process(BCsWithMatchings const&, soa::Join<aod::Collisions, aod::EvSels> const& collisions, aod::FT0s const&)
   {
+    constexpr float dummyTime = 30.; // Due to HW limitations time can be only within range (-25,25) ns, dummy time is around 32 ns
+    table.reserve(collisions.size());
     for (auto& collision : collisions) {
-      float vertexPV = collision.posZ();
-      float vertex_corr = vertexPV / o2::constants::physics::LightSpeedCm2NS;
       float t0A = 1e10;
       float t0C = 1e10;
-      constexpr float dummyTime = 30.; // Due to HW limitations time can be only within range (-25,25) ns, dummy time is around 32 ns
       if (collision.has_foundFT0()) {
+        float vertexPV = collision.posZ();
+        float vertex_corr = vertexPV / o2::constants::physics::LightSpeedCm2NS;
         auto ft0 = collision.foundFT0();
+        const float timeA = ft0.timeA();
+        const float timeC = ft0.timeC();
         std::bitset<8> triggers = ft0.triggerMask();
         bool ora = triggers[o2::ft0::Triggers::bitA];
         bool orc = triggers[o2::ft0::Triggers::bitC];
         LOGF(debug, "triggers OrA %i OrC %i ", ora, orc);
-        LOGF(debug, " T0A = %f, T0C %f, vertex_corr %f", ft0.timeA(), ft0.timeC(), vertex_corr);
-        if (ora && ft0.timeA() < dummyTime) {
-          t0A = ft0.timeA() + vertex_corr;
+        LOGF(debug, " T0A = %f, T0C %f, vertex_corr %f", timeA, timeC, vertex_corr);
+        if (ora && timeA < dummyTime) {
+          t0A = timeA + vertex_corr;
         }
-        if (orc && ft0.timeC() < dummyTime) {
-          t0C = ft0.timeC() - vertex_corr;
+        if (orc && timeC < dummyTime) {
+          t0C = timeC - vertex_corr;
         }
       }
       LOGF(debug, " T0 collision time T0A = %f, T0C = %f", t0A, t0C);
@@ -75,150 +75,77 @@ struct mftmchMatchingML {
   Configurable<int> cfgColWindow{"collision-window", 1, "Search window (collision ID) for MFT track"};
   Configurable<float> cfgXYWindow{"XY-window", 3, "Search window (delta XY) for MFT track"};
 
-  Ort::Env env{ORT_LOGGING_LEVEL_WARNING, "model-explorer"};
-  Ort::SessionOptions session_options;
-#if __has_include(<onnxruntime/core/session/onnxruntime_cxx_api.h>)
-  std::shared_ptr<Ort::Experimental::Session> onnx_session = nullptr;
-#else
-  std::shared_ptr<Ort::Session> onnx_session = nullptr;
-#endif
   OnnxModel model;
 
-  template <typename F, typename M>
-  std::vector<float> getVariables(F const& fwdtrack, M const& mfttrack)
+  /// Parameters of a track at the matching plane, the inputs of the model
+  struct TrackAtMatchingPlane {
+    float x;
+    float y;
+    float phi;
+    float tanl;
+  };
+
+  /// MCH-MFT pair within the collision window, with its row in the batched model input (-1 if outside of the XY window)
+  struct MatchingPair {
+    int mftTrackId;
+    int inputRow;
+  };
+
+  std::vector<TrackAtMatchingPlane> mftTracksAtPlane; // MFT tracks of the dataframe at the matching plane, propagated once
+  std::vector<MatchingPair> pairs;                    // pairs of all the muons of the dataframe, muon after muon
+  std::vector<float> pairInputs;                      // flattened inputs of the pairs within the XY window
+  std::vector<float> pairScores;                      // scores of the pairs within the XY window
+
+  template <typename T>
+  TrackAtMatchingPlane propagateToMatchingPlane(T const& track)
   {
 
     static constexpr Double_t MatchingPlaneZ = -77.5;
 
-    // propagate muontrack to matching position
-    double muonchi2 = fwdtrack.chi2();
-    SMatrix5 muonpars(fwdtrack.x(), fwdtrack.y(), fwdtrack.phi(), fwdtrack.tgl(), fwdtrack.signed1Pt());
-    std::vector<double> muonv1;
-    SMatrix55 muoncovs(muonv1.begin(), muonv1.end());
-    o2::track::TrackParCovFwd muonpars1{fwdtrack.z(), muonpars, muoncovs, muonchi2};
-    muonpars1.propagateToZlinear(MatchingPlaneZ);
+    double chi2 = track.chi2();
+    SMatrix5 pars(track.x(), track.y(), track.phi(), track.tgl(), track.signed1Pt());
+    std::vector<double> v1;
+    SMatrix55 covs(v1.begin(), v1.end());
+    o2::track::TrackParCovFwd pars1{track.z(), pars, covs, chi2};
+    pars1.propagateToZlinear(MatchingPlaneZ);
 
-    // propagate mfttrack to matching position
-    double mftchi2 = mfttrack.chi2();
-    SMatrix5 mftpars(mfttrack.x(), mfttrack.y(), mfttrack.phi(), mfttrack.tgl(), mfttrack.signed1Pt());
-    std::vector<double> mftv1;
-    SMatrix55 mftcovs(mftv1.begin(), mftv1.end());
-    o2::track::TrackParCovFwd mftpars1{mfttrack.z(), mftpars, mftcovs, mftchi2};
-    mftpars1.propagateToZlinear(MatchingPlaneZ);
+    return {static_cast<Float_t>(pars1.getX()), static_cast<Float_t>(pars1.getY()), static_cast<Float_t>(pars1.getPhi()), static_cast<Float_t>(pars1.getTanl())};
+  }
 
-    Float_t MFT_X = mftpars1.getX();
-    Float_t MFT_Y = mftpars1.getY();
-    Float_t MFT_Phi = mftpars1.getPhi();
-    Float_t MFT_Tanl = mftpars1.getTanl();
+  /// Appends the model inputs of a pair to the batch if the tracks are within the XY window at the matching plane
+  /// \return whether the pair was added
+  bool addVariables(TrackAtMatchingPlane const& muon, TrackAtMatchingPlane const& mft)
+  {
+    Float_t MFT_X = mft.x;
+    Float_t MFT_Y = mft.y;
+    Float_t MFT_Phi = mft.phi;
+    Float_t MFT_Tanl = mft.tanl;
 
-    Float_t MCH_X = muonpars1.getX();
-    Float_t MCH_Y = muonpars1.getY();
-    Float_t MCH_Phi = muonpars1.getPhi();
-    Float_t MCH_Tanl = muonpars1.getTanl();
+    Float_t MCH_X = muon.x;
+    Float_t MCH_Y = muon.y;
+    Float_t MCH_Phi = muon.phi;
+    Float_t MCH_Tanl = muon.tanl;
+
+    Float_t Delta_X = MFT_X - MCH_X;
+    Float_t Delta_Y = MFT_Y - MCH_Y;
+
+    Float_t Delta_XY = sqrt(Delta_X * Delta_X + Delta_Y * Delta_Y);
+    if (!(Delta_XY < cfgXYWindow)) {
+      return false;
+    }
 
     Float_t Ratio_X = MFT_X / MCH_X;
     Float_t Ratio_Y = MFT_Y / MCH_Y;
     Float_t Ratio_Phi = MFT_Phi / MCH_Phi;
     Float_t Ratio_Tanl = MFT_Tanl / MCH_Tanl;
 
-    Float_t Delta_X = MFT_X - MCH_X;
-    Float_t Delta_Y = MFT_Y - MCH_Y;
     Float_t Delta_Phi = MFT_Phi - MCH_Phi;
     Float_t Delta_Tanl = MFT_Tanl - MCH_Tanl;
 
-    Float_t Delta_XY = sqrt(Delta_X * Delta_X + Delta_Y * Delta_Y);
-
-    std::vector<float> input_tensor_values{
-      MFT_X,
-      MFT_Y,
-      MFT_Phi,
-      MFT_Tanl,
-      MCH_X,
-      MCH_Y,
-      MCH_Phi,
-      MCH_Tanl,
-      Delta_XY,
-      Delta_X,
-      Delta_Y,
-      Delta_Phi,
-      Delta_Tanl,
-      Ratio_X,
-      Ratio_Y,
-      Ratio_Phi,
-      Ratio_Tanl,
-    };
-    return input_tensor_values;
+    pairInputs.insert(pairInputs.end(), {MFT_X, MFT_Y, MFT_Phi, MFT_Tanl, MCH_X, MCH_Y, MCH_Phi, MCH_Tanl, Delta_XY, Delta_X, Delta_Y, Delta_Phi, Delta_Tanl, Ratio_X, Ratio_Y, Ratio_Phi, Ratio_Tanl});
+    return true;
   }
 
-  template <typename F, typename M>
-  double matchONNX(F const& fwdtrack, M const& mfttrack)
-  {
-    std::vector<std::string> input_names;
-    std::vector<std::vector<int64_t>> input_shapes;
-    std::vector<std::string> output_names;
-    std::vector<std::vector<int64_t>> output_shapes;
-
-#if __has_include(<onnxruntime/core/session/onnxruntime_cxx_api.h>)
-    input_names = onnx_session->GetInputNames();
-    input_shapes = onnx_session->GetInputShapes();
-    output_names = onnx_session->GetOutputNames();
-    output_shapes = onnx_session->GetOutputShapes();
-#else
-    Ort::AllocatorWithDefaultOptions tmpAllocator;
-    for (size_t i = 0; i < onnx_session->GetInputCount(); ++i) {
-      input_names.push_back(onnx_session->GetInputNameAllocated(i, tmpAllocator).get());
-    }
-    for (size_t i = 0; i < onnx_session->GetInputCount(); ++i) {
-      input_shapes.emplace_back(onnx_session->GetInputTypeInfo(i).GetTensorTypeAndShapeInfo().GetShape());
-    }
-    for (size_t i = 0; i < onnx_session->GetOutputCount(); ++i) {
-      output_names.push_back(onnx_session->GetOutputNameAllocated(i, tmpAllocator).get());
-    }
-    for (size_t i = 0; i < onnx_session->GetOutputCount(); ++i) {
-      output_shapes.emplace_back(onnx_session->GetOutputTypeInfo(i).GetTensorTypeAndShapeInfo().GetShape());
-    }
-#endif
-
-    auto input_shape = input_shapes[0];
-    input_shape[0] = 1;
-
-    std::vector<float> input_tensor_values;
-    input_tensor_values = getVariables(fwdtrack, mfttrack);
-
-    if (input_tensor_values[8] < cfgXYWindow) {
-      std::vector<Ort::Value> input_tensors;
-#if __has_include(<onnxruntime/core/session/onnxruntime_cxx_api.h>)
-      input_tensors.push_back(Ort::Experimental::Value::CreateTensor<float>(input_tensor_values.data(), input_tensor_values.size(), input_shape));
-
-      std::vector<Ort::Value> output_tensors = onnx_session->Run(input_names, input_tensors, output_names);
-#else
-      Ort::MemoryInfo mem_info =
-        Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
-      input_tensors.push_back(Ort::Value::CreateTensor<float>(mem_info, input_tensor_values.data(), input_tensor_values.size(), input_shape.data(), input_shape.size()));
-
-      Ort::RunOptions runOptions;
-      std::vector<const char*> inputNamesChar(input_names.size(), nullptr);
-      std::transform(std::begin(input_names), std::end(input_names), std::begin(inputNamesChar),
-                     [&](const std::string& str) { return str.c_str(); });
-
-      std::vector<const char*> outputNamesChar(output_names.size(), nullptr);
-      std::transform(std::begin(output_names), std::end(output_names), std::begin(outputNamesChar),
-                     [&](const std::string& str) { return str.c_str(); });
-
-      std::vector<Ort::Value> output_tensors = onnx_session->Run(runOptions, inputNamesChar.data(), input_tensors.data(), input_tensors.size(), outputNamesChar.data(), outputNamesChar.size());
-#endif
-
-      const float* output_value = output_tensors[0].GetTensorData<float>();
-
-      auto score = output_value[0];
-
-      return score;
-    } else {
-      auto score = 0;
-      return score;
-    }
-  };
-
   void init(o2::framework::InitContext&)
   {
     o2::ccdb::CcdbApi ccdbApi;
@@ -236,7 +163,6 @@ struct mftmchMatchingML {
                 << "."
                 << "/" << cfgModelName.value;
       model.initModel(cfgModelName, false, 1, strtoul(headers["Valid-From"].c_str(), NULL, 0), strtoul(headers["Valid-Until"].c_str(), NULL, 0));
-      onnx_session = model.getSession();
     } else {
       LOG(info) << "Failed to retrieve Network file";
     }
@@ -244,39 +170,63 @@ struct mftmchMatchingML {
 
   void process(aod::Collisions const&, soa::Filtered<aod::FwdTracks> const& fwdtracks, aod::MFTTracks const& mfttracks)
   {
+    mftTracksAtPlane.clear();
+    for (auto& mfttrack : mfttracks) {
+      mftTracksAtPlane.push_back(propagateToMatchingPlane(mfttrack));
+    }
+
+    // collect the pairs of all the muons, then score them in a single inference
+    pairs.clear();
+    pairInputs.clear();
+    int nInputRows = 0;
+    for (auto& fwdtrack : fwdtracks) {
+      if (fwdtrack.trackType() != aod::fwdtrack::ForwardTrackTypeEnum::MuonStandaloneTrack || !fwdtrack.has_collision()) {
+        continue;
+      }
+      const auto muonAtPlane = propagateToMatchingPlane(fwdtrack);
+      for (auto& mfttrack : mfttracks) {
+        if (mfttrack.has_collision()) {
+          if (0 <= fwdtrack.collisionId() - mfttrack.collisionId() && fwdtrack.collisionId() - mfttrack.collisionId() < cfgColWindow) {
+            const int inputRow = addVariables(muonAtPlane, mftTracksAtPlane[mfttrack.globalIndex()]) ? nInputRows++ : -1;
+            pairs.push_back({static_cast<int>(mfttrack.globalIndex()), inputRow});
+          }
+        }
+      }
+      pairs.push_back({-1, -1}); // end of the pairs of this muon
+    }
+    if (model.evalModelBatch(pairInputs, pairScores) != nInputRows) {
+      LOG(fatal) << "Failed to evaluate the matching scores of " << nInputRows << " MCH-MFT pairs";
+    }
+    const int nOutputs = nInputRows > 0 ? pairScores.size() / nInputRows : 0;
+
+    auto pair = pairs.begin();
     for (auto& fwdtrack : fwdtracks) {
-      if (fwdtrack.trackType() == aod::fwdtrack::ForwardTrackTypeEnum::MuonStandaloneTrack) {
+      if (fwdtrack.trackType() == aod::fwdtrack::ForwardTrackTypeEnum::MuonStandaloneTrack && fwdtrack.has_collision()) {
         double bestscore = 0;
         int bestmfttrackid = -1;
-        for (auto& mfttrack : mfttracks) {
-          if (fwdtrack.has_collision() && mfttrack.has_collision()) {
-            if (0 <= fwdtrack.collisionId() - mfttrack.collisionId() && fwdtrack.collisionId() - mfttrack.collisionId() < cfgColWindow) {
-              double result = matchONNX(fwdtrack, mfttrack);
-              if (result > cfgThrScore) {
-                bestscore = result;
-                bestmfttrackid = mfttrack.globalIndex();
-              }
-            }
+        for (; pair->mftTrackId != -1; ++pair) {
+          double result = pair->inputRow >= 0 ? pairScores[pair->inputRow * nOutputs] : 0;
+          if (result > cfgThrScore) {
+            bestscore = result;
+            bestmfttrackid = pair->mftTrackId;
           }
         }
+        ++pair;
         if (bestmfttrackid != -1) {
-          for (auto& mfttrack : mfttracks) {
-            if (mfttrack.globalIndex() == bestmfttrackid) {
-              double mftchi2 = mfttrack.chi2();
-              SMatrix5 mftpars(mfttrack.x(), mfttrack.y(), mfttrack.phi(), mfttrack.tgl(), mfttrack.signed1Pt());
-              std::vector<double> mftv1;
-              SMatrix55 mftcovs(mftv1.begin(), mftv1.end());
-              o2::track::TrackParCovFwd mftpars1{mfttrack.z(), mftpars, mftcovs, mftchi2};
-              mftpars1.propagateToZlinear(mfttrack.collision().posZ());
-
-              float dcaX = (mftpars1.getX() - mfttrack.collision().posX());
-              float dcaY = (mftpars1.getY() - mfttrack.collision().posY());
-              double px = fwdtrack.p() * sin(M_PI / 2 - atan(mfttrack.tgl())) * cos(mfttrack.phi());
-              double py = fwdtrack.p() * sin(M_PI / 2 - atan(mfttrack.tgl())) * sin(mfttrack.phi());
-              double pz = fwdtrack.p() * cos(M_PI / 2 - atan(mfttrack.tgl()));
-              fwdtrackml(fwdtrack.collisionId(), 0, mfttrack.x(), mfttrack.y(), mfttrack.z(), mfttrack.phi(), mfttrack.tgl(), fwdtrack.sign() / std::sqrt(std::pow(px, 2) + std::pow(py, 2)), fwdtrack.nClusters(), fwdtrack.pDca(), fwdtrack.rAtAbsorberEnd(), 0, 0, 0, bestscore, mfttrack.globalIndex(), fwdtrack.globalIndex(), fwdtrack.mchBitMap(), fwdtrack.midBitMap(), fwdtrack.midBoards(), mfttrack.trackTime(), mfttrack.trackTimeRes(), mfttrack.eta(), std::sqrt(std::pow(px, 2) + std::pow(py, 2)), std::sqrt(std::pow(px, 2) + std::pow(py, 2) + std::pow(pz, 2)), dcaX, dcaY);
-            }
-          }
+          auto mfttrack = mfttracks.rawIteratorAt(bestmfttrackid);
+          double mftchi2 = mfttrack.chi2();
+          SMatrix5 mftpars(mfttrack.x(), mfttrack.y(), mfttrack.phi(), mfttrack.tgl(), mfttrack.signed1Pt());
+          std::vector<double> mftv1;
+          SMatrix55 mftcovs(mftv1.begin(), mftv1.end());
+          o2::track::TrackParCovFwd mftpars1{mfttrack.z(), mftpars, mftcovs, mftchi2};
+          mftpars1.propagateToZlinear(mfttrack.collision().posZ());
+
+          float dcaX = (mftpars1.getX() - mfttrack.collision().posX());
+          float dcaY = (mftpars1.getY() - mfttrack.collision().posY());
+          double px = fwdtrack.p() * sin(M_PI / 2 - atan(mfttrack.tgl())) * cos(mfttrack.phi());
+          double py = fwdtrack.p() * sin(M_PI / 2 - atan(mfttrack.tgl())) * sin(mfttrack.phi());
+          double pz = fwdtrack.p() * cos(M_PI / 2 - atan(mfttrack.tgl()));
+          fwdtrackml(fwdtrack.collisionId(), 0, mfttrack.x(), mfttrack.y(), mfttrack.z(), mfttrack.phi(), mfttrack.tgl(), fwdtrack.sign() / std::sqrt(std::pow(px, 2) + std::pow(py, 2)), fwdtrack.nClusters(), fwdtrack.pDca(), fwdtrack.rAtAbsorberEnd(), 0, 0, 0, bestscore, mfttrack.globalIndex(), fwdtrack.globalIndex(), fwdtrack.mchBitMap(), fwdtrack.midBitMap(), fwdtrack.midBoards(), mfttrack.trackTime(), mfttrack.trackTimeRes(), mfttrack.eta(), std::sqrt(std::pow(px, 2) + std::pow(py, 2)), std::sqrt(std::pow(px, 2) + std::pow(py, 2) + std::pow(pz, 2)), dcaX, dcaY);
         }
       }
     }
@@ -112,6 +112,8 @@ struct MultiplicityTable {
   Configurable<std::string> ccdbUrl{"ccdburl", "http://alice-ccdb.cern.ch", "The CCDB endpoint url address"};
   Configurable<std::string> ccdbPath{"ccdbpath", "Centrality/Calibration", "The CCDB path for centrality/multiplicity information"};
   Configurable<bool> produceHistograms{"produceHistograms", false, {"Option to produce debug histograms"}};
+  Configurable<bool> fusedTrackCounters{"fusedTrackCounters", true, {"Run 3: count the tracks of all collisions in a single pass over the track table instead of slicing the track partitions per collision"}};
+  Configurable<int> enableMultsGlobal{"enableMultsGlobal", -1, {"Produce the MultsGlobal table (processGlobalTrackingCounters). -1: only if it is required by another task, 0: off, 1: on"}};
 
   int mRunNumber;
   bool lCalibLoaded;
@@ -124,6 +126,24 @@ struct MultiplicityTable {
   TProfile* hVtxZNTracks;
   std::vector<int> mEnabledTables; // Vector of enabled tables
 
+  /// Track-based estimators of one collision, filled in a single pass over the tracks
+  struct TrackCounters {
+    int nTPC = 0;              // tracks with TPC clusters findable
+    int nContribs = 0;         // PV contributors with |eta| < 0.8
+    int nContribsEta1 = 0;     // PV contributors with |eta| < 1
+    int nContribsEtaHalf = 0;  // PV contributors with |eta| < 0.5
+    int nHasITS = 0;           // PV contributors with ITS
+    int nHasTPC = 0;           // PV contributors with TPC
+    int nHasTOF = 0;           // PV contributors with TOF
+    int nHasTRD = 0;           // PV contributors with TRD
+    int nITSonly = 0;          // ITS-only PV contributors
+    int nTPConly = 0;          // TPC-only PV contributors
+    int nITSTPC = 0;           // ITS-TPC PV contributors
+    int nAllTracksTPCOnly = 0; // tracks with TPC and without ITS
+    int nAllTracksITSTPC = 0;  // tracks with TPC and ITS
+  };
+  std::vector<TrackCounters> mTrackCounters; // Track counters, indexed by collision
+
   // Debug output
   HistogramRegistry histos{"Histos", {}, OutputObjHandlingPolicy::QAObject};
   OutputObj<TList> listCalib{"calib-list", OutputObjHandlingPolicy::QAObject};
@@ -135,7 +155,7 @@ struct MultiplicityTable {
       if (metadataInfo.isRun3()) {
         doprocessRun3.value = true;
       } else {
-        doprocessRun2.value = false;
+        doprocessRun2.value = true;
       }
     }
 
@@ -185,6 +205,15 @@ struct MultiplicityTable {
     }
     std::sort(mEnabledTables.begin(), mEnabledTables.end());
 
+    // MultsGlobal is produced by its own process function, enable it only when it is consumed
+    int fGlobal = enableMultsGlobal.value;
+    enableFlagIfTableRequired(context, "MultsGlobal", fGlobal);
+    if (fGlobal == 1 && !doprocessGlobalTrackingCounters) {
+      doprocessGlobalTrackingCounters.value = true;
+      LOG(info) << "Enabling processGlobalTrackingCounters due to the MultsGlobal table being required.";
+    }
+    printTablesNotConsumedInWorkflow(context);
+
     mRunNumber = 0;
     lCalibLoaded = false;
     lCalibObjects = nullptr;
@@ -280,8 +309,63 @@ struct MultiplicityTable {
   Partition<Run3Tracks> pvContribTracksIU = (nabs(aod::track::eta) < 0.8f) && ((aod::track::flags & (uint32_t)o2::aod::track::PVContributor) == (uint32_t)o2::aod::track::PVContributor);
   Partition<Run3Tracks> pvContribTracksIUEta1 = (nabs(aod::track::eta) < 1.0f) && ((aod::track::flags & (uint32_t)o2::aod::track::PVContributor) == (uint32_t)o2::aod::track::PVContributor);
   Partition<Run3Tracks> pvContribTracksIUEtaHalf = (nabs(aod::track::eta) < 0.5f) && ((aod::track::flags & (uint32_t)o2::aod::track::PVContributor) == (uint32_t)o2::aod::track::PVContributor);
+  /// Fills the track counters of all the collisions with one loop over the track table.
+  /// The selections are the same as the ones of the partitions used per collision.
+  void fillTrackCounters(int nCollisions, Run3Tracks const& tracks, bool countPV, bool countExtra)
+  {
+    mTrackCounters.assign(nCollisions, TrackCounters{});
+    for (const auto& track : tracks) {
+      const int collisionId = track.collisionId();
+      if (collisionId < 0 || collisionId >= nCollisions) {
+        continue;
+      }
+      TrackCounters& counters = mTrackCounters[collisionId];
+      const bool hasITS = track.hasITS();
+      const bool hasTPC = track.hasTPC();
+      const bool hasTOF = track.hasTOF();
+      const bool hasTRD = track.hasTRD();
+      if (track.tpcNClsFindable() > 0) {
+        counters.nTPC++;
+        if (hasITS) {
+          counters.nAllTracksITSTPC++;
+        } else {
+          counters.nAllTracksTPCOnly++;
+        }
+      }
+      if ((track.flags() & o2::aod::track::PVContributor) != o2::aod::track::PVContributor) {
+        continue;
+      }
+      const float absEta = std::abs(track.eta());
+      if (countPV && absEta < 1.0f) {
+        counters.nContribsEta1++;
+        if (absEta < 0.8)
+          counters.nContribs++;
+        if (absEta < 0.5)
+          counters.nContribsEtaHalf++;
+      }
+      if (countExtra) {
+        if (hasITS) {
+          counters.nHasITS++;
+          if (hasTPC)
+            counters.nITSTPC++;
+          if (!hasTPC && !hasTOF && !hasTRD)
+            counters.nITSonly++;
+        }
+        if (hasTPC) {
+          counters.nHasTPC++;
+          if (!hasITS && !hasTOF && !hasTRD)
+            counters.nTPConly++;
+        }
+        if (hasTOF)
+          counters.nHasTOF++;
+        if (hasTRD)
+          counters.nHasTRD++;
+      }
+    }
+  }
+
   void processRun3(soa::Join<aod::Collisions, aod::EvSels> const& collisions,
-                   Run3Tracks const&,
+                   Run3Tracks const& tracks,
                    BCsWithRun3Matchings const&,
                    aod::Zdcs const&,
                    aod::FV0As const&,
@@ -338,6 +422,20 @@ struct MultiplicityTable {
       }
     }
 
+    // Count the tracks of all the collisions at once if any track-based table is enabled
+    bool useTrackCounters = false;
+    if (fusedTrackCounters) {
+      bool countPV = false, countExtra = false;
+      for (auto i : mEnabledTables) {
+        useTrackCounters |= (i == kTPCMults || i == kPVMults || i == kMultsExtra);
+        countPV |= (i == kPVMults);
+        countExtra |= (i == kMultsExtra);
+      }
+      if (useTrackCounters) {
+        fillTrackCounters(collisions.size(), tracks, countPV, countExtra);
+      }
+    }
+
     // Initializing multiplicity values
     float multFV0A = 0.f;
     float multFV0C = 0.f;
@@ -488,21 +586,33 @@ struct MultiplicityTable {
           } break;
           case kTPCMults: // TPC
           {
-            const auto& tracksGrouped = tracksIUWithTPC->sliceByCached(aod::track::collisionId, collision.globalIndex(), cache);
-            const int multTPC = tracksGrouped.size();
+            int multTPC = 0;
+            if (useTrackCounters) {
+              multTPC = mTrackCounters[collision.globalIndex()].nTPC;
+            } else {
+              const auto& tracksGrouped = tracksIUWithTPC->sliceByCached(aod::track::collisionId, collision.globalIndex(), cache);
+              multTPC = tracksGrouped.size();
+            }
             tableTpc(multTPC);
             LOGF(debug, "multTPC=%i", multTPC);
           } break;
           case kPVMults: // PV multiplicity
           {
-            // use only one single grouping operation, then do loop
-            const auto& tracksThisCollision = pvContribTracksIUEta1.sliceByCached(aod::track::collisionId, collision.globalIndex(), cache);
-            multNContribsEta1 = tracksThisCollision.size();
-            for (auto track : tracksThisCollision) {
-              if (std::abs(track.eta()) < 0.8)
-                multNContribs++;
-              if (std::abs(track.eta()) < 0.5)
-                multNContribsEtaHalf++;
+            if (useTrackCounters) {
+              const auto& counters = mTrackCounters[collision.globalIndex()];
+              multNContribs = counters.nContribs;
+              multNContribsEta1 = counters.nContribsEta1;
+              multNContribsEtaHalf = counters.nContribsEtaHalf;
+            } else {
+              // use only one single grouping operation, then do loop
+              const auto& tracksThisCollision = pvContribTracksIUEta1.sliceByCached(aod::track::collisionId, collision.globalIndex(), cache);
+              multNContribsEta1 = tracksThisCollision.size();
+              for (auto track : tracksThisCollision) {
+                if (std::abs(track.eta()) < 0.8)
+                  multNContribs++;
+                if (std::abs(track.eta()) < 0.5)
+                  multNContribsEtaHalf++;
+              }
             }
             tablePv(multNContribs, multNContribsEta1, multNContribsEtaHalf);
             LOGF(debug, "multNContribs=%i, multNContribsEta1=%i, multNContribsEtaHalf=%i", multNContribs, multNContribsEta1, multNContribsEtaHalf);
@@ -511,35 +621,48 @@ struct MultiplicityTable {
           {
             int nHasITS = 0, nHasTPC = 0, nHasTOF = 0, nHasTRD = 0;
             int nITSonly = 0, nTPConly = 0, nITSTPC = 0;
-            const auto& pvAllContribsGrouped = pvAllContribTracksIU->sliceByCached(aod::track::collisionId, collision.globalIndex(), cache);
-            const auto& tpcTracksGrouped = tracksIUWithTPC->sliceByCached(aod::track::collisionId, collision.globalIndex(), cache);
-
-            for (auto track : pvAllContribsGrouped) {
-              if (track.hasITS()) {
-                nHasITS++;
-                if (track.hasTPC())
-                  nITSTPC++;
-                if (!track.hasTPC() && !track.hasTOF() && !track.hasTRD())
-                  nITSonly++;
-              }
-              if (track.hasTPC()) {
-                nHasTPC++;
-                if (!track.hasITS() && !track.hasTOF() && !track.hasTRD())
-                  nTPConly++;
-              }
-              if (track.hasTOF())
-                nHasTOF++;
-              if (track.hasTRD())
-                nHasTRD++;
-            }
-
             int nAllTracksTPCOnly = 0;
             int nAllTracksITSTPC = 0;
-            for (auto track : tpcTracksGrouped) {
-              if (track.hasITS()) {
-                nAllTracksITSTPC++;
-              } else {
-                nAllTracksTPCOnly++;
+            if (useTrackCounters) {
+              const auto& counters = mTrackCounters[collision.globalIndex()];
+              nHasITS = counters.nHasITS;
+              nHasTPC = counters.nHasTPC;
+              nHasTOF = counters.nHasTOF;
+              nHasTRD = counters.nHasTRD;
+              nITSonly = counters.nITSonly;
+              nTPConly = counters.nTPConly;
+              nITSTPC = counters.nITSTPC;
+              nAllTracksTPCOnly = counters.nAllTracksTPCOnly;
+              nAllTracksITSTPC = counters.nAllTracksITSTPC;
+            } else {
+              const auto& pvAllContribsGrouped = pvAllContribTracksIU->sliceByCached(aod::track::collisionId, collision.globalIndex(), cache);
+              const auto& tpcTracksGrouped = tracksIUWithTPC->sliceByCached(aod::track::collisionId, collision.globalIndex(), cache);
+
+              for (auto track : pvAllContribsGrouped) {
+                if (track.hasITS()) {
+                  nHasITS++;
+                  if (track.hasTPC())
+                    nITSTPC++;
+                  if (!track.hasTPC() && !track.hasTOF() && !track.hasTRD())
+                    nITSonly++;
+                }
+                if (track.hasTPC()) {
+                  nHasTPC++;
+                  if (!track.hasITS() && !track.hasTOF() && !track.hasTRD())
+                    nTPConly++;
+                }
+                if (track.hasTOF())
+                  nHasTOF++;
+                if (track.hasTRD())
+                  nHasTRD++;
+              }
+
+              for (auto track : tpcTracksGrouped) {
+                if (track.hasITS()) {
+                  nAllTracksITSTPC++;
+                } else {
+                  nAllTracksTPCOnly++;
+                }
               }
             }
 
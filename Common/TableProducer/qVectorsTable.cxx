@@ -19,11 +19,12 @@
 ///
 
 // C++/ROOT includes.
+#include <algorithm>
 #include <chrono>
 #include <string>
 #include <vector>
-#include <TComplex.h>
 #include <TH3F.h>
+#include <TMath.h>
 
 // o2Physics includes.
 #include "Framework/AnalysisDataModel.h"
@@ -121,6 +122,17 @@ struct qVectorsTable {
 
   TH3F* objQvec = nullptr;
 
+  // Per-channel cos(n*phi) and sin(n*phi) of the FIT detectors for the harmonic in use,
+  // computed from the geometry and the alignment at each run change.
+  std::vector<double> FT0CosNPhi{};
+  std::vector<double> FT0SinNPhi{};
+  std::vector<double> FV0CosNPhi{};
+  std::vector<double> FV0SinNPhi{};
+
+  // Contents of objQvec flattened by global bin, to avoid the TH3 lookups per collision.
+  std::vector<float> QvecCorrections{};
+  int nBinsCorr[3] = {0, 0, 0};
+
   std::unordered_map<string, bool> useDetector = {
     {"QvectorBNegs", cfgUseBNeg},
     {"QvectorBPoss", cfgUseBPos},
@@ -205,10 +217,37 @@ struct qVectorsTable {
       LOGF(fatal, "Could not get the alignment parameters for FV0.");
     }
 
+    // Cache the phi of each channel once per run, GetPhiFT0 recomputes all the
+    // channel centers at each call.
+    FT0CosNPhi.resize(208);
+    FT0SinNPhi.resize(208);
+    for (int iCh = 0; iCh < 208; iCh++) {
+      double phi = helperEP.GetPhiFT0(iCh, ft0geom);
+      FT0CosNPhi[iCh] = TMath::Cos(phi * harmonics);
+      FT0SinNPhi[iCh] = TMath::Sin(phi * harmonics);
+    }
+    FV0CosNPhi.resize(48);
+    FV0SinNPhi.resize(48);
+    for (int iCh = 0; iCh < 48; iCh++) {
+      double phi = helperEP.GetPhiFV0(iCh, fv0geom);
+      FV0CosNPhi[iCh] = TMath::Cos(phi * harmonics);
+      FV0SinNPhi[iCh] = TMath::Sin(phi * harmonics);
+    }
+
     fullPath = cfgQvecCalibPath;
     fullPath += "/v";
     fullPath += std::to_string(harmonics);
     objQvec = ccdb->getForTimeStamp<TH3F>(fullPath, timestamp);
+    if (objQvec == nullptr) {
+      LOGF(fatal, "Could not get the Q-vector calibration from %s.", fullPath.data());
+    }
+    nBinsCorr[0] = objQvec->GetNbinsX();
+    nBinsCorr[1] = objQvec->GetNbinsY();
+    nBinsCorr[2] = objQvec->GetNbinsZ();
+    QvecCorrections.resize((nBinsCorr[0] + 2) * (nBinsCorr[1] + 2) * (nBinsCorr[2] + 2));
+    for (std::size_t iBin = 0; iBin < QvecCorrections.size(); iBin++) {
+      QvecCorrections[iBin] = objQvec->GetBinContent(iBin);
+    }
 
     fullPath = cfgGainEqPath;
     fullPath += "/FT0";
@@ -233,6 +272,15 @@ struct qVectorsTable {
     }
   }
 
+  // Same as objQvec->GetBinContent(binx, biny, binz), bins out of range are clamped to the under/overflow.
+  float GetQvecCorrection(int binx, int biny, int binz) const
+  {
+    binx = std::clamp(binx, 0, nBinsCorr[0] + 1);
+    biny = std::clamp(biny, 0, nBinsCorr[1] + 1);
+    binz = std::clamp(binz, 0, nBinsCorr[2] + 1);
+    return QvecCorrections[binx + (nBinsCorr[0] + 2) * (biny + (nBinsCorr[1] + 2) * binz)];
+  }
+
   template <typename TrackType>
   bool SelTrack(const TrackType track)
   {
@@ -296,8 +344,8 @@ struct qVectorsTable {
     float qVectBPos[2] = {0.};
     float qVectBNeg[2] = {0.};
 
-    TComplex QvecDet(0); // Complex value of the Q-vector for any detector.
-    TComplex QvecFT0M(0);
+    double QvecDet[2] = {0., 0.}; // Real and imaginary parts of the Q-vector for any detector.
+    double QvecFT0M[2] = {0., 0.};
     float sumAmplFT0A = 0.; // Sum of the amplitudes of all non-dead channels in any detector.
     float sumAmplFT0C = 0.;
     float sumAmplFT0M = 0.;
@@ -318,20 +366,24 @@ struct qVectorsTable {
           float ampl = ft0.amplitudeA()[iChA];
           int FT0AchId = ft0.channelA()[iChA];
 
+          float amplCor = ampl / FT0RelGainConst[FT0AchId];
+
           histosQA.fill(HIST("FT0Amp"), ampl, FT0AchId);
-          histosQA.fill(HIST("FT0AmpCor"), ampl / FT0RelGainConst[FT0AchId], FT0AchId);
-          // Update the Q-vector and sum of amplitudes using the helper function.
-          // LOKI: Note this assumes nHarmo = 2!! Likely generalise in the future.
-          helperEP.SumQvectors(0, FT0AchId, ampl / FT0RelGainConst[FT0AchId], cfgnMod, QvecDet, sumAmplFT0A, ft0geom, fv0geom);
-          helperEP.SumQvectors(0, FT0AchId, ampl / FT0RelGainConst[FT0AchId], cfgnMod, QvecFT0M, sumAmplFT0M, ft0geom, fv0geom);
+          histosQA.fill(HIST("FT0AmpCor"), amplCor, FT0AchId);
+          // Update the Q-vector and sum of amplitudes using the cached cos(n*phi) and sin(n*phi).
+          QvecDet[0] += amplCor * FT0CosNPhi[FT0AchId];
+          QvecDet[1] += amplCor * FT0SinNPhi[FT0AchId];
+          sumAmplFT0A += amplCor;
+          QvecFT0M[0] += amplCor * FT0CosNPhi[FT0AchId];
+          QvecFT0M[1] += amplCor * FT0SinNPhi[FT0AchId];
+          sumAmplFT0M += amplCor;
         } // Go to the next channel iChA.
 
         // Set the Qvectors for FT0A with the normalised Q-vector values if the sum of
         // amplitudes is non-zero. Otherwise, set it to a dummy 999.
         if (sumAmplFT0A > 1e-8) {
-          QvecDet /= sumAmplFT0A;
-          qVectFT0A[0] = QvecDet.Re();
-          qVectFT0A[1] = QvecDet.Im();
+          qVectFT0A[0] = QvecDet[0] / sumAmplFT0A;
+          qVectFT0A[1] = QvecDet[1] / sumAmplFT0A;
           // printf("qVectFT0A[0] = %.2f ; qVectFT0A[1] = %.2f \n", qVectFT0A[0], qVectFT0A[1]); // Debug printing.
         } else {
           qVectFT0A[0] = 999.;
@@ -345,24 +397,30 @@ struct qVectorsTable {
       if (useDetector["QvectorFT0Cs"]) {
         // Repeat the procedure with FT0-C for the found FT0.
         // Start by resetting to zero the intermediate quantities.
-        QvecDet = TComplex(0., 0.);
+        QvecDet[0] = 0.;
+        QvecDet[1] = 0.;
         for (std::size_t iChC = 0; iChC < ft0.channelC().size(); iChC++) {
           // iChC ranging from 0 to max 112. We need to add 96 (= max channels in FT0-A)
           // to ensure a proper channel number in FT0 as a whole.
           float ampl = ft0.amplitudeC()[iChC];
           int FT0CchId = ft0.channelC()[iChC] + 96;
 
-          histosQA.fill(HIST("FT0Amp"), ampl, FT0CchId);
-          histosQA.fill(HIST("FT0AmpCor"), ampl / FT0RelGainConst[FT0CchId], FT0CchId);
+          float amplCor = ampl / FT0RelGainConst[FT0CchId];
 
-          helperEP.SumQvectors(0, FT0CchId, ampl / FT0RelGainConst[FT0CchId], cfgnMod, QvecDet, sumAmplFT0C, ft0geom, fv0geom);
-          helperEP.SumQvectors(0, FT0CchId, ampl / FT0RelGainConst[FT0CchId], cfgnMod, QvecFT0M, sumAmplFT0M, ft0geom, fv0geom);
+          histosQA.fill(HIST("FT0Amp"), ampl, FT0CchId);
+          histosQA.fill(HIST("FT0AmpCor"), amplCor, FT0CchId);
+
+          QvecDet[0] += amplCor * FT0CosNPhi[FT0CchId];
+          QvecDet[1] += amplCor * FT0SinNPhi[FT0CchId];
+          sumAmplFT0C += amplCor;
+          QvecFT0M[0] += amplCor * FT0CosNPhi[FT0CchId];
+          QvecFT0M[1] += amplCor * FT0SinNPhi[FT0CchId];
+          sumAmplFT0M += amplCor;
         }
 
         if (sumAmplFT0C > 1e-8) {
-          QvecDet /= sumAmplFT0C;
-          qVectFT0C[0] = QvecDet.Re();
-          qVectFT0C[1] = QvecDet.Im();
+          qVectFT0C[0] = QvecDet[0] / sumAmplFT0C;
+          qVectFT0C[1] = QvecDet[1] / sumAmplFT0C;
           // printf("qVectFT0C[0] = %.2f ; qVectFT0C[1] = %.2f \n", qVectFT0C[0], qVectFT0C[1]); // Debug printing.
         } else {
           qVectFT0C[0] = 999.;
@@ -374,9 +432,8 @@ struct qVectorsTable {
       }
 
       if (sumAmplFT0M > 1e-8 && useDetector["QvectorFT0Ms"]) {
-        QvecFT0M /= sumAmplFT0M;
-        qVectFT0M[0] = QvecFT0M.Re();
-        qVectFT0M[1] = QvecFT0M.Im();
+        qVectFT0M[0] = QvecFT0M[0] / sumAmplFT0M;
+        qVectFT0M[1] = QvecFT0M[1] / sumAmplFT0M;
       } else {
         qVectFT0M[0] = 999.;
         qVectFT0M[1] = 999.;
@@ -390,7 +447,8 @@ struct qVectorsTable {
       qVectFT0M[1] = -999.;
     }
 
-    QvecDet = TComplex(0., 0.);
+    QvecDet[0] = 0.;
+    QvecDet[1] = 0.;
     sumAmplFV0A = 0;
     if (coll.has_foundFV0() && useDetector["QvectorFV0As"]) {
       auto fv0 = coll.foundFV0();
@@ -398,16 +456,18 @@ struct qVectorsTable {
       for (std::size_t iCh = 0; iCh < fv0.channel().size(); iCh++) {
         float ampl = fv0.amplitude()[iCh];
         int FV0AchId = fv0.channel()[iCh];
+        float amplCor = ampl / FV0RelGainConst[FV0AchId];
         histosQA.fill(HIST("FV0Amp"), ampl, FV0AchId);
-        histosQA.fill(HIST("FV0AmpCor"), ampl / FV0RelGainConst[FV0AchId], FV0AchId);
+        histosQA.fill(HIST("FV0AmpCor"), amplCor, FV0AchId);
 
-        helperEP.SumQvectors(1, FV0AchId, ampl / FV0RelGainConst[FV0AchId], cfgnMod, QvecDet, sumAmplFV0A, ft0geom, fv0geom);
+        QvecDet[0] += amplCor * FV0CosNPhi[FV0AchId];
+        QvecDet[1] += amplCor * FV0SinNPhi[FV0AchId];
+        sumAmplFV0A += amplCor;
       }
 
       if (sumAmplFV0A > 1e-8) {
-        QvecDet /= sumAmplFV0A;
-        qVectFV0A[0] = QvecDet.Re();
-        qVectFV0A[1] = QvecDet.Im();
+        qVectFV0A[0] = QvecDet[0] / sumAmplFV0A;
+        qVectFV0A[1] = QvecDet[1] / sumAmplFV0A;
         // printf("qVectFV0[0] = %.2f ; qVectFV0[1] = %.2f \n", qVectFV0[0], qVectFV0[1]); // Debug printing.
       } else {
         qVectFV0A[0] = 999.;
@@ -491,6 +551,7 @@ struct qVectorsTable {
     qvecAmp.push_back(static_cast<float>(nTrkBNeg));
 
     if (cent < 80) {
+      const int centBin = static_cast<int>(cent) + 1;
       int i = 0;
       for (auto det : useDetector) {
         // Check whether Q-vectors are found for a detector
@@ -500,19 +561,19 @@ struct qVectorsTable {
         }
 
         helperEP.DoRecenter(qvecRe[i * 4 + 1], qvecIm[i * 4 + 1],
-                            objQvec->GetBinContent(static_cast<int>(cent) + 1, 1, i + 1), objQvec->GetBinContent(static_cast<int>(cent) + 1, 2, i + 1));
+                            GetQvecCorrection(centBin, 1, i + 1), GetQvecCorrection(centBin, 2, i + 1));
 
         helperEP.DoRecenter(qvecRe[i * 4 + 2], qvecIm[i * 4 + 2],
-                            objQvec->GetBinContent(static_cast<int>(cent) + 1, 1, i + 1), objQvec->GetBinContent(static_cast<int>(cent) + 1, 2, i + 1));
+                            GetQvecCorrection(centBin, 1, i + 1), GetQvecCorrection(centBin, 2, i + 1));
         helperEP.DoTwist(qvecRe[i * 4 + 2], qvecIm[i * 4 + 2],
-                         objQvec->GetBinContent(static_cast<int>(cent) + 1, 3, i + 1), objQvec->GetBinContent(static_cast<int>(cent) + 1, 4, i + 1));
+                         GetQvecCorrection(centBin, 3, i + 1), GetQvecCorrection(centBin, 4, i + 1));
 
         helperEP.DoRecenter(qvecRe[i * 4 + 3], qvecIm[i * 4 + 3],
-                            objQvec->GetBinContent(static_cast<int>(cent) + 1, 1, i + 1), objQvec->GetBinContent(static_cast<int>(cent) + 1, 2, i + 1));
+                            GetQvecCorrection(centBin, 1, i + 1), GetQvecCorrection(centBin, 2, i + 1));
         helperEP.DoTwist(qvecRe[i * 4 + 3], qvecIm[i * 4 + 3],
-                         objQvec->GetBinContent(static_cast<int>(cent) + 1, 3, i + 1), objQvec->GetBinContent(static_cast<int>(cent) + 1, 4, i + 1));
+                         GetQvecCorrection(centBin, 3, i + 1), GetQvecCorrection(centBin, 4, i + 1));
         helperEP.DoRescale(qvecRe[i * 4 + 3], qvecIm[i * 4 + 3],
-                           objQvec->GetBinContent(static_cast<int>(cent) + 1, 5, i + 1), objQvec->GetBinContent(static_cast<int>(cent) + 1, 6, i + 1));
+                           GetQvecCorrection(centBin, 5, i + 1), GetQvecCorrection(centBin, 6, i + 1));
         i++;
       }
     }
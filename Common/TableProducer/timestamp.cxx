@@ -16,10 +16,14 @@
 /// \brief  A task to fill the timestamp table from run number.
 ///         Uses headers from CCDB
 ///
+#include <chrono>
+#include <fstream>
+#include <sstream>
 #include <vector>
 #include <map>
 #include "Framework/runDataProcessing.h"
 #include "Framework/AnalysisTask.h"
+#include "Framework/HistogramRegistry.h"
 #include "CCDB/BasicCCDBManager.h"
 #include "CommonDataFormat/InteractionRecord.h"
 #include "DetectorsRaw/HBFUtils.h"
@@ -29,12 +33,24 @@ using namespace o2::header;
 using namespace o2;
 
 struct TimestampTask {
+  /// Run information kept in the local persistent cache
+  struct RunInfo {
+    int64_t sor = 0;         /// timestamp of the SOR in ms
+    int64_t eor = 0;         /// timestamp of the EOR in ms
+    int64_t orbitReset = -1; /// orbit-reset timestamp from CCDB in us, -1 if not retrieved
+  };
+  enum LookupSource { kMemory = 1,
+                      kLocalCache,
+                      kCCDB };
+
   Produces<aod::Timestamps> timestampTable;  /// Table with SOR timestamps produced by the task
   Service<o2::ccdb::BasicCCDBManager> ccdb;  /// CCDB manager to access orbit-reset timestamp
   o2::ccdb::CcdbApi ccdb_api;                /// API to access CCDB headers
   std::map<int, int64_t> mapRunToOrbitReset; /// Cache of orbit reset timestamps
+  std::map<int, RunInfo> mapRunInfo;         /// Run information read from the local persistent cache
   int lastRunNumber = 0;                     /// Last run number processed
   int64_t orbitResetTimestamp = 0;           /// Orbit-reset timestamp in us
+  HistogramRegistry histos{"histos", {}, OutputObjHandlingPolicy::AnalysisObject};
 
   // Configurables
   Configurable<bool> verbose{"verbose", false, "verbose mode"};
@@ -42,6 +58,7 @@ struct TimestampTask {
   Configurable<std::string> orbit_reset_path{"orbit-reset-path", "CTP/Calib/OrbitReset", "path to the ccdb orbit-reset objects"};
   Configurable<std::string> url{"ccdb-url", "http://alice-ccdb.cern.ch", "URL of the CCDB database"};
   Configurable<bool> isRun2MC{"isRun2MC", false, "Running mode: enable only for Run 2 MC. Timestamps are set to SOR timestamp"};
+  Configurable<std::string> localCache{"local-cache", "", "Path to a local file caching SOR, EOR and orbit-reset timestamps per run, shared by the jobs on the same node. Empty to disable"};
 
   void init(o2::framework::InitContext&)
   {
@@ -51,6 +68,53 @@ struct TimestampTask {
     if (!ccdb_api.isHostReachable()) {
       LOGF(fatal, "CCDB host %s is not reacheable, cannot go forward", url.value.data());
     }
+    auto h = histos.add<TH1>("hRunLookups", "Run lookups;source;runs", kTH1F, {{3, 0.5, 3.5}});
+    h->GetXaxis()->SetBinLabel(kMemory, "memory");
+    h->GetXaxis()->SetBinLabel(kLocalCache, "local cache");
+    h->GetXaxis()->SetBinLabel(kCCDB, "CCDB");
+    histos.add("hRunLookupTime", "Time to get the orbit-reset timestamp of a run;source;time (ms)", kTH2F, {{3, 0.5, 3.5}, {1000, 0., 5000.}});
+    readLocalCache();
+  }
+
+  /// Reads the local cache, one line per run: run number, SOR (ms), EOR (ms), orbit reset (us)
+  void readLocalCache()
+  {
+    if (localCache.value.empty()) {
+      return;
+    }
+    std::ifstream file(localCache.value);
+    if (!file.is_open()) {
+      LOGF(info, "Local cache %s not found, it will be created", localCache.value.data());
+      return;
+    }
+    std::string line;
+    while (std::getline(file, line)) {
+      std::istringstream stream(line);
+      int run = 0;
+      RunInfo info;
+      if (!(stream >> run >> info.sor >> info.eor >> info.orbitReset)) {
+        continue; // incomplete line, e.g. being written by another job
+      }
+      RunInfo& entry = mapRunInfo[run];
+      if (entry.orbitReset < 0 || info.orbitReset >= 0) {
+        entry = info;
+      }
+    }
+    LOGF(info, "Read %zu runs from local cache %s", mapRunInfo.size(), localCache.value.data());
+  }
+
+  /// Appends a run to the local cache, lines are short and written at once so that concurrent jobs can share the file
+  void writeLocalCache(int run, const RunInfo& info)
+  {
+    if (localCache.value.empty()) {
+      return;
+    }
+    std::ofstream file(localCache.value, std::ios::app);
+    if (!file.is_open()) {
+      LOGF(warning, "Cannot write to local cache %s", localCache.value.data());
+      return;
+    }
+    file << (std::to_string(run) + " " + std::to_string(info.sor) + " " + std::to_string(info.eor) + " " + std::to_string(info.orbitReset) + "\n") << std::flush;
   }
 
   void process(aod::BC const& bc)
@@ -64,20 +128,32 @@ struct TimestampTask {
     } else if (mapRunToOrbitReset.count(runNumber)) { // The run number was already requested before: getting it from cache!
       LOGF(debug, "Getting orbit-reset timestamp from cache");
       orbitResetTimestamp = mapRunToOrbitReset[runNumber];
-    } else { // The run was not requested before: need to acccess CCDB!
-      LOGF(debug, "Getting start-of-run and end-of-run timestamps from CCDB");
-      std::map<std::string, std::string> metadata, headers;
-      const std::string run_path = Form("%s/%i", rct_path.value.data(), runNumber);
-      headers = ccdb_api.retrieveHeaders(run_path, metadata, -1);
-      if (headers.count("SOR") == 0) {
-        LOGF(fatal, "Cannot find start-of-run timestamp for run number in path '%s'.", run_path.data());
-      }
-      if (headers.count("EOR") == 0) {
-        LOGF(fatal, "Cannot find end-of-run timestamp for run number in path '%s'.", run_path.data());
+      histos.fill(HIST("hRunLookups"), kMemory);
+    } else { // The run was not requested before: need to acccess the local cache or CCDB!
+      const auto start = std::chrono::steady_clock::now();
+      RunInfo info;
+      bool fromLocalCache = false;
+      if (auto it = mapRunInfo.find(runNumber); it != mapRunInfo.end()) {
+        LOGF(debug, "Getting start-of-run and end-of-run timestamps from local cache");
+        info = it->second;
+        fromLocalCache = true;
+      } else {
+        LOGF(debug, "Getting start-of-run and end-of-run timestamps from CCDB");
+        std::map<std::string, std::string> metadata, headers;
+        const std::string run_path = Form("%s/%i", rct_path.value.data(), runNumber);
+        headers = ccdb_api.retrieveHeaders(run_path, metadata, -1);
+        if (headers.count("SOR") == 0) {
+          LOGF(fatal, "Cannot find start-of-run timestamp for run number in path '%s'.", run_path.data());
+        }
+        if (headers.count("EOR") == 0) {
+          LOGF(fatal, "Cannot find end-of-run timestamp for run number in path '%s'.", run_path.data());
+        }
+        info.sor = atol(headers["SOR"].c_str());
+        info.eor = atol(headers["EOR"].c_str());
       }
 
-      int64_t sorTimestamp = atol(headers["SOR"].c_str()); // timestamp of the SOR in ms
-      int64_t eorTimestamp = atol(headers["EOR"].c_str()); // timestamp of the EOR in ms
+      int64_t sorTimestamp = info.sor; // timestamp of the SOR in ms
+      int64_t eorTimestamp = info.eor; // timestamp of the EOR in ms
 
       bool isUnanchoredRun3MC = runNumber >= 300000 && runNumber < 500000;
       if (isRun2MC || isUnanchoredRun3MC) {
@@ -85,16 +161,30 @@ struct TimestampTask {
         // isUnanchoredRun3MC: assuming orbit-reset is done in the beginning of each run
         // Setting orbit-reset timestamp to start-of-run timestamp
         orbitResetTimestamp = sorTimestamp * 1000; // from ms to us
-      } else if (runNumber < 300000) {             // Run 2
+      } else if (info.orbitReset >= 0) {
+        LOGF(debug, "Getting orbit-reset timestamp from local cache");
+        orbitResetTimestamp = info.orbitReset;
+      } else if (runNumber < 300000) { // Run 2
         LOGF(debug, "Getting orbit-reset timestamp using start-of-run timestamp from CCDB");
         auto ctp = ccdb->getForTimeStamp<std::vector<Long64_t>>(orbit_reset_path.value.data(), sorTimestamp);
         orbitResetTimestamp = (*ctp)[0];
+        info.orbitReset = orbitResetTimestamp;
+        fromLocalCache = false;
       } else {
         // sometimes orbit is reset after SOR. Using EOR timestamps for orbitReset query is more reliable
         LOGF(debug, "Getting orbit-reset timestamp using end-of-run timestamp from CCDB");
         auto ctp = ccdb->getForTimeStamp<std::vector<Long64_t>>(orbit_reset_path.value.data(), eorTimestamp);
         orbitResetTimestamp = (*ctp)[0];
+        info.orbitReset = orbitResetTimestamp;
+        fromLocalCache = false;
+      }
+      if (!fromLocalCache) {
+        mapRunInfo[runNumber] = info;
+        writeLocalCache(runNumber, info);
       }
+      const LookupSource source = fromLocalCache ? kLocalCache : kCCDB;
+      histos.fill(HIST("hRunLookups"), source);
+      histos.fill(HIST("hRunLookupTime"), source, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
 
       // Adding the timestamp to the cache map
       std::pair<std::map<int, int64_t>::iterator, bool> check;
@@ -13,6 +13,10 @@
 // Task to add a table of track parameters propagated to the primary vertex
 //
 
+#include <algorithm>
+#include <thread>
+#include <vector>
+
 #include "TableHelper.h"
 #include "Common/Tools/TrackTuner.h"
 
@@ -59,6 +63,8 @@ struct TrackPropagation {
   Configurable<std::string> grpmagPath{"grpmagPath", "GLO/Config/GRPMagField", "CCDB path of the GRPMagField object"};
   Configurable<std::string> mVtxPath{"mVtxPath", "GLO/Calib/MeanVertex", "Path of the mean vertex file"};
   Configurable<float> minPropagationRadius{"minPropagationDistance", o2::constants::geom::XTPCInnerRef + 0.1, "Only tracks which are at a smaller radius will be propagated, defaults to TPC inner wall"};
+  Configurable<float> maxRadiusNoMatCorr{"maxRadiusNoMatCorr", -1.f, "Tracks at a smaller radius (e.g. inside the beam pipe) are propagated without material corrections. Negative to disable"};
+  Configurable<int> nThreads{"nThreads", 1, "Number of threads for the propagation of the tracks without MC, the tables are filled in the original order"};
   // for TrackTuner only (MC smearing)
   Configurable<bool> useTrackTuner{"useTrackTuner", false, "Apply track tuner corrections to MC"};
   Configurable<bool> fillTrackTunerTable{"fillTrackTunerTable", false, "flag to fill track tuner table"};
@@ -104,6 +110,7 @@ struct TrackPropagation {
     // Checking if the tables are requested in the workflow and enabling them
     fillTracksDCA = isTableRequiredInWorkflow(initContext, "TracksDCA");
     fillTracksDCACov = isTableRequiredInWorkflow(initContext, "TracksDCACov");
+    printTablesNotConsumedInWorkflow(initContext);
 
     ccdb->setURL(ccdburl);
     ccdb->setCaching(true);
@@ -142,6 +149,8 @@ struct TrackPropagation {
     runNumber = bc.runNumber();
   }
 
+  static constexpr int kMinTracksPerChunk = 1000; // minimum number of tracks to justify a parallel chunk
+
   // Running variables
   gpu::gpustd::array<float, 2> mDcaInfo;
   o2::dataformats::DCA mDcaInfoCov;
@@ -152,7 +161,7 @@ struct TrackPropagation {
   template <typename TTrack, typename TParticle, bool isMc, bool fillCovMat = false, bool useTrkPid = false>
   void fillTrackTables(TTrack const& tracks,
                        TParticle const&,
-                       aod::Collisions const&,
+                       aod::Collisions const& collisions,
                        aod::BCsWithTimestamps const& bcs)
   {
     if (bcs.size() == 0) {
@@ -174,6 +183,13 @@ struct TrackPropagation {
       }
     }
 
+    if constexpr (!isMc) {
+      if (nThreads > 1) {
+        fillTrackTablesParallel<TTrack, fillCovMat, useTrkPid>(tracks, collisions);
+        return;
+      }
+    }
+
     for (auto& track : tracks) {
       if constexpr (fillCovMat) {
         if (fillTracksDCA || fillTracksDCACov) {
@@ -219,17 +235,17 @@ struct TrackPropagation {
           if constexpr (fillCovMat) {
             mVtx.setPos({collision.posX(), collision.posY(), collision.posZ()});
             mVtx.setCov(collision.covXX(), collision.covXY(), collision.covYY(), collision.covXZ(), collision.covYZ(), collision.covZZ());
-            isPropagationOK = o2::base::Propagator::Instance()->propagateToDCABxByBz(mVtx, mTrackParCov, 2.f, matCorr, &mDcaInfoCov);
+            isPropagationOK = o2::base::Propagator::Instance()->propagateToDCABxByBz(mVtx, mTrackParCov, 2.f, getMatCorr(mTrackParCov.getX()), &mDcaInfoCov);
           } else {
-            isPropagationOK = o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, mTrackPar, 2.f, matCorr, &mDcaInfo);
+            isPropagationOK = o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, mTrackPar, 2.f, getMatCorr(mTrackPar.getX()), &mDcaInfo);
           }
         } else {
           if constexpr (fillCovMat) {
             mVtx.setPos({mMeanVtx->getX(), mMeanVtx->getY(), mMeanVtx->getZ()});
             mVtx.setCov(mMeanVtx->getSigmaX() * mMeanVtx->getSigmaX(), 0.0f, mMeanVtx->getSigmaY() * mMeanVtx->getSigmaY(), 0.0f, 0.0f, mMeanVtx->getSigmaZ() * mMeanVtx->getSigmaZ());
-            isPropagationOK = o2::base::Propagator::Instance()->propagateToDCABxByBz(mVtx, mTrackParCov, 2.f, matCorr, &mDcaInfoCov);
+            isPropagationOK = o2::base::Propagator::Instance()->propagateToDCABxByBz(mVtx, mTrackParCov, 2.f, getMatCorr(mTrackParCov.getX()), &mDcaInfoCov);
           } else {
-            isPropagationOK = o2::base::Propagator::Instance()->propagateToDCABxByBz({mMeanVtx->getX(), mMeanVtx->getY(), mMeanVtx->getZ()}, mTrackPar, 2.f, matCorr, &mDcaInfo);
+            isPropagationOK = o2::base::Propagator::Instance()->propagateToDCABxByBz({mMeanVtx->getX(), mMeanVtx->getY(), mMeanVtx->getZ()}, mTrackPar, 2.f, getMatCorr(mTrackPar.getX()), &mDcaInfo);
           }
         }
         if (isPropagationOK) {
@@ -254,29 +270,136 @@ struct TrackPropagation {
         tunertable(q2OverPtNew);
       }
       // LOG(info) <<  " trackPropagation (this value filled in tuner table)--> "  << q2OverPtNew;
+      fillTrackRow<fillCovMat>(track, trackType);
+    }
+  }
+
+  /// Fills the output tables for one track from the running variables
+  template <bool fillCovMat, typename TTrack>
+  void fillTrackRow(TTrack const& track, aod::track::TrackTypeEnum trackType)
+  {
+    if constexpr (fillCovMat) {
+      tracksParPropagated(track.collisionId(), trackType, mTrackParCov.getX(), mTrackParCov.getAlpha(), mTrackParCov.getY(), mTrackParCov.getZ(), mTrackParCov.getSnp(), mTrackParCov.getTgl(), mTrackParCov.getQ2Pt());
+      tracksParExtensionPropagated(mTrackParCov.getPt(), mTrackParCov.getP(), mTrackParCov.getEta(), mTrackParCov.getPhi());
+      // TODO do we keep the rho as 0? Also the sigma's are duplicated information
+      tracksParCovPropagated(std::sqrt(mTrackParCov.getSigmaY2()), std::sqrt(mTrackParCov.getSigmaZ2()), std::sqrt(mTrackParCov.getSigmaSnp2()),
+                             std::sqrt(mTrackParCov.getSigmaTgl2()), std::sqrt(mTrackParCov.getSigma1Pt2()), 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+      tracksParCovExtensionPropagated(mTrackParCov.getSigmaY2(), mTrackParCov.getSigmaZY(), mTrackParCov.getSigmaZ2(), mTrackParCov.getSigmaSnpY(),
+                                      mTrackParCov.getSigmaSnpZ(), mTrackParCov.getSigmaSnp2(), mTrackParCov.getSigmaTglY(), mTrackParCov.getSigmaTglZ(), mTrackParCov.getSigmaTglSnp(),
+                                      mTrackParCov.getSigmaTgl2(), mTrackParCov.getSigma1PtY(), mTrackParCov.getSigma1PtZ(), mTrackParCov.getSigma1PtSnp(), mTrackParCov.getSigma1PtTgl(),
+                                      mTrackParCov.getSigma1Pt2());
+      if (fillTracksDCA) {
+        tracksDCA(mDcaInfoCov.getY(), mDcaInfoCov.getZ());
+      }
+      if (fillTracksDCACov) {
+        tracksDCACov(mDcaInfoCov.getSigmaY2(), mDcaInfoCov.getSigmaZ2());
+      }
+    } else {
+      tracksParPropagated(track.collisionId(), trackType, mTrackPar.getX(), mTrackPar.getAlpha(), mTrackPar.getY(), mTrackPar.getZ(), mTrackPar.getSnp(), mTrackPar.getTgl(), mTrackPar.getQ2Pt());
+      tracksParExtensionPropagated(mTrackPar.getPt(), mTrackPar.getP(), mTrackPar.getEta(), mTrackPar.getPhi());
+      if (fillTracksDCA) {
+        tracksDCA(mDcaInfo[0], mDcaInfo[1]);
+      }
+    }
+  }
+
+  /// Material correction to use for a track at the radius x
+  o2::base::Propagator::MatCorrType getMatCorr(float x) const
+  {
+    return x < maxRadiusNoMatCorr ? o2::base::Propagator::MatCorrType::USEMatCorrNONE : matCorr;
+  }
+
+  /// Propagates the tracks in parallel chunks. The input parameters and vertices are extracted first,
+  /// then only the propagation runs in the threads and the tables are filled in the original order.
+  template <typename TTrack, bool fillCovMat, bool useTrkPid>
+  void fillTrackTablesParallel(TTrack const& tracks, aod::Collisions const& collisions)
+  {
+    const int nTracks = tracks.size();
+    std::vector<o2::dataformats::VertexBase> vertices(collisions.size() + 1);
+    for (const auto& collision : collisions) {
+      auto& vtx = vertices[collision.globalIndex()];
+      vtx.setPos({collision.posX(), collision.posY(), collision.posZ()});
+      vtx.setCov(collision.covXX(), collision.covXY(), collision.covYY(), collision.covXZ(), collision.covYZ(), collision.covZZ());
+    }
+    const int meanVtxIndex = collisions.size(); // used for the tracks without collision
+    vertices[meanVtxIndex].setPos({mMeanVtx->getX(), mMeanVtx->getY(), mMeanVtx->getZ()});
+    vertices[meanVtxIndex].setCov(mMeanVtx->getSigmaX() * mMeanVtx->getSigmaX(), 0.0f, mMeanVtx->getSigmaY() * mMeanVtx->getSigmaY(), 0.0f, 0.0f, mMeanVtx->getSigmaZ() * mMeanVtx->getSigmaZ());
+
+    std::vector<o2::track::TrackParametrization<float>> trackPars;
+    std::vector<o2::track::TrackParametrizationWithError<float>> trackParCovs;
+    std::vector<gpu::gpustd::array<float, 2>> dcaInfos;
+    std::vector<o2::dataformats::DCA> dcaInfoCovs;
+    if constexpr (fillCovMat) {
+      trackParCovs.resize(nTracks);
+      dcaInfoCovs.resize(nTracks);
+    } else {
+      trackPars.resize(nTracks);
+      dcaInfos.resize(nTracks);
+    }
+    std::vector<int> vertexIndices(nTracks, -1); // -1 for the tracks which are not propagated
+    std::vector<char> propagationOK(nTracks, false);
+
+    int iTrack = 0;
+    for (const auto& track : tracks) {
       if constexpr (fillCovMat) {
-        tracksParPropagated(track.collisionId(), trackType, mTrackParCov.getX(), mTrackParCov.getAlpha(), mTrackParCov.getY(), mTrackParCov.getZ(), mTrackParCov.getSnp(), mTrackParCov.getTgl(), mTrackParCov.getQ2Pt());
-        tracksParExtensionPropagated(mTrackParCov.getPt(), mTrackParCov.getP(), mTrackParCov.getEta(), mTrackParCov.getPhi());
-        // TODO do we keep the rho as 0? Also the sigma's are duplicated information
-        tracksParCovPropagated(std::sqrt(mTrackParCov.getSigmaY2()), std::sqrt(mTrackParCov.getSigmaZ2()), std::sqrt(mTrackParCov.getSigmaSnp2()),
-                               std::sqrt(mTrackParCov.getSigmaTgl2()), std::sqrt(mTrackParCov.getSigma1Pt2()), 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
-        tracksParCovExtensionPropagated(mTrackParCov.getSigmaY2(), mTrackParCov.getSigmaZY(), mTrackParCov.getSigmaZ2(), mTrackParCov.getSigmaSnpY(),
-                                        mTrackParCov.getSigmaSnpZ(), mTrackParCov.getSigmaSnp2(), mTrackParCov.getSigmaTglY(), mTrackParCov.getSigmaTglZ(), mTrackParCov.getSigmaTglSnp(),
-                                        mTrackParCov.getSigmaTgl2(), mTrackParCov.getSigma1PtY(), mTrackParCov.getSigma1PtZ(), mTrackParCov.getSigma1PtSnp(), mTrackParCov.getSigma1PtTgl(),
-                                        mTrackParCov.getSigma1Pt2());
-        if (fillTracksDCA) {
-          tracksDCA(mDcaInfoCov.getY(), mDcaInfoCov.getZ());
-        }
-        if (fillTracksDCACov) {
-          tracksDCACov(mDcaInfoCov.getSigmaY2(), mDcaInfoCov.getSigmaZ2());
+        dcaInfoCovs[iTrack].set(999, 999, 999, 999, 999);
+        setTrackParCov(track, trackParCovs[iTrack]);
+        if constexpr (useTrkPid) {
+          trackParCovs[iTrack].setPID(track.pidForTracking());
         }
       } else {
-        tracksParPropagated(track.collisionId(), trackType, mTrackPar.getX(), mTrackPar.getAlpha(), mTrackPar.getY(), mTrackPar.getZ(), mTrackPar.getSnp(), mTrackPar.getTgl(), mTrackPar.getQ2Pt());
-        tracksParExtensionPropagated(mTrackPar.getPt(), mTrackPar.getP(), mTrackPar.getEta(), mTrackPar.getPhi());
-        if (fillTracksDCA) {
-          tracksDCA(mDcaInfo[0], mDcaInfo[1]);
+        dcaInfos[iTrack][0] = 999;
+        dcaInfos[iTrack][1] = 999;
+        setTrackPar(track, trackPars[iTrack]);
+        if constexpr (useTrkPid) {
+          trackPars[iTrack].setPID(track.pidForTracking());
         }
       }
+      if (track.trackType() == aod::track::TrackIU && track.x() < minPropagationRadius) {
+        vertexIndices[iTrack] = track.has_collision() ? track.collisionId() : meanVtxIndex;
+      }
+      iTrack++;
+    }
+
+    auto propagateChunk = [&](int first, int last) {
+      auto* propagator = o2::base::Propagator::Instance();
+      for (int i = first; i < last; i++) {
+        if (vertexIndices[i] < 0) {
+          continue;
+        }
+        const auto& vtx = vertices[vertexIndices[i]];
+        if constexpr (fillCovMat) {
+          propagationOK[i] = propagator->propagateToDCABxByBz(vtx, trackParCovs[i], 2.f, getMatCorr(trackParCovs[i].getX()), &dcaInfoCovs[i]);
+        } else {
+          propagationOK[i] = propagator->propagateToDCABxByBz(vtx.getXYZ(), trackPars[i], 2.f, getMatCorr(trackPars[i].getX()), &dcaInfos[i]);
+        }
+      }
+    };
+    const int nChunks = std::max(1, std::min(nThreads.value, nTracks / kMinTracksPerChunk));
+    std::vector<std::thread> threads;
+    threads.reserve(nChunks);
+    for (int iChunk = 0; iChunk < nChunks; iChunk++) {
+      threads.emplace_back(propagateChunk, static_cast<int>(static_cast<int64_t>(nTracks) * iChunk / nChunks), static_cast<int>(static_cast<int64_t>(nTracks) * (iChunk + 1) / nChunks));
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    iTrack = 0;
+    for (const auto& track : tracks) {
+      aod::track::TrackTypeEnum trackType = propagationOK[iTrack] ? aod::track::Track : (aod::track::TrackTypeEnum)track.trackType();
+      if constexpr (fillCovMat) {
+        mTrackParCov = trackParCovs[iTrack];
+        mDcaInfoCov = dcaInfoCovs[iTrack];
+      } else {
+        mTrackPar = trackPars[iTrack];
+        mDcaInfo = dcaInfos[iTrack];
+      }
+      if (useTrackTuner && fillTrackTunerTable) {
+        tunertable(-9999.);
+      }
+      fillTrackRow<fillCovMat>(track, trackType);
+      iTrack++;
     }
   }
 
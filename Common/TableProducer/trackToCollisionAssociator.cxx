@@ -39,6 +39,7 @@ struct TrackToCollisionAssociation {
   Configurable<bool> includeUnassigned{"includeUnassigned", false, "consider also tracks which are not assigned to any collision"};
   Configurable<bool> fillTableOfCollIdsPerTrack{"fillTableOfCollIdsPerTrack", false, "fill additional table with vector of collision ids per track"};
   Configurable<int> bcWindowForOneSigma{"bcWindowForOneSigma", 60, "BC window to be multiplied by the number of sigmas to define maximum window to be considered"};
+  Configurable<int> nThreads{"nThreads", 1, "number of threads for the time association (the collisions are split in contiguous chunks)"};
 
   CollisionAssociation<true> collisionAssociator;
 
@@ -62,6 +63,7 @@ struct TrackToCollisionAssociation {
     collisionAssociator.setUsePvAssociation(usePVAssociation);
     collisionAssociator.setIncludeUnassigned(includeUnassigned);
     collisionAssociator.setFillTableOfCollIdsPerTrack(fillTableOfCollIdsPerTrack);
+    collisionAssociator.setNumThreads(nThreads);
     collisionAssociator.setBcWindow(bcWindowForOneSigma);
   }
 
@@ -76,24 +76,28 @@ struct TrackExtension {
   void processRun2(aod::FullTracks const& tracks, aod::Collisions const&, aod::BCsWithTimestamps const&)
   {
     using namespace analysis::trackextension;
+    int64_t lastCollisionId = -1; // the run is checked only when the collision changes
 
     for (auto& track : tracks) {
       std::array<float, 2> dca{1e10f, 1e10f};
       if (track.has_collision()) {
         if (track.trackType() == o2::aod::track::TrackTypeEnum::Run2Track && track.itsChi2NCl() != 0.f && track.tpcChi2NCl() != 0.f && std::abs(track.x()) < 10.f) {
-          auto bc = track.collision_as<aod::Collisions>().bc_as<aod::BCsWithTimestamps>();
-          if (mRunNumber != bc.runNumber()) {
-            o2::parameters::GRPObject* grpo = ccdb->getForTimeStamp<o2::parameters::GRPObject>(ccdbpath_grp, bc.timestamp());
-            if (grpo != nullptr) {
-              mMagField = grpo->getNominalL3Field();
-              LOGF(info, "Setting magnetic field to %f kG for run %d", mMagField, bc.runNumber());
-            } else {
-              LOGF(fatal, "GRP object is not available in CCDB for run=%d at timestamp=%llu", bc.runNumber(), bc.timestamp());
+          auto const& collision = track.collision();
+          if (collision.globalIndex() != lastCollisionId) {
+            lastCollisionId = collision.globalIndex();
+            auto bc = collision.bc_as<aod::BCsWithTimestamps>();
+            if (mRunNumber != bc.runNumber()) {
+              o2::parameters::GRPObject* grpo = ccdb->getForTimeStamp<o2::parameters::GRPObject>(ccdbpath_grp, bc.timestamp());
+              if (grpo != nullptr) {
+                mMagField = grpo->getNominalL3Field();
+                LOGF(info, "Setting magnetic field to %f kG for run %d", mMagField, bc.runNumber());
+              } else {
+                LOGF(fatal, "GRP object is not available in CCDB for run=%d at timestamp=%llu", bc.runNumber(), bc.timestamp());
+              }
+              mRunNumber = bc.runNumber();
             }
-            mRunNumber = bc.runNumber();
           }
           auto trackPar = getTrackPar(track);
-          auto const& collision = track.collision();
           trackPar.propagateParamToDCA({collision.posX(), collision.posY(), collision.posZ()}, mMagField, &dca);
         }
       }
@@ -105,6 +109,7 @@ struct TrackExtension {
   void processRun3(aod::Tracks const& tracks, aod::Collisions const&, aod::BCsWithTimestamps const&)
   {
     using namespace analysis::trackextension;
+    int64_t lastCollisionId = -1; // the run is checked only when the collision changes
 
     /* it is not clear yet if we will the GRP object per run number */
     /* if that is the case something similar to what has been       */
@@ -120,20 +125,23 @@ struct TrackExtension {
       if (track.has_collision()) {
         if (((compatibilityIU.value) && track.trackType() == o2::aod::track::TrackTypeEnum::TrackIU) ||
             ((!compatibilityIU.value) && track.trackType() == o2::aod::track::TrackTypeEnum::Track)) {
-          auto bc = track.collision_as<aod::Collisions>().bc_as<aod::BCsWithTimestamps>();
-          if (mRunNumber != bc.runNumber()) {
-            auto grpo = ccdb->getForTimeStamp<o2::parameters::GRPObject>(ccdbpath_grp, bc.timestamp());
-            if (grpo != nullptr) {
-              o2::base::Propagator::initFieldFromGRP(grpo);
-              o2::base::Propagator::Instance()->setMatLUT(lut);
-              LOGF(info, "Setting magnetic field to %d kG for run %d from its GRP CCDB object", grpo->getNominalL3Field(), bc.runNumber());
-            } else {
-              LOGF(fatal, "GRP object is not available in CCDB for run=%d at timestamp=%llu", bc.runNumber(), bc.timestamp());
+          auto const& collision = track.collision();
+          if (collision.globalIndex() != lastCollisionId) {
+            lastCollisionId = collision.globalIndex();
+            auto bc = collision.bc_as<aod::BCsWithTimestamps>();
+            if (mRunNumber != bc.runNumber()) {
+              auto grpo = ccdb->getForTimeStamp<o2::parameters::GRPObject>(ccdbpath_grp, bc.timestamp());
+              if (grpo != nullptr) {
+                o2::base::Propagator::initFieldFromGRP(grpo);
+                o2::base::Propagator::Instance()->setMatLUT(lut);
+                LOGF(info, "Setting magnetic field to %d kG for run %d from its GRP CCDB object", grpo->getNominalL3Field(), bc.runNumber());
+              } else {
+                LOGF(fatal, "GRP object is not available in CCDB for run=%d at timestamp=%llu", bc.runNumber(), bc.timestamp());
+              }
+              mRunNumber = bc.runNumber();
             }
-            mRunNumber = bc.runNumber();
           }
           auto trackPar = getTrackPar(track);
-          auto const& collision = track.collision();
           gpu::gpustd::array<float, 2> dcaInfo;
           if (o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackPar, 2.f, matCorr, &dcaInfo)) {
             dca[0] = dcaInfo[0];
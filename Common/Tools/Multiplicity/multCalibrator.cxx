@@ -27,6 +27,8 @@
 #include "TArrayF.h"
 #include "multCalibrator.h"
 
+#include <algorithm>
+
 using namespace std;
 
 const TString multCalibrator::fCentEstimName[kNCentEstim] = {
@@ -115,9 +117,13 @@ Bool_t multCalibrator::Calibrate()
   //Create output file
   TFile* fOut = new TFile(fOutputFileName.Data(), "RECREATE");
   TH1F* hCalib[kNCentEstim];
+  TStopwatch lTimer;
   for (Int_t iv = 0; iv < kNCentEstim; iv++) {
     cout << Form("Calibrating estimator: %s", fCentEstimName[iv].Data()) << endl;
+    lTimer.Start(kTRUE);
     hCalib[iv] = GetCalibrationHistogram(hRaw[iv], Form("hCalib%s", fCentEstimName[iv].Data()));
+    lTimer.Stop();
+    cout << Form("Calibrated estimator %s in %.3f seconds", fCentEstimName[iv].Data(), lTimer.RealTime()) << endl;
     hCalib[iv]->Write();
   }
 
@@ -149,9 +155,47 @@ Double_t multCalibrator::GetBoundaryForPercentile(TH1* histo, Double_t lPercenti
   //that corresponds to those bins. If this percentage is O(percentile bin
   //width requested), then the user should worry and we print out a warning.
 
+  CumulativeCounts lCounts;
+  FillCumulativeCounts(histo, lCounts);
+  return GetBoundaryForPercentile(histo, lCounts, lPercentileRequested, lPrecisionEstimate);
+}
+
+void multCalibrator::FillCumulativeCounts(TH1* histo, CumulativeCounts& lCounts)
+{
+  //Running counts summed in the same order as the per-boundary scan, such
+  //that the boundaries do not depend on how they are obtained
+  lCounts.fRawMax = GetRawMax(histo);
+
+  Double_t lCount = 0;
+
+  // Anchor point changes: if anchored, start at the first bin that includes that
+  Long_t lFirstBin = 1;
+  Double_t lHadronicTotal = histo->Integral(1, histo->GetNbinsX()); // histo->GetEntries();
+  if (fAnchorPointValue > 0) {
+    lFirstBin = histo->FindBin(fAnchorPointValue + 1e-6);
+    Double_t lAbove = histo->Integral(lFirstBin, histo->GetNbinsX());
+    lHadronicTotal = lAbove * 100.0 / (fAnchorPointPercentage);
+    lCount = lHadronicTotal - lAbove; // the relevant anchored-out part
+  }
+  lCounts.fFirstBin = lFirstBin;
+  lCounts.fHadronicTotal = lHadronicTotal;
+
+  const Long_t lNBins = histo->GetNbinsX();
+  lCounts.fCount.assign(lNBins, 0.);
+  for (Long_t ibin = lFirstBin; ibin < lNBins; ibin++) {
+    lCount += histo->GetBinContent(ibin);
+    lCounts.fCount[ibin] = lCount;
+  }
+}
+
+Double_t multCalibrator::GetBoundaryForPercentile(TH1* histo, const CumulativeCounts& lCounts, Double_t lPercentileRequested, Double_t& lPrecisionEstimate)
+{
+  //Same as above with the running counts of the histogram already filled:
+  //the bin of the boundary is found by binary search
+
   const Double_t lPrecisionConstant = 2.0;
 
-  Double_t lRawMax = GetRawMax(histo);
+  Double_t lRawMax = lCounts.fRawMax;
 
   if (lPercentileRequested < 1e-7)
     return lRawMax; //safeguard
@@ -164,35 +208,28 @@ Double_t multCalibrator::GetBoundaryForPercentile(TH1* histo, Double_t lPercenti
   lPrecisionEstimate = -1;
   if (lPercentile < lPercentileAnchor + 1e-7)
     return fAnchorPointValue;
-  Double_t lCount = 0;
-
-  // Anchor point changes: if anchored, start at the first bin that includes that
-  Long_t lFirstBin = 1;
-  Double_t lHadronicTotal = histo->Integral(1, histo->GetNbinsX()); // histo->GetEntries();
-  if (fAnchorPointValue > 0) {
-    lFirstBin = histo->FindBin(fAnchorPointValue + 1e-6);
-    Double_t lAbove = histo->Integral(lFirstBin, histo->GetNbinsX());
-    lHadronicTotal = lAbove * 100.0 / (fAnchorPointPercentage);
-    lCount = lHadronicTotal - lAbove; // the relevant anchored-out part
-  }
 
   const Long_t lNBins = histo->GetNbinsX();
+  const Long_t lFirstBin = lCounts.fFirstBin;
+  const Double_t lHadronicTotal = lCounts.fHadronicTotal;
   Double_t lCountDesired = lPercentile * lHadronicTotal / 100;
+  if (lFirstBin >= lNBins)
+    return lReturnValue;
 
-  for (Long_t ibin = lFirstBin; ibin < lNBins; ibin++) {
-    lCount += histo->GetBinContent(ibin);
-    if (lCount >= lCountDesired) {
-      //Found bin I am looking for!
-      Double_t lWidth = histo->GetBinWidth(ibin);
-      Double_t lLeftPercentile = 100. * (lCount - histo->GetBinContent(ibin)) / lHadronicTotal;
-      Double_t lRightPercentile = 100. * lCount / lHadronicTotal;
-      lPrecisionEstimate = (lRightPercentile - lLeftPercentile) / lPrecisionConstant;
+  //the bin contents are counts, hence the running count does not decrease
+  auto lFound = std::lower_bound(lCounts.fCount.begin() + lFirstBin, lCounts.fCount.end(), lCountDesired);
+  if (lFound != lCounts.fCount.end()) {
+    //Found bin I am looking for!
+    const Long_t ibin = lFound - lCounts.fCount.begin();
+    Double_t lCount = *lFound;
+    Double_t lWidth = histo->GetBinWidth(ibin);
+    Double_t lLeftPercentile = 100. * (lCount - histo->GetBinContent(ibin)) / lHadronicTotal;
+    Double_t lRightPercentile = 100. * lCount / lHadronicTotal;
+    lPrecisionEstimate = (lRightPercentile - lLeftPercentile) / lPrecisionConstant;
 
-      Double_t lProportion = (lPercentile - lLeftPercentile) / (lRightPercentile - lLeftPercentile);
+    Double_t lProportion = (lPercentile - lLeftPercentile) / (lRightPercentile - lLeftPercentile);
 
-      lReturnValue = histo->GetBinLowEdge(ibin) + lProportion * lWidth;
-      break;
-    }
+    lReturnValue = histo->GetBinLowEdge(ibin) + lProportion * lWidth;
   }
   return lReturnValue;
 }
@@ -269,11 +306,15 @@ TH1F* multCalibrator::GetCalibrationHistogram(TH1* histoRaw, TString lHistoName)
     lBounds[0] = 0;
   }
 
+  //running counts computed once for all the boundaries
+  CumulativeCounts lCounts;
+  FillCumulativeCounts(histoRaw, lCounts);
+
   for (Int_t ii = 0; ii < lNDesiredBoundaries; ii++) {
     Int_t lDisplacedii = ii;
     if (fAnchorPointValue > 0)
       lDisplacedii++;
-    lBounds[lDisplacedii] = GetBoundaryForPercentile(histoRaw, lDesiredBoundaries[ii], lPrecision[ii]);
+    lBounds[lDisplacedii] = GetBoundaryForPercentile(histoRaw, lCounts, lDesiredBoundaries[ii], lPrecision[ii]);
     TString lPrecisionString = "(Precision OK)";
     if (ii != 0 && ii != lNDesiredBoundaries - 1) {
       //check precision, please
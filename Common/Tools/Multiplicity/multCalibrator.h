@@ -21,6 +21,7 @@
 
 #include <iostream>
 #include <map>
+#include <vector>
 
 #include "TNamed.h"
 #include "TH1D.h"
@@ -69,6 +70,16 @@ class multCalibrator : public TNamed
   Double_t GetRawMax(TH1* histo);
   Double_t GetBoundaryForPercentile(TH1* histo, Double_t lPercentileRequested, Double_t& lPrecisionEstimate);
 
+  //Running counts of a raw histogram, computed once and shared by all its boundaries
+  struct CumulativeCounts {
+    Double_t fRawMax = 0.;        // right edge of the filled range, as GetRawMax
+    Double_t fHadronicTotal = 0.; // total, or the anchored one
+    Long_t fFirstBin = 1;         // first bin counted, after the anchor point
+    std::vector<Double_t> fCount; // running count up to each bin, in bin order
+  };
+  void FillCumulativeCounts(TH1* histo, CumulativeCounts& lCounts);
+  Double_t GetBoundaryForPercentile(TH1* histo, const CumulativeCounts& lCounts, Double_t lPercentileRequested, Double_t& lPrecisionEstimate);
+
   //Precision bookkeeping
   TH1D* GetPrecisionHistogram() { return fPrecisionHistogram; }; //gets precision histogram from current object
   void ResetPrecisionHistogram();                                //Reset precision histogram, if it exists
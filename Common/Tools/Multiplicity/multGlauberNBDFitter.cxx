@@ -56,7 +56,9 @@ multGlauberNBDFitter::multGlauberNBDFitter() : TNamed(),
                                                ff(0.8),
                                                fnorm(100),
                                                fFitOptions("R0"),
-                                               fFitNpx(5000)
+                                               fFitNpx(5000),
+                                               fCachedNBDPar{0., 0., 0.},
+                                               fNBDCacheValid(kFALSE)
 {
   // Constructor
   fNpart = new Double_t[fMaxNpNcPairs];
@@ -103,7 +105,9 @@ multGlauberNBDFitter::multGlauberNBDFitter(const char* name, const char* title)
                                                                                   ff(0.8),
                                                                                   fnorm(100),
                                                                                   fFitOptions("R0"),
-                                                                                  fFitNpx(5000)
+                                                                                  fFitNpx(5000),
+                                                                                  fCachedNBDPar{0., 0., 0.},
+                                                                                  fNBDCacheValid(kFALSE)
 {
   //Named constructor
   fNpart = new Double_t[fMaxNpNcPairs];
@@ -184,6 +188,7 @@ Double_t multGlauberNBDFitter::ProbDistrib(Double_t* x, Double_t* par)
       if (fAncestorMode == 2)
         fhNanc->Fill(lOption2, fContent[ibin]);
     }
+    fNBDCacheValid = kFALSE;
     if (fhNanc->Integral() < 1) {
       cout << "ERROR: ANCESTOR HISTOGRAM EMPTY" << endl;
       cout << "Will not do anything. Call InitializeNpNc if you want to plot without fitting" << endl;
@@ -193,6 +198,37 @@ Double_t multGlauberNBDFitter::ProbDistrib(Double_t* x, Double_t* par)
   }
   //______________________________________________________
   //Actually evaluate function
+  if (fAncestorMode == 2) {
+    //Same operations as ContinuousNBD, with the terms depending only on the
+    //parameters and on Nancestors taken from the cache. Empty bins add nothing.
+    UpdateContinuousNBDCache(par);
+    if (lMultValue <= 1e-6)
+      return par[3] * lProbability;
+    const Double_t n = lMultValue;
+    const Double_t lLnGammaN1 = TMath::LnGamma(n + 1.);
+    Double_t lGammaN1 = -1.;
+    const size_t lNAnc = fAncN.size();
+    for (size_t iAnc = 0; iAnc < lNAnc; iAnc++) {
+      const Double_t k = fAncK[iAnc];
+      Double_t F;
+      Double_t f;
+      if (n + k > 100.0) {
+        F = TMath::LnGamma(n + k) - lLnGammaN1 - fAncLnGammaK[iAnc];
+        f = n * fAncLogMuK[iAnc] - (n + k) * fAncLogOneMuK[iAnc];
+        F = F + f;
+        F = TMath::Exp(F);
+      } else {
+        if (lGammaN1 < 0.)
+          lGammaN1 = TMath::Gamma(n + 1.);
+        F = TMath::Gamma(n + k) / (lGammaN1 * fAncGammaK[iAnc]);
+        f = n * fAncLogMuK[iAnc] - (n + k) * fAncLogOneMuK[iAnc];
+        f = TMath::Exp(f);
+        F *= f;
+      }
+      lProbability += fAncCount[iAnc] * F;
+    }
+    return par[3] * lProbability;
+  }
   Int_t lStartBin = fhNanc->FindBin(0.0) + 1;
   for (Long_t iNanc = lStartBin; iNanc < fhNanc->GetNbinsX() + 1; iNanc++) {
     Double_t lNancestors = fhNanc->GetBinCenter(iNanc);
@@ -214,6 +250,47 @@ Double_t multGlauberNBDFitter::ProbDistrib(Double_t* x, Double_t* par)
   return par[3] * lProbability;
 }
 
+//______________________________________________________
+void multGlauberNBDFitter::UpdateContinuousNBDCache(const Double_t* par)
+{
+  //The minimiser evaluates the function at all the fit points for each set of
+  //parameters: the ancestor terms are recomputed only if (mu, k, dMu/dNanc) changed
+  if (fNBDCacheValid && fCachedNBDPar[0] == par[0] && fCachedNBDPar[1] == par[1] && fCachedNBDPar[2] == par[4])
+    return;
+  fCachedNBDPar[0] = par[0];
+  fCachedNBDPar[1] = par[1];
+  fCachedNBDPar[2] = par[4];
+
+  fAncN.clear();
+  fAncCount.clear();
+  Int_t lStartBin = fhNanc->FindBin(0.0) + 1;
+  for (Long_t iNanc = lStartBin; iNanc < fhNanc->GetNbinsX() + 1; iNanc++) {
+    Double_t lNancestorCount = fhNanc->GetBinContent(iNanc);
+    if (lNancestorCount == 0.)
+      continue;
+    fAncN.push_back(fhNanc->GetBinCenter(iNanc));
+    fAncCount.push_back(lNancestorCount);
+  }
+
+  const size_t lNAnc = fAncN.size();
+  fAncK.resize(lNAnc);
+  fAncLnGammaK.resize(lNAnc);
+  fAncGammaK.resize(lNAnc);
+  fAncLogMuK.resize(lNAnc);
+  fAncLogOneMuK.resize(lNAnc);
+  for (size_t iAnc = 0; iAnc < lNAnc; iAnc++) {
+    Double_t lNancestors = fAncN[iAnc];
+    Double_t mu = (((Double_t)lNancestors)) * (par[0] + par[4] * lNancestors);
+    Double_t k = (((Double_t)lNancestors)) * par[1];
+    fAncK[iAnc] = k;
+    fAncLnGammaK[iAnc] = TMath::LnGamma(k);
+    fAncGammaK[iAnc] = k <= 100.0 ? TMath::Gamma(k) : 0.;
+    fAncLogMuK[iAnc] = TMath::Log(mu / k);
+    fAncLogOneMuK[iAnc] = TMath::Log(1.0 + mu / k);
+  }
+  fNBDCacheValid = kTRUE;
+}
+
 //________________________________________________________________
 Bool_t multGlauberNBDFitter::SetNpartNcollCorrelation(TH2* hNpNc)
 {
@@ -13,6 +13,7 @@
 #define MULTGLAUBERNBDFITTER_H
 
 #include <iostream>
+#include <vector>
 #include "TNamed.h"
 #include "TF1.h"
 #include "TH1.h"
@@ -115,6 +116,19 @@ class multGlauberNBDFitter : public TNamed
   TString fFitOptions;
   Long_t fFitNpx;
 
+  //Caches of the continuous NBD (ancestor mode 2) for the evaluations at fixed parameters:
+  //only the terms depending on the multiplicity are evaluated per (multiplicity, Nancestors)
+  void UpdateContinuousNBDCache(const Double_t* par);
+  std::vector<Double_t> fAncN;         //! centres of the non-empty ancestor bins
+  std::vector<Double_t> fAncCount;     //! normalised contents of these bins
+  std::vector<Double_t> fAncK;         //! k of the NBD for each ancestor bin
+  std::vector<Double_t> fAncLnGammaK;  //! LnGamma(k)
+  std::vector<Double_t> fAncGammaK;    //! Gamma(k), for k <= 100 only
+  std::vector<Double_t> fAncLogMuK;    //! Log(mu/k)
+  std::vector<Double_t> fAncLogOneMuK; //! Log(1 + mu/k)
+  Double_t fCachedNBDPar[3];           //! mu, k, dMu/dNanc of the cache
+  Bool_t fNBDCacheValid;               //! cache filled with the current fhNanc
+
   ClassDef(multGlauberNBDFitter, 1);
 };
 #endif
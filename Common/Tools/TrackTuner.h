@@ -44,6 +44,53 @@
 #include "ReconstructionDataFormats/Track.h"
 #include <TGraphErrors.h>
 
+/// Linear interpolation of a graph with the points sorted in x, as TGraph::Eval within the range of the graph.
+/// The points are copied once, so that each evaluation is a binary search instead of a loop over the points.
+class TrackTunerGraphInterpolator
+{
+ public:
+  void set(const TGraph* graph)
+  {
+    mX.clear();
+    mY.clear();
+    if (!graph) {
+      return;
+    }
+    std::vector<std::pair<double, double>> points;
+    for (int i = 0; i < graph->GetN(); i++) {
+      points.emplace_back(graph->GetX()[i], graph->GetY()[i]);
+    }
+    std::stable_sort(points.begin(), points.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (const auto& point : points) {
+      mX.push_back(point.first);
+      mY.push_back(point.second);
+    }
+  }
+
+  bool isSet() const { return !mX.empty(); }
+  double xMin() const { return mX.front(); }
+  double xMax() const { return mX.back(); }
+
+  /// \param x  abscissa within [xMin(), xMax()]
+  double eval(double x) const
+  {
+    const std::size_t up = std::lower_bound(mX.begin(), mX.end(), x) - mX.begin();
+    if (up == mX.size()) {
+      return mY.back();
+    }
+    if (mX[up] == x || up == 0) {
+      return mY[up];
+    }
+    // first of the points with the abscissa of the lower neighbour, as TGraph::Eval for unsorted graphs
+    const std::size_t low = std::lower_bound(mX.begin(), mX.end(), mX[up - 1]) - mX.begin();
+    return mY[up] + (x - mX[up]) * (mY[low] - mY[up]) / (mX[low] - mX[up]);
+  }
+
+ private:
+  std::vector<double> mX; // sorted abscissas
+  std::vector<double> mY; // ordinates
+};
+
 namespace o2::aod
 {
 namespace track_tuner
@@ -98,6 +145,20 @@ struct TrackTuner {
   std::unique_ptr<TGraphErrors> grDcaZPullVsPtPionMC;
   std::unique_ptr<TGraphErrors> grDcaZPullVsPtPionData;
 
+  // interpolations of the graphs evaluated per track, filled in getDcaGraphs()
+  TrackTunerGraphInterpolator interpDcaXYResVsPtPionMC;
+  TrackTunerGraphInterpolator interpDcaXYResVsPtPionData;
+  TrackTunerGraphInterpolator interpDcaZResVsPtPionMC;
+  TrackTunerGraphInterpolator interpDcaZResVsPtPionData;
+  TrackTunerGraphInterpolator interpOneOverPtPionMC;
+  TrackTunerGraphInterpolator interpOneOverPtPionData;
+  TrackTunerGraphInterpolator interpDcaXYMeanVsPtPionMC;
+  TrackTunerGraphInterpolator interpDcaXYMeanVsPtPionData;
+  TrackTunerGraphInterpolator interpDcaXYPullVsPtPionMC;
+  TrackTunerGraphInterpolator interpDcaXYPullVsPtPionData;
+  TrackTunerGraphInterpolator interpDcaZPullVsPtPionMC;
+  TrackTunerGraphInterpolator interpDcaZPullVsPtPionData;
+
   /// @brief Function to configure the TrackTuner parameters
   /// @param inputString Input string with all parameter configuration. Format: <name>=<value>|<name>=<value>
   /// @return String with the values of all parameters after configurations are listed, to cross check that everything worked well
@@ -391,6 +452,19 @@ struct TrackTuner {
       grOneOverPtPionMC.reset(dynamic_cast<TGraphErrors*>(inputFileQoverPt->Get(grOneOverPtPionNameMC.c_str())));
       grOneOverPtPionData.reset(dynamic_cast<TGraphErrors*>(inputFileQoverPt->Get(grOneOverPtPionNameData.c_str())));
     }
+
+    interpDcaXYResVsPtPionMC.set(grDcaXYResVsPtPionMC.get());
+    interpDcaXYResVsPtPionData.set(grDcaXYResVsPtPionData.get());
+    interpDcaZResVsPtPionMC.set(grDcaZResVsPtPionMC.get());
+    interpDcaZResVsPtPionData.set(grDcaZResVsPtPionData.get());
+    interpOneOverPtPionMC.set(grOneOverPtPionMC.get());
+    interpOneOverPtPionData.set(grOneOverPtPionData.get());
+    interpDcaXYMeanVsPtPionMC.set(grDcaXYMeanVsPtPionMC.get());
+    interpDcaXYMeanVsPtPionData.set(grDcaXYMeanVsPtPionData.get());
+    interpDcaXYPullVsPtPionMC.set(grDcaXYPullVsPtPionMC.get());
+    interpDcaXYPullVsPtPionData.set(grDcaXYPullVsPtPionData.get());
+    interpDcaZPullVsPtPionMC.set(grDcaZPullVsPtPionMC.get());
+    interpDcaZPullVsPtPionData.set(grDcaZPullVsPtPionData.get());
   } // getDcaGraphs() ends here
 
   template <typename T1, typename T2, typename T3, typename T4, typename H>
@@ -412,11 +486,11 @@ struct TrackTuner {
     double dcaZPullMC = 1.0;
     double dcaZPullData = 1.0;
 
-    dcaXYResMC = evalGraph(ptMC, grDcaXYResVsPtPionMC.get());
-    dcaXYResData = evalGraph(ptMC, grDcaXYResVsPtPionData.get());
+    dcaXYResMC = evalGraph(ptMC, interpDcaXYResVsPtPionMC);
+    dcaXYResData = evalGraph(ptMC, interpDcaXYResVsPtPionData);
 
-    dcaZResMC = evalGraph(ptMC, grDcaZResVsPtPionMC.get());
-    dcaZResData = evalGraph(ptMC, grDcaZResVsPtPionData.get());
+    dcaZResMC = evalGraph(ptMC, interpDcaZResVsPtPionMC);
+    dcaZResData = evalGraph(ptMC, interpDcaZResVsPtPionData);
 
     // For Q/Pt corrections, files on CCDB will be used if both qOverPtMC and qOverPtData are null
     if (updateCurvature || updateCurvatureIU) {
@@ -428,20 +502,20 @@ struct TrackTuner {
         if (!grOneOverPtPionData.get() || !grOneOverPtPionMC.get()) {
           LOG(fatal) << "### q/pt smearing: input graphs not correctly retrieved. Aborting.";
         }
-        qOverPtMC = std::max(0.0, evalGraph(ptMC, grOneOverPtPionMC.get()));
-        qOverPtData = std::max(0.0, evalGraph(ptMC, grOneOverPtPionData.get()));
+        qOverPtMC = std::max(0.0, evalGraph(ptMC, interpOneOverPtPionMC));
+        qOverPtData = std::max(0.0, evalGraph(ptMC, interpOneOverPtPionData));
       } // qOverPtMC, qOverPtData block ends here
     }   // updateCurvature, updateCurvatureIU block ends here
 
     if (updateTrackDCAs) {
-      dcaXYMeanMC = evalGraph(ptMC, grDcaXYMeanVsPtPionMC.get());
-      dcaXYMeanData = evalGraph(ptMC, grDcaXYMeanVsPtPionData.get());
+      dcaXYMeanMC = evalGraph(ptMC, interpDcaXYMeanVsPtPionMC);
+      dcaXYMeanData = evalGraph(ptMC, interpDcaXYMeanVsPtPionData);
 
-      dcaXYPullMC = evalGraph(ptMC, grDcaXYPullVsPtPionMC.get());
-      dcaXYPullData = evalGraph(ptMC, grDcaXYPullVsPtPionData.get());
+      dcaXYPullMC = evalGraph(ptMC, interpDcaXYPullVsPtPionMC);
+      dcaXYPullData = evalGraph(ptMC, interpDcaXYPullVsPtPionData);
 
-      dcaZPullMC = evalGraph(ptMC, grDcaZPullVsPtPionMC.get());
-      dcaZPullData = evalGraph(ptMC, grDcaZPullVsPtPionData.get());
+      dcaZPullMC = evalGraph(ptMC, interpDcaZPullVsPtPionMC);
+      dcaZPullData = evalGraph(ptMC, interpDcaZPullVsPtPionData);
     }
     //  Unit conversion, is it required ??
     dcaXYResMC *= 1.e-4;
@@ -824,21 +898,20 @@ struct TrackTuner {
   //   return -1;
   // }
 
-  double evalGraph(double x, const TGraphErrors* graph) const
+  double evalGraph(double x, const TrackTunerGraphInterpolator& graph) const
   {
 
-    if (!graph) {
+    if (!graph.isSet()) {
       printf("\tevalGraph fails !\n");
       return 0.;
     }
-    int nPoints = graph->GetN();
-    double xMin = graph->GetX()[0];
-    double xMax = graph->GetX()[nPoints - 1];
+    double xMin = graph.xMin();
+    double xMax = graph.xMax();
     if (x > xMax)
-      return graph->Eval(xMax);
+      return graph.eval(xMax);
     if (x < xMin)
-      return graph->Eval(xMin);
-    return graph->Eval(x);
+      return graph.eval(xMin);
+    return graph.eval(x);
   }
 };
 
@@ -604,8 +604,9 @@ struct EventSelectionQaTask {
       double maxSec = ceil(tsEOR / 1000.);
       const AxisSpec axisSeconds{static_cast<int>(maxSec - minSec), minSec, maxSec, "seconds"};
       const AxisSpec axisBcDif{600, -300., 300., "bc difference"};
-      histos.add("hSecondsTVXvsBcDif", "", kTH2F, {axisSeconds, axisBcDif});
-      histos.add("hSecondsTVXvsBcDifAll", "", kTH2F, {axisSeconds, axisBcDif});
+      // one bin per second of the run: sparse, such that only the seconds covered by the processed DFs are allocated
+      histos.add("hSecondsTVXvsBcDif", "", kTHnSparseF, {axisSeconds, axisBcDif});
+      histos.add("hSecondsTVXvsBcDifAll", "", kTHnSparseF, {axisSeconds, axisBcDif});
     }
 
     // background studies
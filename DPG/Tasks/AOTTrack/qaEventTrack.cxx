@@ -641,13 +641,16 @@ struct qaEventTrack {
   template <bool IS_MC, typename T>
   bool isSelectedTrack(const T& track)
   {
-    if (track.pt() < minPt || track.pt() > maxPt) { // Extra pT selection
+    const float pt = track.pt();
+    if (pt < minPt || pt > maxPt) { // Extra pT selection
       return false;
     }
-    if (track.eta() < minEta || track.eta() > maxEta) { // Extra Eta selection
+    const float eta = track.eta();
+    if (eta < minEta || eta > maxEta) { // Extra Eta selection
       return false;
     }
-    if (track.phi() < minPhi || track.phi() > maxPhi) { // Extra Phi selection
+    const float phi = track.phi();
+    if (phi < minPhi || phi > maxPhi) { // Extra Phi selection
       return false;
     }
     if (track.tpcNClsCrossedRows() < minTPCcrossedRows) { // Extra TPC crossed rows selection
@@ -703,6 +706,7 @@ struct qaEventTrack {
   void fillRecoHistogramsAllTracks(const T& tracks, const aod::AmbiguousTracks& tracksAmbiguous);
   template <bool IS_MC, typename C, typename T, typename T_UNF>
   void fillRecoHistogramsGroupedTracks(const C& collision, const T& tracks, const T_UNF& tracksUnfiltered);
+  std::vector<bool> isSelectedGroupedTrack; // track selection of the collision, evaluated in the first of its track loops
 
   // Process function for data
   using CollisionTableData = soa::Join<aod::Collisions, aod::EvSels>;
@@ -1272,12 +1276,16 @@ void qaEventTrack::fillRecoHistogramsGroupedTracks(const C& collision, const T&
   }
 
   int nFilteredTracks = 0;
+  isSelectedGroupedTrack.clear();
   for (const auto& track : tracks) {
     if (checkOnlyPVContributor && !track.isPVContributor()) {
+      isSelectedGroupedTrack.push_back(false);
       continue;
     }
     histos.fill(HIST("Tracks/selection"), 1.f);
-    if (!isSelectedTrack<IS_MC>(track)) {
+    const bool isSelected = isSelectedTrack<IS_MC>(track);
+    isSelectedGroupedTrack.push_back(isSelected);
+    if (!isSelected) {
       continue;
     }
     histos.fill(HIST("Tracks/selection"), 2.f);
@@ -1491,11 +1499,13 @@ void qaEventTrack::fillRecoHistogramsGroupedTracks(const C& collision, const T&
   histos.fill(HIST("Events/nContribAllvsWithTRD"), collision.numContrib(), nPvContrWithTRD);
 
   // track related histograms
+  size_t iTrack = 0;
   for (const auto& track : tracks) {
+    const bool isSelected = isSelectedGroupedTrack[iTrack++];
     if (checkOnlyPVContributor && !track.isPVContributor()) {
       continue;
     }
-    if (!isSelectedTrack<IS_MC>(track)) {
+    if (!isSelected) {
       continue;
     }
     // fill kinematic variables
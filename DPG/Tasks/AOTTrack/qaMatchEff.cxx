@@ -117,6 +117,10 @@ struct qaMatchEff {
   // DCA and PID cuts
   Configurable<LabeledArray<float>> dcaMaxCut{"dcaMaxCut", {parTableDCA[0], nParDCA, nParVaDCA, parClassDCA, parNameDCA}, "Track DCA cuts"};
   Configurable<LabeledArray<float>> nSigmaPID{"nSigmaPID", {parTablePID[0], nParPID, nParVaPID, parClassPID, parNamePID}, "PID nSigma cuts TPC and TOF"};
+  // nSigma windows of nSigmaPID, read once by label in init instead of for every track
+  struct NSigmaWindows {
+    float pionMin, pionMax, kaonMin, kaonMax, protonMin, protonMax;
+  } nSigmaTPCWindows, nSigmaTOFWindows;
   // TPC
   Configurable<int> tpcNClusterMin{"tpcNClusterMin", 0, "Minimum number of clusters in TPC"};
   Configurable<int> tpcNCrossedRowsMin{"tpcNCrossedRowsMin", 70, "Minimum number of crossed rows in TPC"};
@@ -223,6 +227,16 @@ struct qaMatchEff {
   //
   void init(o2::framework::InitContext&)
   {
+    auto readNSigmaWindows = [&](NSigmaWindows& windows, const char* det) {
+      windows.pionMin = nSigmaPID->get(det, "nSigPionMin");
+      windows.pionMax = nSigmaPID->get(det, "nSigPionMax");
+      windows.kaonMin = nSigmaPID->get(det, "nSigKaonMin");
+      windows.kaonMax = nSigmaPID->get(det, "nSigKaonMax");
+      windows.protonMin = nSigmaPID->get(det, "nSigProtonMin");
+      windows.protonMax = nSigmaPID->get(det, "nSigProtonMax");
+    };
+    readNSigmaWindows(nSigmaTPCWindows, "TPC");
+    readNSigmaWindows(nSigmaTOFWindows, "TOF");
     if (doDebug)
       LOG(info) << "===========================================>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>  is it MC? = " << isitMC;
     //
@@ -1482,6 +1496,11 @@ struct qaMatchEff {
       // pt from full tracking or from TPCinnerWallPt
       float reco_pt = track.pt();
       float tpcinner_pt = computePtInParamTPC(track);
+      // eta and phi are dynamic columns, and the ITS and TPC selections are tested for many of the fills below
+      const float trackEta = track.eta();
+      const float trackPhi = track.phi();
+      const bool isITSCutsSelected = isTrackSelectedITSCuts(track);
+      const bool isTPCCutsSelected = isTrackSelectedTPCCuts(track);
 
       /// Using pt calculated at the inner wall of TPC
       /// Caveat: tgl still from tracking: this is not the value of tgl at the
@@ -1526,12 +1545,12 @@ struct qaMatchEff {
       const bool trkWTOF = track.hasTOF();
       const bool trkWTPC = track.hasTPC();
       const bool trkWITS = track.hasITS();
-      bool pionPIDwithTPC = (nSigmaPID->get("TPC", "nSigPionMin") < tpcNSigmaPion && tpcNSigmaPion < nSigmaPID->get("TPC", "nSigPionMax"));
-      bool pionPIDwithTOF = (nSigmaPID->get("TOF", "nSigPionMin") < tofNSigmaPion && tofNSigmaPion < nSigmaPID->get("TOF", "nSigPionMax"));
-      bool kaonPIDwithTPC = (nSigmaPID->get("TPC", "nSigKaonMin") < tpcNSigmaKaon && tpcNSigmaKaon < nSigmaPID->get("TPC", "nSigKaonMax"));
-      bool kaonPIDwithTOF = (nSigmaPID->get("TOF", "nSigKaonMin") < tofNSigmaKaon && tofNSigmaKaon < nSigmaPID->get("TOF", "nSigKaonMax"));
-      bool protonPIDwithTPC = (nSigmaPID->get("TPC", "nSigProtonMin") < tpcNSigmaProton && tpcNSigmaProton < nSigmaPID->get("TPC", "nSigProtonMax"));
-      bool protonPIDwithTOF = (nSigmaPID->get("TOF", "nSigProtonMin") < tofNSigmaProton && tofNSigmaProton < nSigmaPID->get("TOF", "nSigProtonMax"));
+      bool pionPIDwithTPC = (nSigmaTPCWindows.pionMin < tpcNSigmaPion && tpcNSigmaPion < nSigmaTPCWindows.pionMax);
+      bool pionPIDwithTOF = (nSigmaTOFWindows.pionMin < tofNSigmaPion && tofNSigmaPion < nSigmaTOFWindows.pionMax);
+      bool kaonPIDwithTPC = (nSigmaTPCWindows.kaonMin < tpcNSigmaKaon && tpcNSigmaKaon < nSigmaTPCWindows.kaonMax);
+      bool kaonPIDwithTOF = (nSigmaTOFWindows.kaonMin < tofNSigmaKaon && tofNSigmaKaon < nSigmaTOFWindows.kaonMax);
+      bool protonPIDwithTPC = (nSigmaTPCWindows.protonMin < tpcNSigmaProton && tpcNSigmaProton < nSigmaTPCWindows.protonMax);
+      bool protonPIDwithTOF = (nSigmaTOFWindows.protonMin < tofNSigmaProton && tofNSigmaProton < nSigmaTOFWindows.protonMax);
       // isPion
       bool isPion = false;
       if (isPIDPionRequired && pionPIDwithTPC && ((!trkWTOF) || pionPIDwithTOF))
@@ -1551,8 +1570,8 @@ struct qaMatchEff {
         siPDGCode = mcpart.pdgCode();
         tpPDGCode = TMath::Abs(siPDGCode);
         if (mcpart.isPhysicalPrimary()) {
-          // histos.get<TH1>(HIST("MC/control/etahist_diff"))->Fill(mcpart.eta() - track.eta());
-          auto delta = mcpart.phi() - track.phi();
+          // histos.get<TH1>(HIST("MC/control/etahist_diff"))->Fill(mcpart.eta() - trackEta);
+          auto delta = mcpart.phi() - trackPhi;
           if (delta > PI) {
             delta -= TwoPI;
           }
@@ -1627,146 +1646,146 @@ struct qaMatchEff {
       //***************************************************************************************************************************************************************************
       //  MIND!!!!   THESE SETS OVERLAP!!!  ___M__U__S__T___ select one of the conditions in the analysis
       hasdet = 0;
-      if (trkWITS && isTrackSelectedITSCuts(track)) { // ITS at least
+      if (trkWITS && isITSCutsSelected) { // ITS at least
         hasdet = 1;
         //
         //
         // fill thnsparse for fraction analysis
         if (makethn) {
           if constexpr (IS_MC) {
-            histos.fill(HIST("MC/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, track.eta(), sayPrim, track.phi(), specind, signOfTrack, hasdet);
+            histos.fill(HIST("MC/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, trackEta, sayPrim, trackPhi, specind, signOfTrack, hasdet);
           } else {
-            histos.fill(HIST("data/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, track.eta(), sayPrim, track.phi(), specind, signOfTrack, hasdet);
+            histos.fill(HIST("data/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, trackEta, sayPrim, trackPhi, specind, signOfTrack, hasdet);
           }
         }
       }
-      if (trkWTPC && isTrackSelectedTPCCuts(track)) { // TPC at least
+      if (trkWTPC && isTPCCutsSelected) { // TPC at least
         hasdet = 2;
         //
         //
         // fill thnsparse for fraction analysis
         if (makethn) {
           if constexpr (IS_MC) {
-            histos.fill(HIST("MC/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, track.eta(), sayPrim, track.phi(), specind, signOfTrack, hasdet);
+            histos.fill(HIST("MC/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, trackEta, sayPrim, trackPhi, specind, signOfTrack, hasdet);
           } else {
-            histos.fill(HIST("data/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, track.eta(), sayPrim, track.phi(), specind, signOfTrack, hasdet);
+            histos.fill(HIST("data/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, trackEta, sayPrim, trackPhi, specind, signOfTrack, hasdet);
           }
         }
       }
-      if (trkWITS && trkWTPC && isTrackSelectedTPCCuts(track) && isTrackSelectedITSCuts(track)) { // ITS + TPC at least
+      if (trkWITS && trkWTPC && isTPCCutsSelected && isITSCutsSelected) { // ITS + TPC at least
         hasdet = 3;
         //
         //
         // fill thnsparse for fraction analysis
         if (makethn) {
           if constexpr (IS_MC) {
-            histos.fill(HIST("MC/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, track.eta(), sayPrim, track.phi(), specind, signOfTrack, hasdet);
+            histos.fill(HIST("MC/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, trackEta, sayPrim, trackPhi, specind, signOfTrack, hasdet);
           } else {
-            histos.fill(HIST("data/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, track.eta(), sayPrim, track.phi(), specind, signOfTrack, hasdet);
+            histos.fill(HIST("data/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, trackEta, sayPrim, trackPhi, specind, signOfTrack, hasdet);
           }
         }
       }
-      if (trkWTOF && trkWTPC && isTrackSelectedTPCCuts(track)) { // TOF + TPC at least
+      if (trkWTOF && trkWTPC && isTPCCutsSelected) { // TOF + TPC at least
         hasdet = 4;
         //
         //
         // fill thnsparse for fraction analysis
         if (makethn) {
           if constexpr (IS_MC) {
-            histos.fill(HIST("MC/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, track.eta(), sayPrim, track.phi(), specind, signOfTrack, hasdet);
+            histos.fill(HIST("MC/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, trackEta, sayPrim, trackPhi, specind, signOfTrack, hasdet);
           } else {
-            histos.fill(HIST("data/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, track.eta(), sayPrim, track.phi(), specind, signOfTrack, hasdet);
+            histos.fill(HIST("data/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, trackEta, sayPrim, trackPhi, specind, signOfTrack, hasdet);
           }
         }
       }
-      if (trkWITS && isTrackSelectedITSCuts(track) && trkWTOF) { // TOF + ITS at least
+      if (trkWITS && isITSCutsSelected && trkWTOF) { // TOF + ITS at least
         hasdet = 5;
         //
         //
         // fill thnsparse for fraction analysis
         if (makethn) {
           if constexpr (IS_MC) {
-            histos.fill(HIST("MC/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, track.eta(), sayPrim, track.phi(), specind, signOfTrack, hasdet);
+            histos.fill(HIST("MC/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, trackEta, sayPrim, trackPhi, specind, signOfTrack, hasdet);
           } else {
-            histos.fill(HIST("data/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, track.eta(), sayPrim, track.phi(), specind, signOfTrack, hasdet);
+            histos.fill(HIST("data/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, trackEta, sayPrim, trackPhi, specind, signOfTrack, hasdet);
           }
         }
       }
-      if (trkWITS && trkWTOF && trkWTPC && isTrackSelectedTPCCuts(track) && isTrackSelectedITSCuts(track)) { // TOF + TPC +ITS at least
+      if (trkWITS && trkWTOF && trkWTPC && isTPCCutsSelected && isITSCutsSelected) { // TOF + TPC +ITS at least
         hasdet = 6;
         //
         //
         // fill thnsparse for fraction analysis
         if (makethn) {
           if constexpr (IS_MC) {
-            histos.fill(HIST("MC/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, track.eta(), sayPrim, track.phi(), specind, signOfTrack, hasdet);
+            histos.fill(HIST("MC/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, trackEta, sayPrim, trackPhi, specind, signOfTrack, hasdet);
           } else {
-            histos.fill(HIST("data/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, track.eta(), sayPrim, track.phi(), specind, signOfTrack, hasdet);
+            histos.fill(HIST("data/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, trackEta, sayPrim, trackPhi, specind, signOfTrack, hasdet);
           }
         }
       }
-      if (trkWITS && isTrackSelectedITSCuts(track) && !trkWTPC) { // ITS at least, NO TPC
+      if (trkWITS && isITSCutsSelected && !trkWTPC) { // ITS at least, NO TPC
         hasdet = 7;
         //
         //
         // fill thnsparse for fraction analysis
         if (makethn) {
           if constexpr (IS_MC) {
-            histos.fill(HIST("MC/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, track.eta(), sayPrim, track.phi(), specind, signOfTrack, hasdet);
+            histos.fill(HIST("MC/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, trackEta, sayPrim, trackPhi, specind, signOfTrack, hasdet);
           } else {
-            histos.fill(HIST("data/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, track.eta(), sayPrim, track.phi(), specind, signOfTrack, hasdet);
+            histos.fill(HIST("data/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, trackEta, sayPrim, trackPhi, specind, signOfTrack, hasdet);
           }
         }
       }
-      if (trkWTPC && isTrackSelectedTPCCuts(track) && !trkWITS) { // TPC at least, NO ITS
+      if (trkWTPC && isTPCCutsSelected && !trkWITS) { // TPC at least, NO ITS
         hasdet = 8;
         //
         //
         // fill thnsparse for fraction analysis
         if (makethn) {
           if constexpr (IS_MC) {
-            histos.fill(HIST("MC/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, track.eta(), sayPrim, track.phi(), specind, signOfTrack, hasdet);
+            histos.fill(HIST("MC/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, trackEta, sayPrim, trackPhi, specind, signOfTrack, hasdet);
           } else {
-            histos.fill(HIST("data/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, track.eta(), sayPrim, track.phi(), specind, signOfTrack, hasdet);
+            histos.fill(HIST("data/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, trackEta, sayPrim, trackPhi, specind, signOfTrack, hasdet);
           }
         }
       }
-      if (trkWITS && isTrackSelectedITSCuts(track) && trkWTRD) { // ITS + TRD at least
+      if (trkWITS && isITSCutsSelected && trkWTRD) { // ITS + TRD at least
         hasdet = 9;
         //
         //
         // fill thnsparse for fraction analysis
         if (makethn) {
           if constexpr (IS_MC) {
-            histos.fill(HIST("MC/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, track.eta(), sayPrim, track.phi(), specind, signOfTrack, hasdet);
+            histos.fill(HIST("MC/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, trackEta, sayPrim, trackPhi, specind, signOfTrack, hasdet);
           } else {
-            histos.fill(HIST("data/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, track.eta(), sayPrim, track.phi(), specind, signOfTrack, hasdet);
+            histos.fill(HIST("data/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, trackEta, sayPrim, trackPhi, specind, signOfTrack, hasdet);
           }
         }
       }
-      if (trkWITS && isTrackSelectedITSCuts(track) && trkWTRD && trkWTOF) { // ITS + TRD + TOF at least
+      if (trkWITS && isITSCutsSelected && trkWTRD && trkWTOF) { // ITS + TRD + TOF at least
         hasdet = 10;
         //
         //
         // fill thnsparse for fraction analysis
         if (makethn) {
           if constexpr (IS_MC) {
-            histos.fill(HIST("MC/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, track.eta(), sayPrim, track.phi(), specind, signOfTrack, hasdet);
+            histos.fill(HIST("MC/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, trackEta, sayPrim, trackPhi, specind, signOfTrack, hasdet);
           } else {
-            histos.fill(HIST("data/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, track.eta(), sayPrim, track.phi(), specind, signOfTrack, hasdet);
+            histos.fill(HIST("data/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, trackEta, sayPrim, trackPhi, specind, signOfTrack, hasdet);
           }
         }
       }
-      if (trkWITS && isTrackSelectedITSCuts(track) && !trkWTRD && !trkWTOF && !trkWTPC) { // ITS ONLY!
+      if (trkWITS && isITSCutsSelected && !trkWTRD && !trkWTOF && !trkWTPC) { // ITS ONLY!
         hasdet = 11;
         //
         //
         // fill thnsparse for fraction analysis
         if (makethn) {
           if constexpr (IS_MC) {
-            histos.fill(HIST("MC/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, track.eta(), sayPrim, track.phi(), specind, signOfTrack, hasdet);
+            histos.fill(HIST("MC/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, trackEta, sayPrim, trackPhi, specind, signOfTrack, hasdet);
           } else {
-            histos.fill(HIST("data/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, track.eta(), sayPrim, track.phi(), specind, signOfTrack, hasdet);
+            histos.fill(HIST("data/sparse/thnsforfrac"), track.dcaXY(), track.dcaZ(), trackPt, trackEta, sayPrim, trackPhi, specind, signOfTrack, hasdet);
           }
         }
       }
@@ -1866,7 +1885,7 @@ struct qaMatchEff {
       //
       // all tracks w/TPC
       //
-      if (trkWTPC && isTrackSelectedTPCCuts(track)) {
+      if (trkWTPC && isTPCCutsSelected) {
         if constexpr (IS_MC) { ////////////////////////   MC
           //
           // TPC clusters
@@ -1897,12 +1916,12 @@ struct qaMatchEff {
           // }
           histos.get<TH1>(HIST("MC/qopthist_tpc"))->Fill(track.signed1Pt());
           histos.get<TH1>(HIST("MC/pthist_tpc"))->Fill(trackPt);
-          histos.get<TH1>(HIST("MC/phihist_tpc"))->Fill(track.phi());
-          histos.get<TH1>(HIST("MC/etahist_tpc"))->Fill(track.eta());
+          histos.get<TH1>(HIST("MC/phihist_tpc"))->Fill(trackPhi);
+          histos.get<TH1>(HIST("MC/etahist_tpc"))->Fill(trackEta);
           if (trkWTOF) {
             histos.get<TH1>(HIST("MC/pthist_toftpc"))->Fill(trackPt);
-            histos.get<TH1>(HIST("MC/phihist_toftpc"))->Fill(track.phi());
-            histos.get<TH1>(HIST("MC/etahist_toftpc"))->Fill(track.eta());
+            histos.get<TH1>(HIST("MC/phihist_toftpc"))->Fill(trackPhi);
+            histos.get<TH1>(HIST("MC/etahist_toftpc"))->Fill(trackEta);
           }
           // if (isPion) {
           //   //
@@ -1952,7 +1971,7 @@ struct qaMatchEff {
           //     histos.get<TH1>(HIST("MC/TPCclust/tpcsFindableMinusCrossedRows_pr_tpc_1g"))->Fill(crowstpc);
           //   }
           // }
-          // if (trkWITS && isTrackSelectedITSCuts(track)) { ////////////////////////////////////////////   ITS tag inside TPC tagged
+          // if (trkWITS && isITSCutsSelected) { ////////////////////////////////////////////   ITS tag inside TPC tagged
           //   if (isPion) {
           //     //
           //     // TPC clusters
@@ -2033,8 +2052,8 @@ struct qaMatchEff {
           // }
           histos.get<TH1>(HIST("data/qopthist_tpc"))->Fill(track.signed1Pt());
           histos.get<TH1>(HIST("data/pthist_tpc"))->Fill(trackPt);
-          histos.get<TH1>(HIST("data/phihist_tpc"))->Fill(track.phi());
-          histos.get<TH1>(HIST("data/etahist_tpc"))->Fill(track.eta());
+          histos.get<TH1>(HIST("data/phihist_tpc"))->Fill(trackPhi);
+          histos.get<TH1>(HIST("data/etahist_tpc"))->Fill(trackEta);
           //
           // monitoring vs. time (debug reasons)
           if (enableMonitorVsTime && timeMonitorSetUp) {
@@ -2042,7 +2061,7 @@ struct qaMatchEff {
               const auto timestamp = track.collision().template bc_as<BCsWithTimeStamp>().timestamp(); /// NB: in ms
               histos.get<TH1>(HIST("data/hTrkTPCvsTime"))->Fill(timestamp);
               if (enableTHnSparseMonitorVsTime) {
-                histos.get<THnSparse>(HIST("data/hTrkTPCvsTimePtEtaPosZ"))->Fill(timestamp, trackPt, track.eta(), track.collision().posZ(), 1. / trackPt, signOfTrack * 0.5, track.tpcNClsFound(), track.itsNCls());
+                histos.get<THnSparse>(HIST("data/hTrkTPCvsTimePtEtaPosZ"))->Fill(timestamp, trackPt, trackEta, track.collision().posZ(), 1. / trackPt, signOfTrack * 0.5, track.tpcNClsFound(), track.itsNCls());
               }
             }
           }
@@ -2050,8 +2069,8 @@ struct qaMatchEff {
           // with TOF tag
           if (trkWTOF) {
             histos.get<TH1>(HIST("data/pthist_toftpc"))->Fill(trackPt);
-            histos.get<TH1>(HIST("data/phihist_toftpc"))->Fill(track.phi());
-            histos.get<TH1>(HIST("data/etahist_toftpc"))->Fill(track.eta());
+            histos.get<TH1>(HIST("data/phihist_toftpc"))->Fill(trackPhi);
+            histos.get<TH1>(HIST("data/etahist_toftpc"))->Fill(trackEta);
           }
           //
           // PID is applied
@@ -2075,16 +2094,16 @@ struct qaMatchEff {
             // histos.get<TH1>(HIST("data/PID/xyDCA_tpc_pi"))->Fill(track.dcaXY());
             //
             histos.get<TH1>(HIST("data/PID/pthist_tpc_pi"))->Fill(trackPt);
-            histos.get<TH1>(HIST("data/PID/phihist_tpc_pi"))->Fill(track.phi());
-            histos.get<TH1>(HIST("data/PID/etahist_tpc_pi"))->Fill(track.eta());
+            histos.get<TH1>(HIST("data/PID/phihist_tpc_pi"))->Fill(trackPhi);
+            histos.get<TH1>(HIST("data/PID/etahist_tpc_pi"))->Fill(trackEta);
             if (signOfTrack > 0) {
               histos.get<TH1>(HIST("data/PID/pthist_tpc_piplus"))->Fill(trackPt);
-              histos.get<TH1>(HIST("data/PID/phihist_tpc_piplus"))->Fill(track.phi());
-              histos.get<TH1>(HIST("data/PID/etahist_tpc_piplus"))->Fill(track.eta());
+              histos.get<TH1>(HIST("data/PID/phihist_tpc_piplus"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("data/PID/etahist_tpc_piplus"))->Fill(trackEta);
             } else {
               histos.get<TH1>(HIST("data/PID/pthist_tpc_piminus"))->Fill(trackPt);
-              histos.get<TH1>(HIST("data/PID/phihist_tpc_piminus"))->Fill(track.phi());
-              histos.get<TH1>(HIST("data/PID/etahist_tpc_piminus"))->Fill(track.eta());
+              histos.get<TH1>(HIST("data/PID/phihist_tpc_piminus"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("data/PID/etahist_tpc_piminus"))->Fill(trackEta);
             }
           }
           if (isPIDPionRequired) {
@@ -2145,16 +2164,16 @@ struct qaMatchEff {
             // histos.get<TH1>(HIST("data/PID/xyDCA_tpc_ka"))->Fill(track.dcaXY());
             //
             histos.get<TH1>(HIST("data/PID/pthist_tpc_ka"))->Fill(trackPt);
-            histos.get<TH1>(HIST("data/PID/phihist_tpc_ka"))->Fill(track.phi());
-            histos.get<TH1>(HIST("data/PID/etahist_tpc_ka"))->Fill(track.eta());
+            histos.get<TH1>(HIST("data/PID/phihist_tpc_ka"))->Fill(trackPhi);
+            histos.get<TH1>(HIST("data/PID/etahist_tpc_ka"))->Fill(trackEta);
             if (signOfTrack > 0) {
               histos.get<TH1>(HIST("data/PID/pthist_tpc_kaplus"))->Fill(trackPt);
-              histos.get<TH1>(HIST("data/PID/phihist_tpc_kaplus"))->Fill(track.phi());
-              histos.get<TH1>(HIST("data/PID/etahist_tpc_kaplus"))->Fill(track.eta());
+              histos.get<TH1>(HIST("data/PID/phihist_tpc_kaplus"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("data/PID/etahist_tpc_kaplus"))->Fill(trackEta);
             } else {
               histos.get<TH1>(HIST("data/PID/pthist_tpc_kaminus"))->Fill(trackPt);
-              histos.get<TH1>(HIST("data/PID/phihist_tpc_kaminus"))->Fill(track.phi());
-              histos.get<TH1>(HIST("data/PID/etahist_tpc_kaminus"))->Fill(track.eta());
+              histos.get<TH1>(HIST("data/PID/phihist_tpc_kaminus"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("data/PID/etahist_tpc_kaminus"))->Fill(trackEta);
             }
           }
           if (isPIDKaonRequired) {
@@ -2215,16 +2234,16 @@ struct qaMatchEff {
             // histos.get<TH1>(HIST("data/PID/xyDCA_tpc_pr"))->Fill(track.dcaXY());
             //
             histos.get<TH1>(HIST("data/PID/pthist_tpc_pr"))->Fill(trackPt);
-            histos.get<TH1>(HIST("data/PID/phihist_tpc_pr"))->Fill(track.phi());
-            histos.get<TH1>(HIST("data/PID/etahist_tpc_pr"))->Fill(track.eta());
+            histos.get<TH1>(HIST("data/PID/phihist_tpc_pr"))->Fill(trackPhi);
+            histos.get<TH1>(HIST("data/PID/etahist_tpc_pr"))->Fill(trackEta);
             if (signOfTrack > 0) {
               histos.get<TH1>(HIST("data/PID/pthist_tpc_prplus"))->Fill(trackPt);
-              histos.get<TH1>(HIST("data/PID/phihist_tpc_prplus"))->Fill(track.phi());
-              histos.get<TH1>(HIST("data/PID/etahist_tpc_prplus"))->Fill(track.eta());
+              histos.get<TH1>(HIST("data/PID/phihist_tpc_prplus"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("data/PID/etahist_tpc_prplus"))->Fill(trackEta);
             } else {
               histos.get<TH1>(HIST("data/PID/pthist_tpc_prminus"))->Fill(trackPt);
-              histos.get<TH1>(HIST("data/PID/phihist_tpc_prminus"))->Fill(track.phi());
-              histos.get<TH1>(HIST("data/PID/etahist_tpc_prminus"))->Fill(track.eta());
+              histos.get<TH1>(HIST("data/PID/phihist_tpc_prminus"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("data/PID/etahist_tpc_prminus"))->Fill(trackEta);
             }
           }
           if (isPIDProtonRequired) {
@@ -2269,21 +2288,21 @@ struct qaMatchEff {
             // histos.get<TH1>(HIST("data/PID/zDCA_tpc_noid"))->Fill(track.dcaZ());
             // histos.get<TH1>(HIST("data/PID/xyDCA_tpc_noid"))->Fill(track.dcaXY());
             histos.get<TH1>(HIST("data/PID/pthist_tpc_noid"))->Fill(trackPt);
-            histos.get<TH1>(HIST("data/PID/phihist_tpc_noid"))->Fill(track.phi());
-            histos.get<TH1>(HIST("data/PID/etahist_tpc_noid"))->Fill(track.eta());
+            histos.get<TH1>(HIST("data/PID/phihist_tpc_noid"))->Fill(trackPhi);
+            histos.get<TH1>(HIST("data/PID/etahist_tpc_noid"))->Fill(trackEta);
             if (signOfTrack > 0) {
               histos.get<TH1>(HIST("data/PID/pthist_tpc_noidplus"))->Fill(trackPt);
-              histos.get<TH1>(HIST("data/PID/phihist_tpc_noidplus"))->Fill(track.phi());
-              histos.get<TH1>(HIST("data/PID/etahist_tpc_noidplus"))->Fill(track.eta());
+              histos.get<TH1>(HIST("data/PID/phihist_tpc_noidplus"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("data/PID/etahist_tpc_noidplus"))->Fill(trackEta);
             } else {
               histos.get<TH1>(HIST("data/PID/pthist_tpc_noidminus"))->Fill(trackPt);
-              histos.get<TH1>(HIST("data/PID/phihist_tpc_noidminus"))->Fill(track.phi());
-              histos.get<TH1>(HIST("data/PID/etahist_tpc_noidminus"))->Fill(track.eta());
+              histos.get<TH1>(HIST("data/PID/phihist_tpc_noidminus"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("data/PID/etahist_tpc_noidminus"))->Fill(trackEta);
             }
           } // not pions, nor kaons, nor protons
         }   // end if DATA
         //
-        if (trkWITS && isTrackSelectedITSCuts(track)) { ////////////////////////////////////////////   ITS tag inside TPC tagged
+        if (trkWITS && isITSCutsSelected) { ////////////////////////////////////////////   ITS tag inside TPC tagged
           if constexpr (IS_MC) {                        ////////////////////////   MC
             //
             // TPC clusters
@@ -2307,16 +2326,16 @@ struct qaMatchEff {
             histos.get<TH1>(HIST("MC/qopthist_tpcits"))->Fill(track.signed1Pt());
             histos.get<TH1>(HIST("MC/pthist_tpcits"))->Fill(trackPt);
             //
-            histos.get<TH1>(HIST("MC/phihist_tpcits"))->Fill(track.phi());
-            histos.get<TH1>(HIST("MC/etahist_tpcits"))->Fill(track.eta());
+            histos.get<TH1>(HIST("MC/phihist_tpcits"))->Fill(trackPhi);
+            histos.get<TH1>(HIST("MC/etahist_tpcits"))->Fill(trackEta);
             //
             // histos.get<TH1>(HIST("MC/control/trackXhist_tpcits"))->Fill(track.x());
             // histos.get<TH1>(HIST("MC/control/trackZhist_tpcits"))->Fill(track.z());
 
             if (trkWTOF) {
               histos.get<TH1>(HIST("MC/pthist_toftpcits"))->Fill(trackPt);
-              histos.get<TH1>(HIST("MC/phihist_toftpcits"))->Fill(track.phi());
-              histos.get<TH1>(HIST("MC/etahist_toftpcits"))->Fill(track.eta());
+              histos.get<TH1>(HIST("MC/phihist_toftpcits"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("MC/etahist_toftpcits"))->Fill(trackEta);
             }
           } else { ////////////////////////   DATA
             //
@@ -2365,16 +2384,16 @@ struct qaMatchEff {
               // histos.get<TH1>(HIST("data/PID/xyDCA_tpcits_pi"))->Fill(track.dcaXY());
               //
               histos.get<TH1>(HIST("data/PID/pthist_tpcits_pi"))->Fill(trackPt);
-              histos.get<TH1>(HIST("data/PID/phihist_tpcits_pi"))->Fill(track.phi());
-              histos.get<TH1>(HIST("data/PID/etahist_tpcits_pi"))->Fill(track.eta());
+              histos.get<TH1>(HIST("data/PID/phihist_tpcits_pi"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("data/PID/etahist_tpcits_pi"))->Fill(trackEta);
               if (signOfTrack > 0) {
                 histos.get<TH1>(HIST("data/PID/pthist_tpcits_piplus"))->Fill(trackPt);
-                histos.get<TH1>(HIST("data/PID/phihist_tpcits_piplus"))->Fill(track.phi());
-                histos.get<TH1>(HIST("data/PID/etahist_tpcits_piplus"))->Fill(track.eta());
+                histos.get<TH1>(HIST("data/PID/phihist_tpcits_piplus"))->Fill(trackPhi);
+                histos.get<TH1>(HIST("data/PID/etahist_tpcits_piplus"))->Fill(trackEta);
               } else {
                 histos.get<TH1>(HIST("data/PID/pthist_tpcits_piminus"))->Fill(trackPt);
-                histos.get<TH1>(HIST("data/PID/phihist_tpcits_piminus"))->Fill(track.phi());
-                histos.get<TH1>(HIST("data/PID/etahist_tpcits_piminus"))->Fill(track.eta());
+                histos.get<TH1>(HIST("data/PID/phihist_tpcits_piminus"))->Fill(trackPhi);
+                histos.get<TH1>(HIST("data/PID/etahist_tpcits_piminus"))->Fill(trackEta);
               }
             }
             if (isPIDPionRequired) {
@@ -2435,16 +2454,16 @@ struct qaMatchEff {
               // histos.get<TH1>(HIST("data/PID/xyDCA_tpcits_ka"))->Fill(track.dcaXY());
               //
               histos.get<TH1>(HIST("data/PID/pthist_tpcits_ka"))->Fill(trackPt);
-              histos.get<TH1>(HIST("data/PID/phihist_tpcits_ka"))->Fill(track.phi());
-              histos.get<TH1>(HIST("data/PID/etahist_tpcits_ka"))->Fill(track.eta());
+              histos.get<TH1>(HIST("data/PID/phihist_tpcits_ka"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("data/PID/etahist_tpcits_ka"))->Fill(trackEta);
               if (signOfTrack > 0) {
                 histos.get<TH1>(HIST("data/PID/pthist_tpcits_kaplus"))->Fill(trackPt);
-                histos.get<TH1>(HIST("data/PID/phihist_tpcits_kaplus"))->Fill(track.phi());
-                histos.get<TH1>(HIST("data/PID/etahist_tpcits_kaplus"))->Fill(track.eta());
+                histos.get<TH1>(HIST("data/PID/phihist_tpcits_kaplus"))->Fill(trackPhi);
+                histos.get<TH1>(HIST("data/PID/etahist_tpcits_kaplus"))->Fill(trackEta);
               } else {
                 histos.get<TH1>(HIST("data/PID/pthist_tpcits_kaminus"))->Fill(trackPt);
-                histos.get<TH1>(HIST("data/PID/phihist_tpcits_kaminus"))->Fill(track.phi());
-                histos.get<TH1>(HIST("data/PID/etahist_tpcits_kaminus"))->Fill(track.eta());
+                histos.get<TH1>(HIST("data/PID/phihist_tpcits_kaminus"))->Fill(trackPhi);
+                histos.get<TH1>(HIST("data/PID/etahist_tpcits_kaminus"))->Fill(trackEta);
               }
             }
             if (isPIDKaonRequired) {
@@ -2505,16 +2524,16 @@ struct qaMatchEff {
               // histos.get<TH1>(HIST("data/PID/xyDCA_tpcits_pr"))->Fill(track.dcaXY());
               //
               histos.get<TH1>(HIST("data/PID/pthist_tpcits_pr"))->Fill(trackPt);
-              histos.get<TH1>(HIST("data/PID/phihist_tpcits_pr"))->Fill(track.phi());
-              histos.get<TH1>(HIST("data/PID/etahist_tpcits_pr"))->Fill(track.eta());
+              histos.get<TH1>(HIST("data/PID/phihist_tpcits_pr"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("data/PID/etahist_tpcits_pr"))->Fill(trackEta);
               if (signOfTrack > 0) {
                 histos.get<TH1>(HIST("data/PID/pthist_tpcits_prplus"))->Fill(trackPt);
-                histos.get<TH1>(HIST("data/PID/phihist_tpcits_prplus"))->Fill(track.phi());
-                histos.get<TH1>(HIST("data/PID/etahist_tpcits_prplus"))->Fill(track.eta());
+                histos.get<TH1>(HIST("data/PID/phihist_tpcits_prplus"))->Fill(trackPhi);
+                histos.get<TH1>(HIST("data/PID/etahist_tpcits_prplus"))->Fill(trackEta);
               } else {
                 histos.get<TH1>(HIST("data/PID/pthist_tpcits_prminus"))->Fill(trackPt);
-                histos.get<TH1>(HIST("data/PID/phihist_tpcits_prminus"))->Fill(track.phi());
-                histos.get<TH1>(HIST("data/PID/etahist_tpcits_prminus"))->Fill(track.eta());
+                histos.get<TH1>(HIST("data/PID/phihist_tpcits_prminus"))->Fill(trackPhi);
+                histos.get<TH1>(HIST("data/PID/etahist_tpcits_prminus"))->Fill(trackEta);
               }
             }
             if (isPIDProtonRequired) {
@@ -2556,8 +2575,8 @@ struct qaMatchEff {
             }
             // end protons
             histos.get<TH1>(HIST("data/pthist_tpcits"))->Fill(trackPt);
-            histos.get<TH1>(HIST("data/phihist_tpcits"))->Fill(track.phi());
-            histos.get<TH1>(HIST("data/etahist_tpcits"))->Fill(track.eta());
+            histos.get<TH1>(HIST("data/phihist_tpcits"))->Fill(trackPhi);
+            histos.get<TH1>(HIST("data/etahist_tpcits"))->Fill(trackEta);
             //
             // monitoring vs. time (debug reasons)
             if (enableMonitorVsTime && timeMonitorSetUp) {
@@ -2565,7 +2584,7 @@ struct qaMatchEff {
                 const auto timestamp = track.collision().template bc_as<BCsWithTimeStamp>().timestamp(); /// NB: in ms
                 histos.get<TH1>(HIST("data/hTrkITSTPCvsTime"))->Fill(timestamp);
                 if (enableTHnSparseMonitorVsTime) {
-                  histos.get<THnSparse>(HIST("data/hTrkITSTPCvsTimePtEtaPosZ"))->Fill(timestamp, trackPt, track.eta(), track.collision().posZ(), 1. / trackPt, signOfTrack * 0.5, track.tpcNClsFound(), track.itsNCls());
+                  histos.get<THnSparse>(HIST("data/hTrkITSTPCvsTimePtEtaPosZ"))->Fill(timestamp, trackPt, trackEta, track.collision().posZ(), 1. / trackPt, signOfTrack * 0.5, track.tpcNClsFound(), track.itsNCls());
                 }
               }
             }
@@ -2575,24 +2594,24 @@ struct qaMatchEff {
               // histos.get<TH1>(HIST("data/PID/zDCA_tpcits_noid"))->Fill(track.dcaZ());
               // histos.get<TH1>(HIST("data/PID/xyDCA_tpcits_noid"))->Fill(track.dcaXY());
               histos.get<TH1>(HIST("data/PID/pthist_tpcits_noid"))->Fill(trackPt);
-              histos.get<TH1>(HIST("data/PID/phihist_tpcits_noid"))->Fill(track.phi());
-              histos.get<TH1>(HIST("data/PID/etahist_tpcits_noid"))->Fill(track.eta());
+              histos.get<TH1>(HIST("data/PID/phihist_tpcits_noid"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("data/PID/etahist_tpcits_noid"))->Fill(trackEta);
               if (signOfTrack > 0) {
                 histos.get<TH1>(HIST("data/PID/pthist_tpcits_noidplus"))->Fill(trackPt);
-                histos.get<TH1>(HIST("data/PID/phihist_tpcits_noidplus"))->Fill(track.phi());
-                histos.get<TH1>(HIST("data/PID/etahist_tpcits_noidplus"))->Fill(track.eta());
+                histos.get<TH1>(HIST("data/PID/phihist_tpcits_noidplus"))->Fill(trackPhi);
+                histos.get<TH1>(HIST("data/PID/etahist_tpcits_noidplus"))->Fill(trackEta);
               } else {
                 histos.get<TH1>(HIST("data/PID/pthist_tpcits_noidminus"))->Fill(trackPt);
-                histos.get<TH1>(HIST("data/PID/phihist_tpcits_noidminus"))->Fill(track.phi());
-                histos.get<TH1>(HIST("data/PID/etahist_tpcits_noidminus"))->Fill(track.eta());
+                histos.get<TH1>(HIST("data/PID/phihist_tpcits_noidminus"))->Fill(trackPhi);
+                histos.get<TH1>(HIST("data/PID/etahist_tpcits_noidminus"))->Fill(trackEta);
               }
             }
             //
             // with TOF tag
             if (trkWTOF) {
               histos.get<TH1>(HIST("data/pthist_toftpcits"))->Fill(trackPt);
-              histos.get<TH1>(HIST("data/phihist_toftpcits"))->Fill(track.phi());
-              histos.get<TH1>(HIST("data/etahist_toftpcits"))->Fill(track.eta());
+              histos.get<TH1>(HIST("data/phihist_toftpcits"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("data/etahist_toftpcits"))->Fill(trackEta);
             }
           }
           /// control plot: correlation # ITS its vs ITS layer
@@ -2660,7 +2679,7 @@ struct qaMatchEff {
       //      if (trkWTPC && trkWTRD && trkWTOF)
       //        histos.get<TH1>(HIST("data/control/itsCMwTPCwTOFwTRD"))->Fill(track.itsClusterMap());
       //    }
-      //    if (isTrackSelectedITSCuts(track)) {
+      //    if (isITSCutsSelected) {
       //      if (IS_MC) { ////////////////////////   MC
       //        if (!trkWTPC)
       //          histos.get<TH1>(HIST("MC/control/SitsCMnoTPC"))->Fill(track.itsClusterMap());
@@ -2701,25 +2720,25 @@ struct qaMatchEff {
       //
       // all tracks with pt>0.5
       // if (trackPt > 0.5) {
-      //   if (trkWTPC && isTrackSelectedTPCCuts(track)) {
+      //   if (trkWTPC && isTPCCutsSelected) {
       //     if constexpr (IS_MC) { ////////////////////////   MC
       //       histos.get<TH1>(HIST("MC/pthist_tpc_05"))->Fill(trackPt);
-      //       histos.get<TH1>(HIST("MC/phihist_tpc_05"))->Fill(track.phi());
-      //       histos.get<TH1>(HIST("MC/etahist_tpc_05"))->Fill(track.eta());
+      //       histos.get<TH1>(HIST("MC/phihist_tpc_05"))->Fill(trackPhi);
+      //       histos.get<TH1>(HIST("MC/etahist_tpc_05"))->Fill(trackEta);
       //     } else { ////////////////////////   DATA
       //       histos.get<TH1>(HIST("data/pthist_tpc_05"))->Fill(trackPt);
-      //       histos.get<TH1>(HIST("data/phihist_tpc_05"))->Fill(track.phi());
-      //       histos.get<TH1>(HIST("data/etahist_tpc_05"))->Fill(track.eta());
+      //       histos.get<TH1>(HIST("data/phihist_tpc_05"))->Fill(trackPhi);
+      //       histos.get<TH1>(HIST("data/etahist_tpc_05"))->Fill(trackEta);
       //     }
-      //     if (trkWITS && isTrackSelectedITSCuts(track)) {
+      //     if (trkWITS && isITSCutsSelected) {
       //       if constexpr (IS_MC) {
       //         histos.get<TH1>(HIST("MC/pthist_tpcits_05"))->Fill(trackPt);
-      //         histos.get<TH1>(HIST("MC/phihist_tpcits_05"))->Fill(track.phi());
-      //         histos.get<TH1>(HIST("MC/etahist_tpcits_05"))->Fill(track.eta());
+      //         histos.get<TH1>(HIST("MC/phihist_tpcits_05"))->Fill(trackPhi);
+      //         histos.get<TH1>(HIST("MC/etahist_tpcits_05"))->Fill(trackEta);
       //       } else {
       //         histos.get<TH1>(HIST("data/pthist_tpcits_05"))->Fill(trackPt);
-      //         histos.get<TH1>(HIST("data/phihist_tpcits_05"))->Fill(track.phi());
-      //         histos.get<TH1>(HIST("data/etahist_tpcits_05"))->Fill(track.eta());
+      //         histos.get<TH1>(HIST("data/phihist_tpcits_05"))->Fill(trackPhi);
+      //         histos.get<TH1>(HIST("data/etahist_tpcits_05"))->Fill(trackEta);
       //       }
       //     } //  end if ITS
       //   }   //  end if TPC
@@ -2727,25 +2746,25 @@ struct qaMatchEff {
       //
       // positive only
       if (track.signed1Pt() > 0) {
-        if (trkWTPC && isTrackSelectedTPCCuts(track)) {
+        if (trkWTPC && isTPCCutsSelected) {
           if constexpr (IS_MC) {
             histos.get<TH1>(HIST("MC/pthist_tpc_pos"))->Fill(trackPt);
-            histos.get<TH1>(HIST("MC/phihist_tpc_pos"))->Fill(track.phi());
-            histos.get<TH1>(HIST("MC/etahist_tpc_pos"))->Fill(track.eta());
+            histos.get<TH1>(HIST("MC/phihist_tpc_pos"))->Fill(trackPhi);
+            histos.get<TH1>(HIST("MC/etahist_tpc_pos"))->Fill(trackEta);
           } else {
             histos.get<TH1>(HIST("data/pthist_tpc_pos"))->Fill(trackPt);
-            histos.get<TH1>(HIST("data/phihist_tpc_pos"))->Fill(track.phi());
-            histos.get<TH1>(HIST("data/etahist_tpc_pos"))->Fill(track.eta());
+            histos.get<TH1>(HIST("data/phihist_tpc_pos"))->Fill(trackPhi);
+            histos.get<TH1>(HIST("data/etahist_tpc_pos"))->Fill(trackEta);
           }
-          if (trkWITS && isTrackSelectedITSCuts(track)) {
+          if (trkWITS && isITSCutsSelected) {
             if constexpr (IS_MC) {
               histos.get<TH1>(HIST("MC/pthist_tpcits_pos"))->Fill(trackPt);
-              histos.get<TH1>(HIST("MC/phihist_tpcits_pos"))->Fill(track.phi());
-              histos.get<TH1>(HIST("MC/etahist_tpcits_pos"))->Fill(track.eta());
+              histos.get<TH1>(HIST("MC/phihist_tpcits_pos"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("MC/etahist_tpcits_pos"))->Fill(trackEta);
             } else {
               histos.get<TH1>(HIST("data/pthist_tpcits_pos"))->Fill(trackPt);
-              histos.get<TH1>(HIST("data/phihist_tpcits_pos"))->Fill(track.phi());
-              histos.get<TH1>(HIST("data/etahist_tpcits_pos"))->Fill(track.eta());
+              histos.get<TH1>(HIST("data/phihist_tpcits_pos"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("data/etahist_tpcits_pos"))->Fill(trackEta);
             }
           } //  end if ITS
         }   //  end if TPC
@@ -2754,25 +2773,25 @@ struct qaMatchEff {
       //
       // negative only
       if (track.signed1Pt() < 0) {
-        if (trkWTPC && isTrackSelectedTPCCuts(track)) {
+        if (trkWTPC && isTPCCutsSelected) {
           if constexpr (IS_MC) {
             histos.get<TH1>(HIST("MC/pthist_tpc_neg"))->Fill(trackPt);
-            histos.get<TH1>(HIST("MC/phihist_tpc_neg"))->Fill(track.phi());
-            histos.get<TH1>(HIST("MC/etahist_tpc_neg"))->Fill(track.eta());
+            histos.get<TH1>(HIST("MC/phihist_tpc_neg"))->Fill(trackPhi);
+            histos.get<TH1>(HIST("MC/etahist_tpc_neg"))->Fill(trackEta);
           } else {
             histos.get<TH1>(HIST("data/pthist_tpc_neg"))->Fill(trackPt);
-            histos.get<TH1>(HIST("data/phihist_tpc_neg"))->Fill(track.phi());
-            histos.get<TH1>(HIST("data/etahist_tpc_neg"))->Fill(track.eta());
+            histos.get<TH1>(HIST("data/phihist_tpc_neg"))->Fill(trackPhi);
+            histos.get<TH1>(HIST("data/etahist_tpc_neg"))->Fill(trackEta);
           }
-          if (trkWITS && isTrackSelectedITSCuts(track)) {
+          if (trkWITS && isITSCutsSelected) {
             if constexpr (IS_MC) {
               histos.get<TH1>(HIST("MC/pthist_tpcits_neg"))->Fill(trackPt);
-              histos.get<TH1>(HIST("MC/phihist_tpcits_neg"))->Fill(track.phi());
-              histos.get<TH1>(HIST("MC/etahist_tpcits_neg"))->Fill(track.eta());
+              histos.get<TH1>(HIST("MC/phihist_tpcits_neg"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("MC/etahist_tpcits_neg"))->Fill(trackEta);
             } else {
               histos.get<TH1>(HIST("data/pthist_tpcits_neg"))->Fill(trackPt);
-              histos.get<TH1>(HIST("data/phihist_tpcits_neg"))->Fill(track.phi());
-              histos.get<TH1>(HIST("data/etahist_tpcits_neg"))->Fill(track.eta());
+              histos.get<TH1>(HIST("data/phihist_tpcits_neg"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("data/etahist_tpcits_neg"))->Fill(trackEta);
             }
           } //  end if ITS
         }   //  end if TPC
@@ -2784,73 +2803,73 @@ struct qaMatchEff {
         //
         // only primaries
         if (mcpart.isPhysicalPrimary()) {
-          if (trkWTPC && isTrackSelectedTPCCuts(track)) {
+          if (trkWTPC && isTPCCutsSelected) {
             // histos.get<TH1>(HIST("MC/primsec/zDCA_tpc_prim"))->Fill(track.dcaZ());
             // histos.get<TH1>(HIST("MC/primsec/xyDCA_tpc_prim"))->Fill(track.dcaXY());
             //
             histos.get<TH1>(HIST("MC/primsec/qopthist_tpc_prim"))->Fill(track.signed1Pt());
             histos.get<TH1>(HIST("MC/primsec/pthist_tpc_prim"))->Fill(trackPt);
-            histos.get<TH1>(HIST("MC/primsec/phihist_tpc_prim"))->Fill(track.phi());
-            histos.get<TH1>(HIST("MC/primsec/etahist_tpc_prim"))->Fill(track.eta());
-            if (trkWITS && isTrackSelectedITSCuts(track)) {
+            histos.get<TH1>(HIST("MC/primsec/phihist_tpc_prim"))->Fill(trackPhi);
+            histos.get<TH1>(HIST("MC/primsec/etahist_tpc_prim"))->Fill(trackEta);
+            if (trkWITS && isITSCutsSelected) {
               // histos.get<TH1>(HIST("MC/primsec/zDCA_tpcits_prim"))->Fill(track.dcaZ());
               // histos.get<TH1>(HIST("MC/primsec/xyDCA_tpcits_prim"))->Fill(track.dcaXY());
               //
               histos.get<TH1>(HIST("MC/primsec/qopthist_tpcits_prim"))->Fill(track.signed1Pt());
               histos.get<TH1>(HIST("MC/primsec/pthist_tpcits_prim"))->Fill(trackPt);
-              histos.get<TH1>(HIST("MC/primsec/phihist_tpcits_prim"))->Fill(track.phi());
-              histos.get<TH1>(HIST("MC/primsec/etahist_tpcits_prim"))->Fill(track.eta());
+              histos.get<TH1>(HIST("MC/primsec/phihist_tpcits_prim"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("MC/primsec/etahist_tpcits_prim"))->Fill(trackEta);
             } //  end if ITS
           }   //  end if TPC
           //  end if primaries
         } else if (mcpart.getProcess() == 4) {
           //
           // only secondaries from decay
-          if (trkWTPC && isTrackSelectedTPCCuts(track)) {
+          if (trkWTPC && isTPCCutsSelected) {
             // histos.get<TH1>(HIST("MC/primsec/zDCA_tpc_secd"))->Fill(track.dcaZ());
             // histos.get<TH1>(HIST("MC/primsec/xyDCA_tpc_secd"))->Fill(track.dcaXY());
             //
             histos.get<TH1>(HIST("MC/primsec/qopthist_tpc_secd"))->Fill(track.signed1Pt());
             histos.get<TH1>(HIST("MC/primsec/pthist_tpc_secd"))->Fill(trackPt);
-            histos.get<TH1>(HIST("MC/primsec/phihist_tpc_secd"))->Fill(track.phi());
-            histos.get<TH1>(HIST("MC/primsec/etahist_tpc_secd"))->Fill(track.eta());
-            if (trkWITS && isTrackSelectedITSCuts(track)) {
+            histos.get<TH1>(HIST("MC/primsec/phihist_tpc_secd"))->Fill(trackPhi);
+            histos.get<TH1>(HIST("MC/primsec/etahist_tpc_secd"))->Fill(trackEta);
+            if (trkWITS && isITSCutsSelected) {
               // histos.get<TH1>(HIST("MC/primsec/zDCA_tpcits_secd"))->Fill(track.dcaZ());
               // histos.get<TH1>(HIST("MC/primsec/xyDCA_tpcits_secd"))->Fill(track.dcaXY());
               //
               histos.get<TH1>(HIST("MC/primsec/qopthist_tpcits_secd"))->Fill(track.signed1Pt());
               histos.get<TH1>(HIST("MC/primsec/pthist_tpcits_secd"))->Fill(trackPt);
-              histos.get<TH1>(HIST("MC/primsec/phihist_tpcits_secd"))->Fill(track.phi());
-              histos.get<TH1>(HIST("MC/primsec/etahist_tpcits_secd"))->Fill(track.eta());
+              histos.get<TH1>(HIST("MC/primsec/phihist_tpcits_secd"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("MC/primsec/etahist_tpcits_secd"))->Fill(trackEta);
             } //  end if ITS
           }   //  end if TPC
           // end if secondaries from decay
         } else {
           //
           // only secondaries from material
-          if (trkWTPC && isTrackSelectedTPCCuts(track)) {
+          if (trkWTPC && isTPCCutsSelected) {
             // histos.get<TH1>(HIST("MC/primsec/zDCA_tpc_secm"))->Fill(track.dcaZ());
             // histos.get<TH1>(HIST("MC/primsec/xyDCA_tpc_secm"))->Fill(track.dcaXY());
             //
             histos.get<TH1>(HIST("MC/primsec/qopthist_tpc_secm"))->Fill(track.signed1Pt());
             histos.get<TH1>(HIST("MC/primsec/pthist_tpc_secm"))->Fill(trackPt);
-            histos.get<TH1>(HIST("MC/primsec/phihist_tpc_secm"))->Fill(track.phi());
-            histos.get<TH1>(HIST("MC/primsec/etahist_tpc_secm"))->Fill(track.eta());
-            if (trkWITS && isTrackSelectedITSCuts(track)) {
+            histos.get<TH1>(HIST("MC/primsec/phihist_tpc_secm"))->Fill(trackPhi);
+            histos.get<TH1>(HIST("MC/primsec/etahist_tpc_secm"))->Fill(trackEta);
+            if (trkWITS && isITSCutsSelected) {
               // histos.get<TH1>(HIST("MC/primsec/zDCA_tpcits_secm"))->Fill(track.dcaZ());
               // histos.get<TH1>(HIST("MC/primsec/xyDCA_tpcits_secm"))->Fill(track.dcaXY());
               //
               histos.get<TH1>(HIST("MC/primsec/qopthist_tpcits_secm"))->Fill(track.signed1Pt());
               histos.get<TH1>(HIST("MC/primsec/pthist_tpcits_secm"))->Fill(trackPt);
-              histos.get<TH1>(HIST("MC/primsec/phihist_tpcits_secm"))->Fill(track.phi());
-              histos.get<TH1>(HIST("MC/primsec/etahist_tpcits_secm"))->Fill(track.eta());
+              histos.get<TH1>(HIST("MC/primsec/phihist_tpcits_secm"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("MC/primsec/etahist_tpcits_secm"))->Fill(trackEta);
             } //  end if ITS
           }   //  end if TPC
         }     // end if secondaries from material
         //
         // protons only
         if (tpPDGCode == 2212) {
-          if (trkWTPC && isTrackSelectedTPCCuts(track)) {
+          if (trkWTPC && isTPCCutsSelected) {
             //
             // TPC clusters
             histos.get<TH1>(HIST("MC/TPCclust/tpcNClsFound_prMC_tpc"))->Fill(clustpc);
@@ -2870,18 +2889,18 @@ struct qaMatchEff {
             // histos.get<TH1>(HIST("MC/PID/xyDCA_tpc_pr"))->Fill(track.dcaXY());
             //
             histos.get<TH1>(HIST("MC/PID/pthist_tpc_pr"))->Fill(trackPt);
-            histos.get<TH1>(HIST("MC/PID/phihist_tpc_pr"))->Fill(track.phi());
-            histos.get<TH1>(HIST("MC/PID/etahist_tpc_pr"))->Fill(track.eta());
+            histos.get<TH1>(HIST("MC/PID/phihist_tpc_pr"))->Fill(trackPhi);
+            histos.get<TH1>(HIST("MC/PID/etahist_tpc_pr"))->Fill(trackEta);
             if (signOfTrack > 0) {
               histos.get<TH1>(HIST("MC/PID/pthist_tpc_prplus"))->Fill(trackPt);
-              histos.get<TH1>(HIST("MC/PID/phihist_tpc_prplus"))->Fill(track.phi());
-              histos.get<TH1>(HIST("MC/PID/etahist_tpc_prplus"))->Fill(track.eta());
+              histos.get<TH1>(HIST("MC/PID/phihist_tpc_prplus"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("MC/PID/etahist_tpc_prplus"))->Fill(trackEta);
             } else {
               histos.get<TH1>(HIST("MC/PID/pthist_tpc_prminus"))->Fill(trackPt);
-              histos.get<TH1>(HIST("MC/PID/phihist_tpc_prminus"))->Fill(track.phi());
-              histos.get<TH1>(HIST("MC/PID/etahist_tpc_prminus"))->Fill(track.eta());
+              histos.get<TH1>(HIST("MC/PID/phihist_tpc_prminus"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("MC/PID/etahist_tpc_prminus"))->Fill(trackEta);
             }
-            if (trkWITS && isTrackSelectedITSCuts(track)) {
+            if (trkWITS && isITSCutsSelected) {
               //
               // TPC clusters
               histos.get<TH1>(HIST("MC/TPCclust/tpcNClsFound_prMC_tpcits"))->Fill(clustpc);
@@ -2901,16 +2920,16 @@ struct qaMatchEff {
               // histos.get<TH1>(HIST("MC/PID/xyDCA_tpcits_pr"))->Fill(track.dcaXY());
               //
               histos.get<TH1>(HIST("MC/PID/pthist_tpcits_pr"))->Fill(trackPt);
-              histos.get<TH1>(HIST("MC/PID/phihist_tpcits_pr"))->Fill(track.phi());
-              histos.get<TH1>(HIST("MC/PID/etahist_tpcits_pr"))->Fill(track.eta());
+              histos.get<TH1>(HIST("MC/PID/phihist_tpcits_pr"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("MC/PID/etahist_tpcits_pr"))->Fill(trackEta);
               if (signOfTrack > 0) {
                 histos.get<TH1>(HIST("MC/PID/pthist_tpcits_prplus"))->Fill(trackPt);
-                histos.get<TH1>(HIST("MC/PID/phihist_tpcits_prplus"))->Fill(track.phi());
-                histos.get<TH1>(HIST("MC/PID/etahist_tpcits_prplus"))->Fill(track.eta());
+                histos.get<TH1>(HIST("MC/PID/phihist_tpcits_prplus"))->Fill(trackPhi);
+                histos.get<TH1>(HIST("MC/PID/etahist_tpcits_prplus"))->Fill(trackEta);
               } else {
                 histos.get<TH1>(HIST("MC/PID/pthist_tpcits_prminus"))->Fill(trackPt);
-                histos.get<TH1>(HIST("MC/PID/phihist_tpcits_prminus"))->Fill(track.phi());
-                histos.get<TH1>(HIST("MC/PID/etahist_tpcits_prminus"))->Fill(track.eta());
+                histos.get<TH1>(HIST("MC/PID/phihist_tpcits_prminus"))->Fill(trackPhi);
+                histos.get<TH1>(HIST("MC/PID/etahist_tpcits_prminus"))->Fill(trackEta);
               }
             } //  end if ITS
           }   //  end if TPC
@@ -2918,7 +2937,7 @@ struct qaMatchEff {
         //
         // pions only
         if (tpPDGCode == 211) {
-          if (trkWTPC && isTrackSelectedTPCCuts(track)) {
+          if (trkWTPC && isTPCCutsSelected) {
             //
             // TPC clusters
             histos.get<TH1>(HIST("MC/TPCclust/tpcNClsFound_piMC_tpc"))->Fill(clustpc);
@@ -2938,18 +2957,18 @@ struct qaMatchEff {
             // histos.get<TH1>(HIST("MC/PID/xyDCA_tpc_pi"))->Fill(track.dcaXY());
             //
             histos.get<TH1>(HIST("MC/PID/pthist_tpc_pi"))->Fill(trackPt);
-            histos.get<TH1>(HIST("MC/PID/phihist_tpc_pi"))->Fill(track.phi());
-            histos.get<TH1>(HIST("MC/PID/etahist_tpc_pi"))->Fill(track.eta());
+            histos.get<TH1>(HIST("MC/PID/phihist_tpc_pi"))->Fill(trackPhi);
+            histos.get<TH1>(HIST("MC/PID/etahist_tpc_pi"))->Fill(trackEta);
             if (signOfTrack > 0) {
               histos.get<TH1>(HIST("MC/PID/pthist_tpc_piplus"))->Fill(trackPt);
-              histos.get<TH1>(HIST("MC/PID/phihist_tpc_piplus"))->Fill(track.phi());
-              histos.get<TH1>(HIST("MC/PID/etahist_tpc_piplus"))->Fill(track.eta());
+              histos.get<TH1>(HIST("MC/PID/phihist_tpc_piplus"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("MC/PID/etahist_tpc_piplus"))->Fill(trackEta);
             } else {
               histos.get<TH1>(HIST("MC/PID/pthist_tpc_piminus"))->Fill(trackPt);
-              histos.get<TH1>(HIST("MC/PID/phihist_tpc_piminus"))->Fill(track.phi());
-              histos.get<TH1>(HIST("MC/PID/etahist_tpc_piminus"))->Fill(track.eta());
+              histos.get<TH1>(HIST("MC/PID/phihist_tpc_piminus"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("MC/PID/etahist_tpc_piminus"))->Fill(trackEta);
             }
-            if (trkWITS && isTrackSelectedITSCuts(track)) {
+            if (trkWITS && isITSCutsSelected) {
               //
               // TPC clusters
               histos.get<TH1>(HIST("MC/TPCclust/tpcNClsFound_piMC_tpcits"))->Fill(clustpc);
@@ -2969,58 +2988,58 @@ struct qaMatchEff {
               // histos.get<TH1>(HIST("MC/PID/xyDCA_tpcits_pi"))->Fill(track.dcaXY());
               //
               histos.get<TH1>(HIST("MC/PID/pthist_tpcits_pi"))->Fill(trackPt);
-              histos.get<TH1>(HIST("MC/PID/phihist_tpcits_pi"))->Fill(track.phi());
-              histos.get<TH1>(HIST("MC/PID/etahist_tpcits_pi"))->Fill(track.eta());
+              histos.get<TH1>(HIST("MC/PID/phihist_tpcits_pi"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("MC/PID/etahist_tpcits_pi"))->Fill(trackEta);
               if (signOfTrack > 0) {
                 histos.get<TH1>(HIST("MC/PID/pthist_tpcits_piplus"))->Fill(trackPt);
-                histos.get<TH1>(HIST("MC/PID/phihist_tpcits_piplus"))->Fill(track.phi());
-                histos.get<TH1>(HIST("MC/PID/etahist_tpcits_piplus"))->Fill(track.eta());
+                histos.get<TH1>(HIST("MC/PID/phihist_tpcits_piplus"))->Fill(trackPhi);
+                histos.get<TH1>(HIST("MC/PID/etahist_tpcits_piplus"))->Fill(trackEta);
               } else {
                 histos.get<TH1>(HIST("MC/PID/pthist_tpcits_piminus"))->Fill(trackPt);
-                histos.get<TH1>(HIST("MC/PID/phihist_tpcits_piminus"))->Fill(track.phi());
-                histos.get<TH1>(HIST("MC/PID/etahist_tpcits_piminus"))->Fill(track.eta());
+                histos.get<TH1>(HIST("MC/PID/phihist_tpcits_piminus"))->Fill(trackPhi);
+                histos.get<TH1>(HIST("MC/PID/etahist_tpcits_piminus"))->Fill(trackEta);
               }
             } //  end if ITS
           }   //  end if TPC
           //
           // only primary pions
           if (mcpart.isPhysicalPrimary()) {
-            if (trkWTPC && isTrackSelectedTPCCuts(track)) {
+            if (trkWTPC && isTPCCutsSelected) {
               histos.get<TH1>(HIST("MC/PID/pthist_tpc_pi_prim"))->Fill(trackPt);
-              histos.get<TH1>(HIST("MC/PID/phihist_tpc_pi_prim"))->Fill(track.phi());
-              histos.get<TH1>(HIST("MC/PID/etahist_tpc_pi_prim"))->Fill(track.eta());
-              if (trkWITS && isTrackSelectedITSCuts(track)) {
+              histos.get<TH1>(HIST("MC/PID/phihist_tpc_pi_prim"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("MC/PID/etahist_tpc_pi_prim"))->Fill(trackEta);
+              if (trkWITS && isITSCutsSelected) {
                 histos.get<TH1>(HIST("MC/PID/pthist_tpcits_pi_prim"))->Fill(trackPt);
-                histos.get<TH1>(HIST("MC/PID/phihist_tpcits_pi_prim"))->Fill(track.phi());
-                histos.get<TH1>(HIST("MC/PID/etahist_tpcits_pi_prim"))->Fill(track.eta());
+                histos.get<TH1>(HIST("MC/PID/phihist_tpcits_pi_prim"))->Fill(trackPhi);
+                histos.get<TH1>(HIST("MC/PID/etahist_tpcits_pi_prim"))->Fill(trackEta);
               } //  end if ITS
             }   //  end if TPC
             //  end if primaries
           } else if (mcpart.getProcess() == 4) {
             //
             // only secondary pions from decay
-            if (trkWTPC && isTrackSelectedTPCCuts(track)) {
+            if (trkWTPC && isTPCCutsSelected) {
               histos.get<TH1>(HIST("MC/PID/pthist_tpc_pi_secd"))->Fill(trackPt);
-              histos.get<TH1>(HIST("MC/PID/phihist_tpc_pi_secd"))->Fill(track.phi());
-              histos.get<TH1>(HIST("MC/PID/etahist_tpc_pi_secd"))->Fill(track.eta());
-              if (trkWITS && isTrackSelectedITSCuts(track)) {
+              histos.get<TH1>(HIST("MC/PID/phihist_tpc_pi_secd"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("MC/PID/etahist_tpc_pi_secd"))->Fill(trackEta);
+              if (trkWITS && isITSCutsSelected) {
                 histos.get<TH1>(HIST("MC/PID/pthist_tpcits_pi_secd"))->Fill(trackPt);
-                histos.get<TH1>(HIST("MC/PID/phihist_tpcits_pi_secd"))->Fill(track.phi());
-                histos.get<TH1>(HIST("MC/PID/etahist_tpcits_pi_secd"))->Fill(track.eta());
+                histos.get<TH1>(HIST("MC/PID/phihist_tpcits_pi_secd"))->Fill(trackPhi);
+                histos.get<TH1>(HIST("MC/PID/etahist_tpcits_pi_secd"))->Fill(trackEta);
               } //  end if ITS
             }   //  end if TPC
             // end if secondaries from decay
           } else {
             //
             // only secondary pions from material
-            if (trkWTPC && isTrackSelectedTPCCuts(track)) {
+            if (trkWTPC && isTPCCutsSelected) {
               histos.get<TH1>(HIST("MC/PID/pthist_tpc_pi_secm"))->Fill(trackPt);
-              histos.get<TH1>(HIST("MC/PID/phihist_tpc_pi_secm"))->Fill(track.phi());
-              histos.get<TH1>(HIST("MC/PID/etahist_tpc_pi_secm"))->Fill(track.eta());
-              if (trkWITS && isTrackSelectedITSCuts(track)) {
+              histos.get<TH1>(HIST("MC/PID/phihist_tpc_pi_secm"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("MC/PID/etahist_tpc_pi_secm"))->Fill(trackEta);
+              if (trkWITS && isITSCutsSelected) {
                 histos.get<TH1>(HIST("MC/PID/pthist_tpcits_pi_secm"))->Fill(trackPt);
-                histos.get<TH1>(HIST("MC/PID/phihist_tpcits_pi_secm"))->Fill(track.phi());
-                histos.get<TH1>(HIST("MC/PID/etahist_tpcits_pi_secm"))->Fill(track.eta());
+                histos.get<TH1>(HIST("MC/PID/phihist_tpcits_pi_secm"))->Fill(trackPhi);
+                histos.get<TH1>(HIST("MC/PID/etahist_tpcits_pi_secm"))->Fill(trackEta);
               } //  end if ITS
             }   //  end if TPC
           }     // end if secondaries from material  //
@@ -3037,15 +3056,15 @@ struct qaMatchEff {
           else
             pdg_fill = -10.0;
           //
-          if (trkWTPC && isTrackSelectedTPCCuts(track)) {
+          if (trkWTPC && isTPCCutsSelected) {
             histos.get<TH1>(HIST("MC/PID/pthist_tpc_nopi"))->Fill(trackPt);
-            histos.get<TH1>(HIST("MC/PID/phihist_tpc_nopi"))->Fill(track.phi());
-            histos.get<TH1>(HIST("MC/PID/etahist_tpc_nopi"))->Fill(track.eta());
+            histos.get<TH1>(HIST("MC/PID/phihist_tpc_nopi"))->Fill(trackPhi);
+            histos.get<TH1>(HIST("MC/PID/etahist_tpc_nopi"))->Fill(trackEta);
             histos.get<TH1>(HIST("MC/PID/pdghist_den"))->Fill(pdg_fill);
-            if (trkWITS && isTrackSelectedITSCuts(track)) {
+            if (trkWITS && isITSCutsSelected) {
               histos.get<TH1>(HIST("MC/PID/pthist_tpcits_nopi"))->Fill(trackPt);
-              histos.get<TH1>(HIST("MC/PID/phihist_tpcits_nopi"))->Fill(track.phi());
-              histos.get<TH1>(HIST("MC/PID/etahist_tpcits_nopi"))->Fill(track.eta());
+              histos.get<TH1>(HIST("MC/PID/phihist_tpcits_nopi"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("MC/PID/etahist_tpcits_nopi"))->Fill(trackEta);
               histos.get<TH1>(HIST("MC/PID/pdghist_num"))->Fill(pdg_fill);
             } //  end if ITS
           }   //  end if TPC
@@ -3053,7 +3072,7 @@ struct qaMatchEff {
         //
         // kaons only
         if (tpPDGCode == 321) {
-          if (trkWTPC && isTrackSelectedTPCCuts(track)) {
+          if (trkWTPC && isTPCCutsSelected) {
             //
             // TPC clusters
             histos.get<TH1>(HIST("MC/TPCclust/tpcNClsFound_kaMC_tpc"))->Fill(clustpc);
@@ -3073,18 +3092,18 @@ struct qaMatchEff {
             // histos.get<TH1>(HIST("MC/PID/xyDCA_tpc_ka"))->Fill(track.dcaXY());
             //
             histos.get<TH1>(HIST("MC/PID/pthist_tpc_ka"))->Fill(trackPt);
-            histos.get<TH1>(HIST("MC/PID/phihist_tpc_ka"))->Fill(track.phi());
-            histos.get<TH1>(HIST("MC/PID/etahist_tpc_ka"))->Fill(track.eta());
+            histos.get<TH1>(HIST("MC/PID/phihist_tpc_ka"))->Fill(trackPhi);
+            histos.get<TH1>(HIST("MC/PID/etahist_tpc_ka"))->Fill(trackEta);
             if (signOfTrack > 0) {
               histos.get<TH1>(HIST("MC/PID/pthist_tpc_kaplus"))->Fill(trackPt);
-              histos.get<TH1>(HIST("MC/PID/phihist_tpc_kaplus"))->Fill(track.phi());
-              histos.get<TH1>(HIST("MC/PID/etahist_tpc_kaplus"))->Fill(track.eta());
+              histos.get<TH1>(HIST("MC/PID/phihist_tpc_kaplus"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("MC/PID/etahist_tpc_kaplus"))->Fill(trackEta);
             } else {
               histos.get<TH1>(HIST("MC/PID/pthist_tpc_kaminus"))->Fill(trackPt);
-              histos.get<TH1>(HIST("MC/PID/phihist_tpc_kaminus"))->Fill(track.phi());
-              histos.get<TH1>(HIST("MC/PID/etahist_tpc_kaminus"))->Fill(track.eta());
+              histos.get<TH1>(HIST("MC/PID/phihist_tpc_kaminus"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("MC/PID/etahist_tpc_kaminus"))->Fill(trackEta);
             }
-            if (trkWITS && isTrackSelectedITSCuts(track)) {
+            if (trkWITS && isITSCutsSelected) {
               //
               // TPC clusters
               histos.get<TH1>(HIST("MC/TPCclust/tpcNClsFound_kaMC_tpcits"))->Fill(clustpc);
@@ -3104,16 +3123,16 @@ struct qaMatchEff {
               // histos.get<TH1>(HIST("MC/PID/xyDCA_tpcits_ka"))->Fill(track.dcaXY());
               //
               histos.get<TH1>(HIST("MC/PID/pthist_tpcits_ka"))->Fill(trackPt);
-              histos.get<TH1>(HIST("MC/PID/phihist_tpcits_ka"))->Fill(track.phi());
-              histos.get<TH1>(HIST("MC/PID/etahist_tpcits_ka"))->Fill(track.eta());
+              histos.get<TH1>(HIST("MC/PID/phihist_tpcits_ka"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("MC/PID/etahist_tpcits_ka"))->Fill(trackEta);
               if (signOfTrack > 0) {
                 histos.get<TH1>(HIST("MC/PID/pthist_tpcits_kaplus"))->Fill(trackPt);
-                histos.get<TH1>(HIST("MC/PID/phihist_tpcits_kaplus"))->Fill(track.phi());
-                histos.get<TH1>(HIST("MC/PID/etahist_tpcits_kaplus"))->Fill(track.eta());
+                histos.get<TH1>(HIST("MC/PID/phihist_tpcits_kaplus"))->Fill(trackPhi);
+                histos.get<TH1>(HIST("MC/PID/etahist_tpcits_kaplus"))->Fill(trackEta);
               } else {
                 histos.get<TH1>(HIST("MC/PID/pthist_tpcits_kaminus"))->Fill(trackPt);
-                histos.get<TH1>(HIST("MC/PID/phihist_tpcits_kaminus"))->Fill(track.phi());
-                histos.get<TH1>(HIST("MC/PID/etahist_tpcits_kaminus"))->Fill(track.eta());
+                histos.get<TH1>(HIST("MC/PID/phihist_tpcits_kaminus"))->Fill(trackPhi);
+                histos.get<TH1>(HIST("MC/PID/etahist_tpcits_kaminus"))->Fill(trackEta);
               }
             } //  end if ITS
           }   //  end if TPC
@@ -3121,14 +3140,14 @@ struct qaMatchEff {
         //
         // pions and kaons together
         if (tpPDGCode == 211 || tpPDGCode == 321) {
-          if (trkWTPC && isTrackSelectedTPCCuts(track)) {
+          if (trkWTPC && isTPCCutsSelected) {
             histos.get<TH1>(HIST("MC/PID/pthist_tpc_piK"))->Fill(trackPt);
-            histos.get<TH1>(HIST("MC/PID/phihist_tpc_piK"))->Fill(track.phi());
-            histos.get<TH1>(HIST("MC/PID/etahist_tpc_piK"))->Fill(track.eta());
-            if (trkWITS && isTrackSelectedITSCuts(track)) {
+            histos.get<TH1>(HIST("MC/PID/phihist_tpc_piK"))->Fill(trackPhi);
+            histos.get<TH1>(HIST("MC/PID/etahist_tpc_piK"))->Fill(trackEta);
+            if (trkWITS && isITSCutsSelected) {
               histos.get<TH1>(HIST("MC/PID/pthist_tpcits_piK"))->Fill(trackPt);
-              histos.get<TH1>(HIST("MC/PID/phihist_tpcits_piK"))->Fill(track.phi());
-              histos.get<TH1>(HIST("MC/PID/etahist_tpcits_piK"))->Fill(track.eta());
+              histos.get<TH1>(HIST("MC/PID/phihist_tpcits_piK"))->Fill(trackPhi);
+              histos.get<TH1>(HIST("MC/PID/etahist_tpcits_piK"))->Fill(trackEta);
             } //  end if ITS
           }   //  end if TPC
         }
@@ -76,7 +76,8 @@ struct QaPrimVtxVsTime {
       double minSec = floor(tsSOR / 1000.); /// round tsSOR to the highest integer lower than tsSOR
       double maxSec = ceil(tsEOR / 1000.);  /// round tsEOR to the lowest integer higher than tsEOR
       const AxisSpec axisSeconds{static_cast<int>(maxSec - minSec), minSec, maxSec, "seconds (from January 1st, 1970 at UTC)"};
-      histos.add("hPosZvsTime", "", kTH2F, {axisSeconds, axisVertexPosZ});
+      /// one bin per second of the run: sparse, such that only the bins of the seconds with collisions in the processed DFs are allocated
+      histos.add("hPosZvsTime", "", kTHnSparseF, {axisSeconds, axisVertexPosZ});
     }
 
     /// The rest of the code is always run
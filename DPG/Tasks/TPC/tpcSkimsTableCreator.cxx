@@ -19,6 +19,8 @@
 #include "tpcSkimsTableCreator.h"
 #include <CCDB/BasicCCDBManager.h>
 #include <cmath>
+#include <map>
+#include <utility>
 /// ROOT
 #include "TRandom3.h"
 /// O2
@@ -129,13 +131,18 @@ struct TreeWriterTpcV0 {
   /// Random downsampling trigger function using Tsalis/Hagedorn spectra fit (sqrt(s) = 62.4 GeV to 13 TeV)
   /// as in https://iopscience.iop.org/article/10.1088/2399-6528/aab00f/pdf
   TRandom3* fRndm = new TRandom3(0);
+  std::map<std::pair<double, double>, double> tsalisNorms; // normalisation at pt = 1 GeV/c per (mass, sqrt(s))
   bool downsampleTsalisCharged(double pt, double factor1Pt, double sqrts, double mass)
   {
     if (factor1Pt < 0.) {
       return true;
     }
     const double prob = tsalisCharged(pt, mass, sqrts) * pt;
-    const double probNorm = tsalisCharged(1., mass, sqrts);
+    auto norm = tsalisNorms.find({mass, sqrts});
+    if (norm == tsalisNorms.end()) {
+      norm = tsalisNorms.emplace(std::make_pair(mass, sqrts), tsalisCharged(1., mass, sqrts)).first;
+    }
+    const double probNorm = norm->second;
     if ((fRndm->Rndm() * ((prob / probNorm) * pt * pt)) > factor1Pt) {
       return false;
     } else {
@@ -294,13 +301,18 @@ struct TreeWriterTPCTOF {
   /// Random downsampling trigger function using Tsalis/Hagedorn spectra fit (sqrt(s) = 62.4 GeV to 13 TeV)
   /// as in https://iopscience.iop.org/article/10.1088/2399-6528/aab00f/pdf
   TRandom3* fRndm = new TRandom3(0);
+  std::map<std::pair<double, double>, double> tsalisNorms; // normalisation at pt = 1 GeV/c per (mass, sqrt(s))
   bool downsampleTsalisCharged(double pt, float factor1Pt, double sqrts, double mass)
   {
     if (factor1Pt < 0.) {
       return true;
     }
     const double prob = tsalisCharged(pt, mass, sqrts) * pt;
-    const double probNorm = tsalisCharged(1., mass, sqrts);
+    auto norm = tsalisNorms.find({mass, sqrts});
+    if (norm == tsalisNorms.end()) {
+      norm = tsalisNorms.emplace(std::make_pair(mass, sqrts), tsalisCharged(1., mass, sqrts)).first;
+    }
+    const double probNorm = norm->second;
     if ((fRndm->Rndm() * ((prob / probNorm) * pt * pt)) > factor1Pt) {
       return false;
     } else {
@@ -1199,19 +1199,18 @@ struct CFFilter {
     return 0.5 * trackRelK.P();
   }
 
-  ROOT::Math::PxPyPzEVector getqij(const ROOT::Math::PtEtaPhiMVector parti,
-                                   const ROOT::Math::PtEtaPhiMVector partj)
+  ROOT::Math::PxPyPzEVector getqij(const ROOT::Math::PxPyPzEVector& vecparti,
+                                   const ROOT::Math::PxPyPzEVector& vecpartj)
   {
-    ROOT::Math::PxPyPzEVector vecparti(parti);
-    ROOT::Math::PxPyPzEVector vecpartj(partj);
     ROOT::Math::PxPyPzEVector trackSum = vecparti + vecpartj;
     ROOT::Math::PxPyPzEVector trackDifference = vecparti - vecpartj;
     float scaling = trackDifference.Dot(trackSum) / trackSum.Dot(trackSum);
     return trackDifference - scaling * trackSum;
   }
-  float getQ3(const ROOT::Math::PtEtaPhiMVector part1,
-              const ROOT::Math::PtEtaPhiMVector part2,
-              const ROOT::Math::PtEtaPhiMVector part3)
+  /// Q3 of a triplet, from the cartesian four-momenta of the particles, which are converted once per candidate
+  float getQ3(const ROOT::Math::PxPyPzEVector& part1,
+              const ROOT::Math::PxPyPzEVector& part2,
+              const ROOT::Math::PxPyPzEVector& part3)
   {
     ROOT::Math::PxPyPzEVector q12 = getqij(part1, part2);
     ROOT::Math::PxPyPzEVector q23 = getqij(part2, part3);
@@ -1627,6 +1626,12 @@ struct CFFilter {
         }
       }
 
+      // cartesian four-momenta of the candidates, for the Q3 of all their triplets
+      const std::vector<ROOT::Math::PxPyPzEVector> protonsPxPyPzE(protons.begin(), protons.end());
+      const std::vector<ROOT::Math::PxPyPzEVector> antiprotonsPxPyPzE(antiprotons.begin(), antiprotons.end());
+      const std::vector<ROOT::Math::PxPyPzEVector> lambdasPxPyPzE(lambdas.begin(), lambdas.end());
+      const std::vector<ROOT::Math::PxPyPzEVector> antilambdasPxPyPzE(antilambdas.begin(), antilambdas.end());
+
       float Q3 = 999.f, kstar = 999.f;
       if (ConfTriggerSwitches->get("Switch", "ppp") > 0.) {
         // ppp trigger
@@ -1635,7 +1640,7 @@ struct CFFilter {
           for (; iProton2 != protons.end(); ++iProton2) {
             auto iProton3 = iProton2 + 1;
             for (; iProton3 != protons.end(); ++iProton3) {
-              Q3 = getQ3(*iProton1, *iProton2, *iProton3);
+              Q3 = getQ3(protonsPxPyPzE[std::distance(protons.begin(), iProton1)], protonsPxPyPzE[std::distance(protons.begin(), iProton2)], protonsPxPyPzE[std::distance(protons.begin(), iProton3)]);
               registry.fill(HIST("ppp/fSE_particle"), Q3);
               registry.fill(HIST("ppp/fProtonPtVsQ3"), Q3, (*iProton1).Pt());
               registry.fill(HIST("ppp/fProtonPtVsQ3"), Q3, (*iProton2).Pt());
@@ -1658,7 +1663,7 @@ struct CFFilter {
           for (; iAntiProton2 != antiprotons.end(); ++iAntiProton2) {
             auto iAntiProton3 = iAntiProton2 + 1;
             for (; iAntiProton3 != antiprotons.end(); ++iAntiProton3) {
-              Q3 = getQ3(*iAntiProton1, *iAntiProton2, *iAntiProton3);
+              Q3 = getQ3(antiprotonsPxPyPzE[std::distance(antiprotons.begin(), iAntiProton1)], antiprotonsPxPyPzE[std::distance(antiprotons.begin(), iAntiProton2)], antiprotonsPxPyPzE[std::distance(antiprotons.begin(), iAntiProton3)]);
               registry.fill(HIST("ppp/fSE_antiparticle"), Q3);
               registry.fill(HIST("ppp/fAntiProtonPtVsQ3"), Q3, (*iAntiProton1).Pt());
               registry.fill(HIST("ppp/fAntiProtonPtVsQ3"), Q3, (*iAntiProton2).Pt());
@@ -1691,7 +1696,7 @@ struct CFFilter {
                    ProtonIndex.at(i2) == LambdaPosDaughIndex.at(i3))) {
                 continue;
               }
-              Q3 = getQ3(*iProton1, *iProton2, *iLambda1);
+              Q3 = getQ3(protonsPxPyPzE[i1], protonsPxPyPzE[i2], lambdasPxPyPzE[i3]);
               registry.fill(HIST("ppl/fSE_particle"), Q3);
               registry.fill(HIST("ppl/fProtonPtVsQ3"), Q3, (*iProton1).Pt());
               registry.fill(HIST("ppl/fProtonPtVsQ3"), Q3, (*iProton2).Pt());
@@ -1721,7 +1726,7 @@ struct CFFilter {
                    AntiProtonIndex.at(i2) == AntiLambdaNegDaughIndex.at(i3))) {
                 continue;
               }
-              Q3 = getQ3(*iAntiProton1, *iAntiProton2, *iAntiLambda1);
+              Q3 = getQ3(antiprotonsPxPyPzE[i1], antiprotonsPxPyPzE[i2], antilambdasPxPyPzE[i3]);
               registry.fill(HIST("ppl/fSE_antiparticle"), Q3);
               registry.fill(HIST("ppl/fAntiProtonPtVsQ3"), Q3, (*iAntiProton1).Pt());
               registry.fill(HIST("ppl/fAntiProtonPtVsQ3"), Q3, (*iAntiProton2).Pt());
@@ -1759,7 +1764,7 @@ struct CFFilter {
                    LambdaPosDaughIndex.at(i2) == ProtonIndex.at(i3))) {
                 continue;
               }
-              Q3 = getQ3(*iLambda1, *iLambda2, *iProton1);
+              Q3 = getQ3(lambdasPxPyPzE[i1], lambdasPxPyPzE[i2], protonsPxPyPzE[i3]);
               registry.fill(HIST("pll/fSE_particle"), Q3);
               registry.fill(HIST("pll/fProtonPtVsQ3"), Q3, (*iProton1).Pt());
               registry.fill(HIST("pll/fLambdaPtVsQ3"), Q3, (*iLambda1).Pt());
@@ -1794,7 +1799,7 @@ struct CFFilter {
                    AntiLambdaNegDaughIndex.at(i2) == AntiProtonIndex.at(i3))) {
                 continue;
               }
-              Q3 = getQ3(*iAntiLambda1, *iAntiLambda2, *iAntiProton1);
+              Q3 = getQ3(antilambdasPxPyPzE[i1], antilambdasPxPyPzE[i2], antiprotonsPxPyPzE[i3]);
               registry.fill(HIST("pll/fSE_antiparticle"), Q3);
               registry.fill(HIST("pll/fAntiProtonPtVsQ3"), Q3, (*iAntiProton1).Pt());
               registry.fill(HIST("pll/fAntiLambdaPtVsQ3"), Q3, (*iAntiLambda1).Pt());
@@ -1835,7 +1840,7 @@ struct CFFilter {
                    LambdaNegDaughIndex.at(i2) == LambdaNegDaughIndex.at(i3))) {
                 continue;
               }
-              Q3 = getQ3(*iLambda1, *iLambda2, *iLambda3);
+              Q3 = getQ3(lambdasPxPyPzE[i1], lambdasPxPyPzE[i2], lambdasPxPyPzE[i3]);
               registry.fill(HIST("lll/fSE_particle"), Q3);
               registry.fill(HIST("lll/fLambdaPtVsQ3"), Q3, (*iLambda1).Pt());
               registry.fill(HIST("lll/fLambdaPtVsQ3"), Q3, (*iLambda2).Pt());
@@ -1873,7 +1878,7 @@ struct CFFilter {
                    AntiLambdaNegDaughIndex.at(i2) == AntiLambdaNegDaughIndex.at(i3))) {
                 continue;
               }
-              Q3 = getQ3(*iAntiLambda1, *iAntiLambda2, *iAntiLambda3);
+              Q3 = getQ3(antilambdasPxPyPzE[i1], antilambdasPxPyPzE[i2], antilambdasPxPyPzE[i3]);
               registry.fill(HIST("lll/fSE_antiparticle"), Q3);
               registry.fill(HIST("lll/fAntiLambdaPtVsQ3"), Q3, (*iAntiLambda1).Pt());
               registry.fill(HIST("lll/fAntiLambdaPtVsQ3"), Q3, (*iAntiLambda2).Pt());
@@ -19,6 +19,10 @@
 /// \author Biao Zhang <biao.zhang@cern.ch>, CCNU
 /// \author Federica Zanone <federica.zanone@cern.ch>, Heidelberg University
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
 #include "CommonConstants/PhysicsConstants.h"
 #include "CCDB/BasicCCDBManager.h"
 #include "DataFormatsParameters/GRPMagField.h"
@@ -154,6 +158,10 @@ struct HfFilter { // Main struct for HF triggers
   // helper object
   HfFilterHelper helper;
 
+  // track quantities and selections of the tracks associated to the current collision, see preselectTracks
+  std::vector<HfFilterTrack> preselTracks{};
+  std::vector<int> preselTracksPtOrder{}; // positions in preselTracks sorted by decreasing pT
+
   void init(InitContext&)
   {
     helper.setHighPtTriggerThresholds(ptThresholds->get(0u, 0u), ptThresholds->get(0u, 1u));
@@ -274,6 +282,48 @@ struct HfFilter { // Main struct for HF triggers
   Preslice<aod::CascDatas> cascPerCollision = aod::cascdata::collisionId;
   Preslice<aod::V0PhotonsKF> photonsPerCollision = aod::v0photonkf::collisionId;
 
+  /// Computes the track quantities at the collision and the track-level selections once per collision,
+  /// instead of once per candidate and per trigger in the candidate loops
+  /// \param trackIds are the indices of the tracks associated to the collision
+  /// \param collision is the collision
+  template <typename TTrackIds, typename TColl>
+  void preselectTracks(TTrackIds const& trackIds, TColl const& collision)
+  {
+    auto thisCollId = collision.globalIndex();
+    preselTracks.clear();
+    preselTracks.reserve(trackIds.size());
+    for (const auto& trackId : trackIds) {
+      auto track = trackId.template track_as<BigTracksPID>();
+      auto& presel = preselTracks.emplace_back();
+      presel.globalIndex = track.globalIndex();
+      presel.sign = track.sign();
+      presel.tpcNSigmaPr = track.tpcNSigmaPr();
+      presel.tofNSigmaPr = track.tofNSigmaPr();
+      presel.trackPar = getTrackPar(track);
+      presel.dca = {track.dcaXY(), track.dcaZ()};
+      presel.pVec = track.pVector();
+      if (track.collisionId() != thisCollId) {
+        o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, presel.trackPar, 2.f, noMatCorr, &presel.dca);
+        getPxPyPz(presel.trackPar, presel.pVec);
+      } else {
+        SETBIT(presel.tags, kTagSameCollision);
+      }
+      presel.pt = presel.trackPar.getPt();
+      presel.selBeauty3P = helper.isSelectedTrackForSoftPionOrBeauty(track, presel.trackPar, presel.dca, kBeauty3P);
+      presel.selBeauty4P = helper.isSelectedTrackForSoftPionOrBeauty(track, presel.trackPar, presel.dca, kBeauty4P);
+      presel.selSoftPionForSigmaC = helper.isSelectedTrackForSoftPionOrBeauty(track, presel.trackPar, presel.dca, kSigmaCPPK);
+      if (helper.isSelectedProton4Femto(track, presel.trackPar, activateQA, hProtonTPCPID, hProtonTOFPID, forceTofPidForFemto)) {
+        SETBIT(presel.tags, kTagProtonForFemto);
+      }
+      if (helper.isSelectedKaonFromXicResoToSigmaC<true>(track)) {
+        SETBIT(presel.tags, kTagKaonFromXicResoToSigmaC);
+      }
+    }
+    preselTracksPtOrder.resize(preselTracks.size());
+    std::iota(preselTracksPtOrder.begin(), preselTracksPtOrder.end(), 0);
+    std::sort(preselTracksPtOrder.begin(), preselTracksPtOrder.end(), [this](int first, int second) { return preselTracks[first].pt > preselTracks[second].pt; });
+  }
+
   void process(CollsWithEvSel const& collisions,
                aod::BCsWithTimestamps const&,
                aod::V0Datas const& v0s,
@@ -324,6 +374,11 @@ struct HfFilter { // Main struct for HF triggers
       std::vector<std::vector<int64_t>> indicesDau2Prong{};
 
       auto cand2ProngsThisColl = cand2Prongs.sliceBy(hf2ProngPerCollision, thisCollId);
+      auto cand3ProngsThisColl = cand3Prongs.sliceBy(hf3ProngPerCollision, thisCollId);
+      if (cand2ProngsThisColl.size() > 0 || cand3ProngsThisColl.size() > 0) { // the tracks are only paired with charm candidates
+        preselectTracks(trackIndices.sliceBy(trackIndicesPerCollision, thisCollId), collision);
+      }
+
       for (const auto& cand2Prong : cand2ProngsThisColl) {                                // start loop over 2 prongs
         if (!TESTBIT(cand2Prong.hfflag(), o2::aod::hf_cand_2prong::DecayType::D0ToPiK)) { // check if it's a D0
           continue;
@@ -400,25 +455,17 @@ struct HfFilter { // Main struct for HF triggers
         auto massD0Cand = RecoDecay::m(std::array{pVecPos, pVecNeg}, std::array{massPi, massKa});
         auto massD0BarCand = RecoDecay::m(std::array{pVecPos, pVecNeg}, std::array{massKa, massPi});
 
-        auto trackIdsThisCollision = trackIndices.sliceBy(trackIndicesPerCollision, thisCollId);
-        for (const auto& trackId : trackIdsThisCollision) { // start loop over tracks
-          auto track = trackId.track_as<BigTracksPID>();
-
-          if (track.globalIndex() == trackPos.globalIndex() || track.globalIndex() == trackNeg.globalIndex()) {
+        for (const auto& track : preselTracks) { // start loop over tracks
+          if (track.globalIndex == trackPos.globalIndex() || track.globalIndex == trackNeg.globalIndex()) {
             continue;
           }
 
-          auto trackParThird = getTrackPar(track);
-          o2::gpu::gpustd::array<float, 2> dcaThird{track.dcaXY(), track.dcaZ()};
-          std::array<float, 3> pVecThird = track.pVector();
-          if (track.collisionId() != thisCollId) {
-            o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParThird, 2.f, noMatCorr, &dcaThird);
-            getPxPyPz(trackParThird, pVecThird);
-          }
+          const auto& dcaThird = track.dca;
+          const auto& pVecThird = track.pVec;
 
           if (!keepEvent[kBeauty3P] && isBeautyTagged) {
-            auto isTrackSelected = helper.isSelectedTrackForSoftPionOrBeauty(track, trackParThird, dcaThird, kBeauty3P);
-            if (isTrackSelected && ((TESTBIT(selD0, 0) && track.sign() > 0) || (TESTBIT(selD0, 1) && track.sign() < 0))) {
+            auto isTrackSelected = track.selBeauty3P;
+            if (isTrackSelected && ((TESTBIT(selD0, 0) && track.sign > 0) || (TESTBIT(selD0, 1) && track.sign < 0))) {
               auto massCand = RecoDecay::m(std::array{pVec2Prong, pVecThird}, std::array{massD0, massPi});
               auto pVecBeauty3Prong = RecoDecay::pVec(pVec2Prong, pVecThird);
               auto ptCand = RecoDecay::pt(pVecBeauty3Prong);
@@ -434,7 +481,7 @@ struct HfFilter { // Main struct for HF triggers
               } else if (TESTBIT(isTrackSelected, kSoftPionForBeauty)) {
                 std::array<float, 2> massDausD0{massPi, massKa};
                 auto massD0dau = massD0Cand;
-                if (track.sign() < 0) {
+                if (track.sign < 0) {
                   massDausD0[0] = massKa;
                   massDausD0[1] = massPi;
                   massD0dau = massD0BarCand;
@@ -445,21 +492,19 @@ struct HfFilter { // Main struct for HF triggers
                   if (activateQA) {
                     hMassVsPtC[kNCharmParticles]->Fill(ptCand, massDiffDstar);
                   }
-                  for (const auto& trackIdB : trackIdsThisCollision) { // start loop over tracks
-                    auto trackB = trackIdB.track_as<BigTracksPID>();
-                    if (track.globalIndex() == trackB.globalIndex()) {
-                      continue;
+                  for (const auto& iTrackB : preselTracksPtOrder) { // start loop over tracks, sorted by decreasing pT
+                    const auto& trackB = preselTracks[iTrackB];
+                    if (trackB.pt < helper.getPtMinBeautyBachelor()) {
+                      break; // no further track can be selected for beauty
                     }
-                    auto trackParFourth = getTrackPar(trackB);
-                    o2::gpu::gpustd::array<float, 2> dcaFourth{trackB.dcaXY(), trackB.dcaZ()};
-                    std::array<float, 3> pVecFourth = trackB.pVector();
-                    if (trackB.collisionId() != thisCollId) {
-                      o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParFourth, 2.f, noMatCorr, &dcaFourth);
-                      getPxPyPz(trackParFourth, pVecFourth);
+                    if (track.globalIndex == trackB.globalIndex) {
+                      continue;
                     }
+                    const auto& dcaFourth = trackB.dca;
+                    const auto& pVecFourth = trackB.pVec;
 
-                    auto isTrackFourthSelected = helper.isSelectedTrackForSoftPionOrBeauty(trackB, trackParFourth, dcaFourth, kBeauty3P);
-                    if (track.sign() * trackB.sign() < 0 && TESTBIT(isTrackFourthSelected, kForBeauty)) {
+                    auto isTrackFourthSelected = trackB.selBeauty3P;
+                    if (track.sign * trackB.sign < 0 && TESTBIT(isTrackFourthSelected, kForBeauty)) {
                       auto massCandB0 = RecoDecay::m(std::array{pVecBeauty3Prong, pVecFourth}, std::array{massDStar, massPi});
                       if (std::fabs(massCandB0 - massB0) <= deltaMassBeauty->get(0u, 2u)) {
                         keepEvent[kBeauty3P] = true;
@@ -481,12 +526,12 @@ struct HfFilter { // Main struct for HF triggers
           } // end beauty selection
 
           // 2-prong femto
-          if (!keepEvent[kFemto2P] && enableFemtoChannels->get(0u, 0u) && isCharmTagged && track.collisionId() == thisCollId && (TESTBIT(selD0, 0) || TESTBIT(selD0, 1) || !requireCharmMassForFemto)) {
-            bool isProton = helper.isSelectedProton4Femto(track, trackParThird, activateQA, hProtonTPCPID, hProtonTOFPID, forceTofPidForFemto);
+          if (!keepEvent[kFemto2P] && enableFemtoChannels->get(0u, 0u) && isCharmTagged && TESTBIT(track.tags, kTagSameCollision) && (TESTBIT(selD0, 0) || TESTBIT(selD0, 1) || !requireCharmMassForFemto)) {
+            bool isProton = TESTBIT(track.tags, kTagProtonForFemto);
             if (isProton) {
               float relativeMomentum = helper.computeRelativeMomentum(pVecThird, pVec2Prong, massD0);
               if (applyOptimisation) {
-                optimisationTreeFemto(thisCollId, o2::constants::physics::Pdg::kD0, pt2Prong, scores[0], scores[1], scores[2], relativeMomentum, track.tpcNSigmaPr(), track.tofNSigmaPr());
+                optimisationTreeFemto(thisCollId, o2::constants::physics::Pdg::kD0, pt2Prong, scores[0], scores[1], scores[2], relativeMomentum, track.tpcNSigmaPr, track.tofNSigmaPr);
               }
               if (relativeMomentum < femtoMaxRelativeMomentum) {
                 keepEvent[kFemto2P] = true;
@@ -573,25 +618,18 @@ struct HfFilter { // Main struct for HF triggers
               getPxPyPz(trackParK0, pVecV0);
 
               // we first look for a D*+
-              for (const auto& trackBachelorId : trackIdsThisCollision) { // start loop over tracks
-                auto trackBachelor = trackBachelorId.track_as<BigTracksPID>();
-                if (trackBachelor.globalIndex() == trackPos.globalIndex() || trackBachelor.globalIndex() == trackNeg.globalIndex()) {
+              for (const auto& trackBachelor : preselTracks) { // start loop over tracks
+                if (trackBachelor.globalIndex == trackPos.globalIndex() || trackBachelor.globalIndex == trackNeg.globalIndex()) {
                   continue;
                 }
 
-                auto trackParBachelor = getTrackPar(trackBachelor);
-                o2::gpu::gpustd::array<float, 2> dcaBachelor{trackBachelor.dcaXY(), trackBachelor.dcaZ()};
-                std::array<float, 3> pVecBachelor = trackBachelor.pVector();
-                if (trackBachelor.collisionId() != thisCollId) {
-                  o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParBachelor, 2.f, noMatCorr, &dcaBachelor);
-                  getPxPyPz(trackParBachelor, pVecBachelor);
-                }
+                const auto& pVecBachelor = trackBachelor.pVec;
 
-                int isTrackSelected = helper.isSelectedTrackForSoftPionOrBeauty(trackBachelor, trackParBachelor, dcaBachelor, -1);
-                if (TESTBIT(isTrackSelected, kSoftPion) && ((TESTBIT(selD0, 0) && trackBachelor.sign() > 0) || (TESTBIT(selD0, 1) && trackBachelor.sign() < 0))) {
+                int isTrackSelected = trackBachelor.selBeauty3P; // the soft-pion bit does not depend on the beauty DCA cuts
+                if (TESTBIT(isTrackSelected, kSoftPion) && ((TESTBIT(selD0, 0) && trackBachelor.sign > 0) || (TESTBIT(selD0, 1) && trackBachelor.sign < 0))) {
                   std::array<float, 2> massDausD0{massPi, massKa};
                   auto massD0dau = massD0Cand;
-                  if (trackBachelor.sign() < 0) {
+                  if (trackBachelor.sign < 0) {
                     massDausD0[0] = massKa;
                     massDausD0[1] = massPi;
                     massD0dau = massD0BarCand;
@@ -677,7 +715,6 @@ struct HfFilter { // Main struct for HF triggers
       } // end loop over 2-prong candidates
 
       std::vector<std::vector<int64_t>> indicesDau3Prong{};
-      auto cand3ProngsThisColl = cand3Prongs.sliceBy(hf3ProngPerCollision, thisCollId);
       for (const auto& cand3Prong : cand3ProngsThisColl) { // start loop over 3 prongs
         std::array<int8_t, kNCharmParticles - 1> is3Prong = {
           TESTBIT(cand3Prong.hfflag(), o2::aod::hf_cand_3prong::DecayType::DplusToPiKPi),
@@ -813,29 +850,21 @@ struct HfFilter { // Main struct for HF triggers
           }
         } // end high-pT selection
 
-        auto trackIdsThisCollision = trackIndices.sliceBy(trackIndicesPerCollision, thisCollId);
-
-        for (const auto& trackId : trackIdsThisCollision) { // start loop over track indices as associated to this collision in HF code
-          auto track = trackId.track_as<BigTracksPID>();
-          if (track.globalIndex() == trackFirst.globalIndex() || track.globalIndex() == trackSecond.globalIndex() || track.globalIndex() == trackThird.globalIndex()) {
+        for (const auto& track : preselTracks) { // start loop over tracks as associated to this collision in HF code
+          if (track.globalIndex == trackFirst.globalIndex() || track.globalIndex == trackSecond.globalIndex() || track.globalIndex == trackThird.globalIndex()) {
             continue;
           }
 
-          auto trackParFourth = getTrackPar(track);
-          o2::gpu::gpustd::array<float, 2> dcaFourth{track.dcaXY(), track.dcaZ()};
-          std::array<float, 3> pVecFourth = track.pVector();
-          if (track.collisionId() != thisCollId) {
-            o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParFourth, 2.f, noMatCorr, &dcaFourth);
-            getPxPyPz(trackParFourth, pVecFourth);
-          }
+          const auto& dcaFourth = track.dca;
+          const auto& pVecFourth = track.pVec;
 
           int charmParticleID[kNBeautyParticles - 2] = {o2::constants::physics::Pdg::kDPlus, o2::constants::physics::Pdg::kDS, o2::constants::physics::Pdg::kLambdaCPlus, o2::constants::physics::Pdg::kXiCPlus};
 
           float massCharmHypos[kNBeautyParticles - 2] = {massDPlus, massDs, massLc, massXic};
           float massBeautyHypos[kNBeautyParticles - 2] = {massB0, massBs, massLb, massXib};
           float deltaMassHypos[kNBeautyParticles - 2] = {deltaMassBeauty->get(0u, 1u), deltaMassBeauty->get(0u, 3u), deltaMassBeauty->get(0u, 4u), deltaMassBeauty->get(0u, 5u)};
-          auto isTrackSelected = helper.isSelectedTrackForSoftPionOrBeauty(track, trackParFourth, dcaFourth, kBeauty4P);
-          if (track.sign() * sign3Prong < 0 && TESTBIT(isTrackSelected, kForBeauty)) {
+          auto isTrackSelected = track.selBeauty4P;
+          if (track.sign * sign3Prong < 0 && TESTBIT(isTrackSelected, kForBeauty)) {
             for (int iHypo{0}; iHypo < kNBeautyParticles - 2 && !keepEvent[kBeauty4P]; ++iHypo) {
               if (isBeautyTagged[iHypo] && (TESTBIT(is3ProngInMass[iHypo], 0) || TESTBIT(is3ProngInMass[iHypo], 1))) {
                 auto massCandB = RecoDecay::m(std::array{pVec3Prong, pVecFourth}, std::array{massCharmHypos[iHypo], massPi});
@@ -855,13 +884,13 @@ struct HfFilter { // Main struct for HF triggers
           } // end beauty selection
 
           // 3-prong femto
-          bool isProton = helper.isSelectedProton4Femto(track, trackParFourth, activateQA, hProtonTPCPID, hProtonTOFPID, forceTofPidForFemto);
-          if (isProton && track.collisionId() == thisCollId) {
+          bool isProton = TESTBIT(track.tags, kTagProtonForFemto);
+          if (isProton && TESTBIT(track.tags, kTagSameCollision)) {
             for (int iHypo{0}; iHypo < kNCharmParticles - 1 && !keepEvent[kFemto3P]; ++iHypo) {
               if (isCharmTagged[iHypo] && enableFemtoChannels->get(0u, iHypo + 1) && (TESTBIT(is3ProngInMass[iHypo], 0) || TESTBIT(is3ProngInMass[iHypo], 1) || !requireCharmMassForFemto)) {
                 float relativeMomentum = helper.computeRelativeMomentum(pVecFourth, pVec3Prong, massCharmHypos[iHypo]);
                 if (applyOptimisation) {
-                  optimisationTreeFemto(thisCollId, charmParticleID[iHypo], pt3Prong, scores[iHypo][0], scores[iHypo][1], scores[iHypo][2], relativeMomentum, track.tpcNSigmaPr(), track.tofNSigmaPr());
+                  optimisationTreeFemto(thisCollId, charmParticleID[iHypo], pt3Prong, scores[iHypo][0], scores[iHypo][1], scores[iHypo][2], relativeMomentum, track.tpcNSigmaPr, track.tofNSigmaPr);
                 }
                 if (relativeMomentum < femtoMaxRelativeMomentum) {
                   keepEvent[kFemto3P] = true;
@@ -874,15 +903,18 @@ struct HfFilter { // Main struct for HF triggers
           } // end femto selection
 
           // SigmaC++ K- trigger
-          if (!keepEvent[kSigmaCPPK] && is3Prong[2] > 0 && is3ProngInMass[2] > 0 && isSignalTagged[2] > 0 && helper.isSelectedKaonFromXicResoToSigmaC<true>(track)) {
+          if (!keepEvent[kSigmaCPPK] && is3Prong[2] > 0 && is3ProngInMass[2] > 0 && isSignalTagged[2] > 0 && TESTBIT(track.tags, kTagKaonFromXicResoToSigmaC)) {
             // we need a candidate Lc->pKpi and a candidate soft kaon
 
             // look for SigmaC++ candidates
-            for (const auto& trackSoftPiId : trackIdsThisCollision) { // start loop over tracks (soft pi)
+            for (const auto& iTrackSoftPi : preselTracksPtOrder) { // start loop over tracks (soft pi), sorted by decreasing pT
 
               // soft pion candidates
-              auto trackSoftPi = trackSoftPiId.track_as<BigTracksPID>();
-              auto globalIndexSoftPi = trackSoftPi.globalIndex();
+              const auto& trackSoftPi = preselTracks[iTrackSoftPi];
+              if (trackSoftPi.pt < helper.getPtMinSoftPionForSigmaC()) {
+                break; // no further track can be selected as soft pion
+              }
+              auto globalIndexSoftPi = trackSoftPi.globalIndex;
 
               // exclude tracks already used to build the 3-prong candidate
               if (globalIndexSoftPi == trackFirst.globalIndex() || globalIndexSoftPi == trackSecond.globalIndex() || globalIndexSoftPi == trackThird.globalIndex()) {
@@ -891,28 +923,20 @@ struct HfFilter { // Main struct for HF triggers
               }
 
               // exclude already the current track if it corresponds to the K- candidate
-              if (globalIndexSoftPi == track.globalIndex()) {
+              if (globalIndexSoftPi == track.globalIndex) {
                 continue;
               }
 
               // check the candidate SigmaC++ charge
-              std::array<int, 4> chargesSc = {trackFirst.sign(), trackSecond.sign(), trackThird.sign(), trackSoftPi.sign()};
+              std::array<int, 4> chargesSc = {trackFirst.sign(), trackSecond.sign(), trackThird.sign(), trackSoftPi.sign};
               int chargeSc = std::accumulate(chargesSc.begin(), chargesSc.end(), 0); // SIGNED electric charge of SigmaC candidate
               if (std::abs(chargeSc) != 2) {
                 continue;
               }
 
               // select soft pion candidates
-              auto trackParSoftPi = getTrackPar(trackSoftPi);
-              o2::gpu::gpustd::array<float, 2> dcaSoftPi{trackSoftPi.dcaXY(), trackSoftPi.dcaZ()};
-              std::array<float, 3> pVecSoftPi = trackSoftPi.pVector();
-              if (trackSoftPi.collisionId() != thisCollId) {
-                // This is a track reassociated to this PV by the track-to-collision-associator
-                // Let's propagate this track to it, and calculate dcaXY, dcaZ
-                o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParSoftPi, 2.f, noMatCorr, &dcaSoftPi);
-                getPxPyPz(trackParSoftPi, pVecSoftPi);
-              }
-              int8_t isSoftPionSelected = helper.isSelectedTrackForSoftPionOrBeauty(trackSoftPi, trackParSoftPi, dcaSoftPi, kSigmaCPPK);
+              const auto& pVecSoftPi = trackSoftPi.pVec;
+              int8_t isSoftPionSelected = trackSoftPi.selSoftPionForSigmaC;
               if (TESTBIT(isSoftPionSelected, kSoftPionForSigmaC) /*&& (TESTBIT(is3Prong[2], 0) || TESTBIT(is3Prong[2], 1))*/) {
 
                 // check the mass of the SigmaC++ candidate
@@ -926,7 +950,7 @@ struct HfFilter { // Main struct for HF triggers
                   ///   - it is in the correct mass range
 
                   // check the charge for SigmaC++K- candidates
-                  if (std::abs(chargeSc + track.sign()) != 1) {
+                  if (std::abs(chargeSc + track.sign) != 1) {
                     continue;
                   }
 
@@ -1101,11 +1125,14 @@ struct HfFilter { // Main struct for HF triggers
             // we pair SigmaC0 with V0
             if (!keepEvent[kSigmaC0K0] && (isGoodLcToPKPi || isGoodLcToPiKP) && TESTBIT(selV0, kK0S)) {
               // look for SigmaC0 candidates
-              for (const auto& trackSoftPiId : trackIdsThisCollision) { // start loop over tracks (soft pi)
+              for (const auto& iTrackSoftPi : preselTracksPtOrder) { // start loop over tracks (soft pi), sorted by decreasing pT
 
                 // soft pion candidates
-                auto trackSoftPi = trackSoftPiId.track_as<BigTracksPID>();
-                auto globalIndexSoftPi = trackSoftPi.globalIndex();
+                const auto& trackSoftPi = preselTracks[iTrackSoftPi];
+                if (trackSoftPi.pt < helper.getPtMinSoftPionForSigmaC()) {
+                  break; // no further track can be selected as soft pion
+                }
+                auto globalIndexSoftPi = trackSoftPi.globalIndex;
 
                 // exclude tracks already used to build the 3-prong candidate
                 if (globalIndexSoftPi == trackFirst.globalIndex() || globalIndexSoftPi == trackSecond.globalIndex() || globalIndexSoftPi == trackThird.globalIndex()) {
@@ -1114,23 +1141,15 @@ struct HfFilter { // Main struct for HF triggers
                 }
 
                 // check the candidate SigmaC0 charge
-                std::array<int, 4> chargesSc = {trackFirst.sign(), trackSecond.sign(), trackThird.sign(), trackSoftPi.sign()};
+                std::array<int, 4> chargesSc = {trackFirst.sign(), trackSecond.sign(), trackThird.sign(), trackSoftPi.sign};
                 int chargeSc = std::accumulate(chargesSc.begin(), chargesSc.end(), 0); // SIGNED electric charge of SigmaC candidate
                 if (chargeSc != 0) {
                   continue;
                 }
 
                 // select soft pion candidates
-                auto trackParSoftPi = getTrackPar(trackSoftPi);
-                o2::gpu::gpustd::array<float, 2> dcaSoftPi{trackSoftPi.dcaXY(), trackSoftPi.dcaZ()};
-                std::array<float, 3> pVecSoftPi = trackSoftPi.pVector();
-                if (trackSoftPi.collisionId() != thisCollId) {
-                  // This is a track reassociated to this PV by the track-to-collision-associator
-                  // Let's propagate this track to it, and calculate dcaXY, dcaZ
-                  o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, trackParSoftPi, 2.f, noMatCorr, &dcaSoftPi);
-                  getPxPyPz(trackParSoftPi, pVecSoftPi);
-                }
-                int8_t isSoftPionSelected = helper.isSelectedTrackForSoftPionOrBeauty(trackSoftPi, trackParSoftPi, dcaSoftPi, kSigmaC0K0);
+                const auto& pVecSoftPi = trackSoftPi.pVec;
+                int8_t isSoftPionSelected = trackSoftPi.selSoftPionForSigmaC;
                 if (TESTBIT(isSoftPionSelected, kSoftPionForSigmaC) /*&& (TESTBIT(is3Prong[2], 0) || TESTBIT(is3Prong[2], 1))*/) {
 
                   // check the mass of the SigmaC0 candidate
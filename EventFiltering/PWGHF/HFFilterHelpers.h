@@ -107,6 +107,12 @@ enum bachelorTrackSelection {
   kSoftPionForSigmaC
 };
 
+enum trackTags {
+  kTagSameCollision = 0,
+  kTagProtonForFemto,
+  kTagKaonFromXicResoToSigmaC
+};
+
 enum PIDSpecies {
   kEl = 0,
   kPi,
@@ -226,6 +232,22 @@ static const std::vector<std::string> labelsEmpty{};
 static constexpr double cutsTrackDummy[o2::analysis::hf_cuts_single_track::nBinsPtTrack][o2::analysis::hf_cuts_single_track::nCutVarsTrack] = {{0., 10.}, {0., 10.}, {0., 10.}, {0., 10.}, {0., 10.}, {0., 10.}};
 o2::framework::LabeledArray<double> cutsSingleTrackDummy{cutsTrackDummy[0], o2::analysis::hf_cuts_single_track::nBinsPtTrack, o2::analysis::hf_cuts_single_track::nCutVarsTrack, o2::analysis::hf_cuts_single_track::labelsPtTrack, o2::analysis::hf_cuts_single_track::labelsCutVarTrack};
 
+// Track quantities and track-level selections computed once per collision and shared by all the candidates
+struct HfFilterTrack {
+  int64_t globalIndex{-1};                           // global index of the track
+  int sign{0};                                       // sign of the track
+  float pt{0.f};                                     // pT at the collision
+  float tpcNSigmaPr{-999.f};                         // TPC nsigma for the proton hypothesis
+  float tofNSigmaPr{-999.f};                         // TOF nsigma for the proton hypothesis
+  o2::track::TrackParametrization<float> trackPar{}; // track parameters at the collision
+  o2::gpu::gpustd::array<float, 2> dca{};            // dcaXY and dcaZ with respect to the collision
+  std::array<float, 3> pVec{};                       // momentum at the collision
+  int8_t selBeauty3P{kRejected};                     // isSelectedTrackForSoftPionOrBeauty for 3-prong beauty candidates (soft-pion bits also valid for the other triggers)
+  int8_t selBeauty4P{kRejected};                     // isSelectedTrackForSoftPionOrBeauty for 4-prong beauty candidates
+  int8_t selSoftPionForSigmaC{kRejected};            // isSelectedTrackForSoftPionOrBeauty for SigmaC soft pions
+  uint8_t tags{0};                                   // BIT(trackTags)
+};
+
 // Main helper class
 
 class HfFilterHelper
@@ -361,6 +383,10 @@ class HfFilterHelper
 
   void setNumSigmaForDeltaMassCharmHadCut(float nSigma) { mNumSigmaDeltaMassCharmHad = nSigma; }
 
+  // getters
+  float getPtMinBeautyBachelor() const { return mPtMinBeautyBachelor; }
+  float getPtMinSoftPionForSigmaC() const { return mPtMinSoftPionForSigmaC; }
+
   // helper functions for selections
   template <typename T>
   bool isSelectedHighPt2Prong(const T& pt);
@@ -460,6 +460,13 @@ struct fullJetFilter {
     return isEMCALMinBias(collision) || isEMCALLevel0(collision) || isEMCALLevel1(collision);
   }
 
+  struct ClusterData {
+    float mTriggerObservable;
+    float mEta;
+    float mPhi;
+  };
+  std::vector<ClusterData> analysedClusters; // clusters of the current collision passing the gamma trigger selection, reused across collisions
+
   void runGammaTrigger(const selectedClusters& clusters, std::bitset<EMCALHardwareTrigger::TRG_NTriggers> hardwaretriggers, std::array<bool, kCategories>& keepEvent)
   {
     double maxClusterObservableEMCAL = -1., maxClusterObservableDCAL = -1.;
@@ -468,12 +475,7 @@ struct fullJetFilter {
     std::array<TH2*, 8> acceptanceHistsPtEta{{hSelectedGammaEMCALPtEtaVeryHigh.object.get(), hSelectedGammaDCALPtEtaVeryHigh.object.get(), hSelectedGammaEMCALPtEta.object.get(), hSelectedGammaDCALPtEta.object.get(), hSelectedGammaEMCALPtEtaLow.object.get(), hSelectedGammaDCALPtEtaLow.object.get(), hSelectedGammaEMCALPtEtaVeryLow.object.get(), hSelectedGammaDCALPtEtaVeryLow.object.get()}},
       acceptanceHistsPtPhi{{hSelectedGammaEMCALPtPhiVeryHigh.object.get(), hSelectedGammaDCALPtPhiVeryHigh.object.get(), hSelectedGammaEMCALPtPhi.object.get(), hSelectedGammaDCALPtPhi.object.get(), hSelectedGammaEMCALPtPhiLow.object.get(), hSelectedGammaDCALPtPhiLow.object.get(), hSelectedGammaEMCALPtPhiVeryLow.object.get(), hSelectedGammaDCALPtPhiVeryLow.object.get()}};
     std::array<TH1*, 8> maxClusterPtHists = {{hSelectGammaVeryHighMaxClusterEMCAL.object.get(), hSelectGammaVeryHighMaxClusterDCAL.object.get(), hSelectGammaMaxClusterEMCAL.object.get(), hSelectGammaMaxClusterDCAL.object.get(), hSelectGammaLowMaxClusterEMCAL.object.get(), hSelectGammaLowMaxClusterDCAL.object.get(), hSelectGammaVeryLowMaxClusterEMCAL.object.get(), hSelectGammaVeryLowMaxClusterDCAL.object.get()}};
-    struct ClusterData {
-      float mTriggerObservable;
-      float mEta;
-      float mPhi;
-    };
-    std::vector<ClusterData> analysedClusters;
+    analysedClusters.clear();
     for (const auto& cluster : clusters) {
       if (b_RejectExoticClusters && cluster.isExotic()) {
         continue;
@@ -482,9 +484,10 @@ struct fullJetFilter {
         continue;
       }
       double observableGamma = (f_ObservalbeGammaTrigger == 0) ? cluster.energy() : cluster.energy() / std::cosh(cluster.eta());
-      if (TVector2::Phi_0_2pi(cluster.phi()) < 4 && observableGamma > maxClusterObservableEMCAL) {
+      const double clusterPhi = TVector2::Phi_0_2pi(cluster.phi());
+      if (clusterPhi < 4 && observableGamma > maxClusterObservableEMCAL) {
         maxClusterObservableEMCAL = observableGamma;
-      } else if (TVector2::Phi_0_2pi(cluster.phi()) > 4 && observableGamma > maxClusterObservableDCAL) {
+      } else if (clusterPhi > 4 && observableGamma > maxClusterObservableDCAL) {
         maxClusterObservableDCAL = observableGamma;
       }
       hEmcClusterPtEta->Fill(observableGamma, cluster.eta());
@@ -390,6 +390,7 @@ struct strangenessFilter {
 
   Service<o2::ccdb::BasicCCDBManager> ccdb;
   int runNumber;
+  std::vector<float> selectedTrackPt; // pt of the selected tracks of the current collision
 
   float getMassWindow(const stfilter::species s, const float pt, const float nsigma = 6)
   {
@@ -532,9 +533,12 @@ struct strangenessFilter {
         continue;
       }
 
+      // topological variables used by several selections, evaluated once
+      const float cascCosPA = casc.casccosPA(collision.posX(), collision.posY(), collision.posZ());
+      const float dcaV0ToPV = casc.dcav0topv(collision.posX(), collision.posY(), collision.posZ());
       isXi = (TMath::Abs(bachelor.tpcNSigmaPi()) < nsigmatpcpi) &&
-             (casc.casccosPA(collision.posX(), collision.posY(), collision.posZ()) > casccospaxi) &&
-             (casc.dcav0topv(collision.posX(), collision.posY(), collision.posZ()) > dcav0topv) &&
+             (cascCosPA > casccospaxi) &&
+             (dcaV0ToPV > dcav0topv) &&
              (TMath::Abs(casc.mXi() - o2::constants::physics::MassXiMinus) < ximasswindow) &&
              (TMath::Abs(casc.mOmega() - o2::constants::physics::MassOmegaMinus) > omegarej) &&
              (xiproperlifetime < properlifetimefactor * ctauxi) &&
@@ -546,16 +550,16 @@ struct strangenessFilter {
                (xiproperlifetime < properlifetimefactor * ctauxi) &&
                (TMath::Abs(casc.yXi()) < rapidity); // add PID on bachelor
       isOmega = (TMath::Abs(bachelor.tpcNSigmaKa()) < nsigmatpcka) &&
-                (casc.casccosPA(collision.posX(), collision.posY(), collision.posZ()) > casccospaomega) &&
-                (casc.dcav0topv(collision.posX(), collision.posY(), collision.posZ()) > dcav0topv) &&
+                (cascCosPA > casccospaomega) &&
+                (dcaV0ToPV > dcav0topv) &&
                 (casc.cascradius() < upperradiusOmega) &&
                 (TMath::Abs(casc.mOmega() - o2::constants::physics::MassOmegaMinus) < omegamasswindow) &&
                 (TMath::Abs(casc.mXi() - o2::constants::physics::MassXiMinus) > xirej) &&
                 (omegaproperlifetime < properlifetimefactor * ctauomega) &&
                 (TMath::Abs(casc.yOmega()) < rapidity); // add PID on bachelor
       isOmegalargeR = (TMath::Abs(bachelor.tpcNSigmaKa()) < nsigmatpcka) &&
-                      (casc.casccosPA(collision.posX(), collision.posY(), collision.posZ()) > casccospaomega) &&
-                      (casc.dcav0topv(collision.posX(), collision.posY(), collision.posZ()) > dcav0topv) &&
+                      (cascCosPA > casccospaomega) &&
+                      (dcaV0ToPV > dcav0topv) &&
                       (casc.cascradius() > lowerradiusOmega) &&
                       (TMath::Abs(casc.mOmega() - o2::constants::physics::MassOmegaMinus) < omegamasswindow) &&
                       (TMath::Abs(casc.mXi() - o2::constants::physics::MassXiMinus) > xirej) &&
@@ -600,6 +604,7 @@ struct strangenessFilter {
         }
         // triggcounter++;
         keepEvent[1] = true;
+        break; // one selected track fires the trigger
       } // end loop over tracks
     }
 
@@ -714,6 +719,51 @@ struct strangenessFilter {
     int triggcounterAllEv = 0;
     int triggcounterForEstimates = 0;
 
+    // Selected tracks, evaluated once for the QA, the Xi estimates and the high-pT hadron + Omega trigger
+    selectedTrackPt.clear();
+    bool EvtwhMinPt[11];
+    bool EvtwhMinPtCasc[11];
+    float ThrdPt[11];
+    for (int i = 0; i < 11; i++) {
+      EvtwhMinPt[i] = 0.;
+      EvtwhMinPtCasc[i] = 0.;
+      ThrdPt[i] = static_cast<float>(i);
+    }
+
+    // QA tracks
+    for (auto track : tracks) { // start loop over tracks
+      if (isTrackFilter && !mTrackSelector.IsSelected(track)) {
+        continue;
+      }
+      triggcounterAllEv++;
+      selectedTrackPt.push_back(track.pt());
+      QAHistosTriggerParticles.fill(HIST("hPtTriggerAllEv"), track.pt());
+      QAHistosTriggerParticles.fill(HIST("hPhiTriggerAllEv"), track.phi(), track.pt());
+      QAHistosTriggerParticles.fill(HIST("hEtaTriggerAllEv"), track.eta(), track.pt());
+      QAHistosTriggerParticles.fill(HIST("hDCAxyTriggerAllEv"), track.dcaXY(), track.pt());
+      QAHistosTriggerParticles.fill(HIST("hDCAzTriggerAllEv"), track.dcaZ(), track.pt());
+      for (int i = 0; i < 11; i++) {
+        if (track.pt() > ThrdPt[i])
+          EvtwhMinPt[i] = 1;
+      }
+    } // end loop over tracks
+    for (int i = 0; i < 11; i++) {
+      if (EvtwhMinPt[i]) {
+        EventsvsMultiplicity.fill(HIST("hadEventsvsMultiplicityZeqV0AvsPt"), collision.multZeqFV0A(), i + 0.5);
+        EventsvsMultiplicity.fill(HIST("hadEventsvsMultiplicityZeqT0MvsPt"), collision.multZeqFT0A() + collision.multZeqFT0C(), i + 0.5);
+        EventsvsMultiplicity.fill(HIST("hadEventsvsMultiplicityZeqNTracksPVvsPt"), collision.multZeqNTracksPV(), i + 0.5);
+      }
+    }
+    if (triggcounterAllEv > 0) {
+      hProcessedEvents->Fill(1.5);
+      if (doextraQA) {
+        EventsvsMultiplicity.fill(HIST("hadEventsvsMultiplicityZeqV0A"), collision.multZeqFV0A());
+        EventsvsMultiplicity.fill(HIST("hadEventsvsMultiplicityZeqT0M"), collision.multZeqFT0A() + collision.multZeqFT0C());
+        EventsvsMultiplicity.fill(HIST("hadEventsvsMultiplicityZeqNTracksPV"), collision.multZeqNTracksPV());
+      }
+    }
+    QAHistosTriggerParticles.fill(HIST("hTriggeredParticlesAllEv"), triggcounterAllEv);
+
     for (auto& casc : fullCasc) { // loop over cascades
       triggcounterForEstimates = 0;
 
@@ -824,11 +874,14 @@ struct strangenessFilter {
         continue;
       }
       hCandidate->Fill(15.5);
+      // topological variables used by several selections and the QA, evaluated once
+      const float cascCosPA = casc.casccosPA(collision.posX(), collision.posY(), collision.posZ());
+      const float dcaV0ToPV = casc.dcav0topv(collision.posX(), collision.posY(), collision.posZ());
 
       // Fill selections QA for XiMinus
-      if (casc.casccosPA(collision.posX(), collision.posY(), collision.posZ()) > casccospaxi) {
+      if (cascCosPA > casccospaxi) {
         hCandidate->Fill(16.5);
-        if (casc.dcav0topv(collision.posX(), collision.posY(), collision.posZ()) > dcav0topv) {
+        if (dcaV0ToPV > dcav0topv) {
           hCandidate->Fill(17.5);
           if (xiproperlifetime < properlifetimefactor * ctauxi) {
             hCandidate->Fill(18.5);
@@ -842,8 +895,8 @@ struct strangenessFilter {
       const auto deltaMassXi = useSigmaBasedMassCutXi ? getMassWindow(stfilter::species::Xi, casc.pt()) : ximasswindow;
       const auto deltaMassOmega = useSigmaBasedMassCutOmega ? getMassWindow(stfilter::species::Omega, casc.pt()) : omegamasswindow;
       isXi = (TMath::Abs(bachelor.tpcNSigmaPi()) < nsigmatpcpi) &&
-             (casc.casccosPA(collision.posX(), collision.posY(), collision.posZ()) > casccospaxi) &&
-             (casc.dcav0topv(collision.posX(), collision.posY(), collision.posZ()) > dcav0topv) &&
+             (cascCosPA > casccospaxi) &&
+             (dcaV0ToPV > dcav0topv) &&
              (TMath::Abs(casc.mXi() - o2::constants::physics::MassXiMinus) < deltaMassXi) &&
              (TMath::Abs(casc.mOmega() - o2::constants::physics::MassOmegaMinus) > omegarej) &&
              (xiproperlifetime < properlifetimefactor * ctauxi) &&
@@ -855,16 +908,16 @@ struct strangenessFilter {
                (xiproperlifetime < properlifetimefactor * ctauxi) &&
                (TMath::Abs(casc.yXi()) < rapidity);
       isOmega = (TMath::Abs(bachelor.tpcNSigmaKa()) < nsigmatpcka) &&
-                (casc.casccosPA(collision.posX(), collision.posY(), collision.posZ()) > casccospaomega) &&
-                (casc.dcav0topv(collision.posX(), collision.posY(), collision.posZ()) > dcav0topv) &&
+                (cascCosPA > casccospaomega) &&
+                (dcaV0ToPV > dcav0topv) &&
                 (TMath::Abs(casc.mOmega() - o2::constants::physics::MassOmegaMinus) < deltaMassOmega) &&
                 (TMath::Abs(casc.mXi() - o2::constants::physics::MassXiMinus) > xirej) &&
                 (casc.cascradius() < upperradiusOmega) &&
                 (omegaproperlifetime < properlifetimefactor * ctauomega) &&
                 (TMath::Abs(casc.yOmega()) < rapidity);
       isOmegalargeR = (TMath::Abs(bachelor.tpcNSigmaKa()) < nsigmatpcka) &&
-                      (casc.casccosPA(collision.posX(), collision.posY(), collision.posZ()) > casccospaomega) &&
-                      (casc.dcav0topv(collision.posX(), collision.posY(), collision.posZ()) > dcav0topv) &&
+                      (cascCosPA > casccospaomega) &&
+                      (dcaV0ToPV > dcav0topv) &&
                       (casc.cascradius() > lowerradiusOmega) &&
                       (TMath::Abs(casc.mOmega() - o2::constants::physics::MassOmegaMinus) < deltaMassOmega) &&
                       (TMath::Abs(casc.mXi() - o2::constants::physics::MassXiMinus) > xirej) &&
@@ -876,11 +929,11 @@ struct strangenessFilter {
         QAHistos.fill(HIST("hPtXi"), casc.pt());
         QAHistos.fill(HIST("hEtaXi"), casc.eta());
         QAHistosTopologicalVariables.fill(HIST("hProperLifetimeXi"), xiproperlifetime);
-        QAHistosTopologicalVariables.fill(HIST("hCascCosPAXi"), casc.casccosPA(collision.posX(), collision.posY(), collision.posZ()));
+        QAHistosTopologicalVariables.fill(HIST("hCascCosPAXi"), cascCosPA);
         QAHistosTopologicalVariables.fill(HIST("hV0CosPAXi"), casc.v0cosPA(collision.posX(), collision.posY(), collision.posZ()));
         QAHistosTopologicalVariables.fill(HIST("hCascRadiusXi"), casc.cascradius());
         QAHistosTopologicalVariables.fill(HIST("hV0RadiusXi"), casc.v0radius());
-        QAHistosTopologicalVariables.fill(HIST("hDCAV0ToPVXi"), casc.dcav0topv(collision.posX(), collision.posY(), collision.posZ()));
+        QAHistosTopologicalVariables.fill(HIST("hDCAV0ToPVXi"), dcaV0ToPV);
         QAHistosTopologicalVariables.fill(HIST("hDCAV0DaughtersXi"), casc.dcaV0daughters());
         QAHistosTopologicalVariables.fill(HIST("hDCACascDaughtersXi"), casc.dcacascdaughters());
         QAHistosTopologicalVariables.fill(HIST("hDCABachToPVXi"), TMath::Abs(casc.dcabachtopv()));
@@ -912,13 +965,8 @@ struct strangenessFilter {
         xicounter++;
 
         // Plot for estimates
-        for (auto track : tracks) { // start loop over tracks
-          if (isTrackFilter && !mTrackSelector.IsSelected(track)) {
-            continue;
-          }
-          triggcounterForEstimates++;
-          if (triggcounterForEstimates > 0)
-            break;
+        if (!selectedTrackPt.empty()) {
+          triggcounterForEstimates = 1;
         }
         if (triggcounterForEstimates && (TMath::Abs(casc.mXi() - o2::constants::physics::MassXiMinus) < 0.01))
           hhXiPairsvsPt->Fill(casc.pt()); // Fill the histogram with all the Xis produced in events with a trigger particle
@@ -934,11 +982,11 @@ struct strangenessFilter {
         QAHistos.fill(HIST("hPtOmega"), casc.pt());
         QAHistos.fill(HIST("hEtaOmega"), casc.eta());
         QAHistosTopologicalVariables.fill(HIST("hProperLifetimeOmega"), omegaproperlifetime);
-        QAHistosTopologicalVariables.fill(HIST("hCascCosPAOmega"), casc.casccosPA(collision.posX(), collision.posY(), collision.posZ()));
+        QAHistosTopologicalVariables.fill(HIST("hCascCosPAOmega"), cascCosPA);
         QAHistosTopologicalVariables.fill(HIST("hV0CosPAOmega"), casc.v0cosPA(collision.posX(), collision.posY(), collision.posZ()));
         QAHistosTopologicalVariables.fill(HIST("hCascRadiusOmega"), casc.cascradius());
         QAHistosTopologicalVariables.fill(HIST("hV0RadiusOmega"), casc.v0radius());
-        QAHistosTopologicalVariables.fill(HIST("hDCAV0ToPVOmega"), casc.dcav0topv(collision.posX(), collision.posY(), collision.posZ()));
+        QAHistosTopologicalVariables.fill(HIST("hDCAV0ToPVOmega"), dcaV0ToPV);
         QAHistosTopologicalVariables.fill(HIST("hDCAV0DaughtersOmega"), casc.dcaV0daughters());
         QAHistosTopologicalVariables.fill(HIST("hDCACascDaughtersOmega"), casc.dcacascdaughters());
         QAHistosTopologicalVariables.fill(HIST("hDCABachToPVOmega"), TMath::Abs(casc.dcabachtopv()));
@@ -980,58 +1028,14 @@ struct strangenessFilter {
       keepEvent[0] = true;
     }
 
-    bool EvtwhMinPt[11];
-    bool EvtwhMinPtCasc[11];
-    float ThrdPt[11];
-    for (int i = 0; i < 11; i++) {
-      EvtwhMinPt[i] = 0.;
-      EvtwhMinPtCasc[i] = 0.;
-      ThrdPt[i] = static_cast<float>(i);
-    }
-
-    // QA tracks
-    for (auto track : tracks) { // start loop over tracks
-      if (isTrackFilter && !mTrackSelector.IsSelected(track)) {
-        continue;
-      }
-      triggcounterAllEv++;
-      QAHistosTriggerParticles.fill(HIST("hPtTriggerAllEv"), track.pt());
-      QAHistosTriggerParticles.fill(HIST("hPhiTriggerAllEv"), track.phi(), track.pt());
-      QAHistosTriggerParticles.fill(HIST("hEtaTriggerAllEv"), track.eta(), track.pt());
-      QAHistosTriggerParticles.fill(HIST("hDCAxyTriggerAllEv"), track.dcaXY(), track.pt());
-      QAHistosTriggerParticles.fill(HIST("hDCAzTriggerAllEv"), track.dcaZ(), track.pt());
-      for (int i = 0; i < 11; i++) {
-        if (track.pt() > ThrdPt[i])
-          EvtwhMinPt[i] = 1;
-      }
-    } // end loop over tracks
-    for (int i = 0; i < 11; i++) {
-      if (EvtwhMinPt[i]) {
-        EventsvsMultiplicity.fill(HIST("hadEventsvsMultiplicityZeqV0AvsPt"), collision.multZeqFV0A(), i + 0.5);
-        EventsvsMultiplicity.fill(HIST("hadEventsvsMultiplicityZeqT0MvsPt"), collision.multZeqFT0A() + collision.multZeqFT0C(), i + 0.5);
-        EventsvsMultiplicity.fill(HIST("hadEventsvsMultiplicityZeqNTracksPVvsPt"), collision.multZeqNTracksPV(), i + 0.5);
-      }
-    }
-    if (triggcounterAllEv > 0) {
-      hProcessedEvents->Fill(1.5);
-      if (doextraQA) {
-        EventsvsMultiplicity.fill(HIST("hadEventsvsMultiplicityZeqV0A"), collision.multZeqFV0A());
-        EventsvsMultiplicity.fill(HIST("hadEventsvsMultiplicityZeqT0M"), collision.multZeqFT0A() + collision.multZeqFT0C());
-        EventsvsMultiplicity.fill(HIST("hadEventsvsMultiplicityZeqNTracksPV"), collision.multZeqNTracksPV());
-      }
-    }
-    QAHistosTriggerParticles.fill(HIST("hTriggeredParticlesAllEv"), triggcounterAllEv);
 
     // High-pT hadron + Omega trigger definition
     if (omegacounter > 0) {
-      for (auto track : tracks) { // start loop over tracks
-        if (isTrackFilter && !mTrackSelector.IsSelected(track)) {
-          continue;
-        }
+      for (const float trackPt : selectedTrackPt) { // start loop over selected tracks
         triggcounter++;
-        QAHistosTriggerParticles.fill(HIST("hPtTriggerSelEv"), track.pt());
+        QAHistosTriggerParticles.fill(HIST("hPtTriggerSelEv"), trackPt);
         for (int i = 0; i < 11; i++) {
-          if (track.pt() > ThrdPt[i])
+          if (trackPt > ThrdPt[i])
             EvtwhMinPtCasc[i] = 1;
         }
         keepEvent[1] = true;
@@ -43,6 +43,9 @@ struct DGFilterRun3 {
   // DG selector
   DGSelector dgSelector;
 
+  // FIT activity of the compatible BCs of a collision
+  udhelpers::FITActivity fitActivity;
+
   // histogram stat/aftercuts with cut statistics
   // bin:
   //   1: All collisions
@@ -200,26 +203,32 @@ struct DGFilterRun3 {
       registry.fill(HIST("FIT/FDDCtime"), bc2.foundFDD().timeC());
     }
 
+    // The single detector limits of the first BC range leave the detectors which follow
+    // unchecked (-1), those of the larger ranges check them with a loose limit (1000000).
+    // The limits of the nMinBC loop are thus the default ones and two sets of 5.
     auto FITlims = std::vector<float>(5, -1.);
+    std::vector<std::vector<float>> FITlimsSets{diffCuts.FITAmpLimits()};
+    for (int iset = 0; iset < 2; iset++) {
+      for (int n = 0; n < 5; n++) {
+        FITlims[n] = 0.;
+        FITlimsSets.push_back(FITlims);
+        FITlims[n] = 1000000.;
+      }
+    }
+    // the compatible BCs of the largest range contain those of the smaller ones
+    fitActivity.fill(udhelpers::compatibleBCs(collision, 0, bcs, 20), diffCuts.maxFITtime(), FITlimsSets);
+
     bool isDGcandidate = true;
     for (int nMinBC = 0; nMinBC <= 20; nMinBC++) {
       auto bcSlice = udhelpers::compatibleBCs(collision, 0, bcs, nMinBC);
-      isDGcandidate = true;
-      for (auto const& bc : bcSlice) {
-        isDGcandidate &= udhelpers::cleanFIT(bc, diffCuts.maxFITtime(), diffCuts.FITAmpLimits());
-      }
+      isDGcandidate = fitActivity.isClean(bcSlice, 0);
       registry.get<TH2>(HIST("FIT/cleanFIT"))->Fill(nMinBC, isDGcandidate * 1.);
 
       // loop over single detectors
       static_for<0, 4>([&](auto n) {
-        FITlims[n] = 0.;
-        isDGcandidate = true;
-        for (auto const& bc : bcSlice) {
-          isDGcandidate &= udhelpers::cleanFIT(bc, diffCuts.maxFITtime(), FITlims);
-        }
         constexpr int index = n.value;
+        isDGcandidate = fitActivity.isClean(bcSlice, 1 + (nMinBC == 0 ? 0 : 5) + index);
         registry.fill(HIST(hcFITs[index]), nMinBC, isDGcandidate * 1.);
-        FITlims[n] = 1000000.;
       });
     }
 
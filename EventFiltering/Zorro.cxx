@@ -12,11 +12,14 @@
 
 #include "Zorro.h"
 
+#include <algorithm>
 #include <map>
+#include <numeric>
 
 #include "TH1D.h"
 
 #include "CCDB/BasicCCDBManager.h"
+#include "Framework/Logger.h"
 #include "CommonDataFormat/InteractionRecord.h"
 
 using o2::InteractionRecord;
@@ -29,25 +32,55 @@ std::vector<int> Zorro::initCCDB(o2::ccdb::BasicCCDBManager* ccdb, int runNumber
   mCCDB = ccdb;
   mRunNumber = runNumber;
   mBCtolerance = bcRange;
+  mLastBCglobalId = 0;
+  mLastSelectedIdx = 0;
+
+  auto cached = mRunCache.find(runNumber);
+  if (cached != mRunCache.end() && cached->second.tois == tois) {
+    LOGP(info, "Zorro: using the selected BCs of run {} from the cache", runNumber);
+    mSelectedBCs = &cached->second;
+    mTOIs = mSelectedBCs->toiNames;
+    mTOIidx = mSelectedBCs->toiIdx;
+    mTOIcounts.assign(mTOIs.size(), 0);
+    return mTOIidx;
+  }
+
   std::map<std::string, std::string> metadata;
   metadata["runNumber"] = std::to_string(runNumber);
   mScalers = mCCDB->getSpecific<TH1D>(mBaseCCDBPath + "FilterCounters", timestamp, metadata);
   mSelections = mCCDB->getSpecific<TH1D>(mBaseCCDBPath + "SelectionCounters", timestamp, metadata);
   mInspectedTVX = mCCDB->getSpecific<TH1D>(mBaseCCDBPath + "InspectedTVX", timestamp, metadata);
   auto selectedBCs = mCCDB->getSpecific<std::vector<std::array<uint64_t, 2>>>(mBaseCCDBPath + "SelectedBCs", timestamp, metadata);
-  mBCranges.clear();
-  for (auto bc : *selectedBCs) {
-    mBCranges.emplace_back(InteractionRecord::long2IR(std::min(bc[0], bc[1])), InteractionRecord::long2IR(std::max(bc[0], bc[1])));
-  }
-  std::sort(mBCranges.begin(), mBCranges.end(), [](const auto& a, const auto& b) { return a.getMin() < b.getMin(); });
-
   mSelectionBitMask = mCCDB->getSpecific<std::vector<std::array<uint64_t, 2>>>(mBaseCCDBPath + "SelectionBitMask", timestamp, metadata);
   mFilterBitMask = mCCDB->getSpecific<std::vector<std::array<uint64_t, 2>>>(mBaseCCDBPath + "FilterBitMask", timestamp, metadata);
 
-  mLastBCglobalId = 0;
-  mLastSelectedIdx = 0;
+  // sort the ranges together with their trigger bits
+  SelectedBCs& entry = mRunCache[runNumber];
+  entry = SelectedBCs{};
+  std::vector<size_t> order(selectedBCs->size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [selectedBCs](size_t a, size_t b) { return std::min((*selectedBCs)[a][0], (*selectedBCs)[a][1]) < std::min((*selectedBCs)[b][0], (*selectedBCs)[b][1]); });
+  entry.bcMin.reserve(order.size());
+  entry.bcMax.reserve(order.size());
+  entry.bcMaxPrefix.reserve(order.size());
+  entry.filterBits.reserve(order.size());
+  for (const size_t i : order) {
+    const auto& bc = (*selectedBCs)[i];
+    entry.bcMin.push_back(std::min(bc[0], bc[1]));
+    entry.bcMax.push_back(std::max(bc[0], bc[1]));
+    entry.bcMaxPrefix.push_back(entry.bcMaxPrefix.empty() ? entry.bcMax.back() : std::max(entry.bcMaxPrefix.back(), entry.bcMax.back()));
+    std::bitset<128> bits;
+    for (int iMask{0}; iMask < 2; ++iMask) {
+      for (int iTOI{0}; iTOI < 64; ++iTOI) {
+        bits.set(iMask * 64 + iTOI, mFilterBitMask->at(i)[iMask] & (1ull << iTOI));
+      }
+    }
+    entry.filterBits.push_back(bits);
+  }
+
   mTOIs.clear();
   mTOIidx.clear();
+  entry.tois = tois;
   size_t pos = 0;
   while ((pos = tois.find(",")) != std::string::npos) {
     std::string token = tois.substr(0, pos);
@@ -59,28 +92,40 @@ std::vector<int> Zorro::initCCDB(o2::ccdb::BasicCCDBManager* ccdb, int runNumber
     mTOIidx.push_back(bin);
     tois.erase(0, pos + 1);
   }
-  mTOIcounts.resize(mTOIs.size(), 0);
+  entry.toiNames = mTOIs;
+  entry.toiIdx = mTOIidx;
+  mSelectedBCs = &entry;
+  mTOIcounts.assign(mTOIs.size(), 0);
   return mTOIidx;
 }
 
-std::bitset<128> Zorro::fetch(uint64_t bcGlobalId, uint64_t tolerance)
+int Zorro::findRange(uint64_t bcGlobalId, uint64_t tolerance) const
 {
-  std::bitset<128> result;
-  o2::dataformats::IRFrame bcFrame{InteractionRecord::long2IR(bcGlobalId) - tolerance, InteractionRecord::long2IR(bcGlobalId) + tolerance};
-  if (bcGlobalId < mLastBCglobalId) {
-    mLastSelectedIdx = 0;
+  if (mSelectedBCs == nullptr) {
+    return -1;
   }
-  for (size_t i = mLastSelectedIdx; i < mBCranges.size(); i++) {
-    if (!bcFrame.getOverlap(mBCranges[i]).isZeroLength()) {
-      for (int iMask{0}; iMask < 2; ++iMask) {
-        for (int iTOI{0}; iTOI < 64; ++iTOI) {
-          result.set(iMask * 64 + iTOI, mFilterBitMask->at(i)[iMask] & (1ull << iTOI));
-        }
-      }
-      mLastSelectedIdx = i;
-      return result;
+  const uint64_t low = bcGlobalId > tolerance ? bcGlobalId - tolerance : 0;
+  const uint64_t high = bcGlobalId + tolerance;
+  // first range which can end after the lower edge of the frame
+  const auto& prefix = mSelectedBCs->bcMaxPrefix;
+  size_t i = std::lower_bound(prefix.begin(), prefix.end(), low) - prefix.begin();
+  for (; i < prefix.size() && mSelectedBCs->bcMin[i] <= high; ++i) {
+    if (mSelectedBCs->bcMax[i] >= low) {
+      return i;
     }
   }
+  return -1;
+}
+
+std::bitset<128> Zorro::fetch(uint64_t bcGlobalId, uint64_t tolerance)
+{
+  std::bitset<128> result;
+  mLastBCglobalId = bcGlobalId;
+  const int i = findRange(bcGlobalId, tolerance);
+  if (i >= 0) {
+    result = mSelectedBCs->filterBits[i];
+    mLastSelectedIdx = i;
+  }
   return result;
 }
 
@@ -97,4 +142,4 @@ bool Zorro::isSelected(uint64_t bcGlobalId, uint64_t tolerance)
     }
   }
   return false;
-}
\ No newline at end of file
+}
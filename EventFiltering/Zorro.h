@@ -14,7 +14,9 @@
 #ifndef EVENTFILTERING_ZORRO_H_
 #define EVENTFILTERING_ZORRO_H_
 
+#include <array>
 #include <bitset>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -37,6 +39,18 @@ class Zorro
   std::bitset<128> fetch(uint64_t bcGlobalId, uint64_t tolerance = 100);
   bool isSelected(uint64_t bcGlobalId, uint64_t tolerance = 100);
 
+  /// Selection of all the BCs of a table, with the same accounting as isSelected
+  template <typename TBCs>
+  std::vector<bool> selectCollisions(TBCs const& bcs, uint64_t tolerance = 100)
+  {
+    std::vector<bool> mask;
+    mask.reserve(bcs.size());
+    for (const auto& bc : bcs) {
+      mask.push_back(isSelected(bc.globalBC(), tolerance));
+    }
+    return mask;
+  }
+
   std::vector<int> getTOIcounters() const { return mTOIcounts; }
 
   void setCCDBpath(std::string path) { mBaseCCDBPath = path; }
@@ -52,7 +66,20 @@ class Zorro
   TH1D* mScalers = nullptr;
   TH1D* mSelections = nullptr;
   TH1D* mInspectedTVX = nullptr;
-  std::vector<o2::dataformats::IRFrame> mBCranges;
+  /// Selected BC ranges of a run sorted by their first BC, with the fired trigger bits of each range
+  struct SelectedBCs {
+    std::vector<uint64_t> bcMin;
+    std::vector<uint64_t> bcMax;
+    std::vector<uint64_t> bcMaxPrefix; // running maximum of bcMax, monotonic for the binary search
+    std::vector<std::bitset<128>> filterBits;
+    std::string tois;
+    std::vector<std::string> toiNames;
+    std::vector<int> toiIdx;
+  };
+  int findRange(uint64_t bcGlobalId, uint64_t tolerance) const;
+
+  std::map<int, SelectedBCs> mRunCache; // selected BCs of the runs already processed in the job
+  const SelectedBCs* mSelectedBCs = nullptr;
   std::vector<std::array<uint64_t, 2>>* mFilterBitMask = nullptr;
   std::vector<std::array<uint64_t, 2>>* mSelectionBitMask = nullptr;
   std::vector<std::string> mTOIs;
@@ -14,6 +14,7 @@
 #include <rapidjson/document.h>
 #include <rapidjson/filereadstream.h>
 
+#include <bit>
 #include <iostream>
 #include <cstdio>
 #include <random>
@@ -333,6 +334,10 @@ struct centralEventFilterTask {
           for (int64_t iC{0}; iC < column->num_chunks(); ++iC) {
             auto chunk{column->chunk(iC)};
             auto boolArray = std::static_pointer_cast<arrow::BooleanArray>(chunk);
+            if (boolArray->true_count() == 0) { // most triggers do not fire in most chunks
+              entry += chunk->length() - startCollision;
+              continue;
+            }
             for (int64_t iS{startCollision}; iS < chunk->length(); ++iS) {
               if (boolArray->Value(iS)) {
                 mScalers->Fill(binCenter);
@@ -354,15 +359,13 @@ struct centralEventFilterTask {
     for (uint64_t iE{0}; iE < outTrigger.size(); ++iE) {
       bool triggered{false}, selected{false};
       for (uint64_t iD{0}; iD < outTrigger[0].size(); ++iD) {
-        for (int iB{0}; iB < 64; ++iB) {
-          if (!(outTrigger[iE][iD] & BIT(iB))) {
-            continue;
-          }
+        // loop only on the fired bits iB, and on the fired bits iC >= iB
+        for (uint64_t bitsB{outTrigger[iE][iD]}; bitsB; bitsB &= bitsB - 1) {
+          int iB{std::countr_zero(bitsB)};
           for (int jD{0}; jD < outTrigger[0].size(); ++jD) {
-            for (int iC{iB}; iC < 64; ++iC) {
-              if (outTrigger[iE][iD] & BIT(iC)) {
-                mCovariance->Fill(iD * 64 + iB, jD * 64 + iC);
-              }
+            for (uint64_t bitsC{bitsB}; bitsC; bitsC &= bitsC - 1) {
+              int iC{std::countr_zero(bitsC)};
+              mCovariance->Fill(iD * 64 + iB, jD * 64 + iC);
             }
           }
         }
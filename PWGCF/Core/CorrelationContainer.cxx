@@ -24,6 +24,7 @@
 #include "TH1D.h"
 #include "TH2D.h"
 #include "TH3D.h"
+#include "TArrayD.h"
 #include "TCanvas.h"
 #include "TF1.h"
 #include "THn.h"
@@ -103,23 +104,76 @@ CorrelationContainer::CorrelationContainer(const char* name, const char* objTitl
 
   std::vector<o2::framework::AxisSpec> pairAxis(correlationAxis);
   pairAxis.insert(pairAxis.end(), userAxis.begin(), userAxis.end());
-  long bins = 1;
-  for (const auto& axis : pairAxis) {
-    bins *= axis.getNbins();
-  }
-  LOGF(info, "Creating CorrelationContainer with %ld bins in the pair histogram (approx. %ld-%ld MB of memory)", bins, bins * 4 / 1024 / 1024, bins * 8 / 1024 / 1024);
-
-  mPairHist = HistFactory::createHist<StepTHnF>({"mPairHist", "d^{2}N_{ch}/d#varphid#eta", {HistType::kStepTHnF, pairAxis, fgkCFSteps}}).release();
 
   std::vector<o2::framework::AxisSpec> triggerAxis({correlationAxis[2], correlationAxis[3], correlationAxis[5]});
   triggerAxis.insert(triggerAxis.end(), userAxis.begin(), userAxis.end());
+
+  std::vector<o2::framework::AxisSpec> trackEfficiencyAxis({efficiencyAxis[0], efficiencyAxis[1], {4, -0.5, 3.5, "species"}, correlationAxis[3], efficiencyAxis[2]});
+
+  // the steps of a StepTHn are allocated when they are filled for the first time, the sum of weights squared when they are filled with a weight != 1
+  LOGF(info, "Creating CorrelationContainer %s, memory per filled step (with sum of weights squared):", name);
+  logStepMemory("pair histogram", pairAxis, sizeof(Float_t));
+  logStepMemory("trigger histogram", triggerAxis, sizeof(Float_t));
+  logStepMemory("tracking efficiency histogram", trackEfficiencyAxis, sizeof(Double_t));
+
+  mPairHist = HistFactory::createHist<StepTHnF>({"mPairHist", "d^{2}N_{ch}/d#varphid#eta", {HistType::kStepTHnF, pairAxis, fgkCFSteps}}).release();
+
   mTriggerHist = HistFactory::createHist<StepTHnF>({"mTriggerHist", "d^{2}N_{ch}/d#varphid#eta", {HistType::kStepTHnF, triggerAxis, fgkCFSteps}}).release();
 
-  mTrackHistEfficiency = HistFactory::createHist<StepTHnD>({"mTrackHistEfficiency", "Tracking efficiency", {HistType::kStepTHnD, {efficiencyAxis[0], efficiencyAxis[1], {4, -0.5, 3.5, "species"}, correlationAxis[3], efficiencyAxis[2]}, fgkCFSteps}}).release();
+  mTrackHistEfficiency = HistFactory::createHist<StepTHnD>({"mTrackHistEfficiency", "Tracking efficiency", {HistType::kStepTHnD, trackEfficiencyAxis, fgkCFSteps}}).release();
 
   mEventCount = HistFactory::createHist<TH2F>({"mEventCount", ";step;centrality;count", {HistType::kTH2F, {{fgkCFSteps + 2, -2.5, -0.5 + fgkCFSteps, "step"}, correlationAxis[3]}}}).release();
 }
 
+//____________________________________________________________________
+void CorrelationContainer::logStepMemory(const char* histName, const std::vector<o2::framework::AxisSpec>& axes, Long64_t bytesPerCell)
+{
+  // prints the memory of one step of a StepTHn with the given axes
+  // the cells include the under- and overflow bins of each axis
+
+  Long64_t cells = 1;
+  for (const auto& axis : axes) {
+    cells *= axis.getNbins() + 2;
+  }
+  const Double_t megaBytes = cells * bytesPerCell / 1024. / 1024.;
+  LOGF(info, "  %s: %lld cells, %.1f MB (%.1f MB) per step, %.1f MB (%.1f MB) if all %d steps are filled", histName, cells, megaBytes, 2 * megaBytes, fgkCFSteps * megaBytes, 2 * fgkCFSteps * megaBytes, fgkCFSteps);
+}
+
+//____________________________________________________________________
+Long64_t CorrelationContainer::getAllocatedMemory(StepTHn* hist, Bool_t verbose)
+{
+  // returns the memory in bytes of the steps of hist allocated so far
+
+  if (!hist) {
+    return 0;
+  }
+
+  Long64_t bytes = 0;
+  for (Int_t step = 0; step < hist->getNSteps(); step++) {
+    Long64_t stepBytes = 0;
+    for (TArray* array : {hist->getValues(step), hist->getSumw2(step)}) {
+      if (array) {
+        stepBytes += array->GetSize() * (dynamic_cast<TArrayD*>(array) ? sizeof(Double_t) : sizeof(Float_t));
+      }
+    }
+    if (verbose && stepBytes > 0) {
+      LOGF(info, "  %s step %d: %.1f MB", hist->GetName(), step, stepBytes / 1024. / 1024.);
+    }
+    bytes += stepBytes;
+  }
+  return bytes;
+}
+
+//____________________________________________________________________
+void CorrelationContainer::printMemoryUsage()
+{
+  // prints the memory of the allocated steps of the histograms
+
+  LOGF(info, "Memory of the allocated steps of CorrelationContainer %s:", GetName());
+  const Long64_t bytes = getAllocatedMemory(mPairHist, kTRUE) + getAllocatedMemory(mTriggerHist, kTRUE) + getAllocatedMemory(mTrackHistEfficiency, kTRUE);
+  LOGF(info, "  total: %.1f MB", bytes / 1024. / 1024.);
+}
+
 //_____________________________________________________________________________
 CorrelationContainer::CorrelationContainer(const CorrelationContainer& c) : TNamed(c),
                                                                             mPairHist(nullptr),
@@ -1625,17 +1679,14 @@ void CorrelationContainer::Scale(Double_t factor)
 void CorrelationContainer::Reset()
 {
   // resets all contained histograms
+  // steps which were never filled are skipped, as getTHn would create a dense target for them
 
-  for (Int_t step = 0; step < mPairHist->getNSteps(); step++) {
-    mPairHist->getTHn(step)->Reset();
-  }
-
-  for (Int_t step = 0; step < mTriggerHist->getNSteps(); step++) {
-    mTriggerHist->getTHn(step)->Reset();
-  }
-
-  for (Int_t step = 0; step < mTrackHistEfficiency->getNSteps(); step++) {
-    mTrackHistEfficiency->getTHn(step)->Reset();
+  for (StepTHn* hist : {mPairHist, mTriggerHist, mTrackHistEfficiency}) {
+    for (Int_t step = 0; step < hist->getNSteps(); step++) {
+      if (hist->getValues(step)) {
+        hist->getTHn(step)->Reset();
+      }
+    }
   }
 }
 
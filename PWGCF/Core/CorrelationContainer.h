@@ -140,6 +140,9 @@ class CorrelationContainer : public TNamed
 
   void setGetMultCache(Bool_t flag = kTRUE) { mGetMultCacheOn = flag; }
 
+  static Long64_t getAllocatedMemory(StepTHn* hist, Bool_t verbose = kFALSE);
+  void printMemoryUsage();
+
   CorrelationContainer(const CorrelationContainer& c);
   CorrelationContainer& operator=(const CorrelationContainer& corr);
   virtual void Copy(TObject& c) const; // NOLINT: Making this override breaks compilation for unknown reason
@@ -152,6 +155,7 @@ class CorrelationContainer : public TNamed
  protected:
   void weightHistogram(TH3* hist1, TH1* hist2);
   void multiplyHistograms(THnBase* grid, THnBase* target, TH1* histogram, Int_t var1, Int_t var2);
+  static void logStepMemory(const char* histName, const std::vector<o2::framework::AxisSpec>& axes, Long64_t bytesPerCell);
 
   StepTHn* mPairHist;            // container for pair level distributions at all analysis steps
   StepTHn* mTriggerHist;         // container for "trigger" particle (single-particle) level distribution at all analysis steps
@@ -72,17 +72,29 @@ class PairCuts
 
   HistogramRegistry* histogramRegistry = nullptr; // if set, control histograms are stored here
 
+  /// Approximate kinematics of a pair which do not depend on the mass hypotheses, computed once per pair in conversionCuts
+  struct FastPairKinematics {
+    float tantheta1;
+    float tantheta2;
+    float cosDeltaPhi;
+  };
+
   template <typename T>
-  bool conversionCut(T const& track1, T const& track2, Particle conv, double cut);
+  bool conversionCut(T const& track1, T const& track2, FastPairKinematics const& kinematics, Particle conv, double cut);
 
   template <typename T>
   double getInvMassSquared(T const& track1, double m0_1, T const& track2, double m0_2);
 
   template <typename T>
-  double getInvMassSquaredFast(T const& track1, double m0_1, T const& track2, double m0_2);
+  FastPairKinematics getFastPairKinematics(T const& track1, T const& track2);
+
+  template <typename T>
+  double getInvMassSquaredFast(T const& track1, double m0_1, T const& track2, double m0_2, FastPairKinematics const& kinematics);
 
   template <typename T>
   float getDPhiStar(T const& track1, T const& track2, float radius, int magField);
+
+  float getDPhiStar(float deltaPhi, double bFactor, int charge1, float pt1, int charge2, float pt2, float radius);
 };
 
 template <typename T>
@@ -93,14 +105,17 @@ bool PairCuts::conversionCuts(T const& track1, T const& track2)
     return false;
   }
 
+  const FastPairKinematics kinematics = getFastPairKinematics(track1, track2);
+  const FastPairKinematics kinematicsSwapped{kinematics.tantheta2, kinematics.tantheta1, kinematics.cosDeltaPhi};
+
   for (int i = 0; i < static_cast<int>(ParticlesLastEntry); i++) {
     Particle particle = static_cast<Particle>(i);
     if (mCuts[i] > 0) {
-      if (conversionCut(track1, track2, particle, mCuts[i])) {
+      if (conversionCut(track1, track2, kinematics, particle, mCuts[i])) {
         return true;
       }
       if (particle == Lambda) {
-        if (conversionCut(track2, track1, particle, mCuts[i])) {
+        if (conversionCut(track2, track1, kinematicsSwapped, particle, mCuts[i])) {
           return true;
         }
       }
@@ -129,10 +144,18 @@ bool PairCuts::twoTrackCut(T const& track1, T const& track2, int magField)
     const float kLimit = mTwoTrackDistance * 3;
 
     if (std::fabs(dphistar1) < kLimit || std::fabs(dphistar2) < kLimit || dphistar1 * dphistar2 < 0) {
+      // the track quantities are read once for the scan in radius
+      const float deltaPhi = track1.phi() - track2.phi();
+      const double bFactor = 0.015 * magField;
+      const int charge1 = track1.sign();
+      const int charge2 = track2.sign();
+      const float pt1 = track1.pt();
+      const float pt2 = track2.pt();
+
       float dphistarminabs = 1e5;
       float dphistarmin = 1e5;
       for (Double_t rad = mTwoTrackRadius; rad < 2.51; rad += 0.01) {
-        float dphistar = getDPhiStar(track1, track2, rad, magField);
+        float dphistar = getDPhiStar(deltaPhi, bFactor, charge1, pt1, charge2, pt2, rad);
 
         float dphistarabs = std::fabs(dphistar);
 
@@ -161,7 +184,7 @@ bool PairCuts::twoTrackCut(T const& track1, T const& track2, int magField)
 }
 
 template <typename T>
-bool PairCuts::conversionCut(T const& track1, T const& track2, Particle conv, double cut)
+bool PairCuts::conversionCut(T const& track1, T const& track2, FastPairKinematics const& kinematics, Particle conv, double cut)
 {
   //LOGF(info, "pt is %f %f", track1.pt(), track2.pt());
 
@@ -203,7 +226,7 @@ bool PairCuts::conversionCut(T const& track1, T const& track2, Particle conv, do
       break;
   }
 
-  auto massC = getInvMassSquaredFast(track1, massD1, track2, massD2);
+  auto massC = getInvMassSquaredFast(track1, massD1, track2, massD2, kinematics);
 
   if (std::fabs(massC - massM * massM) > cut * 5) {
     return false;
@@ -257,16 +280,14 @@ double PairCuts::getInvMassSquared(T const& track1, double m0_1, T const& track2
 }
 
 template <typename T>
-double PairCuts::getInvMassSquaredFast(T const& track1, double m0_1, T const& track2, double m0_2)
+PairCuts::FastPairKinematics PairCuts::getFastPairKinematics(T const& track1, T const& track2)
 {
-  // calculate inv mass squared approximately
+  // approximate tan(theta) of the tracks and cos(delta phi) of the pair, common to all the mass hypotheses
 
   const float eta1 = track1.eta();
   const float eta2 = track2.eta();
   const float phi1 = track1.phi();
   const float phi2 = track2.phi();
-  const float pt1 = track1.pt();
-  const float pt2 = track2.pt();
 
   float tantheta1 = 1e10f;
 
@@ -281,9 +302,6 @@ double PairCuts::getInvMassSquaredFast(T const& track1, double m0_1, T const& tr
     tantheta2 = 2.0f * expTmp / (1.0f - expTmp * expTmp);
   }
 
-  float e1squ = m0_1 * m0_1 + pt1 * pt1 * (1.0f + 1.0f / tantheta1 / tantheta1);
-  float e2squ = m0_2 * m0_2 + pt2 * pt2 * (1.0f + 1.0f / tantheta2 / tantheta2);
-
   // fold onto 0...pi
   float deltaPhi = std::fabs(phi1 - phi2);
   while (deltaPhi > TwoPI) {
@@ -302,7 +320,23 @@ double PairCuts::getInvMassSquaredFast(T const& track1, double m0_1, T const& tr
     cosDeltaPhi = -1.0f + 1.0f / 2.0f * (deltaPhi - PI) * (deltaPhi - PI) - 1.0f / 24.0f * std::pow(deltaPhi - PI, 4.0f);
   }
 
-  double mass2 = m0_1 * m0_1 + m0_2 * m0_2 + 2.0f * (std::sqrt(e1squ * e2squ) - (pt1 * pt2 * (cosDeltaPhi + 1.0f / tantheta1 / tantheta2)));
+  return {tantheta1, tantheta2, cosDeltaPhi};
+}
+
+template <typename T>
+double PairCuts::getInvMassSquaredFast(T const& track1, double m0_1, T const& track2, double m0_2, FastPairKinematics const& kinematics)
+{
+  // calculate inv mass squared approximately
+
+  const float pt1 = track1.pt();
+  const float pt2 = track2.pt();
+  const float tantheta1 = kinematics.tantheta1;
+  const float tantheta2 = kinematics.tantheta2;
+
+  float e1squ = m0_1 * m0_1 + pt1 * pt1 * (1.0f + 1.0f / tantheta1 / tantheta1);
+  float e2squ = m0_2 * m0_2 + pt2 * pt2 * (1.0f + 1.0f / tantheta2 / tantheta2);
+
+  double mass2 = m0_1 * m0_1 + m0_2 * m0_2 + 2.0f * (std::sqrt(e1squ * e2squ) - (pt1 * pt2 * (kinematics.cosDeltaPhi + 1.0f / tantheta1 / tantheta2)));
 
   //LOGF(debug, "%f %f %f %f %f %f %f %f %f", pt1, eta1, phi1, pt2, eta2, phi2, m0_1, m0_2, mass2);
 
@@ -316,15 +350,17 @@ float PairCuts::getDPhiStar(T const& track1, T const& track2, float radius, int
   // calculates dphistar
   //
 
-  auto phi1 = track1.phi();
-  auto pt1 = track1.pt();
-  auto charge1 = track1.sign();
+  return getDPhiStar(track1.phi() - track2.phi(), 0.015 * magField, track1.sign(), track1.pt(), track2.sign(), track2.pt(), radius);
+}
 
-  auto phi2 = track2.phi();
-  auto pt2 = track2.pt();
-  auto charge2 = track2.sign();
+inline float PairCuts::getDPhiStar(float deltaPhi, double bFactor, int charge1, float pt1, int charge2, float pt2, float radius)
+{
+  //
+  // calculates dphistar from the quantities of the two tracks
+  //   bFactor: 0.015 * B field in kG
+  //
 
-  float dphistar = phi1 - phi2 - charge1 * std::asin(0.015 * magField * radius / pt1) + charge2 * std::asin(0.015 * magField * radius / pt2);
+  float dphistar = deltaPhi - charge1 * std::asin(bFactor * radius / pt1) + charge2 * std::asin(bFactor * radius / pt2);
 
   if (dphistar > PI) {
     dphistar = TwoPI - dphistar;
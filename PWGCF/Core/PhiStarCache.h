@@ -0,0 +1,81 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file PhiStarCache.h
+/// \brief Cache of the azimuth phi* of particles at a set of TPC radii, for the close pair rejection of the femtoscopy
+///        analyses. A particle takes part in many pairs of the same and of the mixed events, while its phi* only
+///        depends on its phi, pt and charge and on the magnetic field: they are computed at the first lookup only.
+
+#ifndef PWGCF_CORE_PHISTARCACHE_H_
+#define PWGCF_CORE_PHISTARCACHE_H_
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace o2::analysis
+{
+
+/// \class PhiStarCache
+/// \brief Direct-mapped cache of phi* arrays, indexed by a particle key, e.g. its global index
+/// An entry is used only if the key, phi, pt, charge and magnetic field are those it was computed with, otherwise it is
+/// recomputed. The cache thus needs no reset between collisions or dataframes and its memory is fixed.
+/// \tparam NRadii number of radii
+/// \tparam NSlots number of entries, which should exceed the number of particles of a collision
+template <std::size_t NRadii, std::size_t NSlots = 1024>
+class PhiStarCache
+{
+ public:
+  using PhiStars = std::array<float, NRadii>;
+
+  /// phi* of a particle
+  /// \param key index of the particle, unique within a dataframe
+  /// \param compute callable filling a PhiStars with the phi* of the particle, called if the entry is not valid
+  /// \return copy of the entry, which can be overwritten by the next lookup
+  template <typename F>
+  PhiStars get(int64_t key, float phi, float pt, int charge, float magField, F&& compute)
+  {
+    Entry& entry = mEntries[static_cast<uint64_t>(key) % NSlots];
+    if (entry.key != key || entry.phi != phi || entry.pt != pt || entry.charge != charge || entry.magField != magField) {
+      entry.key = key;
+      entry.phi = phi;
+      entry.pt = pt;
+      entry.charge = charge;
+      entry.magField = magField;
+      compute(entry.phiStars);
+    }
+    return entry.phiStars;
+  }
+
+  /// Invalidates all the entries
+  void clear()
+  {
+    for (auto& entry : mEntries) {
+      entry.key = -1;
+    }
+  }
+
+ private:
+  struct Entry {
+    int64_t key = -1;     ///< key of the particle, -1 if empty
+    float phi = 0.f;      ///< azimuth at the primary vertex
+    float pt = 0.f;       ///< transverse momentum
+    int charge = 0;       ///< charge
+    float magField = 0.f; ///< magnetic field
+    PhiStars phiStars{};  ///< phi* at the radii
+  };
+
+  std::vector<Entry> mEntries = std::vector<Entry>(NSlots);
+};
+
+} // namespace o2::analysis
+
+#endif // PWGCF_CORE_PHISTARCACHE_H_
@@ -185,6 +185,34 @@ struct RobustFluctuationObservables {
   map<string, int> mPtStudyCuts;
   vector<std::shared_ptr<TH1>> pHistPtStudy1D;
 
+  // pt study histograms resolved once in init, so that the per-track fills need no string building and map lookups
+  enum PtStudyTrackType { kPtAll = 0,
+                          kPtGlobal,
+                          kPtITS7hits,
+                          kPtITS7hitsTPC80cl,
+                          kPtITS4567,
+                          kPtITS4567TPC80cl,
+                          kPtITS567,
+                          kPtITS567TPC80cl,
+                          kPtITS67,
+                          kPtITS67TPC80cl,
+                          kNPtStudyTrackTypes };
+  enum PtStudyEvSel { kPtAllBC = 0,
+                      kPtTFborder,
+                      kPtNoTFborder,
+                      kPtROFborder,
+                      kPtNoROFborder,
+                      kPtNoTFandROFborder,
+                      kNPtStudyEvSels };
+  enum PtStudyHist { kPtHist = 0,
+                     kPtHistWnTPCcls,
+                     kPosPtHist,
+                     kPosPtHistWnTPCcls,
+                     kNegPtHist,
+                     kNegPtHistWnTPCcls,
+                     kNPtStudyHists };
+  TH1* pPtStudyHists[kNPtStudyTrackTypes][kNPtStudyEvSels][kNPtStudyHists] = {{{nullptr}}};
+
   //
   TF1* funcCutEventsByMultPVvsV0A;
   TF1* funcCutEventsByMultPVvsT0C;
@@ -712,6 +740,22 @@ struct RobustFluctuationObservables {
         ADD_PT_HIST_1D("ITS67_TPC80cl", cutName, "", axisLogPt);
       }
     }
+    {
+      string strPtStudyTrackTypes[kNPtStudyTrackTypes] = {"All", "Global", "ITS7hits", "ITS7hits_TPC80cl", "ITS4567", "ITS4567_TPC80cl", "ITS567", "ITS567_TPC80cl", "ITS67", "ITS67_TPC80cl"};
+      if (nFolderPt != kNPtStudyEvSels || nCutsPtQA != kNPtStudyHists) {
+        LOGF(fatal, "AHTUNG! the pt study enums do not match the pt study histogram names!");
+      }
+      for (int t = 0; t < kNPtStudyTrackTypes; t++) {
+        for (int i = 0; i < nFolderPt; i++) {
+          for (int j = 0; j < nCutsPtQA; j++) {
+            string fullName = strPtStudyTrackTypes[t] + "/" + strPtSelFolderNames[i] + "/" + strPtSelNames[j];
+            if (!mPtStudyCuts.count(fullName))
+              LOGF(fatal, "AHTUNG! no key %s in mPtStudyCuts map!", fullName);
+            pPtStudyHists[t][i][j] = pHistPtStudy1D[mPtStudyCuts[fullName]].get();
+          }
+        }
+      }
+    }
     // ### end of detailed pt study
 
     histosTracks.add("phiHistogram", "phiHistogram", kTH1D, {axisPhi});
@@ -1955,29 +1999,29 @@ struct RobustFluctuationObservables {
         bool noTF = collision.selection_bit(o2::aod::evsel::kNoTimeFrameBorder);
         bool noROF = collision.selection_bit(o2::aod::evsel::kNoITSROFrameBorder);
 
-        fillPtHistos("All", track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
+        fillPtHistos(kPtAll, track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
         if (track.isGlobalTrack())
-          fillPtHistos("Global", track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
+          fillPtHistos(kPtGlobal, track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
 
         if (track.itsNCls() == 7)
-          fillPtHistos("ITS7hits", track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
+          fillPtHistos(kPtITS7hits, track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
         if (track.itsNCls() == 7 && track.tpcNClsFound() >= 80)
-          fillPtHistos("ITS7hits_TPC80cl", track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
+          fillPtHistos(kPtITS7hitsTPC80cl, track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
 
         if (track.itsNCls() >= 4)
-          fillPtHistos("ITS4567", track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
+          fillPtHistos(kPtITS4567, track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
         if (track.itsNCls() >= 4 && track.tpcNClsFound() >= 80)
-          fillPtHistos("ITS4567_TPC80cl", track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
+          fillPtHistos(kPtITS4567TPC80cl, track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
 
         if (track.itsNCls() >= 5)
-          fillPtHistos("ITS567", track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
+          fillPtHistos(kPtITS567, track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
         if (track.itsNCls() >= 5 && track.tpcNClsFound() >= 80)
-          fillPtHistos("ITS567_TPC80cl", track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
+          fillPtHistos(kPtITS567TPC80cl, track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
 
         if (track.itsNCls() >= 6)
-          fillPtHistos("ITS67", track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
+          fillPtHistos(kPtITS67, track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
         if (track.itsNCls() >= 6 && track.tpcNClsFound() >= 80)
-          fillPtHistos("ITS67_TPC80cl", track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
+          fillPtHistos(kPtITS67TPC80cl, track.pt(), track.sign(), track.tpcNClsFound(), noTF, noROF);
 
       } // #### end of detailed pt study:
 
@@ -2333,40 +2377,40 @@ struct RobustFluctuationObservables {
     // }
   }
 
-  void fillPtHistos(string strTrackType, float pt, int charge, float w, bool noTF, bool noROF)
+  void fillPtHistos(PtStudyTrackType trackType, float pt, int charge, float w, bool noTF, bool noROF)
   {
-    fillPtHistosThisCut(strTrackType, "allBC", pt, charge, w);
+    fillPtHistosThisCut(trackType, kPtAllBC, pt, charge, w);
 
     // TF
     if (noTF)
-      fillPtHistosThisCut(strTrackType, "noTFborder", pt, charge, w);
+      fillPtHistosThisCut(trackType, kPtNoTFborder, pt, charge, w);
     else
-      fillPtHistosThisCut(strTrackType, "TFborder", pt, charge, w);
+      fillPtHistosThisCut(trackType, kPtTFborder, pt, charge, w);
 
     // ROF
     if (noROF)
-      fillPtHistosThisCut(strTrackType, "noROFborder", pt, charge, w);
+      fillPtHistosThisCut(trackType, kPtNoROFborder, pt, charge, w);
     else
-      fillPtHistosThisCut(strTrackType, "ROFborder", pt, charge, w);
+      fillPtHistosThisCut(trackType, kPtROFborder, pt, charge, w);
 
     // TF, ROF
     if (noTF && noROF)
-      fillPtHistosThisCut(strTrackType, "noTFandROFborder", pt, charge, w);
+      fillPtHistosThisCut(trackType, kPtNoTFandROFborder, pt, charge, w);
   }
 
-  void fillPtHistosThisCut(string strTrackType, string strEvSelType, float pt, int charge, float w)
+  void fillPtHistosThisCut(PtStudyTrackType trackType, PtStudyEvSel evSelType, float pt, int charge, float w)
   {
-    string strPre = strTrackType + "/" + strEvSelType;
+    TH1** hists = pPtStudyHists[trackType][evSelType];
 
-    FILL_PT_HIST_1D(strPre + "/pt", pt, 1);
-    FILL_PT_HIST_1D(strPre + "/pt_w_nTPCcls", pt, w);
+    hists[kPtHist]->Fill(pt, 1);
+    hists[kPtHistWnTPCcls]->Fill(pt, w);
 
     if (charge > 0) {
-      FILL_PT_HIST_1D(strPre + "/pos_pt", pt, 1);
-      FILL_PT_HIST_1D(strPre + "/pos_pt_w_nTPCcls", pt, w);
+      hists[kPosPtHist]->Fill(pt, 1);
+      hists[kPosPtHistWnTPCcls]->Fill(pt, w);
     } else {
-      FILL_PT_HIST_1D(strPre + "/neg_pt", pt, 1);
-      FILL_PT_HIST_1D(strPre + "/neg_pt_w_nTPCcls", pt, w);
+      hists[kNegPtHist]->Fill(pt, 1);
+      hists[kNegPtHistWnTPCcls]->Fill(pt, w);
     }
   }
 
@@ -176,14 +176,33 @@ class FemtoPair
   {
     _first = first;
     _second = second;
+    _4momentaSet = false;
+  }
+  void SetFirstParticle(TrackType const& first)
+  {
+    _first = first;
+    _4momentaSet = false;
+  }
+  void SetSecondParticle(TrackType const& second)
+  {
+    _second = second;
+    _4momentaSet = false;
   }
-  void SetFirstParticle(TrackType const& first) { _first = first; }
-  void SetSecondParticle(TrackType const& second) { _second = second; }
   void SetIdentical(const bool& isidentical) { _isidentical = isidentical; }
   void SetMagField1(const float& magfield1) { _magfield1 = magfield1; }
   void SetMagField2(const float& magfield2) { _magfield2 = magfield2; }
-  void SetPDG1(const int& PDG1) { _PDG1 = PDG1; }
-  void SetPDG2(const int& PDG2) { _PDG2 = PDG2; }
+  void SetPDG1(const int& PDG1)
+  {
+    _PDG1 = PDG1;
+    _mass1 = PDG1 != 0 ? particle_mass(PDG1) : 0.0; // the mass is looked up once instead of once per pair
+    _4momentaSet = false;
+  }
+  void SetPDG2(const int& PDG2)
+  {
+    _PDG2 = PDG2;
+    _mass2 = PDG2 != 0 ? particle_mass(PDG2) : 0.0;
+    _4momentaSet = false;
+  }
   int GetPDG1() { return _PDG1; }
   int GetPDG2() { return _PDG2; }
   void ResetPair();
@@ -224,6 +243,12 @@ class FemtoPair
   int _PDG1 = 0, _PDG2 = 0;
   bool _isidentical = true;
   std::array<float, 9> TPCradii = {0.85, 1.05, 1.25, 1.45, 1.65, 1.85, 2.05, 2.25, 2.45};
+
+  // the four-momenta of the pair are built at most once per pair and shared by GetKstar, GetQLCMS and GetMt
+  void Set4momenta() const;
+  double _mass1 = 0.0, _mass2 = 0.0;
+  mutable bool _4momentaSet = false;
+  mutable TLorentzVector _first4momentum, _second4momentum;
 };
 
 template <typename TrackType>
@@ -231,6 +256,7 @@ void FemtoPair<TrackType>::ResetPair()
 {
   _first = NULL;
   _second = NULL;
+  _4momentaSet = false;
 }
 
 template <typename TrackType>
@@ -242,7 +268,20 @@ void FemtoPair<TrackType>::ResetAll()
   _magfield2 = 0.0;
   _PDG1 = 0;
   _PDG2 = 0;
+  _mass1 = 0.0;
+  _mass2 = 0.0;
   _isidentical = true;
+  _4momentaSet = false;
+}
+
+template <typename TrackType>
+void FemtoPair<TrackType>::Set4momenta() const
+{
+  if (_4momentaSet)
+    return;
+  _first4momentum.SetPtEtaPhiM(_first->pt(), _first->eta(), _first->phi(), _mass1);
+  _second4momentum.SetPtEtaPhiM(_second->pt(), _second->eta(), _second->phi(), _mass2);
+  _4momentaSet = true;
 }
 
 template <typename TrackType>
@@ -288,12 +327,9 @@ float FemtoPair<TrackType>::GetKstar() const
   if (_PDG1 * _PDG2 == 0)
     return -1000;
 
-  TLorentzVector first4momentum;
-  first4momentum.SetPtEtaPhiM(_first->pt(), _first->eta(), _first->phi(), particle_mass(_PDG1));
-  TLorentzVector second4momentum;
-  second4momentum.SetPtEtaPhiM(_second->pt(), _second->eta(), _second->phi(), particle_mass(_PDG2));
+  Set4momenta();
 
-  return GetKstarFrom4vectors(first4momentum, second4momentum, _isidentical);
+  return GetKstarFrom4vectors(_first4momentum, _second4momentum, _isidentical);
 }
 
 template <typename TrackType>
@@ -306,12 +342,9 @@ TVector3 FemtoPair<TrackType>::GetQLCMS() const
   if (_PDG1 * _PDG2 == 0)
     return TVector3(-1000, -1000, -1000);
 
-  TLorentzVector first4momentum;
-  first4momentum.SetPtEtaPhiM(_first->pt(), _first->eta(), _first->phi(), particle_mass(_PDG1));
-  TLorentzVector second4momentum;
-  second4momentum.SetPtEtaPhiM(_second->pt(), _second->eta(), _second->phi(), particle_mass(_PDG2));
+  Set4momenta();
 
-  return GetQLCMSFrom4vectors(first4momentum, second4momentum);
+  return GetQLCMSFrom4vectors(_first4momentum, _second4momentum);
 }
 
 template <typename TrackType>
@@ -337,12 +370,9 @@ float FemtoPair<TrackType>::GetMt() const
   if (_PDG1 * _PDG2 == 0)
     return -1000;
 
-  TLorentzVector first4momentum;
-  first4momentum.SetPtEtaPhiM(_first->pt(), _first->eta(), _first->phi(), particle_mass(_PDG1));
-  TLorentzVector second4momentum;
-  second4momentum.SetPtEtaPhiM(_second->pt(), _second->eta(), _second->phi(), particle_mass(_PDG2));
+  Set4momenta();
 
-  TLorentzVector fourmomentasum = first4momentum + second4momentum;
+  TLorentzVector fourmomentasum = _first4momentum + _second4momentum;
 
   return 0.5 * fourmomentasum.Mt();
 }
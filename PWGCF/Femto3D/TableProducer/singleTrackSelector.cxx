@@ -115,6 +115,7 @@ struct singleTrackSelector {
 
   void init(InitContext&)
   {
+    mRateFetcher.setUseRateTables();
 
     particlesToKeep = _particlesToKeep;
     particlesToReject = _particlesToReject;
@@ -20,6 +20,8 @@
 #define PWGCF_FEMTODREAM_CORE_FEMTODREAMCONTAINER_H_
 
 #include <fairlogger/Logger.h>
+#include <array>
+#include <memory>
 #include <vector>
 #include <string>
 
@@ -70,35 +72,36 @@ class FemtoDreamContainer
   /// \param kTAxis axis object for the kT axis
   /// \param mTAxis axis object for the mT axis
 
-  template <bool isHF = false, typename T>
+  template <o2::aod::femtodreamMCparticle::MCType mc, bool isHF = false, typename T>
   void init_base(std::string folderName, std::string femtoObs,
                  T& femtoObsAxis, T& pTAxis, T& kTAxis, T& mTAxis, T& multAxis, T& multPercentileAxis,
                  T& /*kstarAxis4D*/, T& mTAxis4D, T& multAxis4D, T& multPercentileAxis4D,
                  bool use4dplots, bool extendedplots, T& mP2Axis)
   {
+    auto& hists = mPairHistograms[mc];
 
     if constexpr (isHF) {
-      mHistogramRegistry->add((folderName + "/relPairkstarmP2").c_str(), ("; " + femtoObs + "; Mass (GeV)").c_str(), kTH2F, {femtoObsAxis, mP2Axis});
+      hists.relPairkstarmP2 = mHistogramRegistry->add<TH2>((folderName + "/relPairkstarmP2").c_str(), ("; " + femtoObs + "; Mass (GeV)").c_str(), kTH2F, {femtoObsAxis, mP2Axis});
     }
 
-    mHistogramRegistry->add((folderName + "/relPairDist").c_str(), ("; " + femtoObs + "; Entries").c_str(), kTH1F, {femtoObsAxis});
-    mHistogramRegistry->add((folderName + "/relPairkT").c_str(), "; #it{k}_{T} (GeV/#it{c}); Entries", kTH1F, {kTAxis});
-    mHistogramRegistry->add((folderName + "/relPairkstarkT").c_str(), ("; " + femtoObs + "; #it{k}_{T} (GeV/#it{c})").c_str(), kTH2F, {femtoObsAxis, kTAxis});
-    mHistogramRegistry->add((folderName + "/relPairkstarmT").c_str(), ("; " + femtoObs + "; #it{m}_{T} (GeV/#it{c}^{2})").c_str(), kTH2F, {femtoObsAxis, mTAxis});
-    mHistogramRegistry->add((folderName + "/relPairkstarMult").c_str(), ("; " + femtoObs + "; Multiplicity").c_str(), kTH2F, {femtoObsAxis, multAxis});
-    mHistogramRegistry->add((folderName + "/relPairkstarMultPercentile").c_str(), ("; " + femtoObs + "; Multiplicity Percentile").c_str(), kTH2F, {femtoObsAxis, multPercentileAxis4D});
-    mHistogramRegistry->add((folderName + "/kstarPtPart1").c_str(), ("; " + femtoObs + "; #it{p} _{T} Particle 1 (GeV/#it{c})").c_str(), kTH2F, {femtoObsAxis, pTAxis});
-    mHistogramRegistry->add((folderName + "/kstarPtPart2").c_str(), ("; " + femtoObs + "; #it{p} _{T} Particle 2 (GeV/#it{c})").c_str(), kTH2F, {femtoObsAxis, pTAxis});
-    mHistogramRegistry->add((folderName + "/MultPtPart1").c_str(), "; #it{p} _{T} Particle 1 (GeV/#it{c}); Multiplicity", kTH2F, {pTAxis, multAxis});
-    mHistogramRegistry->add((folderName + "/MultPtPart2").c_str(), "; #it{p} _{T} Particle 2 (GeV/#it{c}); Multiplicity", kTH2F, {pTAxis, multAxis});
-    mHistogramRegistry->add((folderName + "/MultPercentilePtPart1").c_str(), "; #it{p} _{T} Particle 1 (GeV/#it{c}); Multiplicity Percentile", kTH2F, {pTAxis, multPercentileAxis});
-    mHistogramRegistry->add((folderName + "/MultPercentilePtPart2").c_str(), "; #it{p} _{T} Particle 2 (GeV/#it{c}); Multiplicity Percentile", kTH2F, {pTAxis, multPercentileAxis});
-    mHistogramRegistry->add((folderName + "/PtPart1PtPart2").c_str(), "; #it{p} _{T} Particle 1 (GeV/#it{c}); #it{p} _{T} Particle 2 (GeV/#it{c})", kTH2F, {pTAxis, pTAxis});
+    hists.relPairDist = mHistogramRegistry->add<TH1>((folderName + "/relPairDist").c_str(), ("; " + femtoObs + "; Entries").c_str(), kTH1F, {femtoObsAxis});
+    hists.relPairkT = mHistogramRegistry->add<TH1>((folderName + "/relPairkT").c_str(), "; #it{k}_{T} (GeV/#it{c}); Entries", kTH1F, {kTAxis});
+    hists.relPairkstarkT = mHistogramRegistry->add<TH2>((folderName + "/relPairkstarkT").c_str(), ("; " + femtoObs + "; #it{k}_{T} (GeV/#it{c})").c_str(), kTH2F, {femtoObsAxis, kTAxis});
+    hists.relPairkstarmT = mHistogramRegistry->add<TH2>((folderName + "/relPairkstarmT").c_str(), ("; " + femtoObs + "; #it{m}_{T} (GeV/#it{c}^{2})").c_str(), kTH2F, {femtoObsAxis, mTAxis});
+    hists.relPairkstarMult = mHistogramRegistry->add<TH2>((folderName + "/relPairkstarMult").c_str(), ("; " + femtoObs + "; Multiplicity").c_str(), kTH2F, {femtoObsAxis, multAxis});
+    hists.relPairkstarMultPercentile = mHistogramRegistry->add<TH2>((folderName + "/relPairkstarMultPercentile").c_str(), ("; " + femtoObs + "; Multiplicity Percentile").c_str(), kTH2F, {femtoObsAxis, multPercentileAxis4D});
+    hists.kstarPtPart1 = mHistogramRegistry->add<TH2>((folderName + "/kstarPtPart1").c_str(), ("; " + femtoObs + "; #it{p} _{T} Particle 1 (GeV/#it{c})").c_str(), kTH2F, {femtoObsAxis, pTAxis});
+    hists.kstarPtPart2 = mHistogramRegistry->add<TH2>((folderName + "/kstarPtPart2").c_str(), ("; " + femtoObs + "; #it{p} _{T} Particle 2 (GeV/#it{c})").c_str(), kTH2F, {femtoObsAxis, pTAxis});
+    hists.MultPtPart1 = mHistogramRegistry->add<TH2>((folderName + "/MultPtPart1").c_str(), "; #it{p} _{T} Particle 1 (GeV/#it{c}); Multiplicity", kTH2F, {pTAxis, multAxis});
+    hists.MultPtPart2 = mHistogramRegistry->add<TH2>((folderName + "/MultPtPart2").c_str(), "; #it{p} _{T} Particle 2 (GeV/#it{c}); Multiplicity", kTH2F, {pTAxis, multAxis});
+    hists.MultPercentilePtPart1 = mHistogramRegistry->add<TH2>((folderName + "/MultPercentilePtPart1").c_str(), "; #it{p} _{T} Particle 1 (GeV/#it{c}); Multiplicity Percentile", kTH2F, {pTAxis, multPercentileAxis});
+    hists.MultPercentilePtPart2 = mHistogramRegistry->add<TH2>((folderName + "/MultPercentilePtPart2").c_str(), "; #it{p} _{T} Particle 2 (GeV/#it{c}); Multiplicity Percentile", kTH2F, {pTAxis, multPercentileAxis});
+    hists.PtPart1PtPart2 = mHistogramRegistry->add<TH2>((folderName + "/PtPart1PtPart2").c_str(), "; #it{p} _{T} Particle 1 (GeV/#it{c}); #it{p} _{T} Particle 2 (GeV/#it{c})", kTH2F, {pTAxis, pTAxis});
     if (use4dplots) {
-      mHistogramRegistry->add((folderName + "/relPairkstarmTMultMultPercentile").c_str(), ("; " + femtoObs + "; #it{m}_{T} (GeV/#it{c}^{2}); Multiplicity").c_str(), kTHnSparseF, {femtoObsAxis, mTAxis4D, multAxis4D, multPercentileAxis4D});
+      hists.relPairkstarmTMultMultPercentile = mHistogramRegistry->add<THnSparse>((folderName + "/relPairkstarmTMultMultPercentile").c_str(), ("; " + femtoObs + "; #it{m}_{T} (GeV/#it{c}^{2}); Multiplicity").c_str(), kTHnSparseF, {femtoObsAxis, mTAxis4D, multAxis4D, multPercentileAxis4D});
     }
     if (extendedplots) {
-      mHistogramRegistry->add((folderName + "/relPairkstarmTPtPart1PtPart2MultPercentile").c_str(), ("; :" + femtoObs + "; #it{m}_{T} (GeV/#it{c}^{2}); #it{p} _{T} Particle 1 (GeV/#it{c}); #it{p} _{T} Particle 2 (GeV/#it{c}); Multiplicity Percentile (%)").c_str(), kTHnSparseF, {femtoObsAxis, mTAxis4D, pTAxis, pTAxis, multPercentileAxis4D});
+      hists.relPairkstarmTPtPart1PtPart2MultPercentile = mHistogramRegistry->add<THnSparse>((folderName + "/relPairkstarmTPtPart1PtPart2MultPercentile").c_str(), ("; :" + femtoObs + "; #it{m}_{T} (GeV/#it{c}^{2}); #it{p} _{T} Particle 1 (GeV/#it{c}); #it{p} _{T} Particle 2 (GeV/#it{c}); Multiplicity Percentile (%)").c_str(), kTHnSparseF, {femtoObsAxis, mTAxis4D, pTAxis, pTAxis, multPercentileAxis4D});
     }
   }
 
@@ -165,17 +168,17 @@ class FemtoDreamContainer
 
     std::string folderName = static_cast<std::string>(mFolderSuffix[mEventType]) + static_cast<std::string>(o2::aod::femtodreamMCparticle::MCTypeName[o2::aod::femtodreamMCparticle::MCType::kRecon]);
 
-    init_base<isHF>(folderName, femtoObs,
-                    femtoObsAxis, pTAxis, kTAxis, mTAxis, multAxis, multPercentileAxis,
-                    kstarAxis4D, mTAxis4D, multAxis4D, multPercentileAxis4D,
-                    use4dplots, extendedplots, mP2Axis);
+    init_base<o2::aod::femtodreamMCparticle::MCType::kRecon, isHF>(folderName, femtoObs,
+                                                                  femtoObsAxis, pTAxis, kTAxis, mTAxis, multAxis, multPercentileAxis,
+                                                                  kstarAxis4D, mTAxis4D, multAxis4D, multPercentileAxis4D,
+                                                                  use4dplots, extendedplots, mP2Axis);
 
     if (isMC) {
       folderName = static_cast<std::string>(mFolderSuffix[mEventType]) + static_cast<std::string>(o2::aod::femtodreamMCparticle::MCTypeName[o2::aod::femtodreamMCparticle::MCType::kTruth]);
-      init_base<isHF>(folderName, femtoObs,
-                      femtoObsAxis, pTAxis, kTAxis, mTAxis, multAxis, multPercentileAxis,
-                      kstarAxis4D, mTAxis4D, multAxis4D, multPercentileAxis4D,
-                      use4dplots, extendedplots, mP2Axis);
+      init_base<o2::aod::femtodreamMCparticle::MCType::kTruth, isHF>(folderName, femtoObs,
+                                                                    femtoObsAxis, pTAxis, kTAxis, mTAxis, multAxis, multPercentileAxis,
+                                                                    kstarAxis4D, mTAxis4D, multAxis4D, multPercentileAxis4D,
+                                                                    use4dplots, extendedplots, mP2Axis);
       init_MC(folderName, femtoObs, femtoObsAxis, multAxis, mTAxis, smearingByOrigin);
     }
   }
@@ -198,9 +201,11 @@ class FemtoDreamContainer
   /// \param part2 Particle two
   /// \param mult Multiplicity of the event
   template <o2::aod::femtodreamMCparticle::MCType mc, bool isHF = false, typename T1, typename T2>
-  void setPair_base(const float femtoObs, const float mT, T1 const& part1, T2 const& part2, const int mult, const float multPercentile, bool use4dplots, bool extendedplots)
+  void setPair_base(const float femtoObs, const float kT, const float mT, T1 const& part1, T2 const& part2, const int mult, const float multPercentile, bool use4dplots, bool extendedplots)
   {
-    const float kT = FemtoDreamMath::getkT(part1, mMassOne, part2, mMassTwo);
+    const auto& hists = mPairHistograms[mc];
+    const float pt1 = part1.pt();
+    const float pt2 = part2.pt();
     if constexpr (isHF) {
       float mP2;
       if (part2.candidateSelFlag() == o2::aod::fdhf::lcToPKPi) {
@@ -208,26 +213,28 @@ class FemtoDreamContainer
       } else {
         mP2 = part2.m(std::array{o2::constants::physics::MassPiPlus, o2::constants::physics::MassKPlus, o2::constants::physics::MassProton});
       }
-      mHistogramRegistry->fill(HIST(mFolderSuffix[mEventType]) + HIST(o2::aod::femtodreamMCparticle::MCTypeName[mc]) + HIST("/relPairkstarmP2"), femtoObs, mP2);
+      hists.relPairkstarmP2->Fill(femtoObs, mP2);
     }
-    mHistogramRegistry->fill(HIST(mFolderSuffix[mEventType]) + HIST(o2::aod::femtodreamMCparticle::MCTypeName[mc]) + HIST("/relPairDist"), femtoObs);
-    mHistogramRegistry->fill(HIST(mFolderSuffix[mEventType]) + HIST(o2::aod::femtodreamMCparticle::MCTypeName[mc]) + HIST("/relPairkT"), kT);
-    mHistogramRegistry->fill(HIST(mFolderSuffix[mEventType]) + HIST(o2::aod::femtodreamMCparticle::MCTypeName[mc]) + HIST("/relPairkstarkT"), femtoObs, kT);
-    mHistogramRegistry->fill(HIST(mFolderSuffix[mEventType]) + HIST(o2::aod::femtodreamMCparticle::MCTypeName[mc]) + HIST("/relPairkstarmT"), femtoObs, mT);
-    mHistogramRegistry->fill(HIST(mFolderSuffix[mEventType]) + HIST(o2::aod::femtodreamMCparticle::MCTypeName[mc]) + HIST("/relPairkstarMult"), femtoObs, mult);
-    mHistogramRegistry->fill(HIST(mFolderSuffix[mEventType]) + HIST(o2::aod::femtodreamMCparticle::MCTypeName[mc]) + HIST("/relPairkstarMultPercentile"), femtoObs, multPercentile);
-    mHistogramRegistry->fill(HIST(mFolderSuffix[mEventType]) + HIST(o2::aod::femtodreamMCparticle::MCTypeName[mc]) + HIST("/kstarPtPart1"), femtoObs, part1.pt());
-    mHistogramRegistry->fill(HIST(mFolderSuffix[mEventType]) + HIST(o2::aod::femtodreamMCparticle::MCTypeName[mc]) + HIST("/kstarPtPart2"), femtoObs, part2.pt());
-    mHistogramRegistry->fill(HIST(mFolderSuffix[mEventType]) + HIST(o2::aod::femtodreamMCparticle::MCTypeName[mc]) + HIST("/MultPtPart1"), part1.pt(), mult);
-    mHistogramRegistry->fill(HIST(mFolderSuffix[mEventType]) + HIST(o2::aod::femtodreamMCparticle::MCTypeName[mc]) + HIST("/MultPtPart2"), part2.pt(), mult);
-    mHistogramRegistry->fill(HIST(mFolderSuffix[mEventType]) + HIST(o2::aod::femtodreamMCparticle::MCTypeName[mc]) + HIST("/MultPercentilePtPart1"), part1.pt(), multPercentile);
-    mHistogramRegistry->fill(HIST(mFolderSuffix[mEventType]) + HIST(o2::aod::femtodreamMCparticle::MCTypeName[mc]) + HIST("/MultPercentilePtPart2"), part2.pt(), multPercentile);
-    mHistogramRegistry->fill(HIST(mFolderSuffix[mEventType]) + HIST(o2::aod::femtodreamMCparticle::MCTypeName[mc]) + HIST("/PtPart1PtPart2"), part1.pt(), part2.pt());
-    if (use4dplots) {
-      mHistogramRegistry->fill(HIST(mFolderSuffix[mEventType]) + HIST(o2::aod::femtodreamMCparticle::MCTypeName[mc]) + HIST("/relPairkstarmTMultMultPercentile"), femtoObs, mT, mult, multPercentile);
+    hists.relPairDist->Fill(femtoObs);
+    hists.relPairkT->Fill(kT);
+    hists.relPairkstarkT->Fill(femtoObs, kT);
+    hists.relPairkstarmT->Fill(femtoObs, mT);
+    hists.relPairkstarMult->Fill(femtoObs, mult);
+    hists.relPairkstarMultPercentile->Fill(femtoObs, multPercentile);
+    hists.kstarPtPart1->Fill(femtoObs, pt1);
+    hists.kstarPtPart2->Fill(femtoObs, pt2);
+    hists.MultPtPart1->Fill(pt1, mult);
+    hists.MultPtPart2->Fill(pt2, mult);
+    hists.MultPercentilePtPart1->Fill(pt1, multPercentile);
+    hists.MultPercentilePtPart2->Fill(pt2, multPercentile);
+    hists.PtPart1PtPart2->Fill(pt1, pt2);
+    if (use4dplots && hists.relPairkstarmTMultMultPercentile) {
+      const double values[] = {femtoObs, mT, static_cast<double>(mult), multPercentile};
+      hists.relPairkstarmTMultMultPercentile->Fill(values);
     }
-    if (extendedplots) {
-      mHistogramRegistry->fill(HIST(mFolderSuffix[mEventType]) + HIST(o2::aod::femtodreamMCparticle::MCTypeName[mc]) + HIST("/relPairkstarmTPtPart1PtPart2MultPercentile"), femtoObs, mT, part1.pt(), part2.pt(), multPercentile);
+    if (extendedplots && hists.relPairkstarmTPtPart1PtPart2MultPercentile) {
+      const double values[] = {femtoObs, mT, pt1, pt2, multPercentile};
+      hists.relPairkstarmTPtPart1PtPart2MultPercentile->Fill(values);
     }
   }
 
@@ -265,30 +272,32 @@ class FemtoDreamContainer
   void setPair(T1 const& part1, T2 const& part2, const int mult, const float multPercentile, bool use4dplots, bool extendedplots, bool smearingByOrigin = false)
   {
     float femtoObs, femtoObsMC;
-    // Calculate femto observable and the mT with reconstructed information
+    // Calculate femto observable, kT and mT with reconstructed information
+    const auto kinematics = FemtoDreamMath::getPairKinematics(part1, mMassOne, part2, mMassTwo);
     if constexpr (mFemtoObs == femtoDreamContainer::Observable::kstar) {
-      femtoObs = FemtoDreamMath::getkstar(part1, mMassOne, part2, mMassTwo);
+      femtoObs = kinematics.kstar;
     }
     if (mHighkstarCut > 0) {
       if (femtoObs > mHighkstarCut) {
         return;
       }
     }
-    const float mT = FemtoDreamMath::getmT(part1, mMassOne, part2, mMassTwo);
+    const float mT = kinematics.mT;
 
     if (mHistogramRegistry) {
-      setPair_base<o2::aod::femtodreamMCparticle::MCType::kRecon, isHF>(femtoObs, mT, part1, part2, mult, multPercentile, use4dplots, extendedplots);
+      setPair_base<o2::aod::femtodreamMCparticle::MCType::kRecon, isHF>(femtoObs, kinematics.kT, mT, part1, part2, mult, multPercentile, use4dplots, extendedplots);
 
       if constexpr (isMC) {
         if (part1.has_fdMCParticle() && part2.has_fdMCParticle()) {
-          // calculate the femto observable and the mT with MC truth information
+          // calculate the femto observable, kT and mT with MC truth information
+          const auto kinematicsMC = FemtoDreamMath::getPairKinematics(part1.fdMCParticle(), mMassOne, part2.fdMCParticle(), mMassTwo);
           if constexpr (mFemtoObs == femtoDreamContainer::Observable::kstar) {
-            femtoObsMC = FemtoDreamMath::getkstar(part1.fdMCParticle(), mMassOne, part2.fdMCParticle(), mMassTwo);
+            femtoObsMC = kinematicsMC.kstar;
           }
-          const float mTMC = FemtoDreamMath::getmT(part1.fdMCParticle(), mMassOne, part2.fdMCParticle(), mMassTwo);
+          const float mTMC = kinematicsMC.mT;
 
           if (abs(part1.fdMCParticle().pdgMCTruth()) == mPDGOne && abs(part2.fdMCParticle().pdgMCTruth()) == mPDGTwo) { // Note: all pair-histogramms are filled with MC truth information ONLY in case of non-fake candidates
-            setPair_base<o2::aod::femtodreamMCparticle::MCType::kTruth, isHF>(femtoObsMC, mTMC, part1.fdMCParticle(), part2.fdMCParticle(), mult, multPercentile, use4dplots, extendedplots);
+            setPair_base<o2::aod::femtodreamMCparticle::MCType::kTruth, isHF>(femtoObsMC, kinematicsMC.kT, mTMC, part1.fdMCParticle(), part2.fdMCParticle(), mult, multPercentile, use4dplots, extendedplots);
             setPair_MC(femtoObsMC, femtoObs, mT, mult, part1.fdMCParticle().partOriginMCTruth(), part2.fdMCParticle().partOriginMCTruth(), smearingByOrigin);
           } else {
             mHistogramRegistry->fill(HIST(mFolderSuffix[mEventType]) + HIST(o2::aod::femtodreamMCparticle::MCTypeName[o2::aod::femtodreamMCparticle::MCType::kTruth]) + HIST("/hFakePairsCounter"), 0);
@@ -311,6 +320,27 @@ class FemtoDreamContainer
   int mPDGOne = 0;                                                                  ///< PDG code of particle 1
   int mPDGTwo = 0;                                                                  ///< PDG code of particle 2
   float mHighkstarCut = 6.;
+
+  /// Histograms filled by setPair_base, resolved once in init_base
+  struct PairHistograms {
+    std::shared_ptr<TH2> relPairkstarmP2;
+    std::shared_ptr<TH1> relPairDist;
+    std::shared_ptr<TH1> relPairkT;
+    std::shared_ptr<TH2> relPairkstarkT;
+    std::shared_ptr<TH2> relPairkstarmT;
+    std::shared_ptr<TH2> relPairkstarMult;
+    std::shared_ptr<TH2> relPairkstarMultPercentile;
+    std::shared_ptr<TH2> kstarPtPart1;
+    std::shared_ptr<TH2> kstarPtPart2;
+    std::shared_ptr<TH2> MultPtPart1;
+    std::shared_ptr<TH2> MultPtPart2;
+    std::shared_ptr<TH2> MultPercentilePtPart1;
+    std::shared_ptr<TH2> MultPercentilePtPart2;
+    std::shared_ptr<TH2> PtPart1PtPart2;
+    std::shared_ptr<THnSparse> relPairkstarmTMultMultPercentile;
+    std::shared_ptr<THnSparse> relPairkstarmTPtPart1PtPart2MultPercentile;
+  };
+  std::array<PairHistograms, o2::aod::femtodreamMCparticle::MCType::kNMCTypes> mPairHistograms{}; ///< Pair histograms of the reconstructed and of the MC truth pairs
 };
 
 } // namespace o2::analysis::femtoDream
@@ -16,9 +16,11 @@
 #ifndef PWGCF_FEMTODREAM_CORE_FEMTODREAMDETADPHISTAR_H_
 #define PWGCF_FEMTODREAM_CORE_FEMTODREAMDETADPHISTAR_H_
 
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
+#include "PWGCF/Core/PhiStarCache.h"
 #include "PWGCF/DataModel/FemtoDerived.h"
 #include "Framework/HistogramRegistry.h"
 
@@ -430,10 +432,15 @@ class FemtoDreamDetaDphiStar
   std::array<std::shared_ptr<THnSparse>, 3> histdetadpi_eta{};
   std::array<std::shared_ptr<THnSparse>, 3> histdetadpi_phi{};
 
+  using PhiStars = std::array<float, 9>;
+  PhiStarCache<9> phiStarCache;   ///< phi* of the femto particles, by global index
+  PhiStarCache<9> phiStarCacheHF; ///< phi* of the prongs of the charm hadrons, by global index and prong
+
   ///  Calculate phi at all required radii stored in tmpRadiiTPC
   /// Magnetic field to be provided in Tesla
+  /// The values are computed once per particle and magnetic field, and then taken from phiStarCache
   template <typename T>
-  int PhiAtRadiiTPC(const T& part, std::vector<float>& tmpVec)
+  int PhiAtRadiiTPC(const T& part, PhiStars& phiStars)
   {
 
     float phi0 = part.phi();
@@ -450,21 +457,27 @@ class FemtoDreamDetaDphiStar
     }
     // End: Get the charge from cutcontainer using masks
     float pt = part.pt();
+    phiStars = phiStarCache.get(part.globalIndex(), phi0, pt, charge, magfield, [&](PhiStars& values) { PhiAtRadiiTPCFromKinematics(phi0, pt, charge, values); });
+    return charge;
+  }
+
+  /// phi* at the radii of tmpRadiiTPC for a given azimuth, transverse momentum and charge
+  void PhiAtRadiiTPCFromKinematics(float phi0, float pt, int charge, PhiStars& phiStars)
+  {
     for (size_t i = 0; i < 9; i++) {
       if (runOldVersion) {
-        tmpVec.push_back(phi0 - std::asin(0.3 * charge * 0.1 * magfield * tmpRadiiTPC[i] * 0.01 / (2. * pt)));
+        phiStars[i] = phi0 - std::asin(0.3 * charge * 0.1 * magfield * tmpRadiiTPC[i] * 0.01 / (2. * pt));
       }
       if (!runOldVersion) {
         auto arg = 0.3 * charge * magfield * tmpRadiiTPC[i] * 0.01 / (2. * pt);
         // for very low pT particles, this value goes outside of range -1 to 1 at at large tpc radius; asin fails
         if (abs(arg) < 1) {
-          tmpVec.push_back(phi0 - std::asin(0.3 * charge * magfield * tmpRadiiTPC[i] * 0.01 / (2. * pt)));
+          phiStars[i] = phi0 - std::asin(0.3 * charge * magfield * tmpRadiiTPC[i] * 0.01 / (2. * pt));
         } else {
-          tmpVec.push_back(999);
+          phiStars[i] = 999;
         }
       }
     }
-    return charge;
   }
 
   ///  Calculate phi at specific radii
@@ -528,7 +541,7 @@ class FemtoDreamDetaDphiStar
   }
 
   template <typename T>
-  int PhiAtRadiiTPCForHF(const T& part, std::vector<float>& tmpVec, int prong)
+  int PhiAtRadiiTPCForHF(const T& part, PhiStars& phiStars, int prong)
   {
     int charge = 0;
     float pt = -999.;
@@ -553,20 +566,7 @@ class FemtoDreamDetaDphiStar
         // Handle invalid prong value
         break;
     }
-    for (size_t i = 0; i < 9; i++) {
-      if (runOldVersion) {
-        tmpVec.push_back(phi0 - std::asin(0.3 * charge * 0.1 * magfield * tmpRadiiTPC[i] * 0.01 / (2. * pt)));
-      }
-      if (!runOldVersion) {
-        auto arg = 0.3 * charge * magfield * tmpRadiiTPC[i] * 0.01 / (2. * pt);
-        // for very low pT particles, this value goes outside of range -1 to 1 at at large tpc radius; asin fails
-        if (abs(arg) < 1) {
-          tmpVec.push_back(phi0 - std::asin(0.3 * charge * magfield * tmpRadiiTPC[i] * 0.01 / (2. * pt)));
-        } else {
-          tmpVec.push_back(999);
-        }
-      }
-    }
+    phiStars = phiStarCacheHF.get(part.globalIndex() * Nprongs + prong, phi0, pt, charge, magfield, [&](PhiStars& values) { PhiAtRadiiTPCFromKinematics(phi0, pt, charge, values); });
     return charge;
   }
 
@@ -574,8 +574,8 @@ class FemtoDreamDetaDphiStar
   template <bool isHF = false, typename T1, typename T2>
   float AveragePhiStar(const T1& part1, const T2& part2, int iHist, bool* sameCharge)
   {
-    std::vector<float> tmpVec1;
-    std::vector<float> tmpVec2;
+    PhiStars tmpVec1;
+    PhiStars tmpVec2;
     auto charge1 = PhiAtRadiiTPC(part1, tmpVec1);
     if constexpr (!isHF) {
       auto charge2 = PhiAtRadiiTPC(part2, tmpVec2);
@@ -591,8 +591,8 @@ class FemtoDreamDetaDphiStar
     float dPhiAvg = 0;
     float dphi;
     for (int i = 0; i < num; i++) {
-      if (tmpVec1.at(i) != 999 && tmpVec2.at(i) != 999) {
-        dphi = tmpVec1.at(i) - tmpVec2.at(i);
+      if (tmpVec1[i] != 999 && tmpVec2[i] != 999) {
+        dphi = tmpVec1[i] - tmpVec2[i];
       } else {
         dphi = 0;
         meaningfulEntries = meaningfulEntries - 1;
@@ -31,6 +31,48 @@ namespace o2::analysis::femtoDream
 class FemtoDreamMath
 {
  public:
+  /// Kinematic observables of a pair of particles
+  struct PairKinematics {
+    float kstar; ///< relative momentum in the pair rest frame
+    float kT;    ///< average transverse momentum
+    float mT;    ///< transverse mass
+  };
+
+  /// Compute k*, kT and mT of a pair of particles from a single pair of four-vectors
+  /// Gives the same values as getkstar, getkT and getmT
+  /// \tparam T type of tracks
+  /// \param part1 Particle 1
+  /// \param mass1 Mass of particle 1
+  /// \param part2 Particle 2
+  /// \param mass2 Mass of particle 2
+  template <typename T1, typename T2>
+  static PairKinematics getPairKinematics(const T1& part1, const float mass1, const T2& part2, const float mass2)
+  {
+    const ROOT::Math::PtEtaPhiMVector vecpart1(part1.pt(), part1.eta(), part1.phi(), mass1);
+    const ROOT::Math::PtEtaPhiMVector vecpart2(part2.pt(), part2.eta(), part2.phi(), mass2);
+    const ROOT::Math::PtEtaPhiMVector trackSum = vecpart1 + vecpart2;
+
+    const float beta = trackSum.Beta();
+    const float betax = beta * std::cos(trackSum.Phi()) * std::sin(trackSum.Theta());
+    const float betay = beta * std::sin(trackSum.Phi()) * std::sin(trackSum.Theta());
+    const float betaz = beta * std::cos(trackSum.Theta());
+
+    ROOT::Math::PxPyPzMVector PartOneCMS(vecpart1);
+    ROOT::Math::PxPyPzMVector PartTwoCMS(vecpart2);
+
+    const ROOT::Math::Boost boostPRF = ROOT::Math::Boost(-betax, -betay, -betaz);
+    PartOneCMS = boostPRF(PartOneCMS);
+    PartTwoCMS = boostPRF(PartTwoCMS);
+
+    const ROOT::Math::PxPyPzMVector trackRelK = PartOneCMS - PartTwoCMS;
+
+    PairKinematics kinematics;
+    kinematics.kstar = 0.5 * trackRelK.P();
+    kinematics.kT = 0.5 * trackSum.Pt();
+    kinematics.mT = std::sqrt(std::pow(kinematics.kT, 2.) + std::pow(0.5 * (mass1 + mass2), 2.));
+    return kinematics;
+  }
+
   /// Compute the k* of a pair of particles
   /// \tparam T type of tracks
   /// \param part1 Particle 1
@@ -246,6 +246,8 @@ class FemtoDreamTrackSelection : public FemtoDreamObjectSelection<float, femtoDr
   float nSigmaPIDOffsetTPC;
   float nSigmaPIDOffsetTOF;
   std::vector<o2::track::PID> mPIDspecies; ///< All the particle species for which the n_sigma values need to be stored
+  std::vector<float> mPIDnSigmaTPC;        ///< TPC n_sigma of the current track for all mPIDspecies, offset subtracted
+  std::vector<float> mPIDnSigmaComb;       ///< Combined TPC+TOF n_sigma of the current track for all mPIDspecies, offsets subtracted
   static constexpr int kNtrackSelection = 14;
   static constexpr std::string_view mSelectionNames[kNtrackSelection] = {"Sign",
                                                                          "PtMin",
@@ -399,11 +401,6 @@ bool FemtoDreamTrackSelection::isSelectedMinimal(T const& track)
   const auto dcaZ = track.dcaZ();
   const auto dca = track.dcaXY(); // Accordingly to FemtoDream in AliPhysics  as well as LF analysis,
                                   // only dcaXY should be checked; NOT std::sqrt(pow(dcaXY, 2.) + pow(dcaZ, 2.))
-  std::vector<float> pidTPC, pidTOF;
-  for (auto it : mPIDspecies) {
-    pidTPC.push_back(getNsigmaTPC(track, it));
-    pidTOF.push_back(getNsigmaTOF(track, it));
-  }
 
   if (nPtMinSel > 0 && pT < pTMin) {
     return false;
@@ -446,9 +443,10 @@ bool FemtoDreamTrackSelection::isSelectedMinimal(T const& track)
   }
 
   if (nPIDnSigmaSel > 0) {
+    /// only the TPC n_sigma enters here, and it is needed only for tracks passing all the other selections
     bool isFulfilled = false;
-    for (size_t i = 0; i < pidTPC.size(); ++i) {
-      auto pidTPCVal = pidTPC.at(i);
+    for (auto it : mPIDspecies) {
+      auto pidTPCVal = getNsigmaTPC(track, it);
       if (std::abs(pidTPCVal - nSigmaPIDOffsetTPC) < nSigmaPIDMax) {
         isFulfilled = true;
       }
@@ -479,10 +477,15 @@ std::array<cutContainerType, 2> FemtoDreamTrackSelection::getCutContainer(T cons
   const auto dcaZ = track.dcaZ();
   const auto dca = Dca;
 
-  std::vector<float> pidTPC, pidTOF;
-  for (auto it : mPIDspecies) {
-    pidTPC.push_back(getNsigmaTPC(track, it));
-    pidTOF.push_back(getNsigmaTOF(track, it));
+  /// the n_sigma values are computed once per species and reused by all the PID selections,
+  /// in buffers kept between the tracks
+  mPIDnSigmaTPC.resize(mPIDspecies.size());
+  mPIDnSigmaComb.resize(mPIDspecies.size());
+  for (size_t i = 0; i < mPIDspecies.size(); ++i) {
+    auto pidTPCVal = getNsigmaTPC(track, mPIDspecies[i]) - nSigmaPIDOffsetTPC;
+    auto pidTOFVal = getNsigmaTOF(track, mPIDspecies[i]) - nSigmaPIDOffsetTOF;
+    mPIDnSigmaTPC[i] = pidTPCVal;
+    mPIDnSigmaComb[i] = std::sqrt(pidTPCVal * pidTPCVal + pidTOFVal * pidTOFVal);
   }
 
   float observable = 0.;
@@ -491,11 +494,8 @@ std::array<cutContainerType, 2> FemtoDreamTrackSelection::getCutContainer(T cons
     if (selVariable == femtoDreamTrackSelection::kPIDnSigmaMax) {
       /// PID needs to be handled a bit differently since we may need more than one species
       for (size_t i = 0; i < mPIDspecies.size(); ++i) {
-        auto pidTPCVal = pidTPC.at(i) - nSigmaPIDOffsetTPC;
-        auto pidTOFVal = pidTOF.at(i) - nSigmaPIDOffsetTOF;
-        auto pidComb = std::sqrt(pidTPCVal * pidTPCVal + pidTOFVal * pidTOFVal);
-        sel.checkSelectionSetBitPID(pidTPCVal, outputPID);
-        sel.checkSelectionSetBitPID(pidComb, outputPID);
+        sel.checkSelectionSetBitPID(mPIDnSigmaTPC[i], outputPID);
+        sel.checkSelectionSetBitPID(mPIDnSigmaComb[i], outputPID);
       }
     } else {
       /// for the rest it's all the same
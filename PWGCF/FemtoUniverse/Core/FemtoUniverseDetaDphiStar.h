@@ -18,10 +18,12 @@
 #ifndef PWGCF_FEMTOUNIVERSE_CORE_FEMTOUNIVERSEDETADPHISTAR_H_
 #define PWGCF_FEMTOUNIVERSE_CORE_FEMTOUNIVERSEDETADPHISTAR_H_
 
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
 #include "TMath.h"
+#include "PWGCF/Core/PhiStarCache.h"
 #include "PWGCF/FemtoUniverse/DataModel/FemtoDerived.h"
 #include "PWGCF/FemtoUniverse/Core/FemtoUniverseFemtoContainer.h"
 #include "PWGCF/FemtoUniverse/Core/FemtoUniverseAngularContainer.h"
@@ -440,10 +442,14 @@ class FemtoUniverseDetaDphiStar
   std::array<std::array<std::shared_ptr<TH2>, 2>, 2> histdetadpimixed{};
   std::array<std::array<std::shared_ptr<TH2>, 9>, 2> histdetadpiRadii{};
 
+  using PhiStars = std::array<float, 9>;
+  PhiStarCache<9> phiStarCache; ///< phi* of the femto particles, by global index
+
   ///  Calculate phi at all required radii stored in tmpRadiiTPC
   /// Magnetic field to be provided in Tesla
+  /// The values are computed once per particle and magnetic field, and then taken from phiStarCache
   template <typename T>
-  void PhiAtRadiiTPC(const T& part, std::vector<float>& tmpVec)
+  void PhiAtRadiiTPC(const T& part, PhiStars& phiStars)
   {
 
     float phi0 = part.phi();
@@ -460,22 +466,24 @@ class FemtoUniverseDetaDphiStar
     }
     // End: Get the charge from cutcontainer using masks
     float pt = part.pt();
-    for (size_t i = 0; i < 9; i++) {
-      double arg = 0.3 * charge * magfield * tmpRadiiTPC[i] * 0.01 / (2. * pt);
-      if (abs(arg) < 1.0) {
-        tmpVec.push_back(phi0 - std::asin(arg));
-      } else {
-        tmpVec.push_back(999.0);
+    phiStars = phiStarCache.get(part.globalIndex(), phi0, pt, static_cast<int>(charge), magfield, [&](PhiStars& values) {
+      for (size_t i = 0; i < 9; i++) {
+        double arg = 0.3 * charge * magfield * tmpRadiiTPC[i] * 0.01 / (2. * pt);
+        if (abs(arg) < 1.0) {
+          values[i] = phi0 - std::asin(arg);
+        } else {
+          values[i] = 999.0;
+        }
       }
-    }
+    });
   }
 
   ///  Calculate average phi
   template <typename T1, typename T2>
   float AveragePhiStar(const T1& part1, const T2& part2, int iHist)
   {
-    std::vector<float> tmpVec1;
-    std::vector<float> tmpVec2;
+    PhiStars tmpVec1;
+    PhiStars tmpVec2;
     PhiAtRadiiTPC(part1, tmpVec1);
     PhiAtRadiiTPC(part2, tmpVec2);
     int num = tmpVec1.size();
@@ -483,8 +491,8 @@ class FemtoUniverseDetaDphiStar
     float dphi = 0;
     int entries = 0;
     for (int i = 0; i < num; i++) {
-      if (tmpVec1.at(i) != 999 && tmpVec2.at(i) != 999) {
-        dphi = tmpVec1.at(i) - tmpVec2.at(i);
+      if (tmpVec1[i] != 999 && tmpVec2[i] != 999) {
+        dphi = tmpVec1[i] - tmpVec2[i];
         entries++;
       } else {
         dphi = 0;
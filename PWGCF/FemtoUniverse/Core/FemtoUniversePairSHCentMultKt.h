@@ -16,11 +16,13 @@
 #ifndef PWGCF_FEMTOUNIVERSE_CORE_FEMTOUNIVERSEPAIRSHCENTMULTKT_H_
 #define PWGCF_FEMTOUNIVERSE_CORE_FEMTOUNIVERSEPAIRSHCENTMULTKT_H_
 
+#include <array>
 #include <vector>
 #include <string>
 #include <complex>
 #include <memory>
 #include "Framework/HistogramRegistry.h"
+#include "PWGCF/FemtoUniverse/Core/FemtoUniverseSpherHarMath.h"
 
 using namespace o2;
 using namespace o2::framework;
@@ -266,7 +268,6 @@ class PairSHCentMultKt
   {
     int fMultBin = multval;
     int fKtBin = ktval;
-    std::vector<std::complex<double>> fYlmBuffer(fMaxJM);
     std::vector<double> f3d;
     f3d = FemtoUniverseMath::getpairmom3d(part1, mMassOne, part2, mMassTwo,
                                           true, true);
@@ -278,8 +279,7 @@ class PairSHCentMultKt
     double kv = sqrt(qout * qout + qside * qside + qlong * qlong);
     int nqbin = fbinctn[0][0]->GetXaxis()->FindFixBin(kv) - 1;
 
-    FemtoUniverseSpherHarMath Ylm;
-    Ylm.YlmUpToL(fMaxL, qout, qside, qlong, fYlmBuffer.data());
+    fYlm.YlmUpToL(fMaxL, qout, qside, qlong, fYlmBuffer.data());
 
     if (ChosenEventType == femtoUniverseSHContainer::EventType::same) {
       for (int ihist = 0; ihist < fMaxJM; ihist++) {
@@ -287,19 +287,8 @@ class PairSHCentMultKt
         fnumsimag[fMultBin][fKtBin][ihist]->Fill(kv, -imag(fYlmBuffer[ihist]));
         fbinctn[fMultBin][fKtBin]->Fill(kv, 1.0);
       }
-      if (nqbin < fbinctn[0][0]->GetNbinsX()) {
-        for (int ilmzero = 0; ilmzero < fMaxJM; ilmzero++) {
-          for (int ilmprim = 0; ilmprim < fMaxJM; ilmprim++) {
-            fcovmnum[fMultBin][fKtBin][GetBin(nqbin, ilmzero, 0, ilmprim, 0)] +=
-              (real(fYlmBuffer[ilmzero]) * real(fYlmBuffer[ilmprim]));
-            fcovmnum[fMultBin][fKtBin][GetBin(nqbin, ilmzero, 0, ilmprim, 1)] +=
-              (real(fYlmBuffer[ilmzero]) * -imag(fYlmBuffer[ilmprim]));
-            fcovmnum[fMultBin][fKtBin][GetBin(nqbin, ilmzero, 1, ilmprim, 0)] +=
-              (-imag(fYlmBuffer[ilmzero]) * real(fYlmBuffer[ilmprim]));
-            fcovmnum[fMultBin][fKtBin][GetBin(nqbin, ilmzero, 1, ilmprim, 1)] +=
-              (-imag(fYlmBuffer[ilmzero]) * -imag(fYlmBuffer[ilmprim]));
-          }
-        }
+      if (nqbin >= 0 && nqbin < fbinctn[0][0]->GetNbinsX()) {
+        FemtoUniverseSpherHarMath::AddCovariance(fMaxJM, fYlmBuffer.data(), &fcovmnum[fMultBin][fKtBin][GetBin(nqbin, 0, 0, 0, 0)]);
       }
     } else if (ChosenEventType == femtoUniverseSHContainer::EventType::mixed) {
       for (int ihist = 0; ihist < fMaxJM; ihist++) {
@@ -307,19 +296,8 @@ class PairSHCentMultKt
         fdensimag[fMultBin][fKtBin][ihist]->Fill(kv, -imag(fYlmBuffer[ihist]));
         fbinctd[fMultBin][fKtBin]->Fill(kv, 1.0);
       }
-      if (nqbin < fbinctd[0][0]->GetNbinsX()) {
-        for (int ilmzero = 0; ilmzero < fMaxJM; ilmzero++) {
-          for (int ilmprim = 0; ilmprim < fMaxJM; ilmprim++) {
-            fcovmden[fMultBin][fKtBin][GetBin(nqbin, ilmzero, 0, ilmprim, 0)] +=
-              (real(fYlmBuffer[ilmzero]) * real(fYlmBuffer[ilmprim]));
-            fcovmden[fMultBin][fKtBin][GetBin(nqbin, ilmzero, 0, ilmprim, 1)] +=
-              (real(fYlmBuffer[ilmzero]) * -imag(fYlmBuffer[ilmprim]));
-            fcovmden[fMultBin][fKtBin][GetBin(nqbin, ilmzero, 1, ilmprim, 0)] +=
-              (-imag(fYlmBuffer[ilmzero]) * real(fYlmBuffer[ilmprim]));
-            fcovmden[fMultBin][fKtBin][GetBin(nqbin, ilmzero, 1, ilmprim, 1)] +=
-              (-imag(fYlmBuffer[ilmzero]) * -imag(fYlmBuffer[ilmprim]));
-          }
-        }
+      if (nqbin >= 0 && nqbin < fbinctd[0][0]->GetNbinsX()) {
+        FemtoUniverseSpherHarMath::AddCovariance(fMaxJM, fYlmBuffer.data(), &fcovmden[fMultBin][fKtBin][GetBin(nqbin, 0, 0, 0, 0)]);
       }
     }
   }
@@ -389,6 +367,9 @@ class PairSHCentMultKt
   static constexpr int fMaxL = 2;
   static constexpr int fMaxJM = (fMaxL + 1) * (fMaxL + 1);
 
+  FemtoUniverseSpherHarMath fYlm;                        ///< Ylm evaluator, with the normalisation computed once
+  std::array<std::complex<double>, fMaxJM> fYlmBuffer{}; ///< Ylms of the current pair
+
   std::array<std::array<std::array<float, (fMaxJM * fMaxJM * 4 * 100)>, 10>, 10>
     fcovmnum{}; ///< Covariance matrix for the numerator
   std::array<std::array<std::array<float, (fMaxJM * fMaxJM * 4 * 100)>, 10>, 10>
@@ -163,7 +163,6 @@ class FemtoUniverseSHContainer
   {
     // int fMaxL = 2;
     // int fMaxJM = (2+1)*(2+1);
-    std::vector<std::complex<double>> fYlmBuffer(fMaxJM);
     std::vector<double> f3d;
     f3d = FemtoUniverseMath::getpairmom3d(part1, mMassOne, part2, mMassTwo, true, true);
 
@@ -175,8 +174,7 @@ class FemtoUniverseSHContainer
     double kv = sqrt(qout * qout + qside * qside + qlong * qlong);
     int nqbin = fbinctn->GetXaxis()->FindFixBin(kv) - 1;
 
-    FemtoUniverseSpherHarMath Ylm;
-    Ylm.YlmUpToL(fMaxL, qout, qside, qlong, fYlmBuffer.data());
+    fYlm.YlmUpToL(fMaxL, qout, qside, qlong, fYlmBuffer.data());
 
     if (ChosenEventType == femtoUniverseSHContainer::EventType::same) {
       for (int ihist = 0; ihist < fMaxJM; ihist++) {
@@ -185,30 +183,16 @@ class FemtoUniverseSHContainer
         fbinctn->Fill(kv, 1.0);
       }
 
-      if (nqbin < fbinctn->GetNbinsX()) {
-        for (int ilmzero = 0; ilmzero < fMaxJM; ilmzero++) {
-          for (int ilmprim = 0; ilmprim < fMaxJM; ilmprim++) {
-            fcovmnum[GetBin(nqbin, ilmzero, 0, ilmprim, 0)] += (real(fYlmBuffer[ilmzero]) * real(fYlmBuffer[ilmprim]));
-            fcovmnum[GetBin(nqbin, ilmzero, 0, ilmprim, 1)] += (real(fYlmBuffer[ilmzero]) * -imag(fYlmBuffer[ilmprim]));
-            fcovmnum[GetBin(nqbin, ilmzero, 1, ilmprim, 0)] += (-imag(fYlmBuffer[ilmzero]) * real(fYlmBuffer[ilmprim]));
-            fcovmnum[GetBin(nqbin, ilmzero, 1, ilmprim, 1)] += (-imag(fYlmBuffer[ilmzero]) * -imag(fYlmBuffer[ilmprim]));
-          }
-        }
+      if (nqbin >= 0 && nqbin < fbinctn->GetNbinsX()) {
+        FemtoUniverseSpherHarMath::AddCovariance(fMaxJM, fYlmBuffer.data(), &fcovmnum[GetBin(nqbin, 0, 0, 0, 0)]);
       }
     } else if (ChosenEventType == femtoUniverseSHContainer::EventType::mixed) {
       for (int ihist = 0; ihist < fMaxJM; ihist++) {
         fdensreal[ihist]->Fill(kv, real(fYlmBuffer[ihist]));
         fdensimag[ihist]->Fill(kv, -imag(fYlmBuffer[ihist]));
       }
-      if (nqbin < fbinctn->GetNbinsX()) {
-        for (int ilmzero = 0; ilmzero < fMaxJM; ilmzero++) {
-          for (int ilmprim = 0; ilmprim < fMaxJM; ilmprim++) {
-            fcovmden[GetBin(nqbin, ilmzero, 0, ilmprim, 0)] += (real(fYlmBuffer[ilmzero]) * real(fYlmBuffer[ilmprim]));
-            fcovmden[GetBin(nqbin, ilmzero, 0, ilmprim, 1)] += (real(fYlmBuffer[ilmzero]) * -imag(fYlmBuffer[ilmprim]));
-            fcovmden[GetBin(nqbin, ilmzero, 1, ilmprim, 0)] += (-imag(fYlmBuffer[ilmzero]) * real(fYlmBuffer[ilmprim]));
-            fcovmden[GetBin(nqbin, ilmzero, 1, ilmprim, 1)] += (-imag(fYlmBuffer[ilmzero]) * -imag(fYlmBuffer[ilmprim]));
-          }
-        }
+      if (nqbin >= 0 && nqbin < fbinctn->GetNbinsX()) {
+        FemtoUniverseSpherHarMath::AddCovariance(fMaxJM, fYlmBuffer.data(), &fcovmden[GetBin(nqbin, 0, 0, 0, 0)]);
       }
     }
   }
@@ -256,6 +240,9 @@ class FemtoUniverseSHContainer
   static constexpr int fMaxL = 1;
   static constexpr int fMaxJM = (fMaxL + 1) * (fMaxL + 1);
 
+  FemtoUniverseSpherHarMath fYlm;                        ///< Ylm evaluator, with the normalisation computed once
+  std::array<std::complex<double>, fMaxJM> fYlmBuffer{}; ///< Ylms of the current pair
+
   std::array<float, (fMaxJM * fMaxJM * 4 * 100)> fcovmnum{}; ///< Covariance matrix for the numerator
   std::array<float, (fMaxJM * fMaxJM * 4 * 100)> fcovmden{}; ///< Covariance matrix for the numerator
 
@@ -16,6 +16,7 @@
 #ifndef PWGCF_FEMTOUNIVERSE_CORE_FEMTOUNIVERSESPHERHARMATH_H_
 #define PWGCF_FEMTOUNIVERSE_CORE_FEMTOUNIVERSESPHERHARMATH_H_
 
+#include <complex>
 #include <iostream>
 #include <vector>
 #include <algorithm>
@@ -33,6 +34,9 @@ namespace o2::analysis::femtoUniverse
 class FemtoUniverseSpherHarMath
 {
  public:
+  /// The normalisation coefficients are computed once, at construction
+  FemtoUniverseSpherHarMath() { InitializeYlms(); }
+
   /// Values of various coefficients
   void InitializeYlms()
   {
@@ -189,7 +193,6 @@ class FemtoUniverseSpherHarMath
 
     double lbuf[36];
     LegendreUpToYlm(lmax, ctheta, lbuf);
-    InitializeYlms();
 
     for (int iter = 1; iter <= lmax; iter++) {
       coss[iter - 1] = cos(iter * phi);
@@ -211,6 +214,29 @@ class FemtoUniverseSpherHarMath
     }
   }
 
+  /// Adds the products of the real and minus imaginary parts of a set of Ylms, for all pairs of (l,m), to a flat covariance
+  /// matrix of size 2 maxjm x 2 maxjm, of elements (2 ilmprim + primimag) * 2 maxjm + (2 ilmzero + zeroimag)
+  /// \param maxjm Number of (l,m) components
+  /// \param ylms Values of the Ylms
+  /// \param cov Covariance matrix of one k* bin
+  template <typename T>
+  static void AddCovariance(int maxjm, const std::complex<double>* ylms, T* cov)
+  {
+    const int size = 2 * maxjm;
+    double parts[72];
+    for (int ilm = 0; ilm < maxjm; ilm++) {
+      parts[2 * ilm] = real(ylms[ilm]);
+      parts[2 * ilm + 1] = -imag(ylms[ilm]);
+    }
+    for (int iprim = 0; iprim < size; iprim++) {
+      const double prim = parts[iprim];
+      T* row = cov + iprim * size;
+      for (int izero = 0; izero < size; izero++) {
+        row[izero] += (parts[izero] * prim);
+      }
+    }
+  }
+
  private:
   static std::complex<double> Ceiphi(double phi);
 
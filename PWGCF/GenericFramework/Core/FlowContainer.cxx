@@ -17,6 +17,7 @@ FlowContainer::FlowContainer() : TNamed("", ""),
                                  fProf(0),
                                  fProfRand(0),
                                  fNRandom(0),
+                                 fDenseSubsamples(kFALSE),
                                  fIDName("MidV"),
                                  fPtRebin(1),
                                  fPtRebinEdges(0),
@@ -30,6 +31,7 @@ FlowContainer::FlowContainer(const char* name) : TNamed(name, name),
                                                  fProf(0),
                                                  fProfRand(0),
                                                  fNRandom(0),
+                                                 fDenseSubsamples(kFALSE),
                                                  fIDName("MidV"),
                                                  fPtRebin(1),
                                                  fPtRebinEdges(0),
@@ -66,7 +68,11 @@ void FlowContainer::Initialize(TObjArray* inputList, const o2::framework::AxisSp
   for (int i = 0; i < inputList->GetEntries(); i++)
     fProf->GetYaxis()->SetBinLabel(i + 1, inputList->At(i)->GetName());
   fProf->Sumw2();
-  if (nRandom) {
+  if (nRandom && fDenseSubsamples) {
+    fNRandom = nRandom;
+    fSubsampleSums.assign(static_cast<size_t>(nRandom) * fProf->GetNcells() * 4, 0.);
+    fSubsampleEntries.assign(nRandom, 0.);
+  } else if (nRandom) {
     fNRandom = nRandom;
     fProfRand = new TObjArray();
     fProfRand->SetOwner(kTRUE);
@@ -91,7 +97,11 @@ void FlowContainer::Initialize(TObjArray* inputList, int nMultiBins, double Mult
   fProf->Sumw2();
   for (int i = 0; i < inputList->GetEntries(); i++)
     fProf->GetYaxis()->SetBinLabel(i + 1, inputList->At(i)->GetName());
-  if (nRandom) {
+  if (nRandom && fDenseSubsamples) {
+    fNRandom = nRandom;
+    fSubsampleSums.assign(static_cast<size_t>(nRandom) * fProf->GetNcells() * 4, 0.);
+    fSubsampleEntries.assign(nRandom, 0.);
+  } else if (nRandom) {
     fNRandom = nRandom;
     fProfRand = new TObjArray();
     fProfRand->SetOwner(kTRUE);
@@ -143,7 +153,15 @@ int FlowContainer::FillProfile(const char* hname, double multi, double corr, dou
     return -1;
   }
   fProf->Fill(multi, yin, corr, w);
-  if (fNRandom) {
+  if (fNRandom && !fSubsampleSums.empty()) {
+    int isample = static_cast<int>(rn * fNRandom);
+    double* sums = &fSubsampleSums[(static_cast<size_t>(isample) * fProf->GetNcells() + fProf->FindBin(multi, yin)) * 4];
+    sums[0] += w;
+    sums[1] += w * corr;
+    sums[2] += w * corr * corr;
+    sums[3] += w * w;
+    fSubsampleEntries[isample]++;
+  } else if (fNRandom) {
     double rnind = rn * fNRandom;
     dynamic_cast<TProfile2D*>(fProfRand->At(static_cast<int>(rnind)))->Fill(multi, yin, corr, w);
   }
@@ -201,7 +219,8 @@ Long64_t FlowContainer::Merge(TCollection* collist)
       tpro->Add(spro);
     }
     nmerged++;
-    TObjArray* tarr = l_FC->GetSubProfiles();
+    MergeSubsampleSums(l_FC);
+    TObjArray* tarr = l_FC->fProfRand;
     if (!tarr)
       continue;
     if (!fProfRand) {
@@ -260,7 +279,8 @@ void FlowContainer::PickAndMerge(TFile* tfi)
   } else {
     tpro->Add(spro);
   }
-  TObjArray* tarr = lfc->GetSubProfiles();
+  MergeSubsampleSums(lfc);
+  TObjArray* tarr = lfc->fProfRand;
   if (!tarr) {
     return;
   }
@@ -277,6 +297,70 @@ void FlowContainer::PickAndMerge(TFile* tfi)
     }
   }
 }
+void FlowContainer::MergeSubsampleSums(FlowContainer* other)
+{
+  if (other->fSubsampleSums.empty())
+    return;
+  if (fSubsampleSums.empty()) {
+    fNRandom = other->fNRandom;
+    fSubsampleSums = other->fSubsampleSums;
+    fSubsampleEntries = other->fSubsampleEntries;
+    return;
+  }
+  if (fSubsampleSums.size() != other->fSubsampleSums.size()) {
+    printf("Subsample sums of %s have different sizes, not merging them\n", this->GetName());
+    return;
+  }
+  for (size_t i = 0; i < fSubsampleSums.size(); i++)
+    fSubsampleSums[i] += other->fSubsampleSums[i];
+  for (size_t i = 0; i < fSubsampleEntries.size(); i++)
+    fSubsampleEntries[i] += other->fSubsampleEntries[i];
+}
+bool FlowContainer::ConvertSubsamplesToProfiles()
+{
+  if (fSubsampleSums.empty())
+    return kFALSE;
+  if (!fProf) {
+    printf("Main profile does not exist, cannot convert the subsample sums\n");
+    return kFALSE;
+  }
+  if (!fProfRand) {
+    fProfRand = new TObjArray();
+    fProfRand->SetOwner(kTRUE);
+  }
+  int nCells = fProf->GetNcells();
+  for (int i = 0; i < fNRandom; i++) {
+    TProfile2D* tarprof = dynamic_cast<TProfile2D*>(fProfRand->FindObject(Form("%s_Rand_%i", fProf->GetName(), i)));
+    if (!tarprof) {
+      tarprof = dynamic_cast<TProfile2D*>(fProf->Clone(Form("%s_Rand_%i", fProf->GetName(), i)));
+      tarprof->SetDirectory(0);
+      tarprof->Reset();
+      tarprof->Sumw2();
+      fProfRand->Add(tarprof);
+    }
+    double* sumw2Targ = tarprof->GetSumw2()->fArray;
+    double* binsw2Targ = tarprof->GetBinSumw2()->fArray;
+    for (int bin = 0; bin < nCells; bin++) {
+      const double* sums = &fSubsampleSums[(static_cast<size_t>(i) * nCells + bin) * 4];
+      if (sums[0] == 0. && sums[3] == 0.)
+        continue;
+      tarprof->SetBinEntries(bin, tarprof->GetBinEntries(bin) + sums[0]);
+      tarprof->fArray[bin] += sums[1];
+      sumw2Targ[bin] += sums[2];
+      binsw2Targ[bin] += sums[3];
+    }
+    tarprof->SetEntries(tarprof->GetEntries() + fSubsampleEntries[i]);
+    tarprof->ResetStats();
+  }
+  fSubsampleSums.clear();
+  fSubsampleEntries.clear();
+  return kTRUE;
+}
+TObjArray* FlowContainer::GetSubProfiles()
+{
+  ConvertSubsamplesToProfiles();
+  return fProfRand;
+}
 bool FlowContainer::OverrideBinsWithZero(int xb1, int yb1, int xb2, int yb2)
 {
   ProfileSubset* t_apf = new ProfileSubset(*fProf);
@@ -290,6 +374,7 @@ bool FlowContainer::OverrideBinsWithZero(int xb1, int yb1, int xb2, int yb2)
 }
 bool FlowContainer::OverrideMainWithSub(int ind, bool ExcludeChosen)
 {
+  ConvertSubsamplesToProfiles();
   if (!fProfRand) {
     printf("Cannot override main profile with a randomized one. Random profile array does not exist.\n");
     return kFALSE;
@@ -322,6 +407,7 @@ bool FlowContainer::OverrideMainWithSub(int ind, bool ExcludeChosen)
 }
 bool FlowContainer::RandomizeProfile(int nSubsets)
 {
+  ConvertSubsamplesToProfiles();
   if (!fProfRand) {
     printf("Cannot randomize profile, random array does not exist.\n");
     return kFALSE;
@@ -59,7 +59,11 @@ class FlowContainer : public TNamed
   bool OverrideMainWithSub(int subind, bool ExcludeChosen);
   bool RandomizeProfile(int nSubsets = 0);
   bool CreateStatisticsProfile(StatisticsType StatType, int arg);
-  TObjArray* GetSubProfiles() { return fProfRand; }
+  TObjArray* GetSubProfiles();
+  // Keep the subsamples as dense sums (sum w, sum wy, sum wy^2, sum w^2 per bin) instead of one TProfile2D each.
+  // Must be set before Initialize. The sums are merged as plain arrays and converted to profiles on first access
+  void SetDenseSubsamples(bool newval) { fDenseSubsamples = newval; }
+  bool ConvertSubsamplesToProfiles();
   Long64_t Merge(TCollection* collist);
   void SetIDName(TString newname); //! do not store
   void SetPtRebin(int newval) { fPtRebin = newval; }
@@ -153,6 +157,10 @@ class FlowContainer : public TNamed
   TProfile2D* fProf;
   TObjArray* fProfRand;
   int fNRandom;
+  bool fDenseSubsamples;
+  std::vector<double> fSubsampleSums;    // sum w, sum wy, sum wy^2, sum w^2 for each subsample and (global) bin of fProf
+  std::vector<double> fSubsampleEntries; // number of fills of each subsample
+  void MergeSubsampleSums(FlowContainer* other);
   TString fIDName;
   int fPtRebin;             //! do not store
   double* fPtRebinEdges;    //! do not store
@@ -163,7 +171,7 @@ class FlowContainer : public TNamed
   double* fbinsPt;       //! Do not store; stored in fXAxis
   bool fPropagateErrors; //! do not store
   TProfile* GetRefFlowProfile(const char* order, double m1 = -1, double m2 = -1);
-  ClassDef(FlowContainer, 2);
+  ClassDef(FlowContainer, 3);
 };
 
 #endif // PWGCF_GENERICFRAMEWORK_CORE_FLOWCONTAINER_H_
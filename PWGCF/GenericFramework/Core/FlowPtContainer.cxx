@@ -186,8 +186,13 @@ void FlowPtContainer::Initialise(int nbinsx, double xlow, double xhigh, const in
 };
 void FlowPtContainer::Fill(const double& w, const double& pt)
 {
+  // the powers are computed once per track instead of once per (weight power, pt power) combination
+  for (auto i = 0; i < wPow.size(); ++i) {
+    wPow[i] = pow(w, i);
+    ptPow[i] = pow(pt, i);
+  }
   for (auto i = 0; i < sumP.size(); ++i) {
-    sumP[i] += pow(w, i % (mpar + 1)) * pow(pt, i / (mpar + 1));
+    sumP[i] += wPow[i % (mpar + 1)] * ptPow[i / (mpar + 1)];
   }
   return;
 }
@@ -271,7 +276,7 @@ void FlowPtContainer::FillCMProfiles(const double& centmult, const double& rn)
   dynamic_cast<BootstrapProfile*>(fCMTermList->At(9))->FillProfile(centmult, 1 / weight3 * (-4 * sumP[GetVectorIndex(1, 1)] / sumP[GetVectorIndex(1, 0)] + 12 * tau1 * sumP[GetVectorIndex(2, 1)] / sumP[GetVectorIndex(2, 0)] + 12 * tau1 * sumP[GetVectorIndex(1, 1)] / sumP[GetVectorIndex(1, 0)] - 12 * tau1 * tau1 * sumP[GetVectorIndex(2, 1)] / sumP[GetVectorIndex(2, 0)] - 24 * tau2 * sumP[GetVectorIndex(3, 1)] / sumP[GetVectorIndex(3, 0)] - 8 * tau2 * sumP[GetVectorIndex(1, 1)] / sumP[GetVectorIndex(1, 0)] + 24 * tau3 * sumP[GetVectorIndex(4, 1)] / sumP[GetVectorIndex(4, 0)]), (fEventWeight == kEventWeight::kUnity) ? 1.0 : weight3, rn);
   return;
 }
-double FlowPtContainer::OrderedAddition(std::vector<double> vec)
+double FlowPtContainer::OrderedAddition(std::vector<double>& vec)
 {
   double sum = 0;
   std::sort(vec.begin(), vec.end());
@@ -61,7 +61,7 @@ class FlowPtContainer : public TNamed
   TH1* getCorrHist(int ind, int m);
   Int_t getMpar() { return mpar; }
   Long64_t Merge(TCollection* collist);
-  Double_t OrderedAddition(std::vector<double> vec);
+  Double_t OrderedAddition(std::vector<double>& vec); // sorts vec in place
   void CreateCentralMomentList();
   void CalculateCentralMomentHists(std::vector<TH1*> inh, int ind, int m, TH1* hMpt);
   void CreateCumulantList();
@@ -70,6 +70,8 @@ class FlowPtContainer : public TNamed
   {
     sumP.clear();
     sumP.resize((mpar + 1) * (mpar + 1));
+    wPow.resize(mpar + 1);
+    ptPow.resize(mpar + 1);
     fillCounter = 0;
   };
 
@@ -85,6 +87,8 @@ class FlowPtContainer : public TNamed
   void MergeBSLists(TList* source, TList* target);
   TH1* raiseHistToPower(TH1* inh, double p);
   std::vector<double> sumP;    //!
+  std::vector<double> wPow;    //! powers of the weight of the current track
+  std::vector<double> ptPow;   //! powers of the pt of the current track
   std::vector<double> corrNum; //!
   std::vector<double> corrDen; //!
 
@@ -101,11 +101,32 @@ int GFW::CreateRegions()
 void GFW::Fill(double eta, int ptin, double phi, double weight, int mask, double SecondWeight)
 {
   // if(!fInitialized) return;
+  fCorrCacheValid = false;
   for (int i = 0; i < static_cast<int>(fRegions.size()); ++i) {
     if (fRegions.at(i).EtaMin < eta && fRegions.at(i).EtaMax > eta && (fRegions.at(i).BitMask & mask))
       fCumulants.at(i).FillArray(ptin, phi, weight, SecondWeight);
   }
 };
+void GFW::FillBatch(const double* eta, const int* ptin, const double* phi, const double* weight, const int* mask, int nTracks, const double* secondWeight)
+{
+  fCorrCacheValid = false;
+  fBatchCos.resize(nTracks);
+  fBatchSin.resize(nTracks);
+  for (int i = 0; i < nTracks; ++i) {
+    fBatchCos[i] = cos(phi[i]);
+    fBatchSin[i] = sin(phi[i]);
+  }
+  for (int i = 0; i < static_cast<int>(fRegions.size()); ++i) {
+    const Region& lRegion = fRegions.at(i);
+    fBatchIndices.clear();
+    for (int j = 0; j < nTracks; ++j) {
+      if (lRegion.EtaMin < eta[j] && lRegion.EtaMax > eta[j] && (lRegion.BitMask & mask[j]))
+        fBatchIndices.push_back(j);
+    }
+    if (!fBatchIndices.empty())
+      fCumulants.at(i).FillArrayBatch(static_cast<int>(fBatchIndices.size()), fBatchIndices.data(), ptin, fBatchCos.data(), fBatchSin.data(), weight, secondWeight);
+  }
+};
 complex<double> GFW::TwoRec(int n1, int n2, int p1, int p2, int ptbin, GFWCumulant* r1, GFWCumulant* r2, GFWCumulant* r3)
 {
   complex<double> part1 = r1->Vec(n1, p1, ptbin);
@@ -131,6 +152,17 @@ complex<double> GFW::RecursiveCorr(GFWCumulant* qpoi, GFWCumulant* qref, GFWCumu
     return qpoi->Vec(hars.at(0), pows.at(0), ptbin);
   if (hars.size() < 3)
     return TwoRec(hars.at(0), hars.at(1), pows.at(0), pows.at(1), ptbin, qpoi, qref, qol);
+  if (!fCorrCacheValid) {
+    fCorrCache.clear();
+    fCorrCacheValid = true;
+  }
+  CorrKey lKey{qpoi, qref, qol, ptbin, 0};
+  bool lCacheable = PackHarmonics(hars, pows, lKey.packedHars);
+  if (lCacheable) {
+    auto lCached = fCorrCache.find(lKey);
+    if (lCached != fCorrCache.end())
+      return lCached->second;
+  }
   int harlast = hars.at(hars.size() - 1);
   int powlast = pows.at(pows.size() - 1);
   hars.erase(hars.end() - 1);
@@ -160,14 +192,31 @@ complex<double> GFW::RecursiveCorr(GFWCumulant* qpoi, GFWCumulant* qref, GFWCumu
   }
   hars.push_back(harlast);
   pows.push_back(powlast);
+  if (lCacheable)
+    fCorrCache.emplace(lKey, formula);
   return formula;
 };
+bool GFW::PackHarmonics(const vector<int>& hars, const vector<int>& pows, uint64_t& packed)
+{
+  // 5 bits for harmonics in [-16, 15] and 3 bits for powers in [0, 7], for up to 7 particles
+  if (hars.size() > 7)
+    return false;
+  packed = 0;
+  for (int i = 0; i < static_cast<int>(hars.size()); i++) {
+    if (hars[i] < -16 || hars[i] > 15 || pows[i] < 0 || pows[i] > 7)
+      return false;
+    packed = (packed << 8) | (static_cast<uint64_t>(hars[i] + 16) << 3) | static_cast<uint64_t>(pows[i]);
+  }
+  packed |= static_cast<uint64_t>(hars.size()) << 60; // the number of particles makes keys of different lengths distinct
+  return true;
+};
 void GFW::Clear()
 {
   if (!fInitialized)
     CreateRegions();
   for (auto ptr = fCumulants.begin(); ptr != fCumulants.end(); ++ptr)
     ptr->ResetQs();
+  fCorrCacheValid = false;
 };
 GFW::CorrConfig GFW::GetCorrelatorConfig(string config, string head, bool ptdif)
 {
@@ -260,7 +309,7 @@ complex<double> GFW::Calculate(int poi, int ref, vector<int> hars, int ptbin)
   GFWCumulant* qovl = qpoi;
   return RecursiveCorr(qpoi, qref, qovl, ptbin, hars);
 };
-complex<double> GFW::Calculate(CorrConfig corconf, int ptbin, bool SetHarmsToZero)
+complex<double> GFW::Calculate(const CorrConfig& corconf, int ptbin, bool SetHarmsToZero)
 {
   // if(!fInitialized) return complex<double>(0,0); //First check if initialised, if not -- initialize, and if it fails, return
   if (corconf.Regs.size() == 0)
@@ -296,12 +345,12 @@ complex<double> GFW::Calculate(CorrConfig corconf, int ptbin, bool SetHarmsToZer
       qovl = &fCumulants.at(ovl);
     else if (ref == poi)
       qovl = qref; // If ref and poi are the same, then the same is for overlap. Only, when OL not explicitly defined
-    if (SetHarmsToZero) {
-      for (int j = 0; j < static_cast<int>(corconf.Hars.at(i).size()); j++) {
-        corconf.Hars.at(i).at(j) = 0;
-      }
-    }
-    retval *= RecursiveCorr(qpoi, qref, qovl, ptInd, corconf.Hars.at(i));
+    // Working copy of the harmonics, reusing the memory of the previous calls
+    if (SetHarmsToZero)
+      fCalcHars.assign(corconf.Hars.at(i).size(), 0);
+    else
+      fCalcHars.assign(corconf.Hars.at(i).begin(), corconf.Hars.at(i).end());
+    retval *= RecursiveCorr(qpoi, qref, qovl, ptInd, fCalcHars);
   }
   return retval;
 };
@@ -26,6 +26,8 @@ If used, modified, or distributed, please aknowledge the author of this code.
 #include <utility>
 #include <algorithm>
 #include <complex>
+#include <cstdint>
+#include <unordered_map>
 
 class GFW
 {
@@ -62,15 +64,42 @@ class GFW
   void AddRegion(std::string refName, int lNhar, int* lNparVec, double lEtaMin, double lEtaMax, int lNpT, int BitMask);  // Legacy support, array instead of a vector
   int CreateRegions();
   void Fill(double eta, int ptin, double phi, double weight, int mask, double secondWeight = -1);
+  // Fills nTracks tracks given as arrays, with the same result as a call to Fill for each of them. cos(phi) and sin(phi) are evaluated once per track
+  void FillBatch(const double* eta, const int* ptin, const double* phi, const double* weight, const int* mask, int nTracks, const double* secondWeight = nullptr);
   void Clear();
   GFWCumulant GetCumulant(int index) { return fCumulants.at(index); }
   CorrConfig GetCorrelatorConfig(std::string config, std::string head = "", bool ptdif = false);
-  std::complex<double> Calculate(CorrConfig corconf, int ptbin, bool SetHarmsToZero);
+  std::complex<double> Calculate(const CorrConfig& corconf, int ptbin, bool SetHarmsToZero);
   void InitializePowerArrays();
 
  protected:
   bool fInitialized;
   std::vector<CorrConfig> fListOfCFGs;
+  std::vector<double> fBatchCos, fBatchSin; //! cos(phi), sin(phi) of the tracks of FillBatch
+  std::vector<int> fBatchIndices;           //! tracks of FillBatch within the current region
+  // Sub-correlators of 3 or more particles are shared between the correlator configurations, the pT bins and the
+  // terms of the recursion, so they are evaluated once per event and reused until the Q-vectors change
+  struct CorrKey {
+    const GFWCumulant* poi;
+    const GFWCumulant* ref;
+    const GFWCumulant* ovl;
+    int ptbin;
+    uint64_t packedHars; // harmonics and powers, 8 bits per particle
+    bool operator==(const CorrKey& other) const { return poi == other.poi && ref == other.ref && ovl == other.ovl && ptbin == other.ptbin && packedHars == other.packedHars; }
+  };
+  struct CorrKeyHash {
+    std::size_t operator()(const CorrKey& key) const
+    {
+      std::size_t h = std::hash<uint64_t>()(key.packedHars);
+      for (std::size_t v : {reinterpret_cast<std::size_t>(key.poi), reinterpret_cast<std::size_t>(key.ref), reinterpret_cast<std::size_t>(key.ovl), static_cast<std::size_t>(key.ptbin)})
+        h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+      return h;
+    }
+  };
+  std::unordered_map<CorrKey, std::complex<double>, CorrKeyHash> fCorrCache; //! sub-correlators of the current Q-vectors
+  bool fCorrCacheValid = false;                                               //! false once the Q-vectors change
+  std::vector<int> fCalcHars;                                                 //! harmonics of the current subevent in Calculate
+  bool PackHarmonics(const std::vector<int>& hars, const std::vector<int>& pows, uint64_t& packed);
   std::complex<double> TwoRec(int n1, int n2, int p1, int p2, int ptbin, GFWCumulant*, GFWCumulant*, GFWCumulant*);
   std::complex<double> RecursiveCorr(GFWCumulant* qpoi, GFWCumulant* qref, GFWCumulant* qol, int ptbin, std::vector<int>& hars, std::vector<int>& pows); // POI, Ref. flow, overlapping region
   std::complex<double> RecursiveCorr(GFWCumulant* qpoi, GFWCumulant* qref, GFWCumulant* qol, int ptbin, std::vector<int>& hars);                         // POI, Ref. flow, overlapping region
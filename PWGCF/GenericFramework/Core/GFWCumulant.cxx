@@ -18,6 +18,7 @@ If used, modified, or distributed, please aknowledge the author of this code.
 */
 
 #include "GFWCumulant.h"
+#include <algorithm>
 
 using std::complex;
 using std::vector;
@@ -60,6 +61,71 @@ void GFWCumulant::FillArray(int ptin, double phi, double weight, double SecondWe
   }
   Inc();
 };
+void GFWCumulant::FillArrayBatch(int nTracks, const int* trackIndices, const int* ptin, const double* cosPhi, const double* sinPhi, const double* weight, const double* SecondWeight)
+{
+  if (!fInitialized)
+    CreateComplexVectorArray(1, 1, 1);
+  // Gather the tracks within the pT range
+  fBatchPt.clear();
+  fBatchCos.clear();
+  fBatchSin.clear();
+  fBatchW.clear();
+  fBatchW2.clear();
+  for (int i = 0; i < nTracks; i++) {
+    int lTrack = trackIndices[i];
+    int lPt = (fPt == 1) ? 0 : ptin[lTrack];
+    if (lPt < 0 || lPt >= fPt)
+      continue;
+    fFilledPts[lPt] = true;
+    fBatchPt.push_back(lPt);
+    fBatchCos.push_back(cosPhi[lTrack]);
+    fBatchSin.push_back(sinPhi[lTrack]);
+    fBatchW.push_back(weight[lTrack]);
+    // As in FillArray, the second weight replaces the first one for the powers above 1
+    fBatchW2.push_back((SecondWeight && SecondWeight[lTrack] > 0) ? SecondWeight[lTrack] : weight[lTrack]);
+  }
+  const int lN = static_cast<int>(fBatchPt.size());
+  fBatchRe.assign(lN, 1.);
+  fBatchIm.assign(lN, 0.);
+  fBatchPrefactor.resize(lN);
+  double* lRe = fBatchRe.data();
+  double* lIm = fBatchIm.data();
+  double* lPrefactor = fBatchPrefactor.data();
+  const double* lCos = fBatchCos.data();
+  const double* lSin = fBatchSin.data();
+  for (int lHar = 0; lHar < fN; lHar++) {
+    if (lHar > 0) {
+      // e^{i(n+1)phi} = e^{in phi} e^{i phi}
+      for (int i = 0; i < lN; i++) {
+        double lReNext = lRe[i] * lCos[i] - lIm[i] * lSin[i];
+        lIm[i] = lRe[i] * lSin[i] + lIm[i] * lCos[i];
+        lRe[i] = lReNext;
+      }
+    }
+    for (int lPow = 0; lPow < PW(lHar); lPow++) {
+      // Multiplication by the weight of each power is cheaper than pow
+      if (lPow == 0) {
+        std::fill(lPrefactor, lPrefactor + lN, 1.);
+      } else {
+        const double* lW = (lPow == 1) ? fBatchW.data() : fBatchW2.data();
+        for (int i = 0; i < lN; i++)
+          lPrefactor[i] *= lW[i];
+      }
+      if (fPt == 1) {
+        double lSumRe = 0, lSumIm = 0;
+        for (int i = 0; i < lN; i++) {
+          lSumRe += lPrefactor[i] * lRe[i];
+          lSumIm += lPrefactor[i] * lIm[i];
+        }
+        fQvector[0][lHar][lPow] += complex<double>(lSumRe, lSumIm);
+      } else {
+        for (int i = 0; i < lN; i++)
+          fQvector[fBatchPt[i]][lHar][lPow] += complex<double>(lPrefactor[i] * lRe[i], lPrefactor[i] * lIm[i]);
+      }
+    }
+  }
+  fNEntries += lN;
+};
 void GFWCumulant::ResetQs()
 {
   if (!fNEntries)
@@ -30,6 +30,9 @@ class GFWCumulant
   ~GFWCumulant();
   void ResetQs();
   void FillArray(int ptin, double phi, double weight = 1, double SecondWeight = -1);
+  // Bulk version of FillArray for the tracks at positions trackIndices of the input arrays, given cos(phi) and sin(phi).
+  // Higher harmonics are obtained by complex multiplication and the track loops are kept free of branches. SecondWeight can be null
+  void FillArrayBatch(int nTracks, const int* trackIndices, const int* ptin, const double* cosPhi, const double* sinPhi, const double* weight, const double* SecondWeight = nullptr);
   enum UsedFlags_t { kBlank = 0,
                      kFull = 1,
                      kPt = 2 };
@@ -58,6 +61,12 @@ class GFWCumulant
   bool* fFilledPts;
   bool fInitialized; // Arrays are initialized
   std::complex<double> fNullQ = 0;
+  // Buffers of FillArrayBatch, kept between calls
+  std::vector<int> fBatchPt;                //! pT bins of the tracks
+  std::vector<double> fBatchCos, fBatchSin; //! cos(phi), sin(phi)
+  std::vector<double> fBatchRe, fBatchIm;   //! cos(n phi), sin(n phi) of the current harmonic
+  std::vector<double> fBatchW, fBatchW2;    //! weights for the first and the higher powers
+  std::vector<double> fBatchPrefactor;      //! weights to the current power
 };
 
 #endif // PWGCF_GENERICFRAMEWORK_CORE_GFWCUMULANT_H_
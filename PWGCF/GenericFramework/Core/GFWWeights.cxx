@@ -11,6 +11,7 @@
 
 #include "GFWWeights.h"
 #include "TMath.h"
+#include <algorithm>
 GFWWeights::GFWWeights() : TNamed("", ""),
                            fDataFilled(kFALSE),
                            fMCFilled(kFALSE),
@@ -143,27 +144,86 @@ double GFWWeights::GetWeight(double phi, double eta, double vz, double pt, doubl
 };
 double GFWWeights::GetNUA(double phi, double eta, double vz)
 {
-  if (!fAccInt)
-    CreateNUA();
-  int xind = fAccInt->GetXaxis()->FindBin(phi);
-  int etaind = fAccInt->GetYaxis()->FindBin(eta);
-  int vzind = fAccInt->GetZaxis()->FindBin(vz);
-  double weight = fAccInt->GetBinContent(xind, etaind, vzind);
-  if (weight != 0)
-    return 1. / weight;
-  return 1;
+  if (!fFlatNUA.IsBuilt()) {
+    if (!fAccInt)
+      CreateNUA();
+    fFlatNUA.Build(fAccInt);
+  }
+  return fFlatNUA.IsBuilt() ? fFlatNUA.Get(phi, eta, vz) : 1;
 }
 double GFWWeights::GetNUE(double pt, double eta, double vz)
 {
-  if (!fEffInt)
-    CreateNUE();
-  int xind = fEffInt->GetXaxis()->FindBin(pt);
-  int etaind = fEffInt->GetYaxis()->FindBin(eta);
-  int vzind = fEffInt->GetZaxis()->FindBin(vz);
-  double weight = fEffInt->GetBinContent(xind, etaind, vzind);
-  if (weight != 0)
-    return 1. / weight;
-  return 1;
+  if (!fFlatNUE.IsBuilt()) {
+    if (!fEffInt)
+      CreateNUE();
+    fFlatNUE.Build(fEffInt);
+  }
+  return fFlatNUE.IsBuilt() ? fFlatNUE.Get(pt, eta, vz) : 1;
+}
+void GFWWeights::GetNUA(int nTracks, const double* phi, const double* eta, double vz, double* weights)
+{
+  if (nTracks < 1)
+    return;
+  weights[0] = GetNUA(phi[0], eta[0], vz); // builds the flat weights if needed
+  if (!fFlatNUA.IsBuilt()) {
+    std::fill(weights, weights + nTracks, 1.);
+    return;
+  }
+  int vzBin = fFlatNUA.fZ.FindBin(vz);
+  int stride = fFlatNUA.fX.fN + 2;
+  const double* inverse = fFlatNUA.fInverse.data() + vzBin * (fFlatNUA.fY.fN + 2) * stride;
+  for (int i = 1; i < nTracks; i++)
+    weights[i] = inverse[fFlatNUA.fY.FindBin(eta[i]) * stride + fFlatNUA.fX.FindBin(phi[i])];
+}
+void GFWWeights::GetNUE(int nTracks, const double* pt, const double* eta, double vz, double* weights)
+{
+  if (nTracks < 1)
+    return;
+  weights[0] = GetNUE(pt[0], eta[0], vz); // builds the flat weights if needed
+  if (!fFlatNUE.IsBuilt()) {
+    std::fill(weights, weights + nTracks, 1.);
+    return;
+  }
+  int vzBin = fFlatNUE.fZ.FindBin(vz);
+  int stride = fFlatNUE.fX.fN + 2;
+  const double* inverse = fFlatNUE.fInverse.data() + vzBin * (fFlatNUE.fY.fN + 2) * stride;
+  for (int i = 1; i < nTracks; i++)
+    weights[i] = inverse[fFlatNUE.fY.FindBin(eta[i]) * stride + fFlatNUE.fX.FindBin(pt[i])];
+}
+void GFWWeights::FlatAxis::Set(const TAxis* ax)
+{
+  fN = ax->GetNbins();
+  fMin = ax->GetXmin();
+  fMax = ax->GetXmax();
+  fEdges.clear();
+  if (ax->GetXbins()->GetSize())
+    fEdges.assign(ax->GetXbins()->GetArray(), ax->GetXbins()->GetArray() + fN + 1);
+}
+int GFWWeights::FlatAxis::FindBin(double x) const
+{
+  // Same bins as TAxis::FindBin, including under- and overflow
+  if (x < fMin)
+    return 0;
+  if (!(x < fMax))
+    return fN + 1;
+  if (fEdges.empty())
+    return 1 + static_cast<int>(fN * (x - fMin) / (fMax - fMin));
+  return static_cast<int>(std::upper_bound(fEdges.begin(), fEdges.end(), x) - fEdges.begin());
+}
+void GFWWeights::FlatWeights::Build(TH3D* inh)
+{
+  fInverse.clear();
+  if (!inh)
+    return;
+  fX.Set(inh->GetXaxis());
+  fY.Set(inh->GetYaxis());
+  fZ.Set(inh->GetZaxis());
+  int nCells = inh->GetNcells();
+  fInverse.resize(nCells);
+  for (int bin = 0; bin < nCells; bin++) {
+    double weight = inh->GetBinContent(bin);
+    fInverse[bin] = (weight != 0) ? 1. / weight : 1;
+  }
 }
 double GFWWeights::FindMax(TH3D* inh, int& ix, int& iy, int& iz)
 {
@@ -216,6 +276,7 @@ void GFWWeights::CreateNUA(bool IntegrateOverCentAndPt)
   if (IntegrateOverCentAndPt) {
     if (fAccInt)
       delete fAccInt;
+    fFlatNUA.Clear();
     fAccInt = reinterpret_cast<TH3D*>(fW_data->At(0)->Clone("IntegratedAcceptance"));
     fAccInt->Sumw2();
     for (int etai = 1; etai <= fAccInt->GetNbinsY(); etai++) {
@@ -276,6 +337,7 @@ void GFWWeights::CreateNUE(bool IntegrateOverCentrality)
     den->RebinY(2);
     num->RebinZ(5);
     den->RebinZ(5);
+    fFlatNUE.Clear();
     fEffInt = reinterpret_cast<TH3D*>(num->Clone("Efficiency_Integrated"));
     fEffInt->Divide(den);
     return;
@@ -362,6 +424,8 @@ void GFWWeights::OverwriteNUA()
   delete trash;
   fW_data->Add(reinterpret_cast<TH3D*>(fAccInt->Clone(ts.Data())));
   delete fAccInt;
+  fAccInt = 0;
+  fFlatNUA.Clear();
 }
 Long64_t GFWWeights::Merge(TCollection* collist)
 {
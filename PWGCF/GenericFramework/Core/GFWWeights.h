@@ -19,6 +19,8 @@
 #include "TFile.h"
 #include "TCollection.h"
 #include "TString.h"
+#include "TAxis.h"
+#include <vector>
 
 class GFWWeights : public TNamed
 {
@@ -31,6 +33,8 @@ class GFWWeights : public TNamed
   double GetWeight(double phi, double eta, double vz, double pt, double cent, int htype);             // htype: 0 for data, 1 for mc rec, 2 for mc gen
   double GetNUA(double phi, double eta, double vz);                                                   // This just fetches correction from integrated NUA, should speed up
   double GetNUE(double pt, double eta, double vz);                                                    // fetches weight from fEffInt
+  void GetNUA(int nTracks, const double* phi, const double* eta, double vz, double* weights);          // GetNUA for the tracks of one collision
+  void GetNUE(int nTracks, const double* pt, const double* eta, double vz, double* weights);           // GetNUE for the tracks of one collision
   bool IsDataFilled() { return fDataFilled; }
   bool IsMCFilled() { return fMCFilled; }
   double FindMax(TH3D* inh, int& ix, int& iy, int& iz);
@@ -65,6 +69,26 @@ class GFWWeights : public TNamed
   int fNbinsPt;    //! do not store
   double* fbinsPt; //! do not store
   void AddArray(TObjArray* targ, TObjArray* sour);
+  // Flat copy of a TH3D holding 1/content (1 for empty bins), with the bin search of TAxis done arithmetically for
+  // uniform axes and on an edge table otherwise. Built on first use from fAccInt or fEffInt, cleared when they change
+  struct FlatAxis {
+    int fN = 0;
+    double fMin = 0, fMax = 0;
+    std::vector<double> fEdges; // empty for uniform binning
+    void Set(const TAxis* ax);
+    int FindBin(double x) const;
+  };
+  struct FlatWeights {
+    FlatAxis fX, fY, fZ;
+    std::vector<double> fInverse;
+    void Build(TH3D* inh);
+    void Clear() { fInverse.clear(); }
+    bool IsBuilt() const { return !fInverse.empty(); }
+    int RowOffset(double y, double z) const { return (fZ.FindBin(z) * (fY.fN + 2) + fY.FindBin(y)) * (fX.fN + 2); }
+    double Get(double x, double y, double z) const { return fInverse[RowOffset(y, z) + fX.FindBin(x)]; }
+  };
+  FlatWeights fFlatNUA; //!
+  FlatWeights fFlatNUE; //!
   const char* GetBinName(double /*ptv*/, double /*v0mv*/, const char* pf = "")
   {
     int ptind = 0;  // GetPtBin(ptv);
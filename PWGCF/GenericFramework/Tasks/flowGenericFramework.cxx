@@ -77,6 +77,7 @@ using namespace o2::analysis::genericframework;
 struct GenericFramework {
 
   O2_DEFINE_CONFIGURABLE(cfgNbootstrap, int, 10, "Number of subsamples")
+  O2_DEFINE_CONFIGURABLE(cfgDenseSubsamples, bool, false, "Store the subsamples as dense sums, converted to profiles at post-processing")
   O2_DEFINE_CONFIGURABLE(cfgMpar, int, 8, "Highest order of pt-pt correlations")
   O2_DEFINE_CONFIGURABLE(cfgUseNch, bool, false, "Do correlations as function of Nch")
   O2_DEFINE_CONFIGURABLE(cfgFillWeights, bool, false, "Fill NUA weights")
@@ -118,6 +119,27 @@ struct GenericFramework {
 
   // define global variables
   GFW* fGFW = new GFW();
+  // Tracks of the current collision, filled to GFW in one call
+  struct GFWBatch {
+    std::vector<double> eta, phi, weight;
+    std::vector<int> ptBin, mask;
+    void clear()
+    {
+      eta.clear();
+      phi.clear();
+      weight.clear();
+      ptBin.clear();
+      mask.clear();
+    }
+    void add(double lEta, int lPtBin, double lPhi, double lWeight, int lMask)
+    {
+      eta.push_back(lEta);
+      ptBin.push_back(lPtBin);
+      phi.push_back(lPhi);
+      weight.push_back(lWeight);
+      mask.push_back(lMask);
+    }
+  } fGFWBatch;
   std::vector<GFW::CorrConfig> corrconfigs;
   TRandom3* fRndm = new TRandom3(0);
   TAxis* fPtAxis;
@@ -231,11 +253,13 @@ struct GenericFramework {
     if (doprocessData || doprocessRun2 || doprocessMCReco) {
       fFC->SetName("FlowContainer");
       fFC->SetXAxis(fPtAxis);
+      fFC->SetDenseSubsamples(cfgDenseSubsamples);
       fFC->Initialize(oba, multAxis, cfgNbootstrap);
     }
     if (doprocessMCGen) {
       fFC_gen->SetName("FlowContainer_gen");
       fFC_gen->SetXAxis(fPtAxis);
+      fFC_gen->SetDenseSubsamples(cfgDenseSubsamples);
       fFC_gen->Initialize(oba, multAxis, cfgNbootstrap);
     }
     delete oba;
@@ -452,11 +476,13 @@ struct GenericFramework {
       return;
     float vtxz = collision.posZ();
     fGFW->Clear();
+    fGFWBatch.clear();
     fFCpt->ClearVector();
     float l_Random = fRndm->Rndm();
     for (auto& track : tracks) {
       ProcessTrack(track, centrality, vtxz, field);
     }
+    fGFW->FillBatch(fGFWBatch.eta.data(), fGFWBatch.ptBin.data(), fGFWBatch.phi.data(), fGFWBatch.weight.data(), fGFWBatch.mask.data(), static_cast<int>(fGFWBatch.eta.size()));
     FillOutputContainers<dt>((cfgUseNch) ? tracks.size() : centrality, l_Random);
   }
 
@@ -521,12 +547,15 @@ struct GenericFramework {
     fFCpt->Fill(weff, track.pt());
     bool WithinPtPOI = (ptpoilow < track.pt()) && (track.pt() < ptpoiup); // within POI pT range
     bool WithinPtRef = (ptreflow < track.pt()) && (track.pt() < ptrefup); // within RF pT range
+    if (!WithinPtRef && !WithinPtPOI)
+      return;
+    int ptBin = fPtAxis->FindBin(track.pt()) - 1;
     if (WithinPtRef)
-      fGFW->Fill(track.eta(), fPtAxis->FindBin(track.pt()) - 1, track.phi(), weff * wacc, 1);
+      fGFWBatch.add(track.eta(), ptBin, track.phi(), weff * wacc, 1);
     if (WithinPtPOI)
-      fGFW->Fill(track.eta(), fPtAxis->FindBin(track.pt()) - 1, track.phi(), weff * wacc, 2);
+      fGFWBatch.add(track.eta(), ptBin, track.phi(), weff * wacc, 2);
     if (WithinPtPOI && WithinPtRef)
-      fGFW->Fill(track.eta(), fPtAxis->FindBin(track.pt()) - 1, track.phi(), weff * wacc, 4);
+      fGFWBatch.add(track.eta(), ptBin, track.phi(), weff * wacc, 4);
     return;
   }
 
@@ -13,8 +13,8 @@
 /// \since Sep 2022
 
 #include <TMath.h>
-#include <TComplex.h>
 #include <algorithm>
+#include <complex>
 #include "JFFlucAnalysis.h"
 
 JFFlucAnalysis::JFFlucAnalysis() : TNamed(),
@@ -79,47 +79,47 @@ JFFlucAnalysis::~JFFlucAnalysis()
   //
 }
 
-#define C(u) TComplex::Conjugate(u)
+#define C(u) std::conj(u)
 // TODO: conjugate macro
-inline TComplex TwoGap(const TComplex (&Qa)[JFFlucAnalysis::kNH][JFFlucAnalysis::nKL], const TComplex (&Qb)[JFFlucAnalysis::kNH][JFFlucAnalysis::nKL], UInt_t a, UInt_t b)
+inline JFFlucAnalysis::Complex TwoGap(const JFFlucAnalysis::Complex (&Qa)[JFFlucAnalysis::kNH][JFFlucAnalysis::nKL], const JFFlucAnalysis::Complex (&Qb)[JFFlucAnalysis::kNH][JFFlucAnalysis::nKL], UInt_t a, UInt_t b)
 {
   return Qa[a][1] * C(Qb[b][1]);
 }
 
-inline TComplex ThreeGap(const TComplex (&Qa)[JFFlucAnalysis::kNH][JFFlucAnalysis::nKL], const TComplex (&Qb)[JFFlucAnalysis::kNH][JFFlucAnalysis::nKL], UInt_t a, UInt_t b, UInt_t c)
+inline JFFlucAnalysis::Complex ThreeGap(const JFFlucAnalysis::Complex (&Qa)[JFFlucAnalysis::kNH][JFFlucAnalysis::nKL], const JFFlucAnalysis::Complex (&Qb)[JFFlucAnalysis::kNH][JFFlucAnalysis::nKL], UInt_t a, UInt_t b, UInt_t c)
 {
   return Qa[a][1] * C(Qb[b][1] * Qb[c][1] - Qb[b + c][2]);
 }
 
-inline TComplex FourGap22(const TComplex (&Qa)[JFFlucAnalysis::kNH][JFFlucAnalysis::nKL], const TComplex (&Qb)[JFFlucAnalysis::kNH][JFFlucAnalysis::nKL], UInt_t a, UInt_t b, UInt_t c, UInt_t d)
+inline JFFlucAnalysis::Complex FourGap22(const JFFlucAnalysis::Complex (&Qa)[JFFlucAnalysis::kNH][JFFlucAnalysis::nKL], const JFFlucAnalysis::Complex (&Qb)[JFFlucAnalysis::kNH][JFFlucAnalysis::nKL], UInt_t a, UInt_t b, UInt_t c, UInt_t d)
 {
   return Qa[a][1] * Qa[b][1] * C(Qb[c][1] * Qb[d][1]) - Qa[a + b][2] * C(Qb[c][1] * Qb[d][1]) - Qa[a][1] * Qa[b][1] * C(Qb[c + d][2]) + Qa[a + b][2] * C(Qb[c + d][2]);
 }
 
-inline TComplex FourGap13(const TComplex (&Qa)[JFFlucAnalysis::kNH][JFFlucAnalysis::nKL], const TComplex (&Qb)[JFFlucAnalysis::kNH][JFFlucAnalysis::nKL], UInt_t a, UInt_t b, UInt_t c, UInt_t d)
+inline JFFlucAnalysis::Complex FourGap13(const JFFlucAnalysis::Complex (&Qa)[JFFlucAnalysis::kNH][JFFlucAnalysis::nKL], const JFFlucAnalysis::Complex (&Qb)[JFFlucAnalysis::kNH][JFFlucAnalysis::nKL], UInt_t a, UInt_t b, UInt_t c, UInt_t d)
 {
   return Qa[a][1] * C(Qb[b][1] * Qb[c][1] * Qb[d][1] - Qb[b + c][2] * Qb[d][1] - Qb[b + d][2] * Qb[c][1] - Qb[c + d][2] * Qb[b][1] + 2.0 * Qb[b + c + d][3]);
 }
 
-inline TComplex SixGap33(const TComplex (&Qa)[JFFlucAnalysis::kNH][JFFlucAnalysis::nKL], const TComplex (&Qb)[JFFlucAnalysis::kNH][JFFlucAnalysis::nKL], UInt_t n1, UInt_t n2, UInt_t n3, UInt_t n4, UInt_t n5, UInt_t n6)
+inline JFFlucAnalysis::Complex SixGap33(const JFFlucAnalysis::Complex (&Qa)[JFFlucAnalysis::kNH][JFFlucAnalysis::nKL], const JFFlucAnalysis::Complex (&Qb)[JFFlucAnalysis::kNH][JFFlucAnalysis::nKL], UInt_t n1, UInt_t n2, UInt_t n3, UInt_t n4, UInt_t n5, UInt_t n6)
 {
   return Qa[n1][1] * Qa[n2][1] * Qa[n3][1] * C(Qb[n4][1] * Qb[n5][1] * Qb[n6][1]) - Qa[n1][1] * Qa[n2][1] * Qa[n3][1] * C(Qb[n4 + n5][2] * Qb[n6][1]) - Qa[n1][1] * Qa[n2][1] * Qa[n3][1] * C(Qb[n4 + n6][2] * Qb[n5][1]) - Qa[n1][1] * Qa[n2][1] * Qa[n3][1] * C(Qb[n5 + n6][2] * Qb[n4][1]) + 2.0 * Qa[n1][1] * Qa[n2][1] * Qa[n3][1] * C(Qb[n4 + n5 + n6][3]) - Qa[n1 + n2][2] * Qa[n3][1] * C(Qb[n4][1] * Qb[n5][1] * Qb[n6][1]) + Qa[n1 + n2][2] * Qa[n3][1] * C(Qb[n4 + n5][2] * Qb[n6][1]) + Qa[n1 + n2][2] * Qa[n3][1] * C(Qb[n4 + n6][2] * Qb[n5][1]) + Qa[n1 + n2][2] * Qa[n3][1] * C(Qb[n5 + n6][2] * Qb[n4][1]) - 2.0 * Qa[n1 + n2][2] * Qa[n3][1] * C(Qb[n4 + n5 + n6][3]) - Qa[n1 + n3][2] * Qa[n2][1] * C(Qb[n4][1] * Qb[n5][1] * Qb[n6][1]) + Qa[n1 + n3][2] * Qa[n2][1] * C(Qb[n4 + n5][2] * Qb[n6][1]) + Qa[n1 + n3][2] * Qa[n2][1] * C(Qb[n4 + n6][2] * Qb[n5][1]) + Qa[n1 + n3][2] * Qa[n2][1] * C(Qb[n5 + n6][2] * Qb[n4][1]) - 2.0 * Qa[n1 + n3][2] * Qa[n2][1] * C(Qb[n4 + n5 + n6][3]) - Qa[n2 + n3][2] * Qa[n1][1] * C(Qb[n4][1] * Qb[n5][1] * Qb[n6][1]) + Qa[n2 + n3][2] * Qa[n1][1] * C(Qb[n4 + n5][2] * Qb[n6][1]) + Qa[n2 + n3][2] * Qa[n1][1] * C(Qb[n4 + n6][2] * Qb[n5][1]) + Qa[n2 + n3][2] * Qa[n1][1] * C(Qb[n5 + n6][2] * Qb[n4][1]) - 2.0 * Qa[n2 + n3][2] * Qa[n1][1] * C(Qb[n4 + n5 + n6][3]) + 2.0 * Qa[n1 + n2 + n3][3] * C(Qb[n4][1] * Qb[n5][1] * Qb[n6][1]) - 2.0 * Qa[n1 + n2 + n3][3] * C(Qb[n4 + n5][2] * Qb[n6][1]) - 2.0 * Qa[n1 + n2 + n3][3] * C(Qb[n4 + n6][2] * Qb[n5][1]) - 2.0 * Qa[n1 + n2 + n3][3] * C(Qb[n5 + n6][2] * Qb[n4][1]) + 4.0 * Qa[n1 + n2 + n3][3] * C(Qb[n4 + n5 + n6][3]);
 }
 
-TComplex JFFlucAnalysis::Q(int n, int p)
+JFFlucAnalysis::Complex JFFlucAnalysis::Q(int n, int p) const
 {
   // Return QvectorQC
   // Q{-n, p} = Q{n, p}*
   return n >= 0 ? pqvecs->QvectorQC[n][p] : C(pqvecs->QvectorQC[-n][p]);
 }
 
-TComplex JFFlucAnalysis::Two(int n1, int n2)
+JFFlucAnalysis::Complex JFFlucAnalysis::Two(int n1, int n2) const
 {
   // two-particle correlation <exp[i(n1*phi1 + n2*phi2)]>
   return Q(n1, 1) * Q(n2, 1) - Q(n1 + n2, 2);
 }
 
-TComplex JFFlucAnalysis::Four(int n1, int n2, int n3, int n4)
+JFFlucAnalysis::Complex JFFlucAnalysis::Four(int n1, int n2, int n3, int n4) const
 {
 
   return Q(n1, 1) * Q(n2, 1) * Q(n3, 1) * Q(n4, 1) - Q(n1 + n2, 2) * Q(n3, 1) * Q(n4, 1) - Q(n2, 1) * Q(n1 + n3, 2) * Q(n4, 1) - Q(n1, 1) * Q(n2 + n3, 2) * Q(n4, 1) + 2. * Q(n1 + n2 + n3, 3) * Q(n4, 1) - Q(n2, 1) * Q(n3, 1) * Q(n1 + n4, 2) + Q(n2 + n3, 2) * Q(n1 + n4, 2) - Q(n1, 1) * Q(n3, 1) * Q(n2 + n4, 2) + Q(n1 + n3, 2) * Q(n2 + n4, 2) + 2. * Q(n3, 1) * Q(n1 + n2 + n4, 3) - Q(n1, 1) * Q(n2, 1) * Q(n3 + n4, 2) + Q(n1 + n2, 2) * Q(n3 + n4, 2) + 2. * Q(n2, 1) * Q(n1 + n3 + n4, 3) + 2. * Q(n1, 1) * Q(n2 + n3 + n4, 3) - 6. * Q(n1 + n2 + n3 + n4, 4);
@@ -129,20 +129,20 @@ TComplex JFFlucAnalysis::Four(int n1, int n2, int n3, int n4)
 //________________________________________________________________________
 void JFFlucAnalysis::UserExec(Option_t* /*popt*/)
 {
-  TComplex corr[kNH][nKL];
-  TComplex ncorr[kNH][nKL];
-  TComplex ncorr2[kNH][nKL][kcNH][nKL];
+  Complex corr[kNH][nKL];
+  Complex ncorr[kNH][nKL];
+  Complex ncorr2[kNH][nKL][kcNH][nKL];
 
   for (UInt_t i = 0; i < 2; ++i) {
     if ((subeventMask & (1 << i)) == 0)
       continue;
     decltype(pqvecs->QvectorQCgap[i])& Qa = pqvecs->QvectorQCgap[i];
     decltype(pqvecs->QvectorQCgap[1 - i])& Qb = (pqvecsRef ? pqvecsRef : pqvecs)->QvectorQCgap[1 - i]; // A & B subevents from POI and REF, when given
-    Double_t ref_2p = TwoGap(Qa, Qb, 0, 0).Re();
-    Double_t ref_3p = ThreeGap(Qa, Qb, 0, 0, 0).Re();
-    Double_t ref_4p = FourGap22(Qa, Qb, 0, 0, 0, 0).Re();
-    Double_t ref_4pB = FourGap13(Qa, Qb, 0, 0, 0, 0).Re();
-    Double_t ref_6p = SixGap33(Qa, Qb, 0, 0, 0, 0, 0, 0).Re();
+    Double_t ref_2p = TwoGap(Qa, Qb, 0, 0).real();
+    Double_t ref_3p = ThreeGap(Qa, Qb, 0, 0, 0).real();
+    Double_t ref_4p = FourGap22(Qa, Qb, 0, 0, 0, 0).real();
+    Double_t ref_4pB = FourGap13(Qa, Qb, 0, 0, 0, 0).real();
+    Double_t ref_6p = SixGap33(Qa, Qb, 0, 0, 0, 0, 0, 0).real();
 
     Double_t ebe_2p_weight = 1.0;
     Double_t ebe_3p_weight = 1.0;
@@ -167,13 +167,13 @@ void JFFlucAnalysis::UserExec(Option_t* /*popt*/)
     if (flags & kFlucEbEWeighting) {
       for (UInt_t ik = 3; ik < 2 * nKL; ik++) {
         double dk = static_cast<double>(ik);
-        ref_2Np[ik] = ref_2Np[ik - 1] * std::max(Qa[0][1].Re() - dk, 1.0) * std::max(Qb[0][1].Re() - dk, 1.0);
-        ebe_2Np_weight[ik] = ebe_2Np_weight[ik - 1] * std::max(Qa[0][1].Re() - dk, 1.0) * std::max(Qb[0][1].Re() - dk, 1.0);
+        ref_2Np[ik] = ref_2Np[ik - 1] * std::max(Qa[0][1].real() - dk, 1.0) * std::max(Qb[0][1].real() - dk, 1.0);
+        ebe_2Np_weight[ik] = ebe_2Np_weight[ik - 1] * std::max(Qa[0][1].real() - dk, 1.0) * std::max(Qb[0][1].real() - dk, 1.0);
       }
     } else {
       for (UInt_t ik = 3; ik < 2 * nKL; ik++) {
         double dk = static_cast<double>(ik);
-        ref_2Np[ik] = ref_2Np[ik - 1] * std::max(Qa[0][1].Re() - dk, 1.0) * std::max(Qb[0][1].Re() - dk, 1.0);
+        ref_2Np[ik] = ref_2Np[ik - 1] * std::max(Qa[0][1].real() - dk, 1.0) * std::max(Qb[0][1].real() - dk, 1.0);
         ebe_2Np_weight[ik] = 1.0;
       }
     }
@@ -181,7 +181,7 @@ void JFFlucAnalysis::UserExec(Option_t* /*popt*/)
     for (UInt_t ih = 2; ih < kNH; ih++) {
       corr[ih][1] = TwoGap(Qa, Qb, ih, ih);
       for (UInt_t ik = 2; ik < nKL; ik++)
-        corr[ih][ik] = corr[ih][ik - 1] * corr[ih][1]; // TComplex::Power(corr[ih][1],ik);
+        corr[ih][ik] = corr[ih][ik - 1] * corr[ih][1];
       ncorr[ih][1] = corr[ih][1];
       ncorr[ih][2] = FourGap22(Qa, Qb, ih, ih, ih, ih);
       ncorr[ih][3] = SixGap33(Qa, Qb, ih, ih, ih, ih, ih, ih);
@@ -200,13 +200,13 @@ void JFFlucAnalysis::UserExec(Option_t* /*popt*/)
 
     for (UInt_t ih = 2; ih < kNH; ih++) {
       for (UInt_t ik = 1; ik < nKL; ik++) { // 2k(0) =1, 2k(1) =2, 2k(2)=4....
-                                            // vn2[ih][ik] = corr[ih][ik].Re() / ref_2Np[ik - 1];
+                                            // vn2[ih][ik] = corr[ih][ik].real() / ref_2Np[ik - 1];
         // fh_vn[ih][ik][fCBin]->Fill(vn2[ih][ik], ebe_2Np_weight[ik - 1]);
-        // fh_vna[ih][ik][fCBin]->Fill(ncorr[ih][ik].Re() / ref_2Np[ik - 1], ebe_2Np_weight[ik - 1]);
-        phs[HIST_THN_SPARSE_VN]->Fill(fCent, ih, ik, ncorr[ih][ik].Re() / ref_2Np[ik - 1], ebe_2Np_weight[ik - 1]);
+        // fh_vna[ih][ik][fCBin]->Fill(ncorr[ih][ik].real() / ref_2Np[ik - 1], ebe_2Np_weight[ik - 1]);
+        phs[HIST_THN_SPARSE_VN]->Fill(fCent, ih, ik, ncorr[ih][ik].real() / ref_2Np[ik - 1], ebe_2Np_weight[ik - 1]);
         for (UInt_t ihh = 2; ihh < kcNH; ihh++) {
           for (UInt_t ikk = 1; ikk < nKL; ikk++) {
-            Double_t vn2_vn2 = ncorr2[ih][ik][ihh][ikk] / ref_2Np[ik + ikk - 1];
+            Double_t vn2_vn2 = ncorr2[ih][ik][ihh][ikk].real() / ref_2Np[ik + ikk - 1];
             phs[HIST_THN_SPARSE_VN_VN]->Fill(fCent, ih, ik, ihh, ikk, vn2_vn2, ebe_2Np_weight[ik + ikk - 1]);
           }
         }
@@ -214,95 +214,99 @@ void JFFlucAnalysis::UserExec(Option_t* /*popt*/)
     }
 
     //************************************************************************
-    TComplex V4V2star_2 = Qa[4][1] * Qb[2][1] * Qb[2][1];
-    TComplex V4V2starv2_2 = V4V2star_2 * corr[2][1] / ref_2Np[0];                           // vn[2][1]
-    TComplex V4V2starv2_4 = V4V2star_2 * corr[2][2] / ref_2Np[1];                           // vn2[2][2]
-    TComplex V5V2starV3starv2_2 = Qa[5][1] * Qb[2][1] * Qb[3][1] * corr[2][1] / ref_2Np[0]; // vn2[2][1]
-    TComplex V5V2starV3star = Qa[5][1] * Qb[2][1] * Qb[3][1];
-    TComplex V5V2starV3startv3_2 = V5V2starV3star * corr[3][1] / ref_2Np[0]; // vn2[3][1]
-    TComplex V6V2star_3 = Qa[6][1] * Qb[2][1] * Qb[2][1] * Qb[2][1];
-    TComplex V6V3star_2 = Qa[6][1] * Qb[3][1] * Qb[3][1];
-    TComplex V6V2starV4star = Qa[6][1] * Qb[2][1] * Qb[4][1];
-    TComplex V7V2star_2V3star = Qa[7][1] * Qb[2][1] * Qb[2][1] * Qb[3][1];
-    TComplex V7V2starV5star = Qa[7][1] * Qb[2][1] * Qb[5][1];
-    TComplex V7V3starV4star = Qa[7][1] * Qb[3][1] * Qb[4][1];
-    TComplex V8V2starV3star_2 = Qa[8][1] * Qb[2][1] * Qb[3][1] * Qb[3][1];
-    TComplex V8V2star_4 = Qa[8][1] * TComplex::Power(Qb[2][1], 4);
+    Complex V4V2star_2 = Qa[4][1] * Qb[2][1] * Qb[2][1];
+    Complex V4V2starv2_2 = V4V2star_2 * corr[2][1] / ref_2Np[0];                           // vn[2][1]
+    Complex V4V2starv2_4 = V4V2star_2 * corr[2][2] / ref_2Np[1];                           // vn2[2][2]
+    Complex V5V2starV3starv2_2 = Qa[5][1] * Qb[2][1] * Qb[3][1] * corr[2][1] / ref_2Np[0]; // vn2[2][1]
+    Complex V5V2starV3star = Qa[5][1] * Qb[2][1] * Qb[3][1];
+    Complex V5V2starV3startv3_2 = V5V2starV3star * corr[3][1] / ref_2Np[0]; // vn2[3][1]
+    Complex V6V2star_3 = Qa[6][1] * Qb[2][1] * Qb[2][1] * Qb[2][1];
+    Complex V6V3star_2 = Qa[6][1] * Qb[3][1] * Qb[3][1];
+    Complex V6V2starV4star = Qa[6][1] * Qb[2][1] * Qb[4][1];
+    Complex V7V2star_2V3star = Qa[7][1] * Qb[2][1] * Qb[2][1] * Qb[3][1];
+    Complex V7V2starV5star = Qa[7][1] * Qb[2][1] * Qb[5][1];
+    Complex V7V3starV4star = Qa[7][1] * Qb[3][1] * Qb[4][1];
+    Complex V8V2starV3star_2 = Qa[8][1] * Qb[2][1] * Qb[3][1] * Qb[3][1];
+    Complex V8V2star_4 = Qa[8][1] * ((Qb[2][1] * Qb[2][1]) * (Qb[2][1] * Qb[2][1]));
 
     // New correlators (Modified by You's correction term for self-correlations)
-    TComplex nV4V2star_2 = ThreeGap(Qa, Qb, 4, 2, 2) / ref_3p;
-    TComplex nV5V2starV3star = ThreeGap(Qa, Qb, 5, 2, 3) / ref_3p;
-    TComplex nV6V2star_3 = FourGap13(Qa, Qb, 6, 2, 2, 2) / ref_4pB;
-    TComplex nV6V3star_2 = ThreeGap(Qa, Qb, 6, 3, 3) / ref_3p;
-    TComplex nV6V2starV4star = ThreeGap(Qa, Qb, 6, 2, 4) / ref_3p;
-    TComplex nV7V2star_2V3star = FourGap13(Qa, Qb, 7, 2, 2, 3) / ref_4pB;
-    TComplex nV7V2starV5star = ThreeGap(Qa, Qb, 7, 2, 5) / ref_3p;
-    TComplex nV7V3starV4star = ThreeGap(Qa, Qb, 7, 3, 4) / ref_3p;
-    TComplex nV8V2starV3star_2 = FourGap13(Qa, Qb, 8, 2, 3, 3) / ref_4pB;
-
-    TComplex nV4V4V2V2 = FourGap22(Qa, Qb, 4, 2, 4, 2) / ref_4p;
-    TComplex nV3V3V2V2 = FourGap22(Qa, Qb, 3, 2, 3, 2) / ref_4p;
-    TComplex nV5V5V2V2 = FourGap22(Qa, Qb, 5, 2, 5, 2) / ref_4p;
-    TComplex nV5V5V3V3 = FourGap22(Qa, Qb, 5, 3, 5, 3) / ref_4p;
-    TComplex nV4V4V3V3 = FourGap22(Qa, Qb, 4, 3, 4, 3) / ref_4p;
-
-    pht[HIST_THN_V4V2starv2_2]->Fill(fCent, V4V2starv2_2.Re());
-    pht[HIST_THN_V4V2starv2_4]->Fill(fCent, V4V2starv2_4.Re());
-    pht[HIST_THN_V4V2star_2]->Fill(fCent, V4V2star_2.Re(), ebe_3p_weight); // added 2015.3.18
-    pht[HIST_THN_V5V2starV3starv2_2]->Fill(fCent, V5V2starV3starv2_2.Re());
-    pht[HIST_THN_V5V2starV3star]->Fill(fCent, V5V2starV3star.Re(), ebe_3p_weight);
-    pht[HIST_THN_V5V2starV3startv3_2]->Fill(fCent, V5V2starV3startv3_2.Re());
-    pht[HIST_THN_V6V2star_3]->Fill(fCent, V6V2star_3.Re(), ebe_4p_weightB);
-    pht[HIST_THN_V6V3star_2]->Fill(fCent, V6V3star_2.Re(), ebe_3p_weight);
-    pht[HIST_THN_V7V2star_2V3star]->Fill(fCent, V7V2star_2V3star.Re(), ebe_4p_weightB);
-
-    pht[HIST_THN_V4V2star_2]->Fill(fCent, nV4V2star_2.Re(), ebe_3p_weight); // added 2015.6.10
-    pht[HIST_THN_V5V2starV3star]->Fill(fCent, nV5V2starV3star.Re(), ebe_3p_weight);
-    pht[HIST_THN_V6V3star_2]->Fill(fCent, nV6V3star_2.Re(), ebe_3p_weight);
+    Complex nV4V2star_2 = ThreeGap(Qa, Qb, 4, 2, 2) / ref_3p;
+    Complex nV5V2starV3star = ThreeGap(Qa, Qb, 5, 2, 3) / ref_3p;
+    Complex nV6V2star_3 = FourGap13(Qa, Qb, 6, 2, 2, 2) / ref_4pB;
+    Complex nV6V3star_2 = ThreeGap(Qa, Qb, 6, 3, 3) / ref_3p;
+    Complex nV6V2starV4star = ThreeGap(Qa, Qb, 6, 2, 4) / ref_3p;
+    Complex nV7V2star_2V3star = FourGap13(Qa, Qb, 7, 2, 2, 3) / ref_4pB;
+    Complex nV7V2starV5star = ThreeGap(Qa, Qb, 7, 2, 5) / ref_3p;
+    Complex nV7V3starV4star = ThreeGap(Qa, Qb, 7, 3, 4) / ref_3p;
+    Complex nV8V2starV3star_2 = FourGap13(Qa, Qb, 8, 2, 3, 3) / ref_4pB;
+
+    Complex nV4V4V2V2 = FourGap22(Qa, Qb, 4, 2, 4, 2) / ref_4p;
+    Complex nV3V3V2V2 = FourGap22(Qa, Qb, 3, 2, 3, 2) / ref_4p;
+    Complex nV5V5V2V2 = FourGap22(Qa, Qb, 5, 2, 5, 2) / ref_4p;
+    Complex nV5V5V3V3 = FourGap22(Qa, Qb, 5, 3, 5, 3) / ref_4p;
+    Complex nV4V4V3V3 = FourGap22(Qa, Qb, 4, 3, 4, 3) / ref_4p;
+
+    pht[HIST_THN_V4V2starv2_2]->Fill(fCent, V4V2starv2_2.real());
+    pht[HIST_THN_V4V2starv2_4]->Fill(fCent, V4V2starv2_4.real());
+    pht[HIST_THN_V4V2star_2]->Fill(fCent, V4V2star_2.real(), ebe_3p_weight); // added 2015.3.18
+    pht[HIST_THN_V5V2starV3starv2_2]->Fill(fCent, V5V2starV3starv2_2.real());
+    pht[HIST_THN_V5V2starV3star]->Fill(fCent, V5V2starV3star.real(), ebe_3p_weight);
+    pht[HIST_THN_V5V2starV3startv3_2]->Fill(fCent, V5V2starV3startv3_2.real());
+    pht[HIST_THN_V6V2star_3]->Fill(fCent, V6V2star_3.real(), ebe_4p_weightB);
+    pht[HIST_THN_V6V3star_2]->Fill(fCent, V6V3star_2.real(), ebe_3p_weight);
+    pht[HIST_THN_V7V2star_2V3star]->Fill(fCent, V7V2star_2V3star.real(), ebe_4p_weightB);
+
+    pht[HIST_THN_V4V2star_2]->Fill(fCent, nV4V2star_2.real(), ebe_3p_weight); // added 2015.6.10
+    pht[HIST_THN_V5V2starV3star]->Fill(fCent, nV5V2starV3star.real(), ebe_3p_weight);
+    pht[HIST_THN_V6V3star_2]->Fill(fCent, nV6V3star_2.real(), ebe_3p_weight);
 
     // use this to avoid self-correlation 4p correlation (2 particles from A, 2 particles from B) -> MA(MA-1)MB(MB-1) : evt weight..
-    pht[HIST_THN_nV4V4V2V2]->Fill(fCent, nV4V4V2V2.Re(), ebe_2Np_weight[1]);
-    pht[HIST_THN_nV3V3V2V2]->Fill(fCent, nV3V3V2V2.Re(), ebe_2Np_weight[1]);
+    pht[HIST_THN_nV4V4V2V2]->Fill(fCent, nV4V4V2V2.real(), ebe_2Np_weight[1]);
+    pht[HIST_THN_nV3V3V2V2]->Fill(fCent, nV3V3V2V2.real(), ebe_2Np_weight[1]);
 
-    pht[HIST_THN_nV5V5V2V2]->Fill(fCent, nV5V5V2V2.Re(), ebe_2Np_weight[1]);
-    pht[HIST_THN_nV5V5V3V3]->Fill(fCent, nV5V5V3V3.Re(), ebe_2Np_weight[1]);
-    pht[HIST_THN_nV4V4V3V3]->Fill(fCent, nV4V4V3V3.Re(), ebe_2Np_weight[1]);
+    pht[HIST_THN_nV5V5V2V2]->Fill(fCent, nV5V5V2V2.real(), ebe_2Np_weight[1]);
+    pht[HIST_THN_nV5V5V3V3]->Fill(fCent, nV5V5V3V3.real(), ebe_2Np_weight[1]);
+    pht[HIST_THN_nV4V4V3V3]->Fill(fCent, nV4V4V3V3.real(), ebe_2Np_weight[1]);
 
     // higher order correlators, added 2017.8.10
-    pht[HIST_THN_V8V2starV3star_2]->Fill(fCent, V8V2starV3star_2.Re(), ebe_4p_weightB);
-    pht[HIST_THN_V8V2star_4]->Fill(fCent, V8V2star_4.Re()); // 5p weight
-    pht[HIST_THN_V6V2star_3]->Fill(fCent, nV6V2star_3.Re(), ebe_4p_weightB);
-    pht[HIST_THN_V7V2star_2V3star]->Fill(fCent, nV7V2star_2V3star.Re(), ebe_4p_weightB);
-    pht[HIST_THN_V8V2starV3star_2]->Fill(fCent, nV8V2starV3star_2.Re(), ebe_4p_weightB);
-
-    pht[HIST_THN_V6V2starV4star]->Fill(fCent, V6V2starV4star.Re(), ebe_3p_weight);
-    pht[HIST_THN_V7V2starV5star]->Fill(fCent, V7V2starV5star.Re(), ebe_3p_weight);
-    pht[HIST_THN_V7V3starV4star]->Fill(fCent, V7V3starV4star.Re(), ebe_3p_weight);
-    pht[HIST_THN_V6V2starV4star]->Fill(fCent, nV6V2starV4star.Re(), ebe_3p_weight);
-    pht[HIST_THN_V7V2starV5star]->Fill(fCent, nV7V2starV5star.Re(), ebe_3p_weight);
-    pht[HIST_THN_V7V3starV4star]->Fill(fCent, nV7V3starV4star.Re(), ebe_3p_weight);
-
+    pht[HIST_THN_V8V2starV3star_2]->Fill(fCent, V8V2starV3star_2.real(), ebe_4p_weightB);
+    pht[HIST_THN_V8V2star_4]->Fill(fCent, V8V2star_4.real()); // 5p weight
+    pht[HIST_THN_V6V2star_3]->Fill(fCent, nV6V2star_3.real(), ebe_4p_weightB);
+    pht[HIST_THN_V7V2star_2V3star]->Fill(fCent, nV7V2star_2V3star.real(), ebe_4p_weightB);
+    pht[HIST_THN_V8V2starV3star_2]->Fill(fCent, nV8V2starV3star_2.real(), ebe_4p_weightB);
+
+    pht[HIST_THN_V6V2starV4star]->Fill(fCent, V6V2starV4star.real(), ebe_3p_weight);
+    pht[HIST_THN_V7V2starV5star]->Fill(fCent, V7V2starV5star.real(), ebe_3p_weight);
+    pht[HIST_THN_V7V3starV4star]->Fill(fCent, V7V3starV4star.real(), ebe_3p_weight);
+    pht[HIST_THN_V6V2starV4star]->Fill(fCent, nV6V2starV4star.real(), ebe_3p_weight);
+    pht[HIST_THN_V7V2starV5star]->Fill(fCent, nV7V2starV5star.real(), ebe_3p_weight);
+    pht[HIST_THN_V7V3starV4star]->Fill(fCent, nV7V3starV4star.real(), ebe_3p_weight);
+
+    // the normalisations do not depend on the harmonics: evaluate them once per subevent
+    const Double_t four0 = Four(0, 0, 0, 0).real();
+    const Double_t two0 = Two(0, 0).real();
+    const Double_t twoGap0 = (Qa[0][1] * Qb[0][1]).real();
     Double_t event_weight_four = 1.0;
     Double_t event_weight_two = 1.0;
     Double_t event_weight_two_gap = 1.0;
     if (flags & kFlucEbEWeighting) {
-      event_weight_four = Four(0, 0, 0, 0).Re();
-      event_weight_two = Two(0, 0).Re();
-      event_weight_two_gap = (Qa[0][1] * Qb[0][1]).Re();
+      event_weight_four = four0;
+      event_weight_two = two0;
+      event_weight_two_gap = twoGap0;
     }
 
     for (UInt_t ih = 2; ih < kNH; ih++) {
       for (UInt_t ihh = 2, mm = (ih < kcNH ? ih : static_cast<UInt_t>(kcNH)); ihh < mm; ihh++) {
-        TComplex scfour = Four(ih, ihh, -ih, -ihh) / Four(0, 0, 0, 0).Re();
+        Complex scfour = Four(ih, ihh, -ih, -ihh) / four0;
 
-        pht[HIST_THN_SC_with_QC_4corr]->Fill(fCent, ih, ihh, scfour.Re(), event_weight_four);
+        pht[HIST_THN_SC_with_QC_4corr]->Fill(fCent, ih, ihh, scfour.real(), event_weight_four);
       }
 
-      TComplex sctwo = Two(ih, -ih) / Two(0, 0).Re();
-      pht[HIST_THN_SC_with_QC_2corr]->Fill(fCent, ih, sctwo.Re(), event_weight_two);
+      Complex sctwo = Two(ih, -ih) / two0;
+      pht[HIST_THN_SC_with_QC_2corr]->Fill(fCent, ih, sctwo.real(), event_weight_two);
 
-      TComplex sctwoGap = (Qa[ih][1] * TComplex::Conjugate(Qb[ih][1])) / (Qa[0][1] * Qb[0][1]).Re();
-      pht[HIST_THN_SC_with_QC_2corr_gap]->Fill(fCent, ih, sctwoGap.Re(), event_weight_two_gap);
+      Complex sctwoGap = (Qa[ih][1] * std::conj(Qb[ih][1])) / twoGap0;
+      pht[HIST_THN_SC_with_QC_2corr_gap]->Fill(fCent, ih, sctwoGap.real(), event_weight_two_gap);
     }
   }
 }
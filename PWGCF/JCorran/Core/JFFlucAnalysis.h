@@ -15,9 +15,9 @@
 #ifndef PWGCF_JCORRAN_CORE_JFFLUCANALYSIS_H_
 #define PWGCF_JCORRAN_CORE_JFFLUCANALYSIS_H_
 
+#include <complex>
 #include <experimental/type_traits>
 #include "JQVectors.h"
-#include <TComplex.h>
 #include <TNamed.h>
 #include <TH1.h>
 #include <THn.h>
@@ -34,9 +34,10 @@ class JFFlucAnalysis : public TNamed
   ~JFFlucAnalysis();
   void UserCreateOutputObjects();
   void Init();
-  TComplex Q(int n, int p);
-  TComplex Two(int n1, int n2);
-  TComplex Four(int n1, int n2, int n3, int n4);
+  using Complex = std::complex<double>;
+  Complex Q(int n, int p) const;
+  Complex Two(int n1, int n2) const;
+  Complex Four(int n1, int n2, int n3, int n4) const;
   void UserExec(Option_t* option);
   void Terminate(Option_t*);
 
@@ -122,7 +123,7 @@ class JFFlucAnalysis : public TNamed
          kK3,
          kK4,
          nKL }; // order
-  using JQVectorsT = JQVectors<TComplex, kNH, nKL, true>;
+  using JQVectorsT = JQVectors<Complex, kNH, nKL, true>;
   inline void SetJQVectors(const JQVectorsT* _pqvecs)
   {
     pqvecs = _pqvecs;
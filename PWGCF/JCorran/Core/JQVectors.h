@@ -58,27 +58,37 @@ class JQVectors : public std::conditional_t<gap, JQVectorsGapBase<Q, nh, nk>, JQ
         }
       }
     }
+    Double_t tf[nk];
     for (auto& track : inputInst) {
-      if (track.eta() < -etamax || track.eta() > etamax)
+      const auto eta = track.eta();
+      if (eta < -etamax || eta > etamax)
         continue;
 
-      UInt_t isub = (UInt_t)(track.eta() > 0.0);
+      // the weight powers and the track columns do not depend on the harmonic: evaluate them once per track
+      const auto phi = track.phi();
+      tf[0] = 1.0;
+      for (UInt_t ik = 1; ik < nk; ++ik) {
+        tf[ik] = tf[ik - 1];
+        using JInputClassIter = typename JInputClass::iterator;
+        if constexpr (std::experimental::is_detected<hasWeightNUA, const JInputClassIter>::value)
+          tf[ik] /= track.weightNUA();
+        if constexpr (std::experimental::is_detected<hasWeightEff, const JInputClassIter>::value)
+          tf[ik] /= track.weightEff();
+      }
+      const bool inGap = TMath::Abs(eta) > etamin;
+
+      UInt_t isub = (UInt_t)(eta > 0.0);
       for (UInt_t ih = 0; ih < nh; ++ih) {
-        Double_t tf = 1.0;
+        const Double_t c = TMath::Cos(ih * phi);
+        const Double_t s = TMath::Sin(ih * phi);
         for (UInt_t ik = 0; ik < nk; ++ik) {
-          Q q(tf * TMath::Cos(ih * track.phi()), tf * TMath::Sin(ih * track.phi()));
+          Q q(tf[ik] * c, tf[ik] * s);
           QvectorQC[ih][ik] += q;
 
           if constexpr (gap) {
-            if (TMath::Abs(track.eta()) > etamin)
+            if (inGap)
               this->QvectorQCgap[isub][ih][ik] += q;
           }
-
-          using JInputClassIter = typename JInputClass::iterator;
-          if constexpr (std::experimental::is_detected<hasWeightNUA, const JInputClassIter>::value)
-            tf /= track.weightNUA();
-          if constexpr (std::experimental::is_detected<hasWeightEff, const JInputClassIter>::value)
-            tf /= track.weightEff();
         }
       }
     }
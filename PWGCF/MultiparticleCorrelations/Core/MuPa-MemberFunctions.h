@@ -8358,13 +8358,21 @@ void FillQvector(const Double_t& dPhi, const Double_t& dPt, const Double_t& dEta
   } // if(pw.fUseWeights[wETA])
 
   if (qv.fCalculateQvectors) {
+    // The weight powers do not depend on harmonic, and cos and sin do not depend on weight power, so each is evaluated only once per particle:
+    const Bool_t bUseWeights = pw.fUseWeights[wPHI] || pw.fUseWeights[wPT] || pw.fUseWeights[wETA];
+    Double_t wToPowerPs[gMaxCorrelator + 1] = {0.};
+    for (Int_t wp = 0; wp < gMaxCorrelator + 1; wp++) { // weight power
+      wToPowerPs[wp] = bUseWeights ? pow(wPhi * wPt * wEta, wp) : 1.;
+    }
     for (Int_t h = 0; h < gMaxHarmonic * gMaxCorrelator + 1; h++) {
+      const Double_t dCos = TMath::Cos(h * dPhi);
+      const Double_t dSin = TMath::Sin(h * dPhi);
       for (Int_t wp = 0; wp < gMaxCorrelator + 1; wp++) { // weight power
-        if (pw.fUseWeights[wPHI] || pw.fUseWeights[wPT] || pw.fUseWeights[wETA]) {
-          wToPowerP = pow(wPhi * wPt * wEta, wp);
-          qv.fQvector[h][wp] += TComplex(wToPowerP * TMath::Cos(h * dPhi), wToPowerP * TMath::Sin(h * dPhi)); // Q-vector with weights
+        if (bUseWeights) {
+          wToPowerP = wToPowerPs[wp];
+          qv.fQvector[h][wp] += TComplex(wToPowerP * dCos, wToPowerP * dSin); // Q-vector with weights
         } else {
-          qv.fQvector[h][wp] += TComplex(TMath::Cos(h * dPhi), TMath::Sin(h * dPhi)); // bare Q-vector without weights
+          qv.fQvector[h][wp] += TComplex(dCos, dSin); // bare Q-vector without weights
         }
       } // for(Int_t wp=0;wp<gMaxCorrelator+1;wp++)
     }   // for(Int_t h=0;h<gMaxHarmonic*gMaxCorrelator+1;h++)
@@ -8447,15 +8455,23 @@ void Fillqvector(const Double_t& dPhi, const Double_t& kineVarValue, eqvectorKin
   } // if(pw.fUseDiffWeights[AFO_diffWeight]) {
 
   // *) Finally, fill differential q-vector in that bin:
+  //    As for the integrated Q-vector, weight powers and cos and sin are evaluated only once per particle.
+  const Bool_t bUseWeights = pw.fUseWeights[AFO_weight] || pw.fUseDiffWeights[AFO_diffWeight];
+  Double_t wToPowerPs[gMaxCorrelator + 1] = {0.};
+  for (Int_t wp = 0; wp < gMaxCorrelator + 1; wp++) { // weight power
+    // TBI 20240212 supported at the moment: e.g. q-vector vs pt can be weighted only with diff. phi(pt) and integrated pt weights.
+    // It cannot be weighted in addition with eta weights, since in any case I anticipate I will do always 1-D analysis, by integrating out all other dependencies
+    wToPowerPs[wp] = bUseWeights ? pow(diffPhiWeightsForThisKineVar * kineVarWeight, wp) : 1.;
+  }
   for (Int_t h = 0; h < gMaxHarmonic * gMaxCorrelator + 1; h++) {
+    const Double_t dCos = TMath::Cos(h * dPhi);
+    const Double_t dSin = TMath::Sin(h * dPhi);
     for (Int_t wp = 0; wp < gMaxCorrelator + 1; wp++) { // weight power
-      if (pw.fUseWeights[AFO_weight] || pw.fUseDiffWeights[AFO_diffWeight]) {
-        // TBI 20240212 supported at the moment: e.g. q-vector vs pt can be weighted only with diff. phi(pt) and integrated pt weights.
-        // It cannot be weighted in addition with eta weights, since in any case I anticipate I will do always 1-D analysis, by integrating out all other dependencies
-        wToPowerP = pow(diffPhiWeightsForThisKineVar * kineVarWeight, wp);
-        qv.fqvector[kineVarChoice][bin - 1][h][wp] += TComplex(wToPowerP * TMath::Cos(h * dPhi), wToPowerP * TMath::Sin(h * dPhi)); // q-vector with weights
+      if (bUseWeights) {
+        wToPowerP = wToPowerPs[wp];
+        qv.fqvector[kineVarChoice][bin - 1][h][wp] += TComplex(wToPowerP * dCos, wToPowerP * dSin); // q-vector with weights
       } else {
-        qv.fqvector[kineVarChoice][bin - 1][h][wp] += TComplex(TMath::Cos(h * dPhi), TMath::Sin(h * dPhi)); // bare q-vector without weights
+        qv.fqvector[kineVarChoice][bin - 1][h][wp] += TComplex(dCos, dSin); // bare q-vector without weights
       }
     } // for(Int_t wp=0;wp<gMaxCorrelator+1;wp++)
   }   // for(Int_t h=0;h<gMaxHarmonic*gMaxCorrelator+1;h++)
@@ -12,6 +12,8 @@
 
 #include <TH1F.h>
 #include <cmath>
+#include <algorithm>
+#include <vector>
 #include <TDirectory.h>
 #include <THn.h>
 #include <TFile.h>
@@ -120,7 +122,17 @@ struct CorrelationTask {
   OutputObj<CorrelationContainer> same{"sameEvent"};
   OutputObj<CorrelationContainer> mixed{"mixedEvent"};
 
-  std::vector<float> efficiencyAssociatedCache;
+  // Associated particles of the current fillCorrelations call, with the quantities used in the pair loop
+  struct AssociatedParticle {
+    float eta;
+    float phi;
+    float pt;
+    int sign;
+    int64_t globalIndex;
+    float efficiency;
+    uint64_t position; // position in the associated table, for the pair cuts
+  };
+  std::vector<AssociatedParticle> associatedCache;
 
   struct Config {
     bool mPairCuts = false;
@@ -189,7 +201,7 @@ struct CorrelationTask {
     same->setTrackEtaCut(cfgCutEta);
     mixed->setTrackEtaCut(cfgCutEta);
 
-    efficiencyAssociatedCache.reserve(512);
+    associatedCache.reserve(512);
 
     // o2-ccdb-upload -p Users/jgrosseo/correlations/LHC15o -f /tmp/correction_2011_global.root -k correction
 
@@ -287,15 +299,29 @@ struct CorrelationTask {
   template <CorrelationContainer::CFStep step, typename TTarget, typename TTracks1, typename TTracks2>
   void fillCorrelations(TTarget target, TTracks1& tracks1, TTracks2& tracks2, float multiplicity, float posZ, int magField, float eventWeight)
   {
-    // Cache efficiency for particles (too many FindBin lookups)
-    if constexpr (step == CorrelationContainer::kCFStepCorrected) {
-      if (cfg.mEfficiencyAssociated) {
-        efficiencyAssociatedCache.clear();
-        efficiencyAssociatedCache.reserve(tracks2.size());
-        for (auto& track : tracks2) {
-          efficiencyAssociatedCache.push_back(getEfficiencyCorrection(cfg.mEfficiencyAssociated, track.eta(), track.pt(), multiplicity, posZ));
+    // Cache the associated particles passing the single-particle selections, with their efficiency (too many FindBin lookups)
+    // With pT ordering, they are sorted in pT such that the pair loop stops at the first associated particle above the trigger
+    associatedCache.clear();
+    associatedCache.reserve(tracks2.size());
+    uint64_t position = 0;
+    for (auto& track : tracks2) {
+      bool accepted = cfgAssociatedCharge == 0 || cfgAssociatedCharge * track.sign() >= 0;
+      if constexpr (step <= CorrelationContainer::kCFStepTracked) {
+        accepted = accepted && checkObject<step>(track);
+      }
+      if (accepted) {
+        float efficiency = 1.0f;
+        if constexpr (step == CorrelationContainer::kCFStepCorrected) {
+          if (cfg.mEfficiencyAssociated) {
+            efficiency = getEfficiencyCorrection(cfg.mEfficiencyAssociated, track.eta(), track.pt(), multiplicity, posZ);
+          }
         }
+        associatedCache.push_back({track.eta(), track.phi(), track.pt(), track.sign(), track.globalIndex(), efficiency, position});
       }
+      position++;
+    }
+    if (cfgPtOrder != 0) {
+      std::stable_sort(associatedCache.begin(), associatedCache.end(), [](const AssociatedParticle& a, const AssociatedParticle& b) { return a.pt < b.pt; });
     }
 
     for (auto& track1 : tracks1) {
@@ -334,50 +360,43 @@ struct CorrelationTask {
         target->getTriggerHist()->Fill(step, track1.pt(), multiplicity, posZ, triggerWeight);
       }
 
-      for (auto& track2 : tracks2) {
+      for (const auto& associated : associatedCache) {
+        if (cfgPtOrder != 0 && associated.pt >= track1.pt()) {
+          break;
+        }
+
         if constexpr (std::is_same<TTracks1, TTracks2>::value) {
-          if (track1.globalIndex() == track2.globalIndex()) {
-            // LOGF(info, "Track identical: %f | %f | %f || %f | %f | %f", track1.eta(), track1.phi(), track1.pt(),  track2.eta(), track2.phi(), track2.pt());
+          if (track1.globalIndex() == associated.globalIndex) {
+            // LOGF(info, "Track identical: %f | %f | %f || %f | %f | %f", track1.eta(), track1.phi(), track1.pt(),  associated.eta, associated.phi, associated.pt);
             continue;
           }
         }
         if constexpr (std::experimental::is_detected<hasProng0Id, typename TTracks1::iterator>::value) {
-          if (track2.globalIndex() == track1.cfTrackProng0Id()) // do not correlate daughter tracks of the same event
+          if (associated.globalIndex == track1.cfTrackProng0Id()) // do not correlate daughter tracks of the same event
             continue;
         }
         if constexpr (std::experimental::is_detected<hasProng1Id, typename TTracks1::iterator>::value) {
-          if (track2.globalIndex() == track1.cfTrackProng1Id()) // do not correlate daughter tracks of the same event
-            continue;
-        }
-
-        if constexpr (step <= CorrelationContainer::kCFStepTracked) {
-          if (!checkObject<step>(track2)) {
+          if (associated.globalIndex == track1.cfTrackProng1Id()) // do not correlate daughter tracks of the same event
             continue;
-          }
-        }
-
-        if (cfgPtOrder != 0 && track2.pt() >= track1.pt()) {
-          continue;
-        }
-
-        if (cfgAssociatedCharge != 0 && cfgAssociatedCharge * track2.sign() < 0) {
-          continue;
         }
 
         if constexpr (std::experimental::is_detected<hasSign, typename TTracks1::iterator>::value) {
-          if (cfgPairCharge != 0 && cfgPairCharge * track1.sign() * track2.sign() < 0) {
+          if (cfgPairCharge != 0 && cfgPairCharge * track1.sign() * associated.sign < 0) {
             continue;
           }
         }
 
         if constexpr (std::is_same<TTracks1, TTracks2>::value) {
           if constexpr (step >= CorrelationContainer::kCFStepReconstructed) {
-            if (cfg.mPairCuts && mPairCuts.conversionCuts(track1, track2)) {
-              continue;
-            }
-
-            if (cfgTwoTrackCut > 0 && mPairCuts.twoTrackCut(track1, track2, magField)) {
-              continue;
+            if (cfg.mPairCuts || cfgTwoTrackCut > 0) {
+              auto track2 = tracks2.iteratorAt(associated.position);
+              if (cfg.mPairCuts && mPairCuts.conversionCuts(track1, track2)) {
+                continue;
+              }
+
+              if (cfgTwoTrackCut > 0 && mPairCuts.twoTrackCut(track1, track2, magField)) {
+                continue;
+              }
             }
           }
         }
@@ -385,11 +404,11 @@ struct CorrelationTask {
         float associatedWeight = triggerWeight;
         if constexpr (step == CorrelationContainer::kCFStepCorrected) {
           if (cfg.mEfficiencyAssociated) {
-            associatedWeight *= efficiencyAssociatedCache[track2.filteredIndex()];
+            associatedWeight *= associated.efficiency;
           }
         }
 
-        float deltaPhi = track1.phi() - track2.phi();
+        float deltaPhi = track1.phi() - associated.phi;
         if (deltaPhi > 1.5f * PI) {
           deltaPhi -= TwoPI;
         }
@@ -400,11 +419,11 @@ struct CorrelationTask {
         // last param is the weight
         if (cfgMassAxis) {
           if constexpr (std::experimental::is_detected<hasInvMass, typename TTracks1::iterator>::value)
-            target->getPairHist()->Fill(step, track1.eta() - track2.eta(), track2.pt(), track1.pt(), multiplicity, deltaPhi, posZ, track1.invMass(), associatedWeight);
+            target->getPairHist()->Fill(step, track1.eta() - associated.eta, associated.pt, track1.pt(), multiplicity, deltaPhi, posZ, track1.invMass(), associatedWeight);
           else
             LOGF(fatal, "Can not fill mass axis without invMass column. Disable cfgMassAxis.");
         } else {
-          target->getPairHist()->Fill(step, track1.eta() - track2.eta(), track2.pt(), track1.pt(), multiplicity, deltaPhi, posZ, associatedWeight);
+          target->getPairHist()->Fill(step, track1.eta() - associated.eta, associated.pt, track1.pt(), multiplicity, deltaPhi, posZ, associatedWeight);
         }
       }
     }
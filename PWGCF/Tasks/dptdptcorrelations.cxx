@@ -116,6 +116,12 @@ struct DptDptCorrelationsTask {
 
     bool ccdbstored = false;
 
+    /* per track bin indices of the track lists of the pair processing */
+    std::vector<int> etaixs1; //!<! zero based eta bin indices of the tracks one
+    std::vector<int> phiixs1; //!<! zero based phi bin indices of the tracks one
+    std::vector<int> etaixs2; //!<! zero based eta bin indices of the tracks two
+    std::vector<int> phiixs2; //!<! zero based phi bin indices of the tracks two
+
     float isCCDBstored()
     {
       return ccdbstored;
@@ -194,6 +200,45 @@ struct DptDptCorrelationsTask {
       return fhN2_vsDEtaDPhi[0][0]->GetBin(deltaeta_ix + 1, deltaphi_ix + 1);
     }
 
+    /// \brief Fills the zero based eta and phi bin indices of the tracks of a list
+    /// \param tracks the intended track list
+    /// \param etaixs the eta bin indices, in track list order
+    /// \param phiixs the phi bin indices, in track list order
+    ///
+    /// The same WARNING as for GetEtaPhiIndex applies
+    template <typename TrackListObject>
+    void getEtaPhiBinIndices(TrackListObject const& tracks, std::vector<int>& etaixs, std::vector<int>& phiixs)
+    {
+      using namespace correlationstask;
+      using namespace o2::analysis::dptdptfilter;
+
+      etaixs.clear();
+      phiixs.clear();
+      for (auto const& t : tracks) {
+        etaixs.push_back(static_cast<int>((t.eta() - etalow) / etabinwidth));
+        /* consider a potential phi origin shift */
+        float phi = GetShiftedPhi(t.phi());
+        phiixs.push_back(static_cast<int>((phi - philow) / phibinwidth));
+      }
+    }
+
+    /// \brief Returns the TH2 global bin for the differential histograms from the
+    /// zero based eta and phi bin indices of the two tracks
+    /// \return the global TH2 bin for delta eta delta phi, the same as GetDEtaDPhiGlobalIndex
+    int GetDEtaDPhiGlobalIndex(int etaix_1, int phiix_1, int etaix_2, int phiix_2)
+    {
+      using namespace correlationstask;
+      using namespace o2::analysis::dptdptfilter;
+
+      int deltaeta_ix = etaix_1 - etaix_2 + etabins - 1;
+      int deltaphi_ix = phiix_1 - phiix_2;
+      if (deltaphi_ix < 0) {
+        deltaphi_ix += phibins;
+      }
+      /* the TH2 global bin, including the underflow and overflow bins */
+      return (deltaphi_ix + 1) * (deltaetabins + 2) + deltaeta_ix + 1;
+    }
+
     void storeTrackCorrections(std::vector<TH3*> corrs)
     {
       LOGF(info, "Stored NUA&NUE corrections for %d track ids", corrs.size());
@@ -328,11 +373,16 @@ struct DptDptCorrelationsTask {
       std::vector<std::vector<double>> n2nw(nch, std::vector<double>(nch, 0.0));         ///< not weighted number of track1 track 2 pairs for current collision
       std::vector<std::vector<double>> sum2PtPtnw(nch, std::vector<double>(nch, 0.0));   ///< accumulated sum of not weighted track 1 track 2 \f${p_T}_1 {p_T}_2\f$ for current collision
       std::vector<std::vector<double>> sum2DptDptnw(nch, std::vector<double>(nch, 0.0)); ///< accumulated sum of not weighted number of track 1 tracks times not weighted track 2 \f$p_T\f$ for current collision
+      /* the eta and phi bin indices are evaluated once per track instead of once per pair */
+      getEtaPhiBinIndices(trks1, etaixs1, phiixs1);
+      getEtaPhiBinIndices(trks2, etaixs2, phiixs2);
       int index1 = 0;
 
       for (auto& track1 : trks1) {
         double ptavg_1 = (*ptavgs1)[index1];
         double corr1 = (*corrs1)[index1];
+        int etaix_1 = etaixs1[index1];
+        int phiix_1 = phiixs1[index1];
         int index2 = 0;
         for (auto& track2 : trks2) {
           /* checking the same track id condition */
@@ -356,7 +406,9 @@ struct DptDptCorrelationsTask {
           double dptdptw = (corr1 * track1.pt() - ptavg_1) * (corr2 * track2.pt() - ptavg_2);
 
           /* get the global bin for filling the differential histograms */
-          int globalbin = GetDEtaDPhiGlobalIndex(track1, track2);
+          int globalbin = GetDEtaDPhiGlobalIndex(etaix_1, phiix_1, etaixs2[index2], phiixs2[index2]);
+          int pid1 = track1.trackacceptedid();
+          int pid2 = track2.trackacceptedid();
           float deltaeta = track1.eta() - track2.eta();
           float deltaphi = track1.phi() - track2.phi();
           while (deltaphi >= deltaphiup) {
@@ -367,24 +419,25 @@ struct DptDptCorrelationsTask {
           }
           if ((fUseConversionCuts && fPairCuts.conversionCuts(track1, track2)) || (fUseTwoTrackCut && fPairCuts.twoTrackCut(track1, track2, bfield))) {
             /* suppress the pair */
-            fhSupN1N1_vsDEtaDPhi[track1.trackacceptedid()][track2.trackacceptedid()]->AddBinContent(globalbin, corr);
-            fhSupPt1Pt1_vsDEtaDPhi[track1.trackacceptedid()][track2.trackacceptedid()]->AddBinContent(globalbin, track1.pt() * track2.pt() * corr);
-            n2sup[track1.trackacceptedid()][track2.trackacceptedid()] += corr;
+            /* the bins are accumulated directly in the histogram arrays, as AddBinContent does */
+            fhSupN1N1_vsDEtaDPhi[pid1][pid2]->GetArray()[globalbin] += static_cast<Float_t>(corr);
+            fhSupPt1Pt1_vsDEtaDPhi[pid1][pid2]->GetArray()[globalbin] += static_cast<Float_t>(track1.pt() * track2.pt() * corr);
+            n2sup[pid1][pid2] += corr;
           } else {
             /* count the pair */
-            n2[track1.trackacceptedid()][track2.trackacceptedid()] += corr;
-            sum2PtPt[track1.trackacceptedid()][track2.trackacceptedid()] += track1.pt() * track2.pt() * corr;
-            sum2DptDpt[track1.trackacceptedid()][track2.trackacceptedid()] += dptdptw;
-            n2nw[track1.trackacceptedid()][track2.trackacceptedid()] += 1;
-            sum2PtPtnw[track1.trackacceptedid()][track2.trackacceptedid()] += track1.pt() * track2.pt();
-            sum2DptDptnw[track1.trackacceptedid()][track2.trackacceptedid()] += dptdptnw;
-
-            fhN2_vsDEtaDPhi[track1.trackacceptedid()][track2.trackacceptedid()]->AddBinContent(globalbin, corr);
-            fhN2cont_vsDEtaDPhi[track1.trackacceptedid()][track2.trackacceptedid()]->Fill(deltaeta, deltaphi, corr);
-            fhSum2DptDpt_vsDEtaDPhi[track1.trackacceptedid()][track2.trackacceptedid()]->AddBinContent(globalbin, dptdptw);
-            fhSum2PtPt_vsDEtaDPhi[track1.trackacceptedid()][track2.trackacceptedid()]->AddBinContent(globalbin, track1.pt() * track2.pt() * corr);
+            n2[pid1][pid2] += corr;
+            sum2PtPt[pid1][pid2] += track1.pt() * track2.pt() * corr;
+            sum2DptDpt[pid1][pid2] += dptdptw;
+            n2nw[pid1][pid2] += 1;
+            sum2PtPtnw[pid1][pid2] += track1.pt() * track2.pt();
+            sum2DptDptnw[pid1][pid2] += dptdptnw;
+
+            fhN2_vsDEtaDPhi[pid1][pid2]->GetArray()[globalbin] += static_cast<Float_t>(corr);
+            fhN2cont_vsDEtaDPhi[pid1][pid2]->Fill(deltaeta, deltaphi, corr);
+            fhSum2DptDpt_vsDEtaDPhi[pid1][pid2]->GetArray()[globalbin] += static_cast<Float_t>(dptdptw);
+            fhSum2PtPt_vsDEtaDPhi[pid1][pid2]->GetArray()[globalbin] += static_cast<Float_t>(track1.pt() * track2.pt() * corr);
           }
-          fhN2_vsPtPt[track1.trackacceptedid()][track2.trackacceptedid()]->Fill(track1.pt(), track2.pt(), corr);
+          fhN2_vsPtPt[pid1][pid2]->Fill(track1.pt(), track2.pt(), corr);
           index2++;
         }
         index1++;
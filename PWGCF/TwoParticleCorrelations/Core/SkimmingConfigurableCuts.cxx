@@ -744,6 +744,15 @@ std::vector<bool> CutBrickSelectorMultipleRanges<TValueToFilter>::IsArmed()
 /// \return true if the value passed the cut false otherwise
 template <typename TValueToFilter>
 std::vector<bool> CutBrickSelectorMultipleRanges<TValueToFilter>::Filter(const TValueToFilter& value)
+{
+  UpdateActiveRanges(value);
+  return std::vector<bool>(mActive);
+}
+
+/// \brief Update the brick status and the active ranges with the passed value
+/// \param value The value to filter
+template <typename TValueToFilter>
+void CutBrickSelectorMultipleRanges<TValueToFilter>::UpdateActiveRanges(const TValueToFilter& value)
 {
   if ((mEdges.front() <= value) and (value < mEdges.back())) {
     this->mState = this->kACTIVE;
@@ -766,7 +775,24 @@ std::vector<bool> CutBrickSelectorMultipleRanges<TValueToFilter>::Filter(const T
       mActive[i] = false;
     }
   }
-  return std::vector<bool>(mActive);
+}
+
+/// \brief Filter the passed value to update the brick status and the passed mask accordingly
+/// \param value The value to filter
+/// \param mask The mask where to set the bits of the active ranges
+/// \param bit The bit of the first range, it is advanced by the number of ranges
+/// \return true if the value is within any of the ranges false otherwise
+template <typename TValueToFilter>
+bool CutBrickSelectorMultipleRanges<TValueToFilter>::FilterOnMask(const TValueToFilter& value, uint64_t& mask, int& bit)
+{
+  UpdateActiveRanges(value);
+  for (unsigned int i = 0; i < mActive.size(); ++i) {
+    if (mActive[i]) {
+      SETBIT(mask, bit);
+    }
+    bit++;
+  }
+  return this->mState == this->kACTIVE;
 }
 
 templateClassImp(CutBrickSelectorMultipleRanges);
@@ -987,6 +1013,25 @@ std::vector<bool> CutWithVariations<TValueToFilter>::Filter(const TValueToFilter
   return res;
 }
 
+/// Filters the passed value as Filter() does, setting the bits of the activated
+/// default and variation bricks directly in the passed mask
+/// \param value The value to filter
+/// \param mask The mask to update
+/// \param bit The bit of the first brick, it is advanced by the cut length
+/// \returns true if the value activated any of the bricks
+template <typename TValueToFilter>
+bool CutWithVariations<TValueToFilter>::FilterOnMask(const TValueToFilter& value, uint64_t& mask, int& bit)
+{
+  bool atleastone = false;
+  for (int i = 0; i < mDefaultBricks.GetEntries(); ++i) {
+    atleastone = ((CutBrick<TValueToFilter>*)mDefaultBricks.UncheckedAt(i))->FilterOnMask(value, mask, bit) || atleastone;
+  }
+  for (int i = 0; i < mVariationBricks.GetEntries(); ++i) {
+    atleastone = ((CutBrick<TValueToFilter>*)mVariationBricks.UncheckedAt(i))->FilterOnMask(value, mask, bit) || atleastone;
+  }
+  return atleastone;
+}
+
 /// Return the length needed to code the cut
 /// The length is in brick units. The actual length is implementation dependent
 /// \returns Cut length in units of bricks
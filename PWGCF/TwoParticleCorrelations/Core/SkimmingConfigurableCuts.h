@@ -57,6 +57,23 @@ class CutBrick : public TNamed
   /// fits within the brick or brick components scope
   /// \returns a vector of booleans with true on the component for which the value activated the component brick
   virtual std::vector<bool> Filter(const TValueToFilter&) = 0;
+  /// Virtual function. Filters the passed value as Filter() does but sets the bits of the
+  /// activated components directly in the passed mask, without building a vector of booleans
+  /// \param mask the mask to update
+  /// \param bit the bit of the first brick component, it is advanced by the brick length
+  /// \returns true if the value activated any of the brick components
+  virtual bool FilterOnMask(const TValueToFilter& value, uint64_t& mask, int& bit)
+  {
+    bool atleastone = false;
+    for (auto b : Filter(value)) {
+      if (b) {
+        atleastone = true;
+        SETBIT(mask, bit);
+      }
+      bit++;
+    }
+    return atleastone;
+  }
   /// Pure virtual function. Return the length needed to code the brick status
   /// The length is in brick units. The actual length is implementation dependent
   /// \returns Brick length in units of bricks
@@ -113,6 +130,7 @@ class CutBrickLimit : public CutBrick<TValueToFilter>
 
   virtual std::vector<bool> IsArmed() override;
   virtual std::vector<bool> Filter(const TValueToFilter&) override;
+  virtual bool FilterOnMask(const TValueToFilter&, uint64_t&, int&) override;
   virtual int Length() override { return 1; }
 
  private:
@@ -141,6 +159,26 @@ inline std::vector<bool> CutBrickLimit<TValueToFilter>::Filter(const TValueToFil
   return res;
 }
 
+/// \brief Filter the passed value to update the brick status and the passed mask accordingly
+/// \param value The value to filter
+/// \param mask The mask where to set the brick bit
+/// \param bit The brick bit, it is advanced by one
+/// \return true if the value passed the cut false otherwise
+template <typename TValueToFilter>
+inline bool CutBrickLimit<TValueToFilter>::FilterOnMask(const TValueToFilter& value, uint64_t& mask, int& bit)
+{
+  bool pass = false;
+  if (value < mLimit) {
+    this->mState = this->kACTIVE;
+    SETBIT(mask, bit);
+    pass = true;
+  } else {
+    this->mState = this->kPASSIVE;
+  }
+  bit++;
+  return pass;
+}
+
 /// \class CutBrickFnLimit
 /// \brief Class which implements a function based limiting cut brick.
 /// The brick will be active if the filtered value is below the limit
@@ -184,6 +222,7 @@ class CutBrickThreshold : public CutBrick<TValueToFilter>
 
   virtual std::vector<bool> IsArmed() override;
   virtual std::vector<bool> Filter(const TValueToFilter&) override;
+  virtual bool FilterOnMask(const TValueToFilter&, uint64_t&, int&) override;
   virtual int Length() override { return 1; }
 
  private:
@@ -212,6 +251,26 @@ inline std::vector<bool> CutBrickThreshold<TValueToFilter>::Filter(const TValueT
   return res;
 }
 
+/// \brief Filter the passed value to update the brick status and the passed mask accordingly
+/// \param value The value to filter
+/// \param mask The mask where to set the brick bit
+/// \param bit The brick bit, it is advanced by one
+/// \return true if the value passed the cut false otherwise
+template <typename TValueToFilter>
+inline bool CutBrickThreshold<TValueToFilter>::FilterOnMask(const TValueToFilter& value, uint64_t& mask, int& bit)
+{
+  bool pass = false;
+  if (mThreshold < value) {
+    this->mState = this->kACTIVE;
+    SETBIT(mask, bit);
+    pass = true;
+  } else {
+    this->mState = this->kPASSIVE;
+  }
+  bit++;
+  return pass;
+}
+
 /// \class CutBrickFnThreshold
 /// \brief Class which implements a function based threshold cut brick.
 /// The brick will be active if the filtered value is above the threshold
@@ -255,6 +314,7 @@ class CutBrickRange : public CutBrick<TValueToFilter>
 
   virtual std::vector<bool> IsArmed() override;
   virtual std::vector<bool> Filter(const TValueToFilter&) override;
+  virtual bool FilterOnMask(const TValueToFilter&, uint64_t&, int&) override;
   virtual int Length() override { return 1; }
 
  private:
@@ -284,6 +344,26 @@ std::vector<bool> CutBrickRange<TValueToFilter>::Filter(const TValueToFilter& va
   return res;
 }
 
+/// \brief Filter the passed value to update the brick status and the passed mask accordingly
+/// \param value The value to filter
+/// \param mask The mask where to set the brick bit
+/// \param bit The brick bit, it is advanced by one
+/// \return true if the value passed the cut false otherwise
+template <typename TValueToFilter>
+bool CutBrickRange<TValueToFilter>::FilterOnMask(const TValueToFilter& value, uint64_t& mask, int& bit)
+{
+  bool pass = false;
+  if ((mLow < value) and (value < mUp)) {
+    this->mState = this->kACTIVE;
+    SETBIT(mask, bit);
+    pass = true;
+  } else {
+    this->mState = this->kPASSIVE;
+  }
+  bit++;
+  return pass;
+}
+
 /// \class CutBrickFnRange
 /// \brief Class which implements a function based range cut brick.
 /// The brick will be active if the filtered value is within the range
@@ -329,6 +409,7 @@ class CutBrickExtToRange : public CutBrick<TValueToFilter>
 
   virtual std::vector<bool> IsArmed() override;
   virtual std::vector<bool> Filter(const TValueToFilter&) override;
+  virtual bool FilterOnMask(const TValueToFilter&, uint64_t&, int&) override;
   virtual int Length() override { return 1; }
 
  private:
@@ -358,6 +439,26 @@ std::vector<bool> CutBrickExtToRange<TValueToFilter>::Filter(const TValueToFilte
   return res;
 }
 
+/// \brief Filter the passed value to update the brick status and the passed mask accordingly
+/// \param value The value to filter
+/// \param mask The mask where to set the brick bit
+/// \param bit The brick bit, it is advanced by one
+/// \return true if the value passed the cut false otherwise
+template <typename TValueToFilter>
+bool CutBrickExtToRange<TValueToFilter>::FilterOnMask(const TValueToFilter& value, uint64_t& mask, int& bit)
+{
+  bool pass = false;
+  if ((value < mLow) or (mUp < value)) {
+    this->mState = this->kACTIVE;
+    SETBIT(mask, bit);
+    pass = true;
+  } else {
+    this->mState = this->kPASSIVE;
+  }
+  bit++;
+  return pass;
+}
+
 /// \class CutBrickExtToRange
 /// \brief Class which implements an external to function base range cut brick.
 /// The brick will be active if the filtered value is outside the range
@@ -405,6 +506,7 @@ class CutBrickSelectorMultipleRanges : public CutBrick<TValueToFilter>
 
   virtual std::vector<bool> IsArmed() override;
   virtual std::vector<bool> Filter(const TValueToFilter&) override;
+  virtual bool FilterOnMask(const TValueToFilter&, uint64_t&, int&) override;
   /// Return the length needed to code the brick status
   /// The length is in brick units. The actual length is implementation dependent
   /// \returns Brick length in units of bricks
@@ -412,6 +514,7 @@ class CutBrickSelectorMultipleRanges : public CutBrick<TValueToFilter>
 
  private:
   void ConstructCutFromString(const TString&);
+  void UpdateActiveRanges(const TValueToFilter&);
 
   std::vector<TValueToFilter> mEdges; ///< the value of the ranges edges (len = nranges + 1)
   std::vector<bool> mActive;          ///< if the associated range is active with the passed value to filter (len = nranges)
@@ -439,6 +542,7 @@ class CutWithVariations : public CutBrick<TValueToFilter>
   TList& getVariantBricks() { return mVariationBricks; }
   virtual std::vector<bool> IsArmed() override;
   virtual std::vector<bool> Filter(const TValueToFilter&) override;
+  virtual bool FilterOnMask(const TValueToFilter&, uint64_t&, int&) override;
   virtual int Length() override;
   virtual int getArmedIndex() override;
 
@@ -139,13 +139,7 @@ uint64_t TrackSelectionFilterAndAnalysis::Filter(TrackToFilter const& track)
   };
 
   auto filterBrickValue = [&](auto brick, auto value) {
-    std::vector<bool> res = brick->Filter(value);
-    for (auto b : res) {
-      if (b) {
-        SETBIT(selectedMask, bit);
-      }
-      bit++;
-    }
+    brick->FilterOnMask(value, selectedMask, bit);
   };
 
   auto filterBrickValueNoMask = [](auto brick, auto value) {
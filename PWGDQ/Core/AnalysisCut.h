@@ -40,6 +40,8 @@ class AnalysisCut : public TNamed
 
   virtual bool IsSelected(float* values);
 
+  int GetNCutContainers() const { return fCuts.size(); }
+
   static std::vector<int> fgUsedVars; //! vector of used variables
 
   struct CutContainer {
@@ -61,6 +63,7 @@ class AnalysisCut : public TNamed
     TF1* fFuncLow;  // function for the lower limit cut
     TF1* fFuncHigh; // function for the upper limit cut
   };
+  const std::vector<CutContainer>& GetCutContainers() const { return fCuts; }
 
  protected:
   std::vector<CutContainer> fCuts;
@@ -0,0 +1,194 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//
+// Contact: iarsene@cern.ch, i.c.arsene@fys.uio.no
+//
+// Flattened evaluator for a set of AnalysisCut / AnalysisCompositeCut objects
+//   At init, all the cut containers of all the configured cuts are collected in a single table of rows,
+//   with identical rows (same variable, limits, exclusion flags and dependent-variable ranges) stored only once.
+//   The AND / OR structure of the (composite) cuts is kept as a list of nodes, ordered such that each node only
+//   refers to rows or nodes defined before it. For a candidate, every row is evaluated once, then the nodes,
+//   and the decision of each added cut is returned as one bit of a uint64_t.
+//   The decisions are identical to the ones of AnalysisCut::IsSelected() and AnalysisCompositeCut::IsSelected().
+//
+
+#ifndef PWGDQ_CORE_COMPILEDCUTS_H_
+#define PWGDQ_CORE_COMPILEDCUTS_H_
+
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include "Framework/Logger.h"
+#include "PWGDQ/Core/AnalysisCut.h"
+#include "PWGDQ/Core/AnalysisCompositeCut.h"
+
+class CompiledCuts
+{
+ public:
+  static constexpr int kMaxCuts = 64;
+
+  CompiledCuts() = default;
+
+  /// Adds a cut, composite or not, and returns the bit used for its decision
+  int AddCut(const AnalysisCut* cut)
+  {
+    if (fTopNodes.size() >= kMaxCuts) {
+      LOG(fatal) << "CompiledCuts: at most " << kMaxCuts << " cuts can be compiled together";
+    }
+    int node = -1;
+    if (cut->IsA() == AnalysisCompositeCut::Class()) {
+      node = AddCompositeNode(*static_cast<const AnalysisCompositeCut*>(cut));
+    } else {
+      node = AddLeafNode(*cut);
+    }
+    fTopNodes.push_back(node);
+    fRowPass.resize(fRows.size());
+    fNodePass.resize(fNodes.size());
+    return fTopNodes.size() - 1;
+  }
+  template <typename TCuts>
+  void AddCuts(TCuts const& cuts)
+  {
+    for (const auto& cut : cuts) {
+      AddCut(&cut);
+    }
+  }
+  void Clear()
+  {
+    fRows.clear();
+    fRowIndices.clear();
+    fNodes.clear();
+    fChildren.clear();
+    fLeafIndices.clear();
+    fTopNodes.clear();
+    fRowPass.clear();
+    fNodePass.clear();
+  }
+
+  int GetNCuts() const { return fTopNodes.size(); }
+  int GetNRows() const { return fRows.size(); }
+
+  /// Evaluates all the cuts for one candidate, bit i is set if the cut i is passed
+  uint64_t Evaluate(const float* values)
+  {
+    for (size_t iRow = 0; iRow < fRows.size(); iRow++) {
+      fRowPass[iRow] = EvaluateRow(fRows[iRow], values);
+    }
+    for (size_t iNode = 0; iNode < fNodes.size(); iNode++) {
+      const Node& node = fNodes[iNode];
+      const std::vector<char>& childPass = node.isLeaf ? fRowPass : fNodePass;
+      bool pass = node.useAND;
+      for (int iChild = node.first; iChild < node.last; iChild++) {
+        if (childPass[fChildren[iChild]] != node.useAND) {
+          pass = !node.useAND;
+          break;
+        }
+      }
+      fNodePass[iNode] = pass;
+    }
+    uint64_t decisions = 0;
+    for (size_t iCut = 0; iCut < fTopNodes.size(); iCut++) {
+      decisions |= static_cast<uint64_t>(fNodePass[fTopNodes[iCut]]) << iCut;
+    }
+    return decisions;
+  }
+
+ private:
+  struct Node {
+    bool isLeaf; // children are rows (AnalysisCut, always AND) or nodes (AnalysisCompositeCut)
+    bool useAND; // AND or OR of the children
+    int first;   // first child in fChildren
+    int last;    // one past the last child in fChildren
+  };
+  using RowKey = std::tuple<short, float, float, bool, short, float, float, bool, short, float, float, bool, TF1*, TF1*>;
+
+  static bool EvaluateRow(const AnalysisCut::CutContainer& row, const float* values)
+  {
+    // same logic as AnalysisCut::IsSelected(): a row is passed if its dependent variables are not in the range in which it applies
+    if (row.fDepVar != -1) {
+      bool inRange = (values[row.fDepVar] > row.fDepLow && values[row.fDepVar] <= row.fDepHigh);
+      if (inRange == row.fDepExclude) {
+        return true;
+      }
+    }
+    if (row.fDepVar2 != -1) {
+      bool inRange = (values[row.fDepVar2] > row.fDep2Low && values[row.fDepVar2] <= row.fDep2High);
+      if (inRange == row.fDep2Exclude) {
+        return true;
+      }
+    }
+    float cutLow = row.fFuncLow ? row.fFuncLow->Eval(values[row.fDepVar]) : row.fLow;
+    float cutHigh = row.fFuncHigh ? row.fFuncHigh->Eval(values[row.fDepVar]) : row.fHigh;
+    bool inRange = (values[row.fVar] >= cutLow && values[row.fVar] <= cutHigh);
+    return inRange != row.fExclude;
+  }
+
+  int AddRow(const AnalysisCut::CutContainer& row)
+  {
+    RowKey key{row.fVar, row.fLow, row.fHigh, row.fExclude, row.fDepVar, row.fDepLow, row.fDepHigh, row.fDepExclude,
+               row.fDepVar2, row.fDep2Low, row.fDep2High, row.fDep2Exclude, row.fFuncLow, row.fFuncHigh};
+    auto it = fRowIndices.find(key);
+    if (it != fRowIndices.end()) {
+      return it->second;
+    }
+    fRows.push_back(row);
+    fRowIndices[key] = fRows.size() - 1;
+    return fRows.size() - 1;
+  }
+
+  int AddLeafNode(const AnalysisCut& cut)
+  {
+    std::vector<int> rows;
+    for (const auto& row : cut.GetCutContainers()) {
+      rows.push_back(AddRow(row));
+    }
+    auto it = fLeafIndices.find(rows);
+    if (it != fLeafIndices.end()) {
+      return it->second;
+    }
+    int node = AddNode(true, true, rows);
+    fLeafIndices[rows] = node;
+    return node;
+  }
+
+  int AddCompositeNode(const AnalysisCompositeCut& cut)
+  {
+    std::vector<int> children;
+    for (const auto& subCut : cut.GetCutList()) {
+      children.push_back(AddLeafNode(subCut));
+    }
+    for (const auto& subCut : cut.GetCompositeCutList()) {
+      children.push_back(AddCompositeNode(subCut));
+    }
+    return AddNode(false, cut.GetUseAND(), children);
+  }
+
+  int AddNode(bool isLeaf, bool useAND, const std::vector<int>& children)
+  {
+    Node node{isLeaf, useAND, static_cast<int>(fChildren.size()), static_cast<int>(fChildren.size() + children.size())};
+    fChildren.insert(fChildren.end(), children.begin(), children.end());
+    fNodes.push_back(node);
+    return fNodes.size() - 1;
+  }
+
+  std::vector<AnalysisCut::CutContainer> fRows; // unique cut conditions of all the cuts
+  std::map<RowKey, int> fRowIndices;            // index of each unique condition
+  std::vector<Node> fNodes;                     // AND / OR nodes, children always before their parents
+  std::vector<int> fChildren;                   // children (rows or nodes) of all the nodes
+  std::map<std::vector<int>, int> fLeafIndices; // node of each unique set of rows
+  std::vector<int> fTopNodes;                   // node of each added cut, i.e. of each bit of the decision
+  std::vector<char> fRowPass;                   // decision of each row for the current candidate
+  std::vector<char> fNodePass;                  // decision of each node for the current candidate
+};
+
+#endif // PWGDQ_CORE_COMPILEDCUTS_H_
@@ -14,10 +14,20 @@
 #include "PWGDQ/Core/CutsLibrary.h"
 #include <RtypesCore.h>
 #include <TF1.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include "AnalysisCompositeCut.h"
 #include "VarManager.h"
 
-AnalysisCompositeCut* o2::aod::dqcuts::GetCompositeCut(const char* cutName)
+namespace
+{
+using o2::aod::dqcuts::GetAnalysisCut;
+using o2::aod::dqcuts::GetCompositeCut;
+
+// The cuts are built by name with the chains of string comparisons below, the exported
+// GetCompositeCut() and GetAnalysisCut() run them only once per name and hand out copies afterwards
+AnalysisCompositeCut* BuildCompositeCut(const char* cutName)
 {
   //
   // define composie cuts, typically combinations of all the ingredients needed for a full cut
@@ -3068,11 +3078,10 @@ AnalysisCompositeCut* o2::aod::dqcuts::GetCompositeCut(const char* cutName)
   }
 
   delete cut;
-  LOGF(info, Form("Did not find cut %s", cutName));
   return nullptr;
 }
 
-AnalysisCut* o2::aod::dqcuts::GetAnalysisCut(const char* cutName)
+AnalysisCut* BuildAnalysisCut(const char* cutName)
 {
   //
   // define here cuts which are likely to be used often
@@ -5375,6 +5384,52 @@ AnalysisCut* o2::aod::dqcuts::GetAnalysisCut(const char* cutName)
   }
 
   delete cut;
-  LOGF(info, Form("Did not find cut %s", cutName));
   return nullptr;
 }
+} // namespace
+
+namespace
+{
+// Cuts already built, by name, nullptr for the names not found in the library
+std::unordered_map<std::string, std::unique_ptr<AnalysisCompositeCut>> gCompositeCutCache;
+std::unordered_map<std::string, std::unique_ptr<AnalysisCut>> gAnalysisCutCache;
+} // namespace
+
+AnalysisCompositeCut* o2::aod::dqcuts::GetCompositeCut(const char* cutName)
+{
+  //
+  // get a new copy of a composite cut, building it at the first request
+  //
+  auto it = gCompositeCutCache.find(cutName);
+  if (it == gCompositeCutCache.end()) {
+    // the builder may call this function recursively, so the cache is filled only after the cut is built
+    std::unique_ptr<AnalysisCompositeCut> cut(BuildCompositeCut(cutName));
+    it = gCompositeCutCache.emplace(cutName, std::move(cut)).first;
+  }
+  if (!it->second) {
+    LOGF(info, Form("Did not find cut %s", cutName));
+    return nullptr;
+  }
+  return new AnalysisCompositeCut(*it->second);
+}
+
+AnalysisCut* o2::aod::dqcuts::GetAnalysisCut(const char* cutName)
+{
+  //
+  // get a new copy of a cut, building it at the first request
+  //
+  auto it = gAnalysisCutCache.find(cutName);
+  if (it == gAnalysisCutCache.end()) {
+    std::unique_ptr<AnalysisCut> cut(BuildAnalysisCut(cutName));
+    it = gAnalysisCutCache.emplace(cutName, std::move(cut)).first;
+  }
+  if (!it->second) {
+    LOGF(info, Form("Did not find cut %s", cutName));
+    return nullptr;
+  }
+  // a few event cuts are built as composite cuts, keep their type in the copy
+  if (it->second->IsA() == AnalysisCompositeCut::Class()) {
+    return new AnalysisCompositeCut(*static_cast<AnalysisCompositeCut*>(it->second.get()));
+  }
+  return new AnalysisCut(*it->second);
+}
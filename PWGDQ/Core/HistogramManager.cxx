@@ -322,6 +322,7 @@ void HistogramManager::AddHistogram(const char* histClass, const char* hname, co
       hList->Add(h);
       break;
   } // end switch
+  UpdateCompiledClass(histClass);
 }
 
 //_________________________________________________________________
@@ -527,6 +528,7 @@ void HistogramManager::AddHistogram(const char* histClass, const char* hname, co
       hList->Add(h);
       break;
   } // end switch(dimension)
+  UpdateCompiledClass(histClass);
 }
 
 //_________________________________________________________________
@@ -620,6 +622,7 @@ void HistogramManager::AddHistogram(const char* histClass, const char* hname, co
   }
 
   fBinsAllocated += nbins;
+  UpdateCompiledClass(histClass);
 }
 
 //_________________________________________________________________
@@ -726,6 +729,7 @@ void HistogramManager::AddHistogram(const char* histClass, const char* hname, co
     }
   }
   fBinsAllocated += bins;
+  UpdateCompiledClass(histClass);
 }
 
 //__________________________________________________________________
@@ -745,7 +749,7 @@ void HistogramManager::FillHistClass(const char* className, Float_t* values)
   }
 
   // get the corresponding std::list containng identifiers to the needed variables to be filled
-  list varList = fVariablesMap[className];
+  const auto& varList = fVariablesMap[className];
 
   TIter next(hList);
 
@@ -855,6 +859,155 @@ void HistogramManager::FillHistClass(const char* className, Float_t* values)
   }   // end loop over histograms
 }
 
+//_______________________________________________________________________________
+int HistogramManager::GetHistClassHandle(const char* className)
+{
+  //
+  // get the handle of a histogram class, compiling it on the first request
+  //
+  auto it = fClassHandles.find(className);
+  if (it != fClassHandles.end()) {
+    return it->second;
+  }
+  if (!fMainList->FindObject(className)) {
+    LOG(warn) << "HistogramManager::GetHistClassHandle(): Histogram list " << className << " not found!";
+    return -1;
+  }
+  int handle = fCompiledClasses.size();
+  fClassHandles[className] = handle;
+  fClassNames.push_back(className);
+  fCompiledClasses.emplace_back();
+  CompileHistClass(handle);
+  return handle;
+}
+
+//_______________________________________________________________________________
+void HistogramManager::UpdateCompiledClass(const char* histClass)
+{
+  //
+  // recompile a histogram class if a handle was already given for it
+  //
+  auto it = fClassHandles.find(histClass);
+  if (it != fClassHandles.end()) {
+    CompileHistClass(it->second);
+  }
+}
+
+//_______________________________________________________________________________
+void HistogramManager::CompileHistClass(int handle)
+{
+  //
+  // decode the histogram list and the variable identifiers of a class into a flat array of fill entries
+  //
+  const std::string& className = fClassNames[handle];
+  auto* hList = reinterpret_cast<TList*>(fMainList->FindObject(className.c_str()));
+  auto& entries = fCompiledClasses[handle];
+  entries.clear();
+  if (!hList) {
+    return;
+  }
+  const auto& varList = fVariablesMap[className];
+  entries.reserve(varList.size());
+  TIter next(hList);
+  for (const auto& varVector : varList) {
+    FillEntry entry;
+    entry.hist = next();
+    const bool isProfile = (varVector.at(0) == 1);
+    entry.varW = varVector.at(2);
+    if (varVector.at(1) > 0) {
+      entry.type = FillEntry::kTHn;
+      entry.nDimensions = varVector.at(1);
+      entry.vars.assign(varVector.begin() + 3, varVector.begin() + 3 + entry.nDimensions);
+    } else {
+      switch ((reinterpret_cast<TH1*>(entry.hist))->GetDimension()) {
+        case 1:
+          entry.type = isProfile ? FillEntry::kProfile : FillEntry::kTH1;
+          break;
+        case 2:
+          entry.type = isProfile ? FillEntry::kProfile2D : FillEntry::kTH2;
+          break;
+        default:
+          entry.type = isProfile ? FillEntry::kProfile3D : FillEntry::kTH3;
+          break;
+      }
+      entry.vars.assign(varVector.begin() + 3, varVector.begin() + 7); // varX, varY, varZ, varT
+    }
+    entries.push_back(entry);
+  }
+}
+
+//_______________________________________________________________________________
+void HistogramManager::FillHistClass(int handle, const float* values)
+{
+  //
+  //  fill a class of histograms from its handle, same as FillHistClass(const char*, float*)
+  //
+  if (handle < 0 || handle >= static_cast<int>(fCompiledClasses.size())) {
+    return;
+  }
+  double fillValues[20] = {0.0};
+  for (const auto& entry : fCompiledClasses[handle]) {
+    const int* vars = entry.vars.data();
+    const bool hasWeight = entry.varW > kNothing;
+    switch (entry.type) {
+      case FillEntry::kTH1:
+        if (hasWeight) {
+          (reinterpret_cast<TH1*>(entry.hist))->Fill(values[vars[0]], values[entry.varW]);
+        } else {
+          (reinterpret_cast<TH1*>(entry.hist))->Fill(values[vars[0]]);
+        }
+        break;
+      case FillEntry::kProfile:
+        if (hasWeight) {
+          (reinterpret_cast<TProfile*>(entry.hist))->Fill(values[vars[0]], values[vars[1]], values[entry.varW]);
+        } else {
+          (reinterpret_cast<TProfile*>(entry.hist))->Fill(values[vars[0]], values[vars[1]]);
+        }
+        break;
+      case FillEntry::kTH2:
+        if (hasWeight) {
+          (reinterpret_cast<TH2*>(entry.hist))->Fill(values[vars[0]], values[vars[1]], values[entry.varW]);
+        } else {
+          (reinterpret_cast<TH2*>(entry.hist))->Fill(values[vars[0]], values[vars[1]]);
+        }
+        break;
+      case FillEntry::kProfile2D:
+        if (hasWeight) {
+          (reinterpret_cast<TProfile2D*>(entry.hist))->Fill(values[vars[0]], values[vars[1]], values[vars[2]], values[entry.varW]);
+        } else {
+          (reinterpret_cast<TProfile2D*>(entry.hist))->Fill(values[vars[0]], values[vars[1]], values[vars[2]]);
+        }
+        break;
+      case FillEntry::kTH3:
+        if (hasWeight) {
+          (reinterpret_cast<TH3*>(entry.hist))->Fill(values[vars[0]], values[vars[1]], values[vars[2]], values[entry.varW]);
+        } else {
+          (reinterpret_cast<TH3*>(entry.hist))->Fill(values[vars[0]], values[vars[1]], values[vars[2]]);
+        }
+        break;
+      case FillEntry::kProfile3D:
+        if (hasWeight) {
+          (reinterpret_cast<TProfile3D*>(entry.hist))->Fill(values[vars[0]], values[vars[1]], values[vars[2]], values[vars[3]], values[entry.varW]);
+        } else {
+          (reinterpret_cast<TProfile3D*>(entry.hist))->Fill(values[vars[0]], values[vars[1]], values[vars[2]], values[vars[3]]);
+        }
+        break;
+      case FillEntry::kTHn:
+        for (int i = 0; i < entry.nDimensions; i++) {
+          fillValues[i] = values[vars[i]];
+        }
+        if (hasWeight) {
+          (reinterpret_cast<THnBase*>(entry.hist))->Fill(fillValues, values[entry.varW]);
+        } else {
+          (reinterpret_cast<THnBase*>(entry.hist))->Fill(fillValues);
+        }
+        break;
+      default:
+        break;
+    }
+  }
+}
+
 //____________________________________________________________________________________
 void HistogramManager::MakeAxisLabels(TAxis* ax, const char* labels)
 {
@@ -85,6 +85,12 @@ class HistogramManager : public TNamed
                     TString* axLabels = nullptr, int varW = -1, bool useSparse = kFALSE, bool isdouble = false);
 
   void FillHistClass(const char* className, float* values);
+  // Get an integer handle for a histogram class, to be used with the FillHistClass(int, const float*) fast path.
+  // The histogram class is compiled into a contiguous array of histogram pointers and variable indices, which is
+  // updated if histograms are added to the class later on. Returns -1 if the class does not exist
+  int GetHistClassHandle(const char* className);
+  // Fill a class of histograms from its handle, without any string operation
+  void FillHistClass(int handle, const float* values);
 
   void SetUseDefaultVariableNames(bool flag) { fUseDefaultVariableNames = flag; }
   void SetDefaultVarNames(TString* vars, TString* units);
@@ -108,7 +114,28 @@ class HistogramManager : public TNamed
   TString* fVariableNames;          //! variable names
   TString* fVariableUnits;          //! variable units
 
+  // Histogram of a compiled class with the indices of the variables used to fill it
+  struct FillEntry {
+    enum Type { kTH1,
+                kTH2,
+                kTH3,
+                kProfile,
+                kProfile2D,
+                kProfile3D,
+                kTHn };
+    TObject* hist = nullptr;
+    int type = kTH1;
+    int nDimensions = 0; // number of variables for THn histograms
+    int varW = -1;       // weight variable, -1 if none
+    std::vector<int> vars;
+  };
+  std::map<std::string, int> fClassHandles;            //! map from histogram class name to handle
+  std::vector<std::string> fClassNames;                //! histogram class name of each handle
+  std::vector<std::vector<FillEntry>> fCompiledClasses; //! compiled histogram classes, indexed by handle
+
   void MakeAxisLabels(TAxis* ax, const char* labels);
+  void CompileHistClass(int handle);
+  void UpdateCompiledClass(const char* histClass);
 
   HistogramManager& operator=(const HistogramManager& c);
   HistogramManager(const HistogramManager& c);
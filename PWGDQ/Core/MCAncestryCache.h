@@ -0,0 +1,138 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//
+// Contact: iarsene@cern.ch, i.c.arsene@fys.uio.no
+//
+// Flattened copy of the history information of a contiguous range of MC particles
+//   (PDG code, source flags, first mother and daughter range of each particle), used by
+//   MCSignal::CheckSignal() to follow the mother and daughter chains without going through the table iterators.
+// The cache is built once (e.g. per MC event or per dataframe) and all the signals are checked against it.
+// Mothers and daughters outside the cached range cannot be followed, in which case IsComplete() returns false
+//   and the signals have to be checked on the MC particles themselves.
+//
+#ifndef PWGDQ_CORE_MCANCESTRYCACHE_H_
+#define PWGDQ_CORE_MCANCESTRYCACHE_H_
+
+#include <cstdint>
+#include <vector>
+
+class MCAncestryCache
+{
+ public:
+  enum Flags {
+    kIsPhysicalPrimary = 0x1,
+    kProducedByGenerator = 0x2,
+    kFromBackgroundEvent = 0x4
+  };
+
+  MCAncestryCache() = default;
+  ~MCAncestryCache() = default;
+
+  // Build the cache from a table (or slice) of MC particles with contiguous global indices
+  template <typename TMCParticles>
+  void Build(const TMCParticles& mcParticles);
+
+  void Clear()
+  {
+    fFirstIndex = 0;
+    fComplete = true;
+    fPdgCodes.clear();
+    fFlags.clear();
+    fMothers.clear();
+    fFirstDaughters.clear();
+    fLastDaughters.clear();
+  }
+
+  int GetNParticles() const { return fPdgCodes.size(); }
+  bool IsComplete() const { return fComplete; }
+  // position in the cache of the particle with a given global index, -1 if not cached
+  int GetPosition(int64_t globalIndex) const
+  {
+    int64_t pos = globalIndex - fFirstIndex;
+    return (pos >= 0 && pos < static_cast<int64_t>(fPdgCodes.size())) ? static_cast<int>(pos) : -1;
+  }
+  int64_t GetGlobalIndex(int pos) const { return fFirstIndex + pos; }
+  int GetPdgCode(int pos) const { return fPdgCodes[pos]; }
+  bool IsPhysicalPrimary(int pos) const { return fFlags[pos] & kIsPhysicalPrimary; }
+  bool ProducedByGenerator(int pos) const { return fFlags[pos] & kProducedByGenerator; }
+  bool FromBackgroundEvent(int pos) const { return fFlags[pos] & kFromBackgroundEvent; }
+  // position of the first mother, -1 if none
+  int GetMother(int pos) const { return fMothers[pos]; }
+  bool HasMothers(int pos) const { return fMothers[pos] >= 0; }
+  // positions of the first and last daughters, -1 if none
+  int GetFirstDaughter(int pos) const { return fFirstDaughters[pos]; }
+  int GetLastDaughter(int pos) const { return fLastDaughters[pos]; }
+  bool HasDaughters(int pos) const { return fFirstDaughters[pos] >= 0; }
+
+ private:
+  int64_t fFirstIndex = 0;            // global index of the first cached particle
+  bool fComplete = true;              // false if some mother or daughter is outside the cached range
+  std::vector<int> fPdgCodes;         // PDG code
+  std::vector<uint8_t> fFlags;        // source flags, see Flags
+  std::vector<int> fMothers;          // position of the first mother
+  std::vector<int> fFirstDaughters;   // position of the first daughter
+  std::vector<int> fLastDaughters;    // position of the last daughter
+
+  int CachePosition(int64_t globalIndex)
+  {
+    int pos = GetPosition(globalIndex);
+    if (pos < 0) {
+      fComplete = false;
+    }
+    return pos;
+  }
+};
+
+template <typename TMCParticles>
+void MCAncestryCache::Build(const TMCParticles& mcParticles)
+{
+  Clear();
+  const int n = mcParticles.size();
+  if (n == 0) {
+    return;
+  }
+  fFirstIndex = mcParticles.begin().globalIndex();
+  fPdgCodes.reserve(n);
+  fFlags.reserve(n);
+  fMothers.reserve(n);
+  fFirstDaughters.reserve(n);
+  fLastDaughters.reserve(n);
+  for (const auto& particle : mcParticles) {
+    if (particle.globalIndex() != fFirstIndex + static_cast<int64_t>(fPdgCodes.size())) {
+      fComplete = false; // not a contiguous range, positions would not match the global indices
+    }
+    fPdgCodes.push_back(particle.pdgCode());
+    fFlags.push_back((particle.isPhysicalPrimary() ? kIsPhysicalPrimary : 0) |
+                     (particle.producedByGenerator() ? kProducedByGenerator : 0) |
+                     (particle.fromBackgroundEvent() ? kFromBackgroundEvent : 0));
+    fMothers.push_back(-1);
+    fFirstDaughters.push_back(-1);
+    fLastDaughters.push_back(-1);
+  }
+  // the indices are resolved once all the particles are known
+  int pos = 0;
+  for (const auto& particle : mcParticles) {
+    if (particle.has_mothers()) {
+      fMothers[pos] = CachePosition(particle.mothersIds()[0]);
+    }
+    if (particle.has_daughters()) {
+      fFirstDaughters[pos] = CachePosition(particle.daughtersIds()[0]);
+      fLastDaughters[pos] = CachePosition(particle.daughtersIds()[1]);
+      if (fFirstDaughters[pos] < 0 || fLastDaughters[pos] < 0) {
+        fFirstDaughters[pos] = -1;
+        fLastDaughters[pos] = -1;
+      }
+    }
+    pos++;
+  }
+}
+
+#endif // PWGDQ_CORE_MCANCESTRYCACHE_H_
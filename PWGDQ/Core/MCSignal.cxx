@@ -75,3 +75,125 @@ void MCSignal::PrintConfig()
     pr.Print();
   }
 }
+
+//________________________________________________________________________________________________
+bool MCSignal::CheckProngInCache(int i, const MCAncestryCache& cache, bool checkSources, int position)
+{
+  //
+  // Same logic as the templated CheckProng(), following the mother and daughter positions stored in the cache
+  //
+  const MCProng& prong = fProngs[i];
+  int current = position;
+
+  // moves one generation further in history (or younger if the prong is checked in time), returns false if not possible
+  auto nextGeneration = [&](int j) {
+    if (j >= prong.fNGenerations - 1) {
+      return true;
+    }
+    if (!prong.fCheckGenerationsInTime) {
+      if (!cache.HasMothers(current)) {
+        return false;
+      }
+      current = cache.GetMother(current);
+    } else {
+      if (!cache.HasDaughters(current)) {
+        return false;
+      }
+      for (int d = cache.GetFirstDaughter(current); d <= cache.GetLastDaughter(current); d++) {
+        if (prong.TestPDG(j + 1, cache.GetPdgCode(d))) {
+          current = d;
+          break;
+        }
+      }
+    }
+    return true;
+  };
+
+  // loop over the generations specified for this prong
+  for (int j = 0; j < prong.fNGenerations; j++) {
+    if (!prong.TestPDG(j, cache.GetPdgCode(current))) {
+      return false;
+    }
+    // check the common ancestor (if specified)
+    if (fNProngs > 1 && fCommonAncestorIdxs[i] == j) {
+      if (i == 0) {
+        fTempAncestorLabel = cache.GetGlobalIndex(current);
+      } else if (cache.GetGlobalIndex(current) != fTempAncestorLabel) {
+        return false;
+      }
+    }
+    if (!nextGeneration(j)) {
+      return false;
+    }
+  }
+
+  // check the various specified sources
+  if (checkSources) {
+    current = position;
+    for (int j = 0; j < prong.fNGenerations; j++) {
+      if (!prong.fSourceBits[j]) {
+        continue;
+      }
+      uint64_t sourcesDecision = 0;
+      if (prong.fSourceBits[j] & (uint64_t(1) << MCProng::kPhysicalPrimary)) {
+        if ((prong.fExcludeSource[j] & (uint64_t(1) << MCProng::kPhysicalPrimary)) != cache.IsPhysicalPrimary(current)) {
+          sourcesDecision |= (uint64_t(1) << MCProng::kPhysicalPrimary);
+        }
+      }
+      if (prong.fSourceBits[j] & (uint64_t(1) << MCProng::kProducedInTransport)) {
+        if ((prong.fExcludeSource[j] & (uint64_t(1) << MCProng::kProducedInTransport)) != (!cache.ProducedByGenerator(current))) {
+          sourcesDecision |= (uint64_t(1) << MCProng::kProducedInTransport);
+        }
+      }
+      if (prong.fSourceBits[j] & (uint64_t(1) << MCProng::kProducedByGenerator)) {
+        if ((prong.fExcludeSource[j] & (uint64_t(1) << MCProng::kProducedByGenerator)) != cache.ProducedByGenerator(current)) {
+          sourcesDecision |= (uint64_t(1) << MCProng::kProducedByGenerator);
+        }
+      }
+      if (prong.fSourceBits[j] & (uint64_t(1) << MCProng::kFromBackgroundEvent)) {
+        if ((prong.fExcludeSource[j] & (uint64_t(1) << MCProng::kFromBackgroundEvent)) != cache.FromBackgroundEvent(current)) {
+          sourcesDecision |= (uint64_t(1) << MCProng::kFromBackgroundEvent);
+        }
+      }
+      if (!sourcesDecision) {
+        return false;
+      }
+      if (prong.fUseANDonSourceBitMap[j] && (sourcesDecision != prong.fSourceBits[j])) {
+        return false;
+      }
+      if (!nextGeneration(j)) {
+        return false;
+      }
+    }
+  }
+
+  if (prong.fPDGInHistory.size() == 0) {
+    return true;
+  }
+  // check if the provided PDG codes are included or excluded in the mother history
+  unsigned int nIncludedPDG = 0;
+  unsigned int nFoundPDG = 0;
+  for (unsigned int k = 0; k < prong.fPDGInHistory.size(); k++) {
+    current = position;
+    if (!prong.fExcludePDGInHistory[k]) {
+      nIncludedPDG++;
+    }
+    int ith = 0;
+    while (cache.HasMothers(current)) {
+      int mother = cache.GetMother(current);
+      if (!prong.fExcludePDGInHistory[k] && prong.ComparePDG(cache.GetPdgCode(mother), prong.fPDGInHistory[k], true, prong.fExcludePDGInHistory[k])) {
+        nFoundPDG++;
+        break;
+      }
+      if (prong.fExcludePDGInHistory[k] && !prong.ComparePDG(cache.GetPdgCode(mother), prong.fPDGInHistory[k], true, prong.fExcludePDGInHistory[k])) {
+        return false;
+      }
+      ith++;
+      current = mother;
+      if (ith > 10) {
+        break;
+      }
+    }
+  }
+  return nFoundPDG == nIncludedPDG;
+}
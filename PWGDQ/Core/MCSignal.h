@@ -57,6 +57,7 @@ process(aod::McParticles const& mcTracks) {
 #define PWGDQ_CORE_MCSIGNAL_H_
 
 #include "MCProng.h"
+#include "MCAncestryCache.h"
 #include "TNamed.h"
 
 #include <vector>
@@ -94,6 +95,16 @@ class MCSignal : public TNamed
     return CheckMC(0, checkSources, args...);
   };
 
+  // Same as above, for particles given by their positions in an MCAncestryCache
+  template <typename... T>
+  bool CheckSignal(const MCAncestryCache& cache, bool checkSources, T... positions)
+  {
+    if (sizeof...(positions) != fNProngs) {
+      return false;
+    }
+    return CheckMCInCache(0, cache, checkSources, positions...);
+  };
+
   void PrintConfig();
 
  private:
@@ -120,6 +131,22 @@ class MCSignal : public TNamed
       return CheckMC(i + 1, checkSources, args...);
     }
   };
+
+  bool CheckProngInCache(int i, const MCAncestryCache& cache, bool checkSources, int position);
+
+  bool CheckMCInCache(int, const MCAncestryCache&, bool)
+  {
+    return true;
+  };
+
+  template <typename... Ts>
+  bool CheckMCInCache(int i, const MCAncestryCache& cache, bool checkSources, int position, Ts... positions)
+  {
+    if (!CheckProngInCache(i, cache, checkSources, position)) {
+      return false;
+    }
+    return CheckMCInCache(i + 1, cache, checkSources, positions...);
+  };
 };
 
 template <typename T>
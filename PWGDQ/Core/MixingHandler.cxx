@@ -12,6 +12,7 @@
 #include "PWGDQ/Core/MixingHandler.h"
 #include "PWGDQ/Core/VarManager.h"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 using namespace std;
@@ -63,17 +64,13 @@ void MixingHandler::AddMixingVariable(int var, int nBins, float* binLims)
   varBins.Set(nBins, binLims);
   fVariableLimits.push_back(varBins);
   VarManager::SetUseVariable(var);
+  fIsInitialized = kFALSE;
 }
 
 //_________________________________________________________________________
 void MixingHandler::AddMixingVariable(int var, int nBins, std::vector<float> binLims)
 {
-
-  float* bins = new float[nBins];
-  for (int i = 0; i < nBins; ++i) {
-    bins[i] = binLims[i];
-  }
-  AddMixingVariable(var, nBins, bins);
+  AddMixingVariable(var, nBins, binLims.data());
 }
 
 //_________________________________________________________________________
@@ -111,14 +108,61 @@ void MixingHandler::Init()
   // Initialization of pools
   //       The correct event category will be retrieved using the function FindEventCategory()
   //
-  int size = 1;
-  for (auto v : fVariableLimits) {
-    size *= (v.GetSize() - 1);
+  //       The category is sum_i(bin_i * stride_i), with the stride of a variable being the product of the numbers of bins of the following variables
+  //
+  const int nVars = fVariables.size();
+  fStrides.assign(nVars, 1);
+  for (int i = nVars - 2; i >= 0; --i) {
+    fStrides[i] = fStrides[i + 1] * (fVariableLimits[i + 1].GetSize() - 1);
+  }
+  // variables with bins of equal width (within float precision) are binned arithmetically
+  fIsUniform.assign(nVars, false);
+  fInvBinWidths.assign(nVars, 0.0);
+  for (int i = 0; i < nVars; ++i) {
+    const TArrayF& limits = fVariableLimits[i];
+    const int nBins = limits.GetSize() - 1;
+    if (nBins < 1) {
+      continue;
+    }
+    const float width = (limits[nBins] - limits[0]) / nBins;
+    bool isUniform = (width > 0.0);
+    for (int iBin = 0; iBin < nBins && isUniform; ++iBin) {
+      isUniform = (TMath::Abs(limits[iBin + 1] - limits[iBin] - width) < 1.0e-5 * width);
+    }
+    fIsUniform[i] = isUniform;
+    fInvBinWidths[i] = isUniform ? 1.0 / width : 0.0;
   }
-  (void)size;
   fIsInitialized = kTRUE;
 }
 
+//_________________________________________________________________________
+int MixingHandler::FindBin(int iVar, float value) const
+{
+  //
+  // Find the bin of a value for the iVar-th mixing variable, -1 if outside the limits
+  //   same convention as TMath::BinarySearch() on the bin limits: the upper limit of the last bin is excluded
+  //
+  const TArrayF& limits = fVariableLimits[iVar];
+  const int nBins = limits.GetSize() - 1;
+  if (nBins < 1 || !(value >= limits[0] && value < limits[nBins])) {
+    return -1;
+  }
+  if (!fIsUniform[iVar]) {
+    return TMath::BinarySearch(limits.GetSize(), limits.GetArray(), value);
+  }
+  int bin = static_cast<int>((value - limits[0]) * fInvBinWidths[iVar]);
+  // correct for the rounding close to the bin limits, such that the result is the same as for the binary search
+  if (bin >= nBins) {
+    bin = nBins - 1;
+  }
+  if (value < limits[bin]) {
+    bin--;
+  } else if (value >= limits[bin + 1]) {
+    bin++;
+  }
+  return bin;
+}
+
 //_________________________________________________________________________
 int MixingHandler::FindEventCategory(float* values)
 {
@@ -132,33 +176,43 @@ int MixingHandler::FindEventCategory(float* values)
     Init();
   }
 
-  std::vector<int> bin;
-  int iVar = 0;
-  for (auto v = fVariableLimits.begin(); v != fVariableLimits.end(); v++, iVar++) {
-    int binValue = TMath::BinarySearch((*v).GetSize(), (*v).GetArray(), values[fVariables[iVar]]);
-    bin.push_back(binValue);
-    if (bin[iVar] == -1 || bin[iVar] == (*v).GetSize() - 1) {
+  int category = 0;
+  for (unsigned int iVar = 0; iVar < fVariables.size(); iVar++) {
+    int bin = FindBin(iVar, values[fVariables[iVar]]);
+    if (bin < 0) {
       return -1; // all variables must be inside limits
     }
+    category += bin * fStrides[iVar];
   }
+  return category;
+}
 
-  int category = 0;
-  int tempCategory = 1;
-  int iv1 = 0;
-  int iv2 = 0;
-  for (auto v1 = fVariables.begin(); v1 != fVariables.end(); v1++, iv1++) {
-    tempCategory = 1;
-    iv2 = iv1;
-    for (auto v2 = v1; v2 != fVariables.end(); v2++, iv2++) {
-      if (iv2 == iv1) {
-        tempCategory *= bin[iv2];
-      } else {
-        tempCategory *= (fVariableLimits[iv2].GetSize() - 1);
+//_________________________________________________________________________
+void MixingHandler::FindEventCategories(const float* values, int nEvents, int* categories, int nValuesPerEvent)
+{
+  //
+  // Find the event categories of a set of events, e.g. all the events of a table
+  //   values of the event i start at values[i * nValuesPerEvent], in the same order as the VarManager variables
+  //
+  if (fVariables.size() == 0) {
+    std::fill(categories, categories + nEvents, -1);
+    return;
+  }
+  if (!fIsInitialized) {
+    Init();
+  }
+  std::fill(categories, categories + nEvents, 0);
+  // loop over the variables first, such that the inner loop runs over the events for a single set of bin limits
+  for (unsigned int iVar = 0; iVar < fVariables.size(); iVar++) {
+    const float* eventValues = values + fVariables[iVar];
+    for (int iEvent = 0; iEvent < nEvents; iEvent++, eventValues += nValuesPerEvent) {
+      if (categories[iEvent] < 0) {
+        continue;
       }
+      int bin = FindBin(iVar, *eventValues);
+      categories[iEvent] = (bin < 0 ? -1 : categories[iEvent] + bin * fStrides[iVar]);
     }
-    category += tempCategory;
   }
-  return category;
 }
 
 //_________________________________________________________________________
@@ -24,6 +24,8 @@
 #include <TList.h>
 #include <TString.h>
 
+#include <vector>
+
 #include "PWGDQ/Core/HistogramManager.h"
 #include "PWGDQ/Core/VarManager.h"
 
@@ -46,6 +48,8 @@ class MixingHandler : public TNamed
 
   void Init();
   int FindEventCategory(float* values);
+  // categories of nEvents events, whose variables are stored one event after the other, nValuesPerEvent values per event
+  void FindEventCategories(const float* values, int nEvents, int* categories, int nValuesPerEvent = VarManager::kNVars);
   int GetBinFromCategory(VarManager::Variables var, int category) const;
 
  private:
@@ -58,6 +62,13 @@ class MixingHandler : public TNamed
   std::vector<TArrayF> fVariableLimits;
   std::vector<int> fVariables;
 
+  // lookup information computed in Init()
+  std::vector<int> fStrides;        //! category stride of each variable
+  std::vector<bool> fIsUniform;     //! whether the bins of each variable have the same width
+  std::vector<float> fInvBinWidths; //! inverse bin width of the variables with uniform bins
+
+  int FindBin(int iVar, float value) const;
+
   ClassDef(MixingHandler, 1);
 };
 
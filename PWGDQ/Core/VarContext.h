@@ -0,0 +1,66 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+//
+// Contact: iarsene@cern.ch, i.c.arsene@fys.uio.no
+//
+// Instance-based value context for the VarManager
+//   The VarManager::Fill* functions write by default into the static VarManager::fgValues array,
+//   which cannot be shared by two task instances or by several threads. A VarContext owns its own
+//   value buffer and a snapshot of the used-variable mask, and converts to float* so that it can be
+//   passed as the values argument of any Fill* function, e.g. VarManager::FillPair<kDecayToEE, gkTrackFillMap>(t1, t2, context);
+//   The static API remains a thin wrapper writing into fgValues.
+//   NOTE: the static DCA fitters and the magnetic field are still shared; the Fill* functions using
+//         the fitters (FillPairVertexing, FillDileptonTrackVertexing, ...) must not be called concurrently.
+//
+
+#ifndef PWGDQ_CORE_VARCONTEXT_H_
+#define PWGDQ_CORE_VARCONTEXT_H_
+
+#include <algorithm>
+
+#include "PWGDQ/Core/VarManager.h"
+
+class VarContext
+{
+ public:
+  VarContext()
+  {
+    UpdateUsedVars();
+    Reset();
+  }
+
+  /// Takes a new snapshot of the used-variable mask configured in the VarManager
+  void UpdateUsedVars()
+  {
+    for (int i = 0; i < VarManager::kNVars; ++i) {
+      fUsedVars[i] = VarManager::GetUsedVar(i);
+    }
+  }
+  bool IsUsed(int var) const { return var >= 0 && var < VarManager::kNVars && fUsedVars[var]; }
+  const bool* GetUsedVars() const { return fUsedVars; }
+
+  /// Resets the values to the same neutral value as VarManager::ResetValues
+  void Reset(int startValue = 0, int endValue = VarManager::kNVars) { VarManager::ResetValues(startValue, endValue, fValues); }
+  /// Copies the values of another buffer, e.g. to start a pair from the values filled for its event
+  void CopyFrom(const float* values, int startValue = 0, int endValue = VarManager::kNVars) { std::copy(values + startValue, values + endValue, fValues + startValue); }
+
+  float* GetValues() { return fValues; }
+  const float* GetValues() const { return fValues; }
+  float& operator[](int var) { return fValues[var]; }
+  float operator[](int var) const { return fValues[var]; }
+  operator float*() { return fValues; }
+
+ private:
+  float fValues[VarManager::kNVars];  // values filled by the VarManager::Fill* functions
+  bool fUsedVars[VarManager::kNVars]; // snapshot of the used-variable mask
+};
+
+#endif // PWGDQ_CORE_VARCONTEXT_H_
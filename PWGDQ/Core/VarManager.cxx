@@ -22,6 +22,7 @@ TString VarManager::fgVariableNames[VarManager::kNVars] = {""};
 TString VarManager::fgVariableUnits[VarManager::kNVars] = {""};
 bool VarManager::fgUsedVars[VarManager::kNVars] = {false};
 bool VarManager::fgUsedKF = false;
+bool VarManager::fgUsedKernels[VarManager::kNKernels] = {false};
 float VarManager::fgMagField = 0.5;
 float VarManager::fgValues[VarManager::kNVars] = {0.0f};
 std::map<int, int> VarManager::fgRunMap;
@@ -39,6 +40,8 @@ o2::vertexing::DCAFitterN<3> VarManager::fgFitterThreeProngBarrel;
 o2::vertexing::FwdDCAFitterN<2> VarManager::fgFitterTwoProngFwd;
 o2::vertexing::FwdDCAFitterN<3> VarManager::fgFitterThreeProngFwd;
 o2::globaltracking::MatchGlobalFwd VarManager::mMatching;
+bool VarManager::fgUseMuonPropagationCache = false;
+std::unordered_map<uint64_t, o2::dataformats::GlobalFwdTrack> VarManager::fgMuonPropagationCache;
 std::map<VarManager::CalibObjects, TObject*> VarManager::fgCalibs;
 bool VarManager::fgRunTPCPostCalibration[4] = {false, false, false, false};
 
@@ -54,39 +57,58 @@ VarManager::VarManager() : TObject()
 //__________________________________________________________________
 VarManager::~VarManager() = default;
 
+namespace
+{
+// Variables needed for the calculation of other variables: {variable, {needed variables}}
+const std::vector<std::pair<int, std::vector<int>>> gkVarDependencies = {
+  {VarManager::kP, {VarManager::kPt, VarManager::kEta}},
+  {VarManager::kVertexingLxyOverErr, {VarManager::kVertexingLxy, VarManager::kVertexingLxyErr}},
+  {VarManager::kVertexingLzOverErr, {VarManager::kVertexingLz, VarManager::kVertexingLzErr}},
+  {VarManager::kVertexingLxyzOverErr, {VarManager::kVertexingLxyz, VarManager::kVertexingLxyzErr}},
+  {VarManager::kKFTracksDCAxyzMax, {VarManager::kKFTrack0DCAxyz, VarManager::kKFTrack1DCAxyz}},
+  {VarManager::kKFTracksDCAxyMax, {VarManager::kKFTrack0DCAxy, VarManager::kKFTrack1DCAxy}},
+  {VarManager::kTrackIsInsideTPCModule, {VarManager::kPhiTPCOuter}}};
+
+// Variables computed by each kernel, indexed by VarManager::FillKernels
+const std::vector<std::vector<int>> gkKernelVariables = {
+  {VarManager::kCosThetaHE, VarManager::kPhiHE, VarManager::kCosThetaCS, VarManager::kPhiCS},
+  {VarManager::kQuadDCAabsXY, VarManager::kQuadDCAsigXY, VarManager::kQuadDCAabsZ, VarManager::kQuadDCAsigZ, VarManager::kQuadDCAsigXYZ, VarManager::kSignQuadDCAsigXY},
+  {VarManager::kVertexingLxy, VarManager::kVertexingLz, VarManager::kVertexingLxyz, VarManager::kVertexingLxyErr, VarManager::kVertexingLzErr, VarManager::kVertexingTauxy, VarManager::kVertexingLxyOverErr, VarManager::kVertexingLzOverErr, VarManager::kVertexingLxyzOverErr, VarManager::kCosPointingAngle},
+  {VarManager::kVertexingLxyProjected, VarManager::kVertexingLxyzProjected, VarManager::kVertexingLzProjected}};
+} // namespace
+
 //__________________________________________________________________
 void VarManager::SetVariableDependencies()
 {
   //
-  // Set as used variables on which other variables calculation depends
+  // Set as used variables on which other variables calculation depends, following the dependencies until no new variable is added.
+  // Then enable the kernels computing at least one of the used variables
   //
-  if (fgUsedVars[kP]) {
-    fgUsedVars[kPt] = true;
-    fgUsedVars[kEta] = true;
+  static_assert(kNKernels == 4, "gkKernelVariables must list the variables of each kernel");
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (const auto& [var, neededVars] : gkVarDependencies) {
+      if (!fgUsedVars[var]) {
+        continue;
+      }
+      for (auto neededVar : neededVars) {
+        if (!fgUsedVars[neededVar]) {
+          fgUsedVars[neededVar] = true;
+          changed = true;
+        }
+      }
+    }
   }
 
-  if (fgUsedVars[kVertexingLxyOverErr]) {
-    fgUsedVars[kVertexingLxy] = true;
-    fgUsedVars[kVertexingLxyErr] = true;
-  }
-  if (fgUsedVars[kVertexingLzOverErr]) {
-    fgUsedVars[kVertexingLz] = true;
-    fgUsedVars[kVertexingLzErr] = true;
-  }
-  if (fgUsedVars[kVertexingLxyzOverErr]) {
-    fgUsedVars[kVertexingLxyz] = true;
-    fgUsedVars[kVertexingLxyzErr] = true;
-  }
-  if (fgUsedVars[kKFTracksDCAxyzMax]) {
-    fgUsedVars[kKFTrack0DCAxyz] = true;
-    fgUsedVars[kKFTrack1DCAxyz] = true;
-  }
-  if (fgUsedVars[kKFTracksDCAxyMax]) {
-    fgUsedVars[kKFTrack0DCAxy] = true;
-    fgUsedVars[kKFTrack1DCAxy] = true;
-  }
-  if (fgUsedVars[kTrackIsInsideTPCModule]) {
-    fgUsedVars[kPhiTPCOuter] = true;
+  for (int kernel = 0; kernel < kNKernels; ++kernel) {
+    fgUsedKernels[kernel] = false;
+    for (auto var : gkKernelVariables[kernel]) {
+      if (fgUsedVars[var]) {
+        fgUsedKernels[kernel] = true;
+        break;
+      }
+    }
   }
 }
 
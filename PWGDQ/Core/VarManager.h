@@ -25,6 +25,7 @@
 
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <cmath>
 #include <iostream>
 #include <utility>
@@ -696,6 +697,16 @@ class VarManager : public TObject
     kSingleGapC
   };
 
+  // Groups of variables computed together in the Fill* functions. A kernel runs only if
+  // at least one of its variables is used; the lists are defined in VarManager.cxx
+  enum FillKernels {
+    kKernelPairPolarization = 0, // boost to the pair rest frame and helicity / Collins-Soper frames
+    kKernelPairQuadDCA,          // quadratic mean of the leg DCAs
+    kKernelKFDecayLength,        // KF decay lengths with respect to the PV
+    kKernelKFDecayLengthProj,    // KF decay lengths projected onto the pair momentum
+    kNKernels
+  };
+
   enum MuonExtrapolation {
     // Index used to set different options for Muon propagation
     kToVertex = 0, // propagtion to vertex by default
@@ -728,6 +739,7 @@ class VarManager : public TObject
     for (auto& var : usedVars) {
       fgUsedVars[var] = true;
     }
+    SetVariableDependencies();
   }
   static bool GetUsedVar(int var)
   {
@@ -736,6 +748,13 @@ class VarManager : public TObject
     }
     return false;
   }
+  static bool GetUsedKernel(int kernel)
+  {
+    if (kernel >= 0 && kernel < kNKernels) {
+      return fgUsedKernels[kernel];
+    }
+    return false;
+  }
 
   static void SetRunNumbers(int n, int* runs);
   static void SetRunNumbers(std::vector<int> runs);
@@ -861,6 +880,17 @@ class VarManager : public TObject
 
   template <typename T, typename C>
   static o2::dataformats::GlobalFwdTrack PropagateMuon(const T& muon, const C& collision, int endPoint = kToVertex);
+  // Keep the results of PropagateMuon(), keyed by muon, collision and end point, such that a muon is extrapolated only once
+  //   e.g. when it enters several pairs. The cache must be reset for each dataframe, since it is keyed by the global indices
+  static void SetUseMuonPropagationCache(bool use = true)
+  {
+    fgUseMuonPropagationCache = use;
+    fgMuonPropagationCache.clear();
+  }
+  static void ResetMuonPropagationCache()
+  {
+    fgMuonPropagationCache.clear();
+  }
   template <uint32_t fillMap, typename T, typename C>
   static void FillMuonPDca(const T& muon, const C& collision, float* values = nullptr);
   template <uint32_t fillMap, typename T, typename C>
@@ -972,9 +1002,10 @@ class VarManager : public TObject
   static void ResetValues(int startValue = 0, int endValue = kNVars, float* values = nullptr);
 
  private:
-  static bool fgUsedVars[kNVars]; // holds flags for when the corresponding variable is needed (e.g., in the histogram manager, in cuts, mixing handler, etc.)
+  static bool fgUsedVars[kNVars];       // holds flags for when the corresponding variable is needed (e.g., in the histogram manager, in cuts, mixing handler, etc.)
+  static bool fgUsedKernels[kNKernels]; // holds flags for the groups of variables which need to be computed, derived from fgUsedVars
   static bool fgUsedKF;
-  static void SetVariableDependencies(); // toggle those variables on which other used variables might depend
+  static void SetVariableDependencies(); // toggle those variables on which other used variables might depend, and the kernels needed
 
   static float fgMagField;
   static std::map<int, int> fgRunMap;     // map of runs to be used in histogram axes
@@ -1007,6 +1038,11 @@ class VarManager : public TObject
   static o2::vertexing::FwdDCAFitterN<2> fgFitterTwoProngFwd;
   static o2::vertexing::FwdDCAFitterN<3> fgFitterThreeProngFwd;
   static o2::globaltracking::MatchGlobalFwd mMatching;
+  static bool fgUseMuonPropagationCache;                                                       // whether to cache the muon extrapolations
+  static std::unordered_map<uint64_t, o2::dataformats::GlobalFwdTrack> fgMuonPropagationCache; //! propagated muons, see PropagateMuon()
+
+  template <typename T, typename C>
+  static o2::dataformats::GlobalFwdTrack ExtrapolateMuon(const T& muon, const C& collision, int endPoint);
 
   static std::map<CalibObjects, TObject*> fgCalibs; // map of calibration histograms
   static bool fgRunTPCPostCalibration[4];           // 0-electron, 1-pion, 2-kaon, 3-proton
@@ -1104,6 +1140,20 @@ KFPVertex VarManager::createKFPVertexFromCollision(const T& collision)
 
 template <typename T, typename C>
 o2::dataformats::GlobalFwdTrack VarManager::PropagateMuon(const T& muon, const C& collision, const int endPoint)
+{
+  if (!fgUseMuonPropagationCache) {
+    return ExtrapolateMuon(muon, collision, endPoint);
+  }
+  const uint64_t key = (static_cast<uint64_t>(muon.globalIndex()) << 32) | (static_cast<uint64_t>(collision.globalIndex()) << 2) | static_cast<uint64_t>(endPoint);
+  auto cached = fgMuonPropagationCache.find(key);
+  if (cached != fgMuonPropagationCache.end()) {
+    return cached->second;
+  }
+  return fgMuonPropagationCache.emplace(key, ExtrapolateMuon(muon, collision, endPoint)).first->second;
+}
+
+template <typename T, typename C>
+o2::dataformats::GlobalFwdTrack VarManager::ExtrapolateMuon(const T& muon, const C& collision, const int endPoint)
 {
   double chi2 = muon.chi2();
   SMatrix5 tpars(muon.x(), muon.y(), muon.phi(), muon.tgl(), muon.signed1Pt());
@@ -1158,7 +1208,6 @@ void VarManager::FillMuonPDca(const T& muon, const C& collision, float* values)
 
   if constexpr ((fillMap & MuonCov) > 0 || (fillMap & ReducedMuonCov) > 0) {
 
-    o2::dataformats::GlobalFwdTrack propmuon = PropagateMuon(muon, collision);
     o2::dataformats::GlobalFwdTrack propmuonAtDCA = PropagateMuon(muon, collision, kToDCA);
 
     float dcaX = (propmuonAtDCA.getX() - collision.posX());
@@ -1688,7 +1737,7 @@ void VarManager::FillTwoMixEvents(T1 const& ev1, T1 const& ev2, T2 const& /*trac
     values[kQ2Y0A2] = ev2.q2y0a();
   }
 
-  if (isnan(VarManager::fgValues[VarManager::kTwoR2SP1]) == true || isnan(VarManager::fgValues[VarManager::kTwoR2EP1]) == true) {
+  if (isnan(values[kTwoR2SP1]) == true || isnan(values[kTwoR2EP1]) == true) {
     values[kTwoR2SP1] = -999.;
     values[kTwoR2SP2] = -999.;
     values[kTwoR2EP1] = -999.;
@@ -2164,7 +2213,6 @@ void VarManager::FillTrackCollision(T const& track, C const& collision, float* v
   }
   if constexpr ((fillMap & MuonCov) > 0 || (fillMap & ReducedMuonCov) > 0) {
 
-    o2::dataformats::GlobalFwdTrack propmuon = PropagateMuon(track, collision);
     o2::dataformats::GlobalFwdTrack propmuonAtDCA = PropagateMuon(track, collision, kToDCA);
 
     float dcaX = (propmuonAtDCA.getX() - collision.posX());
@@ -2355,47 +2403,49 @@ void VarManager::FillPair(T1 const& t1, T2 const& t2, float* values)
     }
   }
 
-  // TO DO: get the correct values from CCDB
-  double BeamMomentum = TMath::Sqrt(fgCenterOfMassEnergy * fgCenterOfMassEnergy / 4 - fgMassofCollidingParticle * fgMassofCollidingParticle); // GeV
-  ROOT::Math::PxPyPzEVector Beam1(0., 0., -BeamMomentum, fgCenterOfMassEnergy / 2);
-  ROOT::Math::PxPyPzEVector Beam2(0., 0., BeamMomentum, fgCenterOfMassEnergy / 2);
+  if (fgUsedKernels[kKernelPairPolarization]) {
+    // TO DO: get the correct values from CCDB
+    double BeamMomentum = TMath::Sqrt(fgCenterOfMassEnergy * fgCenterOfMassEnergy / 4 - fgMassofCollidingParticle * fgMassofCollidingParticle); // GeV
+    ROOT::Math::PxPyPzEVector Beam1(0., 0., -BeamMomentum, fgCenterOfMassEnergy / 2);
+    ROOT::Math::PxPyPzEVector Beam2(0., 0., BeamMomentum, fgCenterOfMassEnergy / 2);
 
-  // Boost to center of mass frame
-  ROOT::Math::Boost boostv12{v12.BoostToCM()};
-  ROOT::Math::XYZVectorF v1_CM{(boostv12(v1).Vect()).Unit()};
-  ROOT::Math::XYZVectorF v2_CM{(boostv12(v2).Vect()).Unit()};
-  ROOT::Math::XYZVectorF Beam1_CM{(boostv12(Beam1).Vect()).Unit()};
-  ROOT::Math::XYZVectorF Beam2_CM{(boostv12(Beam2).Vect()).Unit()};
+    // Boost to center of mass frame
+    ROOT::Math::Boost boostv12{v12.BoostToCM()};
+    ROOT::Math::XYZVectorF v1_CM{(boostv12(v1).Vect()).Unit()};
+    ROOT::Math::XYZVectorF v2_CM{(boostv12(v2).Vect()).Unit()};
+    ROOT::Math::XYZVectorF Beam1_CM{(boostv12(Beam1).Vect()).Unit()};
+    ROOT::Math::XYZVectorF Beam2_CM{(boostv12(Beam2).Vect()).Unit()};
 
-  // Helicity frame
-  ROOT::Math::XYZVectorF zaxis_HE{(v12.Vect()).Unit()};
-  ROOT::Math::XYZVectorF yaxis_HE{(Beam1_CM.Cross(Beam2_CM)).Unit()};
-  ROOT::Math::XYZVectorF xaxis_HE{(yaxis_HE.Cross(zaxis_HE)).Unit()};
+    // Helicity frame
+    ROOT::Math::XYZVectorF zaxis_HE{(v12.Vect()).Unit()};
+    ROOT::Math::XYZVectorF yaxis_HE{(Beam1_CM.Cross(Beam2_CM)).Unit()};
+    ROOT::Math::XYZVectorF xaxis_HE{(yaxis_HE.Cross(zaxis_HE)).Unit()};
 
-  // Collins-Soper frame
-  ROOT::Math::XYZVectorF zaxis_CS{((Beam1_CM.Unit() - Beam2_CM.Unit()).Unit())};
-  ROOT::Math::XYZVectorF yaxis_CS{(Beam1_CM.Cross(Beam2_CM)).Unit()};
-  ROOT::Math::XYZVectorF xaxis_CS{(yaxis_CS.Cross(zaxis_CS)).Unit()};
+    // Collins-Soper frame
+    ROOT::Math::XYZVectorF zaxis_CS{((Beam1_CM.Unit() - Beam2_CM.Unit()).Unit())};
+    ROOT::Math::XYZVectorF yaxis_CS{(Beam1_CM.Cross(Beam2_CM)).Unit()};
+    ROOT::Math::XYZVectorF xaxis_CS{(yaxis_CS.Cross(zaxis_CS)).Unit()};
 
-  if (fgUsedVars[kCosThetaHE]) {
-    values[kCosThetaHE] = (t1.sign() > 0 ? zaxis_HE.Dot(v1_CM) : zaxis_HE.Dot(v2_CM));
-  }
+    if (fgUsedVars[kCosThetaHE]) {
+      values[kCosThetaHE] = (t1.sign() > 0 ? zaxis_HE.Dot(v1_CM) : zaxis_HE.Dot(v2_CM));
+    }
 
-  if (fgUsedVars[kPhiHE]) {
-    values[kPhiHE] = (t1.sign() > 0 ? TMath::ATan2(yaxis_HE.Dot(v1_CM), xaxis_HE.Dot(v1_CM)) : TMath::ATan2(yaxis_HE.Dot(v2_CM), xaxis_HE.Dot(v2_CM)));
-  }
+    if (fgUsedVars[kPhiHE]) {
+      values[kPhiHE] = (t1.sign() > 0 ? TMath::ATan2(yaxis_HE.Dot(v1_CM), xaxis_HE.Dot(v1_CM)) : TMath::ATan2(yaxis_HE.Dot(v2_CM), xaxis_HE.Dot(v2_CM)));
+    }
 
-  if (fgUsedVars[kCosThetaCS]) {
-    values[kCosThetaCS] = (t1.sign() > 0 ? zaxis_CS.Dot(v1_CM) : zaxis_CS.Dot(v2_CM));
-  }
+    if (fgUsedVars[kCosThetaCS]) {
+      values[kCosThetaCS] = (t1.sign() > 0 ? zaxis_CS.Dot(v1_CM) : zaxis_CS.Dot(v2_CM));
+    }
 
-  if (fgUsedVars[kPhiCS]) {
-    values[kPhiCS] = (t1.sign() > 0 ? TMath::ATan2(yaxis_CS.Dot(v1_CM), xaxis_CS.Dot(v1_CM)) : TMath::ATan2(yaxis_CS.Dot(v2_CM), xaxis_CS.Dot(v2_CM)));
+    if (fgUsedVars[kPhiCS]) {
+      values[kPhiCS] = (t1.sign() > 0 ? TMath::ATan2(yaxis_CS.Dot(v1_CM), xaxis_CS.Dot(v1_CM)) : TMath::ATan2(yaxis_CS.Dot(v2_CM), xaxis_CS.Dot(v2_CM)));
+    }
   }
 
   if constexpr ((pairType == kDecayToEE) && ((fillMap & TrackCov) > 0 || (fillMap & ReducedTrackBarrelCov) > 0)) {
 
-    if (fgUsedVars[kQuadDCAabsXY] || fgUsedVars[kQuadDCAsigXY] || fgUsedVars[kQuadDCAabsZ] || fgUsedVars[kQuadDCAsigZ] || fgUsedVars[kQuadDCAsigXYZ] || fgUsedVars[kSignQuadDCAsigXY]) {
+    if (fgUsedKernels[kKernelPairQuadDCA]) {
       // Quantities based on the barrel tables
       double dca1XY = t1.dcaXY();
       double dca2XY = t2.dcaXY();
@@ -2867,7 +2917,7 @@ void VarManager::FillPairVertexing(C const& collision, T const& t1, T const& t2,
       double dxPair2PV = KFGeoTwoProng.GetX() - KFPV.GetX();
       double dyPair2PV = KFGeoTwoProng.GetY() - KFPV.GetY();
       double dzPair2PV = KFGeoTwoProng.GetZ() - KFPV.GetZ();
-      if (fgUsedVars[kVertexingLxy] || fgUsedVars[kVertexingLz] || fgUsedVars[kVertexingLxyz] || fgUsedVars[kVertexingLxyErr] || fgUsedVars[kVertexingLzErr] || fgUsedVars[kVertexingTauxy] || fgUsedVars[kVertexingLxyOverErr] || fgUsedVars[kVertexingLzOverErr] || fgUsedVars[kVertexingLxyzOverErr] || fgUsedVars[kCosPointingAngle]) {
+      if (fgUsedKernels[kKernelKFDecayLength]) {
         values[kVertexingLxy] = std::sqrt(dxPair2PV * dxPair2PV + dyPair2PV * dyPair2PV);
         values[kVertexingLz] = std::sqrt(dzPair2PV * dzPair2PV);
         values[kVertexingLxyz] = std::sqrt(dxPair2PV * dxPair2PV + dyPair2PV * dyPair2PV + dzPair2PV * dzPair2PV);
@@ -2895,7 +2945,7 @@ void VarManager::FillPairVertexing(C const& collision, T const& t1, T const& t2,
                                     (v12.P() * values[VarManager::kVertexingLxyz]);
       }
       // As defined in Run 2 (projected onto momentum)
-      if (fgUsedVars[kVertexingLxyProjected] || fgUsedVars[kVertexingLxyzProjected] || fgUsedVars[kVertexingLzProjected]) {
+      if (fgUsedKernels[kKernelKFDecayLengthProj]) {
         values[kVertexingLzProjected] = (dzPair2PV * KFGeoTwoProng.GetPz()) / TMath::Sqrt(KFGeoTwoProng.GetPz() * KFGeoTwoProng.GetPz());
         values[kVertexingLxyProjected] = (dxPair2PV * KFGeoTwoProng.GetPx()) + (dyPair2PV * KFGeoTwoProng.GetPy());
         values[kVertexingLxyProjected] = values[kVertexingLxyProjected] / TMath::Sqrt((KFGeoTwoProng.GetPx() * KFGeoTwoProng.GetPx()) + (KFGeoTwoProng.GetPy() * KFGeoTwoProng.GetPy()));
@@ -3485,7 +3535,7 @@ void VarManager::FillDileptonTrackVertexing(C const& collision, T1 const& lepton
         double dyTriplet3PV = KFGeoThreeProng.GetY() - KFPV.GetY();
         double dzTriplet3PV = KFGeoThreeProng.GetZ() - KFPV.GetZ();
 
-        if (fgUsedVars[kVertexingLxy] || fgUsedVars[kVertexingLz] || fgUsedVars[kVertexingLxyz] || fgUsedVars[kVertexingLxyErr] || fgUsedVars[kVertexingLzErr] || fgUsedVars[kVertexingTauxy] || fgUsedVars[kVertexingLxyOverErr] || fgUsedVars[kVertexingLzOverErr] || fgUsedVars[kVertexingLxyzOverErr] || fgUsedVars[kCosPointingAngle]) {
+        if (fgUsedKernels[kKernelKFDecayLength]) {
           values[kVertexingLxy] = std::sqrt(dxTriplet3PV * dxTriplet3PV + dyTriplet3PV * dyTriplet3PV);
           values[kVertexingLz] = std::sqrt(dzTriplet3PV * dzTriplet3PV);
           values[kVertexingLxyz] = std::sqrt(dxTriplet3PV * dxTriplet3PV + dyTriplet3PV * dyTriplet3PV + dzTriplet3PV * dzTriplet3PV);
@@ -3515,7 +3565,7 @@ void VarManager::FillDileptonTrackVertexing(C const& collision, T1 const& lepton
         } // end calculate vertex variables
 
         // As defined in Run 2 (projected onto momentum)
-        if (fgUsedVars[kVertexingLxyProjected] || fgUsedVars[kVertexingLxyzProjected] || fgUsedVars[kVertexingLzProjected]) {
+        if (fgUsedKernels[kKernelKFDecayLengthProj]) {
           values[kVertexingLzProjected] = (dzTriplet3PV * KFGeoThreeProng.GetPz()) / TMath::Sqrt(KFGeoThreeProng.GetPz() * KFGeoThreeProng.GetPz());
           values[kVertexingLxyProjected] = (dxTriplet3PV * KFGeoThreeProng.GetPx()) + (dyTriplet3PV * KFGeoThreeProng.GetPy());
           values[kVertexingLxyProjected] = values[kVertexingLxyProjected] / TMath::Sqrt((KFGeoThreeProng.GetPx() * KFGeoThreeProng.GetPx()) + (KFGeoThreeProng.GetPy() * KFGeoThreeProng.GetPy()));
@@ -3858,23 +3908,23 @@ void VarManager::FillPairVn(T1 const& t1, T2 const& t2, float* values)
   values[kCos2DeltaPhiMu1] = std::cos(2 * (v1.Phi() - v12.Phi()));
   values[kCos2DeltaPhiMu2] = std::cos(2 * (v2.Phi() - v12.Phi()));
 
-  if (isnan(VarManager::fgValues[VarManager::kU2Q2]) == true) {
+  if (isnan(values[kU2Q2]) == true) {
     values[kU2Q2] = -999.;
     values[kR2SP_AB] = -999.;
     values[kR2SP_AC] = -999.;
     values[kR2SP_BC] = -999.;
   }
-  if (isnan(VarManager::fgValues[VarManager::kU3Q3]) == true) {
+  if (isnan(values[kU3Q3]) == true) {
     values[kU3Q3] = -999.;
     values[kR3SP] = -999.;
   }
-  if (isnan(VarManager::fgValues[VarManager::kCos2DeltaPhi]) == true) {
+  if (isnan(values[kCos2DeltaPhi]) == true) {
     values[kCos2DeltaPhi] = -999.;
     values[kR2EP_AB] = -999.;
     values[kR2EP_AC] = -999.;
     values[kR2EP_BC] = -999.;
   }
-  if (isnan(VarManager::fgValues[VarManager::kCos3DeltaPhi]) == true) {
+  if (isnan(values[kCos3DeltaPhi]) == true) {
     values[kCos3DeltaPhi] = -999.;
     values[kR3EP] = -999.;
   }
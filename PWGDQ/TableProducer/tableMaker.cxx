@@ -17,7 +17,9 @@
 // The skimming can optionally produce just the barrel, muon, or both barrel and muon tracks
 // The event filtering (filterPP), centrality, and V0Bits (from v0-selector) can be switched on/off by selecting one
 //  of the process functions
+#include <algorithm>
 #include <iostream>
+#include <vector>
 #include "Framework/AnalysisTask.h"
 #include "Framework/AnalysisDataModel.h"
 #include "Framework/ASoAHelpers.h"
@@ -36,6 +38,7 @@
 #include "PWGDQ/Core/HistogramManager.h"
 #include "PWGDQ/Core/AnalysisCut.h"
 #include "PWGDQ/Core/AnalysisCompositeCut.h"
+#include "PWGDQ/Core/CompiledCuts.h"
 #include "PWGDQ/Core/HistogramsLibrary.h"
 #include "PWGDQ/Core/CutsLibrary.h"
 #include "DataFormatsGlobalTracking/RecoContainerCreateTracksVariadic.h"
@@ -206,6 +209,11 @@ struct TableMaker {
   AnalysisCompositeCut* fEventCut;              //! Event selection cut
   std::vector<AnalysisCompositeCut> fTrackCuts; //! Barrel track cuts
   std::vector<AnalysisCompositeCut> fMuonCuts;  //! Muon track cuts
+  CompiledCuts fTrackCutsCompiled;              //! Barrel track cuts flattened for evaluation
+  CompiledCuts fMuonCutsCompiled;               //! Muon track cuts flattened for evaluation
+
+  std::vector<int64_t> fAmbiguousTrackIds; // sorted global indices of the ambiguous barrel tracks of the dataframe
+  std::vector<int64_t> fAmbiguousMuonIds;  // sorted global indices of the ambiguous muons of the dataframe
 
   Preslice<MyBarrelTracks> perCollisionTracks = aod::track::collisionId;
   Preslice<MyMuons> perCollisionMuons = aod::fwdtrack::collisionId;
@@ -230,6 +238,8 @@ struct TableMaker {
       fCCDB->get<TGeoManager>(geoPath);
     }
     VarManager::SetDefaultVarNames();
+    // the selected muons are propagated a second time when they are written, keep the extrapolations
+    VarManager::SetUseMuonPropagationCache(true);
     fHistMan = new HistogramManager("analysisHistos", "aa", VarManager::kNVars);
     fHistMan->SetUseDefaultVariableNames(kTRUE);
     fHistMan->SetDefaultVarNames(VarManager::fgVariableNames, VarManager::fgVariableUnits);
@@ -346,14 +356,17 @@ struct TableMaker {
         fMuonCuts.push_back(*dqcuts::GetCompositeCut(objArray->At(icut)->GetName()));
       }
     }
+    fTrackCutsCompiled.AddCuts(fTrackCuts);
+    fMuonCutsCompiled.AddCuts(fMuonCuts);
 
     VarManager::SetUseVars(AnalysisCut::fgUsedVars); // provide the list of required variables so that VarManager knows what to fill
   }
 
   // Templated function instantianed for all of the process functions
   template <uint32_t TEventFillMap, uint32_t TTrackFillMap, uint32_t TMuonFillMap, uint32_t TMFTFillMap = 0u, typename TEvent, typename TTracks, typename TMuons, typename TAmbiTracks, typename TAmbiMuons, typename TMFTTracks = std::nullptr_t>
-  void fullSkimming(TEvent const& collision, aod::BCsWithTimestamps const&, TTracks const& tracksBarrel, TMuons const& tracksMuon, TAmbiTracks const& ambiTracksMid, TAmbiMuons const& ambiTracksFwd, TMFTTracks const& mftTracks = nullptr)
+  void fullSkimming(TEvent const& collision, aod::BCsWithTimestamps const&, TTracks const& tracksBarrel, TMuons const& tracksMuon, TAmbiTracks const& /*ambiTracksMid*/, TAmbiMuons const& /*ambiTracksFwd*/, TMFTTracks const& mftTracks = nullptr)
   {
+    VarManager::ResetMuonPropagationCache(); // the propagations are reused within a collision only
     auto bc = collision.template bc_as<aod::BCsWithTimestamps>();
     if (fCurrentRun != bc.runNumber()) {
       if (fConfigComputeTPCpostCalib) {
@@ -486,13 +499,7 @@ struct TableMaker {
       for (auto& track : tracksBarrel) {
         if constexpr ((TTrackFillMap & VarManager::ObjTypes::AmbiTrack) > 0) {
           if (fIsAmbiguous) {
-            isAmbiguous = 0;
-            for (auto& ambiTrackMid : ambiTracksMid) {
-              if (ambiTrackMid.trackId() == track.globalIndex()) {
-                isAmbiguous = 1;
-                break;
-              }
-            }
+            isAmbiguous = std::binary_search(fAmbiguousTrackIds.begin(), fAmbiguousTrackIds.end(), static_cast<int64_t>(track.globalIndex())) ? 1 : 0;
           }
         }
 
@@ -508,8 +515,9 @@ struct TableMaker {
 
         // apply track cuts and fill stats histogram
         int i = 0;
+        const uint64_t cutDecisions = fTrackCutsCompiled.Evaluate(VarManager::fgValues);
         for (auto cut = fTrackCuts.begin(); cut != fTrackCuts.end(); cut++, i++) {
-          if ((*cut).IsSelected(VarManager::fgValues)) {
+          if (cutDecisions & (uint64_t(1) << i)) {
             trackTempFilterMap |= (uint8_t(1) << i);
             if (fConfigQA) {
               fHistMan->FillHistClass(Form("TrackBarrel_%s", (*cut).GetName()), VarManager::fgValues);
@@ -641,55 +649,22 @@ struct TableMaker {
       if constexpr (static_cast<bool>(TMuonFillMap & VarManager::ObjTypes::MuonCov)) {
         muonCov.reserve(tracksMuon.size());
       }
-      // loop over muons
-
-      // first we need to get the correct indices
-      int nDel = 0;
-      int idxPrev = -1;
-      std::map<int, int> newEntryNb;
-      std::map<int, int> newMatchIndex;
-      std::map<int, int> newMFTMatchIndex;
-
+      // first pass over the muons: compute the selection decisions, fill the QA histograms and count the selected muons,
+      //   which gives the index of each muon in the skimmed table, needed to update the matching indices
+      std::vector<uint8_t> muonFilterMaps;
+      muonFilterMaps.reserve(tracksMuon.size());
+      int64_t firstMuonIndex = -1;
+      int64_t lastMuonIndex = -1;
       for (auto& muon : tracksMuon) {
-        fwdFilteringTag = uint64_t(0);
-        VarManager::FillTrack<TMuonFillMap>(muon);
-        if (fPropMuon) {
-          VarManager::FillPropagateMuon<TMuonFillMap>(muon, collision);
-        }
-
-        if (muon.index() > idxPrev + 1) { // checks if some muons are filtered even before the skimming function
-          nDel += muon.index() - (idxPrev + 1);
+        if (firstMuonIndex < 0) {
+          firstMuonIndex = muon.index();
         }
-        idxPrev = muon.index();
-
-        // check the cuts and filters
-        int i = 0;
-        for (auto cut = fMuonCuts.begin(); cut != fMuonCuts.end(); cut++, i++) {
-          if ((*cut).IsSelected(VarManager::fgValues))
-            trackTempFilterMap |= (uint8_t(1) << i);
-        }
-
-        if (!trackTempFilterMap) { // does not pass the cuts
-          nDel++;
-        } else { // it passes the cuts and will be saved in the tables
-          newEntryNb[muon.index()] = muon.index() - nDel;
-        }
-      }
-
-      // now let's save the muons with the correct indices and matches
-      for (auto& muon : tracksMuon) {
+        lastMuonIndex = muon.index();
         if constexpr ((TMuonFillMap & VarManager::ObjTypes::AmbiMuon) > 0) {
           if (fIsAmbiguous) {
-            isAmbiguous = 0;
-            for (auto& ambiTrackFwd : ambiTracksFwd) {
-              if (ambiTrackFwd.fwdtrackId() == muon.globalIndex()) {
-                isAmbiguous = 1;
-                break;
-              }
-            }
+            isAmbiguous = std::binary_search(fAmbiguousMuonIds.begin(), fAmbiguousMuonIds.end(), static_cast<int64_t>(muon.globalIndex())) ? 1 : 0;
           }
         }
-        fwdFilteringTag = uint8_t(0);
         trackTempFilterMap = uint8_t(0);
 
         VarManager::FillTrack<TMuonFillMap>(muon);
@@ -708,8 +683,9 @@ struct TableMaker {
         }
         // apply the muon selection cuts and fill the stats histogram
         int i = 0;
+        const uint64_t cutDecisions = fMuonCutsCompiled.Evaluate(VarManager::fgValues);
         for (auto cut = fMuonCuts.begin(); cut != fMuonCuts.end(); cut++, i++) {
-          if ((*cut).IsSelected(VarManager::fgValues)) {
+          if (cutDecisions & (uint64_t(1) << i)) {
             trackTempFilterMap |= (uint8_t(1) << i);
             if (fConfigQA) {
               fHistMan->FillHistClass(Form("Muons_%s", (*cut).GetName()), VarManager::fgValues);
@@ -720,9 +696,46 @@ struct TableMaker {
             (reinterpret_cast<TH1I*>(fStatsList->At(2)))->Fill(static_cast<float>(i));
           }
         }
+        muonFilterMaps.push_back(trackTempFilterMap);
+      }
+
+      // index of each selected muon in the skimmed table of this event, from the prefix sum of the selection decisions, -1 if not selected
+      //   the vectors are indexed by muon.index() - firstMuonIndex
+      const int64_t nMuonIndices = lastMuonIndex - firstMuonIndex + 1;
+      std::vector<int> newEntryNb(nMuonIndices, -1);
+      std::vector<int> newMatchIndex(nMuonIndices, -1);
+      std::vector<int> newMFTMatchIndex(nMuonIndices, -1);
+      int nSelected = 0;
+      int iMuon = 0;
+      for (auto& muon : tracksMuon) {
+        if (muonFilterMaps[iMuon++]) {
+          newEntryNb[muon.index() - firstMuonIndex] = nSelected++;
+        }
+      }
+      auto getEntryNb = [&](int64_t index) {
+        return (index >= firstMuonIndex && index <= lastMuonIndex) ? newEntryNb[index - firstMuonIndex] : -1;
+      };
+
+      // second pass: save the selected muons with the correct indices and matches
+      iMuon = 0;
+      for (auto& muon : tracksMuon) {
+        trackTempFilterMap = muonFilterMaps[iMuon++];
         if (!trackTempFilterMap) {
           continue;
         }
+        if constexpr ((TMuonFillMap & VarManager::ObjTypes::AmbiMuon) > 0) {
+          if (fIsAmbiguous) {
+            isAmbiguous = std::binary_search(fAmbiguousMuonIds.begin(), fAmbiguousMuonIds.end(), static_cast<int64_t>(muon.globalIndex())) ? 1 : 0;
+          }
+        }
+        fwdFilteringTag = uint8_t(0);
+
+        VarManager::FillTrack<TMuonFillMap>(muon);
+        VarManager::FillTrackCollision<TMuonFillMap>(muon, collision);
+        if (fPropMuon) {
+          VarManager::FillPropagateMuon<TMuonFillMap>(muon, collision);
+        }
+
         // store the cut decisions
         trackFilteringTag = trackTempFilterMap; // BIT0-7:  user selection cuts
         if (fPropMuon) {
@@ -730,40 +743,29 @@ struct TableMaker {
         }
 
         // update the matching MCH/MFT index
+        const int64_t muonIdx = muon.index() - firstMuonIndex;
+        const int entryNb = newEntryNb[muonIdx];
         if (static_cast<int>(muon.trackType()) == 0 || static_cast<int>(muon.trackType()) == 2) { // MCH-MFT(2) or GLB(0) track
           int matchIdx = muon.matchMCHTrackId() - muon.offsets();                                 // simple match index, not the global index
           int matchMFTIdx = muon.matchMFTTrackId() - mftOffsets[muon.matchMFTTrackId()];
 
           // first for MCH matching index
-          if (newEntryNb.count(matchIdx) > 0) {                                                  // if the key exists i.e the match will not get deleted
-            newMatchIndex[muon.index()] = newEntryNb[matchIdx];                                  // update the match for this muon to the updated entry of the match
-            newMatchIndex[muon.index()] += muonBasic.lastIndex() + 1 - newEntryNb[muon.index()]; // adding the offset of muons, muonBasic.lastIndex() start at -1
-
-            if (static_cast<int>(muon.trackType()) == 0) {                                     // for now only do this to global tracks
-              newMatchIndex[matchIdx] = newEntryNb[muon.index()];                              // add the  updated index of this muon as a match to mch track
-              newMatchIndex[matchIdx] += muonBasic.lastIndex() + 1 - newEntryNb[muon.index()]; // adding the offset, muonBasic.lastIndex() start at -1
+          const int matchEntryNb = getEntryNb(matchIdx);
+          if (matchEntryNb >= 0) {                                                       // the match will not get deleted
+            newMatchIndex[muonIdx] = matchEntryNb + muonBasic.lastIndex() + 1 - entryNb; // updated entry of the match plus the offset of muons, muonBasic.lastIndex() start at -1
+            if (static_cast<int>(muon.trackType()) == 0) {                               // for now only do this to global tracks
+              newMatchIndex[matchIdx - firstMuonIndex] = muonBasic.lastIndex() + 1;      // add the updated index of this muon as a match to mch track
             }
-          } else {
-            newMatchIndex[muon.index()] = -1;
           }
 
           // then for MFT match index
-          if (newMFTTableSize.count(matchMFTIdx) > 0) {                        // if the key exists i.e the match will not get deleted
-            newMFTMatchIndex[muon.index()] = newMFTTableSize[matchMFTIdx] + 1; // adding the offset of mfts, newMFTTableSize start at -1
-          } else {
-            newMFTMatchIndex[muon.index()] = -1;
-          }
-
-        } else if (static_cast<int>(muon.trackType() == 4)) { // an MCH track
-
-          newMFTMatchIndex[muon.index()] = -1;
-          // in this case the matches should be filled from the other types but we need to check
-          if (newMatchIndex.count(muon.index()) == 0) { // if an entry for this mch was not added it simply mean that non of the global tracks were matched to it
-            newMatchIndex[muon.index()] = -1;
+          if (newMFTTableSize.count(matchMFTIdx) > 0) {                   // if the key exists i.e the match will not get deleted
+            newMFTMatchIndex[muonIdx] = newMFTTableSize[matchMFTIdx] + 1; // adding the offset of mfts, newMFTTableSize start at -1
           }
         }
+        // NOTE: for the MCH tracks, the match index is filled from the global tracks matched to them, -1 if none
 
-        muonBasic(event.lastIndex(), newMatchIndex.find(muon.index())->second, newMFTMatchIndex.find(muon.index())->second, trackFilteringTag, VarManager::fgValues[VarManager::kPt], VarManager::fgValues[VarManager::kEta], VarManager::fgValues[VarManager::kPhi], muon.sign(), isAmbiguous);
+        muonBasic(event.lastIndex(), newMatchIndex[muonIdx], newMFTMatchIndex[muonIdx], trackFilteringTag, VarManager::fgValues[VarManager::kPt], VarManager::fgValues[VarManager::kEta], VarManager::fgValues[VarManager::kPhi], muon.sign(), isAmbiguous);
         muonInfo(muon.collisionId(), collision.posX(), collision.posY(), collision.posZ());
         if constexpr (static_cast<bool>(TMuonFillMap & VarManager::ObjTypes::MuonCov)) {
 
@@ -800,6 +802,7 @@ struct TableMaker {
   template <uint32_t TEventFillMap, uint32_t TTrackFillMap, uint32_t TMuonFillMap, typename TEvent, typename TTracks, typename TMuons, typename AssocTracks, typename AssocMuons>
   void fullSkimmingIndices(TEvent const& collision, aod::BCsWithTimestamps const&, TTracks const& tracksBarrel, TMuons const& tracksMuon, AssocTracks const& trackIndices, AssocMuons const& fwdtrackIndices)
   {
+    VarManager::ResetMuonPropagationCache(); // the propagations are reused within a collision only
     auto bc = collision.template bc_as<aod::BCsWithTimestamps>();
     if (fCurrentRun != bc.runNumber()) {
       if (fConfigComputeTPCpostCalib) {
@@ -942,8 +945,9 @@ struct TableMaker {
 
         // apply track cuts and fill stats histogram
         int i = 0;
+        const uint64_t cutDecisions = fTrackCutsCompiled.Evaluate(VarManager::fgValues);
         for (auto cut = fTrackCuts.begin(); cut != fTrackCuts.end(); cut++, i++) {
-          if ((*cut).IsSelected(VarManager::fgValues)) {
+          if (cutDecisions & (uint64_t(1) << i)) {
             trackTempFilterMap |= (uint8_t(1) << i);
             if (fConfigQA) {
               fHistMan->FillHistClass(Form("TrackBarrel_%s", (*cut).GetName()), VarManager::fgValues);
@@ -1050,8 +1054,9 @@ struct TableMaker {
 
         // check the cuts and filters
         int i = 0;
+        const uint64_t cutDecisions = fMuonCutsCompiled.Evaluate(VarManager::fgValues);
         for (auto cut = fMuonCuts.begin(); cut != fMuonCuts.end(); cut++, i++) {
-          if ((*cut).IsSelected(VarManager::fgValues))
+          if (cutDecisions & (uint64_t(1) << i))
             trackTempFilterMap |= (uint8_t(1) << i);
         }
 
@@ -1090,8 +1095,9 @@ struct TableMaker {
         }
         // apply the muon selection cuts and fill the stats histogram
         int i = 0;
+        const uint64_t cutDecisions = fMuonCutsCompiled.Evaluate(VarManager::fgValues);
         for (auto cut = fMuonCuts.begin(); cut != fMuonCuts.end(); cut++, i++) {
-          if ((*cut).IsSelected(VarManager::fgValues)) {
+          if (cutDecisions & (uint64_t(1) << i)) {
             trackTempFilterMap |= (uint8_t(1) << i);
             if (fConfigQA) {
               fHistMan->FillHistClass(Form("Muons_%s", (*cut).GetName()), VarManager::fgValues);
@@ -1550,6 +1556,14 @@ struct TableMaker {
         }
       }
     }
+    fAmbiguousMuonIds.clear();
+    if (fIsAmbiguous) {
+      fAmbiguousMuonIds.reserve(ambiTracksFwd.size());
+      for (auto& ambiTrackFwd : ambiTracksFwd) {
+        fAmbiguousMuonIds.push_back(ambiTrackFwd.fwdtrackId());
+      }
+      std::sort(fAmbiguousMuonIds.begin(), fAmbiguousMuonIds.end());
+    }
     for (auto& collision : collisions) {
       auto groupedMuons = tracksMuon.sliceBy(perCollisionMuons, collision.globalIndex());
       fullSkimming<gkEventFillMap, 0u, gkMuonFillMapWithCovAmbi>(collision, bcs, nullptr, groupedMuons, nullptr, ambiTracksFwd);
@@ -1570,6 +1584,14 @@ struct TableMaker {
         }
       }
     }
+    fAmbiguousTrackIds.clear();
+    if (fIsAmbiguous) {
+      fAmbiguousTrackIds.reserve(ambiTracksMid.size());
+      for (auto& ambiTrack : ambiTracksMid) {
+        fAmbiguousTrackIds.push_back(ambiTrack.trackId());
+      }
+      std::sort(fAmbiguousTrackIds.begin(), fAmbiguousTrackIds.end());
+    }
     for (auto& collision : collisions) {
       auto groupedTracks = tracksBarrel.sliceBy(perCollisionTracks, collision.globalIndex());
       fullSkimming<gkEventFillMap, gkTrackFillMapWithAmbi, 0u>(collision, bcs, groupedTracks, nullptr, ambiTracksMid, nullptr);
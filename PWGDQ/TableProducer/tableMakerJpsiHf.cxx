@@ -14,7 +14,9 @@
 /// \author Luca Micheletti <luca.micheletti@to.infn.it>, INFN
 /// \author Fabrizio Grosa <fabrizio.grosa@cern.ch>, CERN
 
+#include <array>
 #include <string>
+#include <vector>
 
 #include "Framework/AnalysisTask.h"
 #include "Framework/AnalysisDataModel.h"
@@ -111,52 +113,88 @@ struct tableMakerJpsiHf {
     fOutputList.setObject(fHistMan->GetMainHistogramList());
   }
 
-  // Template function to run pair - hadron combinations
-  // TODO: generalise to all charm-hadron species
-  template <bool withDca, bool withBdt, typename TDqTrack, typename THfTrack>
-  void runDileptonDmeson(TDqTrack const& dileptons, THfTrack const& dmesons, MyEvents::iterator const& collision)
+  // D-meson candidate of the current collision passing the selections, with the quantities used in the pairing
+  struct SelectedDmeson {
+    int64_t position;            // position of the candidate in the grouped D-meson table
+    bool isSelD0;                // selected in the D0 hypothesis
+    bool isSelD0bar;             // selected in the D0bar hypothesis
+    std::array<float, 6> scores; // BDT output scores, D0 + D0bar
+    float massD0;                // invariant mass in the D0 hypothesis, -1 if not selected as D0
+    float massD0bar;             // invariant mass in the D0bar hypothesis, -1 if not selected as D0bar
+  };
+  std::vector<SelectedDmeson> selectedDmesons; // the capacity is kept between collisions
+
+  // Select the D-meson candidates of a collision once, before the pairing with the dileptons
+  template <bool withBdt, typename THfTrack>
+  void selectDmesons(THfTrack const& dmesons)
   {
-    VarManager::ResetValues(0, VarManager::kNVars, fValuesDileptonCharmHadron);
+    selectedDmesons.clear();
+    int64_t position{-1};
+    for (auto& dmeson : dmesons) {
+      ++position;
+      if (!TESTBIT(dmeson.hfflag(), DecayType::D0ToPiK)) {
+        continue;
+      }
 
-    bool isCollSel{false};
-    if (configDebug) {
-      for (auto& dmeson : dmesons) {
-        if (!TESTBIT(dmeson.hfflag(), DecayType::D0ToPiK)) {
-          continue;
-        }
+      auto rapD0 = hfHelper.yD0(dmeson);
 
-        std::array<float, 6> scores = {999., -999., -999., 999., -999., -999.}; // D0 + D0bar
-        if constexpr (withBdt) {
-          if (dmeson.mlProbD0().size() == 3) {
-            for (auto iScore{0u}; iScore < dmeson.mlProbD0().size(); ++iScore) {
-              scores[iScore] = dmeson.mlProbD0()[iScore];
-            }
-          }
-          if (dmeson.mlProbD0bar().size() == 3) {
-            for (auto iScore{0u}; iScore < dmeson.mlProbD0bar().size(); ++iScore) {
-              scores[iScore + 3] = dmeson.mlProbD0bar()[iScore];
-            }
-          }
-        }
+      if (yCandDmesonMax >= 0. && std::abs(rapD0) > yCandDmesonMax) {
+        continue;
+      }
 
-        auto rapD0 = hfHelper.yD0(dmeson);
+      if (dmeson.isSelD0() < 1 && dmeson.isSelD0bar() < 1) {
+        continue;
+      }
 
-        if (yCandDmesonMax >= 0. && std::abs(rapD0) > yCandDmesonMax) {
-          continue;
+      auto& selected = selectedDmesons.emplace_back();
+      selected.position = position;
+      selected.isSelD0 = dmeson.isSelD0() >= 1;
+      selected.isSelD0bar = dmeson.isSelD0bar() >= 1;
+      selected.scores = {999., -999., -999., 999., -999., -999.}; // D0 + D0bar
+      if constexpr (withBdt) {
+        if (dmeson.mlProbD0().size() == 3) {
+          for (auto iScore{0u}; iScore < dmeson.mlProbD0().size(); ++iScore) {
+            selected.scores[iScore] = dmeson.mlProbD0()[iScore];
+          }
+        }
+        if (dmeson.mlProbD0bar().size() == 3) {
+          for (auto iScore{0u}; iScore < dmeson.mlProbD0bar().size(); ++iScore) {
+            selected.scores[iScore + 3] = dmeson.mlProbD0bar()[iScore];
+          }
         }
+      }
+      selected.massD0 = selected.isSelD0 ? hfHelper.invMassD0ToPiK(dmeson) : -1.f;
+      selected.massD0bar = selected.isSelD0bar ? hfHelper.invMassD0barToKPi(dmeson) : -1.f;
 
-        if (dmeson.isSelD0() >= 1) {
-          VarManager::FillSingleDileptonCharmHadron<VarManager::kD0ToPiK>(dmeson, hfHelper, scores[0], fValuesDileptonCharmHadron);
+      if (configDebug) {
+        if (selected.isSelD0) {
+          VarManager::FillSingleDileptonCharmHadron<VarManager::kD0ToPiK>(dmeson, hfHelper, selected.scores[0], fValuesDileptonCharmHadron);
           fHistMan->FillHistClass("Dmeson", fValuesDileptonCharmHadron);
           VarManager::ResetValues(0, VarManager::kNVars, fValuesDileptonCharmHadron);
         }
-        if (dmeson.isSelD0bar() >= 1) {
-          VarManager::FillSingleDileptonCharmHadron<VarManager::kD0barToKPi>(dmeson, hfHelper, scores[3], fValuesDileptonCharmHadron);
+        if (selected.isSelD0bar) {
+          VarManager::FillSingleDileptonCharmHadron<VarManager::kD0barToKPi>(dmeson, hfHelper, selected.scores[3], fValuesDileptonCharmHadron);
           fHistMan->FillHistClass("Dmeson", fValuesDileptonCharmHadron);
           VarManager::ResetValues(0, VarManager::kNVars, fValuesDileptonCharmHadron);
         }
       }
     }
+  }
+
+  // Template function to run pair - hadron combinations
+  // TODO: generalise to all charm-hadron species
+  template <bool withDca, bool withBdt, typename TDqTrack, typename THfTrack>
+  void runDileptonDmeson(TDqTrack const& dileptons, THfTrack const& dmesons, MyEvents::iterator const& collision)
+  {
+    VarManager::ResetValues(0, VarManager::kNVars, fValuesDileptonCharmHadron);
+
+    selectDmesons<withBdt>(dmesons);
+    // without selected D mesons only the debug histograms of the dileptons are filled
+    if (selectedDmesons.empty() && !configDebug) {
+      return;
+    }
+
+    bool isCollSel{false};
 
     // loop over dileptons
     for (auto dilepton : dileptons) {
@@ -174,65 +212,48 @@ struct tableMakerJpsiHf {
         VarManager::ResetValues(0, VarManager::kNVars, fValuesDileptonCharmHadron);
       }
 
-      // loop over D mesons
+      // loop over D mesons, visiting only the selected ones, which are stored in the order of the grouped table
+      auto iSelected = selectedDmesons.begin();
+      int64_t position{-1};
       for (auto& dmeson : dmesons) {
-        if (!TESTBIT(dmeson.hfflag(), DecayType::D0ToPiK)) {
-          continue;
+        if (iSelected == selectedDmesons.end()) {
+          break;
         }
-
-        auto rapD0 = hfHelper.yD0(dmeson);
-
-        if (yCandDmesonMax >= 0. && std::abs(rapD0) > yCandDmesonMax) {
+        if (++position != iSelected->position) {
           continue;
         }
+        const auto& selected = *(iSelected++);
 
-        auto massD0 = -1.;
-        auto massD0bar = -1.;
-
-        if (dmeson.isSelD0() >= 1 || dmeson.isSelD0bar() >= 1) {
-          if (!isCollSel) {
-            redCollisions(collision.posX(), collision.posY(), collision.posZ(), collision.numContrib());
-            isCollSel = true;
-          }
-          auto indexRed = redCollisions.lastIndex();
-          if (!isJPsiFilled) {
-            if constexpr (withDca) {
-              redDileptons(indexRed, dilepton.px(), dilepton.py(), dilepton.pz(), dilepton.mass(), dilepton.sign(), dilepton.mcDecision(), dilepton.tauz(), dilepton.lz(), dilepton.lxy());
-            } else {
-              redDileptons(indexRed, dilepton.px(), dilepton.py(), dilepton.pz(), dilepton.mass(), dilepton.sign(), dilepton.mcDecision(), 0, 0, 0);
-            }
-            isJPsiFilled = true;
-          }
-          redDmesons(indexRed, dmeson.px(), dmeson.py(), dmeson.pz(), dmeson.xSecondaryVertex(), dmeson.ySecondaryVertex(), dmeson.zSecondaryVertex(), 0, 0);
-          std::array<float, 6> scores = {999., -999., -999., 999., -999., -999.}; // D0 + D0bar
-          if constexpr (withBdt) {
-            if (dmeson.mlProbD0().size() == 3) {
-              for (auto iScore{0u}; iScore < dmeson.mlProbD0().size(); ++iScore) {
-                scores[iScore] = dmeson.mlProbD0()[iScore];
-              }
-            }
-            if (dmeson.mlProbD0bar().size() == 3) {
-              for (auto iScore{0u}; iScore < dmeson.mlProbD0bar().size(); ++iScore) {
-                scores[iScore + 3] = dmeson.mlProbD0bar()[iScore];
-              }
-            }
-            redDmesBdts(scores[0], scores[1], scores[2], scores[3], scores[4], scores[5]);
+        if (!isCollSel) {
+          redCollisions(collision.posX(), collision.posY(), collision.posZ(), collision.numContrib());
+          isCollSel = true;
+        }
+        auto indexRed = redCollisions.lastIndex();
+        if (!isJPsiFilled) {
+          if constexpr (withDca) {
+            redDileptons(indexRed, dilepton.px(), dilepton.py(), dilepton.pz(), dilepton.mass(), dilepton.sign(), dilepton.mcDecision(), dilepton.tauz(), dilepton.lz(), dilepton.lxy());
+          } else {
+            redDileptons(indexRed, dilepton.px(), dilepton.py(), dilepton.pz(), dilepton.mass(), dilepton.sign(), dilepton.mcDecision(), 0, 0, 0);
           }
+          isJPsiFilled = true;
+        }
+        redDmesons(indexRed, dmeson.px(), dmeson.py(), dmeson.pz(), dmeson.xSecondaryVertex(), dmeson.ySecondaryVertex(), dmeson.zSecondaryVertex(), 0, 0);
+        const auto& scores = selected.scores;
+        if constexpr (withBdt) {
+          redDmesBdts(scores[0], scores[1], scores[2], scores[3], scores[4], scores[5]);
+        }
 
-          if (dmeson.isSelD0() >= 1) {
-            massD0 = hfHelper.invMassD0ToPiK(dmeson);
-            VarManager::FillDileptonCharmHadron<VarManager::kD0ToPiK>(dilepton, dmeson, hfHelper, scores[0], fValuesDileptonCharmHadron);
-            fHistMan->FillHistClass("JPsiDmeson", fValuesDileptonCharmHadron);
-            VarManager::ResetValues(0, VarManager::kNVars, fValuesDileptonCharmHadron);
-          }
-          if (dmeson.isSelD0bar() >= 1) {
-            massD0bar = hfHelper.invMassD0barToKPi(dmeson);
-            VarManager::FillDileptonCharmHadron<VarManager::kD0barToKPi>(dilepton, dmeson, hfHelper, scores[3], fValuesDileptonCharmHadron);
-            fHistMan->FillHistClass("JPsiDmeson", fValuesDileptonCharmHadron);
-            VarManager::ResetValues(0, VarManager::kNVars, fValuesDileptonCharmHadron);
-          }
-          redD0Masses(massD0, massD0bar);
+        if (selected.isSelD0) {
+          VarManager::FillDileptonCharmHadron<VarManager::kD0ToPiK>(dilepton, dmeson, hfHelper, scores[0], fValuesDileptonCharmHadron);
+          fHistMan->FillHistClass("JPsiDmeson", fValuesDileptonCharmHadron);
+          VarManager::ResetValues(0, VarManager::kNVars, fValuesDileptonCharmHadron);
+        }
+        if (selected.isSelD0bar) {
+          VarManager::FillDileptonCharmHadron<VarManager::kD0barToKPi>(dilepton, dmeson, hfHelper, scores[3], fValuesDileptonCharmHadron);
+          fHistMan->FillHistClass("JPsiDmeson", fValuesDileptonCharmHadron);
+          VarManager::ResetValues(0, VarManager::kNVars, fValuesDileptonCharmHadron);
         }
+        redD0Masses(selected.massD0, selected.massD0bar);
       }
     }
   }
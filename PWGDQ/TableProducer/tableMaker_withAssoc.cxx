@@ -228,7 +228,7 @@ struct TableMaker {
 
   // maps used to store index info; NOTE: std::map are sorted in ascending order by default (needed for track to collision indices)
   std::map<uint32_t, uint32_t> fCollIndexMap;             // key: old collision index, value: skimmed collision index
-  std::map<uint32_t, uint32_t> fTrackIndexMap;            // key: old track global index, value: new track global index
+  std::vector<int> fTrackIndexMap;                        // index: old track global index, value: new track global index (-1 if not skimmed)
   std::map<uint32_t, uint32_t> fFwdTrackIndexMap;         // key: fwd-track global index, value: new fwd-track global index
   std::map<uint32_t, uint32_t> fFwdTrackIndexMapReversed; // key: new fwd-track global index, value: fwd-track global index
   std::map<uint32_t, uint8_t> fFwdTrackFilterMap;         // key: fwd-track global index, value: fwd-track filter map
@@ -678,7 +678,7 @@ struct TableMaker {
       }
 
       // write the track global index in the map for skimming (to make sure we have it just once)
-      if (fTrackIndexMap.find(track.globalIndex()) == fTrackIndexMap.end()) {
+      if (fTrackIndexMap[track.globalIndex()] < 0) {
         // NOTE: The collision ID that is written in the table is the one found in the first association for this track.
         //       However, in data analysis one should loop over associations, so this one should not be used.
         //      In the case of Run2-like analysis, there will be no associations, so this ID will be the one originally assigned in the AO2Ds (updated for the skims)
@@ -900,7 +900,7 @@ struct TableMaker {
     }
 
     if constexpr (static_cast<bool>(TTrackFillMap)) {
-      fTrackIndexMap.clear();
+      fTrackIndexMap.assign(tracksBarrel.size(), -1);
       trackBasic.reserve(tracksBarrel.size());
       trackBarrel.reserve(tracksBarrel.size());
       trackBarrelInfo.reserve(tracksBarrel.size());
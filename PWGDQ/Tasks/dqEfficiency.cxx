@@ -527,6 +527,7 @@ struct AnalysisSameEventPairing {
   std::vector<std::vector<TString>> fBarrelMuonHistNamesMCmatched;
   std::vector<MCSignal> fRecMCSignals;
   std::vector<MCSignal> fGenMCSignals;
+  MCAncestryCache fMCAncestryCache; // history of the MC particles of the current event, used to check the generated signals
 
   void init(o2::framework::InitContext& context)
   {
@@ -873,6 +874,14 @@ struct AnalysisSameEventPairing {
     // loop over mc stack and fill histograms for pure MC truth signals
     // group all the MC tracks which belong to the MC event corresponding to the current reconstructed event
     // auto groupedMCTracks = tracksMC.sliceBy(aod::reducedtrackMC::reducedMCeventId, event.reducedMCevent().globalIndex());
+    // the history of all the MC particles of the event is cached once and the signals are checked on the cache,
+    //   unless some mother or daughter is outside of this event
+    bool useCache = false;
+    if constexpr (!soa::is_soa_filtered_v<TTracksMC>) {
+      fMCAncestryCache.Build(groupedMCTracks);
+      useCache = fMCAncestryCache.IsComplete();
+    }
+    int position = 0;
     for (auto& mctrack : groupedMCTracks) {
       VarManager::FillTrackMC(groupedMCTracks, mctrack);
       // NOTE: Signals are checked here mostly based on the skimmed MC stack, so depending on the requested signal, the stack could be incomplete.
@@ -883,7 +892,9 @@ struct AnalysisSameEventPairing {
           continue;
         }
         bool checked = false;
-        if constexpr (soa::is_soa_filtered_v<TTracksMC>) {
+        if (useCache) {
+          checked = sig.CheckSignal(fMCAncestryCache, false, position);
+        } else if constexpr (soa::is_soa_filtered_v<TTracksMC>) {
           auto mctrack_raw = groupedMCTracks.rawIteratorAt(mctrack.globalIndex());
           checked = sig.CheckSignal(false, mctrack_raw);
         } else {
@@ -893,6 +904,7 @@ struct AnalysisSameEventPairing {
           fHistMan->FillHistClass(Form("MCTruthGen_%s", sig.GetName()), VarManager::fgValues);
         }
       }
+      position++;
     }
 
     //    // loop over mc stack and fill histograms for pure MC truth signals
@@ -902,7 +914,9 @@ struct AnalysisSameEventPairing {
       }
       for (auto& [t1, t2] : combinations(groupedMCTracks, groupedMCTracks)) {
         bool checked = false;
-        if constexpr (soa::is_soa_filtered_v<TTracksMC>) {
+        if (useCache) {
+          checked = sig.CheckSignal(fMCAncestryCache, false, fMCAncestryCache.GetPosition(t1.globalIndex()), fMCAncestryCache.GetPosition(t2.globalIndex()));
+        } else if constexpr (soa::is_soa_filtered_v<TTracksMC>) {
           auto t1_raw = groupedMCTracks.rawIteratorAt(t1.globalIndex());
           auto t2_raw = groupedMCTracks.rawIteratorAt(t2.globalIndex());
           checked = sig.CheckSignal(false, t1_raw, t2_raw);
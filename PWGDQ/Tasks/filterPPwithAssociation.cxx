@@ -427,6 +427,7 @@ struct DQMuonsSelection {
 
   void processSelection(Collisions const& collisions, BCsWithTimestamps const& bcstimestamps, MyMuons const& muons, aod::FwdTrackAssoc const& muonAssocs)
   {
+    VarManager::ResetMuonPropagationCache(); // the cache is keyed by the global indices of this dataframe
     for (auto& collision : collisions) {
       auto muonIdsThisCollision = muonAssocs.sliceBy(fwdtrackIndicesPerCollision, collision.globalIndex());
       runMuonSelection<gkMuonFillMap>(collision, bcstimestamps, muons, muonIdsThisCollision);
@@ -612,6 +613,8 @@ struct DQFilterPPTask {
       if (!o2::base::GeometryManager::isGeometryLoaded()) {
         fCCDB->get<TGeoManager>(geoPath);
       }
+      // the muons are propagated again for each pair they enter, keep the extrapolations
+      VarManager::SetUseMuonPropagationCache(true);
     }
     DefineCuts();
 
@@ -829,6 +832,7 @@ struct DQFilterPPTask {
   {
     fFiltersMap.clear();
     fCEFPfilters.clear();
+    VarManager::ResetMuonPropagationCache(); // the cache is keyed by the global indices of this dataframe
 
     cout << "------------------- filterPP, n assocs barrel/muon :: " << trackAssocs.size() << " / " << muonAssocs.size() << endl;
 
@@ -14,6 +14,10 @@
 /// \author Daniel Samitz, <daniel.samitz@cern.ch>, SMI Vienna
 ///         Elisa Meninno, <elisa.meninno@cern.ch>, SMI Vienna
 
+#include <numeric>
+#include <utility>
+#include <vector>
+
 #include "Framework/AnalysisTask.h"
 #include "Framework/runDataProcessing.h"
 #include "Common/DataModel/TrackSelectionTables.h"
@@ -286,6 +290,13 @@ struct DielectronMlPair {
 
   HistogramRegistry registry{"registry", {}};
 
+  std::vector<o2::analysis::DielectronPairLeg> legs; // legs of the tracks of the dataframe
+  std::vector<std::pair<int64_t, int64_t>> pairLegs; // legs of the opposite-sign pairs
+  std::vector<double> pairMasses;                    // masses of the opposite-sign pairs
+  std::vector<std::size_t> pairIndices;              // 0, ..., number of opposite-sign pairs - 1
+  std::vector<bool> isSelectedPairs;                 // ML selections of the opposite-sign pairs
+  std::vector<std::vector<float>> outputsMlPairs;    // ML scores of the opposite-sign pairs
+
   void init(InitContext&)
   {
     if (doprocessPair) {
@@ -309,30 +320,44 @@ struct DielectronMlPair {
     }
   }
 
-  void processPair(DielectronsExtra const& dielectrons, MySkimmedTracks const&)
+  void processPair(DielectronsExtra const& dielectrons, MySkimmedTracks const& tracks)
   {
     // dummy value for magentic field. ToDo: take it from ccdb!
     float d_bz = 1.;
     mlResponse.setBz(d_bz);
+
+    // the legs are read once per track, and the pairs of the dataframe are scored in one batched call
+    legs.clear();
+    for (const auto& track : tracks) {
+      legs.emplace_back(track);
+    }
+    pairLegs.clear();
+    pairMasses.clear();
     for (const auto& dielectron : dielectrons) {
-      const auto& track1 = dielectron.index0_as<MySkimmedTracks>();
-      const auto& track2 = dielectron.index1_as<MySkimmedTracks>();
-      if (track1.sign() == track2.sign()) {
+      const auto& leg1 = legs[dielectron.index0Id()];
+      const auto& leg2 = legs[dielectron.index1Id()];
+      if (leg1.sign() == leg2.sign()) {
         continue;
       }
-      ROOT::Math::PtEtaPhiMVector v1(track1.pt(), track1.eta(), track1.phi(), o2::constants::physics::MassElectron);
-      ROOT::Math::PtEtaPhiMVector v2(track2.pt(), track2.eta(), track2.phi(), o2::constants::physics::MassElectron);
-      ROOT::Math::PtEtaPhiMVector v12 = v1 + v2;
-      auto m = v12.M();
-      std::vector<float> inputFeatures = mlResponse.getInputFeatures(track1, track2);
-      std::vector<float> outputMl = {};
-
-      bool isSelected = mlResponse.isSelectedMl(inputFeatures, m, outputMl);
-      for (int classMl = 0; classMl < nClassesMl; classMl++) {
-        hModelScore[classMl]->Fill(outputMl[classMl]);
-        hModelScoreVsM[classMl]->Fill(outputMl[classMl], m);
+      pairLegs.emplace_back(dielectron.index0Id(), dielectron.index1Id());
+      pairMasses.emplace_back((mlResponse.fourMomentum(leg1) + mlResponse.fourMomentum(leg2)).M());
+    }
+    pairIndices.resize(pairLegs.size());
+    std::iota(pairIndices.begin(), pairIndices.end(), 0);
+
+    auto getM = [this](std::size_t iPair) { return pairMasses[iPair]; };
+    auto fillInputFeatures = [this](std::size_t iPair, float* inputFeatures) { mlResponse.fillInputFeatures(legs[pairLegs[iPair].first], legs[pairLegs[iPair].second], inputFeatures); };
+    mlResponse.isSelectedMlFill(pairIndices, getM, mlResponse.getNInputFeatures(), fillInputFeatures, isSelectedPairs, outputsMlPairs);
+
+    for (std::size_t iPair = 0; iPair < pairLegs.size(); iPair++) {
+      const auto& outputMl = outputsMlPairs[iPair];
+      if (!outputMl.empty()) { // empty for the pairs outside the mass bins of the models
+        for (int classMl = 0; classMl < nClassesMl; classMl++) {
+          hModelScore[classMl]->Fill(outputMl[classMl]);
+          hModelScoreVsM[classMl]->Fill(outputMl[classMl], pairMasses[iPair]);
+        }
       }
-      pairSelection(isSelected);
+      pairSelection(isSelectedPairs[iPair]);
       if (fillScoreTable) {
         pairScore(outputMl);
       }
@@ -63,7 +63,7 @@ DECLARE_SOA_TABLE(HfTable, "AOD", "HFTABLE",
 const char* stageNames[3] = {"gen", "eff", "eff_and_acc"};
 
 template <typename T>
-void doSingle(T& p, std::vector<std::shared_ptr<TH1>> hEta, std::vector<std::shared_ptr<TH1>> hPt, std::vector<std::shared_ptr<TH2>> hPtEta, float ptMin, float etaMax)
+void doSingle(T& p, std::vector<std::shared_ptr<TH1>> const& hEta, std::vector<std::shared_ptr<TH1>> const& hPt, std::vector<std::shared_ptr<TH2>> const& hPtEta, float ptMin, float etaMax)
 {
   float weight[3] = {p.weight(), p.efficiency() * p.weight(), p.efficiency() * p.weight()};
   float pt[3] = {p.pt(), p.ptSmeared(), p.ptSmeared()};
@@ -79,8 +79,16 @@ void doSingle(T& p, std::vector<std::shared_ptr<TH1>> hEta, std::vector<std::sha
   }
 }
 
+// pair quantities at the three stages, evaluated once per pair and filled in any number of histogram sets
+struct eePairStages {
+  double mass[3];
+  double pt[3];
+  float weight[3];
+  bool isAccepted[3];
+};
+
 template <typename T>
-void doPair(T& p1, T& p2, std::vector<std::shared_ptr<TH1>> hMee, std::vector<std::shared_ptr<TH2>> hMeePtee, float ptMin, float etaMax)
+eePairStages getPairStages(T& p1, T& p2, float ptMin, float etaMax)
 {
 
   ROOT::Math::PtEtaPhiMVector v1(p1.ptSmeared(), p1.etaSmeared(), p1.phiSmeared(), o2::constants::physics::MassElectron);
@@ -90,20 +98,29 @@ void doPair(T& p1, T& p2, std::vector<std::shared_ptr<TH1>> hMee, std::vector<st
   ROOT::Math::PtEtaPhiMVector v2_gen(p2.pt(), p2.eta(), p2.phi(), o2::constants::physics::MassElectron);
   ROOT::Math::PtEtaPhiMVector v12_gen = v1_gen + v2_gen;
 
-  double mass[3] = {v12_gen.M(), v12.M(), v12.M()};
-  double pt[3] = {v12_gen.Pt(), v12.Pt(), v12.Pt()};
+  const double mass = v12.M();
+  const double pt = v12.Pt();
+  const float weight = p1.efficiency() * p2.efficiency() * p1.weight() * p2.weight();
+  eePairStages pair{{v12_gen.M(), mass, mass}, {v12_gen.Pt(), pt, pt}, {p1.weight() * p2.weight(), weight, weight}, {}};
   float pt1[3] = {p1.pt(), p1.ptSmeared(), p1.ptSmeared()};
   float pt2[3] = {p2.pt(), p2.ptSmeared(), p2.ptSmeared()};
   float eta1[3] = {p1.eta(), p1.etaSmeared(), p1.etaSmeared()};
   float eta2[3] = {p2.eta(), p2.etaSmeared(), p2.etaSmeared()};
-  float weight[3] = {p1.weight() * p2.weight(), p1.efficiency() * p2.efficiency() * p1.weight() * p2.weight(), p1.efficiency() * p2.efficiency() * p1.weight() * p2.weight()};
   float cut_pt[3] = {0., 0., ptMin};
   float cut_eta[3] = {9999., 99999., etaMax};
 
   for (int i = 0; i < 3; i++) {
-    if (pt1[i] > cut_pt[i] && pt2[i] > cut_pt[i] && abs(eta1[i]) < cut_eta[i] && abs(eta2[i]) < cut_eta[i]) {
-      hMee[i]->Fill(mass[i], weight[i]);
-      hMeePtee[i]->Fill(mass[i], pt[i], weight[i]);
+    pair.isAccepted[i] = pt1[i] > cut_pt[i] && pt2[i] > cut_pt[i] && abs(eta1[i]) < cut_eta[i] && abs(eta2[i]) < cut_eta[i];
+  }
+  return pair;
+}
+
+void fillPair(eePairStages const& pair, std::vector<std::shared_ptr<TH1>> const& hMee, std::vector<std::shared_ptr<TH2>> const& hMeePtee)
+{
+  for (int i = 0; i < 3; i++) {
+    if (pair.isAccepted[i]) {
+      hMee[i]->Fill(pair.mass[i], pair.weight[i]);
+      hMeePtee[i]->Fill(pair.mass[i], pair.pt[i], pair.weight[i]);
     }
   }
 }
@@ -280,8 +297,9 @@ struct lmeehfcocktailbeauty {
         if ((type < static_cast<int>(EM_HFeeType::kBe_Be)) || (type > static_cast<int>(EM_HFeeType::kBCe_Be_SameB))) {
           LOG(error) << "Something is wrong here. There should only be pairs of type kBe_Be = 1, kBCe_BCe = 2 and kBCe_Be_SameB = 3 left at this point.";
         }
-        doPair(particle1, particle2, hULS_Mee[type - 1], hULS_MeePtee[type - 1], myConfigs.fConfigPtMin, myConfigs.fConfigEtaMax);
-        doPair(particle1, particle2, hULS_Mee[3], hULS_MeePtee[3], myConfigs.fConfigPtMin, myConfigs.fConfigEtaMax); // fill the 'allB' histograms that holds the sum of the others
+        const auto pair = getPairStages(particle1, particle2, myConfigs.fConfigPtMin, myConfigs.fConfigEtaMax);
+        fillPair(pair, hULS_Mee[type - 1], hULS_MeePtee[type - 1]);
+        fillPair(pair, hULS_Mee[3], hULS_MeePtee[3]); // fill the 'allB' histograms that holds the sum of the others
       }
       // LS spectrum
       for (auto const& [particle1, particle2] : combinations(o2::soa::CombinationsStrictlyUpperIndexPolicy(electronsGrouped, electronsGrouped))) {
@@ -297,7 +315,7 @@ struct lmeehfcocktailbeauty {
             LOG(error) << "Something is wrong here. There should only be pairs of type kBCe_Be_DiffB = 4 left at this point.";
           }
         }
-        doPair(particle1, particle2, hLSmm_Mee, hLSmm_MeePtee, myConfigs.fConfigPtMin, myConfigs.fConfigEtaMax);
+        fillPair(getPairStages(particle1, particle2, myConfigs.fConfigPtMin, myConfigs.fConfigEtaMax), hLSmm_Mee, hLSmm_MeePtee);
       }
       for (auto const& [particle1, particle2] : combinations(o2::soa::CombinationsStrictlyUpperIndexPolicy(positronsGrouped, positronsGrouped))) {
         if (myConfigs.fConfigCheckPartonic) {
@@ -312,7 +330,7 @@ struct lmeehfcocktailbeauty {
             LOG(error) << "Something is wrong here. There should only be pairs of type kBCe_Be_DiffB = 4 left at this point.";
           }
         }
-        doPair(particle1, particle2, hLSpp_Mee, hLSpp_MeePtee, myConfigs.fConfigPtMin, myConfigs.fConfigEtaMax);
+        fillPair(getPairStages(particle1, particle2, myConfigs.fConfigPtMin, myConfigs.fConfigEtaMax), hLSpp_Mee, hLSpp_MeePtee);
       }
     }
   }
@@ -399,7 +417,7 @@ struct lmeehfcocktailcharm {
         if (IsHF(particle1, particle2, mcParticlesAll) != static_cast<int>(EM_HFeeType::kCe_Ce)) {
           LOG(error) << "Something is wrong here. There should only be pairs of type kCe_Ce = 0 left at this point.";
         }
-        doPair(particle1, particle2, hULS_Mee, hULS_MeePtee, myConfigs.fConfigPtMin, myConfigs.fConfigEtaMax);
+        fillPair(getPairStages(particle1, particle2, myConfigs.fConfigPtMin, myConfigs.fConfigEtaMax), hULS_Mee, hULS_MeePtee);
       }
       // LS
       for (auto const& [particle1, particle2] : combinations(o2::soa::CombinationsStrictlyUpperIndexPolicy(electronsGrouped, electronsGrouped))) {
@@ -407,14 +425,14 @@ struct lmeehfcocktailcharm {
           if (particle1.cQuarkOriginId() < 0 || particle2.cQuarkOriginId() < 0 || particle1.cQuarkOriginId() != particle2.cQuarkOriginId())
             continue;
         }
-        doPair(particle1, particle2, hLS_Mee, hLS_MeePtee, myConfigs.fConfigPtMin, myConfigs.fConfigEtaMax);
+        fillPair(getPairStages(particle1, particle2, myConfigs.fConfigPtMin, myConfigs.fConfigEtaMax), hLS_Mee, hLS_MeePtee);
       }
       for (auto const& [particle1, particle2] : combinations(o2::soa::CombinationsStrictlyUpperIndexPolicy(positronsGrouped, positronsGrouped))) {
         if (myConfigs.fConfigCheckPartonic) {
           if (particle1.cQuarkOriginId() < 0 || particle2.cQuarkOriginId() < 0 || particle1.cQuarkOriginId() != particle2.cQuarkOriginId())
             continue;
         }
-        doPair(particle1, particle2, hLS_Mee, hLS_MeePtee, myConfigs.fConfigPtMin, myConfigs.fConfigEtaMax);
+        fillPair(getPairStages(particle1, particle2, myConfigs.fConfigPtMin, myConfigs.fConfigEtaMax), hLS_Mee, hLS_MeePtee);
       }
     }
   }
@@ -87,6 +87,15 @@ struct eeTTree {
   float feerap;     // only in histogram, not in tree?
 };
 
+// generated electron of the LS and ULS pairing, with the single-electron quantities evaluated once
+struct eeBuffElectron {
+  PxPyPzEVector e;
+  XYZVector unit;    // direction of the momentum, for the opening angle
+  Char_t ch;
+  Double_t weight;
+  bool inAcceptance; // pt and eta cuts
+};
+
 struct lmeelfcocktail {
   OutputObj<TTree> tree{"eeTTree"};
 
@@ -114,6 +123,8 @@ struct lmeelfcocktail {
 
   Double_t eMass;
 
+  std::vector<eeBuffElectron> eBuff; // electrons of the event for the LS and ULS pairing
+
   Configurable<int> fCollisionSystem{"cfgCollisionSystem", 200, "set the collision system"};
   Configurable<bool> fConfigWriteTTree{"cfgWriteTTree", false, "write tree output"};
   Configurable<bool> fConfigDoPairing{"cfgDoPairing", true, "do like and unlike sign pairing"};
@@ -190,15 +201,14 @@ struct lmeelfcocktail {
   {
     // get number of events per timeframe
     auto Nparts = pc.inputs().getNofParts(0);
+    const Double_t cosMinOpAng = TMath::Cos(fConfigMinOpAng);
 
     for (auto i = 0U; i < Nparts; ++i) {
       registry.fill(HIST("NEvents"), 0.5);
       // get the tracks
       auto mctracks = pc.inputs().get<std::vector<o2::MCTrack>>("mctracks", i);
 
-      std::vector<PxPyPzEVector> eBuff;
-      std::vector<Char_t> echBuff;
-      std::vector<Double_t> eweightBuff;
+      eBuff.clear();
 
       bool skipNext = false;
 
@@ -213,42 +223,46 @@ struct lmeelfcocktail {
           //---------------
           if (fConfigDoPairing) {
             // LS and ULS spectra
-            PxPyPzEVector e, dielectron;
-            Char_t ech, dielectron_ch;
-            Double_t eweight, dielectron_weight;
-            e.SetPxPyPzE(mctrack.Px(), mctrack.Py(), mctrack.Pz(),
-                         mctrack.GetEnergy());
+            PxPyPzEVector dielectron;
+            Char_t dielectron_ch;
+            Double_t dielectron_weight;
+            eeBuffElectron ele;
+            ele.e.SetPxPyPzE(mctrack.Px(), mctrack.Py(), mctrack.Pz(),
+                             mctrack.GetEnergy());
             if (mctrack.GetPdgCode() > 0) {
-              ech = 1.;
+              ele.ch = 1.;
             } else {
-              ech = -1.;
+              ele.ch = -1.;
             }
-            eweight = mctrack.getWeight();
+            ele.weight = mctrack.getWeight();
+            ele.unit = ele.e.Vect().Unit();
+            ele.inAcceptance = ele.e.Pt() > fConfigMinPt && ele.e.Pt() < fConfigMaxPt && TMath::Abs(ele.e.Eta()) < fConfigMaxEta;
             // put in the buffer
             //-----------------
-            eBuff.push_back(e);
-            echBuff.push_back(ech);
-            eweightBuff.push_back(eweight);
+            eBuff.push_back(ele);
             // loop the buffer and pair
             //------------------------
             for (Int_t jj = eBuff.size() - 2; jj >= 0; jj--) {
-              dielectron = eBuff.at(jj) + e;
-              dielectron_ch = (echBuff.at(jj) + ech) / 2;
-              dielectron_weight = eweightBuff.at(jj) * eweight;
+              const auto& other = eBuff[jj];
+              dielectron = other.e + ele.e;
+              dielectron_ch = (other.ch + ele.ch) / 2;
+              dielectron_weight = other.weight * ele.weight;
+              const Double_t mee = dielectron.M();
+              const Double_t ptee = dielectron.Pt();
 
               if (dielectron_ch == 0)
-                registry.fill(HIST("ULS_orig"), dielectron.M(), dielectron.Pt(), dielectron_weight);
+                registry.fill(HIST("ULS_orig"), mee, ptee, dielectron_weight);
               if (dielectron_ch > 0)
-                registry.fill(HIST("LSpp_orig"), dielectron.M(), dielectron.Pt(), dielectron_weight);
+                registry.fill(HIST("LSpp_orig"), mee, ptee, dielectron_weight);
               if (dielectron_ch < 0)
-                registry.fill(HIST("LSmm_orig"), dielectron.M(), dielectron.Pt(), dielectron_weight);
-              if (e.Pt() > fConfigMinPt && eBuff.at(jj).Pt() > fConfigMinPt && e.Pt() < fConfigMaxPt && eBuff.at(jj).Pt() < fConfigMaxPt && TMath::Abs(e.Eta()) < fConfigMaxEta && TMath::Abs(eBuff.at(jj).Eta()) < fConfigMaxEta && e.Vect().Unit().Dot(eBuff.at(jj).Vect().Unit()) < TMath::Cos(fConfigMinOpAng)) {
+                registry.fill(HIST("LSmm_orig"), mee, ptee, dielectron_weight);
+              if (ele.inAcceptance && other.inAcceptance && ele.unit.Dot(other.unit) < cosMinOpAng) {
                 if (dielectron_ch == 0)
-                  registry.fill(HIST("ULS"), dielectron.M(), dielectron.Pt(), dielectron_weight);
+                  registry.fill(HIST("ULS"), mee, ptee, dielectron_weight);
                 if (dielectron_ch > 0)
-                  registry.fill(HIST("LSpp"), dielectron.M(), dielectron.Pt(), dielectron_weight);
+                  registry.fill(HIST("LSpp"), mee, ptee, dielectron_weight);
                 if (dielectron_ch < 0)
-                  registry.fill(HIST("LSmm"), dielectron.M(), dielectron.Pt(), dielectron_weight);
+                  registry.fill(HIST("LSmm"), mee, ptee, dielectron_weight);
               }
             }
           }
@@ -22,6 +22,7 @@
 #include <vector>
 
 #include "Math/Vector4D.h"
+#include "CommonConstants/PhysicsConstants.h"
 #include "Tools/ML/MlResponse.h"
 
 // Fill the map of available input features
@@ -34,21 +35,21 @@
 
 // Check if the index of mCachedIndices (index associated to a FEATURE)
 // matches the entry in EnumInputFeatures associated to this FEATURE
-// if so, the inputFeatures vector is filled with the FEATURE's value
+// if so, the inputFeatures buffer is filled with the FEATURE's value
 // by calling the corresponding GETTER from pair fourmomentum v12
 #define CHECK_AND_FILL_VEC_DIELECTRON_PAIR(FEATURE, GETTER)          \
   case static_cast<uint8_t>(InputFeaturesDielectronPair::FEATURE): { \
-    inputFeatures.emplace_back(v12.GETTER());                        \
+    inputFeatures[iFeature] = v12.GETTER();                          \
     break;                                                           \
   }
 
 // Check if the index of mCachedIndices (index associated to a FEATURE)
 // matches the entry in EnumInputFeatures associated to this FEATURE
-// if so, the inputFeatures vector is filled with the FEATURE's value
+// if so, the inputFeatures buffer is filled with the FEATURE's value
 // by calling the corresponding FUNCTION on the tracks t1 and t2
 #define CHECK_AND_FILL_VEC_DIELECTRON_PAIR_FUNC(FEATURE, FUNCTION)   \
   case static_cast<uint8_t>(InputFeaturesDielectronPair::FEATURE): { \
-    inputFeatures.emplace_back(FUNCTION(t1, t2));                    \
+    inputFeatures[iFeature] = FUNCTION(t1, t2);                      \
     break;                                                           \
   }
 
@@ -65,6 +66,39 @@ enum class InputFeaturesDielectronPair : uint8_t {
   pairDcaZ
 };
 
+/// Quantities of a leg used by the pair features, read once per track and shared by all the pairs the leg enters.
+/// The accessors have the names of the track columns, so that the feature functions take legs or tracks alike.
+class DielectronPairLeg
+{
+ public:
+  DielectronPairLeg() = default;
+  template <typename T>
+  explicit DielectronPairLeg(T const& track) : mPt(track.pt()), mEta(track.eta()), mPhi(track.phi()), mSign(track.sign()), mDcaXY(track.dcaXY()), mDcaZ(track.dcaZ()), mCYY(track.cYY()), mCZZ(track.cZZ()), mFourMomentum(mPt, mEta, mPhi, o2::constants::physics::MassElectron)
+  {
+  }
+
+  float pt() const { return mPt; }
+  float eta() const { return mEta; }
+  float phi() const { return mPhi; }
+  int sign() const { return mSign; }
+  float dcaXY() const { return mDcaXY; }
+  float dcaZ() const { return mDcaZ; }
+  float cYY() const { return mCYY; }
+  float cZZ() const { return mCZZ; }
+  const ROOT::Math::PtEtaPhiMVector& fourMomentum() const { return mFourMomentum; }
+
+ private:
+  float mPt = 0.f;
+  float mEta = 0.f;
+  float mPhi = 0.f;
+  int mSign = 0;
+  float mDcaXY = 0.f;
+  float mDcaZ = 0.f;
+  float mCYY = 0.f;
+  float mCZZ = 0.f;
+  ROOT::Math::PtEtaPhiMVector mFourMomentum; // electron mass hypothesis
+};
+
 template <typename TypeOutputScore = float>
 class MlResponseDielectronPair : public MlResponse<TypeOutputScore>
 {
@@ -74,6 +108,14 @@ class MlResponseDielectronPair : public MlResponse<TypeOutputScore>
   /// Default destructor
   virtual ~MlResponseDielectronPair() = default;
 
+  /// Four-momentum of a leg with the electron mass
+  template <typename T>
+  static ROOT::Math::PtEtaPhiMVector fourMomentum(T const& t)
+  {
+    return ROOT::Math::PtEtaPhiMVector(t.pt(), t.eta(), t.phi(), o2::constants::physics::MassElectron);
+  }
+  static const ROOT::Math::PtEtaPhiMVector& fourMomentum(DielectronPairLeg const& leg) { return leg.fourMomentum(); }
+
   template <typename T>
   float pair_dca_xy(T const& t1, T const& t2)
   {
@@ -95,8 +137,8 @@ class MlResponseDielectronPair : public MlResponse<TypeOutputScore>
     // u = v12 / |v12|            , the unit vector of v12
     // v = v1 x v2 / |v1 x v2|    , unit vector perpendicular to v1 and v2
 
-    ROOT::Math::PtEtaPhiMVector v1(t1.pt(), t1.eta(), t1.phi(), o2::constants::physics::MassElectron);
-    ROOT::Math::PtEtaPhiMVector v2(t2.pt(), t2.eta(), t2.phi(), o2::constants::physics::MassElectron);
+    ROOT::Math::PtEtaPhiMVector v1 = fourMomentum(t1);
+    ROOT::Math::PtEtaPhiMVector v2 = fourMomentum(t2);
     ROOT::Math::PtEtaPhiMVector v12 = v1 + v2;
 
     bool swapTracks = false;
@@ -187,11 +229,21 @@ class MlResponseDielectronPair : public MlResponse<TypeOutputScore>
   template <typename T>
   std::vector<float> getInputFeatures(T const& t1, T const& t2)
   {
-    std::vector<float> inputFeatures;
-    ROOT::Math::PtEtaPhiMVector v1(t1.pt(), t1.eta(), t1.phi(), o2::constants::physics::MassElectron);
-    ROOT::Math::PtEtaPhiMVector v2(t2.pt(), t2.eta(), t2.phi(), o2::constants::physics::MassElectron);
-    ROOT::Math::PtEtaPhiMVector v12 = v1 + v2;
+    std::vector<float> inputFeatures(MlResponse<TypeOutputScore>::mCachedIndices.size());
+    fillInputFeatures(t1, t2, inputFeatures.data());
+    return inputFeatures;
+  }
+
+  /// Method to write the input features needed for ML inference into a buffer, e.g. the batch buffer of MlResponse::isSelectedMlFill
+  /// \param t1 is the first track or DielectronPairLeg
+  /// \param t2 is the second track or DielectronPairLeg
+  /// \param inputFeatures is a pointer to the getNInputFeatures() elements to be filled
+  template <typename T, typename TypeBuffer>
+  void fillInputFeatures(T const& t1, T const& t2, TypeBuffer* inputFeatures)
+  {
+    ROOT::Math::PtEtaPhiMVector v12 = fourMomentum(t1) + fourMomentum(t2);
 
+    std::size_t iFeature{0};
     for (const auto& idx : MlResponse<TypeOutputScore>::mCachedIndices) {
       switch (idx) {
         CHECK_AND_FILL_VEC_DIELECTRON_PAIR(m, M);
@@ -202,9 +254,8 @@ class MlResponseDielectronPair : public MlResponse<TypeOutputScore>
         CHECK_AND_FILL_VEC_DIELECTRON_PAIR_FUNC(pairDcaXY, pair_dca_xy);
         CHECK_AND_FILL_VEC_DIELECTRON_PAIR_FUNC(pairDcaZ, pair_dca_z);
       }
+      ++iFeature;
     }
-
-    return inputFeatures;
   }
 
   void setBz(float bz)
@@ -16,6 +16,8 @@
 #define PWGEM_DILEPTON_UTILS_MOMENTUMSMEARER_H_
 
 #include <TH1D.h>
+#include <TMath.h>
+#include <TRandom.h>
 #include <TString.h>
 #include <TGrid.h>
 #include <TObjArray.h>
@@ -24,6 +26,8 @@
 #include <CCDB/BasicCCDBManager.h>
 #include "Framework/Logger.h"
 
+#include <vector>
+
 using namespace o2::framework;
 using namespace o2;
 
@@ -153,6 +157,7 @@ class MomentumSmearer
       if (!fArrResoPhi_Neg) {
         LOGP(fatal, "Could not open {} from file {}", fResPhiNegHistName.Data(), fResFileName.Data());
       }
+      fillResolutionTables();
     }
     delete listRes;
 
@@ -206,6 +211,7 @@ class MomentumSmearer
       } else {
         LOGP(fatal, "Could not identify type of histogram {}", fEffHistName.Data());
       }
+      fillEfficiencyTable();
     }
     delete listEff;
 
@@ -221,51 +227,27 @@ class MomentumSmearer
       return;
     }
     // smear pt
-    int ptbin = reinterpret_cast<TH2D*>(fArrResoPt->At(0))->GetXaxis()->FindBin(ptgen);
-    if (ptbin < 1) {
-      ptbin = 1;
-    }
-    if (ptbin > fArrResoPt->GetLast()) {
-      ptbin = fArrResoPt->GetLast();
-    }
     float smearing = 0.;
-    TH1D* thisHist = reinterpret_cast<TH1D*>(fArrResoPt->At(ptbin));
-    if (thisHist->GetEntries() > 0) {
-      smearing = thisHist->GetRandom() * ptgen;
+    const auto& resoPt = fTableResoPt.get(ptgen);
+    if (resoPt.hasEntries) {
+      smearing = resoPt.getRandom() * ptgen;
     }
     ptsmeared = ptgen - smearing;
 
     // smear eta
-    ptbin = reinterpret_cast<TH2D*>(fArrResoEta->At(0))->GetXaxis()->FindBin(ptgen);
-    if (ptbin < 1) {
-      ptbin = 1;
-    }
-    if (ptbin > fArrResoEta->GetLast()) {
-      ptbin = fArrResoEta->GetLast();
-    }
     smearing = 0.;
-    thisHist = reinterpret_cast<TH1D*>(fArrResoEta->At(ptbin));
-    if (thisHist->GetEntries() > 0) {
-      smearing = thisHist->GetRandom();
+    const auto& resoEta = fTableResoEta.get(ptgen);
+    if (resoEta.hasEntries) {
+      smearing = resoEta.getRandom();
     }
     etasmeared = etagen - smearing;
 
-    // smear phi
-    ptbin = reinterpret_cast<TH2D*>(fArrResoPhi_Pos->At(0))->GetXaxis()->FindBin(ptgen);
-    if (ptbin < 1) {
-      ptbin = 1;
-    }
-    if (ptbin > fArrResoPhi_Pos->GetLast()) {
-      ptbin = fArrResoPhi_Pos->GetLast();
-    }
+    // smear phi, the pt bins of the negative charges are those of the positive ones
     smearing = 0.;
-    if (ch < 0) {
-      thisHist = reinterpret_cast<TH1D*>(fArrResoPhi_Neg->At(ptbin));
-    } else {
-      thisHist = reinterpret_cast<TH1D*>(fArrResoPhi_Pos->At(ptbin));
-    }
-    if (thisHist->GetEntries() > 0) {
-      smearing = thisHist->GetRandom();
+    const int ptbin = fTableResoPhi_Pos.findBin(ptgen);
+    const auto& resoPhi = ch < 0 ? fTableResoPhi_Neg.bins[ptbin] : fTableResoPhi_Pos.bins[ptbin];
+    if (resoPhi.hasEntries) {
+      smearing = resoPhi.getRandom();
     }
     phismeared = phigen - smearing;
   }
@@ -277,58 +259,26 @@ class MomentumSmearer
       return 1.;
     }
 
+    // make sure that no underflow or overflow bins are used
+    auto findBin = [](const TAxis* axis, float x) {
+      int bin = axis->FindBin(x);
+      if (bin < 1)
+        bin = 1;
+      else if (bin > axis->GetNbins())
+        bin = axis->GetNbins();
+      return bin - 1;
+    };
+
     if (fEffType == 1) {
-      TH1F* hist = reinterpret_cast<TH1F*>(fArrEff);
-      int ptbin = hist->GetXaxis()->FindBin(pt);
-      int ptbin_max = hist->GetXaxis()->GetNbins();
-      // make sure that no underflow or overflow bins are used
-      if (ptbin < 1)
-        ptbin = 1;
-      else if (ptbin > ptbin_max)
-        ptbin = ptbin_max;
-      return hist->GetBinContent(ptbin);
+      return fEffContents[findBin(fEffAxes[0], pt)];
     }
 
     if (fEffType == 2) {
-      TH2F* hist = reinterpret_cast<TH2F*>(fArrEff);
-      int ptbin = hist->GetXaxis()->FindBin(pt);
-      int ptbin_max = hist->GetXaxis()->GetNbins();
-      int etabin = hist->GetYaxis()->FindBin(eta);
-      int etabin_max = hist->GetYaxis()->GetNbins();
-      // make sure that no underflow or overflow bins are used
-      if (ptbin < 1)
-        ptbin = 1;
-      else if (ptbin > ptbin_max)
-        ptbin = ptbin_max;
-      if (etabin < 1)
-        etabin = 1;
-      else if (etabin > etabin_max)
-        etabin = etabin_max;
-      return hist->GetBinContent(ptbin, etabin);
+      return fEffContents[findBin(fEffAxes[0], pt) + fEffNBins[0] * findBin(fEffAxes[1], eta)];
     }
 
     if (fEffType == 3) {
-      TH3F* hist = reinterpret_cast<TH3F*>(fArrEff);
-      int ptbin = hist->GetXaxis()->FindBin(pt);
-      int ptbin_max = hist->GetXaxis()->GetNbins();
-      int etabin = hist->GetYaxis()->FindBin(eta);
-      int etabin_max = hist->GetYaxis()->GetNbins();
-      int phibin = hist->GetZaxis()->FindBin(phi);
-      int phibin_max = hist->GetZaxis()->GetNbins();
-      // make sure that no underflow or overflow bins are used
-      if (ptbin < 1)
-        ptbin = 1;
-      else if (ptbin > ptbin_max)
-        ptbin = ptbin_max;
-      if (etabin < 1)
-        etabin = 1;
-      else if (etabin > etabin_max)
-        etabin = etabin_max;
-      if (phibin < 1)
-        phibin = 1;
-      else if (phibin > phibin_max)
-        phibin = phibin_max;
-      return hist->GetBinContent(ptbin, etabin, phibin);
+      return fEffContents[findBin(fEffAxes[0], pt) + fEffNBins[0] * (findBin(fEffAxes[1], eta) + fEffNBins[1] * findBin(fEffAxes[2], phi))];
     }
 
     return 1.;
@@ -368,6 +318,118 @@ class MomentumSmearer
   TString getCcdbPathEff() { return fCcdbPathEff; }
 
  private:
+  /// Resolution distribution of one pt bin. The cumulative distribution is computed once as TH1::ComputeIntegral does,
+  /// so that the sampling gives the same values as TH1::GetRandom from the same gRandom sequence.
+  struct ResolutionBin {
+    bool hasEntries = false;
+    double integral = 0.;           // before normalisation, 0 or NaN if the distribution cannot be sampled
+    std::vector<double> cumulative; // normalised cumulative distribution, nbins + 1 entries
+    std::vector<double> lowEdges;   // low edges of the bins
+    std::vector<double> widths;     // widths of the bins
+
+    double getRandom() const
+    {
+      if (integral == 0) {
+        return 0;
+      }
+      if (TMath::IsNaN(integral)) {
+        return TMath::QuietNaN();
+      }
+      const int nbins = lowEdges.size();
+      Double_t r1 = gRandom->Rndm();
+      Int_t ibin = TMath::BinarySearch(nbins, cumulative.data(), r1);
+      Double_t x = lowEdges[ibin];
+      if (r1 > cumulative[ibin]) {
+        x += widths[ibin] * (r1 - cumulative[ibin]) / (cumulative[ibin + 1] - cumulative[ibin]);
+      }
+      return x;
+    }
+  };
+
+  /// Resolution distributions in pt bins, element 0 of the array being the 2D histogram with the pt binning
+  struct ResolutionTable {
+    const TAxis* ptAxis = nullptr;
+    int lastBin = 0;
+    std::vector<ResolutionBin> bins; // index 1 to lastBin
+
+    int findBin(float pt) const
+    {
+      int ptbin = ptAxis->FindBin(pt);
+      if (ptbin < 1) {
+        ptbin = 1;
+      }
+      if (ptbin > lastBin) {
+        ptbin = lastBin;
+      }
+      return ptbin;
+    }
+    const ResolutionBin& get(float pt) const { return bins[findBin(pt)]; }
+
+    void fill(TObjArray* arr)
+    {
+      ptAxis = reinterpret_cast<TH2D*>(arr->At(0))->GetXaxis();
+      lastBin = arr->GetLast();
+      bins.assign(lastBin + 1, ResolutionBin{});
+      for (int ptbin = 1; ptbin <= lastBin; ptbin++) {
+        TH1D* hist = reinterpret_cast<TH1D*>(arr->At(ptbin));
+        auto& bin = bins[ptbin];
+        bin.hasEntries = hist->GetEntries() > 0;
+        if (!bin.hasEntries) {
+          continue;
+        }
+        const int nbins = hist->GetNbinsX();
+        bin.integral = hist->ComputeIntegral(true);
+        bin.cumulative.assign(hist->GetIntegral(), hist->GetIntegral() + nbins + 1);
+        bin.lowEdges.resize(nbins);
+        bin.widths.resize(nbins);
+        for (int i = 0; i < nbins; i++) {
+          bin.lowEdges[i] = hist->GetBinLowEdge(i + 1);
+          bin.widths[i] = hist->GetBinWidth(i + 1);
+        }
+      }
+    }
+  };
+
+  void fillResolutionTables()
+  {
+    fTableResoPt.fill(fArrResoPt);
+    fTableResoEta.fill(fArrResoEta);
+    fTableResoPhi_Pos.fill(fArrResoPhi_Pos);
+    fTableResoPhi_Neg.fill(fArrResoPhi_Neg);
+    fTableResoPhi_Neg.ptAxis = fTableResoPhi_Pos.ptAxis;
+    fTableResoPhi_Neg.lastBin = fTableResoPhi_Pos.lastBin;
+    if (static_cast<int>(fTableResoPhi_Neg.bins.size()) <= fTableResoPhi_Pos.lastBin) {
+      LOGP(fatal, "{} has fewer pt bins than {}", fResPhiNegHistName.Data(), fResPhiPosHistName.Data());
+    }
+  }
+
+  /// Copies the efficiency histogram into a flat array, without under- and overflow bins
+  void fillEfficiencyTable()
+  {
+    TH1* hist = dynamic_cast<TH1*>(fArrEff);
+    TAxis* axes[3] = {hist->GetXaxis(), hist->GetYaxis(), hist->GetZaxis()};
+    for (int i = 0; i < 3; i++) {
+      fEffAxes[i] = axes[i];
+      fEffNBins[i] = i < fEffType ? axes[i]->GetNbins() : 1;
+    }
+    fEffContents.resize(fEffNBins[0] * fEffNBins[1] * fEffNBins[2]);
+    for (int k = 0; k < fEffNBins[2]; k++) {
+      for (int j = 0; j < fEffNBins[1]; j++) {
+        for (int i = 0; i < fEffNBins[0]; i++) {
+          float value = 0.;
+          if (fEffType == 1) {
+            value = hist->GetBinContent(i + 1);
+          } else if (fEffType == 2) {
+            value = hist->GetBinContent(i + 1, j + 1);
+          } else {
+            value = hist->GetBinContent(i + 1, j + 1, k + 1);
+          }
+          fEffContents[i + fEffNBins[0] * (j + fEffNBins[1] * k)] = value;
+        }
+      }
+    }
+  }
+
   bool fInitialized = false;
   TString fResFileName;
   TString fResPtHistName;
@@ -385,6 +447,13 @@ class MomentumSmearer
   TObjArray* fArrResoPhi_Pos;
   TObjArray* fArrResoPhi_Neg;
   TObject* fArrEff;
+  ResolutionTable fTableResoPt;
+  ResolutionTable fTableResoEta;
+  ResolutionTable fTableResoPhi_Pos;
+  ResolutionTable fTableResoPhi_Neg;
+  const TAxis* fEffAxes[3] = {nullptr, nullptr, nullptr};
+  int fEffNBins[3] = {1, 1, 1};
+  std::vector<float> fEffContents; // efficiency in the bins of (pt, eta, phi), pt running fastest
   int64_t fTimestamp;
   bool fFromCcdb = false;
   Service<ccdb::BasicCCDBManager> fCcdb;
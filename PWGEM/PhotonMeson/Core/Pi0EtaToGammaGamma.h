@@ -315,11 +315,6 @@ struct Pi0EtaToGammaGamma {
     emh1 = 0x0;
     delete emh2;
     emh2 = 0x0;
-
-    used_photonIds.clear();
-    used_photonIds.shrink_to_fit();
-    used_dileptonIds.clear();
-    used_dileptonIds.shrink_to_fit();
   }
 
   void DefineEMEventCut()
@@ -471,9 +466,23 @@ struct Pi0EtaToGammaGamma {
     fPHOSCut.SetEnergyRange(phoscuts.cfg_min_Ecluster, 1e+10);
   }
 
+  // photons and dileptons of the collision being paired. The selections and the kinematics are evaluated once per collision
+  // instead of once per pair, and the flags of the event pool replace the search over the photons stored so far.
+  struct CachedPhoton {
+    int64_t globalIndex;
+    float pt, eta, phi;
+    ROOT::Math::PtEtaPhiMVector v; // massless
+    bool isSelected;
+    bool isStored; // in the event pool
+  };
+  struct CachedDilepton {
+    int posTrackId, eleTrackId;
+    ROOT::Math::PtEtaPhiMVector v_pos, v_ele, v_ee;
+    bool isStored; // in the event pool
+  };
+
   /// \brief Calculate background (using rotation background method only for EMCal!)
-  template <typename TPhotons>
-  void RotationBackground(const ROOT::Math::PtEtaPhiMVector& meson, ROOT::Math::PtEtaPhiMVector photon1, ROOT::Math::PtEtaPhiMVector photon2, TPhotons const& photons_coll, unsigned int ig1, unsigned int ig2, EMCPhotonCut const& cut, aod::SkimEMCMTs const&)
+  void RotationBackground(const ROOT::Math::PtEtaPhiMVector& meson, ROOT::Math::PtEtaPhiMVector photon1, ROOT::Math::PtEtaPhiMVector photon2, std::vector<CachedPhoton> const& photons_coll, int64_t ig1, int64_t ig2)
   {
     // if less than 3 clusters are present skip event since we need at least 3 clusters
     if (photons_coll.size() < 3) {
@@ -486,15 +495,15 @@ struct Pi0EtaToGammaGamma {
     photon2 = rotationMatrix * photon2;
 
     for (auto& photon : photons_coll) {
-      if (photon.globalIndex() == ig1 || photon.globalIndex() == ig2) {
+      if (photon.globalIndex == ig1 || photon.globalIndex == ig2) {
         // only combine rotated photons with other photons
         continue;
       }
-      if (!cut.template IsSelected<aod::SkimEMCMTs>(photon)) {
+      if (!photon.isSelected) {
         continue;
       }
 
-      ROOT::Math::PtEtaPhiMVector photon3(photon.pt(), photon.eta(), photon.phi(), 0.);
+      const ROOT::Math::PtEtaPhiMVector& photon3 = photon.v;
       ROOT::Math::PtEtaPhiMVector mother1 = photon1 + photon3;
       ROOT::Math::PtEtaPhiMVector mother2 = photon2 + photon3;
 
@@ -525,8 +534,58 @@ struct Pi0EtaToGammaGamma {
 
   o2::aod::pwgem::photonmeson::utils::EventMixingHandler<std::tuple<int, int, int>, std::pair<int, int64_t>, EMTrack>* emh1 = nullptr;
   o2::aod::pwgem::photonmeson::utils::EventMixingHandler<std::tuple<int, int, int>, std::pair<int, int64_t>, EMTrack>* emh2 = nullptr;
-  std::vector<std::pair<int, int>> used_photonIds;              // <ndf, trackId>
-  std::vector<std::tuple<int, int, int, int>> used_dileptonIds; // <ndf, trackId>
+
+  std::vector<CachedPhoton> cached_photons1;
+  std::vector<CachedPhoton> cached_photons2;
+  std::vector<CachedDilepton> cached_dileptons;
+
+  template <typename TSubInfos, typename TPhotons, typename TCut>
+  void cachePhotons(TPhotons const& photons_per_collision, TCut const& cut, std::vector<CachedPhoton>& cached_photons)
+  {
+    cached_photons.clear();
+    for (auto& g : photons_per_collision) {
+      cached_photons.push_back({g.globalIndex(), g.pt(), g.eta(), g.phi(), ROOT::Math::PtEtaPhiMVector(g.pt(), g.eta(), g.phi(), 0.), cut.template IsSelected<TSubInfos>(g), false});
+    }
+  }
+
+  // selected e+e- pairs of a collision, in the order of the pairing loop
+  template <typename TPositrons, typename TElectrons, typename TCollision, typename TCut>
+  void cacheDileptons(TPositrons const& positrons_per_collision, TElectrons const& electrons_per_collision, TCollision const& collision, TCut const& cut)
+  {
+    auto isSelectedTrack = [&](auto const& track) {
+      if (dileptoncuts.cfg_pid_scheme == static_cast<int>(DalitzEECut::PIDSchemes::kPIDML)) {
+        return cut.template IsSelectedTrack<true>(track, collision);
+      } else { // cut-based
+        return cut.template IsSelectedTrack<false>(track, collision);
+      }
+    };
+    selected_electrons.clear();
+    for (auto& ele : electrons_per_collision) {
+      selected_electrons.push_back(isSelectedTrack(ele));
+    }
+
+    cached_dileptons.clear();
+    for (auto& pos : positrons_per_collision) {
+      const bool isSelectedPos = isSelectedTrack(pos);
+      size_t iele = 0;
+      for (auto& ele : electrons_per_collision) {
+        const bool isSelectedEle = selected_electrons[iele++];
+        if (pos.trackId() == ele.trackId()) { // this is protection against pairing identical 2 tracks.
+          continue;
+        }
+        if (!isSelectedPos || !isSelectedEle) {
+          continue;
+        }
+        if (!cut.IsSelectedPair(pos, ele, d_bz)) {
+          continue;
+        }
+        ROOT::Math::PtEtaPhiMVector v_pos(pos.pt(), pos.eta(), pos.phi(), o2::constants::physics::MassElectron);
+        ROOT::Math::PtEtaPhiMVector v_ele(ele.pt(), ele.eta(), ele.phi(), o2::constants::physics::MassElectron);
+        cached_dileptons.push_back({pos.trackId(), ele.trackId(), v_pos, v_ele, v_pos + v_ele, false});
+      }
+    }
+  }
+  std::vector<bool> selected_electrons;
 
   template <typename TCollisions, typename TPhotons1, typename TPhotons2, typename TSubInfos1, typename TSubInfos2, typename TPreslice1, typename TPreslice2, typename TCut1, typename TCut2, typename TTracksMatchedWithEMC, typename TTracksMatchedWithPHOS>
   void runPairing(TCollisions const& collisions,
@@ -534,7 +593,7 @@ struct Pi0EtaToGammaGamma {
                   TSubInfos1 const& /*subinfos1*/, TSubInfos2 const& /*subinfos2*/,
                   TPreslice1 const& perCollision1, TPreslice2 const& perCollision2,
                   TCut1 const& cut1, TCut2 const& cut2,
-                  TTracksMatchedWithEMC const& tracks_emc, TTracksMatchedWithPHOS const& /*tracks_phos*/)
+                  TTracksMatchedWithEMC const& /*tracks_emc*/, TTracksMatchedWithPHOS const& /*tracks_phos*/)
   {
     for (auto& collision : collisions) {
       initCCDB(collision);
@@ -588,77 +647,65 @@ struct Pi0EtaToGammaGamma {
       if constexpr (pairtype == PairType::kPCMPCM || pairtype == PairType::kPHOSPHOS || pairtype == PairType::kEMCEMC) { // same kinds pairing
         auto photons1_per_collision = photons1.sliceBy(perCollision1, collision.globalIndex());
         auto photons2_per_collision = photons2.sliceBy(perCollision2, collision.globalIndex());
+        cachePhotons<TSubInfos1>(photons1_per_collision, cut1, cached_photons1);
+        cachePhotons<TSubInfos2>(photons2_per_collision, cut2, cached_photons2);
 
-        for (auto& [g1, g2] : combinations(CombinationsStrictlyUpperIndexPolicy(photons1_per_collision, photons2_per_collision))) {
-          if (!cut1.template IsSelected<TSubInfos1>(g1) || !cut2.template IsSelected<TSubInfos2>(g2)) {
-            continue;
-          }
-
-          ROOT::Math::PtEtaPhiMVector v1(g1.pt(), g1.eta(), g1.phi(), 0.);
-          ROOT::Math::PtEtaPhiMVector v2(g2.pt(), g2.eta(), g2.phi(), 0.);
-          ROOT::Math::PtEtaPhiMVector v12 = v1 + v2;
-          if (abs(v12.Rapidity()) > maxY) {
+        for (size_t i1 = 0; i1 < cached_photons1.size(); i1++) {
+          auto& g1 = cached_photons1[i1];
+          if (!g1.isSelected) {
             continue;
           }
-          o2::aod::pwgem::photonmeson::utils::nmhistogram::fillPairInfo<0, pairtype>(&fRegistry, collision, v12, cfgDoFlow);
+          for (size_t i2 = i1 + 1; i2 < cached_photons2.size(); i2++) {
+            auto& g2 = cached_photons2[i2];
+            if (!g2.isSelected) {
+              continue;
+            }
 
-          if constexpr (pairtype == PairType::kEMCEMC) {
-            RotationBackground<MyEMCClusters>(v12, v1, v2, photons2_per_collision, g1.globalIndex(), g2.globalIndex(), cut1, tracks_emc);
-          }
+            ROOT::Math::PtEtaPhiMVector v12 = g1.v + g2.v;
+            if (abs(v12.Rapidity()) > maxY) {
+              continue;
+            }
+            o2::aod::pwgem::photonmeson::utils::nmhistogram::fillPairInfo<0, pairtype>(&fRegistry, collision, v12, cfgDoFlow);
 
-          std::pair<int, int> pair_tmp_id1 = std::make_pair(ndf, g1.globalIndex());
-          std::pair<int, int> pair_tmp_id2 = std::make_pair(ndf, g2.globalIndex());
+            if constexpr (pairtype == PairType::kEMCEMC) {
+              RotationBackground(v12, g1.v, g2.v, cached_photons2, g1.globalIndex, g2.globalIndex);
+            }
 
-          if (std::find(used_photonIds.begin(), used_photonIds.end(), pair_tmp_id1) == used_photonIds.end()) {
-            emh1->AddTrackToEventPool(key_df_collision, EMTrack(collision.globalIndex(), g1.globalIndex(), g1.pt(), g1.eta(), g1.phi(), 0, 0, 0, 0, 0, 0, 0, std::vector<int>{}));
-            used_photonIds.emplace_back(pair_tmp_id1);
-          }
-          if (std::find(used_photonIds.begin(), used_photonIds.end(), pair_tmp_id2) == used_photonIds.end()) {
-            emh1->AddTrackToEventPool(key_df_collision, EMTrack(collision.globalIndex(), g2.globalIndex(), g2.pt(), g2.eta(), g2.phi(), 0, 0, 0, 0, 0, 0, 0, std::vector<int>{}));
-            used_photonIds.emplace_back(pair_tmp_id2);
+            // photons of the same kind share the event pool, a photon is stored once whether it was first or second of a pair
+            if (!cached_photons1[i1].isStored) {
+              emh1->AddTrackToEventPool(key_df_collision, EMTrack(collision.globalIndex(), g1.globalIndex, g1.pt, g1.eta, g1.phi, 0, 0, 0, 0, 0, 0, 0, std::vector<int>{}));
+              cached_photons1[i1].isStored = true;
+            }
+            if (!cached_photons1[i2].isStored) {
+              emh1->AddTrackToEventPool(key_df_collision, EMTrack(collision.globalIndex(), g2.globalIndex, g2.pt, g2.eta, g2.phi, 0, 0, 0, 0, 0, 0, 0, std::vector<int>{}));
+              cached_photons1[i2].isStored = true;
+            }
+            ndiphoton++;
           }
-          ndiphoton++;
         } // end of pairing loop
       } else if constexpr (pairtype == PairType::kPCMDalitzEE) {
         auto photons1_per_collision = photons1.sliceBy(perCollision1, collision.globalIndex());
         auto positrons_per_collision = positrons->sliceByCached(o2::aod::emprimaryelectron::emeventId, collision.globalIndex(), cache);
         auto electrons_per_collision = electrons->sliceByCached(o2::aod::emprimaryelectron::emeventId, collision.globalIndex(), cache);
+        cachePhotons<TSubInfos1>(photons1_per_collision, cut1, cached_photons1);
+        cacheDileptons(positrons_per_collision, electrons_per_collision, collision, cut2);
 
+        size_t i1 = 0;
         for (auto& g1 : photons1_per_collision) {
-          if (!cut1.template IsSelected<TSubInfos1>(g1)) {
+          auto& cached_g1 = cached_photons1[i1++];
+          if (!cached_g1.isSelected) {
             continue;
           }
           auto pos1 = g1.template posTrack_as<TSubInfos1>();
           auto ele1 = g1.template negTrack_as<TSubInfos1>();
-          ROOT::Math::PtEtaPhiMVector v_gamma(g1.pt(), g1.eta(), g1.phi(), 0.);
-
-          for (auto& [pos2, ele2] : combinations(CombinationsFullIndexPolicy(positrons_per_collision, electrons_per_collision))) {
-
-            if (pos2.trackId() == ele2.trackId()) { // this is protection against pairing identical 2 tracks.
-              continue;
-            }
-            if (pos1.trackId() == pos2.trackId() || ele1.trackId() == ele2.trackId()) {
-              continue;
-            }
-
-            if (dileptoncuts.cfg_pid_scheme == static_cast<int>(DalitzEECut::PIDSchemes::kPIDML)) {
-              if (!cut2.template IsSelectedTrack<true>(pos2, collision) || !cut2.template IsSelectedTrack<true>(ele2, collision)) {
-                continue;
-              }
-            } else { // cut-based
-              if (!cut2.template IsSelectedTrack<false>(pos2, collision) || !cut2.template IsSelectedTrack<false>(ele2, collision)) {
-                continue;
-              }
-            }
+          const ROOT::Math::PtEtaPhiMVector& v_gamma = cached_g1.v;
 
-            if (!cut2.IsSelectedPair(pos2, ele2, d_bz)) {
+          for (auto& dilepton : cached_dileptons) {
+            if (pos1.trackId() == dilepton.posTrackId || ele1.trackId() == dilepton.eleTrackId) {
               continue;
             }
 
-            ROOT::Math::PtEtaPhiMVector v_pos(pos2.pt(), pos2.eta(), pos2.phi(), o2::constants::physics::MassElectron);
-            ROOT::Math::PtEtaPhiMVector v_ele(ele2.pt(), ele2.eta(), ele2.phi(), o2::constants::physics::MassElectron);
-            ROOT::Math::PtEtaPhiMVector v_ee = v_pos + v_ele;
-            ROOT::Math::PtEtaPhiMVector veeg = v_gamma + v_pos + v_ele;
+            ROOT::Math::PtEtaPhiMVector veeg = v_gamma + dilepton.v_pos + dilepton.v_ele;
             if (abs(veeg.Rapidity()) > maxY) {
               continue;
             }
@@ -667,15 +714,14 @@ struct Pi0EtaToGammaGamma {
             // float dca_ele_3d = dca3DinSigma(ele2);
             // float dca_ee_3d = std::sqrt((dca_pos_3d * dca_pos_3d + dca_ele_3d * dca_ele_3d) / 2.);
 
-            std::pair<int, int> pair_tmp_id1 = std::make_pair(ndf, g1.globalIndex());
-            std::tuple<int, int, int, int> tuple_tmp_id2 = std::make_tuple(ndf, collision.globalIndex(), pos2.trackId(), ele2.trackId());
-            if (std::find(used_photonIds.begin(), used_photonIds.end(), pair_tmp_id1) == used_photonIds.end()) {
+            if (!cached_g1.isStored) {
               emh1->AddTrackToEventPool(key_df_collision, EMTrack(collision.globalIndex(), g1.globalIndex(), g1.pt(), g1.eta(), g1.phi(), 0, 0, 0, 0, 0, 0, 0, std::vector<int>{}));
-              used_photonIds.emplace_back(pair_tmp_id1);
+              cached_g1.isStored = true;
             }
-            if (std::find(used_dileptonIds.begin(), used_dileptonIds.end(), tuple_tmp_id2) == used_dileptonIds.end()) {
+            if (!dilepton.isStored) {
+              const auto& v_ee = dilepton.v_ee;
               emh2->AddTrackToEventPool(key_df_collision, EMTrack(collision.globalIndex(), -1, v_ee.Pt(), v_ee.Eta(), v_ee.Phi(), v_ee.M(), 0, 0, 0, 0, 0, 0, std::vector<int>{}));
-              used_dileptonIds.emplace_back(tuple_tmp_id2);
+              dilepton.isStored = true;
             }
             ndiphoton++;
           }    // end of dielectron loop
@@ -683,30 +729,33 @@ struct Pi0EtaToGammaGamma {
       } else { // PCM-EMC, PCM-PHOS. Nightmare. don't run these pairs.
         auto photons1_per_collision = photons1.sliceBy(perCollision1, collision.globalIndex());
         auto photons2_per_collision = photons2.sliceBy(perCollision2, collision.globalIndex());
+        cachePhotons<TSubInfos1>(photons1_per_collision, cut1, cached_photons1);
+        cachePhotons<TSubInfos2>(photons2_per_collision, cut2, cached_photons2);
 
-        for (auto& [g1, g2] : combinations(CombinationsFullIndexPolicy(photons1_per_collision, photons2_per_collision))) {
-          if (!cut1.template IsSelected<TSubInfos1>(g1) || !cut2.template IsSelected<TSubInfos2>(g2)) {
+        for (auto& g1 : cached_photons1) {
+          if (!g1.isSelected) {
             continue;
           }
-          ROOT::Math::PtEtaPhiMVector v1(g1.pt(), g1.eta(), g1.phi(), 0.);
-          ROOT::Math::PtEtaPhiMVector v2(g2.pt(), g2.eta(), g2.phi(), 0.);
-          ROOT::Math::PtEtaPhiMVector v12 = v1 + v2;
-          if (abs(v12.Rapidity()) > maxY) {
-            continue;
-          }
-          o2::aod::pwgem::photonmeson::utils::nmhistogram::fillPairInfo<0, pairtype>(&fRegistry, collision, v12, cfgDoFlow);
-          std::pair<int, int> pair_tmp_id1 = std::make_pair(ndf, g1.globalIndex());
-          std::pair<int, int> pair_tmp_id2 = std::make_pair(ndf, g2.globalIndex());
+          for (auto& g2 : cached_photons2) {
+            if (!g2.isSelected) {
+              continue;
+            }
+            ROOT::Math::PtEtaPhiMVector v12 = g1.v + g2.v;
+            if (abs(v12.Rapidity()) > maxY) {
+              continue;
+            }
+            o2::aod::pwgem::photonmeson::utils::nmhistogram::fillPairInfo<0, pairtype>(&fRegistry, collision, v12, cfgDoFlow);
 
-          if (std::find(used_photonIds.begin(), used_photonIds.end(), pair_tmp_id1) == used_photonIds.end()) {
-            emh1->AddTrackToEventPool(key_df_collision, EMTrack(collision.globalIndex(), g1.globalIndex(), g1.pt(), g1.eta(), g1.phi(), 0, 0, 0, std::vector<int>{}));
-            used_photonIds.emplace_back(pair_tmp_id1);
-          }
-          if (std::find(used_photonIds.begin(), used_photonIds.end(), pair_tmp_id2) == used_photonIds.end()) {
-            emh2->AddTrackToEventPool(key_df_collision, EMTrack(collision.globalIndex(), g2.globalIndex(), g2.pt(), g2.eta(), g2.phi(), 0, 0, 0, std::vector<int>{}));
-            used_photonIds.emplace_back(pair_tmp_id2);
+            if (!g1.isStored) {
+              emh1->AddTrackToEventPool(key_df_collision, EMTrack(collision.globalIndex(), g1.globalIndex, g1.pt, g1.eta, g1.phi, 0, 0, 0, std::vector<int>{}));
+              g1.isStored = true;
+            }
+            if (!g2.isStored) {
+              emh2->AddTrackToEventPool(key_df_collision, EMTrack(collision.globalIndex(), g2.globalIndex, g2.pt, g2.eta, g2.phi, 0, 0, 0, std::vector<int>{}));
+              g2.isStored = true;
+            }
+            ndiphoton++;
           }
-          ndiphoton++;
         } // end of pairing loop
       }   // end of pairing in same event
 
@@ -716,14 +765,15 @@ struct Pi0EtaToGammaGamma {
       }
 
       // make a vector of selected photons in this collision.
-      auto selected_photons1_in_this_event = emh1->GetTracksPerCollision(key_df_collision);
-      auto selected_photons2_in_this_event = emh2->GetTracksPerCollision(key_df_collision);
+      auto& selected_photons1_in_this_event = emh1->GetTracksPerCollision(key_df_collision);
+      auto& selected_photons2_in_this_event = emh2->GetTracksPerCollision(key_df_collision);
 
-      auto collisionIds1_in_mixing_pool = emh1->GetCollisionIdsFromEventPool(key_bin);
-      auto collisionIds2_in_mixing_pool = emh2->GetCollisionIdsFromEventPool(key_bin);
+      int nCollisions1_in_mixing_pool = emh1->GetNCollisionsInEventPool(key_bin);
+      int nCollisions2_in_mixing_pool = emh2->GetNCollisionsInEventPool(key_bin);
 
       if constexpr (pairtype == PairType::kPCMPCM || pairtype == PairType::kPHOSPHOS || pairtype == PairType::kEMCEMC) { // same kinds pairing
-        for (auto& mix_dfId_collisionId : collisionIds1_in_mixing_pool) {
+        for (int iMix = 0; iMix < nCollisions1_in_mixing_pool; iMix++) {
+          auto& mix_dfId_collisionId = emh1->GetCollisionIdFromEventPool(key_bin, iMix);
           int mix_dfId = mix_dfId_collisionId.first;
           int64_t mix_collisionId = mix_dfId_collisionId.second;
 
@@ -731,7 +781,7 @@ struct Pi0EtaToGammaGamma {
             continue;
           }
 
-          auto photons1_from_event_pool = emh1->GetTracksPerCollision(mix_dfId_collisionId);
+          auto& photons1_from_event_pool = emh1->GetTracksPerCollision(key_bin, iMix);
           // LOGF(info, "Do event mixing: current event (%d, %d), ngamma = %d | event pool (%d, %d), ngamma = %d", ndf, collision.globalIndex(), selected_photons1_in_this_event.size(), mix_dfId, mix_collisionId, photons1_from_event_pool.size());
 
           for (auto& g1 : selected_photons1_in_this_event) {
@@ -748,7 +798,8 @@ struct Pi0EtaToGammaGamma {
         } // end of loop over mixed event pool
 
       } else { //[photon1 from event1, photon2 from event2] and [photon1 from event2, photon2 from event1]
-        for (auto& mix_dfId_collisionId : collisionIds2_in_mixing_pool) {
+        for (int iMix = 0; iMix < nCollisions2_in_mixing_pool; iMix++) {
+          auto& mix_dfId_collisionId = emh2->GetCollisionIdFromEventPool(key_bin, iMix);
           int mix_dfId = mix_dfId_collisionId.first;
           int64_t mix_collisionId = mix_dfId_collisionId.second;
 
@@ -756,7 +807,7 @@ struct Pi0EtaToGammaGamma {
             continue;
           }
 
-          auto photons2_from_event_pool = emh2->GetTracksPerCollision(mix_dfId_collisionId);
+          auto& photons2_from_event_pool = emh2->GetTracksPerCollision(key_bin, iMix);
           // LOGF(info, "Do event mixing: current event (%d, %d), ngamma = %d | event pool (%d, %d), nll = %d", ndf, collision.globalIndex(), selected_photons1_in_this_event.size(), mix_dfId, mix_collisionId, photons2_from_event_pool.size());
 
           for (auto& g1 : selected_photons1_in_this_event) {
@@ -774,7 +825,8 @@ struct Pi0EtaToGammaGamma {
             }
           }
         } // end of loop over mixed event pool
-        for (auto& mix_dfId_collisionId : collisionIds1_in_mixing_pool) {
+        for (int iMix = 0; iMix < nCollisions1_in_mixing_pool; iMix++) {
+          auto& mix_dfId_collisionId = emh1->GetCollisionIdFromEventPool(key_bin, iMix);
           int mix_dfId = mix_dfId_collisionId.first;
           int64_t mix_collisionId = mix_dfId_collisionId.second;
 
@@ -782,7 +834,7 @@ struct Pi0EtaToGammaGamma {
             continue;
           }
 
-          auto photons1_from_event_pool = emh1->GetTracksPerCollision(mix_dfId_collisionId);
+          auto& photons1_from_event_pool = emh1->GetTracksPerCollision(key_bin, iMix);
           // LOGF(info, "Do event mixing: current event (%d, %d), nll = %d | event pool (%d, %d), ngamma = %d", ndf, collision.globalIndex(), selected_photons2_in_this_event.size(), mix_dfId, mix_collisionId, photons1_from_event_pool.size());
 
           for (auto& g1 : selected_photons2_in_this_event) {
@@ -298,7 +298,7 @@ struct PhotonConversionBuilder {
     return true;
   }
 
-  float cospaXY_KF(KFParticle kfp, KFParticle PV)
+  float cospaXY_KF(KFParticle const& kfp, KFParticle const& PV)
   {
     float lx = kfp.GetX() - PV.GetX(); // flight length X
     float ly = kfp.GetY() - PV.GetY(); // flight length Y
@@ -314,7 +314,7 @@ struct PhotonConversionBuilder {
     return cospaXY;
   }
 
-  float cospaRZ_KF(KFParticle kfp, KFParticle PV)
+  float cospaRZ_KF(KFParticle const& kfp, KFParticle const& PV)
   {
     float lx = kfp.GetX() - PV.GetX();              // flight length X
     float ly = kfp.GetY() - PV.GetY();              // flight length Y
@@ -373,6 +373,14 @@ struct PhotonConversionBuilder {
     }
     // LOGF(info, "v0.collisionId() = %d , v0.posTrackId() = %d , v0.negTrackId() = %d", v0.collisionId(), v0.posTrackId(), v0.negTrackId());
 
+    // The transverse position of the conversion point only depends on the helix centers. Reject the V0s outside the TPC before any propagation.
+    float xy[2] = {0.f, 0.f};
+    Vtx_recalculationXY(o2::base::Propagator::Instance(), pos, ele, xy);
+    float rxy_tmp = RecoDecay::sqrtSumOfSquares(xy[0], xy[1]);
+    if (rxy_tmp > maxX + margin_r_tpc) {
+      return;
+    }
+
     // Calculate DCA with respect to the collision associated to the v0, not individual tracks
     gpu::gpustd::array<float, 2> dcaInfo;
 
@@ -392,10 +400,6 @@ struct PhotonConversionBuilder {
 
     float xyz[3] = {0.f, 0.f, 0.f};
     Vtx_recalculation(o2::base::Propagator::Instance(), pos, ele, xyz, matCorr);
-    float rxy_tmp = RecoDecay::sqrtSumOfSquares(xyz[0], xyz[1]);
-    if (rxy_tmp > maxX + margin_r_tpc) {
-      return;
-    }
     if (rxy_tmp < abs(xyz[2]) * TMath::Tan(2 * TMath::ATan(TMath::Exp(-max_eta_v0))) - margin_z) {
       return; // RZ line cut
     }
@@ -564,8 +568,7 @@ struct PhotonConversionBuilder {
     if (!checkAP(alpha, qt, max_alpha_ap, max_qt_ap)) { // store only photon conversions
       return;
     }
-    pca_map[std::make_tuple(v0.globalIndex(), collision.globalIndex(), pos.globalIndex(), ele.globalIndex())] = pca_kf;
-    cospa_map[std::make_tuple(v0.globalIndex(), collision.globalIndex(), pos.globalIndex(), ele.globalIndex())] = cospa_kf;
+    pca_map[std::make_tuple(v0.globalIndex(), collision.globalIndex(), pos.globalIndex(), ele.globalIndex())] = std::make_pair(pca_kf, cospa_kf);
 
     if (filltable) {
       registry.fill(HIST("V0/hAP"), alpha, qt);
@@ -621,9 +624,8 @@ struct PhotonConversionBuilder {
   }
 
   Preslice<aod::V0s> perCollision = o2::aod::v0::collisionId;
-  std::map<std::tuple<int64_t, int64_t, int64_t, int64_t>, float> pca_map;   //(v0.globalIndex(), collision.globalIndex(), pos.globalIndex(), ele.globalIndex()) -> pca
-  std::map<std::tuple<int64_t, int64_t, int64_t, int64_t>, float> cospa_map; //(v0.globalIndex(), collision.globalIndex(), pos.globalIndex(), ele.globalIndex()) -> cospa
-  std::vector<std::pair<int64_t, int64_t>> stored_v0Ids;                     //(pos.globalIndex(), ele.globalIndex())
+  std::map<std::tuple<int64_t, int64_t, int64_t, int64_t>, std::pair<float, float>> pca_map; //(v0.globalIndex(), collision.globalIndex(), pos.globalIndex(), ele.globalIndex()) -> (pca, cospa)
+  std::vector<std::pair<int64_t, int64_t>> stored_v0Ids;                                   //(pos.globalIndex(), ele.globalIndex())
 
   template <bool isMC, typename TCollisions, typename TV0s, typename TTracks, typename TBCs>
   void build(TCollisions const& collisions, TV0s const& v0s, TTracks const& /*tracks*/, TBCs const&)
@@ -655,8 +657,8 @@ struct PhotonConversionBuilder {
       auto collisionId = std::get<1>(key);
       auto posId = std::get<2>(key);
       auto eleId = std::get<3>(key);
-      float v0pca = value;
-      float cospa = cospa_map[key];
+      float v0pca = value.first;
+      float cospa = value.second;
       bool is_closest_v0 = true;
       bool is_most_aligned_v0 = true;
 
@@ -665,8 +667,8 @@ struct PhotonConversionBuilder {
         auto collisionId_tmp = std::get<1>(key_tmp);
         auto posId_tmp = std::get<2>(key_tmp);
         auto eleId_tmp = std::get<3>(key_tmp);
-        float v0pca_tmp = value_tmp;
-        float cospa_tmp = cospa_map[key_tmp];
+        float v0pca_tmp = value_tmp.first;
+        float cospa_tmp = value_tmp.second;
 
         if (v0Id == v0Id_tmp) { // skip exactly the same v0
           continue;
@@ -698,7 +700,6 @@ struct PhotonConversionBuilder {
     } // end of pca_map loop
     // LOGF(info, "pca_map.size() = %d", pca_map.size());
     pca_map.clear();
-    cospa_map.clear();
     stored_v0Ids.clear();
     stored_v0Ids.shrink_to_fit();
   } // end of build
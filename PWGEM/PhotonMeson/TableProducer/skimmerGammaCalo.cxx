@@ -68,6 +68,13 @@ struct skimmerGammaCalo {
     LOG(info) << "| M02 cut: " << minM02 << " < M02 < " << maxM02 << std::endl;
   }
 
+  // matched-track properties of the current cluster, the capacity is kept between clusters
+  std::vector<int32_t> vTrackIds;
+  std::vector<float> vEta;
+  std::vector<float> vPhi;
+  std::vector<float> vP;
+  std::vector<float> vPt;
+
   void processRec(aod::Collision const&, aod::EMCALClusters const& emcclusters, aod::EMCALClusterCells const& emcclustercells, aod::EMCALMatchedTracks const& emcmatchedtracks, aod::FullTracks const&)
   {
     for (const auto& emccluster : emcclusters) {
@@ -92,37 +99,31 @@ struct skimmerGammaCalo {
       }
 
       // Skimmed matched tracks table
-      std::vector<int32_t> vTrackIds;
-      std::vector<float> vEta;
-      std::vector<float> vPhi;
-      std::vector<float> vP;
-      std::vector<float> vPt;
       auto groupedMTs = emcmatchedtracks.sliceBy(MTperCluster, emccluster.globalIndex());
+      vTrackIds.clear();
+      vEta.clear();
+      vPhi.clear();
+      vP.clear();
+      vPt.clear();
       vTrackIds.reserve(groupedMTs.size());
       vEta.reserve(groupedMTs.size());
       vPhi.reserve(groupedMTs.size());
       vP.reserve(groupedMTs.size());
       vPt.reserve(groupedMTs.size());
       for (const auto& emcmatchedtrack : groupedMTs) {
-        if (hasPropagatedTracks) { // only temporarily while not every data has the tracks propagated to EMCal/PHOS
-          historeg.fill(HIST("hMTEtaPhi"), emccluster.eta() - emcmatchedtrack.track_as<aod::FullTracks>().trackEtaEmcal(), emccluster.phi() - emcmatchedtrack.track_as<aod::FullTracks>().trackPhiEmcal());
-          vTrackIds.emplace_back(emcmatchedtrack.trackId());
-          vEta.emplace_back(emcmatchedtrack.track_as<aod::FullTracks>().trackEtaEmcal());
-          vPhi.emplace_back(emcmatchedtrack.track_as<aod::FullTracks>().trackPhiEmcal());
-          vP.emplace_back(emcmatchedtrack.track_as<aod::FullTracks>().p());
-          vPt.emplace_back(emcmatchedtrack.track_as<aod::FullTracks>().pt());
-          tableTrackEMCReco(emcmatchedtrack.emcalclusterId(), emcmatchedtrack.track_as<aod::FullTracks>().trackEtaEmcal(), emcmatchedtrack.track_as<aod::FullTracks>().trackPhiEmcal(),
-                            emcmatchedtrack.track_as<aod::FullTracks>().p(), emcmatchedtrack.track_as<aod::FullTracks>().pt());
-        } else {
-          historeg.fill(HIST("hMTEtaPhi"), emccluster.eta() - emcmatchedtrack.track_as<aod::FullTracks>().eta(), emccluster.phi() - emcmatchedtrack.track_as<aod::FullTracks>().phi());
-          vTrackIds.emplace_back(emcmatchedtrack.trackId());
-          vEta.emplace_back(emcmatchedtrack.track_as<aod::FullTracks>().eta());
-          vPhi.emplace_back(emcmatchedtrack.track_as<aod::FullTracks>().phi());
-          vP.emplace_back(emcmatchedtrack.track_as<aod::FullTracks>().p());
-          vPt.emplace_back(emcmatchedtrack.track_as<aod::FullTracks>().pt());
-          tableTrackEMCReco(emcmatchedtrack.emcalclusterId(), emcmatchedtrack.track_as<aod::FullTracks>().eta(), emcmatchedtrack.track_as<aod::FullTracks>().phi(),
-                            emcmatchedtrack.track_as<aod::FullTracks>().p(), emcmatchedtrack.track_as<aod::FullTracks>().pt());
-        }
+        auto track = emcmatchedtrack.track_as<aod::FullTracks>();
+        // only temporarily while not every data has the tracks propagated to EMCal/PHOS
+        const float trackEta = hasPropagatedTracks ? track.trackEtaEmcal() : track.eta();
+        const float trackPhi = hasPropagatedTracks ? track.trackPhiEmcal() : track.phi();
+        const float trackP = track.p();
+        const float trackPt = track.pt();
+        historeg.fill(HIST("hMTEtaPhi"), emccluster.eta() - trackEta, emccluster.phi() - trackPhi);
+        vTrackIds.emplace_back(emcmatchedtrack.trackId());
+        vEta.emplace_back(trackEta);
+        vPhi.emplace_back(trackPhi);
+        vP.emplace_back(trackP);
+        vPt.emplace_back(trackPt);
+        tableTrackEMCReco(emcmatchedtrack.emcalclusterId(), trackEta, trackPhi, trackP, trackPt);
       }
 
       historeg.fill(HIST("hCaloClusterEOut"), emccluster.energy());
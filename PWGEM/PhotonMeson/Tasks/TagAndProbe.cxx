@@ -102,6 +102,9 @@ struct TagAndProbe {
     DefinePHOSCuts();
     DefineEMCCuts();
     DefinePairCuts();
+    if (fProbePCMCuts.size() > 64 || fProbePHOSCuts.size() > 64 || fProbeEMCCuts.size() > 64) {
+      LOGF(fatal, "At most 64 probe cuts are supported per detector.");
+    }
     addhistograms();
 
     TString ev_cut_name = fConfigEMEventCut.value;
@@ -262,6 +265,7 @@ struct TagAndProbe {
 
       auto photons1_coll = photons1.sliceBy(perCollision1, collision.globalIndex());
       auto photons2_coll = photons2.sliceBy(perCollision2, collision.globalIndex());
+      FillProbeMasks<pairtype, TLegs>(photons2_coll, probecuts);
 
       for (auto& g1 : photons1_coll) {
 
@@ -279,7 +283,9 @@ struct TagAndProbe {
           }
         }
 
+        size_t ig2 = 0;
         for (auto& g2 : photons2_coll) {
+          const uint64_t probe_mask = probe_masks[ig2++];
           if ((pairtype == PairType::kPCMPCM || pairtype == PairType::kPHOSPHOS || pairtype == PairType::kEMCEMC) && (g1.globalIndex() == g2.globalIndex())) {
             continue;
           }
@@ -289,7 +295,8 @@ struct TagAndProbe {
               continue;
             }
 
-            for (auto& probecut : probecuts) {
+            for (size_t iprobe = 0; iprobe < probecuts.size(); iprobe++) {
+              auto& probecut = probecuts[iprobe];
               ROOT::Math::PtEtaPhiMVector v1(g1.pt(), g1.eta(), g1.phi(), 0.);
               ROOT::Math::PtEtaPhiMVector v2(g2.pt(), g2.eta(), g2.phi(), 0.);
               ROOT::Math::PtEtaPhiMVector v12 = v1 + v2;
@@ -298,18 +305,8 @@ struct TagAndProbe {
               }
               reinterpret_cast<TH2F*>(list_pair_ss->FindObject(Form("%s_%s", tagcut.GetName(), probecut.GetName()))->FindObject(paircut.GetName())->FindObject("hMggPt_Probe_Same"))->Fill(v12.M(), v2.Pt());
 
-              if constexpr (pairtype == PairType::kPCMPCM) {
-                if (!probecut.template IsSelected<TLegs>(g2)) {
-                  continue;
-                }
-              } else if constexpr (pairtype == PairType::kPHOSPHOS) {
-                if (!probecut.template IsSelected<int>(g2)) {
-                  continue;
-                }
-              } else if constexpr (pairtype == PairType::kEMCEMC) {
-                if (!probecut.template IsSelected<int>(g2)) {
-                  continue;
-                }
+              if (!(probe_mask & (static_cast<uint64_t>(1) << iprobe))) {
+                continue;
               }
 
               reinterpret_cast<TH2F*>(list_pair_ss->FindObject(Form("%s_%s", tagcut.GetName(), probecut.GetName()))->FindObject(paircut.GetName())->FindObject("hMggPt_PassingProbe_Same"))->Fill(v12.M(), v2.Pt());
@@ -358,6 +355,7 @@ struct TagAndProbe {
 
       auto photons_coll1 = photons1.sliceBy(perCollision1, collision1.globalIndex());
       auto photons_coll2 = photons2.sliceBy(perCollision2, collision2.globalIndex());
+      FillProbeMasks<pairtype, TLegs>(photons_coll2, probecuts);
       // LOGF(info, "collision1: posZ = %f, numContrib = %d , sel8 = %d | collision2: posZ = %f, numContrib = %d , sel8 = %d", collision1.posZ(), collision1.numContrib(), collision1.sel8(), collision2.posZ(), collision2.numContrib(), collision2.sel8());
 
       for (auto& g1 : photons_coll1) {
@@ -374,14 +372,17 @@ struct TagAndProbe {
             continue;
           }
         }
+        size_t ig2 = 0;
         for (auto& g2 : photons_coll2) {
+          const uint64_t probe_mask = probe_masks[ig2++];
           // LOGF(info, "Mixed event photon pair: (%d, %d) from events (%d, %d), photon event: (%d, %d)", g1.index(), g2.index(), collision1.index(), collision2.index(), g1.globalIndex(), g2.globalIndex());
 
           for (auto& paircut : paircuts) {
             if (!paircut.IsSelected(g1, g2)) {
               continue;
             }
-            for (auto& probecut : probecuts) {
+            for (size_t iprobe = 0; iprobe < probecuts.size(); iprobe++) {
+              auto& probecut = probecuts[iprobe];
 
               ROOT::Math::PtEtaPhiMVector v1(g1.pt(), g1.eta(), g1.phi(), 0.);
               ROOT::Math::PtEtaPhiMVector v2(g2.pt(), g2.eta(), g2.phi(), 0.);
@@ -391,18 +392,8 @@ struct TagAndProbe {
               }
               reinterpret_cast<TH2F*>(list_pair_ss->FindObject(Form("%s_%s", tagcut.GetName(), probecut.GetName()))->FindObject(paircut.GetName())->FindObject("hMggPt_Probe_Mixed"))->Fill(v12.M(), v2.Pt());
 
-              if constexpr (pairtype == PairType::kPCMPCM) {
-                if (!probecut.template IsSelected<TLegs>(g2)) {
-                  continue;
-                }
-              } else if constexpr (pairtype == PairType::kPHOSPHOS) {
-                if (!probecut.template IsSelected<int>(g2)) {
-                  continue;
-                }
-              } else if constexpr (pairtype == PairType::kEMCEMC) {
-                if (!probecut.template IsSelected<int>(g2)) {
-                  continue;
-                }
+              if (!(probe_mask & (static_cast<uint64_t>(1) << iprobe))) {
+                continue;
               }
 
               reinterpret_cast<TH2F*>(list_pair_ss->FindObject(Form("%s_%s", tagcut.GetName(), probecut.GetName()))->FindObject(paircut.GetName())->FindObject("hMggPt_PassingProbe_Mixed"))->Fill(v12.M(), v2.Pt());
@@ -414,6 +405,23 @@ struct TagAndProbe {
     }         // end of different collision combinations
   }
 
+  std::vector<uint64_t> probe_masks; // selections of the probe photons of a collision by the probe cuts
+
+  template <PairType pairtype, typename TLegs, typename TPhotons, typename TProbeCuts>
+  void FillProbeMasks(TPhotons const& photons_coll, TProbeCuts const& probecuts)
+  {
+    probe_masks.clear();
+    for (auto& g : photons_coll) {
+      if constexpr (pairtype == PairType::kPCMPCM) {
+        probe_masks.emplace_back(o2::aod::photonpair::GetSelectionMask<TLegs>(g, probecuts));
+      } else if constexpr (pairtype == PairType::kPHOSPHOS || pairtype == PairType::kEMCEMC) {
+        probe_masks.emplace_back(o2::aod::photonpair::GetSelectionMask<int>(g, probecuts));
+      } else {
+        probe_masks.emplace_back(~static_cast<uint64_t>(0));
+      }
+    }
+  }
+
   /// \brief Calculate background (using rotation background method only for EMCal!)
   template <typename TPhotons>
   void RotationBackground(const ROOT::Math::PtEtaPhiMVector& meson, ROOT::Math::PtEtaPhiMVector photon1, ROOT::Math::PtEtaPhiMVector photon2, TPhotons const& photons_coll, unsigned int ig1, unsigned int ig2, EMCPhotonCut const& cut, PairCut const& paircut, SkimEMCMTs const& /*emcmatchedtracks*/)
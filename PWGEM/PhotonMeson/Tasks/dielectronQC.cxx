@@ -595,13 +595,14 @@ struct dielectronQC {
       std::pair<int, int> key_df_collision = std::make_pair(ndf, collision.globalIndex());
 
       // make a vector of selected photons in this collision.
-      auto selected_posTracks_in_this_event = emh_pos->GetTracksPerCollision(key_df_collision);
-      auto selected_negTracks_in_this_event = emh_ele->GetTracksPerCollision(key_df_collision);
+      auto& selected_posTracks_in_this_event = emh_pos->GetTracksPerCollision(key_df_collision);
+      auto& selected_negTracks_in_this_event = emh_ele->GetTracksPerCollision(key_df_collision);
       // LOGF(info, "N selected tracks in current event (%d, %d), zvtx = %f, centrality = %f , npos = %d , nele = %d, nuls = %d , nlspp = %d, nlsmm = %d", ndf, collision.globalIndex(), collision.posZ(), centralities[cfgCentEstimator], selected_posTracks_in_this_event.size(), selected_negTracks_in_this_event.size(), nuls, nlspp, nlsmm);
 
-      auto collisionIds_in_mixing_pool = emh_pos->GetCollisionIdsFromEventPool(key_bin); // pos/ele does not matter.
+      int nCollisions_in_mixing_pool = emh_pos->GetNCollisionsInEventPool(key_bin); // pos/ele does not matter.
 
-      for (auto& mix_dfId_collisionId : collisionIds_in_mixing_pool) {
+      for (int iMix = 0; iMix < nCollisions_in_mixing_pool; iMix++) {
+        auto& mix_dfId_collisionId = emh_pos->GetCollisionIdFromEventPool(key_bin, iMix);
         int mix_dfId = mix_dfId_collisionId.first;
         int mix_collisionId = mix_dfId_collisionId.second;
 
@@ -609,8 +610,8 @@ struct dielectronQC {
           continue;
         }
 
-        auto posTracks_from_event_pool = emh_pos->GetTracksPerCollision(mix_dfId_collisionId);
-        auto negTracks_from_event_pool = emh_ele->GetTracksPerCollision(mix_dfId_collisionId);
+        auto& posTracks_from_event_pool = emh_pos->GetTracksPerCollision(key_bin, iMix);
+        auto& negTracks_from_event_pool = emh_ele->GetTracksPerCollision(key_bin, iMix);
         // LOGF(info, "Do event mixing: current event (%d, %d) | event pool (%d, %d), npos = %d , nele = %d", ndf, collision.globalIndex(), mix_dfId, mix_collisionId, posTracks_from_event_pool.size(), negTracks_from_event_pool.size());
 
         for (auto& pos : selected_posTracks_in_this_event) { // ULS mix
@@ -15,12 +15,16 @@
 #ifndef PWGEM_PHOTONMESON_UTILS_EVENTMIXINGHANDLER_H_
 #define PWGEM_PHOTONMESON_UTILS_EVENTMIXINGHANDLER_H_
 
+#include <algorithm>
 #include <map>
 #include <utility>
 #include <vector>
 
 namespace o2::aod::pwgem::photonmeson::utils
 {
+// T : key of the mixing bin, U : key of the collision, V : track
+// The pool of each bin is a ring buffer of fNdepth collisions. The oldest collision of a full pool is replaced in O(1),
+// and its track buffer is reused for the new collision, so that the memory does not grow over the dataframes.
 template <typename T, typename U, typename V>
 class EventMixingHandler
 {
@@ -29,49 +33,94 @@ class EventMixingHandler
   {
     fNdepth = 0;
     fMapMixBins.clear();
-    fMap_Tracks_per_collision.clear();
+    fCurrentTracks.clear();
   }
 
   explicit EventMixingHandler(int ndepth)
   {
     fNdepth = ndepth;
     fMapMixBins.clear();
-    fMap_Tracks_per_collision.clear();
+    fCurrentTracks.clear();
   }
 
   ~EventMixingHandler()
   {
     fMapMixBins.clear();
-    fMap_Tracks_per_collision.clear();
+    fCurrentTracks.clear();
   }
 
   void SetNdepth(int ndepth) { fNdepth = ndepth; }
 
+  // adds a track to the collision being processed. The tracks of a previous collision which was not added to the pool are discarded.
   void AddTrackToEventPool(U key_df_collision, V obj)
   {
-    fMap_Tracks_per_collision[key_df_collision].emplace_back(obj);
+    if (key_df_collision != fCurrentCollision) {
+      fCurrentCollision = key_df_collision;
+      fCurrentTracks.clear();
+    }
+    fCurrentTracks.emplace_back(obj);
   }
 
-  std::vector<U> GetCollisionIdsFromEventPool(T key_bin) { return fMapMixBins[key_bin]; }
-  std::vector<V> GetTracksPerCollision(T key_bin, int index) { return fMap_Tracks_per_collision[fMapMixBins[key_bin][index]]; }
-  std::vector<V> GetTracksPerCollision(U key_df_collision) { return fMap_Tracks_per_collision[key_df_collision]; }
+  // tracks of the collision being processed, empty if none was added
+  const std::vector<V>& GetTracksPerCollision(U key_df_collision)
+  {
+    if (key_df_collision != fCurrentCollision) {
+      fCurrentCollision = key_df_collision;
+      fCurrentTracks.clear();
+    }
+    return fCurrentTracks;
+  }
+
+  // collisions in the pool of a bin, from the oldest to the most recent. The references are valid until the next call to AddCollisionIdAtLast
+  int GetNCollisionsInEventPool(T key_bin) { return fMapMixBins[key_bin].nCollisions; }
+  const U& GetCollisionIdFromEventPool(T key_bin, int index)
+  {
+    auto& pool = fMapMixBins[key_bin];
+    return pool.collisionIds[pool.slot(index, fNdepth)];
+  }
+  const std::vector<V>& GetTracksPerCollision(T key_bin, int index)
+  {
+    auto& pool = fMapMixBins[key_bin];
+    return pool.tracks[pool.slot(index, fNdepth)];
+  }
 
   // call this function at the end of collision loop
   void AddCollisionIdAtLast(T key_bin, U key_df_collision)
   {
-    // LOGF(info, "fMapMixBins[key_bin].size() = %d", fMapMixBins[key_bin].size());
-    if (static_cast<int>(fMapMixBins[key_bin].size()) >= fNdepth) {
-      fMap_Tracks_per_collision[fMapMixBins[key_bin][0]].clear();
-      fMap_Tracks_per_collision[fMapMixBins[key_bin][0]].shrink_to_fit();
-      fMapMixBins[key_bin].erase(fMapMixBins[key_bin].begin());
+    if (fNdepth < 1) {
+      return;
+    }
+    auto& pool = fMapMixBins[key_bin];
+    if (pool.collisionIds.empty()) {
+      pool.collisionIds.resize(fNdepth);
+      pool.tracks.resize(fNdepth);
     }
-    fMapMixBins[key_bin].emplace_back(key_df_collision);
+    if (key_df_collision != fCurrentCollision) { // no track was added for this collision
+      fCurrentTracks.clear();
+    }
+    pool.collisionIds[pool.next] = key_df_collision;
+    pool.tracks[pool.next].swap(fCurrentTracks); // no copy, the buffer of the replaced collision is reused
+    fCurrentTracks.clear();
+    fCurrentCollision = key_df_collision;
+    pool.next = (pool.next + 1) % fNdepth;
+    pool.nCollisions = std::min(pool.nCollisions + 1, fNdepth);
   }
 
  private:
-  int fNdepth;                                           // depth of event mixing
-  std::map<T, std::vector<U>> fMapMixBins;               // map : e.g. <zbin, centbin, epbin> -> pair<df index, global collision index>
-  std::map<U, std::vector<V>> fMap_Tracks_per_collision; // map : e.g. pair<df index, global collision index> -> track array
+  struct MixingPool {
+    std::vector<U> collisionIds;        // ring buffer of the collision keys
+    std::vector<std::vector<V>> tracks; // ring buffer of the track arrays
+    int next = 0;                       // slot of the next collision
+    int nCollisions = 0;                // number of collisions in the pool
+
+    // slot of the index-th collision from the oldest one
+    int slot(int index, int ndepth) const { return ((nCollisions < ndepth ? 0 : next) + index) % ndepth; }
+  };
+
+  int fNdepth;                         // depth of event mixing
+  std::map<T, MixingPool> fMapMixBins; // map : e.g. <zbin, centbin, epbin> -> pool of pair<df index, global collision index> and track arrays
+  U fCurrentCollision{};               // key of the collision being processed
+  std::vector<V> fCurrentTracks;       // tracks of the collision being processed
 };
 } // namespace o2::aod::pwgem::photonmeson::utils
 #endif // PWGEM_PHOTONMESON_UTILS_EVENTMIXINGHANDLER_H_
@@ -106,6 +106,19 @@ inline void Vtx_recalculation(o2::base::Propagator* prop, T1 lTrackPos, T2 lTrac
   xyz[2] = (trackPosInformationCopy.getZ() * helixNeg.rC + trackNegInformationCopy.getZ() * helixPos.rC) / (helixPos.rC + helixNeg.rC);
 }
 //_______________________________________________________________________
+// conversion point in the transverse plane as in Vtx_recalculation, from the helix centers only, i.e. without propagation.
+template <typename TrackPrecision = float, typename T1, typename T2>
+inline void Vtx_recalculationXY(o2::base::Propagator* prop, T1 lTrackPos, T2 lTrackNeg, float xy[2])
+{
+  float bz = prop->getNominalBz();
+  o2::track::TrackParametrizationWithError<TrackPrecision> trackPosInformation = getTrackParCov(lTrackPos);
+  o2::track::TrackParametrizationWithError<TrackPrecision> trackNegInformation = getTrackParCov(lTrackNeg);
+  o2::track::TrackAuxPar helixPos(trackPosInformation, bz);
+  o2::track::TrackAuxPar helixNeg(trackNegInformation, bz);
+  xy[0] = (helixPos.xC * helixNeg.rC + helixNeg.xC * helixPos.rC) / (helixPos.rC + helixNeg.rC);
+  xy[1] = (helixPos.yC * helixNeg.rC + helixNeg.yC * helixPos.rC) / (helixPos.rC + helixNeg.rC);
+}
+//_______________________________________________________________________
 inline float getPhivPair(float pxpos, float pypos, float pzpos, float pxneg, float pyneg, float pzneg, int cpos, int cneg, float bz)
 {
   // cos(phiv) = w*a /|w||a|
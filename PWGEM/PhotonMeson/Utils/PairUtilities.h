@@ -17,6 +17,7 @@
 
 #include <TVector2.h>
 #include <cmath>
+#include <cstdint>
 
 namespace o2::aod::photonpair
 {
@@ -43,6 +44,20 @@ bool IsSelectedPair(TG1 const& g1, TG2 const& g2, TCut1 const& cut1, TCut2 const
   return (is_g1_selected && is_g2_selected);
 }
 
+// bit i of the mask is set if the photon is selected by cuts[i], at most 64 cuts are evaluated.
+// The pair loops looking up the bits evaluate each cut once per photon instead of once per pair.
+template <typename U, typename TG, typename TCuts>
+uint64_t GetSelectionMask(TG const& g, TCuts const& cuts)
+{
+  uint64_t mask = 0;
+  for (size_t icut = 0; icut < cuts.size() && icut < 64; icut++) {
+    if (cuts[icut].template IsSelected<U>(g)) {
+      mask |= (static_cast<uint64_t>(1) << icut);
+    }
+  }
+  return mask;
+}
+
 template <typename TV0Leg, typename TCluster>
 bool DoesV0LegMatchWithCluster(TV0Leg const& v0leg, TCluster const& cluster, const float max_deta, const float max_dphi, const float max_Ep_width)
 {
@@ -17,8 +17,10 @@
 #ifndef PWGHF_CORE_HFMLRESPONSED0TOKPI_H_
 #define PWGHF_CORE_HFMLRESPONSED0TOKPI_H_
 
+#include <array>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "CommonConstants/PhysicsConstants.h"
@@ -34,43 +36,39 @@
 #FEATURE, static_cast < uint8_t>(InputFeaturesD0ToKPi::FEATURE) \
   }
 
-// Check if the index of mCachedIndices (index associated to a FEATURE)
+// Check if the index of the requested feature (index associated to a FEATURE)
 // matches the entry in EnumInputFeatures associated to this FEATURE
-// if so, the inputFeatures vector is filled with the FEATURE's value
+// if so, the FEATURE's value is returned
 // by calling the corresponding GETTER from OBJECT
 #define CHECK_AND_FILL_VEC_D0_FULL(OBJECT, FEATURE, GETTER)   \
   case static_cast<uint8_t>(InputFeaturesD0ToKPi::FEATURE): { \
-    inputFeatures.emplace_back(OBJECT.GETTER());              \
-    break;                                                    \
+    return OBJECT.GETTER();                                   \
   }
 
 // Specific case of CHECK_AND_FILL_VEC_D0_FULL(OBJECT, FEATURE, GETTER)
 // where OBJECT is named candidate and FEATURE = GETTER
 #define CHECK_AND_FILL_VEC_D0(GETTER)                        \
   case static_cast<uint8_t>(InputFeaturesD0ToKPi::GETTER): { \
-    inputFeatures.emplace_back(candidate.GETTER());          \
-    break;                                                   \
+    return candidate.GETTER();                               \
   }
 
 // Variation of CHECK_AND_FILL_VEC_D0_FULL(OBJECT, FEATURE, GETTER)
 // where GETTER is a method of hfHelper
 #define CHECK_AND_FILL_VEC_D0_HFHELPER(OBJECT, FEATURE, GETTER) \
   case static_cast<uint8_t>(InputFeaturesD0ToKPi::FEATURE): {   \
-    inputFeatures.emplace_back(hfHelper.GETTER(OBJECT));        \
-    break;                                                      \
+    return hfHelper.GETTER(OBJECT);                             \
   }
 
 // Variation of CHECK_AND_FILL_VEC_D0_HFHELPER(OBJECT, FEATURE, GETTER)
 // where GETTER1 and GETTER2 are methods of hfHelper, and the variable
-// is filled depending on whether it is a D0 or a D0bar
+// is returned depending on whether it is a D0 or a D0bar
 #define CHECK_AND_FILL_VEC_D0_HFHELPER_SIGNED(OBJECT, FEATURE, GETTER1, GETTER2) \
   case static_cast<uint8_t>(InputFeaturesD0ToKPi::FEATURE): {                    \
     if (pdgCode == o2::constants::physics::kD0) {                                \
-      inputFeatures.emplace_back(hfHelper.GETTER1(OBJECT));                      \
+      return hfHelper.GETTER1(OBJECT);                                           \
     } else {                                                                     \
-      inputFeatures.emplace_back(hfHelper.GETTER2(OBJECT));                      \
+      return hfHelper.GETTER2(OBJECT);                                           \
     }                                                                            \
-    break;                                                                       \
   }
 
 namespace o2::analysis
@@ -119,6 +117,9 @@ class HfMlResponseD0ToKPi : public HfMlResponse<TypeOutputScore>
 
   HfHelper hfHelper;
 
+  /// Number of entries in InputFeaturesD0ToKPi
+  static constexpr std::size_t NInputFeatures = static_cast<std::size_t>(InputFeaturesD0ToKPi::ct) + 1;
+
   /// Method to get the input features vector needed for ML inference
   /// \param candidate is the D0 candidate
   /// \param prong0 is the candidate's prong0
@@ -128,47 +129,88 @@ class HfMlResponseD0ToKPi : public HfMlResponse<TypeOutputScore>
   std::vector<float> getInputFeatures(T1 const& candidate,
                                       T2 const& prong0, T2 const& prong1, int const& pdgCode)
   {
-    std::vector<float> inputFeatures;
+    std::vector<float> inputFeatures(MlResponse<TypeOutputScore>::mCachedIndices.size());
+    fillInputFeatures(candidate, prong0, prong1, pdgCode, inputFeatures.data());
+    return inputFeatures;
+  }
+
+  /// Method to write the input features needed for ML inference into a buffer, e.g. the batch buffer of MlResponse::isSelectedMlFill
+  /// The configured features are read through a table with one accessor per entry of InputFeaturesD0ToKPi, generated at compile time
+  /// \param candidate is the D0 candidate
+  /// \param prong0 is the candidate's prong0
+  /// \param prong1 is the candidate's prong1
+  /// \param inputFeatures is a pointer to the getNInputFeatures() elements to be filled
+  template <typename T1, typename T2, typename TypeBuffer>
+  void fillInputFeatures(T1 const& candidate,
+                         T2 const& prong0, T2 const& prong1, int const& pdgCode, TypeBuffer* inputFeatures)
+  {
+    using Accessor = float (*)(HfMlResponseD0ToKPi&, T1 const&, T2 const&, T2 const&, int const&);
+    static constexpr auto accessors = []<std::size_t... iFeatures>(std::index_sequence<iFeatures...>) {
+      return std::array<Accessor, NInputFeatures>{&accessInputFeature<iFeatures, T1, T2>...};
+    }(std::make_index_sequence<NInputFeatures>{});
 
+    std::size_t iFeature{0};
     for (const auto& idx : MlResponse<TypeOutputScore>::mCachedIndices) {
-      switch (idx) {
-        CHECK_AND_FILL_VEC_D0(chi2PCA);
-        CHECK_AND_FILL_VEC_D0(decayLength);
-        CHECK_AND_FILL_VEC_D0(decayLengthXY);
-        CHECK_AND_FILL_VEC_D0(decayLengthNormalised);
-        CHECK_AND_FILL_VEC_D0(decayLengthXYNormalised);
-        CHECK_AND_FILL_VEC_D0(ptProng0);
-        CHECK_AND_FILL_VEC_D0(ptProng1);
-        CHECK_AND_FILL_VEC_D0_FULL(candidate, impactParameterXY0, impactParameter0);
-        CHECK_AND_FILL_VEC_D0_FULL(candidate, impactParameterXY1, impactParameter1);
-        CHECK_AND_FILL_VEC_D0(impactParameterZ0);
-        CHECK_AND_FILL_VEC_D0(impactParameterZ1);
-        // TPC PID variables
-        CHECK_AND_FILL_VEC_D0_FULL(prong0, nSigTpcPi0, tpcNSigmaPi);
-        CHECK_AND_FILL_VEC_D0_FULL(prong0, nSigTpcKa0, tpcNSigmaKa);
-        CHECK_AND_FILL_VEC_D0_FULL(prong1, nSigTpcPi1, tpcNSigmaPi);
-        CHECK_AND_FILL_VEC_D0_FULL(prong1, nSigTpcKa1, tpcNSigmaKa);
-        // TOF PID variables
-        CHECK_AND_FILL_VEC_D0_FULL(prong0, nSigTofPi0, tofNSigmaPi);
-        CHECK_AND_FILL_VEC_D0_FULL(prong0, nSigTofKa0, tofNSigmaKa);
-        CHECK_AND_FILL_VEC_D0_FULL(prong1, nSigTofPi1, tofNSigmaPi);
-        CHECK_AND_FILL_VEC_D0_FULL(prong1, nSigTofKa1, tofNSigmaKa);
-        // Combined PID variables
-        CHECK_AND_FILL_VEC_D0_FULL(prong0, nSigTpcTofPi0, tpcTofNSigmaPi);
-        CHECK_AND_FILL_VEC_D0_FULL(prong0, nSigTpcTofKa0, tpcTofNSigmaKa);
-        CHECK_AND_FILL_VEC_D0_FULL(prong1, nSigTpcTofPi1, tpcTofNSigmaPi);
-        CHECK_AND_FILL_VEC_D0_FULL(prong1, nSigTpcTofKa1, tpcTofNSigmaKa);
-
-        CHECK_AND_FILL_VEC_D0(maxNormalisedDeltaIP);
-        CHECK_AND_FILL_VEC_D0_FULL(candidate, impactParameterProduct, impactParameterProduct);
-        CHECK_AND_FILL_VEC_D0_HFHELPER_SIGNED(candidate, cosThetaStar, cosThetaStarD0, cosThetaStarD0bar);
-        CHECK_AND_FILL_VEC_D0(cpa);
-        CHECK_AND_FILL_VEC_D0(cpaXY);
-        CHECK_AND_FILL_VEC_D0_HFHELPER(candidate, ct, ctD0);
-      }
+      inputFeatures[iFeature++] = static_cast<TypeBuffer>(accessors[idx](*this, candidate, prong0, prong1, pdgCode));
     }
+  }
 
-    return inputFeatures;
+  /// Method to get one input feature needed for ML inference
+  /// \param idx is the index of the feature in InputFeaturesD0ToKPi
+  /// \param candidate is the D0 candidate
+  /// \param prong0 is the candidate's prong0
+  /// \param prong1 is the candidate's prong1
+  /// \return value of the input feature
+  template <typename T1, typename T2>
+  float getInputFeature(uint8_t idx, T1 const& candidate,
+                        T2 const& prong0, T2 const& prong1, int const& pdgCode)
+  {
+    switch (idx) {
+      CHECK_AND_FILL_VEC_D0(chi2PCA);
+      CHECK_AND_FILL_VEC_D0(decayLength);
+      CHECK_AND_FILL_VEC_D0(decayLengthXY);
+      CHECK_AND_FILL_VEC_D0(decayLengthNormalised);
+      CHECK_AND_FILL_VEC_D0(decayLengthXYNormalised);
+      CHECK_AND_FILL_VEC_D0(ptProng0);
+      CHECK_AND_FILL_VEC_D0(ptProng1);
+      CHECK_AND_FILL_VEC_D0_FULL(candidate, impactParameterXY0, impactParameter0);
+      CHECK_AND_FILL_VEC_D0_FULL(candidate, impactParameterXY1, impactParameter1);
+      CHECK_AND_FILL_VEC_D0(impactParameterZ0);
+      CHECK_AND_FILL_VEC_D0(impactParameterZ1);
+      // TPC PID variables
+      CHECK_AND_FILL_VEC_D0_FULL(prong0, nSigTpcPi0, tpcNSigmaPi);
+      CHECK_AND_FILL_VEC_D0_FULL(prong0, nSigTpcKa0, tpcNSigmaKa);
+      CHECK_AND_FILL_VEC_D0_FULL(prong1, nSigTpcPi1, tpcNSigmaPi);
+      CHECK_AND_FILL_VEC_D0_FULL(prong1, nSigTpcKa1, tpcNSigmaKa);
+      // TOF PID variables
+      CHECK_AND_FILL_VEC_D0_FULL(prong0, nSigTofPi0, tofNSigmaPi);
+      CHECK_AND_FILL_VEC_D0_FULL(prong0, nSigTofKa0, tofNSigmaKa);
+      CHECK_AND_FILL_VEC_D0_FULL(prong1, nSigTofPi1, tofNSigmaPi);
+      CHECK_AND_FILL_VEC_D0_FULL(prong1, nSigTofKa1, tofNSigmaKa);
+      // Combined PID variables
+      CHECK_AND_FILL_VEC_D0_FULL(prong0, nSigTpcTofPi0, tpcTofNSigmaPi);
+      CHECK_AND_FILL_VEC_D0_FULL(prong0, nSigTpcTofKa0, tpcTofNSigmaKa);
+      CHECK_AND_FILL_VEC_D0_FULL(prong1, nSigTpcTofPi1, tpcTofNSigmaPi);
+      CHECK_AND_FILL_VEC_D0_FULL(prong1, nSigTpcTofKa1, tpcTofNSigmaKa);
+
+      CHECK_AND_FILL_VEC_D0(maxNormalisedDeltaIP);
+      CHECK_AND_FILL_VEC_D0_FULL(candidate, impactParameterProduct, impactParameterProduct);
+      CHECK_AND_FILL_VEC_D0_HFHELPER_SIGNED(candidate, cosThetaStar, cosThetaStarD0, cosThetaStarD0bar);
+      CHECK_AND_FILL_VEC_D0(cpa);
+      CHECK_AND_FILL_VEC_D0(cpaXY);
+      CHECK_AND_FILL_VEC_D0_HFHELPER(candidate, ct, ctD0);
+    }
+    LOG(fatal) << "Input feature " << static_cast<int>(idx) << " not available!";
+    return 0.f;
+  }
+
+ private:
+  /// Accessor to the input feature idx, the entries of the table in fillInputFeatures
+  template <std::size_t idx, typename T1, typename T2>
+  static float accessInputFeature(HfMlResponseD0ToKPi& mlResponse, T1 const& candidate,
+                                  T2 const& prong0, T2 const& prong1, int const& pdgCode)
+  {
+    return mlResponse.getInputFeature(static_cast<uint8_t>(idx), candidate, prong0, prong1, pdgCode);
   }
 
  protected:
@@ -16,6 +16,8 @@
 #ifndef PWGHF_CORE_HFMLRESPONSELCTOPKPI_H_
 #define PWGHF_CORE_HFMLRESPONSELCTOPKPI_H_
 
+#include <array>
+#include <utility>
 #include <vector>
 
 #include "PWGHF/Core/HfMlResponse.h"
@@ -28,30 +30,27 @@
 #FEATURE, static_cast < uint8_t>(InputFeaturesLcToPKPi::FEATURE) \
   }
 
-// Check if the index of mCachedIndices (index associated to a FEATURE)
+// Check if the index of the requested feature (index associated to a FEATURE)
 // matches the entry in EnumInputFeatures associated to this FEATURE
-// if so, the inputFeatures vector is filled with the FEATURE's value
+// if so, the FEATURE's value is returned
 // by calling the corresponding GETTER from OBJECT
 #define CHECK_AND_FILL_VEC_LCTOPKPI_FULL(OBJECT, FEATURE, GETTER) \
   case static_cast<uint8_t>(InputFeaturesLcToPKPi::FEATURE): {    \
-    inputFeatures.emplace_back(OBJECT.GETTER());                  \
-    break;                                                        \
+    return OBJECT.GETTER();                                       \
   }
 
 // Specific case of CHECK_AND_FILL_VEC_LCTOPKPI_FULL(OBJECT, FEATURE, GETTER)
 // where OBJECT is named candidate and FEATURE = GETTER
 #define CHECK_AND_FILL_VEC_LCTOPKPI(GETTER)                   \
   case static_cast<uint8_t>(InputFeaturesLcToPKPi::GETTER): { \
-    inputFeatures.emplace_back(candidate.GETTER());           \
-    break;                                                    \
+    return candidate.GETTER();                                \
   }
 
 // Variation of CHECK_AND_FILL_VEC_LCTOPKPI_FULL(OBJECT, FEATURE, GETTER)
 // where GETTER is a method of hfHelper
 #define CHECK_AND_FILL_VEC_LCTOPKPI_HFHELPER(OBJECT, FEATURE, GETTER) \
   case static_cast<uint8_t>(InputFeaturesLcToPKPi::FEATURE): {        \
-    inputFeatures.emplace_back(hfHelper.GETTER(OBJECT));              \
-    break;                                                            \
+    return hfHelper.GETTER(OBJECT);                                   \
   }
 
 namespace o2::analysis
@@ -110,6 +109,9 @@ class HfMlResponseLcToPKPi : public HfMlResponse<TypeOutputScore>
   /// Default destructor
   virtual ~HfMlResponseLcToPKPi() = default;
 
+  /// Number of entries in InputFeaturesLcToPKPi
+  static constexpr std::size_t NInputFeatures = static_cast<std::size_t>(InputFeaturesLcToPKPi::tpcTofNSigmaPr2) + 1;
+
   /// Method to get the input features vector needed for ML inference
   /// \param candidate is the Lc candidate
   /// \param prong0 is the candidate's prong0
@@ -120,59 +122,102 @@ class HfMlResponseLcToPKPi : public HfMlResponse<TypeOutputScore>
   std::vector<float> getInputFeatures(T1 const& candidate,
                                       T2 const& prong0, T2 const& prong1, T2 const& prong2)
   {
-    std::vector<float> inputFeatures;
+    std::vector<float> inputFeatures(MlResponse<TypeOutputScore>::mCachedIndices.size());
+    fillInputFeatures(candidate, prong0, prong1, prong2, inputFeatures.data());
+    return inputFeatures;
+  }
+
+  /// Method to write the input features needed for ML inference into a buffer, e.g. the batch buffer of MlResponse::isSelectedMlFill
+  /// The configured features are read through a table with one accessor per entry of InputFeaturesLcToPKPi, generated at compile time
+  /// \param candidate is the Lc candidate
+  /// \param prong0 is the candidate's prong0
+  /// \param prong1 is the candidate's prong1
+  /// \param prong2 is the candidate's prong2
+  /// \param inputFeatures is a pointer to the getNInputFeatures() elements to be filled
+  template <typename T1, typename T2, typename TypeBuffer>
+  void fillInputFeatures(T1 const& candidate,
+                         T2 const& prong0, T2 const& prong1, T2 const& prong2, TypeBuffer* inputFeatures)
+  {
+    using Accessor = float (*)(T1 const&, T2 const&, T2 const&, T2 const&);
+    static constexpr auto accessors = []<std::size_t... iFeatures>(std::index_sequence<iFeatures...>) {
+      return std::array<Accessor, NInputFeatures>{&accessInputFeature<iFeatures, T1, T2>...};
+    }(std::make_index_sequence<NInputFeatures>{});
 
+    std::size_t iFeature{0};
     for (const auto& idx : MlResponse<TypeOutputScore>::mCachedIndices) {
-      switch (idx) {
-        CHECK_AND_FILL_VEC_LCTOPKPI(ptProng0);
-        CHECK_AND_FILL_VEC_LCTOPKPI(ptProng1);
-        CHECK_AND_FILL_VEC_LCTOPKPI(ptProng2);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, impactParameterXY0, impactParameter0);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, impactParameterXY1, impactParameter1);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, impactParameterXY2, impactParameter2);
-        CHECK_AND_FILL_VEC_LCTOPKPI(impactParameterZ0);
-        CHECK_AND_FILL_VEC_LCTOPKPI(impactParameterZ1);
-        CHECK_AND_FILL_VEC_LCTOPKPI(impactParameterZ2);
-        CHECK_AND_FILL_VEC_LCTOPKPI(decayLength);
-        CHECK_AND_FILL_VEC_LCTOPKPI(decayLengthXY);
-        CHECK_AND_FILL_VEC_LCTOPKPI(decayLengthXYNormalised);
-        CHECK_AND_FILL_VEC_LCTOPKPI(cpa);
-        CHECK_AND_FILL_VEC_LCTOPKPI(cpaXY);
-        CHECK_AND_FILL_VEC_LCTOPKPI(chi2PCA);
-        // TPC PID variables
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong0, tpcNSigmaP0, tpcNSigmaPr);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong0, tpcNSigmaKa0, tpcNSigmaKa);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong0, tpcNSigmaPi0, tpcNSigmaPi);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong1, tpcNSigmaP1, tpcNSigmaPr);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong1, tpcNSigmaKa1, tpcNSigmaKa);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong1, tpcNSigmaPi1, tpcNSigmaPi);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong2, tpcNSigmaP2, tpcNSigmaPr);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong2, tpcNSigmaKa2, tpcNSigmaKa);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong2, tpcNSigmaPi2, tpcNSigmaPi);
-        // TOF PID variables
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong0, tofNSigmaP0, tofNSigmaPr);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong0, tofNSigmaKa0, tofNSigmaKa);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong0, tofNSigmaPi0, tofNSigmaPi);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong1, tofNSigmaP1, tofNSigmaPr);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong1, tofNSigmaKa1, tofNSigmaKa);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong1, tofNSigmaPi1, tofNSigmaPi);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong2, tofNSigmaP2, tofNSigmaPr);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong2, tofNSigmaKa2, tofNSigmaKa);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong2, tofNSigmaPi2, tofNSigmaPi);
-        // Combined PID variables
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong0, tpcTofNSigmaPi0, tpcTofNSigmaPi);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong1, tpcTofNSigmaPi1, tpcTofNSigmaPi);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong2, tpcTofNSigmaPi2, tpcTofNSigmaPi);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong0, tpcTofNSigmaKa0, tpcTofNSigmaKa);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong1, tpcTofNSigmaKa1, tpcTofNSigmaKa);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong2, tpcTofNSigmaKa2, tpcTofNSigmaKa);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong0, tpcTofNSigmaPr0, tpcTofNSigmaPr);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong1, tpcTofNSigmaPr1, tpcTofNSigmaPr);
-        CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong2, tpcTofNSigmaPr2, tpcTofNSigmaPr);
-      }
+      inputFeatures[iFeature++] = static_cast<TypeBuffer>(accessors[idx](candidate, prong0, prong1, prong2));
     }
+  }
 
-    return inputFeatures;
+  /// Method to get one input feature needed for ML inference
+  /// \param idx is the index of the feature in InputFeaturesLcToPKPi
+  /// \param candidate is the Lc candidate
+  /// \param prong0 is the candidate's prong0
+  /// \param prong1 is the candidate's prong1
+  /// \param prong2 is the candidate's prong2
+  /// \return value of the input feature
+  template <typename T1, typename T2>
+  static float getInputFeature(uint8_t idx, T1 const& candidate,
+                               T2 const& prong0, T2 const& prong1, T2 const& prong2)
+  {
+    switch (idx) {
+      CHECK_AND_FILL_VEC_LCTOPKPI(ptProng0);
+      CHECK_AND_FILL_VEC_LCTOPKPI(ptProng1);
+      CHECK_AND_FILL_VEC_LCTOPKPI(ptProng2);
+      CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, impactParameterXY0, impactParameter0);
+      CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, impactParameterXY1, impactParameter1);
+      CHECK_AND_FILL_VEC_LCTOPKPI_FULL(candidate, impactParameterXY2, impactParameter2);
+      CHECK_AND_FILL_VEC_LCTOPKPI(impactParameterZ0);
+      CHECK_AND_FILL_VEC_LCTOPKPI(impactParameterZ1);
+      CHECK_AND_FILL_VEC_LCTOPKPI(impactParameterZ2);
+      CHECK_AND_FILL_VEC_LCTOPKPI(decayLength);
+      CHECK_AND_FILL_VEC_LCTOPKPI(decayLengthXY);
+      CHECK_AND_FILL_VEC_LCTOPKPI(decayLengthXYNormalised);
+      CHECK_AND_FILL_VEC_LCTOPKPI(cpa);
+      CHECK_AND_FILL_VEC_LCTOPKPI(cpaXY);
+      CHECK_AND_FILL_VEC_LCTOPKPI(chi2PCA);
+      // TPC PID variables
+      CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong0, tpcNSigmaP0, tpcNSigmaPr);
+      CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong0, tpcNSigmaKa0, tpcNSigmaKa);
+      CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong0, tpcNSigmaPi0, tpcNSigmaPi);
+      CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong1, tpcNSigmaP1, tpcNSigmaPr);
+      CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong1, tpcNSigmaKa1, tpcNSigmaKa);
+      CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong1, tpcNSigmaPi1, tpcNSigmaPi);
+      CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong2, tpcNSigmaP2, tpcNSigmaPr);
+      CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong2, tpcNSigmaKa2, tpcNSigmaKa);
+      CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong2, tpcNSigmaPi2, tpcNSigmaPi);
+      // TOF PID variables
+      CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong0, tofNSigmaP0, tofNSigmaPr);
+      CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong0, tofNSigmaKa0, tofNSigmaKa);
+      CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong0, tofNSigmaPi0, tofNSigmaPi);
+      CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong1, tofNSigmaP1, tofNSigmaPr);
+      CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong1, tofNSigmaKa1, tofNSigmaKa);
+      CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong1, tofNSigmaPi1, tofNSigmaPi);
+      CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong2, tofNSigmaP2, tofNSigmaPr);
+      CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong2, tofNSigmaKa2, tofNSigmaKa);
+      CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong2, tofNSigmaPi2, tofNSigmaPi);
+      // Combined PID variables
+      CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong0, tpcTofNSigmaPi0, tpcTofNSigmaPi);
+      CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong1, tpcTofNSigmaPi1, tpcTofNSigmaPi);
+      CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong2, tpcTofNSigmaPi2, tpcTofNSigmaPi);
+      CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong0, tpcTofNSigmaKa0, tpcTofNSigmaKa);
+      CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong1, tpcTofNSigmaKa1, tpcTofNSigmaKa);
+      CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong2, tpcTofNSigmaKa2, tpcTofNSigmaKa);
+      CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong0, tpcTofNSigmaPr0, tpcTofNSigmaPr);
+      CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong1, tpcTofNSigmaPr1, tpcTofNSigmaPr);
+      CHECK_AND_FILL_VEC_LCTOPKPI_FULL(prong2, tpcTofNSigmaPr2, tpcTofNSigmaPr);
+    }
+    LOG(fatal) << "Input feature " << static_cast<int>(idx) << " not available!";
+    return 0.f;
+  }
+
+ private:
+  /// Accessor to the input feature idx, the entries of the table in fillInputFeatures
+  template <std::size_t idx, typename T1, typename T2>
+  static float accessInputFeature(T1 const& candidate,
+                                  T2 const& prong0, T2 const& prong1, T2 const& prong2)
+  {
+    return getInputFeature(static_cast<uint8_t>(idx), candidate, prong0, prong1, prong2);
   }
 
  protected:
@@ -418,6 +418,69 @@ DECLARE_SOA_TABLE(HfPvRefitDstar, "AOD", "HFPVREFITDSTAR", //!
                   hf_pv_refit::PvRefitSigmaZ2,
                   o2::soa::Marker<2>);
 
+// secondary-vertex fit of the track-index skims, used by the candidate creators instead of refitting
+namespace hf_sv_fit
+{
+DECLARE_SOA_COLUMN(SvX, svX, float);               //!
+DECLARE_SOA_COLUMN(SvY, svY, float);               //!
+DECLARE_SOA_COLUMN(SvZ, svZ, float);               //!
+DECLARE_SOA_COLUMN(SvChi2PCA, svChi2PCA, float);   //! chi2 at the point of closest approach of the prongs
+DECLARE_SOA_COLUMN(SvSigmaX2, svSigmaX2, float);   //!
+DECLARE_SOA_COLUMN(SvSigmaXY, svSigmaXY, float);   //!
+DECLARE_SOA_COLUMN(SvSigmaY2, svSigmaY2, float);   //!
+DECLARE_SOA_COLUMN(SvSigmaXZ, svSigmaXZ, float);   //!
+DECLARE_SOA_COLUMN(SvSigmaYZ, svSigmaYZ, float);   //!
+DECLARE_SOA_COLUMN(SvSigmaZ2, svSigmaZ2, float);   //!
+DECLARE_SOA_COLUMN(SvPxProng0, svPxProng0, float); //! px of prong 0 at the secondary vertex
+DECLARE_SOA_COLUMN(SvPyProng0, svPyProng0, float); //!
+DECLARE_SOA_COLUMN(SvPzProng0, svPzProng0, float); //!
+DECLARE_SOA_COLUMN(SvPxProng1, svPxProng1, float); //! px of prong 1 at the secondary vertex
+DECLARE_SOA_COLUMN(SvPyProng1, svPyProng1, float); //!
+DECLARE_SOA_COLUMN(SvPzProng1, svPzProng1, float); //!
+DECLARE_SOA_COLUMN(SvPxProng2, svPxProng2, float); //! px of prong 2 at the secondary vertex
+DECLARE_SOA_COLUMN(SvPyProng2, svPyProng2, float); //!
+DECLARE_SOA_COLUMN(SvPzProng2, svPzProng2, float); //!
+} // namespace hf_sv_fit
+
+DECLARE_SOA_TABLE(HfSvFit2Prong, "AOD", "HFSVFIT2PRONG", //! Secondary-vertex fit of the 2-prong skims, joinable with Hf2Prongs
+                  hf_sv_fit::SvX,
+                  hf_sv_fit::SvY,
+                  hf_sv_fit::SvZ,
+                  hf_sv_fit::SvChi2PCA,
+                  hf_sv_fit::SvSigmaX2,
+                  hf_sv_fit::SvSigmaXY,
+                  hf_sv_fit::SvSigmaY2,
+                  hf_sv_fit::SvSigmaXZ,
+                  hf_sv_fit::SvSigmaYZ,
+                  hf_sv_fit::SvSigmaZ2,
+                  hf_sv_fit::SvPxProng0,
+                  hf_sv_fit::SvPyProng0,
+                  hf_sv_fit::SvPzProng0,
+                  hf_sv_fit::SvPxProng1,
+                  hf_sv_fit::SvPyProng1,
+                  hf_sv_fit::SvPzProng1);
+
+DECLARE_SOA_TABLE(HfSvFit3Prong, "AOD", "HFSVFIT3PRONG", //! Secondary-vertex fit of the 3-prong skims, joinable with Hf3Prongs
+                  hf_sv_fit::SvX,
+                  hf_sv_fit::SvY,
+                  hf_sv_fit::SvZ,
+                  hf_sv_fit::SvChi2PCA,
+                  hf_sv_fit::SvSigmaX2,
+                  hf_sv_fit::SvSigmaXY,
+                  hf_sv_fit::SvSigmaY2,
+                  hf_sv_fit::SvSigmaXZ,
+                  hf_sv_fit::SvSigmaYZ,
+                  hf_sv_fit::SvSigmaZ2,
+                  hf_sv_fit::SvPxProng0,
+                  hf_sv_fit::SvPyProng0,
+                  hf_sv_fit::SvPzProng0,
+                  hf_sv_fit::SvPxProng1,
+                  hf_sv_fit::SvPyProng1,
+                  hf_sv_fit::SvPzProng1,
+                  hf_sv_fit::SvPxProng2,
+                  hf_sv_fit::SvPyProng2,
+                  hf_sv_fit::SvPzProng2);
+
 // general decay properties
 namespace hf_cand
 {
@@ -16,6 +16,7 @@
 #ifndef PWGHF_DATAMODEL_DERIVEDTABLES_H_
 #define PWGHF_DATAMODEL_DERIVEDTABLES_H_
 
+#include <cstdint>
 #include <vector>
 
 #include "CommonConstants/PhysicsConstants.h"
@@ -234,6 +235,73 @@ DECLARE_SOA_COLUMN(NSigTpcTofPr1, nSigTpcTofPr1, float);
 DECLARE_SOA_COLUMN(NSigTpcTofPr2, nSigTpcTofPr2, float);
 } // namespace hf_cand_par
 
+// Candidate properties used for selection, stored with reduced precision
+namespace hf_cand_par_binned
+{
+/// Binning of the nσ stored with 8 bits: bins of width 0.1 centred on multiples of the bin width,
+/// absolute error <= 0.05 for |nσ| < 12.7, values outside the range (e.g. missing TOF) go to the under/overflow bins
+struct BinningNSigma {
+  using binned_t = int8_t;
+  static constexpr int nbins = (1 << 8 * sizeof(binned_t)) - 2;
+  static constexpr binned_t overflowBin = nbins >> 1;
+  static constexpr binned_t underflowBin = -(nbins >> 1);
+  static constexpr float binned_max = 12.7;
+  static constexpr float binned_min = -12.7;
+  static constexpr float bin_width = (binned_max - binned_min) / nbins;
+};
+
+/// Packs a nσ value with BinningNSigma
+inline BinningNSigma::binned_t packNSigma(float nSigma)
+{
+  if (nSigma <= BinningNSigma::binned_min) {
+    return BinningNSigma::underflowBin;
+  }
+  if (nSigma >= BinningNSigma::binned_max) {
+    return BinningNSigma::overflowBin;
+  }
+  return static_cast<BinningNSigma::binned_t>(nSigma / BinningNSigma::bin_width + (nSigma >= 0.f ? 0.5f : -0.5f));
+}
+
+/// Unpacks a nσ value stored with BinningNSigma
+inline float unpackNSigma(BinningNSigma::binned_t nSigmaBinned)
+{
+  return BinningNSigma::bin_width * static_cast<float>(nSigmaBinned);
+}
+
+// Binned nσ column and dynamic column with the getter of the corresponding float column of hf_cand_par
+#define DECLARE_SOA_HF_NSIGMA_BINNED_COLUMN(NAME, GETTER)                    \
+  DECLARE_SOA_COLUMN(NAME##Binned, GETTER##Binned, BinningNSigma::binned_t); \
+  DECLARE_SOA_DYNAMIC_COLUMN(NAME, GETTER,                                   \
+                             [](BinningNSigma::binned_t nSigmaBinned) -> float { return unpackNSigma(nSigmaBinned); });
+
+// TOF
+DECLARE_SOA_HF_NSIGMA_BINNED_COLUMN(NSigTofKa0, nSigTofKa0);
+DECLARE_SOA_HF_NSIGMA_BINNED_COLUMN(NSigTofKa1, nSigTofKa1);
+DECLARE_SOA_HF_NSIGMA_BINNED_COLUMN(NSigTofPi0, nSigTofPi0);
+DECLARE_SOA_HF_NSIGMA_BINNED_COLUMN(NSigTofPi1, nSigTofPi1);
+DECLARE_SOA_HF_NSIGMA_BINNED_COLUMN(NSigTofPi2, nSigTofPi2);
+DECLARE_SOA_HF_NSIGMA_BINNED_COLUMN(NSigTofPr0, nSigTofPr0);
+DECLARE_SOA_HF_NSIGMA_BINNED_COLUMN(NSigTofPr2, nSigTofPr2);
+// TPC
+DECLARE_SOA_HF_NSIGMA_BINNED_COLUMN(NSigTpcKa0, nSigTpcKa0);
+DECLARE_SOA_HF_NSIGMA_BINNED_COLUMN(NSigTpcKa1, nSigTpcKa1);
+DECLARE_SOA_HF_NSIGMA_BINNED_COLUMN(NSigTpcPi0, nSigTpcPi0);
+DECLARE_SOA_HF_NSIGMA_BINNED_COLUMN(NSigTpcPi1, nSigTpcPi1);
+DECLARE_SOA_HF_NSIGMA_BINNED_COLUMN(NSigTpcPi2, nSigTpcPi2);
+DECLARE_SOA_HF_NSIGMA_BINNED_COLUMN(NSigTpcPr0, nSigTpcPr0);
+DECLARE_SOA_HF_NSIGMA_BINNED_COLUMN(NSigTpcPr2, nSigTpcPr2);
+// TPC+TOF
+DECLARE_SOA_HF_NSIGMA_BINNED_COLUMN(NSigTpcTofKa0, nSigTpcTofKa0);
+DECLARE_SOA_HF_NSIGMA_BINNED_COLUMN(NSigTpcTofKa1, nSigTpcTofKa1);
+DECLARE_SOA_HF_NSIGMA_BINNED_COLUMN(NSigTpcTofPi0, nSigTpcTofPi0);
+DECLARE_SOA_HF_NSIGMA_BINNED_COLUMN(NSigTpcTofPi1, nSigTpcTofPi1);
+DECLARE_SOA_HF_NSIGMA_BINNED_COLUMN(NSigTpcTofPi2, nSigTpcTofPi2);
+DECLARE_SOA_HF_NSIGMA_BINNED_COLUMN(NSigTpcTofPr0, nSigTpcTofPr0);
+DECLARE_SOA_HF_NSIGMA_BINNED_COLUMN(NSigTpcTofPr2, nSigTpcTofPr2);
+
+#undef DECLARE_SOA_HF_NSIGMA_BINNED_COLUMN
+} // namespace hf_cand_par_binned
+
 // Candidate selection flags
 namespace hf_cand_sel
 {
@@ -303,6 +371,52 @@ DECLARE_SOA_TABLE(HfD0Pars, "AOD", "HFD0PAR", //! Table with candidate propertie
                   hf_cand_par::ImpactParameterProduct,
                   soa::Marker<MarkerD0>);
 
+// HfD0Pars split in topological properties and PID, with the nσ stored with 8 bits
+DECLARE_SOA_TABLE(HfD0Tops, "AOD", "HFD0TOP", //! Table with candidate topological properties used for selection
+                  hf_cand::Chi2PCA,
+                  hf_cand_par::Cpa,
+                  hf_cand_par::CpaXY,
+                  hf_cand_par::DecayLength,
+                  hf_cand_par::DecayLengthXY,
+                  hf_cand_par::DecayLengthNormalised,
+                  hf_cand_par::DecayLengthXYNormalised,
+                  hf_cand_par::PtProng0,
+                  hf_cand_par::PtProng1,
+                  hf_cand::ImpactParameter0,
+                  hf_cand::ImpactParameter1,
+                  hf_cand_par::ImpactParameterNormalised0,
+                  hf_cand_par::ImpactParameterNormalised1,
+                  hf_cand_par::MaxNormalisedDeltaIP,
+                  hf_cand_par::ImpactParameterProduct,
+                  soa::Marker<MarkerD0>);
+
+DECLARE_SOA_TABLE(HfD0PidBs, "AOD", "HFD0PIDB", //! Table with PID nσ of the prongs used for selection, stored with 8 bits
+                  hf_cand_par_binned::NSigTpcPi0Binned,
+                  hf_cand_par_binned::NSigTpcKa0Binned,
+                  hf_cand_par_binned::NSigTofPi0Binned,
+                  hf_cand_par_binned::NSigTofKa0Binned,
+                  hf_cand_par_binned::NSigTpcTofPi0Binned,
+                  hf_cand_par_binned::NSigTpcTofKa0Binned,
+                  hf_cand_par_binned::NSigTpcPi1Binned,
+                  hf_cand_par_binned::NSigTpcKa1Binned,
+                  hf_cand_par_binned::NSigTofPi1Binned,
+                  hf_cand_par_binned::NSigTofKa1Binned,
+                  hf_cand_par_binned::NSigTpcTofPi1Binned,
+                  hf_cand_par_binned::NSigTpcTofKa1Binned,
+                  hf_cand_par_binned::NSigTpcPi0<hf_cand_par_binned::NSigTpcPi0Binned>,
+                  hf_cand_par_binned::NSigTpcKa0<hf_cand_par_binned::NSigTpcKa0Binned>,
+                  hf_cand_par_binned::NSigTofPi0<hf_cand_par_binned::NSigTofPi0Binned>,
+                  hf_cand_par_binned::NSigTofKa0<hf_cand_par_binned::NSigTofKa0Binned>,
+                  hf_cand_par_binned::NSigTpcTofPi0<hf_cand_par_binned::NSigTpcTofPi0Binned>,
+                  hf_cand_par_binned::NSigTpcTofKa0<hf_cand_par_binned::NSigTpcTofKa0Binned>,
+                  hf_cand_par_binned::NSigTpcPi1<hf_cand_par_binned::NSigTpcPi1Binned>,
+                  hf_cand_par_binned::NSigTpcKa1<hf_cand_par_binned::NSigTpcKa1Binned>,
+                  hf_cand_par_binned::NSigTofPi1<hf_cand_par_binned::NSigTofPi1Binned>,
+                  hf_cand_par_binned::NSigTofKa1<hf_cand_par_binned::NSigTofKa1Binned>,
+                  hf_cand_par_binned::NSigTpcTofPi1<hf_cand_par_binned::NSigTpcTofPi1Binned>,
+                  hf_cand_par_binned::NSigTpcTofKa1<hf_cand_par_binned::NSigTpcTofKa1Binned>,
+                  soa::Marker<MarkerD0>);
+
 DECLARE_SOA_TABLE(HfD0ParEs, "AOD", "HFD0PARE", //! Table with additional candidate properties used for selection
                   hf_cand::XSecondaryVertex,
                   hf_cand::YSecondaryVertex,
@@ -399,6 +513,60 @@ DECLARE_SOA_TABLE(Hf3PPars, "AOD", "HF3PPAR", //! Table with candidate propertie
                   hf_cand_par::NSigTpcTofPr2,
                   soa::Marker<Marker3P>);
 
+// Hf3PPars split in topological properties and PID, with the nσ stored with 8 bits
+DECLARE_SOA_TABLE(Hf3PTops, "AOD", "HF3PTOP", //! Table with candidate topological properties used for selection
+                  hf_cand::Chi2PCA,
+                  hf_cand::NProngsContributorsPV,
+                  hf_cand_par::Cpa,
+                  hf_cand_par::CpaXY,
+                  hf_cand_par::DecayLength,
+                  hf_cand_par::DecayLengthXY,
+                  hf_cand_par::DecayLengthNormalised,
+                  hf_cand_par::DecayLengthXYNormalised,
+                  hf_cand_par::PtProng0,
+                  hf_cand_par::PtProng1,
+                  hf_cand_par::PtProng2,
+                  hf_cand::ImpactParameter0,
+                  hf_cand::ImpactParameter1,
+                  hf_cand::ImpactParameter2,
+                  hf_cand_par::ImpactParameterNormalised0,
+                  hf_cand_par::ImpactParameterNormalised1,
+                  hf_cand_par::ImpactParameterNormalised2,
+                  soa::Marker<Marker3P>);
+
+DECLARE_SOA_TABLE(Hf3PPidBs, "AOD", "HF3PPIDB", //! Table with PID nσ of the prongs used for selection, stored with 8 bits
+                  hf_cand_par_binned::NSigTpcPi0Binned,
+                  hf_cand_par_binned::NSigTpcPr0Binned,
+                  hf_cand_par_binned::NSigTofPi0Binned,
+                  hf_cand_par_binned::NSigTofPr0Binned,
+                  hf_cand_par_binned::NSigTpcTofPi0Binned,
+                  hf_cand_par_binned::NSigTpcTofPr0Binned,
+                  hf_cand_par_binned::NSigTpcKa1Binned,
+                  hf_cand_par_binned::NSigTofKa1Binned,
+                  hf_cand_par_binned::NSigTpcTofKa1Binned,
+                  hf_cand_par_binned::NSigTpcPi2Binned,
+                  hf_cand_par_binned::NSigTpcPr2Binned,
+                  hf_cand_par_binned::NSigTofPi2Binned,
+                  hf_cand_par_binned::NSigTofPr2Binned,
+                  hf_cand_par_binned::NSigTpcTofPi2Binned,
+                  hf_cand_par_binned::NSigTpcTofPr2Binned,
+                  hf_cand_par_binned::NSigTpcPi0<hf_cand_par_binned::NSigTpcPi0Binned>,
+                  hf_cand_par_binned::NSigTpcPr0<hf_cand_par_binned::NSigTpcPr0Binned>,
+                  hf_cand_par_binned::NSigTofPi0<hf_cand_par_binned::NSigTofPi0Binned>,
+                  hf_cand_par_binned::NSigTofPr0<hf_cand_par_binned::NSigTofPr0Binned>,
+                  hf_cand_par_binned::NSigTpcTofPi0<hf_cand_par_binned::NSigTpcTofPi0Binned>,
+                  hf_cand_par_binned::NSigTpcTofPr0<hf_cand_par_binned::NSigTpcTofPr0Binned>,
+                  hf_cand_par_binned::NSigTpcKa1<hf_cand_par_binned::NSigTpcKa1Binned>,
+                  hf_cand_par_binned::NSigTofKa1<hf_cand_par_binned::NSigTofKa1Binned>,
+                  hf_cand_par_binned::NSigTpcTofKa1<hf_cand_par_binned::NSigTpcTofKa1Binned>,
+                  hf_cand_par_binned::NSigTpcPi2<hf_cand_par_binned::NSigTpcPi2Binned>,
+                  hf_cand_par_binned::NSigTpcPr2<hf_cand_par_binned::NSigTpcPr2Binned>,
+                  hf_cand_par_binned::NSigTofPi2<hf_cand_par_binned::NSigTofPi2Binned>,
+                  hf_cand_par_binned::NSigTofPr2<hf_cand_par_binned::NSigTofPr2Binned>,
+                  hf_cand_par_binned::NSigTpcTofPi2<hf_cand_par_binned::NSigTpcTofPi2Binned>,
+                  hf_cand_par_binned::NSigTpcTofPr2<hf_cand_par_binned::NSigTpcTofPr2Binned>,
+                  soa::Marker<Marker3P>);
+
 DECLARE_SOA_TABLE(Hf3PParEs, "AOD", "HF3PPARE", //! Table with additional candidate properties used for selection
                   hf_cand::XSecondaryVertex,
                   hf_cand::YSecondaryVertex,
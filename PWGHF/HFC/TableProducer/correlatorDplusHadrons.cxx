@@ -211,6 +211,29 @@ struct HfCorrelatorDplusHadrons {
      {"hDplusBin", "Dplus selected in pool Bin;pool Bin;entries", {HistType::kTH1F, {{9, 0., 9.}}}},
      {"hTracksBin", "Tracks selected in pool Bin;pool Bin;entries", {HistType::kTH1F, {{9, 0., 9.}}}}}};
 
+  /// Associated-hadron candidate, with the quantities used in the pairing with the Dplus candidates
+  struct SelectedTrack {
+    int64_t globalIndex;
+    float phi;
+    float eta;
+    float pt;
+  };
+  std::vector<SelectedTrack> selectedTracks; // tracks of the current collision passing the track selection
+
+  /// Selects the associated-hadron candidates of a collision once, instead of once per Dplus candidate
+  template <typename T>
+  void selectTracks(T const& tracks)
+  {
+    selectedTracks.clear();
+    for (const auto& track : tracks) {
+      // apply track selection
+      if (!track.isGlobalTrackWoDCA()) {
+        continue;
+      }
+      selectedTracks.push_back({track.globalIndex(), track.phi(), track.eta(), track.pt()});
+    }
+  }
+
   void init(InitContext&)
   {
     auto vbins = (std::vector<double>)binsPt;
@@ -249,6 +272,7 @@ struct HfCorrelatorDplusHadrons {
         return;
       }
       registry.fill(HIST("hMultiplicity"), nTracks);
+      selectTracks(tracks);
 
       int cntDplus = 0;
       for (const auto& candidate : candidates) {
@@ -275,22 +299,19 @@ struct HfCorrelatorDplusHadrons {
         entryDplus(candidate.phi(), candidate.eta(), candidate.pt(), hfHelper.invMassDplusToPiKPi(candidate), poolBin, gCollisionId, timeStamp);
         // Dplus-Hadron correlation dedicated section
         // if the candidate is a Dplus, search for Hadrons and evaluate correlations
-        for (const auto& track : tracks) {
-          // apply track selection
-          if (!track.isGlobalTrackWoDCA()) {
-            continue;
-          }
+        const double massDplus = hfHelper.invMassDplusToPiKPi(candidate);
+        for (const auto& track : selectedTracks) {
           // Removing Dplus daughters by checking track indices
-          if ((candidate.prong0Id() == track.globalIndex()) || (candidate.prong1Id() == track.globalIndex()) || (candidate.prong2Id() == track.globalIndex())) {
+          if ((candidate.prong0Id() == track.globalIndex) || (candidate.prong1Id() == track.globalIndex) || (candidate.prong2Id() == track.globalIndex)) {
             continue;
           }
-          entryDplusHadronPair(getDeltaPhi(track.phi(), candidate.phi()),
-                               track.eta() - candidate.eta(),
+          entryDplusHadronPair(getDeltaPhi(track.phi, candidate.phi()),
+                               track.eta - candidate.eta(),
                                candidate.pt(),
-                               track.pt(), poolBin);
-          entryDplusHadronRecoInfo(hfHelper.invMassDplusToPiKPi(candidate), 0);
+                               track.pt, poolBin);
+          entryDplusHadronRecoInfo(massDplus, 0);
           if (cntDplus == 0)
-            entryHadron(track.phi(), track.eta(), track.pt(), poolBin, gCollisionId, timeStamp);
+            entryHadron(track.phi, track.eta, track.pt, poolBin, gCollisionId, timeStamp);
         } // Hadron Tracks loop
         cntDplus++;
       } // end outer Dplus loop
@@ -322,6 +343,7 @@ struct HfCorrelatorDplusHadrons {
         return;
       }
       registry.fill(HIST("hMultiplicity"), nTracks);
+      selectTracks(tracks);
 
       // MC reco level
       bool flagDplusSignal = false;
@@ -358,20 +380,17 @@ struct HfCorrelatorDplusHadrons {
         // if the candidate is selected as Dplus, search for Hadron and evaluate correlations
         flagDplusSignal = candidate.flagMcMatchRec() == 1 << aod::hf_cand_3prong::DecayType::DplusToPiKPi;
 
-        for (const auto& track : tracks) {
-          // apply track selection
-          if (!track.isGlobalTrackWoDCA()) {
-            continue;
-          }
+        const double massDplus = hfHelper.invMassDplusToPiKPi(candidate);
+        for (const auto& track : selectedTracks) {
           // Removing Dplus daughters by checking track indices
-          if ((candidate.prong0Id() == track.globalIndex()) || (candidate.prong1Id() == track.globalIndex()) || (candidate.prong2Id() == track.globalIndex())) {
+          if ((candidate.prong0Id() == track.globalIndex) || (candidate.prong1Id() == track.globalIndex) || (candidate.prong2Id() == track.globalIndex)) {
             continue;
           }
-          entryDplusHadronPair(getDeltaPhi(track.phi(), candidate.phi()),
-                               track.eta() - candidate.eta(),
+          entryDplusHadronPair(getDeltaPhi(track.phi, candidate.phi()),
+                               track.eta - candidate.eta(),
                                candidate.pt(),
-                               track.pt(), poolBin);
-          entryDplusHadronRecoInfo(hfHelper.invMassDplusToPiKPi(candidate), flagDplusSignal);
+                               track.pt, poolBin);
+          entryDplusHadronRecoInfo(massDplus, flagDplusSignal);
         } // end inner loop (Tracks)
 
       } // end outer Dplus loop
@@ -196,6 +196,28 @@ struct femtoDreamPairTaskCharmHadrons {
     }
   }
 
+  std::vector<float> charmHadMasses; // invariant masses of the charm-hadron candidates of the current slice, in slice order
+
+  /// Invariant mass of a charm-hadron candidate under its selected mass hypothesis
+  template <typename CharmCand>
+  float getCharmHadMass(CharmCand const& cand)
+  {
+    if (cand.candidateSelFlag() == 1) {
+      return cand.m(std::array{o2::constants::physics::MassProton, o2::constants::physics::MassKPlus, o2::constants::physics::MassPiPlus});
+    }
+    return cand.m(std::array{o2::constants::physics::MassPiPlus, o2::constants::physics::MassKPlus, o2::constants::physics::MassProton});
+  }
+
+  /// Computes the masses of the charm-hadron candidates of a slice once, instead of once per pair
+  template <typename CandType>
+  void fillCharmHadMasses(CandType& SliceCharmHad)
+  {
+    charmHadMasses.clear();
+    for (auto const& cand : SliceCharmHad) {
+      charmHadMasses.push_back(getCharmHadMass(cand));
+    }
+  }
+
   /// This function processes the same event and takes care of all the histogramming
   template <bool isMc, typename PartitionType, typename CandType, typename TableTracks, typename TableCandidates, typename Collision>
   void doSameEvent(PartitionType& SliceTrk1, CandType& SliceCharmHad, TableTracks const& parts, TableCandidates const& candidates, Collision const& col)
@@ -206,7 +228,9 @@ struct femtoDreamPairTaskCharmHadrons {
 
       trackHistoPartOne.fillQA<isMc, false>(part, aod::femtodreamparticle::kPt, col.multNtr(), col.multV0M());
     }
-    for (auto const& [p1, p2] : combinations(CombinationsFullIndexPolicy(SliceTrk1, SliceCharmHad))) {
+    // same pair order as CombinationsFullIndexPolicy, with the charm-hadron candidates in the inner loop
+    fillCharmHadMasses(SliceCharmHad);
+    for (auto const& p1 : SliceTrk1) {
       // proton track charge
       float chargeTrack = 0.;
       if ((p1.cut() & 1) == 1) {
@@ -215,55 +239,53 @@ struct femtoDreamPairTaskCharmHadrons {
         chargeTrack = negativeCharge;
       }
 
-      if (chargeTrack != p2.charge())
-        continue;
-      float kstar = FemtoDreamMath::getkstar(p1, MassOne, p2, MassTwo);
-      if (kstar > ConfOptHighkstarCut)
-        continue;
+      size_t iCand = 0;
+      for (auto const& p2 : SliceCharmHad) {
+        const float invMass = charmHadMasses[iCand++];
+        if (chargeTrack != p2.charge())
+          continue;
+        float kstar = FemtoDreamMath::getkstar(p1, MassOne, p2, MassTwo);
+        if (kstar > ConfOptHighkstarCut)
+          continue;
 
-      if (chargeTrack == 1) {
-        partSign = 1;
-      } else {
-        partSign = 1 << 1;
-      }
+        if (chargeTrack == 1) {
+          partSign = 1;
+        } else {
+          partSign = 1 << 1;
+        }
 
-      if (ConfOptUseCPR.value) {
-        if (pairCloseRejection.isClosePair(p1, p2, parts, col.magField())) {
+        if (ConfOptUseCPR.value) {
+          if (pairCloseRejection.isClosePair(p1, p2, parts, col.magField())) {
+            continue;
+          }
+        }
+
+        if (!pairCleaner.isCleanPair(p1, p2, parts)) {
           continue;
         }
-      }
 
-      if (!pairCleaner.isCleanPair(p1, p2, parts)) {
-        continue;
-      }
-      float invMass;
-      if (p2.candidateSelFlag() == 1) {
-        invMass = p2.m(std::array{o2::constants::physics::MassProton, o2::constants::physics::MassKPlus, o2::constants::physics::MassPiPlus});
-      } else {
-        invMass = p2.m(std::array{o2::constants::physics::MassPiPlus, o2::constants::physics::MassKPlus, o2::constants::physics::MassProton});
-      }
+        if (invMass < ConfHF_minInvMass || invMass > ConfHF_maxInvMass)
+          continue;
+        if (p2.pt() < ConfHF_minPt || p2.pt() > ConfHF_maxPt)
+          continue;
 
-      if (invMass < ConfHF_minInvMass || invMass > ConfHF_maxInvMass)
-        continue;
-      if (p2.pt() < ConfHF_minPt || p2.pt() > ConfHF_maxPt)
-        continue;
-
-      fillFemtoResult(
-        invMass,
-        p2.pt(),
-        p1.pt(),
-        p2.bdtBkg(),
-        p2.bdtPrompt(),
-        p2.bdtFD(),
-        kstar,
-        FemtoDreamMath::getkT(p1, MassOne, p2, MassTwo),
-        FemtoDreamMath::getmT(p1, MassOne, p2, MassTwo),
-        col.multNtr(),
-        col.multV0M(),
-        partSign,
-        processType);
-
-      sameEventCont.setPair<isMc, true>(p1, p2, col.multNtr(), col.multV0M(), ConfOptUse4D, ConfOptExtendedPlots, ConfOptsmearingByOrigin);
+        fillFemtoResult(
+          invMass,
+          p2.pt(),
+          p1.pt(),
+          p2.bdtBkg(),
+          p2.bdtPrompt(),
+          p2.bdtFD(),
+          kstar,
+          FemtoDreamMath::getkT(p1, MassOne, p2, MassTwo),
+          FemtoDreamMath::getmT(p1, MassOne, p2, MassTwo),
+          col.multNtr(),
+          col.multV0M(),
+          partSign,
+          processType);
+
+        sameEventCont.setPair<isMc, true>(p1, p2, col.multNtr(), col.multV0M(), ConfOptUse4D, ConfOptExtendedPlots, ConfOptsmearingByOrigin);
+      }
     }
   }
 
@@ -285,8 +307,8 @@ struct femtoDreamPairTaskCharmHadrons {
 
       auto SliceTrk1 = part1->sliceByCached(aod::femtodreamparticle::fdCollisionId, collision1.globalIndex(), cache);
       auto SliceCharmHad = PartitionHF->sliceByCached(aod::femtodreamparticle::fdCollisionId, collision2.globalIndex(), cache);
-      for (auto& [p1, p2] : combinations(CombinationsFullIndexPolicy(SliceTrk1, SliceCharmHad))) {
-
+      fillCharmHadMasses(SliceCharmHad);
+      for (auto const& p1 : SliceTrk1) {
         float chargeTrack = 0.;
         if ((p1.cut() & 1) == 1) {
           chargeTrack = positiveCharge;
@@ -294,48 +316,46 @@ struct femtoDreamPairTaskCharmHadrons {
           chargeTrack = negativeCharge;
         }
 
-        if (chargeTrack != p2.charge())
-          continue;
-        float kstar = FemtoDreamMath::getkstar(p1, MassOne, p2, MassTwo);
-        if (kstar > ConfOptHighkstarCut)
-          continue;
-
-        if (chargeTrack == 1) {
-          partSign = 1;
-        } else {
-          partSign = 1 << 1;
-        }
+        size_t iCand = 0;
+        for (auto const& p2 : SliceCharmHad) {
+          const float invMass = charmHadMasses[iCand++];
+          if (chargeTrack != p2.charge())
+            continue;
+          float kstar = FemtoDreamMath::getkstar(p1, MassOne, p2, MassTwo);
+          if (kstar > ConfOptHighkstarCut)
+            continue;
 
-        float invMass;
-        if (p2.candidateSelFlag() == 1) {
-          invMass = p2.m(std::array{o2::constants::physics::MassProton, o2::constants::physics::MassKPlus, o2::constants::physics::MassPiPlus});
-        } else {
-          invMass = p2.m(std::array{o2::constants::physics::MassPiPlus, o2::constants::physics::MassKPlus, o2::constants::physics::MassProton});
-        }
-        fillFemtoResult(
-          invMass,
-          p2.pt(),
-          p1.pt(),
-          p2.bdtBkg(),
-          p2.bdtPrompt(),
-          p2.bdtFD(),
-          kstar,
-          FemtoDreamMath::getkT(p1, MassOne, p2, MassTwo),
-          FemtoDreamMath::getmT(p1, MassOne, p2, MassTwo),
-          collision1.multNtr(),
-          collision1.multV0M(),
-          partSign,
-          processType);
+          if (chargeTrack == 1) {
+            partSign = 1;
+          } else {
+            partSign = 1 << 1;
+          }
 
-        if (ConfOptUseCPR.value) {
-          if (pairCloseRejection.isClosePair(p1, p2, parts, collision1.magField())) {
+          fillFemtoResult(
+            invMass,
+            p2.pt(),
+            p1.pt(),
+            p2.bdtBkg(),
+            p2.bdtPrompt(),
+            p2.bdtFD(),
+            kstar,
+            FemtoDreamMath::getkT(p1, MassOne, p2, MassTwo),
+            FemtoDreamMath::getmT(p1, MassOne, p2, MassTwo),
+            collision1.multNtr(),
+            collision1.multV0M(),
+            partSign,
+            processType);
+
+          if (ConfOptUseCPR.value) {
+            if (pairCloseRejection.isClosePair(p1, p2, parts, collision1.magField())) {
+              continue;
+            }
+          }
+          if (!pairCleaner.isCleanPair(p1, p2, parts)) {
             continue;
           }
+          mixedEventCont.setPair<isMc, true>(p1, p2, collision1.multNtr(), collision1.multV0M(), ConfOptUse4D, ConfOptExtendedPlots, ConfOptsmearingByOrigin);
         }
-        if (!pairCleaner.isCleanPair(p1, p2, parts)) {
-          continue;
-        }
-        mixedEventCont.setPair<isMc, true>(p1, p2, collision1.multNtr(), collision1.multV0M(), ConfOptUse4D, ConfOptExtendedPlots, ConfOptsmearingByOrigin);
       }
     }
   }
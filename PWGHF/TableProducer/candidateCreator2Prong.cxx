@@ -26,6 +26,9 @@
 #include <KFPVertex.h>
 #include <KFVertex.h>
 
+#include <array>
+#include <unordered_map>
+
 #include <TPDGCode.h>
 
 #include "CommonConstants/PhysicsConstants.h"
@@ -95,9 +98,10 @@ struct HfCandidateCreator2Prong {
 
   void init(InitContext const&)
   {
-    std::array<bool, 6> doprocessDF{doprocessPvRefitWithDCAFitterN, doprocessNoPvRefitWithDCAFitterN,
+    std::array<bool, 8> doprocessDF{doprocessPvRefitWithDCAFitterN, doprocessNoPvRefitWithDCAFitterN,
                                     doprocessPvRefitWithDCAFitterNCentFT0C, doprocessNoPvRefitWithDCAFitterNCentFT0C,
-                                    doprocessPvRefitWithDCAFitterNCentFT0M, doprocessNoPvRefitWithDCAFitterNCentFT0M};
+                                    doprocessPvRefitWithDCAFitterNCentFT0M, doprocessNoPvRefitWithDCAFitterNCentFT0M,
+                                    doprocessPvRefitWithSkimSvFit, doprocessNoPvRefitWithSkimSvFit};
     std::array<bool, 6> doprocessKF{doprocessPvRefitWithKFParticle, doprocessNoPvRefitWithKFParticle,
                                     doprocessPvRefitWithKFParticleCentFT0C, doprocessNoPvRefitWithKFParticleCentFT0C,
                                     doprocessPvRefitWithKFParticleCentFT0M, doprocessNoPvRefitWithKFParticleCentFT0M};
@@ -111,7 +115,7 @@ struct HfCandidateCreator2Prong {
       LOGP(fatal, "At most one process function for collision monitoring can be enabled at a time.");
     }
     if (nProcessesCollisions == 1) {
-      if ((doprocessPvRefitWithDCAFitterN || doprocessNoPvRefitWithDCAFitterN || doprocessPvRefitWithKFParticle || doprocessNoPvRefitWithKFParticle) && !doprocessCollisions) {
+      if ((doprocessPvRefitWithDCAFitterN || doprocessNoPvRefitWithDCAFitterN || doprocessPvRefitWithKFParticle || doprocessNoPvRefitWithKFParticle || doprocessPvRefitWithSkimSvFit || doprocessNoPvRefitWithSkimSvFit) && !doprocessCollisions) {
         LOGP(fatal, "Process function for collision monitoring not correctly enabled. Did you enable \"processCollisions\"?");
       }
       if ((doprocessPvRefitWithDCAFitterNCentFT0C || doprocessNoPvRefitWithDCAFitterNCentFT0C || doprocessPvRefitWithKFParticleCentFT0C || doprocessNoPvRefitWithKFParticleCentFT0C) && !doprocessCollisionsCentFT0C) {
@@ -167,7 +171,7 @@ struct HfCandidateCreator2Prong {
     setLabelHistoCands(hCandidates);
   }
 
-  template <bool doPvRefit, o2::hf_centrality::CentralityEstimator centEstimator, typename Coll, typename CandType, typename TTracks>
+  template <bool doPvRefit, o2::hf_centrality::CentralityEstimator centEstimator, bool useSkimSvFit = false, typename Coll, typename CandType, typename TTracks>
   void runCreator2ProngWithDCAFitterN(Coll const&,
                                       CandType const& rowsTrackIndexProng2,
                                       TTracks const&,
@@ -204,34 +208,51 @@ struct HfCandidateCreator2Prong {
       }
       df.setBz(bz);
 
-      // reconstruct the 2-prong secondary vertex
+      std::array<float, 3> secondaryVertex;
+      float chi2PCA;
+      std::array<float, 6> covMatrixPCA;
+      std::array<float, 3> pvec0;
+      std::array<float, 3> pvec1;
+      auto trackParVar0 = trackParVarPos1;
+      auto trackParVar1 = trackParVarNeg1;
       hCandidates->Fill(SVFitting::BeforeFit);
-      try {
-        if (df.process(trackParVarPos1, trackParVarNeg1) == 0) {
+      if constexpr (useSkimSvFit) {
+        /// use the secondary vertex fitted in the track-index skimming
+        /// the original tracks are used for the impact parameters, the fitter does not modify them apart from the propagation to the PCA
+        secondaryVertex = {rowTrackIndexProng2.svX(), rowTrackIndexProng2.svY(), rowTrackIndexProng2.svZ()};
+        chi2PCA = rowTrackIndexProng2.svChi2PCA();
+        covMatrixPCA = {rowTrackIndexProng2.svSigmaX2(), rowTrackIndexProng2.svSigmaXY(), rowTrackIndexProng2.svSigmaY2(), rowTrackIndexProng2.svSigmaXZ(), rowTrackIndexProng2.svSigmaYZ(), rowTrackIndexProng2.svSigmaZ2()};
+        pvec0 = {rowTrackIndexProng2.svPxProng0(), rowTrackIndexProng2.svPyProng0(), rowTrackIndexProng2.svPzProng0()};
+        pvec1 = {rowTrackIndexProng2.svPxProng1(), rowTrackIndexProng2.svPyProng1(), rowTrackIndexProng2.svPzProng1()};
+      } else {
+        // reconstruct the 2-prong secondary vertex
+        try {
+          if (df.process(trackParVarPos1, trackParVarNeg1) == 0) {
+            continue;
+          }
+        } catch (const std::runtime_error& error) {
+          LOG(info) << "Run time error found: " << error.what() << ". DCFitterN cannot work, skipping the candidate.";
+          hCandidates->Fill(SVFitting::Fail);
           continue;
         }
-      } catch (const std::runtime_error& error) {
-        LOG(info) << "Run time error found: " << error.what() << ". DCFitterN cannot work, skipping the candidate.";
-        hCandidates->Fill(SVFitting::Fail);
-        continue;
+
+        const auto& vertexPCA = df.getPCACandidate();
+        secondaryVertex = {static_cast<float>(vertexPCA[0]), static_cast<float>(vertexPCA[1]), static_cast<float>(vertexPCA[2])};
+        chi2PCA = df.getChi2AtPCACandidate();
+        covMatrixPCA = df.calcPCACovMatrixFlat();
+        trackParVar0 = df.getTrack(0);
+        trackParVar1 = df.getTrack(1);
+
+        // get track momenta
+        trackParVar0.getPxPyPzGlo(pvec0);
+        trackParVar1.getPxPyPzGlo(pvec1);
       }
       hCandidates->Fill(SVFitting::FitOk);
 
-      const auto& secondaryVertex = df.getPCACandidate();
-      auto chi2PCA = df.getChi2AtPCACandidate();
-      auto covMatrixPCA = df.calcPCACovMatrixFlat();
       registry.fill(HIST("hCovSVXX"), covMatrixPCA[0]); // FIXME: Calculation of errorDecayLength(XY) gives wrong values without this line.
       registry.fill(HIST("hCovSVYY"), covMatrixPCA[2]);
       registry.fill(HIST("hCovSVXZ"), covMatrixPCA[3]);
       registry.fill(HIST("hCovSVZZ"), covMatrixPCA[5]);
-      auto trackParVar0 = df.getTrack(0);
-      auto trackParVar1 = df.getTrack(1);
-
-      // get track momenta
-      std::array<float, 3> pvec0;
-      std::array<float, 3> pvec1;
-      trackParVar0.getPxPyPzGlo(pvec0);
-      trackParVar1.getPxPyPzGlo(pvec1);
 
       // get track impact parameters
       // This modifies track momenta!
@@ -308,12 +329,30 @@ struct HfCandidateCreator2Prong {
     }
   }
 
+  /// Returns the pion and kaon hypotheses of a track, built at its first use in the collision
+  template <typename TTrack>
+  std::array<KFParticle, 2> const& getKfDaughterHypotheses(TTrack const& track, std::unordered_map<int64_t, std::array<KFParticle, 2>>& kfDaughters)
+  {
+    auto [it, isNew] = kfDaughters.try_emplace(track.globalIndex());
+    if (isNew) {
+      KFPTrack kfpTrack = createKFPTrackFromTrack(track);
+      it->second = {KFParticle(kfpTrack, kPiPlus), KFParticle(kfpTrack, kKPlus)};
+    }
+    return it->second;
+  }
+
   template <bool doPvRefit, o2::hf_centrality::CentralityEstimator centEstimator, typename Coll, typename CandType, typename TTracks>
   void runCreator2ProngWithKFParticle(Coll const&,
                                       CandType const& rowsTrackIndexProng2,
                                       TTracks const&,
                                       aod::BCsWithTimestamps const& /*bcWithTimeStamps*/)
   {
+    // the candidates are grouped by collision: the KF primary vertex (w/o PV refit) and the
+    // pion and kaon hypotheses of the daughter tracks are built once per collision
+    int64_t indexCollisionKf{-1};
+    KFParticle kfPvCollision;
+    float covMatrixPvCollision[6] = {0.f};
+    std::unordered_map<int64_t, std::array<KFParticle, 2>> kfDaughtersCollision; // pion and kaon hypotheses per track
 
     for (const auto& rowTrackIndexProng2 : rowsTrackIndexProng2) {
 
@@ -341,45 +380,58 @@ struct HfCandidateCreator2Prong {
         // df.setBz(bz); /// put it outside the 'if'! Otherwise we have a difference wrt bz Configurable (< 1 permille) in Run2 conv. data
         // df.print();
       }
-      float covMatrixPV[6];
 
       KFParticle::SetField(bz);
-      KFPVertex kfpVertex = createKFPVertexFromCollision(collision);
+      if (collision.globalIndex() != indexCollisionKf) {
+        indexCollisionKf = collision.globalIndex();
+        kfDaughtersCollision.clear();
+        if constexpr (!doPvRefit) {
+          KFPVertex kfpVertex = createKFPVertexFromCollision(collision);
+          kfpVertex.GetCovarianceMatrix(covMatrixPvCollision);
+          kfPvCollision = KFParticle(kfpVertex);
+        }
+      }
 
+      KFParticle kfPvRefit;
+      float covMatrixPvRefit[6] = {0.f};
       if constexpr (doPvRefit) {
         /// use PV refit
         /// Using it in the rowCandidateBase all dynamic columns shall take it into account
+        KFPVertex kfpVertex = createKFPVertexFromCollision(collision);
         // coordinates
         kfpVertex.SetXYZ(rowTrackIndexProng2.pvRefitX(), rowTrackIndexProng2.pvRefitY(), rowTrackIndexProng2.pvRefitZ());
         // covariance matrix
         kfpVertex.SetCovarianceMatrix(rowTrackIndexProng2.pvRefitSigmaX2(), rowTrackIndexProng2.pvRefitSigmaXY(), rowTrackIndexProng2.pvRefitSigmaY2(), rowTrackIndexProng2.pvRefitSigmaXZ(), rowTrackIndexProng2.pvRefitSigmaYZ(), rowTrackIndexProng2.pvRefitSigmaZ2());
+        kfpVertex.GetCovarianceMatrix(covMatrixPvRefit);
+        kfPvRefit = KFParticle(kfpVertex);
       }
-      kfpVertex.GetCovarianceMatrix(covMatrixPV);
-      KFParticle KFPV(kfpVertex);
+      const KFParticle& KFPV = doPvRefit ? kfPvRefit : kfPvCollision;
+      const float* covMatrixPV = doPvRefit ? covMatrixPvRefit : covMatrixPvCollision;
       registry.fill(HIST("hCovPVXX"), covMatrixPV[0]);
       registry.fill(HIST("hCovPVYY"), covMatrixPV[2]);
       registry.fill(HIST("hCovPVXZ"), covMatrixPV[3]);
       registry.fill(HIST("hCovPVZZ"), covMatrixPV[5]);
 
-      KFPTrack kfpTrack0 = createKFPTrackFromTrack(track0);
-      KFPTrack kfpTrack1 = createKFPTrackFromTrack(track1);
-
-      KFParticle kfPosPion(kfpTrack0, kPiPlus);
-      KFParticle kfNegPion(kfpTrack1, kPiPlus);
-      KFParticle kfPosKaon(kfpTrack0, kKPlus);
-      KFParticle kfNegKaon(kfpTrack1, kKPlus);
+      const auto& kfDaughters0 = getKfDaughterHypotheses(track0, kfDaughtersCollision);
+      const auto& kfDaughters1 = getKfDaughterHypotheses(track1, kfDaughtersCollision);
+      const KFParticle& kfPosPion = kfDaughters0[0];
+      const KFParticle& kfPosKaon = kfDaughters0[1];
+      const KFParticle& kfNegPion = kfDaughters1[0];
+      const KFParticle& kfNegKaon = kfDaughters1[1];
 
       float impactParameter0XY = 0., errImpactParameter0XY = 0., impactParameter1XY = 0., errImpactParameter1XY = 0.;
       if (!kfPosPion.GetDistanceFromVertexXY(KFPV, impactParameter0XY, errImpactParameter0XY)) {
+        const float impactParameter0 = kfPosPion.GetDistanceFromVertex(KFPV);
         registry.fill(HIST("hDcaXYProngs"), track0.pt(), impactParameter0XY * toMicrometers);
-        registry.fill(HIST("hDcaZProngs"), track0.pt(), std::sqrt(kfPosPion.GetDistanceFromVertex(KFPV) * kfPosPion.GetDistanceFromVertex(KFPV) - impactParameter0XY * impactParameter0XY) * toMicrometers);
+        registry.fill(HIST("hDcaZProngs"), track0.pt(), std::sqrt(impactParameter0 * impactParameter0 - impactParameter0XY * impactParameter0XY) * toMicrometers);
       } else {
         registry.fill(HIST("hDcaXYProngs"), track0.pt(), -999.f);
         registry.fill(HIST("hDcaZProngs"), track0.pt(), -999.f);
       }
       if (!kfNegPion.GetDistanceFromVertexXY(KFPV, impactParameter1XY, errImpactParameter1XY)) {
+        const float impactParameter1 = kfNegPion.GetDistanceFromVertex(KFPV);
         registry.fill(HIST("hDcaXYProngs"), track1.pt(), impactParameter1XY * toMicrometers);
-        registry.fill(HIST("hDcaZProngs"), track1.pt(), std::sqrt(kfNegPion.GetDistanceFromVertex(KFPV) * kfNegPion.GetDistanceFromVertex(KFPV) - impactParameter1XY * impactParameter1XY) * toMicrometers);
+        registry.fill(HIST("hDcaZProngs"), track1.pt(), std::sqrt(impactParameter1 * impactParameter1 - impactParameter1XY * impactParameter1XY) * toMicrometers);
       } else {
         registry.fill(HIST("hDcaXYProngs"), track1.pt(), -999.f);
         registry.fill(HIST("hDcaZProngs"), track1.pt(), -999.f);
@@ -477,6 +529,26 @@ struct HfCandidateCreator2Prong {
   }
   PROCESS_SWITCH(HfCandidateCreator2Prong, processNoPvRefitWithDCAFitterN, "Run candidate creator using DCA fitter w/o PV refit and w/o centrality selections", true);
 
+  /// @brief process function using the DCA fitter result of the track-index skimming w/ PV refit and w/o centrality selections
+  void processPvRefitWithSkimSvFit(soa::Join<aod::Collisions, aod::EvSels> const& collisions,
+                                   soa::Join<aod::Hf2Prongs, aod::HfPvRefit2Prong, aod::HfSvFit2Prong> const& rowsTrackIndexProng2,
+                                   aod::TracksWCovExtra const& tracks,
+                                   aod::BCsWithTimestamps const& bcWithTimeStamps)
+  {
+    runCreator2ProngWithDCAFitterN</*doPvRefit*/ true, CentralityEstimator::None, /*useSkimSvFit*/ true>(collisions, rowsTrackIndexProng2, tracks, bcWithTimeStamps);
+  }
+  PROCESS_SWITCH(HfCandidateCreator2Prong, processPvRefitWithSkimSvFit, "Run candidate creator using the secondary vertex fitted in the track-index skimming w/ PV refit and w/o centrality selections", false);
+
+  /// @brief process function using the DCA fitter result of the track-index skimming w/o PV refit and w/o centrality selections
+  void processNoPvRefitWithSkimSvFit(soa::Join<aod::Collisions, aod::EvSels> const& collisions,
+                                     soa::Join<aod::Hf2Prongs, aod::HfSvFit2Prong> const& rowsTrackIndexProng2,
+                                     aod::TracksWCovExtra const& tracks,
+                                     aod::BCsWithTimestamps const& bcWithTimeStamps)
+  {
+    runCreator2ProngWithDCAFitterN</*doPvRefit*/ false, CentralityEstimator::None, /*useSkimSvFit*/ true>(collisions, rowsTrackIndexProng2, tracks, bcWithTimeStamps);
+  }
+  PROCESS_SWITCH(HfCandidateCreator2Prong, processNoPvRefitWithSkimSvFit, "Run candidate creator using the secondary vertex fitted in the track-index skimming w/o PV refit and w/o centrality selections", false);
+
   /// @brief process function using KFParticle package w/ PV refit and w/o centrality selections
   void processPvRefitWithKFParticle(soa::Join<aod::Collisions, aod::EvSels> const& collisions,
                                     soa::Join<aod::Hf2Prongs, aod::HfPvRefit2Prong> const& rowsTrackIndexProng2,
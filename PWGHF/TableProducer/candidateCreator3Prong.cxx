@@ -83,6 +83,8 @@ struct HfCandidateCreator3Prong {
 
   using FilteredHf3Prongs = soa::Filtered<aod::Hf3Prongs>;
   using FilteredPvRefitHf3Prongs = soa::Filtered<soa::Join<aod::Hf3Prongs, aod::HfPvRefit3Prong>>;
+  using FilteredSvFitHf3Prongs = soa::Filtered<soa::Join<aod::Hf3Prongs, aod::HfSvFit3Prong>>;
+  using FilteredPvRefitSvFitHf3Prongs = soa::Filtered<soa::Join<aod::Hf3Prongs, aod::HfPvRefit3Prong, aod::HfSvFit3Prong>>;
 
   // filter candidates
   Filter filterSelected3Prongs = (createDplus && (o2::aod::hf_track_index::hfflag & static_cast<uint8_t>(BIT(aod::hf_cand_3prong::DecayType::DplusToPiKPi))) != static_cast<uint8_t>(0)) || (createDs && (o2::aod::hf_track_index::hfflag & static_cast<uint8_t>(BIT(aod::hf_cand_3prong::DecayType::DsToKKPi))) != static_cast<uint8_t>(0)) || (createLc && (o2::aod::hf_track_index::hfflag & static_cast<uint8_t>(BIT(aod::hf_cand_3prong::DecayType::LcToPKPi))) != static_cast<uint8_t>(0)) || (createXic && (o2::aod::hf_track_index::hfflag & static_cast<uint8_t>(BIT(aod::hf_cand_3prong::DecayType::XicToPKPi))) != static_cast<uint8_t>(0));
@@ -92,9 +94,10 @@ struct HfCandidateCreator3Prong {
 
   void init(InitContext const&)
   {
-    std::array<bool, 6> processes = {doprocessPvRefit, doprocessNoPvRefit,
+    std::array<bool, 8> processes = {doprocessPvRefit, doprocessNoPvRefit,
                                      doprocessPvRefitCentFT0C, doprocessNoPvRefitCentFT0C,
-                                     doprocessPvRefitCentFT0M, doprocessNoPvRefitCentFT0M};
+                                     doprocessPvRefitCentFT0M, doprocessNoPvRefitCentFT0M,
+                                     doprocessPvRefitWithSkimSvFit, doprocessNoPvRefitWithSkimSvFit};
     if (std::accumulate(processes.begin(), processes.end(), 0) != 1) {
       LOGP(fatal, "One and only one process function must be enabled at a time.");
     }
@@ -105,7 +108,7 @@ struct HfCandidateCreator3Prong {
       LOGP(fatal, "At most one process function for collision monitoring can be enabled at a time.");
     }
     if (nProcessesCollisions == 1) {
-      if ((doprocessPvRefit || doprocessNoPvRefit) && !doprocessCollisions) {
+      if ((doprocessPvRefit || doprocessNoPvRefit || doprocessPvRefitWithSkimSvFit || doprocessNoPvRefitWithSkimSvFit) && !doprocessCollisions) {
         LOGP(fatal, "Process function for collision monitoring not correctly enabled. Did you enable \"processCollisions\"?");
       }
       if ((doprocessPvRefitCentFT0C || doprocessNoPvRefitCentFT0C) && !doprocessCollisionsCentFT0C) {
@@ -159,7 +162,7 @@ struct HfCandidateCreator3Prong {
     setLabelHistoCands(hCandidates);
   }
 
-  template <bool doPvRefit = false, o2::hf_centrality::CentralityEstimator centEstimator, typename Coll, typename Cand>
+  template <bool doPvRefit = false, o2::hf_centrality::CentralityEstimator centEstimator, bool useSkimSvFit = false, typename Coll, typename Cand>
   void runCreator3Prong(Coll const&,
                         Cand const& rowsTrackIndexProng3,
                         aod::TracksWCovExtra const&,
@@ -198,37 +201,53 @@ struct HfCandidateCreator3Prong {
       }
       df.setBz(bz);
 
-      // reconstruct the 3-prong secondary vertex
+      std::array<float, 3> secondaryVertex;
+      float chi2PCA;
+      std::array<float, 6> covMatrixPCA;
+      std::array<float, 3> pvec0;
+      std::array<float, 3> pvec1;
+      std::array<float, 3> pvec2;
       hCandidates->Fill(SVFitting::BeforeFit);
-      try {
-        if (df.process(trackParVar0, trackParVar1, trackParVar2) == 0) {
+      if constexpr (useSkimSvFit) {
+        /// use the secondary vertex fitted in the track-index skimming
+        /// the original tracks are used for the impact parameters, the fitter does not modify them apart from the propagation to the PCA
+        secondaryVertex = {rowTrackIndexProng3.svX(), rowTrackIndexProng3.svY(), rowTrackIndexProng3.svZ()};
+        chi2PCA = rowTrackIndexProng3.svChi2PCA();
+        covMatrixPCA = {rowTrackIndexProng3.svSigmaX2(), rowTrackIndexProng3.svSigmaXY(), rowTrackIndexProng3.svSigmaY2(), rowTrackIndexProng3.svSigmaXZ(), rowTrackIndexProng3.svSigmaYZ(), rowTrackIndexProng3.svSigmaZ2()};
+        pvec0 = {rowTrackIndexProng3.svPxProng0(), rowTrackIndexProng3.svPyProng0(), rowTrackIndexProng3.svPzProng0()};
+        pvec1 = {rowTrackIndexProng3.svPxProng1(), rowTrackIndexProng3.svPyProng1(), rowTrackIndexProng3.svPzProng1()};
+        pvec2 = {rowTrackIndexProng3.svPxProng2(), rowTrackIndexProng3.svPyProng2(), rowTrackIndexProng3.svPzProng2()};
+      } else {
+        // reconstruct the 3-prong secondary vertex
+        try {
+          if (df.process(trackParVar0, trackParVar1, trackParVar2) == 0) {
+            continue;
+          }
+        } catch (const std::runtime_error& error) {
+          LOG(info) << "Run time error found: " << error.what() << ". DCFitterN cannot work, skipping the candidate.";
+          hCandidates->Fill(SVFitting::Fail);
           continue;
         }
-      } catch (const std::runtime_error& error) {
-        LOG(info) << "Run time error found: " << error.what() << ". DCFitterN cannot work, skipping the candidate.";
-        hCandidates->Fill(SVFitting::Fail);
-        continue;
+
+        const auto& vertexPCA = df.getPCACandidate();
+        secondaryVertex = {static_cast<float>(vertexPCA[0]), static_cast<float>(vertexPCA[1]), static_cast<float>(vertexPCA[2])};
+        chi2PCA = df.getChi2AtPCACandidate();
+        covMatrixPCA = df.calcPCACovMatrixFlat();
+        trackParVar0 = df.getTrack(0);
+        trackParVar1 = df.getTrack(1);
+        trackParVar2 = df.getTrack(2);
+
+        // get track momenta
+        trackParVar0.getPxPyPzGlo(pvec0);
+        trackParVar1.getPxPyPzGlo(pvec1);
+        trackParVar2.getPxPyPzGlo(pvec2);
       }
       hCandidates->Fill(SVFitting::FitOk);
 
-      const auto& secondaryVertex = df.getPCACandidate();
-      auto chi2PCA = df.getChi2AtPCACandidate();
-      auto covMatrixPCA = df.calcPCACovMatrixFlat();
       registry.fill(HIST("hCovSVXX"), covMatrixPCA[0]); // FIXME: Calculation of errorDecayLength(XY) gives wrong values without this line.
       registry.fill(HIST("hCovSVYY"), covMatrixPCA[2]);
       registry.fill(HIST("hCovSVXZ"), covMatrixPCA[3]);
       registry.fill(HIST("hCovSVZZ"), covMatrixPCA[5]);
-      trackParVar0 = df.getTrack(0);
-      trackParVar1 = df.getTrack(1);
-      trackParVar2 = df.getTrack(2);
-
-      // get track momenta
-      std::array<float, 3> pvec0;
-      std::array<float, 3> pvec1;
-      std::array<float, 3> pvec2;
-      trackParVar0.getPxPyPzGlo(pvec0);
-      trackParVar1.getPxPyPzGlo(pvec1);
-      trackParVar2.getPxPyPzGlo(pvec2);
 
       // get track impact parameters
       // This modifies track momenta!
@@ -337,6 +356,26 @@ struct HfCandidateCreator3Prong {
   }
   PROCESS_SWITCH(HfCandidateCreator3Prong, processNoPvRefit, "Run candidate creator without PV refit and w/o centrality selections", true);
 
+  /// @brief process function using the secondary vertex fitted in the track-index skimming, w/ PV refit and w/o centrality selections
+  void processPvRefitWithSkimSvFit(soa::Join<aod::Collisions, aod::EvSels> const& collisions,
+                                   FilteredPvRefitSvFitHf3Prongs const& rowsTrackIndexProng3,
+                                   aod::TracksWCovExtra const& tracks,
+                                   aod::BCsWithTimestamps const& bcWithTimeStamps)
+  {
+    runCreator3Prong</*doPvRefit*/ true, CentralityEstimator::None, /*useSkimSvFit*/ true>(collisions, rowsTrackIndexProng3, tracks, bcWithTimeStamps);
+  }
+  PROCESS_SWITCH(HfCandidateCreator3Prong, processPvRefitWithSkimSvFit, "Run candidate creator using the secondary vertex fitted in the track-index skimming, with PV refit and w/o centrality selections", false);
+
+  /// @brief process function using the secondary vertex fitted in the track-index skimming, w/o PV refit and w/o centrality selections
+  void processNoPvRefitWithSkimSvFit(soa::Join<aod::Collisions, aod::EvSels> const& collisions,
+                                     FilteredSvFitHf3Prongs const& rowsTrackIndexProng3,
+                                     aod::TracksWCovExtra const& tracks,
+                                     aod::BCsWithTimestamps const& bcWithTimeStamps)
+  {
+    runCreator3Prong</*doPvRefit*/ false, CentralityEstimator::None, /*useSkimSvFit*/ true>(collisions, rowsTrackIndexProng3, tracks, bcWithTimeStamps);
+  }
+  PROCESS_SWITCH(HfCandidateCreator3Prong, processNoPvRefitWithSkimSvFit, "Run candidate creator using the secondary vertex fitted in the track-index skimming, without PV refit and w/o centrality selections", false);
+
   /////////////////////////////////////////////
   ///                                       ///
   ///   with centrality selection on FT0C   ///
@@ -28,6 +28,7 @@
 #include "PWGHF/Core/HfHelper.h"
 #include "PWGHF/DataModel/CandidateReconstructionTables.h"
 #include "PWGHF/DataModel/CandidateSelectionTables.h"
+#include "PWGHF/Utils/utilsBachelorPool.h"
 #include "PWGHF/Utils/utilsBfieldCCDB.h"
 #include "PWGHF/Utils/utilsTrkCandHf.h"
 
@@ -84,6 +85,8 @@ struct HfCandidateCreatorB0 {
   o2::vertexing::DCAFitterN<2> df2;
   // Fitter to redo D-vertex to get extrapolated daughter tracks (3-prong vertex filter)
   o2::vertexing::DCAFitterN<3> df3;
+  // Selected pion tracks of the current collision
+  BachelorPool bachelorPool;
 
   using TracksWithSel = soa::Join<aod::TracksWCovDca, aod::TrackSelection>;
   using CandsDFiltered = soa::Filtered<soa::Join<aod::HfCand3Prong, aod::HfSelDplusToPiKPi>>;
@@ -198,6 +201,7 @@ struct HfCandidateCreatorB0 {
 
       auto thisCollId = collision.globalIndex();
       auto candsDThisColl = candsD.sliceBy(candsDPerCollision, thisCollId);
+      bool isBachelorPoolFilled = false; // the pions are selected at the first D candidate of the collision
 
       for (const auto& candD : candsDThisColl) { // start loop over filtered D candidates indices as associated to this collision in candidateCreator3Prong.cxx
         hMassDToPiKPi->Fill(hfHelper.invMassDplusToPiKPi(candD), candD.pt());
@@ -268,32 +272,32 @@ struct HfCandidateCreatorB0 {
         int indexTrack1 = track1.globalIndex();
         int indexTrack2 = track2.globalIndex();
 
-        auto trackIdsThisCollision = trackIndices.sliceBy(trackIndicesPerCollision, thisCollId);
-
-        for (const auto& trackId : trackIdsThisCollision) { // start loop over track indices associated to this collision
-          auto trackPion = trackId.track_as<TracksWithSel>();
-
-          // check isGlobalTrackWoDCA status for pions if wanted
-          if (usePionIsGlobalTrackWoDCA && !trackPion.isGlobalTrackWoDCA()) {
-            continue;
-          }
+        if (!isBachelorPoolFilled) {
+          auto trackIdsThisCollision = trackIndices.sliceBy(trackIndicesPerCollision, thisCollId);
+          bachelorPool.fill<TracksWithSel>(trackIdsThisCollision, [&](const auto& trackPion) {
+            // check isGlobalTrackWoDCA status for pions if wanted
+            if (usePionIsGlobalTrackWoDCA && !trackPion.isGlobalTrackWoDCA()) {
+              return false;
+            }
+            // minimum pT selection
+            return trackPion.pt() >= ptPionMin && isSelectedTrackDCA(trackPion);
+          });
+          isBachelorPoolFilled = true;
+        }
 
-          // minimum pT selection
-          if (trackPion.pt() < ptPionMin || !isSelectedTrackDCA(trackPion)) {
-            continue;
-          }
+        for (const auto& trackPion : bachelorPool.tracks()) { // start loop over the selected tracks associated to this collision
           // reject pions that are D daughters
-          if (trackPion.globalIndex() == indexTrack0 || trackPion.globalIndex() == indexTrack1 || trackPion.globalIndex() == indexTrack2) {
+          if (trackPion.globalIndex == indexTrack0 || trackPion.globalIndex == indexTrack1 || trackPion.globalIndex == indexTrack2) {
             continue;
           }
           // reject pi and D with same sign
-          if (trackPion.sign() * track0.sign() > 0) {
+          if (trackPion.sign * track0.sign() > 0) {
             continue;
           }
 
-          hPtPion->Fill(trackPion.pt());
-          std::array<float, 3> pVecPion = trackPion.pVector();
-          auto trackParCovPi = getTrackParCov(trackPion);
+          hPtPion->Fill(trackPion.pt);
+          std::array<float, 3> pVecPion = trackPion.pVec;
+          auto trackParCovPi = trackPion.trackParCov;
 
           // ---------------------------------
           // reconstruct the 2-prong B0 vertex
@@ -353,7 +357,7 @@ struct HfCandidateCreatorB0 {
                            dcaD.getY(), dcaPion.getY(),
                            std::sqrt(dcaD.getSigmaY2()), std::sqrt(dcaPion.getSigmaY2()));
 
-          rowCandidateProngs(candD.globalIndex(), trackPion.globalIndex());
+          rowCandidateProngs(candD.globalIndex(), trackPion.globalIndex);
         } // pi loop
       }   // D loop
     }     // collision loop
@@ -31,6 +31,7 @@
 #include "PWGHF/Core/HfHelper.h"
 #include "PWGHF/DataModel/CandidateReconstructionTables.h"
 #include "PWGHF/DataModel/CandidateSelectionTables.h"
+#include "PWGHF/Utils/utilsBachelorPool.h"
 #include "PWGHF/Utils/utilsBfieldCCDB.h"
 #include "PWGHF/Utils/utilsTrkCandHf.h"
 
@@ -62,6 +63,7 @@ struct HfCandidateCreatorBplus {
   Configurable<std::vector<double>> binsPtPion{"binsPtPion", std::vector<double>{hf_cuts_single_track::vecBinsPtTrack}, "track pT bin limits for pion DCA XY pT-dependent cut"};
   Configurable<LabeledArray<double>> cutsTrackPionDCA{"cutsTrackPionDCA", {hf_cuts_single_track::cutsTrack[0], hf_cuts_single_track::nBinsPtTrack, hf_cuts_single_track::nCutVarsTrack, hf_cuts_single_track::labelsPtTrack, hf_cuts_single_track::labelsCutVarTrack}, "Single-track selections per pT bin for pions"};
   Configurable<double> invMassWindowBplus{"invMassWindowBplus", 0.3, "invariant-mass window for B^{+} candidates"};
+  Configurable<double> invMassWindowBplusPreFit{"invMassWindowBplusPreFit", -1., "invariant-mass window for D0-pi pairs before the B^{+} vertex fit, with the momenta at the D0 vertex and at the pion reference point (no selection if negative)"};
   Configurable<int> selectionFlagD0{"selectionFlagD0", 1, "Selection Flag for D0"};
   Configurable<int> selectionFlagD0bar{"selectionFlagD0bar", 1, "Selection Flag for D0bar"};
   Configurable<double> yCandMax{"yCandMax", -1., "max. cand. rapidity"};
@@ -84,12 +86,16 @@ struct HfCandidateCreatorBplus {
   double massBplus{0.};
   double invMass2D0PiMin{0.};
   double invMass2D0PiMax{0.};
+  double invMass2D0PiPreFitMin{0.};
+  double invMass2D0PiPreFitMax{0.};
   double bz{0.};
 
   // Fitter for B vertex
   o2::vertexing::DCAFitterN<2> dfB;
   // Fitter to redo D-vertex to get extrapolated daughter tracks
   o2::vertexing::DCAFitterN<2> df;
+  // Selected pion tracks of the current collision
+  BachelorPool bachelorPool;
 
   using TracksWithSel = soa::Join<aod::TracksWCovDca, aod::TrackSelection>;
   using CandsDFiltered = soa::Filtered<soa::Join<aod::HfCand2Prong, aod::HfSelD0>>;
@@ -115,6 +121,10 @@ struct HfCandidateCreatorBplus {
     massBplus = MassBPlus;
     invMass2D0PiMin = (massBplus - invMassWindowBplus) * (massBplus - invMassWindowBplus);
     invMass2D0PiMax = (massBplus + invMassWindowBplus) * (massBplus + invMassWindowBplus);
+    if (invMassWindowBplusPreFit >= 0.) {
+      invMass2D0PiPreFitMin = massBplus > invMassWindowBplusPreFit ? (massBplus - invMassWindowBplusPreFit) * (massBplus - invMassWindowBplusPreFit) : 0.;
+      invMass2D0PiPreFitMax = (massBplus + invMassWindowBplusPreFit) * (massBplus + invMassWindowBplusPreFit);
+    }
 
     // Initialise fitter for B vertex
     dfB.setPropagateToPCA(propagateToPCA);
@@ -198,6 +208,7 @@ struct HfCandidateCreatorBplus {
 
       auto thisCollId = collision.globalIndex();
       auto candsDThisColl = candsD.sliceBy(candsDPerCollision, thisCollId);
+      bool isBachelorPoolFilled = false; // the pions are selected at the first D0 candidate of the collision
 
       // loop over pairs of track indices
       for (const auto& candD0 : candsDThisColl) {
@@ -259,39 +270,46 @@ struct HfCandidateCreatorBplus {
         int indexTrack0 = prong0.globalIndex();
         int indexTrack1 = prong1.globalIndex();
 
-        auto trackIdsThisCollision = trackIndices.sliceBy(trackIndicesPerCollision, thisCollId);
+        if (!isBachelorPoolFilled) {
+          auto trackIdsThisCollision = trackIndices.sliceBy(trackIndicesPerCollision, thisCollId);
+          bachelorPool.fill<TracksWithSel>(trackIdsThisCollision, [&](const auto& trackPion) {
+            // check isGlobalTrackWoDCA status for pions if wanted
+            if (usePionIsGlobalTrackWoDCA && !trackPion.isGlobalTrackWoDCA()) {
+              return false;
+            }
+            // minimum pT selection
+            if (trackPion.pt() < ptPionMin || !isSelectedTrack(trackPion)) {
+              return false;
+            }
+            return etaTrackMax < 0. || std::abs(trackPion.eta()) <= etaTrackMax;
+          });
+          isBachelorPoolFilled = true;
+        }
 
         // loop over tracks pi
-        for (const auto& trackId : trackIdsThisCollision) { // start loop over track indices associated to this collision
-          auto trackPion = trackId.track_as<TracksWithSel>();
-
-          // check isGlobalTrackWoDCA status for pions if wanted
-          if (usePionIsGlobalTrackWoDCA && !trackPion.isGlobalTrackWoDCA()) {
-            continue;
-          }
+        for (const auto& trackPion : bachelorPool.tracks()) { // start loop over the selected tracks associated to this collision
 
           // Select D0pi- and D0(bar)pi+ pairs only
-          if (!((candD0.isSelD0() >= selectionFlagD0 && trackPion.sign() < 0) || (candD0.isSelD0bar() >= selectionFlagD0bar && trackPion.sign() > 0))) {
+          if (!((candD0.isSelD0() >= selectionFlagD0 && trackPion.sign < 0) || (candD0.isSelD0bar() >= selectionFlagD0bar && trackPion.sign > 0))) {
             // LOGF(debug, "D0: %d, D0bar%d, sign: %d", candD0.isSelD0(), candD0.isSelD0bar(), track.sign());
             continue;
           }
 
-          // minimum pT selection
-          if (trackPion.pt() < ptPionMin || !isSelectedTrack(trackPion)) {
-            continue;
-          }
-
-          if (indexTrack0 == trackPion.globalIndex() || indexTrack1 == trackPion.globalIndex()) {
+          if (indexTrack0 == trackPion.globalIndex || indexTrack1 == trackPion.globalIndex) {
             continue; // different id between D0 daughters and bachelor track
           }
 
-          if (etaTrackMax >= 0. && std::abs(trackPion.eta()) > etaTrackMax) {
-            continue;
-          }
+          hEtaPi->Fill(trackPion.eta);
 
-          hEtaPi->Fill(trackPion.eta());
+          // reject the pairs far from the B+ mass before the vertex fit
+          if (invMassWindowBplusPreFit >= 0.) {
+            auto invMass2D0PiPreFit = RecoDecay::m2(std::array{pVecD, trackPion.pVec}, std::array{massD0, massPi});
+            if ((invMass2D0PiPreFit < invMass2D0PiPreFitMin) || (invMass2D0PiPreFit > invMass2D0PiPreFitMax)) {
+              continue;
+            }
+          }
 
-          auto trackParCovPi = getTrackParCov(trackPion);
+          auto trackParCovPi = trackPion.trackParCov;
           std::array<float, 3> pVecD0 = {0., 0., 0.};
           std::array<float, 3> pVecBach = {0., 0., 0.};
           std::array<float, 3> pVecBCand = {0., 0., 0.};
@@ -353,12 +371,12 @@ struct HfCandidateCreatorBplus {
                            impactParameter0.getY(), impactParameter1.getY(),
                            std::sqrt(impactParameter0.getSigmaY2()), std::sqrt(impactParameter1.getSigmaY2()));
 
-          rowCandidateProngs(candD0.globalIndex(), trackPion.globalIndex()); // index D0 and bachelor
-        }                                                                    // track loop
-      }                                                                      // D0 cand loop
-    }                                                                        // collision
-  }                                                                          // process
-};                                                                           // struct
+          rowCandidateProngs(candD0.globalIndex(), trackPion.globalIndex); // index D0 and bachelor
+        }                                                                  // track loop
+      }                                                                    // D0 cand loop
+    }                                                                      // collision
+  }                                                                        // process
+};                                                                         // struct
 
 /// Extends the base table with expression columns and performs MC matching
 struct HfCandidateCreatorBplusExpressions {
@@ -28,6 +28,7 @@
 #include "PWGHF/Core/HfHelper.h"
 #include "PWGHF/DataModel/CandidateReconstructionTables.h"
 #include "PWGHF/DataModel/CandidateSelectionTables.h"
+#include "PWGHF/Utils/utilsBachelorPool.h"
 #include "PWGHF/Utils/utilsBfieldCCDB.h"
 #include "PWGHF/Utils/utilsTrkCandHf.h"
 
@@ -68,6 +69,8 @@ struct HfCandidateCreatorBs {
 
   o2::vertexing::DCAFitterN<2> df2; // 2-prong vertex fitter
   o2::vertexing::DCAFitterN<3> df3; // 3-prong vertex fitter
+  // Selected pion tracks of the current collision
+  BachelorPool bachelorPool;
   HfHelper hfHelper;
   Service<o2::ccdb::BasicCCDBManager> ccdb;
   o2::base::MatLayerCylSet* lut;
@@ -181,6 +184,7 @@ struct HfCandidateCreatorBs {
 
       auto thisCollId = collision.globalIndex();
       auto candsDsThisColl = candsDs.sliceBy(candsDsPerCollision, thisCollId);
+      bool isBachelorPoolFilled = false; // the pions are selected at the first Ds candidate of the collision
 
       for (const auto& candDs : candsDsThisColl) { // start loop over filtered Ds candidates indices as associated to this collision in candidateCreator3Prong.cxx
 
@@ -250,31 +254,31 @@ struct HfCandidateCreatorBs {
         int indexTrack1 = track1.globalIndex();
         int indexTrack2 = track2.globalIndex();
 
-        auto trackIdsThisCollision = trackIndices.sliceBy(trackIndicesPerCollision, thisCollId);
-
-        for (const auto& trackId : trackIdsThisCollision) { // start loop over track indices associated to this collision
-          auto trackPion = trackId.track_as<TracksWithSel>();
-
-          // check isGlobalTrackWoDCA status for pions if wanted
-          if (usePionIsGlobalTrackWoDCA && !trackPion.isGlobalTrackWoDCA()) {
-            continue;
-          }
+        if (!isBachelorPoolFilled) {
+          auto trackIdsThisCollision = trackIndices.sliceBy(trackIndicesPerCollision, thisCollId);
+          bachelorPool.fill<TracksWithSel>(trackIdsThisCollision, [&](const auto& trackPion) {
+            // check isGlobalTrackWoDCA status for pions if wanted
+            if (usePionIsGlobalTrackWoDCA && !trackPion.isGlobalTrackWoDCA()) {
+              return false;
+            }
+            // minimum pT selection
+            return trackPion.pt() >= ptPionMin && isSelectedTrackDCA(trackPion);
+          });
+          isBachelorPoolFilled = true;
+        }
 
-          // minimum pT selection
-          if (trackPion.pt() < ptPionMin || !isSelectedTrackDCA(trackPion)) {
-            continue;
-          }
+        for (const auto& trackPion : bachelorPool.tracks()) { // start loop over the selected tracks associated to this collision
           // reject pions that are Ds daughters
-          if (trackPion.globalIndex() == indexTrack0 || trackPion.globalIndex() == indexTrack1 || trackPion.globalIndex() == indexTrack2) {
+          if (trackPion.globalIndex == indexTrack0 || trackPion.globalIndex == indexTrack1 || trackPion.globalIndex == indexTrack2) {
             continue;
           }
           // reject pi and Ds with same sign
-          if (trackPion.sign() * track0.sign() > 0) {
+          if (trackPion.sign * track0.sign() > 0) {
             continue;
           }
 
-          std::array<float, 3> pVecPion = trackPion.pVector();
-          auto trackParCovPi = getTrackParCov(trackPion);
+          std::array<float, 3> pVecPion = trackPion.pVec;
+          auto trackParCovPi = trackPion.trackParCov;
 
           // ---------------------------------
           // reconstruct the 2-prong Bs vertex
@@ -329,7 +333,7 @@ struct HfCandidateCreatorBs {
           hMassBsToDsPi->Fill(massDsPi);
           hPtDs->Fill(candDs.pt());
           hCPADs->Fill(candDs.cpa());
-          hPtPion->Fill(trackPion.pt());
+          hPtPion->Fill(trackPion.pt);
 
           // fill the candidate table for the Bs here:
           rowCandidateBase(thisCollId,
@@ -341,7 +345,7 @@ struct HfCandidateCreatorBs {
                            pVecPion[0], pVecPion[1], pVecPion[2],
                            dcaDs.getY(), dcaPion.getY(),
                            std::sqrt(dcaDs.getSigmaY2()), std::sqrt(dcaPion.getSigmaY2()),
-                           candDs.globalIndex(), trackPion.globalIndex(),
+                           candDs.globalIndex(), trackPion.globalIndex,
                            hfFlag);
         } // pi loop
       }   // Ds loop
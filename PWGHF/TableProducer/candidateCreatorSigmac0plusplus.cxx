@@ -89,6 +89,20 @@ struct HfCandidateCreatorSigmac0plusplus {
   // Preslice<CandidatesLc> hf3ProngPerCollision = aod::track_association::collisionId;
   Preslice<CandidatesLc> hf3ProngPerCollision = aod::hf_cand::collisionId;
 
+  /// Λc+ candidate of the current collision passing the selections for the Σc0,++ creation
+  struct SelectedCandidateLc {
+    int64_t globalIndex;
+    int collisionId;
+    std::array<float, 3> pVec;
+    uint8_t hfflag;
+    int statusSpreadMinvPKPiFromPDG;
+    int statusSpreadMinvPiKPFromPDG;
+    std::array<int, 3> indexProngs;
+    int charge;
+  };
+  std::vector<SelectedCandidateLc> selectedCandidatesLc; // selected Λc+ candidates of the current collision, shared by all its soft pions
+  int64_t nCandidatesLcThisColl{0};                      // Λc+ candidates of the current collision before the selections
+
   HistogramRegistry histos;
 
   /// @brief init function, to define the soft pion selections and histograms
@@ -161,16 +175,16 @@ struct HfCandidateCreatorSigmac0plusplus {
     runNumber = 0;
   }
 
-  /// @param trackSoftPi is the track (with dcaXY, dcaZ information)of a candidate soft-pion in the collision
-  /// @param candidates are 3-prong candidates satisfying the analysis selections for Λc+ → pK-π+ (and charge conj.)
-  /// @param tracks are the tracks (with dcaXY, dcaZ information) → soft-pion candidate tracks
-  template <typename TRK, typename CAND>
-  void makeSoftPiLcPair(TRK const& trackSoftPi, CAND const& candidatesThisColl, aod::TracksWDcaExtra const&)
+  /// @brief function to select the Λc+ → pK-π+ (and charge conj.) candidates of a collision, once for all the candidate soft pions of the collision
+  /// @param candidatesThisColl are 3-prong candidates satisfying the analysis selections for Λc+ → pK-π+ (and charge conj.) in the collision
+  template <typename CAND>
+  void selectLcCandidates(CAND const& candidatesThisColl)
   {
+    nCandidatesLcThisColl = candidatesThisColl.size();
+    selectedCandidatesLc.clear();
 
     /// loop over Λc+ → pK-π+ (and charge conj.) candidates
     for (const auto& candLc : candidatesThisColl) {
-      histos.fill(HIST("hCounter"), 4);
 
       /// keep only the candidates flagged as possible Λc+ (and charge conj.) decaying into a charged pion, kaon and proton
       /// if not selected, skip it and go to the next one
@@ -206,9 +220,31 @@ struct HfCandidateCreatorSigmac0plusplus {
         /// none of the two possibilities are satisfied, therefore this candidate Lc can be skipped
         continue;
       }
-      histos.fill(HIST("hCounter"), 5);
 
-      // auto trackSoftPi = tracks.rawIteratorAt(trackId.trackId());
+      auto prong0 = candLc.template prong0_as<aod::TracksWDcaExtra>();
+      auto prong1 = candLc.template prong1_as<aod::TracksWDcaExtra>();
+      auto prong2 = candLc.template prong2_as<aod::TracksWDcaExtra>();
+      SelectedCandidateLc& selectedLc = selectedCandidatesLc.emplace_back();
+      selectedLc.globalIndex = candLc.globalIndex();
+      selectedLc.collisionId = candLc.collisionId();
+      selectedLc.pVec = {candLc.px(), candLc.py(), candLc.pz()};
+      selectedLc.hfflag = candLc.hfflag();
+      selectedLc.statusSpreadMinvPKPiFromPDG = statusSpreadMinvPKPiFromPDG;
+      selectedLc.statusSpreadMinvPiKPFromPDG = statusSpreadMinvPiKPFromPDG;
+      selectedLc.indexProngs = {static_cast<int>(prong0.globalIndex()), static_cast<int>(prong1.globalIndex()), static_cast<int>(prong2.globalIndex())};
+      selectedLc.charge = prong0.sign() + prong1.sign() + prong2.sign();
+    } /// end loop over Λc+ → pK-π+ (and charge conj.) candidates
+  }
+
+  /// @param trackSoftPi is the track (with dcaXY, dcaZ information)of a candidate soft-pion in the collision
+  template <typename TRK>
+  void makeSoftPiLcPair(TRK const& trackSoftPi)
+  {
+    histos.fill(HIST("hCounter"), 4, nCandidatesLcThisColl);
+    histos.fill(HIST("hCounter"), 5, selectedCandidatesLc.size());
+
+    /// loop over the selected Λc+ → pK-π+ (and charge conj.) candidates
+    for (const auto& candLc : selectedCandidatesLc) {
 
       //////////////////////////////////////////////////////////////////////////////////////
       ///                       Σc0,++ candidate creation                                ///
@@ -217,17 +253,14 @@ struct HfCandidateCreatorSigmac0plusplus {
       //////////////////////////////////////////////////////////////////////////////////////
 
       /// Exclude the current candidate soft pion if it corresponds already to a candidate Lc prong
-      int indexProng0 = candLc.template prong0_as<aod::TracksWDcaExtra>().globalIndex();
-      int indexProng1 = candLc.template prong1_as<aod::TracksWDcaExtra>().globalIndex();
-      int indexProng2 = candLc.template prong2_as<aod::TracksWDcaExtra>().globalIndex();
       int indexSoftPi = trackSoftPi.globalIndex();
-      if (indexSoftPi == indexProng0 || indexSoftPi == indexProng1 || indexSoftPi == indexProng2) {
+      if (indexSoftPi == candLc.indexProngs[0] || indexSoftPi == candLc.indexProngs[1] || indexSoftPi == candLc.indexProngs[2]) {
         continue;
       }
       histos.fill(HIST("hCounter"), 6);
 
       /// determine the Σc candidate charge
-      int chargeLc = candLc.template prong0_as<aod::TracksWDcaExtra>().sign() + candLc.template prong1_as<aod::TracksWDcaExtra>().sign() + candLc.template prong2_as<aod::TracksWDcaExtra>().sign();
+      int chargeLc = candLc.charge;
       int chargeSoftPi = trackSoftPi.sign();
       int8_t chargeSigmac = chargeLc + chargeSoftPi;
       if (std::abs(chargeSigmac) != 0 && std::abs(chargeSigmac) != 2) {
@@ -238,28 +271,25 @@ struct HfCandidateCreatorSigmac0plusplus {
 
       /// fill the Σc0,++ candidate table
       rowScCandidates(/* general columns */
-                      candLc.collisionId(),
+                      candLc.collisionId,
                       /* 2-prong specific columns */
-                      candLc.px(), candLc.py(), candLc.pz(),
+                      candLc.pVec[0], candLc.pVec[1], candLc.pVec[2],
                       trackSoftPi.px(), trackSoftPi.py(), trackSoftPi.pz(),
-                      candLc.globalIndex(), trackSoftPi.globalIndex(),
-                      candLc.hfflag(),
+                      candLc.globalIndex, trackSoftPi.globalIndex(),
+                      candLc.hfflag,
                       /* Σc0,++ specific columns */
                       chargeSigmac,
-                      statusSpreadMinvPKPiFromPDG, statusSpreadMinvPiKPFromPDG);
+                      candLc.statusSpreadMinvPKPiFromPDG, candLc.statusSpreadMinvPiKPFromPDG);
     } /// end loop over Λc+ → pK-π+ (and charge conj.) candidates
   }   /// end makeSoftPiLcPair
 
   /// @brief function to loop over candidate soft pions and, for each of them, over candidate Λc+ for Σc0,++ → Λc+(→pK-π+) π- candidate reconstruction
   /// @param collision is a o2::aod::Collisions
   /// @param trackSoftPi is the track (with dcaXY, dcaZ information)of a candidate soft-pion in the collision
-  /// @param tracks are the tracks (with dcaXY, dcaZ information) → soft-pion candidate tracks
-  /// @param candidates are 3-prong candidates satisfying the analysis selections for Λc+ → pK-π+ (and charge conj.)
+  /// The Λc+ candidates of the collision are those selected beforehand by selectLcCandidates
   template <bool withTimeAssoc, typename TRK>
   void createSigmaC(aod::Collisions::iterator const& collision,
                     TRK const& trackSoftPi,
-                    aod::TracksWDcaExtra const& tracks,
-                    CandidatesLc const& candidates,
                     aod::BCsWithTimestamps const&)
   {
 
@@ -304,14 +334,7 @@ struct HfCandidateCreatorSigmac0plusplus {
     histos.fill(HIST("hCounter"), 3);
 
     /// loop over Λc+ → pK-π+ (and charge conj.) candidates
-    if constexpr (withTimeAssoc) {
-      /// need to group candidates manually
-      auto candidatesThisColl = candidates.sliceBy(hf3ProngPerCollision, thisCollId);
-      makeSoftPiLcPair(trackSoftPi, candidatesThisColl, tracks);
-    } else {
-      /// tracks and candidates already grouped by collision at the level of process function
-      makeSoftPiLcPair(trackSoftPi, candidates, tracks);
-    }
+    makeSoftPiLcPair(trackSoftPi);
 
   } /// end createSigmaC
 
@@ -335,13 +358,17 @@ struct HfCandidateCreatorSigmac0plusplus {
       auto trackIdsThisCollision = trackIndices.sliceBy(trackIndicesPerCollision, collision.globalIndex());
       // LOG(info) << "[processDataTrackToCollAssoc]     - number of tracks: " << trackIdsThisCollision.size();
 
+      /// need to group candidates manually, the selected ones are then shared by all the soft pions
+      auto candidatesThisColl = candidates.sliceBy(hf3ProngPerCollision, collision.globalIndex());
+      selectLcCandidates(candidatesThisColl);
+
       /// loop over tracks for soft pion
       for (const auto& trackId : trackIdsThisCollision) {
         /// slice soft pion tracks associated to the current collision
         auto trackSoftPi = trackId.track_as<aod::TracksWDcaExtra>();
 
         /// create SigmaC candidate with the current soft pion and Lc candidates
-        createSigmaC<true>(collision, trackSoftPi, tracks, candidates, bcWithTimeStamps);
+        createSigmaC<true>(collision, trackSoftPi, bcWithTimeStamps);
 
       } /// end loop over tracks for soft pion
 
@@ -364,12 +391,15 @@ struct HfCandidateCreatorSigmac0plusplus {
     // LOG(info) << "[processDataNoTrackToCollAssoc]     - number of tracks: " << tracks.size();
     // LOG(info) << "[processDataNoTrackToCollAssoc]     - number of Lc candidates: " << candidates.size();
 
+    /// tracks and candidates already grouped by collision at the level of process function
+    selectLcCandidates(candidates);
+
     /// loop over tracks for soft pion
     /// In this case, they are already grouped by collision, using the track::CollisionId
     for (const auto& trackSoftPi : tracks) {
 
       /// create SigmaC candidate with the current soft pion and Lc candidates
-      createSigmaC<false>(collision, trackSoftPi, tracks, candidates, bcWithTimeStamps);
+      createSigmaC<false>(collision, trackSoftPi, bcWithTimeStamps);
 
     } /// end loop over tracks for soft pion
   }
@@ -15,6 +15,9 @@
 /// \author Nima Zardoshti <nima.zardoshti@cern.ch>, CERN
 /// \author Vít Kučera <vit.kucera@cern.ch>, CERN
 
+#include <array>
+#include <vector>
+
 #include "CommonConstants/PhysicsConstants.h"
 #include "Framework/AnalysisTask.h"
 #include "Framework/runDataProcessing.h"
@@ -72,6 +75,8 @@ struct HfCandidateSelectorD0 {
   Configurable<std::vector<std::string>> onnxFileNames{"onnxFileNames", std::vector<std::string>{"ModelHandler_onnx_D0ToKPi.onnx"}, "ONNX file names for each pT bin (if not from CCDB full path)"};
   Configurable<int64_t> timestampCCDB{"timestampCCDB", -1, "timestamp of the ONNX file for ML model used to query in CCDB"};
   Configurable<bool> loadModelsFromCCDB{"loadModelsFromCCDB", false, "Flag to enable or disable the loading of models from CCDB"};
+  // bulk selection
+  Configurable<bool> selectInBulk{"selectInBulk", false, "Select the whole candidate table at once: PID status computed once per track and ML applied in one batch to the candidates passing the cuts"};
 
   o2::analysis::HfMlResponseD0ToKPi<float> hfMlResponse;
   std::vector<float> outputMlD0 = {};
@@ -81,6 +86,24 @@ struct HfCandidateSelectorD0 {
   TrackSelectorKa selectorKaon;
   HfHelper hfHelper;
 
+  /// Selection status of a candidate
+  struct SelectionStatus {
+    int statusD0 = 0;
+    int statusD0bar = 0;
+    int statusHFFlag = 0;
+    int statusTopol = 0;
+    int statusCand = 0;
+    int statusPID = 0;
+  };
+  std::vector<SelectionStatus> statusCandidates;           // selection status of the candidates, bulk selection
+  TrackSelectorPidStatusTable pidStatusTracks;             // PID status of the tracks for the kaon (0) and pion (1) hypotheses, bulk selection
+  std::vector<int64_t> indicesCandidatesMlD0;              // candidates passing the cuts as D0, bulk selection
+  std::vector<int64_t> indicesCandidatesMlD0bar;           // candidates passing the cuts as D0bar, bulk selection
+  std::vector<bool> isSelectedMlCandidatesD0;              // ML decision for the candidates in indicesCandidatesMlD0
+  std::vector<bool> isSelectedMlCandidatesD0bar;           // ML decision for the candidates in indicesCandidatesMlD0bar
+  std::vector<std::vector<float>> outputMlCandidatesD0;    // ML scores for the candidates in indicesCandidatesMlD0
+  std::vector<std::vector<float>> outputMlCandidatesD0bar; // ML scores for the candidates in indicesCandidatesMlD0bar
+
   using TracksSel = soa::Join<aod::TracksWDcaExtra, aod::TracksPidPi, aod::PidTpcTofFullPi, aod::TracksPidKa, aod::PidTpcTofFullKa>;
 
   // Define histograms
@@ -251,6 +274,38 @@ struct HfCandidateSelectorD0 {
 
     return true;
   }
+  /// Track-level PID status for the kaon and pion hypotheses
+  /// \param track is the track
+  /// \return PID status (TrackSelectorPID::Status) for the kaon and the pion hypotheses
+  template <typename T>
+  std::array<int, 2> getPidStatusTrack(const T& track)
+  {
+    if (usePidTpcOnly) {
+      return {selectorKaon.statusTpc(track), selectorPion.statusTpc(track)};
+    }
+    if (usePidTpcAndTof) {
+      return {selectorKaon.statusTpcAndTof(track), selectorPion.statusTpcAndTof(track)};
+    }
+    return {selectorKaon.statusTpcOrTof(track), selectorPion.statusTpcOrTof(track)};
+  }
+
+  /// Candidate-level PID status from the track-level ones
+  /// \param pidTrackPion is the PID status of the track with the pion hypothesis
+  /// \param pidTrackKaon is the PID status of the track with the kaon hypothesis
+  /// \return 1 if accepted, 0 if excluded, -1 if undecided
+  int getPidStatusCandidate(int pidTrackPion, int pidTrackKaon)
+  {
+    if (pidTrackPion == TrackSelectorPID::Accepted &&
+        pidTrackKaon == TrackSelectorPID::Accepted) {
+      return 1; // accept
+    }
+    if (pidTrackPion == TrackSelectorPID::Rejected ||
+        pidTrackKaon == TrackSelectorPID::Rejected) {
+      return 0; // exclude
+    }
+    return -1;
+  }
+
   template <int reconstructionType, typename CandType>
   void processSel(CandType const& candidates,
                   TracksSel const&)
@@ -311,48 +366,13 @@ struct HfCandidateSelectorD0 {
 
       if (usePid) {
         // track-level PID selection
-        int pidTrackPosKaon = -1;
-        int pidTrackPosPion = -1;
-        int pidTrackNegKaon = -1;
-        int pidTrackNegPion = -1;
-
-        if (usePidTpcOnly) {
-          pidTrackPosKaon = selectorKaon.statusTpc(trackPos);
-          pidTrackPosPion = selectorPion.statusTpc(trackPos);
-          pidTrackNegKaon = selectorKaon.statusTpc(trackNeg);
-          pidTrackNegPion = selectorPion.statusTpc(trackNeg);
-        } else if (usePidTpcAndTof) {
-          pidTrackPosKaon = selectorKaon.statusTpcAndTof(trackPos);
-          pidTrackPosPion = selectorPion.statusTpcAndTof(trackPos);
-          pidTrackNegKaon = selectorKaon.statusTpcAndTof(trackNeg);
-          pidTrackNegPion = selectorPion.statusTpcAndTof(trackNeg);
-        } else {
-          pidTrackPosKaon = selectorKaon.statusTpcOrTof(trackPos);
-          pidTrackPosPion = selectorPion.statusTpcOrTof(trackPos);
-          pidTrackNegKaon = selectorKaon.statusTpcOrTof(trackNeg);
-          pidTrackNegPion = selectorPion.statusTpcOrTof(trackNeg);
-        }
+        auto [pidTrackPosKaon, pidTrackPosPion] = getPidStatusTrack(trackPos);
+        auto [pidTrackNegKaon, pidTrackNegPion] = getPidStatusTrack(trackNeg);
 
         // int pidBayesTrackPos1Pion = selectorPion.statusBayes(trackPos);
 
-        int pidD0 = -1;
-        int pidD0bar = -1;
-
-        if (pidTrackPosPion == TrackSelectorPID::Accepted &&
-            pidTrackNegKaon == TrackSelectorPID::Accepted) {
-          pidD0 = 1; // accept D0
-        } else if (pidTrackPosPion == TrackSelectorPID::Rejected ||
-                   pidTrackNegKaon == TrackSelectorPID::Rejected) {
-          pidD0 = 0; // exclude D0
-        }
-
-        if (pidTrackNegPion == TrackSelectorPID::Accepted &&
-            pidTrackPosKaon == TrackSelectorPID::Accepted) {
-          pidD0bar = 1; // accept D0bar
-        } else if (pidTrackNegPion == TrackSelectorPID::Rejected ||
-                   pidTrackPosKaon == TrackSelectorPID::Rejected) {
-          pidD0bar = 0; // exclude D0bar
-        }
+        int pidD0 = getPidStatusCandidate(pidTrackPosPion, pidTrackNegKaon);
+        int pidD0bar = getPidStatusCandidate(pidTrackNegPion, pidTrackPosKaon);
 
         if (pidD0 == 0 && pidD0bar == 0) {
           hfSelD0Candidate(statusD0, statusD0bar, statusHFFlag, statusTopol, statusCand, statusPID);
@@ -420,14 +440,157 @@ struct HfCandidateSelectorD0 {
     }
   }
 
+  /// Selection of the whole candidate table at once
+  /// The cuts are applied to all the candidates first, with the PID status computed once per track in a status table,
+  /// then the ML model is applied in one batch per pT bin to the candidates passing them
+  template <int reconstructionType, typename CandType>
+  void processSelBulk(CandType const& candidates,
+                      TracksSel const& tracks)
+  {
+    statusCandidates.assign(candidates.size(), SelectionStatus{});
+    if (usePid) {
+      if (usePidTpcOnly) {
+        pidStatusTracks.build<TrackSelectorPidStatusTable::Mode::Tpc>(tracks, selectorKaon, selectorPion);
+      } else if (usePidTpcAndTof) {
+        pidStatusTracks.build<TrackSelectorPidStatusTable::Mode::TpcAndTof>(tracks, selectorKaon, selectorPion);
+      } else {
+        pidStatusTracks.build<TrackSelectorPidStatusTable::Mode::TpcOrTof>(tracks, selectorKaon, selectorPion);
+      }
+    }
+    indicesCandidatesMlD0.clear();
+    indicesCandidatesMlD0bar.clear();
+
+    // topological and PID selections
+    for (const auto& candidate : candidates) {
+      auto& status = statusCandidates[candidate.globalIndex()];
+      if (!(candidate.hfflag() & 1 << aod::hf_cand_2prong::DecayType::D0ToPiK)) {
+        continue;
+      }
+      status.statusHFFlag = 1;
+
+      if (!selectionTopol<reconstructionType>(candidate)) {
+        continue;
+      }
+      status.statusTopol = 1;
+
+      auto trackPos = candidate.template prong0_as<TracksSel>(); // positive daughter
+      auto trackNeg = candidate.template prong1_as<TracksSel>(); // negative daughter
+      bool topolD0 = selectionTopolConjugate<reconstructionType>(candidate, trackPos, trackNeg);
+      bool topolD0bar = selectionTopolConjugate<reconstructionType>(candidate, trackNeg, trackPos);
+      if (!topolD0 && !topolD0bar) {
+        continue;
+      }
+      status.statusCand = 1;
+
+      if (usePid) {
+        int pidD0 = getPidStatusCandidate(pidStatusTracks.getStatus(candidate.prong0Id(), 1), pidStatusTracks.getStatus(candidate.prong1Id(), 0));
+        int pidD0bar = getPidStatusCandidate(pidStatusTracks.getStatus(candidate.prong1Id(), 1), pidStatusTracks.getStatus(candidate.prong0Id(), 0));
+        if (pidD0 == 0 && pidD0bar == 0) {
+          continue;
+        }
+        if ((pidD0 == -1 || pidD0 == 1) && topolD0) {
+          status.statusD0 = 1; // identified as D0
+        }
+        if ((pidD0bar == -1 || pidD0bar == 1) && topolD0bar) {
+          status.statusD0bar = 1; // identified as D0bar
+        }
+        status.statusPID = 1;
+      } else {
+        if (topolD0) {
+          status.statusD0 = 1; // identified as D0
+        }
+        if (topolD0bar) {
+          status.statusD0bar = 1; // identified as D0bar
+        }
+      }
+      if (status.statusD0 > 0) {
+        indicesCandidatesMlD0.push_back(candidate.globalIndex());
+      }
+      if (status.statusD0bar > 0) {
+        indicesCandidatesMlD0bar.push_back(candidate.globalIndex());
+      }
+    }
+
+    if (!applyMl) {
+      for (const auto& status : statusCandidates) {
+        hfSelD0Candidate(status.statusD0, status.statusD0bar, status.statusHFFlag, status.statusTopol, status.statusCand, status.statusPID);
+      }
+      return;
+    }
+
+    // ML selections, only on the candidates passing the cuts
+    auto getPtCand = [&candidates](int64_t indexCand) { return candidates.rawIteratorAt(indexCand).pt(); };
+    auto fillInputFeatures = [this, &candidates](int64_t indexCand, int pdgCode, float* inputFeatures) {
+      auto candidate = candidates.rawIteratorAt(indexCand);
+      hfMlResponse.fillInputFeatures(candidate, candidate.template prong0_as<TracksSel>(), candidate.template prong1_as<TracksSel>(), pdgCode, inputFeatures);
+    };
+    hfMlResponse.isSelectedMlFill(
+      indicesCandidatesMlD0, getPtCand, hfMlResponse.getNInputFeatures(), [&fillInputFeatures](int64_t indexCand, float* inputFeatures) { fillInputFeatures(indexCand, o2::constants::physics::kD0, inputFeatures); }, isSelectedMlCandidatesD0, outputMlCandidatesD0);
+    hfMlResponse.isSelectedMlFill(
+      indicesCandidatesMlD0bar, getPtCand, hfMlResponse.getNInputFeatures(), [&fillInputFeatures](int64_t indexCand, float* inputFeatures) { fillInputFeatures(indexCand, o2::constants::physics::kD0Bar, inputFeatures); }, isSelectedMlCandidatesD0bar, outputMlCandidatesD0bar);
+
+    // fill the tables in the order of the candidates
+    const std::vector<float> outputMlEmpty{};
+    std::size_t iMlD0{0}, iMlD0bar{0};
+    for (int64_t indexCand{0}; indexCand < static_cast<int64_t>(statusCandidates.size()); ++indexCand) {
+      auto& status = statusCandidates[indexCand];
+      const std::vector<float>* outputD0 = &outputMlEmpty;
+      const std::vector<float>* outputD0bar = &outputMlEmpty;
+      bool isSelectedMlD0 = false;
+      bool isSelectedMlD0bar = false;
+      if (iMlD0 < indicesCandidatesMlD0.size() && indicesCandidatesMlD0[iMlD0] == indexCand) {
+        isSelectedMlD0 = isSelectedMlCandidatesD0[iMlD0];
+        outputD0 = &outputMlCandidatesD0[iMlD0];
+        ++iMlD0;
+      }
+      if (iMlD0bar < indicesCandidatesMlD0bar.size() && indicesCandidatesMlD0bar[iMlD0bar] == indexCand) {
+        isSelectedMlD0bar = isSelectedMlCandidatesD0bar[iMlD0bar];
+        outputD0bar = &outputMlCandidatesD0bar[iMlD0bar];
+        ++iMlD0bar;
+      }
+      if (!isSelectedMlD0) {
+        status.statusD0 = 0;
+      }
+      if (!isSelectedMlD0bar) {
+        status.statusD0bar = 0;
+      }
+      hfMlD0Candidate(*outputD0, *outputD0bar);
+
+      if (enableDebugMl) {
+        auto candidate = candidates.rawIteratorAt(indexCand);
+        if (isSelectedMlD0) {
+          registry.fill(HIST("DebugBdt/hBdtScore1VsStatus"), (*outputD0)[0], status.statusD0);
+          registry.fill(HIST("DebugBdt/hBdtScore2VsStatus"), (*outputD0)[1], status.statusD0);
+          registry.fill(HIST("DebugBdt/hBdtScore3VsStatus"), (*outputD0)[2], status.statusD0);
+          registry.fill(HIST("DebugBdt/hMassDmesonSel"), hfHelper.invMassD0ToPiK(candidate));
+        }
+        if (isSelectedMlD0bar) {
+          registry.fill(HIST("DebugBdt/hBdtScore1VsStatus"), (*outputD0bar)[0], status.statusD0bar);
+          registry.fill(HIST("DebugBdt/hBdtScore2VsStatus"), (*outputD0bar)[1], status.statusD0bar);
+          registry.fill(HIST("DebugBdt/hBdtScore3VsStatus"), (*outputD0bar)[2], status.statusD0bar);
+          registry.fill(HIST("DebugBdt/hMassDmesonSel"), hfHelper.invMassD0barToKPi(candidate));
+        }
+      }
+      hfSelD0Candidate(status.statusD0, status.statusD0bar, status.statusHFFlag, status.statusTopol, status.statusCand, status.statusPID);
+    }
+  }
+
   void processWithDCAFitterN(aod::HfCand2Prong const& candidates, TracksSel const& tracks)
   {
+    if (selectInBulk) {
+      processSelBulk<aod::hf_cand::VertexerType::DCAFitter>(candidates, tracks);
+      return;
+    }
     processSel<aod::hf_cand::VertexerType::DCAFitter>(candidates, tracks);
   }
   PROCESS_SWITCH(HfCandidateSelectorD0, processWithDCAFitterN, "process candidates selection with DCAFitterN", true);
 
   void processWithKFParticle(soa::Join<aod::HfCand2Prong, aod::HfCand2ProngKF> const& candidates, TracksSel const& tracks)
   {
+    if (selectInBulk) {
+      processSelBulk<aod::hf_cand::VertexerType::KfParticle>(candidates, tracks);
+      return;
+    }
     processSel<aod::hf_cand::VertexerType::KfParticle>(candidates, tracks);
   }
   PROCESS_SWITCH(HfCandidateSelectorD0, processWithKFParticle, "process candidates selection with KFParticle", false);
@@ -37,6 +37,8 @@ struct HfDerivedDataCreatorD0ToKPi {
   // Candidates
   Produces<o2::aod::HfD0Bases> rowCandidateBase;
   Produces<o2::aod::HfD0Pars> rowCandidatePar;
+  Produces<o2::aod::HfD0Tops> rowCandidateTop;
+  Produces<o2::aod::HfD0PidBs> rowCandidatePidB;
   Produces<o2::aod::HfD0ParEs> rowCandidateParE;
   Produces<o2::aod::HfD0Sels> rowCandidateSel;
   Produces<o2::aod::HfD0Mls> rowCandidateMl;
@@ -56,6 +58,7 @@ struct HfDerivedDataCreatorD0ToKPi {
   // Switches for filling tables
   Configurable<bool> fillCandidateBase{"fillCandidateBase", true, "Fill candidate base properties"};
   Configurable<bool> fillCandidatePar{"fillCandidatePar", true, "Fill candidate parameters"};
+  Configurable<bool> packCandidatePar{"packCandidatePar", false, "Fill candidate parameters in separate topological and PID tables with nσ stored with 8 bits"};
   Configurable<bool> fillCandidateParE{"fillCandidateParE", true, "Fill candidate extended parameters"};
   Configurable<bool> fillCandidateSel{"fillCandidateSel", true, "Fill candidate selection flags"};
   Configurable<bool> fillCandidateMl{"fillCandidateMl", true, "Fill candidate selection ML scores"};
@@ -204,7 +207,7 @@ struct HfDerivedDataCreatorD0ToKPi {
         invMass,
         y);
     }
-    if (fillCandidatePar) {
+    if (fillCandidatePar && !packCandidatePar) {
       rowCandidatePar(
         candidate.chi2PCA(),
         candidate.cpa(),
@@ -234,6 +237,37 @@ struct HfDerivedDataCreatorD0ToKPi {
         candidate.maxNormalisedDeltaIP(),
         candidate.impactParameterProduct());
     }
+    if (fillCandidatePar && packCandidatePar) {
+      rowCandidateTop(
+        candidate.chi2PCA(),
+        candidate.cpa(),
+        candidate.cpaXY(),
+        candidate.decayLength(),
+        candidate.decayLengthXY(),
+        candidate.decayLengthNormalised(),
+        candidate.decayLengthXYNormalised(),
+        candidate.ptProng0(),
+        candidate.ptProng1(),
+        candidate.impactParameter0(),
+        candidate.impactParameter1(),
+        candidate.impactParameterNormalised0(),
+        candidate.impactParameterNormalised1(),
+        candidate.maxNormalisedDeltaIP(),
+        candidate.impactParameterProduct());
+      rowCandidatePidB(
+        o2::aod::hf_cand_par_binned::packNSigma(prong0.tpcNSigmaPi()),
+        o2::aod::hf_cand_par_binned::packNSigma(prong0.tpcNSigmaKa()),
+        o2::aod::hf_cand_par_binned::packNSigma(prong0.tofNSigmaPi()),
+        o2::aod::hf_cand_par_binned::packNSigma(prong0.tofNSigmaKa()),
+        o2::aod::hf_cand_par_binned::packNSigma(prong0.tpcTofNSigmaPi()),
+        o2::aod::hf_cand_par_binned::packNSigma(prong0.tpcTofNSigmaKa()),
+        o2::aod::hf_cand_par_binned::packNSigma(prong1.tpcNSigmaPi()),
+        o2::aod::hf_cand_par_binned::packNSigma(prong1.tpcNSigmaKa()),
+        o2::aod::hf_cand_par_binned::packNSigma(prong1.tofNSigmaPi()),
+        o2::aod::hf_cand_par_binned::packNSigma(prong1.tofNSigmaKa()),
+        o2::aod::hf_cand_par_binned::packNSigma(prong1.tpcTofNSigmaPi()),
+        o2::aod::hf_cand_par_binned::packNSigma(prong1.tpcTofNSigmaKa()));
+    }
     if (fillCandidateParE) {
       rowCandidateParE(
         candidate.xSecondaryVertex(),
@@ -333,7 +367,12 @@ struct HfDerivedDataCreatorD0ToKPi {
 
       // Fill candidate properties
       reserveTable(rowCandidateBase, fillCandidateBase, sizeTableCand);
-      reserveTable(rowCandidatePar, fillCandidatePar, sizeTableCand);
+      if (packCandidatePar) {
+        reserveTable(rowCandidateTop, fillCandidatePar, sizeTableCand);
+        reserveTable(rowCandidatePidB, fillCandidatePar, sizeTableCand);
+      } else {
+        reserveTable(rowCandidatePar, fillCandidatePar, sizeTableCand);
+      }
       reserveTable(rowCandidateParE, fillCandidateParE, sizeTableCand);
       reserveTable(rowCandidateSel, fillCandidateSel, sizeTableCand);
       reserveTable(rowCandidateId, fillCandidateId, sizeTableCand);
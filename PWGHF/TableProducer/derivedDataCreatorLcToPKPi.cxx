@@ -37,6 +37,8 @@ struct HfDerivedDataCreatorLcToPKPi {
   // Candidates
   Produces<o2::aod::Hf3PBases> rowCandidateBase;
   Produces<o2::aod::Hf3PPars> rowCandidatePar;
+  Produces<o2::aod::Hf3PTops> rowCandidateTop;
+  Produces<o2::aod::Hf3PPidBs> rowCandidatePidB;
   Produces<o2::aod::Hf3PParEs> rowCandidateParE;
   Produces<o2::aod::Hf3PSels> rowCandidateSel;
   Produces<o2::aod::Hf3PMls> rowCandidateMl;
@@ -56,6 +58,7 @@ struct HfDerivedDataCreatorLcToPKPi {
   // Switches for filling tables
   Configurable<bool> fillCandidateBase{"fillCandidateBase", true, "Fill candidate base properties"};
   Configurable<bool> fillCandidatePar{"fillCandidatePar", true, "Fill candidate parameters"};
+  Configurable<bool> packCandidatePar{"packCandidatePar", false, "Fill candidate parameters in separate topological and PID tables with nσ stored with 8 bits"};
   Configurable<bool> fillCandidateParE{"fillCandidateParE", true, "Fill candidate extended parameters"};
   Configurable<bool> fillCandidateSel{"fillCandidateSel", true, "Fill candidate selection flags"};
   Configurable<bool> fillCandidateMl{"fillCandidateMl", true, "Fill candidate selection ML scores"};
@@ -187,7 +190,7 @@ struct HfDerivedDataCreatorLcToPKPi {
         invMass,
         y);
     }
-    if (fillCandidatePar) {
+    if (fillCandidatePar && !packCandidatePar) {
       rowCandidatePar(
         candidate.chi2PCA(),
         candidate.nProngsContributorsPV(),
@@ -222,6 +225,42 @@ struct HfDerivedDataCreatorLcToPKPi {
         prong2.tpcTofNSigmaPi(),
         prong2.tpcTofNSigmaPr());
     }
+    if (fillCandidatePar && packCandidatePar) {
+      rowCandidateTop(
+        candidate.chi2PCA(),
+        candidate.nProngsContributorsPV(),
+        candidate.cpa(),
+        candidate.cpaXY(),
+        candidate.decayLength(),
+        candidate.decayLengthXY(),
+        candidate.decayLengthNormalised(),
+        candidate.decayLengthXYNormalised(),
+        candidate.ptProng0(),
+        candidate.ptProng1(),
+        candidate.ptProng2(),
+        candidate.impactParameter0(),
+        candidate.impactParameter1(),
+        candidate.impactParameter2(),
+        candidate.impactParameterNormalised0(),
+        candidate.impactParameterNormalised1(),
+        candidate.impactParameterNormalised2());
+      rowCandidatePidB(
+        o2::aod::hf_cand_par_binned::packNSigma(prong0.tpcNSigmaPi()),
+        o2::aod::hf_cand_par_binned::packNSigma(prong0.tpcNSigmaPr()),
+        o2::aod::hf_cand_par_binned::packNSigma(prong0.tofNSigmaPi()),
+        o2::aod::hf_cand_par_binned::packNSigma(prong0.tofNSigmaPr()),
+        o2::aod::hf_cand_par_binned::packNSigma(prong0.tpcTofNSigmaPi()),
+        o2::aod::hf_cand_par_binned::packNSigma(prong0.tpcTofNSigmaPr()),
+        o2::aod::hf_cand_par_binned::packNSigma(prong1.tpcNSigmaKa()),
+        o2::aod::hf_cand_par_binned::packNSigma(prong1.tofNSigmaKa()),
+        o2::aod::hf_cand_par_binned::packNSigma(prong1.tpcTofNSigmaKa()),
+        o2::aod::hf_cand_par_binned::packNSigma(prong2.tpcNSigmaPi()),
+        o2::aod::hf_cand_par_binned::packNSigma(prong2.tpcNSigmaPr()),
+        o2::aod::hf_cand_par_binned::packNSigma(prong2.tofNSigmaPi()),
+        o2::aod::hf_cand_par_binned::packNSigma(prong2.tofNSigmaPr()),
+        o2::aod::hf_cand_par_binned::packNSigma(prong2.tpcTofNSigmaPi()),
+        o2::aod::hf_cand_par_binned::packNSigma(prong2.tpcTofNSigmaPr()));
+    }
     if (fillCandidateParE) {
       rowCandidateParE(
         candidate.xSecondaryVertex(),
@@ -326,7 +365,12 @@ struct HfDerivedDataCreatorLcToPKPi {
 
       // Fill candidate properties
       reserveTable(rowCandidateBase, fillCandidateBase, sizeTableCand);
-      reserveTable(rowCandidatePar, fillCandidatePar, sizeTableCand);
+      if (packCandidatePar) {
+        reserveTable(rowCandidateTop, fillCandidatePar, sizeTableCand);
+        reserveTable(rowCandidatePidB, fillCandidatePar, sizeTableCand);
+      } else {
+        reserveTable(rowCandidatePar, fillCandidatePar, sizeTableCand);
+      }
       reserveTable(rowCandidateParE, fillCandidateParE, sizeTableCand);
       reserveTable(rowCandidateSel, fillCandidateSel, sizeTableCand);
       reserveTable(rowCandidateId, fillCandidateId, sizeTableCand);
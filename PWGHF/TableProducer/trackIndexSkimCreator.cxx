@@ -20,7 +20,7 @@
 /// \author Fabrizio Grosa <fgrosa@cern.ch>, CERN
 /// \author Federica Zanone <federica.zanone@cern.ch>, Heidelberg University
 
-#include <algorithm> // std::find
+#include <algorithm> // std::find, std::max
 #include <iterator>  // std::distance
 #include <string>    // std::string
 #include <vector>    // std::vector
@@ -92,6 +92,65 @@ enum ChannelsProtonPid {
 // kaon PID (opposite-sign track in 3-prong decays)
 constexpr int channelKaonPid = ChannelsProtonPid::NChannelsProtonPid;
 
+/// PV contributors of a collision and vertexer prepared once for all the refits excluding some of them
+/// The buffers are kept from one collision to the next to avoid reallocating them
+struct PvRefitContext {
+  std::vector<int64_t> globalIds{};                   // global indices of the PV contributors
+  std::vector<o2::track::TrackParCov> trackParCovs{}; // track parameters of the PV contributors
+  std::vector<bool> isUsed{};                         // contributors used in the refit
+  o2::dataformats::VertexBase primVtx{};              // original PV
+  o2::vertexing::PVertexer vertexer{};                // vertexer prepared for the refits
+  float bz{-999.f};                                   // magnetic field with which the vertexer was initialised
+  bool isPrepared{false};                             // vertexer prepared with the contributors of this collision
+  bool isRefitDoable{false};                          // enough contributors accepted for the refit
+
+  /// Removes the contributors of the previous collision
+  void clear()
+  {
+    globalIds.clear();
+    trackParCovs.clear();
+    isPrepared = false;
+    isRefitDoable = false;
+  }
+
+  /// Adds a PV contributor
+  template <typename TTrack>
+  void addContributor(TTrack const& track)
+  {
+    globalIds.push_back(track.globalIndex());
+    trackParCovs.push_back(getTrackParCov(track));
+  }
+
+  /// Prepares the vertexer with the contributors, the magnetic field must be already set
+  /// \param collision is the collision of the contributors
+  template <typename TCollision>
+  void prepare(TCollision const& collision)
+  {
+    primVtx.setX(collision.posX());
+    primVtx.setY(collision.posY());
+    primVtx.setZ(collision.posZ());
+    primVtx.setCov(collision.covXX(), collision.covXY(), collision.covYY(), collision.covXZ(), collision.covYZ(), collision.covZZ());
+    const float bzCurrent = o2::base::Propagator::Instance()->getNominalBz();
+    if (bzCurrent != bz) {
+      // configure PVertexer
+      o2::conf::ConfigurableParam::updateFromString("pvertexer.useMeanVertexConstraint=false"); /// remove diamond constraint (let's keep it at the moment...)
+      vertexer.init();
+      bz = bzCurrent;
+    }
+    isRefitDoable = vertexer.prepareVertexRefit(trackParCovs, primVtx);
+    isUsed.assign(globalIds.size(), true);
+    isPrepared = true;
+  }
+
+  /// \param globalIndex is the global index of a track
+  /// \return position of the track among the contributors, -1 if it is not a contributor
+  int find(int64_t globalIndex) const
+  {
+    auto it = std::find(globalIds.begin(), globalIds.end(), globalIndex);
+    return it != globalIds.end() ? static_cast<int>(std::distance(globalIds.begin(), it)) : -1;
+  }
+};
+
 /// Event selection
 struct HfTrackIndexSkimCreatorTagSelCollisions {
   Produces<aod::HfSelCollision> rowSelectedCollision;
@@ -259,6 +318,7 @@ struct HfTrackIndexSkimCreatorTagSelTracks {
   o2::base::MatLayerCylSet* lut;
   o2::base::Propagator::MatCorrType noMatCorr = o2::base::Propagator::MatCorrType::USEMatCorrNONE;
   int runNumber;
+  PvRefitContext pvRefitContext; // PV contributors of the current collision
 
   // single-track cuts
   static const int nCuts = 4;
@@ -670,8 +730,7 @@ struct HfTrackIndexSkimCreatorTagSelTracks {
   /// Method for the PV refit and DCA recalculation for tracks with a collision assigned
   /// \param collision is a collision
   /// \param bcWithTimeStamps is a table of bunch crossing joined with timestamps used to query the CCDB for B and material budget
-  /// \param vecPvContributorGlobId is a vector containing the global ID of PV contributors for the current collision
-  /// \param vecPvContributorTrackParCov is a vector containing the TrackParCov of PV contributors for the current collision
+  /// \param pvRefitContext contains the PV contributors of the current collision and the vertexer prepared for their refit
   /// \param trackToRemove is the track to be removed, if contributor, from the PV refit
   /// \param pvCoord is an array containing the coordinates of the refitted PV
   /// \param pvCovMatrix is an array containing the covariance matrix values of the refitted PV
@@ -679,15 +738,12 @@ struct HfTrackIndexSkimCreatorTagSelTracks {
   template <typename TTrack>
   void performPvRefitTrack(aod::Collision const& collision,
                            aod::BCsWithTimestamps const&,
-                           std::vector<int64_t> vecPvContributorGlobId,
-                           std::vector<o2::track::TrackParCov> vecPvContributorTrackParCov,
+                           PvRefitContext& pvRefitContext,
                            TTrack const& trackToRemove,
                            std::array<float, 3>& pvCoord,
                            std::array<float, 6>& pvCovMatrix,
                            std::array<float, 2>& dcaXYdcaZ)
   {
-    std::vector<bool> vecPvRefitContributorUsed(vecPvContributorGlobId.size(), true);
-
     /// Prepare the vertex refitting
     // set the magnetic field from CCDB
     auto bc = collision.bc_as<o2::aod::BCsWithTimestamps>();
@@ -717,17 +773,12 @@ struct HfTrackIndexSkimCreatorTagSelTracks {
       runNumber = bc.runNumber();
     }*/
 
-    // build the VertexBase to initialize the vertexer
-    o2::dataformats::VertexBase primVtx;
-    primVtx.setX(collision.posX());
-    primVtx.setY(collision.posY());
-    primVtx.setZ(collision.posZ());
-    primVtx.setCov(collision.covXX(), collision.covXY(), collision.covYY(), collision.covXZ(), collision.covYZ(), collision.covZZ());
-    // configure PVertexer
-    o2::vertexing::PVertexer vertexer;
-    o2::conf::ConfigurableParam::updateFromString("pvertexer.useMeanVertexConstraint=false"); /// remove diamond constraint (let's keep it at the moment...)
-    vertexer.init();
-    bool pvRefitDoable = vertexer.prepareVertexRefit(vecPvContributorTrackParCov, primVtx);
+    // prepare the vertexer once per collision, the same preparation is used for the refits of all its tracks
+    if (!pvRefitContext.isPrepared) {
+      pvRefitContext.prepare(collision);
+    }
+    const auto& primVtx = pvRefitContext.primVtx;
+    bool pvRefitDoable = pvRefitContext.isRefitDoable;
     if (!pvRefitDoable) {
       LOG(info) << "Not enough tracks accepted for the refit";
       if (doPvRefit && fillHistograms) {
@@ -735,7 +786,7 @@ struct HfTrackIndexSkimCreatorTagSelTracks {
       }
     }
     if (debugPvRefit) {
-      LOG(info) << "prepareVertexRefit = " << pvRefitDoable << " Ncontrib= " << vecPvContributorTrackParCov.size() << " Ntracks= " << collision.numContrib() << " Vtx= " << primVtx.asString();
+      LOG(info) << "prepareVertexRefit = " << pvRefitDoable << " Ncontrib= " << pvRefitContext.trackParCovs.size() << " Ntracks= " << collision.numContrib() << " Vtx= " << primVtx.asString();
     }
 
     if (fillHistograms) {
@@ -749,15 +800,13 @@ struct HfTrackIndexSkimCreatorTagSelTracks {
     bool recalcImpPar = false;
     if (doPvRefit && pvRefitDoable) {
       recalcImpPar = true;
-      auto trackIterator = std::find(vecPvContributorGlobId.begin(), vecPvContributorGlobId.end(), trackToRemove.globalIndex()); /// track global index
-      if (trackIterator != vecPvContributorGlobId.end()) {
+      const int entry = pvRefitContext.find(trackToRemove.globalIndex()); /// track global index
+      if (entry >= 0) {
 
         /// this track contributed to the PV fit: let's do the refit without it
-        const int entry = std::distance(vecPvContributorGlobId.begin(), trackIterator);
-
-        vecPvRefitContributorUsed[entry] = false; /// remove the track from the PV refitting
+        pvRefitContext.isUsed[entry] = false; /// remove the track from the PV refitting
 
-        auto primVtxRefitted = vertexer.refitVertex(vecPvRefitContributorUsed, primVtx); // vertex refit
+        auto primVtxRefitted = pvRefitContext.vertexer.refitVertex(pvRefitContext.isUsed, primVtx); // vertex refit
         // LOG(info) << "refit " << cnt << "/" << ntr << " result = " << primVtxRefitted.asString();
         if (debugPvRefit) {
           LOG(info) << "refit for track with global index " << static_cast<int>(trackToRemove.globalIndex()) << " " << primVtxRefitted.asString();
@@ -780,7 +829,7 @@ struct HfTrackIndexSkimCreatorTagSelTracks {
           registry.fill(HIST("PvRefit/hChi2vsNContrib"), primVtxRefitted.getNContributors(), primVtxRefitted.getChi2());
         }
 
-        vecPvRefitContributorUsed[entry] = true; /// restore the track for the next PV refitting (probably not necessary here)
+        pvRefitContext.isUsed[entry] = true; /// restore the track for the next PV refitting
 
         if (recalcImpPar) {
           // fill the histograms for refitted PV with good Chi2
@@ -872,6 +921,7 @@ struct HfTrackIndexSkimCreatorTagSelTracks {
                        std::vector<std::array<float, 6>>& pvRefitPvCovMatrixPerTrack)
   {
     auto thisCollId = collision.globalIndex();
+    bool hasPvContributors = false; // PV contributors of this collision already retrieved
     for (const auto& trackId : trackIndicesCollision) {
       int statusProng = BIT(CandidateType::NCandidateTypes) - 1; // all bits on
       auto track = trackId.template track_as<TTracks>();
@@ -888,23 +938,23 @@ struct HfTrackIndexSkimCreatorTagSelTracks {
         pvRefitPvCoord = {collision.posX(), collision.posY(), collision.posZ()};
         pvRefitPvCovMatrix = {collision.covXX(), collision.covXY(), collision.covYY(), collision.covXZ(), collision.covYZ(), collision.covZZ()};
 
-        /// retrieve PV contributors for the current collision
-        std::vector<int64_t> vecPvContributorGlobId = {};
-        std::vector<o2::track::TrackParCov> vecPvContributorTrackParCov = {};
-
-        for (const auto& contributor : pvContrCollision) {
-          vecPvContributorGlobId.push_back(contributor.globalIndex());
-          vecPvContributorTrackParCov.push_back(getTrackParCov(contributor));
-        }
-        if (debugPvRefit) {
-          LOG(info) << "### vecPvContributorGlobId.size()=" << vecPvContributorGlobId.size() << ", vecPvContributorTrackParCov.size()=" << vecPvContributorTrackParCov.size() << ", N. original contributors=" << collision.numContrib();
+        /// retrieve PV contributors for the current collision, once for all its tracks
+        if (!hasPvContributors) {
+          pvRefitContext.clear();
+          for (const auto& contributor : pvContrCollision) {
+            pvRefitContext.addContributor(contributor);
+          }
+          hasPvContributors = true;
+          if (debugPvRefit) {
+            LOG(info) << "### pvRefitContext.globalIds.size()=" << pvRefitContext.globalIds.size() << ", pvRefitContext.trackParCovs.size()=" << pvRefitContext.trackParCovs.size() << ", N. original contributors=" << collision.numContrib();
+          }
         }
 
         /// Perform the PV refit only for tracks with an assigned collision
         if (debugPvRefit) {
           LOG(info) << "[BEFORE performPvRefitTrack] track.collision().globalIndex(): " << collision.globalIndex();
         }
-        performPvRefitTrack(collision, bcWithTimeStamps, vecPvContributorGlobId, vecPvContributorTrackParCov, track, pvRefitPvCoord, pvRefitPvCovMatrix, pvRefitDcaXYDcaZ);
+        performPvRefitTrack(collision, bcWithTimeStamps, pvRefitContext, track, pvRefitPvCoord, pvRefitPvCovMatrix, pvRefitDcaXYDcaZ);
         // we subtract the offset since trackIdx is the global index referred to the total track table
         pvRefitDcaPerTrack[trackIdx] = pvRefitDcaXYDcaZ;
         pvRefitPvCoordPerTrack[trackIdx] = pvRefitPvCoord;
@@ -1125,6 +1175,8 @@ struct HfTrackIndexSkimCreator {
   // Tables with ML scores for HF Filters
   Produces<aod::Hf2ProngMlProbs> rowTrackIndexMlScoreProng2;
   Produces<aod::Hf3ProngMlProbs> rowTrackIndexMlScoreProng3;
+  Produces<aod::HfSvFit2Prong> rowProng2SvFit;
+  Produces<aod::HfSvFit3Prong> rowProng3SvFit;
 
   Configurable<bool> isRun2{"isRun2", false, "enable Run 2 or Run 3 GRP objects for magnetic field"};
   Configurable<bool> do3Prong{"do3Prong", 0, "do 3 prong"};
@@ -1132,6 +1184,7 @@ struct HfTrackIndexSkimCreator {
   Configurable<bool> debug{"debug", false, "debug mode"};
   Configurable<bool> debugPvRefit{"debugPvRefit", false, "debug lines for primary vertex refit"};
   Configurable<bool> fillHistograms{"fillHistograms", true, "fill histograms"};
+  Configurable<bool> fillSvFit{"fillSvFit", false, "fill the tables with the secondary-vertex fit of the 2- and 3-prong skims, to be used by the candidate creators instead of refitting"};
   // Configurable<int> nCollsMax{"nCollsMax", -1, "Max collisions per file"}; //can be added to run over limited collisions per file - for tesing purposes
   // preselection
   Configurable<double> ptTolerance{"ptTolerance", 0.1, "pT tolerance in GeV/c for applying preselections before vertex reconstruction"};
@@ -1185,6 +1238,7 @@ struct HfTrackIndexSkimCreator {
 
   // ML models for triggers
   Configurable<bool> applyMlForHfFilters{"applyMlForHfFilters", false, "Flag to enable ML application for HF Filters"};
+  Configurable<bool> applyMlForHfFiltersInBulk{"applyMlForHfFiltersInBulk", false, "Evaluate the ML models for HF Filters once per dataframe and species, without ML rejection of the candidates (selection left to the HF Filters)"};
   Configurable<std::string> mlModelPathCCDB{"mlModelPathCCDB", "EventFiltering/PWGHF/BDTSmeared", "Path on CCDB of ML models for HF Filters"};
   Configurable<int64_t> timestampCcdbForHfFilters{"timestampCcdbForHfFilters", 1657032422771, "timestamp of the ONNX file for ML model used to query in CCDB"};
   Configurable<bool> loadMlModelsFromCCDB{"loadMlModelsFromCCDB", true, "Flag to enable or disable the loading of ML models from CCDB"};
@@ -1205,6 +1259,7 @@ struct HfTrackIndexSkimCreator {
   o2::base::MatLayerCylSet* lut;
   o2::base::Propagator::MatCorrType noMatCorr = o2::base::Propagator::MatCorrType::USEMatCorrNONE;
   int runNumber;
+  PvRefitContext pvRefitContext; // PV contributors of the current collision
 
   double massPi{0.};
   double massK{0.};
@@ -1213,6 +1268,7 @@ struct HfTrackIndexSkimCreator {
   double massMuon{0.};
   double massDzero{0.};
   double massPhi{0.};
+  double maxMass3Prong{-1.}; // largest upper mass limit of the 3-prong preselections, negative if some channel has no mass selection
 
   // int nColls{0}; //can be added to run over limited collisions per file - for tesing purposes
 
@@ -1233,6 +1289,11 @@ struct HfTrackIndexSkimCreator {
   o2::analysis::MlResponse<float> hfMlResponse2Prongs;                             // only D0
   std::array<o2::analysis::MlResponse<float>, kN3ProngDecays> hfMlResponse3Prongs; // D+, Lc, Ds, Xic
   std::array<bool, kN3ProngDecays> hasMlModel3Prong{false};
+  // ML input features and selection bitmaps of the filled candidates, evaluated at the end of the dataframe with applyMlForHfFiltersInBulk
+  std::vector<std::vector<float>> mlInputsBulk2Prong{};
+  std::vector<int> mlSelectedBulk2Prong{};
+  std::vector<std::vector<float>> mlInputsBulk3Prong{};
+  std::vector<int> mlSelectedBulk3Prong{};
   o2::ccdb::CcdbApi ccdbApi;
 
   using SelectedCollisions = soa::Filtered<soa::Join<aod::Collisions, aod::HfSelCollision>>;
@@ -1304,6 +1365,20 @@ struct HfTrackIndexSkimCreator {
     cut3Prong = {cutsDplusToPiKPi, cutsLcToPKPi, cutsDsToKKPi, cutsXicToPKPi};
     pTBins3Prong = {binsPtDplusToPiKPi, binsPtLcToPKPi, binsPtDsToKKPi, binsPtXicToPKPi};
 
+    // upper mass limit of all the 3-prong channels and pT bins, used to reject the track pairs that cannot form any 3-prong candidate
+    maxMass3Prong = 0.;
+    for (int iDecay3P = 0; iDecay3P < kN3ProngDecays && maxMass3Prong >= 0.; iDecay3P++) {
+      for (int iBin = 0; iBin + 1 < static_cast<int>(pTBins3Prong[iDecay3P].size()); iBin++) {
+        double minMass = cut3Prong[iDecay3P].get(iBin, 0u);
+        double maxMass = cut3Prong[iDecay3P].get(iBin, 1u);
+        if (minMass < 0. || maxMass <= 0.) { // no mass selection in this bin
+          maxMass3Prong = -1.;
+          break;
+        }
+        maxMass3Prong = std::max(maxMass3Prong, maxMass);
+      }
+    }
+
     df2.setPropagateToPCA(propagateToPCA);
     df2.setMaxR(maxR);
     df2.setMaxDZIni(maxDZIni);
@@ -1760,6 +1835,39 @@ struct HfTrackIndexSkimCreator {
     }
   }
 
+  /// Method to fill the histograms of the ML scores of 3-prong candidates
+  /// \param iDecay3P is the 3-prong decay channel
+  /// \param outputScores is the vector with the output scores
+  void fillHistogramsMlScores3Prong(int iDecay3P, const std::vector<float>& outputScores)
+  {
+    switch (iDecay3P) {
+      case hf_cand_3prong::DecayType::DplusToPiKPi: {
+        registry.fill(HIST("ML/hMlScoreBkgDplus"), outputScores[0]);
+        registry.fill(HIST("ML/hMlScorePromptDplus"), outputScores[1]);
+        registry.fill(HIST("ML/hMlScoreNonpromptDplus"), outputScores[2]);
+        break;
+      }
+      case hf_cand_3prong::DecayType::LcToPKPi: {
+        registry.fill(HIST("ML/hMlScoreBkgLc"), outputScores[0]);
+        registry.fill(HIST("ML/hMlScorePromptLc"), outputScores[1]);
+        registry.fill(HIST("ML/hMlScoreNonpromptLc"), outputScores[2]);
+        break;
+      }
+      case hf_cand_3prong::DecayType::DsToKKPi: {
+        registry.fill(HIST("ML/hMlScoreBkgDs"), outputScores[0]);
+        registry.fill(HIST("ML/hMlScorePromptDs"), outputScores[1]);
+        registry.fill(HIST("ML/hMlScoreNonpromptDs"), outputScores[2]);
+        break;
+      }
+      case hf_cand_3prong::DecayType::XicToPKPi: {
+        registry.fill(HIST("ML/hMlScoreBkgXic"), outputScores[0]);
+        registry.fill(HIST("ML/hMlScorePromptXic"), outputScores[1]);
+        registry.fill(HIST("ML/hMlScoreNonpromptXic"), outputScores[2]);
+        break;
+      }
+    }
+  }
+
   /// Method to perform ML selections for 2-prong candidates after the rectangular selections
   /// \param featuresCand is the vector with the candidate features
   /// \param outputScores is the array of vectors with the output scores to be filled
@@ -1775,32 +1883,7 @@ struct HfTrackIndexSkimCreator {
       if (TESTBIT(isSelected, iDecay3P) && hasMlModel3Prong[iDecay3P]) {
         bool isMlSel = hfMlResponse3Prongs[iDecay3P].isSelectedMl(featuresCand, ptDummy, outputScores[iDecay3P]);
         if (fillHistograms) {
-          switch (iDecay3P) {
-            case hf_cand_3prong::DecayType::DplusToPiKPi: {
-              registry.fill(HIST("ML/hMlScoreBkgDplus"), outputScores[iDecay3P][0]);
-              registry.fill(HIST("ML/hMlScorePromptDplus"), outputScores[iDecay3P][1]);
-              registry.fill(HIST("ML/hMlScoreNonpromptDplus"), outputScores[iDecay3P][2]);
-              break;
-            }
-            case hf_cand_3prong::DecayType::LcToPKPi: {
-              registry.fill(HIST("ML/hMlScoreBkgLc"), outputScores[iDecay3P][0]);
-              registry.fill(HIST("ML/hMlScorePromptLc"), outputScores[iDecay3P][1]);
-              registry.fill(HIST("ML/hMlScoreNonpromptLc"), outputScores[iDecay3P][2]);
-              break;
-            }
-            case hf_cand_3prong::DecayType::DsToKKPi: {
-              registry.fill(HIST("ML/hMlScoreBkgDs"), outputScores[iDecay3P][0]);
-              registry.fill(HIST("ML/hMlScorePromptDs"), outputScores[iDecay3P][1]);
-              registry.fill(HIST("ML/hMlScoreNonpromptDs"), outputScores[iDecay3P][2]);
-              break;
-            }
-            case hf_cand_3prong::DecayType::XicToPKPi: {
-              registry.fill(HIST("ML/hMlScoreBkgXic"), outputScores[iDecay3P][0]);
-              registry.fill(HIST("ML/hMlScorePromptXic"), outputScores[iDecay3P][1]);
-              registry.fill(HIST("ML/hMlScoreNonpromptXic"), outputScores[iDecay3P][2]);
-              break;
-            }
-          }
+          fillHistogramsMlScores3Prong(iDecay3P, outputScores[iDecay3P]);
         }
         if (!isMlSel) {
           CLRBIT(isSelected, iDecay3P);
@@ -1809,6 +1892,72 @@ struct HfTrackIndexSkimCreator {
     }
   }
 
+  /// Method to evaluate the ML models for HF Filters on all the candidates of the dataframe, with one batch per species,
+  /// and to fill the ML score tables (one row per filled candidate, as in the per-candidate evaluation)
+  void applyMlSelectionForHfFiltersInBulk()
+  {
+    const float ptDummy = 1.; // dummy pT value (only one pT bin)
+    std::vector<std::size_t> indicesBatch{};
+    std::vector<std::vector<float>> inputsBatch{};
+    std::vector<float> ptDummiesBatch{};
+    std::vector<bool> isSelectedBatch{};
+    std::vector<std::vector<float>> outputsBatch{};
+
+    // 2-prong candidates, only D0
+    std::vector<std::vector<float>> mlScores2Prongs(mlInputsBulk2Prong.size());
+    for (std::size_t iCand{0}; iCand < mlInputsBulk2Prong.size(); ++iCand) {
+      if (TESTBIT(mlSelectedBulk2Prong[iCand], hf_cand_2prong::DecayType::D0ToPiK)) {
+        indicesBatch.push_back(iCand);
+        inputsBatch.push_back(std::move(mlInputsBulk2Prong[iCand]));
+      }
+    }
+    ptDummiesBatch.assign(inputsBatch.size(), ptDummy);
+    hfMlResponse2Prongs.isSelectedMlBatch(inputsBatch, ptDummiesBatch, isSelectedBatch, outputsBatch);
+    for (std::size_t iBatch{0}; iBatch < indicesBatch.size(); ++iBatch) {
+      if (fillHistograms) {
+        registry.fill(HIST("ML/hMlScoreBkgD0"), outputsBatch[iBatch][0]);
+        registry.fill(HIST("ML/hMlScorePromptD0"), outputsBatch[iBatch][1]);
+        registry.fill(HIST("ML/hMlScoreNonpromptD0"), outputsBatch[iBatch][2]);
+      }
+      mlScores2Prongs[indicesBatch[iBatch]] = std::move(outputsBatch[iBatch]);
+    }
+    for (const auto& mlScoresD0 : mlScores2Prongs) {
+      rowTrackIndexMlScoreProng2(mlScoresD0);
+    }
+
+    // 3-prong candidates, one batch per species with a model
+    std::vector<std::array<std::vector<float>, kN3ProngDecays>> mlScores3Prongs(mlInputsBulk3Prong.size());
+    for (int iDecay3P{0}; iDecay3P < kN3ProngDecays; ++iDecay3P) {
+      if (!hasMlModel3Prong[iDecay3P]) {
+        continue;
+      }
+      indicesBatch.clear();
+      inputsBatch.clear();
+      for (std::size_t iCand{0}; iCand < mlInputsBulk3Prong.size(); ++iCand) {
+        if (TESTBIT(mlSelectedBulk3Prong[iCand], iDecay3P)) {
+          indicesBatch.push_back(iCand);
+          inputsBatch.push_back(mlInputsBulk3Prong[iCand]);
+        }
+      }
+      ptDummiesBatch.assign(inputsBatch.size(), ptDummy);
+      hfMlResponse3Prongs[iDecay3P].isSelectedMlBatch(inputsBatch, ptDummiesBatch, isSelectedBatch, outputsBatch);
+      for (std::size_t iBatch{0}; iBatch < indicesBatch.size(); ++iBatch) {
+        if (fillHistograms) {
+          fillHistogramsMlScores3Prong(iDecay3P, outputsBatch[iBatch]);
+        }
+        mlScores3Prongs[indicesBatch[iBatch]][iDecay3P] = std::move(outputsBatch[iBatch]);
+      }
+    }
+    for (const auto& mlScores : mlScores3Prongs) {
+      rowTrackIndexMlScoreProng3(mlScores[0], mlScores[1], mlScores[2], mlScores[3]);
+    }
+
+    mlInputsBulk2Prong.clear();
+    mlSelectedBulk2Prong.clear();
+    mlInputsBulk3Prong.clear();
+    mlSelectedBulk3Prong.clear();
+  }
+
   /// Method to perform selections for D* candidates before vertex reconstruction
   /// \param pVecTrack0 is the momentum array of the first daughter track (same charge)
   /// \param pVecTrack1 is the momentum array of the second daughter track (opposite charge)
@@ -1865,37 +2014,28 @@ struct HfTrackIndexSkimCreator {
   /// Method for the PV refit excluding the candidate daughters
   /// \param collision is a collision
   /// \param bcWithTimeStamps is a table of bunch crossing joined with timestamps used to query the CCDB for B and material budget
-  /// \param vecPvContributorGlobId is a vector containing the global ID of PV contributors for the current collision
-  /// \param vecPvContributorTrackParCov is a vector containing the TrackParCov of PV contributors for the current collision
+  /// \param pvRefitContext contains the PV contributors of the current collision and the vertexer prepared for their refit
   /// \param vecCandPvContributorGlobId is a vector containing the global indices of daughter tracks that contributed to the original PV refit
   /// \param pvCoord is a vector where to store X, Y and Z values of refitted PV
   /// \param pvCovMatrix is a vector where to store the covariance matrix values of refitted PV
   void performPvRefitCandProngs(SelectedCollisions::iterator const& collision,
                                 aod::BCsWithTimestamps const&,
-                                std::vector<int64_t> vecPvContributorGlobId,
-                                std::vector<o2::track::TrackParCov> vecPvContributorTrackParCov,
-                                std::vector<int64_t> vecCandPvContributorGlobId,
+                                PvRefitContext& pvRefitContext,
+                                std::vector<int64_t> const& vecCandPvContributorGlobId,
                                 std::array<float, 3>& pvCoord,
                                 std::array<float, 6>& pvCovMatrix)
   {
-    std::vector<bool> vecPvRefitContributorUsed(vecPvContributorGlobId.size(), true);
-
     /// Prepare the vertex refitting
     // set the magnetic field from CCDB
     auto bc = collision.bc_as<o2::aod::BCsWithTimestamps>();
     initCCDB(bc, runNumber, ccdb, isRun2 ? ccdbPathGrp : ccdbPathGrpMag, lut, isRun2);
 
-    // build the VertexBase to initialize the vertexer
-    o2::dataformats::VertexBase primVtx;
-    primVtx.setX(collision.posX());
-    primVtx.setY(collision.posY());
-    primVtx.setZ(collision.posZ());
-    primVtx.setCov(collision.covXX(), collision.covXY(), collision.covYY(), collision.covXZ(), collision.covYZ(), collision.covZZ());
-    // configure PVertexer
-    o2::vertexing::PVertexer vertexer;
-    o2::conf::ConfigurableParam::updateFromString("pvertexer.useMeanVertexConstraint=false"); /// remove diamond constraint (let's keep it at the moment...)
-    vertexer.init();
-    bool pvRefitDoable = vertexer.prepareVertexRefit(vecPvContributorTrackParCov, primVtx);
+    // prepare the vertexer once per collision, the same preparation is used for the refits of all its candidates
+    if (!pvRefitContext.isPrepared) {
+      pvRefitContext.prepare(collision);
+    }
+    const auto& primVtx = pvRefitContext.primVtx;
+    bool pvRefitDoable = pvRefitContext.isRefitDoable;
     if (!pvRefitDoable) {
       LOG(info) << "Not enough tracks accepted for the refit";
       if (doprocess2And3ProngsWithPvRefit && fillHistograms) {
@@ -1903,7 +2043,7 @@ struct HfTrackIndexSkimCreator {
       }
     }
     if (debugPvRefit) {
-      LOG(info) << "prepareVertexRefit = " << pvRefitDoable << " Ncontrib= " << vecPvContributorTrackParCov.size() << " Ntracks= " << collision.numContrib() << " Vtx= " << primVtx.asString();
+      LOG(info) << "prepareVertexRefit = " << pvRefitDoable << " Ncontrib= " << pvRefitContext.trackParCovs.size() << " Ntracks= " << collision.numContrib() << " Vtx= " << primVtx.asString();
     }
 
     /// PV refitting, if the tracks contributed to this at the beginning
@@ -1915,12 +2055,13 @@ struct HfTrackIndexSkimCreator {
       }
       recalcPvRefit = true;
       int nCandContr = 0;
-      for (uint64_t myGlobalID : vecCandPvContributorGlobId) {
-        auto trackIterator = std::find(vecPvContributorGlobId.begin(), vecPvContributorGlobId.end(), myGlobalID); /// track global index
-        if (trackIterator != vecPvContributorGlobId.end()) {
+      std::array<int, 3> candContrEntries{-1, -1, -1}; // positions of the removed contributors, to restore them after the refit
+      for (int64_t myGlobalID : vecCandPvContributorGlobId) {
+        const int entry = pvRefitContext.find(myGlobalID); /// track global index
+        if (entry >= 0 && nCandContr < static_cast<int>(candContrEntries.size())) {
           /// this is a contributor, let's remove it for the PV refit
-          const int entry = std::distance(vecPvContributorGlobId.begin(), trackIterator);
-          vecPvRefitContributorUsed[entry] = false; /// remove the track from the PV refitting
+          pvRefitContext.isUsed[entry] = false; /// remove the track from the PV refitting
+          candContrEntries[nCandContr] = entry;
           nCandContr++;
         }
       }
@@ -1929,7 +2070,7 @@ struct HfTrackIndexSkimCreator {
       if (debugPvRefit) {
         LOG(info) << "### PV refit after removing " << nCandContr << " tracks";
       }
-      auto primVtxRefitted = vertexer.refitVertex(vecPvRefitContributorUsed, primVtx); // vertex refit
+      auto primVtxRefitted = pvRefitContext.vertexer.refitVertex(pvRefitContext.isUsed, primVtx); // vertex refit
       // LOG(info) << "refit " << cnt << "/" << ntr << " result = " << primVtxRefitted.asString();
       // LOG(info) << "refit for track with global index " << static_cast<int>(myTrack.globalIndex()) << " " << primVtxRefitted.asString();
       if (primVtxRefitted.getChi2() < 0) {
@@ -1951,8 +2092,8 @@ struct HfTrackIndexSkimCreator {
         registry.fill(HIST("PvRefit/hChi2vsNContrib"), primVtxRefitted.getNContributors(), primVtxRefitted.getChi2());
       }
 
-      for (size_t i = 0; i < vecPvContributorGlobId.size(); i++) {
-        vecPvRefitContributorUsed[i] = true; /// restore the tracks for the next PV refitting (probably not necessary here)
+      for (int i = 0; i < nCandContr; i++) {
+        pvRefitContext.isUsed[candContrEntries[i]] = true; /// restore the tracks for the next PV refitting
       }
 
       if (recalcPvRefit) {
@@ -2019,10 +2160,8 @@ struct HfTrackIndexSkimCreator {
     for (const auto& collision : collisions) {
 
       /// retrieve PV contributors for the current collision
-      std::vector<int64_t> vecPvContributorGlobId{};
-      std::vector<o2::track::TrackParCov> vecPvContributorTrackParCov{};
-      std::vector<bool> vecPvRefitContributorUsed{};
       if constexpr (doPvRefit) {
+        pvRefitContext.clear();
         auto groupedTracksUnfiltered = tracks.sliceBy(tracksPerCollision, collision.globalIndex());
         const int nTrk = groupedTracksUnfiltered.size();
         int nContrib = 0;
@@ -2033,22 +2172,20 @@ struct HfTrackIndexSkimCreator {
             nNonContrib++;
             continue;
           } else {
-            vecPvContributorGlobId.push_back(trackUnfiltered.globalIndex());
-            vecPvContributorTrackParCov.push_back(getTrackParCov(trackUnfiltered));
+            pvRefitContext.addContributor(trackUnfiltered);
             nContrib++;
             if (debugPvRefit) {
               LOG(info) << "---> a contributor! stuff saved";
-              LOG(info) << "vec_contrib size: " << vecPvContributorTrackParCov.size() << ", nContrib: " << nContrib;
+              LOG(info) << "vec_contrib size: " << pvRefitContext.trackParCovs.size() << ", nContrib: " << nContrib;
             }
           }
         }
         if (debugPvRefit) {
           LOG(info) << "===> nTrk: " << nTrk << ",   nContrib: " << nContrib << ",   nNonContrib: " << nNonContrib;
-          if ((uint16_t)vecPvContributorTrackParCov.size() != collision.numContrib() || (uint16_t)nContrib != collision.numContrib()) {
-            LOG(info) << "!!! Some problem here !!! vecPvContributorTrackParCov.size()= " << vecPvContributorTrackParCov.size() << ", nContrib=" << nContrib << ", collision.numContrib()" << collision.numContrib();
+          if ((uint16_t)pvRefitContext.trackParCovs.size() != collision.numContrib() || (uint16_t)nContrib != collision.numContrib()) {
+            LOG(info) << "!!! Some problem here !!! pvRefitContext.trackParCovs.size()= " << pvRefitContext.trackParCovs.size() << ", nContrib=" << nContrib << ", collision.numContrib()" << collision.numContrib();
           }
         }
-        vecPvRefitContributorUsed = std::vector<bool>(vecPvContributorGlobId.size(), true);
       }
 
       // auto centrality = collision.centV0M(); //FIXME add centrality when option for variations to the process function appears
@@ -2144,6 +2281,13 @@ struct HfTrackIndexSkimCreator {
           // 2-prong vertex reconstruction
           float pt2Prong{-1.};
           bool is2ProngCandidateGoodFor3Prong{sel3ProngStatusPos1 && sel3ProngStatusNeg1};
+          if (!debug && do3Prong == 1 && is2ProngCandidateGoodFor3Prong && maxMass3Prong >= 0.) {
+            // the 3-prong mass is at least the mass of the pair with the lightest hypothesis (pions) plus the mass of the third track (pion)
+            double massPairMin = RecoDecay::m(std::array{pVecTrackPos1, pVecTrackNeg1}, std::array{massPi, massPi});
+            if (massPairMin + massPi >= maxMass3Prong) {
+              is2ProngCandidateGoodFor3Prong = false;
+            }
+          }
           int nVtxFrom2ProngFitter = 0;
           if (sel2ProngStatusPos && sel2ProngStatusNeg) {
 
@@ -2173,11 +2317,11 @@ struct HfTrackIndexSkimCreator {
                     registry.fill(HIST("PvRefit/verticesPerCandidate"), 1);
                   }
                   int nCandContr = 2;
-                  auto trackFirstIt = std::find(vecPvContributorGlobId.begin(), vecPvContributorGlobId.end(), trackPos1.globalIndex());
-                  auto trackSecondIt = std::find(vecPvContributorGlobId.begin(), vecPvContributorGlobId.end(), trackNeg1.globalIndex());
+                  auto trackFirstIt = std::find(pvRefitContext.globalIds.begin(), pvRefitContext.globalIds.end(), trackPos1.globalIndex());
+                  auto trackSecondIt = std::find(pvRefitContext.globalIds.begin(), pvRefitContext.globalIds.end(), trackNeg1.globalIndex());
                   bool isTrackFirstContr = true;
                   bool isTrackSecondContr = true;
-                  if (trackFirstIt == vecPvContributorGlobId.end()) {
+                  if (trackFirstIt == pvRefitContext.globalIds.end()) {
                     /// This track did not contribute to the original PV refit
                     if (debugPvRefit) {
                       LOG(info) << "--- [2 Prong] trackPos1 with globalIndex " << trackPos1.globalIndex() << " was not a PV contributor";
@@ -2185,7 +2329,7 @@ struct HfTrackIndexSkimCreator {
                     nCandContr--;
                     isTrackFirstContr = false;
                   }
-                  if (trackSecondIt == vecPvContributorGlobId.end()) {
+                  if (trackSecondIt == pvRefitContext.globalIds.end()) {
                     /// This track did not contribute to the original PV refit
                     if (debugPvRefit) {
                       LOG(info) << "--- [2 Prong] trackNeg1 with globalIndex " << trackNeg1.globalIndex() << " was not a PV contributor";
@@ -2198,7 +2342,7 @@ struct HfTrackIndexSkimCreator {
                     if (debugPvRefit) {
                       LOG(info) << "### [2 Prong] Calling performPvRefitCandProngs for HF 2 prong candidate";
                     }
-                    performPvRefitCandProngs(collision, bcWithTimeStamps, vecPvContributorGlobId, vecPvContributorTrackParCov, {trackPos1.globalIndex(), trackNeg1.globalIndex()}, pvRefitCoord2Prong, pvRefitCovMatrix2Prong);
+                    performPvRefitCandProngs(collision, bcWithTimeStamps, pvRefitContext, {trackPos1.globalIndex(), trackNeg1.globalIndex()}, pvRefitCoord2Prong, pvRefitCovMatrix2Prong);
                   } else if (nCandContr == 1) {
                     /// Only one daughter was a contributor, let's use then the PV recalculated by excluding only it
                     if (debugPvRefit) {
@@ -2245,18 +2389,31 @@ struct HfTrackIndexSkimCreator {
                   auto trackParVarPcaPos1 = df2.getTrack(0);
                   auto trackParVarPcaNeg1 = df2.getTrack(1);
                   std::vector<float> inputFeatures{trackParVarPcaPos1.getPt(), dcaInfoPos1[0], dcaInfoPos1[1], trackParVarPcaNeg1.getPt(), dcaInfoNeg1[0], dcaInfoNeg1[1]};
-                  applyMlSelectionForHfFilters2Prong(inputFeatures, mlScoresD0, isSelected2ProngCand);
+                  if (applyMlForHfFiltersInBulk) {
+                    if (isSelected2ProngCand > 0) {
+                      mlInputsBulk2Prong.push_back(std::move(inputFeatures));
+                      mlSelectedBulk2Prong.push_back(isSelected2ProngCand);
+                    }
+                  } else {
+                    applyMlSelectionForHfFilters2Prong(inputFeatures, mlScoresD0, isSelected2ProngCand);
+                  }
                 }
 
                 if (isSelected2ProngCand > 0) {
                   // fill table row
                   rowTrackIndexProng2(thisCollId, trackPos1.globalIndex(), trackNeg1.globalIndex(), isSelected2ProngCand);
-                  if (applyMlForHfFilters) {
+                  if (applyMlForHfFilters && !applyMlForHfFiltersInBulk) {
                     rowTrackIndexMlScoreProng2(mlScoresD0);
                   }
                   if (TESTBIT(isSelected2ProngCand, hf_cand_2prong::DecayType::D0ToPiK)) {
                     lastFilledD0 = rowTrackIndexProng2.lastIndex();
                   }
+                  if (fillSvFit) {
+                    auto covMatrixPca2Prong = df2.calcPCACovMatrixFlat();
+                    rowProng2SvFit(secondaryVertex2[0], secondaryVertex2[1], secondaryVertex2[2], df2.getChi2AtPCACandidate(),
+                                   covMatrixPca2Prong[0], covMatrixPca2Prong[1], covMatrixPca2Prong[2], covMatrixPca2Prong[3], covMatrixPca2Prong[4], covMatrixPca2Prong[5],
+                                   pvec0[0], pvec0[1], pvec0[2], pvec1[0], pvec1[1], pvec1[2]);
+                  }
 
                   if constexpr (doPvRefit) {
                     // fill table row with coordinates of PV refit
@@ -2390,13 +2547,13 @@ struct HfTrackIndexSkimCreator {
                   registry.fill(HIST("PvRefit/verticesPerCandidate"), 1);
                 }
                 int nCandContr = 3;
-                auto trackFirstIt = std::find(vecPvContributorGlobId.begin(), vecPvContributorGlobId.end(), trackPos1.globalIndex());
-                auto trackSecondIt = std::find(vecPvContributorGlobId.begin(), vecPvContributorGlobId.end(), trackNeg1.globalIndex());
-                auto trackThirdIt = std::find(vecPvContributorGlobId.begin(), vecPvContributorGlobId.end(), trackPos2.globalIndex());
+                auto trackFirstIt = std::find(pvRefitContext.globalIds.begin(), pvRefitContext.globalIds.end(), trackPos1.globalIndex());
+                auto trackSecondIt = std::find(pvRefitContext.globalIds.begin(), pvRefitContext.globalIds.end(), trackNeg1.globalIndex());
+                auto trackThirdIt = std::find(pvRefitContext.globalIds.begin(), pvRefitContext.globalIds.end(), trackPos2.globalIndex());
                 bool isTrackFirstContr = true;
                 bool isTrackSecondContr = true;
                 bool isTrackThirdContr = true;
-                if (trackFirstIt == vecPvContributorGlobId.end()) {
+                if (trackFirstIt == pvRefitContext.globalIds.end()) {
                   /// This track did not contribute to the original PV refit
                   if (debugPvRefit) {
                     LOG(info) << "--- [3 prong] trackPos1 with globalIndex " << trackPos1.globalIndex() << " was not a PV contributor";
@@ -2404,7 +2561,7 @@ struct HfTrackIndexSkimCreator {
                   nCandContr--;
                   isTrackFirstContr = false;
                 }
-                if (trackSecondIt == vecPvContributorGlobId.end()) {
+                if (trackSecondIt == pvRefitContext.globalIds.end()) {
                   /// This track did not contribute to the original PV refit
                   if (debugPvRefit) {
                     LOG(info) << "--- [3 prong] trackNeg1 with globalIndex " << trackNeg1.globalIndex() << " was not a PV contributor";
@@ -2412,7 +2569,7 @@ struct HfTrackIndexSkimCreator {
                   nCandContr--;
                   isTrackSecondContr = false;
                 }
-                if (trackThirdIt == vecPvContributorGlobId.end()) {
+                if (trackThirdIt == pvRefitContext.globalIds.end()) {
                   /// This track did not contribute to the original PV refit
                   if (debugPvRefit) {
                     LOG(info) << "--- [3 prong] trackPos2 with globalIndex " << trackPos2.globalIndex() << " was not a PV contributor";
@@ -2438,7 +2595,7 @@ struct HfTrackIndexSkimCreator {
                   if (debugPvRefit) {
                     LOG(info) << "### [3 prong] Calling performPvRefitCandProngs for HF 3 prong candidate, removing " << nCandContr << " daughters";
                   }
-                  performPvRefitCandProngs(collision, bcWithTimeStamps, vecPvContributorGlobId, vecPvContributorTrackParCov, vecCandPvContributorGlobId, pvRefitCoord3Prong2Pos1Neg, pvRefitCovMatrix3Prong2Pos1Neg);
+                  performPvRefitCandProngs(collision, bcWithTimeStamps, pvRefitContext, vecCandPvContributorGlobId, pvRefitCoord3Prong2Pos1Neg, pvRefitCovMatrix3Prong2Pos1Neg);
                 } else if (nCandContr == 1) {
                   /// Only one daughter was a contributor, let's use then the PV recalculated by excluding only it
                   if (debugPvRefit) {
@@ -2502,7 +2659,14 @@ struct HfTrackIndexSkimCreator {
               std::array<std::vector<float>, kN3ProngDecays> mlScores3Prongs;
               if (applyMlForHfFilters) {
                 std::vector<float> inputFeatures{trackParVarPcaPos1.getPt(), dcaInfoPos1[0], dcaInfoPos1[1], trackParVarPcaNeg1.getPt(), dcaInfoNeg1[0], dcaInfoNeg1[1], trackParVarPcaPos2.getPt(), dcaInfoPos2[0], dcaInfoPos2[1]};
-                applyMlSelectionForHfFilters3Prong(inputFeatures, mlScores3Prongs, isSelected3ProngCand);
+                if (applyMlForHfFiltersInBulk) {
+                  if (debug || isSelected3ProngCand > 0) {
+                    mlInputsBulk3Prong.push_back(std::move(inputFeatures));
+                    mlSelectedBulk3Prong.push_back(isSelected3ProngCand);
+                  }
+                } else {
+                  applyMlSelectionForHfFilters3Prong(inputFeatures, mlScores3Prongs, isSelected3ProngCand);
+                }
               }
 
               if (!debug && isSelected3ProngCand == 0) {
@@ -2511,9 +2675,15 @@ struct HfTrackIndexSkimCreator {
 
               // fill table row
               rowTrackIndexProng3(thisCollId, trackPos1.globalIndex(), trackNeg1.globalIndex(), trackPos2.globalIndex(), isSelected3ProngCand);
-              if (applyMlForHfFilters) {
+              if (applyMlForHfFilters && !applyMlForHfFiltersInBulk) {
                 rowTrackIndexMlScoreProng3(mlScores3Prongs[0], mlScores3Prongs[1], mlScores3Prongs[2], mlScores3Prongs[3]);
               }
+              if (fillSvFit) {
+                auto covMatrixPca3Prong = df3.calcPCACovMatrixFlat();
+                rowProng3SvFit(secondaryVertex3[0], secondaryVertex3[1], secondaryVertex3[2], df3.getChi2AtPCACandidate(),
+                               covMatrixPca3Prong[0], covMatrixPca3Prong[1], covMatrixPca3Prong[2], covMatrixPca3Prong[3], covMatrixPca3Prong[4], covMatrixPca3Prong[5],
+                               pvec0[0], pvec0[1], pvec0[2], pvec1[0], pvec1[1], pvec1[2], pvec2[0], pvec2[1], pvec2[2]);
+              }
               if constexpr (doPvRefit) {
                 // fill table row of coordinates of PV refit
                 rowProng3PVrefit(pvRefitCoord3Prong2Pos1Neg[0], pvRefitCoord3Prong2Pos1Neg[1], pvRefitCoord3Prong2Pos1Neg[2],
@@ -2634,13 +2804,13 @@ struct HfTrackIndexSkimCreator {
                   registry.fill(HIST("PvRefit/verticesPerCandidate"), 1);
                 }
                 int nCandContr = 3;
-                auto trackFirstIt = std::find(vecPvContributorGlobId.begin(), vecPvContributorGlobId.end(), trackPos1.globalIndex());
-                auto trackSecondIt = std::find(vecPvContributorGlobId.begin(), vecPvContributorGlobId.end(), trackNeg1.globalIndex());
-                auto trackThirdIt = std::find(vecPvContributorGlobId.begin(), vecPvContributorGlobId.end(), trackNeg2.globalIndex());
+                auto trackFirstIt = std::find(pvRefitContext.globalIds.begin(), pvRefitContext.globalIds.end(), trackPos1.globalIndex());
+                auto trackSecondIt = std::find(pvRefitContext.globalIds.begin(), pvRefitContext.globalIds.end(), trackNeg1.globalIndex());
+                auto trackThirdIt = std::find(pvRefitContext.globalIds.begin(), pvRefitContext.globalIds.end(), trackNeg2.globalIndex());
                 bool isTrackFirstContr = true;
                 bool isTrackSecondContr = true;
                 bool isTrackThirdContr = true;
-                if (trackFirstIt == vecPvContributorGlobId.end()) {
+                if (trackFirstIt == pvRefitContext.globalIds.end()) {
                   /// This track did not contribute to the original PV refit
                   if (debugPvRefit) {
                     LOG(info) << "--- [3 prong] trackPos1 with globalIndex " << trackPos1.globalIndex() << " was not a PV contributor";
@@ -2648,7 +2818,7 @@ struct HfTrackIndexSkimCreator {
                   nCandContr--;
                   isTrackFirstContr = false;
                 }
-                if (trackSecondIt == vecPvContributorGlobId.end()) {
+                if (trackSecondIt == pvRefitContext.globalIds.end()) {
                   /// This track did not contribute to the original PV refit
                   if (debugPvRefit) {
                     LOG(info) << "--- [3 prong] trackNeg1 with globalIndex " << trackNeg1.globalIndex() << " was not a PV contributor";
@@ -2656,7 +2826,7 @@ struct HfTrackIndexSkimCreator {
                   nCandContr--;
                   isTrackSecondContr = false;
                 }
-                if (trackThirdIt == vecPvContributorGlobId.end()) {
+                if (trackThirdIt == pvRefitContext.globalIds.end()) {
                   /// This track did not contribute to the original PV refit
                   if (debugPvRefit) {
                     LOG(info) << "--- [3 prong] trackNeg2 with globalIndex " << trackNeg2.globalIndex() << " was not a PV contributor";
@@ -2682,7 +2852,7 @@ struct HfTrackIndexSkimCreator {
                   if (debugPvRefit) {
                     LOG(info) << "### [3 prong] Calling performPvRefitCandProngs for HF 3 prong candidate, removing " << nCandContr << " daughters";
                   }
-                  performPvRefitCandProngs(collision, bcWithTimeStamps, vecPvContributorGlobId, vecPvContributorTrackParCov, vecCandPvContributorGlobId, pvRefitCoord3Prong1Pos2Neg, pvRefitCovMatrix3Prong1Pos2Neg);
+                  performPvRefitCandProngs(collision, bcWithTimeStamps, pvRefitContext, vecCandPvContributorGlobId, pvRefitCoord3Prong1Pos2Neg, pvRefitCovMatrix3Prong1Pos2Neg);
                 } else if (nCandContr == 1) {
                   /// Only one daughter was a contributor, let's use then the PV recalculated by excluding only it
                   if (debugPvRefit) {
@@ -2747,7 +2917,14 @@ struct HfTrackIndexSkimCreator {
               std::array<std::vector<float>, kN3ProngDecays> mlScores3Prongs;
               if (applyMlForHfFilters) {
                 std::vector<float> inputFeatures{trackParVarPcaNeg1.getPt(), dcaInfoNeg1[0], dcaInfoNeg1[1], trackParVarPcaPos1.getPt(), dcaInfoPos1[0], dcaInfoPos1[1], trackParVarPcaNeg2.getPt(), dcaInfoNeg2[0], dcaInfoNeg2[1]};
-                applyMlSelectionForHfFilters3Prong(inputFeatures, mlScores3Prongs, isSelected3ProngCand);
+                if (applyMlForHfFiltersInBulk) {
+                  if (debug || isSelected3ProngCand > 0) {
+                    mlInputsBulk3Prong.push_back(std::move(inputFeatures));
+                    mlSelectedBulk3Prong.push_back(isSelected3ProngCand);
+                  }
+                } else {
+                  applyMlSelectionForHfFilters3Prong(inputFeatures, mlScores3Prongs, isSelected3ProngCand);
+                }
               }
 
               if (!debug && isSelected3ProngCand == 0) {
@@ -2756,9 +2933,15 @@ struct HfTrackIndexSkimCreator {
 
               // fill table row
               rowTrackIndexProng3(thisCollId, trackNeg1.globalIndex(), trackPos1.globalIndex(), trackNeg2.globalIndex(), isSelected3ProngCand);
-              if (applyMlForHfFilters) {
+              if (applyMlForHfFilters && !applyMlForHfFiltersInBulk) {
                 rowTrackIndexMlScoreProng3(mlScores3Prongs[0], mlScores3Prongs[1], mlScores3Prongs[2], mlScores3Prongs[3]);
               }
+              if (fillSvFit) {
+                auto covMatrixPca3Prong = df3.calcPCACovMatrixFlat();
+                rowProng3SvFit(secondaryVertex3[0], secondaryVertex3[1], secondaryVertex3[2], df3.getChi2AtPCACandidate(),
+                               covMatrixPca3Prong[0], covMatrixPca3Prong[1], covMatrixPca3Prong[2], covMatrixPca3Prong[3], covMatrixPca3Prong[4], covMatrixPca3Prong[5],
+                               pvec0[0], pvec0[1], pvec0[2], pvec1[0], pvec1[1], pvec1[2], pvec2[0], pvec2[1], pvec2[2]);
+              }
               // fill table row of coordinates of PV refit
               if constexpr (doPvRefit) {
                 rowProng3PVrefit(pvRefitCoord3Prong1Pos2Neg[0], pvRefitCoord3Prong1Pos2Neg[1], pvRefitCoord3Prong1Pos2Neg[2],
@@ -2914,6 +3097,10 @@ struct HfTrackIndexSkimCreator {
         registry.fill(HIST("hNCand3ProngVsNTracks"), nTracks, nCand3);
       }
     }
+
+    if (applyMlForHfFilters && applyMlForHfFiltersInBulk) {
+      applyMlSelectionForHfFiltersInBulk();
+    }
   } /// end of run2And3Prongs function
 
   void processNo2And3Prongs(SelectedCollisions const&)
@@ -342,159 +342,167 @@ struct HfTreeCreatorLcToPKPi {
     }
     for (const auto& candidate : candidates) {
       auto trackPos1 = candidate.prong0_as<TracksWPid>(); // positive daughter (negative for the antiparticles)
+      bool isMcCandidateSignal = std::abs(candidate.flagMcMatchRec()) == (1 << o2::aod::hf_cand_3prong::DecayType::LcToPKPi);
+      // the selection and the downsampling do not depend on the mass hypothesis, apply them before computing the candidate properties
+      double pseudoRndm = trackPos1.pt() * 1000. - (int64_t)(trackPos1.pt() * 1000);
+      if (!(/*keep all*/ (!keepOnlySignalMc && !keepOnlyBkg) || /*keep only signal*/ (keepOnlySignalMc && isMcCandidateSignal) || /*keep only background and downsample it*/ (keepOnlyBkg && !isMcCandidateSignal && (candidate.pt() > downSampleBkgPtMax || (pseudoRndm < downSampleBkgFactor && candidate.pt() < downSampleBkgPtMax))))) {
+        continue;
+      }
+      if (candidate.isSelLcToPKPi() < 1 && candidate.isSelLcToPiKP() < 1) {
+        continue;
+      }
       auto trackNeg = candidate.prong1_as<TracksWPid>();  // negative daughter (positive for the antiparticles)
       auto trackPos2 = candidate.prong2_as<TracksWPid>(); // positive daughter (negative for the antiparticles)
-      bool isMcCandidateSignal = std::abs(candidate.flagMcMatchRec()) == (1 << o2::aod::hf_cand_3prong::DecayType::LcToPKPi);
+      const float FunctionCt = hfHelper.ctLc(candidate);
+      const float FunctionY = hfHelper.yLc(candidate);
+      const float FunctionE = hfHelper.eLc(candidate);
       auto fillTable = [&](int CandFlag,
-                           int FunctionSelection,
                            float FunctionInvMass,
-                           float FunctionCt,
-                           float FunctionY,
-                           float FunctionE,
                            float FunctionInvMassKPi) {
-        double pseudoRndm = trackPos1.pt() * 1000. - (int64_t)(trackPos1.pt() * 1000);
-        if (FunctionSelection >= 1 && (/*keep all*/ (!keepOnlySignalMc && !keepOnlyBkg) || /*keep only signal*/ (keepOnlySignalMc && isMcCandidateSignal) || /*keep only background and downsample it*/ (keepOnlyBkg && !isMcCandidateSignal && (candidate.pt() > downSampleBkgPtMax || (pseudoRndm < downSampleBkgFactor && candidate.pt() < downSampleBkgPtMax))))) {
-          if (fillCandidateLiteTable) {
-            rowCandidateLite(
-              candidate.posX(),
-              candidate.posY(),
-              candidate.posZ(),
-              candidate.nProngsContributorsPV(),
-              // candidate.errorDecayLength(),
-              // candidate.errorDecayLengthXY(),
-              candidate.chi2PCA(),
-              candidate.decayLength(),
-              candidate.decayLengthXY(),
-              // candidate.decayLengthNormalised(),
-              // candidate.decayLengthXYNormalised(),
-              // candidate.impactParameterNormalised0(),
-              candidate.ptProng0(),
-              // candidate.impactParameterNormalised1(),
-              candidate.ptProng1(),
-              // candidate.impactParameterNormalised2(),
-              candidate.ptProng2(),
-              candidate.impactParameter0(),
-              candidate.impactParameter1(),
-              candidate.impactParameter2(),
-              // candidate.errorImpactParameter0(),
-              // candidate.errorImpactParameter1(),
-              // candidate.errorImpactParameter2(),
-              trackPos1.tpcNSigmaPi(),
-              trackPos1.tpcNSigmaPr(),
-              trackPos1.tofNSigmaPi(),
-              trackPos1.tofNSigmaPr(),
-              trackNeg.tpcNSigmaKa(),
-              trackNeg.tofNSigmaKa(),
-              trackPos2.tpcNSigmaPi(),
-              trackPos2.tpcNSigmaPr(),
-              trackPos2.tofNSigmaPi(),
-              trackPos2.tofNSigmaPr(),
-              trackPos1.tpcTofNSigmaPi(),
-              trackPos1.tpcTofNSigmaPr(),
-              trackNeg.tpcTofNSigmaKa(),
-              trackPos2.tpcTofNSigmaPi(),
-              trackPos2.tpcTofNSigmaPr(),
-              1 << CandFlag,
-              FunctionInvMass,
-              candidate.pt(),
-              candidate.cpa(),
-              candidate.cpaXY(),
-              FunctionCt,
-              candidate.eta(),
-              candidate.phi(),
-              FunctionY,
-              candidate.flagMcMatchRec(),
-              candidate.originMcRec(),
-              candidate.isCandidateSwapped(),
-              candidate.flagMcDecayChanRec(),
-              FunctionInvMassKPi);
-            // candidate.globalIndex());
-
-            if (fillCollIdTable) {
-              /// save also candidate collision indices
-              rowCollisionId(candidate.collisionId());
-            }
-
-          } else {
-            rowCandidateFull(
-              candidate.collisionId(),
-              candidate.posX(),
-              candidate.posY(),
-              candidate.posZ(),
-              candidate.nProngsContributorsPV(),
-              candidate.xSecondaryVertex(),
-              candidate.ySecondaryVertex(),
-              candidate.zSecondaryVertex(),
-              candidate.errorDecayLength(),
-              candidate.errorDecayLengthXY(),
-              candidate.chi2PCA(),
-              candidate.rSecondaryVertex(),
-              candidate.decayLength(),
-              candidate.decayLengthXY(),
-              candidate.decayLengthNormalised(),
-              candidate.decayLengthXYNormalised(),
-              candidate.impactParameterNormalised0(),
-              candidate.ptProng0(),
-              RecoDecay::p(candidate.pxProng0(), candidate.pyProng0(), candidate.pzProng0()),
-              candidate.impactParameterNormalised1(),
-              candidate.ptProng1(),
-              RecoDecay::p(candidate.pxProng1(), candidate.pyProng1(), candidate.pzProng1()),
-              candidate.impactParameterNormalised2(),
-              candidate.ptProng2(),
-              RecoDecay::p(candidate.pxProng2(), candidate.pyProng2(), candidate.pzProng2()),
-              candidate.pxProng0(),
-              candidate.pyProng0(),
-              candidate.pzProng0(),
-              candidate.pxProng1(),
-              candidate.pyProng1(),
-              candidate.pzProng1(),
-              candidate.pxProng2(),
-              candidate.pyProng2(),
-              candidate.pzProng2(),
-              candidate.impactParameter0(),
-              candidate.impactParameter1(),
-              candidate.impactParameter2(),
-              candidate.errorImpactParameter0(),
-              candidate.errorImpactParameter1(),
-              candidate.errorImpactParameter2(),
-              trackPos1.tpcNSigmaPi(),
-              trackPos1.tpcNSigmaPr(),
-              trackPos1.tofNSigmaPi(),
-              trackPos1.tofNSigmaPr(),
-              trackNeg.tpcNSigmaKa(),
-              trackNeg.tofNSigmaKa(),
-              trackPos2.tpcNSigmaPi(),
-              trackPos2.tpcNSigmaPr(),
-              trackPos2.tofNSigmaPi(),
-              trackPos2.tofNSigmaPr(),
-              trackPos1.tpcTofNSigmaPi(),
-              trackPos1.tpcTofNSigmaPr(),
-              trackNeg.tpcTofNSigmaKa(),
-              trackPos2.tpcTofNSigmaPi(),
-              trackPos2.tpcTofNSigmaPr(),
-              1 << CandFlag,
-              FunctionInvMass,
-              candidate.pt(),
-              candidate.p(),
-              candidate.cpa(),
-              candidate.cpaXY(),
-              FunctionCt,
-              candidate.eta(),
-              candidate.phi(),
-              FunctionY,
-              FunctionE,
-              candidate.flagMcMatchRec(),
-              candidate.originMcRec(),
-              candidate.isCandidateSwapped(),
-              candidate.globalIndex(),
-              candidate.flagMcDecayChanRec(),
-              FunctionInvMassKPi);
+        if (fillCandidateLiteTable) {
+          rowCandidateLite(
+            candidate.posX(),
+            candidate.posY(),
+            candidate.posZ(),
+            candidate.nProngsContributorsPV(),
+            // candidate.errorDecayLength(),
+            // candidate.errorDecayLengthXY(),
+            candidate.chi2PCA(),
+            candidate.decayLength(),
+            candidate.decayLengthXY(),
+            // candidate.decayLengthNormalised(),
+            // candidate.decayLengthXYNormalised(),
+            // candidate.impactParameterNormalised0(),
+            candidate.ptProng0(),
+            // candidate.impactParameterNormalised1(),
+            candidate.ptProng1(),
+            // candidate.impactParameterNormalised2(),
+            candidate.ptProng2(),
+            candidate.impactParameter0(),
+            candidate.impactParameter1(),
+            candidate.impactParameter2(),
+            // candidate.errorImpactParameter0(),
+            // candidate.errorImpactParameter1(),
+            // candidate.errorImpactParameter2(),
+            trackPos1.tpcNSigmaPi(),
+            trackPos1.tpcNSigmaPr(),
+            trackPos1.tofNSigmaPi(),
+            trackPos1.tofNSigmaPr(),
+            trackNeg.tpcNSigmaKa(),
+            trackNeg.tofNSigmaKa(),
+            trackPos2.tpcNSigmaPi(),
+            trackPos2.tpcNSigmaPr(),
+            trackPos2.tofNSigmaPi(),
+            trackPos2.tofNSigmaPr(),
+            trackPos1.tpcTofNSigmaPi(),
+            trackPos1.tpcTofNSigmaPr(),
+            trackNeg.tpcTofNSigmaKa(),
+            trackPos2.tpcTofNSigmaPi(),
+            trackPos2.tpcTofNSigmaPr(),
+            1 << CandFlag,
+            FunctionInvMass,
+            candidate.pt(),
+            candidate.cpa(),
+            candidate.cpaXY(),
+            FunctionCt,
+            candidate.eta(),
+            candidate.phi(),
+            FunctionY,
+            candidate.flagMcMatchRec(),
+            candidate.originMcRec(),
+            candidate.isCandidateSwapped(),
+            candidate.flagMcDecayChanRec(),
+            FunctionInvMassKPi);
+          // candidate.globalIndex());
+
+          if (fillCollIdTable) {
+            /// save also candidate collision indices
+            rowCollisionId(candidate.collisionId());
           }
+
+        } else {
+          rowCandidateFull(
+            candidate.collisionId(),
+            candidate.posX(),
+            candidate.posY(),
+            candidate.posZ(),
+            candidate.nProngsContributorsPV(),
+            candidate.xSecondaryVertex(),
+            candidate.ySecondaryVertex(),
+            candidate.zSecondaryVertex(),
+            candidate.errorDecayLength(),
+            candidate.errorDecayLengthXY(),
+            candidate.chi2PCA(),
+            candidate.rSecondaryVertex(),
+            candidate.decayLength(),
+            candidate.decayLengthXY(),
+            candidate.decayLengthNormalised(),
+            candidate.decayLengthXYNormalised(),
+            candidate.impactParameterNormalised0(),
+            candidate.ptProng0(),
+            RecoDecay::p(candidate.pxProng0(), candidate.pyProng0(), candidate.pzProng0()),
+            candidate.impactParameterNormalised1(),
+            candidate.ptProng1(),
+            RecoDecay::p(candidate.pxProng1(), candidate.pyProng1(), candidate.pzProng1()),
+            candidate.impactParameterNormalised2(),
+            candidate.ptProng2(),
+            RecoDecay::p(candidate.pxProng2(), candidate.pyProng2(), candidate.pzProng2()),
+            candidate.pxProng0(),
+            candidate.pyProng0(),
+            candidate.pzProng0(),
+            candidate.pxProng1(),
+            candidate.pyProng1(),
+            candidate.pzProng1(),
+            candidate.pxProng2(),
+            candidate.pyProng2(),
+            candidate.pzProng2(),
+            candidate.impactParameter0(),
+            candidate.impactParameter1(),
+            candidate.impactParameter2(),
+            candidate.errorImpactParameter0(),
+            candidate.errorImpactParameter1(),
+            candidate.errorImpactParameter2(),
+            trackPos1.tpcNSigmaPi(),
+            trackPos1.tpcNSigmaPr(),
+            trackPos1.tofNSigmaPi(),
+            trackPos1.tofNSigmaPr(),
+            trackNeg.tpcNSigmaKa(),
+            trackNeg.tofNSigmaKa(),
+            trackPos2.tpcNSigmaPi(),
+            trackPos2.tpcNSigmaPr(),
+            trackPos2.tofNSigmaPi(),
+            trackPos2.tofNSigmaPr(),
+            trackPos1.tpcTofNSigmaPi(),
+            trackPos1.tpcTofNSigmaPr(),
+            trackNeg.tpcTofNSigmaKa(),
+            trackPos2.tpcTofNSigmaPi(),
+            trackPos2.tpcTofNSigmaPr(),
+            1 << CandFlag,
+            FunctionInvMass,
+            candidate.pt(),
+            candidate.p(),
+            candidate.cpa(),
+            candidate.cpaXY(),
+            FunctionCt,
+            candidate.eta(),
+            candidate.phi(),
+            FunctionY,
+            FunctionE,
+            candidate.flagMcMatchRec(),
+            candidate.originMcRec(),
+            candidate.isCandidateSwapped(),
+            candidate.globalIndex(),
+            candidate.flagMcDecayChanRec(),
+            FunctionInvMassKPi);
         }
       };
 
-      fillTable(0, candidate.isSelLcToPKPi(), hfHelper.invMassLcToPKPi(candidate), hfHelper.ctLc(candidate), hfHelper.yLc(candidate), hfHelper.eLc(candidate), hfHelper.invMassKPiPairLcToPKPi(candidate));
-      fillTable(1, candidate.isSelLcToPiKP(), hfHelper.invMassLcToPiKP(candidate), hfHelper.ctLc(candidate), hfHelper.yLc(candidate), hfHelper.eLc(candidate), hfHelper.invMassKPiPairLcToPiKP(candidate));
+      if (candidate.isSelLcToPKPi() >= 1) {
+        fillTable(0, hfHelper.invMassLcToPKPi(candidate), hfHelper.invMassKPiPairLcToPKPi(candidate));
+      }
+      if (candidate.isSelLcToPiKP() >= 1) {
+        fillTable(1, hfHelper.invMassLcToPiKP(candidate), hfHelper.invMassKPiPairLcToPiKP(candidate));
+      }
     }
 
     // Filling particle properties
@@ -602,158 +610,166 @@ struct HfTreeCreatorLcToPKPi {
     }
     for (const auto& candidate : candidates) {
       auto trackPos1 = candidate.prong0_as<TracksWPid>(); // positive daughter (negative for the antiparticles)
+      // the selection and the downsampling do not depend on the mass hypothesis, apply them before computing the candidate properties
+      double pseudoRndm = trackPos1.pt() * 1000. - (int64_t)(trackPos1.pt() * 1000);
+      if (!(candidate.pt() > downSampleBkgPtMax || (pseudoRndm < downSampleBkgFactor && candidate.pt() < downSampleBkgPtMax))) {
+        continue;
+      }
+      if (candidate.isSelLcToPKPi() < 1 && candidate.isSelLcToPiKP() < 1) {
+        continue;
+      }
       auto trackNeg = candidate.prong1_as<TracksWPid>();  // negative daughter (positive for the antiparticles)
       auto trackPos2 = candidate.prong2_as<TracksWPid>(); // positive daughter (negative for the antiparticles)
+      const float FunctionCt = hfHelper.ctLc(candidate);
+      const float FunctionY = hfHelper.yLc(candidate);
+      const float FunctionE = hfHelper.eLc(candidate);
       auto fillTable = [&](int CandFlag,
-                           int FunctionSelection,
                            float FunctionInvMass,
-                           float FunctionCt,
-                           float FunctionY,
-                           float FunctionE,
                            float FunctionInvMassKPi) {
-        double pseudoRndm = trackPos1.pt() * 1000. - (int64_t)(trackPos1.pt() * 1000);
-        if (FunctionSelection >= 1 && (candidate.pt() > downSampleBkgPtMax || (pseudoRndm < downSampleBkgFactor && candidate.pt() < downSampleBkgPtMax))) {
-          if (fillCandidateLiteTable) {
-            rowCandidateLite(
-              candidate.posX(),
-              candidate.posY(),
-              candidate.posZ(),
-              candidate.nProngsContributorsPV(),
-              // candidate.errorDecayLength(),
-              // candidate.errorDecayLengthXY(),
-              candidate.chi2PCA(),
-              candidate.decayLength(),
-              candidate.decayLengthXY(),
-              // candidate.decayLengthNormalised(),
-              // candidate.decayLengthXYNormalised(),
-              // candidate.impactParameterNormalised0(),
-              candidate.ptProng0(),
-              // candidate.impactParameterNormalised1(),
-              candidate.ptProng1(),
-              // candidate.impactParameterNormalised2(),
-              candidate.ptProng2(),
-              candidate.impactParameter0(),
-              candidate.impactParameter1(),
-              candidate.impactParameter2(),
-              // candidate.errorImpactParameter0(),
-              // candidate.errorImpactParameter1(),
-              // candidate.errorImpactParameter2(),
-              trackPos1.tpcNSigmaPi(),
-              trackPos1.tpcNSigmaPr(),
-              trackPos1.tofNSigmaPi(),
-              trackPos1.tofNSigmaPr(),
-              trackNeg.tpcNSigmaKa(),
-              trackNeg.tofNSigmaKa(),
-              trackPos2.tpcNSigmaPi(),
-              trackPos2.tpcNSigmaPr(),
-              trackPos2.tofNSigmaPi(),
-              trackPos2.tofNSigmaPr(),
-              trackPos1.tpcTofNSigmaPi(),
-              trackPos1.tpcTofNSigmaPr(),
-              trackNeg.tpcTofNSigmaKa(),
-              trackPos2.tpcTofNSigmaPi(),
-              trackPos2.tpcTofNSigmaPr(),
-              1 << CandFlag,
-              FunctionInvMass,
-              candidate.pt(),
-              candidate.cpa(),
-              candidate.cpaXY(),
-              FunctionCt,
-              candidate.eta(),
-              candidate.phi(),
-              FunctionY,
-              0.,
-              0.,
-              0.,
-              -1,
-              FunctionInvMassKPi);
-            // candidate.globalIndex());
-
-            if (fillCollIdTable) {
-              /// save also candidate collision indices
-              rowCollisionId(candidate.collisionId());
-            }
-
-          } else {
-            rowCandidateFull(
-              candidate.collisionId(),
-              candidate.posX(),
-              candidate.posY(),
-              candidate.posZ(),
-              candidate.nProngsContributorsPV(),
-              candidate.xSecondaryVertex(),
-              candidate.ySecondaryVertex(),
-              candidate.zSecondaryVertex(),
-              candidate.errorDecayLength(),
-              candidate.errorDecayLengthXY(),
-              candidate.chi2PCA(),
-              candidate.rSecondaryVertex(),
-              candidate.decayLength(),
-              candidate.decayLengthXY(),
-              candidate.decayLengthNormalised(),
-              candidate.decayLengthXYNormalised(),
-              candidate.impactParameterNormalised0(),
-              candidate.ptProng0(),
-              RecoDecay::p(candidate.pxProng0(), candidate.pyProng0(), candidate.pzProng0()),
-              candidate.impactParameterNormalised1(),
-              candidate.ptProng1(),
-              RecoDecay::p(candidate.pxProng1(), candidate.pyProng1(), candidate.pzProng1()),
-              candidate.impactParameterNormalised2(),
-              candidate.ptProng2(),
-              RecoDecay::p(candidate.pxProng2(), candidate.pyProng2(), candidate.pzProng2()),
-              candidate.pxProng0(),
-              candidate.pyProng0(),
-              candidate.pzProng0(),
-              candidate.pxProng1(),
-              candidate.pyProng1(),
-              candidate.pzProng1(),
-              candidate.pxProng2(),
-              candidate.pyProng2(),
-              candidate.pzProng2(),
-              candidate.impactParameter0(),
-              candidate.impactParameter1(),
-              candidate.impactParameter2(),
-              candidate.errorImpactParameter0(),
-              candidate.errorImpactParameter1(),
-              candidate.errorImpactParameter2(),
-              trackPos1.tpcNSigmaPi(),
-              trackPos1.tpcNSigmaPr(),
-              trackPos1.tofNSigmaPi(),
-              trackPos1.tofNSigmaPr(),
-              trackNeg.tpcNSigmaKa(),
-              trackNeg.tofNSigmaKa(),
-              trackPos2.tpcNSigmaPi(),
-              trackPos2.tpcNSigmaPr(),
-              trackPos2.tofNSigmaPi(),
-              trackPos2.tofNSigmaPr(),
-              trackPos1.tpcTofNSigmaPi(),
-              trackPos1.tpcTofNSigmaPr(),
-              trackNeg.tpcTofNSigmaKa(),
-              trackPos2.tpcTofNSigmaPi(),
-              trackPos2.tpcTofNSigmaPr(),
-              1 << CandFlag,
-              FunctionInvMass,
-              candidate.pt(),
-              candidate.p(),
-              candidate.cpa(),
-              candidate.cpaXY(),
-              FunctionCt,
-              candidate.eta(),
-              candidate.phi(),
-              FunctionY,
-              FunctionE,
-              0.,
-              0.,
-              0.,
-              candidate.globalIndex(),
-              -1,
-              FunctionInvMassKPi);
+        if (fillCandidateLiteTable) {
+          rowCandidateLite(
+            candidate.posX(),
+            candidate.posY(),
+            candidate.posZ(),
+            candidate.nProngsContributorsPV(),
+            // candidate.errorDecayLength(),
+            // candidate.errorDecayLengthXY(),
+            candidate.chi2PCA(),
+            candidate.decayLength(),
+            candidate.decayLengthXY(),
+            // candidate.decayLengthNormalised(),
+            // candidate.decayLengthXYNormalised(),
+            // candidate.impactParameterNormalised0(),
+            candidate.ptProng0(),
+            // candidate.impactParameterNormalised1(),
+            candidate.ptProng1(),
+            // candidate.impactParameterNormalised2(),
+            candidate.ptProng2(),
+            candidate.impactParameter0(),
+            candidate.impactParameter1(),
+            candidate.impactParameter2(),
+            // candidate.errorImpactParameter0(),
+            // candidate.errorImpactParameter1(),
+            // candidate.errorImpactParameter2(),
+            trackPos1.tpcNSigmaPi(),
+            trackPos1.tpcNSigmaPr(),
+            trackPos1.tofNSigmaPi(),
+            trackPos1.tofNSigmaPr(),
+            trackNeg.tpcNSigmaKa(),
+            trackNeg.tofNSigmaKa(),
+            trackPos2.tpcNSigmaPi(),
+            trackPos2.tpcNSigmaPr(),
+            trackPos2.tofNSigmaPi(),
+            trackPos2.tofNSigmaPr(),
+            trackPos1.tpcTofNSigmaPi(),
+            trackPos1.tpcTofNSigmaPr(),
+            trackNeg.tpcTofNSigmaKa(),
+            trackPos2.tpcTofNSigmaPi(),
+            trackPos2.tpcTofNSigmaPr(),
+            1 << CandFlag,
+            FunctionInvMass,
+            candidate.pt(),
+            candidate.cpa(),
+            candidate.cpaXY(),
+            FunctionCt,
+            candidate.eta(),
+            candidate.phi(),
+            FunctionY,
+            0.,
+            0.,
+            0.,
+            -1,
+            FunctionInvMassKPi);
+          // candidate.globalIndex());
+
+          if (fillCollIdTable) {
+            /// save also candidate collision indices
+            rowCollisionId(candidate.collisionId());
           }
+
+        } else {
+          rowCandidateFull(
+            candidate.collisionId(),
+            candidate.posX(),
+            candidate.posY(),
+            candidate.posZ(),
+            candidate.nProngsContributorsPV(),
+            candidate.xSecondaryVertex(),
+            candidate.ySecondaryVertex(),
+            candidate.zSecondaryVertex(),
+            candidate.errorDecayLength(),
+            candidate.errorDecayLengthXY(),
+            candidate.chi2PCA(),
+            candidate.rSecondaryVertex(),
+            candidate.decayLength(),
+            candidate.decayLengthXY(),
+            candidate.decayLengthNormalised(),
+            candidate.decayLengthXYNormalised(),
+            candidate.impactParameterNormalised0(),
+            candidate.ptProng0(),
+            RecoDecay::p(candidate.pxProng0(), candidate.pyProng0(), candidate.pzProng0()),
+            candidate.impactParameterNormalised1(),
+            candidate.ptProng1(),
+            RecoDecay::p(candidate.pxProng1(), candidate.pyProng1(), candidate.pzProng1()),
+            candidate.impactParameterNormalised2(),
+            candidate.ptProng2(),
+            RecoDecay::p(candidate.pxProng2(), candidate.pyProng2(), candidate.pzProng2()),
+            candidate.pxProng0(),
+            candidate.pyProng0(),
+            candidate.pzProng0(),
+            candidate.pxProng1(),
+            candidate.pyProng1(),
+            candidate.pzProng1(),
+            candidate.pxProng2(),
+            candidate.pyProng2(),
+            candidate.pzProng2(),
+            candidate.impactParameter0(),
+            candidate.impactParameter1(),
+            candidate.impactParameter2(),
+            candidate.errorImpactParameter0(),
+            candidate.errorImpactParameter1(),
+            candidate.errorImpactParameter2(),
+            trackPos1.tpcNSigmaPi(),
+            trackPos1.tpcNSigmaPr(),
+            trackPos1.tofNSigmaPi(),
+            trackPos1.tofNSigmaPr(),
+            trackNeg.tpcNSigmaKa(),
+            trackNeg.tofNSigmaKa(),
+            trackPos2.tpcNSigmaPi(),
+            trackPos2.tpcNSigmaPr(),
+            trackPos2.tofNSigmaPi(),
+            trackPos2.tofNSigmaPr(),
+            trackPos1.tpcTofNSigmaPi(),
+            trackPos1.tpcTofNSigmaPr(),
+            trackNeg.tpcTofNSigmaKa(),
+            trackPos2.tpcTofNSigmaPi(),
+            trackPos2.tpcTofNSigmaPr(),
+            1 << CandFlag,
+            FunctionInvMass,
+            candidate.pt(),
+            candidate.p(),
+            candidate.cpa(),
+            candidate.cpaXY(),
+            FunctionCt,
+            candidate.eta(),
+            candidate.phi(),
+            FunctionY,
+            FunctionE,
+            0.,
+            0.,
+            0.,
+            candidate.globalIndex(),
+            -1,
+            FunctionInvMassKPi);
         }
       };
 
-      fillTable(0, candidate.isSelLcToPKPi(), hfHelper.invMassLcToPKPi(candidate), hfHelper.ctLc(candidate), hfHelper.yLc(candidate), hfHelper.eLc(candidate), hfHelper.invMassKPiPairLcToPKPi(candidate));
-      fillTable(1, candidate.isSelLcToPiKP(), hfHelper.invMassLcToPiKP(candidate), hfHelper.ctLc(candidate), hfHelper.yLc(candidate), hfHelper.eLc(candidate), hfHelper.invMassKPiPairLcToPiKP(candidate));
+      if (candidate.isSelLcToPKPi() >= 1) {
+        fillTable(0, hfHelper.invMassLcToPKPi(candidate), hfHelper.invMassKPiPairLcToPKPi(candidate));
+      }
+      if (candidate.isSelLcToPiKP() >= 1) {
+        fillTable(1, hfHelper.invMassLcToPiKP(candidate), hfHelper.invMassKPiPairLcToPiKP(candidate));
+      }
     }
   }
 
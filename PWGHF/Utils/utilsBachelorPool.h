@@ -0,0 +1,73 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file utilsBachelorPool.h
+/// \brief Pool of the bachelor tracks of a collision for the beauty-hadron candidate creators
+///        The tracks associated to a collision are selected and converted to TrackParCov once per collision,
+///        instead of once per charm-hadron candidate of the collision.
+
+#ifndef PWGHF_UTILS_UTILSBACHELORPOOL_H_
+#define PWGHF_UTILS_UTILSBACHELORPOOL_H_
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "ReconstructionDataFormats/Track.h"
+
+#include "Common/Core/trackUtilities.h"
+
+namespace o2::hf_trkcandsel
+{
+/// Bachelor track, with the quantities used in the pairing with the charm-hadron candidates
+struct BachelorTrack {
+  int64_t globalIndex;                // index of the track
+  int8_t sign;                        // charge sign
+  float pt;                           // transverse momentum
+  float eta;                          // pseudorapidity
+  std::array<float, 3> pVec;          // momentum at the reference point of the track
+  o2::track::TrackParCov trackParCov; // track parametrisation, to be copied before the fit
+};
+
+class BachelorPool
+{
+ public:
+  /// Fills the pool with the selected tracks associated to a collision, in the order of the association table
+  /// \param trackIdsThisCollision track association rows of the collision
+  /// \param isSelected callable returning whether a track passes the candidate-independent selections
+  template <typename TTracks, typename TTrackIndices, typename TSelector>
+  void fill(const TTrackIndices& trackIdsThisCollision, TSelector&& isSelected)
+  {
+    mTracks.clear();
+    for (const auto& trackId : trackIdsThisCollision) {
+      auto track = trackId.template track_as<TTracks>();
+      if (!isSelected(track)) {
+        continue;
+      }
+      BachelorTrack& bachelor = mTracks.emplace_back();
+      bachelor.globalIndex = track.globalIndex();
+      bachelor.sign = track.sign();
+      bachelor.pt = track.pt();
+      bachelor.eta = track.eta();
+      bachelor.pVec = track.pVector();
+      bachelor.trackParCov = getTrackParCov(track);
+    }
+  }
+
+  const std::vector<BachelorTrack>& tracks() const { return mTracks; }
+
+ private:
+  std::vector<BachelorTrack> mTracks; // selected tracks of the current collision, the capacity is kept between collisions
+};
+
+} // namespace o2::hf_trkcandsel
+
+#endif // PWGHF_UTILS_UTILSBACHELORPOOL_H_
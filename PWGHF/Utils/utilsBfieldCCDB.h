@@ -23,15 +23,17 @@
 #include "DataFormatsParameters/GRPObject.h"
 
 /// \brief Sets up the grp object for magnetic field (w/o matCorr for propagation)
+/// \note The material LUT is loaded once per device in the init of the task; here it is only attached to the propagator again,
+///       after the field of the new run has been set (setMatLUT would otherwise initialise the field implicitly)
 /// \param bc is the bunch crossing
 /// \param mRunNumber is an int with the run umber of the previous iteration. If at the current iteration it changes, then the grp object is updated
 /// \param ccdb is the o2::ccdb::BasicCCDBManager object
 /// \param ccdbPathGrp is the path where the GRP oject is stored
 /// \param lut is a pointer to the o2::base::MatLayerCylSet object
 /// \param isRun2 tells whether we are analysing Run2 converted data or not (different GRP object type)
-void initCCDB(o2::aod::BCsWithTimestamps::iterator const& bc, int& mRunNumber,
-              o2::framework::Service<o2::ccdb::BasicCCDBManager> const& ccdb, std::string const& ccdbPathGrp, o2::base::MatLayerCylSet* lut,
-              bool isRun2)
+inline void initCCDB(o2::aod::BCsWithTimestamps::iterator const& bc, int& mRunNumber,
+                     o2::framework::Service<o2::ccdb::BasicCCDBManager> const& ccdb, std::string const& ccdbPathGrp, o2::base::MatLayerCylSet* lut,
+                     bool isRun2)
 {
   if (mRunNumber != bc.runNumber()) {
     LOGF(info, "====== initCCDB function called (isRun2==%d)", isRun2);
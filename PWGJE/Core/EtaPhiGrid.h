@@ -0,0 +1,174 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file EtaPhiGrid.h
+/// \brief Uniform eta-phi cell grid for nearest-neighbour searches within a maximum distance
+///        Phi is periodic, so no duplication of the points around the phi boundary is needed.
+///        The storage is kept between builds, so that a grid reused for every collision does not allocate.
+
+#ifndef PWGJE_CORE_ETAPHIGRID_H_
+#define PWGJE_CORE_ETAPHIGRID_H_
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace jetutilities
+{
+
+template <typename T>
+class EtaPhiGrid
+{
+ public:
+  /// Fills the grid with the points, the cell size is adapted to the maximum distance of the searches
+  /// \param eta eta of the points
+  /// \param phi phi of the points, any range
+  /// \param maxDistance maximum distance of the searches
+  void build(const std::vector<T>& eta, const std::vector<T>& phi, double maxDistance)
+  {
+    if (eta.size() != phi.size()) {
+      throw std::invalid_argument("Grid eta and phi sizes don't match. Check the inputs.");
+    }
+    const int nPoints = eta.size();
+    mEta.resize(nPoints);
+    mPhi.resize(nPoints);
+    mIndices.resize(nPoints);
+    mMaxDistance = maxDistance;
+    if (nPoints == 0) {
+      mNEta = mNPhi = 0;
+      mCellStart.assign(1, 0);
+      return;
+    }
+    mEtaMin = *std::min_element(eta.begin(), eta.end());
+    const double etaRange = *std::max_element(eta.begin(), eta.end()) - mEtaMin;
+    // cells not smaller than the search distance, and not many more cells than points
+    double cellSize = std::max(maxDistance, 1.e-3);
+    const double maxCells = std::max(64., 4. * nPoints);
+    const double nCellsEstimate = (etaRange / cellSize + 1.) * (TwoPi / cellSize);
+    if (nCellsEstimate > maxCells) {
+      cellSize *= std::sqrt(nCellsEstimate / maxCells);
+    }
+    mNPhi = std::max(1, static_cast<int>(TwoPi / cellSize));
+    mCellPhi = TwoPi / mNPhi;
+    mNEta = static_cast<int>(etaRange / cellSize) + 1;
+    mCellEta = cellSize;
+
+    // counting sort of the points by cell
+    mCellStart.assign(mNEta * mNPhi + 1, 0);
+    mCellOfPoint.resize(nPoints);
+    for (int i = 0; i < nPoints; i++) {
+      mCellOfPoint[i] = cell(etaBin(eta[i]), phiBin(phi[i]));
+      mCellStart[mCellOfPoint[i] + 1]++;
+    }
+    for (std::size_t iCell = 1; iCell < mCellStart.size(); iCell++) {
+      mCellStart[iCell] += mCellStart[iCell - 1];
+    }
+    mCellFill.assign(mCellStart.begin(), mCellStart.end() - 1);
+    for (int i = 0; i < nPoints; i++) {
+      const int pos = mCellFill[mCellOfPoint[i]]++;
+      mEta[pos] = eta[i];
+      mPhi[pos] = phi[i];
+      mIndices[pos] = i;
+    }
+  }
+
+  /// Finds the closest points within the maximum distance of the build, sorted by distance
+  /// \param eta eta of the query
+  /// \param phi phi of the query
+  /// \param nMax maximum number of points to be found
+  /// \param indices indices of the points found, -1 for the missing ones, at least nMax elements
+  /// \param distances distances of the points found, at least nMax elements
+  /// \return number of points found
+  int findNearest(T eta, T phi, int nMax, int* indices, double* distances) const
+  {
+    std::fill_n(indices, nMax, -1);
+    std::fill_n(distances, nMax, mMaxDistance);
+    if (mNEta == 0 || nMax <= 0) {
+      return 0;
+    }
+    const int rangeEta = static_cast<int>(std::ceil(mMaxDistance / mCellEta));
+    const int rangePhi = static_cast<int>(std::ceil(mMaxDistance / mCellPhi));
+    const int iEtaQuery = static_cast<int>(std::floor((eta - mEtaMin) / mCellEta));
+    const int iEtaFirst = std::max(0, iEtaQuery - rangeEta);
+    const int iEtaLast = std::min(mNEta - 1, iEtaQuery + rangeEta);
+    const int iPhiQuery = phiBin(phi);
+    const bool allPhi = 2 * rangePhi + 1 >= mNPhi;
+    const int iPhiFirst = allPhi ? 0 : iPhiQuery - rangePhi;
+    const int iPhiLast = allPhi ? mNPhi - 1 : iPhiQuery + rangePhi;
+    int nFound = 0;
+    for (int iEta = iEtaFirst; iEta <= iEtaLast; iEta++) {
+      for (int iPhi = iPhiFirst; iPhi <= iPhiLast; iPhi++) {
+        const int iCell = cell(iEta, (iPhi + mNPhi) % mNPhi);
+        for (int pos = mCellStart[iCell]; pos < mCellStart[iCell + 1]; pos++) {
+          const double dEta = eta - mEta[pos];
+          double dPhi = std::fmod(std::fabs(phi - mPhi[pos]), TwoPi);
+          dPhi = std::min(dPhi, TwoPi - dPhi);
+          const double distance = std::sqrt(dEta * dEta + dPhi * dPhi);
+          if (distance >= distances[nMax - 1]) {
+            continue;
+          }
+          // insertion in the sorted list of the closest points
+          int iInsert = std::min(nFound, nMax - 1);
+          while (iInsert > 0 && distances[iInsert - 1] > distance) {
+            distances[iInsert] = distances[iInsert - 1];
+            indices[iInsert] = indices[iInsert - 1];
+            iInsert--;
+          }
+          distances[iInsert] = distance;
+          indices[iInsert] = mIndices[pos];
+          nFound = std::min(nFound + 1, nMax);
+        }
+      }
+    }
+    return nFound;
+  }
+
+  /// Finds the closest point within the maximum distance of the build
+  /// \return index of the point, -1 if none
+  int findNearest(T eta, T phi, double& distance) const
+  {
+    int index = -1;
+    findNearest(eta, phi, 1, &index, &distance);
+    return index;
+  }
+
+ private:
+  static constexpr double TwoPi = 2. * M_PI;
+
+  int etaBin(T eta) const { return std::min(mNEta - 1, std::max(0, static_cast<int>((eta - mEtaMin) / mCellEta))); }
+  int phiBin(T phi) const
+  {
+    double phiWrapped = std::fmod(static_cast<double>(phi), TwoPi);
+    if (phiWrapped < 0.) {
+      phiWrapped += TwoPi;
+    }
+    return std::min(mNPhi - 1, static_cast<int>(phiWrapped / mCellPhi));
+  }
+  int cell(int iEta, int iPhi) const { return iEta * mNPhi + iPhi; }
+
+  double mMaxDistance = 0.;      // maximum distance of the searches
+  double mEtaMin = 0.;           // lower edge of the first eta cell
+  double mCellEta = 1.;          // eta size of the cells
+  double mCellPhi = 1.;          // phi size of the cells
+  int mNEta = 0;                 // number of eta cells
+  int mNPhi = 0;                 // number of phi cells
+  std::vector<int> mCellStart;   // position of the first point of each cell, and total number of points at the end
+  std::vector<int> mCellFill;    // fill position of each cell while building
+  std::vector<int> mCellOfPoint; // cell of each input point while building
+  std::vector<T> mEta;           // eta of the points, sorted by cell
+  std::vector<T> mPhi;           // phi of the points, sorted by cell
+  std::vector<int> mIndices;     // input index of the points, sorted by cell
+};
+
+}; // namespace jetutilities
+
+#endif // PWGJE_CORE_ETAPHIGRID_H_
@@ -12,8 +12,11 @@
 // jet finder task
 //
 // Author: Hadi Hassan, Universiy of Jväskylä, hadi.hassan@cern.ch
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <tuple>
+#include <vector>
 #include "Framework/Logger.h"
 #include "Common/Core/RecoDecay.h"
 #include "PWGJE/Core/JetUtilities.h"
@@ -52,8 +55,15 @@ std::tuple<double, double> JetBkgSubUtils::estimateRhoAreaMedian(const std::vect
   // cluster the kT jets
   fastjet::ClusterSequenceArea clusterSeq(inputParticles, jetDefBkg, areaDefBkg);
 
+  return estimateRhoAreaMedianFromJets(clusterSeq.inclusive_jets(), doSparseSub);
+}
+
+std::tuple<double, double> JetBkgSubUtils::estimateRhoAreaMedianFromJets(const std::vector<fastjet::PseudoJet>& jets, bool doSparseSub)
+{
+  JetBkgSubUtils::initialise();
+
   // select jets in detector acceptance
-  std::vector<fastjet::PseudoJet> alljets = selRho(clusterSeq.inclusive_jets());
+  std::vector<fastjet::PseudoJet> alljets = selRho(jets);
 
   double totaljetAreaPhys(0), totalAreaCovered(0);
   std::vector<double> rhovector;
@@ -63,7 +73,7 @@ std::tuple<double, double> JetBkgSubUtils::estimateRhoAreaMedian(const std::vect
   for (auto& ijet : alljets) {
 
     // Physical area/ Physical jets (no ghost)
-    if (!clusterSeq.is_pure_ghost(ijet)) {
+    if (!ijet.is_pure_ghost()) {
       rhovector.push_back(ijet.perp() / ijet.area());
       rhoMdvector.push_back(getMd(ijet) / ijet.area());
 
@@ -99,10 +109,29 @@ std::tuple<double, double> JetBkgSubUtils::estimateRhoPerpCone(const std::vector
     return std::make_tuple(0.0, 0.0);
   }
 
-  double perpPtDensity1 = 0;
-  double perpPtDensity2 = 0;
-  double perpMdDensity1 = 0;
-  double perpMdDensity2 = 0;
+  perpConeEta.clear();
+  perpConePhi.clear();
+  perpConePt.clear();
+  perpConeMd.clear();
+  perpConeEta.reserve(inputParticles.size());
+  perpConePhi.reserve(inputParticles.size());
+  perpConePt.reserve(inputParticles.size());
+  perpConeMd.reserve(inputParticles.size());
+  for (auto& particle : inputParticles) {
+    perpConeEta.push_back(particle.eta());
+    perpConePhi.push_back(particle.phi());
+    perpConePt.push_back(particle.perp());
+    perpConeMd.push_back(TMath::Sqrt(particle.m() * particle.m() + particle.pt() * particle.pt()) - particle.pt());
+  }
+  return estimateRhoPerpCone(perpConeEta, perpConePhi, perpConePt, perpConeMd, jets);
+}
+
+std::tuple<double, double> JetBkgSubUtils::estimateRhoPerpCone(const std::vector<float>& eta, const std::vector<float>& phi, const std::vector<float>& pt, const std::vector<float>& md, const std::vector<fastjet::PseudoJet>& jets)
+{
+  JetBkgSubUtils::initialise();
+  if (eta.size() == 0 || jets.size() == 0) {
+    return std::make_tuple(0.0, 0.0);
+  }
 
   fastjet::Selector selectJet = fastjet::SelectorEtaRange(bkgEtaMin, bkgEtaMax) && fastjet::SelectorPhiRange(bkgPhiMin, bkgPhiMax);
 
@@ -114,35 +143,31 @@ std::tuple<double, double> JetBkgSubUtils::estimateRhoPerpCone(const std::vector
 
   fastjet::PseudoJet leadingJet = selectedJets[0];
 
-  double dPhi1 = 999.;
-  double dPhi2 = 999.;
-  double dEta = 999.;
-  double PerpendicularConeAxisPhi1 = 999., PerpendicularConeAxisPhi2 = 999.;
   // build 2 perp cones in phi around the leading jet (right and left of the jet)
-  PerpendicularConeAxisPhi1 = RecoDecay::constrainAngle<double, double>(leadingJet.phi() + (M_PI / 2.)); // This will contrain the angel between 0-2Pi
-  PerpendicularConeAxisPhi2 = RecoDecay::constrainAngle<double, double>(leadingJet.phi() - (M_PI / 2.)); // This will contrain the angel between 0-2Pi
-
-  for (auto& particle : inputParticles) {
-    // sum the momentum of all paricles that fill the two cones
-    dPhi1 = particle.phi() - PerpendicularConeAxisPhi1;
-    dPhi1 = RecoDecay::constrainAngle<double, double>(dPhi1, -M_PI); // This will contrain the angel between -pi & Pi
-    dPhi2 = particle.phi() - PerpendicularConeAxisPhi2;
-    dPhi2 = RecoDecay::constrainAngle<double, double>(dPhi2, -M_PI); // This will contrain the angel between -pi & Pi
-    dEta = leadingJet.eta() - particle.eta();                        // The perp cone eta is the same as the leading jet since the cones are perpendicular only in phi
-    if (TMath::Sqrt(dPhi1 * dPhi1 + dEta * dEta) <= jetBkgR) {
-      perpPtDensity1 += particle.perp();
-      perpMdDensity1 += TMath::Sqrt(particle.m() * particle.m() + particle.pt() * particle.pt()) - particle.pt();
-    }
-
-    if (TMath::Sqrt(dPhi2 * dPhi2 + dEta * dEta) <= jetBkgR) {
-      perpPtDensity2 += particle.perp();
-      perpMdDensity2 += TMath::Sqrt(particle.m() * particle.m() + particle.pt() * particle.pt()) - particle.pt();
-    }
+  const float perpendicularConeAxisPhi1 = RecoDecay::constrainAngle<double, double>(leadingJet.phi() + (M_PI / 2.)); // This will contrain the angel between 0-2Pi
+  const float perpendicularConeAxisPhi2 = RecoDecay::constrainAngle<double, double>(leadingJet.phi() - (M_PI / 2.)); // This will contrain the angel between 0-2Pi
+  const float leadingJetEta = leadingJet.eta();                                                                     // The perp cone eta is the same as the leading jet since the cones are perpendicular only in phi
+  const float jetBkgR2 = jetBkgR * jetBkgR;
+  const float twoPi = 2. * M_PI;
+
+  // branch-free loop so that it can be vectorised, both phi and the cone axes are in [0, 2pi)
+  double perpPtDensity = 0;
+  double perpMdDensity = 0;
+  const size_t nParticles = eta.size();
+  for (size_t i = 0; i < nParticles; i++) {
+    const float dEta = leadingJetEta - eta[i];
+    float dPhi1 = std::fabs(phi[i] - perpendicularConeAxisPhi1);
+    dPhi1 = std::min(dPhi1, twoPi - dPhi1);
+    float dPhi2 = std::fabs(phi[i] - perpendicularConeAxisPhi2);
+    dPhi2 = std::min(dPhi2, twoPi - dPhi2);
+    const float nCones = static_cast<float>(dPhi1 * dPhi1 + dEta * dEta <= jetBkgR2) + static_cast<float>(dPhi2 * dPhi2 + dEta * dEta <= jetBkgR2);
+    perpPtDensity += nCones * pt[i];
+    perpMdDensity += nCones * md[i];
   }
 
   // Caculate rho as the ratio of average pT of the two cones / the cone area
-  double perpPtDensity = (perpPtDensity1 + perpPtDensity2) / (2 * M_PI * jetBkgR * jetBkgR);
-  double perpMdDensity = (perpMdDensity1 + perpMdDensity2) / (2 * M_PI * jetBkgR * jetBkgR);
+  perpPtDensity /= (2 * M_PI * jetBkgR * jetBkgR);
+  perpMdDensity /= (2 * M_PI * jetBkgR * jetBkgR);
 
   return std::make_tuple(perpPtDensity, perpMdDensity);
 }
@@ -161,19 +186,24 @@ std::vector<fastjet::PseudoJet> JetBkgSubUtils::doEventConstSub(std::vector<fast
 {
 
   JetBkgSubUtils::initialise();
-  fastjet::contrib::ConstituentSubtractor constituentSub(rhoParam, rhoMParam);
-  constituentSub.set_distance_type(fastjet::contrib::ConstituentSubtractor::deltaR); /// deltaR=sqrt((y_i-y_j)^2+(phi_i-phi_j)^2)), longitudinal Lorentz invariant
-  constituentSub.set_max_distance(constSubRMax);
-  constituentSub.set_alpha(constSubAlpha);
-  constituentSub.set_ghost_area(ghostAreaSpec.ghost_area());
-  constituentSub.set_max_eta(maxEtaEvent);
-
-  // by default, the masses of all particles are set to zero. With this flag the jet mass will also be subtracted
-  if (doRhoMassSub) {
-    constituentSub.set_do_mass_subtraction();
+  if (!eventConstSub) {
+    // the ghosts are built once by initialize() and reused for all the events
+    eventConstSub = std::make_unique<fastjet::contrib::ConstituentSubtractor>(rhoParam, rhoMParam);
+    eventConstSub->set_distance_type(fastjet::contrib::ConstituentSubtractor::deltaR); /// deltaR=sqrt((y_i-y_j)^2+(phi_i-phi_j)^2)), longitudinal Lorentz invariant
+    eventConstSub->set_max_distance(constSubRMax);
+    eventConstSub->set_alpha(constSubAlpha);
+    eventConstSub->set_ghost_area(ghostAreaSpec.ghost_area());
+    eventConstSub->set_max_eta(maxEtaEvent);
+
+    // by default, the masses of all particles are set to zero. With this flag the jet mass will also be subtracted
+    if (doRhoMassSub) {
+      eventConstSub->set_do_mass_subtraction();
+    }
+    eventConstSub->initialize();
   }
+  eventConstSub->set_scalar_background_density(rhoParam, rhoMParam);
 
-  return constituentSub.subtract_event(inputParticles, maxEtaEvent);
+  return eventConstSub->subtract_event(inputParticles);
 }
 
 std::vector<fastjet::PseudoJet> JetBkgSubUtils::doJetConstSub(std::vector<fastjet::PseudoJet>& jets, double rhoParam, double rhoMParam)
@@ -75,12 +75,27 @@ class JetBkgSubUtils
   /// @return Rho, RhoM the underlying event density
   std::tuple<double, double> estimateRhoAreaMedian(const std::vector<fastjet::PseudoJet>& inputParticles, bool doSparseSub);
 
+  /// @brief Method for estimating the jet background density from jets clustered beforehand, to share one clustering with other uses
+  /// @param jets (all jets in the event, with areas, whose cluster sequence is still alive)
+  /// @param doSparseSub weather to do rho sparse subtraction
+  /// @return Rho, RhoM the underlying event density
+  std::tuple<double, double> estimateRhoAreaMedianFromJets(const std::vector<fastjet::PseudoJet>& jets, bool doSparseSub);
+
   /// @brief Background estimator using the perpendicular cone method
   /// @param inputParticles
   /// @param jets (all jets in the event)
   /// @return Rho, RhoM the underlying event density
   std::tuple<double, double> estimateRhoPerpCone(const std::vector<fastjet::PseudoJet>& inputParticles, const std::vector<fastjet::PseudoJet>& jets);
 
+  /// @brief Background estimator using the perpendicular cone method, with the particles given as arrays
+  /// @param eta pseudorapidities of the particles
+  /// @param phi azimuthal angles of the particles, in [0, 2pi)
+  /// @param pt transverse momenta of the particles
+  /// @param md mT - pT of the particles, used for RhoM
+  /// @param jets (all jets in the event)
+  /// @return Rho, RhoM the underlying event density
+  std::tuple<double, double> estimateRhoPerpCone(const std::vector<float>& eta, const std::vector<float>& phi, const std::vector<float>& pt, const std::vector<float>& md, const std::vector<fastjet::PseudoJet>& jets);
+
   /// @brief method that subtracts the background from jets using the area method
   /// @param jet input jet to be background subtracted
   /// @param rhoParam the underlying evvent density vs pT (to be set)
@@ -89,6 +104,7 @@ class JetBkgSubUtils
   fastjet::PseudoJet doRhoAreaSub(fastjet::PseudoJet& jet, double rhoParam, double rhoMParam);
 
   /// @brief method that subtracts the background from the input particles using the event-wise cosntituent subtractor
+  /// @note the subtractor and its ghosts are kept between calls, one JetBkgSubUtils object is needed per thread
   /// @param inputParticles (all the tracks/clusters/particles in the event)
   /// @param rhoParam the underlying evvent density vs pT (to be set)
   /// @param rhoParam the underlying evvent density vs jet mass (to be set)
@@ -118,10 +134,23 @@ class JetBkgSubUtils
   {
     constSubAlpha = alpha_out;
     constSubRMax = rmax_out;
+    eventConstSub.reset();
+  }
+  void setMaxEtaEvent(float etaMaxEvent)
+  {
+    maxEtaEvent = etaMaxEvent;
+    eventConstSub.reset();
+  }
+  void setDoRhoMassSub(bool doMSub_out = true)
+  {
+    doRhoMassSub = doMSub_out;
+    eventConstSub.reset();
+  }
+  void setGhostAreaSpec(fastjet::GhostedAreaSpec ghostAreaSpec_out)
+  {
+    ghostAreaSpec = ghostAreaSpec_out;
+    eventConstSub.reset();
   }
-  void setMaxEtaEvent(float etaMaxEvent) { maxEtaEvent = etaMaxEvent; }
-  void setDoRhoMassSub(bool doMSub_out = true) { doRhoMassSub = doMSub_out; }
-  void setGhostAreaSpec(fastjet::GhostedAreaSpec ghostAreaSpec_out) { ghostAreaSpec = ghostAreaSpec_out; }
   void setJetDefinition(fastjet::JetDefinition jetdefbkg_out) { jetDefBkg = jetdefbkg_out; }
   void setAreaDefinition(fastjet::AreaDefinition areaDefBkg_out) { areaDefBkg = areaDefBkg_out; }
   void setRhoSelector(fastjet::Selector selRho_out) { selRho = selRho_out; }
@@ -156,6 +185,11 @@ class JetBkgSubUtils
   int nHardReject = 2;
   bool doRhoMassSub = false; /// flag whether to do jet mass subtraction with the const sub
 
+  std::vector<float> perpConeEta; /// particle arrays for the perpendicular cones, kept to avoid reallocations
+  std::vector<float> perpConePhi;
+  std::vector<float> perpConePt;
+  std::vector<float> perpConeMd;
+
   fastjet::GhostedAreaSpec ghostAreaSpec = fastjet::GhostedAreaSpec();
   fastjet::JetAlgorithm algorithmBkg = fastjet::kt_algorithm;
   fastjet::RecombinationScheme recombSchemeBkg = fastjet::E_scheme;
@@ -163,6 +197,8 @@ class JetBkgSubUtils
   fastjet::AreaDefinition areaDefBkg = fastjet::AreaDefinition(fastjet::active_area_explicit_ghosts, ghostAreaSpec);
   fastjet::Selector selRho = fastjet::Selector();
 
+  std::unique_ptr<fastjet::contrib::ConstituentSubtractor> eventConstSub; //! event-wise subtractor with its ghosts, created at the first use after a change of the parameters
+
 }; // class JetBkgSubUtils
 
 #endif // PWGJE_CORE_JETBKGSUBUTILS_H_
@@ -0,0 +1,187 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file JetConstituentUtilities.h
+/// \brief Contiguous per-dataframe storage of the jet constituent kinematics
+///        The (pt, eta, phi, mass) of the constituents of all the jets of a table are copied once, in jet order,
+///        so that the tasks can loop over the constituents of a jet through spans instead of dereferencing
+///        the constituent index columns one by one with tracks_as<>.
+
+#ifndef PWGJE_CORE_JETCONSTITUENTUTILITIES_H_
+#define PWGJE_CORE_JETCONSTITUENTUTILITIES_H_
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <gsl/span>
+
+#include "fastjet/PseudoJet.hh"
+
+#include "PWGJE/Core/FastJetUtilities.h"
+
+namespace jetconstituentutilities
+{
+
+/// Constituents of one jet, pointing into the arrays of a JetConstituentArrays
+struct JetConstituentSpan {
+  gsl::span<const float> pt;
+  gsl::span<const float> eta;
+  gsl::span<const float> phi;
+  gsl::span<const float> mass;
+  gsl::span<const int32_t> index; // global index of the constituents in their table
+
+  std::size_t size() const { return pt.size(); }
+  bool empty() const { return pt.empty(); }
+};
+
+class JetConstituentArrays
+{
+ public:
+  /// Fills the constituent arrays of all the jets of a table
+  /// \param jets jet table with a constituent index column, possibly filtered or sliced
+  /// \param tracks table of the constituents, read sequentially once
+  /// \param massOf callable returning the mass assigned to a constituent
+  template <typename T, typename U, typename F>
+  void build(T const& jets, U const& tracks, F&& massOf)
+  {
+    clear();
+    if (jets.size() == 0) {
+      return;
+    }
+
+    // the constituent kinematics are first read sequentially, by position in their table
+    int64_t firstTrackIndex = -1;
+    for (auto const& track : tracks) {
+      if (firstTrackIndex < 0) {
+        firstTrackIndex = track.globalIndex();
+      }
+      const std::size_t position = track.globalIndex() - firstTrackIndex;
+      if (position >= mTrackPt.size()) {
+        mTrackPt.resize(position + 1);
+        mTrackEta.resize(position + 1);
+        mTrackPhi.resize(position + 1);
+        mTrackMass.resize(position + 1);
+        mTrackValid.resize(position + 1, false);
+      }
+      mTrackPt[position] = track.pt();
+      mTrackEta[position] = track.eta();
+      mTrackPhi[position] = track.phi();
+      mTrackMass[position] = massOf(track);
+      mTrackValid[position] = true;
+    }
+
+    // then gathered in jet order
+    mFirstJetIndex = -1;
+    std::size_t jetPosition = 0;
+    for (auto const& jet : jets) {
+      if (mFirstJetIndex < 0) {
+        mFirstJetIndex = jet.globalIndex();
+      }
+      const std::size_t position = jet.globalIndex() - mFirstJetIndex;
+      while (jetPosition <= position) {
+        mOffsets.push_back(mPt.size()); // jets missing from a filtered table have no constituents
+        jetPosition++;
+      }
+      for (auto const& trackId : jet.tracksIds()) {
+        const int64_t trackPosition = trackId - firstTrackIndex;
+        if (firstTrackIndex < 0 || trackPosition < 0 || trackPosition >= static_cast<int64_t>(mTrackValid.size()) || !mTrackValid[trackPosition]) {
+          continue; // constituent not in the table, e.g. rejected by a filter
+        }
+        mPt.push_back(mTrackPt[trackPosition]);
+        mEta.push_back(mTrackEta[trackPosition]);
+        mPhi.push_back(mTrackPhi[trackPosition]);
+        mMass.push_back(mTrackMass[trackPosition]);
+        mIndex.push_back(trackId);
+      }
+    }
+    mOffsets.push_back(mPt.size());
+  }
+
+  /// Fills the constituent arrays of all the jets of a table, with the same mass for all the constituents
+  template <typename T, typename U>
+  void build(T const& jets, U const& tracks, float mass = fastjetutilities::mPion)
+  {
+    build(jets, tracks, [mass](auto const& /*track*/) { return mass; });
+  }
+
+  void clear()
+  {
+    mFirstJetIndex = -1;
+    mOffsets.clear();
+    mPt.clear();
+    mEta.clear();
+    mPhi.clear();
+    mMass.clear();
+    mIndex.clear();
+    mTrackPt.clear();
+    mTrackEta.clear();
+    mTrackPhi.clear();
+    mTrackMass.clear();
+    mTrackValid.clear();
+  }
+
+  /// Number of constituents of all the jets
+  std::size_t size() const { return mPt.size(); }
+
+  /// Constituents of a jet of the table used in build(), empty for a jet not in the table
+  template <typename T>
+  JetConstituentSpan get(T const& jet) const
+  {
+    const int64_t position = jet.globalIndex() - mFirstJetIndex;
+    if (mFirstJetIndex < 0 || position < 0 || position + 1 >= static_cast<int64_t>(mOffsets.size())) {
+      return {};
+    }
+    const std::size_t first = mOffsets[position];
+    const std::size_t n = mOffsets[position + 1] - first;
+    return {{mPt.data() + first, n}, {mEta.data() + first, n}, {mPhi.data() + first, n}, {mMass.data() + first, n}, {mIndex.data() + first, n}};
+  }
+
+ private:
+  int64_t mFirstJetIndex = -1;       // global index of the first jet
+  std::vector<std::size_t> mOffsets; // first constituent of each jet by global index - mFirstJetIndex, and total number of constituents at the end
+  std::vector<float> mPt;            // constituents of all the jets, in jet order
+  std::vector<float> mEta;
+  std::vector<float> mPhi;
+  std::vector<float> mMass;
+  std::vector<int32_t> mIndex;
+  std::vector<float> mTrackPt; // kinematics of the constituent table by position, used while building
+  std::vector<float> mTrackEta;
+  std::vector<float> mTrackPhi;
+  std::vector<float> mTrackMass;
+  std::vector<bool> mTrackValid;
+};
+
+/**
+ * Adds the constituents of a jet as fastjet pseudojet objects, with the same four-momenta as fastjetutilities::fillTracks
+ *
+ * @param jetConstituents constituents of the jet
+ * @param constituents vector of pseudojets
+ * @param status status of constituent type
+ */
+inline void fillPseudoJets(JetConstituentSpan const& jetConstituents, std::vector<fastjet::PseudoJet>& constituents, int status = static_cast<int>(JetConstituentStatus::track))
+{
+  constituents.reserve(constituents.size() + jetConstituents.size());
+  for (std::size_t i = 0; i < jetConstituents.size(); i++) {
+    const float pt = jetConstituents.pt[i];
+    const float eta = jetConstituents.eta[i];
+    const float phi = jetConstituents.phi[i];
+    const float mass = jetConstituents.mass[i];
+    const float p = pt * std::cosh(eta);
+    const float energy = std::sqrt((p * p) + (mass * mass));
+    constituents.emplace_back(pt * std::cos(phi), pt * std::sin(phi), pt * std::sinh(eta), energy);
+    fastjetutilities::setFastJetUserInfo(constituents, jetConstituents.index[i], status);
+  }
+}
+
+}; // namespace jetconstituentutilities
+
+#endif // PWGJE_CORE_JETCONSTITUENTUTILITIES_H_
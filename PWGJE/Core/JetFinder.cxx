@@ -60,3 +60,71 @@ fastjet::ClusterSequenceArea JetFinder::findJets(std::vector<fastjet::PseudoJet>
   }
   return clusterSeq;
 }
+
+bool JetFinder::isStrategyValid() const
+{
+  switch (strategy) {
+    case fastjet::NlnN:
+    case fastjet::NlnN3pi:
+    case fastjet::NlnN4pi:
+      return algorithm == fastjet::kt_algorithm || algorithm == fastjet::cambridge_algorithm || algorithm == fastjet::antikt_algorithm;
+    case fastjet::NlnNCam:
+    case fastjet::NlnNCam2pi2R:
+    case fastjet::NlnNCam4pi:
+      return algorithm == fastjet::cambridge_algorithm;
+    case fastjet::N2MHTLazy9AntiKtSeparateGhosts:
+      return algorithm == fastjet::antikt_algorithm;
+    case fastjet::plugin_strategy:
+      return false;
+    default:
+      return true;
+  }
+}
+
+std::unique_ptr<fastjet::ClusterSequence> JetFinder::findJetsNoArea(const std::vector<fastjet::PseudoJet>& inputParticles, std::vector<fastjet::PseudoJet>& jets)
+{
+  setParams();
+  jets.clear();
+  auto clusterSeq = std::make_unique<fastjet::ClusterSequence>(inputParticles, jetDef);
+  jets = clusterSeq->inclusive_jets();
+  jets = selJets(jets);
+  jets = fastjet::sorted_by_pt(jets);
+  if (isReclustering) {
+    jetR = jetR / 5.0;
+  }
+  return clusterSeq;
+}
+
+const std::vector<fastjet::PseudoJet>& JetFinder::getGhosts()
+{
+  setParams();
+  if (isReclustering) {
+    jetR = jetR / 5.0;
+  }
+  std::vector<double> ghostParams{ghostEtaMax, static_cast<double>(ghostRepeatN), ghostArea, gridScatter, ktScatter, ghostktMean};
+  if (cacheGhosts && mGhosts && ghostParams == mGhostParams) {
+    return *mGhosts;
+  }
+  if (!ghostSeeds.empty()) {
+    ghostAreaSpec.set_random_status(ghostSeeds);
+  }
+  auto ghosts = std::make_shared<std::vector<fastjet::PseudoJet>>();
+  ghostAreaSpec.add_ghosts(*ghosts);
+  mGhosts = ghosts;
+  mGhostParams = ghostParams;
+  return *mGhosts;
+}
+
+std::unique_ptr<fastjet::ClusterSequenceActiveAreaExplicitGhosts> JetFinder::findJets(const std::vector<fastjet::PseudoJet>& inputParticles, const std::vector<fastjet::PseudoJet>& ghosts, std::vector<fastjet::PseudoJet>& jets)
+{
+  setParams();
+  jets.clear();
+  auto clusterSeq = std::make_unique<fastjet::ClusterSequenceActiveAreaExplicitGhosts>(inputParticles, jetDef, ghosts, ghostAreaSpec.actual_ghost_area());
+  jets = clusterSeq->inclusive_jets();
+  jets = (!fastjet::SelectorIsPureGhost() && selJets)(jets);
+  jets = fastjet::sorted_by_pt(jets);
+  if (isReclustering) {
+    jetR = jetR / 5.0;
+  }
+  return clusterSeq;
+}
@@ -27,6 +27,7 @@
 
 #include "fastjet/PseudoJet.hh"
 #include "fastjet/ClusterSequenceArea.hh"
+#include "fastjet/ClusterSequenceActiveAreaExplicitGhosts.hh"
 #include "fastjet/AreaDefinition.hh"
 #include "fastjet/JetDefinition.hh"
 #include "fastjet/tools/Subtractor.hh"
@@ -73,6 +74,12 @@ class JetFinder
   bool isReclustering = false;
   bool isTriggering = false;
 
+  bool reuseGhostsAcrossRadii = false; // generate the ghosts once and cluster the same input for all the radii, see jetfindingutilities::findJets
+  int nThreadsAcrossRadii = 1;         // number of worker threads for the clusterings of the different radii when reusing the ghosts
+  bool computeArea = true;             // set to false to cluster without ghosts when the jet areas are not needed
+  bool cacheGhosts = false;            // keep the ghosts of the area definition and reuse them for all the events with the same ghost parameters
+  std::vector<int> ghostSeeds;         // seeds of the ghost random generator, used if not empty to make the ghosts reproducible
+
   fastjet::JetAlgorithm algorithm = fastjet::antikt_algorithm;
   fastjet::RecombinationScheme recombScheme = fastjet::E_scheme;
   fastjet::Strategy strategy = fastjet::Best;
@@ -86,6 +93,11 @@ class JetFinder
   /// Sets the jet finding parameters
   void setParams();
 
+  /// Checks that the clustering strategy is available for the jet algorithm
+  /// \note the NlnN strategies need FastJet built with CGAL, NlnNCam* only for Cambridge/Aachen
+  /// \return true if the strategy can be used
+  bool isStrategyValid() const;
+
   /// Performs jet finding
   /// \note the input particle and jet lists are passed by reference
   /// \param inputParticles vector of input particles/tracks
@@ -93,7 +105,29 @@ class JetFinder
   /// \return ClusterSequenceArea object needed to access constituents
   fastjet::ClusterSequenceArea findJets(std::vector<fastjet::PseudoJet>& inputParticles, std::vector<fastjet::PseudoJet>& jets); // ideally find a way of passing the cluster sequence as a reeference
 
+  /// Performs jet finding without ghosts, for the cases where the jet areas are not needed
+  /// \param inputParticles vector of input particles/tracks
+  /// \param jets vector of jets to be filled
+  /// \return cluster sequence needed to access constituents
+  std::unique_ptr<fastjet::ClusterSequence> findJetsNoArea(const std::vector<fastjet::PseudoJet>& inputParticles, std::vector<fastjet::PseudoJet>& jets);
+
+  /// Returns the ghosts of the area definition, to be shared by several clusterings
+  /// \note with cacheGhosts the ghosts are only generated again if the ghost parameters change
+  /// \return ghosts, valid until the next call
+  const std::vector<fastjet::PseudoJet>& getGhosts();
+
+  /// Performs jet finding with ghosts generated beforehand
+  /// \note pure-ghost jets are removed, the constituents of the jets still contain the ghosts
+  /// \param inputParticles vector of input particles/tracks
+  /// \param ghosts vector of ghosts from getGhosts
+  /// \param jets vector of jets to be filled
+  /// \return cluster sequence needed to access constituents
+  std::unique_ptr<fastjet::ClusterSequenceActiveAreaExplicitGhosts> findJets(const std::vector<fastjet::PseudoJet>& inputParticles, const std::vector<fastjet::PseudoJet>& ghosts, std::vector<fastjet::PseudoJet>& jets);
+
  private:
+  std::shared_ptr<const std::vector<fastjet::PseudoJet>> mGhosts; //! ghosts of the last call to getGhosts, shared by the copies of the jet finder
+  std::vector<double> mGhostParams;                                //! ghost parameters of mGhosts
+
   ClassDefNV(JetFinder, 1);
 };
 
@@ -17,12 +17,14 @@
 #ifndef PWGJE_CORE_JETFINDINGUTILITIES_H_
 #define PWGJE_CORE_JETFINDINGUTILITIES_H_
 
+#include <algorithm>
 #include <array>
 #include <vector>
 #include <string>
 #include <optional>
 #include <cmath>
 #include <memory>
+#include <thread>
 
 #include "Framework/AnalysisTask.h"
 #include "Framework/AnalysisDataModel.h"
@@ -231,9 +233,65 @@ bool analyseV0s(std::vector<fastjet::PseudoJet>& inputParticles, T const& v0s, f
   }
 }
 
+/**
+ * Fills the jet tables with a jet
+ *
+ * @param jet the jet
+ * @param constituents constituents of the jet, without ghosts
+ * @param R jet radius
+ * @param collision the collision within which jets are being found
+ * @param jetsTable output table of jets
+ * @param constituentsTable output table of jet constituents
+ * @param doHFJetFinding set whether only jets containing a HF candidate are saved
+ */
+template <typename T, typename U, typename V>
+void fillJetTables(const fastjet::PseudoJet& jet, const std::vector<fastjet::PseudoJet>& constituents, double R, float jetAreaFractionMin, T const& collision, U& jetsTable, V& constituentsTable, std::shared_ptr<THn> thnSparseJet, bool fillThnSparse, bool doCandidateJetFinding)
+{
+  if (jet.has_area() && jet.area() < jetAreaFractionMin * M_PI * R * R) {
+    return;
+  }
+  if (fillThnSparse) {
+    thnSparseJet->Fill(R, jet.pt(), jet.eta(), jet.phi()); // important for normalisation in V0Jet analyses to store all jets, including those that aren't V0s
+  }
+  bool isCandidateJet = false;
+  if (doCandidateJetFinding) {
+    for (const auto& constituent : constituents) {
+      auto constituentStatus = constituent.template user_info<fastjetutilities::fastjet_user_info>().getStatus();
+      if (constituentStatus == static_cast<int>(JetConstituentStatus::candidateHF)) { // note currently we cannot run V0 and HF in the same jet. If we ever need to we can seperate the loops
+        isCandidateJet = true;
+        break;
+      }
+    }
+    if (!isCandidateJet) {
+      return;
+    }
+  }
+  std::vector<int> tracks;
+  std::vector<int> cands;
+  std::vector<int> clusters;
+  jetsTable(collision.globalIndex(), jet.pt(), jet.eta(), jet.phi(),
+            jet.E(), jet.rapidity(), jet.m(), jet.has_area() ? jet.area() : 0., std::round(R * 100));
+  for (const auto& constituent : sorted_by_pt(constituents)) {
+    if (constituent.template user_info<fastjetutilities::fastjet_user_info>().getStatus() == static_cast<int>(JetConstituentStatus::track)) {
+      tracks.push_back(constituent.template user_info<fastjetutilities::fastjet_user_info>().getIndex());
+    }
+    if (constituent.template user_info<fastjetutilities::fastjet_user_info>().getStatus() == static_cast<int>(JetConstituentStatus::cluster)) {
+      clusters.push_back(constituent.template user_info<fastjetutilities::fastjet_user_info>().getIndex());
+    }
+    if (constituent.template user_info<fastjetutilities::fastjet_user_info>().getStatus() == static_cast<int>(JetConstituentStatus::candidateHF)) {
+      cands.push_back(constituent.template user_info<fastjetutilities::fastjet_user_info>().getIndex());
+    }
+  }
+  constituentsTable(jetsTable.lastIndex(), tracks, clusters, cands);
+}
+
 /**
  * Performs jet finding and fills jet tables
  *
+ * With jetFinder.reuseGhostsAcrossRadii the ghosts are generated once and shared by the clusterings of all the radii,
+ * which run on jetFinder.nThreadsAcrossRadii worker threads. The tables are always filled in the order of the radii.
+ * With jetFinder.cacheGhosts the same ghosts are also kept across events, with jetFinder.computeArea false no ghosts are used.
+ *
  * @param jetFinder JetFinder object which carries jet finding parameters
  * @param inputParticles fastjet container
  * @param jetRadius jet finding radii
@@ -248,47 +306,57 @@ void findJets(JetFinder& jetFinder, std::vector<fastjet::PseudoJet>& inputPartic
   auto jetRValues = static_cast<std::vector<double>>(jetRadius);
   jetFinder.jetPtMin = jetPtMin;
   jetFinder.jetPtMax = jetPtMax;
+  if (!jetFinder.computeArea) {
+    for (auto R : jetRValues) {
+      jetFinder.jetR = R;
+      std::vector<fastjet::PseudoJet> jets;
+      auto clusterSeq = jetFinder.findJetsNoArea(inputParticles, jets);
+      for (const auto& jet : jets) {
+        fillJetTables(jet, jet.constituents(), R, jetAreaFractionMin, collision, jetsTable, constituentsTable, thnSparseJet, fillThnSparse, doCandidateJetFinding);
+      }
+    }
+    return;
+  }
+  if (jetFinder.reuseGhostsAcrossRadii || jetFinder.cacheGhosts) {
+    const std::size_t nRadii = jetRValues.size();
+    const auto& ghosts = jetFinder.getGhosts();
+    std::vector<JetFinder> jetFinders(nRadii, jetFinder); // one copy per radius, setParams modifies the jet finder
+    std::vector<std::unique_ptr<fastjet::ClusterSequenceActiveAreaExplicitGhosts>> clusterSeqs(nRadii);
+    std::vector<std::vector<fastjet::PseudoJet>> jets(nRadii);
+    auto clusterRadii = [&](std::size_t iFirst, std::size_t iStep) {
+      for (auto iR = iFirst; iR < nRadii; iR += iStep) {
+        jetFinders[iR].jetR = jetRValues[iR];
+        clusterSeqs[iR] = jetFinders[iR].findJets(inputParticles, ghosts, jets[iR]);
+      }
+    };
+    const std::size_t nThreads = std::min(static_cast<std::size_t>(std::max(jetFinder.nThreadsAcrossRadii, 1)), nRadii);
+    if (nThreads <= 1) {
+      clusterRadii(0, 1);
+    } else {
+      fastjet::ClusterSequence::print_banner(); // printed once here rather than concurrently by the first clusterings
+      std::vector<std::thread> threads;
+      threads.reserve(nThreads);
+      for (std::size_t iThread = 0; iThread < nThreads; iThread++) {
+        threads.emplace_back(clusterRadii, iThread, nThreads);
+      }
+      for (auto& thread : threads) {
+        thread.join();
+      }
+    }
+    for (std::size_t iR = 0; iR < nRadii; iR++) {
+      jetFinder.jetR = jetRValues[iR];
+      for (const auto& jet : jets[iR]) {
+        fillJetTables(jet, (!fastjet::SelectorIsPureGhost())(jet.constituents()), jetRValues[iR], jetAreaFractionMin, collision, jetsTable, constituentsTable, thnSparseJet, fillThnSparse, doCandidateJetFinding);
+      }
+    }
+    return;
+  }
   for (auto R : jetRValues) {
     jetFinder.jetR = R;
     std::vector<fastjet::PseudoJet> jets;
     fastjet::ClusterSequenceArea clusterSeq(jetFinder.findJets(inputParticles, jets));
     for (const auto& jet : jets) {
-      if (jet.has_area() && jet.area() < jetAreaFractionMin * M_PI * R * R) {
-        continue;
-      }
-      if (fillThnSparse) {
-        thnSparseJet->Fill(R, jet.pt(), jet.eta(), jet.phi()); // important for normalisation in V0Jet analyses to store all jets, including those that aren't V0s
-      }
-      bool isCandidateJet = false;
-      if (doCandidateJetFinding) {
-        for (const auto& constituent : jet.constituents()) {
-          auto constituentStatus = constituent.template user_info<fastjetutilities::fastjet_user_info>().getStatus();
-          if (constituentStatus == static_cast<int>(JetConstituentStatus::candidateHF)) { // note currently we cannot run V0 and HF in the same jet. If we ever need to we can seperate the loops
-            isCandidateJet = true;
-            break;
-          }
-        }
-        if (!isCandidateJet) {
-          continue;
-        }
-      }
-      std::vector<int> tracks;
-      std::vector<int> cands;
-      std::vector<int> clusters;
-      jetsTable(collision.globalIndex(), jet.pt(), jet.eta(), jet.phi(),
-                jet.E(), jet.rapidity(), jet.m(), jet.has_area() ? jet.area() : 0., std::round(R * 100));
-      for (const auto& constituent : sorted_by_pt(jet.constituents())) {
-        if (constituent.template user_info<fastjetutilities::fastjet_user_info>().getStatus() == static_cast<int>(JetConstituentStatus::track)) {
-          tracks.push_back(constituent.template user_info<fastjetutilities::fastjet_user_info>().getIndex());
-        }
-        if (constituent.template user_info<fastjetutilities::fastjet_user_info>().getStatus() == static_cast<int>(JetConstituentStatus::cluster)) {
-          clusters.push_back(constituent.template user_info<fastjetutilities::fastjet_user_info>().getIndex());
-        }
-        if (constituent.template user_info<fastjetutilities::fastjet_user_info>().getStatus() == static_cast<int>(JetConstituentStatus::candidateHF)) {
-          cands.push_back(constituent.template user_info<fastjetutilities::fastjet_user_info>().getIndex());
-        }
-      }
-      constituentsTable(jetsTable.lastIndex(), tracks, clusters, cands);
+      fillJetTables(jet, jet.constituents(), R, jetAreaFractionMin, collision, jetsTable, constituentsTable, thnSparseJet, fillThnSparse, doCandidateJetFinding);
     }
   }
 }
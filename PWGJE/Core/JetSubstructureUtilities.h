@@ -43,6 +43,26 @@
 namespace jetsubstructureutilities
 {
 
+/**
+ * recluster the constituents of a jet into a single fastjet pseudojet object, returning its clusterSequence
+ *
+ * @param jetConstituents fastjet pseudojet objects of the jet constituents
+ * @param jetR jet radius
+ * @param pseudoJet reclustered pseudoJet object which is passed by reference
+ */
+inline fastjet::ClusterSequenceArea constituentsToPseudoJet(std::vector<fastjet::PseudoJet>& jetConstituents, double jetR, fastjet::PseudoJet& pseudoJet)
+{
+  std::vector<fastjet::PseudoJet> jetReclustered;
+
+  JetFinder jetReclusterer;
+  jetReclusterer.isReclustering = true;
+  jetReclusterer.jetR = jetR;
+  fastjet::ClusterSequenceArea clusterSeq = jetReclusterer.findJets(jetConstituents, jetReclustered);
+  jetReclustered = sorted_by_pt(jetReclustered);
+  pseudoJet = jetReclustered[0];
+  return clusterSeq;
+}
+
 /**
  * convert an O2Physics jet to a fastjet pseudojet object, returning its clusterSequence
  *
@@ -69,15 +89,37 @@ fastjet::ClusterSequenceArea jetToPseudoJet(T const& jet, U const& /*tracks*/, V
       fastjetutilities::fillTracks(jetHFConstituent, jetConstituents, jetHFConstituent.globalIndex(), static_cast<int>(JetConstituentStatus::candidateHF), jethfutilities::getTablePDGMass<O>());
     }
   }
-  std::vector<fastjet::PseudoJet> jetReclustered;
+  return constituentsToPseudoJet(jetConstituents, jet.r() / 100.0, pseudoJet);
+}
 
-  JetFinder jetReclusterer;
-  jetReclusterer.isReclustering = true;
-  jetReclusterer.jetR = jet.r() / 100.0;
-  fastjet::ClusterSequenceArea clusterSeq = jetReclusterer.findJets(jetConstituents, jetReclustered);
-  jetReclustered = sorted_by_pt(jetReclustered);
-  pseudoJet = jetReclustered[0];
-  return clusterSeq;
+/**
+ * returns a vector with Nsubjettiness variables of a reclustered fastjet pseudojet object, see the overload with the jet for the parameters
+ */
+template <typename M>
+std::vector<float> getPseudoJetNSubjettiness(fastjet::PseudoJet pseudoJet, double jetR, int nMax, M const& reclusteringAlgorithm, bool doSoftDrop = false, float zCut = 0.1, float beta = 0.0)
+{
+  std::vector<float> result;
+  if (doSoftDrop) {
+    fastjet::contrib::SoftDrop softDrop(beta, zCut);
+    pseudoJet = softDrop(pseudoJet);
+  }
+
+  for (auto n = 0; n < nMax + 1; n++) {
+    result.push_back(-1.0 * (n + 1));
+  }
+
+  for (auto n = 1; n <= nMax; n++) {
+    if (pseudoJet.constituents().size() < n) { // Tau_N needs at least N tracks
+      return result;
+    }
+    fastjet::contrib::Nsubjettiness nSub(n, reclusteringAlgorithm, fastjet::contrib::NormalizedMeasure(1.0, jetR));
+    result[n] = nSub.result(pseudoJet);
+    if (n == 2) {
+      std::vector<fastjet::PseudoJet> nSubAxes = nSub.currentAxes(); // gets the two axes used in the 2-subjettiness calculation
+      result[0] = nSubAxes[0].delta_R(nSubAxes[1]);                  // distance between axes for 2-subjettiness
+    }
+  }
+  return result;
 }
 
 /**
@@ -98,30 +140,51 @@ fastjet::ClusterSequenceArea jetToPseudoJet(T const& jet, U const& /*tracks*/, V
 template <typename T, typename U, typename V, typename O, typename M>
 std::vector<float> getNSubjettiness(T const& jet, U const& tracks, V const& clusters, O const& candidates, int nMax, M const& reclusteringAlgorithm, bool doSoftDrop = false, float zCut = 0.1, float beta = 0.0)
 {
-  std::vector<float> result;
   fastjet::PseudoJet pseudoJet;
   fastjet::ClusterSequenceArea clusterSeq(jetToPseudoJet(jet, tracks, clusters, candidates, pseudoJet));
-  if (doSoftDrop) {
-    fastjet::contrib::SoftDrop softDrop(beta, zCut);
-    pseudoJet = softDrop(pseudoJet);
-  }
+  return getPseudoJetNSubjettiness(pseudoJet, jet.r() / 100.0, nMax, reclusteringAlgorithm, doSoftDrop, zCut, beta);
+}
 
-  for (auto n = 0; n < nMax + 1; n++) {
-    result.push_back(-1.0 * (n + 1));
-  }
+/**
+ * returns a vector with Nsubjettiness variables from the jet constituents already converted to fastjet pseudojet objects,
+ * e.g. with jetconstituentutilities::fillPseudoJets. See the overload with the jet for the other parameters.
+ *
+ * @param jetConstituents fastjet pseudojet objects of the jet constituents
+ * @param jetR jet radius
+ */
+template <typename M>
+std::vector<float> getNSubjettinessFromConstituents(std::vector<fastjet::PseudoJet>& jetConstituents, double jetR, int nMax, M const& reclusteringAlgorithm, bool doSoftDrop = false, float zCut = 0.1, float beta = 0.0)
+{
+  fastjet::PseudoJet pseudoJet;
+  fastjet::ClusterSequenceArea clusterSeq(constituentsToPseudoJet(jetConstituents, jetR, pseudoJet));
+  return getPseudoJetNSubjettiness(pseudoJet, jetR, nMax, reclusteringAlgorithm, doSoftDrop, zCut, beta);
+}
 
-  for (auto n = 1; n <= nMax; n++) {
-    if (pseudoJet.constituents().size() < n) { // Tau_N needs at least N tracks
-      return result;
-    }
-    fastjet::contrib::Nsubjettiness nSub(n, reclusteringAlgorithm, fastjet::contrib::NormalizedMeasure(1.0, jet.r() / 100.0));
-    result[n] = nSub.result(pseudoJet);
-    if (n == 2) {
-      std::vector<fastjet::PseudoJet> nSubAxes = nSub.currentAxes(); // gets the two axes used in the 2-subjettiness calculation
-      result[0] = nSubAxes[0].delta_R(nSubAxes[1]);                  // distance between axes for 2-subjettiness
+/**
+ * SoftDrop grooming of a jet from its primary C/A declustering splits, e.g. as stored in the splits tables, without reclustering the jet
+ *
+ * @param splitZ momentum fraction of the subleading prong of each split, from the first declustering on
+ * @param splitTheta opening angle of each split
+ * @param jetR jet radius
+ * @param zCut minimim momentum sharing fraction needed to satisfy the SoftDrop condition
+ * @param beta angular exponent in the SoftDrop condition
+ * @param nsd number of splits satisfying the SoftDrop condition
+ * @return position of the first split satisfying the SoftDrop condition, which gives zg and Rg, -1 if none
+ */
+template <typename T>
+int softDropFromSplits(T const& splitZ, T const& splitTheta, float jetR, float zCut, float beta, int& nsd)
+{
+  int groomedSplit = -1;
+  nsd = 0;
+  for (std::size_t iSplit = 0; iSplit < splitZ.size(); iSplit++) {
+    if (splitZ[iSplit] >= zCut * std::pow(splitTheta[iSplit] / jetR, beta)) {
+      if (groomedSplit < 0) {
+        groomedSplit = iSplit;
+      }
+      nsd++;
     }
   }
-  return result;
+  return groomedSplit;
 }
 
 }; // namespace jetsubstructureutilities
@@ -362,16 +362,41 @@ void orderForIPJetTracks(T const& collision, U const& jet, V const& /*jtracks*/,
 }
 
 /**
- * Checks if a jet is greater than the given tagging working point based on the signed impact parameter significances
+ * Geometric sign and impact parameter significance in plane XY of a jet track.
+ * They are computed once per jet and shared by all the orders of the track counting and jet probability taggers.
  */
-template <typename T, typename U, typename V, typename W, typename X, typename Y>
-bool isGreaterThanTaggingPoint(T const& collision, U const& jet, V const& jtracks, W const& tracks, X const& taggingPoint = 1.0, Y const& cnt = 1)
+struct JetTrackIP {
+  int geoSign = 0;
+  float impXYSig = 0.; // |d_xy| / sigma(d_xy)
+};
+
+/**
+ * Computes the geometric signs and impact parameter significances of the tracks of a jet, and their signed
+ * impact parameter significances in descending order.
+ */
+template <typename T, typename U, typename V, typename W>
+void fillJetTracksIP(T const& collision, U const& jet, V const& /*jtracks*/, W const& /*tracks*/, std::vector<JetTrackIP>& jetTracksIP, std::vector<float>& vecSignImpSig)
+{
+  jetTracksIP.clear();
+  vecSignImpSig.clear();
+  for (auto& jtrack : jet.template tracks_as<V>()) {
+    auto track = jtrack.template track_as<W>();
+    JetTrackIP& trackIP = jetTracksIP.emplace_back();
+    trackIP.geoSign = getGeoSign(collision, jet, track);
+    trackIP.impXYSig = TMath::Abs(track.dcaXY()) / TMath::Sqrt(track.sigmaDcaXY2());
+    vecSignImpSig.push_back(trackIP.geoSign * trackIP.impXYSig);
+  }
+  std::sort(vecSignImpSig.begin(), vecSignImpSig.end(), std::greater<float>());
+}
+
+/**
+ * Checks if a jet is greater than the given tagging working point based on its signed impact parameter significances in descending order
+ */
+inline bool isGreaterThanTaggingPoint(const std::vector<float>& vecSignImpSig, float taggingPoint, int cnt)
 {
   if (cnt == 0)
     return true; // untagged
-  std::vector<float> vecSignImpSig;
-  orderForIPJetTracks(collision, jet, jtracks, tracks, vecSignImpSig);
-  if (vecSignImpSig.size() > cnt - 1) {
+  if (vecSignImpSig.size() > static_cast<size_t>(cnt - 1)) {
     for (int i = 0; i < cnt; i++) {
       if (0 < vecSignImpSig[i] && vecSignImpSig[i] < taggingPoint) { // tagger point set
         return false;
@@ -383,6 +408,19 @@ bool isGreaterThanTaggingPoint(T const& collision, U const& jet, V const& jtrack
   return true;
 }
 
+/**
+ * Checks if a jet is greater than the given tagging working point based on the signed impact parameter significances
+ */
+template <typename T, typename U, typename V, typename W, typename X, typename Y>
+bool isGreaterThanTaggingPoint(T const& collision, U const& jet, V const& jtracks, W const& tracks, X const& taggingPoint = 1.0, Y const& cnt = 1)
+{
+  if (cnt == 0)
+    return true; // untagged
+  std::vector<float> vecSignImpSig;
+  orderForIPJetTracks(collision, jet, jtracks, tracks, vecSignImpSig);
+  return isGreaterThanTaggingPoint(vecSignImpSig, taggingPoint, cnt);
+}
+
 /**
  * Creates and sets the parameters of a resolution function (TF1) for constituents of jet based on signed impact parameter significnace in plane XY
  * This function is typically used to set up a resolution function for jet tagging purposes.
@@ -415,16 +453,19 @@ std::unique_ptr<TF1> setResolutionFunction(T const& vecParams)
  * @return The calculated probability of the track being associated with the jet, based on its
  *         impact parameter significance.
  */
+template <typename T>
+float getTrackProbability(T const& fResoFuncjet, float impXYSig, const float& minSignImpXYSig, double integralNorm)
+{
+  if (-impXYSig < minSignImpXYSig)
+    impXYSig = -minSignImpXYSig - 0.01; // To avoid overflow for integral
+  return fResoFuncjet->Integral(minSignImpXYSig, -impXYSig) / integralNorm;
+}
+
 template <typename T, typename U>
 float getTrackProbability(T const& fResoFuncjet, U const& track, const float& minSignImpXYSig = -40)
 {
-  float probTrack = 0;
   auto varSignImpXYSig = TMath::Abs(track.dcaXY()) / TMath::Sqrt(track.sigmaDcaXY2());
-  if (-varSignImpXYSig < minSignImpXYSig)
-    varSignImpXYSig = -minSignImpXYSig - 0.01; // To avoid overflow for integral
-  probTrack = fResoFuncjet->Integral(minSignImpXYSig, -varSignImpXYSig) / fResoFuncjet->Integral(minSignImpXYSig, 0);
-
-  return probTrack;
+  return getTrackProbability(fResoFuncjet, varSignImpXYSig, minSignImpXYSig, fResoFuncjet->Integral(minSignImpXYSig, 0));
 }
 
 /**
@@ -446,38 +487,39 @@ float getTrackProbability(T const& fResoFuncjet, U const& track, const float& mi
  *         specific flavor. Returns -1 if the jet contains fewer than two tracks with a positive
  *         geometric sign.
  */
-template <typename T, typename U, typename V, typename W, typename X>
-float getJetProbability(T const& fResoFuncjet, U const& collision, V const& jet, W const& jtracks, X const& tracks, const int& cnt, const float& tagPoint = 1.0, const float& minSignImpXYSig = -10)
+template <typename T>
+float getJetProbability(T const& fResoFuncjet, const std::vector<JetTrackIP>& jetTracksIP, const float& minSignImpXYSig = -10)
 {
-  if (!(isGreaterThanTaggingPoint(collision, jet, jtracks, tracks, tagPoint, cnt)))
-    return -1;
-
-  std::vector<float> jetTracksPt;
+  const double integralNorm = fResoFuncjet->Integral(minSignImpXYSig, 0); // same for all the tracks
   float trackjetProb = 1.;
-
-  for (auto& jtrack : jet.template tracks_as<W>()) {
-    auto track = jtrack.template track_as<X>();
-
-    float probTrack = getTrackProbability(fResoFuncjet, track, minSignImpXYSig);
-
-    auto geoSign = getGeoSign(collision, jet, track);
-    if (geoSign > 0) { // only take positive sign track for JP calculation
-      trackjetProb *= probTrack;
-      jetTracksPt.push_back(track.pt());
+  int nTracks = 0;
+  for (const auto& trackIP : jetTracksIP) {
+    if (trackIP.geoSign > 0) { // only take positive sign track for JP calculation
+      trackjetProb *= getTrackProbability(fResoFuncjet, trackIP.impXYSig, minSignImpXYSig, integralNorm);
+      nTracks++;
     }
   }
 
-  float JP = -1.;
-  if (jetTracksPt.size() < 2)
+  if (nTracks < 2)
     return -1;
 
   float sumjetProb = 0.;
-  for (int i = 0; i < jetTracksPt.size(); i++) {
+  for (int i = 0; i < nTracks; i++) {
     sumjetProb += (TMath::Power(-1 * TMath::Log(trackjetProb), i) / TMath::Factorial(i));
   }
 
-  JP = trackjetProb * sumjetProb;
-  return JP;
+  return trackjetProb * sumjetProb;
+}
+
+template <typename T, typename U, typename V, typename W, typename X>
+float getJetProbability(T const& fResoFuncjet, U const& collision, V const& jet, W const& jtracks, X const& tracks, const int& cnt, const float& tagPoint = 1.0, const float& minSignImpXYSig = -10)
+{
+  std::vector<JetTrackIP> jetTracksIP;
+  std::vector<float> vecSignImpSig;
+  fillJetTracksIP(collision, jet, jtracks, tracks, jetTracksIP, vecSignImpSig);
+  if (!(isGreaterThanTaggingPoint(vecSignImpSig, tagPoint, cnt)))
+    return -1;
+  return getJetProbability(fResoFuncjet, jetTracksIP, minSignImpXYSig);
 }
 
 }; // namespace jettaggingutilities
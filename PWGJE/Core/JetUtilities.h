@@ -24,10 +24,9 @@
 #include <tuple>
 #include <vector>
 
-#include <TKDTree.h>
-
 #include "Framework/Logger.h"
 #include "Common/Core/RecoDecay.h"
+#include "PWGJE/Core/EtaPhiGrid.h"
 
 namespace jetutilities
 {
@@ -45,6 +44,8 @@ namespace jetutilities
  * @param trackEta track collection eta.
  * @param maxMatchingDistance Maximum matching distance.
  * @param maxNumberMatches Maximum number of matches (e.g. 5 closest).
+ * @param gridCluster Grid for the clusters, reused between calls.
+ * @param gridTrack Grid for the tracks, reused between calls.
  *
  * @returns (cluster to track index map, track to cluster index map)
  */
@@ -55,9 +56,10 @@ std::tuple<std::vector<std::vector<int>>, std::vector<std::vector<int>>> MatchCl
   std::vector<T>& trackPhi,
   std::vector<T>& trackEta,
   double maxMatchingDistance,
-  int maxNumberMatches)
+  int maxNumberMatches,
+  EtaPhiGrid<T>& gridCluster,
+  EtaPhiGrid<T>& gridTrack)
 {
-  // test
   // Validation
   const std::size_t nClusters = clusterEta.size();
   const std::size_t nTracks = trackEta.size();
@@ -73,71 +75,49 @@ std::tuple<std::vector<std::vector<int>>, std::vector<std::vector<int>>> MatchCl
     throw std::invalid_argument("track collection eta and phi sizes don't match. Check the inputs.");
   }
 
-  // for (std::size_t iTrack = 0; iTrack < nTracks; iTrack++) {
-  //   if (trackEta[iTrack] == 0)
-  //     LOG(warning) << "Track eta is 0!";
-  // }
-
-  // Build the KD-trees using vectors
-  // We build two trees:
-  // treeBase, which contains the base collection.
-  // treeTag, which contains the tag collection.
-  // The trees are built to match in two dimensions (eta, phi)
-  TKDTree<int, T> treeCluster(clusterEta.size(), 2, 1), treeTrack(trackEta.size(), 2, 1);
-  // By utilizing SetData, we can avoid having to copy the data again.
-  treeCluster.SetData(0, clusterEta.data());
-  treeCluster.SetData(1, clusterPhi.data());
-  treeCluster.Build();
-  treeTrack.SetData(0, trackEta.data());
-  treeTrack.SetData(1, trackPhi.data());
-  treeTrack.Build();
+  // Fill the eta-phi grids
+  // We build two grids:
+  // gridCluster, which contains the clusters.
+  // gridTrack, which contains the tracks.
+  // The grids keep their storage between calls, so that no allocation is needed for every collision
+  gridCluster.build(clusterEta, clusterPhi, maxMatchingDistance);
+  gridTrack.build(trackEta, trackPhi, maxMatchingDistance);
 
   // Storage for the cluster matching indices.
   std::vector<std::vector<int>> matchIndexTrack(nClusters, std::vector<int>(maxNumberMatches, -1));
   std::vector<std::vector<int>> matchIndexCluster(nTracks, std::vector<int>(maxNumberMatches, -1));
+  std::vector<double> distance(maxNumberMatches);
 
-  // Find the track closest to each cluster.
+  // Find the tracks closest to each cluster, no match or no more matches found are filled with -1
   for (std::size_t iCluster = 0; iCluster < nClusters; iCluster++) {
-    T point[2] = {clusterEta[iCluster], clusterPhi[iCluster]};
-    int index[50];  // size 50 for safety
-    T distance[50]; // size 50 for safery
-    std::fill_n(index, 50, -1);
-    std::fill_n(distance, 50, std::numeric_limits<T>::max());
-    treeTrack.FindNearestNeighbors(point, maxNumberMatches, index, distance);
-    // test whether indices are matching:
-    matchIndexTrack[iCluster] = std::vector<int>(maxNumberMatches);
-    for (int m = 0; m < maxNumberMatches; m++) {
-      if (index[m] >= 0 && distance[m] < maxMatchingDistance) {
-        matchIndexTrack[iCluster][m] = index[m];
-      } else {
-        // no match or no more matches found, fill -1
-        matchIndexTrack[iCluster][m] = -1;
-      }
-    }
+    gridTrack.findNearest(clusterEta[iCluster], clusterPhi[iCluster], maxNumberMatches, matchIndexTrack[iCluster].data(), distance.data());
   }
 
-  // Find the base jet closest to each tag jet
+  // Find the clusters closest to each track
   for (std::size_t iTrack = 0; iTrack < nTracks; iTrack++) {
-    T point[2] = {trackEta[iTrack], trackPhi[iTrack]};
-    int index[50];  // size 50 for safety
-    T distance[50]; // size 50 for safery
-    std::fill_n(index, 50, -1);
-    std::fill_n(distance, 50, std::numeric_limits<T>::max());
-    treeCluster.FindNearestNeighbors(point, maxNumberMatches, index, distance);
-    matchIndexCluster[iTrack] = std::vector<int>(maxNumberMatches);
-    // loop over maxNumberMatches closest matches
-    for (int m = 0; m < maxNumberMatches; m++) {
-      if (index[m] >= 0 && distance[m] < maxMatchingDistance) {
-        matchIndexCluster[iTrack][m] = index[m];
-      } else {
-        // no match jet or no more matches found, fill -1
-        matchIndexCluster[iTrack][m] = -1;
-      }
-    }
+    gridCluster.findNearest(trackEta[iTrack], trackPhi[iTrack], maxNumberMatches, matchIndexCluster[iTrack].data(), distance.data());
   }
   return std::make_tuple(matchIndexTrack, matchIndexCluster);
 }
 
+/**
+ * Match clusters and tracks, with grids kept by the calling thread.
+ * See the overload with the grids for the parameters.
+ */
+template <typename T>
+std::tuple<std::vector<std::vector<int>>, std::vector<std::vector<int>>> MatchClustersAndTracks(
+  std::vector<T>& clusterPhi,
+  std::vector<T>& clusterEta,
+  std::vector<T>& trackPhi,
+  std::vector<T>& trackEta,
+  double maxMatchingDistance,
+  int maxNumberMatches)
+{
+  static thread_local EtaPhiGrid<T> gridCluster;
+  static thread_local EtaPhiGrid<T> gridTrack;
+  return MatchClustersAndTracks(clusterPhi, clusterEta, trackPhi, trackEta, maxMatchingDistance, maxNumberMatches, gridCluster, gridTrack);
+}
+
 template <typename T, typename U>
 float deltaR(T const& A, U const& B)
 {
@@ -45,6 +45,10 @@ DECLARE_SOA_COLUMN(Theta, theta, std::vector<float>);               //!
 DECLARE_SOA_COLUMN(NSub2DR, nSub2DR, float);                        //!
 DECLARE_SOA_COLUMN(NSub1, nSub1, float);                            //!
 DECLARE_SOA_COLUMN(NSub2, nSub2, float);                            //!
+DECLARE_SOA_COLUMN(SplitZ, splitZ, std::vector<float>);             //! momentum fraction of the subleading prong of each primary C/A split
+DECLARE_SOA_COLUMN(SplitTheta, splitTheta, std::vector<float>);     //! opening angle of each primary C/A split
+DECLARE_SOA_COLUMN(SplitKt, splitKt, std::vector<float>);           //! relative transverse momentum of each primary C/A split
+DECLARE_SOA_COLUMN(SplitMass, splitMass, std::vector<float>);       //! mass of the mother of each primary C/A split
 } // namespace jetsubstructure
 
 namespace jetoutput
@@ -84,6 +88,7 @@ DECLARE_SOA_COLUMN(JetNConstituents, jetNConstituents, int); //!
                                                                                                                                                                                                                                                                                                         \
   DECLARE_SOA_TABLE(_jet_type_##SSs, "AOD", _description_ "SS", jetsubstructure::EnergyMother, jetsubstructure::PtLeading, jetsubstructure::PtSubLeading, jetsubstructure::Theta, jetsubstructure::NSub2DR, jetsubstructure::NSub1, jetsubstructure::NSub2, _name_##substructure::Dummy##_jet_type_<>); \
   DECLARE_SOA_TABLE(_jet_type_##SSOs, "AOD", _description_ "SSO", _name_##substructure::_jet_type_##OId, jetsubstructure::EnergyMother, jetsubstructure::PtLeading, jetsubstructure::PtSubLeading, jetsubstructure::Theta, jetsubstructure::NSub2DR, jetsubstructure::NSub1, jetsubstructure::NSub2);   \
+  DECLARE_SOA_TABLE(_jet_type_##SPs, "AOD", _description_ "SP", jetsubstructure::SplitZ, jetsubstructure::SplitTheta, jetsubstructure::SplitKt, jetsubstructure::SplitMass, _name_##substructure::Dummy##_jet_type_<>);                                                                                 \
                                                                                                                                                                                                                                                                                                         \
   using _jet_type_##O = _jet_type_##Os::iterator;                                                                                                                                                                                                                                                       \
   using _jet_type_##SSO = _jet_type_##SSOs::iterator;
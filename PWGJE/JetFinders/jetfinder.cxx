@@ -75,6 +75,13 @@ struct JetFinderTask {
   Configurable<float> jetAreaFractionMin{"jetAreaFractionMin", -99.0, "used to make a cut on the jet areas"};
   Configurable<int> jetPtBinWidth{"jetPtBinWidth", 5, "used to define the width of the jetPt bins for the THnSparse"};
   Configurable<bool> fillTHnSparse{"fillTHnSparse", false, "switch to fill the THnSparse"};
+  Configurable<int> jetStrategy{"jetStrategy", 1, "fastjet clustering strategy, 1 = Best. Falls back to Best if not valid for the algorithm"};
+  Configurable<bool> reuseGhostsAcrossRadii{"reuseGhostsAcrossRadii", false, "generate the ghosts once per event and share them across the jet radii"};
+  Configurable<int> nThreadsAcrossRadii{"nThreadsAcrossRadii", 1, "number of threads clustering the jet radii in parallel, with reuseGhostsAcrossRadii"};
+  Configurable<bool> computeArea{"computeArea", true, "compute the areas of the data and detector level jets, set to false to cluster without ghosts"};
+  Configurable<bool> computeAreaMCP{"computeAreaMCP", true, "compute the areas of the particle level jets, set to false to cluster without ghosts"};
+  Configurable<bool> cacheGhosts{"cacheGhosts", false, "generate the ghosts once and reuse them for all the events"};
+  Configurable<int> ghostSeed{"ghostSeed", 0, "seed of the ghost generation, 0 to use the default random status"};
 
   Service<o2::framework::O2DatabasePDG> pdgDatabase;
   int trackSelection = -1;
@@ -82,6 +89,7 @@ struct JetFinderTask {
   std::string particleSelection;
 
   JetFinder jetFinder;
+  JetFinder jetFinderMCP; // same as jetFinder, apart from the area computation
   std::vector<fastjet::PseudoJet> inputParticles;
 
   void init(InitContext const&)
@@ -101,9 +109,23 @@ struct JetFinderTask {
     jetFinder.recombScheme = static_cast<fastjet::RecombinationScheme>(static_cast<int>(jetRecombScheme));
     jetFinder.ghostArea = jetGhostArea;
     jetFinder.ghostRepeatN = ghostRepeat;
+    jetFinder.strategy = static_cast<fastjet::Strategy>(static_cast<int>(jetStrategy));
+    if (!jetFinder.isStrategyValid()) {
+      LOG(warning) << "Clustering strategy " << jetStrategy << " not valid for jet algorithm " << jetAlgorithm << ", using Best";
+      jetFinder.strategy = fastjet::Best;
+    }
+    jetFinder.reuseGhostsAcrossRadii = reuseGhostsAcrossRadii;
+    jetFinder.nThreadsAcrossRadii = nThreadsAcrossRadii;
+    jetFinder.computeArea = computeArea;
+    jetFinder.cacheGhosts = cacheGhosts;
+    if (ghostSeed != 0) {
+      jetFinder.ghostSeeds = {ghostSeed, ghostSeed + 1};
+    }
     if (DoTriggering) {
       jetFinder.isTriggering = true;
     }
+    jetFinderMCP = jetFinder;
+    jetFinderMCP.computeArea = computeAreaMCP;
 
     auto jetRadiiBins = (std::vector<double>)jetRadius;
     if (jetRadiiBins.size() > 1) {
@@ -190,7 +212,7 @@ struct JetFinderTask {
     // TODO: MC event selection?
     inputParticles.clear();
     jetfindingutilities::analyseParticles<soa::Filtered<JetParticles>, soa::Filtered<JetParticles>::iterator>(inputParticles, particleSelection, 1, particles, pdgDatabase);
-    jetfindingutilities::findJets(jetFinder, inputParticles, jetPtMin, jetPtMax, jetRadius, jetAreaFractionMin, collision, jetsTable, constituentsTable, registry.get<THn>(HIST("hJetMCP")), fillTHnSparse);
+    jetfindingutilities::findJets(jetFinderMCP, inputParticles, jetPtMin, jetPtMax, jetRadius, jetAreaFractionMin, collision, jetsTable, constituentsTable, registry.get<THn>(HIST("hJetMCP")), fillTHnSparse);
   }
   PROCESS_SWITCH(JetFinderTask, processParticleLevelChargedJets, "Particle level charged jet finding", false);
 
@@ -199,7 +221,7 @@ struct JetFinderTask {
     // TODO: MC event selection?
     inputParticles.clear();
     jetfindingutilities::analyseParticles<soa::Filtered<JetParticles>, soa::Filtered<JetParticles>::iterator>(inputParticles, particleSelection, 2, particles, pdgDatabase);
-    jetfindingutilities::findJets(jetFinder, inputParticles, jetPtMin, jetPtMax, jetRadius, jetAreaFractionMin, collision, jetsTable, constituentsTable, registry.get<THn>(HIST("hJetMCP")), fillTHnSparse);
+    jetfindingutilities::findJets(jetFinderMCP, inputParticles, jetPtMin, jetPtMax, jetRadius, jetAreaFractionMin, collision, jetsTable, constituentsTable, registry.get<THn>(HIST("hJetMCP")), fillTHnSparse);
   }
   PROCESS_SWITCH(JetFinderTask, processParticleLevelNeutralJets, "Particle level neutral jet finding", false);
 
@@ -208,7 +230,7 @@ struct JetFinderTask {
     // TODO: MC event selection?
     inputParticles.clear();
     jetfindingutilities::analyseParticles<soa::Filtered<JetParticles>, soa::Filtered<JetParticles>::iterator>(inputParticles, particleSelection, 0, particles, pdgDatabase);
-    jetfindingutilities::findJets(jetFinder, inputParticles, jetPtMin, jetPtMax, jetRadius, jetAreaFractionMin, collision, jetsTable, constituentsTable, registry.get<THn>(HIST("hJetMCP")), fillTHnSparse);
+    jetfindingutilities::findJets(jetFinderMCP, inputParticles, jetPtMin, jetPtMax, jetRadius, jetAreaFractionMin, collision, jetsTable, constituentsTable, registry.get<THn>(HIST("hJetMCP")), fillTHnSparse);
   }
 
   PROCESS_SWITCH(JetFinderTask, processParticleLevelFullJets, "Particle level full jet finding", false);
@@ -18,6 +18,8 @@
 #include <iostream>
 #include <memory>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 #include <cmath>
 
 #include "CCDB/BasicCCDBManager.h"
@@ -101,9 +103,21 @@ struct EmcalCorrectionTask {
   std::vector<std::unique_ptr<o2::emcal::Clusterizer<o2::emcal::Cell>>> mClusterizers;
   o2::emcal::ClusterFactory<o2::emcal::Cell> mClusterFactories;
   o2::emcal::NonlinearityHandler mNonlinearityHandler;
-  // Cells and clusters
+  // Cells and clusters, kept between BCs to avoid reallocations
+  std::vector<o2::emcal::Cell> mCellsBC;
+  std::vector<int64_t> mCellIndicesBC;
+  std::vector<o2::emcal::CellLabel> mCellLabelsBC;
+  std::vector<float> mCellAmplitudesBC; // amplitudes of the cells of the BC, corrected in one pass before the clusterization
+  std::vector<float> mCellAbsScale;     // absolute energy scale per cell ID, filled once in init
   std::vector<o2::emcal::AnalysisCluster> mAnalysisClusters;
   std::vector<o2::emcal::ClusterLabel> mClusterLabels;
+  // Kinematics of the clusters of the current clusterizer, computed once for the matching and the tables
+  std::vector<double> mClusterEta;
+  std::vector<double> mClusterPhi;
+  std::vector<float> mClusterEnergyNonLin;
+  // Grids for the cluster-track matching, kept to avoid reallocations for every collision
+  jetutilities::EtaPhiGrid<double> mClusterGrid;
+  jetutilities::EtaPhiGrid<double> mTrackGrid;
 
   std::vector<o2::aod::EMCALClusterDefinition> mClusterDefinitions;
   // QA
@@ -165,6 +179,14 @@ struct EmcalCorrectionTask {
       LOG(error) << "No cluster definitions specified!";
     }
 
+    if (applyCellAbsScale && !mClusterizers.empty()) {
+      // the scale only depends on the cell ID, so it is tabulated once instead of for every cell
+      mCellAbsScale.resize(geometry->GetNCells());
+      for (int cellID = 0; cellID < geometry->GetNCells(); cellID++) {
+        mCellAbsScale[cellID] = GetAbsCellScale(cellID);
+      }
+    }
+
     mNonlinearityHandler = o2::emcal::NonlinearityFactory::getInstance().getNonlinearity(static_cast<std::string>(nonlinearityFunction));
     LOG(info) << "Using nonlinearity parameterisation: " << nonlinearityFunction.value;
     LOG(info) << "Apply shaper saturation correction:  " << (hasShaperCorrection.value ? "yes" : "no");
@@ -246,22 +268,9 @@ struct EmcalCorrectionTask {
       }
       // Counters for BCs with matched collisions
       countBC(collisionsInFoundBC.size(), true);
-      std::vector<o2::emcal::Cell> cellsBC;
-      std::vector<int64_t> cellIndicesBC;
-      for (auto& cell : cellsInBC) {
-        auto amplitude = cell.amplitude();
-        if (static_cast<bool>(hasShaperCorrection)) {
-          amplitude = o2::emcal::NonlinearityHandler::evaluateShaperCorrectionCellEnergy(amplitude);
-        }
-        if (applyCellAbsScale) {
-          amplitude *= GetAbsCellScale(cell.cellNumber());
-        }
-        cellsBC.emplace_back(cell.cellNumber(),
-                             amplitude,
-                             cell.time(),
-                             o2::emcal::intToChannelType(cell.cellType()));
-        cellIndicesBC.emplace_back(cell.globalIndex());
-      }
+      fillCellBuffers(cellsInBC, hasShaperCorrection, applyCellAbsScale);
+      auto& cellsBC = mCellsBC;
+      auto& cellIndicesBC = mCellIndicesBC;
       LOG(detail) << "Number of cells for BC (CF): " << cellsBC.size();
       nCellsProcessed += cellsBC.size();
 
@@ -361,26 +370,19 @@ struct EmcalCorrectionTask {
       }
       // Counters for BCs with matched collisions
       countBC(collisionsInFoundBC.size(), true);
-      std::vector<o2::emcal::Cell> cellsBC;
-      std::vector<int64_t> cellIndicesBC;
-      std::vector<o2::emcal::CellLabel> cellLabels;
+      mCellLabelsBC.clear();
       for (auto& cell : cellsInBC) {
-        mHistManager.fill(HIST("hContributors"), cell.mcParticle_as<aod::StoredMcParticles_001>().size());
         auto cellParticles = cell.mcParticle_as<aod::StoredMcParticles_001>();
+        mHistManager.fill(HIST("hContributors"), cellParticles.size());
         for (auto& cellparticle : cellParticles) {
           mHistManager.fill(HIST("hMCParticleEnergy"), cellparticle.e());
         }
-        auto amplitude = cell.amplitude();
-        if (static_cast<bool>(hasShaperCorrection)) {
-          amplitude = o2::emcal::NonlinearityHandler::evaluateShaperCorrectionCellEnergy(amplitude);
-        }
-        cellsBC.emplace_back(cell.cellNumber(),
-                             amplitude,
-                             cell.time(),
-                             o2::emcal::intToChannelType(cell.cellType()));
-        cellIndicesBC.emplace_back(cell.globalIndex());
-        cellLabels.emplace_back(cell.mcParticleIds(), cell.amplitudeA());
+        mCellLabelsBC.emplace_back(cell.mcParticleIds(), cell.amplitudeA());
       }
+      fillCellBuffers(cellsInBC, hasShaperCorrection, false);
+      auto& cellsBC = mCellsBC;
+      auto& cellIndicesBC = mCellIndicesBC;
+      auto& cellLabels = mCellLabelsBC;
       LOG(detail) << "Number of cells for BC (CF): " << cellsBC.size();
       nCellsProcessed += cellsBC.size();
 
@@ -473,15 +475,9 @@ struct EmcalCorrectionTask {
       }
       // Counters for BCs with matched collisions
       countBC(collisionsInBC.size(), true);
-      std::vector<o2::emcal::Cell> cellsBC;
-      std::vector<int64_t> cellIndicesBC;
-      for (auto& cell : cellsInBC) {
-        cellsBC.emplace_back(cell.cellNumber(),
-                             cell.amplitude(),
-                             cell.time(),
-                             o2::emcal::intToChannelType(cell.cellType()));
-        cellIndicesBC.emplace_back(cell.globalIndex());
-      }
+      fillCellBuffers(cellsInBC, false, false);
+      auto& cellsBC = mCellsBC;
+      auto& cellIndicesBC = mCellIndicesBC;
       LOG(detail) << "Number of cells for BC (CF): " << cellsBC.size();
       nCellsProcessed += cellsBC.size();
 
@@ -534,6 +530,64 @@ struct EmcalCorrectionTask {
   }
   PROCESS_SWITCH(EmcalCorrectionTask, processStandalone, "run stand alone analysis", false);
 
+  /// Fills the cell buffers of the BC, the amplitudes are corrected in one pass over a contiguous array before the cells are built
+  template <typename Cells>
+  void fillCellBuffers(Cells const& cellsInBC, bool applyShaperCorrection, bool applyAbsScale)
+  {
+    mCellAmplitudesBC.clear();
+    mCellIndicesBC.clear();
+    for (auto& cell : cellsInBC) {
+      mCellAmplitudesBC.push_back(cell.amplitude());
+      mCellIndicesBC.push_back(cell.globalIndex());
+    }
+    if (applyShaperCorrection) {
+      for (auto& amplitude : mCellAmplitudesBC) {
+        amplitude = o2::emcal::NonlinearityHandler::evaluateShaperCorrectionCellEnergy(amplitude);
+      }
+    }
+    mCellsBC.clear();
+    size_t iCell = 0;
+    for (auto& cell : cellsInBC) {
+      float amplitude = mCellAmplitudesBC[iCell++];
+      if (applyAbsScale) {
+        amplitude *= static_cast<size_t>(cell.cellNumber()) < mCellAbsScale.size() ? mCellAbsScale[cell.cellNumber()] : GetAbsCellScale(cell.cellNumber());
+      }
+      mCellsBC.emplace_back(cell.cellNumber(),
+                            amplitude,
+                            cell.time(),
+                            o2::emcal::intToChannelType(cell.cellType()));
+    }
+  }
+
+  /// Computes the eta, phi and non-linearity corrected energy of the clusters of the current clusterizer
+  void computeClusterKinematics(math_utils::Point3D<float> const& vertex_pos, bool applyNonLin)
+  {
+    mClusterEta.clear();
+    mClusterPhi.clear();
+    mClusterEnergyNonLin.clear();
+    for (const auto& cluster : mAnalysisClusters) {
+      // Determine the cluster eta, phi, correcting for the vertex position.
+      auto pos = cluster.getGlobalPosition();
+      pos = pos - vertex_pos;
+      // Normalize the vector and rescale by energy.
+      pos *= (cluster.E() / std::sqrt(pos.Mag2()));
+      mClusterEta.push_back(pos.Eta());
+      mClusterPhi.push_back(TVector2::Phi_0_2pi(pos.Phi()));
+    }
+    // Correct for nonlinear behaviour
+    for (const auto& cluster : mAnalysisClusters) {
+      float nonlinCorrEnergy = cluster.E();
+      if (applyNonLin) {
+        try {
+          nonlinCorrEnergy = mNonlinearityHandler.getCorrectedClusterEnergy(cluster);
+        } catch (o2::emcal::NonlinearityHandler::UninitException& e) {
+          LOG(error) << e.what();
+        }
+      }
+      mClusterEnergyNonLin.push_back(nonlinCorrEnergy);
+    }
+  }
+
   void cellsToCluster(size_t iClusterizer, const gsl::span<o2::emcal::Cell> cellsBC, std::optional<const gsl::span<o2::emcal::CellLabel>> cellLabels = std::nullopt)
   {
     mClusterizers.at(iClusterizer)->findClusters(cellsBC);
@@ -547,6 +601,8 @@ struct EmcalCorrectionTask {
     // to build the clusters.
     mAnalysisClusters.clear();
     mClusterLabels.clear();
+    mAnalysisClusters.reserve(emcalClusters->size());
+    mClusterLabels.reserve(emcalClusters->size());
     mClusterFactories.reset();
     if (cellLabels) {
       mClusterFactories.setContainer(*emcalClusters, cellsBC, *emcalClustersInputIndices, cellLabels);
@@ -558,9 +614,8 @@ struct EmcalCorrectionTask {
     // Convert to analysis clusters.
     for (int icl = 0; icl < mClusterFactories.getNumberOfClusters(); icl++) {
       o2::emcal::ClusterLabel clusterLabel;
-      auto analysisCluster = mClusterFactories.buildCluster(icl, &clusterLabel);
-      mAnalysisClusters.emplace_back(analysisCluster);
-      mClusterLabels.push_back(clusterLabel);
+      const auto& analysisCluster = mAnalysisClusters.emplace_back(mClusterFactories.buildCluster(icl, &clusterLabel));
+      mClusterLabels.push_back(std::move(clusterLabel));
       LOG(debug) << "Cluster " << icl << ": E: " << analysisCluster.E()
                  << ", NCells " << analysisCluster.getNCells();
     }
@@ -571,6 +626,10 @@ struct EmcalCorrectionTask {
   void FillClusterTable(Collision const& col, math_utils::Point3D<float> const& vertex_pos, size_t iClusterizer, const gsl::span<int64_t> cellIndicesBC, std::optional<std::tuple<std::vector<std::vector<int>>, std::vector<std::vector<int>>>> const& IndexMapPair = std::nullopt, std::optional<std::vector<int64_t>> const& trackGlobalIndex = std::nullopt)
   {
     // we found a collision, put the clusters into the none ambiguous table
+    // the kinematics were already computed for the matching if there was one
+    if (!IndexMapPair) {
+      computeClusterKinematics(vertex_pos, !disableNonLin);
+    }
     clusters.reserve(mAnalysisClusters.size());
     if (mClusterLabels.size() > 0) {
       mcclusters.reserve(mClusterLabels.size());
@@ -578,21 +637,9 @@ struct EmcalCorrectionTask {
     int cellindex = -1;
     unsigned int iCluster = 0;
     for (const auto& cluster : mAnalysisClusters) {
-      // Determine the cluster eta, phi, correcting for the vertex position.
-      auto pos = cluster.getGlobalPosition();
-      pos = pos - vertex_pos;
-      // Normalize the vector and rescale by energy.
-      pos *= (cluster.E() / std::sqrt(pos.Mag2()));
-
-      // Correct for nonlinear behaviour
-      float nonlinCorrEnergy = cluster.E();
-      if (!disableNonLin) {
-        try {
-          nonlinCorrEnergy = mNonlinearityHandler.getCorrectedClusterEnergy(cluster);
-        } catch (o2::emcal::NonlinearityHandler::UninitException& e) {
-          LOG(error) << e.what();
-        }
-      }
+      const double clusterEta = mClusterEta[iCluster];
+      const double clusterPhi = mClusterPhi[iCluster];
+      const float nonlinCorrEnergy = mClusterEnergyNonLin[iCluster];
 
       // save to table
       LOG(debug) << "Writing cluster definition "
@@ -600,7 +647,7 @@ struct EmcalCorrectionTask {
                  << " to table.";
       mHistManager.fill(HIST("hClusterType"), 1);
       clusters(col, cluster.getID(), nonlinCorrEnergy, cluster.getCoreEnergy(), cluster.E(),
-               pos.Eta(), TVector2::Phi_0_2pi(pos.Phi()), cluster.getM02(),
+               clusterEta, clusterPhi, cluster.getM02(),
                cluster.getM20(), cluster.getNCells(),
                cluster.getClusterTime(), cluster.getIsExotic(),
                cluster.getDistanceToBadChannel(), cluster.getNExMax(),
@@ -617,7 +664,7 @@ struct EmcalCorrectionTask {
       } // end of cells of cluser loop
       // fill histograms
       mHistManager.fill(HIST("hClusterE"), cluster.E());
-      mHistManager.fill(HIST("hClusterEtaPhi"), pos.Eta(), TVector2::Phi_0_2pi(pos.Phi()));
+      mHistManager.fill(HIST("hClusterEtaPhi"), clusterEta, clusterPhi);
       if (IndexMapPair && trackGlobalIndex) {
         for (unsigned int iTrack = 0; iTrack < std::get<0>(*IndexMapPair)[iCluster].size(); iTrack++) {
           if (std::get<0>(*IndexMapPair)[iCluster][iTrack] >= 0) {
@@ -634,20 +681,11 @@ struct EmcalCorrectionTask {
   void FillAmbigousClusterTable(BC const& bc, size_t iClusterizer, const gsl::span<int64_t> cellIndicesBC, bool hasCollision)
   {
     int cellindex = -1;
+    computeClusterKinematics(math_utils::Point3D<float>{0., 0., 0.}, true);
     clustersAmbiguous.reserve(mAnalysisClusters.size());
+    unsigned int iCluster = 0;
     for (const auto& cluster : mAnalysisClusters) {
-      auto pos = cluster.getGlobalPosition();
-      pos = pos - math_utils::Point3D<float>{0., 0., 0.};
-      // Normalize the vector and rescale by energy.
-      pos *= (cluster.E() / std::sqrt(pos.Mag2()));
-
-      // Correct for nonlinear behaviour
-      float nonlinCorrEnergy = cluster.E();
-      try {
-        nonlinCorrEnergy = mNonlinearityHandler.getCorrectedClusterEnergy(cluster);
-      } catch (o2::emcal::NonlinearityHandler::UninitException& e) {
-        LOG(error) << e.what();
-      }
+      const float nonlinCorrEnergy = mClusterEnergyNonLin[iCluster];
 
       // We have our necessary properties. Now we store outputs
 
@@ -659,7 +697,7 @@ struct EmcalCorrectionTask {
       }
       clustersAmbiguous(
         bc, cluster.getID(), nonlinCorrEnergy, cluster.getCoreEnergy(), cluster.E(),
-        pos.Eta(), TVector2::Phi_0_2pi(pos.Phi()), cluster.getM02(),
+        mClusterEta[iCluster], mClusterPhi[iCluster], cluster.getM02(),
         cluster.getM20(), cluster.getNCells(), cluster.getClusterTime(),
         cluster.getIsExotic(), cluster.getDistanceToBadChannel(),
         cluster.getNExMax(), static_cast<int>(mClusterDefinitions.at(iClusterizer)));
@@ -669,7 +707,8 @@ struct EmcalCorrectionTask {
         clustercellsambiguous(clustersAmbiguous.lastIndex(),
                               cellIndicesBC[cellindex]);
       } // end of cells of cluster loop
-    }   // end of cluster loop
+      iCluster++;
+    } // end of cluster loop
   }
 
   template <typename Collision>
@@ -685,28 +724,13 @@ struct EmcalCorrectionTask {
     trackGlobalIndex.reserve(NTracksInCol);
     FillTrackInfo<decltype(groupedTracks)>(groupedTracks, trackPhi, trackEta, trackGlobalIndex);
 
-    int NClusterInCol = mAnalysisClusters.size();
-    std::vector<double> clusterPhi;
-    std::vector<double> clusterEta;
-    clusterPhi.reserve(NClusterInCol);
-    clusterEta.reserve(NClusterInCol);
-
-    // TODO one loop that could in principle be combined with the other
-    // loop to improve performance
-    for (const auto& cluster : mAnalysisClusters) {
-      // Determine the cluster eta, phi, correcting for the vertex
-      // position.
-      auto pos = cluster.getGlobalPosition();
-      pos = pos - vertex_pos;
-      // Normalize the vector and rescale by energy.
-      pos *= (cluster.E() / std::sqrt(pos.Mag2()));
-      clusterPhi.emplace_back(TVector2::Phi_0_2pi(pos.Phi()));
-      clusterEta.emplace_back(pos.Eta());
-    }
+    // the cluster kinematics are kept for FillClusterTable
+    computeClusterKinematics(vertex_pos, !disableNonLin);
     IndexMapPair =
-      jetutilities::MatchClustersAndTracks(clusterPhi, clusterEta,
+      jetutilities::MatchClustersAndTracks(mClusterPhi, mClusterEta,
                                            trackPhi, trackEta,
-                                           maxMatchingDistance, 20);
+                                           maxMatchingDistance, 20,
+                                           mClusterGrid, mTrackGrid);
   }
 
   template <typename Tracks>
@@ -106,8 +106,9 @@ struct EmcalMatchedTracksTask {
   {
     mHistManager.fill(HIST("eventsAll"), 1);
 
+    const auto bc = theCollision.bc_as<myBCs>();
     o2::InteractionRecord eventIR;
-    eventIR.setFromLong(theCollision.bc_as<myBCs>().globalBC());
+    eventIR.setFromLong(bc.globalBC());
 
     // do event selection if mDoEventSel is specified
     // currently the event selection is hard coded to kINT7
@@ -146,18 +147,23 @@ struct EmcalMatchedTracksTask {
       // skip clusters with no matched tracks!
       if (tracksofcluster.size() == 0) {
         continue;
-      } else if (tracksofcluster.size() == 1) {
-        if (fabs(tracksofcluster.iteratorAt(0).track_as<myTracksPID>().trackEtaEmcal() - cluster.eta()) >= minDEta || fabs(tracksofcluster.iteratorAt(0).track_as<myTracksPID>().trackPhiEmcal() - cluster.phi()) >= minDPhi) {
+      }
+      // the matched tracks are accessed once, not once per column
+      const auto track0 = tracksofcluster.iteratorAt(0).track_as<myTracksPID>();
+      const float dEta0 = track0.trackEtaEmcal() - cluster.eta();
+      const float dPhi0 = track0.trackPhiEmcal() - cluster.phi();
+      if (tracksofcluster.size() == 1) {
+        if (fabs(dEta0) >= minDEta || fabs(dPhi0) >= minDPhi) {
           continue;
         }
-        clustersmatchedtracks(eventIR.orbit, theCollision.bc_as<myBCs>().timestamp(), theCollision.bc_as<myBCs>().runNumber(),
-                              tracksofcluster.iteratorAt(0).track_as<myTracksPID>().x(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().alpha(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().p(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().signed1Pt(),
-                              tracksofcluster.iteratorAt(0).track_as<myTracksPID>().y(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().z(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().snp(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().tgl(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().pt(),
-                              tracksofcluster.iteratorAt(0).track_as<myTracksPID>().sigmaY(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().sigmaZ(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().sigmaSnp(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().sigmaTgl(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().sigma1Pt(),
-                              tracksofcluster.iteratorAt(0).track_as<myTracksPID>().eta(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().phi(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().trackEtaEmcal(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().trackPhiEmcal(),
-                              tracksofcluster.iteratorAt(0).track_as<myTracksPID>().trackEtaEmcal() - cluster.eta(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().trackPhiEmcal() - cluster.phi(),
-                              tracksofcluster.iteratorAt(0).track_as<myTracksPID>().itsNCls(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().tofExpMom(),
-                              tracksofcluster.iteratorAt(0).track_as<myTracksPID>().tpcNSigmaEl(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().tpcNSigmaPi(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().tofNSigmaEl(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().tofNSigmaPi(),
+        clustersmatchedtracks(eventIR.orbit, bc.timestamp(), bc.runNumber(),
+                              track0.x(), track0.alpha(), track0.p(), track0.signed1Pt(),
+                              track0.y(), track0.z(), track0.snp(), track0.tgl(), track0.pt(),
+                              track0.sigmaY(), track0.sigmaZ(), track0.sigmaSnp(), track0.sigmaTgl(), track0.sigma1Pt(),
+                              track0.eta(), track0.phi(), track0.trackEtaEmcal(), track0.trackPhiEmcal(),
+                              dEta0, dPhi0,
+                              track0.itsNCls(), track0.tofExpMom(),
+                              track0.tpcNSigmaEl(), track0.tpcNSigmaPi(), track0.tofNSigmaEl(), track0.tofNSigmaPi(),
                               0.f, 0.f, 0.f, 0.f,
                               0.f, 0.f, 0.f, 0.f, 0.f,
                               0.f, 0.f, 0.f, 0.f, 0.f,
@@ -168,19 +174,22 @@ struct EmcalMatchedTracksTask {
                               cluster.energy(), cluster.eta(), cluster.phi(), cluster.m02(), cluster.nCells(), cluster.time());
 
       } else if (tracksofcluster.size() >= 2) { // do at least two cluster pre matched
-        if (fabs(tracksofcluster.iteratorAt(0).track_as<myTracksPID>().trackEtaEmcal() - cluster.eta()) >= minDEta || fabs(tracksofcluster.iteratorAt(0).track_as<myTracksPID>().trackPhiEmcal() - cluster.phi()) >= minDPhi) {
+        const auto track1 = tracksofcluster.iteratorAt(1).track_as<myTracksPID>();
+        const float dEta1 = track1.trackEtaEmcal() - cluster.eta();
+        const float dPhi1 = track1.trackPhiEmcal() - cluster.phi();
+        if (fabs(dEta0) >= minDEta || fabs(dPhi0) >= minDPhi) {
           // if not even the first track is within tighter matching window, go to next cluster
           continue;
-        } else if (fabs(tracksofcluster.iteratorAt(1).track_as<myTracksPID>().trackEtaEmcal() - cluster.eta()) >= minDEta || fabs(tracksofcluster.iteratorAt(1).track_as<myTracksPID>().trackPhiEmcal() - cluster.phi()) >= minDPhi) {
+        } else if (fabs(dEta1) >= minDEta || fabs(dPhi1) >= minDPhi) {
           // if only the first track is within tighter matching window, just write that one to table
-          clustersmatchedtracks(eventIR.orbit, theCollision.bc_as<myBCs>().timestamp(), theCollision.bc_as<myBCs>().runNumber(),
-                                tracksofcluster.iteratorAt(0).track_as<myTracksPID>().x(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().alpha(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().p(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().signed1Pt(),
-                                tracksofcluster.iteratorAt(0).track_as<myTracksPID>().y(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().z(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().snp(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().tgl(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().pt(),
-                                tracksofcluster.iteratorAt(0).track_as<myTracksPID>().sigmaY(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().sigmaZ(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().sigmaSnp(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().sigmaTgl(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().sigma1Pt(),
-                                tracksofcluster.iteratorAt(0).track_as<myTracksPID>().eta(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().phi(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().trackEtaEmcal(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().trackPhiEmcal(),
-                                tracksofcluster.iteratorAt(0).track_as<myTracksPID>().trackEtaEmcal() - cluster.eta(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().trackPhiEmcal() - cluster.phi(),
-                                tracksofcluster.iteratorAt(0).track_as<myTracksPID>().itsNCls(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().tofExpMom(),
-                                tracksofcluster.iteratorAt(0).track_as<myTracksPID>().tpcNSigmaEl(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().tpcNSigmaPi(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().tofNSigmaEl(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().tofNSigmaPi(),
+          clustersmatchedtracks(eventIR.orbit, bc.timestamp(), bc.runNumber(),
+                                track0.x(), track0.alpha(), track0.p(), track0.signed1Pt(),
+                                track0.y(), track0.z(), track0.snp(), track0.tgl(), track0.pt(),
+                                track0.sigmaY(), track0.sigmaZ(), track0.sigmaSnp(), track0.sigmaTgl(), track0.sigma1Pt(),
+                                track0.eta(), track0.phi(), track0.trackEtaEmcal(), track0.trackPhiEmcal(),
+                                dEta0, dPhi0,
+                                track0.itsNCls(), track0.tofExpMom(),
+                                track0.tpcNSigmaEl(), track0.tpcNSigmaPi(), track0.tofNSigmaEl(), track0.tofNSigmaPi(),
                                 0.f, 0.f, 0.f, 0.f,
                                 0.f, 0.f, 0.f, 0.f, 0.f,
                                 0.f, 0.f, 0.f, 0.f, 0.f,
@@ -191,21 +200,21 @@ struct EmcalMatchedTracksTask {
                                 cluster.energy(), cluster.eta(), cluster.phi(), cluster.m02(), cluster.nCells(), cluster.time());
         } else {
           // if both the first and second track are within tighter matching window, write both down
-          clustersmatchedtracks(eventIR.orbit, theCollision.bc_as<myBCs>().timestamp(), theCollision.bc_as<myBCs>().runNumber(),
-                                tracksofcluster.iteratorAt(0).track_as<myTracksPID>().x(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().alpha(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().p(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().signed1Pt(),
-                                tracksofcluster.iteratorAt(0).track_as<myTracksPID>().y(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().z(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().snp(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().tgl(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().pt(),
-                                tracksofcluster.iteratorAt(0).track_as<myTracksPID>().sigmaY(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().sigmaZ(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().sigmaSnp(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().sigmaTgl(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().sigma1Pt(),
-                                tracksofcluster.iteratorAt(0).track_as<myTracksPID>().eta(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().phi(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().trackEtaEmcal(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().trackPhiEmcal(),
-                                tracksofcluster.iteratorAt(0).track_as<myTracksPID>().trackEtaEmcal() - cluster.eta(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().trackPhiEmcal() - cluster.phi(),
-                                tracksofcluster.iteratorAt(0).track_as<myTracksPID>().itsNCls(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().tofExpMom(),
-                                tracksofcluster.iteratorAt(0).track_as<myTracksPID>().tpcNSigmaEl(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().tpcNSigmaPi(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().tofNSigmaEl(), tracksofcluster.iteratorAt(0).track_as<myTracksPID>().tofNSigmaPi(),
-                                tracksofcluster.iteratorAt(1).track_as<myTracksPID>().x(), tracksofcluster.iteratorAt(1).track_as<myTracksPID>().alpha(), tracksofcluster.iteratorAt(1).track_as<myTracksPID>().p(), tracksofcluster.iteratorAt(1).track_as<myTracksPID>().signed1Pt(),
-                                tracksofcluster.iteratorAt(1).track_as<myTracksPID>().y(), tracksofcluster.iteratorAt(1).track_as<myTracksPID>().z(), tracksofcluster.iteratorAt(1).track_as<myTracksPID>().snp(), tracksofcluster.iteratorAt(1).track_as<myTracksPID>().tgl(), tracksofcluster.iteratorAt(1).track_as<myTracksPID>().pt(),
-                                tracksofcluster.iteratorAt(1).track_as<myTracksPID>().sigmaY(), tracksofcluster.iteratorAt(1).track_as<myTracksPID>().sigmaZ(), tracksofcluster.iteratorAt(1).track_as<myTracksPID>().sigmaSnp(), tracksofcluster.iteratorAt(1).track_as<myTracksPID>().sigmaTgl(), tracksofcluster.iteratorAt(1).track_as<myTracksPID>().sigma1Pt(),
-                                tracksofcluster.iteratorAt(1).track_as<myTracksPID>().eta(), tracksofcluster.iteratorAt(1).track_as<myTracksPID>().phi(), tracksofcluster.iteratorAt(1).track_as<myTracksPID>().trackEtaEmcal(), tracksofcluster.iteratorAt(1).track_as<myTracksPID>().trackPhiEmcal(),
-                                tracksofcluster.iteratorAt(1).track_as<myTracksPID>().trackEtaEmcal() - cluster.eta(), tracksofcluster.iteratorAt(1).track_as<myTracksPID>().trackPhiEmcal() - cluster.phi(),
-                                tracksofcluster.iteratorAt(1).track_as<myTracksPID>().itsNCls(), tracksofcluster.iteratorAt(1).track_as<myTracksPID>().tofExpMom(),
-                                tracksofcluster.iteratorAt(1).track_as<myTracksPID>().tpcNSigmaEl(), tracksofcluster.iteratorAt(1).track_as<myTracksPID>().tpcNSigmaPi(), tracksofcluster.iteratorAt(1).track_as<myTracksPID>().tofNSigmaEl(), tracksofcluster.iteratorAt(1).track_as<myTracksPID>().tofNSigmaPi(), cluster.energy(), cluster.eta(), cluster.phi(), cluster.m02(), cluster.nCells(), cluster.time());
+          clustersmatchedtracks(eventIR.orbit, bc.timestamp(), bc.runNumber(),
+                                track0.x(), track0.alpha(), track0.p(), track0.signed1Pt(),
+                                track0.y(), track0.z(), track0.snp(), track0.tgl(), track0.pt(),
+                                track0.sigmaY(), track0.sigmaZ(), track0.sigmaSnp(), track0.sigmaTgl(), track0.sigma1Pt(),
+                                track0.eta(), track0.phi(), track0.trackEtaEmcal(), track0.trackPhiEmcal(),
+                                dEta0, dPhi0,
+                                track0.itsNCls(), track0.tofExpMom(),
+                                track0.tpcNSigmaEl(), track0.tpcNSigmaPi(), track0.tofNSigmaEl(), track0.tofNSigmaPi(),
+                                track1.x(), track1.alpha(), track1.p(), track1.signed1Pt(),
+                                track1.y(), track1.z(), track1.snp(), track1.tgl(), track1.pt(),
+                                track1.sigmaY(), track1.sigmaZ(), track1.sigmaSnp(), track1.sigmaTgl(), track1.sigma1Pt(),
+                                track1.eta(), track1.phi(), track1.trackEtaEmcal(), track1.trackPhiEmcal(),
+                                dEta1, dPhi1,
+                                track1.itsNCls(), track1.tofExpMom(),
+                                track1.tpcNSigmaEl(), track1.tpcNSigmaPi(), track1.tofNSigmaEl(), track1.tofNSigmaPi(), cluster.energy(), cluster.eta(), cluster.phi(), cluster.m02(), cluster.nCells(), cluster.time());
         }
       }
     } // end of loop over clusters
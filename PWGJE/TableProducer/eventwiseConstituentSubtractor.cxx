@@ -13,6 +13,11 @@
 //
 /// \author Nima Zardoshti <nima.zardoshti@cern.ch>
 
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "Framework/AnalysisTask.h"
 #include "Framework/AnalysisDataModel.h"
 #include "Framework/ASoA.h"
@@ -47,8 +52,12 @@ struct eventWiseConstituentSubtractorTask {
   Configurable<float> rMax{"rMax", 0.24, "maximum distance of subtraction"};
   Configurable<float> eventEtaMax{"eventEtaMax", 0.9, "maximum pseudorapidity of event"};
   Configurable<bool> doRhoMassSub{"doRhoMassSub", true, "perfom mass subtraction as well"};
+  Configurable<int> nThreads{"nThreads", 1, "number of threads subtracting the collisions of a dataframe in parallel, with processCollisionsParallel"};
 
   JetBkgSubUtils eventWiseConstituentSubtractor;
+  std::vector<JetBkgSubUtils> eventWiseConstituentSubtractorsPerThread; // one subtractor per thread, each keeping its ghosts between collisions
+  std::vector<std::vector<fastjet::PseudoJet>> inputParticlesPerCollision;
+  std::vector<std::vector<fastjet::PseudoJet>> tracksSubtractedPerCollision;
   float bkgPhiMax_;
   std::vector<fastjet::PseudoJet> inputParticles;
   std::vector<fastjet::PseudoJet> tracksSubtracted;
@@ -61,10 +70,18 @@ struct eventWiseConstituentSubtractorTask {
     eventWiseConstituentSubtractor.setDoRhoMassSub(doRhoMassSub);
     eventWiseConstituentSubtractor.setConstSubAlphaRMax(alpha, rMax);
     eventWiseConstituentSubtractor.setMaxEtaEvent(eventEtaMax);
+
+    eventWiseConstituentSubtractorsPerThread.resize(std::max(1, static_cast<int>(nThreads)));
+    for (auto& subtractor : eventWiseConstituentSubtractorsPerThread) {
+      subtractor.setDoRhoMassSub(doRhoMassSub);
+      subtractor.setConstSubAlphaRMax(alpha, rMax);
+      subtractor.setMaxEtaEvent(eventEtaMax);
+    }
   }
 
   Filter trackCuts = (aod::jtrack::pt >= trackPtMin && aod::jtrack::pt < trackPtMax && aod::jtrack::eta > trackEtaMin && aod::jtrack::eta < trackEtaMax && aod::jtrack::phi >= trackPhiMin && aod::jtrack::phi <= trackPhiMax);
 
+  Preslice<JetTracks> perCollision = aod::jtrack::collisionId;
   Preslice<aod::BkgD0Rhos> perD0Candidate = aod::bkgd0::candidateId;
   Preslice<aod::BkgLcRhos> perLcCandidate = aod::bkglc::candidateId;
   Preslice<aod::BkgBplusRhos> perBplusCandidate = aod::bkgbplus::candidateId;
@@ -105,6 +122,49 @@ struct eventWiseConstituentSubtractorTask {
   }
   PROCESS_SWITCH(eventWiseConstituentSubtractorTask, processCollisions, "Fill table of subtracted tracks for collisions", true);
 
+  void processCollisionsParallel(soa::Join<JetCollisions, aod::BkgChargedRhos> const& collisions, soa::Filtered<JetTracks> const& tracks)
+  {
+    // the input particles are collected first, the subtraction runs in chunks of collisions and the table is filled in the collision order
+    const int nCollisions = collisions.size();
+    inputParticlesPerCollision.resize(nCollisions);
+    tracksSubtractedPerCollision.resize(nCollisions);
+    std::vector<double> rho(nCollisions), rhoM(nCollisions);
+    int iCollision = 0;
+    for (const auto& collision : collisions) {
+      inputParticlesPerCollision[iCollision].clear();
+      auto tracksPerCollision = tracks.sliceBy(perCollision, collision.globalIndex());
+      jetfindingutilities::analyseTracks<soa::Filtered<JetTracks>, soa::Filtered<JetTracks>::iterator>(inputParticlesPerCollision[iCollision], tracksPerCollision, trackSelection);
+      rho[iCollision] = collision.rho();
+      rhoM[iCollision] = collision.rhoM();
+      iCollision++;
+    }
+
+    auto subtractChunk = [&](int iThread, int first, int last) {
+      auto& subtractor = eventWiseConstituentSubtractorsPerThread[iThread];
+      for (int i = first; i < last; i++) {
+        tracksSubtractedPerCollision[i] = subtractor.doEventConstSub(inputParticlesPerCollision[i], rho[i], rhoM[i]);
+      }
+    };
+    const int nChunks = std::max(1, std::min(static_cast<int>(eventWiseConstituentSubtractorsPerThread.size()), nCollisions));
+    std::vector<std::thread> threads;
+    threads.reserve(nChunks);
+    for (int iChunk = 0; iChunk < nChunks; iChunk++) {
+      threads.emplace_back(subtractChunk, iChunk, static_cast<int>(static_cast<int64_t>(nCollisions) * iChunk / nChunks), static_cast<int>(static_cast<int64_t>(nCollisions) * (iChunk + 1) / nChunks));
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    iCollision = 0;
+    for (const auto& collision : collisions) {
+      for (auto const& trackSubtracted : tracksSubtractedPerCollision[iCollision]) {
+        trackSubtractedTable(collision.globalIndex(), trackSubtracted.pt(), trackSubtracted.eta(), trackSubtracted.phi(), trackSubtracted.E(), jetderiveddatautilities::setSingleTrackSelectionBit(trackSelection));
+      }
+      iCollision++;
+    }
+  }
+  PROCESS_SWITCH(eventWiseConstituentSubtractorTask, processCollisionsParallel, "Fill table of subtracted tracks for collisions, subtracting the collisions of a dataframe in parallel", false);
+
   void processD0Collisions(JetCollision const&, aod::BkgD0Rhos const& bkgRhos, soa::Filtered<JetTracks> const& tracks, CandidatesD0Data const& candidates)
   {
     analyseHF(tracks, candidates, bkgRhos, trackSubtractedD0Table);
@@ -68,6 +68,8 @@ struct JetTaggerHFTask {
   std::vector<float> vecParamsBeautyJetMC;
   std::vector<float> vecParamsLfJetMC;
   std::vector<float> jetProb;
+  std::vector<jettaggingutilities::JetTrackIP> jetTracksIP; // impact parameters of the tracks of the current jet
+  std::vector<float> vecSignImpSig;                         // signed impact parameter significances of the current jet in descending order
   bool useResoFuncFromIncJet = false;
   int maxOrder = -1;
   int resoFuncMatch = 0;
@@ -144,6 +146,27 @@ struct JetTaggerHFTask {
     }
   }
 
+  /// Fills the jet probabilities of all the orders from the impact parameters of the current jet, the jet probability itself being computed at most once
+  template <typename T>
+  void fillJetProbabilities(T const& fResoFunc)
+  {
+    jetProb.clear();
+    jetProb.reserve(maxOrder);
+    float valueJetProb = 0.;
+    bool valueJetProbComputed = false;
+    for (int order = 0; order < maxOrder; order++) {
+      if (!jettaggingutilities::isGreaterThanTaggingPoint(vecSignImpSig, tagPoint, order)) {
+        jetProb.push_back(-1);
+        continue;
+      }
+      if (!valueJetProbComputed) {
+        valueJetProb = jettaggingutilities::getJetProbability(fResoFunc, jetTracksIP, minSignImpXYSig);
+        valueJetProbComputed = true;
+      }
+      jetProb.push_back(valueJetProb);
+    }
+  }
+
   void processDummy(JetCollisions const&)
   {
   }
@@ -155,11 +178,8 @@ struct JetTaggerHFTask {
       int algorithm2 = 0;
       int algorithm3 = 0;
       if (useJetProb) {
-        jetProb.clear();
-        jetProb.reserve(maxOrder);
-        for (int order = 0; order < maxOrder; order++) {
-          jetProb.push_back(jettaggingutilities::getJetProbability(fSignImpXYSigData, collision, jet, jtracks, tracks, order, tagPoint, minSignImpXYSig));
-        }
+        jettaggingutilities::fillJetTracksIP(collision, jet, jtracks, tracks, jetTracksIP, vecSignImpSig);
+        fillJetProbabilities(fSignImpXYSigData);
       }
       // if (doSV) algorithm2 = jettaggingutilities::Algorithm2((mcdjet, tracks);
       taggingTableData(0, jetProb, algorithm2, algorithm3);
@@ -180,21 +200,19 @@ struct JetTaggerHFTask {
       int algorithm3 = 0;
       if (useJetProb) {
         jetProb.clear();
-        jetProb.reserve(maxOrder);
-        for (int order = 0; order < maxOrder; order++) {
-          if (useResoFuncFromIncJet) {
-            jetProb.push_back(jettaggingutilities::getJetProbability(fSignImpXYSigIncJetMC, collision, mcdjet, jtracks, tracks, order, tagPoint, minSignImpXYSig));
-          } else {
-            if (origin == JetTaggingSpecies::charm) {
-              jetProb.push_back(jettaggingutilities::getJetProbability(fSignImpXYSigCharmJetMC, collision, mcdjet, jtracks, tracks, order, tagPoint, minSignImpXYSig));
-            }
-            if (origin == JetTaggingSpecies::beauty) {
-              jetProb.push_back(jettaggingutilities::getJetProbability(fSignImpXYSigBeautyJetMC, collision, mcdjet, jtracks, tracks, order, tagPoint, minSignImpXYSig));
-            }
-            if (origin == JetTaggingSpecies::lightflavour) {
-              jetProb.push_back(jettaggingutilities::getJetProbability(fSignImpXYSigLfJetMC, collision, mcdjet, jtracks, tracks, order, tagPoint, minSignImpXYSig));
-            }
-          }
+        const std::unique_ptr<TF1>* fSignImpXYSigMC = nullptr;
+        if (useResoFuncFromIncJet) {
+          fSignImpXYSigMC = &fSignImpXYSigIncJetMC;
+        } else if (origin == JetTaggingSpecies::charm) {
+          fSignImpXYSigMC = &fSignImpXYSigCharmJetMC;
+        } else if (origin == JetTaggingSpecies::beauty) {
+          fSignImpXYSigMC = &fSignImpXYSigBeautyJetMC;
+        } else if (origin == JetTaggingSpecies::lightflavour) {
+          fSignImpXYSigMC = &fSignImpXYSigLfJetMC;
+        }
+        if (fSignImpXYSigMC) {
+          jettaggingutilities::fillJetTracksIP(collision, mcdjet, jtracks, tracks, jetTracksIP, vecSignImpSig);
+          fillJetProbabilities(*fSignImpXYSigMC);
         }
         if (trackProbQA) {
           for (auto& jtrack : mcdjet.template tracks_as<JetTagTracksMCD>()) {
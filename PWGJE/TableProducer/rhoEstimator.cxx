@@ -49,6 +49,7 @@ struct RhoEstimatorTask {
   Configurable<float> bkgPhiMin{"bkgPhiMin", 0., "minimim phi for determining background density"};
   Configurable<float> bkgPhiMax{"bkgPhiMax", 99.0, "maximum phi for determining background density"};
   Configurable<bool> doSparse{"doSparse", false, "perfom sparse estimation"};
+  Configurable<bool> useCollisionRhoForCandidates{"useCollisionRhoForCandidates", false, "cluster the background once per collision with all the tracks and use it for all the HF candidates, instead of once per candidate with its daughters replaced"};
 
   JetBkgSubUtils bkgSub;
   float bkgPhiMax_;
@@ -81,6 +82,17 @@ struct RhoEstimatorTask {
   void processD0Collisions(JetCollision const&, soa::Filtered<JetTracks> const& tracks, CandidatesD0Data const& candidates)
   {
     inputParticles.clear();
+    if (useCollisionRhoForCandidates) {
+      if (candidates.size() == 0) {
+        return;
+      }
+      jetfindingutilities::analyseTracks<soa::Filtered<JetTracks>, soa::Filtered<JetTracks>::iterator>(inputParticles, tracks, trackSelection);
+      auto [rho, rhoM] = bkgSub.estimateRhoAreaMedian(inputParticles, doSparse);
+      for (auto& candidate : candidates) {
+        rhoD0Table(candidate.globalIndex(), rho, rhoM);
+      }
+      return;
+    }
     for (auto& candidate : candidates) {
       inputParticles.clear();
       jetfindingutilities::analyseTracks(inputParticles, tracks, trackSelection, std::optional{candidate});
@@ -94,6 +106,17 @@ struct RhoEstimatorTask {
   void processLcCollisions(JetCollision const&, soa::Filtered<JetTracks> const& tracks, CandidatesLcData const& candidates)
   {
     inputParticles.clear();
+    if (useCollisionRhoForCandidates) {
+      if (candidates.size() == 0) {
+        return;
+      }
+      jetfindingutilities::analyseTracks<soa::Filtered<JetTracks>, soa::Filtered<JetTracks>::iterator>(inputParticles, tracks, trackSelection);
+      auto [rho, rhoM] = bkgSub.estimateRhoAreaMedian(inputParticles, doSparse);
+      for (auto& candidate : candidates) {
+        rhoLcTable(candidate.globalIndex(), rho, rhoM);
+      }
+      return;
+    }
     for (auto& candidate : candidates) {
       inputParticles.clear();
       jetfindingutilities::analyseTracks(inputParticles, tracks, trackSelection, std::optional{candidate});
@@ -107,6 +130,17 @@ struct RhoEstimatorTask {
   void processBplusCollisions(JetCollision const&, soa::Filtered<JetTracks> const& tracks, CandidatesBplusData const& candidates)
   {
     inputParticles.clear();
+    if (useCollisionRhoForCandidates) {
+      if (candidates.size() == 0) {
+        return;
+      }
+      jetfindingutilities::analyseTracks<soa::Filtered<JetTracks>, soa::Filtered<JetTracks>::iterator>(inputParticles, tracks, trackSelection);
+      auto [rho, rhoM] = bkgSub.estimateRhoAreaMedian(inputParticles, doSparse);
+      for (auto& candidate : candidates) {
+        rhoBplusTable(candidate.globalIndex(), rho, rhoM);
+      }
+      return;
+    }
     for (auto& candidate : candidates) {
       inputParticles.clear();
       jetfindingutilities::analyseTracks(inputParticles, tracks, trackSelection, std::optional{candidate});
@@ -13,7 +13,11 @@
 //
 /// \author Hadi Hassan <hadi.hassan@cern.ch>
 
+#include <algorithm>
+#include <array>
+#include <limits>
 #include <type_traits>
+#include <vector>
 
 #include <TF1.h>
 #include <TH1.h>
@@ -66,6 +70,8 @@ struct SecondaryVertexReconstruction {
   Configurable<float> ptMinTrack{"ptMinTrack", -1., "min. track pT"};
   Configurable<float> etaMinTrack{"etaMinTrack", -99999., "min. pseudorapidity"};
   Configurable<float> etaMaxTrack{"etaMaxTrack", 4., "max. pseudorapidity"};
+  Configurable<float> minProngIPSignificance{"minProngIPSignificance", -1., "min. |d_xy|/sigma(d_xy) of the prongs, the tracks compatible with the primary vertex are not combined (<= 0: no cut)"};
+  Configurable<int> maxProngsPerJet{"maxProngsPerJet", -1, "max. number of prongs per jet, in decreasing order of impact parameter significance (<= 0: all)"};
   Configurable<bool> fillHistograms{"fillHistograms", true, "do validation plots"};
 
   Configurable<std::string> ccdbUrl{"ccdbUrl", "http://alice-ccdb.cern.ch", "url of the ccdb repository"};
@@ -125,37 +131,105 @@ struct SecondaryVertexReconstruction {
   using JetTracksMCDwPIs = soa::Filtered<soa::Join<JetTracksMCD, aod::JTrackPIs>>;
   using OriginalTracks = soa::Join<aod::Tracks, aod::TracksCov, aod::TrackSelection, aod::TracksDCA, aod::TracksDCACov>;
 
-  template <unsigned int numProngs, typename AnyCollision, typename AnyJet, typename AnyParticles>
-  void runCreatorNProng(AnyCollision const& collision,
-                        AnyJet const& analysisJet,
-                        AnyParticles const& listoftracks,
-                        std::vector<int>& svIndices,
-                        o2::vertexing::DCAFitterN<numProngs>& df,
-                        size_t prongIndex = 0,
-                        std::vector<size_t> currentCombination = {})
+  // prong candidate cached once per collision and shared by all the jets and combinations
+  struct ProngCandidate {
+    o2::track::TrackParametrizationWithError<float> trackParCov; // track parameters, copied for every fit
+    float pt = 0.;
+    float energy = 0.;                                            // energy with the pion mass hypothesis
+    float impactParameterSignificance = 0.;                       // |d_xy| / sigma(d_xy)
+  };
+  static constexpr int ProngNotCached = -2;
+  static constexpr int ProngRejected = -1;
+
+  std::vector<ProngCandidate> prongCache; // prong candidates of the current collision
+  std::vector<int> prongCacheIndices;     // position in prongCache by jet track index - prongCacheFirstIndex, or ProngNotCached or ProngRejected
+  int prongCacheFirstIndex = 0;
+  std::vector<int> jetProngs;             // positions in prongCache of the prongs of the current jet
+  o2::dataformats::VertexBase primaryVertex;
+  std::array<float, 6> covMatrixPV;
+
+  /// Sets up the field, the primary vertex and the prong cache of a collision, once for all its jets
+  template <typename AnyCollision, typename AnyJets>
+  void initCollision(AnyCollision const& collision, AnyJets const& jets)
   {
+    auto bc = collision.template bc_as<aod::BCsWithTimestamps>();
+    if (runNumber != bc.runNumber()) {
+      initCCDB(bc, runNumber, ccdb, ccdbPathGrpMag, lut, false);
+      bz = o2::base::Propagator::Instance()->getNominalBz();
+    }
+    df2.setBz(bz);
+    df3.setBz(bz);
+
+    primaryVertex = getPrimaryVertex(collision);
+    covMatrixPV = primaryVertex.getCov();
+
+    int firstIndex = std::numeric_limits<int>::max();
+    int lastIndex = -1;
+    for (auto const& jet : jets) {
+      for (auto const& trackId : jet.tracksIds()) {
+        firstIndex = std::min(firstIndex, trackId);
+        lastIndex = std::max(lastIndex, trackId);
+      }
+    }
+    prongCache.clear();
+    prongCacheFirstIndex = firstIndex;
+    prongCacheIndices.assign(lastIndex >= firstIndex ? lastIndex - firstIndex + 1 : 0, ProngNotCached);
+  }
+
+  /// Collects the prong candidates of a jet, caching the constituents not seen yet in the collision
+  template <typename AnyJet, typename AnyParticles>
+  void fillJetProngs(AnyJet const& analysisJet, AnyParticles const& /*listoftracks*/)
+  {
+    jetProngs.clear();
+    for (auto const& particle : analysisJet.template tracks_as<AnyParticles>()) {
+      int& cacheIndex = prongCacheIndices[particle.globalIndex() - prongCacheFirstIndex];
+      if (cacheIndex == ProngNotCached) {
+        const auto& prong = particle.template track_as<OriginalTracks>();
+        if (prong.pt() < ptMinTrack || prong.eta() < etaMinTrack || prong.eta() > etaMaxTrack) {
+          cacheIndex = ProngRejected;
+        } else {
+          ProngCandidate& candidate = prongCache.emplace_back();
+          candidate.trackParCov = getTrackParCov(prong);
+          candidate.pt = prong.pt();
+          candidate.energy = prong.energy(o2::constants::physics::MassPiPlus);
+          candidate.impactParameterSignificance = prong.sigmaDcaXY2() > 0. ? std::abs(prong.dcaXY()) / std::sqrt(prong.sigmaDcaXY2()) : 0.;
+          cacheIndex = prongCache.size() - 1;
+        }
+      }
+      if (cacheIndex >= 0) {
+        jetProngs.push_back(cacheIndex);
+      }
+    }
 
-    const auto& particles = analysisJet.template tracks_as<AnyParticles>();
+    // early rejection of the prongs compatible with the primary vertex, in decreasing order of impact parameter significance
+    if (minProngIPSignificance > 0. || maxProngsPerJet > 0) {
+      std::stable_sort(jetProngs.begin(), jetProngs.end(), [this](int a, int b) { return prongCache[a].impactParameterSignificance > prongCache[b].impactParameterSignificance; });
+      auto firstRejected = std::find_if(jetProngs.begin(), jetProngs.end(), [this](int index) { return prongCache[index].impactParameterSignificance < minProngIPSignificance; });
+      jetProngs.erase(firstRejected, jetProngs.end());
+      if (maxProngsPerJet > 0 && jetProngs.size() > static_cast<size_t>(maxProngsPerJet.value)) {
+        jetProngs.resize(maxProngsPerJet);
+      }
+    }
+  }
 
-    if (currentCombination.size() == numProngs) {
-      // Create an array of track parameters and covariance matrices for the current combination
+  template <unsigned int numProngs, typename AnyJet>
+  void runCreatorNProng(AnyJet const& analysisJet,
+                        std::vector<int>& svIndices,
+                        o2::vertexing::DCAFitterN<numProngs>& df,
+                        std::array<int, numProngs>& currentCombination,
+                        unsigned int combinationSize = 0,
+                        size_t prongIndex = 0)
+  {
+    if (combinationSize == numProngs) {
+      // Copy the cached track parameters and covariance matrices for the current combination
       std::array<o2::track::TrackParametrizationWithError<float>, numProngs> trackParVars;
       double energySV = 0.;
       for (unsigned int inum = 0; inum < numProngs; ++inum) {
-        const auto& prong = particles[currentCombination[inum]].template track_as<OriginalTracks>();
-        energySV += prong.energy(o2::constants::physics::MassPiPlus);
-        trackParVars[inum] = getTrackParCov(prong);
+        const ProngCandidate& prong = prongCache[currentCombination[inum]];
+        energySV += prong.energy;
+        trackParVars[inum] = prong.trackParCov;
       }
 
-      auto bc = collision.template bc_as<aod::BCsWithTimestamps>();
-      if (runNumber != bc.runNumber()) {
-        initCCDB(bc, runNumber, ccdb, ccdbPathGrpMag, lut, false);
-        bz = o2::base::Propagator::Instance()->getNominalBz();
-      }
-
-      // Use a different fitter depending on the number of prongs
-      df.setBz(bz);
-
       // Reconstruct the secondary vertex
       int processResult = 0;
       std::apply([&df, &processResult](const auto&... elems) { processResult = df.process(elems...); }, trackParVars);
@@ -167,12 +241,8 @@ struct SecondaryVertexReconstruction {
       auto chi2PCA = df.getChi2AtPCACandidate();
       auto covMatrixPCA = df.calcPCACovMatrixFlat();
 
-      // get track impact parameters
-      // This modifies track momenta!
-      auto primaryVertex = getPrimaryVertex(collision);
-      auto covMatrixPV = primaryVertex.getCov();
-
       // Get track momenta and impact parameters
+      // This modifies track momenta!
       std::array<std::array<float, 3>, numProngs> arrayMomenta;
       std::array<o2::dataformats::DCA, numProngs> impactParameters;
       for (unsigned int inum = 0; inum < numProngs; ++inum) {
@@ -180,12 +250,11 @@ struct SecondaryVertexReconstruction {
         trackParVars[inum].propagateToDCA(primaryVertex, bz, &impactParameters[inum]);
 
         if (fillHistograms) {
-          const auto& prong = particles[currentCombination[inum]].template track_as<OriginalTracks>();
-          registry.fill(HIST("hDcaXYNProngs"), prong.pt(), impactParameters[inum].getY() * toMicrometers, numProngs);
-          registry.fill(HIST("hDcaZNProngs"), prong.pt(), impactParameters[inum].getZ() * toMicrometers, numProngs);
+          const float ptProng = prongCache[currentCombination[inum]].pt;
+          registry.fill(HIST("hDcaXYNProngs"), ptProng, impactParameters[inum].getY() * toMicrometers, numProngs);
+          registry.fill(HIST("hDcaZNProngs"), ptProng, impactParameters[inum].getZ() * toMicrometers, numProngs);
         }
       }
-
       // get uncertainty of the decay length
       double phi, theta;
       getPointDirection(std::array{primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ()}, secondaryVertex, phi, theta);
@@ -252,18 +321,28 @@ struct SecondaryVertexReconstruction {
       return;
     }
 
-    // Recursive call to explore all combinations
-    for (size_t iprong = prongIndex; iprong < particles.size(); ++iprong) {
-
-      const auto& testTrack = particles[iprong].template track_as<OriginalTracks>();
-      if (testTrack.pt() < ptMinTrack || testTrack.eta() < etaMinTrack || testTrack.eta() > etaMaxTrack) {
-        continue;
-      }
+    // Recursive call to explore all combinations of the selected prongs
+    for (size_t iprong = prongIndex; iprong + (numProngs - combinationSize) <= jetProngs.size(); ++iprong) {
+      currentCombination[combinationSize] = jetProngs[iprong];
+      runCreatorNProng<numProngs>(analysisJet, svIndices, df, currentCombination, combinationSize + 1, iprong + 1);
+    }
+  }
 
-      currentCombination.push_back(iprong);
-      runCreatorNProng<numProngs>(
-        collision, analysisJet, listoftracks, svIndices, df, iprong + 1, currentCombination);
-      currentCombination.pop_back();
+  /// Reconstructs the n-prong secondary vertices of all the jets of a collision
+  template <unsigned int numProngs, typename AnyCollision, typename AnyJets, typename AnyParticles, typename SVIndicesTable>
+  void runCreatorNProngJets(AnyCollision const& collision, AnyJets const& jets, AnyParticles const& listoftracks, o2::vertexing::DCAFitterN<numProngs>& df, SVIndicesTable& svIndicesTable)
+  {
+    if (jets.size() == 0) {
+      return;
+    }
+    initCollision(collision, jets);
+    std::array<int, numProngs> currentCombination;
+    std::vector<int> svIndices;
+    for (auto const& jet : jets) {
+      svIndices.clear();
+      fillJetProngs(jet, listoftracks);
+      runCreatorNProng<numProngs>(jet, svIndices, df, currentCombination);
+      svIndicesTable(svIndices);
     }
   }
 
@@ -274,41 +353,25 @@ struct SecondaryVertexReconstruction {
 
   void processData3Prongs(JetCollisionwPIs::iterator const& collision, aod::Collisions const& /*realColl*/, soa::Join<aod::ChargedJets, aod::ChargedJetConstituents> const& jets, JetTracksData const& jtracks, OriginalTracks const& /*tracks*/, aod::BCsWithTimestamps const& /*bcWithTimeStamps*/)
   {
-    for (auto& jet : jets) {
-      std::vector<int> svIndices;
-      runCreatorNProng<3>(collision.template collision_as<aod::Collisions>(), jet, jtracks, svIndices, df3);
-      sv3prongIndicesTableData(svIndices);
-    }
+    runCreatorNProngJets<3>(collision.template collision_as<aod::Collisions>(), jets, jtracks, df3, sv3prongIndicesTableData);
   }
   PROCESS_SWITCH(SecondaryVertexReconstruction, processData3Prongs, "Reconstruct the data 3-prong secondary vertex", false);
 
   void processData2Prongs(JetCollisionwPIs::iterator const& collision, aod::Collisions const& /*realColl*/, soa::Join<aod::ChargedJets, aod::ChargedJetConstituents> const& jets, JetTracksData const& jtracks, OriginalTracks const& /*tracks*/, aod::BCsWithTimestamps const& /*bcWithTimeStamps*/)
   {
-    for (auto& jet : jets) {
-      std::vector<int> svIndices;
-      runCreatorNProng<2>(collision.template collision_as<aod::Collisions>(), jet, jtracks, svIndices, df2);
-      sv2prongIndicesTableData(svIndices);
-    }
+    runCreatorNProngJets<2>(collision.template collision_as<aod::Collisions>(), jets, jtracks, df2, sv2prongIndicesTableData);
   }
   PROCESS_SWITCH(SecondaryVertexReconstruction, processData2Prongs, "Reconstruct the data 2-prong secondary vertex", false);
 
   void processMCD3Prongs(JetCollisionwPIs::iterator const& collision, aod::Collisions const& /*realColl*/, soa::Join<aod::ChargedMCDetectorLevelJets, aod::ChargedMCDetectorLevelJetConstituents> const& mcdjets, JetTracksMCDwPIs const& jtracks, OriginalTracks const& /*tracks*/, aod::BCsWithTimestamps const& /*bcWithTimeStamps*/)
   {
-    for (auto& jet : mcdjets) {
-      std::vector<int> svIndices;
-      runCreatorNProng<3>(collision.template collision_as<aod::Collisions>(), jet, jtracks, svIndices, df3);
-      sv3prongIndicesTableMCD(svIndices);
-    }
+    runCreatorNProngJets<3>(collision.template collision_as<aod::Collisions>(), mcdjets, jtracks, df3, sv3prongIndicesTableMCD);
   }
   PROCESS_SWITCH(SecondaryVertexReconstruction, processMCD3Prongs, "Reconstruct the MCD 3-prong secondary vertex", false);
 
   void processMCD2Prongs(JetCollisionwPIs::iterator const& collision, aod::Collisions const& /*realColl*/, soa::Join<aod::ChargedMCDetectorLevelJets, aod::ChargedMCDetectorLevelJetConstituents> const& mcdjets, JetTracksMCDwPIs const& jtracks, OriginalTracks const& /*tracks*/, aod::BCsWithTimestamps const& /*bcWithTimeStamps*/)
   {
-    for (auto& jet : mcdjets) {
-      std::vector<int> svIndices;
-      runCreatorNProng<2>(collision.template collision_as<aod::Collisions>(), jet, jtracks, svIndices, df2);
-      sv2prongIndicesTableMCD(svIndices);
-    }
+    runCreatorNProngJets<2>(collision.template collision_as<aod::Collisions>(), mcdjets, jtracks, df2, sv2prongIndicesTableMCD);
   }
   PROCESS_SWITCH(SecondaryVertexReconstruction, processMCD2Prongs, "Reconstruct the MCD 2-prong secondary vertex", false);
 };
@@ -173,8 +173,8 @@ struct Photon {
 };
 
 struct Meson {
-  Meson(Photon p1, Photon p2) : pgamma1(p1),
-                                pgamma2(p2)
+  Meson(const Photon& p1, const Photon& p2) : pgamma1(p1),
+                                              pgamma2(p2)
   {
     pMeson = p1.photon + p2.photon;
   }
@@ -447,18 +447,20 @@ struct Pi0EnergyScaleCalibTask {
       for (unsigned int ig2 = ig1 + 1; ig2 < mPhotons.size(); ++ig2) {
         Meson meson(mPhotons[ig1], mPhotons[ig2]); // build meson from photons
         if (meson.getOpeningAngle() > mMinOpenAngleCut) {
-          mHistManager.fill(HIST("invMassVsPt"), meson.getMass(), meson.getPt());
-          mHistManager.fill(HIST("invMassVsPtVsAcc"), meson.getMass(), meson.getPt(), 0.);
+          const float mass = meson.getMass();
+          const float pt = meson.getPt();
+          mHistManager.fill(HIST("invMassVsPt"), mass, pt);
+          mHistManager.fill(HIST("invMassVsPtVsAcc"), mass, pt, 0.);
           if (mPhotons[ig1].supermodulecategory == mPhotons[ig2].supermodulecategory)
-            mHistManager.fill(HIST("invMassVsPtVsSMCat"), meson.getMass(), meson.getPt(), mPhotons[ig1].supermodulecategory);
-          mHistManager.fill(HIST("invMassVsPtVsRow"), meson.getMass(), meson.getPt(), mPhotons[ig1].row);
-          mHistManager.fill(HIST("invMassVsPtVsRow"), meson.getMass(), meson.getPt(), mPhotons[ig2].row);
-          mHistManager.fill(HIST("invMassVsPtVsCol"), meson.getMass(), meson.getPt(), mPhotons[ig1].col);
-          mHistManager.fill(HIST("invMassVsPtVsCol"), meson.getMass(), meson.getPt(), mPhotons[ig2].col);
+            mHistManager.fill(HIST("invMassVsPtVsSMCat"), mass, pt, mPhotons[ig1].supermodulecategory);
+          mHistManager.fill(HIST("invMassVsPtVsRow"), mass, pt, mPhotons[ig1].row);
+          mHistManager.fill(HIST("invMassVsPtVsRow"), mass, pt, mPhotons[ig2].row);
+          mHistManager.fill(HIST("invMassVsPtVsCol"), mass, pt, mPhotons[ig1].col);
+          mHistManager.fill(HIST("invMassVsPtVsCol"), mass, pt, mPhotons[ig2].col);
           for (int iAcceptanceCategory = 1; iAcceptanceCategory < NAcceptanceCategories; iAcceptanceCategory++) {
             if ((!mRequireBothPhotonsFromAcceptance && (mPhotons[ig1].acceptance_category == iAcceptanceCategory || mPhotons[ig2].acceptance_category == iAcceptanceCategory)) ||
                 (mPhotons[ig1].acceptance_category == iAcceptanceCategory && mPhotons[ig2].acceptance_category == iAcceptanceCategory)) {
-              mHistManager.fill(HIST("invMassVsPtVsAcc"), meson.getMass(), meson.getPt(), iAcceptanceCategory);
+              mHistManager.fill(HIST("invMassVsPtVsAcc"), mass, pt, iAcceptanceCategory);
             }
           }
           CalculateBackground(meson, ig1, ig2); // calculate background candidates (rotation background)
@@ -476,28 +478,31 @@ struct Pi0EnergyScaleCalibTask {
     }
     const double rotationAngle = M_PI / 2.0; // 0.78539816339; // rotaion angle 90°
 
+    // the rotated photons only depend on the pair, so they are built once and combined with all the other photons
     TLorentzVector lvRotationPhoton1; // photon candidates which get rotated
     TLorentzVector lvRotationPhoton2; // photon candidates which get rotated
     TVector3 lvRotationPion;          // rotation axis
+
+    // calculate rotation axis
+    lvRotationPion = (meson.pMeson).Vect();
+
+    // initialize photons for rotation
+    lvRotationPhoton1.SetPxPyPzE(mPhotons[ig1].px, mPhotons[ig1].py, mPhotons[ig1].pz, mPhotons[ig1].energy);
+    lvRotationPhoton2.SetPxPyPzE(mPhotons[ig2].px, mPhotons[ig2].py, mPhotons[ig2].pz, mPhotons[ig2].energy);
+
+    // rotate photons around rotation axis
+    lvRotationPhoton1.Rotate(rotationAngle, lvRotationPion);
+    lvRotationPhoton2.Rotate(rotationAngle, lvRotationPion);
+
+    // initialize Photon objects for rotated photons
+    const Photon rotPhoton1(lvRotationPhoton1.Eta(), lvRotationPhoton1.Phi(), lvRotationPhoton1.E(), mPhotons[ig1].clusterid, mPhotons[ig1].cellid);
+    const Photon rotPhoton2(lvRotationPhoton2.Eta(), lvRotationPhoton2.Phi(), lvRotationPhoton2.E(), mPhotons[ig2].clusterid, mPhotons[ig2].cellid);
+
     for (unsigned int ig3 = 0; ig3 < mPhotons.size(); ++ig3) {
       // continue if photons are identical
       if (ig3 == ig1 || ig3 == ig2) {
         continue;
       }
-      // calculate rotation axis
-      lvRotationPion = (meson.pMeson).Vect();
-
-      // initialize photons for rotation
-      lvRotationPhoton1.SetPxPyPzE(mPhotons[ig1].px, mPhotons[ig1].py, mPhotons[ig1].pz, mPhotons[ig1].energy);
-      lvRotationPhoton2.SetPxPyPzE(mPhotons[ig2].px, mPhotons[ig2].py, mPhotons[ig2].pz, mPhotons[ig2].energy);
-
-      // rotate photons around rotation axis
-      lvRotationPhoton1.Rotate(rotationAngle, lvRotationPion);
-      lvRotationPhoton2.Rotate(rotationAngle, lvRotationPion);
-
-      // initialize Photon objects for rotated photons
-      Photon rotPhoton1(lvRotationPhoton1.Eta(), lvRotationPhoton1.Phi(), lvRotationPhoton1.E(), mPhotons[ig1].clusterid, mPhotons[ig1].cellid);
-      Photon rotPhoton2(lvRotationPhoton2.Eta(), lvRotationPhoton2.Phi(), lvRotationPhoton2.E(), mPhotons[ig2].clusterid, mPhotons[ig2].cellid);
 
       // build meson from rotated photons
       Meson mesonRotated1(rotPhoton1, mPhotons[ig3]);
@@ -505,34 +510,38 @@ struct Pi0EnergyScaleCalibTask {
 
       // Fill histograms
       if (mesonRotated1.getOpeningAngle() > mMinOpenAngleCut) {
-        mHistManager.fill(HIST("invMassVsPtBackground"), mesonRotated1.getMass(), mesonRotated1.getPt());
-        mHistManager.fill(HIST("invMassVsPtVsAccBackground"), mesonRotated1.getMass(), mesonRotated1.getPt(), 0);
+        const float mass = mesonRotated1.getMass();
+        const float pt = mesonRotated1.getPt();
+        mHistManager.fill(HIST("invMassVsPtBackground"), mass, pt);
+        mHistManager.fill(HIST("invMassVsPtVsAccBackground"), mass, pt, 0);
         if (mPhotons[ig3].supermodulecategory == rotPhoton1.supermodulecategory)
-          mHistManager.fill(HIST("invMassVsPtVsSMCatBackground"), mesonRotated1.getMass(), mesonRotated1.getPt(), mPhotons[ig3].supermodulecategory);
-        mHistManager.fill(HIST("invMassVsPtVsRowBackground"), mesonRotated1.getMass(), mesonRotated1.getPt(), mPhotons[ig3].row);
-        mHistManager.fill(HIST("invMassVsPtVsRowBackground"), mesonRotated1.getMass(), mesonRotated1.getPt(), rotPhoton1.row);
-        mHistManager.fill(HIST("invMassVsPtVsColBackground"), mesonRotated1.getMass(), mesonRotated1.getPt(), mPhotons[ig3].col);
-        mHistManager.fill(HIST("invMassVsPtVsColBackground"), mesonRotated1.getMass(), mesonRotated1.getPt(), rotPhoton1.col);
+          mHistManager.fill(HIST("invMassVsPtVsSMCatBackground"), mass, pt, mPhotons[ig3].supermodulecategory);
+        mHistManager.fill(HIST("invMassVsPtVsRowBackground"), mass, pt, mPhotons[ig3].row);
+        mHistManager.fill(HIST("invMassVsPtVsRowBackground"), mass, pt, rotPhoton1.row);
+        mHistManager.fill(HIST("invMassVsPtVsColBackground"), mass, pt, mPhotons[ig3].col);
+        mHistManager.fill(HIST("invMassVsPtVsColBackground"), mass, pt, rotPhoton1.col);
         for (int iAcceptanceCategory = 1; iAcceptanceCategory < NAcceptanceCategories; iAcceptanceCategory++) {
           if ((!mRequireBothPhotonsFromAcceptance && (rotPhoton1.acceptance_category == iAcceptanceCategory || mPhotons[ig3].acceptance_category == iAcceptanceCategory)) ||
               (rotPhoton1.acceptance_category == iAcceptanceCategory && mPhotons[ig3].acceptance_category == iAcceptanceCategory)) {
-            mHistManager.fill(HIST("invMassVsPtVsAccBackground"), mesonRotated1.getMass(), mesonRotated1.getPt(), iAcceptanceCategory);
+            mHistManager.fill(HIST("invMassVsPtVsAccBackground"), mass, pt, iAcceptanceCategory);
           }
         }
       }
       if (mesonRotated2.getOpeningAngle() > mMinOpenAngleCut) {
-        mHistManager.fill(HIST("invMassVsPtBackground"), mesonRotated2.getMass(), mesonRotated2.getPt());
-        mHistManager.fill(HIST("invMassVsPtVsAccBackground"), mesonRotated2.getMass(), mesonRotated2.getPt(), 0);
+        const float mass = mesonRotated2.getMass();
+        const float pt = mesonRotated2.getPt();
+        mHistManager.fill(HIST("invMassVsPtBackground"), mass, pt);
+        mHistManager.fill(HIST("invMassVsPtVsAccBackground"), mass, pt, 0);
         if (mPhotons[ig3].supermodulecategory == rotPhoton2.supermodulecategory)
-          mHistManager.fill(HIST("invMassVsPtVsSMCatBackground"), mesonRotated2.getMass(), mesonRotated2.getPt(), mPhotons[ig3].supermodulecategory);
-        mHistManager.fill(HIST("invMassVsPtVsRowBackground"), mesonRotated2.getMass(), mesonRotated2.getPt(), mPhotons[ig3].row);
-        mHistManager.fill(HIST("invMassVsPtVsRowBackground"), mesonRotated2.getMass(), mesonRotated2.getPt(), rotPhoton2.row);
-        mHistManager.fill(HIST("invMassVsPtVsColBackground"), mesonRotated2.getMass(), mesonRotated2.getPt(), mPhotons[ig3].col);
-        mHistManager.fill(HIST("invMassVsPtVsColBackground"), mesonRotated2.getMass(), mesonRotated2.getPt(), rotPhoton2.col);
+          mHistManager.fill(HIST("invMassVsPtVsSMCatBackground"), mass, pt, mPhotons[ig3].supermodulecategory);
+        mHistManager.fill(HIST("invMassVsPtVsRowBackground"), mass, pt, mPhotons[ig3].row);
+        mHistManager.fill(HIST("invMassVsPtVsRowBackground"), mass, pt, rotPhoton2.row);
+        mHistManager.fill(HIST("invMassVsPtVsColBackground"), mass, pt, mPhotons[ig3].col);
+        mHistManager.fill(HIST("invMassVsPtVsColBackground"), mass, pt, rotPhoton2.col);
         for (int iAcceptanceCategory = 1; iAcceptanceCategory < NAcceptanceCategories; iAcceptanceCategory++) {
           if ((!mRequireBothPhotonsFromAcceptance && (rotPhoton2.acceptance_category == iAcceptanceCategory || mPhotons[ig3].acceptance_category == iAcceptanceCategory)) ||
               (rotPhoton2.acceptance_category == iAcceptanceCategory && mPhotons[ig3].acceptance_category == iAcceptanceCategory)) {
-            mHistManager.fill(HIST("invMassVsPtVsAccBackground"), mesonRotated2.getMass(), mesonRotated2.getPt(), iAcceptanceCategory);
+            mHistManager.fill(HIST("invMassVsPtVsAccBackground"), mass, pt, iAcceptanceCategory);
           }
         }
       }
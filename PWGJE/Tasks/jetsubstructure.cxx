@@ -32,6 +32,7 @@
 #include "PWGJE/DataModel/JetSubstructure.h"
 #include "PWGJE/Core/JetFinder.h"
 #include "PWGJE/Core/FastJetUtilities.h"
+#include "PWGJE/Core/JetConstituentUtilities.h"
 #include "PWGJE/Core/JetSubstructureUtilities.h"
 
 using namespace o2;
@@ -45,16 +46,26 @@ struct JetSubstructureTask {
   Produces<aod::CMCDJetSSs> jetSubstructureMCDTable;
   Produces<aod::CMCPJetSSs> jetSubstructureMCPTable;
   Produces<aod::CEWSJetSSs> jetSubstructureDataSubTable;
+  Produces<aod::CJetSPs> jetSplitsDataTable;
+  Produces<aod::CMCDJetSPs> jetSplitsMCDTable;
+  Produces<aod::CMCPJetSPs> jetSplitsMCPTable;
+  Produces<aod::CEWSJetSPs> jetSplitsDataSubTable;
 
   Configurable<float> zCut{"zCut", 0.1, "soft drop z cut"};
   Configurable<float> beta{"beta", 0.0, "soft drop beta"};
 
   Service<o2::framework::O2DatabasePDG> pdg;
   std::vector<fastjet::PseudoJet> jetConstituents;
+  jetconstituentutilities::JetConstituentArrays jetConstituentArrays; // constituents of all the jets of the dataframe
   std::vector<fastjet::PseudoJet> jetReclustered;
   JetFinder jetReclusterer;
 
   std::vector<float> nSub;
+  // primary C/A declustering of the current jet, stored in the splits tables so that the grooming can be redone downstream without reclustering
+  std::vector<float> splitZ;
+  std::vector<float> splitTheta;
+  std::vector<float> splitKt;
+  std::vector<float> splitMass;
 
   HistogramRegistry registry;
 
@@ -76,8 +87,8 @@ struct JetSubstructureTask {
     jetReclusterer.algorithm = fastjet::JetAlgorithm::cambridge_algorithm;
   }
 
-  template <bool isMCP, bool isSubtracted, typename T, typename U>
-  void jetReclustering(T const& jet, U& outputTable)
+  template <bool isMCP, bool isSubtracted, typename T, typename U, typename S>
+  void jetReclustering(T const& jet, U& outputTable, S& splitsTable)
   {
     jetReclustered.clear();
     fastjet::ClusterSequenceArea clusterSeq(jetReclusterer.findJets(jetConstituents, jetReclustered));
@@ -93,6 +104,10 @@ struct JetSubstructureTask {
     std::vector<float> ptLeadingVec;
     std::vector<float> ptSubLeadingVec;
     std::vector<float> thetaVec;
+    splitZ.clear();
+    splitTheta.clear();
+    splitKt.clear();
+    splitMass.clear();
 
     while (daughterSubJet.has_parents(parentSubJet1, parentSubJet2)) {
       if (parentSubJet1.perp() < parentSubJet2.perp()) {
@@ -104,6 +119,10 @@ struct JetSubstructureTask {
       ptLeadingVec.push_back(parentSubJet1.pt());
       ptSubLeadingVec.push_back(parentSubJet2.pt());
       thetaVec.push_back(theta);
+      splitZ.push_back(z);
+      splitTheta.push_back(theta);
+      splitKt.push_back(parentSubJet2.perp() * std::sin(theta));
+      splitMass.push_back(daughterSubJet.m());
 
       if (z >= zCut * TMath::Power(theta / (jet.r() / 100.f), beta)) {
         if (!softDropped) {
@@ -137,18 +156,26 @@ struct JetSubstructureTask {
       registry.fill(HIST("h2_jet_pt_jet_nsd_eventwiseconstituentsubtracted"), jet.pt(), nsd);
     }
     outputTable(energyMotherVec, ptLeadingVec, ptSubLeadingVec, thetaVec, nSub[0], nSub[1], nSub[2]);
+    splitsTable(splitZ, splitTheta, splitKt, splitMass);
   }
 
-  template <bool isSubtracted, typename T, typename U, typename V>
-  void analyseCharged(T const& jet, U const& tracks, V& outputTable)
+  template <bool isMCP, bool isSubtracted, typename T, typename V, typename S>
+  void analyseJets(T const& jets, V& outputTable, S& splitsTable)
   {
-    jetConstituents.clear();
-    for (auto& jetConstituent : jet.template tracks_as<U>()) {
-      fastjetutilities::fillTracks(jetConstituent, jetConstituents, jetConstituent.globalIndex());
+    for (auto const& jet : jets) {
+      jetConstituents.clear();
+      jetconstituentutilities::fillPseudoJets(jetConstituentArrays.get(jet), jetConstituents);
+      nSub = jetsubstructureutilities::getNSubjettinessFromConstituents(jetConstituents, jet.r() / 100.0, 2, fastjet::contrib::CA_Axes(), true, zCut, beta);
+
+      jetReclustering<isMCP, isSubtracted>(jet, outputTable, splitsTable);
     }
-    nSub = jetsubstructureutilities::getNSubjettiness(jet, tracks, tracks, tracks, 2, fastjet::contrib::CA_Axes(), true, zCut, beta);
+  }
 
-    jetReclustering<false, isSubtracted>(jet, outputTable);
+  template <bool isSubtracted, typename T, typename U, typename V, typename S>
+  void analyseCharged(T const& jets, U const& tracks, V& outputTable, S& splitsTable)
+  {
+    jetConstituentArrays.build(jets, tracks);
+    analyseJets<false, isSubtracted>(jets, outputTable, splitsTable);
   }
 
   void processDummy(JetTracks const&)
@@ -156,36 +183,32 @@ struct JetSubstructureTask {
   }
   PROCESS_SWITCH(JetSubstructureTask, processDummy, "Dummy process function turned on by default", true);
 
-  void processChargedJetsData(soa::Join<aod::ChargedJets, aod::ChargedJetConstituents>::iterator const& jet,
+  void processChargedJetsData(soa::Join<aod::ChargedJets, aod::ChargedJetConstituents> const& jets,
                               JetTracks const& tracks)
   {
-    analyseCharged<false>(jet, tracks, jetSubstructureDataTable);
+    analyseCharged<false>(jets, tracks, jetSubstructureDataTable, jetSplitsDataTable);
   }
   PROCESS_SWITCH(JetSubstructureTask, processChargedJetsData, "charged jet substructure", false);
 
-  void processChargedJetsEventWiseSubData(soa::Join<aod::ChargedEventWiseSubtractedJets, aod::ChargedEventWiseSubtractedJetConstituents>::iterator const& jet,
+  void processChargedJetsEventWiseSubData(soa::Join<aod::ChargedEventWiseSubtractedJets, aod::ChargedEventWiseSubtractedJetConstituents> const& jets,
                                           JetTracksSub const& tracks)
   {
-    analyseCharged<true>(jet, tracks, jetSubstructureDataSubTable);
+    analyseCharged<true>(jets, tracks, jetSubstructureDataSubTable, jetSplitsDataSubTable);
   }
   PROCESS_SWITCH(JetSubstructureTask, processChargedJetsEventWiseSubData, "eventwise-constituent subtracted charged jet substructure", false);
 
-  void processChargedJetsMCD(typename soa::Join<aod::ChargedMCDetectorLevelJets, aod::ChargedMCDetectorLevelJetConstituents>::iterator const& jet,
+  void processChargedJetsMCD(typename soa::Join<aod::ChargedMCDetectorLevelJets, aod::ChargedMCDetectorLevelJetConstituents> const& jets,
                              JetTracks const& tracks)
   {
-    analyseCharged<false>(jet, tracks, jetSubstructureMCDTable);
+    analyseCharged<false>(jets, tracks, jetSubstructureMCDTable, jetSplitsMCDTable);
   }
   PROCESS_SWITCH(JetSubstructureTask, processChargedJetsMCD, "charged jet substructure", false);
 
-  void processChargedJetsMCP(typename soa::Join<aod::ChargedMCParticleLevelJets, aod::ChargedMCParticleLevelJetConstituents>::iterator const& jet,
+  void processChargedJetsMCP(typename soa::Join<aod::ChargedMCParticleLevelJets, aod::ChargedMCParticleLevelJetConstituents> const& jets,
                              JetParticles const& particles)
   {
-    jetConstituents.clear();
-    for (auto& jetConstituent : jet.template tracks_as<JetParticles>()) {
-      fastjetutilities::fillTracks(jetConstituent, jetConstituents, jetConstituent.globalIndex(), static_cast<int>(JetConstituentStatus::track), pdg->Mass(jetConstituent.pdgCode()));
-    }
-    nSub = jetsubstructureutilities::getNSubjettiness(jet, particles, particles, particles, 2, fastjet::contrib::CA_Axes(), true, zCut, beta);
-    jetReclustering<true, false>(jet, jetSubstructureMCPTable);
+    jetConstituentArrays.build(jets, particles, [this](auto const& particle) -> float { return pdg->Mass(particle.pdgCode()); });
+    analyseJets<true, false>(jets, jetSubstructureMCPTable, jetSplitsMCPTable);
   }
   PROCESS_SWITCH(JetSubstructureTask, processChargedJetsMCP, "charged jet substructure on MC particle level", false);
 };
@@ -46,12 +46,16 @@ using namespace o2::framework::expressions;
 // NB: runDataProcessing.h must be included after customize!
 #include "Framework/runDataProcessing.h"
 
-template <typename JetTableData, typename JetTableMCD, typename JetTableMCP, typename JetTableDataSub, typename CandidateTable, typename CandidateTableMCP, typename SubstructureTableData, typename SubstructureTableMCD, typename SubstructureTableMCP, typename SubstructureTableDataSub, typename TracksSub>
+template <typename JetTableData, typename JetTableMCD, typename JetTableMCP, typename JetTableDataSub, typename CandidateTable, typename CandidateTableMCP, typename SubstructureTableData, typename SubstructureTableMCD, typename SubstructureTableMCP, typename SubstructureTableDataSub, typename SplitsTableData, typename SplitsTableMCD, typename SplitsTableMCP, typename SplitsTableDataSub, typename TracksSub>
 struct JetSubstructureHFTask {
   Produces<SubstructureTableData> jetSubstructureDataTable;
   Produces<SubstructureTableMCD> jetSubstructureMCDTable;
   Produces<SubstructureTableMCP> jetSubstructureMCPTable;
   Produces<SubstructureTableDataSub> jetSubstructureDataSubTable;
+  Produces<SplitsTableData> jetSplitsDataTable;
+  Produces<SplitsTableMCD> jetSplitsMCDTable;
+  Produces<SplitsTableMCP> jetSplitsMCPTable;
+  Produces<SplitsTableDataSub> jetSplitsDataSubTable;
 
   // Jet level configurables
   Configurable<float> zCut{"zCut", 0.1, "soft drop z cut"};
@@ -65,6 +69,11 @@ struct JetSubstructureHFTask {
   JetFinder jetReclusterer;
 
   std::vector<float> nSub;
+  // primary C/A declustering of the current jet, stored in the splits tables so that the grooming can be redone downstream without reclustering
+  std::vector<float> splitZ;
+  std::vector<float> splitTheta;
+  std::vector<float> splitKt;
+  std::vector<float> splitMass;
 
   HistogramRegistry registry;
   void init(InitContext const&)
@@ -87,8 +96,8 @@ struct JetSubstructureHFTask {
     candMass = jethfutilities::getTablePDGMass<CandidateTable>();
   }
 
-  template <bool isMCP, bool isSubtracted, typename T, typename U>
-  void jetReclustering(T const& jet, U& outputTable)
+  template <bool isMCP, bool isSubtracted, typename T, typename U, typename S>
+  void jetReclustering(T const& jet, U& outputTable, S& splitsTable)
   {
     jetReclustered.clear();
     fastjet::ClusterSequenceArea clusterSeq(jetReclusterer.findJets(jetConstituents, jetReclustered));
@@ -104,6 +113,10 @@ struct JetSubstructureHFTask {
     std::vector<float> ptLeadingVec;
     std::vector<float> ptSubLeadingVec;
     std::vector<float> thetaVec;
+    splitZ.clear();
+    splitTheta.clear();
+    splitKt.clear();
+    splitMass.clear();
     while (daughterSubJet.has_parents(parentSubJet1, parentSubJet2)) {
 
       bool isHFInSubjet1 = false;
@@ -122,6 +135,10 @@ struct JetSubstructureHFTask {
       ptLeadingVec.push_back(parentSubJet1.pt());
       ptSubLeadingVec.push_back(parentSubJet2.pt());
       thetaVec.push_back(theta);
+      splitZ.push_back(z);
+      splitTheta.push_back(theta);
+      splitKt.push_back(parentSubJet2.perp() * std::sin(theta));
+      splitMass.push_back(daughterSubJet.m());
       if (z >= zCut * TMath::Power(theta / (jet.r() / 100.f), beta)) {
         if (!softDropped) {
           zg = z;
@@ -154,10 +171,11 @@ struct JetSubstructureHFTask {
       registry.fill(HIST("h2_jet_pt_jet_nsd_eventwiseconstituentsubtracted"), jet.pt(), nsd);
     }
     outputTable(energyMotherVec, ptLeadingVec, ptSubLeadingVec, thetaVec, nSub[0], nSub[1], nSub[2]);
+    splitsTable(splitZ, splitTheta, splitKt, splitMass);
   }
 
-  template <bool isSubtracted, typename T, typename U, typename V, typename M>
-  void analyseCharged(T const& jet, U const& tracks, V const& candidates, M& outputTable)
+  template <bool isSubtracted, typename T, typename U, typename V, typename M, typename S>
+  void analyseCharged(T const& jet, U const& tracks, V const& candidates, M& outputTable, S& splitsTable)
   {
 
     jetConstituents.clear();
@@ -168,7 +186,7 @@ struct JetSubstructureHFTask {
       fastjetutilities::fillTracks(jetHFCandidate, jetConstituents, jetHFCandidate.globalIndex(), static_cast<int>(JetConstituentStatus::candidateHF), candMass);
     }
     nSub = jetsubstructureutilities::getNSubjettiness(jet, tracks, tracks, candidates, 2, fastjet::contrib::CA_Axes(), true, zCut, beta);
-    jetReclustering<false, isSubtracted>(jet, outputTable);
+    jetReclustering<false, isSubtracted>(jet, outputTable, splitsTable);
   }
 
   void processDummy(JetTracks const&)
@@ -180,7 +198,7 @@ struct JetSubstructureHFTask {
                               CandidateTable const& candidates,
                               JetTracks const& tracks)
   {
-    analyseCharged<false>(jet, tracks, candidates, jetSubstructureDataTable);
+    analyseCharged<false>(jet, tracks, candidates, jetSubstructureDataTable, jetSplitsDataTable);
   }
   PROCESS_SWITCH(JetSubstructureHFTask, processChargedJetsData, "HF jet substructure on data", false);
 
@@ -188,7 +206,7 @@ struct JetSubstructureHFTask {
                                  CandidateTable const& candidates,
                                  TracksSub const& tracks)
   {
-    analyseCharged<true>(jet, tracks, candidates, jetSubstructureDataSubTable);
+    analyseCharged<true>(jet, tracks, candidates, jetSubstructureDataSubTable, jetSplitsDataSubTable);
   }
   PROCESS_SWITCH(JetSubstructureHFTask, processChargedJetsDataSub, "HF jet substructure on data", false);
 
@@ -196,7 +214,7 @@ struct JetSubstructureHFTask {
                              CandidateTable const& candidates,
                              JetTracks const& tracks)
   {
-    analyseCharged<false>(jet, tracks, candidates, jetSubstructureMCDTable);
+    analyseCharged<false>(jet, tracks, candidates, jetSubstructureMCDTable, jetSplitsMCDTable);
   }
   PROCESS_SWITCH(JetSubstructureHFTask, processChargedJetsMCD, "HF jet substructure on data", false);
 
@@ -212,13 +230,13 @@ struct JetSubstructureHFTask {
       fastjetutilities::fillTracks(jetHFCandidate, jetConstituents, jetHFCandidate.globalIndex(), static_cast<int>(JetConstituentStatus::candidateHF), candMass);
     }
     nSub = jetsubstructureutilities::getNSubjettiness(jet, particles, particles, candidates, 2, fastjet::contrib::CA_Axes(), true, zCut, beta);
-    jetReclustering<true, false>(jet, jetSubstructureMCPTable);
+    jetReclustering<true, false>(jet, jetSubstructureMCPTable, jetSplitsMCPTable);
   }
   PROCESS_SWITCH(JetSubstructureHFTask, processChargedJetsMCP, "HF jet substructure on MC particle level", false);
 };
-using JetSubstructureD0 = JetSubstructureHFTask<soa::Join<aod::D0ChargedJets, aod::D0ChargedJetConstituents>, soa::Join<aod::D0ChargedMCDetectorLevelJets, aod::D0ChargedMCDetectorLevelJetConstituents>, soa::Join<aod::D0ChargedMCParticleLevelJets, aod::D0ChargedMCParticleLevelJetConstituents>, soa::Join<aod::D0ChargedEventWiseSubtractedJets, aod::D0ChargedEventWiseSubtractedJetConstituents>, CandidatesD0Data, CandidatesD0MCP, aod::D0CJetSSs, aod::D0CMCDJetSSs, aod::D0CMCPJetSSs, aod::D0CEWSJetSSs, aod::JTrackD0Subs>;
-using JetSubstructureLc = JetSubstructureHFTask<soa::Join<aod::LcChargedJets, aod::LcChargedJetConstituents>, soa::Join<aod::LcChargedMCDetectorLevelJets, aod::LcChargedMCDetectorLevelJetConstituents>, soa::Join<aod::LcChargedMCParticleLevelJets, aod::LcChargedMCParticleLevelJetConstituents>, soa::Join<aod::LcChargedEventWiseSubtractedJets, aod::LcChargedEventWiseSubtractedJetConstituents>, CandidatesLcData, CandidatesLcMCP, aod::LcCJetSSs, aod::LcCMCDJetSSs, aod::LcCMCPJetSSs, aod::LcCEWSJetSSs, aod::JTrackLcSubs>;
-// using JetSubstructureBplus = JetSubstructureHFTask<soa::Join<aod::BplusChargedJets, aod::BplusChargedJetConstituents>,soa::Join<aod::BplusChargedMCDetectorLevelJets, aod::BplusChargedMCDetectorLevelJetConstituents>,soa::Join<aod::BplusChargedMCParticleLevelJets, aod::BplusChargedMCParticleLevelJetConstituents>,soa::Join<aod::BplusChargedEventWiseSubtractedJets, aod::BplusChargedEventWiseSubtractedJetConstituents>, CandidatesBplusData, CandidatesBplusMCP, aod::BplusCJetSSs,aod::BplusCMCDJetSSs,aod::BplusCMCPJetSSs, aod::BplusCEWSJetSSs, aod::JTrackBplusSubs>;
+using JetSubstructureD0 = JetSubstructureHFTask<soa::Join<aod::D0ChargedJets, aod::D0ChargedJetConstituents>, soa::Join<aod::D0ChargedMCDetectorLevelJets, aod::D0ChargedMCDetectorLevelJetConstituents>, soa::Join<aod::D0ChargedMCParticleLevelJets, aod::D0ChargedMCParticleLevelJetConstituents>, soa::Join<aod::D0ChargedEventWiseSubtractedJets, aod::D0ChargedEventWiseSubtractedJetConstituents>, CandidatesD0Data, CandidatesD0MCP, aod::D0CJetSSs, aod::D0CMCDJetSSs, aod::D0CMCPJetSSs, aod::D0CEWSJetSSs, aod::D0CJetSPs, aod::D0CMCDJetSPs, aod::D0CMCPJetSPs, aod::D0CEWSJetSPs, aod::JTrackD0Subs>;
+using JetSubstructureLc = JetSubstructureHFTask<soa::Join<aod::LcChargedJets, aod::LcChargedJetConstituents>, soa::Join<aod::LcChargedMCDetectorLevelJets, aod::LcChargedMCDetectorLevelJetConstituents>, soa::Join<aod::LcChargedMCParticleLevelJets, aod::LcChargedMCParticleLevelJetConstituents>, soa::Join<aod::LcChargedEventWiseSubtractedJets, aod::LcChargedEventWiseSubtractedJetConstituents>, CandidatesLcData, CandidatesLcMCP, aod::LcCJetSSs, aod::LcCMCDJetSSs, aod::LcCMCPJetSSs, aod::LcCEWSJetSSs, aod::LcCJetSPs, aod::LcCMCDJetSPs, aod::LcCMCPJetSPs, aod::LcCEWSJetSPs, aod::JTrackLcSubs>;
+// using JetSubstructureBplus = JetSubstructureHFTask<soa::Join<aod::BplusChargedJets, aod::BplusChargedJetConstituents>,soa::Join<aod::BplusChargedMCDetectorLevelJets, aod::BplusChargedMCDetectorLevelJetConstituents>,soa::Join<aod::BplusChargedMCParticleLevelJets, aod::BplusChargedMCParticleLevelJetConstituents>,soa::Join<aod::BplusChargedEventWiseSubtractedJets, aod::BplusChargedEventWiseSubtractedJetConstituents>, CandidatesBplusData, CandidatesBplusMCP, aod::BplusCJetSSs,aod::BplusCMCDJetSSs,aod::BplusCMCPJetSSs, aod::BplusCEWSJetSSs, aod::BplusCJetSPs, aod::BplusCMCDJetSPs, aod::BplusCMCPJetSPs, aod::BplusCEWSJetSPs, aod::JTrackBplusSubs>;
 
 WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
 {
@@ -79,6 +79,12 @@ struct epvector {
   std::vector<float> qvecRe;
   std::vector<float> qvecIm;
   std::vector<float> qvecAmp;
+  // cos(2 phi) and sin(2 phi) of the FT0 channels, with the offset of FT0-A for the
+  // first 96 and of FT0-C for the others, computed once from the alignment
+  std::vector<double> cos2PhiFT0;
+  std::vector<double> sin2PhiFT0;
+  // inverse of the gain of the FT0 channels, filled from the gain profile at each new run
+  std::vector<double> gainEqualFT0;
   HistogramRegistry histos{"histos", {}, OutputObjHandlingPolicy::AnalysisObject};
   // Configurable<bool> timFrameEvsel{"timFrameEvsel", false, "TPC Time frame boundary cut"};
   // Configurable<bool> additionalEvsel{"additionalEvsel", false, "Additional event selcection"};
@@ -171,6 +177,16 @@ struct epvector {
     printf("Offset for FT0C: x = %.3f y = %.3f\n", (*offsetFT0)[1].getX(), (*offsetFT0)[1].getY());
     printf("Offset for FV0-left: x = %.3f y = %.3f\n", (*offsetFV0)[0].getX(), (*offsetFV0)[0].getY());
     printf("Offset for FV0-right: x = %.3f y = %.3f\n", (*offsetFV0)[1].getX(), (*offsetFV0)[1].getY());
+
+    // GetPhiFT0 recomputes all the channel centers at each call
+    cos2PhiFT0.resize(nChannelsFT0);
+    sin2PhiFT0.resize(nChannelsFT0);
+    for (int iCh = 0; iCh < nChannelsFT0; iCh++) {
+      const int iOffset = iCh < nChannelsFT0A ? 0 : 1;
+      auto phi = GetPhiFT0(iCh, (*offsetFT0)[iOffset].getX(), (*offsetFT0)[iOffset].getY());
+      cos2PhiFT0[iCh] = TMath::Cos(2.0 * phi);
+      sin2PhiFT0[iCh] = TMath::Sin(2.0 * phi);
+    }
   }
 
   template <typename TCollision>
@@ -188,6 +204,9 @@ struct epvector {
     return 1;
   }
 
+  static constexpr int nChannelsFT0A = 96;
+  static constexpr int nChannelsFT0 = 208;
+
   double GetPhiFT0(int chno, double offsetX, double offsetY)
   {
     o2::ft0::Geometry ft0Det;
@@ -265,71 +284,76 @@ struct epvector {
       triggerevent = true;
       if (useGainCallib && (currentRunNumber != lastRunNumber)) {
         gainprofile = ccdb->getForTimeStamp<TProfile>(ConfGainPath.value, bc.timestamp());
+        gainEqualFT0.resize(nChannelsFT0);
+        for (int iCh = 0; iCh < nChannelsFT0; iCh++) {
+          gainEqualFT0[iCh] = 1 / gainprofile->GetBinContent(gainprofile->FindBin(iCh));
+        }
       }
 
       histos.fill(HIST("hCentrality"), centrality);
       histos.fill(HIST("Vz"), vz);
 
       auto ft0 = coll.foundFT0();
-      auto offsetFT0Ax = (*offsetFT0)[0].getX();
-      auto offsetFT0Ay = (*offsetFT0)[0].getY();
-      auto offsetFT0Cx = (*offsetFT0)[1].getX();
-      auto offsetFT0Cy = (*offsetFT0)[1].getY();
       for (std::size_t iChA = 0; iChA < ft0.channelA().size(); iChA++) {
         auto chanelid = ft0.channelA()[iChA];
         auto gainequal = 1.0;
         if (useGainCallib) {
-          gainequal = 1 / gainprofile->GetBinContent(gainprofile->FindBin(chanelid));
+          gainequal = gainEqualFT0[chanelid];
         }
         float ampl = gainequal * ft0.amplitudeA()[iChA];
         histos.fill(HIST("FT0Amp"), chanelid, ampl);
-        auto phiA = GetPhiFT0(chanelid, offsetFT0Ax, offsetFT0Ay);
-        qxFT0A = qxFT0A + ampl * TMath::Cos(2.0 * phiA);
-        qyFT0A = qyFT0A + ampl * TMath::Sin(2.0 * phiA);
+        qxFT0A = qxFT0A + ampl * cos2PhiFT0[chanelid];
+        qyFT0A = qyFT0A + ampl * sin2PhiFT0[chanelid];
       }
       for (std::size_t iChC = 0; iChC < ft0.channelC().size(); iChC++) {
         auto chanelid = ft0.channelC()[iChC] + 96;
         // printf("Offset for FT0A: x = %d y = %d\n", chanelid, chanelid-96);
         auto gainequal = 1.0;
         if (useGainCallib) {
-          gainequal = 1 / gainprofile->GetBinContent(gainprofile->FindBin(chanelid));
+          gainequal = gainEqualFT0[chanelid];
         }
         float ampl = gainequal * ft0.amplitudeC()[iChC];
         histos.fill(HIST("FT0Amp"), chanelid, ampl);
-        auto phiC = GetPhiFT0(chanelid, offsetFT0Cx, offsetFT0Cy);
-        qxFT0C = qxFT0C + ampl * TMath::Cos(2.0 * phiC);
-        qyFT0C = qyFT0C + ampl * TMath::Sin(2.0 * phiC);
+        qxFT0C = qxFT0C + ampl * cos2PhiFT0[chanelid];
+        qyFT0C = qyFT0C + ampl * sin2PhiFT0[chanelid];
       }
 
       for (auto& trk : tracks) {
         if (!selectionTrack(trk) || abs(trk.eta()) > 0.8 || trk.pt() > cfgCutPTMax || abs(trk.eta()) < cfgMinEta) {
           continue;
         }
-        qxTPC = qxTPC + trk.pt() * TMath::Cos(2.0 * trk.phi());
-        qyTPC = qyTPC + trk.pt() * TMath::Sin(2.0 * trk.phi());
+        const double cos2Phi = TMath::Cos(2.0 * trk.phi());
+        const double sin2Phi = TMath::Sin(2.0 * trk.phi());
+        qxTPC = qxTPC + trk.pt() * cos2Phi;
+        qyTPC = qyTPC + trk.pt() * sin2Phi;
         if (trk.eta() < 0.0) {
-          qxTPCL = qxTPCL + trk.pt() * TMath::Cos(2.0 * trk.phi());
-          qyTPCL = qyTPCL + trk.pt() * TMath::Sin(2.0 * trk.phi());
+          qxTPCL = qxTPCL + trk.pt() * cos2Phi;
+          qyTPCL = qyTPCL + trk.pt() * sin2Phi;
         }
         if (trk.eta() > 0.0) {
-          qxTPCR = qxTPCR + trk.pt() * TMath::Cos(2.0 * trk.phi());
-          qyTPCR = qyTPCR + trk.pt() * TMath::Sin(2.0 * trk.phi());
+          qxTPCR = qxTPCR + trk.pt() * cos2Phi;
+          qyTPCR = qyTPCR + trk.pt() * sin2Phi;
         }
       }
       if (useRecentere && (currentRunNumber != lastRunNumber)) {
         hrecentere = ccdb->getForTimeStamp<TH2D>(ConfRecentere.value, bc.timestamp());
       }
       if (useRecentere) {
-        qxFT0A = (qxFT0A - hrecentere->GetBinContent(hrecentere->FindBin(centrality, 0.5))) / hrecentere->GetBinError(hrecentere->FindBin(centrality, 0.5));
-        qyFT0A = (qyFT0A - hrecentere->GetBinContent(hrecentere->FindBin(centrality, 1.5))) / hrecentere->GetBinError(hrecentere->FindBin(centrality, 1.5));
-        qxFT0C = (qxFT0C - hrecentere->GetBinContent(hrecentere->FindBin(centrality, 2.5))) / hrecentere->GetBinError(hrecentere->FindBin(centrality, 2.5));
-        qyFT0C = (qyFT0C - hrecentere->GetBinContent(hrecentere->FindBin(centrality, 3.5))) / hrecentere->GetBinError(hrecentere->FindBin(centrality, 3.5));
-        qxTPC = (qxTPC - hrecentere->GetBinContent(hrecentere->FindBin(centrality, 4.5))) / hrecentere->GetBinError(hrecentere->FindBin(centrality, 4.5));
-        qyTPC = (qyTPC - hrecentere->GetBinContent(hrecentere->FindBin(centrality, 5.5))) / hrecentere->GetBinError(hrecentere->FindBin(centrality, 5.5));
-        qxTPCL = (qxTPCL - hrecentere->GetBinContent(hrecentere->FindBin(centrality, 6.5))) / hrecentere->GetBinError(hrecentere->FindBin(centrality, 6.5));
-        qyTPCL = (qyTPCL - hrecentere->GetBinContent(hrecentere->FindBin(centrality, 7.5))) / hrecentere->GetBinError(hrecentere->FindBin(centrality, 7.5));
-        qxTPCR = (qxTPCR - hrecentere->GetBinContent(hrecentere->FindBin(centrality, 8.5))) / hrecentere->GetBinError(hrecentere->FindBin(centrality, 8.5));
-        qyTPCR = (qyTPCR - hrecentere->GetBinContent(hrecentere->FindBin(centrality, 9.5))) / hrecentere->GetBinError(hrecentere->FindBin(centrality, 9.5));
+        // mean and width of the q-vector components in the y bins of the recentering histogram
+        auto recenter = [&](double q, double component) {
+          const int bin = hrecentere->FindBin(centrality, component);
+          return (q - hrecentere->GetBinContent(bin)) / hrecentere->GetBinError(bin);
+        };
+        qxFT0A = recenter(qxFT0A, 0.5);
+        qyFT0A = recenter(qyFT0A, 1.5);
+        qxFT0C = recenter(qxFT0C, 2.5);
+        qyFT0C = recenter(qyFT0C, 3.5);
+        qxTPC = recenter(qxTPC, 4.5);
+        qyTPC = recenter(qyTPC, 5.5);
+        qxTPCL = recenter(qxTPCL, 6.5);
+        qyTPCL = recenter(qyTPCL, 7.5);
+        qxTPCR = recenter(qxTPCR, 8.5);
+        qyTPCR = recenter(qyTPCR, 9.5);
       }
       psiFT0C = 0.5 * TMath::ATan2(qyFT0C, qxFT0C);
       psiFT0A = 0.5 * TMath::ATan2(qyFT0A, qxFT0A);
@@ -36,6 +36,7 @@
 #include "Framework/RunningWorkflowInfo.h"
 #include "Framework/StaticFor.h"
 #include "DataFormatsTPC/BetheBlochAleph.h"
+#include "Common/Core/PID/TPCPIDResponse.h"
 #include "TableHelper.h"
 
 using namespace o2;
@@ -104,6 +105,24 @@ struct bbParams {
   std::string ccdbPathPost = ""; // Path to the CCDB object for the post calib
   int lastRunNumber = 0;         // Last processed run
   bool isSimple = false;         // Flag to use only the Bethe-Bloch parameters without the charge exponent and the MIP value
+  bool useLut = false;           // Flag to evaluate the Bethe-Bloch parametrization from a lookup table, rebuilt when the parameters change
+  float lutMaxRelError = 1.e-4f; // Maximum relative interpolation error of the lookup table
+  mutable o2::pid::tpc::BetheBlochLookupTable lut;
+
+  ///
+  /// Evaluates the Bethe-Bloch parametrization at the given beta*gamma, from the lookup table if enabled
+  float betheBloch(const float bg) const
+  {
+    if (!useLut) {
+      return o2::tpc::BetheBlochAleph(bg, bb1, bb2, bb3, bb4, bb5);
+    }
+    const std::array<float, 5> params{bb1, bb2, bb3, bb4, bb5};
+    if (!lut.matches(params)) {
+      LOG(info) << "bbParams `" << name << "` :: building the Bethe-Bloch lookup table";
+      lut.build(params, lutMaxRelError);
+    }
+    return lut.eval(bg);
+  }
 
   ///
   /// Set the values of the BetheBloch from an array of parameters
@@ -458,6 +477,8 @@ struct lfTpcPid {
   Service<o2::ccdb::BasicCCDBManager> ccdb;
   Configurable<bool> skipTPCOnly{"skipTPCOnly", true, "Flag to skip TPC only tracks (faster but affects the analyses that use TPC only tracks)"};
   Configurable<bool> fatalOnNonExisting{"fatalOnNonExisting", true, "Fatal message if calibrations not found on the CCDB"};
+  Configurable<bool> useBetheBlochLut{"useBetheBlochLut", false, "Evaluate the Bethe-Bloch parametrizations from lookup tables in beta*gamma"};
+  Configurable<float> betheBlochLutMaxRelError{"betheBlochLutMaxRelError", 1.e-4f, "Maximum relative interpolation error of the Bethe-Bloch lookup tables"};
 
   // Parameters setting from json
   Configurable<LabeledArray<float>> bbParameters{"bbParameters",
@@ -510,9 +531,9 @@ struct lfTpcPid {
       corr = params.postCorrectionFun->Eval(track.tpcInnerParam());
     }
     if (params.isSimple) {
-      return o2::tpc::BetheBlochAleph(track.tpcInnerParam() * invmass, params.bb1, params.bb2, params.bb3, params.bb4, params.bb5) + corr;
+      return params.betheBloch(track.tpcInnerParam() * invmass) + corr;
     }
-    return params.mip * o2::tpc::BetheBlochAleph(track.tpcInnerParam() * invmass, params.bb1, params.bb2, params.bb3, params.bb4, params.bb5) * std::pow(charge, params.exp) + corr;
+    return params.mip * params.betheBloch(track.tpcInnerParam() * invmass) * std::pow(charge, params.exp) + corr;
   }
 
   template <o2::track::PID::ID id, typename T>
@@ -584,6 +605,8 @@ struct lfTpcPid {
   if (doprocess##Particle || doprocessFull##Particle) {                                                    \
     LOG(info) << "Enabling " << #Particle;                                                                 \
     bbPos##Particle.init(#Particle, bbParameters, fileParamBbPositive, ccdb);                              \
+    bbPos##Particle.useLut = useBetheBlochLut;                                                             \
+    bbPos##Particle.lutMaxRelError = betheBlochLutMaxRelError;                                             \
     auto h = histos.add<TH1>(Form("%s", #Particle), "", kTH1F, {{10, 0, 10}});                             \
     h->SetBit(TH1::kIsAverage);                                                                            \
     h->SetBinContent(1, bbPos##Particle.bb1);                                                              \
@@ -596,6 +619,8 @@ struct lfTpcPid {
     h->SetBinContent(8, bbPos##Particle.res);                                                              \
     h->SetBinContent(9, 1.f);                                                                              \
     bbNeg##Particle.init(#Particle, bbParameters, fileParamBbNegative, ccdb);                              \
+    bbNeg##Particle.useLut = useBetheBlochLut;                                                             \
+    bbNeg##Particle.lutMaxRelError = betheBlochLutMaxRelError;                                             \
     h = histos.add<TH1>(Form("Neg%s", #Particle), "", kTH1F, {{10, 0, 10}});                               \
     h->SetBit(TH1::kIsAverage);                                                                            \
     h->SetBinContent(1, bbNeg##Particle.bb1);                                                              \
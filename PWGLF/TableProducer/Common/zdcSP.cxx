@@ -118,6 +118,7 @@ struct zdcSP {
     ccdb->setURL("http://alice-ccdb.cern.ch");
     ccdb->setCaching(true);
     ccdb->setFatalWhenNull(false);
+    mRateFetcher.setUseRateTables();
   }
 
   Preslice<aod::Zdcs> zdcPerCollision = aod::collision::bcId;
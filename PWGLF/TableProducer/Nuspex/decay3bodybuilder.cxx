@@ -81,6 +81,7 @@ struct decay3bodyBuilder {
   Configurable<int> mintpcNCls{"mintpcNCls", 70, "min tpc Nclusters"};
   Configurable<float> minCosPA3body{"minCosPA3body", 0.9, "minCosPA3body"};
   Configurable<float> dcavtxdau{"dcavtxdau", 1.0, "DCA Vtx Daughters"};
+  Configurable<float> maxDcaDau01PreFit{"maxDcaDau01PreFit", -1., "max DCA between track0 and track1 from a 2-prong fit, checked before the 3-body fit (no selection if negative)"};
 
   Configurable<int> useMatCorrType{"useMatCorrType", 0, "0: none, 1: TGeo, 2: LUT"};
   // CCDB options
@@ -104,6 +105,7 @@ struct decay3bodyBuilder {
   float maxStep; // max step size (cm) for propagation
   o2::base::MatLayerCylSet* lut = nullptr;
   o2::vertexing::DCAFitterN<3> fitter3body;
+  o2::vertexing::DCAFitterN<2> fitter2body; // prefilter on the closest approach of track0 and track1
   o2::pid::tof::TOFResoParamsV2 mRespParamsV2;
 
   void init(InitContext&)
@@ -119,6 +121,13 @@ struct decay3bodyBuilder {
     fitter3body.setMaxDZIni(1e9);
     fitter3body.setMaxChi2(1e9);
     fitter3body.setUseAbsDCA(d_UseAbsDCA);
+    fitter2body.setPropagateToPCA(false);
+    fitter2body.setMaxR(200.);
+    fitter2body.setMinParamChange(1e-3);
+    fitter2body.setMinRelChi2Change(0.9);
+    fitter2body.setMaxDZIni(1e9);
+    fitter2body.setMaxChi2(1e9);
+    fitter2body.setUseAbsDCA(true);
 
     // Material correction in the DCA fitter
 
@@ -152,6 +161,7 @@ struct decay3bodyBuilder {
       matCorr = o2::base::Propagator::MatCorrType::USEMatCorrLUT;
 
     fitter3body.setMatCorrType(matCorr);
+    fitter2body.setMatCorrType(matCorr);
   }
 
   void initCCDB(aod::BCsWithTimestamps::iterator const& bc)
@@ -164,6 +174,7 @@ struct decay3bodyBuilder {
     if (d_bz_input > -990) {
       d_bz = d_bz_input;
       fitter3body.setBz(d_bz);
+      fitter2body.setBz(d_bz);
       o2::parameters::GRPMagField grpmag;
       if (fabs(d_bz) > 1e-5) {
         grpmag.setL3Current(30000.f / (d_bz / 5.0f));
@@ -194,6 +205,7 @@ struct decay3bodyBuilder {
     mRunNumber = bc.runNumber();
     // Set magnetic field value once known
     fitter3body.setBz(d_bz);
+    fitter2body.setBz(d_bz);
 
     if (useMatCorrType == 2) {
       // setMatLUT only after magfield has been initalized
@@ -292,24 +304,17 @@ struct decay3bodyBuilder {
       }
       registry.fill(HIST("hVtx3BodyCounter"), kVtxTPCNcls);
 
-      // Calculate DCA with respect to the collision associated to the V0, not individual tracks
-      gpu::gpustd::array<float, 2> dcaInfo;
-
-      auto Track0Par = getTrackPar(t0);
-      o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, Track0Par, 2.f, fitter3body.getMatCorrType(), &dcaInfo);
-      auto Track0dcaXY = dcaInfo[0];
-
-      auto Track1Par = getTrackPar(t1);
-      o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, Track1Par, 2.f, fitter3body.getMatCorrType(), &dcaInfo);
-      auto Track1dcaXY = dcaInfo[0];
-
-      auto Track2Par = getTrackPar(t2);
-      o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, Track2Par, 2.f, fitter3body.getMatCorrType(), &dcaInfo);
-      auto Track2dcaXY = dcaInfo[0];
-
       auto Track0 = getTrackParCov(t0);
       auto Track1 = getTrackParCov(t1);
       auto Track2 = getTrackParCov(t2);
+
+      // reject the candidates whose first two daughters do not approach each other, before the costlier 3-body fit
+      if (maxDcaDau01PreFit >= 0.) {
+        if (fitter2body.process(Track0, Track1) == 0 || std::sqrt(fitter2body.getChi2AtPCACandidate()) > maxDcaDau01PreFit) {
+          continue;
+        }
+      }
+
       int n3bodyVtx = fitter3body.process(Track0, Track1, Track2);
       if (n3bodyVtx == 0) { // discard this pair
         continue;
@@ -345,6 +350,22 @@ struct decay3bodyBuilder {
       }
       registry.fill(HIST("hVtx3BodyCounter"), kVtxCosPA);
 
+      // Calculate DCA with respect to the collision associated to the V0, not individual tracks
+      // only for the selected candidates, the propagations to the primary vertex being as costly as the fit
+      gpu::gpustd::array<float, 2> dcaInfo;
+
+      auto Track0Par = getTrackPar(t0);
+      o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, Track0Par, 2.f, fitter3body.getMatCorrType(), &dcaInfo);
+      auto Track0dcaXY = dcaInfo[0];
+
+      auto Track1Par = getTrackPar(t1);
+      o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, Track1Par, 2.f, fitter3body.getMatCorrType(), &dcaInfo);
+      auto Track1dcaXY = dcaInfo[0];
+
+      auto Track2Par = getTrackPar(t2);
+      o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, Track2Par, 2.f, fitter3body.getMatCorrType(), &dcaInfo);
+      auto Track2dcaXY = dcaInfo[0];
+
       // Recalculate the TOF PID
       double tofNsigmaDe = -999;
       static constexpr float kCSPEED = TMath::C() * 1.0e2f * 1.0e-12f; // c in cm/ps
@@ -12,6 +12,7 @@
 #include <vector>
 #include <utility>
 #include <random>
+#include <unordered_set>
 
 #include "Framework/runDataProcessing.h"
 #include "Framework/AnalysisTask.h"
@@ -156,6 +157,8 @@ struct ebyeMaker {
   std::mt19937 gen32;
   std::vector<CandidateV0> candidateV0s;
   std::array<std::vector<CandidateTrack>, 2> candidateTracks;
+  std::unordered_set<int64_t> recoMcIndicesV0;                    // MC particles of the reconstructed V0 candidates of the current collision
+  std::array<std::unordered_set<int64_t>, 2> recoMcIndicesTracks; // MC particles of the reconstructed track candidates of the current collision
   Service<o2::ccdb::BasicCCDBManager> ccdb;
   o2::vertexing::DCAFitterN<2> fitter;
 
@@ -687,6 +690,18 @@ struct ebyeMaker {
 
   void fillMcGen(aod::McParticles const& mcParticles, aod::McTrackLabels const& /*mcLab*/, uint64_t const& collisionId)
   {
+    // MC particles already matched to a reconstructed candidate, looked up instead of searching the candidates for each particle
+    recoMcIndicesV0.clear();
+    for (const auto& candidateV0 : candidateV0s) {
+      recoMcIndicesV0.insert(candidateV0.mcIndex);
+    }
+    for (int iP{0}; iP < kNpart; ++iP) {
+      recoMcIndicesTracks[iP].clear();
+      for (const auto& candidateTrack : candidateTracks[iP]) {
+        recoMcIndicesTracks[iP].insert(candidateTrack.mcIndex);
+      }
+    }
+
     auto mcParticles_thisCollision = mcParticles.sliceBy(perCollisionMcParts, collisionId);
     for (auto& mcPart : mcParticles_thisCollision) {
       auto genEta = mcPart.eta();
@@ -714,11 +729,10 @@ struct ebyeMaker {
         candV0.genpt = genPt;
         candV0.geneta = mcPart.eta();
         candV0.pdgcode = pdgCode;
-        auto it = find_if(candidateV0s.begin(), candidateV0s.end(), [&](CandidateV0 v0) { return v0.mcIndex == mcPart.globalIndex(); });
-        if (it != candidateV0s.end()) {
+        if (recoMcIndicesV0.count(mcPart.globalIndex())) {
           continue;
         } else {
-          LOGF(info, "not found!");
+          LOGF(debug, "not found!");
           candidateV0s.emplace_back(candV0);
         }
       } else if (std::abs(pdgCode) == partPdg[0] || std::abs(pdgCode) == partPdg[1]) {
@@ -733,8 +747,7 @@ struct ebyeMaker {
         candTrack.genpt = genPt;
         candTrack.geneta = mcPart.eta();
         candTrack.pdgcode = pdgCode;
-        auto it = find_if(candidateTracks[iP].begin(), candidateTracks[iP].end(), [&](CandidateTrack trk) { return trk.mcIndex == mcPart.globalIndex(); });
-        if (it != candidateTracks[iP].end()) {
+        if (recoMcIndicesTracks[iP].count(mcPart.globalIndex())) {
           continue;
         } else {
           candidateTracks[iP].emplace_back(candTrack);
@@ -42,6 +42,7 @@
 #include <map>
 #include <iterator>
 #include <utility>
+#include <vector>
 
 #include "Framework/runDataProcessing.h"
 #include "Framework/RunningWorkflowInfo.h"
@@ -54,6 +55,7 @@
 #include "Common/Core/trackUtilities.h"
 #include "PWGLF/DataModel/LFStrangenessTables.h"
 #include "PWGLF/DataModel/LFParticleIdentification.h"
+#include "PWGLF/Utils/strangenessBuilderPrefilter.h"
 #include "Common/Core/TrackSelection.h"
 #include "Common/DataModel/TrackSelectionTables.h"
 #include "DetectorsBase/Propagator.h"
@@ -63,6 +65,7 @@
 #include "CCDB/BasicCCDBManager.h"
 #include "Tools/ML/MlResponse.h"
 #include "Tools/ML/model.h"
+#include "Tools/ML/FeatureBuffer.h"
 
 #ifndef HomogeneousField
 #define HomogeneousField
@@ -186,6 +189,13 @@ struct cascadeBuilder {
     Configurable<float> dQAOmegaMassWindow{"qaConfigurations.dQAOmegaMassWindow", 0.005, "Omega mass window for ITS cluster map QA"};
   } qaConfigurations;
 
+  // Analytic prefilter on the bachelor helix and the V0 line, before the propagation and the DCA fitter
+  struct : ConfigurableGroup {
+    Configurable<bool> usePrefilter{"prefilterConfigurations.usePrefilter", false, "Reject the cascades that cannot pass the DCA selections with analytic helix calculations"};
+    Configurable<float> marginDCAToPV{"prefilterConfigurations.marginDCAToPV", 0.01, "Margin on the analytic DCAxy of the bachelor to the PV (cm)"};
+    Configurable<float> marginDCADau{"prefilterConfigurations.marginDCADau", 0.1, "Margin on the analytic DCAxy between the V0 and the bachelor (cm), only used with absolute DCAs"};
+  } prefilterConfigurations;
+
   // for KF particle operation
   Configurable<bool> kfTuneForOmega{"kfTuneForOmega", false, "if enabled, take main cascade properties from Omega fit instead of Xi fit (= default)"};
   Configurable<int> kfConstructMethod{"kfConstructMethod", 2, "KF Construct Method"};
@@ -230,6 +240,9 @@ struct cascadeBuilder {
     Configurable<float> thresholdXiPlus{"mlConfigurations.thresholdXiPlus", -1.0f, "Threshold to keep XiPlus candidates"};
     Configurable<float> thresholdOmegaMinus{"mlConfigurations.thresholdOmegaMinus", -1.0f, "Threshold to keep OmegaMinus candidates"};
     Configurable<float> thresholdOmegaPlus{"mlConfigurations.thresholdOmegaPlus", -1.0f, "Threshold to keep OmegaPlus candidates"};
+
+    // batched inference: the candidates of a dataframe are scored together, with one inference call per model
+    Configurable<bool> batchedInference{"mlConfigurations.batchedInference", false, "Score the cascade candidates of a dataframe in one inference call per model (DCAFitter building only)"};
   } mlConfigurations;
 
   // round some V0 core variables up to a certain level of precision if requested
@@ -270,7 +283,7 @@ struct cascadeBuilder {
                   kNCascSteps };
 
   // Helper struct to pass cascade information
-  struct {
+  struct CascadeCandidate {
     int v0Id;
     int positiveId;
     int negativeId;
@@ -316,6 +329,35 @@ struct cascadeBuilder {
     float mlOmegaPlusScore;
   } cascadecandidate;
 
+  // Cascade candidates waiting for the batched ML scores, with what is needed to fill the tables
+  struct PendingCascade {
+    CascadeCandidate candidate;
+    int64_t cascadeId;
+    int64_t collisionId;
+    std::array<float, 6> positionCovariance;
+    std::array<float, 6> momentumCovariance;
+  };
+  std::vector<PendingCascade> pendingCascades;
+  o2::ml::FeatureBuffer mlFeatureBuffer; // columnar ML features of the pending cascades, reused between dataframes
+  std::vector<float> mlScores;
+  bool deferMLSelection = false; // ML scoring deferred to the end of the dataframe
+
+  // V0 quantities of the KF building which do not depend on the bachelor, computed once per V0
+  // and reused by all the cascades sharing the same V0
+  enum v0PreFitStatus { kV0PreFitNotDone = 0,
+                        kV0PreFitFailed,
+                        kV0PreFitOK };
+  struct V0PreFit {
+    int64_t collisionId = -2; // collision of the daughter DCAs to the PV, -2 if not calculated
+    float dcaPosToPV = 0.f;
+    float dcaNegToPV = 0.f;
+    int fitStatus = kV0PreFitNotDone; // DCAFitter pre-minimisation of the V0
+    float dcaV0Dau = 0.f;
+    o2::track::TrackParCov posTrack; // daughters at the PCA
+    o2::track::TrackParCov negTrack;
+  };
+  std::vector<V0PreFit> v0PreFits; // by V0 global index, cleared for every DF
+
   o2::track::TrackParCov lBachelorTrack;
   o2::track::TrackParCov lV0Track;
   o2::track::TrackParCov lCascadeTrack;
@@ -694,6 +736,8 @@ struct cascadeBuilder {
     if (mRunNumber == bc.runNumber()) {
       return;
     }
+    // the cached V0 fits depend on the magnetic field
+    v0PreFits.clear();
 
     // machine learning initialization if requested
     if (mlConfigurations.calculateXiMinusScores ||
@@ -974,6 +1018,16 @@ struct cascadeBuilder {
     }
     statisticsRegistry.cascstats[kBachTPCrefit]++;
 
+    // Analytic prefilter: transverse DCA of the bachelor helix, which does not require any propagation
+    o2::math_utils::CircleXYf_t bachCircle;
+    const bool usePrefilter = prefilterConfigurations.usePrefilter && std::abs(d_bz) > 1e-5;
+    if (usePrefilter) {
+      float sna, csa;
+      getTrackPar(bachTrack).getCircleParams(d_bz, bachCircle, sna, csa);
+      if (o2::pwglf::dcaXYHelixToPoint(bachCircle, collision.posX(), collision.posY()) + prefilterConfigurations.marginDCAToPV < dcabachtopv)
+        return false;
+    }
+
     // bachelor DCA track to PV
     // Calculate DCA with respect to the collision associated to the V0, not individual tracks
     gpu::gpustd::array<float, 2> dcaInfo;
@@ -986,6 +1040,11 @@ struct cascadeBuilder {
       return false;
     statisticsRegistry.cascstats[kBachDCAxy]++;
 
+    // the bachelor cannot get closer to the V0 line than the transverse DCA of its helix
+    if (usePrefilter && d_UseAbsDCA &&
+        o2::pwglf::dcaXYHelixToLine(bachCircle, v0.x(), v0.y(), v0.pxpos() + v0.pxneg(), v0.pypos() + v0.pyneg()) > o2::pwglf::DCAFitterDistanceScale * dcacascdau + prefilterConfigurations.marginDCADau)
+      return false;
+
     // Do actual minimization
     lBachelorTrack = getTrackParCov(bachTrack);
 
@@ -1179,10 +1238,11 @@ struct cascadeBuilder {
     cascadecandidate.mlOmegaMinusScore = -1.0f;
     cascadecandidate.mlOmegaPlusScore = -1.0f;
 
-    if (mlConfigurations.calculateXiMinusScores ||
-        mlConfigurations.calculateXiPlusScores ||
-        mlConfigurations.calculateOmegaMinusScores ||
-        mlConfigurations.calculateOmegaPlusScores) {
+    if (!deferMLSelection &&
+        (mlConfigurations.calculateXiMinusScores ||
+         mlConfigurations.calculateXiPlusScores ||
+         mlConfigurations.calculateOmegaMinusScores ||
+         mlConfigurations.calculateOmegaPlusScores)) {
       // machine learning is on, go for calculation of thresholds
       // FIXME THIS NEEDS ADJUSTING
       std::vector<float> inputFeatures{0.0f, 0.0f,
@@ -1259,12 +1319,21 @@ struct cascadeBuilder {
     o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, bachTrackPar, 2.f, fitter.getMatCorrType(), &dcaInfo);
     cascadecandidate.bachDCAxy = dcaInfo[0];
 
-    o2::track::TrackParCov posTrackParCovForDCA = getTrackParCov(posTrack);
-    o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, posTrackParCovForDCA, 2.f, fitter.getMatCorrType(), &dcaInfo);
-    cascadecandidate.v0dcapostopv = dcaInfo[0];
-    o2::track::TrackParCov negTrackParCovForDCA = getTrackParCov(negTrack);
-    o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, negTrackParCovForDCA, 2.f, fitter.getMatCorrType(), &dcaInfo);
-    cascadecandidate.v0dcanegtopv = dcaInfo[0];
+    if (v0PreFits.size() <= static_cast<std::size_t>(v0.globalIndex())) {
+      v0PreFits.resize(v0.globalIndex() + 1);
+    }
+    auto& v0PreFit = v0PreFits[v0.globalIndex()];
+    if (v0PreFit.collisionId != collision.globalIndex()) {
+      o2::track::TrackParCov posTrackParCovForDCA = getTrackParCov(posTrack);
+      o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, posTrackParCovForDCA, 2.f, fitter.getMatCorrType(), &dcaInfo);
+      v0PreFit.dcaPosToPV = dcaInfo[0];
+      o2::track::TrackParCov negTrackParCovForDCA = getTrackParCov(negTrack);
+      o2::base::Propagator::Instance()->propagateToDCABxByBz({collision.posX(), collision.posY(), collision.posZ()}, negTrackParCovForDCA, 2.f, fitter.getMatCorrType(), &dcaInfo);
+      v0PreFit.dcaNegToPV = dcaInfo[0];
+      v0PreFit.collisionId = collision.globalIndex();
+    }
+    cascadecandidate.v0dcapostopv = v0PreFit.dcaPosToPV;
+    cascadecandidate.v0dcanegtopv = v0PreFit.dcaNegToPV;
 
     if (TMath::Abs(cascadecandidate.bachDCAxy) < dcabachtopv)
       return false;
@@ -1286,22 +1355,31 @@ struct cascadeBuilder {
     //*>~<* step 1 : V0 with dca fitter, uses material corrections implicitly
     // This is optional - move close to minima and therefore take material
     if (kfDoDCAFitterPreMinimV0) {
-      int nCand = 0;
-      try {
-        nCand = fitter.process(posTrackParCov, negTrackParCov);
-      } catch (...) {
-        LOG(error) << "Exception caught in DCA fitter process call!";
-        return false;
+      // the fit of the V0 is done at its first use only
+      if (v0PreFit.fitStatus == kV0PreFitNotDone) {
+        v0PreFit.fitStatus = kV0PreFitFailed;
+        int nCand = 0;
+        try {
+          nCand = fitter.process(posTrackParCov, negTrackParCov);
+        } catch (...) {
+          LOG(error) << "Exception caught in DCA fitter process call!";
+        }
+        if (nCand > 0) {
+          v0PreFit.fitStatus = kV0PreFitOK;
+          v0PreFit.dcaV0Dau = TMath::Sqrt(fitter.getChi2AtPCACandidate());
+          v0PreFit.posTrack = fitter.getTrack(0);
+          v0PreFit.negTrack = fitter.getTrack(1);
+        }
       }
-      if (nCand == 0) {
+      if (v0PreFit.fitStatus != kV0PreFitOK) {
         return false;
       }
       // save classical DCA daughters
-      cascadecandidate.v0dcadau = TMath::Sqrt(fitter.getChi2AtPCACandidate());
+      cascadecandidate.v0dcadau = v0PreFit.dcaV0Dau;
 
       // re-acquire from DCA fitter
-      posTrackParCov = fitter.getTrack(0);
-      negTrackParCov = fitter.getTrack(1);
+      posTrackParCov = v0PreFit.posTrack;
+      negTrackParCov = v0PreFit.negTrack;
     }
 
     //__________________________________________
@@ -1546,9 +1624,44 @@ struct cascadeBuilder {
     if (roundDCAVariables)
       roundCascadeCandidateVariables();
 
-    cascidx(/*cascadecandidate.v0Id, */ cascade.globalIndex(),
+    std::array<float, 6> positionCovariance = {0.};
+    std::array<float, 6> momentumCovariance = {0.};
+    if (createCascCovMats) {
+      // Calculate position covariance matrix
+      auto covVtxV = fitter.calcPCACovMatrix(0);
+      positionCovariance[0] = covVtxV(0, 0);
+      positionCovariance[1] = covVtxV(1, 0);
+      positionCovariance[2] = covVtxV(1, 1);
+      positionCovariance[3] = covVtxV(2, 0);
+      positionCovariance[4] = covVtxV(2, 1);
+      positionCovariance[5] = covVtxV(2, 2);
+      // store momentum covariance matrix
+      std::array<float, 21> covTv0 = {0.};
+      std::array<float, 21> covTbachelor = {0.};
+      lV0Track.getCovXYZPxPyPzGlo(covTv0);
+      lBachelorTrack.getCovXYZPxPyPzGlo(covTbachelor);
+      constexpr int MomInd[6] = {9, 13, 14, 18, 19, 20}; // cov matrix elements for momentum component
+      for (int i = 0; i < 6; i++) {
+        momentumCovariance[i] = covTv0[MomInd[i]] + covTbachelor[MomInd[i]];
+      }
+    }
+
+    if (deferMLSelection) {
+      // keep the candidate until the scores of the whole dataframe are known
+      pendingCascades.push_back({cascadecandidate, cascade.globalIndex(), cascade.collisionId(), positionCovariance, momentumCovariance});
+      // FIXME THIS NEEDS ADJUSTING, same features as in buildCascadeCandidate
+      mlFeatureBuffer.addCandidate({0.0f, 0.0f,
+                                    0.0f, 0.0f});
+      return;
+    }
+    fillCascadeTables(cascade.globalIndex(), cascade.collisionId(), positionCovariance, momentumCovariance);
+  }
+
+  void fillCascadeTables(int64_t cascadeId, int64_t collisionId, const std::array<float, 6>& positionCovariance, const std::array<float, 6>& momentumCovariance)
+  {
+    cascidx(/*cascadecandidate.v0Id, */ cascadeId,
             cascadecandidate.positiveId, cascadecandidate.negativeId,
-            cascadecandidate.bachelorId, cascade.collisionId());
+            cascadecandidate.bachelorId, collisionId);
     cascdata(cascadecandidate.charge, cascadecandidate.mXi, cascadecandidate.mOmega,
              cascadecandidate.pos[0], cascadecandidate.pos[1], cascadecandidate.pos[2],
              cascadecandidate.v0pos[0], cascadecandidate.v0pos[1], cascadecandidate.v0pos[2],
@@ -1568,35 +1681,73 @@ struct cascadeBuilder {
 
     // populate cascade covariance matrices if required by any other task
     if (createCascCovMats) {
-      // Calculate position covariance matrix
-      auto covVtxV = fitter.calcPCACovMatrix(0);
-      // std::array<float, 6> positionCovariance;
-      float positionCovariance[6];
-      positionCovariance[0] = covVtxV(0, 0);
-      positionCovariance[1] = covVtxV(1, 0);
-      positionCovariance[2] = covVtxV(1, 1);
-      positionCovariance[3] = covVtxV(2, 0);
-      positionCovariance[4] = covVtxV(2, 1);
-      positionCovariance[5] = covVtxV(2, 2);
-      // store momentum covariance matrix
-      std::array<float, 21> covTv0 = {0.};
-      std::array<float, 21> covTbachelor = {0.};
-      // std::array<float, 6> momentumCovariance;
-      float momentumCovariance[6];
-      lV0Track.getCovXYZPxPyPzGlo(covTv0);
-      lBachelorTrack.getCovXYZPxPyPzGlo(covTbachelor);
-      constexpr int MomInd[6] = {9, 13, 14, 18, 19, 20}; // cov matrix elements for momentum component
-      for (int i = 0; i < 6; i++) {
-        momentumCovariance[i] = covTv0[MomInd[i]] + covTbachelor[MomInd[i]];
+      casccovs(positionCovariance.data(), momentumCovariance.data());
+    }
+  }
+
+  // Scores the pending cascades with one inference call per model, then fills the tables
+  // of the candidates passing the thresholds, in building order
+  void evaluatePendingCascades()
+  {
+    const size_t nPending = pendingCascades.size();
+    if (nPending > 0) {
+      for (auto& pending : pendingCascades) {
+        pending.candidate.mlXiMinusScore = -1.0f;
+        pending.candidate.mlXiPlusScore = -1.0f;
+        pending.candidate.mlOmegaMinusScore = -1.0f;
+        pending.candidate.mlOmegaPlusScore = -1.0f;
+      }
+      auto scorePending = [&](o2::ml::OnnxModel& model, float CascadeCandidate::*score) {
+        const size_t nScores = mlFeatureBuffer.evaluate(model, mlScores);
+        if (nScores < 2) {
+          LOG(fatal) << "Batched inference of " << nPending << " cascades failed, the models must provide the two class probabilities per candidate!";
+        }
+        for (size_t iPending = 0; iPending < nPending; iPending++) {
+          pendingCascades[iPending].candidate.*score = mlScores[iPending * nScores + 1];
+        }
+      };
+      if (mlConfigurations.calculateXiMinusScores)
+        scorePending(mlModelXiMinus, &CascadeCandidate::mlXiMinusScore);
+      if (mlConfigurations.calculateXiPlusScores)
+        scorePending(mlModelXiPlus, &CascadeCandidate::mlXiPlusScore);
+      if (mlConfigurations.calculateOmegaMinusScores)
+        scorePending(mlModelOmegaMinus, &CascadeCandidate::mlOmegaMinusScore);
+      if (mlConfigurations.calculateOmegaPlusScores)
+        scorePending(mlModelOmegaPlus, &CascadeCandidate::mlOmegaPlusScore);
+
+      for (const auto& pending : pendingCascades) {
+        // Skip anything that doesn't fulfull any of the desired conditions
+        if (pending.candidate.mlXiMinusScore < mlConfigurations.thresholdXiMinus.value &&
+            pending.candidate.mlXiPlusScore < mlConfigurations.thresholdXiPlus.value &&
+            pending.candidate.mlOmegaMinusScore < mlConfigurations.thresholdOmegaMinus.value &&
+            pending.candidate.mlOmegaPlusScore < mlConfigurations.thresholdOmegaPlus.value) {
+          continue; // skipped as uninteresting in any hypothesis considered
+        }
+        cascadecandidate = pending.candidate;
+        fillCascadeTables(pending.cascadeId, pending.collisionId, pending.positionCovariance, pending.momentumCovariance);
       }
-      casccovs(positionCovariance, momentumCovariance);
     }
+    pendingCascades.clear();
+    deferMLSelection = false;
+  }
+
+  // Enables the deferred ML selection of the dataframe, if batched inference is requested
+  void startPendingCascades()
+  {
+    deferMLSelection = mlConfigurations.batchedInference &&
+                       (mlConfigurations.calculateXiMinusScores ||
+                        mlConfigurations.calculateXiPlusScores ||
+                        mlConfigurations.calculateOmegaMinusScores ||
+                        mlConfigurations.calculateOmegaPlusScores);
+    pendingCascades.clear();
+    mlFeatureBuffer.reset(4);
   }
 
   template <class TTrackTo, typename TCascTable>
   void buildStrangenessTables(TCascTable const& cascades)
   {
     statisticsRegistry.eventCounter++;
+    startPendingCascades();
     for (auto& cascade : cascades) {
       // de-reference from V0 pool, either specific for cascades or general
       // use templatizing to avoid code duplication
@@ -1604,6 +1755,7 @@ struct cascadeBuilder {
       auto v0index = cascade.template v0_as<aod::V0sLinked>();
       processCascadeCandidate<TTrackTo>(v0index, cascade);
     }
+    evaluatePendingCascades();
     // En masse filling at end of process call
     fillHistos();
     resetHistos();
@@ -1613,6 +1765,7 @@ struct cascadeBuilder {
   void buildFindableStrangenessTables(TCascTable const& cascades)
   {
     statisticsRegistry.eventCounter++;
+    startPendingCascades();
     for (auto& cascade : cascades) {
       // de-reference from V0 pool, either specific for cascades or general
       // use templatizing to avoid code duplication
@@ -1620,6 +1773,7 @@ struct cascadeBuilder {
       auto v0index = cascade.template findableV0_as<aod::FindableV0sLinked>();
       processCascadeCandidate<TTrackTo>(v0index, cascade);
     }
+    evaluatePendingCascades();
     // En masse filling at end of process call
     fillHistos();
     resetHistos();
@@ -1934,6 +2088,7 @@ struct cascadeBuilder {
 
   void processRun3withKFParticle(aod::Collisions const& collisions, soa::Filtered<TaggedCascades> const& cascades, FullTracksExtIU const&, aod::BCsWithTimestamps const&, aod::V0s const&)
   {
+    v0PreFits.clear();
     for (const auto& collision : collisions) {
       // Fire up CCDB
       auto bc = collision.bc_as<aod::BCsWithTimestamps>();
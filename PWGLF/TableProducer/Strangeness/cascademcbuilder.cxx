@@ -22,6 +22,8 @@
 #include <array>
 #include <cstdlib>
 #include <map>
+#include <tuple>
+#include <vector>
 #include <iterator>
 #include <utility>
 
@@ -87,6 +89,12 @@ struct cascademcbuilder {
     int mcParticleBachelor;
   };
   mcCascinfo thisInfo;
+
+  // to be used if using the asymmetric mode, kept empty otherwise
+  // members, so that their capacity is kept from one dataframe to the next
+  std::vector<mcCascinfo> mcCascinfos;                        // CascMCCore information
+  std::map<std::tuple<int, int, int>, int> mcCascinfoIndices; // pos, neg, bach mc particles -> index in mcCascinfos
+  std::vector<bool> mcParticleIsReco;                         // mc Particle not recoed by cascades
   //*+-+*+-+*+-+*+-+*+-+*+-+*+-+*+-+*+-+*+-+*
 
   void init(InitContext const&) {}
@@ -95,9 +103,9 @@ struct cascademcbuilder {
   void generateCascadeMCinfo(TCascadeTable cascTable, TMCParticleTable mcParticles)
   {
 
-    // to be used if using the asymmetric mode, kept empty otherwise
-    std::vector<mcCascinfo> mcCascinfos;                           // V0MCCore information
-    std::vector<bool> mcParticleIsReco(mcParticles.size(), false); // mc Particle not recoed by V0s
+    mcCascinfos.clear();
+    mcCascinfoIndices.clear();
+    mcParticleIsReco.assign(mcParticles.size(), false);
 
     for (auto& casc : cascTable) {
       thisInfo.pdgCode = -1, thisInfo.pdgCodeMother = -1;
@@ -215,18 +223,20 @@ struct cascademcbuilder {
         int thisCascMCCoreIndex = -1;
         // step 1: check if this element is already provided in the table
         //         using the packedIndices variable calculated above
-        for (uint32_t ii = 0; ii < mcCascinfos.size(); ii++) {
-          if (
-            thisInfo.mcParticlePositive == mcCascinfos[ii].mcParticlePositive && mcCascinfos[ii].mcParticlePositive > 0 &&
-            thisInfo.mcParticleNegative == mcCascinfos[ii].mcParticleNegative && mcCascinfos[ii].mcParticleNegative > 0 &&
-            thisInfo.mcParticleBachelor == mcCascinfos[ii].mcParticleBachelor && mcCascinfos[ii].mcParticleBachelor > 0) {
-            thisCascMCCoreIndex = ii;
-            break; // this exists already in list
+        const bool hasAllProngs = thisInfo.mcParticlePositive > 0 && thisInfo.mcParticleNegative > 0 && thisInfo.mcParticleBachelor > 0;
+        const auto prongs = std::make_tuple(thisInfo.mcParticlePositive, thisInfo.mcParticleNegative, thisInfo.mcParticleBachelor);
+        if (hasAllProngs) {
+          auto found = mcCascinfoIndices.find(prongs);
+          if (found != mcCascinfoIndices.end()) {
+            thisCascMCCoreIndex = found->second; // this exists already in list
           }
         }
         if (thisCascMCCoreIndex < 0) {
           // this CascMCCore does not exist yet. Create it and reference it
           thisCascMCCoreIndex = mcCascinfos.size();
+          if (hasAllProngs) {
+            mcCascinfoIndices.emplace(prongs, thisCascMCCoreIndex);
+          }
           mcCascinfos.push_back(thisInfo);
         }
         cascCoreMClabels(thisCascMCCoreIndex); // interlink: reconstructed -> MC index
@@ -278,7 +288,7 @@ struct cascademcbuilder {
         }
       }
 
-      for (auto thisInfo : mcCascinfos) {
+      for (const auto& thisInfo : mcCascinfos) {
         cascmccores( // a lot of the info below will be compressed in case of not-recoed MC (good!)
           thisInfo.pdgCode, thisInfo.pdgCodeMother, thisInfo.pdgCodeV0, thisInfo.isPhysicalPrimary,
           thisInfo.pdgCodePositive, thisInfo.pdgCodeNegative, thisInfo.pdgCodeBachelor,
@@ -125,36 +125,27 @@ struct cascadepid {
   float maxSnp;  // max sine phi for propagation
   float maxStep; // max step size (cm) for propagation
 
+  std::array<std::array<float, 4>, 18> tofSegments; // x1, y1, x2, y2 of the TOF sectors in the transverse plane, computed in init
+
   /// function to calculate track length of this track up to a certain segment of a detector
   /// to be used internally in another funcrtion that calculates length until it finds the proper one
-  /// warning: this could be optimised further for speed
   /// \param track the input track
+  /// \param mom global momentum of the track at its start point
+  /// \param startPoint global position of the start point of the track
+  /// \param trcCircle circle of the track in the transverse plane
   /// \param x1 x of the first point of the detector segment
   /// \param y1 y of the first point of the detector segment
   /// \param x2 x of the first point of the detector segment
   /// \param y2 y of the first point of the detector segment
-  /// \param magneticField the magnetic field to use when propagating
-  float trackLengthToSegment(o2::track::TrackPar track, float x1, float y1, float x2, float y2, float magneticField)
+  float trackLengthToSegment(o2::track::TrackPar const& track, std::array<float, 3> const& mom, std::array<float, 3> const& startPoint, o2::math_utils::CircleXYf_t const& trcCircle, float x1, float y1, float x2, float y2)
   {
     // don't make use of the track parametrization
     float length = -104;
 
-    // causality protection
-    std::array<float, 3> mom;
-    track.getPxPyPzGlo(mom);
-    // get start point
-    std::array<float, 3> startPoint;
-    track.getXYZGlo(startPoint);
-
     // better replaced with scalar momentum check later
     // if (((x1 + x2) * mom[0] + (y1 + y2) * mom[1]) < 0.0f)
     //   return -101;
 
-    // get circle X, Y please
-    o2::math_utils::CircleXYf_t trcCircle;
-    float sna, csa;
-    track.getCircleParams(magneticField, trcCircle, sna, csa);
-
     // Calculate necessary inner product
     float segmentModulus = std::hypot(x2 - x1, y2 - y1);
     float alongSegment = ((trcCircle.xC - x1) * (x2 - x1) + (trcCircle.yC - y1) * (y2 - y1)) / segmentModulus;
@@ -232,9 +223,30 @@ struct cascadepid {
   /// function to calculate track length of this track up to a certain segmented detector
   /// \param track the input track
   /// \param magneticField the magnetic field to use when propagating
-  float findInterceptLength(o2::track::TrackPar track, float magneticField)
+  float findInterceptLength(o2::track::TrackPar const& track, float magneticField)
   {
+    // the start point, momentum and circle of the track are the same for all the segments
+    std::array<float, 3> mom;
+    track.getPxPyPzGlo(mom);
+    std::array<float, 3> startPoint;
+    track.getXYZGlo(startPoint);
+    o2::math_utils::CircleXYf_t trcCircle;
+    float sna, csa;
+    track.getCircleParams(magneticField, trcCircle, sna, csa);
+
     float length = 1e+6;
+    for (const auto& segment : tofSegments) {
+      float thisLength = trackLengthToSegment(track, mom, startPoint, trcCircle, segment[0], segment[1], segment[2], segment[3]);
+      if (thisLength < length && thisLength > 0)
+        length = thisLength;
+    }
+    if (length > 1e+5)
+      length = -100; // force negative to avoid misunderstandings
+    return length;
+  }
+
+  void init(InitContext&)
+  {
     for (int iSeg = 0; iSeg < 18; iSeg++) {
       // Detector segmentation loop
       float segmentAngle = 20.0f / 180.0f * TMath::Pi();
@@ -244,17 +256,9 @@ struct cascadepid {
       float y1 = -TMath::Sin(theta) * (-halfWidth) + TMath::Cos(theta) * tofPosition;
       float x2 = TMath::Cos(theta) * (+halfWidth) + TMath::Sin(theta) * tofPosition;
       float y2 = -TMath::Sin(theta) * (+halfWidth) + TMath::Cos(theta) * tofPosition;
-      float thisLength = trackLengthToSegment(track, x1, y1, x2, y2, magneticField);
-      if (thisLength < length && thisLength > 0)
-        length = thisLength;
+      tofSegments[iSeg] = {x1, y1, x2, y2};
     }
-    if (length > 1e+5)
-      length = -100; // force negative to avoid misunderstandings
-    return length;
-  }
 
-  void init(InitContext&)
-  {
     mRunNumber = 0;
     d_bz = 0;
     maxSnp = 0.85f;  // could be changed later
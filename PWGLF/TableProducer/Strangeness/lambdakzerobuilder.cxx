@@ -42,6 +42,8 @@
 #include <map>
 #include <iterator>
 #include <utility>
+#include <thread>
+#include <vector>
 
 #include "TRandom3.h"
 #include "Framework/runDataProcessing.h"
@@ -56,6 +58,7 @@
 #include "PWGLF/DataModel/LFStrangenessTables.h"
 #include "PWGLF/DataModel/LFStrangenessMLTables.h"
 #include "PWGLF/DataModel/LFParticleIdentification.h"
+#include "PWGLF/Utils/strangenessBuilderPrefilter.h"
 #include "Common/Core/TrackSelection.h"
 #include "Common/DataModel/TrackSelectionTables.h"
 #include "DetectorsBase/Propagator.h"
@@ -135,6 +138,10 @@ struct lambdakzeroBuilder {
 
   Configurable<bool> storePhotonCandidates{"storePhotonCandidates", false, "store photon candidates (yes/no)"};
 
+  // multi-threaded building, with one DCA fitter per thread
+  Configurable<int> nThreads{"nThreads", 1, "Number of threads for the building of the V0s, the tables are filled in the original order"};
+  Configurable<int> v0ChunkSize{"v0ChunkSize", 1000, "Number of V0s built by each thread between two fills of the tables, if nThreads > 1"};
+
   // use auto-detect configuration
   Configurable<bool> d_UseAutodetectMode{"d_UseAutodetectMode", false, "Autodetect requested topo sels"};
 
@@ -206,6 +213,13 @@ struct lambdakzeroBuilder {
     Configurable<int> rejDiffCollTracks{"dcaFitterConfigurations.rejDiffCollTracks", 0, "rejDiffCollTracks"};
   } dcaFitterConfigurations;
 
+  // Analytic prefilter on the helices of the daughters, before the propagation and the DCA fitter
+  struct : ConfigurableGroup {
+    Configurable<bool> usePrefilter{"prefilterConfigurations.usePrefilter", false, "Reject the V0s that cannot pass the DCA selections with analytic helix calculations"};
+    Configurable<float> marginDCAToPV{"prefilterConfigurations.marginDCAToPV", 0.01, "Margin on the analytic DCAxy of the daughters to the PV (cm)"};
+    Configurable<float> marginDCADau{"prefilterConfigurations.marginDCADau", 0.1, "Margin on the analytic DCAxy between the daughters (cm), only used with absolute DCAs"};
+  } prefilterConfigurations;
+
   // CCDB options
   struct : ConfigurableGroup {
     Configurable<std::string> ccdburl{"ccdbConfigurations.ccdb-url", "http://alice-ccdb.cern.ch", "url of the ccdb repository"};
@@ -315,7 +329,7 @@ struct lambdakzeroBuilder {
                 kNV0Steps };
 
   // Helper struct to pass V0 information
-  struct {
+  struct V0Candidate {
     float posTrackX;
     float negTrackX;
     std::array<float, 3> pos;
@@ -332,10 +346,31 @@ struct lambdakzeroBuilder {
     float k0ShortMass;
     float lambdaMass;
     float antiLambdaMass;
-  } v0candidate;
+    std::array<float, 6> positionCovariance; // only with createV0CovMats
+    o2::track::TrackParCov positiveTrack;    // at the PCA
+    o2::track::TrackParCov negativeTrack;    // at the PCA
+    o2::track::TrackParCov positiveTrackIU;
+    o2::track::TrackParCov negativeTrackIU;
+
+    // quantities for the QA histograms, only with d_doQA
+    double pt;
+    double eta;
+    double ptHypertriton;
+    double ptAntiHypertriton;
+    double gammaMass;
+    double hypertritonMass;
+    double antiHypertritonMass;
+    float dcaV0toPV;
+    float pcmDCAXY;
+    double pcmDCAChi2;
+    float pcmDeltaDistanceRadii;
+    float pcmPositionGuess;
+    float pcmRadiallyOutgoing1;
+    float pcmRadiallyOutgoing2;
+  };
 
   // Helper struct to do bookkeeping of building parameters
-  struct {
+  struct StatisticsRegistry {
     std::array<int32_t, kNV0Steps> v0stats;
     std::array<int32_t, kNV0Steps> v0statsUnassociated;
     std::array<int32_t, 10> posITSclu;
@@ -344,6 +379,12 @@ struct lambdakzeroBuilder {
     int32_t eventCounter;
   } statisticsRegistry;
 
+  // workspace of the building, one entry per thread or per V0 of the current chunk
+  std::vector<o2::vertexing::DCAFitterN<2>> threadFitters;
+  std::vector<StatisticsRegistry> threadStatistics;
+  std::vector<V0Candidate> v0candidates;
+  std::vector<char> v0candidateValid;
+
   HistogramRegistry registry{
     "registry",
     {{"hEventCounter", "hEventCounter", {HistType::kTH1D, {{1, 0.0f, 1.0f}}}},
@@ -397,7 +438,7 @@ struct lambdakzeroBuilder {
     return step * static_cast<float>(static_cast<int>((number) / step)) + TMath::Sign(1.0f, number) * (0.5f) * step;
   }
 
-  void roundV0CandidateVariables()
+  void roundV0CandidateVariables(V0Candidate& v0candidate)
   {
     v0candidate.dcaV0dau = roundToPrecision(v0candidate.dcaV0dau, precisionDCAs);
     v0candidate.posDCAxy = roundToPrecision(v0candidate.posDCAxy, precisionDCAs);
@@ -419,6 +460,19 @@ struct lambdakzeroBuilder {
     }
   }
 
+  void addStatistics(StatisticsRegistry const& statistics)
+  {
+    statisticsRegistry.exceptions += statistics.exceptions;
+    for (Int_t ii = 0; ii < kNV0Steps; ii++) {
+      statisticsRegistry.v0stats[ii] += statistics.v0stats[ii];
+      statisticsRegistry.v0statsUnassociated[ii] += statistics.v0statsUnassociated[ii];
+    }
+    for (Int_t ii = 0; ii < 10; ii++) {
+      statisticsRegistry.posITSclu[ii] += statistics.posITSclu[ii];
+      statisticsRegistry.negITSclu[ii] += statistics.negITSclu[ii];
+    }
+  }
+
   void fillHistos()
   {
     registry.fill(HIST("hEventCounter"), 0.0, statisticsRegistry.eventCounter);
@@ -435,11 +489,6 @@ struct lambdakzeroBuilder {
     }
   }
 
-  o2::track::TrackParCov lPositiveTrack;
-  o2::track::TrackParCov lNegativeTrack;
-  o2::track::TrackParCov lPositiveTrackIU;
-  o2::track::TrackParCov lNegativeTrackIU;
-
   void init(InitContext& context)
   {
     prng.SetSeed(0);
@@ -659,6 +708,12 @@ struct lambdakzeroBuilder {
     if (createV0DauCovMats > 0) {
       LOGF(info, " ---+*> Will produce V0 cov mat table for decay daughters");
     }
+    if (prefilterConfigurations.usePrefilter) {
+      LOGF(info, " ---+*> Will prefilter the V0s with analytic helix DCAs");
+    }
+    if (nThreads > 1) {
+      LOGF(info, " ---+*> Will build the V0s with %i threads, in chunks of %i V0s per thread", nThreads.value, v0ChunkSize.value);
+    }
     //*+-+*+-+*+-+*+-+*+-+*+-+*+-+*+-+*+-+*+-+*+-+*+-+*+-+*+-+*
 
     // initialize O2 2-prong fitter (only once)
@@ -799,7 +854,7 @@ struct lambdakzeroBuilder {
   }
 
   template <class TTrackTo, typename TV0Object>
-  bool buildV0Candidate(TV0Object const& V0)
+  bool buildV0Candidate(TV0Object const& V0, o2::vertexing::DCAFitterN<2>& dcaFitter, V0Candidate& v0candidate, StatisticsRegistry& statistics)
   {
     // Get tracks
     auto const& posTrack = V0.template posTrack_as<TTrackTo>();
@@ -816,9 +871,9 @@ struct lambdakzeroBuilder {
     }
 
     // value 0.5: any considered V0
-    statisticsRegistry.v0stats[kV0All]++;
+    statistics.v0stats[kV0All]++;
     if (!V0.has_collision())
-      statisticsRegistry.v0statsUnassociated[kV0All]++;
+      statistics.v0statsUnassociated[kV0All]++;
 
     if (tpcrefit) {
       if (!(posTrack.trackType() & o2::aod::track::TPCrefit)) {
@@ -830,19 +885,32 @@ struct lambdakzeroBuilder {
     }
 
     // Passes TPC refit
-    statisticsRegistry.v0stats[kV0TPCrefit]++;
+    statistics.v0stats[kV0TPCrefit]++;
     if (!V0.has_collision())
-      statisticsRegistry.v0statsUnassociated[kV0TPCrefit]++;
+      statistics.v0statsUnassociated[kV0TPCrefit]++;
+
+    // Analytic prefilter: transverse DCAs of the helices, which do not require any propagation
+    o2::math_utils::CircleXYf_t posCircle, negCircle;
+    const bool usePrefilter = prefilterConfigurations.usePrefilter && std::abs(d_bz) > 1e-5;
+    if (usePrefilter) {
+      float sna, csa;
+      getTrackPar(posTrack).getCircleParams(d_bz, posCircle, sna, csa);
+      getTrackPar(negTrack).getCircleParams(d_bz, negCircle, sna, csa);
+      if (o2::pwglf::dcaXYHelixToPoint(posCircle, primaryVertex.getX(), primaryVertex.getY()) + prefilterConfigurations.marginDCAToPV < dcapostopv ||
+          o2::pwglf::dcaXYHelixToPoint(negCircle, primaryVertex.getX(), primaryVertex.getY()) + prefilterConfigurations.marginDCAToPV < dcanegtopv) {
+        return false;
+      }
+    }
 
     // Calculate DCA with respect to the collision associated to the V0, not individual tracks
     gpu::gpustd::array<float, 2> dcaInfo;
 
     auto posTrackPar = getTrackPar(posTrack);
-    o2::base::Propagator::Instance()->propagateToDCABxByBz({primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ()}, posTrackPar, 2.f, fitter.getMatCorrType(), &dcaInfo);
+    o2::base::Propagator::Instance()->propagateToDCABxByBz({primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ()}, posTrackPar, 2.f, dcaFitter.getMatCorrType(), &dcaInfo);
     auto posTrackdcaXY = dcaInfo[0];
 
     auto negTrackPar = getTrackPar(negTrack);
-    o2::base::Propagator::Instance()->propagateToDCABxByBz({primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ()}, negTrackPar, 2.f, fitter.getMatCorrType(), &dcaInfo);
+    o2::base::Propagator::Instance()->propagateToDCABxByBz({primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ()}, negTrackPar, 2.f, dcaFitter.getMatCorrType(), &dcaInfo);
     auto negTrackdcaXY = dcaInfo[0];
 
     if (fabs(posTrackdcaXY) < dcapostopv || fabs(negTrackdcaXY) < dcanegtopv) {
@@ -854,24 +922,30 @@ struct lambdakzeroBuilder {
     v0candidate.negDCAxy = negTrackdcaXY;
 
     // passes DCAxy
-    statisticsRegistry.v0stats[kV0DCAxy]++;
+    statistics.v0stats[kV0DCAxy]++;
     if (!V0.has_collision())
-      statisticsRegistry.v0statsUnassociated[kV0DCAxy]++;
+      statistics.v0statsUnassociated[kV0DCAxy]++;
+
+    // the daughters cannot get closer than the transverse DCA of their helices
+    if (usePrefilter && dcaFitterConfigurations.d_UseAbsDCA &&
+        o2::pwglf::dcaXYHelixToHelix(posCircle, negCircle) > o2::pwglf::DCAFitterDistanceScale * dcav0dau + prefilterConfigurations.marginDCADau) {
+      return false;
+    }
 
     // Change strangenessBuilder tracks
-    lPositiveTrack = getTrackParCov(posTrack);
-    lNegativeTrack = getTrackParCov(negTrack);
-    lPositiveTrackIU = getTrackParCov(posTrack);
-    lNegativeTrackIU = getTrackParCov(negTrack);
+    v0candidate.positiveTrack = getTrackParCov(posTrack);
+    v0candidate.negativeTrack = getTrackParCov(negTrack);
+    v0candidate.positiveTrackIU = getTrackParCov(posTrack);
+    v0candidate.negativeTrackIU = getTrackParCov(negTrack);
 
     //---/---/---/
     // Move close to minima
     int nCand = 0;
-    fitter.setCollinear(dcaFitterConfigurations.d_UseCollinearFit || V0.isCollinearV0());
+    dcaFitter.setCollinear(dcaFitterConfigurations.d_UseCollinearFit || V0.isCollinearV0());
     try {
-      nCand = fitter.process(lPositiveTrack, lNegativeTrack);
+      nCand = dcaFitter.process(v0candidate.positiveTrack, v0candidate.negativeTrack);
     } catch (...) {
-      statisticsRegistry.exceptions++;
+      statistics.exceptions++;
       LOG(error) << "Exception caught in DCA fitter process call!";
       return false;
     }
@@ -879,23 +953,23 @@ struct lambdakzeroBuilder {
       return false;
     }
 
-    v0candidate.posTrackX = fitter.getTrack(0).getX();
-    v0candidate.negTrackX = fitter.getTrack(1).getX();
+    v0candidate.posTrackX = dcaFitter.getTrack(0).getX();
+    v0candidate.negTrackX = dcaFitter.getTrack(1).getX();
 
-    lPositiveTrack = fitter.getTrack(0);
-    lNegativeTrack = fitter.getTrack(1);
-    lPositiveTrack.getPxPyPzGlo(v0candidate.posP);
-    lNegativeTrack.getPxPyPzGlo(v0candidate.negP);
-    lPositiveTrack.getXYZGlo(v0candidate.posPosition);
-    lNegativeTrack.getXYZGlo(v0candidate.negPosition);
+    v0candidate.positiveTrack = dcaFitter.getTrack(0);
+    v0candidate.negativeTrack = dcaFitter.getTrack(1);
+    v0candidate.positiveTrack.getPxPyPzGlo(v0candidate.posP);
+    v0candidate.negativeTrack.getPxPyPzGlo(v0candidate.negP);
+    v0candidate.positiveTrack.getXYZGlo(v0candidate.posPosition);
+    v0candidate.negativeTrack.getXYZGlo(v0candidate.negPosition);
 
     // get decay vertex coordinates
-    const auto& vtx = fitter.getPCACandidate();
+    const auto& vtx = dcaFitter.getPCACandidate();
     for (int i = 0; i < 3; i++) {
       v0candidate.pos[i] = vtx[i];
     }
 
-    v0candidate.dcaV0dau = TMath::Sqrt(fitter.getChi2AtPCACandidate());
+    v0candidate.dcaV0dau = TMath::Sqrt(dcaFitter.getChi2AtPCACandidate());
 
     // Apply selections so a skimmed table is created only
     if (v0candidate.dcaV0dau > dcav0dau) {
@@ -903,9 +977,9 @@ struct lambdakzeroBuilder {
     }
 
     // Passes DCA between daughters check
-    statisticsRegistry.v0stats[kV0DCADau]++;
+    statistics.v0stats[kV0DCADau]++;
     if (!V0.has_collision())
-      statisticsRegistry.v0statsUnassociated[kV0DCADau]++;
+      statistics.v0statsUnassociated[kV0DCADau]++;
 
     v0candidate.cosPA = RecoDecay::cpa(array{primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ()}, array{v0candidate.pos[0], v0candidate.pos[1], v0candidate.pos[2]}, array{v0candidate.posP[0] + v0candidate.negP[0], v0candidate.posP[1] + v0candidate.negP[1], v0candidate.posP[2] + v0candidate.negP[2]});
     if (v0candidate.cosPA < v0cospa) {
@@ -920,9 +994,9 @@ struct lambdakzeroBuilder {
       primaryVertex.getX(), primaryVertex.getY(), primaryVertex.getZ());
 
     // Passes CosPA check
-    statisticsRegistry.v0stats[kV0CosPA]++;
+    statistics.v0stats[kV0CosPA]++;
     if (!V0.has_collision())
-      statisticsRegistry.v0statsUnassociated[kV0CosPA]++;
+      statistics.v0statsUnassociated[kV0CosPA]++;
 
     v0candidate.V0radius = RecoDecay::sqrtSumOfSquares(v0candidate.pos[0], v0candidate.pos[1]);
     if (v0candidate.V0radius < v0radius) {
@@ -930,9 +1004,9 @@ struct lambdakzeroBuilder {
     }
 
     // Passes radius check
-    statisticsRegistry.v0stats[kV0Radius]++;
+    statistics.v0stats[kV0Radius]++;
     if (!V0.has_collision())
-      statisticsRegistry.v0statsUnassociated[kV0Radius]++;
+      statistics.v0statsUnassociated[kV0Radius]++;
     // Return OK: passed all v0 candidate selecton criteria
 
     auto px = v0candidate.posP[0] + v0candidate.negP[0];
@@ -959,9 +1033,9 @@ struct lambdakzeroBuilder {
     float lML2P_Lambda = o2::constants::physics::MassLambda * lLengthTraveled / lPtotal;
 
     // Passes momentum window check
-    statisticsRegistry.v0stats[kWithinMomentumRange]++;
+    statistics.v0stats[kWithinMomentumRange]++;
     if (!V0.has_collision())
-      statisticsRegistry.v0statsUnassociated[kWithinMomentumRange]++;
+      statistics.v0statsUnassociated[kWithinMomentumRange]++;
 
     // Calculate masses
     auto lGammaMass = RecoDecay::m(array{array{v0candidate.posP[0], v0candidate.posP[1], v0candidate.posP[2]}, array{v0candidate.negP[0], v0candidate.negP[1], v0candidate.negP[2]}}, array{o2::constants::physics::MassElectron, o2::constants::physics::MassElectron});
@@ -1010,62 +1084,34 @@ struct lambdakzeroBuilder {
 
     if (qaConfigurations.d_doTrackQA) {
       if (posTrack.itsNCls() < 10)
-        statisticsRegistry.posITSclu[posTrack.itsNCls()]++;
+        statistics.posITSclu[posTrack.itsNCls()]++;
       if (negTrack.itsNCls() < 10)
-        statisticsRegistry.negITSclu[negTrack.itsNCls()]++;
+        statistics.negITSclu[negTrack.itsNCls()]++;
     }
 
-    if (qaConfigurations.d_doQA) {
-      bool mcUnchecked = !qaConfigurations.d_QA_checkMC;
-      bool dEdxUnchecked = !qaConfigurations.d_QA_checkdEdx;
-
-      auto lPtHy = RecoDecay::sqrtSumOfSquares(2.0f * v0candidate.posP[0] + v0candidate.negP[0], 2.0f * v0candidate.posP[1] + v0candidate.negP[1]);
-      auto lPtAnHy = RecoDecay::sqrtSumOfSquares(v0candidate.posP[0] + 2.0f * v0candidate.negP[0], v0candidate.posP[1] + 2.0f * v0candidate.negP[1]);
-
-      // Fill basic mass histograms
-      if (TMath::Abs(RecoDecay::eta(std::array{px, py, pz})) < 0.5) {
-        if ((V0.isdEdxGamma() || dEdxUnchecked) && (V0.isTrueGamma() || mcUnchecked))
-          registry.fill(HIST("h2dGammaMass"), lPt, lGammaMass);
-        if ((V0.isdEdxK0Short() || dEdxUnchecked) && (V0.isTrueK0Short() || mcUnchecked))
-          registry.fill(HIST("h2dK0ShortMass"), lPt, v0candidate.k0ShortMass);
-        if ((V0.isdEdxLambda() || dEdxUnchecked) && (V0.isTrueLambda() || mcUnchecked))
-          registry.fill(HIST("h2dLambdaMass"), lPt, v0candidate.lambdaMass);
-        if ((V0.isdEdxAntiLambda() || dEdxUnchecked) && (V0.isTrueAntiLambda() || mcUnchecked))
-          registry.fill(HIST("h2dAntiLambdaMass"), lPt, v0candidate.antiLambdaMass);
-        if ((V0.isdEdxHypertriton() || dEdxUnchecked) && (V0.isTrueHypertriton() || mcUnchecked))
-          registry.fill(HIST("h2dHypertritonMass"), lPtHy, lHypertritonMass);
-        if ((V0.isdEdxAntiHypertriton() || dEdxUnchecked) && (V0.isTrueAntiHypertriton() || mcUnchecked))
-          registry.fill(HIST("h2dAntiHypertritonMass"), lPtAnHy, lAntiHypertritonMass);
-      }
+    // the position covariance needs the state of the fitter, which is reused for the next V0
+    if (createV0CovMats) {
+      auto covVtxV = dcaFitter.calcPCACovMatrix(0);
+      v0candidate.positionCovariance[0] = covVtxV(0, 0);
+      v0candidate.positionCovariance[1] = covVtxV(1, 0);
+      v0candidate.positionCovariance[2] = covVtxV(1, 1);
+      v0candidate.positionCovariance[3] = covVtxV(2, 0);
+      v0candidate.positionCovariance[4] = covVtxV(2, 1);
+      v0candidate.positionCovariance[5] = covVtxV(2, 2);
+    }
 
-      // Fill ITS cluster maps with specific mass cuts
-      if (TMath::Abs(lGammaMass - 0.0) < qaConfigurations.dQAGammaMassWindow && ((V0.isdEdxGamma() || dEdxUnchecked) && (V0.isTrueGamma() || mcUnchecked))) {
-        registry.fill(HIST("h2dITSCluMap_Gamma"), static_cast<float>(posTrack.itsClusterMap()), static_cast<float>(negTrack.itsClusterMap()), v0candidate.V0radius);
-        registry.fill(HIST("h2dXIU_Gamma"), static_cast<float>(posTrack.x()), static_cast<float>(negTrack.x()), v0candidate.V0radius);
-      }
-      if (TMath::Abs(v0candidate.k0ShortMass - 0.497) < qaConfigurations.dQAK0ShortMassWindow && ((V0.isdEdxK0Short() || dEdxUnchecked) && (V0.isTrueK0Short() || mcUnchecked))) {
-        registry.fill(HIST("h2dITSCluMap_K0Short"), static_cast<float>(posTrack.itsClusterMap()), static_cast<float>(negTrack.itsClusterMap()), v0candidate.V0radius);
-        registry.fill(HIST("h2dXIU_K0Short"), static_cast<float>(posTrack.x()), static_cast<float>(negTrack.x()), v0candidate.V0radius);
-      }
-      if (TMath::Abs(v0candidate.lambdaMass - 1.116) < qaConfigurations.dQALambdaMassWindow && ((V0.isdEdxLambda() || dEdxUnchecked) && (V0.isTrueLambda() || mcUnchecked))) {
-        registry.fill(HIST("h2dITSCluMap_Lambda"), static_cast<float>(posTrack.itsClusterMap()), static_cast<float>(negTrack.itsClusterMap()), v0candidate.V0radius);
-        registry.fill(HIST("h2dXIU_Lambda"), static_cast<float>(posTrack.x()), static_cast<float>(negTrack.x()), v0candidate.V0radius);
-      }
-      if (TMath::Abs(v0candidate.antiLambdaMass - 1.116) < qaConfigurations.dQALambdaMassWindow && ((V0.isdEdxAntiLambda() || dEdxUnchecked) && (V0.isTrueAntiLambda() || mcUnchecked))) {
-        registry.fill(HIST("h2dITSCluMap_AntiLambda"), static_cast<float>(posTrack.itsClusterMap()), static_cast<float>(negTrack.itsClusterMap()), v0candidate.V0radius);
-        registry.fill(HIST("h2dXIU_AntiLambda"), static_cast<float>(posTrack.x()), static_cast<float>(negTrack.x()), v0candidate.V0radius);
-      }
+    // QA quantities, the histograms are filled in fillV0QAHistograms in the order of the V0s
+    if (qaConfigurations.d_doQA) {
+      v0candidate.pt = lPt;
+      v0candidate.eta = RecoDecay::eta(std::array{px, py, pz});
+      v0candidate.ptHypertriton = RecoDecay::sqrtSumOfSquares(2.0f * v0candidate.posP[0] + v0candidate.negP[0], 2.0f * v0candidate.posP[1] + v0candidate.negP[1]);
+      v0candidate.ptAntiHypertriton = RecoDecay::sqrtSumOfSquares(v0candidate.posP[0] + 2.0f * v0candidate.negP[0], v0candidate.posP[1] + 2.0f * v0candidate.negP[1]);
+      v0candidate.gammaMass = lGammaMass;
+      v0candidate.hypertritonMass = lHypertritonMass;
+      v0candidate.antiHypertritonMass = lAntiHypertritonMass;
 
       // QA extra: DCA to PV
-      float dcaV0toPV = std::sqrt((std::pow((primaryVertex.getY() - v0candidate.pos[1]) * pz - (primaryVertex.getZ() - v0candidate.pos[2]) * py, 2) + std::pow((primaryVertex.getX() - v0candidate.pos[0]) * pz - (primaryVertex.getZ() - v0candidate.pos[2]) * px, 2) + std::pow((primaryVertex.getX() - v0candidate.pos[0]) * py - (primaryVertex.getY() - v0candidate.pos[1]) * px, 2)) / (px * px + py * py + pz * pz));
-
-      registry.fill(HIST("h2dTopoVarPointingAngle"), lPt, TMath::ACos(v0candidate.cosPA));
-      registry.fill(HIST("h2dTopoVarRAP"), lPt, TMath::ACos(v0candidate.cosPA) * v0candidate.V0radius);
-      registry.fill(HIST("h2dTopoVarV0Radius"), lPt, v0candidate.V0radius);
-      registry.fill(HIST("h2dTopoVarDCAV0Dau"), lPt, v0candidate.dcaV0dau);
-      registry.fill(HIST("h2dTopoVarPosDCAToPV"), lPt, v0candidate.posDCAxy);
-      registry.fill(HIST("h2dTopoVarNegDCAToPV"), lPt, v0candidate.negDCAxy);
-      registry.fill(HIST("h2dTopoVarDCAV0ToPV"), lPt, dcaV0toPV);
+      v0candidate.dcaV0toPV = std::sqrt((std::pow((primaryVertex.getY() - v0candidate.pos[1]) * pz - (primaryVertex.getZ() - v0candidate.pos[2]) * py, 2) + std::pow((primaryVertex.getX() - v0candidate.pos[0]) * pz - (primaryVertex.getZ() - v0candidate.pos[2]) * px, 2) + std::pow((primaryVertex.getX() - v0candidate.pos[0]) * py - (primaryVertex.getY() - v0candidate.pos[1]) * px, 2)) / (px * px + py * py + pz * pz));
 
       // -------------------------------------------------------------------------------------
       // PCM finding tests
@@ -1091,117 +1137,196 @@ struct lambdakzeroBuilder {
       float delta3_track1 = TMath::Sqrt(TMath::Power(trcCircle1.xC, 2) + TMath::Power(trcCircle1.yC, 2) - TMath::Power(trcCircle1.rC, 2));
       float delta3_track2 = TMath::Sqrt(TMath::Power(trcCircle2.xC, 2) + TMath::Power(trcCircle2.yC, 2) - TMath::Power(trcCircle2.rC, 2));
 
-      // let's just use tagged, cause we can
-      if (!posTrack.hasITS() && !posTrack.hasTRD() && !posTrack.hasTOF() && !negTrack.hasITS() && !negTrack.hasTRD() && !negTrack.hasTOF()) {
-        if (V0.isTrueGamma()) {
-          registry.fill(HIST("h2d_pcm_DCAXY_True"), lPt, std::hypot(dcaInfo[0], dcaInfo[1]));
-          registry.fill(HIST("h2d_pcm_DCACHI2_True"), lPt, fitter.getChi2AtPCACandidate());
-          registry.fill(HIST("h2d_pcm_DeltaDistanceRadii_True"), lPt, centerDistance - trcCircle1.rC - trcCircle2.rC);
-          registry.fill(HIST("h2d_pcm_PositionGuess_True"), lPt, delta2);
-          registry.fill(HIST("h2d_pcm_RadiallyOutgoingAtThisRadius1_True"), lPt, delta3_track1);
-          registry.fill(HIST("h2d_pcm_RadiallyOutgoingAtThisRadius2_True"), lPt, delta3_track2);
-        } else {
-          registry.fill(HIST("h2d_pcm_DCAXY_Bg"), lPt, std::hypot(dcaInfo[0], dcaInfo[1]));
-          registry.fill(HIST("h2d_pcm_DCACHI2_Bg"), lPt, fitter.getChi2AtPCACandidate());
-          registry.fill(HIST("h2d_pcm_DeltaDistanceRadii_Bg"), lPt, centerDistance - trcCircle1.rC - trcCircle2.rC);
-          registry.fill(HIST("h2d_pcm_PositionGuess_Bg"), lPt, delta2);
-          registry.fill(HIST("h2d_pcm_RadiallyOutgoingAtThisRadius1_Bg"), lPt, delta3_track1);
-          registry.fill(HIST("h2d_pcm_RadiallyOutgoingAtThisRadius2_Bg"), lPt, delta3_track2);
-        }
-      }
+      v0candidate.pcmDCAXY = std::hypot(dcaInfo[0], dcaInfo[1]);
+      v0candidate.pcmDCAChi2 = dcaFitter.getChi2AtPCACandidate();
+      v0candidate.pcmDeltaDistanceRadii = centerDistance - trcCircle1.rC - trcCircle2.rC;
+      v0candidate.pcmPositionGuess = delta2;
+      v0candidate.pcmRadiallyOutgoing1 = delta3_track1;
+      v0candidate.pcmRadiallyOutgoing2 = delta3_track2;
       // -------------------------------------------------------------------------------------
-    } // end QA
+    }
     return true;
   }
 
-  template <class TTrackTo, typename TV0Table>
-  void buildStrangenessTables(TV0Table const& V0s)
+  template <class TTrackTo, typename TV0Object>
+  void fillV0QAHistograms(TV0Object const& V0, V0Candidate const& v0candidate)
   {
-    // Loops over all V0s in the time frame
-    for (auto& V0 : V0s) {
-      // downscale some V0s if requested to do so
-      if (downscalingOptions.downscaleFactor < 1.f && (static_cast<float>(rand_r(&randomSeed)) / static_cast<float>(RAND_MAX)) > downscalingOptions.downscaleFactor) {
-        return;
-      }
+    auto const& posTrack = V0.template posTrack_as<TTrackTo>();
+    auto const& negTrack = V0.template negTrack_as<TTrackTo>();
+    bool mcUnchecked = !qaConfigurations.d_QA_checkMC;
+    bool dEdxUnchecked = !qaConfigurations.d_QA_checkdEdx;
+    auto lPt = v0candidate.pt;
+
+    // Fill basic mass histograms
+    if (TMath::Abs(v0candidate.eta) < 0.5) {
+      if ((V0.isdEdxGamma() || dEdxUnchecked) && (V0.isTrueGamma() || mcUnchecked))
+        registry.fill(HIST("h2dGammaMass"), lPt, v0candidate.gammaMass);
+      if ((V0.isdEdxK0Short() || dEdxUnchecked) && (V0.isTrueK0Short() || mcUnchecked))
+        registry.fill(HIST("h2dK0ShortMass"), lPt, v0candidate.k0ShortMass);
+      if ((V0.isdEdxLambda() || dEdxUnchecked) && (V0.isTrueLambda() || mcUnchecked))
+        registry.fill(HIST("h2dLambdaMass"), lPt, v0candidate.lambdaMass);
+      if ((V0.isdEdxAntiLambda() || dEdxUnchecked) && (V0.isTrueAntiLambda() || mcUnchecked))
+        registry.fill(HIST("h2dAntiLambdaMass"), lPt, v0candidate.antiLambdaMass);
+      if ((V0.isdEdxHypertriton() || dEdxUnchecked) && (V0.isTrueHypertriton() || mcUnchecked))
+        registry.fill(HIST("h2dHypertritonMass"), v0candidate.ptHypertriton, v0candidate.hypertritonMass);
+      if ((V0.isdEdxAntiHypertriton() || dEdxUnchecked) && (V0.isTrueAntiHypertriton() || mcUnchecked))
+        registry.fill(HIST("h2dAntiHypertritonMass"), v0candidate.ptAntiHypertriton, v0candidate.antiHypertritonMass);
+    }
 
-      // populates v0candidate struct declared inside strangenessbuilder
-      bool validCandidate = buildV0Candidate<TTrackTo>(V0);
 
-      if (!validCandidate) {
-        continue; // doesn't pass selections
+    // Fill ITS cluster maps with specific mass cuts
+    if (TMath::Abs(v0candidate.gammaMass - 0.0) < qaConfigurations.dQAGammaMassWindow && ((V0.isdEdxGamma() || dEdxUnchecked) && (V0.isTrueGamma() || mcUnchecked))) {
+      registry.fill(HIST("h2dITSCluMap_Gamma"), static_cast<float>(posTrack.itsClusterMap()), static_cast<float>(negTrack.itsClusterMap()), v0candidate.V0radius);
+      registry.fill(HIST("h2dXIU_Gamma"), static_cast<float>(posTrack.x()), static_cast<float>(negTrack.x()), v0candidate.V0radius);
+    }
+    if (TMath::Abs(v0candidate.k0ShortMass - 0.497) < qaConfigurations.dQAK0ShortMassWindow && ((V0.isdEdxK0Short() || dEdxUnchecked) && (V0.isTrueK0Short() || mcUnchecked))) {
+      registry.fill(HIST("h2dITSCluMap_K0Short"), static_cast<float>(posTrack.itsClusterMap()), static_cast<float>(negTrack.itsClusterMap()), v0candidate.V0radius);
+      registry.fill(HIST("h2dXIU_K0Short"), static_cast<float>(posTrack.x()), static_cast<float>(negTrack.x()), v0candidate.V0radius);
+    }
+    if (TMath::Abs(v0candidate.lambdaMass - 1.116) < qaConfigurations.dQALambdaMassWindow && ((V0.isdEdxLambda() || dEdxUnchecked) && (V0.isTrueLambda() || mcUnchecked))) {
+      registry.fill(HIST("h2dITSCluMap_Lambda"), static_cast<float>(posTrack.itsClusterMap()), static_cast<float>(negTrack.itsClusterMap()), v0candidate.V0radius);
+      registry.fill(HIST("h2dXIU_Lambda"), static_cast<float>(posTrack.x()), static_cast<float>(negTrack.x()), v0candidate.V0radius);
+    }
+    if (TMath::Abs(v0candidate.antiLambdaMass - 1.116) < qaConfigurations.dQALambdaMassWindow && ((V0.isdEdxAntiLambda() || dEdxUnchecked) && (V0.isTrueAntiLambda() || mcUnchecked))) {
+      registry.fill(HIST("h2dITSCluMap_AntiLambda"), static_cast<float>(posTrack.itsClusterMap()), static_cast<float>(negTrack.itsClusterMap()), v0candidate.V0radius);
+      registry.fill(HIST("h2dXIU_AntiLambda"), static_cast<float>(posTrack.x()), static_cast<float>(negTrack.x()), v0candidate.V0radius);
+    }
+
+    registry.fill(HIST("h2dTopoVarPointingAngle"), lPt, TMath::ACos(v0candidate.cosPA));
+    registry.fill(HIST("h2dTopoVarRAP"), lPt, TMath::ACos(v0candidate.cosPA) * v0candidate.V0radius);
+    registry.fill(HIST("h2dTopoVarV0Radius"), lPt, v0candidate.V0radius);
+    registry.fill(HIST("h2dTopoVarDCAV0Dau"), lPt, v0candidate.dcaV0dau);
+    registry.fill(HIST("h2dTopoVarPosDCAToPV"), lPt, v0candidate.posDCAxy);
+    registry.fill(HIST("h2dTopoVarNegDCAToPV"), lPt, v0candidate.negDCAxy);
+    registry.fill(HIST("h2dTopoVarDCAV0ToPV"), lPt, v0candidate.dcaV0toPV);
+
+    // PCM finding tests, let's just use tagged, cause we can
+    if (!posTrack.hasITS() && !posTrack.hasTRD() && !posTrack.hasTOF() && !negTrack.hasITS() && !negTrack.hasTRD() && !negTrack.hasTOF()) {
+      if (V0.isTrueGamma()) {
+        registry.fill(HIST("h2d_pcm_DCAXY_True"), lPt, v0candidate.pcmDCAXY);
+        registry.fill(HIST("h2d_pcm_DCACHI2_True"), lPt, v0candidate.pcmDCAChi2);
+        registry.fill(HIST("h2d_pcm_DeltaDistanceRadii_True"), lPt, v0candidate.pcmDeltaDistanceRadii);
+        registry.fill(HIST("h2d_pcm_PositionGuess_True"), lPt, v0candidate.pcmPositionGuess);
+        registry.fill(HIST("h2d_pcm_RadiallyOutgoingAtThisRadius1_True"), lPt, v0candidate.pcmRadiallyOutgoing1);
+        registry.fill(HIST("h2d_pcm_RadiallyOutgoingAtThisRadius2_True"), lPt, v0candidate.pcmRadiallyOutgoing2);
+      } else {
+        registry.fill(HIST("h2d_pcm_DCAXY_Bg"), lPt, v0candidate.pcmDCAXY);
+        registry.fill(HIST("h2d_pcm_DCACHI2_Bg"), lPt, v0candidate.pcmDCAChi2);
+        registry.fill(HIST("h2d_pcm_DeltaDistanceRadii_Bg"), lPt, v0candidate.pcmDeltaDistanceRadii);
+        registry.fill(HIST("h2d_pcm_PositionGuess_Bg"), lPt, v0candidate.pcmPositionGuess);
+        registry.fill(HIST("h2d_pcm_RadiallyOutgoingAtThisRadius1_Bg"), lPt, v0candidate.pcmRadiallyOutgoing1);
+        registry.fill(HIST("h2d_pcm_RadiallyOutgoingAtThisRadius2_Bg"), lPt, v0candidate.pcmRadiallyOutgoing2);
       }
+    }
+  }
 
-      int ivanovMap = 0;
-      float pt = RecoDecay::sqrtSumOfSquares(v0candidate.posP[0] + v0candidate.negP[0], v0candidate.posP[1] + v0candidate.negP[1]);
-      if (downscalingOptions.downscale_adaptive) {
-        ivanovMap = DownsampleMap(pt);
-        if (ivanovMap == 0)
-          continue; // skip this V0, passes nothing
+  template <class TTrackTo, typename TV0Object>
+  void fillV0Tables(TV0Object const& V0, V0Candidate& v0candidate)
+  {
+    int ivanovMap = 0;
+    float pt = RecoDecay::sqrtSumOfSquares(v0candidate.posP[0] + v0candidate.negP[0], v0candidate.posP[1] + v0candidate.negP[1]);
+    if (downscalingOptions.downscale_adaptive) {
+      ivanovMap = DownsampleMap(pt);
+      if (ivanovMap == 0)
+        return; // skip this V0, passes nothing
+    }
+
+    // round the DCA variables to a certain precision if asked
+    if (roundDCAVariables)
+      roundV0CandidateVariables();
+
+    // evaluate machine-learning scores
+    float gammaScore = -1.0f, lambdaScore = -1.0f, antiLambdaScore = -1.0f, k0ShortScore = -1.0f;
+
+    if (mlConfigurations.calculateK0ShortScores ||
+        mlConfigurations.calculateLambdaScores ||
+        mlConfigurations.calculateAntiLambdaScores ||
+        mlConfigurations.calculateGammaScores) {
+      // machine learning is on, go for calculation of thresholds
+      // FIXME THIS NEEDS ADJUSTING
+      std::vector<float> inputFeatures{pt, 0.0f,
+                                       0.0f, v0candidate.V0radius,
+                                       v0candidate.cosPA, v0candidate.dcaV0dau,
+                                       v0candidate.posDCAxy, v0candidate.negDCAxy};
+
+      // calculate scores
+      if (mlConfigurations.calculateLambdaScores) {
+        float* lambdaProbability = mlModelLambda.evalModel(inputFeatures);
+        lambdaScore = lambdaProbability[1];
+      }
+      if (mlConfigurations.calculateGammaScores) {
+        float* gammaProbability = mlModelGamma.evalModel(inputFeatures);
+        gammaScore = gammaProbability[1];
       }
 
-      // round the DCA variables to a certain precision if asked
-      if (roundDCAVariables)
-        roundV0CandidateVariables();
+      // Skip anything that doesn't fulfull any of the desired conditions
+      if (gammaScore < mlConfigurations.thresholdGamma.value &&
+          lambdaScore < mlConfigurations.thresholdLambda.value &&
+          antiLambdaScore < mlConfigurations.thresholdAntiLambda.value &&
+          k0ShortScore < mlConfigurations.thresholdK0Short.value) {
+        return; // skipped as uninteresting in any hypothesis considered
+      }
+    }
 
-      // evaluate machine-learning scores
-      float gammaScore = -1.0f, lambdaScore = -1.0f, antiLambdaScore = -1.0f, k0ShortScore = -1.0f;
+    // V0 logic reminder
+    // 0: v0 saved for the only due to the cascade, 1: standalone v0, 3: standard v0 with photon-only test
+    if (V0.v0Type() > 0) {
+      if (V0.v0Type() > 1 && !storePhotonCandidates)
+        return;
 
       if (mlConfigurations.calculateK0ShortScores ||
           mlConfigurations.calculateLambdaScores ||
           mlConfigurations.calculateAntiLambdaScores ||
           mlConfigurations.calculateGammaScores) {
-        // machine learning is on, go for calculation of thresholds
-        // FIXME THIS NEEDS ADJUSTING
-        std::vector<float> inputFeatures{pt, 0.0f,
-                                         0.0f, v0candidate.V0radius,
-                                         v0candidate.cosPA, v0candidate.dcaV0dau,
-                                         v0candidate.posDCAxy, v0candidate.negDCAxy};
-
-        // calculate scores
-        if (mlConfigurations.calculateLambdaScores) {
-          float* lambdaProbability = mlModelLambda.evalModel(inputFeatures);
-          lambdaScore = lambdaProbability[1];
-        }
-        if (mlConfigurations.calculateGammaScores) {
-          float* gammaProbability = mlModelGamma.evalModel(inputFeatures);
-          gammaScore = gammaProbability[1];
-        }
-
-        // Skip anything that doesn't fulfull any of the desired conditions
-        if (gammaScore < mlConfigurations.thresholdGamma.value &&
-            lambdaScore < mlConfigurations.thresholdLambda.value &&
-            antiLambdaScore < mlConfigurations.thresholdAntiLambda.value &&
-            k0ShortScore < mlConfigurations.thresholdK0Short.value) {
-          continue; // skipped as uninteresting in any hypothesis considered
-        }
+        // at this stage, the candidate is interesting -> populate table
+        gammaMLSelections(gammaScore);
+        lambdaMLSelections(lambdaScore);
+        antiLambdaMLSelections(antiLambdaScore);
+        k0ShortMLSelections(k0ShortScore);
       }
 
-      // V0 logic reminder
-      // 0: v0 saved for the only due to the cascade, 1: standalone v0, 3: standard v0 with photon-only test
-      if (V0.v0Type() > 0) {
-        if (V0.v0Type() > 1 && !storePhotonCandidates)
-          continue;
-
-        if (mlConfigurations.calculateK0ShortScores ||
-            mlConfigurations.calculateLambdaScores ||
-            mlConfigurations.calculateAntiLambdaScores ||
-            mlConfigurations.calculateGammaScores) {
-          // at this stage, the candidate is interesting -> populate table
-          gammaMLSelections(gammaScore);
-          lambdaMLSelections(lambdaScore);
-          antiLambdaMLSelections(antiLambdaScore);
-          k0ShortMLSelections(k0ShortScore);
-        }
-
-        // populates the various tables for analysis
-        statisticsRegistry.v0stats[kCountStandardV0]++;
-        if (!V0.has_collision())
-          statisticsRegistry.v0statsUnassociated[kCountStandardV0]++;
-
-        v0indices(V0.posTrackId(), V0.negTrackId(),
+      // populates the various tables for analysis
+      statisticsRegistry.v0stats[kCountStandardV0]++;
+      if (!V0.has_collision())
+        statisticsRegistry.v0statsUnassociated[kCountStandardV0]++;
+
+      v0indices(V0.posTrackId(), V0.negTrackId(),
+                V0.collisionId(), V0.globalIndex());
+      v0trackXs(v0candidate.posTrackX, v0candidate.negTrackX);
+      v0cores(v0candidate.pos[0], v0candidate.pos[1], v0candidate.pos[2],
+              v0candidate.posP[0], v0candidate.posP[1], v0candidate.posP[2],
+              v0candidate.negP[0], v0candidate.negP[1], v0candidate.negP[2],
+              v0candidate.dcaV0dau,
+              v0candidate.posDCAxy,
+              v0candidate.negDCAxy,
+              v0candidate.cosPA,
+              v0candidate.dcav0topv,
+              V0.v0Type());
+      if (createV0PosAtDCAs)
+        v0dauPositions(v0candidate.posPosition[0], v0candidate.posPosition[1], v0candidate.posPosition[2],
+                       v0candidate.negPosition[0], v0candidate.negPosition[1], v0candidate.negPosition[2]);
+      if (createV0PosAtDCAs) {
+        std::array<float, 3> posPositionIU;
+        std::array<float, 3> negPositionIU;
+        v0candidate.positiveTrackIU.getXYZGlo(posPositionIU);
+        v0candidate.negativeTrackIU.getXYZGlo(negPositionIU);
+        v0dauPositionsIU(posPositionIU[0], posPositionIU[1], posPositionIU[2],
+                         negPositionIU[0], negPositionIU[1], negPositionIU[2]);
+      }
+      if (downscalingOptions.downscale_adaptive) {
+        v0ivanovs(ivanovMap);
+      }
+    } else {
+      // place V0s built exclusively for the sake of cascades
+      // in a fully independent table (though identical) to make
+      // sure there's no accidental usage of those candidates
+      // N.B.: these are obtained with *other selections* in
+      //       the svertexer!
+      statisticsRegistry.v0stats[kCountV0forCascade]++;
+      v0fcindices(V0.posTrackId(), V0.negTrackId(),
                   V0.collisionId(), V0.globalIndex());
-        v0trackXs(v0candidate.posTrackX, v0candidate.negTrackX);
-        v0cores(v0candidate.pos[0], v0candidate.pos[1], v0candidate.pos[2],
+      v0fctrackXs(v0candidate.posTrackX, v0candidate.negTrackX);
+      v0fccores(v0candidate.pos[0], v0candidate.pos[1], v0candidate.pos[2],
                 v0candidate.posP[0], v0candidate.posP[1], v0candidate.posP[2],
                 v0candidate.negP[0], v0candidate.negP[1], v0candidate.negP[2],
                 v0candidate.dcaV0dau,
@@ -1210,91 +1335,117 @@ struct lambdakzeroBuilder {
                 v0candidate.cosPA,
                 v0candidate.dcav0topv,
                 V0.v0Type());
-        if (createV0PosAtDCAs)
-          v0dauPositions(v0candidate.posPosition[0], v0candidate.posPosition[1], v0candidate.posPosition[2],
-                         v0candidate.negPosition[0], v0candidate.negPosition[1], v0candidate.negPosition[2]);
-        if (createV0PosAtDCAs) {
-          std::array<float, 3> posPositionIU;
-          std::array<float, 3> negPositionIU;
-          lPositiveTrackIU.getXYZGlo(posPositionIU);
-          lNegativeTrackIU.getXYZGlo(negPositionIU);
-          v0dauPositionsIU(posPositionIU[0], posPositionIU[1], posPositionIU[2],
-                           negPositionIU[0], negPositionIU[1], negPositionIU[2]);
+    }
+
+    // populate V0 covariance matrices if required by any other task
+    if (createV0CovMats) {
+      // position covariance matrix calculated with the fitter in buildV0Candidate
+      const float* positionCovariance = v0candidate.positionCovariance.data();
+      std::array<float, 21> covTpositive = {0.};
+      std::array<float, 21> covTnegative = {0.};
+      std::array<float, 21> covTpositiveIU = {0.};
+      std::array<float, 21> covTnegativeIU = {0.};
+      // std::array<float, 6> momentumCovariance;
+      float momentumCovariance[6];
+      v0candidate.positiveTrack.getCovXYZPxPyPzGlo(covTpositive);
+      v0candidate.negativeTrack.getCovXYZPxPyPzGlo(covTnegative);
+      v0candidate.positiveTrackIU.getCovXYZPxPyPzGlo(covTpositiveIU);
+      v0candidate.negativeTrackIU.getCovXYZPxPyPzGlo(covTnegativeIU);
+      constexpr int MomInd[6] = {9, 13, 14, 18, 19, 20}; // cov matrix elements for momentum component
+      for (int i = 0; i < 6; i++) {
+        momentumCovariance[i] = covTpositive[MomInd[i]] + covTnegative[MomInd[i]];
+      }
+      if (V0.v0Type() > 0) {
+        if (V0.v0Type() > 1 && !storePhotonCandidates)
+          return;
+        v0covs(positionCovariance, momentumCovariance);
+        if (createV0DauCovMats) {
+          // store momentum covariance matrix
+          float covariancePosTrack[21];
+          float covarianceNegTrack[21];
+          float covariancePosTrackIU[21];
+          float covarianceNegTrackIU[21];
+          for (int i = 0; i < 21; i++) {
+            covariancePosTrack[i] = covTpositive[i];
+            covarianceNegTrack[i] = covTnegative[i];
+            covariancePosTrackIU[i] = covTpositiveIU[i];
+            covarianceNegTrackIU[i] = covTnegativeIU[i];
+          }
+          v0daucovs(covariancePosTrack, covarianceNegTrack);
+          v0daucovIUs(covariancePosTrackIU, covarianceNegTrackIU);
+        }
+      } else {
+        v0fccovs(positionCovariance, momentumCovariance);
+      }
+    }
+  }
+
+  template <class TTrackTo, typename TV0Table>
+  void buildStrangenessTables(TV0Table const& V0s)
+  {
+    // V0s are built by chunks, one slice of each chunk per thread with its own fitter, and
+    // the tables are filled in the order of the V0s, so that the output does not depend on the number of threads
+    const int nBuilderThreads = std::max(1, nThreads.value);
+    const std::size_t chunkSize = nBuilderThreads > 1 ? static_cast<std::size_t>(nBuilderThreads) * std::max(1, v0ChunkSize.value) : 1;
+    threadFitters.assign(nBuilderThreads, fitter);
+    threadStatistics.assign(nBuilderThreads, StatisticsRegistry{});
+    v0candidates.resize(chunkSize);
+    v0candidateValid.resize(chunkSize);
+    std::vector<typename TV0Table::iterator> chunk;
+    chunk.reserve(chunkSize);
+
+    auto buildChunk = [&]() {
+      const int nV0s = chunk.size();
+      auto buildSlice = [&](int iThread, int first, int last) {
+        for (int i = first; i < last; i++) {
+          // populates the v0candidate struct of the V0
+          v0candidateValid[i] = buildV0Candidate<TTrackTo>(chunk[i], threadFitters[iThread], v0candidates[i], threadStatistics[iThread]);
         }
-        if (downscalingOptions.downscale_adaptive) {
-          v0ivanovs(ivanovMap);
+      };
+      const int nSlices = std::min(nBuilderThreads, nV0s);
+      if (nSlices > 1) {
+        std::vector<std::thread> threads;
+        threads.reserve(nSlices);
+        for (int iSlice = 0; iSlice < nSlices; iSlice++) {
+          threads.emplace_back(buildSlice, iSlice, nV0s * iSlice / nSlices, nV0s * (iSlice + 1) / nSlices);
+        }
+        for (auto& thread : threads) {
+          thread.join();
         }
       } else {
-        // place V0s built exclusively for the sake of cascades
-        // in a fully independent table (though identical) to make
-        // sure there's no accidental usage of those candidates
-        // N.B.: these are obtained with *other selections* in
-        //       the svertexer!
-        statisticsRegistry.v0stats[kCountV0forCascade]++;
-        v0fcindices(V0.posTrackId(), V0.negTrackId(),
-                    V0.collisionId(), V0.globalIndex());
-        v0fctrackXs(v0candidate.posTrackX, v0candidate.negTrackX);
-        v0fccores(v0candidate.pos[0], v0candidate.pos[1], v0candidate.pos[2],
-                  v0candidate.posP[0], v0candidate.posP[1], v0candidate.posP[2],
-                  v0candidate.negP[0], v0candidate.negP[1], v0candidate.negP[2],
-                  v0candidate.dcaV0dau,
-                  v0candidate.posDCAxy,
-                  v0candidate.negDCAxy,
-                  v0candidate.cosPA,
-                  v0candidate.dcav0topv,
-                  V0.v0Type());
+        buildSlice(0, 0, nV0s);
+      }
+      for (auto& statistics : threadStatistics) {
+        addStatistics(statistics);
+        statistics = StatisticsRegistry{};
       }
 
-      // populate V0 covariance matrices if required by any other task
-      if (createV0CovMats) {
-        // Calculate position covariance matrix
-        auto covVtxV = fitter.calcPCACovMatrix(0);
-        // std::array<float, 6> positionCovariance;
-        float positionCovariance[6];
-        positionCovariance[0] = covVtxV(0, 0);
-        positionCovariance[1] = covVtxV(1, 0);
-        positionCovariance[2] = covVtxV(1, 1);
-        positionCovariance[3] = covVtxV(2, 0);
-        positionCovariance[4] = covVtxV(2, 1);
-        positionCovariance[5] = covVtxV(2, 2);
-        std::array<float, 21> covTpositive = {0.};
-        std::array<float, 21> covTnegative = {0.};
-        std::array<float, 21> covTpositiveIU = {0.};
-        std::array<float, 21> covTnegativeIU = {0.};
-        // std::array<float, 6> momentumCovariance;
-        float momentumCovariance[6];
-        lPositiveTrack.getCovXYZPxPyPzGlo(covTpositive);
-        lNegativeTrack.getCovXYZPxPyPzGlo(covTnegative);
-        lPositiveTrackIU.getCovXYZPxPyPzGlo(covTpositiveIU);
-        lNegativeTrackIU.getCovXYZPxPyPzGlo(covTnegativeIU);
-        constexpr int MomInd[6] = {9, 13, 14, 18, 19, 20}; // cov matrix elements for momentum component
-        for (int i = 0; i < 6; i++) {
-          momentumCovariance[i] = covTpositive[MomInd[i]] + covTnegative[MomInd[i]];
+      for (int i = 0; i < nV0s; i++) {
+        if (!v0candidateValid[i]) {
+          continue; // doesn't pass selections
         }
-        if (V0.v0Type() > 0) {
-          if (V0.v0Type() > 1 && !storePhotonCandidates)
-            continue;
-          v0covs(positionCovariance, momentumCovariance);
-          if (createV0DauCovMats) {
-            // store momentum covariance matrix
-            float covariancePosTrack[21];
-            float covarianceNegTrack[21];
-            float covariancePosTrackIU[21];
-            float covarianceNegTrackIU[21];
-            for (int i = 0; i < 21; i++) {
-              covariancePosTrack[i] = covTpositive[i];
-              covarianceNegTrack[i] = covTnegative[i];
-              covariancePosTrackIU[i] = covTpositiveIU[i];
-              covarianceNegTrackIU[i] = covTnegativeIU[i];
-            }
-            v0daucovs(covariancePosTrack, covarianceNegTrack);
-            v0daucovIUs(covariancePosTrackIU, covarianceNegTrackIU);
-          }
-        } else {
-          v0fccovs(positionCovariance, momentumCovariance);
+        if (qaConfigurations.d_doQA) {
+          fillV0QAHistograms<TTrackTo>(chunk[i], v0candidates[i]);
         }
+        fillV0Tables<TTrackTo>(chunk[i], v0candidates[i]);
+      }
+      chunk.clear();
+    };
+
+    // Loops over all V0s in the time frame
+    for (auto& V0 : V0s) {
+      // downscale some V0s if requested to do so
+      if (downscalingOptions.downscaleFactor < 1.f && (static_cast<float>(rand_r(&randomSeed)) / static_cast<float>(RAND_MAX)) > downscalingOptions.downscaleFactor) {
+        buildChunk();
+        return;
+      }
+      chunk.push_back(V0);
+      if (chunk.size() == chunkSize) {
+        buildChunk();
       }
     }
+    buildChunk();
+
     // En masse histo filling at end of process call
     fillHistos();
     resetHistos();
@@ -22,6 +22,8 @@
 #include <array>
 #include <cstdlib>
 #include <map>
+#include <unordered_map>
+#include <vector>
 #include <iterator>
 #include <utility>
 
@@ -98,6 +100,12 @@ struct lambdakzeromcbuilder {
   mcV0info thisInfo;
   //*+-+*+-+*+-+*+-+*+-+*+-+*+-+*+-+*+-+*+-+*
 
+  // to be used if using the populateV0MCCoresAsymmetric mode, kept empty otherwise
+  // members, so that their capacity is kept from one dataframe to the next
+  std::vector<mcV0info> mcV0infos;                   // V0MCCore information
+  std::unordered_map<uint64_t, int> mcV0infoIndices; // packed prong indices -> index in mcV0infos
+  std::vector<bool> mcParticleIsReco;                // mc Particle not recoed by V0s
+
   // prong index combiner
   uint64_t combineProngIndices(uint32_t low, uint32_t high)
   {
@@ -108,9 +116,9 @@ struct lambdakzeromcbuilder {
   // build V0 labels
   void process(aod::V0Datas const& v0table, aod::McTrackLabels const&, aod::McParticles const& mcParticles)
   {
-    // to be used if using the populateV0MCCoresAsymmetric mode, kept empty otherwise
-    std::vector<mcV0info> mcV0infos; // V0MCCore information
-    std::vector<bool> mcParticleIsReco(mcParticles.size(), false); // mc Particle not recoed by V0s
+    mcV0infos.clear();
+    mcV0infoIndices.clear();
+    mcParticleIsReco.assign(mcParticles.size(), false);
 
     for (auto& v0 : v0table) {
       thisInfo.packedMcParticleIndices = 0; // not de-referenced properly yet
@@ -203,17 +211,20 @@ struct lambdakzeromcbuilder {
         int thisV0MCCoreIndex = -1;
         // step 1: check if this element is already provided in the table
         //         using the packedIndices variable calculated above
-        for (uint32_t ii = 0; ii < mcV0infos.size(); ii++) {
-          if (thisInfo.packedMcParticleIndices == mcV0infos[ii].packedMcParticleIndices && mcV0infos[ii].packedMcParticleIndices > 0) {
-            thisV0MCCoreIndex = ii;
+        if (thisInfo.packedMcParticleIndices > 0) {
+          auto found = mcV0infoIndices.find(thisInfo.packedMcParticleIndices);
+          if (found != mcV0infoIndices.end()) {
+            thisV0MCCoreIndex = found->second;
             histos.fill(HIST("hBuildingStatistics"), 2.0f); // found
-            break;                                          // this exists already in list
           }
         }
         if (thisV0MCCoreIndex < 0) {
           // this V0MCCore does not exist yet. Create it and reference it
           histos.fill(HIST("hBuildingStatistics"), 3.0f); // new
           thisV0MCCoreIndex = mcV0infos.size();
+          if (thisInfo.packedMcParticleIndices > 0) {
+            mcV0infoIndices.emplace(thisInfo.packedMcParticleIndices, thisV0MCCoreIndex);
+          }
           mcV0infos.push_back(thisInfo);
         }
         v0CoreMCLabels(thisV0MCCoreIndex); // interlink index
@@ -265,14 +276,14 @@ struct lambdakzeromcbuilder {
         }
       }
 
-      for (auto info : mcV0infos) {
+      for (const auto& info : mcV0infos) {
         v0mccores(
           info.label, info.pdgCode,
           info.pdgCodeMother, info.pdgCodePositive, info.pdgCodeNegative,
           info.isPhysicalPrimary, info.xyz[0], info.xyz[1], info.xyz[2],
           info.posP[0], info.posP[1], info.posP[2],
           info.negP[0], info.negP[1], info.negP[2]);
-        v0mccollref(thisInfo.mcCollision);
+        v0mccollref(info.mcCollision);
       }
     }
 
@@ -24,6 +24,7 @@
 #include <cmath>
 #include <array>
 #include <cstdlib>
+#include <vector>
 
 #include "Framework/runDataProcessing.h"
 #include "Framework/AnalysisTask.h"
@@ -51,6 +52,7 @@
 #include <TDatabasePDG.h>
 #include "Tools/ML/MlResponse.h"
 #include "Tools/ML/model.h"
+#include "Tools/ML/FeatureBuffer.h"
 
 using namespace o2;
 using namespace o2::analysis;
@@ -88,6 +90,7 @@ struct lambdakzeromlselection {
   Configurable<bool> PredictGamma{"PredictGamma", true, "Flag to enable or disable the loading of model"};
   Configurable<bool> PredictKZeroShort{"PredictKZeroShort", false, "Flag to enable or disable the loading of model"};
   Configurable<bool> fIsMC{"fIsMC", false, "If true, save additional MC info for analysis"};
+  Configurable<int> batchSize{"batchSize", 0, "Number of V0s scored per inference call in the batched processes, 0 for all the V0s of the dataframe"};
 
   // Feature selection masks:
 
@@ -118,6 +121,10 @@ struct lambdakzeromlselection {
   // base properties
   ConfigurableAxis vertexZ{"vertexZ", {30, -15.0f, 15.0f}, ""};
 
+  // batched inference: columnar features of the V0s of a dataframe and scores, reused between dataframes
+  o2::ml::FeatureBuffer featureBuffer;
+  std::vector<float> lambdaScores, antiLambdaScores, gammaScores, kZeroShortScores;
+
   int nCandidates = 0;
   void init(InitContext const&)
   {
@@ -201,6 +208,9 @@ struct lambdakzeromlselection {
     return selected_elements;
   }
 
+  // Number of base features, see processCandidate for the order
+  static constexpr size_t NBaseFeatures = 18;
+
   // Process candidate and store properties in object
   template <typename TV0Object, typename T>
   void processCandidate(TV0Object const& cand, const std::vector<T>& Feature_SelMask)
@@ -236,6 +246,81 @@ struct lambdakzeromlselection {
     }
   }
 
+  // Adds the base features of a candidate to the batch, same order as in processCandidate
+  template <typename TV0Object>
+  void addCandidateToBatch(TV0Object const& cand)
+  {
+    featureBuffer.addCandidate({cand.mLambda(), cand.mAntiLambda(),
+                                cand.mGamma(), cand.mK0Short(),
+                                cand.pt(), static_cast<float>(cand.qtarm()), cand.alpha(),
+                                cand.positiveeta(), cand.negativeeta(), cand.eta(),
+                                cand.z(), cand.v0radius(), static_cast<float>(TMath::ACos(cand.v0cosPA())),
+                                cand.dcapostopv(), cand.dcanegtopv(), cand.dcaV0daughters(),
+                                cand.dcav0topv(), cand.psipair()});
+  }
+
+  // Scores the candidates of the batch with one inference call per model and fills the score tables in candidate order
+  void evaluateBatch()
+  {
+    const size_t nBatch = featureBuffer.getNCandidates();
+    if (nBatch == 0) {
+      return;
+    }
+    size_t lambdaStride = 0, antiLambdaStride = 0, gammaStride = 0, kZeroShortStride = 0;
+    if (PredictLambda) {
+      lambdaStride = featureBuffer.evaluate(lambda_bdt, lambdaScores, Feature_SelMask);
+    }
+    if (PredictAntiLambda) {
+      antiLambdaStride = featureBuffer.evaluate(antilambda_bdt, antiLambdaScores, Feature_SelMask);
+    }
+    if (PredictGamma) {
+      gammaStride = featureBuffer.evaluate(gamma_bdt, gammaScores, Feature_SelMask);
+    }
+    if (PredictKZeroShort) {
+      kZeroShortStride = featureBuffer.evaluate(kzeroshort_bdt, kZeroShortScores, Feature_SelMask);
+    }
+    if ((PredictLambda && lambdaStride < 2) || (PredictAntiLambda && antiLambdaStride < 2) || (PredictGamma && gammaStride < 2) || (PredictKZeroShort && kZeroShortStride < 2)) {
+      LOG(fatal) << "Batched inference of " << nBatch << " V0s failed, the models must provide the two class probabilities per candidate!";
+    }
+    for (size_t iCandidate = 0; iCandidate < nBatch; iCandidate++) {
+      if (PredictLambda) {
+        lambdaMLSelections(lambdaScores[iCandidate * lambdaStride + 1]);
+      }
+      if (PredictGamma) {
+        gammaMLSelections(gammaScores[iCandidate * gammaStride + 1]);
+      }
+      if (PredictAntiLambda) {
+        antiLambdaMLSelections(antiLambdaScores[iCandidate * antiLambdaStride + 1]);
+      }
+      if (PredictKZeroShort) {
+        kZeroShortMLSelections(kZeroShortScores[iCandidate * kZeroShortStride + 1]);
+      }
+    }
+    featureBuffer.reset(NBaseFeatures);
+  }
+
+  // Scores all the V0s of the dataframe in batches; the V0s are taken in table order,
+  // without grouping by collision, so that the score tables stay aligned with the V0 table
+  template <typename TCollisions, typename TV0s>
+  void processBatched(TCollisions const& collisions, TV0s const& v0s)
+  {
+    for (const auto& coll : collisions) {
+      histos.fill(HIST("hEventVertexZ"), coll.posZ());
+    }
+    featureBuffer.reset(NBaseFeatures);
+    for (const auto& v0 : v0s) {
+      nCandidates++;
+      if (nCandidates % 50000 == 0) {
+        LOG(info) << "Candidates processed: " << nCandidates;
+      }
+      addCandidateToBatch(v0);
+      if (batchSize > 0 && featureBuffer.getNCandidates() >= static_cast<size_t>(batchSize.value)) {
+        evaluateBatch();
+      }
+    }
+    evaluateBatch();
+  }
+
   void processDerivedData(aod::StraCollision const& coll, V0DerivedDatas const& v0s)
   {
     histos.fill(HIST("hEventVertexZ"), coll.posZ());
@@ -259,8 +344,19 @@ struct lambdakzeromlselection {
     }
   }
 
+  void processStandardDataBatched(aod::Collisions const& collisions, V0OriginalDatas const& v0s)
+  {
+    processBatched(collisions, v0s);
+  }
+  void processDerivedDataBatched(aod::StraCollisions const& collisions, V0DerivedDatas const& v0s)
+  {
+    processBatched(collisions, v0s);
+  }
+
   PROCESS_SWITCH(lambdakzeromlselection, processStandardData, "Process standard data", false);
   PROCESS_SWITCH(lambdakzeromlselection, processDerivedData, "Process derived data", true);
+  PROCESS_SWITCH(lambdakzeromlselection, processStandardDataBatched, "Process standard data, with batched inference", false);
+  PROCESS_SWITCH(lambdakzeromlselection, processDerivedDataBatched, "Process derived data, with batched inference", false);
 };
 
 WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
@@ -24,6 +24,7 @@
 #include <cmath>
 #include <array>
 #include <cstdlib>
+#include <vector>
 
 #include "Framework/runDataProcessing.h"
 #include "Framework/AnalysisTask.h"
@@ -127,27 +128,25 @@ struct sigma0builder {
     histos.get<TH1>(HIST("hCandidateBuilderSelection"))->GetXaxis()->SetBinLabel(10, "Lambda DCADau Cut");
   }
 
-  // Process sigma candidate and store properties in object
+  // V0 of the collision passing the photon or the Lambda selection, with the momentum used to build the Sigma0 mass
+  struct SelectedV0 {
+    int64_t globalIndex;
+    std::array<float, 3> pVec;
+  };
+  std::vector<SelectedV0> selectedPhotons; // photon candidates of the current collision
+  std::vector<SelectedV0> selectedLambdas; // Lambda and AntiLambda candidates of the current collision
+
+  // Photon selection, evaluated once per V0
   template <typename TV0Object>
-  bool processSigmaCandidate(TV0Object const& lambda, TV0Object const& gamma)
+  bool isPhotonSelected(TV0Object const& gamma)
   {
-    if ((lambda.v0Type() == 0) || (gamma.v0Type() == 0))
+    if (gamma.v0Type() == 0)
       return false;
 
-    if constexpr (
-      requires { gamma.gammaBDTScore(); } &&
-      requires { lambda.lambdaBDTScore(); } &&
-      requires { lambda.antiLambdaBDTScore(); }) {
-
-      LOGF(info, "X-check: ML Selection is on!");
+    if constexpr (requires { gamma.gammaBDTScore(); }) {
       // Gamma selection:
       if (gamma.gammaBDTScore() <= Gamma_MLThreshold)
         return false;
-
-      // Lambda and AntiLambda selection
-      if ((lambda.lambdaBDTScore() <= Lambda_MLThreshold) && (lambda.antiLambdaBDTScore() <= AntiLambda_MLThreshold))
-        return false;
-
     } else {
       // Standard selection
       // Gamma basic selection criteria:
@@ -166,7 +165,25 @@ struct sigma0builder {
       if ((gamma.v0radius() < PhotonMinRadius) || (gamma.v0radius() > PhotonMaxRadius))
         return false;
       histos.fill(HIST("hCandidateBuilderSelection"), 4.);
+    }
+    return true;
+  }
 
+  // Lambda and AntiLambda selection, evaluated once per V0
+  template <typename TV0Object>
+  bool isLambdaSelected(TV0Object const& lambda)
+  {
+    if (lambda.v0Type() == 0)
+      return false;
+
+    if constexpr (
+      requires { lambda.lambdaBDTScore(); } &&
+      requires { lambda.antiLambdaBDTScore(); }) {
+      // Lambda and AntiLambda selection
+      if ((lambda.lambdaBDTScore() <= Lambda_MLThreshold) && (lambda.antiLambdaBDTScore() <= AntiLambda_MLThreshold))
+        return false;
+    } else {
+      // Standard selection
       // Lambda basic selection criteria:
       if (TMath::Abs(lambda.mLambda() - 1.115683) > LambdaWindow)
         return false;
@@ -184,17 +201,33 @@ struct sigma0builder {
         return false;
       histos.fill(HIST("hCandidateBuilderSelection"), 9.);
     }
-    // Sigma0 candidate properties
-    std::array<float, 3> pVecPhotons{gamma.px(), gamma.py(), gamma.pz()};
-    std::array<float, 3> pVecLambda{lambda.px(), lambda.py(), lambda.pz()};
-    auto arrMom = std::array{pVecPhotons, pVecLambda};
-    float sigmamass = RecoDecay::m(arrMom, std::array{o2::constants::physics::MassPhoton, o2::constants::physics::MassLambda0});
+    return true;
+  }
 
-    if (TMath::Abs(sigmamass - 1.192642) > Sigma0Window)
-      return false;
+  // Split the V0s of a collision into photon and Lambda candidates, keeping the order of the V0 table
+  template <typename TV0s>
+  void selectV0s(TV0s const& V0Table_thisCollision)
+  {
+    selectedPhotons.clear();
+    selectedLambdas.clear();
+    for (const auto& v0 : V0Table_thisCollision) {
+      if (isPhotonSelected(v0)) {
+        selectedPhotons.push_back({v0.globalIndex(), {v0.px(), v0.py(), v0.pz()}});
+      }
+      if (isLambdaSelected(v0)) {
+        selectedLambdas.push_back({v0.globalIndex(), {v0.px(), v0.py(), v0.pz()}});
+      }
+    }
+  }
 
-    return true;
+  // Sigma0 mass window of a photon-Lambda pair
+  bool isInSigma0Window(SelectedV0 const& gamma, SelectedV0 const& lambda)
+  {
+    auto arrMom = std::array{gamma.pVec, lambda.pVec};
+    float sigmamass = RecoDecay::m(arrMom, std::array{o2::constants::physics::MassPhoton, o2::constants::physics::MassLambda0});
+    return TMath::Abs(sigmamass - 1.192642) <= Sigma0Window;
   }
+
   // Helper struct to pass v0 information
   struct {
     float mass;
@@ -332,11 +365,14 @@ struct sigma0builder {
       auto V0Table_thisCollision = V0s.sliceBy(perCollisionMCDerived, collIdx);
 
       // V0 table sliced
-      for (auto& gamma : V0Table_thisCollision) {    // selecting photons from Sigma0
-        for (auto& lambda : V0Table_thisCollision) { // selecting lambdas from Sigma0
-          if (!processSigmaCandidate(lambda, gamma))
+      selectV0s(V0Table_thisCollision);
+      for (const auto& selectedPhoton : selectedPhotons) {   // selecting photons from Sigma0
+        for (const auto& selectedLambda : selectedLambdas) { // selecting lambdas from Sigma0
+          if (!isInSigma0Window(selectedPhoton, selectedLambda))
             continue;
 
+          auto gamma = V0s.rawIteratorAt(selectedPhoton.globalIndex);
+          auto lambda = V0s.rawIteratorAt(selectedLambda.globalIndex);
           bool fIsSigma = false;
           if ((gamma.pdgCode() == 22) && (gamma.pdgCodeMother() == 3212) && (lambda.pdgCode() == 3122) && (lambda.pdgCodeMother() == 3212) && (gamma.motherMCPartId() == lambda.motherMCPartId()))
             fIsSigma = true;
@@ -358,11 +394,14 @@ struct sigma0builder {
       v0sigma0Coll(coll.posX(), coll.posY(), coll.posZ(), coll.centFT0M(), coll.centFT0A(), coll.centFT0C(), coll.centFV0A());
 
       // V0 table sliced
-      for (auto& gamma : V0Table_thisCollision) {    // selecting photons from Sigma0
-        for (auto& lambda : V0Table_thisCollision) { // selecting lambdas from Sigma0
-          if (!processSigmaCandidate(lambda, gamma)) // applying selection for reconstruction
+      selectV0s(V0Table_thisCollision);
+      for (const auto& selectedPhoton : selectedPhotons) {   // selecting photons from Sigma0
+        for (const auto& selectedLambda : selectedLambdas) { // selecting lambdas from Sigma0
+          if (!isInSigma0Window(selectedPhoton, selectedLambda)) // applying the Sigma0 mass window to the selected pairs
             continue;
 
+          auto gamma = V0s.rawIteratorAt(selectedPhoton.globalIndex);
+          auto lambda = V0s.rawIteratorAt(selectedLambda.globalIndex);
           nSigmaCandidates++;
           if (nSigmaCandidates % 5000 == 0) {
             LOG(info) << "Sigma0 Candidates built: " << nSigmaCandidates;
@@ -385,11 +424,14 @@ struct sigma0builder {
       v0sigma0Coll(coll.posX(), coll.posY(), coll.posZ(), coll.centFT0M(), coll.centFT0A(), coll.centFT0C(), coll.centFV0A());
 
       // V0 table sliced
-      for (auto& gamma : V0Table_thisCollision) {    // selecting photons from Sigma0
-        for (auto& lambda : V0Table_thisCollision) { // selecting lambdas from Sigma0
-          if (!processSigmaCandidate(lambda, gamma))
+      selectV0s(V0Table_thisCollision);
+      for (const auto& selectedPhoton : selectedPhotons) {   // selecting photons from Sigma0
+        for (const auto& selectedLambda : selectedLambdas) { // selecting lambdas from Sigma0
+          if (!isInSigma0Window(selectedPhoton, selectedLambda)) // applying the Sigma0 mass window to the selected pairs
             continue;
 
+          auto gamma = V0s.rawIteratorAt(selectedPhoton.globalIndex);
+          auto lambda = V0s.rawIteratorAt(selectedLambda.globalIndex);
           nSigmaCandidates++;
           if (nSigmaCandidates % 5000 == 0) {
             LOG(info) << "Sigma0 Candidates built: " << nSigmaCandidates;
@@ -21,6 +21,7 @@
 #include <map>
 #include <iterator>
 #include <utility>
+#include <vector>
 
 #include "Framework/runDataProcessing.h"
 #include "Framework/RunningWorkflowInfo.h"
@@ -175,12 +176,11 @@ struct strangederivedbuilder {
   Configurable<bool> qaCentrality{"qaCentrality", false, "qa centrality flag: check base raw values"};
 
   // For manual sliceBy
-  Preslice<aod::V0Datas> V0perCollision = o2::aod::v0data::collisionId;
-  Preslice<aod::CascDatas> CascperCollision = o2::aod::cascdata::collisionId;
-  Preslice<aod::KFCascDatas> KFCascperCollision = o2::aod::cascdata::collisionId;
-  Preslice<aod::TraCascDatas> TraCascperCollision = o2::aod::cascdata::collisionId;
   Preslice<aod::McParticles> mcParticlePerMcCollision = o2::aod::mcparticle::mcCollisionId;
 
+  std::vector<int> collisionMap; // derived collision index of each original collision, reused between dataframes
+  std::vector<int> trackMap;     // derived daughter track index of each original track, reused between dataframes
+
   std::vector<uint32_t> genK0Short;
   std::vector<uint32_t> genLambda;
   std::vector<uint32_t> genAntiLambda;
@@ -250,130 +250,103 @@ struct strangederivedbuilder {
     }
   }
 
-  void processCollisionsV0sOnly(soa::Join<aod::Collisions, aod::FT0Mults, aod::FV0Mults, aod::PVMults, aod::ZDCMults, aod::CentFT0Ms, aod::CentFT0As, aod::CentFT0Cs, aod::CentFV0As, aod::EvSels, aod::MultsExtra, aod::MultsGlobal> const& collisions, aod::V0Datas const& V0s, aod::BCsWithTimestamps const&)
+  // marks the collisions with at least one candidate of the table, with a single traversal of the candidates
+  template <typename TCandidates>
+  void markStrangeCollisions(TCandidates const& candidates, std::vector<bool>& collisionIsStrange)
   {
-    for (const auto& collision : collisions) {
-      const uint64_t collIdx = collision.globalIndex();
-      auto V0Table_thisColl = V0s.sliceBy(V0perCollision, collIdx);
-      bool strange = V0Table_thisColl.size() > 0;
-      // casc table sliced
-      if (strange || fillEmptyCollisions) {
-        strangeColl(collision.posX(), collision.posY(), collision.posZ());
-        strangeCents(collision.centFT0M(), collision.centFT0A(),
-                     collision.centFT0C(), collision.centFV0A());
-        strangeEvSels(collision.sel8(), collision.selection_raw());
-        auto bc = collision.bc_as<aod::BCsWithTimestamps>();
-        strangeStamps(bc.runNumber(), bc.timestamp());
-
-        if (fillRawFT0C || fillRawFT0C || fillRawFV0A || fillRawNTracksEta1 || fillRawZDC) {
-          strangeRawCents(collision.multFT0A() * static_cast<float>(fillRawFT0A),
-                          collision.multFT0C() * static_cast<float>(fillRawFT0C),
-                          collision.multFV0A() * static_cast<float>(fillRawFV0A),
-                          collision.multNTracksPVeta1() * static_cast<int>(fillRawNTracksEta1),
-                          collision.multPVTotalContributors() * static_cast<int>(fillRawNTracksForCorrelation),
-                          collision.multNTracksGlobal() * static_cast<int>(fillRawNTracksForCorrelation),
-                          collision.multNTracksITSTPC() * static_cast<int>(fillRawNTracksForCorrelation),
-                          collision.multAllTracksTPCOnly() * static_cast<int>(fillRawNTracksForCorrelation),
-                          collision.multAllTracksITSTPC() * static_cast<int>(fillRawNTracksForCorrelation),
-                          collision.multZNA() * static_cast<float>(fillRawZDC),
-                          collision.multZNC() * static_cast<float>(fillRawZDC),
-                          collision.multZEM1() * static_cast<float>(fillRawZDC),
-                          collision.multZEM2() * static_cast<float>(fillRawZDC),
-                          collision.multZPA() * static_cast<float>(fillRawZDC),
-                          collision.multZPC() * static_cast<float>(fillRawZDC),
-                          collision.trackOccupancyInTimeRange());
-        }
+    for (const auto& candidate : candidates) {
+      if (candidate.collisionId() >= 0) {
+        collisionIsStrange[candidate.collisionId()] = true;
       }
-      for (int i = 0; i < V0Table_thisColl.size(); i++)
-        v0collref(strangeColl.lastIndex());
     }
   }
 
-  void processCollisions(soa::Join<aod::Collisions, aod::FT0Mults, aod::FV0Mults, aod::PVMults, aod::ZDCMults, aod::CentFT0Ms, aod::CentFT0As, aod::CentFT0Cs, aod::CentFV0As, aod::EvSels, aod::MultsExtra, aod::MultsGlobal> const& collisions, aod::V0Datas const& V0s, aod::CascDatas const& Cascades, aod::KFCascDatas const& KFCascades, aod::TraCascDatas const& TraCascades, aod::BCsWithTimestamps const&)
+  // populates the collision references of a candidate table, including the candidates that might not be assigned
+  template <typename TCandidates, typename TCollRefs>
+  void fillCollisionReferences(TCandidates const& candidates, std::vector<int> const& collisionMap, TCollRefs& collRefs)
   {
-    // create collision indices beforehand
-    std::vector<int> V0CollIndices(V0s.size(), -1);                 // index -1: no collision
-    std::vector<int> CascadeCollIndices(Cascades.size(), -1);       // index -1: no collision
-    std::vector<int> KFCascadeCollIndices(KFCascades.size(), -1);   // index -1: no collision
-    std::vector<int> TraCascadeCollIndices(TraCascades.size(), -1); // index -1: no collision
+    for (const auto& candidate : candidates) {
+      collRefs(candidate.collisionId() >= 0 ? collisionMap[candidate.collisionId()] : -1);
+    }
+  }
 
+  // emits the derived collision tables: every derived index is known from collisionMap after a single
+  // traversal of the candidate tables, without slicing them per collision
+  template <typename TCollisions>
+  void fillStrangeCollisions(TCollisions const& collisions, std::vector<bool> const& collisionIsStrange, std::vector<int>& collisionMap)
+  {
+    collisionMap.assign(collisions.size(), -1); // index -1: not stored
+    const bool fillRawCents = fillRawFT0A || fillRawFT0C || fillRawFV0A || fillRawNTracksEta1 || fillRawNTracksForCorrelation || fillRawZDC;
+    auto hRawCentrality = histos.get<TH1>(HIST("hRawCentrality"));
     for (const auto& collision : collisions) {
       const uint64_t collIdx = collision.globalIndex();
+      if (!collisionIsStrange[collIdx] && !fillEmptyCollisions) {
+        continue;
+      }
 
       float centrality = collision.centFT0C();
       if (qaCentrality) {
-        auto hRawCentrality = histos.get<TH1>(HIST("hRawCentrality"));
         centrality = hRawCentrality->GetBinContent(hRawCentrality->FindBin(collision.multFT0C()));
       }
 
-      auto V0Table_thisColl = V0s.sliceBy(V0perCollision, collIdx);
-      auto CascTable_thisColl = Cascades.sliceBy(CascperCollision, collIdx);
-      auto KFCascTable_thisColl = KFCascades.sliceBy(KFCascperCollision, collIdx);
-      auto TraCascTable_thisColl = TraCascades.sliceBy(TraCascperCollision, collIdx);
-      bool strange = V0Table_thisColl.size() > 0 ||
-                     CascTable_thisColl.size() > 0 ||
-                     KFCascTable_thisColl.size() > 0 ||
-                     TraCascTable_thisColl.size() > 0;
-      // casc table sliced
-      if (strange || fillEmptyCollisions) {
-        strangeColl(collision.posX(), collision.posY(), collision.posZ());
-        strangeCents(collision.centFT0M(), collision.centFT0A(),
-                     centrality, collision.centFV0A());
-        strangeEvSels(collision.sel8(), collision.selection_raw());
-        auto bc = collision.bc_as<aod::BCsWithTimestamps>();
-        strangeStamps(bc.runNumber(), bc.timestamp());
-
-        if (fillRawFT0C || fillRawFT0C || fillRawFV0A || fillRawNTracksEta1 || fillRawZDC) {
-          strangeRawCents(collision.multFT0A() * static_cast<float>(fillRawFT0A),
-                          collision.multFT0C() * static_cast<float>(fillRawFT0C),
-                          collision.multFV0A() * static_cast<float>(fillRawFV0A),
-                          collision.multNTracksPVeta1() * static_cast<int>(fillRawNTracksEta1),
-                          collision.multPVTotalContributors() * static_cast<int>(fillRawNTracksForCorrelation),
-                          collision.multNTracksGlobal() * static_cast<int>(fillRawNTracksForCorrelation),
-                          collision.multNTracksITSTPC() * static_cast<int>(fillRawNTracksForCorrelation),
-                          collision.multAllTracksTPCOnly() * static_cast<int>(fillRawNTracksForCorrelation),
-                          collision.multAllTracksITSTPC() * static_cast<int>(fillRawNTracksForCorrelation),
-                          collision.multZNA() * static_cast<float>(fillRawZDC),
-                          collision.multZNC() * static_cast<float>(fillRawZDC),
-                          collision.multZEM1() * static_cast<float>(fillRawZDC),
-                          collision.multZEM2() * static_cast<float>(fillRawZDC),
-                          collision.multZPA() * static_cast<float>(fillRawZDC),
-                          collision.multZPC() * static_cast<float>(fillRawZDC),
-                          collision.trackOccupancyInTimeRange());
-        }
+      strangeColl(collision.posX(), collision.posY(), collision.posZ());
+      if constexpr (requires { collision.mcCollisionId(); }) {
+        strangeCollLabels(collision.mcCollisionId());
       }
-
-      for (const auto& v0 : V0Table_thisColl)
-        V0CollIndices[v0.globalIndex()] = strangeColl.lastIndex();
-      for (const auto& casc : CascTable_thisColl)
-        CascadeCollIndices[casc.globalIndex()] = strangeColl.lastIndex();
-      for (const auto& casc : KFCascTable_thisColl)
-        KFCascadeCollIndices[casc.globalIndex()] = strangeColl.lastIndex();
-      for (const auto& casc : TraCascTable_thisColl)
-        TraCascadeCollIndices[casc.globalIndex()] = strangeColl.lastIndex();
+      strangeCents(collision.centFT0M(), collision.centFT0A(),
+                   centrality, collision.centFV0A());
+      strangeEvSels(collision.sel8(), collision.selection_raw());
+      auto bc = collision.template bc_as<aod::BCsWithTimestamps>();
+      strangeStamps(bc.runNumber(), bc.timestamp());
+
+      if (fillRawCents) {
+        strangeRawCents(collision.multFT0A() * static_cast<float>(fillRawFT0A),
+                        collision.multFT0C() * static_cast<float>(fillRawFT0C),
+                        collision.multFV0A() * static_cast<float>(fillRawFV0A),
+                        collision.multNTracksPVeta1() * static_cast<int>(fillRawNTracksEta1),
+                        collision.multPVTotalContributors() * static_cast<int>(fillRawNTracksForCorrelation),
+                        collision.multNTracksGlobal() * static_cast<int>(fillRawNTracksForCorrelation),
+                        collision.multNTracksITSTPC() * static_cast<int>(fillRawNTracksForCorrelation),
+                        collision.multAllTracksTPCOnly() * static_cast<int>(fillRawNTracksForCorrelation),
+                        collision.multAllTracksITSTPC() * static_cast<int>(fillRawNTracksForCorrelation),
+                        collision.multZNA() * static_cast<float>(fillRawZDC),
+                        collision.multZNC() * static_cast<float>(fillRawZDC),
+                        collision.multZEM1() * static_cast<float>(fillRawZDC),
+                        collision.multZEM2() * static_cast<float>(fillRawZDC),
+                        collision.multZPA() * static_cast<float>(fillRawZDC),
+                        collision.multZPC() * static_cast<float>(fillRawZDC),
+                        collision.trackOccupancyInTimeRange());
+      }
+      collisionMap[collIdx] = strangeColl.lastIndex();
     }
+  }
 
-    // populate references, including those that might not be assigned
-    for (const auto& v0 : V0s)
-      v0collref(V0CollIndices[v0.globalIndex()]);
-    for (const auto& casc : Cascades)
-      casccollref(CascadeCollIndices[casc.globalIndex()]);
-    for (const auto& casc : KFCascades)
-      kfcasccollref(KFCascadeCollIndices[casc.globalIndex()]);
-    for (const auto& casc : KFCascades)
-      tracasccollref(TraCascadeCollIndices[casc.globalIndex()]);
+  void processCollisionsV0sOnly(soa::Join<aod::Collisions, aod::FT0Mults, aod::FV0Mults, aod::PVMults, aod::ZDCMults, aod::CentFT0Ms, aod::CentFT0As, aod::CentFT0Cs, aod::CentFV0As, aod::EvSels, aod::MultsExtra, aod::MultsGlobal> const& collisions, aod::V0Datas const& V0s, aod::BCsWithTimestamps const&)
+  {
+    std::vector<bool> collisionIsStrange(collisions.size(), false);
+    markStrangeCollisions(V0s, collisionIsStrange);
+    fillStrangeCollisions(collisions, collisionIsStrange, collisionMap);
+    fillCollisionReferences(V0s, collisionMap, v0collref);
   }
 
-  void processCollisionsMC(soa::Join<aod::Collisions, aod::FT0Mults, aod::FV0Mults, aod::PVMults, aod::ZDCMults, aod::CentFT0Ms, aod::CentFT0As, aod::CentFT0Cs, aod::CentFV0As, aod::EvSels, aod::McCollisionLabels, aod::MultsExtra, aod::MultsGlobal> const& collisions, soa::Join<aod::V0Datas, aod::McV0Labels> const& V0s, soa::Join<aod::V0MCCores, aod::McV0Labels> const& V0MCCores, soa::Join<aod::CascDatas, aod::McCascLabels> const& Cascades, aod::KFCascDatas const& KFCascades, aod::TraCascDatas const& TraCascades, aod::BCsWithTimestamps const&, soa::Join<aod::McCollisions, aod::MultsExtraMC> const& mcCollisions, aod::McParticles const&)
+  void processCollisions(soa::Join<aod::Collisions, aod::FT0Mults, aod::FV0Mults, aod::PVMults, aod::ZDCMults, aod::CentFT0Ms, aod::CentFT0As, aod::CentFT0Cs, aod::CentFV0As, aod::EvSels, aod::MultsExtra, aod::MultsGlobal> const& collisions, aod::V0Datas const& V0s, aod::CascDatas const& Cascades, aod::KFCascDatas const& KFCascades, aod::TraCascDatas const& TraCascades, aod::BCsWithTimestamps const&)
   {
-    // create collision indices beforehand
-    std::vector<int> V0CollIndices(V0s.size(), -1);                 // index -1: no collision
-    std::vector<int> V0MCCollIndices(V0s.size(), -1);               // index -1: no collision
-    std::vector<int> CascadeCollIndices(Cascades.size(), -1);       // index -1: no collision
-    std::vector<int> CascadeMCCollIndices(Cascades.size(), -1);     // index -1: no collision
-    std::vector<int> KFCascadeCollIndices(KFCascades.size(), -1);   // index -1: no collision
-    std::vector<int> TraCascadeCollIndices(TraCascades.size(), -1); // index -1: no collision
+    std::vector<bool> collisionIsStrange(collisions.size(), false);
+    markStrangeCollisions(V0s, collisionIsStrange);
+    markStrangeCollisions(Cascades, collisionIsStrange);
+    markStrangeCollisions(KFCascades, collisionIsStrange);
+    markStrangeCollisions(TraCascades, collisionIsStrange);
+    fillStrangeCollisions(collisions, collisionIsStrange, collisionMap);
 
+    // populate references, including those that might not be assigned
+    fillCollisionReferences(V0s, collisionMap, v0collref);
+    fillCollisionReferences(Cascades, collisionMap, casccollref);
+    fillCollisionReferences(KFCascades, collisionMap, kfcasccollref);
+    fillCollisionReferences(TraCascades, collisionMap, tracasccollref);
+  }
+
+  void processCollisionsMC(soa::Join<aod::Collisions, aod::FT0Mults, aod::FV0Mults, aod::PVMults, aod::ZDCMults, aod::CentFT0Ms, aod::CentFT0As, aod::CentFT0Cs, aod::CentFV0As, aod::EvSels, aod::McCollisionLabels, aod::MultsExtra, aod::MultsGlobal> const& collisions, soa::Join<aod::V0Datas, aod::McV0Labels> const& V0s, soa::Join<aod::V0MCCores, aod::McV0Labels> const& /*V0MCCores*/, soa::Join<aod::CascDatas, aod::McCascLabels> const& Cascades, aod::KFCascDatas const& KFCascades, aod::TraCascDatas const& TraCascades, aod::BCsWithTimestamps const&, soa::Join<aod::McCollisions, aod::MultsExtraMC> const& mcCollisions, aod::McParticles const&)
+  {
     // ______________________________________________
     // fill all MC collisions, correlate via index later on
     for (const auto& mccollision : mcCollisions) {
@@ -385,86 +358,29 @@ struct strangederivedbuilder {
     }
 
     // ______________________________________________
-    for (const auto& collision : collisions) {
-      const uint64_t collIdx = collision.globalIndex();
-
-      float centrality = collision.centFT0C();
-      if (qaCentrality) {
-        auto hRawCentrality = histos.get<TH1>(HIST("hRawCentrality"));
-        centrality = hRawCentrality->GetBinContent(hRawCentrality->FindBin(collision.multFT0C()));
-      }
-
-      auto V0Table_thisColl = V0s.sliceBy(V0perCollision, collIdx);
-      auto CascTable_thisColl = Cascades.sliceBy(CascperCollision, collIdx);
-      auto KFCascTable_thisColl = KFCascades.sliceBy(KFCascperCollision, collIdx);
-      auto TraCascTable_thisColl = TraCascades.sliceBy(TraCascperCollision, collIdx);
-      bool strange = V0Table_thisColl.size() > 0 ||
-                     CascTable_thisColl.size() > 0 ||
-                     KFCascTable_thisColl.size() > 0 ||
-                     TraCascTable_thisColl.size() > 0;
-      // casc table sliced
-      if (strange || fillEmptyCollisions) {
-        strangeColl(collision.posX(), collision.posY(), collision.posZ());
-        strangeCollLabels(collision.mcCollisionId());
-        strangeCents(collision.centFT0M(), collision.centFT0A(),
-                     centrality, collision.centFV0A());
-        strangeEvSels(collision.sel8(), collision.selection_raw());
-        auto bc = collision.bc_as<aod::BCsWithTimestamps>();
-        strangeStamps(bc.runNumber(), bc.timestamp());
-
-        if (fillRawFT0C || fillRawFT0C || fillRawFV0A || fillRawNTracksEta1 || fillRawZDC) {
-          strangeRawCents(collision.multFT0A() * static_cast<float>(fillRawFT0A),
-                          collision.multFT0C() * static_cast<float>(fillRawFT0C),
-                          collision.multFV0A() * static_cast<float>(fillRawFV0A),
-                          collision.multNTracksPVeta1() * static_cast<int>(fillRawNTracksEta1),
-                          collision.multPVTotalContributors() * static_cast<int>(fillRawNTracksForCorrelation),
-                          collision.multNTracksGlobal() * static_cast<int>(fillRawNTracksForCorrelation),
-                          collision.multNTracksITSTPC() * static_cast<int>(fillRawNTracksForCorrelation),
-                          collision.multAllTracksTPCOnly() * static_cast<int>(fillRawNTracksForCorrelation),
-                          collision.multAllTracksITSTPC() * static_cast<int>(fillRawNTracksForCorrelation),
-                          collision.multZNA() * static_cast<float>(fillRawZDC),
-                          collision.multZNC() * static_cast<float>(fillRawZDC),
-                          collision.multZEM1() * static_cast<float>(fillRawZDC),
-                          collision.multZEM2() * static_cast<float>(fillRawZDC),
-                          collision.multZPA() * static_cast<float>(fillRawZDC),
-                          collision.multZPC() * static_cast<float>(fillRawZDC),
-                          collision.trackOccupancyInTimeRange());
-        }
-      }
-      for (const auto& v0 : V0Table_thisColl)
-        V0CollIndices[v0.globalIndex()] = strangeColl.lastIndex();
-      for (const auto& casc : CascTable_thisColl)
-        CascadeCollIndices[casc.globalIndex()] = strangeColl.lastIndex();
-      for (const auto& casc : KFCascTable_thisColl)
-        KFCascadeCollIndices[casc.globalIndex()] = strangeColl.lastIndex();
-      for (const auto& casc : TraCascTable_thisColl)
-        TraCascadeCollIndices[casc.globalIndex()] = strangeColl.lastIndex();
-    }
+    std::vector<bool> collisionIsStrange(collisions.size(), false);
+    markStrangeCollisions(V0s, collisionIsStrange);
+    markStrangeCollisions(Cascades, collisionIsStrange);
+    markStrangeCollisions(KFCascades, collisionIsStrange);
+    markStrangeCollisions(TraCascades, collisionIsStrange);
+    fillStrangeCollisions(collisions, collisionIsStrange, collisionMap);
 
     // populate references, including those that might not be assigned
-    for (const auto& v0 : V0s) {
-      v0collref(V0CollIndices[v0.globalIndex()]);
-    }
-    for (const auto& casc : Cascades) {
-      casccollref(CascadeCollIndices[casc.globalIndex()]);
-    }
-    for (const auto& casc : KFCascades)
-      kfcasccollref(KFCascadeCollIndices[casc.globalIndex()]);
-    for (const auto& casc : KFCascades)
-      tracasccollref(TraCascadeCollIndices[casc.globalIndex()]);
+    fillCollisionReferences(V0s, collisionMap, v0collref);
+    fillCollisionReferences(Cascades, collisionMap, casccollref);
+    fillCollisionReferences(KFCascades, collisionMap, kfcasccollref);
+    fillCollisionReferences(TraCascades, collisionMap, tracasccollref);
   }
 
   void processTrackExtrasV0sOnly(aod::V0Datas const& V0s, TracksWithExtra const& tracksExtra)
   {
-    std::vector<int> trackMap(tracksExtra.size(), -1); // index -1: not used
+    trackMap.assign(tracksExtra.size(), -1); // index -1: not used
 
     //__________________________________________________
     // mark tracks that belong to V0s
     for (auto const& v0 : V0s) {
-      auto const& posTrack = v0.posTrack_as<TracksWithExtra>();
-      auto const& negTrack = v0.negTrack_as<TracksWithExtra>();
-      trackMap[posTrack.globalIndex()] = 0;
-      trackMap[negTrack.globalIndex()] = 0;
+      trackMap[v0.posTrackId()] = 0;
+      trackMap[v0.negTrackId()] = 0;
     }
     //__________________________________________________
     // Figure out the numbering of the new tracks table
@@ -478,10 +394,8 @@ struct strangederivedbuilder {
     //__________________________________________________
     // populate track references
     for (auto const& v0 : V0s) {
-      auto const& posTrack = v0.posTrack_as<TracksWithExtra>();
-      auto const& negTrack = v0.negTrack_as<TracksWithExtra>();
-      v0Extras(trackMap[posTrack.globalIndex()],
-               trackMap[negTrack.globalIndex()]); // joinable with V0Datas
+      v0Extras(trackMap[v0.posTrackId()],
+               trackMap[v0.negTrackId()]); // joinable with V0Datas
     }
     //__________________________________________________
     // circle back and populate actual DauTrackExtra table
@@ -498,48 +412,36 @@ struct strangederivedbuilder {
   template <typename V0Datas, typename CascDatas, typename KFCascDatas, typename TraCascDatas, typename tracksWithExtra>
   void fillTrackExtras(V0Datas const& V0s, CascDatas const& Cascades, KFCascDatas const& KFCascades, TraCascDatas const& TraCascades, tracksWithExtra const& tracksExtra)
   {
-    std::vector<int> trackMap(tracksExtra.size(), -1); // index -1: not used
+    trackMap.assign(tracksExtra.size(), -1); // index -1: not used
 
     //__________________________________________________
     // mark tracks that belong to V0s
     for (auto const& v0 : V0s) {
-      auto const& posTrack = v0.template posTrack_as<tracksWithExtra>();
-      auto const& negTrack = v0.template negTrack_as<tracksWithExtra>();
-      trackMap[posTrack.globalIndex()] = 0;
-      trackMap[negTrack.globalIndex()] = 0;
+      trackMap[v0.posTrackId()] = 0;
+      trackMap[v0.negTrackId()] = 0;
     }
 
     //__________________________________________________
     // index tracks that belong to CascDatas
     for (auto const& casc : Cascades) {
-      auto bachTrack = casc.template bachelor_as<tracksWithExtra>();
-      auto posTrack = casc.template posTrack_as<tracksWithExtra>();
-      auto negTrack = casc.template negTrack_as<tracksWithExtra>();
-      trackMap[posTrack.globalIndex()] = 0;
-      trackMap[negTrack.globalIndex()] = 0;
-      trackMap[bachTrack.globalIndex()] = 0;
+      trackMap[casc.posTrackId()] = 0;
+      trackMap[casc.negTrackId()] = 0;
+      trackMap[casc.bachelorId()] = 0;
     }
     //__________________________________________________
     // index tracks that belong to KFCascDatas
     for (auto const& casc : KFCascades) {
-      auto bachTrack = casc.template bachelor_as<tracksWithExtra>();
-      auto posTrack = casc.template posTrack_as<tracksWithExtra>();
-      auto negTrack = casc.template negTrack_as<tracksWithExtra>();
-      trackMap[posTrack.globalIndex()] = 0;
-      trackMap[negTrack.globalIndex()] = 0;
-      trackMap[bachTrack.globalIndex()] = 0;
+      trackMap[casc.posTrackId()] = 0;
+      trackMap[casc.negTrackId()] = 0;
+      trackMap[casc.bachelorId()] = 0;
     }
     //__________________________________________________
     // index tracks that belong to TraCascDatas
     for (auto const& casc : TraCascades) {
-      auto bachTrack = casc.template bachelor_as<tracksWithExtra>();
-      auto posTrack = casc.template posTrack_as<tracksWithExtra>();
-      auto negTrack = casc.template negTrack_as<tracksWithExtra>();
-      auto strangeTrack = casc.template strangeTrack_as<tracksWithExtra>();
-      trackMap[posTrack.globalIndex()] = 0;
-      trackMap[negTrack.globalIndex()] = 0;
-      trackMap[bachTrack.globalIndex()] = 0;
-      trackMap[strangeTrack.globalIndex()] = 0;
+      trackMap[casc.posTrackId()] = 0;
+      trackMap[casc.negTrackId()] = 0;
+      trackMap[casc.bachelorId()] = 0;
+      trackMap[casc.strangeTrackId()] = 0;
     }
     //__________________________________________________
     // Figure out the numbering of the new tracks table
@@ -553,26 +455,20 @@ struct strangederivedbuilder {
     //__________________________________________________
     // populate track references
     for (auto const& v0 : V0s) {
-      auto const& posTrack = v0.template posTrack_as<tracksWithExtra>();
-      auto const& negTrack = v0.template negTrack_as<tracksWithExtra>();
-      v0Extras(trackMap[posTrack.globalIndex()],
-               trackMap[negTrack.globalIndex()]); // joinable with V0Datas
+      v0Extras(trackMap[v0.posTrackId()],
+               trackMap[v0.negTrackId()]); // joinable with V0Datas
     }
     //__________________________________________________
     // populate track references
     for (auto const& casc : Cascades) {
-      auto bachTrack = casc.template bachelor_as<tracksWithExtra>();
-      auto posTrack = casc.template posTrack_as<tracksWithExtra>();
-      auto negTrack = casc.template negTrack_as<tracksWithExtra>();
-      cascExtras(trackMap[posTrack.globalIndex()],
-                 trackMap[negTrack.globalIndex()],
-                 trackMap[bachTrack.globalIndex()]); // joinable with CascDatas
+      cascExtras(trackMap[casc.posTrackId()],
+                 trackMap[casc.negTrackId()],
+                 trackMap[casc.bachelorId()]); // joinable with CascDatas
     }
     //__________________________________________________
     // populate track references
     for (auto const& casc : TraCascades) {
-      auto strangeTrack = casc.template strangeTrack_as<tracksWithExtra>();
-      straTrackExtras(trackMap[strangeTrack.globalIndex()]); // joinable with TraCascDatas
+      straTrackExtras(trackMap[casc.strangeTrackId()]); // joinable with TraCascDatas
     }
     //__________________________________________________
     // circle back and populate actual DauTrackExtra table
@@ -603,7 +499,9 @@ struct strangederivedbuilder {
         }
 
         // populate daughter-level TOF information
-        dauTrackTOFPIDs(tr.tofSignal(), tr.tofEvTime(), tr.length());
+        if (fillTOFInformation) {
+          dauTrackTOFPIDs(tr.tofSignal(), tr.tofEvTime(), tr.length());
+        }
       }
     }
     // done!
@@ -34,6 +34,7 @@
 #include "Common/Core/trackUtilities.h"
 #include "Common/CCDB/EventSelectionParams.h"
 #include "PWGLF/DataModel/LFParticleIdentification.h"
+#include "PWGLF/Utils/nucleiTrackPid.h"
 #include "ReconstructionDataFormats/PID.h"
 
 using namespace o2;
@@ -1977,6 +1978,7 @@ struct LFNucleiBATask {
     bool trRapCut = kFALSE;
     bool heRapCut = kFALSE;
     bool alRapCut = kFALSE;
+    o2::pwglf::NucleiTrackPid nucleiPid; // rapidities and TOF mass factor of the current track
 
     // Event histos fill
     histos.fill(HIST("event/h1VtxZ"), event.posZ());
@@ -2227,11 +2229,12 @@ struct LFNucleiBATask {
         continue;
 
       // Rapidity cuts
-      prRapCut = track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Proton)) > kinemOptions.yLowCut && track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Proton)) < kinemOptions.yHighCut;
-      deRapCut = track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Deuteron)) > kinemOptions.yLowCut && track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Deuteron)) < kinemOptions.yHighCut;
-      trRapCut = track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Triton)) > kinemOptions.yLowCut && track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Triton)) < kinemOptions.yHighCut;
-      heRapCut = track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Helium3)) > kinemOptions.yLowCut && track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Helium3)) < kinemOptions.yHighCut;
-      alRapCut = track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Alpha)) > kinemOptions.yLowCut && track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Alpha)) < kinemOptions.yHighCut;
+      nucleiPid.fill(track);
+      prRapCut = nucleiPid.isInRapidity(o2::pwglf::NucleiTrackPid::kProton, kinemOptions.yLowCut, kinemOptions.yHighCut);
+      deRapCut = nucleiPid.isInRapidity(o2::pwglf::NucleiTrackPid::kDeuteron, kinemOptions.yLowCut, kinemOptions.yHighCut);
+      trRapCut = nucleiPid.isInRapidity(o2::pwglf::NucleiTrackPid::kTriton, kinemOptions.yLowCut, kinemOptions.yHighCut);
+      heRapCut = nucleiPid.isInRapidity(o2::pwglf::NucleiTrackPid::kHelium3, kinemOptions.yLowCut, kinemOptions.yHighCut);
+      alRapCut = nucleiPid.isInRapidity(o2::pwglf::NucleiTrackPid::kAlpha, kinemOptions.yLowCut, kinemOptions.yHighCut);
 
       isDeuteron = enableDe && deRapCut;
       isHelium = enableHe && heRapCut;
@@ -3926,7 +3929,7 @@ struct LFNucleiBATask {
                 histos.fill(HIST("tracks/eff/proton/h2pVsTPCmomentumPr"), track.tpcInnerParam(), track.p());
               }
               histos.fill(HIST("tracks/proton/h1ProtonSpectra"), track.pt());
-              histos.fill(HIST("tracks/proton/h2ProtonYvsPt"), track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Proton)), track.pt());
+              histos.fill(HIST("tracks/proton/h2ProtonYvsPt"), nucleiPid.rapidity(o2::pwglf::NucleiTrackPid::kProton), track.pt());
               histos.fill(HIST("tracks/proton/h2ProtonEtavsPt"), track.eta(), track.pt());
 
               if (enablePIDplot)
@@ -3938,7 +3941,7 @@ struct LFNucleiBATask {
                 histos.fill(HIST("tracks/eff/proton/h2pVsTPCmomentumantiPr"), track.tpcInnerParam(), track.p());
               }
               histos.fill(HIST("tracks/proton/h1antiProtonSpectra"), track.pt());
-              histos.fill(HIST("tracks/proton/h2antiProtonYvsPt"), track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Proton)), track.pt());
+              histos.fill(HIST("tracks/proton/h2antiProtonYvsPt"), nucleiPid.rapidity(o2::pwglf::NucleiTrackPid::kProton), track.pt());
               histos.fill(HIST("tracks/proton/h2antiProtonEtavsPt"), track.eta(), track.pt());
 
               if (enablePIDplot)
@@ -4069,7 +4072,7 @@ struct LFNucleiBATask {
           histos.fill(HIST("tracks/eff/deuteron/h2pVsTPCmomentumDe"), track.tpcInnerParam(), track.p());
         }
         histos.fill(HIST("tracks/deuteron/h1DeuteronSpectra"), DPt);
-        histos.fill(HIST("tracks/deuteron/h2DeuteronYvsPt"), track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Deuteron)), DPt);
+        histos.fill(HIST("tracks/deuteron/h2DeuteronYvsPt"), nucleiPid.rapidity(o2::pwglf::NucleiTrackPid::kDeuteron), DPt);
         if (enablePIDplot)
           histos.fill(HIST("tracks/deuteron/h2TPCsignVsTPCmomentumDeuteron"), track.tpcInnerParam(), track.tpcSignal());
       }
@@ -4079,7 +4082,7 @@ struct LFNucleiBATask {
           histos.fill(HIST("tracks/eff/deuteron/h2pVsTPCmomentumantiDe"), track.tpcInnerParam(), track.p());
         }
         histos.fill(HIST("tracks/deuteron/h1antiDeuteronSpectra"), antiDPt);
-        histos.fill(HIST("tracks/deuteron/h2antiDeuteronYvsPt"), track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Deuteron)), antiDPt);
+        histos.fill(HIST("tracks/deuteron/h2antiDeuteronYvsPt"), nucleiPid.rapidity(o2::pwglf::NucleiTrackPid::kDeuteron), antiDPt);
         if (enablePIDplot)
           histos.fill(HIST("tracks/deuteron/h2TPCsignVsTPCmomentumantiDeuteron"), track.tpcInnerParam(), track.tpcSignal());
       }
@@ -4090,8 +4093,8 @@ struct LFNucleiBATask {
         }
         histos.fill(HIST("tracks/helium/h1HeliumSpectra"), hePt);
         histos.fill(HIST("tracks/helium/h1HeliumSpectra_Z2"), 2 * hePt);
-        histos.fill(HIST("tracks/helium/h2HeliumYvsPt"), track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Helium3)), hePt);
-        histos.fill(HIST("tracks/helium/h2HeliumYvsPt_Z2"), track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Helium3)), 2 * hePt);
+        histos.fill(HIST("tracks/helium/h2HeliumYvsPt"), nucleiPid.rapidity(o2::pwglf::NucleiTrackPid::kHelium3), hePt);
+        histos.fill(HIST("tracks/helium/h2HeliumYvsPt_Z2"), nucleiPid.rapidity(o2::pwglf::NucleiTrackPid::kHelium3), 2 * hePt);
         histos.fill(HIST("tracks/helium/h2HeliumEtavsPt"), track.eta(), hePt);
         histos.fill(HIST("tracks/helium/h2HeliumEtavsPt_Z2"), track.eta(), 2 * hePt);
         if (enablePIDplot)
@@ -4104,8 +4107,8 @@ struct LFNucleiBATask {
         }
         histos.fill(HIST("tracks/helium/h1antiHeliumSpectra"), antihePt);
         histos.fill(HIST("tracks/helium/h1antiHeliumSpectra_Z2"), 2 * antihePt);
-        histos.fill(HIST("tracks/helium/h2antiHeliumYvsPt"), track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Helium3)), antihePt);
-        histos.fill(HIST("tracks/helium/h2antiHeliumYvsPt_Z2"), track.rapidity(o2::track::PID::getMass2Z(o2::track::PID::Helium3)), 2 * antihePt);
+        histos.fill(HIST("tracks/helium/h2antiHeliumYvsPt"), nucleiPid.rapidity(o2::pwglf::NucleiTrackPid::kHelium3), antihePt);
+        histos.fill(HIST("tracks/helium/h2antiHeliumYvsPt_Z2"), nucleiPid.rapidity(o2::pwglf::NucleiTrackPid::kHelium3), 2 * antihePt);
         histos.fill(HIST("tracks/helium/h2antiHeliumEtavsPt"), track.eta(), antihePt);
         histos.fill(HIST("tracks/helium/h2antiHeliumEtavsPt_Z2"), track.eta(), 2 * antihePt);
         if (enablePIDplot)
@@ -4144,22 +4147,22 @@ struct LFNucleiBATask {
           }
         }
 
-        if ((track.beta() * track.beta()) < 1.) {
-          gamma = 1.f / TMath::Sqrt(1.f - (track.beta() * track.beta()));
+        if (nucleiPid.hasTOFMass()) {
+          gamma = nucleiPid.gamma();
 
           switch (massTOFConfig) {
             case 0:
-              massTOF = track.tpcInnerParam() * TMath::Sqrt(1.f / (track.beta() * track.beta()) - 1.f);
-              massTOFhe = heTPCmomentum * TMath::Sqrt(1.f / (track.beta() * track.beta()) - 1.f);
-              massTOFantihe = antiheTPCmomentum * TMath::Sqrt(1.f / (track.beta() * track.beta()) - 1.f);
+              massTOF = track.tpcInnerParam() * nucleiPid.tofMassFactor();
+              massTOFhe = heTPCmomentum * nucleiPid.tofMassFactor();
+              massTOFantihe = antiheTPCmomentum * nucleiPid.tofMassFactor();
               break;
             case 1:
-              massTOF = track.tofExpMom() * TMath::Sqrt(1.f / (track.beta() * track.beta()) - 1.f);
+              massTOF = track.tofExpMom() * nucleiPid.tofMassFactor();
               break;
             case 2:
-              massTOF = track.p() * TMath::Sqrt(1.f / (track.beta() * track.beta()) - 1.f);
-              massTOFhe = heP * TMath::Sqrt(1.f / (track.beta() * track.beta()) - 1.f);
-              massTOFantihe = antiheP * TMath::Sqrt(1.f / (track.beta() * track.beta()) - 1.f);
+              massTOF = track.p() * nucleiPid.tofMassFactor();
+              massTOFhe = heP * nucleiPid.tofMassFactor();
+              massTOFantihe = antiheP * nucleiPid.tofMassFactor();
               break;
           }
           if (passDCAxyzCut)
@@ -37,6 +37,7 @@
 #include "Common/DataModel/EventSelection.h"
 #include "Common/DataModel/Centrality.h"
 #include "Common/DataModel/PIDResponse.h"
+#include "PWGLF/Utils/inJetCones.h"
 
 using namespace std;
 using namespace o2;
@@ -120,6 +121,9 @@ struct nuclei_in_jets {
   enum region { jet,
                 underlying_event };
 
+  // Jet finder of the data, keeping its buffers between events
+  o2::pwglf::LeadingParticleJetFinder jetFinder;
+
   void init(InitContext const&)
   {
     // Global Properties and QC
@@ -527,8 +531,8 @@ struct nuclei_in_jets {
     registryQC.fill(HIST("number_of_events_data"), 2.5);
 
     // Reduced Event
-    std::vector<int> particle_ID;
-    int leading_ID = 0;
+    jetFinder.clear();
+    std::size_t leadingPosition = 0;
     bool containsParticleOfInterest(false);
     float pt_max(0);
     int i = -1;
@@ -549,12 +553,12 @@ struct nuclei_in_jets {
 
       // Find pt Leading
       if (track.pt() > pt_max) {
-        leading_ID = i;
+        leadingPosition = jetFinder.getNParticles();
         pt_max = track.pt();
       }
 
       // Store Array Element
-      particle_ID.push_back(i);
+      jetFinder.addParticle(i, track.px(), track.py(), track.pz());
     }
 
     // Event Counter: Skip Events with no trigger Particle (pmax=0)
@@ -571,7 +575,7 @@ struct nuclei_in_jets {
     registryQC.fill(HIST("number_of_events_data"), 4.5);
 
     // Number of Stored Particles
-    int nParticles = static_cast<int>(particle_ID.size());
+    int nParticles = static_cast<int>(jetFinder.getNParticles());
 
     // Event Counter: Skip Events with 0 Particles
     if (nParticles < 1)
@@ -579,8 +583,7 @@ struct nuclei_in_jets {
     registryQC.fill(HIST("number_of_events_data"), 5.5);
 
     // Momentum of the Leading Particle
-    auto const& leading_track = tracks.iteratorAt(leading_ID);
-    TVector3 p_leading(leading_track.px(), leading_track.py(), leading_track.pz());
+    auto const& leading_track = tracks.iteratorAt(jetFinder.getId(leadingPosition));
     TVector3 p_highest_pt_track(leading_track.px(), leading_track.py(), leading_track.pz());
 
     // Event Counter: Skip Events with no Particle of Interest
@@ -588,78 +591,9 @@ struct nuclei_in_jets {
       return;
     registryQC.fill(HIST("number_of_events_data"), 6.5);
 
-    // Array of Particles inside Jet
-    std::vector<int> jet_particle_ID;
-    jet_particle_ID.push_back(leading_ID);
-
-    // Labels
-    Int_t exit(0);
-    Int_t nPartAssociated(0);
-
     // Jet Finder
-    do {
-      // Initialization
-      float distance_jet_min(1e+08);
-      float distance_bkg_min(1e+08);
-      int label_jet_particle(0);
-      int i_jet_particle(0);
-
-      for (int i = 0; i < nParticles; i++) {
-
-        // Skip Leading Particle & Elements already associated to the Jet
-        if (particle_ID[i] == leading_ID || particle_ID[i] == -1)
-          continue;
-
-        // Get Particle Momentum
-        auto stored_track = tracks.iteratorAt(particle_ID[i]);
-        TVector3 p_particle(stored_track.px(), stored_track.py(), stored_track.pz());
-
-        // Variables
-        float one_over_pt2_part = 1.0 / (p_particle.Pt() * p_particle.Pt());
-        float one_over_pt2_lead = 1.0 / (p_leading.Pt() * p_leading.Pt());
-        float deltaEta = p_particle.Eta() - p_leading.Eta();
-        float deltaPhi = GetDeltaPhi(p_particle.Phi(), p_leading.Phi());
-        float min = Minimum(one_over_pt2_part, one_over_pt2_lead);
-        float Delta2 = deltaEta * deltaEta + deltaPhi * deltaPhi;
-
-        // Distances
-        float distance_jet = min * Delta2 / (Rparameter_jet * Rparameter_jet);
-        float distance_bkg = one_over_pt2_part;
-
-        // Find Minimum Distance Jet
-        if (distance_jet < distance_jet_min) {
-          distance_jet_min = distance_jet;
-          label_jet_particle = particle_ID[i];
-          i_jet_particle = i;
-        }
-
-        // Find Minimum Distance Bkg
-        if (distance_bkg < distance_bkg_min) {
-          distance_bkg_min = distance_bkg;
-        }
-      }
-
-      if (distance_jet_min <= distance_bkg_min) {
-
-        // Add Particle to Jet
-        jet_particle_ID.push_back(label_jet_particle);
-
-        // Update Momentum of Leading Particle
-        auto jet_track = tracks.iteratorAt(label_jet_particle);
-        TVector3 p_i(jet_track.px(), jet_track.py(), jet_track.pz());
-        p_leading = p_leading + p_i;
-
-        // Remove Element
-        particle_ID[i_jet_particle] = -1;
-        nPartAssociated++;
-      }
-
-      if (nPartAssociated >= (nParticles - 1))
-        exit = 1;
-      if (distance_jet_min > distance_bkg_min)
-        exit = 2;
-
-    } while (exit == 0);
+    TVector3 p_leading = jetFinder.findJet(leadingPosition, Rparameter_jet);
+    const std::vector<int>& jet_particle_ID = jetFinder.getJetIds();
 
     // Multiplicity inside Jet + UE
     int nParticlesJetUE = static_cast<int>(jet_particle_ID.size());
@@ -711,6 +645,7 @@ struct nuclei_in_jets {
       return;
 
     registryQC.fill(HIST("number_of_events_data"), 8.5);
+    const o2::pwglf::JetCones cones(p_leading, ue_axis1, ue_axis2);
 
     // Store UE
     std::vector<int> ue_particle_ID;
@@ -718,31 +653,31 @@ struct nuclei_in_jets {
     for (int i = 0; i < nParticles; i++) {
 
       // Skip Leading Particle & Elements already associated to the Jet
-      if (particle_ID[i] == leading_ID || particle_ID[i] == -1)
+      if (jetFinder.isInJet(i))
         continue;
 
       // Get UE Track
-      const auto& ue_track = tracks.iteratorAt(particle_ID[i]);
+      const auto& ue_track = tracks.iteratorAt(jetFinder.getId(i));
 
       // Variables
-      float deltaEta1 = ue_track.eta() - ue_axis1.Eta();
-      float deltaPhi1 = GetDeltaPhi(ue_track.phi(), ue_axis1.Phi());
+      float deltaEta1 = ue_track.eta() - cones.eta(o2::pwglf::JetCones::kUE1);
+      float deltaPhi1 = GetDeltaPhi(ue_track.phi(), cones.phi(o2::pwglf::JetCones::kUE1));
       float dr1 = TMath::Sqrt(deltaEta1 * deltaEta1 + deltaPhi1 * deltaPhi1);
-      float deltaEta2 = ue_track.eta() - ue_axis2.Eta();
-      float deltaPhi2 = GetDeltaPhi(ue_track.phi(), ue_axis2.Phi());
+      float deltaEta2 = ue_track.eta() - cones.eta(o2::pwglf::JetCones::kUE2);
+      float deltaPhi2 = GetDeltaPhi(ue_track.phi(), cones.phi(o2::pwglf::JetCones::kUE2));
       float dr2 = TMath::Sqrt(deltaEta2 * deltaEta2 + deltaPhi2 * deltaPhi2);
 
       // Store Particles in the UE
       if (dr1 < Rmax_jet_ue) {
         registryQC.fill(HIST("eta_phi_ue"), deltaEta1, deltaPhi1);
         registryQC.fill(HIST("r_ue"), dr1);
-        ue_particle_ID.push_back(particle_ID[i]);
+        ue_particle_ID.push_back(jetFinder.getId(i));
       }
 
       if (dr2 < Rmax_jet_ue) {
         registryQC.fill(HIST("eta_phi_ue"), deltaEta2, deltaPhi2);
         registryQC.fill(HIST("r_ue"), dr2);
-        ue_particle_ID.push_back(particle_ID[i]);
+        ue_particle_ID.push_back(jetFinder.getId(i));
       }
     }
 
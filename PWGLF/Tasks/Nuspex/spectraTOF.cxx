@@ -1451,14 +1451,7 @@ struct tofSpectra {
       return;
     }
 
-    const auto& mcCollision = collision.mcCollision_as<GenMCCollisions>();
-    float multiplicity = getMultiplicityMC(mcCollision);
-    //************************************RD**************************************************
-    if (includeCentralityMC) {
-      multiplicity = mcCollision.impactParameter();
-    }
-    //************************************RD**************************************************
-
+    // at most one of the species matches, check it before getting the MC collision
     if (mcParticle.pdgCode() != PDGs[i]) {
       return;
     }
@@ -1469,6 +1462,14 @@ struct tofSpectra {
     if (std::abs(mcParticle.y()) > trkselOptions.cfgCutY) {
       return;
     }
+
+    const auto& mcCollision = collision.mcCollision_as<GenMCCollisions>();
+    float multiplicity = getMultiplicityMC(mcCollision);
+    //************************************RD**************************************************
+    if (includeCentralityMC) {
+      multiplicity = mcCollision.impactParameter();
+    }
+    //************************************RD**************************************************
     if (!mcParticle.isPhysicalPrimary()) {
       if (mcParticle.getProcess() == 4) {
         if (enableDCAxyzHistograms) {
@@ -1697,7 +1698,8 @@ struct tofSpectra {
         }
         continue;
       }
-      if (!isEventSelected<false, false>(track.collision_as<RecoMCCollisions>())) {
+      const auto& collision = track.collision_as<RecoMCCollisions>();
+      if (!isEventSelected<false, false>(collision)) {
         continue;
       }
       if (!passesCutWoDCA(track)) {
@@ -1714,7 +1716,7 @@ struct tofSpectra {
       const auto& mcParticle = track.mcParticle();
 
       static_for<0, 17>([&](auto i) {
-        fillTrackHistograms_MC<i>(track, mcParticle, track.collision_as<RecoMCCollisions>());
+        fillTrackHistograms_MC<i>(track, mcParticle, collision);
       });
     }
     if (includeCentralityMC) {
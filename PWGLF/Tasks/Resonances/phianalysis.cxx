@@ -15,6 +15,8 @@
 ///
 /// \author Bong-Hwi Lim <bong-hwi.lim@cern.ch>
 
+#include <vector>
+
 #include <TLorentzVector.h>
 
 #include "Common/DataModel/PIDResponse.h"
@@ -24,6 +26,7 @@
 #include "Framework/ASoAHelpers.h"
 #include "Framework/runDataProcessing.h"
 #include "PWGLF/DataModel/LFResonanceTables.h"
+#include "PWGLF/Utils/resonanceDaughters.h"
 #include "DataFormatsParameters/GRPObject.h"
 #include "CommonConstants/PhysicsConstants.h"
 
@@ -52,6 +55,7 @@ struct phianalysis {
   Configurable<int> cDCABins{"cDCABins", 150, "DCA binning"};
   /// Event Mixing
   Configurable<int> nEvtMixing{"nEvtMixing", 5, "Number of events to mix"};
+  Configurable<bool> cMixInMassWindow{"cMixInMassWindow", false, "Mix only the pairs which can have a mass below the invariant mass end (drops the overflow of the mixed-event histograms)"};
   ConfigurableAxis CfgVtxBins{"CfgVtxBins", {VARIABLE_WIDTH, -10.0f, -8.f, -6.f, -4.f, -2.f, 0.f, 2.f, 4.f, 6.f, 8.f, 10.f}, "Mixing bins - z-vertex"};
   ConfigurableAxis CfgMultBins{"CfgMultBins", {VARIABLE_WIDTH, 0., 1., 5., 10., 30., 50., 70., 100., 110.}, "Mixing bins - multiplicity"};
   /// Pre-selection cuts
@@ -130,6 +134,13 @@ struct phianalysis {
 
   double massKa = MassKaonCharged;
 
+  // selection bits of the daughter candidates, evaluated once per track
+  enum DaughterSelection : uint32_t {
+    kTrackCut = 1,
+    kPIDKaon = 2
+  };
+  o2::pwglf::ResonanceDaughters daughters1, daughters2;
+
   template <typename TrackType>
   bool trackCut(const TrackType track)
   {
@@ -180,29 +191,56 @@ struct phianalysis {
     return false;
   }
 
+  template <typename T>
+  uint32_t daughterSelection(const T& track)
+  {
+    uint32_t selection = 0;
+    if (trackCut(track)) {
+      selection |= kTrackCut;
+    }
+    if (selectionPIDKaon(track)) {
+      selection |= kPIDKaon;
+    }
+    return selection;
+  }
+
   template <bool IsMC, bool IsMix, typename CollisionType, typename TracksType>
   void fillHistograms(const CollisionType& collision, const TracksType& dTracks1, const TracksType& dTracks2)
   {
     auto multiplicity = collision.cent();
-    TLorentzVector lDecayDaughter1, lDecayDaughter2, lResonance;
-    for (auto& [trk1, trk2] : combinations(CombinationsUpperIndexPolicy(dTracks1, dTracks2))) {
-      // Full index policy is needed to consider all possible combinations
-      if (trk1.index() == trk2.index())
-        continue; // We need to run (0,1), (1,0) pairs as well. but same id pairs are not needed.
+    // the four-momenta and the selections are evaluated once per track, the pairs are then formed from the arrays
+    auto selection = [this](const auto& track) { return daughterSelection(track); };
+    daughters1.fill(dTracks1, massKa, selection);
+    std::vector<typename TracksType::iterator> tracks1, tracks2;
+    tracks1.reserve(dTracks1.size());
+    for (const auto& track : dTracks1) {
+      tracks1.push_back(track);
+    }
+    if constexpr (IsMix) {
+      daughters2.fill(dTracks2, massKa, selection);
+      tracks2.reserve(dTracks2.size());
+      for (const auto& track : dTracks2) {
+        tracks2.push_back(track);
+      }
+    }
+    const auto& secondDaughters = IsMix ? daughters2 : daughters1;
+    const auto& secondTracks = IsMix ? tracks2 : tracks1;
+
+    TLorentzVector lResonance;
+    auto fillPair = [&](std::size_t i1, std::size_t i2) {
       //// Initialize variables
       // Trk1: Kaon, Trk2: Kaon
       // apply the track cut
-      if (!trackCut(trk1) || !trackCut(trk2))
-        continue;
+      if (!daughters1.isSelected(i1, kTrackCut) || !secondDaughters.isSelected(i2, kTrackCut))
+        return;
+      const auto& trk1 = tracks1[i1];
+      const auto& trk2 = secondTracks[i2];
 
       auto isTrk1hasTOF = trk1.hasTOF();
       auto isTrk2hasTOF = trk2.hasTOF();
       auto trk1ptKa = trk1.pt();
       auto trk1NSigmaKaTPC = trk1.tpcNSigmaKa();
       auto trk1NSigmaKaTOF = (isTrk1hasTOF) ? trk1.tofNSigmaKa() : -999.;
-      // auto trk2ptKa = trk2.pt();
-      // auto trk2NSigmaKaTPC = trk2.tpcNSigmaKa();
-      // auto trk2NSigmaKaTOF = (isTrk2hasTOF) ? trk2.tofNSigmaKa() : -999.;
 
       if constexpr (!IsMix) {
         //// QA plots before the selection
@@ -219,9 +257,9 @@ struct phianalysis {
 
       //// Apply the selection
       if (cUseOnlyTOFTrackKa && (!isTrk1hasTOF || !isTrk2hasTOF))
-        continue;
-      if (!selectionPIDKaon(trk1) || !selectionPIDKaon(trk2))
-        continue;
+        return;
+      if (!daughters1.isSelected(i1, kPIDKaon) || !secondDaughters.isSelected(i2, kPIDKaon))
+        return;
 
       if constexpr (!IsMix) {
         //// QA plots after the selection
@@ -237,12 +275,13 @@ struct phianalysis {
       }
 
       //// Resonance reconstruction
-      lDecayDaughter1.SetXYZM(trk1.px(), trk1.py(), trk1.pz(), massKa);
-      lDecayDaughter2.SetXYZM(trk2.px(), trk2.py(), trk2.pz(), massKa);
-      lResonance = lDecayDaughter1 + lDecayDaughter2;
+      lResonance.SetPxPyPzE(daughters1.px(i1) + secondDaughters.px(i2),
+                            daughters1.py(i1) + secondDaughters.py(i2),
+                            daughters1.pz(i1) + secondDaughters.pz(i2),
+                            daughters1.e(i1) + secondDaughters.e(i2));
       // Rapidity cut
       if (abs(lResonance.Rapidity()) > 0.5)
-        continue;
+        return;
       //// Un-like sign pair only
       if (trk1.sign() * trk2.sign() < 0) {
         if constexpr (!IsMix) {
@@ -259,11 +298,11 @@ struct phianalysis {
         // MC
         if constexpr (IsMC) {
           if (abs(trk1.pdgCode()) != 321 || abs(trk2.pdgCode()) != 321)
-            continue;
+            return;
           if (trk1.motherId() != trk2.motherId()) // Same mother
-            continue;
+            return;
           if (abs(trk1.motherPDG()) != 333)
-            continue;
+            return;
 
           // Track selection check.
           histos.fill(HIST("QAMCTrue/trkDCAxy"), trk2.dcaXY());
@@ -276,13 +315,30 @@ struct phianalysis {
         }
       } else {
         if constexpr (!IsMix)
-          continue;
+          return;
         if (trk1.sign() > 0) {
           histos.fill(HIST("phiinvmassLS"), lResonance.M());
           histos.fill(HIST("h3phiinvmassLS"), multiplicity, lResonance.Pt(), lResonance.M());
         } else {
         }
       }
+    };
+
+    // same pairs as combinations(CombinationsUpperIndexPolicy(dTracks1, dTracks2)), without the same-track pairs
+    if (IsMix && cMixInMassWindow) {
+      daughters1.forEachPairBelowMass(daughters2, cInvMassEnd, [&](std::size_t i1, std::size_t i2) {
+        if (i2 >= i1) {
+          fillPair(i1, i2);
+        }
+      });
+      return;
+    }
+    for (std::size_t i1 = 0; i1 < daughters1.size(); i1++) {
+      for (std::size_t i2 = i1; i2 < secondDaughters.size(); i2++) {
+        if (!IsMix && i1 == i2)
+          continue; // We need to run (0,1), (1,0) pairs as well. but same id pairs are not needed.
+        fillPair(i1, i2);
+      }
     }
   }
 
@@ -33,6 +33,7 @@
 #include "Framework/AnalysisTask.h"
 #include "Framework/runDataProcessing.h"
 #include "PWGLF/DataModel/LFStrangenessTables.h"
+#include "PWGLF/Utils/inJetCones.h"
 #include "ReconstructionDataFormats/Track.h"
 
 using namespace std;
@@ -114,6 +115,9 @@ struct strangeness_in_jets {
   Configurable<float> dcaV0topvMin{"dcaV0topvMin", 0.1f, "Minimum DCA V0 to PV"};
   Configurable<float> dcaCascDaughtersMax{"dcaCascDaughtersMax", 0.5f, "Maximum DCA Daughters"};
 
+  // Jet finder of the data, keeping its buffers between events
+  o2::pwglf::LeadingParticleJetFinder jetFinder;
+
   void init(InitContext const&)
   {
     // Event Counters
@@ -781,8 +785,8 @@ struct strangeness_in_jets {
     registryData.fill(HIST("number_of_events_data"), 2.5);
 
     // Find Leading Particle
-    std::vector<int> particle_ID;
-    int leading_ID(0);
+    jetFinder.clear();
+    std::size_t leadingPosition(0);
     float ptMax(0);
 
     // Track Index
@@ -794,86 +798,18 @@ struct strangeness_in_jets {
         continue;
 
       if (track.pt() > ptMax) {
-        leading_ID = i;
+        leadingPosition = jetFinder.getNParticles();
         ptMax = track.pt();
       }
-      particle_ID.push_back(i);
+      jetFinder.addParticle(i, track.px(), track.py(), track.pz());
     }
 
     if (ptMax < ptLeadingMin)
       return;
     registryData.fill(HIST("number_of_events_data"), 3.5);
 
-    auto const& leading_track = tracks.iteratorAt(leading_ID);
-    TVector3 p_leading(leading_track.px(), leading_track.py(), leading_track.pz());
-    int nParticles = static_cast<int>(particle_ID.size());
-
     // Jet Finder
-    int exit(0);
-    int nPartAssociated(0);
-    do {
-      // Initialization
-      float distance_jet_min(1e+08);
-      float distance_bkg_min(1e+08);
-      int label_jet_particle(0);
-      int i_jet_particle(0);
-
-      for (int i = 0; i < nParticles; i++) {
-
-        // Skip Leading Particle & Elements already associated to the Jet
-        if (particle_ID[i] == leading_ID || particle_ID[i] == -1)
-          continue;
-
-        // Get Particle Momentum
-        auto stored_track = tracks.iteratorAt(particle_ID[i]);
-        TVector3 p_particle(stored_track.px(), stored_track.py(), stored_track.pz());
-
-        // Variables
-        float one_over_pt2_part = 1.0 / (p_particle.Pt() * p_particle.Pt());
-        float one_over_pt2_lead = 1.0 / (p_leading.Pt() * p_leading.Pt());
-        float deltaEta = p_particle.Eta() - p_leading.Eta();
-        float deltaPhi = GetDeltaPhi(p_particle.Phi(), p_leading.Phi());
-        float min = Minimum(one_over_pt2_part, one_over_pt2_lead);
-        float Delta2 = deltaEta * deltaEta + deltaPhi * deltaPhi;
-
-        // Distances
-        float distance_jet = min * Delta2 / (Rjet * Rjet);
-        float distance_bkg = one_over_pt2_part;
-
-        // Find Minimum Distance Jet
-        if (distance_jet < distance_jet_min) {
-          distance_jet_min = distance_jet;
-          label_jet_particle = particle_ID[i];
-          i_jet_particle = i;
-        }
-
-        // Find Minimum Distance Bkg
-        if (distance_bkg < distance_bkg_min) {
-          distance_bkg_min = distance_bkg;
-        }
-      }
-
-      if (distance_jet_min <= distance_bkg_min) {
-
-        // Add Particle to Jet
-        // jet_particle_ID.push_back(label_jet_particle);
-
-        // Update Momentum of Leading Particle
-        auto jet_track = tracks.iteratorAt(label_jet_particle);
-        TVector3 p_i(jet_track.px(), jet_track.py(), jet_track.pz());
-        p_leading = p_leading + p_i;
-
-        // Remove Element
-        particle_ID[i_jet_particle] = -1;
-        nPartAssociated++;
-      }
-
-      if (nPartAssociated >= (nParticles - 1))
-        exit = 1;
-      if (distance_jet_min > distance_bkg_min)
-        exit = 2;
-
-    } while (exit == 0);
+    TVector3 p_leading = jetFinder.findJet(leadingPosition, Rjet);
 
     // Jet Axis
     TVector3 jet_axis(p_leading.X(), p_leading.Y(), p_leading.Z());
@@ -895,6 +831,7 @@ struct strangeness_in_jets {
     if (ue_axis2.X() == 0 && ue_axis2.Y() == 0 && ue_axis2.Z() == 0)
       return;
     registryData.fill(HIST("number_of_events_data"), 5.5);
+    const o2::pwglf::JetCones cones(jet_axis, ue_axis1, ue_axis2);
 
     // Event multiplicity
     float multiplicity = collision.centFT0M();
@@ -906,44 +843,37 @@ struct strangeness_in_jets {
 
       TVector3 v0dir(v0.px(), v0.py(), v0.pz());
 
-      float deltaEta_jet = v0dir.Eta() - jet_axis.Eta();
-      float deltaPhi_jet = GetDeltaPhi(v0dir.Phi(), jet_axis.Phi());
-      float deltaR_jet = sqrt(deltaEta_jet * deltaEta_jet + deltaPhi_jet * deltaPhi_jet);
-
-      float deltaEta_ue1 = v0dir.Eta() - ue_axis1.Eta();
-      float deltaPhi_ue1 = GetDeltaPhi(v0dir.Phi(), ue_axis1.Phi());
-      float deltaR_ue1 = sqrt(deltaEta_ue1 * deltaEta_ue1 + deltaPhi_ue1 * deltaPhi_ue1);
-
-      float deltaEta_ue2 = v0dir.Eta() - ue_axis2.Eta();
-      float deltaPhi_ue2 = GetDeltaPhi(v0dir.Phi(), ue_axis2.Phi());
-      float deltaR_ue2 = sqrt(deltaEta_ue2 * deltaEta_ue2 + deltaPhi_ue2 * deltaPhi_ue2);
+      const double eta = v0dir.Eta();
+      const double phi = v0dir.Phi();
+      const bool isInJet = cones.isInJet(eta, phi, Rmax);
+      const bool isInUe = cones.isInUE(eta, phi, Rmax);
 
       // K0s
       if (passedK0ShortSelection(v0, pos, neg)) {
-        if (deltaR_jet < Rmax) {
+        if (isInJet) {
           registryData.fill(HIST("K0s_in_jet"), multiplicity, v0.pt(), v0.mK0Short());
         }
-        if (deltaR_ue1 < Rmax || deltaR_ue2 < Rmax) {
+        if (isInUe) {
           registryData.fill(HIST("K0s_in_ue"), multiplicity, v0.pt(), v0.mK0Short());
         }
       }
 
       // Lambda
       if (passedLambdaSelection(v0, pos, neg)) {
-        if (deltaR_jet < Rmax) {
+        if (isInJet) {
           registryData.fill(HIST("Lambda_in_jet"), multiplicity, v0.pt(), v0.mLambda());
         }
-        if (deltaR_ue1 < Rmax || deltaR_ue2 < Rmax) {
+        if (isInUe) {
           registryData.fill(HIST("Lambda_in_ue"), multiplicity, v0.pt(), v0.mLambda());
         }
       }
 
       // AntiLambda
       if (passedAntiLambdaSelection(v0, pos, neg)) {
-        if (deltaR_jet < Rmax) {
+        if (isInJet) {
           registryData.fill(HIST("AntiLambda_in_jet"), multiplicity, v0.pt(), v0.mAntiLambda());
         }
-        if (deltaR_ue1 < Rmax || deltaR_ue2 < Rmax) {
+        if (isInUe) {
           registryData.fill(HIST("AntiLambda_in_ue"), multiplicity, v0.pt(), v0.mAntiLambda());
         }
       }
@@ -958,50 +888,45 @@ struct strangeness_in_jets {
 
       TVector3 cascade_dir(casc.px(), casc.py(), casc.pz());
 
-      float deltaEta_jet = cascade_dir.Eta() - jet_axis.Eta();
-      float deltaPhi_jet = GetDeltaPhi(cascade_dir.Phi(), jet_axis.Phi());
-      float deltaR_jet = sqrt(deltaEta_jet * deltaEta_jet + deltaPhi_jet * deltaPhi_jet);
-      float deltaEta_ue1 = cascade_dir.Eta() - ue_axis1.Eta();
-      float deltaPhi_ue1 = GetDeltaPhi(cascade_dir.Phi(), ue_axis1.Phi());
-      float deltaR_ue1 = sqrt(deltaEta_ue1 * deltaEta_ue1 + deltaPhi_ue1 * deltaPhi_ue1);
-      float deltaEta_ue2 = cascade_dir.Eta() - ue_axis2.Eta();
-      float deltaPhi_ue2 = GetDeltaPhi(cascade_dir.Phi(), ue_axis2.Phi());
-      float deltaR_ue2 = sqrt(deltaEta_ue2 * deltaEta_ue2 + deltaPhi_ue2 * deltaPhi_ue2);
+      const double eta = cascade_dir.Eta();
+      const double phi = cascade_dir.Phi();
+      const bool isInJet = cones.isInJet(eta, phi, Rmax);
+      const bool isInUe = cones.isInUE(eta, phi, Rmax);
 
       // Xi+
       if (passedXiSelection(casc, pos, neg, bach, collision) && bach.sign() > 0) {
-        if (deltaR_jet < Rmax) {
+        if (isInJet) {
           registryData.fill(HIST("XiPos_in_jet"), multiplicity, casc.pt(), casc.mXi());
         }
-        if (deltaR_ue1 < Rmax || deltaR_ue2 < Rmax) {
+        if (isInUe) {
           registryData.fill(HIST("XiPos_in_ue"), multiplicity, casc.pt(), casc.mXi());
         }
       }
       // Xi-
       if (passedXiSelection(casc, pos, neg, bach, collision) && bach.sign() < 0) {
-        if (deltaR_jet < Rmax) {
+        if (isInJet) {
           registryData.fill(HIST("XiNeg_in_jet"), multiplicity, casc.pt(), casc.mXi());
         }
-        if (deltaR_ue1 < Rmax || deltaR_ue2 < Rmax) {
+        if (isInUe) {
           registryData.fill(HIST("XiNeg_in_ue"), multiplicity, casc.pt(), casc.mXi());
         }
       }
 
       // Omega+
       if (passedOmegaSelection(casc, pos, neg, bach, collision) && bach.sign() > 0) {
-        if (deltaR_jet < Rmax) {
+        if (isInJet) {
           registryData.fill(HIST("OmegaPos_in_jet"), multiplicity, casc.pt(), casc.mOmega());
         }
-        if (deltaR_ue1 < Rmax || deltaR_ue2 < Rmax) {
+        if (isInUe) {
           registryData.fill(HIST("OmegaPos_in_ue"), multiplicity, casc.pt(), casc.mOmega());
         }
       }
       // Omega-
       if (passedOmegaSelection(casc, pos, neg, bach, collision) && bach.sign() < 0) {
-        if (deltaR_jet < Rmax) {
+        if (isInJet) {
           registryData.fill(HIST("OmegaNeg_in_jet"), multiplicity, casc.pt(), casc.mOmega());
         }
-        if (deltaR_ue1 < Rmax || deltaR_ue2 < Rmax) {
+        if (isInUe) {
           registryData.fill(HIST("OmegaNeg_in_ue"), multiplicity, casc.pt(), casc.mOmega());
         }
       }
@@ -1014,22 +939,10 @@ struct strangeness_in_jets {
         continue;
 
       TVector3 track_dir(track.px(), track.py(), track.pz());
-      float deltaEta_jet = track_dir.Eta() - jet_axis.Eta();
-      float deltaPhi_jet = GetDeltaPhi(track_dir.Phi(), jet_axis.Phi());
-      float deltaR_jet = sqrt(deltaEta_jet * deltaEta_jet + deltaPhi_jet * deltaPhi_jet);
-      float deltaEta_ue1 = track_dir.Eta() - ue_axis1.Eta();
-      float deltaPhi_ue1 = GetDeltaPhi(track_dir.Phi(), ue_axis1.Phi());
-      float deltaR_ue1 = sqrt(deltaEta_ue1 * deltaEta_ue1 + deltaPhi_ue1 * deltaPhi_ue1);
-      float deltaEta_ue2 = track_dir.Eta() - ue_axis2.Eta();
-      float deltaPhi_ue2 = GetDeltaPhi(track_dir.Phi(), ue_axis2.Phi());
-      float deltaR_ue2 = sqrt(deltaEta_ue2 * deltaEta_ue2 + deltaPhi_ue2 * deltaPhi_ue2);
-
-      bool isInJet = false;
-      bool isInUe = false;
-      if (deltaR_jet < Rmax)
-        isInJet = true;
-      if (deltaR_ue1 < Rmax || deltaR_ue2 < Rmax)
-        isInUe = true;
+      const double eta = track_dir.Eta();
+      const double phi = track_dir.Phi();
+      const bool isInJet = cones.isInJet(eta, phi, Rmax);
+      const bool isInUe = cones.isInUE(eta, phi, Rmax);
 
       if (isHighPurityPion(track) && track.sign() > 0) {
         if (isInJet)
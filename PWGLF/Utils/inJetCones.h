@@ -0,0 +1,169 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file  inJetCones.h
+/// \brief Leading-particle jet finder and jet/UE cone tagging of the LF in-jet analyses (strangeness_in_jets, nuclei_in_jets).
+///        The pt, eta and phi of the particles are evaluated once when they are added, and those of the jet axis once per
+///        iteration, instead of once per particle pair. The cone axes are evaluated once per event.
+///
+
+#ifndef PWGLF_UTILS_INJETCONES_H_
+#define PWGLF_UTILS_INJETCONES_H_
+
+#include <TMath.h>
+#include <TVector2.h>
+#include <TVector3.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace o2
+{
+namespace pwglf
+{
+
+/// Azimuthal distance in [0, pi]
+inline double jetDeltaPhi(double phi1, double phi2)
+{
+  const double diff = TMath::Abs(TVector2::Phi_0_2pi(phi1) - TVector2::Phi_0_2pi(phi2));
+  return diff <= TMath::Pi() ? diff : TMath::TwoPi() - diff;
+}
+
+class LeadingParticleJetFinder
+{
+ public:
+  void clear()
+  {
+    mIds.clear();
+    mPx.clear();
+    mPy.clear();
+    mPz.clear();
+    mPt.clear();
+    mEta.clear();
+    mPhi.clear();
+    mInJet.clear();
+    mJetIds.clear();
+  }
+
+  /// Adds a particle to the finder
+  /// \param id is the row of the particle in its table
+  void addParticle(int id, float px, float py, float pz)
+  {
+    const TVector3 p(px, py, pz);
+    mIds.push_back(id);
+    mPx.push_back(p.X());
+    mPy.push_back(p.Y());
+    mPz.push_back(p.Z());
+    mPt.push_back(p.Pt());
+    mEta.push_back(p.Eta());
+    mPhi.push_back(p.Phi());
+    mInJet.push_back(false);
+  }
+
+  std::size_t getNParticles() const { return mIds.size(); }
+  int getId(std::size_t position) const { return mIds[position]; }
+  double getEta(std::size_t position) const { return mEta[position]; }
+  double getPhi(std::size_t position) const { return mPhi[position]; }
+  /// Whether a particle is the leading particle or was associated to the jet
+  bool isInJet(std::size_t position) const { return mInJet[position]; }
+  /// Rows of the particles of the jet, the leading particle first and then in the order of association
+  const std::vector<int>& getJetIds() const { return mJetIds; }
+
+  /// Associates the particles to the jet of the leading particle: at each step, the particle with the smallest
+  /// distance min(1/pt^2, 1/ptJet^2) dR^2 / rJet^2 is added to the jet, until that distance exceeds the smallest 1/pt^2
+  /// \param leadingPosition is the position of the leading particle in the finder
+  /// \return momentum of the jet
+  TVector3 findJet(std::size_t leadingPosition, float rJet)
+  {
+    const std::size_t nParticles = getNParticles();
+    TVector3 pJet(mPx[leadingPosition], mPy[leadingPosition], mPz[leadingPosition]);
+    mInJet[leadingPosition] = true;
+    mJetIds.push_back(mIds[leadingPosition]);
+    std::size_t nAssociated = 0;
+    while (nAssociated + 1 < nParticles) {
+      const float oneOverPt2Jet = 1.0 / (pJet.Pt() * pJet.Pt());
+      const double etaJet = pJet.Eta();
+      const double phiJet = pJet.Phi();
+      float distanceJetMin = 1e+08;
+      float distanceBkgMin = 1e+08;
+      std::size_t jetPosition = nParticles;
+      for (std::size_t i = 0; i < nParticles; i++) {
+        if (mInJet[i]) {
+          continue;
+        }
+        const float oneOverPt2 = 1.0 / (mPt[i] * mPt[i]);
+        const float deltaEta = mEta[i] - etaJet;
+        const float deltaPhi = jetDeltaPhi(mPhi[i], phiJet);
+        const float distanceJet = std::min(oneOverPt2, oneOverPt2Jet) * (deltaEta * deltaEta + deltaPhi * deltaPhi) / (rJet * rJet);
+        if (distanceJet < distanceJetMin) {
+          distanceJetMin = distanceJet;
+          jetPosition = i;
+        }
+        distanceBkgMin = std::min(distanceBkgMin, oneOverPt2);
+      }
+      if (jetPosition == nParticles || distanceJetMin > distanceBkgMin) {
+        break;
+      }
+      pJet = pJet + TVector3(mPx[jetPosition], mPy[jetPosition], mPz[jetPosition]);
+      mInJet[jetPosition] = true;
+      mJetIds.push_back(mIds[jetPosition]);
+      nAssociated++;
+    }
+    return pJet;
+  }
+
+ private:
+  std::vector<int> mIds;               // rows of the particles in their table
+  std::vector<double> mPx, mPy, mPz;   // momenta
+  std::vector<double> mPt, mEta, mPhi; // kinematics evaluated once per particle
+  std::vector<bool> mInJet;            // leading or associated particles
+  std::vector<int> mJetIds;            // rows of the particles of the jet
+};
+
+/// Jet cone and the two perpendicular cones of the underlying event, with the axis directions evaluated once
+class JetCones
+{
+ public:
+  enum Cone { kJet = 0,
+              kUE1,
+              kUE2,
+              kNCones };
+
+  JetCones(const TVector3& jetAxis, const TVector3& ueAxis1, const TVector3& ueAxis2)
+    : mEta{jetAxis.Eta(), ueAxis1.Eta(), ueAxis2.Eta()}, mPhi{jetAxis.Phi(), ueAxis1.Phi(), ueAxis2.Phi()}
+  {
+  }
+
+  double eta(Cone cone) const { return mEta[cone]; }
+  double phi(Cone cone) const { return mPhi[cone]; }
+
+  /// Distance in the eta-phi plane between a direction and a cone axis
+  float deltaR(Cone cone, double eta, double phi) const
+  {
+    const float deltaEta = eta - mEta[cone];
+    const float deltaPhi = jetDeltaPhi(phi, mPhi[cone]);
+    return std::sqrt(deltaEta * deltaEta + deltaPhi * deltaPhi);
+  }
+
+  bool isInJet(double eta, double phi, float rMax) const { return deltaR(kJet, eta, phi) < rMax; }
+  bool isInUE(double eta, double phi, float rMax) const { return deltaR(kUE1, eta, phi) < rMax || deltaR(kUE2, eta, phi) < rMax; }
+
+ private:
+  double mEta[kNCones]; // pseudorapidities of the axes
+  double mPhi[kNCones]; // azimuths of the axes
+};
+
+} // namespace pwglf
+} // namespace o2
+
+#endif // PWGLF_UTILS_INJETCONES_H_
@@ -0,0 +1,79 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file  nucleiTrackPid.h
+/// \brief Species-dependent kinematic quantities of a track for the light-nuclei analyses, computed once per track.
+///        The rapidity(mass) dynamic columns evaluate the energy and a logarithm at every call, and the TOF mass
+///        a square root, so the analyses share the cached values between the selections and the histograms.
+///
+
+#ifndef PWGLF_UTILS_NUCLEITRACKPID_H_
+#define PWGLF_UTILS_NUCLEITRACKPID_H_
+
+#include <array>
+#include <cmath>
+
+#include "ReconstructionDataFormats/PID.h"
+
+namespace o2
+{
+namespace pwglf
+{
+
+class NucleiTrackPid
+{
+ public:
+  /// Species of the cache
+  enum Species { kProton = 0,
+                 kDeuteron,
+                 kTriton,
+                 kHelium3,
+                 kAlpha,
+                 kNSpecies };
+
+  /// Computes the quantities of a track with rapidity(mass) and beta() columns
+  template <typename TTrack>
+  void fill(const TTrack& track)
+  {
+    for (int iSpecies = 0; iSpecies < kNSpecies; iSpecies++) {
+      mRapidity[iSpecies] = track.rapidity(o2::track::PID::getMass2Z(PIDs[iSpecies]));
+    }
+    mBeta = track.beta();
+    mHasTOFMass = (mBeta * mBeta) < 1.;
+    mTOFMassFactor = mHasTOFMass ? std::sqrt(static_cast<double>(1.f / (mBeta * mBeta) - 1.f)) : 0.;
+  }
+
+  /// Rapidity under the mass hypothesis of a species, divided by its charge as for the PID masses
+  float rapidity(Species species) const { return mRapidity[species]; }
+  /// Whether the rapidity of a species is within (yLow, yHigh)
+  bool isInRapidity(Species species, float yLow, float yHigh) const { return mRapidity[species] > yLow && mRapidity[species] < yHigh; }
+
+  /// Whether beta is physical, such that the TOF mass is defined
+  bool hasTOFMass() const { return mHasTOFMass; }
+  /// sqrt(1/beta^2 - 1), the TOF mass is the momentum times this factor
+  double tofMassFactor() const { return mTOFMassFactor; }
+  /// Lorentz factor of the TOF beta
+  double gamma() const { return 1.f / std::sqrt(static_cast<double>(1.f - (mBeta * mBeta))); }
+
+ private:
+  static constexpr std::array<o2::track::PID::ID, kNSpecies> PIDs{o2::track::PID::Proton, o2::track::PID::Deuteron, o2::track::PID::Triton, o2::track::PID::Helium3, o2::track::PID::Alpha};
+
+  std::array<float, kNSpecies> mRapidity{}; // rapidities of the species
+  float mBeta = 0.f;                        // TOF beta
+  bool mHasTOFMass = false;                 // beta < 1
+  double mTOFMassFactor = 0.;               // sqrt(1/beta^2 - 1)
+};
+
+} // namespace pwglf
+} // namespace o2
+
+#endif // PWGLF_UTILS_NUCLEITRACKPID_H_
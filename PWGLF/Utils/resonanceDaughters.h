@@ -0,0 +1,152 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file  resonanceDaughters.h
+/// \brief Resonance daughter candidates of a collision as structure of arrays, for the pairing loops of the resonance tasks.
+///        The four-momenta and the selections are evaluated once per track instead of once per pair, and the
+///        pairs can be restricted to the momentum range compatible with a maximum invariant mass.
+///
+
+#ifndef PWGLF_UTILS_RESONANCEDAUGHTERS_H_
+#define PWGLF_UTILS_RESONANCEDAUGHTERS_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace o2
+{
+namespace pwglf
+{
+
+class ResonanceDaughters
+{
+ public:
+  /// Fills the daughter candidates of a table, in table order
+  /// \param tracks table of the candidates, e.g. a collision slice of ResoTracks
+  /// \param mass mass hypothesis of the energy
+  /// \param selection callable returning the selection bits of a track
+  template <typename TTracks, typename TSelection>
+  void fill(TTracks const& tracks, double mass, TSelection&& selection)
+  {
+    clear();
+    mMass = mass;
+    for (const auto& track : tracks) {
+      const double px = track.px();
+      const double py = track.py();
+      const double pz = track.pz();
+      const double p2 = px * px + py * py + pz * pz;
+      mPx.push_back(px);
+      mPy.push_back(py);
+      mPz.push_back(pz);
+      mP.push_back(std::sqrt(p2));
+      mE.push_back(std::sqrt(p2 + mass * mass)); // same as TLorentzVector::SetXYZM
+      mSign.push_back(track.sign());
+      mSelection.push_back(selection(track));
+    }
+  }
+
+  void clear()
+  {
+    mPx.clear();
+    mPy.clear();
+    mPz.clear();
+    mP.clear();
+    mE.clear();
+    mSign.clear();
+    mSelection.clear();
+    mSortedByP.clear();
+  }
+
+  std::size_t size() const { return mPx.size(); }
+  double px(std::size_t i) const { return mPx[i]; }
+  double py(std::size_t i) const { return mPy[i]; }
+  double pz(std::size_t i) const { return mPz[i]; }
+  double p(std::size_t i) const { return mP[i]; }
+  double e(std::size_t i) const { return mE[i]; }
+  double mass() const { return mMass; }
+  int sign(std::size_t i) const { return mSign[i]; }
+  uint32_t selection(std::size_t i) const { return mSelection[i]; }
+  bool isSelected(std::size_t i, uint32_t mask) const { return (mSelection[i] & mask) == mask; }
+
+  /// Momentum range of a second daughter of mass mass2 such that the pair with a first daughter
+  /// of momentum p1 and energy e1 has an invariant mass below maxMass
+  /// \return false if no momentum is compatible
+  static bool compatibleMomentumRange(double p1, double e1, double mass1, double mass2, double maxMass, double& pMin, double& pMax)
+  {
+    // with the opening angle free, M^2 >= m1^2 + m2^2 + 2 (E1 E2 - p1 p2), and the condition on p2 is quadratic
+    const double c = 0.5 * (maxMass * maxMass - mass1 * mass1 - mass2 * mass2);
+    const double m1m2 = mass1 * mass2;
+    if (c < m1m2) {
+      return false; // below the threshold
+    }
+    if (mass1 <= 0.) {
+      pMin = 0.;
+      pMax = std::numeric_limits<double>::max();
+      return true;
+    }
+    const double delta = e1 * std::sqrt(c * c - m1m2 * m1m2);
+    pMin = std::max(0., (c * p1 - delta) / (mass1 * mass1));
+    pMax = (c * p1 + delta) / (mass1 * mass1);
+    return true;
+  }
+
+  /// Loops over the pairs of a first daughter of this array and a second daughter of another array, or of the same one,
+  /// which can have an invariant mass below maxMass. The second daughters are found by binary search in momentum.
+  /// \param others array of the second daughters
+  /// \param maxMass maximum invariant mass of the pairs
+  /// \param f callable taking the positions of the first daughter and of the second one
+  template <typename F>
+  void forEachPairBelowMass(const ResonanceDaughters& others, double maxMass, F&& f) const
+  {
+    others.sortByP();
+    const auto& sorted = others.mSortedByP;
+    for (std::size_t i = 0; i < size(); i++) {
+      double pMin = 0., pMax = 0.;
+      if (!compatibleMomentumRange(mP[i], mE[i], mMass, others.mMass, maxMass, pMin, pMax)) {
+        continue;
+      }
+      auto first = std::lower_bound(sorted.begin(), sorted.end(), pMin, [&others](std::size_t j, double pValue) { return others.mP[j] < pValue; });
+      for (auto it = first; it != sorted.end() && others.mP[*it] <= pMax; ++it) {
+        f(i, *it);
+      }
+    }
+  }
+
+ private:
+  void sortByP() const
+  {
+    if (mSortedByP.size() == size()) {
+      return;
+    }
+    mSortedByP.resize(size());
+    std::iota(mSortedByP.begin(), mSortedByP.end(), 0);
+    std::stable_sort(mSortedByP.begin(), mSortedByP.end(), [this](std::size_t a, std::size_t b) { return mP[a] < mP[b]; });
+  }
+
+  double mMass = 0.;                           // mass hypothesis
+  std::vector<double> mPx, mPy, mPz;           // momentum components
+  std::vector<double> mP;                      // momentum magnitude
+  std::vector<double> mE;                      // energy under the mass hypothesis
+  std::vector<int8_t> mSign;                   // charge sign
+  std::vector<uint32_t> mSelection;            // selection bits
+  mutable std::vector<std::size_t> mSortedByP; // positions sorted by momentum, filled on first use
+};
+
+} // namespace pwglf
+} // namespace o2
+
+#endif // PWGLF_UTILS_RESONANCEDAUGHTERS_H_
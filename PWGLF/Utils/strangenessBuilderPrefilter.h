@@ -0,0 +1,70 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file  strangenessBuilderPrefilter.h
+/// \brief Analytic distances between helices, lines and points in the transverse plane,
+///        used by the strangeness builders to reject candidates before running the DCA fitter.
+///        In a uniform field the transverse projection of a track is a circle, so these distances
+///        are lower bounds of the 3D distances found by the fitter, up to material effects.
+///
+
+#ifndef PWGLF_UTILS_STRANGENESSBUILDERPREFILTER_H_
+#define PWGLF_UTILS_STRANGENESSBUILDERPREFILTER_H_
+
+#include <cmath>
+
+#include "MathUtils/Primitive2D.h"
+
+namespace o2
+{
+namespace pwglf
+{
+
+// With absolute DCAs, the chi2 of a 2-prong fit is the sum of the squared distances of the
+// prongs to their mid-point, such that the distance of closest approach is sqrt(2) times sqrt(chi2)
+constexpr float DCAFitterDistanceScale = 1.41421356f;
+
+/// Transverse distance of closest approach between a helix and a point
+inline float dcaXYHelixToPoint(const o2::math_utils::CircleXYf_t& circle, float x, float y)
+{
+  return std::abs(std::hypot(circle.xC - x, circle.yC - y) - circle.rC);
+}
+
+/// Transverse distance of closest approach between two helices, 0 if their projections cross
+inline float dcaXYHelixToHelix(const o2::math_utils::CircleXYf_t& circle1, const o2::math_utils::CircleXYf_t& circle2)
+{
+  const float centerDistance = std::hypot(circle1.xC - circle2.xC, circle1.yC - circle2.yC);
+  if (centerDistance > circle1.rC + circle2.rC) {
+    return centerDistance - circle1.rC - circle2.rC; // circles outside of each other
+  }
+  const float radiusDifference = std::abs(circle1.rC - circle2.rC);
+  if (centerDistance < radiusDifference) {
+    return radiusDifference - centerDistance; // one circle inside the other
+  }
+  return 0.f;
+}
+
+/// Transverse distance of closest approach between a helix and the straight line of a neutral particle, 0 if they cross
+inline float dcaXYHelixToLine(const o2::math_utils::CircleXYf_t& circle, float x, float y, float px, float py)
+{
+  const float pt = std::hypot(px, py);
+  if (pt <= 0.f) {
+    return 0.f; // no transverse direction, no rejection
+  }
+  const float centerToLine = std::abs((circle.xC - x) * py - (circle.yC - y) * px) / pt;
+  return centerToLine > circle.rC ? centerToLine - circle.rC : 0.f;
+}
+
+} // namespace pwglf
+} // namespace o2
+
+#endif // PWGLF_UTILS_STRANGENESSBUILDERPREFILTER_H_
@@ -0,0 +1,80 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file  strangenessMasses.h
+/// \brief Invariant masses of all the V0 hypotheses of a table, computed in one pass with RecoDecay::mTwoProngs.
+///        The values are the same as those of the mK0Short(), mLambda(), mAntiLambda() and mGamma() dynamic columns,
+///        which evaluate the full mass again at every call.
+///
+
+#ifndef PWGLF_UTILS_STRANGENESSMASSES_H_
+#define PWGLF_UTILS_STRANGENESSMASSES_H_
+
+#include <array>
+#include <vector>
+
+#include "CommonConstants/PhysicsConstants.h"
+#include "Common/Core/RecoDecay.h"
+
+namespace o2
+{
+namespace pwglf
+{
+
+/// Masses of a V0 under the different hypotheses
+struct V0Masses {
+  float k0Short;
+  float lambda;
+  float antiLambda;
+  float gamma;
+};
+
+class V0MassHypotheses
+{
+ public:
+  /// Computes the masses of all the V0s of a table, e.g. a collision slice of V0Cores
+  template <typename TV0s>
+  void compute(TV0s const& v0s)
+  {
+    const std::size_t nV0s = v0s.size();
+    for (auto* column : {&mPxPos, &mPyPos, &mPzPos, &mPxNeg, &mPyNeg, &mPzNeg, &mK0Short, &mLambda, &mAntiLambda, &mGamma}) {
+      column->resize(nV0s);
+    }
+    std::size_t iV0 = 0;
+    for (const auto& v0 : v0s) {
+      mPxPos[iV0] = v0.pxpos();
+      mPyPos[iV0] = v0.pypos();
+      mPzPos[iV0] = v0.pzpos();
+      mPxNeg[iV0] = v0.pxneg();
+      mPyNeg[iV0] = v0.pyneg();
+      mPzNeg[iV0] = v0.pzneg();
+      iV0++;
+    }
+    using namespace o2::constants::physics;
+    RecoDecay::mTwoProngs(nV0s, std::array<const float*, 3>{mPxPos.data(), mPyPos.data(), mPzPos.data()}, std::array<const float*, 3>{mPxNeg.data(), mPyNeg.data(), mPzNeg.data()},
+                          std::array<std::array<double, 2>, 4>{{{MassPionCharged, MassPionCharged}, {MassProton, MassPionCharged}, {MassPionCharged, MassProton}, {MassElectron, MassElectron}}},
+                          std::array<float*, 4>{mK0Short.data(), mLambda.data(), mAntiLambda.data(), mGamma.data()});
+  }
+
+  /// Masses of the V0 at a given position in the table of the last compute()
+  V0Masses get(std::size_t iV0) const { return {mK0Short[iV0], mLambda[iV0], mAntiLambda[iV0], mGamma[iV0]}; }
+
+ private:
+  std::vector<float> mPxPos, mPyPos, mPzPos; // positive daughter momenta
+  std::vector<float> mPxNeg, mPyNeg, mPzNeg; // negative daughter momenta
+  std::vector<float> mK0Short, mLambda, mAntiLambda, mGamma;
+};
+
+} // namespace pwglf
+} // namespace o2
+
+#endif // PWGLF_UTILS_STRANGENESSMASSES_H_
@@ -12,6 +12,7 @@
 #ifndef PWGLF_UTILS_SVPOOLCREATOR_H_
 #define PWGLF_UTILS_SVPOOLCREATOR_H_
 
+#include <algorithm>
 #include <array>
 #include <unordered_map>
 #include <vector>
@@ -42,6 +43,13 @@ struct SVCand {
   CollBracket collBracket{};
 };
 
+struct CollTimeInfo {
+  uint64_t globalBC;
+  float collTime;
+  float collTimeRes2;
+  int collIdx;
+};
+
 class svPoolCreator
 {
  public:
@@ -58,6 +66,8 @@ class svPoolCreator
     tmap.clear();
     svCandPool.clear();
     bc2Coll.clear();
+    ambiTrackBC.clear();
+    ambiTrackBCFilled = false;
   }
 
   void setTimeMargin(float timeMargin) { timeMarginNS = timeMargin; }
@@ -66,84 +76,67 @@ class svPoolCreator
   o2::vertexing::DCAFitterN<2>* getFitter() { return &fitter; }
   std::array<std::vector<TrackCand>, 4> getTrackCandPool() { return trackCandPool; }
 
+  /// Fills the BC-sorted array of the collision times, to be called before appending the track candidates
   template <typename C>
   void fillBC2Coll(const C& collisions, aod::BCsWithTimestamps const&)
   {
+    bc2Coll.reserve(collisions.size());
     for (unsigned i = 0; i < collisions.size(); i++) {
       auto collision = collisions.rawIteratorAt(i);
       if (!collision.has_bc()) {
         continue;
       }
-      bc2Coll[collision.template bc_as<aod::BCsWithTimestamps>().globalBC()] = i;
+      bc2Coll.push_back({collision.template bc_as<aod::BCsWithTimestamps>().globalBC(), collision.collisionTime(), collision.collisionTimeRes() * collision.collisionTimeRes(), static_cast<int>(collision.globalIndex())});
     }
+    std::stable_sort(bc2Coll.begin(), bc2Coll.end(), [](const CollTimeInfo& a, const CollTimeInfo& b) { return a.globalBC < b.globalBC; });
   }
 
   template <typename T, typename C>
-  void appendTrackCand(const T& trackCand, const C& collisions, int pdgHypo, o2::aod::AmbiguousTracks const& ambiTracks, aod::BCsWithTimestamps const&)
+  void appendTrackCand(const T& trackCand, const C& /*collisions*/, int pdgHypo, o2::aod::AmbiguousTracks const& ambiTracks, aod::BCsWithTimestamps const&)
   {
     if (pdgHypo != track0Pdg && pdgHypo != track1Pdg) {
       LOG(debug) << "Wrong pdg hypothesis";
       return;
     }
     bool isDau0 = pdgHypo == track0Pdg;
-    uint64_t globalBC = -1;
+    uint64_t globalBC = NoBC;
     if (trackCand.has_collision()) {
       if (trackCand.template collision_as<C>().has_bc()) {
         globalBC = trackCand.template collision_as<C>().template bc_as<aod::BCsWithTimestamps>().globalBC();
       }
     } else if (!skipAmbiTracks) {
-      for (const auto& ambTrack : ambiTracks) {
-        if (ambTrack.trackId() != trackCand.globalIndex()) {
-          continue;
-        }
-        if (!ambTrack.has_bc() || ambTrack.bc_as<aod::BCsWithTimestamps>().size() == 0) {
-          globalBC = -1;
-          break;
-        }
-        globalBC = ambTrack.bc_as<aod::BCsWithTimestamps>().begin().globalBC();
-        break;
+      if (!ambiTrackBCFilled) {
+        fillAmbiTrackBC(ambiTracks);
+      }
+      auto ambiTrack = std::lower_bound(ambiTrackBC.begin(), ambiTrackBC.end(), std::make_pair(static_cast<int64_t>(trackCand.globalIndex()), uint64_t{0}));
+      if (ambiTrack != ambiTrackBC.end() && ambiTrack->first == trackCand.globalIndex()) {
+        globalBC = ambiTrack->second;
       }
-    } else {
-      globalBC = -1;
     }
 
-    if (globalBC == -1) {
+    if (globalBC == NoBC) {
       return;
     }
 
-    uint64_t firstBC = globalBC < bOffsetMax ? 0 : globalBC - bOffsetMax;
-    uint64_t lastBC = globalBC + bOffsetMax;
-    int firstCollIdx = -1;
-    while (firstBC < lastBC) {
-      if (bc2Coll.find(firstBC) != bc2Coll.end()) {
-        firstCollIdx = bc2Coll[firstBC];
-        break;
-      }
-      firstBC++;
+    float trackTime{0.};
+    float trackTimeRes{0.};
+    if (trackCand.isPVContributor()) {
+      trackTime = trackCand.template collision_as<C>().collisionTime(); // if PV contributor, we assume the time to be the one of the collision
+      trackTimeRes = constants::lhc::LHCBunchSpacingNS;                 // 1 BC
+    } else {
+      trackTime = trackCand.trackTime();
+      trackTimeRes = trackCand.trackTimeRes();
     }
-    // now loop over all the collisions to make the pool
-    for (int i = firstCollIdx; i < collisions.size(); i++) {
-      const auto& collision = collisions.rawIteratorAt(i);
-      float collTime = collision.collisionTime();
-      float collTimeRes2 = collision.collisionTimeRes() * collision.collisionTimeRes();
-      uint64_t collBC = collision.template bc_as<aod::BCsWithTimestamps>().globalBC();
-      int collIdx = collision.globalIndex();
-      int64_t bcOffset = globalBC - (int64_t)collBC;
-      if (std::abs(bcOffset) > bOffsetMax && bcOffset < 0) {
-        break;
-      } else if (std::abs(bcOffset) > bOffsetMax && bcOffset > 0) {
-        continue;
-      }
 
-      float trackTime{0.};
-      float trackTimeRes{0.};
-      if (trackCand.isPVContributor()) {
-        trackTime = trackCand.template collision_as<C>().collisionTime(); // if PV contributor, we assume the time to be the one of the collision
-        trackTimeRes = constants::lhc::LHCBunchSpacingNS;                 // 1 BC
-      } else {
-        trackTime = trackCand.trackTime();
-        trackTimeRes = trackCand.trackTimeRes();
-      }
+    // sweep over the BC-sorted collisions within the maximum BC offset
+    uint64_t firstBC = globalBC < bOffsetMax ? 0 : globalBC - bOffsetMax;
+    uint64_t lastBC = globalBC + bOffsetMax;
+    auto firstColl = std::lower_bound(bc2Coll.begin(), bc2Coll.end(), firstBC, [](const CollTimeInfo& coll, uint64_t bc) { return coll.globalBC < bc; });
+    for (auto coll = firstColl; coll != bc2Coll.end() && coll->globalBC <= lastBC; ++coll) {
+      float collTime = coll->collTime;
+      float collTimeRes2 = coll->collTimeRes2;
+      int collIdx = coll->collIdx;
+      int64_t bcOffset = globalBC - (int64_t)coll->globalBC;
 
       const float deltaTime = trackTime - collTime + bcOffset * constants::lhc::LHCBunchSpacingNS;
       float sigmaTimeRes2 = collTimeRes2 + trackTimeRes * trackTimeRes;
@@ -178,12 +171,20 @@ class svPoolCreator
       trackCandPool[poolIndex].emplace_back(trForpool);
       tmap[trackCand.globalIndex()] = {trackCandPool[poolIndex].size() - 1, poolIndex};
     }
-
-    // is Sorting Needed ? TBD
   }
+
+  /// Pairs the track candidates with overlapping collision brackets, to be called once all the track candidates are appended
   template <typename C>
   std::vector<SVCand>& getSVCandPool(const C& collisions, bool combineLikeSign = false)
   {
+    // the pools are swept in collision order, which requires them to be sorted by bracket
+    for (auto& pool : trackCandPool) {
+      std::sort(pool.begin(), pool.end(), [](const TrackCand& a, const TrackCand& b) {
+        return a.collBracket.getMin() != b.collBracket.getMin() ? a.collBracket.getMin() < b.collBracket.getMin() : a.collBracket.getMax() < b.collBracket.getMax();
+      });
+    }
+    tmap.clear(); // pool positions are not valid anymore
+
     gsl::span<std::vector<TrackCand>> track0Pool{trackCandPool.data(), 2};
     gsl::span<std::vector<TrackCand>> track1Pool{trackCandPool.data() + 2, 2};
     std::array<std::vector<int>, 2> mVtxTrack0{}; // 1st pos. and neg. track of the kink pool for each vertex
@@ -245,13 +246,34 @@ class svPoolCreator
   bool fitSV(unsigned int idxDau0, unsigned int idxDau1, T& trackTable);
 
  private:
+  static constexpr uint64_t NoBC = static_cast<uint64_t>(-1);
+
+  /// Fills the trackId-sorted array of the BCs of the ambiguous tracks, once per dataframe
+  void fillAmbiTrackBC(o2::aod::AmbiguousTracks const& ambiTracks)
+  {
+    ambiTrackBC.clear();
+    ambiTrackBC.reserve(ambiTracks.size());
+    for (const auto& ambTrack : ambiTracks) {
+      uint64_t bc = NoBC;
+      if (ambTrack.has_bc() && ambTrack.bc_as<aod::BCsWithTimestamps>().size() != 0) {
+        bc = ambTrack.bc_as<aod::BCsWithTimestamps>().begin().globalBC();
+      }
+      ambiTrackBC.emplace_back(ambTrack.trackId(), bc);
+    }
+    // the first entry of a track is kept in case of duplicates
+    std::stable_sort(ambiTrackBC.begin(), ambiTrackBC.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    ambiTrackBCFilled = true;
+  }
+
   o2::vertexing::DCAFitterN<2> fitter;
   int track0Pdg;
   int track1Pdg;
   float timeMarginNS = 600.;
   bool skipAmbiTracks = false;
   std::unordered_map<int, std::pair<int, int>> tmap;
-  std::unordered_map<uint64_t, int> bc2Coll;
+  std::vector<CollTimeInfo> bc2Coll;                     // collisions sorted by BC
+  std::vector<std::pair<int64_t, uint64_t>> ambiTrackBC; // BC of the ambiguous tracks, sorted by track index
+  bool ambiTrackBCFilled = false;
 
   std::array<std::vector<TrackCand>, 4> trackCandPool; // Sorting: dau0 pos, dau0 neg, dau1 pos, dau1 neg
   std::vector<SVCand> svCandPool;                      // index of the two tracks in the track table
@@ -17,12 +17,6 @@
 #define bitset(var, nbit) ((var) |= (static_cast<uint64_t>(1) << static_cast<uint64_t>(nbit)))
 #define bitcheck(var, nbit) ((var) & (static_cast<uint64_t>(1) << static_cast<uint64_t>(nbit)))
 
-// trivial 64-bit mask checker
-bool v0SelectionGroup::verifyMask(uint64_t bitmap, uint64_t mask) const
-{
-  return (bitmap & mask) == mask;
-}
-
 // provides standard masks given current event selection criteria.
 void v0SelectionGroup::provideMasks(uint64_t& maskTopological, uint64_t& maskTrackProperties, uint64_t& maskK0ShortSpecific, uint64_t& maskLambdaSpecific, uint64_t& maskAntiLambdaSpecific) const
 {
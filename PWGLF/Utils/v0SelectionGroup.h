@@ -29,7 +29,8 @@ class v0SelectionGroup
   }
 
   void provideMasks(uint64_t& maskTopological, uint64_t& maskTrackProperties, uint64_t& maskK0ShortSpecific, uint64_t& maskLambdaSpecific, uint64_t& maskAntiLambdaSpecific) const;
-  bool verifyMask(uint64_t bitmap, uint64_t mask) const;
+  // trivial 64-bit mask checker, inline since it is called several times per V0
+  bool verifyMask(uint64_t bitmap, uint64_t mask) const { return (bitmap & mask) == mask; }
 
   float getRapidityCut() const { return rapidityCut; }
   float getDaughterEtaCut() const { return daughterEtaCut; }
@@ -24,7 +24,7 @@ namespace v0data
 
 // utility method to calculate a selection map for the V0s
 template <typename TV0, typename TTrack, typename TCollision>
-uint64_t computeReconstructionBitmap(TV0 v0, TTrack posTrackExtra, TTrack negTrackExtra, TCollision collision, float rapidityLambda, float rapidityK0Short, const v0SelectionGroup& v0sels)
+uint64_t computeReconstructionBitmap(TV0 const& v0, TTrack const& posTrackExtra, TTrack const& negTrackExtra, TCollision const& collision, float rapidityLambda, float rapidityK0Short, const v0SelectionGroup& v0sels)
 // precalculate this information so that a check is one mask operation, not many
 {
   uint64_t bitMap = 0;
@@ -114,10 +114,11 @@ uint64_t computeReconstructionBitmap(TV0 v0, TTrack posTrackExtra, TTrack negTra
   if (negTrackExtra.detectorMap() != o2::aod::track::TPC)
     bitset(bitMap, v0data::selNegNotTPCOnly);
 
-  // proper lifetime
-  if (v0.distovertotmom(collision.posX(), collision.posY(), collision.posZ()) * o2::constants::physics::MassLambda0 < v0sels.getlifetimeCutLambda())
+  // proper lifetime, the decay length over momentum is the same for both hypotheses
+  const auto distOverTotMom = v0.distovertotmom(collision.posX(), collision.posY(), collision.posZ());
+  if (distOverTotMom * o2::constants::physics::MassLambda0 < v0sels.getlifetimeCutLambda())
     bitset(bitMap, v0data::selLambdaCTau);
-  if (v0.distovertotmom(collision.posX(), collision.posY(), collision.posZ()) * o2::constants::physics::MassK0Short < v0sels.getlifetimeCutK0Short())
+  if (distOverTotMom * o2::constants::physics::MassK0Short < v0sels.getlifetimeCutK0Short())
     bitset(bitMap, v0data::selK0ShortCTau);
 
   // armenteros
@@ -20,6 +20,8 @@
 #include "Framework/AnalysisDataModel.h"
 #include "Framework/AnalysisTask.h"
 
+#include "Common/Core/ReverseIndex.h"
+
 #include "Index.h"
 
 using namespace o2;
@@ -33,6 +35,8 @@ struct ParticlesToTracks {
   Produces<aod::ParticlesToMftTracks> p2tmft;
 
   std::vector<int> trackIds;
+  std::vector<int> mcParticleIds; // particle of each track, -1 if not labelled
+  ReverseIndex<int> part2track;
 
   void init(InitContext&)
   {
@@ -51,13 +55,17 @@ struct ParticlesToTracks {
   void processIndexingCentralFast(aod::McParticles const& mcParticles, LabeledTracks const& tracks)
   {
     // faster version, but will use more memory due to pre-allocation
-    std::vector<std::vector<int>> part2track(mcParticles.size());
+    // the tracks of all the particles are grouped by counting sort of their labels, in a single array
+    mcParticleIds.clear();
+    mcParticleIds.reserve(tracks.size());
     for (auto& track : tracks) {
-      if (track.has_mcParticle())
-        part2track[track.mcParticleId()].push_back(track.globalIndex());
+      mcParticleIds.push_back(track.mcParticleId());
     }
+    part2track.build(mcParticles.size(), tracks.size(), [&](int iTrack) { return mcParticleIds[iTrack]; });
     for (auto& mcParticle : mcParticles) {
-      p2t(part2track[mcParticle.globalIndex()]);
+      const auto ids = part2track[mcParticle.globalIndex()];
+      trackIds.assign(ids.begin(), ids.end());
+      p2t(trackIds);
     }
   }
   PROCESS_SWITCH(ParticlesToTracks, processIndexingCentralFast, "Create reverse index from particles to tracks: more memory use but potentially faster", false);
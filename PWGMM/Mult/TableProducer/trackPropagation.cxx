@@ -36,7 +36,6 @@
 #include "Common/DataModel/CollisionAssociationTables.h"
 #include "bestCollisionTable.h"
 
-using SMatrix55 = ROOT::Math::SMatrix<double, 5, 5, ROOT::Math::MatRepSym<double, 5>>;
 using SMatrix5 = ROOT::Math::SVector<Double_t, 5>;
 
 // This is a special version of the propagation task chosing the closest vertex
@@ -129,6 +128,18 @@ struct AmbiguousTrackPropagation {
     }
   }
 
+  // Only the parameters enter the DCA to the compatible collisions, and the MFT
+  // tracks carry no covariance: the helix propagation skips the null covariance
+  template <typename T>
+  static o2::track::TrackParFwd getMFTTrackPar(T const& track)
+  {
+    o2::track::TrackParFwd trackPar;
+    trackPar.setZ(track.z());
+    trackPar.setParameters(SMatrix5(track.x(), track.y(), track.phi(), track.tgl(), track.signed1Pt()));
+    trackPar.setTrackChi2(track.chi2());
+    return trackPar;
+  }
+
   static constexpr TrackSelectionFlags::flagtype trackSelectionITS =
     TrackSelectionFlags::kITSNCls | TrackSelectionFlags::kITSChi2NDF |
     TrackSelectionFlags::kITSHits;
@@ -237,7 +248,7 @@ struct AmbiguousTrackPropagation {
     // Minimum only on DCAxy
     float dcaInfo = 0.f;
     float bestDCA = 0.f, bestDCAx = 0.f, bestDCAy = 0.f;
-    o2::track::TrackParCovFwd bestTrackPar;
+    o2::track::TrackParFwd bestTrackPar;
 
     for (auto& atrack : atracks) {
       dcaInfo = 999; // DCAxy
@@ -246,10 +257,7 @@ struct AmbiguousTrackPropagation {
       auto track = atrack.mfttrack();
       auto bestCol = track.has_collision() ? track.collisionId() : -1;
 
-      std::vector<double> v1; // Temporary null vector for the computation of the covariance matrix
-      SMatrix55 tcovs(v1.begin(), v1.end());
-      SMatrix5 tpars(track.x(), track.y(), track.phi(), track.tgl(), track.signed1Pt());
-      o2::track::TrackParCovFwd trackPar{track.z(), tpars, tcovs, track.chi2()};
+      auto trackPar = getMFTTrackPar(track);
 
       int degree = 0; // degree of ambiguity of the track
 
@@ -261,7 +269,7 @@ struct AmbiguousTrackPropagation {
         auto collisions = bc.collisions();
         for (auto const& collision : collisions) {
           degree++;
-          trackPar.propagateToZhelix(collision.posZ(), Bz); // track parameters propagation to the position of the z vertex
+          trackPar.propagateParamToZhelix(collision.posZ(), Bz); // track parameters propagation to the position of the z vertex
 
           const auto dcaX(trackPar.getX() - collision.posX());
           const auto dcaY(trackPar.getY() - collision.posY());
@@ -323,7 +331,7 @@ struct AmbiguousTrackPropagation {
 
     float dcaInfo = 0.f;
     float bestDCA = 0.f, bestDCAx = 0.f, bestDCAy = 0.f;
-    o2::track::TrackParCovFwd bestTrackPar;
+    o2::track::TrackParFwd bestTrackPar;
 
     for (auto& track : tracks) {
       dcaInfo = 999; // DCAxy
@@ -340,14 +348,11 @@ struct AmbiguousTrackPropagation {
 
       auto compatibleColls = track.compatibleColl();
 
-      std::vector<double> v1; // Temporary null vector for the computation of the covariance matrix
-      SMatrix55 tcovs(v1.begin(), v1.end());
-      SMatrix5 tpars(track.x(), track.y(), track.phi(), track.tgl(), track.signed1Pt());
-      o2::track::TrackParCovFwd trackPar{track.z(), tpars, tcovs, track.chi2()};
+      auto trackPar = getMFTTrackPar(track);
 
       for (auto& collision : compatibleColls) {
 
-        trackPar.propagateToZhelix(collision.posZ(), Bz); // track parameters propagation to the position of the z vertex
+        trackPar.propagateParamToZhelix(collision.posZ(), Bz); // track parameters propagation to the position of the z vertex
 
         const auto dcaX(trackPar.getX() - collision.posX());
         const auto dcaY(trackPar.getY() - collision.posY());
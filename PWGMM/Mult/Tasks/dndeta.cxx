@@ -20,6 +20,7 @@
 #include "Framework/runDataProcessing.h"
 #include <TDatabasePDG.h>
 #include <TPDGCode.h>
+#include <unordered_set>
 
 #include "Index.h"
 #include "bestCollisionTable.h"
@@ -104,10 +105,11 @@ struct MultiplicityCounter {
     false,
     true};
 
-  std::vector<int> usedTracksIds;
-  std::vector<int> usedTracksIdsDF;
-  std::vector<int> usedTracksIdsDFMC;
-  std::vector<int> usedTracksIdsDFMCEff;
+  // looked up for every track of the collisions, hence sets
+  std::unordered_set<int> usedTracksIds;
+  std::unordered_set<int> usedTracksIdsDF;
+  std::unordered_set<int> usedTracksIdsDFMC;
+  std::unordered_set<int> usedTracksIdsDFMCEff;
   void init(InitContext&)
   {
     AxisSpec MultAxis = {multBinning};
@@ -447,22 +449,26 @@ struct MultiplicityCounter {
   {
     auto Ntrks = 0;
     for (auto& track : tracks) {
-      if (std::abs(track.eta()) < estimatorEta) {
+      // eta, phi and pt are dynamic columns: evaluated once per track
+      const auto eta = track.eta();
+      const auto phi = track.phi();
+      const auto pt = track.pt();
+      if (std::abs(eta) < estimatorEta) {
         ++Ntrks;
       }
       if constexpr (fillHistos) {
         if constexpr (hasRecoCent<C>()) {
-          binnedRegistry.fill(HIST(EtaZvtx), track.eta(), z, c);
-          binnedRegistry.fill(HIST(PhiEta), track.phi(), track.eta(), c);
-          binnedRegistry.fill(HIST(PtEta), track.pt(), track.eta(), c);
-          binnedRegistry.fill(HIST(DCAXYPt), track.pt(), track.dcaXY(), c);
-          binnedRegistry.fill(HIST(DCAZPt), track.pt(), track.dcaZ(), c);
+          binnedRegistry.fill(HIST(EtaZvtx), eta, z, c);
+          binnedRegistry.fill(HIST(PhiEta), phi, eta, c);
+          binnedRegistry.fill(HIST(PtEta), pt, eta, c);
+          binnedRegistry.fill(HIST(DCAXYPt), pt, track.dcaXY(), c);
+          binnedRegistry.fill(HIST(DCAZPt), pt, track.dcaZ(), c);
         } else {
-          inclusiveRegistry.fill(HIST(EtaZvtx), track.eta(), z);
-          inclusiveRegistry.fill(HIST(PhiEta), track.phi(), track.eta());
-          inclusiveRegistry.fill(HIST(PtEta), track.pt(), track.eta());
-          inclusiveRegistry.fill(HIST(DCAXYPt), track.pt(), track.dcaXY());
-          inclusiveRegistry.fill(HIST(DCAZPt), track.pt(), track.dcaZ());
+          inclusiveRegistry.fill(HIST(EtaZvtx), eta, z);
+          inclusiveRegistry.fill(HIST(PhiEta), phi, eta);
+          inclusiveRegistry.fill(HIST(PtEta), pt, eta);
+          inclusiveRegistry.fill(HIST(DCAXYPt), pt, track.dcaXY());
+          inclusiveRegistry.fill(HIST(DCAZPt), pt, track.dcaZ());
         }
       }
     }
@@ -565,82 +571,88 @@ struct MultiplicityCounter {
           continue;
         }
       }
-      usedTracksIds.emplace_back(track.trackId());
-      if (std::abs(otrack.eta()) < estimatorEta) {
+      usedTracksIds.emplace(track.trackId());
+      const auto eta = otrack.eta();
+      const auto phi = otrack.phi();
+      const auto pt = otrack.pt();
+      if (std::abs(eta) < estimatorEta) {
         ++Ntrks;
       }
       if (fillHistos) {
         if constexpr (hasRecoCent<C>()) {
-          binnedRegistry.fill(HIST(EtaZvtx), otrack.eta(), z, c);
-          binnedRegistry.fill(HIST(PhiEta), otrack.phi(), otrack.eta(), c);
-          binnedRegistry.fill(HIST(PtEta), otrack.pt(), otrack.eta(), c);
-          binnedRegistry.fill(HIST(DCAXYPt), otrack.pt(), track.bestDCAXY(), c);
-          binnedRegistry.fill(HIST(DCAZPt), otrack.pt(), track.bestDCAZ(), c);
+          binnedRegistry.fill(HIST(EtaZvtx), eta, z, c);
+          binnedRegistry.fill(HIST(PhiEta), phi, eta, c);
+          binnedRegistry.fill(HIST(PtEta), pt, eta, c);
+          binnedRegistry.fill(HIST(DCAXYPt), pt, track.bestDCAXY(), c);
+          binnedRegistry.fill(HIST(DCAZPt), pt, track.bestDCAZ(), c);
         } else {
-          inclusiveRegistry.fill(HIST(EtaZvtx), otrack.eta(), z);
-          inclusiveRegistry.fill(HIST(PhiEta), otrack.phi(), otrack.eta());
-          inclusiveRegistry.fill(HIST(PtEta), otrack.pt(), otrack.eta());
-          inclusiveRegistry.fill(HIST(DCAXYPt), otrack.pt(), track.bestDCAXY());
-          inclusiveRegistry.fill(HIST(DCAZPt), otrack.pt(), track.bestDCAZ());
+          inclusiveRegistry.fill(HIST(EtaZvtx), eta, z);
+          inclusiveRegistry.fill(HIST(PhiEta), phi, eta);
+          inclusiveRegistry.fill(HIST(PtEta), pt, eta);
+          inclusiveRegistry.fill(HIST(DCAXYPt), pt, track.bestDCAXY());
+          inclusiveRegistry.fill(HIST(DCAZPt), pt, track.bestDCAZ());
         }
       }
       if (otrack.has_collision() && otrack.collisionId() != track.bestCollisionId()) {
-        usedTracksIdsDF.emplace_back(track.trackId());
+        usedTracksIdsDF.emplace(track.trackId());
         if constexpr (fillHistos) {
           if constexpr (hasRecoCent<C>()) {
-            binnedRegistry.fill(HIST(ReassignedEtaZvtx), otrack.eta(), z, c);
-            binnedRegistry.fill(HIST(ReassignedPhiEta), otrack.phi(), otrack.eta(), c);
+            binnedRegistry.fill(HIST(ReassignedEtaZvtx), eta, z, c);
+            binnedRegistry.fill(HIST(ReassignedPhiEta), phi, eta, c);
             binnedRegistry.fill(HIST(ReassignedZvtxCorr), otrack.template collision_as<C>().posZ(), z, c);
-            binnedRegistry.fill(HIST(ReassignedDCAXYPt), otrack.pt(), track.bestDCAXY(), c);
-            binnedRegistry.fill(HIST(ReassignedDCAZPt), otrack.pt(), track.bestDCAZ(), c);
+            binnedRegistry.fill(HIST(ReassignedDCAXYPt), pt, track.bestDCAXY(), c);
+            binnedRegistry.fill(HIST(ReassignedDCAZPt), pt, track.bestDCAZ(), c);
           } else {
-            inclusiveRegistry.fill(HIST(ReassignedEtaZvtx), otrack.eta(), z);
-            inclusiveRegistry.fill(HIST(ReassignedPhiEta), otrack.phi(), otrack.eta());
+            inclusiveRegistry.fill(HIST(ReassignedEtaZvtx), eta, z);
+            inclusiveRegistry.fill(HIST(ReassignedPhiEta), phi, eta);
             inclusiveRegistry.fill(HIST(ReassignedZvtxCorr), otrack.template collision_as<C>().posZ(), z);
-            inclusiveRegistry.fill(HIST(ReassignedDCAXYPt), otrack.pt(), track.bestDCAXY());
-            inclusiveRegistry.fill(HIST(ReassignedDCAZPt), otrack.pt(), track.bestDCAZ());
+            inclusiveRegistry.fill(HIST(ReassignedDCAXYPt), pt, track.bestDCAXY());
+            inclusiveRegistry.fill(HIST(ReassignedDCAZPt), pt, track.bestDCAZ());
           }
         }
       } else if (!otrack.has_collision()) {
         if constexpr (fillHistos) {
           if constexpr (hasRecoCent<C>()) {
-            binnedRegistry.fill(HIST(ExtraEtaZvtx), otrack.eta(), z, c);
-            binnedRegistry.fill(HIST(ExtraPhiEta), otrack.phi(), otrack.eta(), c);
-            binnedRegistry.fill(HIST(ExtraDCAXYPt), otrack.pt(), track.bestDCAXY(), c);
-            binnedRegistry.fill(HIST(ExtraDCAZPt), otrack.pt(), track.bestDCAZ(), c);
+            binnedRegistry.fill(HIST(ExtraEtaZvtx), eta, z, c);
+            binnedRegistry.fill(HIST(ExtraPhiEta), phi, eta, c);
+            binnedRegistry.fill(HIST(ExtraDCAXYPt), pt, track.bestDCAXY(), c);
+            binnedRegistry.fill(HIST(ExtraDCAZPt), pt, track.bestDCAZ(), c);
           } else {
-            inclusiveRegistry.fill(HIST(ExtraEtaZvtx), otrack.eta(), z);
-            inclusiveRegistry.fill(HIST(ExtraPhiEta), otrack.phi(), otrack.eta());
-            inclusiveRegistry.fill(HIST(ExtraDCAXYPt), otrack.pt(), track.bestDCAXY());
-            inclusiveRegistry.fill(HIST(ExtraDCAZPt), otrack.pt(), track.bestDCAZ());
+            inclusiveRegistry.fill(HIST(ExtraEtaZvtx), eta, z);
+            inclusiveRegistry.fill(HIST(ExtraPhiEta), phi, eta);
+            inclusiveRegistry.fill(HIST(ExtraDCAXYPt), pt, track.bestDCAXY());
+            inclusiveRegistry.fill(HIST(ExtraDCAZPt), pt, track.bestDCAZ());
           }
         }
       }
     }
 
     for (auto& track : tracks) {
-      if (std::find(usedTracksIds.begin(), usedTracksIds.end(), track.globalIndex()) != usedTracksIds.end()) {
+      if (usedTracksIds.find(track.globalIndex()) != usedTracksIds.end()) {
         continue;
       }
-      if (std::find(usedTracksIdsDF.begin(), usedTracksIdsDF.end(), track.globalIndex()) != usedTracksIdsDF.end()) {
+      if (usedTracksIdsDF.find(track.globalIndex()) != usedTracksIdsDF.end()) {
         continue;
       }
-      if (std::abs(track.eta()) < estimatorEta) {
+      const auto eta = track.eta();
+      const auto phi = track.phi();
+      const auto pt = track.pt();
+      if (std::abs(eta) < estimatorEta) {
         ++Ntrks;
       }
       if constexpr (fillHistos) {
         if constexpr (hasRecoCent<C>()) {
-          binnedRegistry.fill(HIST(EtaZvtx), track.eta(), z, c);
-          binnedRegistry.fill(HIST(PhiEta), track.phi(), track.eta(), c);
-          binnedRegistry.fill(HIST(PtEta), track.pt(), track.eta(), c);
-          binnedRegistry.fill(HIST(DCAXYPt), track.pt(), track.dcaXY(), c);
-          binnedRegistry.fill(HIST(DCAZPt), track.pt(), track.dcaZ(), c);
+          binnedRegistry.fill(HIST(EtaZvtx), eta, z, c);
+          binnedRegistry.fill(HIST(PhiEta), phi, eta, c);
+          binnedRegistry.fill(HIST(PtEta), pt, eta, c);
+          binnedRegistry.fill(HIST(DCAXYPt), pt, track.dcaXY(), c);
+          binnedRegistry.fill(HIST(DCAZPt), pt, track.dcaZ(), c);
         } else {
-          inclusiveRegistry.fill(HIST(EtaZvtx), track.eta(), z);
-          inclusiveRegistry.fill(HIST(PhiEta), track.phi(), track.eta());
-          inclusiveRegistry.fill(HIST(PtEta), track.pt(), track.eta());
-          inclusiveRegistry.fill(HIST(DCAXYPt), track.pt(), track.dcaXY());
-          inclusiveRegistry.fill(HIST(DCAZPt), track.pt(), track.dcaZ());
+          inclusiveRegistry.fill(HIST(EtaZvtx), eta, z);
+          inclusiveRegistry.fill(HIST(PhiEta), phi, eta);
+          inclusiveRegistry.fill(HIST(PtEta), pt, eta);
+          inclusiveRegistry.fill(HIST(DCAXYPt), pt, track.dcaXY());
+          inclusiveRegistry.fill(HIST(DCAZPt), pt, track.dcaZ());
         }
       }
     }
@@ -695,10 +707,10 @@ struct MultiplicityCounter {
             }
           }
           for (auto& track : tracks) {
-            if (std::find(usedTracksIds.begin(), usedTracksIds.end(), track.globalIndex()) != usedTracksIds.end()) {
+            if (usedTracksIds.find(track.globalIndex()) != usedTracksIds.end()) {
               continue;
             }
-            if (std::find(usedTracksIdsDF.begin(), usedTracksIdsDF.end(), track.globalIndex()) != usedTracksIdsDF.end()) {
+            if (usedTracksIdsDF.find(track.globalIndex()) != usedTracksIdsDF.end()) {
               continue;
             }
             if (Ntrks > 0) {
@@ -728,10 +740,10 @@ struct MultiplicityCounter {
             }
           }
           for (auto& track : tracks) {
-            if (std::find(usedTracksIds.begin(), usedTracksIds.end(), track.globalIndex()) != usedTracksIds.end()) {
+            if (usedTracksIds.find(track.globalIndex()) != usedTracksIds.end()) {
               continue;
             }
-            if (std::find(usedTracksIdsDF.begin(), usedTracksIdsDF.end(), track.globalIndex()) != usedTracksIdsDF.end()) {
+            if (usedTracksIdsDF.find(track.globalIndex()) != usedTracksIdsDF.end()) {
               continue;
             }
             if (Ntrks > 0) {
@@ -1070,9 +1082,9 @@ struct MultiplicityCounter {
     usedTracksIds.clear();
     for (auto const& track : atracks) {
       auto otrack = track.template track_as<FiLTracks>();
-      usedTracksIds.emplace_back(track.trackId());
+      usedTracksIds.emplace(track.trackId());
       if (otrack.collisionId() != track.bestCollisionId()) {
-        usedTracksIdsDFMCEff.emplace_back(track.trackId());
+        usedTracksIdsDFMCEff.emplace(track.trackId());
       }
       if (otrack.has_mcParticle()) {
         auto particle = otrack.mcParticle_as<Particles>();
@@ -1115,10 +1127,10 @@ struct MultiplicityCounter {
       }
     }
     for (auto const& track : tracks) {
-      if (std::find(usedTracksIds.begin(), usedTracksIds.end(), track.globalIndex()) != usedTracksIds.end()) {
+      if (usedTracksIds.find(track.globalIndex()) != usedTracksIds.end()) {
         continue;
       }
-      if (std::find(usedTracksIdsDFMCEff.begin(), usedTracksIdsDFMCEff.end(), track.globalIndex()) != usedTracksIdsDFMCEff.end()) {
+      if (usedTracksIdsDFMCEff.find(track.globalIndex()) != usedTracksIdsDFMCEff.end()) {
         continue;
       }
       if (track.has_mcParticle()) {
@@ -467,6 +467,62 @@ bool cleanFITC(T& bc, float maxFITtime, std::vector<float> lims)
          cleanFDDC(bc, maxFITtime, lims[4]);
 }
 
+// -----------------------------------------------------------------------------
+// FIT activity of a range of consecutive BCs for several sets of FIT amplitude limits.
+// cleanFIT is evaluated once per BC and set of limits, and the numbers of BCs which are
+// not clean are kept as prefix sums over the range. Whether all BCs of a slice of the
+// range are clean is then known without looping over the slice, e.g. for the
+// compatible BCs of a collision with increasing numbers of BCs.
+class FITActivity
+{
+ public:
+  template <typename T>
+  void fill(T const& bcs, float maxFITtime, std::vector<std::vector<float>> const& lims)
+  {
+    mMaxFITtime = maxFITtime;
+    mLims = lims;
+    mFirstRow = bcs.size() > 0 ? bcs.begin().globalIndex() : 0;
+    mNBCs = bcs.size();
+    const int64_t nLims = mLims.size();
+    mNotClean.assign((mNBCs + 1) * nLims, 0);
+    int64_t iBC = 0;
+    for (auto const& bc : bcs) {
+      for (int64_t iLims = 0; iLims < nLims; iLims++) {
+        mNotClean[(iBC + 1) * nLims + iLims] = mNotClean[iBC * nLims + iLims] + (cleanFIT(bc, mMaxFITtime, mLims[iLims]) ? 0 : 1);
+      }
+      iBC++;
+    }
+  }
+
+  // true if all BCs of bcSlice are clean for the set of limits iLims
+  // slices which are not contained in the filled range are evaluated BC by BC
+  template <typename T>
+  bool isClean(T const& bcSlice, int iLims) const
+  {
+    if (bcSlice.size() == 0) {
+      return true;
+    }
+    const int64_t nLims = mLims.size();
+    const int64_t first = bcSlice.begin().globalIndex() - mFirstRow;
+    const int64_t last = first + bcSlice.size();
+    if (first < 0 || last > mNBCs) {
+      bool isCleanSlice = true;
+      for (auto const& bc : bcSlice) {
+        isCleanSlice &= cleanFIT(bc, mMaxFITtime, mLims[iLims]);
+      }
+      return isCleanSlice;
+    }
+    return mNotClean[last * nLims + iLims] == mNotClean[first * nLims + iLims];
+  }
+
+ private:
+  float mMaxFITtime{0.};
+  std::vector<std::vector<float>> mLims;
+  int64_t mFirstRow{0};
+  int64_t mNBCs{0};
+  std::vector<int32_t> mNotClean; // [BC][set of limits], BCs which are not clean before a position of the range
+};
+
 // -----------------------------------------------------------------------------
 template <typename T>
 bool TVX(T& bc)
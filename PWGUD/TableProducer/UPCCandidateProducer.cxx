@@ -16,6 +16,7 @@
 #include "Framework/AnalysisTask.h"
 #include "Framework/AnalysisDataModel.h"
 #include "Common/CCDB/EventSelectionParams.h"
+#include "Common/Core/BcIndex.h"
 #include "Common/DataModel/EventSelection.h"
 #include "CommonConstants/LHCConstants.h"
 #include "DataFormatsFIT/Triggers.h"
@@ -29,7 +30,7 @@ using namespace o2::framework::expressions;
 struct UpcCandProducer {
   bool fDoMC{false};
 
-  std::map<int32_t, int32_t> fNewPartIDs;
+  std::vector<int32_t> fNewPartIDs; // MC particle ID -> ID in the skimmed MC table, -1 if not stored
   uint64_t fMaxBC{0}; // max BC for ITS-TPC search
 
   Produces<o2::aod::UDMcCollisions> udMCCollisions;
@@ -99,6 +100,11 @@ struct UpcCandProducer {
 
   typedef std::pair<uint64_t, std::vector<int64_t>> BCTracksPair;
 
+  int32_t getNewPartID(int64_t mcPartID) const
+  {
+    return (mcPartID >= 0 && mcPartID < static_cast<int64_t>(fNewPartIDs.size())) ? fNewPartIDs[mcPartID] : -1;
+  }
+
   void init(InitContext&)
   {
     fwdSelectors.resize(upchelpers::kNFwdSels - 1, false);
@@ -215,19 +221,6 @@ struct UpcCandProducer {
     return true;
   }
 
-  auto findClosestBC(uint64_t globalBC, std::map<uint64_t, int32_t>& bcs)
-  {
-    auto it = bcs.lower_bound(globalBC);
-    auto bc1 = it->first;
-    if (it != bcs.begin())
-      --it;
-    auto bc2 = it->first;
-    auto dbc1 = bc1 >= globalBC ? bc1 - globalBC : globalBC - bc1;
-    auto dbc2 = bc2 >= globalBC ? bc2 - globalBC : globalBC - bc2;
-    auto bc = (dbc1 <= dbc2) ? bc1 : bc2;
-    return bc;
-  }
-
   auto findClosestTrackBCiter(uint64_t globalBC, std::vector<BCTracksPair>& bcs)
   {
     auto it = std::lower_bound(bcs.begin(), bcs.end(), globalBC,
@@ -276,6 +269,7 @@ struct UpcCandProducer {
     int32_t newPartID = 0;
     int32_t newEventID = 0;
     int32_t nMCParticles = mcParticles.size();
+    fNewPartIDs.assign(nMCParticles, -1);
     // loop over MC particles to select only the ones from signal events
     // and calculate new MC table IDs
     for (int32_t mcPartID = 0; mcPartID < nMCParticles; mcPartID++) {
@@ -299,8 +293,10 @@ struct UpcCandProducer {
     std::vector<int32_t> newMotherIDs{};
 
     // storing MC particles
-    for (const auto& item : fNewPartIDs) {
-      int32_t mcPartID = item.first;
+    for (int32_t mcPartID = 0; mcPartID < nMCParticles; mcPartID++) {
+      if (fNewPartIDs[mcPartID] == -1) {
+        continue;
+      }
       const auto& mcPart = mcParticles.iteratorAt(mcPartID);
       int32_t mcEventID = mcPart.mcCollisionId();
       int32_t newEventID = newEventIDs[mcEventID];
@@ -311,9 +307,9 @@ struct UpcCandProducer {
           if (motherID >= nMCParticles) {
             continue;
           }
-          auto it = fNewPartIDs.find(motherID);
-          if (it != fNewPartIDs.end()) {
-            newMotherIDs.push_back(it->second);
+          int32_t newMotherID = getNewPartID(motherID);
+          if (newMotherID != -1) {
+            newMotherIDs.push_back(newMotherID);
           }
         }
       }
@@ -326,11 +322,11 @@ struct UpcCandProducer {
         if (firstDaughter >= nMCParticles || lastDaughter >= nMCParticles) {
           continue;
         }
-        auto itFirst = fNewPartIDs.find(firstDaughter);
-        auto itLast = fNewPartIDs.find(lastDaughter);
-        if (itFirst != fNewPartIDs.end() && itLast != fNewPartIDs.end()) {
-          newDaughterIDs[0] = fNewPartIDs.at(daughterIDs.front());
-          newDaughterIDs[1] = fNewPartIDs.at(daughterIDs.back());
+        int32_t newFirstDaughter = getNewPartID(firstDaughter);
+        int32_t newLastDaughter = getNewPartID(lastDaughter);
+        if (newFirstDaughter != -1 && newLastDaughter != -1) {
+          newDaughterIDs[0] = newFirstDaughter;
+          newDaughterIDs[1] = newLastDaughter;
         }
       }
       udMCParticles(newEventID, mcPart.pdgCode(), mcPart.getHepMCStatusCode(), mcPart.flags(), newMotherIDs, newDaughterIDs,
@@ -374,10 +370,9 @@ struct UpcCandProducer {
       if (fDoMC) {
         const auto& label = mcTrackLabels->iteratorAt(trackID);
         uint16_t mcMask = label.mcMask();
-        auto it = fNewPartIDs.find(label.mcParticleId());
         // signal tracks should always have an MC particle
         // background tracks have label == -1
-        int32_t newPartID = it != fNewPartIDs.end() ? it->second : -1;
+        int32_t newPartID = getNewPartID(label.mcParticleId());
         udFwdTrackLabels(newPartID, mcMask);
       }
     }
@@ -386,15 +381,30 @@ struct UpcCandProducer {
   void fillFwdClusters(const std::vector<int>& trackIds,
                        o2::aod::FwdTrkCls const& fwdTrkCls)
   {
-    std::map<int, std::vector<int>> clustersPerTrack;
+    // clusters per track in table order: offsets of the tracks in the array of cluster IDs
+    int nTracks = 0;
+    for (const auto& cls : fwdTrkCls) {
+      nTracks = std::max(nTracks, cls.fwdtrackId() + 1);
+    }
+    std::vector<int> clsOffsets(nTracks + 1, 0);
     for (const auto& cls : fwdTrkCls) {
-      clustersPerTrack[cls.fwdtrackId()].push_back(cls.globalIndex());
+      clsOffsets[cls.fwdtrackId() + 1]++;
+    }
+    for (int i = 0; i < nTracks; i++) {
+      clsOffsets[i + 1] += clsOffsets[i];
+    }
+    std::vector<int> clsIds(clsOffsets[nTracks]);
+    std::vector<int> clsFill(clsOffsets.begin(), clsOffsets.end() - 1);
+    for (const auto& cls : fwdTrkCls) {
+      clsIds[clsFill[cls.fwdtrackId()]++] = cls.globalIndex();
     }
     int newId = 0;
     for (auto trackId : trackIds) {
-      const auto& clusters = clustersPerTrack.at(trackId);
-      for (auto clsId : clusters) {
-        const auto& clsInfo = fwdTrkCls.iteratorAt(clsId);
+      if (trackId >= nTracks) {
+        LOGP(fatal, "No clusters for forward track {}", trackId);
+      }
+      for (int iCls = clsOffsets[trackId]; iCls < clsOffsets[trackId + 1]; iCls++) {
+        const auto& clsInfo = fwdTrkCls.iteratorAt(clsIds[iCls]);
         udFwdTrkClusters(newId, clsInfo.x(), clsInfo.y(), clsInfo.z(), clsInfo.clInfo());
       }
       newId++;
@@ -429,10 +439,9 @@ struct UpcCandProducer {
         const auto& label = mcTrackLabels->iteratorAt(trackID);
         uint16_t mcMask = label.mcMask();
         int32_t mcPartID = label.mcParticleId();
-        auto it = fNewPartIDs.find(mcPartID);
         // signal tracks should always have an MC particle
         // background tracks have label == -1
-        int32_t newPartID = it != fNewPartIDs.end() ? it->second : -1;
+        int32_t newPartID = getNewPartID(mcPartID);
         udTrackLabels(newPartID, mcMask);
       }
     }
@@ -590,14 +599,16 @@ struct UpcCandProducer {
     }
   }
 
-  void addTrack(std::vector<BCTracksPair>& v, uint64_t bc, int64_t trkId)
+  // groups the (BC, track ID) pairs by BC, sorted by BC and with the tracks of a BC in input order
+  void groupTracksByBC(std::vector<std::pair<uint64_t, int64_t>>& bcTrackIds, std::vector<BCTracksPair>& v)
   {
-    auto it = std::find_if(v.begin(), v.end(),
-                           [bc](const BCTracksPair& element) { return element.first == bc; });
-    if (it != v.end())
-      it->second.push_back(trkId);
-    else
-      v.emplace_back(std::make_pair(bc, std::vector<int64_t>({trkId})));
+    std::stable_sort(bcTrackIds.begin(), bcTrackIds.end(),
+                     [](const auto& left, const auto& right) { return left.first < right.first; });
+    for (const auto& [bc, trkId] : bcTrackIds) {
+      if (v.empty() || v.back().first != bc)
+        v.emplace_back(bc, std::vector<int64_t>{});
+      v.back().second.push_back(trkId);
+    }
   }
 
   // trackType == 0 -> hasTOF
@@ -611,6 +622,7 @@ struct UpcCandProducer {
                            o2::aod::AmbiguousTracks const& /*ambBarrelTracks*/,
                            std::unordered_map<int64_t, uint64_t>& ambBarrelTrBCs)
   {
+    std::vector<std::pair<uint64_t, int64_t>> bcTrackIds;
     for (const auto& trk : barrelTracks) {
       if (!trk.hasTPC())
         continue;
@@ -636,8 +648,9 @@ struct UpcCandProducer {
       uint64_t bc = trackBC + tint;
       if (nContrib > upcCuts.getMaxNContrib())
         continue;
-      addTrack(bcsMatchedTrIds, bc, trkId);
+      bcTrackIds.emplace_back(bc, trkId);
     }
+    groupTracksByBC(bcTrackIds, bcsMatchedTrIds);
   }
 
   template <typename TBCs>
@@ -649,6 +662,7 @@ struct UpcCandProducer {
                             o2::aod::AmbiguousFwdTracks const& /*ambFwdTracks*/,
                             std::unordered_map<int64_t, uint64_t>& ambFwdTrBCs)
   {
+    std::vector<std::pair<uint64_t, int64_t>> bcTrackIds;
     for (const auto& trk : fwdTracks) {
       if (trk.trackType() != typeFilter)
         continue;
@@ -669,8 +683,9 @@ struct UpcCandProducer {
       uint64_t bc = trackBC + tint;
       if (nContrib > upcCuts.getMaxNContrib())
         continue;
-      addTrack(bcsMatchedTrIds, bc, trkId);
+      bcTrackIds.emplace_back(bc, trkId);
     }
+    groupTracksByBC(bcTrackIds, bcsMatchedTrIds);
   }
 
   int32_t searchTracks(uint64_t midbc, uint64_t range, uint32_t tracksToFind,
@@ -749,16 +764,16 @@ struct UpcCandProducer {
     std::sort(bcsMatchedTrIdsITSTPC.begin(), bcsMatchedTrIdsITSTPC.end(),
               [](const auto& left, const auto& right) { return left.first < right.first; });
 
-    std::map<uint64_t, int32_t> mapGlobalBcWithTOR{};
-    std::map<uint64_t, int32_t> mapGlobalBcWithTVX{};
-    std::map<uint64_t, int32_t> mapGlobalBcWithTSC{};
+    BcIndex mapGlobalBcWithTOR{};
+    BcIndex mapGlobalBcWithTVX{};
+    BcIndex mapGlobalBcWithTSC{};
     for (const auto& ft0 : ft0s) {
       uint64_t globalBC = ft0.bc_as<o2::aod::BCs>().globalBC();
       int32_t globalIndex = ft0.globalIndex();
       if (!(std::abs(ft0.timeA()) > 2.f && std::abs(ft0.timeC()) > 2.f))
-        mapGlobalBcWithTOR[globalBC] = globalIndex;
+        mapGlobalBcWithTOR.add(globalBC, globalIndex);
       if (TESTBIT(ft0.triggerMask(), o2::fit::Triggers::bitVertex)) { // TVX
-        mapGlobalBcWithTVX[globalBC] = globalIndex;
+        mapGlobalBcWithTVX.add(globalBC, globalIndex);
       }
       if (TESTBIT(ft0.triggerMask(), o2::fit::Triggers::bitCen)) { // TVX & TCE
         histRegistry.get<TH1>(HIST("hCountersTrg"))->Fill("TCE", 1);
@@ -766,19 +781,19 @@ struct UpcCandProducer {
       if (TESTBIT(ft0.triggerMask(), o2::fit::Triggers::bitVertex) &&
           (TESTBIT(ft0.triggerMask(), o2::fit::Triggers::bitCen) ||
            TESTBIT(ft0.triggerMask(), o2::fit::Triggers::bitSCen))) { // TVX & (TSC | TCE)
-        mapGlobalBcWithTSC[globalBC] = globalIndex;
+        mapGlobalBcWithTSC.add(globalBC, globalIndex);
       }
     }
 
-    std::map<uint64_t, int32_t> mapGlobalBcWithV0A{};
+    BcIndex mapGlobalBcWithV0A{};
     for (const auto& fv0a : fv0as) {
       if (std::abs(fv0a.time()) > 15.f)
         continue;
       uint64_t globalBC = fv0a.bc_as<o2::aod::BCs>().globalBC();
-      mapGlobalBcWithV0A[globalBC] = fv0a.globalIndex();
+      mapGlobalBcWithV0A.add(globalBC, fv0a.globalIndex());
     }
 
-    std::map<uint64_t, int32_t> mapGlobalBcWithZdc{};
+    BcIndex mapGlobalBcWithZdc{};
     for (const auto& zdc : zdcs) {
       if (std::abs(zdc.timeZNA()) > 2.f && std::abs(zdc.timeZNC()) > 2.f)
         continue;
@@ -787,9 +802,14 @@ struct UpcCandProducer {
       if (!(std::abs(zdc.timeZNC()) > 2.f))
         histRegistry.get<TH1>(HIST("hCountersTrg"))->Fill("ZNC", 1);
       auto globalBC = zdc.bc_as<o2::aod::BCs>().globalBC();
-      mapGlobalBcWithZdc[globalBC] = zdc.globalIndex();
+      mapGlobalBcWithZdc.add(globalBC, zdc.globalIndex());
     }
 
+    mapGlobalBcWithTOR.finalize();
+    mapGlobalBcWithTSC.finalize();
+    mapGlobalBcWithTVX.finalize();
+    mapGlobalBcWithV0A.finalize();
+    mapGlobalBcWithZdc.finalize();
     auto nTORs = mapGlobalBcWithTOR.size();
     auto nTSCs = mapGlobalBcWithTSC.size();
     auto nTVXs = mapGlobalBcWithTVX.size();
@@ -818,11 +838,11 @@ struct UpcCandProducer {
       fitInfo.distClosestBcTVX = 999;
       fitInfo.distClosestBcV0A = 999;
       if (nTORs > 0) {
-        uint64_t closestBcTOR = findClosestBC(globalBC, mapGlobalBcWithTOR);
+        uint64_t closestBcTOR = mapGlobalBcWithTOR.findClosestBC(globalBC);
         fitInfo.distClosestBcTOR = globalBC - static_cast<int64_t>(closestBcTOR);
         if (std::abs(fitInfo.distClosestBcTOR) <= fFilterFT0)
           return false;
-        auto ft0Id = mapGlobalBcWithTOR.at(closestBcTOR);
+        auto ft0Id = mapGlobalBcWithTOR.find(closestBcTOR);
         auto ft0 = ft0s.iteratorAt(ft0Id);
         fitInfo.timeFT0A = ft0.timeA();
         fitInfo.timeFT0C = ft0.timeC();
@@ -834,23 +854,23 @@ struct UpcCandProducer {
           fitInfo.ampFT0C += amp;
       }
       if (nTSCs > 0) {
-        uint64_t closestBcTSC = findClosestBC(globalBC, mapGlobalBcWithTSC);
+        uint64_t closestBcTSC = mapGlobalBcWithTSC.findClosestBC(globalBC);
         fitInfo.distClosestBcTSC = globalBC - static_cast<int64_t>(closestBcTSC);
         if (std::abs(fitInfo.distClosestBcTSC) <= fFilterTSC)
           return false;
       }
       if (nTVXs > 0) {
-        uint64_t closestBcTVX = findClosestBC(globalBC, mapGlobalBcWithTVX);
+        uint64_t closestBcTVX = mapGlobalBcWithTVX.findClosestBC(globalBC);
         fitInfo.distClosestBcTVX = globalBC - static_cast<int64_t>(closestBcTVX);
         if (std::abs(fitInfo.distClosestBcTVX) <= fFilterTVX)
           return false;
       }
       if (nFV0As > 0) {
-        uint64_t closestBcV0A = findClosestBC(globalBC, mapGlobalBcWithV0A);
+        uint64_t closestBcV0A = mapGlobalBcWithV0A.findClosestBC(globalBC);
         fitInfo.distClosestBcV0A = globalBC - static_cast<int64_t>(closestBcV0A);
         if (std::abs(fitInfo.distClosestBcV0A) <= fFilterFV0)
           return false;
-        auto fv0aId = mapGlobalBcWithV0A.at(closestBcV0A);
+        auto fv0aId = mapGlobalBcWithV0A.find(closestBcV0A);
         auto fv0a = fv0as.iteratorAt(fv0aId);
         fitInfo.timeFV0A = fv0a.time();
         const auto& v0Amps = fv0a.amplitude();
@@ -889,9 +909,9 @@ struct UpcCandProducer {
       if (!updateFitInfo(globalBC, fitInfo))
         continue;
       if (nZdcs > 0) {
-        auto itZDC = mapGlobalBcWithZdc.find(globalBC);
-        if (itZDC != mapGlobalBcWithZdc.end()) {
-          const auto& zdc = zdcs.iteratorAt(itZDC->second);
+        auto zdcId = mapGlobalBcWithZdc.find(globalBC);
+        if (zdcId >= 0) {
+          const auto& zdc = zdcs.iteratorAt(zdcId);
           float timeZNA = zdc.timeZNA();
           float timeZNC = zdc.timeZNC();
           float eComZNA = zdc.energyCommonZNA();
@@ -954,9 +974,9 @@ struct UpcCandProducer {
       if (!updateFitInfo(globalBC, fitInfo))
         continue;
       if (nZdcs > 0) {
-        auto itZDC = mapGlobalBcWithZdc.find(globalBC);
-        if (itZDC != mapGlobalBcWithZdc.end()) {
-          const auto& zdc = zdcs.iteratorAt(itZDC->second);
+        auto zdcId = mapGlobalBcWithZdc.find(globalBC);
+        if (zdcId >= 0) {
+          const auto& zdc = zdcs.iteratorAt(zdcId);
           float timeZNA = zdc.timeZNA();
           float timeZNC = zdc.timeZNC();
           float eComZNA = zdc.energyCommonZNA();
@@ -1056,9 +1076,9 @@ struct UpcCandProducer {
     std::vector<BCTracksPair> bcsMatchedTrIdsTOFTagged(nBCsWithMID);
     for (const auto& pair : bcsMatchedTrIdsTOF) {
       uint64_t bc = pair.first;
-      auto it = std::find_if(bcsMatchedTrIdsMID.begin(), bcsMatchedTrIdsMID.end(),
-                             [bc](const auto& item) { return item.first == bc; });
-      if (it != bcsMatchedTrIdsMID.end()) {
+      auto it = std::lower_bound(bcsMatchedTrIdsMID.begin(), bcsMatchedTrIdsMID.end(), bc,
+                                 [](const auto& item, uint64_t value) { return item.first < value; });
+      if (it != bcsMatchedTrIdsMID.end() && it->first == bc) {
         uint32_t ibc = it - bcsMatchedTrIdsMID.begin();
         bcsMatchedTrIdsTOFTagged[ibc].second = pair.second;
       }
@@ -1173,17 +1193,17 @@ struct UpcCandProducer {
 
   template <typename T>
   void fillAmplitudes(const T& t,
-                      const std::map<uint64_t, int32_t>& mapBCs,
+                      const BcIndex& mapBCs,
                       std::vector<float>& amps,
                       std::vector<int8_t>& relBCs,
                       int64_t gbc)
   {
     auto s = gbc - fBCWindowFITAmps;
     auto e = gbc + (fBCWindowFITAmps - 1);
-    auto it = mapBCs.lower_bound(s);
-    while (it->first <= e && it != mapBCs.end()) {
-      int i = it->first - s;
-      auto id = it->second;
+    auto [first, last] = mapBCs.getRange(s > 0 ? s : 0, e);
+    for (auto pos = first; pos < last; ++pos) {
+      int i = mapBCs.getGlobalBC(pos) - s;
+      auto id = mapBCs.getIndex(pos);
       const auto& row = t.iteratorAt(id);
       float totalAmp = 0.f;
       if constexpr (std::is_same_v<T, o2::aod::FT0s>) {
@@ -1198,7 +1218,6 @@ struct UpcCandProducer {
         amps.push_back(totalAmp);
         relBCs.push_back(gbc - (i + s));
       }
-      ++it;
     }
   }
 
@@ -1237,7 +1256,7 @@ struct UpcCandProducer {
     std::sort(bcsMatchedTrIdsMCH.begin(), bcsMatchedTrIdsMCH.end(),
               [](const auto& left, const auto& right) { return left.first < right.first; });
 
-    std::map<uint64_t, int32_t> mapGlobalBcWithT0A{};
+    BcIndex mapGlobalBcWithT0A{};
     for (const auto& ft0 : ft0s) {
       if (!TESTBIT(ft0.triggerMask(), o2::fit::Triggers::bitVertex))
         continue;
@@ -1247,20 +1266,20 @@ struct UpcCandProducer {
       if (std::abs(ft0.timeA()) > 2.f)
         continue;
       uint64_t globalBC = ft0.bc_as<o2::aod::BCs>().globalBC();
-      mapGlobalBcWithT0A[globalBC] = ft0.globalIndex();
+      mapGlobalBcWithT0A.add(globalBC, ft0.globalIndex());
     }
 
-    std::map<uint64_t, int32_t> mapGlobalBcWithV0A{};
+    BcIndex mapGlobalBcWithV0A{};
     for (const auto& fv0a : fv0as) {
       if (!TESTBIT(fv0a.triggerMask(), o2::fit::Triggers::bitA))
         continue;
       if (std::abs(fv0a.time()) > 15.f)
         continue;
       uint64_t globalBC = fv0a.bc_as<o2::aod::BCs>().globalBC();
-      mapGlobalBcWithV0A[globalBC] = fv0a.globalIndex();
+      mapGlobalBcWithV0A.add(globalBC, fv0a.globalIndex());
     }
 
-    std::map<uint64_t, int32_t> mapGlobalBcWithZdc{};
+    BcIndex mapGlobalBcWithZdc{};
     for (const auto& zdc : zdcs) {
       if (std::abs(zdc.timeZNA()) > 2.f && std::abs(zdc.timeZNC()) > 2.f)
         continue;
@@ -1269,9 +1288,12 @@ struct UpcCandProducer {
       if (!(std::abs(zdc.timeZNC()) > 2.f))
         histRegistry.get<TH1>(HIST("hCountersTrg"))->Fill("ZNC", 1);
       auto globalBC = zdc.bc_as<o2::aod::BCs>().globalBC();
-      mapGlobalBcWithZdc[globalBC] = zdc.globalIndex();
+      mapGlobalBcWithZdc.add(globalBC, zdc.globalIndex());
     }
 
+    mapGlobalBcWithT0A.finalize();
+    mapGlobalBcWithV0A.finalize();
+    mapGlobalBcWithZdc.finalize();
     auto nFT0s = mapGlobalBcWithT0A.size();
     auto nFV0As = mapGlobalBcWithV0A.size();
     auto nZdcs = mapGlobalBcWithZdc.size();
@@ -1325,12 +1347,12 @@ struct UpcCandProducer {
       std::vector<int8_t> relBCsT0A{};
       std::vector<int8_t> relBCsV0A{};
       if (nFT0s > 0) {
-        uint64_t closestBcT0A = findClosestBC(globalBC, mapGlobalBcWithT0A);
+        uint64_t closestBcT0A = mapGlobalBcWithT0A.findClosestBC(globalBC);
         int64_t distClosestBcT0A = globalBC - static_cast<int64_t>(closestBcT0A);
         if (std::abs(distClosestBcT0A) <= fFilterFT0)
           continue;
         fitInfo.distClosestBcT0A = distClosestBcT0A;
-        auto ft0Id = mapGlobalBcWithT0A.at(closestBcT0A);
+        auto ft0Id = mapGlobalBcWithT0A.find(closestBcT0A);
         auto ft0 = ft0s.iteratorAt(ft0Id);
         fitInfo.timeFT0A = ft0.timeA();
         fitInfo.timeFT0C = ft0.timeC();
@@ -1341,12 +1363,12 @@ struct UpcCandProducer {
         fillAmplitudes(ft0s, mapGlobalBcWithT0A, amplitudesT0A, relBCsT0A, globalBC);
       }
       if (nFV0As > 0) {
-        uint64_t closestBcV0A = findClosestBC(globalBC, mapGlobalBcWithV0A);
+        uint64_t closestBcV0A = mapGlobalBcWithV0A.findClosestBC(globalBC);
         int64_t distClosestBcV0A = globalBC - static_cast<int64_t>(closestBcV0A);
         if (std::abs(distClosestBcV0A) <= fFilterFV0)
           continue;
         fitInfo.distClosestBcV0A = distClosestBcV0A;
-        auto fv0aId = mapGlobalBcWithV0A.at(closestBcV0A);
+        auto fv0aId = mapGlobalBcWithV0A.find(closestBcV0A);
         auto fv0a = fv0as.iteratorAt(fv0aId);
         fitInfo.timeFV0A = fv0a.time();
         const auto& v0Amps = fv0a.amplitude();
@@ -1354,9 +1376,9 @@ struct UpcCandProducer {
         fillAmplitudes(fv0as, mapGlobalBcWithV0A, amplitudesV0A, relBCsV0A, globalBC);
       }
       if (nZdcs > 0) {
-        auto itZDC = mapGlobalBcWithZdc.find(globalBC);
-        if (itZDC != mapGlobalBcWithZdc.end()) {
-          const auto& zdc = zdcs.iteratorAt(itZDC->second);
+        auto zdcId = mapGlobalBcWithZdc.find(globalBC);
+        if (zdcId >= 0) {
+          const auto& zdc = zdcs.iteratorAt(zdcId);
           float timeZNA = zdc.timeZNA();
           float timeZNC = zdc.timeZNC();
           float eComZNA = zdc.energyCommonZNA();
@@ -1445,7 +1467,7 @@ struct UpcCandProducer {
     std::sort(bcsMatchedTrIdsGlobal.begin(), bcsMatchedTrIdsGlobal.end(),
               [](const auto& left, const auto& right) { return left.first < right.first; });
 
-    std::map<uint64_t, int32_t> mapGlobalBcWithT0A{};
+    BcIndex mapGlobalBcWithT0A{};
     for (const auto& ft0 : ft0s) {
       if (!TESTBIT(ft0.triggerMask(), o2::fit::Triggers::bitVertex))
         continue;
@@ -1455,20 +1477,20 @@ struct UpcCandProducer {
       if (std::abs(ft0.timeA()) > 2.f)
         continue;
       uint64_t globalBC = ft0.bc_as<o2::aod::BCs>().globalBC();
-      mapGlobalBcWithT0A[globalBC] = ft0.globalIndex();
+      mapGlobalBcWithT0A.add(globalBC, ft0.globalIndex());
     }
 
-    std::map<uint64_t, int32_t> mapGlobalBcWithV0A{};
+    BcIndex mapGlobalBcWithV0A{};
     for (const auto& fv0a : fv0as) {
       if (!TESTBIT(fv0a.triggerMask(), o2::fit::Triggers::bitA))
         continue;
       if (std::abs(fv0a.time()) > 15.f)
         continue;
       uint64_t globalBC = fv0a.bc_as<o2::aod::BCs>().globalBC();
-      mapGlobalBcWithV0A[globalBC] = fv0a.globalIndex();
+      mapGlobalBcWithV0A.add(globalBC, fv0a.globalIndex());
     }
 
-    std::map<uint64_t, int32_t> mapGlobalBcWithZdc{};
+    BcIndex mapGlobalBcWithZdc{};
     for (const auto& zdc : zdcs) {
       if (std::abs(zdc.timeZNA()) > 2.f && std::abs(zdc.timeZNC()) > 2.f)
         continue;
@@ -1477,9 +1499,12 @@ struct UpcCandProducer {
       if (!(std::abs(zdc.timeZNC()) > 2.f))
         histRegistry.get<TH1>(HIST("hCountersTrg"))->Fill("ZNC", 1);
       auto globalBC = zdc.bc_as<o2::aod::BCs>().globalBC();
-      mapGlobalBcWithZdc[globalBC] = zdc.globalIndex();
+      mapGlobalBcWithZdc.add(globalBC, zdc.globalIndex());
     }
 
+    mapGlobalBcWithT0A.finalize();
+    mapGlobalBcWithV0A.finalize();
+    mapGlobalBcWithZdc.finalize();
     auto nFT0s = mapGlobalBcWithT0A.size();
     auto nFV0As = mapGlobalBcWithV0A.size();
     auto nZdcs = mapGlobalBcWithZdc.size();
@@ -1520,12 +1545,12 @@ struct UpcCandProducer {
       std::vector<int8_t> relBCsT0A{};
       std::vector<int8_t> relBCsV0A{};
       if (nFT0s > 0) {
-        uint64_t closestBcT0A = findClosestBC(globalBC, mapGlobalBcWithT0A);
+        uint64_t closestBcT0A = mapGlobalBcWithT0A.findClosestBC(globalBC);
         int64_t distClosestBcT0A = globalBC - static_cast<int64_t>(closestBcT0A);
         if (std::abs(distClosestBcT0A) <= fFilterFT0)
           continue;
         fitInfo.distClosestBcT0A = distClosestBcT0A;
-        auto ft0Id = mapGlobalBcWithT0A.at(closestBcT0A);
+        auto ft0Id = mapGlobalBcWithT0A.find(closestBcT0A);
         auto ft0 = ft0s.iteratorAt(ft0Id);
         fitInfo.timeFT0A = ft0.timeA();
         fitInfo.timeFT0C = ft0.timeC();
@@ -1536,12 +1561,12 @@ struct UpcCandProducer {
         fillAmplitudes(ft0s, mapGlobalBcWithT0A, amplitudesT0A, relBCsT0A, globalBC);
       }
       if (nFV0As > 0) {
-        uint64_t closestBcV0A = findClosestBC(globalBC, mapGlobalBcWithV0A);
+        uint64_t closestBcV0A = mapGlobalBcWithV0A.findClosestBC(globalBC);
         int64_t distClosestBcV0A = globalBC - static_cast<int64_t>(closestBcV0A);
         if (std::abs(distClosestBcV0A) <= fFilterFV0)
           continue;
         fitInfo.distClosestBcV0A = distClosestBcV0A;
-        auto fv0aId = mapGlobalBcWithV0A.at(closestBcV0A);
+        auto fv0aId = mapGlobalBcWithV0A.find(closestBcV0A);
         auto fv0a = fv0as.iteratorAt(fv0aId);
         fitInfo.timeFV0A = fv0a.time();
         const auto& v0Amps = fv0a.amplitude();
@@ -1549,9 +1574,9 @@ struct UpcCandProducer {
         fillAmplitudes(fv0as, mapGlobalBcWithV0A, amplitudesV0A, relBCsV0A, globalBC);
       }
       if (nZdcs > 0) {
-        auto itZDC = mapGlobalBcWithZdc.find(globalBC);
-        if (itZDC != mapGlobalBcWithZdc.end()) {
-          const auto& zdc = zdcs.iteratorAt(itZDC->second);
+        auto zdcId = mapGlobalBcWithZdc.find(globalBC);
+        if (zdcId >= 0) {
+          const auto& zdc = zdcs.iteratorAt(zdcId);
           float timeZNA = zdc.timeZNA();
           float timeZNC = zdc.timeZNC();
           float eComZNA = zdc.energyCommonZNA();
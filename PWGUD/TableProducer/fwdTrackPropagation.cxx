@@ -47,6 +47,7 @@ struct FwdTrackPropagation {
   o2::globaltracking::MatchGlobalFwd fMatching;
 
   int fRun = 0;
+  double fBzAtMFTCenter = 0; // field at the centre of the MFT for the current run, used for the MFT-MCH tracks
 
   void init(InitContext&)
   {
@@ -80,12 +81,9 @@ struct FwdTrackPropagation {
       propmuon.setZ(proptrack.getZ());
       propmuon.setCovariances(proptrack.getCovariances());
     } else if (static_cast<int>(muon.trackType()) < 2) {
-      double centerMFT[3] = {0, 0, -61.4};
-      o2::field::MagneticField* field = static_cast<o2::field::MagneticField*>(TGeoGlobalMagField::Instance()->GetField());
-      auto Bz = field->getBz(centerMFT); // Get field at centre of MFT
       auto geoMan = o2::base::GeometryManager::meanMaterialBudget(muon.x(), muon.y(), muon.z(), vtx[0], vtx[1], vtx[2]);
       auto x2x0 = static_cast<float>(geoMan.meanX2X0);
-      fwdtrack.propagateToVtxhelixWithMCS(vtx[2], {vtx[0], vtx[1]}, {vtxCov[0], vtxCov[1]}, Bz, x2x0);
+      fwdtrack.propagateToVtxhelixWithMCS(vtx[2], {vtx[0], vtx[1]}, {vtxCov[0], vtxCov[1]}, fBzAtMFTCenter, x2x0);
       propmuon.setParameters(fwdtrack.getParameters());
       propmuon.setZ(fwdtrack.getZ());
       propmuon.setCovariances(fwdtrack.getCovariances());
@@ -107,6 +105,9 @@ struct FwdTrackPropagation {
       if (!o2::base::GeometryManager::isGeometryLoaded())
         fCCDB->get<TGeoManager>("GLO/Config/GeometryAligned");
       o2::mch::TrackExtrap::setField();
+      double centerMFT[3] = {0, 0, -61.4};
+      o2::field::MagneticField* field = static_cast<o2::field::MagneticField*>(TGeoGlobalMagField::Instance()->GetField());
+      fBzAtMFTCenter = field->getBz(centerMFT);
     }
 
     propFwdTracks.reserve(fwdTracks.size());
@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+
+# Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+# See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+# All rights not expressly granted are reserved.
+#
+# This software is distributed under the terms of the GNU General Public
+# License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+#
+# In applying this license CERN does not waive the privileges and immunities
+# granted to it by virtue of its status as an Intergovernmental Organization
+# or submit itself to any jurisdiction.
+
+"""!
+@brief  Summarise the throughput and memory of the devices of a workflow run.
+
+The workflow has to be run with the resources monitoring of DPL enabled,
+e.g. `o2-analysis-... --aod-file AO2D.root --resources-monitoring 2 -b`,
+which makes the driver dump the metrics of all devices in performanceMetrics.json.
+For each device, this script reports
+- the wall-clock time between the first and the last metric point,
+- the peak resident set size,
+- the number of events per second, given the number of events of the input,
+- the number of rows per second, if the device filled the histograms of Common/Core/ProcessTimers.h
+  (requires PyROOT and the AnalysisResults.root of the run).
+The summary is printed and optionally written in a JSON file, so that runs on the same input can be compared.
+
+@date   2026-10-14
+"""
+
+import argparse
+import json
+import sys
+
+
+def eprint(*args, **kwargs):
+    """Print to stderr."""
+    print(*args, file=sys.stderr, **kwargs)
+
+
+def msg_fatal(message: str):
+    """Print an error message and exit."""
+    eprint("\x1b[1;31mError: %s\x1b[0m" % message)
+    sys.exit(1)
+
+
+def msg_warn(message: str):
+    """Print a warning message."""
+    eprint("\x1b[1;36mWarning:\x1b[0m %s" % message)
+
+
+def load_json(path: str):
+    """Load a JSON file."""
+    try:
+        with open(path, "r") as file_json:
+            return json.load(file_json)
+    except (IOError, json.JSONDecodeError) as error:
+        msg_fatal(f"Failed to load {path}: {error}")
+
+
+def get_points(metrics_device: dict, metric: str):
+    """Return the (timestamp, value) points of a metric of a device."""
+    points = []
+    for point in metrics_device.get(metric, []):
+        try:
+            points.append((float(point["timestamp"]), float(point["value"])))
+        except (KeyError, TypeError, ValueError):
+            continue
+    return points
+
+
+def get_rows_processed(path_results: str):
+    """Return the number of rows of all ProcessTimers sections, per task directory of AnalysisResults.root."""
+    try:
+        from ROOT import TFile  # pylint: disable=import-outside-toplevel
+    except ImportError:
+        msg_warn("PyROOT is not available, the rows per second are not reported.")
+        return {}
+    file_results = TFile.Open(path_results)
+    if not file_results or file_results.IsZombie():
+        msg_fatal(f"Failed to open {path_results}")
+    rows = {}
+    for key in file_results.GetListOfKeys():
+        hist = file_results.Get(f"{key.GetName()}/ProcessTimers/hRows")
+        if hist:
+            rows[key.GetName()] = {
+                hist.GetXaxis().GetBinLabel(i): hist.GetBinContent(i) for i in range(1, hist.GetNbinsX() + 1)
+            }
+    file_results.Close()
+    return rows
+
+
+def summarise(metrics: dict, n_events: int, metric_rss: str, rows: dict):
+    """Return the summary of each device."""
+    summary = {}
+    for device, metrics_device in sorted(metrics.items()):
+        if not isinstance(metrics_device, dict):
+            continue
+        timestamps = [t for points in (get_points(metrics_device, m) for m in metrics_device) for t, _ in points]
+        if not timestamps:
+            continue
+        time_s = (max(timestamps) - min(timestamps)) / 1000.0  # timestamps are in ms
+        points_rss = get_points(metrics_device, metric_rss)
+        summary_device = {
+            "wall_time_s": time_s,
+            "peak_rss_kb": max(v for _, v in points_rss) if points_rss else None,
+        }
+        if n_events > 0 and time_s > 0:
+            summary_device["events_per_s"] = n_events / time_s
+        # DPL device names are the task names, the directories of AnalysisResults.root too
+        if device in rows and time_s > 0:
+            summary_device["rows_per_s"] = {section: n / time_s for section, n in rows[device].items()}
+        summary[device] = summary_device
+    return summary
+
+
+def main():
+    """Main function"""
+    parser = argparse.ArgumentParser(description="Summarise the throughput and memory of the devices of a workflow run.")
+    parser.add_argument(
+        "-m", dest="metrics", type=str, default="performanceMetrics.json", help="metrics dumped by the DPL driver"
+    )
+    parser.add_argument("-n", dest="events", type=int, default=0, help="number of events of the input")
+    parser.add_argument("-r", dest="results", type=str, help="AnalysisResults.root with the ProcessTimers histograms")
+    parser.add_argument(
+        "--rss-metric", dest="metric_rss", type=str, default="resident-set-size", help="name of the RSS metric"
+    )
+    parser.add_argument("-o", dest="output", type=str, help="output JSON file")
+    args = parser.parse_args()
+
+    metrics = load_json(args.metrics)
+    rows = get_rows_processed(args.results) if args.results else {}
+    summary = summarise(metrics, args.events, args.metric_rss, rows)
+    if not summary:
+        msg_fatal(f"No device metrics found in {args.metrics}")
+
+    for device, summary_device in summary.items():
+        rss = summary_device["peak_rss_kb"]
+        line = f"{device}: {summary_device['wall_time_s']:.1f} s"
+        line += f", peak RSS {rss / 1024:.0f} MB" if rss is not None else ", peak RSS n/a"
+        if "events_per_s" in summary_device:
+            line += f", {summary_device['events_per_s']:.1f} events/s"
+        print(line)
+        for section, rate in summary_device.get("rows_per_s", {}).items():
+            print(f"  {section}: {rate:.0f} rows/s")
+
+    if args.output:
+        try:
+            with open(args.output, "w") as file_out:
+                json.dump(summary, file_out, indent=2)
+        except IOError:
+            msg_fatal(f"Failed to open file {args.output}")
+
+
+if __name__ == "__main__":
+    main()
@@ -21,6 +21,9 @@
 #define HomogeneousField
 #endif
 
+#include <cstdint>
+#include <vector>
+
 #include <TDatabasePDG.h> // FIXME
 
 #include "KFParticle.h"
@@ -105,11 +108,48 @@ KFPTrack createKFPTrackFromTrackParCov(const o2::track::TrackParametrizationWith
   return kfpTrack;
 }
 
+/// @brief Pool of the KFPTracks of the tracks of a collision, converted once and reused in all the track combinations
+class KFPTrackPool
+{
+ public:
+  /// @brief Converts the tracks of a collision, grouped and ordered by index as given to the process function
+  /// @tparam T
+  /// @param tracks Tracks from aod::Tracks, aod::TracksExtra, aod::TracksCov
+  template <typename T>
+  void fill(const T& tracks)
+  {
+    mKFPTracks.clear();
+    if (tracks.size() == 0) {
+      return;
+    }
+    mFirstIndex = tracks.begin().globalIndex();
+    for (const auto& track : tracks) {
+      // the tracks rejected by a filter leave default-constructed gaps, never read back
+      mKFPTracks.resize(track.globalIndex() - mFirstIndex + 1);
+      mKFPTracks.back() = createKFPTrackFromTrack(track);
+    }
+  }
+
+  /// @brief KFPTrack of a track of the collision the pool was filled with
+  /// @tparam T
+  /// @param track Track of the collision
+  /// @return KFPTrack
+  template <typename T>
+  const KFPTrack& get(const T& track) const
+  {
+    return mKFPTracks[track.globalIndex() - mFirstIndex];
+  }
+
+ private:
+  int64_t mFirstIndex{0};           // index of the first track of the collision
+  std::vector<KFPTrack> mKFPTracks; // KFPTracks indexed by track index - mFirstIndex, the capacity is kept between collisions
+};
+
 /// @brief Cosine of pointing angle from KFParticles
 /// @param kfp KFParticle
 /// @param PV KFParticle primary vertex
 /// @return cpa
-float cpaFromKF(KFParticle kfp, KFParticle PV)
+float cpaFromKF(const KFParticle& kfp, const KFParticle& PV)
 {
   float xVtxP, yVtxP, zVtxP, xVtxS, yVtxS, zVtxS, px, py, pz = 0.;
 
@@ -133,7 +173,7 @@ float cpaFromKF(KFParticle kfp, KFParticle PV)
 /// @param kfp KFParticle
 /// @param PV KFParticle primary vertex
 /// @return cpa in xy
-float cpaXYFromKF(KFParticle kfp, KFParticle PV)
+float cpaXYFromKF(const KFParticle& kfp, const KFParticle& PV)
 {
   float xVtxP, yVtxP, xVtxS, yVtxS, px, py = 0.;
 
@@ -159,7 +199,7 @@ float cpaXYFromKF(KFParticle kfp, KFParticle PV)
 /// @param kfpprong0 KFParticle Prong 0
 /// @param kfpprong1 KFParticele Prong 1
 /// @return cos theta star
-float cosThetaStarFromKF(int ip, int pdgvtx, int pdgprong0, int pdgprong1, KFParticle kfpprong0, KFParticle kfpprong1)
+float cosThetaStarFromKF(int ip, int pdgvtx, int pdgprong0, int pdgprong1, const KFParticle& kfpprong0, const KFParticle& kfpprong1)
 {
   float px0, py0, pz0, px1, py1, pz1 = 0.;
 
@@ -186,7 +226,7 @@ float cosThetaStarFromKF(int ip, int pdgvtx, int pdgprong0, int pdgprong1, KFPar
 /// @param kfpParticle KFParticle
 /// @param Vertex KFParticle vertex
 /// @return impact parameter
-float impParXYFromKF(KFParticle kfpParticle, KFParticle Vertex)
+float impParXYFromKF(const KFParticle& kfpParticle, const KFParticle& Vertex)
 {
   float xVtxP, yVtxP, zVtxP, xVtxS, yVtxS, zVtxS, px, py, pz = 0.;
 
@@ -210,7 +250,7 @@ float impParXYFromKF(KFParticle kfpParticle, KFParticle Vertex)
 /// @param kfpParticle KFParticle
 /// @param PV KFParticle primary vertex
 /// @return l/delta l
-float ldlFromKF(KFParticle kfpParticle, KFParticle PV)
+float ldlFromKF(const KFParticle& kfpParticle, const KFParticle& PV)
 {
   float dx_particle = PV.GetX() - kfpParticle.GetX();
   float dy_particle = PV.GetY() - kfpParticle.GetY();
@@ -229,7 +269,7 @@ float ldlFromKF(KFParticle kfpParticle, KFParticle PV)
 /// @param kfpParticle KFParticle
 /// @param PV KFParticle primary vertex
 /// @return l/delta l in xy plane
-float ldlXYFromKF(KFParticle kfpParticle, KFParticle PV)
+float ldlXYFromKF(const KFParticle& kfpParticle, const KFParticle& PV)
 {
   float dx_particle = PV.GetX() - kfpParticle.GetX();
   float dy_particle = PV.GetY() - kfpParticle.GetY();
@@ -76,6 +76,7 @@ struct qaKFParticleLc {
   int runNumber;
   double magneticField = 0.;
   KFParticle KFPion, KFKaon, KFProton, KFLc, KFLc_PV;
+  KFPTrackPool kfpTrackPool; // KFPTracks of the current collision
 
   /// option to select good events
   Configurable<bool> eventSelection{"eventSelection", true, "select good events"}; // currently only sel8 is defined for run3
@@ -247,9 +248,9 @@ struct qaKFParticleLc {
   template <typename T, typename T2>
   bool ReconstructLc(const T& trackKaon, const T& trackPion, const T& trackProton, const T2& KFPV)
   {
-    KFPTrack kfpTrackKa = createKFPTrackFromTrack(trackKaon);
-    KFPTrack kfpTrackPi = createKFPTrackFromTrack(trackPion);
-    KFPTrack kfpTrackPr = createKFPTrackFromTrack(trackProton);
+    const KFPTrack& kfpTrackKa = kfpTrackPool.get(trackKaon);
+    const KFPTrack& kfpTrackPi = kfpTrackPool.get(trackPion);
+    const KFPTrack& kfpTrackPr = kfpTrackPool.get(trackProton);
     KFParticle KFKa(kfpTrackKa, 321);
     KFKaon = KFKa;
     KFParticle KFPi(kfpTrackPi, 211);
@@ -480,6 +481,7 @@ struct qaKFParticleLc {
     /// set KF primary vertex
     KFPVertex kfpVertex = createKFPVertexFromCollision(collision);
     KFParticle KFPV(kfpVertex);
+    kfpTrackPool.fill(tracks);
 
     for (auto& [track1, track2, track3] : combinations(soa::CombinationsStrictlyUpperIndexPolicy(tracks, tracks, tracks))) {
 
@@ -0,0 +1,115 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file     FeatureBuffer.h
+///
+/// \brief    Columnar buffer of the input features of a batch of candidates, for batched ONNX inference
+///           The features are stored column by column and gathered into the row-major matrix of
+///           OnnxModel::evalModelBatch only at evaluation, possibly for a subset of the columns.
+///           The buffers keep their capacity between batches, e.g. between dataframes.
+///
+
+#ifndef TOOLS_ML_FEATUREBUFFER_H_
+#define TOOLS_ML_FEATUREBUFFER_H_
+
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+#include "Framework/Logger.h"
+#include "Tools/ML/model.h"
+
+namespace o2
+{
+
+namespace ml
+{
+
+class FeatureBuffer
+{
+ public:
+  /// Empties the buffer, keeping the allocated memory
+  /// \param nFeatures is the number of feature columns
+  void reset(std::size_t nFeatures)
+  {
+    mColumns.resize(nFeatures);
+    for (auto& column : mColumns) {
+      column.clear();
+    }
+    mNCandidates = 0;
+  }
+
+  std::size_t getNFeatures() const { return mColumns.size(); }
+  std::size_t getNCandidates() const { return mNCandidates; }
+
+  /// Appends the features of a candidate, one value per column
+  void addCandidate(std::initializer_list<float> features)
+  {
+    if (features.size() != mColumns.size()) {
+      LOG(fatal) << "Number of features (" << features.size() << ") different from the number of columns of the buffer (" << mColumns.size() << ")!";
+    }
+    std::size_t iColumn = 0;
+    for (float feature : features) {
+      mColumns[iColumn++].push_back(feature);
+    }
+    mNCandidates++;
+  }
+
+  /// Feature column
+  const std::vector<float>& getColumn(std::size_t iColumn) const { return mColumns[iColumn]; }
+
+  /// Scores all the candidates of the buffer in one inference call
+  /// \param model is the model to be evaluated
+  /// \param scores is filled with the row-major nCandidates x nOutputs scores of the last output tensor
+  /// \param columnMask selects the columns given to the model (value >= 1), all the columns if empty
+  /// \return number of scores per candidate, 0 if the inference failed
+  std::size_t evaluate(OnnxModel& model, std::vector<float>& scores, const std::vector<int>& columnMask = {})
+  {
+    scores.clear();
+    if (mNCandidates == 0) {
+      return 0;
+    }
+    // gather the selected columns in the row-major matrix of the model
+    mSelectedColumns.clear();
+    for (std::size_t iColumn = 0; iColumn < mColumns.size(); iColumn++) {
+      if (columnMask.empty() || (iColumn < columnMask.size() && columnMask[iColumn] >= 1)) {
+        mSelectedColumns.push_back(iColumn);
+      }
+    }
+    const std::size_t nSelected = mSelectedColumns.size();
+    mRowMajor.resize(mNCandidates * nSelected);
+    for (std::size_t iSelected = 0; iSelected < nSelected; iSelected++) {
+      const auto& column = mColumns[mSelectedColumns[iSelected]];
+      for (std::size_t iCandidate = 0; iCandidate < mNCandidates; iCandidate++) {
+        mRowMajor[iCandidate * nSelected + iSelected] = column[iCandidate];
+      }
+    }
+    const int64_t nRows = model.evalModelBatch(mRowMajor, scores);
+    if (nRows != static_cast<int64_t>(mNCandidates) || scores.size() % mNCandidates != 0) {
+      scores.clear();
+      return 0;
+    }
+    return scores.size() / mNCandidates;
+  }
+
+ private:
+  std::vector<std::vector<float>> mColumns;  // features of the candidates, one vector per feature
+  std::vector<std::size_t> mSelectedColumns; // columns given to the model in the last evaluation
+  std::vector<float> mRowMajor;              // row-major input matrix of the last evaluation
+  std::size_t mNCandidates = 0;              // number of candidates in the buffer
+};
+
+} // namespace ml
+
+} // namespace o2
+
+#endif // TOOLS_ML_FEATUREBUFFER_H_
@@ -23,12 +23,18 @@
 #include <onnxruntime_cxx_api.h>
 #endif
 
+#include <algorithm>
+#include <cmath>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include <TH2.h>
+
 #include "CCDB/CcdbApi.h"
 #include "Framework/Array2D.h"
+#include "Framework/HistogramRegistry.h"
 
 #include "Tools/ML/model.h"
 
@@ -46,6 +52,23 @@ enum CutDirection {
 
 namespace analysis
 {
+/// Compile-time list of feature getters for the ML input
+/// \tparam Getters are default-constructible callables returning one feature of a candidate, e.g. decltype([](const auto& cand) { return cand.chi2PCA(); })
+template <typename... Getters>
+struct FeatureGather {
+  static constexpr std::size_t NFeatures = sizeof...(Getters);
+
+  /// Writes the features of a candidate into a buffer
+  /// \param candidate is the candidate (e.g. a table row)
+  /// \param buffer is a pointer to the NFeatures elements to be filled
+  template <typename T, typename TypeBuffer>
+  static void fill(T const& candidate, TypeBuffer* buffer)
+  {
+    std::size_t iFeature{0};
+    ((buffer[iFeature++] = static_cast<TypeBuffer>(Getters{}(candidate))), ...);
+  }
+};
+
 // TypeOutputScore is the type of the output score from o2::ml::OnnxModel (float by default)
 template <typename TypeOutputScore = float>
 class MlResponse
@@ -74,6 +97,32 @@ class MlResponse
     mNModels = binsLimits.size() - 1;
     mModels = std::vector<o2::ml::OnnxModel>(mNModels);
     mPaths = std::vector<std::string>(mNModels);
+    buildBinLut();
+  }
+
+  /// Select the numerical precision variant of the models
+  /// \param precision is the model precision: fp32 (default), fp16 or int8
+  /// \note Must be called before setting the model paths. Reduced-precision variants are expected next to the nominal models,
+  ///       with the precision appended to the file name (model_fp16.onnx) and as a subdirectory of the CCDB path (path/fp16)
+  void setModelPrecision(const std::string& precision)
+  {
+    if (precision != "fp32" && precision != "fp16" && precision != "int8") {
+      LOG(fatal) << "Model precision " << precision << " not supported! Available options: fp32, fp16, int8";
+    }
+    mPrecision = precision;
+  }
+
+  /// Validation of the reduced-precision models against the nominal (fp32) ones
+  /// \param registry is the histogram registry where the residual histogram is added
+  /// \param downsampling is the fraction (1/downsampling) of evaluations scored with both precisions
+  /// \note Must be called after configure and before setting the model paths
+  void enablePrecisionValidation(o2::framework::HistogramRegistry* registry, int downsampling = 100)
+  {
+    mValidatePrecision = true;
+    mReferenceModels = std::vector<o2::ml::OnnxModel>(mNModels);
+    mReferencePaths = std::vector<std::string>(mNModels);
+    mValidationDownsampling = std::max(downsampling, 1);
+    mHistPrecisionResidual = registry->add<TH2>("hMlPrecisionResidual", "ML score residual (reduced precision - fp32);class;score residual", o2::framework::kTH2F, {{mNClasses, -0.5, mNClasses - 0.5}, {200, -0.1, 0.1}});
   }
 
   /// Set model paths to CCDB
@@ -102,11 +151,20 @@ class MlResponse
 
     for (auto iFile{0}; iFile < mNModels; ++iFile) {
       std::map<std::string, std::string> metadata;
-      bool retrieveSuccess = ccdbApi.retrieveBlob(pathsCCDB[iFile], ".", metadata, timestampCCDB, false, onnxFiles[iFile]);
+      const std::string pathCCDB = getPrecisionVariant(pathsCCDB[iFile], true);
+      const std::string onnxFile = getPrecisionVariant(onnxFiles[iFile], false);
+      bool retrieveSuccess = ccdbApi.retrieveBlob(pathCCDB, ".", metadata, timestampCCDB, false, onnxFile);
       if (retrieveSuccess) {
-        mPaths[iFile] = onnxFiles[iFile];
+        mPaths[iFile] = onnxFile;
       } else {
-        LOG(fatal) << "Error encountered while accessing the ML model from " << pathsCCDB[iFile] << "! Maybe the ML model doesn't exist yet for this run number or timestamp?";
+        LOG(fatal) << "Error encountered while accessing the ML model from " << pathCCDB << "! Maybe the ML model doesn't exist yet for this run number or timestamp?";
+      }
+      if (mValidatePrecision && mPrecision != "fp32") {
+        if (ccdbApi.retrieveBlob(pathsCCDB[iFile], ".", metadata, timestampCCDB, false, onnxFiles[iFile])) {
+          mReferencePaths[iFile] = onnxFiles[iFile];
+        } else {
+          LOG(fatal) << "Error encountered while accessing the reference ML model from " << pathsCCDB[iFile] << "!";
+        }
       }
     }
   }
@@ -118,19 +176,52 @@ class MlResponse
     if (onnxFiles.size() != mNModels) {
       LOG(fatal) << "Number of expected models (" << mNModels << ") different from the one set (" << onnxFiles.size() << ")! Please check your configurables.";
     }
-    mPaths = onnxFiles;
+    for (auto iFile{0}; iFile < mNModels; ++iFile) {
+      mPaths[iFile] = getPrecisionVariant(onnxFiles[iFile], false);
+      if (mValidatePrecision && mPrecision != "fp32") {
+        mReferencePaths[iFile] = onnxFiles[iFile];
+      }
+    }
+  }
+
+  /// Use a global intra-op thread pool shared by all ONNX sessions of the process
+  /// \param threads is the total number of inference threads of the process (0 keeps per-session thread pools)
+  /// \note Must be called before init, the thread pool is created together with the first model of the process
+  void setGlobalThreadPool(int threads)
+  {
+    o2::ml::OnnxModel::setGlobalThreadPool(threads);
+  }
+
+  /// Select the ONNX execution provider of the models
+  /// \param provider is the execution provider (CPU, CUDA, TensorRT or ROCm), falls back to CPU if not available
+  /// \param deviceId is the index of the GPU device
+  /// \note Must be called before init
+  void setExecutionProvider(const std::string& provider, int deviceId = 0)
+  {
+    mExecutionProvider = provider;
+    mDeviceId = deviceId;
   }
 
   /// Initialize class instance (initialize OnnxModels)
   /// \param enableOptimizations is a switch to enable optimizations
   /// \param threads is the number of active threads
-  void init(bool enableOptimizations = false, int threads = 0)
+  /// \param maxBatchSize is the number of candidates for which persistent input/output buffers are preallocated (0 disables the I/O binding)
+  void init(bool enableOptimizations = false, int threads = 0, int64_t maxBatchSize = 1024)
   {
     uint8_t counterModel{0};
     for (const auto& path : mPaths) {
+      mModels[counterModel].setExecutionProvider(mExecutionProvider, mDeviceId);
       mModels[counterModel].initModel(path, enableOptimizations, threads);
+      mModels[counterModel].setIoBinding(maxBatchSize);
       ++counterModel;
     }
+    if (mValidatePrecision && mPrecision != "fp32") {
+      for (auto iModel{0}; iModel < mNModels; ++iModel) {
+        mReferenceModels[iModel].initModel(mReferencePaths[iModel], enableOptimizations, threads);
+      }
+    } else {
+      mValidatePrecision = false;
+    }
   }
 
   /// Method to translate configurable input-feature strings into integers
@@ -159,7 +250,12 @@ class MlResponse
     }
 
     TypeOutputScore* outputPtr = mModels[nModel].evalModel(input);
-    return std::vector<TypeOutputScore>{outputPtr, outputPtr + mNClasses};
+    std::vector<TypeOutputScore> output{outputPtr, outputPtr + mNClasses};
+    if (mValidatePrecision && (++mValidationCounter % mValidationDownsampling == 0)) {
+      TypeOutputScore* referencePtr = mReferenceModels[nModel].evalModel(input);
+      fillPrecisionResiduals(output.data(), referencePtr, 1);
+    }
+    return output;
   }
 
   /// ML selections
@@ -213,6 +309,100 @@ class MlResponse
     return true;
   }
 
+  /// Get model predictions for a batch of candidates evaluated with the same model
+  /// \param input is a flattened nCandidates x nFeatures matrix (row-major) with the input features of all candidates
+  /// \param nModel is the model index
+  /// \return flattened nCandidates x nClasses matrix (row-major) with the model predictions
+  template <typename T1, typename T2>
+  std::vector<TypeOutputScore> getModelOutputBatch(T1& input, const T2& nModel)
+  {
+    if (nModel < 0 || static_cast<std::size_t>(nModel) >= mModels.size()) {
+      LOG(fatal) << "Model index " << nModel << " is out of range! The number of initialised models is " << mModels.size() << ". Please check your configurables.";
+    }
+
+    std::vector<TypeOutputScore> output;
+    mModels[nModel].evalModelBatch(input, output);
+    if (mValidatePrecision && (++mValidationCounter % mValidationDownsampling == 0)) {
+      std::vector<TypeOutputScore> reference;
+      mReferenceModels[nModel].evalModelBatch(input, reference);
+      fillPrecisionResiduals(output.data(), reference.data(), std::min(output.size(), reference.size()) / mNClasses);
+    }
+    return output;
+  }
+
+  /// ML selections for a batch of candidates (e.g. all candidates of a table slice)
+  /// \param inputs is a vector with the input features of each candidate
+  /// \param candVars is a vector with the variable value (e.g. pT) of each candidate, used to select which model to use
+  /// \param isSelected is a container filled with the selection decision of each candidate
+  /// \param outputs is a container filled with the model output of each candidate (empty for candidates outside the model bins)
+  /// \note Candidates are grouped per model bin, so that each model is run only once per call
+  template <typename T1, typename T2>
+  void isSelectedMlBatch(std::vector<T1> const& inputs, std::vector<T2> const& candVars, std::vector<bool>& isSelected, std::vector<std::vector<TypeOutputScore>>& outputs)
+  {
+    if (inputs.size() != candVars.size()) {
+      LOG(fatal) << "Number of input-feature vectors (" << inputs.size() << ") different from the number of candidate variables (" << candVars.size() << ")!";
+    }
+    const std::size_t nCandidates = inputs.size();
+    isSelected.assign(nCandidates, false);
+    outputs.assign(nCandidates, {});
+
+    resetBatches();
+    for (std::size_t iCand{0}; iCand < nCandidates; ++iCand) {
+      int nModel = findBin(candVars[iCand]);
+      if (nModel >= 0) {
+        mBatchCandidates[nModel].push_back(iCand);
+        mBatchInputs[nModel].insert(mBatchInputs[nModel].end(), inputs[iCand].begin(), inputs[iCand].end());
+      }
+    }
+    scoreBatches(isSelected, outputs);
+  }
+
+  /// ML selections for a batch of candidates with compile-time feature gather
+  /// \tparam TGather is a FeatureGather with the list of feature getters, fixed at template instantiation
+  /// \param candidates is an iterable over the candidates (e.g. a table slice)
+  /// \param getCandVar is a callable returning the variable value (e.g. pT) of a candidate, used to select which model to use
+  /// \param isSelected is a container filled with the selection decision of each candidate
+  /// \param outputs is a container filled with the model output of each candidate (empty for candidates outside the model bins)
+  /// \note The features are written straight into the per-bin batch buffers, without intermediate per-candidate vectors
+  template <typename TGather, typename TCandidates, typename TGetter>
+  void isSelectedMlGather(TCandidates const& candidates, TGetter const& getCandVar, std::vector<bool>& isSelected, std::vector<std::vector<TypeOutputScore>>& outputs)
+  {
+    isSelectedMlFill(
+      candidates, getCandVar, TGather::NFeatures, [](const auto& candidate, TypeOutputScore* buffer) { TGather::fill(candidate, buffer); }, isSelected, outputs);
+  }
+
+  /// ML selections for a batch of candidates with the input features written by a callable
+  /// \param candidates is an iterable over the candidates (e.g. a table slice)
+  /// \param getCandVar is a callable returning the variable value (e.g. pT) of a candidate, used to select which model to use
+  /// \param nFeatures is the number of input features of each candidate
+  /// \param fillFeatures is a callable writing the nFeatures input features of a candidate to a buffer, e.g. the fillInputFeatures method of the derived classes
+  /// \param isSelected is a container filled with the selection decision of each candidate
+  /// \param outputs is a container filled with the model output of each candidate (empty for candidates outside the model bins)
+  /// \note The features are written straight into the per-bin batch buffers, without intermediate per-candidate vectors
+  template <typename TCandidates, typename TGetter, typename TFiller>
+  void isSelectedMlFill(TCandidates const& candidates, TGetter const& getCandVar, std::size_t nFeatures, TFiller const& fillFeatures, std::vector<bool>& isSelected, std::vector<std::vector<TypeOutputScore>>& outputs)
+  {
+    resetBatches();
+    std::size_t nCandidates{0};
+    for (const auto& candidate : candidates) {
+      int nModel = findBin(getCandVar(candidate));
+      if (nModel >= 0) {
+        auto& buffer = mBatchInputs[nModel];
+        const std::size_t offset = buffer.size();
+        buffer.resize(offset + nFeatures);
+        fillFeatures(candidate, buffer.data() + offset);
+        mBatchCandidates[nModel].push_back(nCandidates);
+      }
+      ++nCandidates;
+    }
+    isSelected.assign(nCandidates, false);
+    outputs.assign(nCandidates, {});
+    scoreBatches(isSelected, outputs);
+  }
+
+  /// Get the number of configured input features
+  std::size_t getNInputFeatures() const { return mCachedIndices.size(); }
+
  protected:
   std::vector<o2::ml::OnnxModel> mModels;                 // OnnxModel objects, one for each bin
   uint8_t mNModels = 1;                                   // number of bins
@@ -223,10 +413,71 @@ class MlResponse
   o2::framework::LabeledArray<double> mCuts = {};         // array of cut values to apply on the model scores
   std::map<std::string, uint8_t> mAvailableInputFeatures; // map of available input features
   std::vector<uint8_t> mCachedIndices;                    // vector of index correspondance between configurables and available input features
+  std::vector<std::vector<std::size_t>> mBatchCandidates; // candidate indices grouped per model bin, reused across batched calls
+  std::string mExecutionProvider = "CPU";                 // ONNX execution provider of the models
+  int mDeviceId = 0;                                      // GPU device used by the execution provider
+  std::vector<std::vector<TypeOutputScore>> mBatchInputs; // flattened input features of the batched candidates per model bin, reused across batched calls
 
   virtual void setAvailableInputFeatures() { return; } // method to fill the map of available input features
 
  private:
+  std::vector<o2::ml::OnnxModel> mReferenceModels;      // nominal-precision models used to validate the reduced-precision ones
+  std::vector<std::string> mReferencePaths;             // paths to the nominal-precision models
+  std::string mPrecision = "fp32";                      // precision variant of the models
+  bool mValidatePrecision = false;                      // switch to score a sample with both precisions
+  int mValidationDownsampling = 100;                    // one evaluation out of mValidationDownsampling is validated
+  uint64_t mValidationCounter = 0;                      // number of evaluations since init
+  std::shared_ptr<TH2> mHistPrecisionResidual = nullptr; // residual of the reduced-precision scores w.r.t. the nominal ones
+
+  /// Name of the precision variant of a model file or CCDB path
+  /// \param name is the file name or CCDB path of the nominal model
+  /// \param isCCDBPath tells whether name is a CCDB path (precision subdirectory) or a file name (precision suffix)
+  std::string getPrecisionVariant(const std::string& name, bool isCCDBPath)
+  {
+    if (mPrecision == "fp32") {
+      return name;
+    }
+    if (isCCDBPath) {
+      return name + "/" + mPrecision;
+    }
+    auto posExtension = name.rfind(".onnx");
+    if (posExtension == std::string::npos) {
+      return name + "_" + mPrecision;
+    }
+    return name.substr(0, posExtension) + "_" + mPrecision + name.substr(posExtension);
+  }
+
+  /// Fills the residuals between reduced-precision and nominal scores
+  void fillPrecisionResiduals(const TypeOutputScore* scores, const TypeOutputScore* referenceScores, std::size_t nRows)
+  {
+    if (referenceScores == nullptr) {
+      return;
+    }
+    for (std::size_t iRow{0}; iRow < nRows; ++iRow) {
+      for (uint8_t iClass{0}; iClass < mNClasses; ++iClass) {
+        mHistPrecisionResidual->Fill(iClass, scores[iRow * mNClasses + iClass] - referenceScores[iRow * mNClasses + iClass]);
+      }
+    }
+  }
+
+  /// Applies the score cuts of a given model bin
+  /// \param scores is a pointer to the nClasses model predictions
+  /// \param nModel is the model index
+  /// \return boolean telling if model predictions pass the cuts
+  bool passesCuts(const TypeOutputScore* scores, int nModel)
+  {
+    for (uint8_t iClass{0}; iClass < mNClasses; ++iClass) {
+      uint8_t dir = mCutDir.at(iClass);
+      if (dir == o2::cuts_ml::CutDirection::CutGreater && scores[iClass] > mCuts.get(nModel, iClass)) {
+        return false;
+      }
+      if (dir == o2::cuts_ml::CutDirection::CutSmaller && scores[iClass] < mCuts.get(nModel, iClass)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   /// Finds matching bin in mBinsLimits
   /// \param value e.g. pT
   /// \return index of the matching bin, used to access mModels
@@ -240,6 +491,17 @@ class MlResponse
     if (value >= mBinsLimits.back()) {
       return -1;
     }
+    if (!mBinLut.empty()) {
+      const std::size_t iCell = std::min(static_cast<std::size_t>((value - mBinsLimits.front()) * mLutInvWidth), mBinLut.size() - 1);
+      int bin = mBinLut[iCell];
+      // the cell contains at most one bin limit (the second check protects against rounding of the cell edges)
+      if (value >= mBinsLimits[bin + 1]) {
+        ++bin;
+      } else if (value < mBinsLimits[bin]) {
+        --bin;
+      }
+      return bin;
+    }
     return std::distance(mBinsLimits.begin(), std::upper_bound(mBinsLimits.begin(), mBinsLimits.end(), value)) - 1;
   }
 };
@@ -20,12 +20,118 @@
 // ONNX includes
 #include "Tools/ML/model.h"
 
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+// ROOT includes
+#include "TMD5.h"
+
 namespace o2
 {
 
 namespace ml
 {
 
+OnnxSessionRegistry& OnnxSessionRegistry::instance()
+{
+  static OnnxSessionRegistry registry;
+  return registry;
+}
+
+std::shared_ptr<Ort::Env> OnnxSessionRegistry::getEnv()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  if (!mEnv) {
+    if (mGlobalThreads > 0) {
+      Ort::ThreadingOptions threadingOptions;
+      threadingOptions.SetGlobalIntraOpNumThreads(mGlobalThreads);
+      threadingOptions.SetGlobalInterOpNumThreads(1);
+      mEnv = std::make_shared<Ort::Env>(threadingOptions, ORT_LOGGING_LEVEL_WARNING, "onnx-model");
+      LOG(info) << "ONNX environment created with a global thread pool of " << mGlobalThreads << " threads";
+    } else {
+      mEnv = std::make_shared<Ort::Env>(ORT_LOGGING_LEVEL_WARNING, "onnx-model");
+    }
+  }
+  return mEnv;
+}
+
+void OnnxSessionRegistry::setGlobalThreadPool(int nThreads)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  if (nThreads < 0) {
+    nThreads = 0;
+  }
+  if (nThreads > 0 && gSystem->Getenv("ALIEN_JDL_CPUCORES") != NULL) {
+    LOGP(info, "Hyperloop test/Grid job detected! Setting the global thread pool to 1 thread.");
+    nThreads = 1;
+  }
+  if (mEnv && nThreads != mGlobalThreads) {
+    LOG(warning) << "ONNX environment already created with " << (mGlobalThreads > 0 ? std::to_string(mGlobalThreads) + " global threads" : "per-session thread pools") << ", request for " << nThreads << " global threads ignored. Set the global thread pool before initialising the first model.";
+    return;
+  }
+  mGlobalThreads = nThreads;
+}
+
+std::shared_ptr<OnnxSession> OnnxSessionRegistry::getSession(const std::string& path, Ort::SessionOptions& options, const std::string& optionsKey)
+{
+  std::string checksum = path;
+  std::unique_ptr<TMD5> md5{TMD5::FileChecksum(path.c_str())};
+  if (md5) {
+    checksum = md5->AsString();
+  } else {
+    LOG(warning) << "Could not compute the checksum of " << path << ", caching the session by path";
+  }
+  std::string key = checksum + "_" + optionsKey;
+
+  auto env = getEnv();
+  std::lock_guard<std::mutex> lock(mMutex);
+  auto& entry = mSessions[key];
+  ++entry.nRequests;
+  if (auto session = entry.session.lock()) {
+    LOG(info) << "Reusing cached ONNX session for " << path << " (loaded from " << entry.path << ")";
+    return session;
+  }
+
+  ProcInfo_t procInfo;
+  gSystem->GetProcInfo(&procInfo);
+  long memBefore = procInfo.fMemResident;
+#if __has_include(<onnxruntime/core/session/onnxruntime_cxx_api.h>)
+  auto session = std::make_shared<OnnxSession>(*env, path, options);
+#else
+  auto session = std::make_shared<OnnxSession>(*env, path.c_str(), options);
+#endif
+  gSystem->GetProcInfo(&procInfo);
+  entry.session = session;
+  entry.path = path;
+  entry.memoryKB = std::max(0L, procInfo.fMemResident - memBefore);
+  return session;
+}
+
+long OnnxSessionRegistry::getMemoryFootprint()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  long memoryKB = 0;
+  for (const auto& [key, entry] : mSessions) {
+    if (!entry.session.expired()) {
+      memoryKB += entry.memoryKB;
+    }
+  }
+  return memoryKB;
+}
+
+void OnnxSessionRegistry::printSummary()
+{
+  long memoryKB = getMemoryFootprint();
+  std::lock_guard<std::mutex> lock(mMutex);
+  LOG(info) << "--- ONNX session registry ---";
+  for (const auto& [key, entry] : mSessions) {
+    LOG(info) << "\t" << entry.path << " : " << (entry.session.expired() ? "released" : "alive") << ", requests: " << entry.nRequests << ", memory: " << entry.memoryKB << " kB";
+  }
+  LOG(info) << "Total estimated memory of the alive sessions: " << memoryKB << " kB";
+}
+
 std::string OnnxModel::printShape(const std::vector<int64_t>& v)
 {
   std::stringstream ss("");
@@ -35,6 +141,40 @@ std::string OnnxModel::printShape(const std::vector<int64_t>& v)
   return ss.str();
 }
 
+std::vector<Ort::Value> OnnxModel::runModel(std::vector<Ort::Value>& input)
+{
+  LOG(debug) << "Input tensor shape: " << printShape(input[0].GetTensorTypeAndShapeInfo().GetShape());
+  // assert(input[0].GetTensorTypeAndShapeInfo().GetShape() == getNumInputNodes()); --> Fails build in debug mode, TODO: assertion should be checked somehow
+
+  auto start = std::chrono::high_resolution_clock::now();
+#if __has_include(<onnxruntime/core/session/onnxruntime_cxx_api.h>)
+  auto outputTensors = mSession->Run(mInputNames, input, mOutputNames);
+#else
+  Ort::RunOptions runOptions;
+  std::vector<const char*> inputNamesChar(mInputNames.size(), nullptr);
+  std::transform(std::begin(mInputNames), std::end(mInputNames), std::begin(inputNamesChar),
+                 [&](const std::string& str) { return str.c_str(); });
+
+  std::vector<const char*> outputNamesChar(mOutputNames.size(), nullptr);
+  std::transform(std::begin(mOutputNames), std::end(mOutputNames), std::begin(outputNamesChar),
+                 [&](const std::string& str) { return str.c_str(); });
+  auto outputTensors = mSession->Run(runOptions, inputNamesChar.data(), input.data(), input.size(), outputNamesChar.data(), outputNamesChar.size());
+#endif
+  mLastInferenceTime = std::chrono::duration<float, std::micro>(std::chrono::high_resolution_clock::now() - start).count();
+  mLastBatchSize = input[0].GetTensorTypeAndShapeInfo().GetShape()[0];
+  LOG(debug) << "Number of output tensors: " << outputTensors.size();
+  if (outputTensors.size() != mOutputNames.size()) {
+    LOG(fatal) << "Number of output tensors: " << outputTensors.size() << " does not agree with the model specified size: " << mOutputNames.size();
+  }
+  for (std::size_t i = 0; i < outputTensors.size(); i++) {
+    LOG(debug) << "Output tensor shape: " << printShape(outputTensors[i].GetTensorTypeAndShapeInfo().GetShape());
+    if ((outputTensors[i].GetTensorTypeAndShapeInfo().GetShape() != mOutputShapes[i]) && (mOutputShapes[i][0] != -1)) {
+      LOG(fatal) << "Shape of tensor " << i << " does not agree with model specification! Output: " << printShape(outputTensors[i].GetTensorTypeAndShapeInfo().GetShape()) << " model: " << printShape(mOutputShapes[i]);
+    }
+  }
+  return outputTensors;
+}
+
 bool OnnxModel::checkHyperloop(bool verbose)
 {
   /// Testing hyperloop core settings
@@ -74,12 +214,44 @@ void OnnxModel::initModel(std::string localPath, bool enableOptimizations, int t
     sessionOptions.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_EXTENDED);
   }
 
-  mEnv = std::make_shared<Ort::Env>(ORT_LOGGING_LEVEL_WARNING, "onnx-model");
-#if __has_include(<onnxruntime/core/session/onnxruntime_cxx_api.h>)
-  mSession = std::make_shared<Ort::Experimental::Session>(*mEnv, modelPath, sessionOptions);
-#else
-  mSession = std::make_shared<Ort::Session>(*mEnv, modelPath.c_str(), sessionOptions);
-#endif
+  /// Sessions of identical models are shared within the process
+  auto& registry = OnnxSessionRegistry::instance();
+  mEnv = registry.getEnv();
+  std::string optionsKey = std::to_string(enableOptimizations) + "_" + std::to_string(activeThreads);
+  if (registry.getGlobalThreads() > 0) {
+    /// Intra-op work goes to the global thread pool of the environment
+    sessionOptions.DisablePerSessionThreads();
+    optionsKey = std::to_string(enableOptimizations) + "_global";
+  }
+  /// Execution provider with automatic CPU fallback
+  appendExecutionProvider();
+  try {
+    mSession = registry.getSession(modelPath, sessionOptions, optionsKey + "_" + mActiveProvider);
+  } catch (const Ort::Exception& exception) {
+    if (mActiveProvider == "CPU") {
+      throw;
+    }
+    LOG(warning) << "Session creation with execution provider " << mActiveProvider << " failed (" << exception.what() << "), falling back to CPU";
+    sessionOptions = Ort::SessionOptions{};
+    if (!checkHyperloop(false)) {
+      sessionOptions.SetIntraOpNumThreads(activeThreads);
+    }
+    if (enableOptimizations) {
+      sessionOptions.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_EXTENDED);
+    }
+    if (registry.getGlobalThreads() > 0) {
+      sessionOptions.DisablePerSessionThreads();
+    }
+    mActiveProvider = "CPU";
+    mRequestedProvider = "CPU";
+    mSession = registry.getSession(modelPath, sessionOptions, optionsKey + "_" + mActiveProvider);
+  }
+  LOG(info) << "Execution provider: " << mActiveProvider;
+
+  mInputNames.clear();
+  mInputShapes.clear();
+  mOutputNames.clear();
+  mOutputShapes.clear();
 
 #if __has_include(<onnxruntime/core/session/onnxruntime_cxx_api.h>)
   mInputNames = mSession->GetInputNames();
@@ -101,6 +273,11 @@ void OnnxModel::initModel(std::string localPath, bool enableOptimizations, int t
     mOutputShapes.emplace_back(mSession->GetOutputTypeInfo(i).GetTensorTypeAndShapeInfo().GetShape());
   }
 #endif
+  mInputType = mSession->GetInputTypeInfo(0).GetTensorTypeAndShapeInfo().GetElementType();
+  if (isFloat16()) {
+    LOG(info) << "Half-precision (FP16) model: float inputs are cast to FP16";
+  }
+
   LOG(info) << "Input Nodes:";
   for (size_t i = 0; i < mInputNames.size(); i++) {
     LOG(info) << "\t" << mInputNames[i] << " : " << printShape(mInputShapes[i]);
@@ -117,6 +294,69 @@ void OnnxModel::initModel(std::string localPath, bool enableOptimizations, int t
   LOG(info) << "Model validity - From: " << validFrom << ", Until: " << validUntil;
 
   LOG(info) << "--- Model initialized! ---";
+
+  /// Buffers of an existing I/O binding are bound to the previous session
+  if (mIoBinding) {
+    setIoBinding(mMaxBatchSize);
+  }
+}
+
+void OnnxModel::appendExecutionProvider()
+{
+  if (mRequestedProvider == mActiveProvider) {
+    return; // already appended to the session options (or CPU)
+  }
+  try {
+    if (mRequestedProvider == "CUDA") {
+      OrtCUDAProviderOptions cudaOptions;
+      cudaOptions.device_id = mDeviceId;
+      sessionOptions.AppendExecutionProvider_CUDA(cudaOptions);
+    } else if (mRequestedProvider == "TensorRT") {
+      OrtTensorRTProviderOptionsV2* tensorRtOptions = nullptr;
+      Ort::ThrowOnError(Ort::GetApi().CreateTensorRTProviderOptions(&tensorRtOptions));
+      std::string deviceId = std::to_string(mDeviceId);
+      const char* keys[] = {"device_id"};
+      const char* values[] = {deviceId.c_str()};
+      Ort::ThrowOnError(Ort::GetApi().UpdateTensorRTProviderOptions(tensorRtOptions, keys, values, 1));
+      sessionOptions.AppendExecutionProvider_TensorRT_V2(*tensorRtOptions);
+      Ort::GetApi().ReleaseTensorRTProviderOptions(tensorRtOptions);
+      // Nodes not supported by TensorRT are run with CUDA
+      OrtCUDAProviderOptions cudaOptions;
+      cudaOptions.device_id = mDeviceId;
+      sessionOptions.AppendExecutionProvider_CUDA(cudaOptions);
+    } else if (mRequestedProvider == "ROCm") {
+      OrtROCMProviderOptions rocmOptions;
+      rocmOptions.device_id = mDeviceId;
+      sessionOptions.AppendExecutionProvider_ROCM(rocmOptions);
+    } else {
+      LOG(fatal) << "Unknown execution provider " << mRequestedProvider << "! Available options: CPU, CUDA, TensorRT, ROCm";
+    }
+    mActiveProvider = mRequestedProvider;
+  } catch (const Ort::Exception& exception) {
+    LOG(warning) << "Execution provider " << mRequestedProvider << " not available (" << exception.what() << "), falling back to CPU";
+    mRequestedProvider = "CPU";
+    mActiveProvider = "CPU";
+  }
+}
+
+void OnnxModel::setExecutionProvider(std::string provider, int deviceId)
+{
+  if (mSession) {
+    LOG(warning) << "Execution provider must be set before initModel, request for " << provider << " ignored";
+    return;
+  }
+  mRequestedProvider = provider.empty() ? "CPU" : provider;
+  mDeviceId = deviceId;
+}
+
+int OnnxModel::getExecutionProviderIndex() const
+{
+  for (int i = 0; i < NExecutionProviders; i++) {
+    if (mActiveProvider == ExecutionProviders[i]) {
+      return i;
+    }
+  }
+  return 0;
 }
 
 void OnnxModel::setActiveThreads(int threads)
@@ -127,6 +367,164 @@ void OnnxModel::setActiveThreads(int threads)
   }
 }
 
+void OnnxModel::setIoBinding(int64_t maxBatchSize)
+{
+  mIoBinding.reset();
+  mBoundTensors.clear();
+  mBoundInput.clear();
+  mBoundOutputs.clear();
+  mOutputTypes.clear();
+  mMaxBatchSize = 0;
+  mBoundRows = 0;
+  if (maxBatchSize <= 0) {
+    return;
+  }
+  if (mInputType != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT) {
+    LOG(info) << "I/O binding is only supported for models with float inputs. Falling back to standard inference.";
+    return;
+  }
+  if (mInputNames.size() != 1) {
+    LOG(warning) << "I/O binding is only supported for models with a single input node, this model has " << mInputNames.size() << ". Falling back to standard inference.";
+    return;
+  }
+
+  auto rowSize = [](const std::vector<int64_t>& shape) {
+    int64_t size = 1;
+    for (std::size_t i = 1; i < shape.size(); i++) {
+      size *= std::max<int64_t>(shape[i], 1);
+    }
+    return size;
+  };
+  auto elementSize = [](ONNXTensorElementDataType type) -> std::size_t {
+    switch (type) {
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64:
+        return 8;
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32:
+        return 4;
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16:
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16:
+        return 2;
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL:
+        return 1;
+      default:
+        return 0;
+    }
+  };
+
+  for (std::size_t i = 0; i < mOutputNames.size(); i++) {
+    auto type = mSession->GetOutputTypeInfo(i).GetTensorTypeAndShapeInfo().GetElementType();
+    if (elementSize(type) == 0) {
+      LOG(warning) << "Output node " << mOutputNames[i] << " has an element type not supported by the I/O binding. Falling back to standard inference.";
+      mOutputTypes.clear();
+      mBoundOutputs.clear();
+      return;
+    }
+    mOutputTypes.push_back(type);
+    mBoundOutputs.emplace_back(maxBatchSize * rowSize(mOutputShapes[i]) * elementSize(type));
+  }
+  if (mOutputTypes.back() != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT) {
+    LOG(warning) << "I/O binding requires a float last output node. Falling back to standard inference.";
+    mOutputTypes.clear();
+    mBoundOutputs.clear();
+    return;
+  }
+
+  mMaxBatchSize = maxBatchSize;
+  mBoundOutputRowSize = rowSize(mOutputShapes.back());
+  mBoundInput.resize(mMaxBatchSize * mInputShapes[0][1]);
+  mMemoryInfo = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
+  mIoBinding = std::make_unique<Ort::IoBinding>(*mSession);
+  LOG(info) << "I/O binding enabled with buffers preallocated for up to " << mMaxBatchSize << " rows";
+}
+
+void OnnxModel::bindBuffers(int64_t nRows)
+{
+  mIoBinding->ClearBoundInputs();
+  mIoBinding->ClearBoundOutputs();
+  mBoundTensors.clear();
+
+  std::vector<int64_t> inputShape{nRows, mInputShapes[0][1]};
+  mBoundTensors.emplace_back(Ort::Value::CreateTensor<float>(mMemoryInfo, mBoundInput.data(), nRows * mInputShapes[0][1], inputShape.data(), inputShape.size()));
+  mIoBinding->BindInput(mInputNames[0].c_str(), mBoundTensors.back());
+
+  for (std::size_t i = 0; i < mOutputNames.size(); i++) {
+    std::vector<int64_t> outputShape = mOutputShapes[i];
+    outputShape[0] = nRows;
+    for (std::size_t j = 1; j < outputShape.size(); j++) {
+      outputShape[j] = std::max<int64_t>(outputShape[j], 1);
+    }
+    std::size_t nBytes = mBoundOutputs[i].size() / mMaxBatchSize * nRows;
+    mBoundTensors.emplace_back(Ort::Value::CreateTensor(mMemoryInfo, mBoundOutputs[i].data(), nBytes, outputShape.data(), outputShape.size(), mOutputTypes[i]));
+    mIoBinding->BindOutput(mOutputNames[i].c_str(), mBoundTensors.back());
+  }
+  mBoundRows = nRows;
+}
+
+float* OnnxModel::evalModelBound(const float* input, int64_t nRows)
+{
+  if (!mIoBinding) {
+    LOG(fatal) << "I/O binding not enabled! Call setIoBinding after initModel.";
+  }
+  if (nRows <= 0 || nRows > mMaxBatchSize) {
+    LOG(fatal) << "Number of rows (" << nRows << ") outside the range of the I/O binding (maximum batch size: " << mMaxBatchSize << ")!";
+  }
+  try {
+    // tensor views are only recreated when the number of rows changes
+    if (nRows != mBoundRows) {
+      bindBuffers(nRows);
+    }
+    std::copy(input, input + nRows * mInputShapes[0][1], mBoundInput.begin());
+    auto start = std::chrono::high_resolution_clock::now();
+    mSession->Run(Ort::RunOptions{nullptr}, *mIoBinding);
+    mLastInferenceTime = std::chrono::duration<float, std::micro>(std::chrono::high_resolution_clock::now() - start).count();
+    mLastBatchSize = nRows;
+  } catch (const Ort::Exception& exception) {
+    LOG(error) << "Error running model inference with I/O binding: " << exception.what();
+    return nullptr;
+  }
+  return reinterpret_cast<float*>(mBoundOutputs.back().data());
+}
+
+float* OnnxModel::evalModelHalf(const float* input, int64_t nRows)
+{
+  const int64_t nValues = nRows * mInputShapes[0][1];
+  mHalfInput.resize(nValues);
+  for (int64_t i = 0; i < nValues; i++) {
+    mHalfInput[i] = Ort::Float16_t(input[i]);
+  }
+  std::vector<int64_t> inputShape{nRows, mInputShapes[0][1]};
+  Ort::MemoryInfo memInfo = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
+  std::vector<Ort::Value> inputTensors;
+  inputTensors.emplace_back(Ort::Value::CreateTensor<Ort::Float16_t>(memInfo, mHalfInput.data(), nValues, inputShape.data(), inputShape.size()));
+  try {
+    auto outputTensors = runModel(inputTensors);
+    const auto& outputTensor = outputTensors.back();
+    auto outputInfo = outputTensor.GetTensorTypeAndShapeInfo();
+    const std::size_t nOutputValues = outputInfo.GetElementCount();
+    mHalfOutput.resize(nOutputValues);
+    if (outputInfo.GetElementType() == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16) {
+      const Ort::Float16_t* outputValues = outputTensor.GetTensorData<Ort::Float16_t>();
+      for (std::size_t i = 0; i < nOutputValues; i++) {
+        mHalfOutput[i] = outputValues[i].ToFloat();
+      }
+    } else {
+      const float* outputValues = outputTensor.GetTensorData<float>();
+      std::copy(outputValues, outputValues + nOutputValues, mHalfOutput.begin());
+    }
+  } catch (const Ort::Exception& exception) {
+    LOG(error) << "Error running half-precision model inference: " << exception.what();
+    return nullptr;
+  }
+  return mHalfOutput.data();
+}
+
 } // namespace ml
 
 } // namespace o2
@@ -31,6 +31,8 @@
 #include <memory>
 #include <map>
 #include <algorithm>
+#include <mutex>
+#include <type_traits>
 
 // ROOT includes
 #include "TSystem.h"
@@ -44,10 +46,57 @@ namespace o2
 namespace ml
 {
 
+#if __has_include(<onnxruntime/core/session/onnxruntime_cxx_api.h>)
+using OnnxSession = Ort::Experimental::Session;
+#else
+using OnnxSession = Ort::Session;
+#endif
+
+/// Process-wide registry of ONNX sessions
+/// Identical models (same file checksum and session settings) are loaded only once and shared read-only between all OnnxModel instances of the process
+class OnnxSessionRegistry
+{
+ public:
+  static OnnxSessionRegistry& instance();
+
+  /// Common ONNX runtime environment of the process
+  std::shared_ptr<Ort::Env> getEnv();
+  /// Enables a global intra-op thread pool shared by all sessions of the process (must be called before the first model is initialised)
+  /// \param nThreads is the total number of inference threads of the process, 0 keeps per-session thread pools
+  void setGlobalThreadPool(int nThreads);
+  int getGlobalThreads() const { return mGlobalThreads; }
+  /// Returns the cached session for the model and settings, creating it if needed
+  /// \param path is the local path of the model file
+  /// \param options are the session options used to create the session
+  /// \param optionsKey is a string identifying the session options
+  std::shared_ptr<OnnxSession> getSession(const std::string& path, Ort::SessionOptions& options, const std::string& optionsKey);
+  /// Estimated resident memory of the sessions currently alive, in kB
+  long getMemoryFootprint();
+  void printSummary();
+
+ private:
+  OnnxSessionRegistry() = default;
+
+  struct Entry {
+    std::weak_ptr<OnnxSession> session;
+    std::string path;
+    long memoryKB = 0; // resident memory increase measured while creating the session
+    int nRequests = 0;
+  };
+
+  std::mutex mMutex;
+  std::shared_ptr<Ort::Env> mEnv = nullptr;
+  int mGlobalThreads = 0; // size of the global intra-op thread pool, 0 if per-session pools are used
+  std::map<std::string, Entry> mSessions; // key: model checksum and session options
+};
+
 class OnnxModel
 {
 
  public:
+  static constexpr int NExecutionProviders = 4;
+  static constexpr const char* ExecutionProviders[NExecutionProviders] = {"CPU", "CUDA", "TensorRT", "ROCm"};
+
   OnnxModel() = default;
   ~OnnxModel() = default;
 
@@ -58,33 +107,8 @@ class OnnxModel
   template <typename T>
   T* evalModel(std::vector<Ort::Value>& input)
   {
-    LOG(debug) << "Input tensor shape: " << printShape(input[0].GetTensorTypeAndShapeInfo().GetShape());
-    // assert(input[0].GetTensorTypeAndShapeInfo().GetShape() == getNumInputNodes()); --> Fails build in debug mode, TODO: assertion should be checked somehow
-
     try {
-#if __has_include(<onnxruntime/core/session/onnxruntime_cxx_api.h>)
-      auto outputTensors = mSession->Run(mInputNames, input, mOutputNames);
-#else
-      Ort::RunOptions runOptions;
-      std::vector<const char*> inputNamesChar(mInputNames.size(), nullptr);
-      std::transform(std::begin(mInputNames), std::end(mInputNames), std::begin(inputNamesChar),
-                     [&](const std::string& str) { return str.c_str(); });
-
-      std::vector<const char*> outputNamesChar(mOutputNames.size(), nullptr);
-      std::transform(std::begin(mOutputNames), std::end(mOutputNames), std::begin(outputNamesChar),
-                     [&](const std::string& str) { return str.c_str(); });
-      auto outputTensors = mSession->Run(runOptions, inputNamesChar.data(), input.data(), input.size(), outputNamesChar.data(), outputNamesChar.size());
-#endif
-      LOG(debug) << "Number of output tensors: " << outputTensors.size();
-      if (outputTensors.size() != mOutputNames.size()) {
-        LOG(fatal) << "Number of output tensors: " << outputTensors.size() << " does not agree with the model specified size: " << mOutputNames.size();
-      }
-      for (std::size_t i = 0; i < outputTensors.size(); i++) {
-        LOG(debug) << "Output tensor shape: " << printShape(outputTensors[i].GetTensorTypeAndShapeInfo().GetShape());
-        if ((outputTensors[i].GetTensorTypeAndShapeInfo().GetShape() != mOutputShapes[i]) && (mOutputShapes[i][0] != -1)) {
-          LOG(fatal) << "Shape of tensor " << i << " does not agree with model specification! Output: " << printShape(outputTensors[i].GetTensorTypeAndShapeInfo().GetShape()) << " model: " << printShape(mOutputShapes[i]);
-        }
-      }
+      auto outputTensors = runModel(input);
       T* outputValues = outputTensors.back().GetTensorMutableData<T>();
       return outputValues;
     } catch (const Ort::Exception& exception) {
@@ -98,6 +122,14 @@ class OnnxModel
   {
     int64_t size = input.size();
     assert(size % mInputShapes[0][1] == 0);
+    if constexpr (std::is_same_v<T, float>) {
+      if (mIoBinding && size / mInputShapes[0][1] <= mMaxBatchSize) {
+        return evalModelBound(input.data(), size / mInputShapes[0][1]);
+      }
+      if (isFloat16()) {
+        return evalModelHalf(input.data(), size / mInputShapes[0][1]);
+      }
+    }
     std::vector<int64_t> inputShape{size / mInputShapes[0][1], mInputShapes[0][1]};
     std::vector<Ort::Value> inputTensors;
 #if __has_include(<onnxruntime/core/session/onnxruntime_cxx_api.h>)
@@ -111,15 +143,92 @@ class OnnxModel
     return evalModel<T>(inputTensors);
   }
 
-  // Reset session
+  /// Batched inference: evaluates all rows of an input matrix in a single session run
+  /// \param input is a row-major nRows x nInputNodes matrix, flattened
+  /// \param output is filled with the row-major nRows x nOutputNodes scores of the last output tensor
+  /// \return number of evaluated rows
+  template <typename T>
+  int64_t evalModelBatch(std::vector<T>& input, std::vector<T>& output)
+  {
+    int64_t size = input.size();
+    int64_t nFeatures = mInputShapes[0][1];
+    output.clear();
+    if (size == 0) {
+      return 0;
+    }
+    if (size % nFeatures != 0) {
+      LOG(fatal) << "Size of the batched input (" << size << ") is not a multiple of the number of input nodes (" << nFeatures << ")!";
+    }
+    int64_t nRows = size / nFeatures;
+    if constexpr (std::is_same_v<T, float>) {
+      if (mIoBinding) {
+        output.resize(nRows * mBoundOutputRowSize);
+        for (int64_t firstRow = 0; firstRow < nRows; firstRow += mMaxBatchSize) {
+          int64_t nChunkRows = std::min(mMaxBatchSize, nRows - firstRow);
+          float* outputValues = evalModelBound(input.data() + firstRow * nFeatures, nChunkRows);
+          if (outputValues == nullptr) {
+            output.clear();
+            return 0;
+          }
+          std::copy(outputValues, outputValues + nChunkRows * mBoundOutputRowSize, output.begin() + firstRow * mBoundOutputRowSize);
+        }
+        return nRows;
+      }
+      if (isFloat16()) {
+        if (evalModelHalf(input.data(), nRows) == nullptr) {
+          return 0;
+        }
+        output = mHalfOutput;
+        return nRows;
+      }
+    }
+    std::vector<int64_t> inputShape{nRows, nFeatures};
+    std::vector<Ort::Value> inputTensors;
 #if __has_include(<onnxruntime/core/session/onnxruntime_cxx_api.h>)
-  void resetSession() { mSession.reset(new Ort::Experimental::Session{*mEnv, modelPath, sessionOptions}); }
+    inputTensors.emplace_back(Ort::Experimental::Value::CreateTensor<T>(input.data(), size, inputShape));
 #else
+    Ort::MemoryInfo mem_info =
+      Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
+    inputTensors.emplace_back(Ort::Value::CreateTensor<T>(mem_info, input.data(), size, inputShape.data(), inputShape.size()));
+#endif
+    LOG(debug) << "Batched input shape: " << printShape(inputShape);
+    try {
+      auto outputTensors = runModel(inputTensors);
+      const auto& outputTensor = outputTensors.back();
+      std::size_t nValues = outputTensor.GetTensorTypeAndShapeInfo().GetElementCount();
+      const T* outputValues = outputTensor.GetTensorData<T>();
+      output.assign(outputValues, outputValues + nValues);
+    } catch (const Ort::Exception& exception) {
+      LOG(error) << "Error running batched model inference: " << exception.what();
+      return 0;
+    }
+    return nRows;
+  }
+
+  /// Inference on preallocated, persistently bound input and output buffers (requires setIoBinding)
+  /// \param input is a pointer to the flattened nRows x nInputNodes input features
+  /// \param nRows is the number of rows to evaluate, must not exceed the maximum batch size
+  /// \return pointer to the bound buffer of the last output, valid until the next call
+  float* evalModelBound(const float* input, int64_t nRows);
+
+  /// Inference of a half-precision (FP16) model on float features
+  /// \param input is a pointer to the flattened nRows x nInputNodes input features, cast to FP16 internally
+  /// \param nRows is the number of rows to evaluate
+  /// \return pointer to the last output converted to float, valid until the next call
+  float* evalModelHalf(const float* input, int64_t nRows);
+
+  // Reset session
   void resetSession()
   {
+#if __has_include(<onnxruntime/core/session/onnxruntime_cxx_api.h>)
+    mSession.reset(new Ort::Experimental::Session{*mEnv, modelPath, sessionOptions});
+#else
     mSession.reset(new Ort::Session{*mEnv, modelPath.c_str(), sessionOptions});
-  }
 #endif
+    if (mIoBinding) {
+      setIoBinding(mMaxBatchSize);
+    }
+  }
 
   // Getters & Setters
   Ort::SessionOptions* getSessionOptions() { return &sessionOptions; } // For optimizations in post
@@ -135,7 +244,17 @@ class OnnxModel
   int getNumOutputNodes() const { return mOutputShapes[0][1]; }
   uint64_t getValidityFrom() const { return validFrom; }
   uint64_t getValidityUntil() const { return validUntil; }
+  int64_t getMaxBatchSize() const { return mMaxBatchSize; }
+  bool isFloat16() const { return mInputType == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16; } // model expects FP16 inputs
+  bool isIoBindingEnabled() const { return mIoBinding != nullptr; }
   void setActiveThreads(int);
+  void setExecutionProvider(std::string, int = 0); // CPU, CUDA, TensorRT or ROCm (with device id), must be called before initModel; falls back to CPU if not available
+  std::string getExecutionProvider() const { return mActiveProvider; }
+  int getExecutionProviderIndex() const; // index of the active provider in ExecutionProviders
+  float getLastInferenceTime() const { return mLastInferenceTime; } // duration of the last session run in microseconds
+  int64_t getLastBatchSize() const { return mLastBatchSize; }       // number of rows evaluated in the last session run
+  static void setGlobalThreadPool(int threads) { OnnxSessionRegistry::instance().setGlobalThreadPool(threads); } // caps the inference threads of the process, call before initModel
+  void setIoBinding(int64_t); // allocates input/output buffers for up to the given number of rows once and binds them to the session, 0 disables the binding
 
  private:
   // Environment variables for the ONNX runtime
@@ -153,6 +272,29 @@ class OnnxModel
   std::vector<std::string> mOutputNames;
   std::vector<std::vector<int64_t>> mOutputShapes;
 
+  // Persistent I/O binding with buffers allocated once for mMaxBatchSize rows
+  std::unique_ptr<Ort::IoBinding> mIoBinding = nullptr;
+  Ort::MemoryInfo mMemoryInfo{nullptr};
+  std::vector<float> mBoundInput;
+  std::vector<std::vector<uint8_t>> mBoundOutputs;   // raw buffers, one per output node
+  std::vector<ONNXTensorElementDataType> mOutputTypes; // element type of each output node
+  std::vector<Ort::Value> mBoundTensors;            // tensor views on the bound buffers
+  int64_t mMaxBatchSize = 0;
+  int64_t mBoundRows = 0;          // number of rows the tensor views are currently shaped for
+  int64_t mBoundOutputRowSize = 0; // number of values per row in the last output
+
+  // Buffers for the casting of half-precision models
+  ONNXTensorElementDataType mInputType = ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT;
+  std::vector<Ort::Float16_t> mHalfInput;
+  std::vector<float> mHalfOutput;
+
+  // Execution provider and timing of the last inference
+  std::string mRequestedProvider = "CPU";
+  std::string mActiveProvider = "CPU";
+  int mDeviceId = 0;
+  float mLastInferenceTime = 0.f;
+  int64_t mLastBatchSize = 0;
+
   // Environment settings
   std::string modelPath;
   int activeThreads = 0;
@@ -161,7 +303,12 @@ class OnnxModel
 
   // Internal function for printing the shape of tensors
   std::string printShape(const std::vector<int64_t>&);
+  // Internal function running the session and checking the output shapes
+  std::vector<Ort::Value> runModel(std::vector<Ort::Value>&);
+  // Internal function (re)creating the tensor views on the bound buffers for a given number of rows
+  void bindBuffers(int64_t);
   bool checkHyperloop(bool = true);
+  void appendExecutionProvider();
 };
 
 } // namespace ml
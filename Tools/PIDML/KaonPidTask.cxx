@@ -14,6 +14,7 @@
 
 #include <cmath>
 #include <memory>
+#include <vector>
 #include "Framework/AnalysisTask.h"
 #include "Framework/runDataProcessing.h"
 #include "Common/DataModel/EventSelection.h"
@@ -97,37 +98,40 @@ struct KaonPidTask {
   {
     auto groupPositive = positive->sliceByCached(aod::track::collisionId, coll.globalIndex(), cache);
     auto groupNegative = negative->sliceByCached(aod::track::collisionId, coll.globalIndex(), cache);
+    float mass = TDatabasePDG::Instance()->GetParticle(cfgPid.value)->Mass();
+
+    // the model is evaluated once per track, and the pairs are built from the accepted tracks
+    std::vector<bool> acceptedPositive = pidModel.get()->applyModelBooleanBatch(groupPositive);
+    std::vector<TLorentzVector> acceptedPositiveVecs;
+    std::size_t iTrack = 0;
     for (auto track : groupPositive) {
       histos.fill(HIST("hChargePos"), track.sign());
-      if (pidModel.get()->applyModelBoolean(track)) {
+      if (acceptedPositive[iTrack++]) {
         histos.fill(HIST("hdEdXvsMomentum"), track.p(), track.tpcSignal());
+        acceptedPositiveVecs.emplace_back();
+        acceptedPositiveVecs.back().SetPtEtaPhiM(track.pt(), track.eta(), track.phi(), mass);
       }
     }
 
+    std::vector<bool> acceptedNegative = pidModel.get()->applyModelBooleanBatch(groupNegative);
+    std::vector<TLorentzVector> acceptedNegativeVecs;
+    iTrack = 0;
     for (auto track : groupNegative) {
       histos.fill(HIST("hChargeNeg"), track.sign());
-      if (pidModel.get()->applyModelBoolean(track)) {
+      if (acceptedNegative[iTrack++]) {
         histos.fill(HIST("hdEdXvsMomentum"), track.p(), track.tpcSignal());
+        acceptedNegativeVecs.emplace_back();
+        acceptedNegativeVecs.back().SetPtEtaPhiM(track.pt(), track.eta(), track.phi(), mass);
       }
     }
 
-    for (auto& [pos, neg] : combinations(soa::CombinationsFullIndexPolicy(groupPositive, groupNegative))) {
-      if (!(pidModel.get()->applyModelBoolean(pos)) || !(pidModel.get()->applyModelBoolean(neg))) {
-        continue;
-      }
-
-      TLorentzVector part1Vec;
-      TLorentzVector part2Vec;
-      float mMassOne = TDatabasePDG::Instance()->GetParticle(cfgPid.value)->Mass();
-      float mMassTwo = TDatabasePDG::Instance()->GetParticle(cfgPid.value)->Mass();
+    for (const auto& part1Vec : acceptedPositiveVecs) {
+      for (const auto& part2Vec : acceptedNegativeVecs) {
+        TLorentzVector sumVec(part1Vec);
+        sumVec += part2Vec;
 
-      part1Vec.SetPtEtaPhiM(pos.pt(), pos.eta(), pos.phi(), mMassOne);
-      part2Vec.SetPtEtaPhiM(neg.pt(), neg.eta(), neg.phi(), mMassTwo);
-
-      TLorentzVector sumVec(part1Vec);
-      sumVec += part2Vec;
-
-      histos.fill(HIST("hInvariantMass"), sumVec.M());
+        histos.fill(HIST("hInvariantMass"), sumVec.M());
+      }
     }
   }
 };
@@ -112,6 +112,59 @@ struct PidONNXInterface {
     return false;
   }
 
+  /// Certainties for a pid of all the tracks of a table, in table order.
+  /// The tracks are partitioned by the detector configuration of their pT range and each model is run once on its partition.
+  template <typename T>
+  std::vector<float> applyModelBatch(const T& tracks, int pid)
+  {
+    std::vector<float> certainties(tracks.size(), -1.0f);
+    for (std::size_t i = 0; i < mNPids; i++) {
+      if (mModels[i * kNDetectors].mPid != pid) {
+        continue;
+      }
+      std::array<std::vector<float>, kNDetectors> inputs;
+      std::array<std::vector<std::size_t>, kNDetectors> positions;
+      std::size_t position = 0;
+      for (const auto& track : tracks) {
+        for (uint32_t j = 0; j < kNDetectors; j++) {
+          if (track.pt() >= mPTLimits[i][j] && (j == kNDetectors - 1 || track.pt() < mPTLimits[i][j + 1])) {
+            mModels[i * kNDetectors + j].appendInputs(track, inputs[j]);
+            positions[j].push_back(position);
+            break;
+          }
+        }
+        position++;
+      }
+      for (uint32_t j = 0; j < kNDetectors; j++) {
+        std::vector<float> detectorCertainties = mModels[i * kNDetectors + j].getModelOutputBatch(inputs[j], positions[j].size());
+        for (std::size_t k = 0; k < positions[j].size(); k++) {
+          certainties[positions[j][k]] = detectorCertainties[k];
+        }
+      }
+      return certainties;
+    }
+    LOG(error) << "No suitable PID ML model found for expected pid: " << pid;
+    return certainties;
+  }
+
+  template <typename T>
+  std::vector<bool> applyModelBooleanBatch(const T& tracks, int pid)
+  {
+    std::vector<bool> accepted(tracks.size(), false);
+    for (std::size_t i = 0; i < mNPids; i++) {
+      if (mModels[i * kNDetectors].mPid == pid) {
+        std::vector<float> certainties = applyModelBatch(tracks, pid);
+        for (std::size_t k = 0; k < certainties.size(); k++) {
+          // the certainty threshold is the same for all the detector configurations of a pid
+          accepted[k] = certainties[k] >= mModels[i * kNDetectors].mMinCertainty;
+        }
+        return accepted;
+      }
+    }
+    LOG(error) << "No suitable PID ML model found for expected pid: " << pid;
+    return accepted;
+  }
+
  private:
   void fillDefaultConfiguration(std::vector<double>& minCertainties)
   {
@@ -69,7 +69,7 @@ struct PidONNXModel {
     loadInputFiles(localPath, ccdbPath, useCCDB, ccdbApi, timestamp, pid, modelFile);
 
     Ort::SessionOptions sessionOptions;
-    mEnv = std::make_shared<Ort::Env>(ORT_LOGGING_LEVEL_WARNING, "pid-onnx-inferer");
+    mEnv = getOrtEnv();
     LOG(info) << "Loading ONNX model from file: " << modelFile;
 #if __has_include(<onnxruntime/core/session/onnxruntime_cxx_api.h>)
     mSession.reset(new Ort::Experimental::Session{*mEnv, modelFile, sessionOptions});
@@ -131,6 +131,60 @@ struct PidONNXModel {
     return getModelOutput(track) >= mMinCertainty;
   }
 
+  /// Certainties of the model for all the tracks of a table, in table order
+  template <typename T>
+  std::vector<float> applyModelBatch(const T& tracks)
+  {
+    std::vector<float> inputTensorValues;
+    int64_t nTracks = 0;
+    for (const auto& track : tracks) {
+      appendInputs(track, inputTensorValues);
+      nTracks++;
+    }
+    return getModelOutputBatch(inputTensorValues, nTracks);
+  }
+
+  template <typename T>
+  std::vector<bool> applyModelBooleanBatch(const T& tracks)
+  {
+    std::vector<float> certainties = applyModelBatch(tracks);
+    std::vector<bool> accepted(certainties.size());
+    for (std::size_t i = 0; i < certainties.size(); i++) {
+      accepted[i] = certainties[i] >= mMinCertainty;
+    }
+    return accepted;
+  }
+
+  /// Appends the inputs of a track to those of a batch
+  template <typename T>
+  void appendInputs(const T& track, std::vector<float>& inputTensorValues)
+  {
+    std::vector<float> inputValues = createInputsSingle(track);
+    inputTensorValues.insert(inputTensorValues.end(), inputValues.begin(), inputValues.end());
+  }
+
+  /// Certainties of the model for a batch of tracks, whose inputs were filled with appendInputs.
+  /// The batch is evaluated in a single inference if the model has a variable batch size, track by track otherwise.
+  std::vector<float> getModelOutputBatch(std::vector<float>& inputTensorValues, int64_t nTracks)
+  {
+    std::vector<float> certainties;
+    certainties.reserve(nTracks);
+    if (nTracks == 0) {
+      return certainties;
+    }
+    std::vector<int64_t> inputShape = mInputShapes[0];
+    const int64_t nInputs = inputTensorValues.size() / nTracks;
+    if (inputShape[0] < 0) {
+      inputShape[0] = nTracks;
+      runModel(inputTensorValues.data(), inputTensorValues.size(), inputShape, certainties);
+    } else {
+      for (int64_t i = 0; i < nTracks; i++) {
+        runModel(inputTensorValues.data() + i * nInputs, nInputs, inputShape, certainties);
+      }
+    }
+    return certainties;
+  }
+
   PidMLDetector mDetector;
   int mPid;
   double mMinCertainty;
@@ -244,18 +298,37 @@ struct PidONNXModel {
     return 1.0f / (1.0f + std::exp(-value));
   }
 
+  // One environment shared by the sessions of all the models
+  static std::shared_ptr<Ort::Env> getOrtEnv()
+  {
+    static std::shared_ptr<Ort::Env> env = std::make_shared<Ort::Env>(ORT_LOGGING_LEVEL_WARNING, "pid-onnx-inferer");
+    return env;
+  }
+
   template <typename T>
   float getModelOutput(const T& track)
   {
     auto input_shape = mInputShapes[0];
+    if (input_shape[0] < 0) {
+      input_shape[0] = 1; // variable batch size
+    }
     std::vector<float> inputTensorValues = createInputsSingle(track);
+    std::vector<float> certainties;
+    runModel(inputTensorValues.data(), inputTensorValues.size(), input_shape, certainties);
+    return certainties[0];
+  }
+
+  // Runs the model on the tracks of an input tensor and appends their certainties
+  void runModel(float* inputTensorValues, std::size_t nInputTensorValues, std::vector<int64_t>& input_shape, std::vector<float>& certainties)
+  {
+    const int64_t nTracks = input_shape[0];
     std::vector<Ort::Value> inputTensors;
 #if __has_include(<onnxruntime/core/session/onnxruntime_cxx_api.h>)
-    inputTensors.emplace_back(Ort::Experimental::Value::CreateTensor<float>(inputTensorValues.data(), inputTensorValues.size(), input_shape));
+    inputTensors.emplace_back(Ort::Experimental::Value::CreateTensor<float>(inputTensorValues, nInputTensorValues, input_shape));
 #else
     Ort::MemoryInfo mem_info =
       Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
-    inputTensors.emplace_back(Ort::Value::CreateTensor<float>(mem_info, inputTensorValues.data(), inputTensorValues.size(), input_shape.data(), input_shape.size()));
+    inputTensors.emplace_back(Ort::Value::CreateTensor<float>(mem_info, inputTensorValues, nInputTensorValues, input_shape.data(), input_shape.size()));
 
 #endif
 
@@ -285,12 +358,14 @@ struct PidONNXModel {
       LOG(debug) << "output tensor shape: " << printShape(outputTensors[0].GetTensorTypeAndShapeInfo().GetShape());
 
       const float* output_value = outputTensors[0].GetTensorData<float>();
-      float certainty = sigmoid(*output_value); // FIXME: Temporary, sigmoid will be added as network layer
-      return certainty;
+      for (int64_t i = 0; i < nTracks; i++) {
+        certainties.push_back(sigmoid(output_value[i])); // FIXME: Temporary, sigmoid will be added as network layer
+      }
+      return;
     } catch (const Ort::Exception& exception) {
       LOG(error) << "Error running model inference: " << exception.what();
     }
-    return false; // unreachable code
+    certainties.resize(certainties.size() + nTracks, 0.f); // unreachable code
   }
 
   // Pretty prints a shape dimension vector
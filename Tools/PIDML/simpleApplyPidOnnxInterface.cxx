@@ -22,6 +22,7 @@
 #include "Tools/PIDML/pidOnnxInterface.h"
 
 #include <string>
+#include <vector>
 
 using namespace o2;
 using namespace o2::framework;
@@ -80,28 +81,43 @@ struct SimpleApplyOnnxInterface {
     if (cfgUseCCDB && bc.runNumber() != currentRunNumber) {
       uint64_t timestamp = cfgUseFixedTimestamp ? cfgTimestamp.value : bc.timestamp();
       pidInterface = PidONNXInterface(cfgPathLocal.value, cfgPathCCDB.value, cfgUseCCDB.value, ccdbApi, timestamp, cfgPids.value, cfgPTCuts.value, cfgCertainties.value, cfgAutoMode.value);
+      currentRunNumber = bc.runNumber();
     }
 
+    std::vector<std::vector<bool>> acceptedTracks;
+    for (int pid : cfgPids.value) {
+      acceptedTracks.push_back(pidInterface.applyModelBooleanBatch(tracks, pid));
+    }
+    std::size_t iTrack = 0;
     for (auto& track : tracks) {
-      for (int pid : cfgPids.value) {
-        bool accepted = pidInterface.applyModelBoolean(track, pid);
+      for (std::size_t iPid = 0; iPid < cfgPids.value.size(); iPid++) {
+        int pid = cfgPids.value[iPid];
+        bool accepted = acceptedTracks[iPid][iTrack];
         LOGF(info, "collision id: %d track id: %d pid: %d accepted: %d p: %.3f; x: %.3f, y: %.3f, z: %.3f",
              track.collisionId(), track.index(), pid, accepted, track.p(), track.x(), track.y(), track.z());
         pidMLResults(track.index(), pid, accepted);
       }
+      iTrack++;
     }
   }
   PROCESS_SWITCH(SimpleApplyOnnxInterface, processCollisions, "Process with collisions and bcs for CCDB", true);
 
   void processTracksOnly(BigTracks const& tracks)
   {
+    std::vector<std::vector<bool>> acceptedTracks;
+    for (int pid : cfgPids.value) {
+      acceptedTracks.push_back(pidInterface.applyModelBooleanBatch(tracks, pid));
+    }
+    std::size_t iTrack = 0;
     for (auto& track : tracks) {
-      for (int pid : cfgPids.value) {
-        bool accepted = pidInterface.applyModelBoolean(track, pid);
+      for (std::size_t iPid = 0; iPid < cfgPids.value.size(); iPid++) {
+        int pid = cfgPids.value[iPid];
+        bool accepted = acceptedTracks[iPid][iTrack];
         LOGF(info, "collision id: %d track id: %d pid: %d accepted: %d p: %.3f; x: %.3f, y: %.3f, z: %.3f",
              track.collisionId(), track.index(), pid, accepted, track.p(), track.x(), track.y(), track.z());
         pidMLResults(track.index(), pid, accepted);
       }
+      iTrack++;
     }
   }
   PROCESS_SWITCH(SimpleApplyOnnxInterface, processTracksOnly, "Process with tracks only -- faster but no CCDB", false);
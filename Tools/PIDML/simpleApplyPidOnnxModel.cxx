@@ -22,6 +22,7 @@
 #include "Tools/PIDML/pidOnnxModel.h"
 
 #include <string>
+#include <vector>
 
 using namespace o2;
 using namespace o2::framework;
@@ -78,10 +79,13 @@ struct SimpleApplyOnnxModel {
     if (cfgUseCCDB && bc.runNumber() != currentRunNumber) {
       uint64_t timestamp = cfgUseFixedTimestamp ? cfgTimestamp.value : bc.timestamp();
       pidModel = PidONNXModel(cfgPathLocal.value, cfgPathCCDB.value, cfgUseCCDB.value, ccdbApi, timestamp, cfgPid.value, static_cast<PidMLDetector>(cfgDetector.value), cfgCertainty.value);
+      currentRunNumber = bc.runNumber();
     }
 
+    std::vector<bool> acceptedTracks = pidModel.applyModelBooleanBatch(tracks);
+    std::size_t iTrack = 0;
     for (auto& track : tracks) {
-      bool accepted = pidModel.applyModelBoolean(track);
+      bool accepted = acceptedTracks[iTrack++];
       LOGF(info, "collision id: %d track id: %d accepted: %d p: %.3f; x: %.3f, y: %.3f, z: %.3f",
            track.collisionId(), track.index(), accepted, track.p(), track.x(), track.y(), track.z());
       pidMLResults(track.index(), cfgPid.value, accepted);
@@ -91,8 +95,10 @@ struct SimpleApplyOnnxModel {
 
   void processTracksOnly(BigTracks const& tracks)
   {
+    std::vector<bool> acceptedTracks = pidModel.applyModelBooleanBatch(tracks);
+    std::size_t iTrack = 0;
     for (auto& track : tracks) {
-      bool accepted = pidModel.applyModelBoolean(track);
+      bool accepted = acceptedTracks[iTrack++];
       LOGF(info, "collision id: %d track id: %d accepted: %d p: %.3f; x: %.3f, y: %.3f, z: %.3f",
            track.collisionId(), track.index(), accepted, track.p(), track.x(), track.y(), track.z());
       pidMLResults(track.index(), cfgPid.value, accepted);